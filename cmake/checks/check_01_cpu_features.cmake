@@ -28,6 +28,7 @@
 #   DEAL_II_HAVE_AVX                     *)
 #   DEAL_II_HAVE_AVX512                  *)
 #   DEAL_II_HAVE_ALTIVEC                 *)
+#   DEAL_II_HAVE_ARM_NEON                *)
 #   DEAL_II_HAVE_OPENMP_SIMD             *)
 #   DEAL_II_VECTORIZATION_WIDTH_IN_BITS
 #   DEAL_II_OPENMP_SIMD_PRAGMA
@@ -74,6 +75,7 @@ IF(DEAL_II_ALLOW_PLATFORM_INTROSPECTION)
   #
   UNSET_IF_CHANGED(CHECK_CPU_FEATURES_FLAGS_SAVED "${CMAKE_REQUIRED_FLAGS}"
     DEAL_II_HAVE_SSE2 DEAL_II_HAVE_AVX DEAL_II_HAVE_AVX512 DEAL_II_HAVE_ALTIVEC
+    DEAL_II_HAVE_ARM_NEON
     )
 
   CHECK_CXX_SOURCE_RUNS(
@@ -246,6 +248,32 @@ IF(DEAL_II_ALLOW_PLATFORM_INTROSPECTION)
     "
     DEAL_II_HAVE_ALTIVEC)
 
+  CHECK_CXX_SOURCE_RUNS(
+    "
+    #if !defined(__ARM_NEON) || !defined(__aarch64__)
+    #error \"__ARM_NEON flag not set, no support for NEON on AArch64\"
+    #endif
+    #include <arm_neon.h>
+    int main()
+    {
+    double data[2];
+    data[0] = static_cast<volatile double>(1.0);
+    data[1] = 0.0;
+    float64x2_t a = vld1q_f64(data);
+    float64x2_t b = vdupq_n_f64(static_cast<volatile double>(2.25));
+    float64x2_t c = vmulq_f64(b, vaddq_f64(a, b));
+    c = vabsq_f64(vmulq_f64(vdupq_n_f64(-1.0), c));
+    vst1q_f64(data, c);
+    int return_value = 0;
+    if (data[0] != 7.3125)
+      return_value += 1;
+    if (data[1] != 5.0625)
+      return_value += 2;
+    return return_value;
+    }
+    "
+    DEAL_II_HAVE_ARM_NEON)
+
   #
   # OpenMP 4.0 can be used for vectorization. Only the vectorization
   # instructions are allowed, the threading must be done through TBB.
@@ -286,7 +314,7 @@ ELSE()
   SET(DEAL_II_VECTORIZATION_WIDTH_IN_BITS 0)
 ENDIF()
 
-IF(DEAL_II_HAVE_ALTIVEC)
+IF(DEAL_II_HAVE_ALTIVEC OR DEAL_II_HAVE_ARM_NEON)
   SET(DEAL_II_VECTORIZATION_WIDTH_IN_BITS 128)
 ENDIF()
 
@@ -26,6 +26,7 @@
 #   DEAL_II_VECTOR_ITERATOR_IS_POINTER
 #   DEAL_II_HAVE_BUILTIN_EXPECT
 #   DEAL_II_HAVE_GLIBC_STACKTRACE
+#   DEAL_II_HAVE_DLOPEN
 #   DEAL_II_HAVE_LIBSTDCXX_DEMANGLER
 #   DEAL_II_COMPILER_HAS_ATTRIBUTE_PRETTY_FUNCTION
 #   DEAL_II_COMPILER_HAS_ATTRIBUTE_ALWAYS_INLINE
@@ -146,6 +147,28 @@ IF(DEAL_II_HAVE_GLIBC_STACKTRACE AND NOT DEAL_II_STATIC_EXECUTABLE)
 ENDIF()
 
 
+#
+# Check whether shared libraries can be loaded at run time. This is used for
+# the run-time generation of matrix-free evaluation kernels.
+#
+LIST(APPEND CMAKE_REQUIRED_LIBRARIES ${CMAKE_DL_LIBS})
+CHECK_CXX_SOURCE_COMPILES(
+  "
+  #include <dlfcn.h>
+  int main()
+  {
+    void *handle = dlopen(\"libm.so\", RTLD_NOW);
+    return handle == nullptr ? 0 : dlclose(handle);
+  }
+  "
+  DEAL_II_HAVE_DLOPEN)
+RESET_CMAKE_REQUIRED()
+
+IF(DEAL_II_HAVE_DLOPEN AND NOT "${CMAKE_DL_LIBS}" STREQUAL "")
+  LIST(APPEND DEAL_II_LIBRARIES ${CMAKE_DL_LIBS})
+ENDIF()
+
+
 #
 # Check whether the compiler offers a way to demangle symbols
 # from within the program. Used inside the exception stacktrace
@@ -0,0 +1,46 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2021 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Configuration for the ADIOS2 library, used for staged and asynchronous
+# output in DataOutBase:
+#
+
+SET(FEATURE_ADIOS2_AFTER MPI)
+
+
+MACRO(FEATURE_ADIOS2_FIND_EXTERNAL var)
+  FIND_PACKAGE(ADIOS2)
+
+  IF(ADIOS2_FOUND)
+    SET(${var} TRUE)
+
+    IF(NOT ADIOS2_WITH_MPI AND DEAL_II_WITH_MPI)
+      MESSAGE(STATUS "Insufficient ADIOS2 installation found: "
+        "ADIOS2 has to be configured with MPI support if deal.II is."
+        )
+      SET(ADIOS2_ADDITIONAL_ERROR_STRING
+        "Insufficient ADIOS2 installation found!\n"
+        "ADIOS2 has to be configured with MPI support if deal.II is, but found:\n"
+        "  DEAL_II_WITH_MPI = ${DEAL_II_WITH_MPI}\n"
+        "  ADIOS2_WITH_MPI  = ${ADIOS2_WITH_MPI}\n"
+        )
+      SET(${var} FALSE)
+    ENDIF()
+  ENDIF()
+ENDMACRO()
+
+
+CONFIGURE_FEATURE(ADIOS2)
@@ -0,0 +1,80 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2021 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Try to find the ADIOS2 library
+#
+# This module exports
+#
+#   ADIOS2_FOUND
+#   ADIOS2_LIBRARIES
+#   ADIOS2_INCLUDE_DIRS
+#   ADIOS2_WITH_MPI
+#
+
+SET(ADIOS2_DIR "" CACHE PATH "An optional hint to an ADIOS2 installation")
+SET_IF_EMPTY(ADIOS2_DIR "$ENV{ADIOS2_DIR}")
+
+DEAL_II_FIND_LIBRARY(ADIOS2_CXX11_LIBRARY
+  NAMES adios2_cxx11
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+DEAL_II_FIND_LIBRARY(ADIOS2_CORE_LIBRARY
+  NAMES adios2_core
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+#
+# The MPI variant of ADIOS2 provides the MPI aware bindings in separate
+# libraries:
+#
+DEAL_II_FIND_LIBRARY(ADIOS2_CXX11_MPI_LIBRARY
+  NAMES adios2_cxx11_mpi
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+DEAL_II_FIND_LIBRARY(ADIOS2_CORE_MPI_LIBRARY
+  NAMES adios2_core_mpi
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+IF(EXISTS ${ADIOS2_CXX11_MPI_LIBRARY} AND EXISTS ${ADIOS2_CORE_MPI_LIBRARY})
+  SET(ADIOS2_WITH_MPI TRUE)
+ELSE()
+  SET(ADIOS2_WITH_MPI FALSE)
+ENDIF()
+
+DEAL_II_FIND_PATH(ADIOS2_INCLUDE_DIR adios2.h
+  HINTS ${ADIOS2_DIR}
+  PATH_SUFFIXES include
+  )
+
+DEAL_II_PACKAGE_HANDLE(ADIOS2
+  LIBRARIES
+    OPTIONAL ADIOS2_CXX11_MPI_LIBRARY ADIOS2_CORE_MPI_LIBRARY
+    REQUIRED ADIOS2_CXX11_LIBRARY ADIOS2_CORE_LIBRARY
+  INCLUDE_DIRS
+    REQUIRED ADIOS2_INCLUDE_DIR
+  USER_INCLUDE_DIRS
+    REQUIRED ADIOS2_INCLUDE_DIR
+  CLEAR
+    ADIOS2_CXX11_LIBRARY ADIOS2_CORE_LIBRARY ADIOS2_CXX11_MPI_LIBRARY
+    ADIOS2_CORE_MPI_LIBRARY ADIOS2_INCLUDE_DIR
+  )
@@ -0,0 +1,48 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2021 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Try to find the hwloc library
+#
+# This module exports
+#
+#   HWLOC_FOUND
+#   HWLOC_LIBRARIES
+#   HWLOC_INCLUDE_DIRS
+#
+
+SET(HWLOC_DIR "" CACHE PATH "An optional hint to an hwloc installation")
+SET_IF_EMPTY(HWLOC_DIR "$ENV{HWLOC_DIR}")
+
+DEAL_II_FIND_LIBRARY(HWLOC_LIBRARY
+  NAMES hwloc
+  HINTS ${HWLOC_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+DEAL_II_FIND_PATH(HWLOC_INCLUDE_DIR hwloc.h
+  HINTS ${HWLOC_DIR}
+  PATH_SUFFIXES include
+  )
+
+DEAL_II_PACKAGE_HANDLE(HWLOC
+  LIBRARIES
+    REQUIRED HWLOC_LIBRARY
+  INCLUDE_DIRS
+    REQUIRED HWLOC_INCLUDE_DIR
+  USER_INCLUDE_DIRS
+    REQUIRED HWLOC_INCLUDE_DIR
+  CLEAR HWLOC_LIBRARY HWLOC_INCLUDE_DIR
+  )
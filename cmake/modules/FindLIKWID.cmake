@@ -0,0 +1,48 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2021 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Try to find the LIKWID library
+#
+# This module exports
+#
+#   LIKWID_FOUND
+#   LIKWID_LIBRARIES
+#   LIKWID_INCLUDE_DIRS
+#
+
+SET(LIKWID_DIR "" CACHE PATH "An optional hint to a LIKWID installation")
+SET_IF_EMPTY(LIKWID_DIR "$ENV{LIKWID_DIR}")
+
+DEAL_II_FIND_LIBRARY(LIKWID_LIBRARY
+  NAMES likwid
+  HINTS ${LIKWID_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+DEAL_II_FIND_PATH(LIKWID_INCLUDE_DIR likwid.h
+  HINTS ${LIKWID_DIR}
+  PATH_SUFFIXES include
+  )
+
+DEAL_II_PACKAGE_HANDLE(LIKWID
+  LIBRARIES
+    REQUIRED LIKWID_LIBRARY
+  INCLUDE_DIRS
+    REQUIRED LIKWID_INCLUDE_DIR
+  USER_INCLUDE_DIRS
+    REQUIRED LIKWID_INCLUDE_DIR
+  CLEAR LIKWID_LIBRARY LIKWID_INCLUDE_DIR
+  )
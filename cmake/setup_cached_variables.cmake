@@ -170,6 +170,11 @@ OPTION(DEAL_II_EARLY_DEPRECATIONS
   OFF)
 MARK_AS_ADVANCED(DEAL_II_EARLY_DEPRECATIONS)
 
+OPTION(DEAL_II_MATRIX_FREE_COUNT_OPERATIONS
+  "Count the arithmetic operations and the memory transfer of the matrix-free evaluation kernels, see MatrixFreeTools::OperationCounter. This slows down the kernels."
+  OFF)
+MARK_AS_ADVANCED(DEAL_II_MATRIX_FREE_COUNT_OPERATIONS)
+
 SET(BUILD_SHARED_LIBS "ON" CACHE BOOL
   "Build a shared library"
   )
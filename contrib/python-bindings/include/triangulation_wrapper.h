@@ -325,6 +325,23 @@ namespace python
     boost::python::list
     cells();
 
+    /**
+     * Return the centers of all active cells as a Python memoryview of shape
+     * (n_active_cells, spacedim), ordered by the active cell index. The
+     * data is written directly into memory owned by the memoryview, which
+     * can be turned into a NumPy array with <tt>numpy.asarray()</tt>
+     * without copying.
+     */
+    boost::python::object
+    cell_centers() const;
+
+    /**
+     * Return the measures of all active cells as a Python memoryview of
+     * shape (n_active_cells,). See cell_centers().
+     */
+    boost::python::object
+    cell_measures() const;
+
     /*! @copydoc GridTools::minimal_cell_diameter
      */
     double
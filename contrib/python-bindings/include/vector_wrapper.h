@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_wrapper_h
+#define dealii_vector_wrapper_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <boost/python.hpp>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  class VectorWrapper
+  {
+  public:
+    /**
+     * Constructor. Create a vector of the given @p size with all entries
+     * set to zero.
+     */
+    VectorWrapper(const unsigned int size);
+
+    /**
+     * Return the size of the vector.
+     */
+    unsigned int
+    size() const;
+
+    /**
+     * Return the entry @p i.
+     */
+    double
+    get_entry(const unsigned int i) const;
+
+    /**
+     * Set the entry @p i to @p value.
+     */
+    void
+    set_entry(const unsigned int i, const double value);
+
+    /*! @copydoc Vector::l2_norm
+     */
+    double
+    l2_norm() const;
+
+    /**
+     * Return a writable Python memoryview of the entries of the vector.
+     * The memoryview shares the memory of the vector, i.e., no data is
+     * copied, and can be turned into a NumPy array with
+     * <tt>numpy.asarray()</tt>, again without copying. Changes made through
+     * the memoryview are visible in the vector and vice versa.
+     *
+     * @note The memoryview does not keep the vector alive. It must not be
+     * used after the vector has been destroyed.
+     */
+    boost::python::object
+    as_array();
+
+    /**
+     * Return a reference to the underlying vector.
+     */
+    Vector<double> &
+    get_vector();
+
+  private:
+    /**
+     * The underlying vector.
+     */
+    Vector<double> vector;
+  };
+
+} // namespace python
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
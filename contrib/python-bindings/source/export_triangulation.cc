@@ -470,6 +470,20 @@ namespace python
 
 
 
+  const char cell_centers_docstring[] =
+    "Return the centers of all active cells as a memoryview of shape       \n"
+    "(n_active_cells, spacedim). Use numpy.asarray() on the result to      \n"
+    "obtain a NumPy array without copying the data.                        \n";
+
+
+
+  const char cell_measures_docstring[] =
+    "Return the measures of all active cells as a memoryview of shape      \n"
+    "(n_active_cells,). Use numpy.asarray() on the result to obtain a      \n"
+    "NumPy array without copying the data.                                 \n";
+
+
+
   const char minimal_cell_diameter_docstring[] =
     "Return the diameter of the smallest active cell of a triangulation.    \n";
 
@@ -514,6 +528,14 @@ namespace python
            &TriangulationWrapper::n_cells,
            n_cells_docstring,
            boost::python::args("self"))
+      .def("cell_centers",
+           &TriangulationWrapper::cell_centers,
+           cell_centers_docstring,
+           boost::python::args("self"))
+      .def("cell_measures",
+           &TriangulationWrapper::cell_measures,
+           cell_measures_docstring,
+           boost::python::args("self"))
       .def("minimal_cell_diameter",
            &TriangulationWrapper::minimal_cell_diameter,
            minimal_cell_diameter_docstring,
@@ -0,0 +1,80 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <boost/python.hpp>
+
+#include <vector_wrapper.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  const char size_docstring[] =
+    "Return the size of the vector.                            \n";
+
+
+  const char get_entry_docstring[] =
+    "Return the entry i of the vector.                         \n";
+
+
+  const char set_entry_docstring[] =
+    "Set the entry i of the vector.                            \n";
+
+
+  const char l2_norm_docstring[] =
+    "Return the l2 norm of the vector.                         \n";
+
+
+  const char as_array_docstring[] =
+    "Return a writable memoryview that shares the memory of    \n"
+    "the vector. Use numpy.asarray() on the result to obtain a \n"
+    "NumPy array without copying the data. The memoryview must \n"
+    "not be used after the vector has been deleted.            \n";
+
+
+  void
+  export_vector()
+  {
+    boost::python::class_<VectorWrapper>(
+      "Vector",
+      boost::python::init<const unsigned int>(boost::python::args("size")))
+      .def("size",
+           &VectorWrapper::size,
+           size_docstring,
+           boost::python::args("self"))
+      .def("__len__",
+           &VectorWrapper::size,
+           size_docstring,
+           boost::python::args("self"))
+      .def("__getitem__",
+           &VectorWrapper::get_entry,
+           get_entry_docstring,
+           boost::python::args("self", "i"))
+      .def("__setitem__",
+           &VectorWrapper::set_entry,
+           set_entry_docstring,
+           boost::python::args("self", "i", "value"))
+      .def("l2_norm",
+           &VectorWrapper::l2_norm,
+           l2_norm_docstring,
+           boost::python::args("self"))
+      .def("as_array",
+           &VectorWrapper::as_array,
+           as_array_docstring,
+           boost::python::args("self"));
+  }
+} // namespace python
+
+DEAL_II_NAMESPACE_CLOSE
@@ -757,6 +757,73 @@ namespace python
 
 
 
+    /**
+     * Create a Python memoryview of doubles with the given shape. The memory
+     * is owned by a Python bytearray that is kept alive by the memoryview,
+     * and a pointer to it is returned in @p data so that it can be filled
+     * directly, without a temporary copy.
+     */
+    boost::python::object
+    create_array(const unsigned int n_rows,
+                 const unsigned int n_columns,
+                 double *&          data)
+    {
+      boost::python::object bytes(boost::python::handle<>(
+        PyByteArray_FromStringAndSize(nullptr,
+                                      n_rows * n_columns * sizeof(double))));
+      data = reinterpret_cast<double *>(PyByteArray_AsString(bytes.ptr()));
+
+      boost::python::object view(
+        boost::python::handle<>(PyMemoryView_FromObject(bytes.ptr())));
+      if (n_columns == 1)
+        return view.attr("cast")("d", boost::python::make_tuple(n_rows));
+      else
+        return view.attr("cast")("d",
+                                 boost::python::make_tuple(n_rows, n_columns));
+    }
+
+
+
+    template <int dim, int spacedim>
+    boost::python::object
+    cell_centers(const void *triangulation)
+    {
+      const Triangulation<dim, spacedim> *tria =
+        static_cast<const Triangulation<dim, spacedim> *>(triangulation);
+
+      double *                    data;
+      const boost::python::object array =
+        create_array(tria->n_active_cells(), spacedim, data);
+      for (const auto &cell : tria->active_cell_iterators())
+        {
+          const Point<spacedim> center = cell->center();
+          for (unsigned int d = 0; d < spacedim; ++d)
+            data[cell->active_cell_index() * spacedim + d] = center[d];
+        }
+
+      return array;
+    }
+
+
+
+    template <int dim, int spacedim>
+    boost::python::object
+    cell_measures(const void *triangulation)
+    {
+      const Triangulation<dim, spacedim> *tria =
+        static_cast<const Triangulation<dim, spacedim> *>(triangulation);
+
+      double *                    data;
+      const boost::python::object array =
+        create_array(tria->n_active_cells(), 1, data);
+      for (const auto &cell : tria->active_cell_iterators())
+        data[cell->active_cell_index()] = cell->measure();
+
+      return array;
+    }
+
+
+
     template <int dim, int spacedim>
     double
     maximal_cell_diameter(const void *triangulation)
@@ -1781,6 +1848,32 @@ namespace python
 
 
 
+  boost::python::object
+  TriangulationWrapper::cell_centers() const
+  {
+    if ((dim == 2) && (spacedim == 2))
+      return internal::cell_centers<2, 2>(triangulation);
+    else if ((dim == 2) && (spacedim == 3))
+      return internal::cell_centers<2, 3>(triangulation);
+    else
+      return internal::cell_centers<3, 3>(triangulation);
+  }
+
+
+
+  boost::python::object
+  TriangulationWrapper::cell_measures() const
+  {
+    if ((dim == 2) && (spacedim == 2))
+      return internal::cell_measures<2, 2>(triangulation);
+    else if ((dim == 2) && (spacedim == 3))
+      return internal::cell_measures<2, 3>(triangulation);
+    else
+      return internal::cell_measures<3, 3>(triangulation);
+  }
+
+
+
   double
   TriangulationWrapper::maximal_cell_diameter() const
   {
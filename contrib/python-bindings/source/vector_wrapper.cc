@@ -0,0 +1,99 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <vector_wrapper.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  VectorWrapper::VectorWrapper(const unsigned int size)
+    : vector(size)
+  {}
+
+
+
+  unsigned int
+  VectorWrapper::size() const
+  {
+    return vector.size();
+  }
+
+
+
+  double
+  VectorWrapper::get_entry(const unsigned int i) const
+  {
+    AssertIndexRange(i, vector.size());
+    return vector[i];
+  }
+
+
+
+  void
+  VectorWrapper::set_entry(const unsigned int i, const double value)
+  {
+    AssertIndexRange(i, vector.size());
+    vector[i] = value;
+  }
+
+
+
+  double
+  VectorWrapper::l2_norm() const
+  {
+    return vector.l2_norm();
+  }
+
+
+
+  boost::python::object
+  VectorWrapper::as_array()
+  {
+    // Describe the memory of the vector as a one-dimensional, contiguous
+    // and writable array of doubles. The memoryview created from this
+    // description refers to the memory of the vector directly.
+    static char format[] = "d";
+    Py_ssize_t  shape    = vector.size();
+    Py_ssize_t  stride   = sizeof(double);
+
+    Py_buffer buffer;
+    buffer.buf        = vector.data();
+    buffer.obj        = nullptr;
+    buffer.len        = shape * stride;
+    buffer.itemsize   = stride;
+    buffer.readonly   = 0;
+    buffer.ndim       = 1;
+    buffer.format     = format;
+    buffer.shape      = &shape;
+    buffer.strides    = &stride;
+    buffer.suboffsets = nullptr;
+    buffer.internal   = nullptr;
+
+    return boost::python::object(
+      boost::python::handle<>(PyMemoryView_FromBuffer(&buffer)));
+  }
+
+
+
+  Vector<double> &
+  VectorWrapper::get_vector()
+  {
+    return vector;
+  }
+
+} // namespace python
+
+DEAL_II_NAMESPACE_CLOSE
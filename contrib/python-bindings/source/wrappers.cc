@@ -37,6 +37,8 @@ namespace python
   export_manifold();
   void
   export_quadrature();
+  void
+  export_vector();
 } // namespace python
 
 DEAL_II_NAMESPACE_CLOSE
@@ -72,6 +74,7 @@ BOOST_PYTHON_MODULE(Debug)
   dealii::python::export_mapping();
   dealii::python::export_manifold();
   dealii::python::export_quadrature();
+  dealii::python::export_vector();
 }
 
 #else
@@ -92,6 +95,7 @@ BOOST_PYTHON_MODULE(Release)
   dealii::python::export_mapping();
   dealii::python::export_manifold();
   dealii::python::export_quadrature();
+  dealii::python::export_vector();
 }
 
 #endif
@@ -21,6 +21,8 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/memory_tracker.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
@@ -34,7 +36,10 @@
 #endif
 #include <boost/serialization/split_member.hpp>
 
+#include <algorithm>
 #include <cstring>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <type_traits>
 
@@ -259,6 +264,79 @@ public:
   void
   fill(const T &element);
 
+  /**
+   * Replace the contents of this vector on all processes of @p communicator
+   * by the contents on the process with rank @p root_process, storing them
+   * only once per shared-memory node.
+   *
+   * The data is placed in an MPI-3 shared memory window that is allocated by
+   * one process on every node and that all other processes on the same node
+   * access directly, rather than keeping a private copy. This reduces the
+   * memory footprint of large, read-only data sets that all processes need
+   * to know, e.g., geometric information of the whole mesh, by the number of
+   * processes per node.
+   *
+   * This is a collective operation on @p communicator. Since the memory is
+   * shared, the contents must not be modified afterwards: changes made by one
+   * process would be seen by all others on the same node. Furthermore,
+   * releasing the memory is collective as well, so that all processes of
+   * @p communicator need to destroy, clear(), or reallocate the vector at the
+   * same time. Copies of the vector use private memory again.
+   *
+   * This function is only available for trivially copyable types @p T.
+   * Without MPI, it does nothing.
+   */
+  void
+  replicate_across_communicator(const MPI_Comm &   communicator,
+                                const unsigned int root_process);
+
+  /**
+   * Request that memory allocated by this vector from now on is backed by
+   * transparent huge pages, if @p use_huge_pages is true. Allocations of at
+   * least 2 MB are then aligned to the size of a huge page and marked with
+   * Utilities::System::advise_transparent_huge_pages() before any element is
+   * written, which reduces the number of TLB misses for large arrays that
+   * are traversed many times, such as the index and mapping data of
+   * MatrixFree. Smaller allocations and the memory that is already allocated
+   * are not affected, so this function is best called before the first
+   * resize() or reserve().
+   *
+   * The setting moves along with the data in move construction, move
+   * assignment, and swap(), but copies of the vector use regular pages.
+   */
+  void
+  enable_huge_pages(const bool use_huge_pages = true);
+
+  /**
+   * Replace the contents of this vector by @p n_elements elements that are
+   * stored in binary form in the file @p filename, starting at byte
+   * @p offset, by mapping the file into memory with
+   * Utilities::System::map_file(). The elements are not read upon this
+   * call, but loaded by the operating system when they are first accessed,
+   * and unmodified pages can be evicted again under memory pressure. This
+   * allows working with data sets that are larger than the main memory.
+   *
+   * If @p write_through is true, changes to the elements are written back to
+   * the file. Otherwise, the file is not modified and changed elements are
+   * kept in private memory.
+   *
+   * The size and the capacity of the vector are @p n_elements after this
+   * call. Operations that need to reallocate, such as growing the vector
+   * with resize() or push_back(), as well as copies of the vector, move the
+   * elements to regular memory. The mapping is released when the vector is
+   * destroyed, cleared, or reallocated.
+   *
+   * This function is only available for trivially copyable types @p T, and
+   * @p offset must be a multiple of the alignment of @p T. Note that the
+   * elements are then only aligned to the alignment of @p T, rather than to
+   * the width of the SIMD registers.
+   */
+  void
+  map_file(const std::string &filename,
+           const std::size_t  offset,
+           const size_type    n_elements,
+           const bool         write_through = false);
+
   /**
    * Swaps the given vector with the calling vector.
    */
@@ -373,9 +451,11 @@ public:
 
 private:
   /**
-   * Pointer to actual data array.
+   * Pointer to actual data array. The deleter is a general function object
+   * because memory that is shared with other processes needs to be released
+   * differently from memory that was allocated by this class.
    */
-  std::unique_ptr<T[], void (*)(T *)> elements;
+  std::unique_ptr<T[], std::function<void(T *)>> elements;
 
   /**
    * Pointer to one past the last valid value.
@@ -386,6 +466,12 @@ private:
    * Pointer to the end of the allocated memory.
    */
   T *allocated_elements_end;
+
+  /**
+   * Whether large allocations should be backed by transparent huge pages,
+   * see enable_huge_pages().
+   */
+  bool use_huge_pages;
 };
 
 
@@ -740,6 +826,7 @@ inline AlignedVector<T>::AlignedVector()
   : elements(nullptr, [](T *) { Assert(false, ExcInternalError()); })
   , used_elements_end(nullptr)
   , allocated_elements_end(nullptr)
+  , use_huge_pages(false)
 {}
 
 
@@ -749,6 +836,7 @@ inline AlignedVector<T>::AlignedVector(const size_type size, const T &init)
   : elements(nullptr, [](T *) { Assert(false, ExcInternalError()); })
   , used_elements_end(nullptr)
   , allocated_elements_end(nullptr)
+  , use_huge_pages(false)
 {
   if (size > 0)
     resize(size, init);
@@ -769,6 +857,7 @@ inline AlignedVector<T>::AlignedVector(const AlignedVector<T> &vec)
   : elements(nullptr, [](T *) { Assert(false, ExcInternalError()); })
   , used_elements_end(nullptr)
   , allocated_elements_end(nullptr)
+  , use_huge_pages(false)
 {
   // copy the data from vec
   reserve(vec.size());
@@ -785,6 +874,7 @@ inline AlignedVector<T>::AlignedVector(AlignedVector<T> &&vec) noexcept
   : elements(std::move(vec.elements))
   , used_elements_end(vec.used_elements_end)
   , allocated_elements_end(vec.allocated_elements_end)
+  , use_huge_pages(vec.use_huge_pages)
 {
   vec.elements               = nullptr;
   vec.used_elements_end      = nullptr;
@@ -819,6 +909,7 @@ AlignedVector<T>::operator=(AlignedVector<T> &&vec) noexcept
   // Then also steal the other pointers and clear them in the original object:
   used_elements_end      = vec.used_elements_end;
   allocated_elements_end = vec.allocated_elements_end;
+  use_huge_pages         = vec.use_huge_pages;
 
   vec.used_elements_end      = nullptr;
   vec.allocated_elements_end = nullptr;
@@ -917,13 +1008,36 @@ AlignedVector<T>::reserve(const size_type new_allocated_size)
         std::max(new_allocated_size, 2 * old_allocated_size);
 
       // allocate and align along 64-byte boundaries (this is enough for all
-      // levels of vectorization currently supported by deal.II)
+      // levels of vectorization currently supported by deal.II). if huge
+      // pages are requested, align large allocations to the size of a huge
+      // page instead and advise the kernel before the memory is touched
+      const std::size_t huge_page_size = 2 * 1024 * 1024;
+      const std::size_t n_bytes        = new_size * sizeof(T);
+      const bool        align_to_huge_pages =
+        use_huge_pages && n_bytes >= huge_page_size;
       T *new_data_ptr;
       Utilities::System::posix_memalign(
-        reinterpret_cast<void **>(&new_data_ptr), 64, new_size * sizeof(T));
-      std::unique_ptr<T[], void (*)(T *)> new_data(new_data_ptr, [](T *ptr) {
-        std::free(ptr);
-      });
+        reinterpret_cast<void **>(&new_data_ptr),
+        align_to_huge_pages ? huge_page_size : 64,
+        n_bytes);
+      if (align_to_huge_pages)
+        Utilities::System::advise_transparent_huge_pages(new_data_ptr,
+                                                         n_bytes);
+      std::unique_ptr<T[], std::function<void(T *)>> new_data(
+        new_data_ptr, [](T *ptr) { std::free(ptr); });
+
+      // if requested, report the allocation and let the deleter report its
+      // release, attributed to the subsystem that is current right now
+      if (MemoryTracker::is_enabled())
+        {
+          const MemoryTracker::Subsystem subsystem =
+            MemoryTracker::current_subsystem();
+          MemoryTracker::allocate(subsystem, n_bytes);
+          new_data.get_deleter() = [subsystem, n_bytes](T *ptr) {
+            MemoryTracker::deallocate(subsystem, n_bytes);
+            std::free(ptr);
+          };
+        }
 
       // copy whatever elements we need to retain
       if (new_allocated_size > 0)
@@ -1036,6 +1150,176 @@ AlignedVector<T>::fill(const T &value)
 
 
 
+template <class T>
+inline void
+AlignedVector<T>::replicate_across_communicator(
+  const MPI_Comm &   communicator,
+  const unsigned int root_process)
+{
+#  ifdef DEAL_II_WITH_MPI
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only trivially copyable types can be placed in memory that "
+                "is shared between processes.");
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+  AssertIndexRange(root_process,
+                   Utilities::MPI::n_mpi_processes(communicator));
+
+  // Split the communicator into groups of processes that can share memory.
+  // The ordering key makes sure that the root process becomes rank zero of
+  // its group. Rank zero of each group owns the shared memory window and
+  // takes part in distributing the data between the groups.
+  const int key = (my_rank == root_process ? 0 : my_rank + 1);
+
+  MPI_Comm shmem_communicator;
+  int      ierr = MPI_Comm_split_type(communicator,
+                                 MPI_COMM_TYPE_SHARED,
+                                 key,
+                                 MPI_INFO_NULL,
+                                 &shmem_communicator);
+  AssertThrowMPI(ierr);
+  const bool is_group_root =
+    (Utilities::MPI::this_mpi_process(shmem_communicator) == 0);
+
+  MPI_Comm group_root_communicator;
+  ierr = MPI_Comm_split(communicator,
+                        is_group_root ? 0 : MPI_UNDEFINED,
+                        key,
+                        &group_root_communicator);
+  AssertThrowMPI(ierr);
+
+  unsigned long long int n_elements = size();
+  ierr                              = MPI_Bcast(
+    &n_elements, 1, MPI_UNSIGNED_LONG_LONG, root_process, communicator);
+  AssertThrowMPI(ierr);
+
+  if (n_elements == 0)
+    {
+      if (is_group_root)
+        {
+          ierr = MPI_Comm_free(&group_root_communicator);
+          AssertThrowMPI(ierr);
+        }
+      ierr = MPI_Comm_free(&shmem_communicator);
+      AssertThrowMPI(ierr);
+      clear();
+      return;
+    }
+
+  // Allocate the window on the root of each group and query its address on
+  // the other processes of the group.
+  const std::size_t n_bytes     = n_elements * sizeof(T);
+  T *               shared_data = nullptr;
+  MPI_Win           window;
+  ierr = MPI_Win_allocate_shared(is_group_root ? n_bytes : 0,
+                                 sizeof(T),
+                                 MPI_INFO_NULL,
+                                 shmem_communicator,
+                                 &shared_data,
+                                 &window);
+  AssertThrowMPI(ierr);
+  if (!is_group_root)
+    {
+      MPI_Aint window_size;
+      int      displacement_unit;
+      ierr = MPI_Win_shared_query(
+        window, 0, &window_size, &displacement_unit, &shared_data);
+      AssertThrowMPI(ierr);
+    }
+
+  // Fill the windows: the root process copies its data, and then sends it to
+  // the roots of all other groups, in chunks whose size fits into an int.
+  if (is_group_root)
+    {
+      if (my_rank == root_process)
+        std::memcpy(shared_data, elements.get(), n_bytes);
+
+      char *const       bytes     = reinterpret_cast<char *>(shared_data);
+      const std::size_t max_chunk = std::numeric_limits<int>::max();
+      for (std::size_t offset = 0; offset < n_bytes; offset += max_chunk)
+        {
+          ierr = MPI_Bcast(bytes + offset,
+                           std::min(max_chunk, n_bytes - offset),
+                           MPI_BYTE,
+                           0,
+                           group_root_communicator);
+          AssertThrowMPI(ierr);
+        }
+
+      ierr = MPI_Comm_free(&group_root_communicator);
+      AssertThrowMPI(ierr);
+    }
+
+  // Make the data written by the group root visible to all processes of
+  // the group.
+  ierr = MPI_Win_fence(0, window);
+  AssertThrowMPI(ierr);
+
+  // Release our own memory and point to the window instead. Releasing the
+  // window again is a collective operation on the group.
+  clear();
+  elements = decltype(elements)(shared_data,
+                                [window, shmem_communicator](T *) mutable {
+                                  int ierr = MPI_Win_free(&window);
+                                  AssertNothrow(ierr == MPI_SUCCESS,
+                                                ExcMPI(ierr));
+                                  ierr = MPI_Comm_free(&shmem_communicator);
+                                  AssertNothrow(ierr == MPI_SUCCESS,
+                                                ExcMPI(ierr));
+                                  (void)ierr;
+                                });
+  used_elements_end      = elements.get() + n_elements;
+  allocated_elements_end = used_elements_end;
+#  else
+  (void)communicator;
+  (void)root_process;
+#  endif
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::enable_huge_pages(const bool use_huge_pages)
+{
+  this->use_huge_pages = use_huge_pages;
+}
+
+
+
+template <class T>
+inline void
+AlignedVector<T>::map_file(const std::string &filename,
+                           const std::size_t  offset,
+                           const size_type    n_elements,
+                           const bool         write_through)
+{
+  AssertThrow(std::is_trivially_copyable<T>::value,
+              ExcMessage(
+                "Only trivially copyable types can be mapped from a file."));
+  AssertThrow(offset % alignof(T) == 0,
+              ExcMessage("The data in the file " + filename +
+                         " is not aligned to the alignment of the element "
+                         "type."));
+
+  clear();
+  if (n_elements == 0)
+    return;
+
+  const auto mapping = Utilities::System::map_file(filename,
+                                                   offset,
+                                                   n_elements * sizeof(T),
+                                                   write_through);
+
+  const std::function<void()> unmap = mapping.second;
+  elements = decltype(elements)(static_cast<T *>(mapping.first),
+                                [unmap](T *) { unmap(); });
+  used_elements_end      = elements.get() + n_elements;
+  allocated_elements_end = used_elements_end;
+}
+
+
+
 template <class T>
 inline void
 AlignedVector<T>::swap(AlignedVector<T> &vec)
@@ -1043,6 +1327,7 @@ AlignedVector<T>::swap(AlignedVector<T> &vec)
   std::swap(elements, vec.elements);
   std::swap(used_elements_end, vec.used_elements_end);
   std::swap(allocated_elements_end, vec.allocated_elements_end);
+  std::swap(use_huge_pages, vec.use_huge_pages);
 }
 
 
@@ -32,6 +32,8 @@
 #include <boost/serialization/map.hpp>
 
 #include <limits>
+#include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <typeinfo>
@@ -1169,6 +1171,22 @@ namespace DataOutBase
      */
     bool write_higher_order_cells;
 
+    /**
+     * The size, in bytes, of the blocks into which the binary data of the
+     * VTU output is split before compression. Blocks are compressed
+     * independently of each other and in parallel, so choosing a block size
+     * that is considerably smaller than the data written for one field
+     * (say, a few hundred kilobytes to a few megabytes) lets the
+     * compression use all available threads. The price is a slightly larger
+     * file since every block is compressed on its own.
+     *
+     * If zero, all data of one field is compressed as a single block. This
+     * is the default.
+     *
+     * The flag is only used if deal.II was configured with zlib.
+     */
+    unsigned int compression_block_size;
+
     /**
      * Constructor.
      */
@@ -1177,7 +1195,8 @@ namespace DataOutBase
       const unsigned int cycle = std::numeric_limits<unsigned int>::min(),
       const bool         print_date_and_time              = true,
       const ZlibCompressionLevel compression_level        = best_compression,
-      const bool                 write_higher_order_cells = false);
+      const bool                 write_higher_order_cells = false,
+      const unsigned int         compression_block_size   = 0);
   };
 
 
@@ -1277,11 +1296,32 @@ namespace DataOutBase
      */
     bool xdmf_hdf5_output;
 
+    /**
+     * The number of rows (i.e., nodes or cells) per chunk of the datasets
+     * written by DataOutBase::write_hdf5_parallel(). If zero, and no
+     * compression is requested, datasets are stored contiguously. Chunked
+     * storage is a prerequisite for compression.
+     */
+    unsigned int hdf5_chunk_size;
+
+    /**
+     * The gzip compression level, between 0 and 9, that is applied to the
+     * datasets written by DataOutBase::write_hdf5_parallel(). Zero means no
+     * compression. If compression is requested but @p hdf5_chunk_size is
+     * zero, a chunk size of 65536 rows is used.
+     *
+     * @note Writing compressed datasets in parallel requires HDF5 version
+     * 1.10.2 or newer.
+     */
+    unsigned int hdf5_compression_level;
+
     /**
      * Constructor.
      */
-    DataOutFilterFlags(const bool filter_duplicate_vertices = false,
-                       const bool xdmf_hdf5_output          = false);
+    DataOutFilterFlags(const bool         filter_duplicate_vertices = false,
+                       const bool         xdmf_hdf5_output          = false,
+                       const unsigned int hdf5_chunk_size           = 0,
+                       const unsigned int hdf5_compression_level    = 0);
 
     /**
      * Declare all flags with name and type as offered by this class, for use
@@ -1438,6 +1478,12 @@ namespace DataOutBase
     unsigned int
     n_data_sets() const;
 
+    /**
+     * Return the flags this object was constructed with.
+     */
+    const DataOutBase::DataOutFilterFlags &
+    get_flags() const;
+
     /**
      * Empty functions to do base class inheritance.
      */
@@ -1539,6 +1585,94 @@ namespace DataOutBase
   };
 
 
+
+  /**
+   * A class that writes the contents of a DataOutFilter object through the
+   * ADIOS2 library, as a sequence of steps of a single output stream. In
+   * contrast to the file based writers like write_vtu() or
+   * write_hdf5_parallel(), which produce a new file for every time step,
+   * the ADIOS2 engine selected in the constructor decides where the data
+   * goes: the "BP5" engine writes all steps to one ADIOS2 file, and with the
+   * engine parameter <tt>AsyncWrite=true</tt> the file system is accessed
+   * in the background while the computation continues. The "SST" engine
+   * sends the data directly to a separate reader program, e.g., an analysis
+   * or visualization job running on other nodes, without going through the
+   * file system at all.
+   *
+   * Every call to write() adds one step containing the following variables,
+   * which are global arrays that every process contributes its part to:
+   * <ul>
+   * <li> "nodes": the coordinates of the points, of shape (number of points,
+   * space dimension),
+   * <li> "cells": the indices of the vertices of all cells, of shape (number
+   * of cells, vertices per cell), using the same ordering as
+   * write_hdf5_parallel(),
+   * <li> one variable per data set, named as the data set, of shape (number
+   * of points, components of the data set),
+   * <li> "time": the time passed to write() as a single value.
+   * </ul>
+   * All arrays are handed over to ADIOS2 before write() returns, so the
+   * DataOutFilter can be reused or destroyed right away. A typical use is
+   * @code
+   * DataOutBase::ADIOS2Writer writer("solution.bp",
+   *                                  MPI_COMM_WORLD,
+   *                                  "BP5",
+   *                                  {{"AsyncWrite", "true"}});
+   * for (...time steps...)
+   *   {
+   *     ...
+   *     data_out.build_patches();
+   *     DataOutBase::DataOutFilter data_filter(
+   *       DataOutBase::DataOutFilterFlags(true, true));
+   *     data_out.write_filtered_data(data_filter);
+   *     writer.write(data_filter, time);
+   *   }
+   * @endcode
+   *
+   * This class can only be used if deal.II was configured with ADIOS2
+   * support, otherwise the constructor throws an exception.
+   */
+  class ADIOS2Writer
+  {
+  public:
+    /**
+     * Constructor. Open the output stream @p name, which is a file name for
+     * file based engines and a stream name the readers connect to for
+     * staging engines, with the ADIOS2 engine @p engine_type, collectively
+     * on all processes of @p comm. The @p engine_parameters are passed on to
+     * the engine unchanged; see the ADIOS2 documentation for the available
+     * parameters.
+     */
+    ADIOS2Writer(
+      const std::string &                       name,
+      const MPI_Comm &                          comm,
+      const std::string &                       engine_type = "BP5",
+      const std::map<std::string, std::string> &engine_parameters = {});
+
+    /**
+     * Destructor. Close the output stream, which waits for outstanding
+     * asynchronous writes to complete.
+     */
+    ~ADIOS2Writer();
+
+    /**
+     * Write the mesh and the data sets of @p data_filter as a new step of
+     * the output stream, marked with the given @p time. This function is
+     * collective on the communicator given to the constructor.
+     */
+    void
+    write(const DataOutFilter &data_filter, const double time);
+
+  private:
+    /**
+     * The ADIOS2 objects, which are hidden from this header so that it does
+     * not depend on the ADIOS2 headers.
+     */
+    struct Implementation;
+    std::unique_ptr<Implementation> implementation;
+  };
+
+
   /**
    * Provide a data type specifying the presently supported output formats.
    */
@@ -2655,10 +2789,23 @@ public:
    * one used by the computation.  This routine uses MPI I/O to achieve high
    * performance on parallel filesystems. Also see
    * DataOutInterface::write_vtu().
+   *
+   * By default, every process writes its own piece of the file, which
+   * leads to many small and unaligned write requests if there are many
+   * processes. If @p n_aggregators is nonzero, output instead happens in
+   * two phases: Every process first compresses and encodes its piece, and
+   * sends it to one of @p n_aggregators aggregator processes, each
+   * responsible for a contiguous range of ranks of @p comm. The aggregators
+   * then write the combined data of their group with a single collective
+   * write call. A good choice for @p n_aggregators is the number of compute
+   * nodes in use (if ranks are placed on nodes in blocks) or the number of
+   * storage targets the file is striped over. Memory consumption on the
+   * aggregators grows with the size of the data of the group.
    */
   void
   write_vtu_in_parallel(const std::string &filename,
-                        const MPI_Comm &   comm) const;
+                        const MPI_Comm &   comm,
+                        const unsigned int n_aggregators = 0) const;
 
   /**
    * Some visualization programs, such as ParaView, can read several separate
@@ -2738,7 +2885,9 @@ public:
    * default value of @p n_groups is 0, meaning that every MPI rank will write one
    * file. A value of 1 will generate one big file containing the solution over
    * the whole domain, while a larger value will create @p n_groups files (but not
-   * more than there are MPI ranks).
+   * more than there are MPI ranks). If files are written through
+   * write_vtu_in_parallel(), @p n_aggregators is passed on to that function
+   * and is used within each group.
    *
    * Note that only one processor needs to
    * generate the .pvtu file, where processor zero is chosen to take over this
@@ -2762,7 +2911,8 @@ public:
     const unsigned int counter,
     const MPI_Comm &   mpi_communicator,
     const unsigned int n_digits_for_counter = numbers::invalid_unsigned_int,
-    const unsigned int n_groups             = 0) const;
+    const unsigned int n_groups             = 0,
+    const unsigned int n_aggregators        = 0) const;
 
   /**
    * Obtain data through get_patches() and write it to <tt>out</tt> in SVG
@@ -25,6 +25,7 @@
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <functional>
 #include <vector>
@@ -261,6 +262,29 @@ public:
   vector_value_list(const std::vector<Point<dim>> &       points,
                     std::vector<Vector<RangeNumberType>> &values) const;
 
+  /**
+   * Set <tt>values</tt> to the point values of the function at a list of
+   * points that is given in batches of VectorizedArray<double>::size()
+   * points, i.e., the coordinates of the point with index <tt>q</tt> are
+   * stored in lane <tt>q % VectorizedArray<double>::size()</tt> of
+   * <tt>points[q / VectorizedArray<double>::size()]</tt>. The number of
+   * points is given by the size of <tt>values</tt>, which needs to be set
+   * beforehand, with all elements being vectors with the same number of
+   * components as this function has. Lanes of the last batch beyond this
+   * number are not evaluated, but they should still hold valid coordinates,
+   * e.g., copies of the last point.
+   *
+   * This is the function VectorTools::interpolate() evaluates functions
+   * through. Derived classes can reimplement it to evaluate the function for
+   * all points of a batch at once with the arithmetic operations of
+   * VectorizedArray. By default, this function unpacks the points and calls
+   * vector_value_list().
+   */
+  virtual void
+  vectorized_vector_value_list(
+    const std::vector<Point<dim, VectorizedArray<double>>> &points,
+    std::vector<Vector<RangeNumberType>> &                  values) const;
+
   /**
    * For each component of the function, fill a vector of values, one for each
    * point.
@@ -114,6 +114,26 @@ Function<dim, RangeNumberType>::vector_value_list(
 }
 
 
+template <int dim, typename RangeNumberType>
+void
+Function<dim, RangeNumberType>::vectorized_vector_value_list(
+  const std::vector<Point<dim, VectorizedArray<double>>> &points,
+  std::vector<Vector<RangeNumberType>> &                  values) const
+{
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+  Assert(values.size() <= points.size() * n_lanes &&
+           values.size() + n_lanes > points.size() * n_lanes,
+         ExcDimensionMismatch(values.size(), points.size() * n_lanes));
+
+  std::vector<Point<dim>> unpacked_points(values.size());
+  for (unsigned int q = 0; q < values.size(); ++q)
+    for (unsigned int d = 0; d < dim; ++d)
+      unpacked_points[q][d] = points[q / n_lanes][d][q % n_lanes];
+
+  this->vector_value_list(unpacked_points, values);
+}
+
+
 template <int dim, typename RangeNumberType>
 void
 Function<dim, RangeNumberType>::vector_values(
@@ -59,6 +59,10 @@ namespace Functions
     value_list(const std::vector<Point<dim>> &points,
                std::vector<double> &          values,
                const unsigned int             component = 0) const override;
+    virtual void
+    vectorized_vector_value_list(
+      const std::vector<Point<dim, VectorizedArray<double>>> &points,
+      std::vector<Vector<double>> &values) const override;
     virtual Tensor<1, dim>
     gradient(const Point<dim> & p,
              const unsigned int component = 0) const override;
@@ -102,6 +106,11 @@ namespace Functions
     vector_value_list(const std::vector<Point<dim>> &points,
                       std::vector<Vector<double>> &  values) const override;
 
+    virtual void
+    vectorized_vector_value_list(
+      const std::vector<Point<dim, VectorizedArray<double>>> &points,
+      std::vector<Vector<double>> &values) const override;
+
     virtual Tensor<1, dim>
     gradient(const Point<dim> & p,
              const unsigned int component = 0) const override;
@@ -237,6 +246,11 @@ namespace Functions
     vector_value_list(const std::vector<Point<dim>> &points,
                       std::vector<Vector<double>> &  values) const override;
 
+    virtual void
+    vectorized_vector_value_list(
+      const std::vector<Point<dim, VectorizedArray<double>>> &points,
+      std::vector<Vector<double>> &values) const override;
+
     virtual Tensor<1, dim>
     gradient(const Point<dim> & p,
              const unsigned int component = 0) const override;
@@ -347,6 +361,15 @@ namespace Functions
                std::vector<double> &          values,
                const unsigned int             component = 0) const override;
 
+    /**
+     * Values at multiple points, given in batches of
+     * VectorizedArray<double>::size() points.
+     */
+    virtual void
+    vectorized_vector_value_list(
+      const std::vector<Point<dim, VectorizedArray<double>>> &points,
+      std::vector<Vector<double>> &values) const override;
+
     /**
      * Gradient at a single point.
      */
@@ -727,6 +750,15 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    /**
+     * Values at multiple points, given in batches of
+     * VectorizedArray<double>::size() points.
+     */
+    virtual void
+    vectorized_vector_value_list(
+      const std::vector<Point<dim, VectorizedArray<double>>> &points,
+      std::vector<Vector<double>> &values) const override;
+
     /**
      * Return the gradient of the specified component of the function at the
      * given point.
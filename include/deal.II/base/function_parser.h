@@ -40,6 +40,14 @@ DEAL_II_NAMESPACE_OPEN
 #ifndef DOXYGEN
 template <typename>
 class Vector;
+
+namespace internal
+{
+  namespace FunctionParser
+  {
+    class CompiledExpressions;
+  }
+} // namespace internal
 #endif
 
 /**
@@ -211,6 +219,34 @@ class Vector;
  *                        constants);
  * @endcode
  *
+ * <h3>Compiled evaluation</h3>
+ *
+ * muparser interprets the byte code of an expression every time it is
+ * evaluated, which for functions evaluated at every quadrature point of a
+ * mesh can become more expensive than the actual assembly. If deal.II is
+ * configured with SymEngine, the expressions can additionally be compiled
+ * into native code by calling compile() after initialize(). The expressions
+ * are then parsed by SymEngine and optimized by a
+ * Differentiation::SD::BatchOptimizer, using LLVM if SymEngine was built
+ * with it and SymEngine's lambda functions otherwise, and all further
+ * evaluations use the compiled functions:
+ * @code
+ *    FunctionParser<2> function(2);
+ *    function.initialize("x,y", "cos(2*pi*x)*y^2; sin(2*pi*x)*exp(y)",
+ *                        {{"pi", numbers::PI}});
+ *    function.compile();
+ * @endcode
+ * Only expressions consisting of the variables, the constants, the
+ * arithmetic operators and the common mathematical functions that both
+ * libraries interpret in the same way (<code>sin, cos, tan, asin, acos, atan,
+ * sinh, cosh, tanh, asinh, acosh, atanh, atan2, exp, sqrt, abs, log,
+ * pow</code>) can be compiled. For all other expressions, in particular those
+ * using <code>if</code>, the ternary operator, comparisons or random numbers,
+ * compile() returns false and the function continues to be evaluated by
+ * muparser. As for muparser, the compiled functions are created separately
+ * on each thread that evaluates the function, so the first evaluation on a
+ * new thread incurs the cost of compilation.
+ *
  * @note The difference between this class and the SymbolicFunction class is
  * that the SymbolicFunction class allows to compute first and second order
  * derivatives (in a symbolic way), while this class computes first order
@@ -344,6 +380,26 @@ public:
   static std::string
   default_variable_names();
 
+  /**
+   * Compile the expressions given to initialize() into native code, see the
+   * section on compiled evaluation in the documentation of this class. This
+   * function has to be called after initialize(), and a later call to
+   * initialize() reverts to evaluation by muparser.
+   *
+   * Return whether the expressions could be compiled. If they could not, or
+   * if deal.II was not configured with SymEngine, the function is still
+   * usable and evaluated by muparser.
+   */
+  bool
+  compile();
+
+  /**
+   * Return whether the function is evaluated through compiled expressions,
+   * i.e., whether the last call to compile() was successful.
+   */
+  bool
+  is_compiled() const;
+
   /**
    * Return the value of the function at the given point. Unless there is only
    * one component (i.e., the function is scalar), you should state the
@@ -363,6 +419,15 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<double> &values) const override;
 
+  /**
+   * Return all components of the function at the given points. In contrast
+   * to the default implementation, the thread-local parser objects are
+   * looked up only once for all points, rather than once for every point.
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>> &  values) const override;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
@@ -424,6 +489,29 @@ private:
    */
   void
   init_muparser() const;
+
+  /**
+   * The compiled expressions for each thread, if compile() was successful.
+   * As for the muparser objects, we are storing a unique_ptr so that we don't
+   * need to include the SymEngine headers here.
+   */
+  mutable Threads::ThreadLocalStorage<
+    std::unique_ptr<internal::FunctionParser::CompiledExpressions>>
+    compiled_fp;
+
+  /**
+   * Initialize compiled_fp on the current thread. Like init_muparser(), this
+   * function may only be called once per thread.
+   */
+  void
+  init_compiled_expressions() const;
+
+  /**
+   * Evaluate all components at the point @p p through the compiled
+   * expressions of the current thread, initializing them if necessary.
+   */
+  const std::vector<double> &
+  evaluate_compiled(const Point<dim> &p) const;
 #endif
 
   /**
@@ -438,6 +526,12 @@ private:
    */
   bool initialized;
 
+  /**
+   * Whether the function is evaluated through the compiled expressions in
+   * compiled_fp rather than through muparser.
+   */
+  bool compiled;
+
   /**
    * Number of variables. If this is also a function of time, then the number
    * of variables is dim+1, otherwise it is dim. In the case that this is a
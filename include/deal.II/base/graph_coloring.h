@@ -20,11 +20,16 @@
 
 #  include <deal.II/base/config.h>
 
+#  include <deal.II/base/numbers.h>
+#  include <deal.II/base/parallel.h>
 #  include <deal.II/base/thread_management.h>
 
 #  include <deal.II/lac/sparsity_tools.h>
 
+#  include <algorithm>
+#  include <atomic>
 #  include <functional>
+#  include <numeric>
 #  include <set>
 #  include <unordered_map>
 #  include <unordered_set>
@@ -569,6 +574,240 @@ namespace GraphColoring
     return internal::gather_colors(partition_coloring);
   }
 
+
+
+  /**
+   * Create a coloring of the given range of iterators with the same meaning
+   * as the one computed by make_graph_coloring(), but with an algorithm that
+   * runs in parallel on all threads available to the library and is
+   * therefore better suited for large ranges that need to be recolored
+   * often, such as the cells of a mesh after each adaptive refinement.
+   *
+   * The function first calls @p get_conflict_indices for all elements of the
+   * range in parallel, so it must be safe to call @p get_conflict_indices
+   * concurrently from several threads. It then uses a speculative coloring
+   * in the spirit of Gebremedhin and Manne: all elements that still need a
+   * color are colored in parallel, where each element picks among the
+   * colors not used by its neighbors the one with the fewest elements so
+   * far, which balances the sizes of the colors. Since neighbors may be
+   * colored at the same time, a second parallel sweep looks for pairs of
+   * conflicting elements with the same color and puts the element further
+   * back in the range into the set of elements that are colored again in
+   * the next round. This process typically terminates after very few
+   * rounds, since conflicts are rare when the number of elements is much
+   * larger than the number of threads.
+   *
+   * In contrast to make_graph_coloring(), the result generally depends on
+   * the timing of the threads, i.e., it may differ between calls. The
+   * elements within each color are sorted in the order of the range. The
+   * memory needed by this function grows with the largest conflict index
+   * returned by @p get_conflict_indices, which is appropriate for global
+   * indices of degrees of freedom but not for arbitrary labels.
+   *
+   * @param[in] begin The first element of a range of iterators for which a
+   * coloring is sought.
+   * @param[in] end The element past the end of the range of iterators.
+   * @param[in] get_conflict_indices A user defined function object returning
+   * a set of indicators that are descriptive of what represents a conflict.
+   * See make_graph_coloring() for a more thorough discussion.
+   * @return A set of sets of iterators (where sets are represented by
+   * std::vector for efficiency). Each element of the outermost set
+   * corresponds to the iterators pointing to objects that are in the same
+   * partition (have the same color) and consequently do not conflict. The
+   * elements of different sets may conflict.
+   */
+  template <typename Iterator>
+  std::vector<std::vector<Iterator>>
+  make_parallel_graph_coloring(
+    const Iterator &                               begin,
+    const typename identity<Iterator>::type &      end,
+    const std::function<std::vector<types::global_dof_index>(
+      const typename identity<Iterator>::type &)> &get_conflict_indices)
+  {
+    const unsigned int invalid    = numbers::invalid_unsigned_int;
+    const unsigned int grain_size = 64;
+
+    std::vector<Iterator> iterators;
+    for (Iterator it = begin; it != end; ++it)
+      iterators.push_back(it);
+    const unsigned int n_vertices = iterators.size();
+
+    // get the conflict indices of all iterators in parallel and sort them,
+    // eliminating duplicates
+    std::vector<std::vector<types::global_dof_index>> conflict_indices(
+      n_vertices);
+    parallel::apply_to_subranges(
+      0U,
+      n_vertices,
+      [&](const unsigned int range_begin, const unsigned int range_end) {
+        for (unsigned int v = range_begin; v < range_end; ++v)
+          {
+            std::vector<types::global_dof_index> &indices =
+              conflict_indices[v];
+            indices = get_conflict_indices(iterators[v]);
+            std::sort(indices.begin(), indices.end());
+            indices.erase(std::unique(indices.begin(), indices.end()),
+                          indices.end());
+          }
+      },
+      grain_size);
+
+    // invert the relation, i.e., store the vertices that share each conflict
+    // index in a compressed row format. the vertices of each index are
+    // sorted in ascending order
+    types::global_dof_index n_indices = 0;
+    for (const auto &indices : conflict_indices)
+      if (indices.size() > 0)
+        n_indices = std::max(n_indices, indices.back() + 1);
+
+    std::vector<std::size_t> index_row_starts(n_indices + 1, 0);
+    for (const auto &indices : conflict_indices)
+      for (const auto index : indices)
+        ++index_row_starts[index + 1];
+    std::partial_sum(index_row_starts.begin(),
+                     index_row_starts.end(),
+                     index_row_starts.begin());
+
+    std::vector<unsigned int> index_vertices(index_row_starts.back());
+    {
+      std::vector<std::size_t> next_position(index_row_starts.begin(),
+                                             index_row_starts.end() - 1);
+      for (unsigned int v = 0; v < n_vertices; ++v)
+        for (const auto index : conflict_indices[v])
+          index_vertices[next_position[index]++] = v;
+    }
+
+    // the number of colors is bounded by the maximal number of neighbors
+    // plus one, where neighbors that share several indices are counted
+    // several times
+    unsigned int max_n_colors = 1;
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      {
+        std::size_t n_neighbors = 0;
+        for (const auto index : conflict_indices[v])
+          n_neighbors +=
+            index_row_starts[index + 1] - index_row_starts[index] - 1;
+        max_n_colors = std::max<unsigned int>(max_n_colors, n_neighbors + 1);
+      }
+
+    // the colors of the vertices and the number of vertices of each color.
+    // both are accessed concurrently while coloring
+    std::vector<std::atomic<unsigned int>> colors(n_vertices);
+    for (auto &color : colors)
+      color.store(invalid);
+    std::vector<std::atomic<unsigned int>> color_sizes(max_n_colors);
+    for (auto &size : color_sizes)
+      size.store(0);
+
+    std::vector<unsigned int> worklist(n_vertices);
+    std::iota(worklist.begin(), worklist.end(), 0U);
+    std::vector<unsigned char> needs_recoloring;
+
+    while (worklist.size() > 0)
+      {
+        // tentatively color all vertices on the worklist. each vertex takes
+        // the color with the fewest vertices among those used so far that are
+        // not used by any of its neighbors, or a new color if there is none
+        parallel::apply_to_subranges(
+          0U,
+          worklist.size(),
+          [&](const unsigned int range_begin, const unsigned int range_end) {
+            // mark the colors of the neighbors of vertex v with v, which
+            // avoids resetting the array for every vertex
+            std::vector<unsigned int> forbidden_colors(max_n_colors, invalid);
+            for (unsigned int k = range_begin; k < range_end; ++k)
+              {
+                const unsigned int v = worklist[k];
+                for (const auto index : conflict_indices[v])
+                  for (std::size_t p = index_row_starts[index];
+                       p < index_row_starts[index + 1];
+                       ++p)
+                    {
+                      const unsigned int color =
+                        colors[index_vertices[p]].load(
+                          std::memory_order_relaxed);
+                      if (index_vertices[p] != v && color != invalid)
+                        forbidden_colors[color] = v;
+                    }
+
+                unsigned int best_color = invalid;
+                for (unsigned int c = 0; c < max_n_colors; ++c)
+                  if (forbidden_colors[c] != v)
+                    {
+                      const unsigned int size = color_sizes[c].load();
+                      if (size == 0)
+                        {
+                          // the first unused color: only take it if none of
+                          // the colors used so far is admissible
+                          if (best_color == invalid)
+                            best_color = c;
+                          break;
+                        }
+                      else if (best_color == invalid ||
+                               size < color_sizes[best_color].load())
+                        best_color = c;
+                    }
+                Assert(best_color != invalid, ExcInternalError());
+
+                colors[v].store(best_color, std::memory_order_relaxed);
+                ++color_sizes[best_color];
+              }
+          },
+          grain_size);
+
+        // detect the conflicts created by neighbors that were colored at the
+        // same time. of two conflicting vertices, the one with the larger
+        // number is colored again
+        needs_recoloring.assign(worklist.size(), 0);
+        parallel::apply_to_subranges(
+          0U,
+          worklist.size(),
+          [&](const unsigned int range_begin, const unsigned int range_end) {
+            for (unsigned int k = range_begin; k < range_end; ++k)
+              {
+                const unsigned int v     = worklist[k];
+                const unsigned int color = colors[v].load();
+                for (const auto index : conflict_indices[v])
+                  for (std::size_t p = index_row_starts[index];
+                       p < index_row_starts[index + 1] &&
+                       index_vertices[p] < v;
+                       ++p)
+                    if (colors[index_vertices[p]].load() == color)
+                      needs_recoloring[k] = 1;
+              }
+          },
+          grain_size);
+
+        std::vector<unsigned int> new_worklist;
+        for (unsigned int k = 0; k < worklist.size(); ++k)
+          if (needs_recoloring[k] != 0)
+            {
+              const unsigned int v = worklist[k];
+              --color_sizes[colors[v].load()];
+              colors[v].store(invalid);
+              new_worklist.push_back(v);
+            }
+        worklist.swap(new_worklist);
+      }
+
+    // collect the iterators of each color, skipping colors that lost all of
+    // their vertices during the recoloring
+    std::vector<unsigned int> color_numbers(max_n_colors, invalid);
+    unsigned int              n_colors = 0;
+    for (unsigned int c = 0; c < max_n_colors; ++c)
+      if (color_sizes[c].load() > 0)
+        color_numbers[c] = n_colors++;
+
+    std::vector<std::vector<Iterator>> coloring(n_colors);
+    for (unsigned int c = 0; c < max_n_colors; ++c)
+      if (color_numbers[c] != invalid)
+        coloring[color_numbers[c]].reserve(color_sizes[c].load());
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      coloring[color_numbers[colors[v].load()]].push_back(iterators[v]);
+
+    return coloring;
+  }
+
   /**
    * GraphColoring::color_sparsity_pattern, a wrapper function for
    * SparsityTools::color_sparsity_pattern, is an alternate method for
@@ -943,7 +943,9 @@ private:
 
   /**
    * A set of contiguous ranges of indices that make up (part of) this index
-   * set. This variable is always kept sorted.
+   * set. This variable is sorted and free of overlaps after compress() has
+   * been called. Ranges added since then are appended at the end and may be
+   * out of order.
    *
    * The variable is marked "mutable" so that it can be changed by compress(),
    * though this of course doesn't change anything about the external
@@ -1654,16 +1656,14 @@ IndexSet::add_index(const size_type index)
 {
   AssertIndexRange(index, index_space_size);
 
-  const Range new_range(index, index + 1);
-  if (ranges.size() == 0 || index > ranges.back().end)
-    ranges.push_back(new_range);
-  else if (index == ranges.back().end)
+  // extend the last range if possible. otherwise append the new index as a
+  // range of its own, even if this leaves the ranges unsorted: inserting
+  // into the middle of the vector of ranges would make adding many
+  // scattered indices quadratic. do_compress() sorts them later on
+  if (ranges.size() > 0 && index == ranges.back().end)
     ranges.back().end++;
   else
-    ranges.insert(Utilities::lower_bound(ranges.begin(),
-                                         ranges.end(),
-                                         new_range),
-                  new_range);
+    ranges.emplace_back(index, index + 1);
   is_compressed = false;
 }
 
@@ -1681,17 +1681,9 @@ IndexSet::add_range(const size_type begin, const size_type end)
 
   if (begin != end)
     {
-      const Range new_range(begin, end);
-
-      // the new index might be larger than the last index present in the
-      // ranges. Then we can skip the binary search
-      if (ranges.size() == 0 || begin > ranges.back().end)
-        ranges.push_back(new_range);
-      else
-        ranges.insert(Utilities::lower_bound(ranges.begin(),
-                                             ranges.end(),
-                                             new_range),
-                      new_range);
+      // as in add_index(), simply append the new range. do_compress() sorts
+      // and merges the ranges
+      ranges.emplace_back(begin, end);
       is_compressed = false;
     }
 }
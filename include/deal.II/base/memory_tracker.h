@@ -0,0 +1,238 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_memory_tracker_h
+#define dealii_memory_tracker_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A namespace for keeping track of the memory that the main data structures
+ * of the library allocate while the program runs.
+ *
+ * The functions in the MemoryConsumption namespace compute the memory
+ * consumption of individual objects when asked to. This does not help in
+ * finding the phase of a program in which its memory consumption peaks,
+ * because that peak is often caused by temporary objects that only live
+ * within some library function, such as sparsity patterns built during the
+ * setup of a matrix, or the patches created by DataOut::build_patches().
+ *
+ * If enabled by calling MemoryTracker::enable(), the following data
+ * structures report each allocation and deallocation to this namespace:
+ * - AlignedVector, and hence all classes that store their data in one, such
+ *   as Vector, FullMatrix, Table, or the data of the patches created by
+ *   DataOut,
+ * - SparsityPattern,
+ * - DynamicSparsityPattern.
+ *
+ * The allocations are attributed to a Subsystem. SparsityPattern and
+ * DynamicSparsityPattern always use their own subsystem. The subsystem of
+ * an allocation in AlignedVector is the one of the innermost
+ * MemoryTracker::Scope object that is alive on the calling thread when the
+ * memory is allocated, or Subsystem::general if there is none. The library
+ * uses such scopes in Vector and in DataOut::build_patches(), and user code
+ * can do the same around its own phases.
+ *
+ * For each subsystem, the number of bytes currently allocated and the
+ * maximum of this number since the tracking was enabled (or since the last
+ * call to reset_peaks()) can be queried, and print_statistics() prints
+ * these numbers as statistics over all MPI ranks. Memory that was allocated
+ * before tracking was enabled is not counted.
+ *
+ * @ingroup utilities
+ */
+namespace MemoryTracker
+{
+  /**
+   * The subsystems to which allocations can be attributed.
+   */
+  enum Subsystem : unsigned char
+  {
+    /**
+     * Allocations not attributed to a particular subsystem.
+     */
+    general,
+    /**
+     * The entries of Vector objects.
+     */
+    vector,
+    /**
+     * The arrays of SparsityPattern objects.
+     */
+    sparsity_pattern,
+    /**
+     * The rows of DynamicSparsityPattern objects.
+     */
+    dynamic_sparsity_pattern,
+    /**
+     * The patches created by DataOut::build_patches().
+     */
+    data_out,
+    /**
+     * The number of subsystems.
+     */
+    n_subsystems
+  };
+
+  /**
+   * Start tracking allocations. The current numbers of bytes and the peaks
+   * are reset to zero.
+   */
+  void
+  enable();
+
+  /**
+   * Stop tracking new allocations. Memory that was tracked while tracking
+   * was enabled is still subtracted when it is released.
+   */
+  void
+  disable();
+
+  /**
+   * Return whether allocations are currently tracked.
+   */
+  bool
+  is_enabled();
+
+  /**
+   * Record the allocation of @p n_bytes bytes by @p subsystem.
+   */
+  void
+  allocate(const Subsystem subsystem, const std::size_t n_bytes);
+
+  /**
+   * Record the release of @p n_bytes bytes by @p subsystem. The numbers
+   * must match those of an earlier call to allocate().
+   */
+  void
+  deallocate(const Subsystem subsystem, const std::size_t n_bytes);
+
+  /**
+   * Return the subsystem of the innermost Scope object alive on the calling
+   * thread, or Subsystem::general if there is none.
+   */
+  Subsystem
+  current_subsystem();
+
+  /**
+   * Return the number of bytes currently allocated by @p subsystem on this
+   * process.
+   */
+  std::size_t
+  get_current_bytes(const Subsystem subsystem);
+
+  /**
+   * Return the maximal number of bytes allocated by @p subsystem at any time
+   * on this process.
+   */
+  std::size_t
+  get_peak_bytes(const Subsystem subsystem);
+
+  /**
+   * Return the number of bytes currently allocated by all subsystems
+   * together on this process.
+   */
+  std::size_t
+  get_total_current_bytes();
+
+  /**
+   * Return the maximal number of bytes allocated by all subsystems together
+   * at any time on this process. This is in general less than the sum of the
+   * peaks of the individual subsystems.
+   */
+  std::size_t
+  get_total_peak_bytes();
+
+  /**
+   * Set the peaks to the number of bytes currently allocated, e.g. to find
+   * the peak of the next phase of a program.
+   */
+  void
+  reset_peaks();
+
+  /**
+   * Return a name for @p subsystem suitable for output.
+   */
+  std::string
+  get_name(const Subsystem subsystem);
+
+  /**
+   * Print the current and peak numbers of bytes of all subsystems to
+   * @p out, as minimum, average, and maximum over the processes in
+   * @p mpi_communicator. This is a collective operation.
+   */
+  void
+  print_statistics(std::ostream &  out,
+                   const MPI_Comm &mpi_communicator = MPI_COMM_SELF);
+
+  /**
+   * A class that attributes all allocations of AlignedVector objects on the
+   * calling thread during its lifetime to a given subsystem.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Constructor. Make @p subsystem the current subsystem of the calling
+     * thread.
+     */
+    Scope(const Subsystem subsystem);
+
+    /**
+     * Destructor. Restore the previous subsystem.
+     */
+    ~Scope();
+
+  private:
+    /**
+     * The subsystem that was current before this object was created.
+     */
+    const Subsystem previous_subsystem;
+  };
+
+
+
+  namespace internal
+  {
+    /**
+     * The flag queried by is_enabled().
+     */
+    extern std::atomic<bool> tracking_is_enabled;
+  } // namespace internal
+
+
+
+  /* ---------------------- inline functions ---------------------- */
+
+  inline bool
+  is_enabled()
+  {
+    return internal::tracking_is_enabled.load(std::memory_order_relaxed);
+  }
+} // namespace MemoryTracker
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -23,6 +23,7 @@
 #include <deal.II/base/mpi_tags.h>
 #include <deal.II/base/numbers.h>
 
+#include <functional>
 #include <map>
 #include <numeric>
 #include <set>
@@ -413,6 +414,107 @@ namespace Utilities
 
 
 
+    /**
+     * An object that represents the result of a nonblocking collective
+     * operation such as isum() or imax(), in the spirit of std::future. The
+     * operation is started by the function that returns the object and runs
+     * in the background, so that other work can be done before its result is
+     * needed. The result is then obtained by calling get(), which waits for
+     * the operation to complete if it has not done so yet.
+     *
+     * A typical use is to overlap a global reduction with local work:
+     * @code
+     *   Utilities::MPI::Future<double> norm =
+     *     Utilities::MPI::isum(local_norm_sqr, mpi_communicator);
+     *
+     *   // ... apply the operator to the next vector ...
+     *
+     *   const double global_norm = std::sqrt(norm.get());
+     * @endcode
+     *
+     * Objects of this type can be moved but not copied. If an object is
+     * destroyed before get() has been called, its destructor waits for the
+     * operation to complete, since the MPI library may otherwise still write
+     * into memory that has been released.
+     *
+     * @tparam T The type of the result of the operation, which may be
+     *   <code>void</code> for operations that write their result into an
+     *   array given by the caller.
+     */
+    template <typename T>
+    class Future
+    {
+    public:
+      /**
+       * Constructor. @p wait_operation blocks until the operation has
+       * completed, and @p get_and_cleanup_operation, which is called after
+       * @p wait_operation, returns the result and releases the resources of
+       * the operation.
+       */
+      Future(const std::function<void()> &wait_operation,
+             const std::function<T()> &   get_and_cleanup_operation);
+
+      /**
+       * Move constructor.
+       */
+      Future(Future &&other) noexcept;
+
+      /**
+       * Destructor. Waits for the operation to complete if get() has not been
+       * called.
+       */
+      ~Future();
+
+      /**
+       * Copying is not allowed since the result can only be obtained once.
+       */
+      Future(const Future &) = delete;
+
+      /**
+       * Copying is not allowed since the result can only be obtained once.
+       */
+      Future &
+      operator=(const Future &) = delete;
+
+      /**
+       * Wait for the operation to complete. Calling this function more than
+       * once is allowed and does nothing after the first call.
+       */
+      void
+      wait();
+
+      /**
+       * Wait for the operation to complete and return its result. This
+       * function may only be called once.
+       */
+      T
+      get();
+
+    private:
+      /**
+       * The function that waits for the operation to complete.
+       */
+      std::function<void()> wait_function;
+
+      /**
+       * The function that returns the result and releases the resources of
+       * the operation.
+       */
+      std::function<T()> get_and_cleanup_function;
+
+      /**
+       * Whether wait() has been called.
+       */
+      bool is_done;
+
+      /**
+       * Whether get() has been called, or the object has been moved from.
+       */
+      bool get_was_called;
+    };
+
+
+
     /**
      * If @p comm is an intracommunicator, this function returns a new
      * communicator @p newcomm with communication group defined by the
@@ -854,6 +956,119 @@ namespace Utilities
                 const MPI_Comm &               mpi_communicator);
 
 
+    /**
+     * Start the computation of the sum over all processors of the value
+     * @p t, like sum(), but without blocking. The result is obtained from the
+     * returned object, see the Future class. This allows to overlap the
+     * communication of a global reduction, e.g., of a norm or a residual,
+     * with other work. The function corresponds to the
+     * <code>MPI_Iallreduce</code> function, which is part of MPI 3.0; if
+     * deal.II is configured with an older MPI version, the reduction is done
+     * immediately by a blocking call.
+     *
+     * The function is implemented for the same types as sum(), including
+     * Tensor and SymmetricTensor objects.
+     *
+     * @note As with all nonblocking collective operations, all processes
+     * need to start the operations on a communicator in the same order.
+     */
+    template <typename T>
+    Future<T>
+    isum(const T &t, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Start an MPI sum of the entries of a symmetric tensor without
+     * blocking. See isum() for details.
+     *
+     * @relatesalso SymmetricTensor
+     */
+    template <int rank, int dim, typename Number>
+    Future<SymmetricTensor<rank, dim, Number>>
+    isum(const SymmetricTensor<rank, dim, Number> &local,
+         const MPI_Comm &                          mpi_communicator);
+
+    /**
+     * Start an MPI sum of the entries of a tensor without blocking. See
+     * isum() for details.
+     *
+     * @relatesalso Tensor
+     */
+    template <int rank, int dim, typename Number>
+    Future<Tensor<rank, dim, Number>>
+    isum(const Tensor<rank, dim, Number> &local,
+         const MPI_Comm &                 mpi_communicator);
+
+    /**
+     * Like the previous function, but take the sums over the elements of an
+     * array as specified by the ArrayView arguments. The arrays must not be
+     * changed or destroyed until the operation has completed, i.e., until
+     * get() has been called on the returned object.
+     *
+     * Input and output arrays may be the same.
+     */
+    template <typename T>
+    Future<void>
+    isum(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      sums);
+
+    /**
+     * Start the computation of the maximum over all processors of the value
+     * @p t, like max(), but without blocking. See isum() for details.
+     */
+    template <typename T>
+    Future<T>
+    imax(const T &t, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Like the previous function, but take the maxima over the elements of an
+     * array as specified by the ArrayView arguments. See isum() for details.
+     */
+    template <typename T>
+    Future<void>
+    imax(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      maxima);
+
+    /**
+     * Start the computation of the minimum over all processors of the value
+     * @p t, like min(), but without blocking. See isum() for details.
+     */
+    template <typename T>
+    Future<T>
+    imin(const T &t, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Like the previous function, but take the minima over the elements of an
+     * array as specified by the ArrayView arguments. See isum() for details.
+     */
+    template <typename T>
+    Future<void>
+    imin(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      minima);
+
+    /**
+     * Start the computation of min_max_avg() without blocking. See isum() for
+     * details.
+     */
+    Future<MinMaxAvg>
+    imin_max_avg(const double my_value, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Like the previous function, but for each entry of an ArrayView. The
+     * arrays must not be changed or destroyed until the operation has
+     * completed, i.e., until get() has been called on the returned object.
+     *
+     * @pre Size of the input ArrayView has to be the same on all processes
+     *   and the input and output ArrayView have to have the same size.
+     */
+    Future<void>
+    imin_max_avg(const ArrayView<const double> &my_values,
+                 const ArrayView<MinMaxAvg> &   result,
+                 const MPI_Comm &               mpi_communicator);
+
+
     /**
      * A class that is used to initialize the MPI system at the beginning of a
      * program and to shut it down again at the end. It also allows you to
@@ -1186,6 +1401,75 @@ namespace Utilities
                  const ArrayView<T> &      output);
     }
 
+
+
+    template <typename T>
+    Future<T>::Future(const std::function<void()> &wait_operation,
+                      const std::function<T()> &   get_and_cleanup_operation)
+      : wait_function(wait_operation)
+      , get_and_cleanup_function(get_and_cleanup_operation)
+      , is_done(false)
+      , get_was_called(false)
+    {}
+
+
+
+    template <typename T>
+    Future<T>::Future(Future<T> &&other) noexcept
+      : wait_function(std::move(other.wait_function))
+      , get_and_cleanup_function(std::move(other.get_and_cleanup_function))
+      , is_done(other.is_done)
+      , get_was_called(other.get_was_called)
+    {
+      other.get_was_called = true;
+    }
+
+
+
+    template <typename T>
+    Future<T>::~Future()
+    {
+      // the operation may still write into buffers that are released below,
+      // so wait for it and release its resources
+      if (get_was_called == false)
+        {
+          try
+            {
+              wait();
+              get_and_cleanup_function();
+            }
+          catch (...)
+            {}
+        }
+    }
+
+
+
+    template <typename T>
+    void
+    Future<T>::wait()
+    {
+      if (is_done == false)
+        {
+          wait_function();
+          is_done = true;
+        }
+    }
+
+
+
+    template <typename T>
+    T
+    Future<T>::get()
+    {
+      Assert(get_was_called == false,
+             ExcMessage("You can not call get() more than once on a "
+                        "Utilities::MPI::Future object."));
+      wait();
+      get_was_called = true;
+      return get_and_cleanup_function();
+    }
+
     // Since these depend on N they must live in the header file
     template <typename T, unsigned int N>
     void
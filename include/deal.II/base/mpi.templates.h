@@ -28,6 +28,7 @@
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/vector.h>
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -275,10 +276,195 @@ namespace Utilities
               std::copy(values.begin(), values.end(), output.begin());
           }
       }
+
+
+
+      /**
+       * The nonblocking version of all_reduce(). The arrays must stay alive
+       * until the operation has completed.
+       */
+      template <typename T>
+      Future<void>
+      iall_reduce(const MPI_Op &            mpi_op,
+                  const ArrayView<const T> &values,
+                  const MPI_Comm &          mpi_communicator,
+                  const ArrayView<T> &      output)
+      {
+        AssertDimension(values.size(), output.size());
+#ifdef DEAL_II_WITH_MPI
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+        if (job_supports_mpi())
+          {
+            const auto request = std::make_shared<MPI_Request>();
+            const int  ierr =
+              MPI_Iallreduce(values != output ?
+                               DEAL_II_MPI_CONST_CAST(values.data()) :
+                               MPI_IN_PLACE,
+                             static_cast<void *>(output.data()),
+                             static_cast<int>(values.size()),
+                             internal::mpi_type_id(values.data()),
+                             mpi_op,
+                             mpi_communicator,
+                             request.get());
+            AssertThrowMPI(ierr);
+
+            return Future<void>(
+              [request]() {
+                const int ierr = MPI_Wait(request.get(), MPI_STATUS_IGNORE);
+                AssertThrowMPI(ierr);
+              },
+              []() {});
+          }
+#  endif
+#endif
+
+        // without support for nonblocking collectives, do the reduction
+        // right away
+        all_reduce(mpi_op, values, mpi_communicator, output);
+        return Future<void>([]() {}, []() {});
+      }
+
+
+
+      /**
+       * Start the reduction of a single object whose entries can be
+       * accessed through make_array_view(), and return a Future that owns
+       * the result.
+       */
+      template <typename T, typename ArrayViewFunction>
+      Future<T>
+      iall_reduce_object(const MPI_Op &           mpi_op,
+                         const T &                t,
+                         const MPI_Comm &         mpi_communicator,
+                         const ArrayViewFunction &array_view)
+      {
+        const auto result = std::make_shared<T>(t);
+        const auto values = array_view(*result);
+        using value_type  = typename decltype(values)::value_type;
+
+        const auto reduction = std::make_shared<Future<void>>(
+          iall_reduce(mpi_op,
+                      ArrayView<const value_type>(values.data(), values.size()),
+                      mpi_communicator,
+                      values));
+
+        return Future<T>([reduction]() { reduction->wait(); },
+                         [reduction, result]() {
+                           reduction->get();
+                           return *result;
+                         });
+      }
     } // namespace internal
 
 
 
+    template <typename T>
+    Future<T>
+    isum(const T &t, const MPI_Comm &mpi_communicator)
+    {
+      return internal::iall_reduce_object(MPI_SUM,
+                                          t,
+                                          mpi_communicator,
+                                          [](T &result) {
+                                            return ArrayView<T>(&result, 1);
+                                          });
+    }
+
+
+
+    template <int rank, int dim, typename Number>
+    Future<Tensor<rank, dim, Number>>
+    isum(const Tensor<rank, dim, Number> &local,
+         const MPI_Comm &                 mpi_communicator)
+    {
+      return internal::iall_reduce_object(
+        MPI_SUM,
+        local,
+        mpi_communicator,
+        [](Tensor<rank, dim, Number> &result) {
+          return make_array_view(result);
+        });
+    }
+
+
+
+    template <int rank, int dim, typename Number>
+    Future<SymmetricTensor<rank, dim, Number>>
+    isum(const SymmetricTensor<rank, dim, Number> &local,
+         const MPI_Comm &                          mpi_communicator)
+    {
+      return internal::iall_reduce_object(
+        MPI_SUM,
+        local,
+        mpi_communicator,
+        [](SymmetricTensor<rank, dim, Number> &result) {
+          return make_array_view(result);
+        });
+    }
+
+
+
+    template <typename T>
+    Future<void>
+    isum(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      sums)
+    {
+      return internal::iall_reduce(MPI_SUM, values, mpi_communicator, sums);
+    }
+
+
+
+    template <typename T>
+    Future<T>
+    imax(const T &t, const MPI_Comm &mpi_communicator)
+    {
+      return internal::iall_reduce_object(MPI_MAX,
+                                          t,
+                                          mpi_communicator,
+                                          [](T &result) {
+                                            return ArrayView<T>(&result, 1);
+                                          });
+    }
+
+
+
+    template <typename T>
+    Future<void>
+    imax(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      maxima)
+    {
+      return internal::iall_reduce(MPI_MAX, values, mpi_communicator, maxima);
+    }
+
+
+
+    template <typename T>
+    Future<T>
+    imin(const T &t, const MPI_Comm &mpi_communicator)
+    {
+      return internal::iall_reduce_object(MPI_MIN,
+                                          t,
+                                          mpi_communicator,
+                                          [](T &result) {
+                                            return ArrayView<T>(&result, 1);
+                                          });
+    }
+
+
+
+    template <typename T>
+    Future<void>
+    imin(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      minima)
+    {
+      return internal::iall_reduce(MPI_MIN, values, mpi_communicator, minima);
+    }
+
+
+
     template <typename T>
     T
     sum(const T &t, const MPI_Comm &mpi_communicator)
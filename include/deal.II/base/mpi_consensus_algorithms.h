@@ -337,6 +337,56 @@ namespace Utilities
         clean_up_and_end_communication();
       };
 
+      /**
+       * This class implements a concrete algorithm for the
+       * ConsensusAlgorithms::Interface base class that takes the topology of
+       * the machine into account. Instead of sending one message per target
+       * process as NBX does, the requests of all processes on a
+       * shared-memory node are first collected by one leader process per
+       * node. The leaders aggregate them into a single message per target
+       * node and exchange these messages using NBX between the leaders only.
+       * Every leader then hands the requests to the target processes on its
+       * node. The answers travel back along the same way, this time with a
+       * communication pattern that is already known.
+       *
+       * For large numbers of processes with many small messages, this
+       * replaces most messages across the network by communication within
+       * the nodes. The Process interface is the same as for the other
+       * algorithms, i.e., the payloads are handed to and received from the
+       * Process object as if they had been exchanged directly.
+       *
+       * If every node only hosts a single process, this class simply runs
+       * NBX.
+       *
+       * @note This class uses MPI 3.0 features.
+       *
+       * @tparam T1 The type of the elements of the vector to be sent.
+       * @tparam T2 The type of the elements of the vector to be received.
+       */
+      template <typename T1, typename T2>
+      class HierarchicalNBX : public Interface<T1, T2>
+      {
+      public:
+        /**
+         * Constructor.
+         *
+         * @param process Process to be run during consensus algorithm.
+         * @param comm MPI Communicator
+         */
+        HierarchicalNBX(Process<T1, T2> &process, const MPI_Comm &comm);
+
+        /**
+         * Destructor.
+         */
+        virtual ~HierarchicalNBX() = default;
+
+        /**
+         * @copydoc Interface::run()
+         */
+        virtual void
+        run() override;
+      };
+
       /**
        * This class implements a concrete algorithm for the
        * ConsensusAlgorithms::Interface base class, using a two step approach.
@@ -472,8 +522,9 @@ namespace Utilities
        * A class which delegates its task to other
        * ConsensusAlgorithms::Interface implementations depending on the number
        * of processes in the MPI communicator. For a small number of processes
-       * it uses PEX and for a large number of processes NBX. The threshold
-       * depends if the program is compiled in debug or release mode.
+       * it uses PEX, for a large number of processes NBX, and for very large
+       * numbers of processes HierarchicalNBX. The thresholds depend on
+       * whether the program is compiled in debug or release mode.
        *
        * @tparam T1 The type of the elements of the vector to be sent.
        * @tparam T2 The type of the elements of the vector to be received.
@@ -29,6 +29,10 @@
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -372,6 +376,507 @@ namespace Utilities
 
 
 
+#ifdef DEAL_II_WITH_MPI
+      namespace internal
+      {
+        /**
+         * The header of a message that is routed through the leader
+         * processes by HierarchicalNBX: the ranks of the process that sent
+         * the message and of the one that receives it, followed by the size
+         * of the payload in bytes.
+         */
+        struct MessageHeader
+        {
+          unsigned int  source;
+          unsigned int  target;
+          std::uint64_t n_bytes;
+        };
+
+
+
+        /**
+         * Append a message with the given payload to @p buffer.
+         */
+        inline void
+        append_message(std::vector<char> & buffer,
+                       const unsigned int  source,
+                       const unsigned int  target,
+                       const char *        payload,
+                       const std::uint64_t n_bytes)
+        {
+          const MessageHeader header{source, target, n_bytes};
+          const std::size_t   offset = buffer.size();
+          buffer.resize(offset + sizeof(MessageHeader) + n_bytes);
+          std::memcpy(buffer.data() + offset, &header, sizeof(MessageHeader));
+          if (n_bytes > 0)
+            std::memcpy(buffer.data() + offset + sizeof(MessageHeader),
+                        payload,
+                        n_bytes);
+        }
+
+
+
+        /**
+         * Call @p function with the header and the payload of every message
+         * stored in @p buffer.
+         */
+        template <typename FunctionType>
+        void
+        for_each_message(const std::vector<char> &buffer,
+                         const FunctionType &     function)
+        {
+          std::size_t offset = 0;
+          while (offset < buffer.size())
+            {
+              MessageHeader header;
+              std::memcpy(&header,
+                          buffer.data() + offset,
+                          sizeof(MessageHeader));
+              offset += sizeof(MessageHeader);
+              function(header, buffer.data() + offset);
+              offset += header.n_bytes;
+            }
+          Assert(offset == buffer.size(), ExcInternalError());
+        }
+
+
+
+        /**
+         * Concatenate the buffers of all processes of @p comm, in the order of
+         * their ranks, on rank zero. The other processes get an empty
+         * buffer.
+         */
+        inline std::vector<char>
+        gather_buffers(const MPI_Comm &comm, const std::vector<char> &buffer)
+        {
+          const bool is_root = (this_mpi_process(comm) == 0);
+          const int  size    = buffer.size();
+          AssertThrow(static_cast<std::size_t>(size) == buffer.size(),
+                      ExcMessage("The messages of a process are too large."));
+
+          std::vector<int> sizes(is_root ? n_mpi_processes(comm) : 0);
+          int ierr = MPI_Gather(
+            &size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+          AssertThrowMPI(ierr);
+
+          std::vector<int> offsets(sizes.size() + 1, 0);
+          for (unsigned int i = 0; i < sizes.size(); ++i)
+            offsets[i + 1] = offsets[i] + sizes[i];
+
+          std::vector<char> result(offsets.back());
+          ierr = MPI_Gatherv(buffer.data(),
+                             size,
+                             MPI_CHAR,
+                             result.data(),
+                             sizes.data(),
+                             offsets.data(),
+                             MPI_CHAR,
+                             0,
+                             comm);
+          AssertThrowMPI(ierr);
+
+          return result;
+        }
+
+
+
+        /**
+         * The inverse of gather_buffers(): send @p buffers[i], which only
+         * needs to be set on rank zero, to rank i of @p comm.
+         */
+        inline std::vector<char>
+        scatter_buffers(const MPI_Comm &                      comm,
+                        const std::vector<std::vector<char>> &buffers)
+        {
+          const bool is_root = (this_mpi_process(comm) == 0);
+
+          std::vector<int>  sizes;
+          std::vector<int>  offsets;
+          std::vector<char> send_buffer;
+          if (is_root)
+            {
+              AssertDimension(buffers.size(), n_mpi_processes(comm));
+              offsets.push_back(0);
+              for (const auto &buffer : buffers)
+                {
+                  sizes.push_back(buffer.size());
+                  offsets.push_back(offsets.back() + buffer.size());
+                  send_buffer.insert(send_buffer.end(),
+                                     buffer.begin(),
+                                     buffer.end());
+                }
+            }
+
+          int size = 0;
+          int ierr =
+            MPI_Scatter(sizes.data(), 1, MPI_INT, &size, 1, MPI_INT, 0, comm);
+          AssertThrowMPI(ierr);
+
+          std::vector<char> result(size);
+          ierr = MPI_Scatterv(send_buffer.data(),
+                              sizes.data(),
+                              offsets.data(),
+                              MPI_CHAR,
+                              result.data(),
+                              size,
+                              MPI_CHAR,
+                              0,
+                              comm);
+          AssertThrowMPI(ierr);
+
+          return result;
+        }
+      } // namespace internal
+#endif
+
+
+
+      template <typename T1, typename T2>
+      HierarchicalNBX<T1, T2>::HierarchicalNBX(Process<T1, T2> &process,
+                                               const MPI_Comm & comm)
+        : Interface<T1, T2>(process, comm)
+      {}
+
+
+
+      template <typename T1, typename T2>
+      void
+      HierarchicalNBX<T1, T2>::run()
+      {
+#ifdef DEAL_II_WITH_MPI
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+        // 1) split the communicator into the processes of each shared-memory
+        //    node, and set up a communicator between the leaders, i.e., the
+        //    first process of every node
+        MPI_Comm node_comm;
+        int      ierr = MPI_Comm_split_type(this->comm,
+                                       MPI_COMM_TYPE_SHARED,
+                                       this->my_rank,
+                                       MPI_INFO_NULL,
+                                       &node_comm);
+        AssertThrowMPI(ierr);
+
+        const unsigned int node_size = n_mpi_processes(node_comm);
+
+        // there is nothing to aggregate if every node only hosts a single
+        // process
+        if (Utilities::MPI::max(node_size, this->comm) == 1)
+          {
+            ierr = MPI_Comm_free(&node_comm);
+            AssertThrowMPI(ierr);
+
+            NBX<T1, T2> nbx(this->process, this->comm);
+            nbx.run();
+            return;
+          }
+
+        static CollectiveMutex      mutex;
+        CollectiveMutex::ScopedLock lock(mutex, this->comm);
+
+        const bool is_leader = (this_mpi_process(node_comm) == 0);
+
+        MPI_Comm leader_comm;
+        ierr = MPI_Comm_split(this->comm,
+                              is_leader ? 0 : MPI_UNDEFINED,
+                              this->my_rank,
+                              &leader_comm);
+        AssertThrowMPI(ierr);
+
+        // the leaders need to know the ranks of the processes on their own
+        // node, which are sorted by rank, and the node of every process
+        std::vector<unsigned int> node_ranks(is_leader ? node_size : 0);
+        ierr = MPI_Gather(&this->my_rank,
+                          1,
+                          MPI_UNSIGNED,
+                          node_ranks.data(),
+                          1,
+                          MPI_UNSIGNED,
+                          0,
+                          node_comm);
+        AssertThrowMPI(ierr);
+
+        unsigned int              my_node = 0;
+        std::vector<unsigned int> node_of_rank;
+        if (is_leader)
+          {
+            my_node                    = this_mpi_process(leader_comm);
+            const unsigned int n_nodes = n_mpi_processes(leader_comm);
+
+            const int        my_node_size = node_size;
+            std::vector<int> node_sizes(n_nodes);
+            ierr = MPI_Allgather(&my_node_size,
+                                 1,
+                                 MPI_INT,
+                                 node_sizes.data(),
+                                 1,
+                                 MPI_INT,
+                                 leader_comm);
+            AssertThrowMPI(ierr);
+
+            std::vector<int> node_offsets(n_nodes + 1, 0);
+            for (unsigned int n = 0; n < n_nodes; ++n)
+              node_offsets[n + 1] = node_offsets[n] + node_sizes[n];
+
+            std::vector<unsigned int> ranks_by_node(this->n_procs);
+            ierr = MPI_Allgatherv(node_ranks.data(),
+                                  node_size,
+                                  MPI_UNSIGNED,
+                                  ranks_by_node.data(),
+                                  node_sizes.data(),
+                                  node_offsets.data(),
+                                  MPI_UNSIGNED,
+                                  leader_comm);
+            AssertThrowMPI(ierr);
+
+            node_of_rank.resize(this->n_procs);
+            for (unsigned int n = 0; n < n_nodes; ++n)
+              for (int i = node_offsets[n]; i < node_offsets[n + 1]; ++i)
+                node_of_rank[ranks_by_node[i]] = n;
+          }
+
+        // return the rank within the node of a process on this node
+        const auto node_local_rank = [&](const unsigned int rank) {
+          const auto it =
+            std::lower_bound(node_ranks.begin(), node_ranks.end(), rank);
+          Assert(it != node_ranks.end() && *it == rank, ExcInternalError());
+          return static_cast<unsigned int>(it - node_ranks.begin());
+        };
+
+        // 2) create the requests of this process and collect them on the
+        //    leader
+        const std::vector<unsigned int> targets =
+          this->process.compute_targets();
+
+        std::vector<char> requests;
+        for (const unsigned int target : targets)
+          {
+            std::vector<T1> send_buffer;
+            this->process.create_request(target, send_buffer);
+            internal::append_message(
+              requests,
+              this->my_rank,
+              target,
+              reinterpret_cast<const char *>(send_buffer.data()),
+              send_buffer.size() * sizeof(T1));
+          }
+
+        requests = internal::gather_buffers(node_comm, requests);
+
+        // 3) the leaders sort the requests by the node of their targets and
+        //    exchange them with the other leaders, using NBX between the
+        //    leaders. requests within the node need not be sent anywhere
+        std::map<unsigned int, std::vector<char>> requests_by_node;
+        std::map<unsigned int, std::vector<char>> incoming_requests;
+        if (is_leader)
+          {
+            internal::for_each_message(
+              requests,
+              [&](const internal::MessageHeader &header, const char *payload) {
+                internal::append_message(
+                  requests_by_node[node_of_rank[header.target]],
+                  header.source,
+                  header.target,
+                  payload,
+                  header.n_bytes);
+              });
+            requests.clear();
+
+            auto own_requests = requests_by_node.find(my_node);
+            if (own_requests != requests_by_node.end())
+              {
+                incoming_requests[my_node] = std::move(own_requests->second);
+                requests_by_node.erase(own_requests);
+              }
+
+            AnonymousProcess<char, char> leader_process(
+              [&]() {
+                std::vector<unsigned int> target_nodes;
+                for (const auto &node_and_requests : requests_by_node)
+                  target_nodes.push_back(node_and_requests.first);
+                return target_nodes;
+              },
+              [&](const unsigned int node, std::vector<char> &send_buffer) {
+                send_buffer = requests_by_node[node];
+              },
+              [&](const unsigned int       node,
+                  const std::vector<char> &recv_buffer,
+                  std::vector<char> &) {
+                incoming_requests[node] = recv_buffer;
+              });
+            NBX<char, char>(leader_process, leader_comm).run();
+          }
+
+        // 4) the leaders hand the requests to their targets, which answer
+        //    them
+        std::vector<std::vector<char>> requests_by_target(
+          is_leader ? node_size : 0);
+        for (const auto &node_and_requests : incoming_requests)
+          internal::for_each_message(
+            node_and_requests.second,
+            [&](const internal::MessageHeader &header, const char *payload) {
+              internal::append_message(
+                requests_by_target[node_local_rank(header.target)],
+                header.source,
+                header.target,
+                payload,
+                header.n_bytes);
+            });
+
+        std::vector<char> answers;
+        internal::for_each_message(
+          internal::scatter_buffers(node_comm, requests_by_target),
+          [&](const internal::MessageHeader &header, const char *payload) {
+            Assert(header.n_bytes % sizeof(T1) == 0, ExcInternalError());
+            std::vector<T1> buffer_recv(header.n_bytes / sizeof(T1));
+            if (header.n_bytes > 0)
+              std::memcpy(static_cast<void *>(buffer_recv.data()),
+                          payload,
+                          header.n_bytes);
+
+            std::vector<T2> request_buffer;
+            this->process.answer_request(header.source,
+                                         buffer_recv,
+                                         request_buffer);
+
+            internal::append_message(
+              answers,
+              header.source,
+              header.target,
+              reinterpret_cast<const char *>(request_buffer.data()),
+              request_buffer.size() * sizeof(T2));
+          });
+
+        // 5) send the answers back the same way. the leaders now know from
+        //    which nodes they will get answers, namely the ones they sent
+        //    requests to, so a static exchange suffices
+        answers = internal::gather_buffers(node_comm, answers);
+
+        std::vector<std::vector<char>> answers_by_source(
+          is_leader ? node_size : 0);
+        if (is_leader)
+          {
+            std::map<unsigned int, std::vector<char>> answers_by_node;
+            for (const auto &node_and_requests : incoming_requests)
+              answers_by_node[node_and_requests.first];
+            internal::for_each_message(
+              answers,
+              [&](const internal::MessageHeader &header, const char *payload) {
+                internal::append_message(
+                  answers_by_node[node_of_rank[header.source]],
+                  header.source,
+                  header.target,
+                  payload,
+                  header.n_bytes);
+              });
+            answers.clear();
+
+            const int tag = Utilities::MPI::internal::Tags::
+              consensus_algorithm_hierarchical_nbx_process_deliver;
+
+            std::vector<MPI_Request> send_requests;
+            send_requests.reserve(answers_by_node.size());
+            for (const auto &node_and_answers : answers_by_node)
+              if (node_and_answers.first != my_node)
+                {
+                  send_requests.emplace_back();
+                  ierr = MPI_Isend(node_and_answers.second.data(),
+                                   node_and_answers.second.size(),
+                                   MPI_CHAR,
+                                   node_and_answers.first,
+                                   tag,
+                                   leader_comm,
+                                   &send_requests.back());
+                  AssertThrowMPI(ierr);
+                }
+
+            std::vector<std::vector<char>> incoming_answers;
+            incoming_answers.emplace_back(
+              std::move(answers_by_node[my_node]));
+            for (const auto &node_and_requests : requests_by_node)
+              {
+                MPI_Status status;
+                ierr = MPI_Probe(
+                  node_and_requests.first, tag, leader_comm, &status);
+                AssertThrowMPI(ierr);
+
+                int n_bytes;
+                ierr = MPI_Get_count(&status, MPI_CHAR, &n_bytes);
+                AssertThrowMPI(ierr);
+
+                incoming_answers.emplace_back(n_bytes);
+                ierr = MPI_Recv(incoming_answers.back().data(),
+                                n_bytes,
+                                MPI_CHAR,
+                                node_and_requests.first,
+                                tag,
+                                leader_comm,
+                                MPI_STATUS_IGNORE);
+                AssertThrowMPI(ierr);
+              }
+
+            for (const auto &buffer : incoming_answers)
+              internal::for_each_message(
+                buffer,
+                [&](const internal::MessageHeader &header,
+                    const char *                   payload) {
+                  internal::append_message(
+                    answers_by_source[node_local_rank(header.source)],
+                    header.source,
+                    header.target,
+                    payload,
+                    header.n_bytes);
+                });
+
+            if (send_requests.size() > 0)
+              {
+                ierr = MPI_Waitall(send_requests.size(),
+                                   send_requests.data(),
+                                   MPI_STATUSES_IGNORE);
+                AssertThrowMPI(ierr);
+              }
+          }
+
+        // 6) hand the answers to the processes that made the requests, and
+        //    let them process the answers in the order of their targets
+        std::map<unsigned int, std::vector<T2>> answers_by_target;
+        internal::for_each_message(
+          internal::scatter_buffers(node_comm, answers_by_source),
+          [&](const internal::MessageHeader &header, const char *payload) {
+            Assert(header.n_bytes % sizeof(T2) == 0, ExcInternalError());
+            std::vector<T2> &recv_buffer = answers_by_target[header.target];
+            this->process.prepare_buffer_for_answer(header.target,
+                                                    recv_buffer);
+            recv_buffer.resize(header.n_bytes / sizeof(T2));
+            if (header.n_bytes > 0)
+              std::memcpy(static_cast<void *>(recv_buffer.data()),
+                          payload,
+                          header.n_bytes);
+          });
+
+        AssertDimension(answers_by_target.size(), targets.size());
+        for (const unsigned int target : targets)
+          this->process.read_answer(target, answers_by_target[target]);
+
+        if (is_leader)
+          {
+            ierr = MPI_Comm_free(&leader_comm);
+            AssertThrowMPI(ierr);
+          }
+        ierr = MPI_Comm_free(&node_comm);
+        AssertThrowMPI(ierr);
+#  else
+        AssertThrow(
+          false,
+          ExcMessage(
+            "ConsensusAlgorithms::HierarchicalNBX uses MPI 3.0 features. You should compile with at least MPI 3.0."));
+#  endif
+#else
+        Serial<T1, T2>(this->process, this->comm).run();
+#endif
+      }
+
+
+
       template <typename T1, typename T2>
       PEX<T1, T2>::PEX(Process<T1, T2> &process, const MPI_Comm &comm)
         : Interface<T1, T2>(process, comm)
@@ -597,9 +1102,16 @@ namespace Utilities
 #ifdef DEAL_II_WITH_MPI
 #  if DEAL_II_MPI_VERSION_GTE(3, 0)
 #    ifdef DEBUG
-        if (this->n_procs > 10)
+        if (this->n_procs > 20)
+#    else
+        if (this->n_procs > 1023)
+#    endif
+          consensus_algo.reset(new HierarchicalNBX<T1, T2>(process, comm));
+        else
+#    ifdef DEBUG
+          if (this->n_procs > 10)
 #    else
-        if (this->n_procs > 99)
+          if (this->n_procs > 99)
 #    endif
           consensus_algo.reset(new NBX<T1, T2>(process, comm));
         else
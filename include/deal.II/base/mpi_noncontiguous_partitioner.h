@@ -18,13 +18,18 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/communication_pattern_base.h>
+#include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi_compute_index_owner_internal.h>
 #include <deal.II/base/mpi_tags.h>
 
 #include <deal.II/lac/vector_space_vector.h>
 
+#include <map>
+#include <memory>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -80,16 +85,31 @@ namespace Utilities
        *   of entries in the index sets passed to the constructors or the
        *   reinit() functions.
        *
+       * The argument @p n_components allows to exchange several values per
+       * index, e.g., the components of a vector-valued quantity or several
+       * vectors at once, with the same communication pattern. The values
+       * belonging to the $i$-th index are expected to be stored contiguously
+       * at the positions $[i\,n_\text{components}, (i+1)\,n_\text{components})$
+       * of the arrays, and the sizes of the vectors scale accordingly. The
+       * communication pattern set up in reinit() is reused for any value of
+       * @p n_components.
+       *
+       * If @p MemorySpaceType is MemorySpace::CUDA, the arrays have to reside
+       * in device memory. The data is packed and unpacked on the device and
+       * passed directly to MPI, which requires a CUDA-aware MPI
+       * implementation.
+       *
        * @note This function calls the methods update_values_start() and
        *   update_values_finish() in sequence. Users can call these two
        *   functions separately and hereby overlap communication and
        *   computation.
        */
-      template <typename Number>
+      template <typename Number, typename MemorySpaceType = MemorySpace::Host>
       void
       export_to_ghosted_array(
-        const ArrayView<const Number> &locally_owned_array,
-        const ArrayView<Number> &      ghost_array) const;
+        const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
+        const ArrayView<Number, MemorySpaceType> &      ghost_array,
+        const unsigned int n_components = 1) const;
 
       /**
        * Same as above but with an interface similar to
@@ -105,14 +125,15 @@ namespace Utilities
        * @note Any value less than 10 is a valid value of
        *   @p communication_channel.
        */
-      template <typename Number>
+      template <typename Number, typename MemorySpaceType = MemorySpace::Host>
       void
       export_to_ghosted_array(
-        const unsigned int             communication_channel,
-        const ArrayView<const Number> &locally_owned_array,
-        const ArrayView<Number> &      temporary_storage,
-        const ArrayView<Number> &      ghost_array,
-        std::vector<MPI_Request> &     requests) const;
+        const unsigned int                              communication_channel,
+        const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
+        const ArrayView<Number, MemorySpaceType> &      temporary_storage,
+        const ArrayView<Number, MemorySpaceType> &      ghost_array,
+        std::vector<MPI_Request> &                      requests,
+        const unsigned int n_components = 1) const;
 
       /**
        * Start update: Data is packed, non-blocking send and receives
@@ -130,13 +151,14 @@ namespace Utilities
        * @note Any value less than 10 is a valid value of
        *   @p communication_channel.
        */
-      template <typename Number>
+      template <typename Number, typename MemorySpaceType = MemorySpace::Host>
       void
       export_to_ghosted_array_start(
-        const unsigned int             communication_channel,
-        const ArrayView<const Number> &locally_owned_array,
-        const ArrayView<Number> &      temporary_storage,
-        std::vector<MPI_Request> &     requests) const;
+        const unsigned int                              communication_channel,
+        const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
+        const ArrayView<Number, MemorySpaceType> &      temporary_storage,
+        std::vector<MPI_Request> &                      requests,
+        const unsigned int n_components = 1) const;
 
       /**
        * Finish update. The method waits until all data has been sent and
@@ -152,12 +174,13 @@ namespace Utilities
        * @pre The required size of the vectors are the same as in the functions
        *   above.
        */
-      template <typename Number>
+      template <typename Number, typename MemorySpaceType = MemorySpace::Host>
       void
       export_to_ghosted_array_finish(
-        const ArrayView<const Number> &temporary_storage,
-        const ArrayView<Number> &      ghost_array,
-        std::vector<MPI_Request> &     requests) const;
+        const ArrayView<const Number, MemorySpaceType> &temporary_storage,
+        const ArrayView<Number, MemorySpaceType> &      ghost_array,
+        std::vector<MPI_Request> &                      requests,
+        const unsigned int n_components = 1) const;
 
       /**
        * Returns the number of processes this process sends data to and the
@@ -169,10 +192,11 @@ namespace Utilities
       /**
        * Return the size of the temporary storage needed by the
        * export_to_ghosted_array() functions, if the temporary storage is
-       * handled by the user code.
+       * handled by the user code and @p n_components values are exchanged
+       * per index.
        */
       unsigned int
-      temporary_storage_size() const;
+      temporary_storage_size(const unsigned int n_components = 1) const;
 
       /**
        * Return memory consumption in Byte.
@@ -203,6 +227,14 @@ namespace Utilities
              const MPI_Comm &                            communicator);
 
     private:
+      /**
+       * Expand send_indices and recv_indices to @p n_components values per
+       * index and copy them to the device. This function is only used when
+       * using CUDA-aware MPI.
+       */
+      void
+      initialize_indices_dev(const unsigned int n_components) const;
+
       /**
        * MPI communicator.
        */
@@ -265,6 +297,25 @@ namespace Utilities
        * @note Only allocated if not provided externally by user.
        */
       mutable std::vector<MPI_Request> requests;
+
+      /**
+       * The entries of send_indices and recv_indices expanded to the
+       * number of components given as key and stored on the device. An
+       * entry is set up the first time the exchange is performed for
+       * MemorySpace::CUDA with the respective number of components, so
+       * that repeated exchanges do not need to touch the host data.
+       */
+      mutable std::map<
+        unsigned int,
+        std::pair<std::shared_ptr<unsigned int>, std::shared_ptr<unsigned int>>>
+        indices_dev;
+
+      /**
+       * Device counterpart of @p buffers together with its size in bytes.
+       *
+       * @note Only allocated if not provided externally by user.
+       */
+      mutable std::pair<std::shared_ptr<uint8_t>, std::size_t> buffers_dev;
     };
 
   } // namespace MPI
@@ -18,11 +18,13 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/cuda_size.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_compute_index_owner_internal.h>
 #include <deal.II/base/mpi_noncontiguous_partitioner.h>
 
+#include <deal.II/lac/cuda_kernels.templates.h>
 #include <deal.II/lac/vector_space_vector.h>
 
 
@@ -61,9 +63,10 @@ namespace Utilities
 
 
     unsigned int
-    NoncontiguousPartitioner::temporary_storage_size() const
+    NoncontiguousPartitioner::temporary_storage_size(
+      const unsigned int n_components) const
     {
-      return send_ptr.back();
+      return send_ptr.back() * n_components;
     }
 
 
@@ -107,6 +110,8 @@ namespace Utilities
       recv_indices.clear();
       buffers.clear();
       requests.clear();
+      indices_dev.clear();
+      buffers_dev = {};
 
       // setup communication pattern
       std::vector<unsigned int> owning_ranks_of_ghosts(
@@ -248,67 +253,101 @@ namespace Utilities
     }
 
 
-    template <typename Number>
+    template <typename Number, typename MemorySpaceType>
     void
     NoncontiguousPartitioner::export_to_ghosted_array(
-      const ArrayView<const Number> &src,
-      const ArrayView<Number> &      dst) const
+      const ArrayView<const Number, MemorySpaceType> &src,
+      const ArrayView<Number, MemorySpaceType> &      dst,
+      const unsigned int                              n_components) const
     {
       // allocate internal memory since needed
       if (requests.size() != send_ranks.size() + recv_ranks.size())
         requests.resize(send_ranks.size() + recv_ranks.size());
 
-      if (this->buffers.size() != send_ptr.back() * sizeof(Number))
-        this->buffers.resize(this->temporary_storage_size() * sizeof(Number));
+      const unsigned int n_buffer_entries =
+        this->temporary_storage_size(n_components);
+
+      Number *buffer_ptr = nullptr;
+#if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+  defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+      if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+        {
+          if (buffers_dev.second < n_buffer_entries * sizeof(Number))
+            {
+              buffers_dev.second = n_buffer_entries * sizeof(Number);
+              buffers_dev.first.reset(
+                Utilities::CUDA::allocate_device_data<uint8_t>(
+                  buffers_dev.second),
+                Utilities::CUDA::delete_device_data<uint8_t>);
+            }
+          buffer_ptr = reinterpret_cast<Number *>(buffers_dev.first.get());
+        }
+      else
+#endif
+        {
+          Assert(
+            (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+            ExcMessage(
+              "Only MemorySpace::Host is supported if the compiler doesn't "
+              "understand CUDA code or MPI is not CUDA-aware!"));
+
+          if (this->buffers.size() != n_buffer_entries * sizeof(Number))
+            this->buffers.resize(n_buffer_entries * sizeof(Number));
+          buffer_ptr = reinterpret_cast<Number *>(this->buffers.data());
+        }
 
       // perform actual exchange
-      this->template export_to_ghosted_array<Number>(
+      this->template export_to_ghosted_array<Number, MemorySpaceType>(
         0,
         src,
-        ArrayView<Number>(reinterpret_cast<Number *>(this->buffers.data()),
-                          send_ptr.back()),
+        ArrayView<Number, MemorySpaceType>(buffer_ptr, n_buffer_entries),
         dst,
-        this->requests);
+        this->requests,
+        n_components);
     }
 
 
-    template <typename Number>
+    template <typename Number, typename MemorySpaceType>
     void
     NoncontiguousPartitioner::export_to_ghosted_array(
-      const unsigned int             communication_channel,
-      const ArrayView<const Number> &locally_owned_array,
-      const ArrayView<Number> &      temporary_storage,
-      const ArrayView<Number> &      ghost_array,
-      std::vector<MPI_Request> &     requests) const
+      const unsigned int                              communication_channel,
+      const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
+      const ArrayView<Number, MemorySpaceType> &      temporary_storage,
+      const ArrayView<Number, MemorySpaceType> &      ghost_array,
+      std::vector<MPI_Request> &                      requests,
+      const unsigned int                              n_components) const
     {
-      this->template export_to_ghosted_array_start<Number>(
+      this->template export_to_ghosted_array_start<Number, MemorySpaceType>(
         communication_channel,
         locally_owned_array,
         temporary_storage,
-        requests);
-      this->template export_to_ghosted_array_finish<Number>(temporary_storage,
-                                                            ghost_array,
-                                                            requests);
+        requests,
+        n_components);
+      this->template export_to_ghosted_array_finish<Number, MemorySpaceType>(
+        temporary_storage, ghost_array, requests, n_components);
     }
 
 
 
-    template <typename Number>
+    template <typename Number, typename MemorySpaceType>
     void
     NoncontiguousPartitioner::export_to_ghosted_array_start(
-      const unsigned int             communication_channel,
-      const ArrayView<const Number> &src,
-      const ArrayView<Number> &      buffers,
-      std::vector<MPI_Request> &     requests) const
+      const unsigned int                              communication_channel,
+      const ArrayView<const Number, MemorySpaceType> &src,
+      const ArrayView<Number, MemorySpaceType> &      buffers,
+      std::vector<MPI_Request> &                      requests,
+      const unsigned int                              n_components) const
     {
 #ifndef DEAL_II_WITH_MPI
       (void)communication_channel;
       (void)src;
       (void)buffers;
       (void)requests;
+      (void)n_components;
       Assert(false, ExcNeedsMPI());
 #else
       AssertDimension(requests.size(), recv_ranks.size() + send_ranks.size());
+      Assert(n_components > 0, ExcMessage("n_components must be positive."));
 
       const auto tag =
         communication_channel +
@@ -323,8 +362,8 @@ namespace Utilities
       for (types::global_dof_index i = 0; i < recv_ranks.size(); i++)
         {
           const auto ierr =
-            MPI_Irecv(buffers.data() + recv_ptr[i],
-                      recv_ptr[i + 1] - recv_ptr[i],
+            MPI_Irecv(buffers.data() + recv_ptr[i] * n_components,
+                      (recv_ptr[i + 1] - recv_ptr[i]) * n_components,
                       Utilities::MPI::internal::mpi_type_id(buffers.data()),
                       recv_ranks[i],
                       tag,
@@ -333,27 +372,65 @@ namespace Utilities
           AssertThrowMPI(ierr);
         }
 
-      // post send
+      // collect data to be sent: on the device, all entries are gathered by
+      // a single kernel before the first message is sent
       AssertIndexRange(send_ranks.size(), send_ptr.size());
-      for (types::global_dof_index i = 0, k = 0; i < send_ranks.size(); i++)
+#  if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+    defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+      if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
         {
-          // collect data to be send
-          for (types::global_dof_index j = send_ptr[i]; j < send_ptr[i + 1];
-               j++)
+          if (indices_dev.find(n_components) == indices_dev.end())
+            initialize_indices_dev(n_components);
+
+          const unsigned int n_entries =
+            (send_ptr.back() - send_ptr.front()) * n_components;
+          if (n_entries > 0)
             {
-              AssertIndexRange(k, send_indices.size());
-              buffers[j] = src[send_indices[k]];
-              ++k;
+              const int n_blocks =
+                1 + n_entries / (::dealii::CUDAWrappers::chunk_size *
+                                 ::dealii::CUDAWrappers::block_size);
+              ::dealii::LinearAlgebra::CUDAWrappers::kernel::
+                gather<<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
+                  buffers.data() + send_ptr.front() * n_components,
+                  indices_dev[n_components].first.get(),
+                  src.data(),
+                  n_entries);
+              AssertCudaKernel();
+              // Only wait for the default stream, on which the gather kernel
+              // runs, rather than for the whole device.
+              const cudaError_t cuda_error = cudaStreamSynchronize(0);
+              AssertCuda(cuda_error);
             }
+        }
+      else
+#  endif
+        Assert((std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+               ExcMessage(
+                 "Only MemorySpace::Host is supported if the compiler doesn't "
+                 "understand CUDA code or MPI is not CUDA-aware!"));
+
+      // post send
+      for (types::global_dof_index i = 0, k = 0; i < send_ranks.size(); i++)
+        {
+          if (std::is_same<MemorySpaceType, MemorySpace::Host>::value)
+            for (types::global_dof_index j = send_ptr[i]; j < send_ptr[i + 1];
+                 j++)
+              {
+                AssertIndexRange(k, send_indices.size());
+                for (unsigned int c = 0; c < n_components; ++c)
+                  buffers[j * n_components + c] =
+                    src[send_indices[k] * n_components + c];
+                ++k;
+              }
 
           // send data
-          Assert((send_ptr[i] < buffers.size()) ||
-                   (send_ptr[i] == buffers.size() &&
+          Assert((send_ptr[i] * n_components < buffers.size()) ||
+                   (send_ptr[i] * n_components == buffers.size() &&
                     send_ptr[i + 1] == send_ptr[i]),
                  ExcMessage("The input buffer doesn't contain enough entries"));
           const auto ierr =
-            MPI_Isend(buffers.data() + send_ptr[i],
-                      send_ptr[i + 1] - send_ptr[i],
+            MPI_Isend(buffers.data() + send_ptr[i] * n_components,
+                      (send_ptr[i + 1] - send_ptr[i]) * n_components,
                       Utilities::MPI::internal::mpi_type_id(buffers.data()),
                       send_ranks[i],
                       tag,
@@ -366,17 +443,19 @@ namespace Utilities
 
 
 
-    template <typename Number>
+    template <typename Number, typename MemorySpaceType>
     void
     NoncontiguousPartitioner::export_to_ghosted_array_finish(
-      const ArrayView<const Number> &buffers,
-      const ArrayView<Number> &      dst,
-      std::vector<MPI_Request> &     requests) const
+      const ArrayView<const Number, MemorySpaceType> &buffers,
+      const ArrayView<Number, MemorySpaceType> &      dst,
+      std::vector<MPI_Request> &                      requests,
+      const unsigned int                              n_components) const
     {
 #ifndef DEAL_II_WITH_MPI
       (void)buffers;
       (void)dst;
       (void)requests;
+      (void)n_components;
       Assert(false, ExcNeedsMPI());
 #else
       // receive all data packages and copy data from buffers
@@ -391,11 +470,48 @@ namespace Utilities
           AssertThrowMPI(ierr);
 
           AssertIndexRange(i + 1, recv_ptr.size());
-          for (types::global_dof_index j = recv_ptr[i], c = 0;
-               j < recv_ptr[i + 1];
-               j++)
-            dst[recv_indices[j]] = buffers[recv_ptr[i] + c++];
+#  if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+    defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+          if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+            {
+              if (indices_dev.find(n_components) == indices_dev.end())
+                initialize_indices_dev(n_components);
+
+              const unsigned int n_entries =
+                (recv_ptr[i + 1] - recv_ptr[i]) * n_components;
+              if (n_entries > 0)
+                {
+                  const int n_blocks =
+                    1 + n_entries / (::dealii::CUDAWrappers::chunk_size *
+                                     ::dealii::CUDAWrappers::block_size);
+                  ::dealii::LinearAlgebra::CUDAWrappers::kernel::
+                    set_permutated<<<n_blocks,
+                                     ::dealii::CUDAWrappers::block_size>>>(
+                      indices_dev[n_components].second.get() +
+                        recv_ptr[i] * n_components,
+                      dst.data(),
+                      buffers.data() + recv_ptr[i] * n_components,
+                      n_entries);
+                  AssertCudaKernel();
+                }
+            }
+          else
+#  endif
+            for (types::global_dof_index j = recv_ptr[i]; j < recv_ptr[i + 1];
+                 j++)
+              for (unsigned int c = 0; c < n_components; ++c)
+                dst[recv_indices[j] * n_components + c] =
+                  buffers[j * n_components + c];
+        }
+
+#  if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+    defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+      if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+        {
+          const cudaError_t cuda_error = cudaStreamSynchronize(0);
+          AssertCuda(cuda_error);
         }
+#  endif
 
       // wait that all data packages have been sent
       const auto ierr =
@@ -404,6 +520,47 @@ namespace Utilities
 #endif
     }
 
+
+
+#if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+  defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+    void
+    NoncontiguousPartitioner::initialize_indices_dev(
+      const unsigned int n_components) const
+    {
+      // expand the indices on the host so that each value is addressed
+      // individually and the kernels do not need to know about components
+      const auto expand =
+        [n_components](const std::vector<types::global_dof_index> &indices) {
+          std::vector<unsigned int> indices_host;
+          indices_host.reserve(indices.size() * n_components);
+          for (const auto index : indices)
+            for (unsigned int c = 0; c < n_components; ++c)
+              indices_host.push_back(index * n_components + c);
+          return indices_host;
+        };
+
+      // move the indices to the device
+      const auto copy_to_dev = [](const std::vector<unsigned int> &host) {
+        std::shared_ptr<unsigned int> dev(
+          Utilities::CUDA::allocate_device_data<unsigned int>(host.size()),
+          Utilities::CUDA::delete_device_data<unsigned int>);
+        Utilities::CUDA::copy_to_dev(host, dev.get());
+        return dev;
+      };
+
+      indices_dev[n_components] =
+        std::make_pair(copy_to_dev(expand(send_indices)),
+                       copy_to_dev(expand(recv_indices)));
+    }
+#else
+    void
+    NoncontiguousPartitioner::initialize_indices_dev(const unsigned int) const
+    {
+      Assert(false, ExcNotImplemented());
+    }
+#endif
+
   } // namespace MPI
 } // namespace Utilities
 
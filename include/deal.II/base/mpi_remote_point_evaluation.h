@@ -71,6 +71,31 @@ namespace Utilities
              const Triangulation<dim, spacedim> &tria,
              const Mapping<dim, spacedim> &      mapping);
 
+      /**
+       * Update the internal data structures for new positions @p points of
+       * the points passed to reinit(), e.g., in the case of a moving
+       * interface. In contrast to reinit(), the distributed search is not
+       * performed for all points: the process that has evaluated a point
+       * so far first checks whether the point still lies in the previous
+       * cell or in one of the locally owned face neighbors of that cell.
+       * Only points that could not be found this way, including the points
+       * not found at all before, are passed to the full search. If no
+       * such point is left on any process, the communication pattern is
+       * kept and only the cell data is updated.
+       *
+       * @note The number and the order of the points have to be the same
+       *   as in the call to reinit() and the Triangulation must not have
+       *   been modified since then, i.e., is_ready() has to return true. The
+       *   Mapping object passed to reinit() is used, so that a moving mesh
+       *   can be described by a mapping that is updated in place.
+       *
+       * @note A point that is moved onto a geometric entity shared by
+       *   several cells is only associated to the cells found by the local
+       *   search, in contrast to reinit(), which would find all of them.
+       */
+      void
+      update(const std::vector<Point<spacedim>> &points);
+
       /**
        * Data of points positioned in a cell.
        */
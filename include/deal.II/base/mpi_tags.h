@@ -95,6 +95,9 @@ namespace Utilities
           /// ConsensusAlgorithms::PEX::process
           consensus_algorithm_pex_process_deliver,
 
+          /// ConsensusAlgorithms::HierarchicalNBX::process
+          consensus_algorithm_hierarchical_nbx_process_deliver,
+
           /// TriangulationDescription::Utilities::create_description_from_triangulation()
           fully_distributed_create,
 
@@ -119,6 +122,8 @@ namespace Utilities
           scalapack_copy_to2,
           /// ScaLAPACKMatrix<NumberType>::copy_from
           scalapack_copy_from,
+          /// ScaLAPACKMatrix<NumberType>::copy_from_start
+          scalapack_copy_from_start,
 
           /// ProcessGrid::ProcessGrid
           process_grid_constructor,
@@ -146,6 +151,12 @@ namespace Utilities
           // global coarsening transfer
           fine_dof_handler_view_reinit,
 
+          /// DataOutInterface::write_vtu_in_parallel() with aggregators
+          data_out_base_write_vtu_in_parallel,
+
+          /// TimeStepping::Parareal::solve()
+          time_stepping_parareal,
+
         };
       } // namespace Tags
     }   // namespace internal
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2000 - 2018 by the deal.II authors
+// Copyright (C) 2000 - 2021 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -25,6 +25,12 @@
 
 #  include <memory>
 
+#  if defined(DEAL_II_WITH_MPI) || defined(DEAL_II_WITH_PETSC)
+#    include <mpi.h>
+#  else
+using MPI_Comm = int;
+#  endif
+
 // forward declaration from <taskflow/taskflow.hpp>
 namespace tf
 {
@@ -120,6 +126,52 @@ public:
   static void
   initialize_multithreading();
 
+  /**
+   * Return the number of NUMA domains, i.e., of groups of cores with their
+   * own memory controller, of the compute node this process runs on. If
+   * deal.II was not configured with the hwloc library, this function
+   * returns one.
+   */
+  static unsigned int
+  n_numa_domains();
+
+  /**
+   * Return the NUMA domain of the core the calling thread is currently
+   * running on, as a number between zero and n_numa_domains(). Data
+   * structures can use this information to allocate the memory a thread
+   * works on in the memory attached to its core. Unless the threads have
+   * been pinned by pin_threads() or otherwise, the operating system may
+   * move a thread to a core of another domain at any time, so the result is
+   * only a snapshot. If deal.II was not configured with the hwloc library,
+   * this function returns zero.
+   */
+  static unsigned int
+  current_numa_domain();
+
+  /**
+   * Distribute the cores of each compute node among the MPI processes in
+   * @p mpi_communicator that run on it, and pin the threads of the calling
+   * process to its share of cores. Each process gets a contiguous range of
+   * cores in the numbering of the node, so that processes usually do not
+   * share a socket or NUMA domain unless there are more processes than
+   * sockets. The main thread is pinned to the first core of the range and
+   * each worker thread of the TBB to one of the cores, in a round-robin
+   * fashion. Finally, the number of threads is reduced to the number of
+   * cores of the range if it is larger, see set_thread_limit().
+   *
+   * Without pinning, the threads of different processes on the same node
+   * compete for the same cores, and the operating system may move threads
+   * between sockets, away from the memory they work on.
+   *
+   * This is a collective operation on @p mpi_communicator and should be
+   * called directly after initializing MPI, before any tasks are started.
+   * If deal.II was not configured with the hwloc library, or if the
+   * operating system does not support pinning threads, this function does
+   * nothing.
+   */
+  static void
+  pin_threads(const MPI_Comm &mpi_communicator);
+
 
 #  ifdef DEAL_II_WITH_TASKFLOW
   /**
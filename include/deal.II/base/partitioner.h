@@ -31,6 +31,7 @@
 #include <deal.II/lac/vector_operation.h>
 
 #include <limits>
+#include <list>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -39,6 +40,132 @@ namespace Utilities
 {
   namespace MPI
   {
+#ifdef DEAL_II_WITH_MPI
+    namespace internal
+    {
+      /**
+       * A cache of persistent MPI requests for point-to-point exchanges that
+       * are repeated many times with the same partners, buffers, and message
+       * sizes, such as the ghost exchanges of the Partitioner class. The
+       * requests of such an exchange are set up once with MPI_Send_init() and
+       * MPI_Recv_init() and then started with MPI_Start() in every exchange,
+       * which saves the setup cost of MPI_Isend() and MPI_Irecv() that
+       * dominates exchanges of small messages.
+       *
+       * An exchange is identified by the complete description of its
+       * messages, including the buffer addresses, so the requests are only
+       * reused if all of these are the same as in a previous exchange. The
+       * number of cached exchanges is bounded; the least recently used
+       * exchanges that are not in use are freed if more are requested.
+       */
+      class PersistentRequests
+      {
+      public:
+        /**
+         * The description of a single message of an exchange, i.e., the
+         * arguments to MPI_Send_init() or MPI_Recv_init().
+         */
+        struct Message
+        {
+          bool         is_send;
+          void *       buffer;
+          int          count;
+          MPI_Datatype datatype;
+          int          rank;
+          int          tag;
+          MPI_Comm     comm;
+
+          /**
+           * Return whether two messages are identical.
+           */
+          bool
+          operator==(const Message &other) const;
+        };
+
+        /**
+         * Constructor.
+         */
+        PersistentRequests(const unsigned int max_n_exchanges = 16);
+
+        /**
+         * The requests are owned by this object, so copying is not allowed.
+         */
+        PersistentRequests(const PersistentRequests &) = delete;
+
+        /**
+         * The requests are owned by this object, so copying is not allowed.
+         */
+        PersistentRequests &
+        operator=(const PersistentRequests &) = delete;
+
+        /**
+         * Destructor. Frees all requests.
+         */
+        ~PersistentRequests();
+
+        /**
+         * Return the inactive persistent requests for the exchange described
+         * by @p messages, in the same order, creating them if necessary. The
+         * requests are considered in use until release() or forget() is
+         * called for them, and must be started with MPI_Start() or
+         * MPI_Startall() by the caller.
+         */
+        const std::vector<MPI_Request> &
+        get(const std::vector<Message> &messages);
+
+        /**
+         * Mark the @p n_requests requests starting at @p requests, which must
+         * have been returned by a previous call to get(), as no longer in use.
+         * The requests must have completed.
+         */
+        void
+        release(const MPI_Request *requests, const unsigned int n_requests);
+
+        /**
+         * Remove all exchanges in use whose requests are among the
+         * @p n_requests requests starting at @p requests from the cache
+         * without freeing them, for the case that the caller frees the
+         * requests itself. The requests need not have completed, and the
+         * array may contain other requests as well.
+         */
+        void
+        forget(const MPI_Request *requests, const unsigned int n_requests);
+
+      private:
+        /**
+         * The messages and requests of one exchange.
+         */
+        struct Exchange
+        {
+          std::vector<Message>     messages;
+          std::vector<MPI_Request> requests;
+          bool                     in_use;
+        };
+
+        /**
+         * Return the exchange whose requests start at @p requests.
+         */
+        std::list<Exchange>::iterator
+        find(const MPI_Request *requests, const unsigned int n_requests);
+
+        /**
+         * The maximal number of cached exchanges that are not in use.
+         */
+        const unsigned int max_n_exchanges;
+
+        /**
+         * The cached exchanges, with the most recently used one first.
+         */
+        std::list<Exchange> exchanges;
+
+        /**
+         * The requests of an exchange without messages.
+         */
+        const std::vector<MPI_Request> no_requests;
+      };
+    } // namespace internal
+#endif
+
     /**
      * This class defines a model for the partitioning of a vector (or, in
      * fact, any linear data structure) among processors using MPI.
@@ -640,6 +767,19 @@ namespace Utilities
         const ArrayView<Number, MemorySpaceType> &      locally_owned_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
         std::vector<MPI_Request> &                      requests) const;
+
+      /**
+       * Free the MPI requests of an exchange that was started with
+       * export_to_ghosted_array_start() or import_from_ghosted_array_start()
+       * but is abandoned without calling the matching finish function, and
+       * clear @p requests.
+       *
+       * This function must be used instead of calling MPI_Request_free()
+       * directly because the exchanges use persistent requests that are
+       * owned by this object and reused for later exchanges.
+       */
+      void
+      free_requests(std::vector<MPI_Request> &requests) const;
 #endif
 
       /**
@@ -793,6 +933,15 @@ namespace Utilities
        * A variable storing whether the ghost indices have been explicitly set.
        */
       bool have_ghost_indices;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The persistent MPI requests of the data exchanges. Exchanges are
+       * typically repeated many times with the same buffers, so setting up
+       * their requests only once saves the setup cost in every exchange.
+       */
+      mutable internal::PersistentRequests persistent_requests;
+#endif
     };
 
 
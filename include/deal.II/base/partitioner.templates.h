@@ -20,6 +20,7 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/partitioner.h>
+#include <deal.II/base/tracing.h>
 
 #include <deal.II/lac/cuda_kernels.templates.h>
 #include <deal.II/lac/la_parallel_vector.h>
@@ -46,6 +47,9 @@ namespace Utilities
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
       std::vector<MPI_Request> &                      requests) const
     {
+      Tracing::Scope trace_scope("Partitioner::export_to_ghosted_array_start",
+                                 "MPI");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       AssertIndexRange(communication_channel, 200);
       Assert(ghost_array.size() == n_ghost_indices() ||
@@ -70,11 +74,6 @@ namespace Utilities
       Assert(mpi_tag <= Utilities::MPI::internal::Tags::partitioner_export_end,
              ExcInternalError());
 
-      // Need to send and receive the data. Use non-blocking communication,
-      // where it is usually less overhead to first initiate the receive and
-      // then actually send the data
-      requests.resize(n_import_targets + n_ghost_targets);
-
       // as a ghost array pointer, put the data at the end of the given ghost
       // array in case we want to fill only a subset of the ghosts so that we
       // can move data to the right position in a forward loop in the _finish
@@ -88,23 +87,50 @@ namespace Utilities
                            n_ghost_indices() :
                          ghost_array.data();
 
+      // Need to send and receive the data. The same exchange is typically
+      // repeated many times with the same arrays, so use persistent requests
+      // that are only set up once. Start the receives before the sends, as
+      // this is usually less overhead
+      std::vector<internal::PersistentRequests::Message> messages;
+      messages.reserve(n_ghost_targets + n_import_targets);
       for (unsigned int i = 0; i < n_ghost_targets; i++)
         {
           // allow writing into ghost indices even though we are in a
           // const function
-          const int ierr =
-            MPI_Irecv(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
+          messages.push_back({false,
+                              ghost_array_ptr,
+                              static_cast<int>(ghost_targets_data[i].second *
+                                               sizeof(Number)),
+                              MPI_BYTE,
+                              static_cast<int>(ghost_targets_data[i].first),
+                              static_cast<int>(mpi_tag),
+                              communicator});
           ghost_array_ptr += ghost_targets_data[i].second;
         }
 
       Number *temp_array_ptr = temporary_storage.data();
+      for (unsigned int i = 0; i < n_import_targets; i++)
+        {
+          messages.push_back({true,
+                              temp_array_ptr,
+                              static_cast<int>(import_targets_data[i].second *
+                                               sizeof(Number)),
+                              MPI_BYTE,
+                              static_cast<int>(import_targets_data[i].first),
+                              static_cast<int>(mpi_tag),
+                              communicator});
+          temp_array_ptr += import_targets_data[i].second;
+        }
+
+      requests = persistent_requests.get(messages);
+
+      if (n_ghost_targets > 0)
+        {
+          const int ierr = MPI_Startall(n_ghost_targets, requests.data());
+          AssertThrowMPI(ierr);
+        }
+
+      temp_array_ptr = temporary_storage.data();
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
       // When using CUDAs-aware MPI, the set of local indices that are ghosts
@@ -117,11 +143,17 @@ namespace Utilities
         initialize_import_indices_plain_dev();
 #    endif
 
-      for (unsigned int i = 0; i < n_import_targets; i++)
-        {
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
-          if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+      if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+        {
+          // Pack the data for all targets first and wait only once for the
+          // gather kernels. They run on the default stream, so it suffices to
+          // synchronize that stream: a device-wide synchronization would also
+          // wait for kernels on other streams, e.g. the cell kernels that
+          // CUDAWrappers::MatrixFree runs while the ghost exchange is ongoing.
+          Number *pack_ptr = temp_array_ptr;
+          for (unsigned int i = 0; i < n_import_targets; i++)
             {
               const auto chunk_size = import_indices_plain_dev[i].second;
               const int  n_blocks =
@@ -129,13 +161,23 @@ namespace Utilities
                                   ::dealii::CUDAWrappers::block_size);
               ::dealii::LinearAlgebra::CUDAWrappers::kernel::
                 gather<<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
-                  temp_array_ptr,
+                  pack_ptr,
                   import_indices_plain_dev[i].first.get(),
                   locally_owned_array.data(),
                   chunk_size);
-              cudaDeviceSynchronize();
+              AssertCudaKernel();
+              pack_ptr += import_targets_data[i].second;
             }
-          else
+          const cudaError_t cuda_error = cudaStreamSynchronize(0);
+          AssertCuda(cuda_error);
+        }
+#    endif
+
+      for (unsigned int i = 0; i < n_import_targets; i++)
+        {
+#    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
+      defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
+          if (std::is_same<MemorySpaceType, MemorySpace::Host>::value)
 #    endif
             {
               // copy the data to be sent to the import_data field
@@ -161,14 +203,7 @@ namespace Utilities
             }
 
           // start the send operations
-          const int ierr =
-            MPI_Isend(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[n_ghost_targets + i]);
+          const int ierr = MPI_Start(&requests[n_ghost_targets + i]);
           AssertThrowMPI(ierr);
           temp_array_ptr += import_targets_data[i].second;
         }
@@ -182,6 +217,9 @@ namespace Utilities
       const ArrayView<Number, MemorySpaceType> &ghost_array,
       std::vector<MPI_Request> &                requests) const
     {
+      Tracing::Scope trace_scope("Partitioner::export_to_ghosted_array_finish",
+                                 "MPI");
+
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
              ExcGhostIndexArrayHasWrongSize(ghost_array.size(),
@@ -198,6 +236,7 @@ namespace Utilities
             MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
         }
+      persistent_requests.release(requests.data(), requests.size());
       requests.resize(0);
 
       // in case we only sent a subset of indices, we now need to move the data
@@ -270,6 +309,9 @@ namespace Utilities
       const ArrayView<Number, MemorySpaceType> &temporary_storage,
       std::vector<MPI_Request> &                requests) const
     {
+      Tracing::Scope trace_scope("Partitioner::import_from_ghosted_array_start",
+                                 "MPI");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       AssertIndexRange(communication_channel, 200);
       Assert(ghost_array.size() == n_ghost_indices() ||
@@ -302,18 +344,19 @@ namespace Utilities
              ExcMessage("Another compress operation seems to still be running. "
                         "Call compress_finish() first."));
 
-      // Need to send and receive the data. Use non-blocking communication,
-      // where it is generally less overhead to first initiate the receive and
-      // then actually send the data
+      // Need to send and receive the data. The same exchange is typically
+      // repeated many times with the same arrays, so use persistent requests
+      // that are only set up once. Start the receives before the sends, as
+      // this is generally less overhead
 
       const unsigned int mpi_tag =
         Utilities::MPI::internal::Tags::partitioner_import_start +
         communication_channel;
       Assert(mpi_tag <= Utilities::MPI::internal::Tags::partitioner_import_end,
              ExcInternalError());
-      requests.resize(n_import_targets + n_ghost_targets);
 
-      // initiate the receive operations
+      std::vector<internal::PersistentRequests::Message> messages;
+      messages.reserve(n_import_targets + n_ghost_targets);
       Number *temp_array_ptr = temporary_storage.data();
       for (unsigned int i = 0; i < n_import_targets; i++)
         {
@@ -324,24 +367,52 @@ namespace Utilities
             ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
-          const int ierr =
-            MPI_Irecv(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
+          messages.push_back({false,
+                              temp_array_ptr,
+                              static_cast<int>(import_targets_data[i].second *
+                                               sizeof(Number)),
+                              MPI_BYTE,
+                              static_cast<int>(import_targets_data[i].first),
+                              static_cast<int>(mpi_tag),
+                              communicator});
           temp_array_ptr += import_targets_data[i].second;
         }
 
-      // initiate the send operations
-
       // in case we want to import only from a subset of the ghosts we want to
       // move the data to send to the front of the array
       AssertIndexRange(n_ghost_indices(), n_ghost_indices_in_larger_set + 1);
       Number *ghost_array_ptr = ghost_array.data();
+      for (unsigned int i = 0; i < n_ghost_targets; i++)
+        {
+          AssertThrow(
+            static_cast<std::size_t>(ghost_targets_data[i].second) *
+                sizeof(Number) <
+              static_cast<std::size_t>(std::numeric_limits<int>::max()),
+            ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
+                       "The number of ghost entries times the size of 'Number' "
+                       "exceeds this value. This is not supported."));
+          messages.push_back({true,
+                              ghost_array_ptr,
+                              static_cast<int>(ghost_targets_data[i].second *
+                                               sizeof(Number)),
+                              MPI_BYTE,
+                              static_cast<int>(ghost_targets_data[i].first),
+                              static_cast<int>(mpi_tag),
+                              communicator});
+          ghost_array_ptr += ghost_targets_data[i].second;
+        }
+
+      requests = persistent_requests.get(messages);
+
+      // initiate the receive operations
+      if (n_import_targets > 0)
+        {
+          const int ierr = MPI_Startall(n_import_targets, requests.data());
+          AssertThrowMPI(ierr);
+        }
+
+      // initiate the send operations
+      ghost_array_ptr = ghost_array.data();
       for (unsigned int i = 0; i < n_ghost_targets; i++)
         {
           // in case we only sent a subset of indices, we now need to move the
@@ -405,26 +476,17 @@ namespace Utilities
               AssertDimension(offset, ghost_targets_data[i].second);
             }
 
-          AssertThrow(
-            static_cast<std::size_t>(ghost_targets_data[i].second) *
-                sizeof(Number) <
-              static_cast<std::size_t>(std::numeric_limits<int>::max()),
-            ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
-                       "The number of ghost entries times the size of 'Number' "
-                       "exceeds this value. This is not supported."));
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
           if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
-            cudaDeviceSynchronize();
+            {
+              // The copies above are issued on the default stream; do not
+              // wait for kernels on other streams.
+              const cudaError_t cuda_error = cudaStreamSynchronize(0);
+              AssertCuda(cuda_error);
+            }
 #    endif
-          const int ierr =
-            MPI_Isend(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      mpi_tag,
-                      communicator,
-                      &requests[n_import_targets + i]);
+          const int ierr = MPI_Start(&requests[n_import_targets + i]);
           AssertThrowMPI(ierr);
 
           ghost_array_ptr += ghost_targets_data[i].second;
@@ -505,6 +567,9 @@ namespace Utilities
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
       std::vector<MPI_Request> &                      requests) const
     {
+      Tracing::Scope trace_scope("Partitioner::import_from_ghosted_array_finish",
+                                 "MPI");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -756,6 +821,7 @@ namespace Utilities
         }
 
       // clear the compress requests
+      persistent_requests.release(requests.data(), requests.size());
       requests.resize(0);
     }
 
@@ -32,7 +32,10 @@ DEAL_II_NAMESPACE_OPEN
  * The coefficients of these quadrature rules are computed by the function
  * described in <a
  * href="http://en.wikipedia.org/wiki/Numerical_Recipes">Numerical
- * Recipes</a>.
+ * Recipes</a>. The one-dimensional formula for a given number of points is
+ * only computed once per program run and stored in a process-wide cache, so
+ * that creating further objects of this class (in any dimension) only
+ * copies the points and weights.
  */
 template <int dim>
 class QGauss : public Quadrature<dim>
@@ -56,7 +59,9 @@ public:
  * The quadrature points are interval end points plus the roots of the
  * derivative of the Legendre polynomial <i>P<sub>n-1</sub></i> of degree
  * <i>n-1</i>. The quadrature weights are
- * <i>2/(n(n-1)(P<sub>n-1</sub>(x<sub>i</sub>)<sup>2</sup>)</i>.
+ * <i>2/(n(n-1)(P<sub>n-1</sub>(x<sub>i</sub>)<sup>2</sup>)</i>. As for
+ * QGauss, the one-dimensional formula is only computed once for every number
+ * of points and then taken from a process-wide cache.
  *
  * @note This implementation has not been optimized concerning numerical
  * stability and efficiency. It can be easily adapted to the general case of
@@ -21,8 +21,11 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
+#include <algorithm>
+#include <array>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -104,6 +107,33 @@ public:
            std::vector<Tensor<3, dim>> &third_derivatives,
            std::vector<Tensor<4, dim>> &fourth_derivatives) const = 0;
 
+  /**
+   * Compute the value and the first, second, and third derivatives of all
+   * polynomials at all of the given @p unit_points. The results are stored
+   * in tables whose first index runs over the polynomials and whose second
+   * index runs over the points, e.g., <tt>values(i,q)</tt> is the value of
+   * the <tt>i</tt>th polynomial at the <tt>q</tt>th point. This is the
+   * layout in which FE_Poly stores the shape functions at the quadrature
+   * points.
+   *
+   * Each table must either be empty or have size <tt>n()</tt> times
+   * <tt>unit_points.size()</tt>. In the first case, the function will not
+   * compute the corresponding quantity.
+   *
+   * The default implementation calls evaluate() for each point. Derived
+   * classes whose polynomials are products of one-dimensional polynomials
+   * override it to evaluate the one-dimensional polynomials only once for
+   * each distinct coordinate, which saves most of the work for the points
+   * of tensor product quadrature formulas, and to compute the products for
+   * all points at once in loops the compiler can vectorize.
+   */
+  virtual void
+  evaluate_on_points(const std::vector<Point<dim>> &unit_points,
+                     Table<2, double> &             values,
+                     Table<2, Tensor<1, dim>> &     grads,
+                     Table<2, Tensor<2, dim>> &     grad_grads,
+                     Table<2, Tensor<3, dim>> &     third_derivatives) const;
+
   /**
    * Compute the value of the <tt>i</tt>th polynomial at unit point
    * <tt>p</tt>.
@@ -233,6 +263,174 @@ private:
 
 
 
+namespace internal
+{
+  /**
+   * Evaluate polynomials that are products of the one-dimensional
+   * @p polynomials at all @p unit_points, where the <tt>i</tt>th polynomial
+   * is the product of the polynomials with the indices
+   * <tt>tensor_indices[i]</tt> in the coordinate directions. The output
+   * arguments are those of ScalarPolynomialsBase::evaluate_on_points().
+   *
+   * The one-dimensional polynomials are evaluated once for each distinct
+   * value of each coordinate of the points, and the products are then formed
+   * for all points of a polynomial at once.
+   */
+  template <int dim, typename PolynomialType>
+  void
+  evaluate_tensor_products_on_points(
+    const std::vector<PolynomialType> &               polynomials,
+    const std::vector<std::array<unsigned int, dim>> &tensor_indices,
+    const std::vector<Point<dim>> &                   unit_points,
+    Table<2, double> &                                values,
+    Table<2, Tensor<1, dim>> &                        grads,
+    Table<2, Tensor<2, dim>> &                        grad_grads,
+    Table<2, Tensor<3, dim>> &                        third_derivatives)
+  {
+    const unsigned int n_points      = unit_points.size();
+    const unsigned int n_polynomials = tensor_indices.size();
+    const unsigned int n_1d          = polynomials.size();
+
+    const TableIndices<2> size(n_polynomials, n_points);
+    Assert(values.n_rows() == 0 || values.size() == size,
+           ExcDimensionMismatch2(values.n_rows(), n_polynomials, 0));
+    Assert(grads.n_rows() == 0 || grads.size() == size,
+           ExcDimensionMismatch2(grads.n_rows(), n_polynomials, 0));
+    Assert(grad_grads.n_rows() == 0 || grad_grads.size() == size,
+           ExcDimensionMismatch2(grad_grads.n_rows(), n_polynomials, 0));
+    Assert(third_derivatives.n_rows() == 0 ||
+             third_derivatives.size() == size,
+           ExcDimensionMismatch2(third_derivatives.n_rows(), n_polynomials, 0));
+    (void)size;
+
+    // find the highest derivative that has to be computed
+    int max_order = -1;
+    if (values.n_rows() > 0)
+      max_order = 0;
+    if (grads.n_rows() > 0)
+      max_order = 1;
+    if (grad_grads.n_rows() > 0)
+      max_order = 2;
+    if (third_derivatives.n_rows() > 0)
+      max_order = 3;
+    if (max_order < 0 || n_points == 0)
+      return;
+    const unsigned int n_orders = max_order + 1;
+
+    // evaluate the one-dimensional polynomials and their derivatives for the
+    // distinct coordinates in each direction, and expand the result to all
+    // points. the data of direction d, derivative o, and polynomial j is
+    // stored contiguously for all points, starting at
+    // ((d * n_orders + o) * n_1d + j) * n_points
+    std::vector<double> values_1d(dim * n_orders * n_1d * n_points);
+    {
+      std::vector<double> coordinates(n_points);
+      std::vector<double> unique_values;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          for (unsigned int q = 0; q < n_points; ++q)
+            coordinates[q] = unit_points[q][d];
+          std::vector<double> unique_coordinates(coordinates);
+          std::sort(unique_coordinates.begin(), unique_coordinates.end());
+          unique_coordinates.erase(std::unique(unique_coordinates.begin(),
+                                               unique_coordinates.end()),
+                                   unique_coordinates.end());
+
+          unique_values.resize(unique_coordinates.size() * n_1d * n_orders);
+          for (unsigned int u = 0; u < unique_coordinates.size(); ++u)
+            for (unsigned int j = 0; j < n_1d; ++j)
+              polynomials[j].value(unique_coordinates[u],
+                                   max_order,
+                                   &unique_values[(u * n_1d + j) * n_orders]);
+
+          for (unsigned int q = 0; q < n_points; ++q)
+            {
+              const unsigned int u =
+                std::lower_bound(unique_coordinates.begin(),
+                                 unique_coordinates.end(),
+                                 coordinates[q]) -
+                unique_coordinates.begin();
+              for (unsigned int j = 0; j < n_1d; ++j)
+                for (unsigned int o = 0; o < n_orders; ++o)
+                  values_1d[((d * n_orders + o) * n_1d + j) * n_points + q] =
+                    unique_values[(u * n_1d + j) * n_orders + o];
+            }
+        }
+    }
+
+    // compute the product of the one-dimensional polynomials of the current
+    // polynomial with the given derivative orders in each direction for all
+    // points
+    std::array<unsigned int, dim> indices;
+
+    const auto compute_product =
+      [&](const std::array<unsigned int, dim> &orders, double *result) {
+        for (unsigned int q = 0; q < n_points; ++q)
+          result[q] = 1.;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const double *values_d =
+              &values_1d[((d * n_orders + orders[d]) * n_1d + indices[d]) *
+                         n_points];
+            for (unsigned int q = 0; q < n_points; ++q)
+              result[q] *= values_d[q];
+          }
+      };
+
+    std::array<unsigned int, dim> orders;
+    std::vector<double>           product(n_points);
+    for (unsigned int i = 0; i < n_polynomials; ++i)
+      {
+        indices = tensor_indices[i];
+
+        if (values.n_rows() > 0)
+          {
+            orders.fill(0);
+            compute_product(orders, &values(i, 0));
+          }
+
+        if (grads.n_rows() > 0)
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              orders.fill(0);
+              ++orders[d];
+              compute_product(orders, product.data());
+              for (unsigned int q = 0; q < n_points; ++q)
+                grads(i, q)[d] = product[q];
+            }
+
+        if (grad_grads.n_rows() > 0)
+          for (unsigned int d1 = 0; d1 < dim; ++d1)
+            for (unsigned int d2 = d1; d2 < dim; ++d2)
+              {
+                orders.fill(0);
+                ++orders[d1];
+                ++orders[d2];
+                compute_product(orders, product.data());
+                for (unsigned int q = 0; q < n_points; ++q)
+                  grad_grads(i, q)[d1][d2] = grad_grads(i, q)[d2][d1] =
+                    product[q];
+              }
+
+        if (third_derivatives.n_rows() > 0)
+          for (unsigned int d1 = 0; d1 < dim; ++d1)
+            for (unsigned int d2 = 0; d2 < dim; ++d2)
+              for (unsigned int d3 = 0; d3 < dim; ++d3)
+                {
+                  orders.fill(0);
+                  ++orders[d1];
+                  ++orders[d2];
+                  ++orders[d3];
+                  compute_product(orders, product.data());
+                  for (unsigned int q = 0; q < n_points; ++q)
+                    third_derivatives(i, q)[d1][d2][d3] = product[q];
+                }
+      }
+  }
+} // namespace internal
+
+
+
 template <int dim>
 inline unsigned int
 ScalarPolynomialsBase<dim>::n() const
@@ -0,0 +1,500 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_strided_array_view_h
+#define dealii_strided_array_view_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/table.h>
+
+#include <array>
+#include <string>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that represents a multidimensional window of memory locations of
+ * type @p ElementType, in the spirit of the <code>std::mdspan</code> class
+ * of C++23. Like ArrayView, the object does not own the memory it points to
+ * and is cheap to copy. Unlike ArrayView, the elements are addressed by
+ * @p rank indices, and the distance between two consecutive entries in each
+ * direction (the <i>stride</i>) can be arbitrary. The entry with indices
+ * $(i_0,\ldots,i_{r-1})$ is located at
+ * @code
+ *   data() + i_0 * stride(0) + ... + i_{r-1} * stride(r-1)
+ * @endcode
+ *
+ * This allows to pass parts of the data stored in a Table, a FullMatrix, or
+ * an AlignedVector, such as a single row or column of a matrix, the entries
+ * of one component, or those of one quadrature point, to a function without
+ * copying them into a temporary array and without resorting to raw pointers
+ * and hand-written index computations. Objects of this class are typically
+ * created by one of the make_strided_array_view() functions, and can be
+ * further restricted by slice() and subview():
+ * @code
+ *   Table<3, double> values(n_components, n_q_points, n_dofs);
+ *   ...
+ *   // all values of the second component, a view of rank two
+ *   const auto component_values = make_strided_array_view(values).slice(0, 1);
+ *
+ *   // the values of all components at quadrature point q, skipping over
+ *   // the entries of the other quadrature points
+ *   const auto values_at_q = make_strided_array_view(values).slice(1, q);
+ * @endcode
+ *
+ * As for ArrayView, a view to constant data is obtained by using a
+ * <code>const</code> qualified @p ElementType, and a view to non-constant
+ * data can be converted into one to constant data.
+ *
+ * @note Contrary to <code>std::mdspan</code>, the extents are always stored
+ * at run time. The rank, however, is a template argument, so loops over the
+ * dimensions of a view can be unrolled by the compiler.
+ *
+ * @ingroup data
+ */
+template <typename ElementType, int rank>
+class StridedArrayView
+{
+public:
+  static_assert(rank > 0, "A StridedArrayView must have at least rank one.");
+
+  /**
+   * An alias that denotes the "value_type" of this container-like class,
+   * i.e., the type of the element it "stores" or points to.
+   */
+  using value_type = ElementType;
+
+  /**
+   * Default constructor. Creates an empty view that does not point to
+   * anything.
+   */
+  StridedArrayView();
+
+  /**
+   * Constructor for a view of contiguous memory starting at
+   * @p starting_element, with the entries stored in row-major order, i.e.,
+   * with the last index running fastest. This is the layout of Table and
+   * FullMatrix.
+   */
+  StridedArrayView(value_type *const                    starting_element,
+                   const std::array<std::size_t, rank> &extents);
+
+  /**
+   * Constructor for a view with the given @p extents and @p strides, both
+   * counted in elements.
+   */
+  StridedArrayView(value_type *const                    starting_element,
+                   const std::array<std::size_t, rank> &extents,
+                   const std::array<std::size_t, rank> &strides);
+
+  /**
+   * Copy constructor from a view to non-const data, enabling the conversion
+   * into a view to const data.
+   */
+  StridedArrayView(
+    const StridedArrayView<typename std::remove_cv<value_type>::type, rank>
+      &view);
+
+  /**
+   * Return the number of entries in direction @p dimension.
+   */
+  std::size_t
+  extent(const unsigned int dimension) const;
+
+  /**
+   * Return the distance, in elements, between two consecutive entries in
+   * direction @p dimension.
+   */
+  std::size_t
+  stride(const unsigned int dimension) const;
+
+  /**
+   * Return the total number of entries of the view, i.e., the product of
+   * all extents.
+   */
+  std::size_t
+  n_elements() const;
+
+  /**
+   * Return whether the view contains no entries.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Return whether the entries of the view are stored contiguously in
+   * row-major order, i.e., whether the view could be represented by an
+   * ArrayView of size n_elements() starting at data().
+   */
+  bool
+  is_contiguous() const;
+
+  /**
+   * Return a pointer to the entry with all indices zero.
+   */
+  value_type *
+  data() const noexcept;
+
+  /**
+   * Return a reference to the entry with the given @p indices, of which
+   * there must be exactly @p rank.
+   *
+   * This function is marked as const because it does not change the
+   * <em>view object</em>. It may however return a reference to a non-const
+   * memory location depending on whether the template type of the class is
+   * const or non-const.
+   */
+  template <typename... Indices>
+  value_type &
+  operator()(const Indices... indices) const;
+
+  /**
+   * Return a view of rank <code>rank-1</code> of the entries whose index in
+   * direction @p dimension equals @p index.
+   */
+  StridedArrayView<ElementType, rank - 1>
+  slice(const unsigned int dimension, const std::size_t index) const;
+
+  /**
+   * Return a view of the same rank that only contains the entries whose
+   * index in direction @p dimension is in the half-open range
+   * $[\text{begin},\text{end})$.
+   */
+  StridedArrayView
+  subview(const unsigned int dimension,
+          const std::size_t  begin,
+          const std::size_t  end) const;
+
+private:
+  /**
+   * A pointer to the entry with all indices zero.
+   */
+  value_type *starting_element;
+
+  /**
+   * The number of entries in each direction.
+   */
+  std::array<std::size_t, rank> extents;
+
+  /**
+   * The distance between two consecutive entries in each direction.
+   */
+  std::array<std::size_t, rank> strides;
+
+  friend class StridedArrayView<const ElementType, rank>;
+};
+
+
+
+/*---------------------- Inline functions -----------------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename ElementType, int rank>
+inline StridedArrayView<ElementType, rank>::StridedArrayView()
+  : starting_element(nullptr)
+{
+  extents.fill(0);
+  strides.fill(0);
+}
+
+
+
+template <typename ElementType, int rank>
+inline StridedArrayView<ElementType, rank>::StridedArrayView(
+  value_type *const                    starting_element,
+  const std::array<std::size_t, rank> &extents)
+  : starting_element(starting_element)
+  , extents(extents)
+{
+  strides[rank - 1] = 1;
+  for (int d = rank - 2; d >= 0; --d)
+    strides[d] = strides[d + 1] * extents[d + 1];
+}
+
+
+
+template <typename ElementType, int rank>
+inline StridedArrayView<ElementType, rank>::StridedArrayView(
+  value_type *const                    starting_element,
+  const std::array<std::size_t, rank> &extents,
+  const std::array<std::size_t, rank> &strides)
+  : starting_element(starting_element)
+  , extents(extents)
+  , strides(strides)
+{}
+
+
+
+template <typename ElementType, int rank>
+inline StridedArrayView<ElementType, rank>::StridedArrayView(
+  const StridedArrayView<typename std::remove_cv<value_type>::type, rank>
+    &view)
+  : starting_element(view.starting_element)
+  , extents(view.extents)
+  , strides(view.strides)
+{}
+
+
+
+template <typename ElementType, int rank>
+inline std::size_t
+StridedArrayView<ElementType, rank>::extent(const unsigned int dimension) const
+{
+  AssertIndexRange(dimension, rank);
+  return extents[dimension];
+}
+
+
+
+template <typename ElementType, int rank>
+inline std::size_t
+StridedArrayView<ElementType, rank>::stride(const unsigned int dimension) const
+{
+  AssertIndexRange(dimension, rank);
+  return strides[dimension];
+}
+
+
+
+template <typename ElementType, int rank>
+inline std::size_t
+StridedArrayView<ElementType, rank>::n_elements() const
+{
+  std::size_t n = 1;
+  for (unsigned int d = 0; d < rank; ++d)
+    n *= extents[d];
+  return n;
+}
+
+
+
+template <typename ElementType, int rank>
+inline bool
+StridedArrayView<ElementType, rank>::empty() const
+{
+  return n_elements() == 0;
+}
+
+
+
+template <typename ElementType, int rank>
+inline bool
+StridedArrayView<ElementType, rank>::is_contiguous() const
+{
+  std::size_t expected_stride = 1;
+  for (int d = rank - 1; d >= 0; --d)
+    {
+      // the stride of a direction with a single entry is irrelevant
+      if (extents[d] > 1 && strides[d] != expected_stride)
+        return false;
+      expected_stride *= extents[d];
+    }
+  return true;
+}
+
+
+
+template <typename ElementType, int rank>
+inline typename StridedArrayView<ElementType, rank>::value_type *
+StridedArrayView<ElementType, rank>::data() const noexcept
+{
+  return starting_element;
+}
+
+
+
+template <typename ElementType, int rank>
+template <typename... Indices>
+inline typename StridedArrayView<ElementType, rank>::value_type &
+StridedArrayView<ElementType, rank>::operator()(
+  const Indices... indices) const
+{
+  static_assert(sizeof...(Indices) == rank,
+                "The number of indices must match the rank of the view.");
+
+  const std::array<std::size_t, rank> index_array = {
+    {static_cast<std::size_t>(indices)...}};
+
+  std::size_t offset = 0;
+  for (unsigned int d = 0; d < rank; ++d)
+    {
+      AssertIndexRange(index_array[d], extents[d]);
+      offset += index_array[d] * strides[d];
+    }
+  return starting_element[offset];
+}
+
+
+
+template <typename ElementType, int rank>
+inline StridedArrayView<ElementType, rank - 1>
+StridedArrayView<ElementType, rank>::slice(const unsigned int dimension,
+                                           const std::size_t  index) const
+{
+  static_assert(rank > 1, "A view of rank one cannot be sliced any further.");
+  AssertIndexRange(dimension, rank);
+  AssertIndexRange(index, extents[dimension]);
+
+  std::array<std::size_t, rank - 1> new_extents;
+  std::array<std::size_t, rank - 1> new_strides;
+  for (unsigned int d = 0, e = 0; d < rank; ++d)
+    if (d != dimension)
+      {
+        new_extents[e] = extents[d];
+        new_strides[e] = strides[d];
+        ++e;
+      }
+
+  return StridedArrayView<ElementType, rank - 1>(starting_element +
+                                                   index * strides[dimension],
+                                                 new_extents,
+                                                 new_strides);
+}
+
+
+
+template <typename ElementType, int rank>
+inline StridedArrayView<ElementType, rank>
+StridedArrayView<ElementType, rank>::subview(const unsigned int dimension,
+                                             const std::size_t  begin,
+                                             const std::size_t  end) const
+{
+  AssertIndexRange(dimension, rank);
+  Assert(begin <= end && end <= extents[dimension],
+         ExcMessage("The range [" + std::to_string(begin) + "," +
+                    std::to_string(end) + ") is not within the extent " +
+                    std::to_string(extents[dimension]) + " of the view."));
+
+  std::array<std::size_t, rank> new_extents = extents;
+  new_extents[dimension]                    = end - begin;
+
+  return StridedArrayView(starting_element + begin * strides[dimension],
+                          new_extents,
+                          strides);
+}
+
+#endif
+
+
+
+/**
+ * Create a view of rank @p N to the entries of the given @p table. This also
+ * covers FullMatrix and the other classes derived from Table.
+ *
+ * @param[in] table The table for which we want to have a view object. The
+ * view is only valid as long as the table is neither destroyed nor resized.
+ *
+ * @relatesalso StridedArrayView
+ */
+template <int N, typename T>
+inline StridedArrayView<T, N>
+make_strided_array_view(Table<N, T> &table)
+{
+  std::array<std::size_t, N> extents;
+  for (unsigned int d = 0; d < N; ++d)
+    extents[d] = table.size(d);
+
+  return StridedArrayView<T, N>(
+    table.n_elements() > 0 ? &table(TableIndices<N>()) : nullptr, extents);
+}
+
+
+
+/**
+ * Create a view of rank @p N to the entries of the given @p table, not
+ * allowing the entries to be modified.
+ *
+ * @relatesalso StridedArrayView
+ */
+template <int N, typename T>
+inline StridedArrayView<const T, N>
+make_strided_array_view(const Table<N, T> &table)
+{
+  std::array<std::size_t, N> extents;
+  for (unsigned int d = 0; d < N; ++d)
+    extents[d] = table.size(d);
+
+  return StridedArrayView<const T, N>(
+    table.n_elements() > 0 ? &table(TableIndices<N>()) : nullptr, extents);
+}
+
+
+
+/**
+ * Create a view that interprets the entries of the given @p vector as an
+ * array with the given @p extents in row-major order, the way the
+ * one-dimensional shape function data of MatrixFree, stored in an
+ * AlignedVector, is organized. The product of the extents must equal the
+ * size of the vector.
+ *
+ * @relatesalso StridedArrayView
+ */
+template <typename T, std::size_t rank>
+inline StridedArrayView<T, rank>
+make_strided_array_view(AlignedVector<T> &                   vector,
+                        const std::array<std::size_t, rank> &extents)
+{
+  const StridedArrayView<T, rank> view(vector.data(), extents);
+  AssertDimension(view.n_elements(), vector.size());
+  return view;
+}
+
+
+
+/**
+ * Create a view that interprets the entries of the given @p vector as an
+ * array with the given @p extents in row-major order, not allowing the
+ * entries to be modified.
+ *
+ * @relatesalso StridedArrayView
+ */
+template <typename T, std::size_t rank>
+inline StridedArrayView<const T, rank>
+make_strided_array_view(const AlignedVector<T> &             vector,
+                        const std::array<std::size_t, rank> &extents)
+{
+  const StridedArrayView<const T, rank> view(vector.data(), extents);
+  AssertDimension(view.n_elements(), vector.size());
+  return view;
+}
+
+
+
+/**
+ * Create a view of rank one to the memory referenced by @p array_view,
+ * with unit stride. This is useful to pass an ArrayView to a function that
+ * accepts a StridedArrayView.
+ *
+ * @relatesalso StridedArrayView
+ */
+template <typename ElementType>
+inline StridedArrayView<ElementType, 1>
+make_strided_array_view(const ArrayView<ElementType> &array_view)
+{
+  return StridedArrayView<ElementType, 1>(array_view.data(),
+                                          {{array_view.size()}});
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
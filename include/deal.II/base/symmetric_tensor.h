@@ -977,12 +977,11 @@ private:
                            identity_tensor();
 
 
-  // Make a few helper classes friends as well.
-  friend struct internal::SymmetricTensorImplementation::
-    Inverse<2, dim, Number>;
-
-  friend struct internal::SymmetricTensorImplementation::
-    Inverse<4, dim, Number>;
+  // Make a few helper classes friends as well. All of them, because the
+  // inverse for vectorized number types works on the tensors of the
+  // individual lanes.
+  template <int, int, typename>
+  friend struct internal::SymmetricTensorImplementation::Inverse;
 };
 
 
@@ -1490,6 +1489,39 @@ namespace internal
       }
     };
 
+
+    template <typename Number, std::size_t width>
+    struct Inverse<4, 3, VectorizedArray<Number, width>>
+    {
+      static dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>>
+      value(
+        const dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>> &t)
+      {
+        dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>> tmp;
+
+        // The pivot search of the general implementation above takes a
+        // different decision for every lane and can therefore not be
+        // expressed with vectorized operations. Invert the tensors of the
+        // individual lanes instead.
+        const unsigned int N = 6;
+        for (unsigned int v = 0; v < width; ++v)
+          {
+            dealii::SymmetricTensor<4, 3, Number> lane;
+            for (unsigned int i = 0; i < N; ++i)
+              for (unsigned int j = 0; j < N; ++j)
+                lane.data[i][j] = t.data[i][j][v];
+
+            lane = Inverse<4, 3, Number>::value(lane);
+
+            for (unsigned int i = 0; i < N; ++i)
+              for (unsigned int j = 0; j < N; ++j)
+                tmp.data[i][j][v] = lane.data[i][j];
+          }
+
+        return tmp;
+      }
+    };
+
   } // namespace SymmetricTensorImplementation
 } // namespace internal
 
@@ -1660,10 +1692,25 @@ namespace internal
 
     const unsigned int data_dim = SymmetricTensorAccessors::
       StorageType<2, dim, value_type>::n_independent_components;
+
+    // Scale the off-diagonal entries of the rank-2 tensor by two once,
+    // rather than once for every row of the rank-4 tensor. Each entry of the
+    // result is then a plain dot product that the compiler can keep in
+    // registers, which matters in particular for VectorizedArray.
+    OtherNumber scaled_sdata[data_dim]{};
+    for (unsigned int d = 0; d < dim; ++d)
+      scaled_sdata[d] = sdata[d];
+    for (unsigned int d = dim; d < data_dim; ++d)
+      scaled_sdata[d] = sdata[d] + sdata[d];
+
     value_type tmp[data_dim]{};
     for (unsigned int i = 0; i < data_dim; ++i)
-      tmp[i] =
-        perform_double_contraction<dim, Number, OtherNumber>(data[i], sdata);
+      {
+        value_type sum = data[i][0] * scaled_sdata[0];
+        for (unsigned int d = 1; d < data_dim; ++d)
+          sum += data[i][d] * scaled_sdata[d];
+        tmp[i] = sum;
+      }
     return result_type(tmp);
   }
 
@@ -1728,18 +1775,19 @@ namespace internal
 
     const unsigned int data_dim = SymmetricTensorAccessors::
       StorageType<2, dim, value_type>::n_independent_components;
+    // Loop over the rows of the result and accumulate the rows of sdata
+    // scaled by the entries of data, counting the off-diagonal entries
+    // twice. The innermost loop then runs over contiguous entries of both
+    // the result and sdata without any dependency between iterations.
     base_tensor_type tmp;
     for (unsigned int i = 0; i < data_dim; ++i)
-      for (unsigned int j = 0; j < data_dim; ++j)
+      for (unsigned int d = 0; d < data_dim; ++d)
         {
-          // Start with the non-diagonal part
-          for (unsigned int d = dim; d < (dim * (dim + 1) / 2); ++d)
-            tmp[i][j] += data[i][d] * sdata[d][j];
-          tmp[i][j] += tmp[i][j]; // tmp[i][j] = tmp[i][j] * 2;
-
-          // Now add the contributions from the diagonal
-          for (unsigned int d = 0; d < dim; ++d)
-            tmp[i][j] += data[i][d] * sdata[d][j];
+          Number factor = data[i][d];
+          if (d >= dim)
+            factor += factor;
+          for (unsigned int j = 0; j < data_dim; ++j)
+            tmp[i][j] += factor * sdata[d][j];
         }
     return tmp;
   }
@@ -136,6 +136,21 @@ public:
            std::vector<Tensor<3, dim>> &third_derivatives,
            std::vector<Tensor<4, dim>> &fourth_derivatives) const override;
 
+  /**
+   * Compute the value and the first, second, and third derivatives of all
+   * tensor product polynomials at all of the given @p unit_points, see
+   * ScalarPolynomialsBase::evaluate_on_points(). The one-dimensional
+   * polynomials are evaluated only once for each distinct coordinate of the
+   * points.
+   */
+  void
+  evaluate_on_points(
+    const std::vector<Point<dim>> &unit_points,
+    Table<2, double> &             values,
+    Table<2, Tensor<1, dim>> &     grads,
+    Table<2, Tensor<2, dim>> &     grad_grads,
+    Table<2, Tensor<3, dim>> &     third_derivatives) const override;
+
   /**
    * Compute the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
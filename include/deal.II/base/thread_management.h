@@ -28,10 +28,12 @@
 #  include <condition_variable>
 #  include <functional>
 #  include <future>
+#  include <iosfwd>
 #  include <iterator>
 #  include <list>
 #  include <memory>
 #  include <mutex>
+#  include <string>
 #  include <thread>
 #  include <tuple>
 #  include <utility>
@@ -1536,6 +1538,149 @@ namespace Threads
     std::list<Task<RT>> tasks;
   };
 
+
+
+  /**
+   * A class that describes a set of tasks together with the dependencies
+   * between them, i.e., a directed acyclic graph of tasks, and that executes
+   * them with as much concurrency as the dependencies allow.
+   *
+   * Tasks are added through add_task(), which returns an identifier that
+   * can be used to declare other tasks as depending on this one. Because a
+   * task can only depend on tasks that were added before it, the graph is
+   * acyclic by construction. A call to run() then starts every task as soon
+   * as all tasks it depends on have finished, and returns once all tasks
+   * have finished. As an example, the setup phase of a typical program
+   * could be expressed as follows:
+   * @code
+   *   Threads::TaskGraph graph;
+   *   const auto dofs =
+   *     graph.add_task("distribute dofs", [&]() { setup_dofs(); });
+   *   const auto constraints =
+   *     graph.add_task("constraints", [&]() { setup_constraints(); }, {dofs});
+   *   const auto transfer =
+   *     graph.add_task("transfer", [&]() { setup_transfer(); }, {dofs});
+   *   graph.add_task("matrix free",
+   *                  [&]() { setup_matrix_free(); },
+   *                  {constraints});
+   *   graph.add_task("smoothers",
+   *                  [&]() { setup_smoothers(); },
+   *                  {constraints, transfer});
+   *   graph.run();
+   * @endcode
+   *
+   * During run(), the wall time spent in each task is recorded. The function
+   * critical_path() returns the chain of dependent tasks with the longest
+   * accumulated wall time, which is a lower bound for the time run() needs
+   * with any number of threads, and print_summary() writes these data to a
+   * stream. This allows to identify which tasks should be sped up (or split
+   * into smaller tasks) to reduce the total time.
+   *
+   * The tasks are started through Threads::new_task(). If
+   * MultithreadInfo::n_threads() returns one, the tasks are consequently run
+   * one after the other in the order in which they were added.
+   *
+   * If a task throws an exception, the tasks depending on it are not run.
+   * All other tasks are run to completion and run() then throws the first
+   * exception encountered.
+   *
+   * @ingroup tasks
+   */
+  class TaskGraph
+  {
+  public:
+    /**
+     * The type used to identify a task within the graph.
+     */
+    using TaskId = unsigned int;
+
+    /**
+     * Add a task with name @p name that executes @p function once all the
+     * tasks listed in @p dependencies have finished. All elements of
+     * @p dependencies must be identifiers previously returned by this
+     * function. Return the identifier of the new task.
+     */
+    TaskId
+    add_task(const std::string &          name,
+             const std::function<void()> &function,
+             const std::vector<TaskId> &  dependencies = {});
+
+    /**
+     * Return the number of tasks in the graph.
+     */
+    unsigned int
+    n_tasks() const;
+
+    /**
+     * Execute all tasks of the graph, respecting their dependencies, and
+     * wait for all of them to finish. The graph can be run several times.
+     */
+    void
+    run();
+
+    /**
+     * Return the wall time in seconds the task with identifier @p task spent
+     * in its function during the last call to run().
+     */
+    double
+    get_wall_time(const TaskId task) const;
+
+    /**
+     * Return the wall time in seconds of the last call to run().
+     */
+    double
+    get_total_wall_time() const;
+
+    /**
+     * Return the chain of tasks, each one depending on the previous one, for
+     * which the sum of the wall times recorded during the last call to run()
+     * is largest.
+     */
+    std::vector<TaskId>
+    critical_path() const;
+
+    /**
+     * Return the sum of the wall times of the tasks on the critical_path().
+     */
+    double
+    critical_path_length() const;
+
+    /**
+     * Write the wall time of each task, the total wall time, and the tasks
+     * on the critical path to @p out.
+     */
+    void
+    print_summary(std::ostream &out) const;
+
+    /**
+     * Remove all tasks from the graph.
+     */
+    void
+    clear();
+
+  private:
+    /**
+     * The data stored for each task.
+     */
+    struct Node
+    {
+      std::string           name;
+      std::function<void()> function;
+      std::vector<TaskId>   dependencies;
+      double                wall_time;
+    };
+
+    /**
+     * The tasks of the graph, in the order they were added.
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * The wall time of the last call to run().
+     */
+    double total_wall_time = 0.;
+  };
+
 } // namespace Threads
 
 /**
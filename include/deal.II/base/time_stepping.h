@@ -19,9 +19,11 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/signaling_nan.h>
 
 #include <functional>
+#include <utility>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -468,6 +470,51 @@ namespace TimeStepping
       VectorType &vec_ri,
       VectorType &vec_ki);
 
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t,
+     * fusing the update of the Runge-Kutta vectors with the application of
+     * the differential operator. Rather than returning $f(t,y)$ as a new
+     * vector, @p apply_operator is called as
+     * `apply_operator(t, src, dst, operation_before_range,
+     * operation_after_range)` and has to write $f(t,\text{src})$ into
+     * `dst`, which is already sized like @p solution. The two functors
+     * passed to it operate on ranges `[first, last)` of locally owned
+     * entries (in MPI-local numbering): `operation_before_range` sets the
+     * entries of `dst` in the range to zero, and `operation_after_range`
+     * performs the low-storage update of @p solution and @p vec_ri from the
+     * final entries of `dst` in the range. They have the same signature as
+     * the `operation_before_loop` and `operation_after_loop` arguments of
+     * MatrixFree::cell_loop() and can be passed there directly, so that the
+     * vector updates are done while the entries are still in cache, as in
+     * step-67. Otherwise, call `operation_before_range` and
+     * `operation_after_range` with the complete locally owned range before
+     * and after the operator evaluation, respectively.
+     *
+     * The update of a range must not happen before all entries of `src` in
+     * it have been read for the last time, because `src` and @p vec_ri are
+     * the same vector after the first stage. MatrixFree::cell_loop()
+     * guarantees this ordering.
+     *
+     * @note Partial ranges are only supported for vectors of type
+     * LinearAlgebra::distributed::Vector. For all other vector types, the
+     * functors have to be called with the complete locally owned range.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<
+        void(const double,
+             const VectorType &,
+             VectorType &,
+             const std::function<void(const unsigned int, const unsigned int)>
+               &,
+             const std::function<void(const unsigned int, const unsigned int)>
+               &)> &apply_operator,
+      double        t,
+      double        delta_t,
+      VectorType &  solution,
+      VectorType &  vec_ri,
+      VectorType &  vec_ki);
+
     /**
      * Get the coefficients of the scheme.
      * Note that here vector @p a is not the conventional definition in terms of a
@@ -856,6 +903,146 @@ namespace TimeStepping
      */
     Status status;
   };
+
+
+  /**
+   * A parallel-in-time driver implementing the Parareal algorithm. The time
+   * interval $[t_0, t_{\text{end}}]$ is split into as many slices of equal
+   * length as there are processes in the time communicator, and process $p$
+   * is responsible for the slice $[T_p, T_{p+1}]$. The user supplies two
+   * propagators that advance a state over a slice: an inexpensive but
+   * inaccurate coarse propagator $\mathcal G$ and the accurate fine
+   * propagator $\mathcal F$. Starting from a sequential sweep with the
+   * coarse propagator, each iteration runs the fine propagator on all slices
+   * concurrently and then corrects the states at the slice boundaries by
+   * the sequential update
+   * @f[
+   *   U_{p+1}^{k+1} = \mathcal G(U_p^{k+1}) + \mathcal F(U_p^k) -
+   *   \mathcal G(U_p^k).
+   * @f]
+   * After at most as many iterations as there are time slices, the result
+   * coincides with the one of a sequential run of the fine propagator.
+   * Parareal is equivalent to a two-level MGRIT method with F-relaxation.
+   *
+   * The spatial problem on each time slice may itself be distributed. In
+   * that case, the set of all processes is typically split into groups that
+   * each share a spatial communicator, and the time communicator connects
+   * the processes with the same rank in their spatial communicator, e.g.
+   * @code
+   *   MPI_Comm space_comm, time_comm;
+   *   MPI_Comm_split(MPI_COMM_WORLD, rank / n_space, rank, &space_comm);
+   *   MPI_Comm_split(MPI_COMM_WORLD, rank % n_space, rank, &time_comm);
+   * @endcode
+   * The vectors on all time slices must then have the same parallel layout,
+   * since only the locally owned entries are exchanged between neighboring
+   * slices.
+   */
+  template <typename VectorType>
+  class Parareal
+  {
+  public:
+    /**
+     * Type of a propagator, which advances the state @p y from time
+     * @p t_start to time @p t_end.
+     */
+    using Propagator = std::function<
+      void(const double t_start, const double t_end, VectorType &y)>;
+
+    /**
+     * Parameters controlling the iteration.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(const unsigned int max_iterations = 10,
+                     const double       tolerance      = 1e-10);
+
+      /**
+       * Maximal number of Parareal iterations after the initial coarse
+       * sweep.
+       */
+      unsigned int max_iterations;
+
+      /**
+       * The iteration is stopped once the maximum norm of the change of the
+       * states at the slice boundaries is below this value on all slices.
+       */
+      double tolerance;
+    };
+
+    /**
+     * Constructor. Each process in @p time_communicator handles one time
+     * slice, ordered by the rank.
+     */
+    Parareal(const MPI_Comm &      time_communicator,
+             const AdditionalData &data = AdditionalData());
+
+    /**
+     * Solve the problem on the interval [@p start_time, @p end_time]. On
+     * input, @p solution holds the initial value on the process with rank
+     * zero and is used to set up the vector layout on all other processes.
+     * On output, it holds the solution at the end of the time slice of the
+     * calling process, i.e., the process with the highest rank holds the
+     * solution at @p end_time. Returns the number of Parareal iterations.
+     */
+    unsigned int
+    solve(const Propagator &coarse,
+          const Propagator &fine,
+          const double      start_time,
+          const double      end_time,
+          VectorType &      solution) const;
+
+    /**
+     * Return the time interval [$T_p$, $T_{p+1}$] handled by the calling
+     * process.
+     */
+    std::pair<double, double>
+    get_time_slice(const double start_time, const double end_time) const;
+
+    /**
+     * Create a propagator that advances the state with the Runge-Kutta
+     * method @p method and a step size of @p time_step, with the last step
+     * of each slice shortened as described in DiscreteTime. The arguments
+     * @p f and @p id_minus_tau_J_inverse are passed on to
+     * RungeKutta::evolve_one_time_step(). The object @p method must live as
+     * long as the returned propagator is used.
+     */
+    static Propagator
+    make_propagator(
+      RungeKutta<VectorType> &                                           method,
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &          id_minus_tau_J_inverse,
+      const double time_step);
+
+  private:
+    /**
+     * Send the locally owned entries of @p vector to the process handling
+     * the next time slice.
+     */
+    void
+    send_to_next_slice(const VectorType &vector) const;
+
+    /**
+     * Receive the locally owned entries of @p vector from the process
+     * handling the previous time slice.
+     */
+    void
+    receive_from_previous_slice(VectorType &vector) const;
+
+    /**
+     * The communicator connecting the time slices.
+     */
+    const MPI_Comm time_communicator;
+
+    /**
+     * Parameters of the iteration.
+     */
+    const AdditionalData data;
+  };
 } // namespace TimeStepping
 
 DEAL_II_NAMESPACE_CLOSE
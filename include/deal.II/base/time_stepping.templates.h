@@ -18,13 +18,208 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/discrete_time.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/mpi_tags.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/time_stepping.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <algorithm>
 #include <functional>
+#include <limits>
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace TimeSteppingImplementation
+  {
+    template <typename Number>
+    using HostVector =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+
+
+    /**
+     * Make sure that @p vector has the same layout as @p reference. The
+     * entries are not initialized.
+     */
+    template <typename VectorType>
+    void
+    adjust_layout(VectorType &vector, const VectorType &reference)
+    {
+      if (vector.size() != reference.size())
+        vector = reference;
+    }
+
+
+
+    template <typename Number>
+    void
+    adjust_layout(HostVector<Number> &      vector,
+                  const HostVector<Number> &reference)
+    {
+      if (!vector.partitioners_are_compatible(*reference.get_partitioner()))
+        vector.reinit(reference, true);
+    }
+
+
+
+    /**
+     * Set the locally owned entries of @p vector in the range [first, last)
+     * to zero. The generic version can only work on the complete vector.
+     */
+    template <typename VectorType>
+    void
+    zero_range(VectorType &       vector,
+               const unsigned int first,
+               const unsigned int last)
+    {
+      (void)first;
+      (void)last;
+      Assert(first == 0 && last == vector.locally_owned_size(),
+             ExcMessage("Partial ranges are only supported for vectors of "
+                        "type LinearAlgebra::distributed::Vector."));
+      vector = 0;
+    }
+
+
+
+    template <typename Number>
+    void
+    zero_range(HostVector<Number> &vector,
+               const unsigned int  first,
+               const unsigned int  last)
+    {
+      AssertIndexRange(last, vector.locally_owned_size() + 1);
+      std::fill(vector.begin() + first, vector.begin() + last, Number());
+    }
+
+
+
+    /**
+     * Perform the vector updates of one stage of a low-storage Runge-Kutta
+     * method, i.e., next_ri = solution + ai * vec_ki (unless @p ai is zero)
+     * and solution += bi * vec_ki, on the complete vector. The generic
+     * version uses the vector operations of @p VectorType, which run over
+     * the vectors several times.
+     */
+    template <typename VectorType>
+    void
+    low_storage_update(const double      ai,
+                       const double      bi,
+                       const VectorType &vec_ki,
+                       VectorType &      solution,
+                       VectorType &      next_ri)
+    {
+      if (ai == double())
+        {
+          solution.sadd(1., bi, vec_ki);
+        }
+      else
+        {
+          next_ri = solution;
+          next_ri.sadd(1., ai, vec_ki);
+          solution.add(bi, vec_ki);
+        }
+    }
+
+
+
+    /**
+     * Same as above, restricted to the locally owned entries in the range
+     * [first, last). The generic version can only work on the complete
+     * vector.
+     */
+    template <typename VectorType>
+    void
+    low_storage_update(const double       ai,
+                       const double       bi,
+                       const VectorType & vec_ki,
+                       VectorType &       solution,
+                       VectorType &       next_ri,
+                       const unsigned int first,
+                       const unsigned int last)
+    {
+      (void)first;
+      (void)last;
+      Assert(first == 0 && last == solution.locally_owned_size(),
+             ExcMessage("Partial ranges are only supported for vectors of "
+                        "type LinearAlgebra::distributed::Vector."));
+      low_storage_update(ai, bi, vec_ki, solution, next_ri);
+    }
+
+
+
+    /**
+     * For LinearAlgebra::distributed::Vector, all vectors are updated in a
+     * single sweep over the range, reading vec_ki and solution only once.
+     * The vector @p next_ri needs to have the layout of @p solution already.
+     */
+    template <typename Number>
+    void
+    low_storage_update(const double              ai,
+                       const double              bi,
+                       const HostVector<Number> &vec_ki,
+                       HostVector<Number> &      solution,
+                       HostVector<Number> &      next_ri,
+                       const unsigned int        first,
+                       const unsigned int        last)
+    {
+      AssertIndexRange(last, solution.locally_owned_size() + 1);
+      const Number  factor_ai       = ai;
+      const Number  factor_solution = bi;
+      const Number *k               = vec_ki.begin();
+      Number *      u               = solution.begin();
+      if (ai == double())
+        {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = first; i < last; ++i)
+            u[i] += factor_solution * k[i];
+        }
+      else
+        {
+          Number *r = next_ri.begin();
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = first; i < last; ++i)
+            {
+              const Number k_i = k[i];
+              const Number u_i = u[i];
+              r[i]             = u_i + factor_ai * k_i;
+              u[i]             = u_i + factor_solution * k_i;
+            }
+        }
+    }
+
+
+
+    template <typename Number>
+    void
+    low_storage_update(const double              ai,
+                       const double              bi,
+                       const HostVector<Number> &vec_ki,
+                       HostVector<Number> &      solution,
+                       HostVector<Number> &      next_ri)
+    {
+      if (ai != double())
+        adjust_layout(next_ri, solution);
+      parallel::apply_to_subranges(
+        0U,
+        solution.locally_owned_size(),
+        [&](const unsigned int first, const unsigned int last) {
+          low_storage_update(ai, bi, vec_ki, solution, next_ri, first, last);
+        },
+        internal::VectorImplementation::minimum_parallel_grain_size);
+    }
+  } // namespace TimeSteppingImplementation
+} // namespace internal
+
+
+
 namespace TimeStepping
 {
   // ----------------------------------------------------------------------
@@ -416,6 +611,61 @@ namespace TimeStepping
     return (t + delta_t);
   }
 
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<
+      void(const double,
+           const VectorType &,
+           VectorType &,
+           const std::function<void(const unsigned int, const unsigned int)> &,
+           const std::function<void(const unsigned int, const unsigned int)>
+             &)> &apply_operator,
+    double        t,
+    double        delta_t,
+    VectorType &  solution,
+    VectorType &  vec_ri,
+    VectorType &  vec_ki)
+  {
+    internal::TimeSteppingImplementation::adjust_layout(vec_ki, solution);
+    internal::TimeSteppingImplementation::adjust_layout(vec_ri, solution);
+
+    const auto perform_stage = [&](const double      t_stage,
+                                   const double      factor_solution,
+                                   const double      factor_ai,
+                                   const VectorType &current_ri) {
+      apply_operator(
+        t_stage,
+        current_ri,
+        vec_ki,
+        [&](const unsigned int first, const unsigned int last) {
+          internal::TimeSteppingImplementation::zero_range(vec_ki,
+                                                           first,
+                                                           last);
+        },
+        [&](const unsigned int first, const unsigned int last) {
+          internal::TimeSteppingImplementation::low_storage_update(
+            factor_ai, factor_solution, vec_ki, solution, vec_ri, first, last);
+        });
+    };
+
+    perform_stage(t, this->b[0] * delta_t, this->a[0][0] * delta_t, solution);
+
+    for (unsigned int stage = 1; stage < this->n_stages; ++stage)
+      {
+        const double c_i = this->c[stage];
+        const double factor_ai =
+          (stage == this->n_stages - 1 ? 0 : this->a[0][stage] * delta_t);
+        perform_stage(t + c_i * delta_t,
+                      this->b[stage] * delta_t,
+                      factor_ai,
+                      vec_ri);
+      }
+    return (t + delta_t);
+  }
+
   template <typename VectorType>
   void
   LowStorageRungeKutta<VectorType>::get_coefficients(
@@ -452,20 +702,10 @@ namespace TimeStepping
     VectorType &      solution,
     VectorType &      next_ri) const
   {
-    const double ai = factor_ai;
-    const double bi = factor_solution;
-    vec_ki          = f(t, current_ri);
+    vec_ki = f(t, current_ri);
 
-    if (ai == double())
-      {
-        solution.sadd(1., bi, vec_ki);
-      }
-    else
-      {
-        next_ri = solution;
-        next_ri.sadd(1., ai, vec_ki);
-        solution.add(bi, vec_ki);
-      }
+    internal::TimeSteppingImplementation::low_storage_update(
+      factor_ai, factor_solution, vec_ki, solution, next_ri);
   }
 
 
@@ -1145,6 +1385,208 @@ namespace TimeStepping
         f_stages[i] = f(t + this->c[i] * delta_t, Y);
       }
   }
+
+
+
+  // ----------------------------------------------------------------------
+  // Parareal
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  Parareal<VectorType>::AdditionalData::AdditionalData(
+    const unsigned int max_iterations,
+    const double       tolerance)
+    : max_iterations(max_iterations)
+    , tolerance(tolerance)
+  {}
+
+
+
+  template <typename VectorType>
+  Parareal<VectorType>::Parareal(const MPI_Comm &      time_communicator,
+                                 const AdditionalData &data)
+    : time_communicator(time_communicator)
+    , data(data)
+  {}
+
+
+
+  template <typename VectorType>
+  std::pair<double, double>
+  Parareal<VectorType>::get_time_slice(const double start_time,
+                                       const double end_time) const
+  {
+    const unsigned int n_slices =
+      Utilities::MPI::n_mpi_processes(time_communicator);
+    const unsigned int slice =
+      Utilities::MPI::this_mpi_process(time_communicator);
+
+    // compute the end of the last slice explicitly to avoid round-off
+    const double slice_length = (end_time - start_time) / n_slices;
+    return {start_time + slice * slice_length,
+            slice + 1 == n_slices ? end_time :
+                                    start_time + (slice + 1) * slice_length};
+  }
+
+
+
+  template <typename VectorType>
+  unsigned int
+  Parareal<VectorType>::solve(const Propagator &coarse,
+                              const Propagator &fine,
+                              const double      start_time,
+                              const double      end_time,
+                              VectorType &      solution) const
+  {
+    Assert(end_time > start_time,
+           ExcMessage("The end time must be larger than the start time."));
+
+    const unsigned int n_slices =
+      Utilities::MPI::n_mpi_processes(time_communicator);
+    const unsigned int slice =
+      Utilities::MPI::this_mpi_process(time_communicator);
+    const std::pair<double, double> interval =
+      get_time_slice(start_time, end_time);
+
+    // with a single time slice, the fine propagator gives the result directly
+    if (n_slices == 1)
+      {
+        fine(interval.first, interval.second, solution);
+        return 0;
+      }
+
+    // initial sweep with the coarse propagator, which is sequential over the
+    // time slices
+    VectorType slice_start(solution);
+    if (slice > 0)
+      receive_from_previous_slice(slice_start);
+
+    VectorType coarse_old(slice_start);
+    coarse(interval.first, interval.second, coarse_old);
+    solution = coarse_old;
+
+    if (slice + 1 < n_slices)
+      send_to_next_slice(solution);
+
+    VectorType fine_result(slice_start);
+    VectorType coarse_new(slice_start);
+
+    unsigned int iteration = 0;
+    while (iteration < data.max_iterations)
+      {
+        ++iteration;
+
+        // the fine propagation runs concurrently on all time slices
+        fine_result = slice_start;
+        fine(interval.first, interval.second, fine_result);
+
+        // sequential correction with the updated state at the start of the
+        // slice
+        if (slice > 0)
+          receive_from_previous_slice(slice_start);
+
+        coarse_new = slice_start;
+        coarse(interval.first, interval.second, coarse_new);
+
+        // compute U = G(U_new) + F(U_old) - G(U_old) in fine_result and
+        // measure the change with respect to the previous iterate
+        fine_result += coarse_new;
+        fine_result -= coarse_old;
+        coarse_old.swap(coarse_new);
+        solution -= fine_result;
+        const double change = solution.linfty_norm();
+        solution.swap(fine_result);
+
+        if (slice + 1 < n_slices)
+          send_to_next_slice(solution);
+
+        // after as many iterations as there are slices, the fine solution
+        // has been propagated through the whole interval
+        if (Utilities::MPI::max(change, time_communicator) < data.tolerance ||
+            iteration >= n_slices)
+          break;
+      }
+
+    return iteration;
+  }
+
+
+
+  template <typename VectorType>
+  typename Parareal<VectorType>::Propagator
+  Parareal<VectorType>::make_propagator(
+    RungeKutta<VectorType> &                                           method,
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      &          id_minus_tau_J_inverse,
+    const double time_step)
+  {
+    return [&method, f, id_minus_tau_J_inverse, time_step](
+             const double t_start, const double t_end, VectorType &y) {
+      DiscreteTime time(t_start, t_end, time_step);
+      while (time.is_at_end() == false)
+        {
+          method.evolve_one_time_step(f,
+                                      id_minus_tau_J_inverse,
+                                      time.get_current_time(),
+                                      time.get_next_step_size(),
+                                      y);
+          time.advance_time();
+        }
+    };
+  }
+
+
+
+  template <typename VectorType>
+  void
+  Parareal<VectorType>::send_to_next_slice(const VectorType &vector) const
+  {
+#ifdef DEAL_II_WITH_MPI
+    AssertThrow(vector.locally_owned_size() <
+                  static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                ExcMessage("The vector is too large to be sent in one piece."));
+
+    const int ierr =
+      MPI_Send(vector.begin(),
+               static_cast<int>(vector.locally_owned_size()),
+               Utilities::MPI::internal::mpi_type_id(vector.begin()),
+               Utilities::MPI::this_mpi_process(time_communicator) + 1,
+               Utilities::MPI::internal::Tags::time_stepping_parareal,
+               time_communicator);
+    AssertThrowMPI(ierr);
+#else
+    (void)vector;
+    Assert(false, ExcNeedsMPI());
+#endif
+  }
+
+
+
+  template <typename VectorType>
+  void
+  Parareal<VectorType>::receive_from_previous_slice(VectorType &vector) const
+  {
+#ifdef DEAL_II_WITH_MPI
+    AssertThrow(vector.locally_owned_size() <
+                  static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                ExcMessage("The vector is too large to be sent in one piece."));
+
+    const int ierr =
+      MPI_Recv(vector.begin(),
+               static_cast<int>(vector.locally_owned_size()),
+               Utilities::MPI::internal::mpi_type_id(vector.begin()),
+               Utilities::MPI::this_mpi_process(time_communicator) - 1,
+               Utilities::MPI::internal::Tags::time_stepping_parareal,
+               time_communicator,
+               MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+#else
+    (void)vector;
+    Assert(false, ExcNeedsMPI());
+#endif
+  }
 } // namespace TimeStepping
 
 DEAL_II_NAMESPACE_CLOSE
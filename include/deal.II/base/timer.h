@@ -539,6 +539,26 @@ private:
  * taken by the 10\% of the slowest and fastest ranks, respectively, to get
  * additional insight into the statistical distribution.
  *
+ * <h3>Performance metrics</h3>
+ *
+ * Time alone does not tell whether a section is limited by the arithmetic
+ * throughput or by the memory bandwidth of the machine. For sections whose
+ * number of floating point operations and amount of transferred data are
+ * known, e.g., from counting them in a matrix-free operator evaluation, these
+ * numbers can be reported through add_operation_counts(). The function
+ * print_throughput_statistics() then computes the achieved GFLOP/s and GB/s
+ * as well as the arithmetic intensity of each section, with the counts summed
+ * and the wall times maximized over all MPI ranks.
+ *
+ * If deal.II was configured with the LIKWID library (see
+ * https://github.com/RRZE-HPC/likwid), enter_subsection() and
+ * leave_subsection() also open and close a LIKWID marker region with the name
+ * of the section, once this has been enabled with enable_likwid_markers().
+ * When the program is then run under <code>likwid-perfctr -m</code>, the
+ * hardware counters, and the FLOP rates and memory bandwidths derived from
+ * them, are reported for each section. Marker regions need to be entered and
+ * left on the same thread.
+ *
  * @ingroup utilities
  */
 class TimerOutput
@@ -809,6 +829,36 @@ public:
   print_wall_time_statistics(const MPI_Comm &mpi_comm,
                              const double    print_quantile = 0.) const;
 
+  /**
+   * Add @p n_flops floating point operations and @p n_bytes bytes transferred
+   * from or to main memory to the counts of the section @p section_name,
+   * which must have been entered at least once. The counts are accumulated
+   * over all calls and are used by print_throughput_statistics().
+   */
+  void
+  add_operation_counts(const std::string &section_name,
+                       const double       n_flops,
+                       const double       n_bytes);
+
+  /**
+   * Print a formatted table with the achieved floating point throughput in
+   * GFLOP/s, the memory throughput in GB/s, and the arithmetic intensity in
+   * FLOP/byte for all sections for which add_operation_counts() has been
+   * called. The operation counts are summed over all ranks in @p mpi_comm,
+   * and divided by the maximal wall time of the section over these ranks.
+   */
+  void
+  print_throughput_statistics(const MPI_Comm &mpi_comm) const;
+
+  /**
+   * Enable or disable opening and closing LIKWID marker regions in
+   * enter_subsection() and leave_subsection(). See the documentation of this
+   * class for details. If deal.II was not configured with LIKWID, this
+   * function has no effect.
+   */
+  void
+  enable_likwid_markers(const bool enable = true);
+
   /**
    * By calling this function, all output can be disabled. This function
    * together with enable_output() can be useful if one wants to control the
@@ -861,6 +911,14 @@ private:
     double       total_cpu_time;
     double       total_wall_time;
     unsigned int n_calls;
+    double       n_flops;
+    double       n_bytes;
+
+    /**
+     * The time at which the section was last entered, used for the events
+     * recorded by the Tracing namespace.
+     */
+    std::chrono::steady_clock::time_point trace_start_time;
   };
 
   /**
@@ -879,6 +937,12 @@ private:
    */
   bool output_is_enabled;
 
+  /**
+   * Whether LIKWID marker regions are opened and closed together with the
+   * sections.
+   */
+  bool use_likwid_markers;
+
   /**
    * A list of the sections that have been entered and not exited. The list is
    * kept in the order in which sections have been entered, but elements may
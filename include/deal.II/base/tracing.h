@@ -0,0 +1,240 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_tracing_h
+#define dealii_tracing_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A namespace for recording a timeline of the phases of a program, to be
+ * viewed in the trace viewers of the Chromium browser (chrome://tracing) or
+ * of the Perfetto project (https://ui.perfetto.dev).
+ *
+ * While TimerOutput accumulates the time spent in the various sections of a
+ * program, the functions in this namespace record each individual execution
+ * of a phase as an event with its start time, duration, and the thread and
+ * MPI rank it ran on. This makes load imbalance between threads and ranks,
+ * idle times, and the overlap of communication and computation visible.
+ *
+ * Recording is disabled by default. Once enabled with Tracing::enable(), the
+ * following phases of the library are recorded:
+ * - the sections of TimerOutput,
+ * - the chunks of work processed by the worker and copier functions within
+ *   WorkStream::run(),
+ * - the cell, face, and boundary ranges processed within MatrixFree::loop()
+ *   and MatrixFree::cell_loop(),
+ * - the start and finish phases of the data exchange of
+ *   Utilities::MPI::Partitioner.
+ *
+ * User code can add its own phases through Tracing::Scope objects:
+ * @code
+ *   Tracing::enable();
+ *   ...
+ *   {
+ *     Tracing::Scope scope("assemble rhs", "user");
+ *     assemble_rhs();
+ *   }
+ *   ...
+ *   Tracing::write_chrome_trace("trace", MPI_COMM_WORLD);
+ * @endcode
+ * This writes the files <tt>trace_0000.json</tt>, <tt>trace_0001.json</tt>,
+ * etc., one per MPI rank, in the Chrome trace event format that both of the
+ * viewers mentioned above can load.
+ *
+ * The events of each thread are kept in a ring buffer of fixed size, so
+ * once the buffer is full, the oldest events of that thread are overwritten.
+ * This bounds the memory consumption and the overhead of long runs. When
+ * recording is disabled, the overhead of each instrumented phase is a single
+ * read of an atomic variable.
+ *
+ * The times of all events are measured relative to the call to enable(). In
+ * order to compare the times of different MPI ranks, call enable() on all
+ * ranks directly after a barrier.
+ *
+ * @ingroup utilities
+ */
+namespace Tracing
+{
+  /**
+   * Start recording events, discarding all previously recorded events. Each
+   * thread keeps up to @p events_per_thread events.
+   *
+   * This function must not be called while other threads record events.
+   */
+  void
+  enable(const unsigned int events_per_thread = 65536);
+
+  /**
+   * Stop recording events. The events recorded so far are kept and can still
+   * be written with write_chrome_trace().
+   */
+  void
+  disable();
+
+  /**
+   * Return whether events are currently recorded.
+   */
+  bool
+  is_enabled();
+
+  /**
+   * Discard all recorded events.
+   *
+   * This function must not be called while other threads record events.
+   */
+  void
+  clear();
+
+  /**
+   * Record an event with the given @p name and @p category that started at
+   * @p start and ended at @p end, on the calling thread. @p category must
+   * point to a string that lives until the events are written, typically a
+   * string literal. This function does nothing if recording is disabled.
+   */
+  void
+  add_event(const std::string &                          name,
+            const char *                                 category,
+            const std::chrono::steady_clock::time_point &start,
+            const std::chrono::steady_clock::time_point &end);
+
+  /**
+   * Write the events recorded on this MPI rank to the file
+   * <tt>filename_without_extension_XXXX.json</tt>, where <tt>XXXX</tt> is
+   * the rank within @p mpi_communicator, in the Chrome trace event format.
+   * The rank is used as process id and the threads are numbered in the order
+   * in which they recorded their first event.
+   */
+  void
+  write_chrome_trace(const std::string &filename_without_extension,
+                     const MPI_Comm &   mpi_communicator = MPI_COMM_SELF);
+
+  /**
+   * A class that records an event for the time between its construction and
+   * its destruction, similar to TimerOutput::Scope.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Constructor. The @p name and @p category must point to strings that
+     * live until the destructor is called, typically string literals.
+     */
+    Scope(const char *name, const char *category);
+
+    /**
+     * Constructor for names that are not known at compile time. The name is
+     * only copied if recording is enabled.
+     */
+    Scope(const std::string &name, const char *category);
+
+    /**
+     * Destructor. Records the event.
+     */
+    ~Scope();
+
+  private:
+    /**
+     * Whether recording was enabled upon construction.
+     */
+    const bool active;
+
+    /**
+     * The name of the event, either as a pointer to a static string or as a
+     * copy.
+     */
+    const char *name;
+    std::string name_copy;
+
+    /**
+     * The category of the event.
+     */
+    const char *category;
+
+    /**
+     * The time at which the object was constructed.
+     */
+    std::chrono::steady_clock::time_point start;
+  };
+
+
+
+  namespace internal
+  {
+    /**
+     * The flag queried by is_enabled().
+     */
+    extern std::atomic<bool> recording_is_enabled;
+  } // namespace internal
+
+
+
+  /* ---------------------- inline functions ---------------------- */
+
+  inline bool
+  is_enabled()
+  {
+    return internal::recording_is_enabled.load(std::memory_order_relaxed);
+  }
+
+
+
+  inline Scope::Scope(const char *name, const char *category)
+    : active(is_enabled())
+    , name(name)
+    , category(category)
+  {
+    if (active)
+      start = std::chrono::steady_clock::now();
+  }
+
+
+
+  inline Scope::Scope(const std::string &name, const char *category)
+    : active(is_enabled())
+    , name(nullptr)
+    , category(category)
+  {
+    if (active)
+      {
+        name_copy = name;
+        start     = std::chrono::steady_clock::now();
+      }
+  }
+
+
+
+  inline Scope::~Scope()
+  {
+    if (active)
+      add_event(name != nullptr ? std::string(name) : name_copy,
+                category,
+                start,
+                std::chrono::steady_clock::now());
+  }
+} // namespace Tracing
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <deal.II/base/exceptions.h>
 
+#include <cstring>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -60,10 +61,16 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
 DEAL_II_NAMESPACE_OPEN
 
-// forward declare Point
+// forward declare Point and ArrayView
 #ifndef DOXYGEN
 template <int dim, typename Number>
 class Point;
+template <typename ElementType, typename MemorySpaceType>
+class ArrayView;
+namespace MemorySpace
+{
+  struct Host;
+}
 #endif
 
 /**
@@ -570,6 +577,18 @@ namespace Utilities
    * If many consecutive calls with the same buffer are considered, it is
    * recommended for reasons of performance to ensure that its capacity is
    * sufficient.
+   *
+   * Not all objects go through boost::serialization: objects of a trivially
+   * copyable type (see std::is_trivially_copyable) that are smaller than 256
+   * bytes are always copied into the buffer byte by byte via std::memcpy. If
+   * @p allow_compression is false, the same is done for trivially copyable
+   * objects of any size and for objects of type std::vector<T> with a
+   * trivially copyable type T (except for `bool`), for which the elements
+   * are copied as one contiguous block of memory. This avoids the overhead
+   * of the serialization machinery on the hot paths of the library that
+   * exchange such data between MPI processes. Since the data is not
+   * converted into a portable format, such buffers can only be unpacked on a
+   * machine with the same binary representation of T.
    */
   template <typename T>
   size_t
@@ -577,6 +596,21 @@ namespace Utilities
        std::vector<char> &dest_buffer,
        const bool         allow_compression = true);
 
+  /**
+   * Same as above, but write the packed object to the beginning of
+   * @p dest_buffer, a piece of memory provided by the caller such as a part
+   * of a larger send buffer, instead of appending it to a std::vector. No
+   * memory is allocated for objects that are copied via std::memcpy as
+   * described above; all other objects are serialized into a temporary
+   * buffer first. The number of bytes written is returned, and an exception
+   * is thrown if @p dest_buffer is too small to hold the packed object.
+   */
+  template <typename T, typename MemorySpaceType>
+  size_t
+  pack(const T &                               object,
+       const ArrayView<char, MemorySpaceType> &dest_buffer,
+       const bool                              allow_compression = true);
+
   /**
    * Creates and returns a buffer solely for the given object, using the
    * above mentioned pack function.
@@ -637,6 +671,22 @@ namespace Utilities
          const std::vector<char>::const_iterator &cend,
          const bool                               allow_compression = true);
 
+  /**
+   * Same unpack function as above, but takes (a fraction of) a packed buffer
+   * in the form of an ArrayView, for example a view into a receive buffer or
+   * into memory owned by another library. The data is read directly from
+   * the memory @p buffer points to, without copying it into a std::vector
+   * first.
+   *
+   * The @p allow_compression parameter denotes if the buffer to
+   * read from could have been previously compressed with ZLIB, and
+   * is only of effect if ZLIB is enabled.
+   */
+  template <typename T, typename MemorySpaceType>
+  T
+  unpack(const ArrayView<const char, MemorySpaceType> &buffer,
+         const bool allow_compression = true);
+
   /**
    * Given a vector of characters, obtained through a call to the function
    * Utilities::pack, restore its content in an array of type T.
@@ -926,6 +976,43 @@ namespace Utilities
      */
     void
     posix_memalign(void **memptr, std::size_t alignment, std::size_t size);
+
+    /**
+     * Advise the operating system to back the memory block starting at
+     * @p memptr with a size of @p size bytes by transparent huge pages,
+     * which reduces the number of TLB misses when accessing large arrays.
+     * For this to be effective, the block should be aligned to the size of
+     * a huge page and not have been touched yet.
+     *
+     * This function is only a hint and does nothing on systems other than
+     * Linux or if the kernel does not support transparent huge pages.
+     */
+    void
+    advise_transparent_huge_pages(void *memptr, std::size_t size);
+
+    /**
+     * Map @p size bytes of the file @p filename, starting at byte
+     * @p offset, into the address space of the calling process. Return the
+     * address of the first mapped byte together with a function that
+     * releases the mapping again.
+     *
+     * If @p write_through is true, changes to the mapped memory are written
+     * back to the file. Otherwise, the file is only read and changes stay
+     * private to the calling process. In both cases, the operating system
+     * loads the data lazily upon first access and is free to evict pages
+     * that have not been modified, so that files larger than the main
+     * memory can be mapped. The memory is advised for sequential access,
+     * which enables aggressive read-ahead.
+     *
+     * This function throws an exception if the file cannot be opened, if it
+     * is shorter than <tt>offset + size</tt> bytes, or on systems other than
+     * Linux.
+     */
+    std::pair<void *, std::function<void()>>
+    map_file(const std::string &filename,
+             const std::size_t  offset,
+             const std::size_t  size,
+             const bool         write_through);
   } // namespace System
 
 
@@ -1072,6 +1159,224 @@ namespace Utilities
 } // namespace Utilities
 
 
+namespace internal
+{
+  namespace PackingHelpers
+  {
+    /**
+     * A type trait that is true for std::vector<T> with a trivially
+     * copyable type T, whose elements can be packed as one contiguous block
+     * of memory. std::vector<bool> is excluded since it does not store its
+     * elements contiguously.
+     */
+    template <typename T>
+    struct IsVectorOfTriviallyCopyable : std::false_type
+    {};
+
+    template <typename T, typename Allocator>
+    struct IsVectorOfTriviallyCopyable<std::vector<T, Allocator>>
+      : std::integral_constant<bool,
+                               std::is_trivially_copyable<T>::value &&
+                                 !std::is_same<T, bool>::value>
+    {};
+
+    /**
+     * A type trait that is true for the objects that are always packed
+     * via std::memcpy, regardless of whether compression is allowed.
+     */
+    template <typename T>
+    using IsAlwaysCopied =
+      std::integral_constant<bool,
+                             std::is_trivially_copyable<T>::value &&
+                               (sizeof(T) < 256)>;
+
+    /**
+     * Tags for the ways in which an object can be copied into a buffer:
+     * not at all (i.e., it has to be serialized), as the object itself,
+     * or as the elements of a vector.
+     */
+    using NotCopyable      = std::integral_constant<int, 0>;
+    using CopyObject       = std::integral_constant<int, 1>;
+    using CopyVectorValues = std::integral_constant<int, 2>;
+
+    template <typename T>
+    using CopyMethod = std::integral_constant<
+      int,
+      std::is_trivially_copyable<T>::value ?
+        1 :
+        (IsVectorOfTriviallyCopyable<T>::value ? 2 : 0)>;
+
+    /**
+     * Return whether objects of type T are packed via std::memcpy for the
+     * given value of @p allow_compression.
+     */
+    template <typename T>
+    inline bool
+    use_memcpy(const bool allow_compression)
+    {
+      return IsAlwaysCopied<T>::value ||
+             ((CopyMethod<T>::value != NotCopyable::value) &&
+              !allow_compression);
+    }
+
+    /**
+     * Return the number of bytes to copy for @p object and a pointer to the
+     * first of them.
+     */
+    template <typename T>
+    inline std::pair<const char *, std::size_t>
+    get_bytes(const T &, NotCopyable)
+    {
+      Assert(false, ExcInternalError());
+      return {nullptr, 0};
+    }
+
+    template <typename T>
+    inline std::pair<const char *, std::size_t>
+    get_bytes(const T &object, CopyObject)
+    {
+      return {reinterpret_cast<const char *>(&object), sizeof(T)};
+    }
+
+    template <typename T>
+    inline std::pair<const char *, std::size_t>
+    get_bytes(const T &object, CopyVectorValues)
+    {
+      return {reinterpret_cast<const char *>(object.data()),
+              object.size() * sizeof(typename T::value_type)};
+    }
+
+    /**
+     * Restore @p object from the bytes in the range [begin, end), which
+     * have been obtained through get_bytes().
+     */
+    template <typename T>
+    inline void
+    set_bytes(const char *, const char *, T &, NotCopyable)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+    template <typename T>
+    inline void
+    set_bytes(const char *begin, const char *end, T &object, CopyObject)
+    {
+      Assert(static_cast<std::size_t>(end - begin) == sizeof(T),
+             ExcInternalError());
+      (void)end;
+      std::memcpy(&object, begin, sizeof(T));
+    }
+
+    template <typename T>
+    inline void
+    set_bytes(const char *begin,
+              const char *end,
+              T &         object,
+              CopyVectorValues)
+    {
+      using value_type = typename T::value_type;
+      Assert((end - begin) % sizeof(value_type) == 0, ExcInternalError());
+      object.resize((end - begin) / sizeof(value_type));
+      if (end != begin)
+        std::memcpy(object.data(), begin, end - begin);
+    }
+
+    /**
+     * Serialize @p object with boost::serialization and append it to
+     * @p dest_buffer. The overload for objects that are always copied
+     * exists so that the serialization machinery is not instantiated for
+     * types that do not support it.
+     */
+    template <typename T>
+    void
+    serialize(const T &, std::vector<char> &, const bool, std::true_type)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+    template <typename T>
+    void
+    serialize(const T &          object,
+              std::vector<char> &dest_buffer,
+              const bool         allow_compression,
+              std::false_type)
+    {
+      // use buffer as the target of a compressing
+      // stream into which we serialize the current object
+      boost::iostreams::filtering_ostreambuf fosb;
+#ifdef DEAL_II_WITH_ZLIB
+      if (allow_compression)
+        fosb.push(boost::iostreams::gzip_compressor());
+#else
+      (void)allow_compression;
+#endif
+      fosb.push(boost::iostreams::back_inserter(dest_buffer));
+
+      boost::archive::binary_oarchive boa(fosb);
+      boa << object;
+      // the stream object has to be destroyed before the function returns
+      // to ensure that all data has been written in the buffer
+    }
+
+    /**
+     * Restore @p object from the serialized data in the range
+     * [begin, end). The first overload is the counterpart of the one of
+     * serialize().
+     */
+    template <typename T>
+    void
+    deserialize(const char *, const char *, const bool, T &, std::true_type)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+    template <typename T>
+    void
+    deserialize(const char *begin,
+                const char *end,
+                const bool  allow_compression,
+                T &         object,
+                std::false_type)
+    {
+      // decompress the buffer section into the object
+      boost::iostreams::filtering_istreambuf fisb;
+#ifdef DEAL_II_WITH_ZLIB
+      if (allow_compression)
+        fisb.push(boost::iostreams::gzip_decompressor());
+#else
+      (void)allow_compression;
+#endif
+      fisb.push(boost::iostreams::array_source(begin, end));
+
+      boost::archive::binary_iarchive bia(fisb);
+      bia >> object;
+    }
+
+    /**
+     * Restore an object of type T from the packed data in the range
+     * [begin, end).
+     */
+    template <typename T>
+    T
+    unpack(const char *begin, const char *end, const bool allow_compression)
+    {
+      T object;
+
+      // see if the object is copyable via memcpy. if so, use this fast
+      // path. otherwise, we have to go through the BOOST serialization
+      // machinery
+      if (use_memcpy<T>(allow_compression))
+        set_bytes(begin, end, object, CopyMethod<T>());
+      else
+        deserialize(begin, end, allow_compression, object, IsAlwaysCopied<T>());
+
+      return object;
+    }
+  } // namespace PackingHelpers
+} // namespace internal
+
+
+
 // --------------------- inline functions
 
 namespace Utilities
@@ -1219,49 +1524,65 @@ namespace Utilities
        std::vector<char> &dest_buffer,
        const bool         allow_compression)
   {
-    std::size_t size = 0;
+    const std::size_t previous_size = dest_buffer.size();
 
-    // see if the object is small and copyable via memcpy. if so, use
-    // this fast path. otherwise, we have to go through the BOOST
-    // serialization machinery
-#ifdef DEAL_II_HAVE_CXX17
-    if constexpr (std::is_trivially_copyable<T>() && sizeof(T) < 256)
-#else
-    if (std::is_trivially_copyable<T>() && sizeof(T) < 256)
-#endif
+    // see if the object is copyable via memcpy. if so, use this fast
+    // path. otherwise, we have to go through the BOOST serialization
+    // machinery
+    if (internal::PackingHelpers::use_memcpy<T>(allow_compression))
       {
-        (void)allow_compression;
-        const std::size_t previous_size = dest_buffer.size();
-        dest_buffer.resize(previous_size + sizeof(T));
+        const auto bytes = internal::PackingHelpers::get_bytes(
+          object, internal::PackingHelpers::CopyMethod<T>());
+        dest_buffer.resize(previous_size + bytes.second);
+        if (bytes.second > 0)
+          std::memcpy(dest_buffer.data() + previous_size,
+                      bytes.first,
+                      bytes.second);
+      }
+    else
+      internal::PackingHelpers::serialize(
+        object,
+        dest_buffer,
+        allow_compression,
+        internal::PackingHelpers::IsAlwaysCopied<T>());
+
+    return dest_buffer.size() - previous_size;
+  }
 
-        std::memcpy(dest_buffer.data() + previous_size, &object, sizeof(T));
 
-        size = sizeof(T);
+  template <typename T, typename MemorySpaceType>
+  size_t
+  pack(const T &                               object,
+       const ArrayView<char, MemorySpaceType> &dest_buffer,
+       const bool                              allow_compression)
+  {
+    static_assert(std::is_same<MemorySpaceType, MemorySpace::Host>::value,
+                  "Objects can only be packed into host memory.");
+
+    if (internal::PackingHelpers::use_memcpy<T>(allow_compression))
+      {
+        // copy the object directly into the destination
+        const auto bytes = internal::PackingHelpers::get_bytes(
+          object, internal::PackingHelpers::CopyMethod<T>());
+        AssertThrow(bytes.second <= dest_buffer.size(),
+                    ExcMessage("The buffer is too small to hold the packed "
+                               "object."));
+        if (bytes.second > 0)
+          std::memcpy(dest_buffer.data(), bytes.first, bytes.second);
+        return bytes.second;
       }
     else
       {
-        // use buffer as the target of a compressing
-        // stream into which we serialize the current object
-        const std::size_t previous_size = dest_buffer.size();
-        {
-          boost::iostreams::filtering_ostreambuf fosb;
-#ifdef DEAL_II_WITH_ZLIB
-          if (allow_compression)
-            fosb.push(boost::iostreams::gzip_compressor());
-#else
-          (void)allow_compression;
-#endif
-          fosb.push(boost::iostreams::back_inserter(dest_buffer));
-
-          boost::archive::binary_oarchive boa(fosb);
-          boa << object;
-          // the stream object has to be destroyed before the return statement
-          // to ensure that all data has been written in the buffer
-        }
-        size = dest_buffer.size() - previous_size;
+        // the size of the serialized object is not known in advance, so
+        // serialize into a temporary buffer first
+        std::vector<char> buffer;
+        pack(object, buffer, allow_compression);
+        AssertThrow(buffer.size() <= dest_buffer.size(),
+                    ExcMessage("The buffer is too small to hold the packed "
+                               "object."));
+        std::memcpy(dest_buffer.data(), buffer.data(), buffer.size());
+        return buffer.size();
       }
-
-    return size;
   }
 
 
@@ -1281,38 +1602,11 @@ namespace Utilities
          const std::vector<char>::const_iterator &cend,
          const bool                               allow_compression)
   {
-    T object;
-
-    // see if the object is small and copyable via memcpy. if so, use
-    // this fast path. otherwise, we have to go through the BOOST
-    // serialization machinery
-#ifdef DEAL_II_HAVE_CXX17
-    if constexpr (std::is_trivially_copyable<T>() && sizeof(T) < 256)
-#else
-    if (std::is_trivially_copyable<T>() && sizeof(T) < 256)
-#endif
-      {
-        (void)allow_compression;
-        Assert(std::distance(cbegin, cend) == sizeof(T), ExcInternalError());
-        std::memcpy(&object, &*cbegin, sizeof(T));
-      }
-    else
-      {
-        // decompress the buffer section into the object
-        boost::iostreams::filtering_istreambuf fisb;
-#ifdef DEAL_II_WITH_ZLIB
-        if (allow_compression)
-          fisb.push(boost::iostreams::gzip_decompressor());
-#else
-        (void)allow_compression;
-#endif
-        fisb.push(boost::iostreams::array_source(&*cbegin, &*cend));
-
-        boost::archive::binary_iarchive bia(fisb);
-        bia >> object;
-      }
-
-    return object;
+    // do not dereference the iterators of an empty range
+    const char *begin = (cbegin != cend) ? &*cbegin : nullptr;
+    return internal::PackingHelpers::unpack<T>(begin,
+                                               begin + (cend - cbegin),
+                                               allow_compression);
   }
 
 
@@ -1324,6 +1618,20 @@ namespace Utilities
   }
 
 
+  template <typename T, typename MemorySpaceType>
+  T
+  unpack(const ArrayView<const char, MemorySpaceType> &buffer,
+         const bool                                    allow_compression)
+  {
+    static_assert(std::is_same<MemorySpaceType, MemorySpace::Host>::value,
+                  "Objects can only be unpacked from host memory.");
+
+    return internal::PackingHelpers::unpack<T>(buffer.data(),
+                                               buffer.data() + buffer.size(),
+                                               allow_compression);
+  }
+
+
   template <typename T, int N>
   void
   unpack(const std::vector<char>::const_iterator &cbegin,
@@ -1331,10 +1639,10 @@ namespace Utilities
          T (&unpacked_object)[N],
          const bool allow_compression)
   {
-    // see if the object is small and copyable via memcpy. if so, use
-    // this fast path. otherwise, we have to go through the BOOST
-    // serialization machinery
-    if (std::is_trivially_copyable<T>() && sizeof(T) * N < 256)
+    // see if the object is copyable via memcpy. if so, use this fast
+    // path. otherwise, we have to go through the BOOST serialization
+    // machinery
+    if (internal::PackingHelpers::use_memcpy<T[N]>(allow_compression))
       {
         Assert(std::distance(cbegin, cend) == sizeof(T) * N,
                ExcInternalError());
@@ -69,6 +69,8 @@
 #    undef vector
 #    undef pixel
 #    undef bool
+#  elif defined(__ARM_NEON)
+#    include <arm_neon.h>
 #  else
 #    include <x86intrin.h>
 #  endif
@@ -370,6 +372,11 @@ public:
  *  - VectorizedArray<double, 1>
  *  - VectorizedArray<double, 2>
  *
+ * and for 64-bit ARM processors with NEON support (e.g. Fujitsu A64FX or
+ * AWS Graviton):
+ *  - VectorizedArray<double, 1> // no vectorization (auto-optimization)
+ *  - VectorizedArray<double, 2> // NEON (default)
+ *
  * for older x86 processors or in case no processor-specific compilation flags
  * were added (i.e., without `-D CMAKE_CXX_FLAGS=-march=native` or similar
  * flags):
@@ -4602,162 +4609,957 @@ private:
 #  endif // if DEAL_II_VECTORIZATION_LEVEL >=1 && defined(__ALTIVEC__) &&
          // defined(__VSX__)
 
+#  if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 && defined(__ARM_NEON) && \
+    defined(__aarch64__)
 
-#endif // DOXYGEN
+template <>
+class VectorizedArray<double, 2>
+  : public VectorizedArrayBase<VectorizedArray<double, 2>, 2>
+{
+public:
+  /**
+   * This gives the type of the array elements.
+   */
+  using value_type = double;
 
-/**
- * @name Arithmetic operations with VectorizedArray
- */
-//@{
+  /**
+   * This gives the number of vectors collected in this class.
+   *
+   * @deprecated Use VectorizedArrayBase::size() instead.
+   */
+  DEAL_II_DEPRECATED static const unsigned int n_array_elements = 2;
 
-/**
- * Relational operator == for VectorizedArray
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE bool
-operator==(const VectorizedArray<Number, width> &lhs,
-           const VectorizedArray<Number, width> &rhs)
-{
-  for (unsigned int i = 0; i < VectorizedArray<Number, width>::size(); ++i)
-    if (lhs[i] != rhs[i])
-      return false;
+  /**
+   * Default empty constructor, leaving the data in an uninitialized state
+   * similar to float/double.
+   */
+  VectorizedArray() = default;
 
-  return true;
-}
+  /**
+   * Construct an array with the given scalar broadcast to all lanes.
+   */
+  VectorizedArray(const double scalar)
+  {
+    this->operator=(scalar);
+  }
 
+  /**
+   * This function assigns a scalar to this class.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator=(const double x)
+  {
+    data = vdupq_n_f64(x);
+    return *this;
+  }
 
-/**
- * Addition of two vectorized arrays with operator +.
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator+(const VectorizedArray<Number, width> &u,
-          const VectorizedArray<Number, width> &v)
-{
-  VectorizedArray<Number, width> tmp = u;
-  return tmp += v;
-}
+  /**
+   * Access operator. The component must be between 0 and 1.
+   */
+  DEAL_II_ALWAYS_INLINE
+  double &operator[](const unsigned int comp)
+  {
+    AssertIndexRange(comp, 2);
+    return *(reinterpret_cast<double *>(&data) + comp);
+  }
 
-/**
- * Subtraction of two vectorized arrays with operator -.
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator-(const VectorizedArray<Number, width> &u,
-          const VectorizedArray<Number, width> &v)
-{
-  VectorizedArray<Number, width> tmp = u;
-  return tmp -= v;
-}
+  /**
+   * Constant access operator.
+   */
+  DEAL_II_ALWAYS_INLINE
+  const double &operator[](const unsigned int comp) const
+  {
+    AssertIndexRange(comp, 2);
+    return *(reinterpret_cast<const double *>(&data) + comp);
+  }
 
-/**
- * Multiplication of two vectorized arrays with operator *.
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator*(const VectorizedArray<Number, width> &u,
-          const VectorizedArray<Number, width> &v)
-{
-  VectorizedArray<Number, width> tmp = u;
-  return tmp *= v;
-}
+  /**
+   * Addition.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator+=(const VectorizedArray &vec)
+  {
+    data = vaddq_f64(data, vec.data);
+    return *this;
+  }
 
-/**
- * Division of two vectorized arrays with operator /.
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator/(const VectorizedArray<Number, width> &u,
-          const VectorizedArray<Number, width> &v)
-{
-  VectorizedArray<Number, width> tmp = u;
-  return tmp /= v;
-}
+  /**
+   * Subtraction.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator-=(const VectorizedArray &vec)
+  {
+    data = vsubq_f64(data, vec.data);
+    return *this;
+  }
 
-/**
- * Addition of a scalar (expanded to a vectorized array with @p
- * size() equal entries) and a vectorized array.
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator+(const Number &u, const VectorizedArray<Number, width> &v)
-{
-  VectorizedArray<Number, width> tmp = u;
-  return tmp += v;
-}
+  /**
+   * Multiplication.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator*=(const VectorizedArray &vec)
+  {
+    data = vmulq_f64(data, vec.data);
+    return *this;
+  }
 
-/**
- * Addition of a scalar (expanded to a vectorized array with @p
- * size() equal entries) and a vectorized array in case the scalar
- * is a double (needed in order to be able to write simple code with constants
- * that are usually double numbers).
- *
- * @relatesalso VectorizedArray
- */
-template <std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<float, width>
-                             operator+(const double u, const VectorizedArray<float, width> &v)
-{
-  VectorizedArray<float, width> tmp = u;
-  return tmp += v;
-}
+  /**
+   * Division.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator/=(const VectorizedArray &vec)
+  {
+    data = vdivq_f64(data, vec.data);
+    return *this;
+  }
 
-/**
- * Addition of a vectorized array and a scalar (expanded to a vectorized array
- * with @p size() equal entries).
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator+(const VectorizedArray<Number, width> &v, const Number &u)
-{
-  return u + v;
-}
+  /**
+   * Load @p size() from memory into the calling class, starting at
+   * the given address. The memory need not be aligned by 16 bytes.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    data = vld1q_f64(ptr);
+  }
 
-/**
- * Addition of a vectorized array and a scalar (expanded to a vectorized array
- * with @p size() equal entries) in case the scalar is a double
- * (needed in order to be able to write simple code with constants that are
- * usually double numbers).
- *
- * @relatesalso VectorizedArray
- */
-template <std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<float, width>
-                             operator+(const VectorizedArray<float, width> &v, const double u)
-{
-  return u + v;
-}
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * size() to the given address. The memory need not be aligned by 16
+   * bytes.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    vst1q_f64(ptr, data);
+  }
 
-/**
- * Subtraction of a vectorized array from a scalar (expanded to a vectorized
- * array with @p size() equal entries).
- *
- * @relatesalso VectorizedArray
- */
-template <typename Number, std::size_t width>
-inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
-                             operator-(const Number &u, const VectorizedArray<Number, width> &v)
-{
-  VectorizedArray<Number, width> tmp = u;
-  return tmp -= v;
-}
+  /** @copydoc VectorizedArray<Number>::streaming_store()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  streaming_store(double *ptr) const
+  {
+    store(ptr);
+  }
 
-/**
- * Subtraction of a vectorized array from a scalar (expanded to a vectorized
+  /** @copydoc VectorizedArray<Number>::gather()
+   *
+   * NEON has no gather instruction, so the entries are loaded one by one.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  gather(const double *base_ptr, const unsigned int *offsets)
+  {
+    for (unsigned int i = 0; i < 2; ++i)
+      *(reinterpret_cast<double *>(&data) + i) = base_ptr[offsets[i]];
+  }
+
+  /** @copydoc VectorizedArray<Number>::scatter
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  scatter(const unsigned int *offsets, double *base_ptr) const
+  {
+    for (unsigned int i = 0; i < 2; ++i)
+      base_ptr[offsets[i]] = *(reinterpret_cast<const double *>(&data) + i);
+  }
+
+  /**
+   * Actual data field. To be consistent with the standard layout type and to
+   * enable interaction with external SIMD functionality, this member is
+   * declared public.
+   */
+  float64x2_t data;
+
+private:
+  /**
+   * Return the square root of this field. Not for use in user code. Use
+   * sqrt(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_sqrt() const
+  {
+    VectorizedArray res;
+    res.data = vsqrtq_f64(data);
+    return res;
+  }
+
+  /**
+   * Return the absolute value of this field. Not for use in user code. Use
+   * abs(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_abs() const
+  {
+    VectorizedArray res;
+    res.data = vabsq_f64(data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise maximum of this field and another one. Not for
+   * use in user code. Use max(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_max(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vmaxq_f64(data, other.data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise minimum of this field and another one. Not for
+   * use in user code. Use min(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_min(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vminq_f64(data, other.data);
+    return res;
+  }
+
+  // Make a few functions friends.
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::sqrt(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::abs(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::max(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::min(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+};
+
+
+
+/**
+ * Specialization for double and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int          n_entries,
+                              const double *              in,
+                              const unsigned int *        offsets,
+                              VectorizedArray<double, 2> *out)
+{
+  const unsigned int n_chunks = n_entries / 2;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      const float64x2_t u0 = vld1q_f64(in + 2 * i + offsets[0]);
+      const float64x2_t u1 = vld1q_f64(in + 2 * i + offsets[1]);
+      out[2 * i + 0].data  = vzip1q_f64(u0, u1);
+      out[2 * i + 1].data  = vzip2q_f64(u0, u1);
+    }
+
+  // remainder loop of work that does not divide by 2
+  for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 2; ++v)
+      out[i][v] = in[offsets[v] + i];
+}
+
+
+
+/**
+ * Specialization for double and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int             n_entries,
+                              const std::array<double *, 2> &in,
+                              VectorizedArray<double, 2> *   out)
+{
+  // see the comments in the vectorized_load_and_transpose above
+
+  const unsigned int n_chunks = n_entries / 2;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      const float64x2_t u0 = vld1q_f64(in[0] + 2 * i);
+      const float64x2_t u1 = vld1q_f64(in[1] + 2 * i);
+      out[2 * i + 0].data  = vzip1q_f64(u0, u1);
+      out[2 * i + 1].data  = vzip2q_f64(u0, u1);
+    }
+
+  for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 2; ++v)
+      out[i][v] = in[v][i];
+}
+
+
+
+/**
+ * Specialization for double and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                        add_into,
+                               const unsigned int                n_entries,
+                               const VectorizedArray<double, 2> *in,
+                               const unsigned int *              offsets,
+                               double *                          out)
+{
+  const unsigned int n_chunks = n_entries / 2;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float64x2_t res0 = vzip1q_f64(in[2 * i + 0].data, in[2 * i + 1].data);
+      float64x2_t res1 = vzip2q_f64(in[2 * i + 0].data, in[2 * i + 1].data);
+      if (add_into)
+        {
+          res0 = vaddq_f64(vld1q_f64(out + 2 * i + offsets[0]), res0);
+          res1 = vaddq_f64(vld1q_f64(out + 2 * i + offsets[1]), res1);
+        }
+      vst1q_f64(out + 2 * i + offsets[0], res0);
+      vst1q_f64(out + 2 * i + offsets[1], res1);
+    }
+
+  // remainder loop of work that does not divide by 2
+  if (add_into)
+    for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 2; ++v)
+        out[offsets[v] + i] += in[i][v];
+  else
+    for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 2; ++v)
+        out[offsets[v] + i] = in[i][v];
+}
+
+
+
+/**
+ * Specialization for double and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                        add_into,
+                               const unsigned int                n_entries,
+                               const VectorizedArray<double, 2> *in,
+                               std::array<double *, 2> &         out)
+{
+  // see the comments in the vectorized_transpose_and_store above
+
+  const unsigned int n_chunks = n_entries / 2;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float64x2_t res0 = vzip1q_f64(in[2 * i + 0].data, in[2 * i + 1].data);
+      float64x2_t res1 = vzip2q_f64(in[2 * i + 0].data, in[2 * i + 1].data);
+      if (add_into)
+        {
+          res0 = vaddq_f64(vld1q_f64(out[0] + 2 * i), res0);
+          res1 = vaddq_f64(vld1q_f64(out[1] + 2 * i), res1);
+        }
+      vst1q_f64(out[0] + 2 * i, res0);
+      vst1q_f64(out[1] + 2 * i, res1);
+    }
+
+  if (add_into)
+    for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 2; ++v)
+        out[v][i] += in[i][v];
+  else
+    for (unsigned int i = 2 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 2; ++v)
+        out[v][i] = in[i][v];
+}
+
+
+
+template <>
+class VectorizedArray<float, 4>
+  : public VectorizedArrayBase<VectorizedArray<float, 4>, 4>
+{
+public:
+  /**
+   * This gives the type of the array elements.
+   */
+  using value_type = float;
+
+  /**
+   * This gives the number of vectors collected in this class.
+   *
+   * @deprecated Use VectorizedArrayBase::size() instead.
+   */
+  DEAL_II_DEPRECATED static const unsigned int n_array_elements = 4;
+
+  /**
+   * Default empty constructor, leaving the data in an uninitialized state
+   * similar to float/double.
+   */
+  VectorizedArray() = default;
+
+  /**
+   * Construct an array with the given scalar broadcast to all lanes.
+   */
+  VectorizedArray(const float scalar)
+  {
+    this->operator=(scalar);
+  }
+
+  /**
+   * This function assigns a scalar to this class.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator=(const float x)
+  {
+    data = vdupq_n_f32(x);
+    return *this;
+  }
+
+  /**
+   * Access operator. The component must be between 0 and 3.
+   */
+  DEAL_II_ALWAYS_INLINE
+  float &operator[](const unsigned int comp)
+  {
+    AssertIndexRange(comp, 4);
+    return *(reinterpret_cast<float *>(&data) + comp);
+  }
+
+  /**
+   * Constant access operator.
+   */
+  DEAL_II_ALWAYS_INLINE
+  const float &operator[](const unsigned int comp) const
+  {
+    AssertIndexRange(comp, 4);
+    return *(reinterpret_cast<const float *>(&data) + comp);
+  }
+
+  /**
+   * Addition.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator+=(const VectorizedArray &vec)
+  {
+    data = vaddq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Subtraction.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator-=(const VectorizedArray &vec)
+  {
+    data = vsubq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Multiplication.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator*=(const VectorizedArray &vec)
+  {
+    data = vmulq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Division.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator/=(const VectorizedArray &vec)
+  {
+    data = vdivq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Load @p size() from memory into the calling class, starting at
+   * the given address. The memory need not be aligned by 16 bytes.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const float *ptr)
+  {
+    data = vld1q_f32(ptr);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * size() to the given address. The memory need not be aligned by 16
+   * bytes.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(float *ptr) const
+  {
+    vst1q_f32(ptr, data);
+  }
+
+  /** @copydoc VectorizedArray<Number>::streaming_store()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  streaming_store(float *ptr) const
+  {
+    store(ptr);
+  }
+
+  /** @copydoc VectorizedArray<Number>::gather()
+   *
+   * NEON has no gather instruction, so the entries are loaded one by one.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  gather(const float *base_ptr, const unsigned int *offsets)
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      *(reinterpret_cast<float *>(&data) + i) = base_ptr[offsets[i]];
+  }
+
+  /** @copydoc VectorizedArray<Number>::scatter
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  scatter(const unsigned int *offsets, float *base_ptr) const
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      base_ptr[offsets[i]] = *(reinterpret_cast<const float *>(&data) + i);
+  }
+
+  /**
+   * Actual data field. To be consistent with the standard layout type and to
+   * enable interaction with external SIMD functionality, this member is
+   * declared public.
+   */
+  float32x4_t data;
+
+private:
+  /**
+   * Return the square root of this field. Not for use in user code. Use
+   * sqrt(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_sqrt() const
+  {
+    VectorizedArray res;
+    res.data = vsqrtq_f32(data);
+    return res;
+  }
+
+  /**
+   * Return the absolute value of this field. Not for use in user code. Use
+   * abs(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_abs() const
+  {
+    VectorizedArray res;
+    res.data = vabsq_f32(data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise maximum of this field and another one. Not for
+   * use in user code. Use max(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_max(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vmaxq_f32(data, other.data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise minimum of this field and another one. Not for
+   * use in user code. Use min(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_min(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vminq_f32(data, other.data);
+    return res;
+  }
+
+  // Make a few functions friends.
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::sqrt(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::abs(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::max(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+  template <typename Number2, std::size_t width2>
+  friend VectorizedArray<Number2, width2>
+  std::min(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+};
+
+
+
+namespace internal
+{
+  /**
+   * Transpose the 4x4 matrix of floats whose rows are given by @p u0, @p u1,
+   * @p u2, and @p u3 in place, using NEON instructions.
+   */
+  DEAL_II_ALWAYS_INLINE inline void
+  transpose_4x4_neon(float32x4_t &u0,
+                     float32x4_t &u1,
+                     float32x4_t &u2,
+                     float32x4_t &u3)
+  {
+    const float32x4_t v0 = vtrn1q_f32(u0, u1);
+    const float32x4_t v1 = vtrn2q_f32(u0, u1);
+    const float32x4_t v2 = vtrn1q_f32(u2, u3);
+    const float32x4_t v3 = vtrn2q_f32(u2, u3);
+    u0                   = vreinterpretq_f32_f64(
+      vtrn1q_f64(vreinterpretq_f64_f32(v0), vreinterpretq_f64_f32(v2)));
+    u1 = vreinterpretq_f32_f64(
+      vtrn1q_f64(vreinterpretq_f64_f32(v1), vreinterpretq_f64_f32(v3)));
+    u2 = vreinterpretq_f32_f64(
+      vtrn2q_f64(vreinterpretq_f64_f32(v0), vreinterpretq_f64_f32(v2)));
+    u3 = vreinterpretq_f32_f64(
+      vtrn2q_f64(vreinterpretq_f64_f32(v1), vreinterpretq_f64_f32(v3)));
+  }
+} // namespace internal
+
+
+
+/**
+ * Specialization for float and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int         n_entries,
+                              const float *              in,
+                              const unsigned int *       offsets,
+                              VectorizedArray<float, 4> *out)
+{
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = vld1q_f32(in + 4 * i + offsets[0]);
+      float32x4_t u1 = vld1q_f32(in + 4 * i + offsets[1]);
+      float32x4_t u2 = vld1q_f32(in + 4 * i + offsets[2]);
+      float32x4_t u3 = vld1q_f32(in + 4 * i + offsets[3]);
+      internal::transpose_4x4_neon(u0, u1, u2, u3);
+      out[4 * i + 0].data = u0;
+      out[4 * i + 1].data = u1;
+      out[4 * i + 2].data = u2;
+      out[4 * i + 3].data = u3;
+    }
+
+  // remainder loop of work that does not divide by 4
+  for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 4; ++v)
+      out[i][v] = in[offsets[v] + i];
+}
+
+
+
+/**
+ * Specialization for float and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_load_and_transpose(const unsigned int            n_entries,
+                              const std::array<float *, 4> &in,
+                              VectorizedArray<float, 4> *   out)
+{
+  // see the comments in the vectorized_load_and_transpose above
+
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = vld1q_f32(in[0] + 4 * i);
+      float32x4_t u1 = vld1q_f32(in[1] + 4 * i);
+      float32x4_t u2 = vld1q_f32(in[2] + 4 * i);
+      float32x4_t u3 = vld1q_f32(in[3] + 4 * i);
+      internal::transpose_4x4_neon(u0, u1, u2, u3);
+      out[4 * i + 0].data = u0;
+      out[4 * i + 1].data = u1;
+      out[4 * i + 2].data = u2;
+      out[4 * i + 3].data = u3;
+    }
+
+  for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+    for (unsigned int v = 0; v < 4; ++v)
+      out[i][v] = in[v][i];
+}
+
+
+
+/**
+ * Specialization for float and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                       add_into,
+                               const unsigned int               n_entries,
+                               const VectorizedArray<float, 4> *in,
+                               const unsigned int *             offsets,
+                               float *                          out)
+{
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = in[4 * i + 0].data;
+      float32x4_t u1 = in[4 * i + 1].data;
+      float32x4_t u2 = in[4 * i + 2].data;
+      float32x4_t u3 = in[4 * i + 3].data;
+      internal::transpose_4x4_neon(u0, u1, u2, u3);
+      if (add_into)
+        {
+          u0 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[0]), u0);
+          u1 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[1]), u1);
+          u2 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[2]), u2);
+          u3 = vaddq_f32(vld1q_f32(out + 4 * i + offsets[3]), u3);
+        }
+      vst1q_f32(out + 4 * i + offsets[0], u0);
+      vst1q_f32(out + 4 * i + offsets[1], u1);
+      vst1q_f32(out + 4 * i + offsets[2], u2);
+      vst1q_f32(out + 4 * i + offsets[3], u3);
+    }
+
+  // remainder loop of work that does not divide by 4
+  if (add_into)
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[offsets[v] + i] += in[i][v];
+  else
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[offsets[v] + i] = in[i][v];
+}
+
+
+
+/**
+ * Specialization for float and NEON.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+vectorized_transpose_and_store(const bool                       add_into,
+                               const unsigned int               n_entries,
+                               const VectorizedArray<float, 4> *in,
+                               std::array<float *, 4> &         out)
+{
+  // see the comments in the vectorized_transpose_and_store above
+
+  const unsigned int n_chunks = n_entries / 4;
+  for (unsigned int i = 0; i < n_chunks; ++i)
+    {
+      float32x4_t u0 = in[4 * i + 0].data;
+      float32x4_t u1 = in[4 * i + 1].data;
+      float32x4_t u2 = in[4 * i + 2].data;
+      float32x4_t u3 = in[4 * i + 3].data;
+      internal::transpose_4x4_neon(u0, u1, u2, u3);
+      if (add_into)
+        {
+          u0 = vaddq_f32(vld1q_f32(out[0] + 4 * i), u0);
+          u1 = vaddq_f32(vld1q_f32(out[1] + 4 * i), u1);
+          u2 = vaddq_f32(vld1q_f32(out[2] + 4 * i), u2);
+          u3 = vaddq_f32(vld1q_f32(out[3] + 4 * i), u3);
+        }
+      vst1q_f32(out[0] + 4 * i, u0);
+      vst1q_f32(out[1] + 4 * i, u1);
+      vst1q_f32(out[2] + 4 * i, u2);
+      vst1q_f32(out[3] + 4 * i, u3);
+    }
+
+  if (add_into)
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[v][i] += in[i][v];
+  else
+    for (unsigned int i = 4 * n_chunks; i < n_entries; ++i)
+      for (unsigned int v = 0; v < 4; ++v)
+        out[v][i] = in[i][v];
+}
+
+#  endif // if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 && defined(__ARM_NEON)
+         // && defined(__aarch64__)
+
+
+#endif // DOXYGEN
+
+/**
+ * @name Arithmetic operations with VectorizedArray
+ */
+//@{
+
+/**
+ * Relational operator == for VectorizedArray
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE bool
+operator==(const VectorizedArray<Number, width> &lhs,
+           const VectorizedArray<Number, width> &rhs)
+{
+  for (unsigned int i = 0; i < VectorizedArray<Number, width>::size(); ++i)
+    if (lhs[i] != rhs[i])
+      return false;
+
+  return true;
+}
+
+
+/**
+ * Addition of two vectorized arrays with operator +.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator+(const VectorizedArray<Number, width> &u,
+          const VectorizedArray<Number, width> &v)
+{
+  VectorizedArray<Number, width> tmp = u;
+  return tmp += v;
+}
+
+/**
+ * Subtraction of two vectorized arrays with operator -.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator-(const VectorizedArray<Number, width> &u,
+          const VectorizedArray<Number, width> &v)
+{
+  VectorizedArray<Number, width> tmp = u;
+  return tmp -= v;
+}
+
+/**
+ * Multiplication of two vectorized arrays with operator *.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator*(const VectorizedArray<Number, width> &u,
+          const VectorizedArray<Number, width> &v)
+{
+  VectorizedArray<Number, width> tmp = u;
+  return tmp *= v;
+}
+
+/**
+ * Division of two vectorized arrays with operator /.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator/(const VectorizedArray<Number, width> &u,
+          const VectorizedArray<Number, width> &v)
+{
+  VectorizedArray<Number, width> tmp = u;
+  return tmp /= v;
+}
+
+/**
+ * Addition of a scalar (expanded to a vectorized array with @p
+ * size() equal entries) and a vectorized array.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator+(const Number &u, const VectorizedArray<Number, width> &v)
+{
+  VectorizedArray<Number, width> tmp = u;
+  return tmp += v;
+}
+
+/**
+ * Addition of a scalar (expanded to a vectorized array with @p
+ * size() equal entries) and a vectorized array in case the scalar
+ * is a double (needed in order to be able to write simple code with constants
+ * that are usually double numbers).
+ *
+ * @relatesalso VectorizedArray
+ */
+template <std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<float, width>
+                             operator+(const double u, const VectorizedArray<float, width> &v)
+{
+  VectorizedArray<float, width> tmp = u;
+  return tmp += v;
+}
+
+/**
+ * Addition of a vectorized array and a scalar (expanded to a vectorized array
+ * with @p size() equal entries).
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator+(const VectorizedArray<Number, width> &v, const Number &u)
+{
+  return u + v;
+}
+
+/**
+ * Addition of a vectorized array and a scalar (expanded to a vectorized array
+ * with @p size() equal entries) in case the scalar is a double
+ * (needed in order to be able to write simple code with constants that are
+ * usually double numbers).
+ *
+ * @relatesalso VectorizedArray
+ */
+template <std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<float, width>
+                             operator+(const VectorizedArray<float, width> &v, const double u)
+{
+  return u + v;
+}
+
+/**
+ * Subtraction of a vectorized array from a scalar (expanded to a vectorized
+ * array with @p size() equal entries).
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, std::size_t width>
+inline DEAL_II_ALWAYS_INLINE VectorizedArray<Number, width>
+                             operator-(const Number &u, const VectorizedArray<Number, width> &v)
+{
+  VectorizedArray<Number, width> tmp = u;
+  return tmp -= v;
+}
+
+/**
+ * Subtraction of a vectorized array from a scalar (expanded to a vectorized
  * array with @p size() equal entries) in case the scalar is a
  * double (needed in order to be able to write simple code with constants that
  * are usually double numbers).
@@ -5265,6 +6067,93 @@ compare_and_apply_mask(const VectorizedArray<double, 2> &left,
   return result;
 }
 
+#  endif
+
+#  if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 && defined(__ARM_NEON) && \
+    defined(__aarch64__)
+
+template <SIMDComparison predicate>
+DEAL_II_ALWAYS_INLINE inline VectorizedArray<float, 4>
+compare_and_apply_mask(const VectorizedArray<float, 4> &left,
+                       const VectorizedArray<float, 4> &right,
+                       const VectorizedArray<float, 4> &true_values,
+                       const VectorizedArray<float, 4> &false_values)
+{
+  // NEON has no "not equal" comparison, so compute "equal" and swap the
+  // values to be selected
+  uint32x4_t  mask;
+  float32x4_t if_true  = true_values.data;
+  float32x4_t if_false = false_values.data;
+  switch (predicate)
+    {
+      case SIMDComparison::equal:
+        mask = vceqq_f32(left.data, right.data);
+        break;
+      case SIMDComparison::not_equal:
+        mask = vceqq_f32(left.data, right.data);
+        std::swap(if_true, if_false);
+        break;
+      case SIMDComparison::less_than:
+        mask = vcltq_f32(left.data, right.data);
+        break;
+      case SIMDComparison::less_than_or_equal:
+        mask = vcleq_f32(left.data, right.data);
+        break;
+      case SIMDComparison::greater_than:
+        mask = vcgtq_f32(left.data, right.data);
+        break;
+      case SIMDComparison::greater_than_or_equal:
+        mask = vcgeq_f32(left.data, right.data);
+        break;
+    }
+
+  VectorizedArray<float, 4> result;
+  result.data = vbslq_f32(mask, if_true, if_false);
+
+  return result;
+}
+
+
+template <SIMDComparison predicate>
+DEAL_II_ALWAYS_INLINE inline VectorizedArray<double, 2>
+compare_and_apply_mask(const VectorizedArray<double, 2> &left,
+                       const VectorizedArray<double, 2> &right,
+                       const VectorizedArray<double, 2> &true_values,
+                       const VectorizedArray<double, 2> &false_values)
+{
+  // see the comments in the float variant above
+  uint64x2_t  mask;
+  float64x2_t if_true  = true_values.data;
+  float64x2_t if_false = false_values.data;
+  switch (predicate)
+    {
+      case SIMDComparison::equal:
+        mask = vceqq_f64(left.data, right.data);
+        break;
+      case SIMDComparison::not_equal:
+        mask = vceqq_f64(left.data, right.data);
+        std::swap(if_true, if_false);
+        break;
+      case SIMDComparison::less_than:
+        mask = vcltq_f64(left.data, right.data);
+        break;
+      case SIMDComparison::less_than_or_equal:
+        mask = vcleq_f64(left.data, right.data);
+        break;
+      case SIMDComparison::greater_than:
+        mask = vcgtq_f64(left.data, right.data);
+        break;
+      case SIMDComparison::greater_than_or_equal:
+        mask = vcgeq_f64(left.data, right.data);
+        break;
+    }
+
+  VectorizedArray<double, 2> result;
+  result.data = vbslq_f64(mask, if_true, if_false);
+
+  return result;
+}
+
 #  endif
 #endif // DOXYGEN
 
@@ -26,6 +26,7 @@
 #  include <deal.II/base/template_constraints.h>
 #  include <deal.II/base/thread_local_storage.h>
 #  include <deal.II/base/thread_management.h>
+#  include <deal.II/base/tracing.h>
 
 #  ifdef DEAL_II_WITH_TBB
 #    include <tbb/pipeline.h>
@@ -545,6 +546,7 @@ namespace WorkStream
           // given. since these worker functions are called on separate threads,
           // nothing good can happen if they throw an exception and we are best
           // off catching it and showing an error message
+          Tracing::Scope trace_scope("WorkStream worker", "WorkStream");
           for (unsigned int i = 0; i < current_item->n_items; ++i)
             {
               try
@@ -648,6 +650,7 @@ namespace WorkStream
           // initiate copying data. for the same reasons as in the worker class
           // above, catch exceptions rather than letting it propagate into
           // unknown territories
+          Tracing::Scope trace_scope("WorkStream copier", "WorkStream");
           for (unsigned int i = 0; i < current_item->n_items; ++i)
             {
               try
@@ -947,6 +950,8 @@ namespace WorkStream
 
           // then call the worker and copier functions on each
           // element of the chunk we were given.
+          Tracing::Scope trace_scope("WorkStream worker and copier",
+                                     "WorkStream");
           for (typename std::vector<Iterator>::const_iterator p = range.begin();
                p != range.end();
                ++p)
@@ -1328,6 +1333,86 @@ namespace WorkStream
 
 
 
+  /**
+   * A variant of the colored run() function above that computes the
+   * coloring itself. Rather than a range of iterators split into colors,
+   * it takes the range given by @p begin and @p end, together with a
+   * function @p get_conflict_indices that returns, for each element of the
+   * range, the indices of the global objects its copier writes into
+   * (typically the global DoF indices of a cell). Two elements that share
+   * an index are never processed concurrently. The range is colored in
+   * parallel with GraphColoring::make_parallel_graph_coloring() and then
+   * processed color by color, with worker and copier running one after the
+   * other on the same thread. In contrast to the run() function taking a
+   * range of iterators, there is hence no copier stage that is executed
+   * serially, which is the limiting factor for scaling to many threads
+   * there. Since the coloring calls @p get_conflict_indices from several
+   * threads at once, this function must be thread-safe.
+   *
+   * Computing the coloring has a cost comparable to a loop over all
+   * elements of the range. If the same range is processed several times,
+   * for example in every time step or nonlinear iteration, it is therefore
+   * more efficient to call GraphColoring::make_parallel_graph_coloring()
+   * once and pass its result to the function above.
+   *
+   * If only a single thread is used, no coloring is computed and the
+   * elements are processed in the order of the range.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run(const Iterator &                         begin,
+      const typename identity<Iterator>::type &end,
+      const std::function<std::vector<types::global_dof_index>(
+        const typename identity<Iterator>::type &)> &get_conflict_indices,
+      Worker                                         worker,
+      Copier                                         copier,
+      const ScratchData &                            sample_scratch_data,
+      const CopyData &                               sample_copy_data,
+      const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+      const unsigned int chunk_size   = 8)
+  {
+    Assert(queue_length > 0,
+           ExcMessage("The queue length must be at least one, and preferably "
+                      "larger than the number of processors on this system."));
+    (void)queue_length; // removes -Wunused-parameter warning in optimized mode
+    Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
+    (void)chunk_size; // removes -Wunused-parameter warning in optimized mode
+    (void)get_conflict_indices;
+
+    // If no work then skip. (only use operator!= for iterators since we may
+    // not have an equality comparison operator)
+    if (!(begin != end))
+      return;
+
+    if (MultithreadInfo::n_threads() > 1)
+      {
+#  ifdef DEAL_II_WITH_TBB
+        run(GraphColoring::make_parallel_graph_coloring(begin,
+                                                        end,
+                                                        get_conflict_indices),
+            worker,
+            copier,
+            sample_scratch_data,
+            sample_copy_data,
+            queue_length,
+            chunk_size);
+
+        // exit this function to not run the sequential version below:
+        return;
+#  endif
+      }
+
+    // no TBB installed or we are requested to run sequentially:
+    internal::sequential::run(
+      begin, end, worker, copier, sample_scratch_data, sample_copy_data);
+  }
+
+
+
   template <typename Worker,
             typename Copier,
             typename Iterator,
@@ -1003,6 +1003,39 @@ namespace Differentiation
         const VectorType &                                  values,
         const std::vector<dealii::types::global_dof_index> &local_dof_indices);
 
+      /**
+       * Evaluate the residual vector and its linearization for a whole batch
+       * of linearization points, typically the local degree of freedom values
+       * of several cells that share the same operation trace (e.g. cells with
+       * the same finite element and material). The active tape, which must
+       * have been recorded before, is replayed for each entry of @p dof_values,
+       * which avoids re-recording the operations for each cell. This is
+       * equivalent to calling set_dof_values(), compute_residual() and
+       * compute_linearization() for each entry of @p dof_values in turn.
+       *
+       * @param[in] dof_values The values of the independent variables for each
+       * linearization point in the batch.
+       * @param[out] residuals The residual vector for each linearization
+       * point. This vector is resized to the size of @p dof_values.
+       * @param[out] linearizations The linearization of the residual vector
+       * for each linearization point. This vector is resized to the size of
+       * @p dof_values.
+       *
+       * @return <code>true</code> if the tape could be reused for all entries
+       * of the batch. If ADOL-C reports for any of the evaluations that a
+       * branch switch occurred and the tape has to be re-recorded, then this
+       * function returns <code>false</code> and the affected results must
+       * be recomputed with a freshly recorded tape.
+       *
+       * @note This function is only available for taped AD numbers, for
+       * which the tape has been recorded and is not currently being recorded.
+       */
+      bool
+      compute_residuals_and_linearizations(
+        const std::vector<std::vector<scalar_type>> &dof_values,
+        std::vector<Vector<scalar_type>> &           residuals,
+        std::vector<FullMatrix<scalar_type>> &       linearizations);
+
       //@}
 
       /**
@@ -37,6 +37,7 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
 #  include <deal.II/base/exceptions.h>
 #  include <deal.II/base/logstream.h>
+#  include <deal.II/base/mpi.h>
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/differentiation/sd/symengine_number_types.h>
@@ -1785,6 +1786,33 @@ namespace Differentiation
       void
       optimize();
 
+      /**
+       * Same as optimize(), but reuse the result of a previous optimization
+       * that has been stored in the file @p cache_file, if possible.
+       *
+       * The file contains a key, computed from the optimization method and
+       * flags as well as from the registered independent symbols and
+       * dependent functions, followed by the serialized optimizer. If the
+       * file exists and its key matches the one of this object, the
+       * optimizer is loaded from it. Otherwise, the optimization is performed
+       * and the file is (over)written. This is particularly useful for the
+       * LLVM optimizer, for which the compiled code is stored, so that the
+       * potentially very expensive compilation step only needs to be
+       * performed once for a given set of expressions.
+       *
+       * All processes in @p mpi_communicator have to call this function
+       * with the same expressions. Only the process with rank zero reads
+       * or writes @p cache_file, and, if necessary, performs the
+       * optimization. The result is then sent to all other processes, which
+       * deserialize it instead of performing the optimization themselves.
+       *
+       * @note As for serialization, the "lambda" optimization method
+       * cannot be stored and is performed anew when the cache is loaded.
+       */
+      void
+      optimize(const std::string &cache_file,
+               const MPI_Comm &   mpi_communicator = MPI_COMM_SELF);
+
       /**
        * Returns a flag which indicates whether the optimize()
        * function has been called and the class is finalized.
@@ -34,6 +34,9 @@
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
 
+#  include <cstring>
+#  include <type_traits>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -344,6 +347,27 @@ namespace parallel
             }
         }
 
+      // For fixed size data of a trivially copyable type, write the values of
+      // all vectors into the buffer in one go instead of going through the
+      // serialization machinery.
+#  ifdef DEAL_II_HAVE_CXX17
+      if constexpr (std::is_trivially_copyable<value_type>::value)
+#  else
+      if (std::is_trivially_copyable<value_type>::value)
+#  endif
+        if (transfer_variable_size_data == false)
+          {
+            std::vector<char> buffer(cell_data.size() * sizeof(value_type));
+            for (unsigned int i = 0; i < cell_data.size(); ++i)
+              {
+                const value_type value = cell_data[i];
+                std::memcpy(&buffer[i * sizeof(value_type)],
+                            &value,
+                            sizeof(value_type));
+              }
+            return buffer;
+          }
+
       // We don't have to pack the whole container if there is just one entry.
       if (input_vectors.size() == 1)
         return Utilities::pack(
@@ -371,16 +395,43 @@ namespace parallel
 
       // We have to unpack the corresponding datatype that has been packed
       // beforehand.
-      if (all_out.size() == 1)
-        cell_data.push_back(Utilities::unpack<value_type>(
-          data_range.begin(),
-          data_range.end(),
-          /*allow_compression=*/transfer_variable_size_data));
-      else
-        cell_data = Utilities::unpack<std::vector<value_type>>(
-          data_range.begin(),
-          data_range.end(),
-          /*allow_compression=*/transfer_variable_size_data);
+      bool unpacked = false;
+#  ifdef DEAL_II_HAVE_CXX17
+      if constexpr (std::is_trivially_copyable<value_type>::value)
+#  else
+      if (std::is_trivially_copyable<value_type>::value)
+#  endif
+        if (transfer_variable_size_data == false)
+          {
+            Assert(static_cast<std::size_t>(data_range.size()) ==
+                     all_out.size() * sizeof(value_type),
+                   ExcInternalError());
+            cell_data.reserve(all_out.size());
+            for (unsigned int i = 0; i < all_out.size(); ++i)
+              {
+                value_type value;
+                std::memcpy(&value,
+                            &(*std::next(data_range.begin(),
+                                         i * sizeof(value_type))),
+                            sizeof(value_type));
+                cell_data.push_back(value);
+              }
+            unpacked = true;
+          }
+
+      if (!unpacked)
+        {
+          if (all_out.size() == 1)
+            cell_data.push_back(Utilities::unpack<value_type>(
+              data_range.begin(),
+              data_range.end(),
+              /*allow_compression=*/transfer_variable_size_data));
+          else
+            cell_data = Utilities::unpack<std::vector<value_type>>(
+              data_range.begin(),
+              data_range.end(),
+              /*allow_compression=*/transfer_variable_size_data);
+        }
 
       // Check if sizes match.
       Assert(cell_data.size() == all_out.size(), ExcInternalError());
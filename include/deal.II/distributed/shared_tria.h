@@ -117,7 +117,8 @@ namespace parallel
        *
        * The constructor requires that exactly one of
        * <code>partition_auto</code>, <code>partition_metis</code>,
-       * <code>partition_zorder</code>, <code>partition_zoltan</code> and
+       * <code>partition_zorder</code>, <code>partition_zoltan</code>,
+       * <code>partition_hilbert</code> and
        * <code>partition_custom_signal</code> is set. If
        * <code>partition_auto</code> is chosen, it will use
        * <code>partition_zoltan</code> (if available), then
@@ -226,6 +227,17 @@ namespace parallel
          * active cell partitioning method.
          */
         construct_multigrid_hierarchy = 0x8,
+
+        /**
+         * Partition active cells by sorting them along a Hilbert space
+         * filling curve through the cell centers and cutting the sequence
+         * into pieces of equal weight, see
+         * GridTools::partition_triangulation_hilbert(). In contrast to
+         * partition_zorder, the curve does not follow the coarse mesh, and
+         * in contrast to partition_metis and partition_zoltan, no cell
+         * connectivity graph needs to be built.
+         */
+        partition_hilbert = 0x10,
       };
 
 
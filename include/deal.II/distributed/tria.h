@@ -31,6 +31,7 @@
 #include <boost/range/iterator_range.hpp>
 
 #include <functional>
+#include <limits>
 #include <list>
 #include <set>
 #include <type_traits>
@@ -528,6 +529,47 @@ namespace parallel
       void
       repartition();
 
+      /**
+       * Repartition the active cells between processors, but only as much as
+       * is necessary to bring the load of every process within the given
+       * tolerance of the average load. Loads are computed from the
+       * cell_weight signal in the same way as for repartition().
+       *
+       * Whereas repartition() computes a new partition of the space filling
+       * curve from scratch, this function keeps each boundary between the
+       * ranges of cells owned by consecutive processes where it is, unless
+       * it lies further than half of @p imbalance_tolerance times the
+       * average load from its ideal position. In that case, the boundary is
+       * moved the shortest distance along the curve that brings it back
+       * into this window. Consequently, small changes of the weights only
+       * shift few cells between neighboring processes, and nothing at all
+       * happens if the current partition is already balanced well enough.
+       *
+       * Data attached to cells is transferred as in repartition(), and the
+       * same considerations apply.
+       *
+       * @param imbalance_tolerance The maximal admissible ratio of the load
+       * of any process over the average load, minus one. For example, 0.05
+       * allows every process to carry up to 5% more than the average load.
+       *
+       * @return The number of cells that changed their owner, summed over
+       * all processes.
+       */
+      types::global_cell_index
+      repartition_incrementally(const double imbalance_tolerance);
+
+      /**
+       * Return the number of cells that a call to
+       * repartition_incrementally() with the same @p imbalance_tolerance
+       * would move to another process, without changing the partition. An
+       * application can use this to decide whether a rebalance is worth
+       * its cost.
+       *
+       * This is a collective operation.
+       */
+      types::global_cell_index
+      n_cells_to_migrate(const double imbalance_tolerance) const;
+
 
       /**
        * Return true if the triangulation has hanging nodes.
@@ -589,6 +631,30 @@ namespace parallel
       virtual void
       save(const std::string &filename) const override;
 
+      /**
+       * Same as save(), but the cell-based data attached to the triangulation
+       * is written to disk using nonblocking MPI-IO. The packed data is kept
+       * in staging buffers, and the function returns as soon as all writes
+       * have been started, so that the simulation can continue while the
+       * data is transferred to the file system. The refinement information
+       * of the forest itself is still written synchronously.
+       *
+       * Processes whose packed data exceeds @p max_staging_memory bytes write
+       * it before returning, so that the memory overhead of the staging
+       * buffers can be bounded.
+       *
+       * Call DistributedTriangulationBase::test_save() to query whether the
+       * background writes have finished, and
+       * DistributedTriangulationBase::wait_for_save() before the files are
+       * used. The latter is a collective operation. A pending save is also
+       * completed when the next save is started, when load() is called, and
+       * when the triangulation is destroyed.
+       */
+      void
+      save_asynchronously(const std::string &filename,
+                          const std::size_t  max_staging_memory =
+                            std::numeric_limits<std::size_t>::max()) const;
+
       /**
        * Load the refinement information saved with save() back in. The mesh
        * must contain the same coarse mesh that was used in save() before
@@ -759,6 +825,35 @@ namespace parallel
       void
       setup_coarse_cell_to_p4est_tree_permutation();
 
+      /**
+       * Compute the first global index of the cells owned by each process,
+       * and the total number of cells as the last entry, for the partition
+       * described in repartition_incrementally(). An empty vector is
+       * returned if the current partition is already within the given
+       * tolerance.
+       */
+      std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+      compute_incremental_partition(const double imbalance_tolerance) const;
+
+      /**
+       * Update the triangulation and transfer attached data after p4est has
+       * repartitioned the forest. @p previous_global_first_quadrant stores
+       * the partition before repartitioning, and is only accessed if data
+       * is attached to the cells.
+       */
+      void
+      update_after_repartition(
+        const std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+          &previous_global_first_quadrant);
+
+      /**
+       * Shared implementation of save() and save_asynchronously().
+       */
+      void
+      do_save(const std::string &filename,
+              const bool         asynchronous,
+              const std::size_t  max_staging_memory) const;
+
       /**
        * Take the contents of a newly created triangulation we are attached to
        * and copy it to p4est data structures.
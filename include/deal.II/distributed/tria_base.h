@@ -29,6 +29,7 @@
 
 #include <functional>
 #include <list>
+#include <memory>
 #include <set>
 #include <utility>
 #include <vector>
@@ -489,6 +490,31 @@ namespace parallel
     virtual void
     load(const std::string &filename, const bool autopartition = true) = 0;
 
+    /**
+     * Return whether this process has finished writing the cell-attached
+     * data of the last save that was started asynchronously, see
+     * parallel::distributed::Triangulation::save_asynchronously(). If no
+     * such save is pending, this function returns true.
+     *
+     * This function does not block and does not communicate. Even if it
+     * returns true, the files written by the save are only guaranteed to be
+     * complete after a call to wait_for_save().
+     */
+    bool
+    test_save() const;
+
+    /**
+     * Block until the cell-attached data of the last save that was started
+     * asynchronously has been written, close the files, and release the
+     * staging buffers. If no such save is pending, this function does
+     * nothing.
+     *
+     * This is a collective operation if a save is pending, since the files
+     * are closed collectively.
+     */
+    void
+    wait_for_save() const;
+
     /**
      * Register a function that can be used to attach data of fixed size
      * to cells. This is useful for two purposes: (i) Upon refinement and
@@ -665,12 +691,19 @@ namespace parallel
      * Save additional cell-attached data into the given file. The first
      * arguments are used to determine the offsets where to write buffers to.
      *
+     * If @p asynchronous is set, the data is packed into staging buffers and
+     * written in the background, see DataTransfer::save(). Processes whose
+     * packed data is larger than @p max_staging_memory bytes write their data
+     * right away instead.
+     *
      * Called by @ref save.
      */
     void
     save_attached_data(const unsigned int global_first_cell,
                        const unsigned int global_num_cells,
-                       const std::string &filename) const;
+                       const std::string &filename,
+                       const bool         asynchronous       = false,
+                       const std::size_t  max_staging_memory = 0) const;
 
     /**
      * Load additional cell-attached data from the given file, if any was saved.
@@ -759,6 +792,12 @@ namespace parallel
     public:
       DataTransfer(const MPI_Comm &mpi_communicator);
 
+      /**
+       * Destructor. Completes a pending asynchronous save(), which requires
+       * all processes to destroy this object at the same time in that case.
+       */
+      ~DataTransfer();
+
       /**
        * Prepare data transfer by calling the pack callback functions on each
        * cell
@@ -822,11 +861,36 @@ namespace parallel
        * from the provided input parameters.
        *
        * Data has to be previously packed with pack_data().
+       *
+       * If @p asynchronous is set, the packed buffers are moved into staging
+       * buffers and written via nonblocking MPI-IO, and the function returns
+       * as soon as the files have been opened. If @p write_immediately is set
+       * in addition, this process nevertheless writes its data right away,
+       * but the files are still closed only by the next call of
+       * wait_for_save(), which has to be called by all processes. Any
+       * previous asynchronous save is completed before a new save starts.
        */
       void
       save(const unsigned int global_first_cell,
            const unsigned int global_num_cells,
-           const std::string &filename) const;
+           const std::string &filename,
+           const bool         asynchronous      = false,
+           const bool         write_immediately = false);
+
+      /**
+       * Return whether the data of a pending asynchronous save() has been
+       * written on this process. Returns true if no save is pending.
+       */
+      bool
+      test_save() const;
+
+      /**
+       * Complete a pending asynchronous save(): wait until the data of this
+       * process has been written, close the files, and release the staging
+       * buffers. This is a collective operation if a save is pending.
+       */
+      void
+      wait_for_save();
 
       /**
        * Transfer data from file system.
@@ -898,6 +962,25 @@ namespace parallel
 
     private:
       MPI_Comm mpi_communicator;
+
+      /**
+       * The staging buffers and open files of an asynchronous save() that
+       * has not been completed by wait_for_save() yet.
+       */
+      struct PendingSave
+      {
+        std::vector<unsigned int> sizes_fixed_cumulative;
+        std::vector<char>         data_fixed;
+        std::vector<int>          sizes_variable;
+        std::vector<char>         data_variable;
+
+#ifdef DEAL_II_WITH_MPI
+        std::vector<MPI_File>    files;
+        std::vector<MPI_Request> requests;
+#endif
+      };
+
+      std::unique_ptr<PendingSave> pending_save;
     };
 
     DataTransfer data_transfer;
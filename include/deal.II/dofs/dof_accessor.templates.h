@@ -31,6 +31,7 @@
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/read_write_vector.h>
 
+#include <algorithm>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -2650,6 +2651,19 @@ DoFCellAccessor<dimension_, space_dimension_, level_dof_access>::
   Assert(this->dof_handler->mg_vertex_dofs.size() > 0,
          ExcMessage("Multigrid DoF indices can only be accessed after "
                     "DoFHandler::distribute_mg_dofs() has been called!"));
+
+  // use the cache of the level DoF indices if it has been set up, see
+  // DoFHandler::distribute_mg_dofs()
+  const auto &mg_level = this->dof_handler->mg_levels[this->level()];
+  if (mg_level->cell_dof_indices_cache.empty() == false)
+    {
+      AssertDimension(dof_indices.size(), this->get_fe().n_dofs_per_cell());
+      const types::global_dof_index *cache =
+        mg_level->get_cell_cache_start(this->present_index, dof_indices.size());
+      std::copy(cache, cache + dof_indices.size(), dof_indices.begin());
+      return;
+    }
+
   DoFAccessor<dimension_, dimension_, space_dimension_, level_dof_access>::
     get_mg_dof_indices(this->level(), dof_indices);
 }
@@ -2666,6 +2680,14 @@ DoFCellAccessor<dimension_, space_dimension_, level_dof_access>::
                     "DoFHandler::distribute_mg_dofs() has been called!"));
   DoFAccessor<dimension_, dimension_, space_dimension_, level_dof_access>::
     set_mg_dof_indices(this->level(), dof_indices);
+
+  // keep the cache of the level DoF indices consistent
+  auto &cache = this->dof_handler->mg_levels[this->level()]
+                  ->cell_dof_indices_cache;
+  if (cache.empty() == false)
+    std::copy(dof_indices.begin(),
+              dof_indices.end(),
+              cache.begin() + this->present_index * dof_indices.size());
 }
 
 
@@ -994,6 +994,16 @@ public:
   IteratorRange<active_cell_iterator>
   active_cell_iterators() const;
 
+  /**
+   * Return an iterator to the active cell whose
+   * CellAccessor::active_cell_index() equals @p active_cell_index. This
+   * function has constant cost, see
+   * Triangulation::get_active_cell_iterator() for how it can be used to
+   * split loops over the active cells into chunks.
+   */
+  active_cell_iterator
+  get_active_cell_iterator(const unsigned int active_cell_index) const;
+
   /**
    * Return an iterator range that contains all cells (active or not) that
    * make up this DoFHandler in their level-cell form. Such a range is useful
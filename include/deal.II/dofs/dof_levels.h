@@ -38,11 +38,11 @@ namespace internal
      * Structure for storing degree of freedom information for cells,
      * organized by levels.
      *
-     * We store are cached values for the DoF indices on each cell
-     * in#cell_dof_indices_cache, since this is a frequently requested
-     * operation. The values are set by
-     * DoFCellAccessor::update_cell_dof_indices_cache and are used by
-     * DoFCellAccessor::get_dof_indices.
+     * We store cached values for the level DoF indices on each cell
+     * in #cell_dof_indices_cache, since this is a frequently requested
+     * operation. The values are set by DoFHandler::distribute_mg_dofs() and
+     * DoFHandler::renumber_dofs() for the level, and are used by
+     * DoFCellAccessor::get_mg_dof_indices().
      *
      * Note that vertices are separate from, and in fact have nothing to do
      * with cells. The indices of degrees of freedom located on vertices
@@ -71,7 +71,8 @@ namespace internal
     public:
       /**
        * Cache for the DoF indices on cells. The size of this array equals the
-       * number of cells on a given level times selected_fe.n_dofs_per_cell().
+       * number of cells on a given level times selected_fe.n_dofs_per_cell(),
+       * or zero if the cache has not been set up.
        */
       std::vector<types::global_dof_index> cell_dof_indices_cache;
 
@@ -1210,6 +1210,50 @@ namespace DoFRenumbering
   compute_subdomain_wise(std::vector<types::global_dof_index> &new_dof_indices,
                          const DoFHandler<dim, spacedim> &     dof_handler);
 
+  /**
+   * Renumber the locally owned degrees of freedom for data locality both
+   * within the current MPI process and with respect to its neighbors. The
+   * locally owned cells are traversed along a Hilbert space-filling curve
+   * through their centers, and degrees of freedom are enumerated in the
+   * order they are first encountered. The result is then grouped, keeping
+   * the order along the curve within each group:
+   * - first come the degrees of freedom that are only touched by cells whose
+   *   degrees of freedom are all locally owned and not needed by any other
+   *   process ("interior cells"),
+   * - then the remaining degrees of freedom touched by cells at the
+   *   boundary to other processes,
+   * - finally the degrees of freedom needed as ghosts by other processes,
+   *   in contiguous blocks per set of neighbor processes, sorted by the
+   *   ranks of these processes.
+   *
+   * The last groups make the import and export lists of a
+   * Utilities::MPI::Partitioner consist of few contiguous ranges, and the
+   * separation of interior from boundary degrees of freedom allows
+   * algorithms like MatrixFree to overlap the communication with work on
+   * the interior. For discontinuous elements, whose degrees of freedom are
+   * all located in the cell interior, the degrees of freedom of cells that
+   * are face neighbors of cells owned by another process are considered as
+   * shared with that process.
+   *
+   * On serial triangulations, this function simply orders the degrees of
+   * freedom along the Hilbert curve through the cells. The renumbering only
+   * affects the active degrees of freedom, not multigrid levels.
+   */
+  template <int dim, int spacedim>
+  void
+  hilbert(DoFHandler<dim, spacedim> &dof_handler);
+
+  /**
+   * Compute the renumbering vector needed by the hilbert() function. Does not
+   * perform the renumbering on the @p DoFHandler dofs but returns the
+   * renumbering vector. The vector @p new_dof_indices has to be of size
+   * DoFHandler::n_locally_owned_dofs().
+   */
+  template <int dim, int spacedim>
+  void
+  compute_hilbert(std::vector<types::global_dof_index> &new_dof_indices,
+                  const DoFHandler<dim, spacedim> &     dof_handler);
+
   /**
    * @}
    */
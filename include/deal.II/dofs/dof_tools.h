@@ -57,6 +57,7 @@ template <class MeshType>
 class InterGridMap;
 template <int dim, int spacedim>
 class Mapping;
+class ChunkSparsityPattern;
 class SparsityPattern;
 template <int dim, class T>
 class Table;
@@ -421,6 +422,42 @@ namespace DoFTools
     const bool                       keep_constrained_dofs = true,
     const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
 
+  /**
+   * Compute the same sparsity pattern as the previous function for a
+   * SparsityPattern object, but build it directly in compressed form without
+   * going through an intermediate DynamicSparsityPattern. The previous
+   * content of @p sparsity_pattern is discarded; on return, the object has
+   * the size <code>dof_handler.n_dofs()</code> times
+   * <code>dof_handler.n_dofs()</code> and is already compressed.
+   *
+   * The pattern is built in two passes that both run in parallel on the
+   * available threads. In the first pass, the degrees of freedom of each
+   * cell are collected and the constraints are resolved, and the list of
+   * cells that contribute to each row is set up. From this list, the exact
+   * number of entries in each row is computed, so that the memory of the
+   * SparsityPattern can be allocated exactly once with its final size. In
+   * the second pass, the rows are filled independently of each other and
+   * sorted in place. This avoids both the per-row allocations of
+   * DynamicSparsityPattern and the copy into the final object, which makes
+   * this function considerably faster and its peak memory consumption much
+   * smaller for large problems. Apart from the pattern itself, only memory
+   * proportional to the sum of the numbers of degrees of freedom over all
+   * cells is needed.
+   *
+   * The arguments @p constraints, @p keep_constrained_dofs, and
+   * @p subdomain_id have the same meaning as for the previous function.
+   *
+   * @ingroup constraints
+   */
+  template <int dim, int spacedim, typename number = double>
+  void
+  make_compressed_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
   /**
    * Compute which entries of a matrix built on the given @p dof_handler may
    * possibly be nonzero, and create a sparsity pattern object that represents
@@ -595,6 +632,58 @@ namespace DoFTools
     const bool                       keep_constrained_dofs = true,
     const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
 
+  /**
+   * Compute the same sparsity pattern as the previous function, but set up
+   * the SparsityPattern directly rather than adding to a given object. On
+   * output, @p sparsity_pattern has the size
+   * <code>dof_handler.n_dofs()</code> and is already compressed.
+   *
+   * This function works like make_compressed_sparsity_pattern(), with the
+   * couplings across faces added: each pair of neighboring cells is treated
+   * like one cell with the degrees of freedom of both. Every face is
+   * visited once instead of once from each side, both passes run in
+   * parallel on the available threads, and the memory of the pattern is
+   * allocated exactly once with its final size. No intermediate
+   * DynamicSparsityPattern is needed, so that the peak memory consumption
+   * is dominated by the pattern itself, which matters for high polynomial
+   * degrees where the coupling blocks between neighbors are large.
+   *
+   * The arguments @p constraints, @p keep_constrained_dofs, and
+   * @p subdomain_id have the same meaning as for the previous function.
+   *
+   * @ingroup constraints
+   */
+  template <int dim, int spacedim, typename number = double>
+  void
+  make_compressed_flux_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
+  /**
+   * Same as the previous function, but set up a ChunkSparsityPattern with
+   * chunks of size @p chunk_size. The pattern of the chunks is computed
+   * directly from the couplings of the cells and faces, without first
+   * building the pattern of the individual entries. For discontinuous
+   * elements whose degrees of freedom are numbered cell by cell, choosing
+   * @p chunk_size as a divisor of the number of degrees of freedom per cell
+   * results in a pattern of dense blocks as used by block-sparse (BSR)
+   * matrix formats.
+   *
+   * @ingroup constraints
+   */
+  template <int dim, int spacedim, typename number = double>
+  void
+  make_compressed_flux_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    ChunkSparsityPattern &           sparsity_pattern,
+    const unsigned int               chunk_size,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
 
   /**
    * This function does essentially the same as the other
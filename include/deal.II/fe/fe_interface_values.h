@@ -23,6 +23,8 @@
 
 #include <deal.II/hp/q_collection.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 /**
@@ -255,10 +257,16 @@ public:
    * in case of level cell (that is, if is_level_cell() return true )
    * the mg dof indices are returned.
    *
+   * For elements without degrees of freedom on faces (e.g. FE_DGQ), no
+   * indices can be shared between the two cells and the joint indices are
+   * simply the ones of the first cell followed by the ones of the second
+   * cell. Otherwise, the indices are sorted and shared indices only appear
+   * once.
+   *
    * @note This function is only available after a call to reinit() and can change
    * from one call to reinit() to the next.
    */
-  std::vector<types::global_dof_index>
+  const std::vector<types::global_dof_index> &
   get_interface_dof_indices() const;
 
   /**
@@ -431,6 +439,90 @@ public:
    * @}
    */
 
+  /**
+   * @name Functions to evaluate finite element fields
+   * @{
+   */
+
+  /**
+   * Return the jump $\jump{u}=u_{\text{cell0}} - u_{\text{cell1}}$ of the
+   * finite element function @p fe_function in all quadrature points of the
+   * current interface. Rather than looping over the interface dofs and
+   * quadrature points with jump(), the values on both sides are computed by
+   * the bulk evaluators of the two FEFaceValues objects.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\jump{u}=u_{\text{cell0}}$.
+   *
+   * This function may only be used for scalar elements and requires that
+   * reinit() was called with iterators into a DoFHandler.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  template <class InputVector>
+  void
+  get_jump_in_function_values(
+    const InputVector &                            fe_function,
+    std::vector<typename InputVector::value_type> &values) const;
+
+  /**
+   * Return the average $\average{u}=\frac{1}{2}u_{\text{cell0}} +
+   * \frac{1}{2}u_{\text{cell1}}$ of the finite element function @p
+   * fe_function in all quadrature points of the current interface. See
+   * get_jump_in_function_values() for the requirements.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\average{u}=u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  template <class InputVector>
+  void
+  get_average_of_function_values(
+    const InputVector &                            fe_function,
+    std::vector<typename InputVector::value_type> &values) const;
+
+  /**
+   * Return the jump in the gradient $\jump{\nabla u}=\nabla u_{\text{cell0}}
+   * - \nabla u_{\text{cell1}}$ of the finite element function @p
+   * fe_function in all quadrature points of the current interface. See
+   * get_jump_in_function_values() for the requirements.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\jump{\nabla u}=\nabla u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  template <class InputVector>
+  void
+  get_jump_in_function_gradients(
+    const InputVector &fe_function,
+    std::vector<Tensor<1, spacedim, typename InputVector::value_type>>
+      &gradients) const;
+
+  /**
+   * Return the average of the gradient $\average{\nabla u} =
+   * \frac{1}{2}\nabla u_{\text{cell0}} + \frac{1}{2} \nabla u_{\text{cell1}}$
+   * of the finite element function @p fe_function in all quadrature points of
+   * the current interface. See get_jump_in_function_values() for the
+   * requirements.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\average{\nabla u}=\nabla u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  template <class InputVector>
+  void
+  get_average_of_function_gradients(
+    const InputVector &fe_function,
+    std::vector<Tensor<1, spacedim, typename InputVector::value_type>>
+      &gradients) const;
+
+  /**
+   * @}
+   */
+
 private:
   /**
    * The list of DoF indices for the current interface, filled in reinit().
@@ -444,6 +536,32 @@ private:
    */
   std::vector<std::array<unsigned int, 2>> dofmap;
 
+  /**
+   * The number of dofs on the first and the second cell for which the
+   * content of @p dofmap describes the layout of an interior interface
+   * between elements without dofs on faces, i.e., the dofs of the first cell
+   * followed by the ones of the second cell. In that case, the layout is the
+   * same on all interfaces and does not need to be recomputed in reinit().
+   * Set to numbers::invalid_unsigned_int if @p dofmap holds another layout.
+   */
+  std::array<unsigned int, 2> dofmap_layout;
+
+  /**
+   * Scratch arrays for the dof indices of the two cells of the interface
+   * used in reinit(), kept as members to avoid repeated allocations.
+   */
+  std::vector<types::global_dof_index> dof_indices_cell;
+  std::vector<types::global_dof_index> dof_indices_neighbor;
+
+  /**
+   * Scratch array used in reinit() to identify the dofs shared between the
+   * two cells of the interface. It holds the global dof index and the local
+   * dof index, where the dofs of the second cell are numbered after the
+   * ones of the first cell.
+   */
+  std::vector<std::pair<types::global_dof_index, unsigned int>>
+    sorted_dof_indices;
+
   /**
    * The FEFaceValues object for the current cell.
    */
@@ -497,7 +615,9 @@ FEInterfaceValues<dim, spacedim>::FEInterfaceValues(
   , internal_fe_subface_values_neighbor(mapping, fe, quadrature, update_flags)
   , fe_face_values(nullptr)
   , fe_face_values_neighbor(nullptr)
-{}
+{
+  dofmap_layout.fill(numbers::invalid_unsigned_int);
+}
 
 template <int dim, int spacedim>
 FEInterfaceValues<dim, spacedim>::FEInterfaceValues(
@@ -515,7 +635,9 @@ FEInterfaceValues<dim, spacedim>::FEInterfaceValues(
                                         update_flags)
   , fe_face_values(nullptr)
   , fe_face_values_neighbor(nullptr)
-{}
+{
+  dofmap_layout.fill(numbers::invalid_unsigned_int);
+}
 
 
 
@@ -547,7 +669,9 @@ FEInterfaceValues<dim, spacedim>::FEInterfaceValues(
       update_flags)
   , fe_face_values(nullptr)
   , fe_face_values_neighbor(nullptr)
-{}
+{
+  dofmap_layout.fill(numbers::invalid_unsigned_int);
+}
 
 
 
@@ -592,49 +716,71 @@ FEInterfaceValues<dim, spacedim>::reinit(
     fe_face_values->n_quadrature_points;
 
   // Set up dof mapping and remove duplicates (for continuous elements).
-  {
-    // Get dof indices first:
-    std::vector<types::global_dof_index> v(
-      fe_face_values->get_fe().n_dofs_per_cell());
-    cell->get_active_or_mg_dof_indices(v);
-    std::vector<types::global_dof_index> v2(
-      fe_face_values_neighbor->get_fe().n_dofs_per_cell());
-    cell_neighbor->get_active_or_mg_dof_indices(v2);
-
-
-
-    // Fill a map from the global dof index to the left and right
-    // local index.
-    std::map<types::global_dof_index, std::pair<unsigned int, unsigned int>>
-                                          tempmap;
-    std::pair<unsigned int, unsigned int> invalid_entry(
-      numbers::invalid_unsigned_int, numbers::invalid_unsigned_int);
-
-    for (unsigned int i = 0; i < v.size(); ++i)
-      {
-        // If not already existing, add an invalid entry:
-        auto result = tempmap.insert(std::make_pair(v[i], invalid_entry));
-        result.first->second.first = i;
-      }
-
-    for (unsigned int i = 0; i < v2.size(); ++i)
-      {
-        // If not already existing, add an invalid entry:
-        auto result = tempmap.insert(std::make_pair(v2[i], invalid_entry));
-        result.first->second.second = i;
-      }
-
-    // Transfer from the map to the sorted std::vectors.
-    dofmap.resize(tempmap.size());
-    interface_dof_indices.resize(tempmap.size());
-    unsigned int idx = 0;
-    for (auto &x : tempmap)
-      {
-        interface_dof_indices[idx] = x.first;
-        dofmap[idx]                = {{x.second.first, x.second.second}};
-        ++idx;
-      }
-  }
+  const FiniteElement<dim, spacedim> &fe = fe_face_values->get_fe();
+  const FiniteElement<dim, spacedim> &fe_neighbor =
+    fe_face_values_neighbor->get_fe();
+  const unsigned int n_dofs          = fe.n_dofs_per_cell();
+  const unsigned int n_dofs_neighbor = fe_neighbor.n_dofs_per_cell();
+
+  dof_indices_cell.resize(n_dofs);
+  cell->get_active_or_mg_dof_indices(dof_indices_cell);
+  dof_indices_neighbor.resize(n_dofs_neighbor);
+  cell_neighbor->get_active_or_mg_dof_indices(dof_indices_neighbor);
+
+  if (fe.n_dofs_per_face(face_no) == 0 &&
+      fe_neighbor.n_dofs_per_face(face_no_neighbor) == 0)
+    {
+      // No dofs can be shared between the two cells, so simply append the
+      // dofs of the neighbor to the ones of the cell. The layout of the dof
+      // map only depends on the number of dofs and is reused from the
+      // previous interface if possible.
+      interface_dof_indices.resize(n_dofs + n_dofs_neighbor);
+      std::copy(dof_indices_cell.begin(),
+                dof_indices_cell.end(),
+                interface_dof_indices.begin());
+      std::copy(dof_indices_neighbor.begin(),
+                dof_indices_neighbor.end(),
+                interface_dof_indices.begin() + n_dofs);
+
+      if (dofmap_layout[0] != n_dofs || dofmap_layout[1] != n_dofs_neighbor)
+        {
+          dofmap.resize(n_dofs + n_dofs_neighbor);
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            dofmap[i] = {{i, numbers::invalid_unsigned_int}};
+          for (unsigned int i = 0; i < n_dofs_neighbor; ++i)
+            dofmap[n_dofs + i] = {{numbers::invalid_unsigned_int, i}};
+          dofmap_layout = {{n_dofs, n_dofs_neighbor}};
+        }
+    }
+  else
+    {
+      // Sort the dof indices of both cells and merge the entries with the
+      // same global index into one interface dof.
+      sorted_dof_indices.resize(n_dofs + n_dofs_neighbor);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        sorted_dof_indices[i] = {dof_indices_cell[i], i};
+      for (unsigned int i = 0; i < n_dofs_neighbor; ++i)
+        sorted_dof_indices[n_dofs + i] = {dof_indices_neighbor[i], n_dofs + i};
+      std::sort(sorted_dof_indices.begin(), sorted_dof_indices.end());
+
+      dofmap.clear();
+      interface_dof_indices.clear();
+      for (const auto &entry : sorted_dof_indices)
+        {
+          if (interface_dof_indices.empty() ||
+              interface_dof_indices.back() != entry.first)
+            {
+              interface_dof_indices.push_back(entry.first);
+              dofmap.push_back({{numbers::invalid_unsigned_int,
+                                 numbers::invalid_unsigned_int}});
+            }
+          if (entry.second < n_dofs)
+            dofmap.back()[0] = entry.second;
+          else
+            dofmap.back()[1] = entry.second - n_dofs;
+        }
+      dofmap_layout.fill(numbers::invalid_unsigned_int);
+    }
 }
 
 
@@ -659,6 +805,7 @@ FEInterfaceValues<dim, spacedim>::reinit(const CellIteratorType &cell,
     {
       dofmap[i] = {{i, numbers::invalid_unsigned_int}};
     }
+  dofmap_layout.fill(numbers::invalid_unsigned_int);
 }
 
 
@@ -766,7 +913,7 @@ FEInterfaceValues<dim, spacedim>::at_boundary() const
 
 
 template <int dim, int spacedim>
-std::vector<types::global_dof_index>
+const std::vector<types::global_dof_index> &
 FEInterfaceValues<dim, spacedim>::get_interface_dof_indices() const
 {
   return interface_dof_indices;
@@ -1037,6 +1184,98 @@ FEInterfaceValues<dim, spacedim>::jump_3rd_derivative(
 }
 
 
+
+template <int dim, int spacedim>
+template <class InputVector>
+void
+FEInterfaceValues<dim, spacedim>::get_jump_in_function_values(
+  const InputVector &                            fe_function,
+  std::vector<typename InputVector::value_type> &values) const
+{
+  AssertDimension(values.size(), n_quadrature_points);
+
+  get_fe_face_values(0).get_function_values(fe_function, values);
+  if (at_boundary())
+    return;
+
+  std::vector<typename InputVector::value_type> values_neighbor(
+    n_quadrature_points);
+  get_fe_face_values(1).get_function_values(fe_function, values_neighbor);
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    values[q] -= values_neighbor[q];
+}
+
+
+
+template <int dim, int spacedim>
+template <class InputVector>
+void
+FEInterfaceValues<dim, spacedim>::get_average_of_function_values(
+  const InputVector &                            fe_function,
+  std::vector<typename InputVector::value_type> &values) const
+{
+  AssertDimension(values.size(), n_quadrature_points);
+
+  get_fe_face_values(0).get_function_values(fe_function, values);
+  if (at_boundary())
+    return;
+
+  std::vector<typename InputVector::value_type> values_neighbor(
+    n_quadrature_points);
+  get_fe_face_values(1).get_function_values(fe_function, values_neighbor);
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    values[q] = 0.5 * (values[q] + values_neighbor[q]);
+}
+
+
+
+template <int dim, int spacedim>
+template <class InputVector>
+void
+FEInterfaceValues<dim, spacedim>::get_jump_in_function_gradients(
+  const InputVector &fe_function,
+  std::vector<Tensor<1, spacedim, typename InputVector::value_type>>
+    &gradients) const
+{
+  AssertDimension(gradients.size(), n_quadrature_points);
+
+  get_fe_face_values(0).get_function_gradients(fe_function, gradients);
+  if (at_boundary())
+    return;
+
+  std::vector<Tensor<1, spacedim, typename InputVector::value_type>>
+    gradients_neighbor(n_quadrature_points);
+  get_fe_face_values(1).get_function_gradients(fe_function,
+                                               gradients_neighbor);
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    gradients[q] -= gradients_neighbor[q];
+}
+
+
+
+template <int dim, int spacedim>
+template <class InputVector>
+void
+FEInterfaceValues<dim, spacedim>::get_average_of_function_gradients(
+  const InputVector &fe_function,
+  std::vector<Tensor<1, spacedim, typename InputVector::value_type>>
+    &gradients) const
+{
+  AssertDimension(gradients.size(), n_quadrature_points);
+
+  get_fe_face_values(0).get_function_gradients(fe_function, gradients);
+  if (at_boundary())
+    return;
+
+  std::vector<Tensor<1, spacedim, typename InputVector::value_type>>
+    gradients_neighbor(n_quadrature_points);
+  get_fe_face_values(1).get_function_gradients(fe_function,
+                                               gradients_neighbor);
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    gradients[q] = 0.5 * (gradients[q] + gradients_neighbor[q]);
+}
+
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
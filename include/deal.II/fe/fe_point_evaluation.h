@@ -519,6 +519,19 @@ private:
    */
   std::vector<value_type> solution_renumbered;
 
+  /**
+   * The value type with VectorizedArray entries, used to process several
+   * points at once.
+   */
+  using vectorized_value_type = typename internal::
+    ProductTypeNoPoint<value_type, VectorizedArray<double>>::type;
+
+  /**
+   * Temporary array to accumulate the integrals of the tensor product shape
+   * functions over the lanes of several points in integrate().
+   */
+  AlignedVector<vectorized_value_type> solution_renumbered_vectorized;
+
   /**
    * Temporary array to store the values at the points.
    */
@@ -581,7 +594,7 @@ FEPointEvaluation<n_components, dim, spacedim>::FEPointEvaluation(
       poly               = Polynomials::generate_complete_Lagrange_basis(
         QGaussLobatto<1>(shape_info.data[0].fe_degree + 1).get_points());
     }
-  if (true /*TODO: as long as the fast path of integrate() is not working*/)
+  if (poly.empty())
     {
       nonzero_shape_function_component.resize(fe.n_dofs_per_cell());
       for (unsigned int d = 0; d < n_components; ++d)
@@ -748,55 +761,50 @@ FEPointEvaluation<n_components, dim, spacedim>::integrate(
   const EvaluationFlags::EvaluationFlags &                    integration_flags)
 {
   AssertDimension(solution_values.size(), fe->dofs_per_cell);
-  if (false /*TODO*/ && (((integration_flags & EvaluationFlags::values) ||
-                          (integration_flags & EvaluationFlags::gradients)) &&
-                         !poly.empty()))
+  if (((integration_flags & EvaluationFlags::values) ||
+       (integration_flags & EvaluationFlags::gradients)) &&
+      !poly.empty())
     {
-      Assert(false, ExcNotImplemented());
       // fast path with tensor product integration
+      if (integration_flags & EvaluationFlags::values)
+        AssertIndexRange(unit_points.size(), values.size() + 1);
+      if (integration_flags & EvaluationFlags::gradients)
+        AssertIndexRange(unit_points.size(), gradients.size() + 1);
 
-      if (solution_renumbered.size() != dofs_per_component)
-        solution_renumbered.resize(dofs_per_component);
-
-      // let mapping compute the transformation
+      // let mapping compute the transformation, which is the transpose of
+      // the one applied in evaluate()
       if (integration_flags & EvaluationFlags::gradients)
         {
           Assert(mapping_q_generic != nullptr, ExcInternalError());
-
           mapping_q_generic->transform_variable(
             cell,
             mapping_covariant,
             unit_points,
-            ArrayView<const gradient_type>(gradients.data(), gradients.size()),
-            ArrayView<gradient_type>(gradients.data(), gradients.size()));
+            ArrayView<const gradient_type>(gradients.data(),
+                                           unit_points.size()),
+            ArrayView<gradient_type>(gradients.data(), unit_points.size()),
+            true);
         }
 
-      if (integration_flags & EvaluationFlags::values)
-        AssertIndexRange(unit_points.size(), values.size() + 1);
-      if (integration_flags & EvaluationFlags::gradients)
-        AssertIndexRange(unit_points.size(), gradients.size() + 1);
+      if (solution_renumbered_vectorized.size() != dofs_per_component)
+        solution_renumbered_vectorized.resize(dofs_per_component);
+      std::fill(solution_renumbered_vectorized.begin(),
+                solution_renumbered_vectorized.end(),
+                vectorized_value_type());
 
       const std::size_t n_points = unit_points.size();
       const std::size_t n_lanes  = VectorizedArray<double>::size();
       for (unsigned int i = 0; i < n_points; i += n_lanes)
         {
-          // convert to vectorized format
+          // convert to vectorized format, leaving the values and gradients
+          // of unused lanes at zero
           Point<dim, VectorizedArray<double>> vectorized_points;
           for (unsigned int j = 0; j < n_lanes && i + j < n_points; ++j)
             for (unsigned int d = 0; d < dim; ++d)
               vectorized_points[d][j] = unit_points[i + j][d];
 
-          typename internal::ProductTypeNoPoint<value_type,
-                                                VectorizedArray<double>>::type
-            value;
-          Tensor<1,
-                 dim,
-                 typename internal::ProductTypeNoPoint<
-                   value_type,
-                   VectorizedArray<double>>::type>
-            gradient;
-
-          // convert back to standard format
+          vectorized_value_type                 value    = {};
+          Tensor<1, dim, vectorized_value_type> gradient = {};
           if (integration_flags & EvaluationFlags::values)
             for (unsigned int j = 0; j < n_lanes && i + j < n_points; ++j)
               internal::FEPointEvaluation::EvaluatorTypeTraits<
@@ -811,20 +819,33 @@ FEPointEvaluation<n_components, dim, spacedim>::integrate(
           // compute
           internal::integrate_tensor_product_value_and_gradient(
             poly,
-            solution_renumbered,
+            solution_renumbered_vectorized,
             value,
             gradient,
-            vectorized_points,
-            poly.size() == 2);
+            vectorized_points);
         }
 
-      for (unsigned int comp = 0; comp < n_components; ++comp)
-        for (unsigned int i = 0; i < dofs_per_component; ++i)
-          internal::FEPointEvaluation::EvaluatorTypeTraits<dim, n_components>::
-            write_value(
-              solution_values[renumber[comp * dofs_per_component + i]],
-              comp,
-              solution_renumbered[i]);
+      // sum over the lanes and write into the solution vector, leaving the
+      // unknowns of components not selected by this class at zero
+      std::fill(solution_values.begin(), solution_values.end(), 0.0);
+      for (unsigned int i = 0; i < dofs_per_component; ++i)
+        {
+          value_type sum = {};
+          for (unsigned int j = 0; j < n_lanes; ++j)
+            {
+              value_type lane_value;
+              internal::FEPointEvaluation::
+                EvaluatorTypeTraits<dim, n_components>::set_value(
+                  solution_renumbered_vectorized[i], j, lane_value);
+              sum += lane_value;
+            }
+          for (unsigned int comp = 0; comp < n_components; ++comp)
+            internal::FEPointEvaluation::
+              EvaluatorTypeTraits<dim, n_components>::write_value(
+                solution_values[renumber[comp * dofs_per_component + i]],
+                comp,
+                sum);
+        }
     }
   else if ((integration_flags & EvaluationFlags::values) ||
            (integration_flags & EvaluationFlags::gradients))
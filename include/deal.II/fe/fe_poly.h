@@ -25,6 +25,8 @@
 #include <deal.II/fe/fe.h>
 
 #include <memory>
+#include <mutex>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -277,97 +279,25 @@ protected:
 
     const unsigned int n_q_points = quadrature.size();
 
-    // initialize some scratch arrays. we need them for the underlying
-    // polynomial to put the values and derivatives of shape functions
-    // to put there, depending on what the user requested
-    std::vector<double> values(
-      update_flags & update_values ? this->n_dofs_per_cell() : 0);
-    std::vector<Tensor<1, dim>> grads(
-      update_flags & update_gradients ? this->n_dofs_per_cell() : 0);
-    std::vector<Tensor<2, dim>> grad_grads(
-      update_flags & update_hessians ? this->n_dofs_per_cell() : 0);
-    std::vector<Tensor<3, dim>> third_derivatives(
-      update_flags & update_3rd_derivatives ? this->n_dofs_per_cell() : 0);
-    std::vector<Tensor<4, dim>>
-      fourth_derivatives; // won't be needed, so leave empty
-
-    // now also initialize fields the fields of this class's own
-    // temporary storage, depending on what we need for the given
-    // update flags.
-    //
-    // there is one exception from the rule: if we are dealing with
+    // the values and derivatives of the shape functions on the unit cell
+    // do not depend on the cell. they are shared with all other objects
+    // that need them in the same points. note that the shape gradients
+    // are only those on the unit cell, and need to be transformed when
+    // visiting an actual cell
+    data.reference_data = get_reference_shape_data(update_flags, quadrature);
+
+    // the values of shape functions at quadrature points don't change.
+    // consequently, copy them right into the output array if we can,
+    // i.e., if the output array has the correct size. this is the case on
     // cells (i.e., if this function is not called via
-    // get_(sub)face_data()), then we can already store things in the
-    // final location where FEValues::reinit() later wants to see
-    // things. we then don't need the intermediate space. we determine
-    // whether we are on a cell by asking whether the number of
-    // elements in the output array equals the number of quadrature
-    // points (yes, it's a cell) or not (because in that case the
-    // number of quadrature points we use here equals the number of
-    // quadrature points summed over *all* faces or subfaces, whereas
-    // the number of output slots equals the number of quadrature
-    // points on only *one* face)
+    // get_(sub)face_data()). on faces, we precompute data on *all* faces
+    // and subfaces, but we later on copy only a portion of it into the
+    // output object in fill_fe_face_values()
     if ((update_flags & update_values) &&
-        !((output_data.shape_values.n_rows() > 0) &&
-          (output_data.shape_values.n_cols() == n_q_points)))
-      data.shape_values.reinit(this->n_dofs_per_cell(), n_q_points);
-
-    if (update_flags & update_gradients)
-      data.shape_gradients.reinit(this->n_dofs_per_cell(), n_q_points);
-
-    if (update_flags & update_hessians)
-      data.shape_hessians.reinit(this->n_dofs_per_cell(), n_q_points);
-
-    if (update_flags & update_3rd_derivatives)
-      data.shape_3rd_derivatives.reinit(this->n_dofs_per_cell(), n_q_points);
-
-    // next already fill those fields of which we have information by
-    // now. note that the shape gradients are only those on the unit
-    // cell, and need to be transformed when visiting an actual cell
-    if (update_flags & (update_values | update_gradients | update_hessians |
-                        update_3rd_derivatives))
-      for (unsigned int i = 0; i < n_q_points; ++i)
-        {
-          poly_space->evaluate(quadrature.point(i),
-                               values,
-                               grads,
-                               grad_grads,
-                               third_derivatives,
-                               fourth_derivatives);
-
-          // the values of shape functions at quadrature points don't change.
-          // consequently, write these values right into the output array if
-          // we can, i.e., if the output array has the correct size. this is
-          // the case on cells. on faces, we already precompute data on *all*
-          // faces and subfaces, but we later on copy only a portion of it
-          // into the output object; in that case, copy the data from all
-          // faces into the scratch object
-          if (update_flags & update_values)
-            if (output_data.shape_values.n_rows() > 0)
-              {
-                if (output_data.shape_values.n_cols() == n_q_points)
-                  for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-                    output_data.shape_values[k][i] = values[k];
-                else
-                  for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-                    data.shape_values[k][i] = values[k];
-              }
-
-          // for everything else, derivatives need to be transformed,
-          // so we write them into our scratch space and only later
-          // copy stuff into where FEValues wants it
-          if (update_flags & update_gradients)
-            for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-              data.shape_gradients[k][i] = grads[k];
-
-          if (update_flags & update_hessians)
-            for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-              data.shape_hessians[k][i] = grad_grads[k];
-
-          if (update_flags & update_3rd_derivatives)
-            for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-              data.shape_3rd_derivatives[k][i] = third_derivatives[k];
-        }
+        ((output_data.shape_values.n_rows() > 0) &&
+         (output_data.shape_values.n_cols() == n_q_points)))
+      output_data.shape_values = data.reference_data->shape_values;
+
     return data_ptr;
   }
 
@@ -420,17 +350,29 @@ protected:
       &output_data) const override;
 
   /**
-   * Fields of cell-independent data.
-   *
-   * For information about the general purpose of this class, see the
-   * documentation of the base class.
+   * The values and derivatives of the shape functions in a set of points on
+   * the unit cell. These tables do not depend on the cell, and all
+   * InternalData objects created for the same points and update flags
+   * share one object of this type, see get_reference_shape_data().
    */
-  class InternalData : public FiniteElement<dim, spacedim>::InternalDataBase
+  struct ReferenceShapeData
   {
-  public:
     /**
-     * Array with shape function values in quadrature points. There is one row
-     * for each shape function, containing values for each quadrature point.
+     * The update flags for which the tables below have been computed,
+     * restricted to the values and derivatives of the shape functions.
+     */
+    UpdateFlags update_flags;
+
+    /**
+     * The points on the unit cell in which the shape functions have been
+     * evaluated.
+     */
+    std::vector<Point<dim>> points;
+
+    /**
+     * Array with shape function values in quadrature points. There is one
+     * row for each shape function, containing values for each quadrature
+     * point.
      *
      * In this array, we store the values of the shape function in the
      * quadrature points on the unit cell. Since these values do not change
@@ -440,9 +382,9 @@ protected:
     Table<2, double> shape_values;
 
     /**
-     * Array with shape function gradients in quadrature points. There is one
-     * row for each shape function, containing values for each quadrature
-     * point.
+     * Array with shape function gradients in quadrature points. There is
+     * one row for each shape function, containing values for each
+     * quadrature point.
      *
      * We store the gradients in the quadrature points on the unit cell. We
      * then only have to apply the transformation (which is a matrix-vector
@@ -462,8 +404,8 @@ protected:
     Table<2, Tensor<2, dim>> shape_hessians;
 
     /**
-     * Array with shape function third derivatives in quadrature points. There
-     * is one row for each shape function, containing values for each
+     * Array with shape function third derivatives in quadrature points.
+     * There is one row for each shape function, containing values for each
      * quadrature point.
      *
      * We store the third derivatives in the quadrature points on the unit
@@ -473,6 +415,38 @@ protected:
     Table<2, Tensor<3, dim>> shape_3rd_derivatives;
   };
 
+  /**
+   * Fields of cell-independent data.
+   *
+   * For information about the general purpose of this class, see the
+   * documentation of the base class.
+   */
+  class InternalData : public FiniteElement<dim, spacedim>::InternalDataBase
+  {
+  public:
+    /**
+     * The values and derivatives of the shape functions in the quadrature
+     * points on the unit cell. The tables are only read when visiting a
+     * cell and are shared with all other objects of this type that have
+     * been created for the same quadrature points and update flags, e.g.,
+     * by the FEValues objects of the different threads of a WorkStream
+     * loop.
+     */
+    std::shared_ptr<const ReferenceShapeData> reference_data;
+  };
+
+  /**
+   * Return the values and derivatives of the shape functions requested by
+   * @p update_flags in the points of @p quadrature. If an object returned
+   * by an earlier call for the same points and flags is still in use, that
+   * object is returned instead of computing the tables again.
+   *
+   * This function is thread safe.
+   */
+  std::shared_ptr<const ReferenceShapeData>
+  get_reference_shape_data(const UpdateFlags      update_flags,
+                           const Quadrature<dim> &quadrature) const;
+
   /**
    * Correct the shape Hessians by subtracting the terms corresponding to the
    * Jacobian pushed forward gradient.
@@ -532,6 +506,20 @@ protected:
    * The polynomial space.
    */
   const std::unique_ptr<ScalarPolynomialsBase<dim>> poly_space;
+
+  /**
+   * A mutex to be used to guard access to the variable below.
+   */
+  mutable std::mutex reference_shape_data_mutex;
+
+  /**
+   * The tables of shape function values and derivatives handed out by
+   * get_reference_shape_data(). Only weak pointers are kept, so the tables
+   * are released as soon as the last FEValues object using them is
+   * destroyed.
+   */
+  mutable std::vector<std::weak_ptr<const ReferenceShapeData>>
+    reference_shape_data_cache;
 };
 
 /*@}*/
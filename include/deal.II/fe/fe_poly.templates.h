@@ -54,6 +54,75 @@ FE_Poly<dim, spacedim>::get_degree() const
 }
 
 
+template <int dim, int spacedim>
+std::shared_ptr<const typename FE_Poly<dim, spacedim>::ReferenceShapeData>
+FE_Poly<dim, spacedim>::get_reference_shape_data(
+  const UpdateFlags      update_flags,
+  const Quadrature<dim> &quadrature) const
+{
+  const UpdateFlags flags =
+    update_flags & (update_values | update_gradients | update_hessians |
+                    update_3rd_derivatives);
+
+  std::lock_guard<std::mutex> lock(reference_shape_data_mutex);
+
+  // look for tables that are still in use for the same points and flags,
+  // and forget about those that have been released in the meantime
+  std::shared_ptr<const ReferenceShapeData> shape_data;
+  for (auto entry = reference_shape_data_cache.begin();
+       entry != reference_shape_data_cache.end();)
+    {
+      const std::shared_ptr<const ReferenceShapeData> cached_data =
+        entry->lock();
+      if (cached_data == nullptr)
+        {
+          entry = reference_shape_data_cache.erase(entry);
+          continue;
+        }
+
+      if (shape_data == nullptr && cached_data->update_flags == flags &&
+          cached_data->points == quadrature.get_points())
+        shape_data = cached_data;
+      ++entry;
+    }
+
+  if (shape_data != nullptr)
+    return shape_data;
+
+  // otherwise compute the tables. the tables of the derivatives not
+  // requested are empty and hence not computed
+  const unsigned int n_q_points = quadrature.size();
+
+  const auto new_data    = std::make_shared<ReferenceShapeData>();
+  new_data->update_flags = flags;
+  new_data->points       = quadrature.get_points();
+
+  if (flags & update_values)
+    new_data->shape_values.reinit(this->n_dofs_per_cell(), n_q_points);
+
+  if (flags & update_gradients)
+    new_data->shape_gradients.reinit(this->n_dofs_per_cell(), n_q_points);
+
+  if (flags & update_hessians)
+    new_data->shape_hessians.reinit(this->n_dofs_per_cell(), n_q_points);
+
+  if (flags & update_3rd_derivatives)
+    new_data->shape_3rd_derivatives.reinit(this->n_dofs_per_cell(),
+                                           n_q_points);
+
+  if (flags != update_default)
+    poly_space->evaluate_on_points(new_data->points,
+                                   new_data->shape_values,
+                                   new_data->shape_gradients,
+                                   new_data->shape_hessians,
+                                   new_data->shape_3rd_derivatives);
+
+  reference_shape_data_cache.push_back(new_data);
+
+  return new_data;
+}
+
+
 template <int dim, int spacedim>
 double
 FE_Poly<dim, spacedim>::shape_value(const unsigned int i,
@@ -282,6 +351,8 @@ FE_Poly<dim, spacedim>::fill_fe_values(
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
 
+  const ReferenceShapeData &shape_data = *fe_data.reference_data;
+
   const UpdateFlags flags(fe_data.update_each);
 
   const bool need_to_correct_higher_derivatives =
@@ -296,7 +367,7 @@ FE_Poly<dim, spacedim>::fill_fe_values(
   if ((flags & update_gradients) &&
       (cell_similarity != CellSimilarity::translation))
     for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_data.shape_gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -305,7 +376,7 @@ FE_Poly<dim, spacedim>::fill_fe_values(
       (cell_similarity != CellSimilarity::translation))
     {
       for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_data.shape_hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -318,7 +389,7 @@ FE_Poly<dim, spacedim>::fill_fe_values(
       (cell_similarity != CellSimilarity::translation))
     {
       for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+        mapping.transform(make_array_view(shape_data.shape_3rd_derivatives, k),
                           mapping_covariant_hessian,
                           mapping_internal,
                           make_array_view(output_data.shape_3rd_derivatives,
@@ -358,6 +429,8 @@ FE_Poly<dim, spacedim>::fill_fe_face_values(
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
 
+  const ReferenceShapeData &shape_data = *fe_data.reference_data;
+
   // offset determines which data set
   // to take (all data sets for all
   // faces are stored contiguously)
@@ -384,12 +457,12 @@ FE_Poly<dim, spacedim>::fill_fe_face_values(
   if (flags & update_values)
     for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
       for (unsigned int i = 0; i < n_q_points; ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
+        output_data.shape_values(k, i) = shape_data.shape_values[k][i + offset];
 
   if (flags & update_gradients)
     for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
       mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, n_q_points),
+        make_array_view(shape_data.shape_gradients, k, offset, n_q_points),
         mapping_covariant,
         mapping_internal,
         make_array_view(output_data.shape_gradients, k));
@@ -398,7 +471,7 @@ FE_Poly<dim, spacedim>::fill_fe_face_values(
     {
       for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
         mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, n_q_points),
+          make_array_view(shape_data.shape_hessians, k, offset, n_q_points),
           mapping_covariant_gradient,
           mapping_internal,
           make_array_view(output_data.shape_hessians, k));
@@ -411,7 +484,8 @@ FE_Poly<dim, spacedim>::fill_fe_face_values(
     {
       for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
         mapping.transform(
-          make_array_view(fe_data.shape_3rd_derivatives, k, offset, n_q_points),
+          make_array_view(
+            shape_data.shape_3rd_derivatives, k, offset, n_q_points),
           mapping_covariant_hessian,
           mapping_internal,
           make_array_view(output_data.shape_3rd_derivatives, k));
@@ -448,6 +522,8 @@ FE_Poly<dim, spacedim>::fill_fe_subface_values(
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
 
+  const ReferenceShapeData &shape_data = *fe_data.reference_data;
+
   // offset determines which data set
   // to take (all data sets for all
   // sub-faces are stored contiguously)
@@ -476,12 +552,13 @@ FE_Poly<dim, spacedim>::fill_fe_subface_values(
   if (flags & update_values)
     for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
       for (unsigned int i = 0; i < quadrature.size(); ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
+        output_data.shape_values(k, i) = shape_data.shape_values[k][i + offset];
 
   if (flags & update_gradients)
     for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
       mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, quadrature.size()),
+        make_array_view(
+          shape_data.shape_gradients, k, offset, quadrature.size()),
         mapping_covariant,
         mapping_internal,
         make_array_view(output_data.shape_gradients, k));
@@ -490,7 +567,8 @@ FE_Poly<dim, spacedim>::fill_fe_subface_values(
     {
       for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
         mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, quadrature.size()),
+          make_array_view(
+            shape_data.shape_hessians, k, offset, quadrature.size()),
           mapping_covariant_gradient,
           mapping_internal,
           make_array_view(output_data.shape_hessians, k));
@@ -502,7 +580,7 @@ FE_Poly<dim, spacedim>::fill_fe_subface_values(
   if (flags & update_3rd_derivatives)
     {
       for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
+        mapping.transform(make_array_view(shape_data.shape_3rd_derivatives,
                                           k,
                                           offset,
                                           quadrature.size()),
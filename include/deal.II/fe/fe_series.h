@@ -25,6 +25,7 @@
 #include <deal.II/base/table.h>
 #include <deal.II/base/table_indices.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/hp/fe_collection.h>
 #include <deal.II/hp/q_collection.h>
@@ -131,6 +132,11 @@ namespace FESeries
      * Calculate @p fourier_coefficients of the cell vector field given by
      * @p local_dof_values corresponding to FiniteElement with
      * @p cell_active_fe_index .
+     *
+     * The transformation matrix for @p cell_active_fe_index is computed on
+     * first use. Once all of them exist, e.g. after a call to
+     * precalculate_all_transformation_matrices(), this function may be
+     * called concurrently from several threads.
      */
     template <typename Number>
     void
@@ -213,9 +219,10 @@ namespace FESeries
     std::vector<FullMatrix<CoefficientType>> fourier_transform_matrices;
 
     /**
-     * Auxiliary vector to store unrolled coefficients.
+     * Auxiliary vector to store unrolled coefficients, one per thread.
      */
-    std::vector<CoefficientType> unrolled_coefficients;
+    Threads::ThreadLocalStorage<std::vector<CoefficientType>>
+      unrolled_coefficients;
 
     /**
      * Which component of FiniteElement should be used to calculate the
@@ -314,6 +321,11 @@ namespace FESeries
      * Calculate @p legendre_coefficients of the cell vector field given by
      * @p local_dof_values corresponding to FiniteElement with
      * @p cell_active_fe_index .
+     *
+     * The transformation matrix for @p cell_active_fe_index is computed on
+     * first use. Once all of them exist, e.g. after a call to
+     * precalculate_all_transformation_matrices(), this function may be
+     * called concurrently from several threads.
      */
     template <typename Number>
     void
@@ -391,9 +403,10 @@ namespace FESeries
     std::vector<FullMatrix<CoefficientType>> legendre_transform_matrices;
 
     /**
-     * Auxiliary vector to store unrolled coefficients.
+     * Auxiliary vector to store unrolled coefficients, one per thread.
      */
-    std::vector<CoefficientType> unrolled_coefficients;
+    Threads::ThreadLocalStorage<std::vector<CoefficientType>>
+      unrolled_coefficients;
 
     /**
      * Which component of FiniteElement should be used to calculate the
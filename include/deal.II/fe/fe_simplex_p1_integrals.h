@@ -0,0 +1,350 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fe_simplex_p1_integrals_h
+#define dealii_fe_simplex_p1_integrals_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+
+#include <deal.II/grid/reference_cell.h>
+#include <deal.II/grid/tria.h>
+
+#include <array>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A class to compute the mass, Laplace and advection element matrices of
+ * the linear simplex element FE_SimplexP<dim>(1) on affine cells without
+ * evaluating shape functions in quadrature points.
+ *
+ * On a simplex with vertices $x_0,\ldots,x_d$, the mapping from the
+ * reference cell is affine with the constant Jacobian $J$ whose columns are
+ * $x_i - x_0$, and the gradients of the linear shape functions are constant.
+ * As a consequence, all element matrices are products of $|\det J|$, the
+ * inverse Jacobian and a few integrals over the reference cell, which are
+ * computed once in the constructor:
+ * @f{align*}{
+ *   M_{ij} &= |\det J| \int_{\hat K} \hat\varphi_i \hat\varphi_j \, d\hat x,
+ *   \\
+ *   K_{ij} &= |\det J|\, |\hat K| \, (J^{-T}\hat\nabla\hat\varphi_i) \cdot
+ *   (J^{-T}\hat\nabla\hat\varphi_j),
+ *   \\
+ *   A_{ij} &= |\det J| \int_{\hat K} \hat\varphi_i \, d\hat x \;
+ *   \mathbf{b} \cdot (J^{-T}\hat\nabla\hat\varphi_j),
+ * @f}
+ * where the advection matrix $A$ is computed for a velocity $\mathbf{b}$
+ * that is constant on the cell. The row index $i$ refers to the test
+ * function and the column index $j$ to the trial function, as in the
+ * usual local matrices.
+ *
+ * The computations are performed for a batch of
+ * VectorizedArray<Number>::size() cells at once, with one cell per lane of
+ * the VectorizedArray. The results are returned as a table of vectorized
+ * entries, in the same format as the cell matrices computed by
+ * MatrixFreeTools::compute_cell_matrix(). The numbering of the dofs is the
+ * one of FE_SimplexP<dim>(1), which coincides with the numbering of the
+ * vertices of the cell.
+ *
+ * This class is only valid for cells with straight edges, i.e., the
+ * geometry described by MappingFE with FE_SimplexP<dim>(1).
+ *
+ * @ingroup simplex
+ */
+template <int dim, typename Number = double>
+class FESimplexP1Integrals
+{
+public:
+  /**
+   * The vectorized number type used for the batches of cells.
+   */
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * The number of dofs per cell of FE_SimplexP<dim>(1).
+   */
+  static constexpr unsigned int dofs_per_cell = dim + 1;
+
+  /**
+   * Constructor. Computes the integrals on the reference cell.
+   */
+  FESimplexP1Integrals();
+
+  /**
+   * Compute the Jacobians of a batch of cells given by their vertices, with
+   * one cell per lane of the VectorizedArray.
+   */
+  void
+  reinit(
+    const std::array<Point<dim, VectorizedArrayType>, dofs_per_cell> &vertices);
+
+  /**
+   * Compute the Jacobians of a batch of at most
+   * VectorizedArrayType::size() cells. Unused lanes are filled with the
+   * data of the first cell.
+   */
+  void
+  reinit(const ArrayView<const typename Triangulation<dim>::cell_iterator>
+           &cells);
+
+  /**
+   * Return the number of cells handed to the last call of reinit() with
+   * cell iterators, or VectorizedArrayType::size() if the vertices were
+   * given directly.
+   */
+  unsigned int
+  n_active_lanes() const;
+
+  /**
+   * Return the absolute value of the determinant of the Jacobian of the
+   * cells of the current batch.
+   */
+  const VectorizedArrayType &
+  get_jacobian_determinant() const;
+
+  /**
+   * Compute the mass matrices of the current batch of cells.
+   */
+  void
+  mass_matrix(Table<2, VectorizedArrayType> &matrix) const;
+
+  /**
+   * Compute the Laplace (stiffness) matrices of the current batch of cells,
+   * scaled by a coefficient @p coefficient that is constant on each cell.
+   */
+  void
+  laplace_matrix(
+    Table<2, VectorizedArrayType> &matrix,
+    const VectorizedArrayType &    coefficient = VectorizedArrayType(1.)) const;
+
+  /**
+   * Compute the advection matrices $A_{ij} = (\varphi_i, \mathbf{b} \cdot
+   * \nabla \varphi_j)$ of the current batch of cells for the velocity @p
+   * velocity, which is constant on each cell.
+   */
+  void
+  advection_matrix(const Tensor<1, dim, VectorizedArrayType> &velocity,
+                   Table<2, VectorizedArrayType> &            matrix) const;
+
+private:
+  /**
+   * The integrals of the products of the shape functions on the reference
+   * cell.
+   */
+  Table<2, Number> reference_mass_matrix;
+
+  /**
+   * The integrals of the shape functions on the reference cell.
+   */
+  std::array<Number, dofs_per_cell> reference_integrals;
+
+  /**
+   * The (constant) gradients of the shape functions on the reference cell.
+   */
+  std::array<Tensor<1, dim, Number>, dofs_per_cell> reference_gradients;
+
+  /**
+   * The volume of the reference cell.
+   */
+  Number reference_volume;
+
+  /**
+   * The absolute value of the determinant of the Jacobian of the current
+   * batch of cells.
+   */
+  VectorizedArrayType jacobian_determinant;
+
+  /**
+   * The gradients of the shape functions on the current batch of cells.
+   */
+  std::array<Tensor<1, dim, VectorizedArrayType>, dofs_per_cell> gradients;
+
+  /**
+   * The number of cells in the current batch.
+   */
+  unsigned int n_lanes_filled;
+};
+
+
+
+#ifndef DOXYGEN
+
+template <int dim, typename Number>
+FESimplexP1Integrals<dim, Number>::FESimplexP1Integrals()
+  : reference_mass_matrix(dofs_per_cell, dofs_per_cell)
+  , reference_volume(0.)
+  , jacobian_determinant(0.)
+  , n_lanes_filled(0)
+{
+  const FE_SimplexP<dim> fe(1);
+  const QGaussSimplex<dim> quadrature(2);
+
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    {
+      reference_integrals[i] = 0.;
+      reference_gradients[i] = fe.shape_grad(i, quadrature.point(0));
+    }
+
+  for (unsigned int q = 0; q < quadrature.size(); ++q)
+    {
+      reference_volume += quadrature.weight(q);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+          const double value_i = fe.shape_value(i, quadrature.point(q));
+          reference_integrals[i] += value_i * quadrature.weight(q);
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            reference_mass_matrix(i, j) +=
+              value_i * fe.shape_value(j, quadrature.point(q)) *
+              quadrature.weight(q);
+        }
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+FESimplexP1Integrals<dim, Number>::reinit(
+  const std::array<Point<dim, VectorizedArrayType>, dofs_per_cell> &vertices)
+{
+  Tensor<2, dim, VectorizedArrayType> jacobian;
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int e = 0; e < dim; ++e)
+      jacobian[d][e] = vertices[e + 1][d] - vertices[0][d];
+
+  const VectorizedArrayType determinant = dealii::determinant(jacobian);
+  jacobian_determinant                  = std::abs(determinant);
+
+  const Tensor<2, dim, VectorizedArrayType> inverse_jacobian_transpose =
+    transpose(invert(jacobian));
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    {
+      Tensor<1, dim, VectorizedArrayType> reference_gradient;
+      for (unsigned int d = 0; d < dim; ++d)
+        reference_gradient[d] = reference_gradients[i][d];
+      gradients[i] = inverse_jacobian_transpose * reference_gradient;
+    }
+
+  n_lanes_filled = VectorizedArrayType::size();
+}
+
+
+
+template <int dim, typename Number>
+void
+FESimplexP1Integrals<dim, Number>::reinit(
+  const ArrayView<const typename Triangulation<dim>::cell_iterator> &cells)
+{
+  AssertIndexRange(cells.size(), VectorizedArrayType::size() + 1);
+  Assert(cells.size() > 0, ExcMessage("At least one cell must be given."));
+
+  std::array<Point<dim, VectorizedArrayType>, dofs_per_cell> vertices;
+  for (unsigned int v = 0; v < VectorizedArrayType::size(); ++v)
+    {
+      const auto &cell = cells[v < cells.size() ? v : 0];
+      Assert(cell->reference_cell() == ReferenceCells::get_simplex<dim>(),
+             ExcMessage("This class can only be used on simplex cells."));
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int d = 0; d < dim; ++d)
+          vertices[i][d][v] = cell->vertex(i)[d];
+    }
+
+  reinit(vertices);
+
+  n_lanes_filled = cells.size();
+}
+
+
+
+template <int dim, typename Number>
+inline unsigned int
+FESimplexP1Integrals<dim, Number>::n_active_lanes() const
+{
+  return n_lanes_filled;
+}
+
+
+
+template <int dim, typename Number>
+inline const typename FESimplexP1Integrals<dim, Number>::VectorizedArrayType &
+FESimplexP1Integrals<dim, Number>::get_jacobian_determinant() const
+{
+  return jacobian_determinant;
+}
+
+
+
+template <int dim, typename Number>
+void
+FESimplexP1Integrals<dim, Number>::mass_matrix(
+  Table<2, VectorizedArrayType> &matrix) const
+{
+  matrix.reinit(dofs_per_cell, dofs_per_cell);
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    for (unsigned int j = 0; j < dofs_per_cell; ++j)
+      matrix(i, j) = jacobian_determinant * reference_mass_matrix(i, j);
+}
+
+
+
+template <int dim, typename Number>
+void
+FESimplexP1Integrals<dim, Number>::laplace_matrix(
+  Table<2, VectorizedArrayType> &matrix,
+  const VectorizedArrayType &    coefficient) const
+{
+  matrix.reinit(dofs_per_cell, dofs_per_cell);
+  const VectorizedArrayType factor =
+    coefficient * jacobian_determinant * reference_volume;
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    for (unsigned int j = i; j < dofs_per_cell; ++j)
+      {
+        matrix(i, j) = factor * (gradients[i] * gradients[j]);
+        matrix(j, i) = matrix(i, j);
+      }
+}
+
+
+
+template <int dim, typename Number>
+void
+FESimplexP1Integrals<dim, Number>::advection_matrix(
+  const Tensor<1, dim, VectorizedArrayType> &velocity,
+  Table<2, VectorizedArrayType> &            matrix) const
+{
+  matrix.reinit(dofs_per_cell, dofs_per_cell);
+  for (unsigned int j = 0; j < dofs_per_cell; ++j)
+    {
+      const VectorizedArrayType velocity_times_gradient =
+        jacobian_determinant * (velocity * gradients[j]);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        matrix(i, j) = reference_integrals[i] * velocity_times_gradient;
+    }
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
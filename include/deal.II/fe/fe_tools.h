@@ -32,6 +32,7 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -424,6 +425,30 @@ namespace FETools
     std::vector<std::vector<FullMatrix<number>>> &matrices,
     const bool                                    isotropic_only = false);
 
+  /**
+   * Return a copy of the transfer matrices stored under @p key in a cache
+   * that is shared by all finite element objects of the program. If there is
+   * no entry for @p key yet, the matrices are computed by calling @p compute
+   * and stored in the cache.
+   *
+   * Computing the embedding and projection matrices via
+   * compute_embedding_matrices() and compute_projection_matrices() is
+   * expensive for elements of high degree, and programs frequently create
+   * several identical element objects. This function allows those elements
+   * to compute the matrices only once per program run. The key has to
+   * identify both the element and the kind of matrices uniquely, for example
+   * by combining FiniteElement::get_name() with the refinement case. Keys
+   * containing the string <tt>QUnknownNodes</tt>, as returned by the names of
+   * elements on support points that cannot be identified, are never cached.
+   *
+   * This function is thread-safe. @p compute is called without holding a
+   * lock, so it may call this function itself.
+   */
+  std::vector<FullMatrix<double>>
+  get_shared_transfer_matrices(
+    const std::string &                                      key,
+    const std::function<std::vector<FullMatrix<double>>()> &compute);
+
   /**
    * Project scalar data defined in quadrature points to a finite element
    * space on a single cell.
@@ -141,29 +141,40 @@ namespace FETools
           return false;
         }
 
+        // the number of bytes needed to pack this object, with or without
+        // the dof values. Needs sent to other processes do not carry any
+        // values, only the number of dofs
         unsigned int
-        bytes_for_buffer() const
+        bytes_for_buffer(const bool with_dof_values) const
         {
-          return (sizeof(unsigned int) +                   // dofs_per_cell
-                  dof_values.size() * sizeof(value_type) + // dof_values
-                  sizeof(unsigned int) +                   // tree_index
+          return (sizeof(unsigned int) + // dofs_per_cell
+                  (with_dof_values ? dof_values.size() * sizeof(value_type) :
+                                     0) + // dof_values
+                  sizeof(unsigned int) +  // tree_index
                   sizeof(typename dealii::internal::p4est::types<
                          dim>::quadrant)); // quadrant
         }
 
+        // append the data of this object to the end of the buffer
         void
-        pack_data(std::vector<char> &buffer) const
+        pack_data(std::vector<char> &buffer, const bool with_dof_values) const
         {
-          buffer.resize(bytes_for_buffer());
+          const std::size_t old_size = buffer.size();
+          buffer.resize(old_size + bytes_for_buffer(with_dof_values));
 
-          char *ptr = buffer.data();
+          char *ptr = buffer.data() + old_size;
 
           unsigned int n_dofs = dof_values.size();
           std::memcpy(ptr, &n_dofs, sizeof(unsigned int));
           ptr += sizeof(unsigned int);
 
-          std::memcpy(ptr, dof_values.begin(), n_dofs * sizeof(value_type));
-          ptr += n_dofs * sizeof(value_type);
+          if (with_dof_values)
+            {
+              std::memcpy(ptr,
+                          dof_values.begin(),
+                          n_dofs * sizeof(value_type));
+              ptr += n_dofs * sizeof(value_type);
+            }
 
           std::memcpy(ptr, &tree_index, sizeof(unsigned int));
           ptr += sizeof(unsigned int);
@@ -177,17 +188,23 @@ namespace FETools
           Assert(ptr == buffer.data() + buffer.size(), ExcInternalError());
         }
 
+        // read the data of this object from the position @p ptr and
+        // advance the pointer behind the data read
         void
-        unpack_data(const std::vector<char> &buffer)
+        unpack_data(const char *&ptr, const bool with_dof_values)
         {
-          const char * ptr = buffer.data();
           unsigned int n_dofs;
           memcpy(&n_dofs, ptr, sizeof(unsigned int));
           ptr += sizeof(unsigned int);
 
           dof_values.reinit(n_dofs);
-          std::memcpy(dof_values.begin(), ptr, n_dofs * sizeof(value_type));
-          ptr += n_dofs * sizeof(value_type);
+          if (with_dof_values)
+            {
+              std::memcpy(dof_values.begin(),
+                          ptr,
+                          n_dofs * sizeof(value_type));
+              ptr += n_dofs * sizeof(value_type);
+            }
 
           std::memcpy(&tree_index, ptr, sizeof(unsigned int));
           ptr += sizeof(unsigned int);
@@ -197,8 +214,6 @@ namespace FETools
             ptr,
             sizeof(typename dealii::internal::p4est::types<dim>::quadrant));
           ptr += sizeof(typename dealii::internal::p4est::types<dim>::quadrant);
-
-          Assert(ptr == buffer.data() + buffer.size(), ExcInternalError());
         }
       };
 
@@ -241,6 +256,8 @@ namespace FETools
       //      processes there can arise new needs and they are
       //      stored in a list again.
       // 4) Send the computed values and the list of new needs around
+      //      Both are sent together, in one message per receiving
+      //      process.
       //
       // This procedure has to be repeated until no process needs any
       // new need and all needs are computed, but there are at most the
@@ -367,12 +384,16 @@ namespace FETools
         std::vector<CellData> &computed_cells,
         std::vector<CellData> &new_needs);
 
-      // send all cell_data in the vector
-      // cells_to_send to their receivers
-      // and receives a vector of cell_data
+      // send all cell_data in the vectors
+      // cells_to_send and needs_to_send to their receivers
+      // and receive the cell_data and needs other processes
+      // sent to us. All cell_data for one receiver are packed
+      // into a single message
       void
       send_cells(const std::vector<CellData> &cells_to_send,
-                 std::vector<CellData> &      received_cells) const;
+                 const std::vector<CellData> &needs_to_send,
+                 std::vector<CellData> &      received_cells,
+                 std::vector<CellData> &      received_needs) const;
 
       // add new cell_data to
       // the ordered list new_needs
@@ -1143,12 +1164,37 @@ namespace FETools
     void
     ExtrapolateImplementation<dim, spacedim, OutVector>::send_cells(
       const std::vector<CellData> &cells_to_send,
-      std::vector<CellData> &      received_cells) const
+      const std::vector<CellData> &needs_to_send,
+      std::vector<CellData> &      received_cells,
+      std::vector<CellData> &      received_needs) const
     {
-      std::vector<std::vector<char>> sendbuffers(cells_to_send.size());
-      std::vector<std::vector<char>>::iterator buffer = sendbuffers.begin();
-      std::vector<MPI_Request>                 requests(cells_to_send.size());
-      std::vector<unsigned int>                destinations;
+      // collect the cells and the needs for each receiver, such that we
+      // send only one message to each other process. the buffer for one
+      // receiver starts with the number of cells and the number of needs
+      std::map<unsigned int, std::pair<unsigned int, unsigned int>> n_items;
+      for (const CellData &cell_data : cells_to_send)
+        ++n_items[cell_data.receiver].first;
+      for (const CellData &cell_data : needs_to_send)
+        ++n_items[cell_data.receiver].second;
+
+      std::map<unsigned int, std::vector<char>> sendbuffers;
+      for (const auto &it : n_items)
+        {
+          std::vector<char> &buffer = sendbuffers[it.first];
+          buffer.resize(2 * sizeof(unsigned int));
+          std::memcpy(buffer.data(), &it.second.first, sizeof(unsigned int));
+          std::memcpy(buffer.data() + sizeof(unsigned int),
+                      &it.second.second,
+                      sizeof(unsigned int));
+        }
+      for (const CellData &cell_data : cells_to_send)
+        cell_data.pack_data(sendbuffers[cell_data.receiver], true);
+      for (const CellData &cell_data : needs_to_send)
+        cell_data.pack_data(sendbuffers[cell_data.receiver], false);
+
+      std::vector<MPI_Request>  requests(sendbuffers.size());
+      std::vector<unsigned int> destinations;
+      destinations.reserve(sendbuffers.size());
 
       // Protect the communication below:
       static Utilities::MPI::CollectiveMutex      mutex;
@@ -1160,26 +1206,20 @@ namespace FETools
 
       // send data
       unsigned int idx = 0;
-      for (typename std::vector<CellData>::const_iterator it =
-             cells_to_send.begin();
-           it != cells_to_send.end();
-           ++it, ++idx)
+      for (auto &it : sendbuffers)
         {
-          destinations.push_back(it->receiver);
+          destinations.push_back(it.first);
 
-          it->pack_data(*buffer);
-          const int ierr = MPI_Isend(buffer->data(),
-                                     buffer->size(),
+          const int ierr = MPI_Isend(it.second.data(),
+                                     it.second.size(),
                                      MPI_BYTE,
-                                     it->receiver,
+                                     it.first,
                                      mpi_tag,
                                      communicator,
-                                     &requests[idx]);
+                                     &requests[idx++]);
           AssertThrowMPI(ierr);
         }
 
-      Assert(destinations.size() == cells_to_send.size(), ExcInternalError());
-
       const unsigned int n_senders =
         Utilities::MPI::compute_n_point_to_point_communications(communicator,
                                                                 destinations);
@@ -1208,14 +1248,30 @@ namespace FETools
                           &status);
           AssertThrowMPI(ierr);
 
-          cell_data.unpack_data(receive);
+          const char * ptr = receive.data();
+          unsigned int n_cells, n_needs;
+          std::memcpy(&n_cells, ptr, sizeof(unsigned int));
+          ptr += sizeof(unsigned int);
+          std::memcpy(&n_needs, ptr, sizeof(unsigned int));
+          ptr += sizeof(unsigned int);
 
-          // this process has to send this
-          // cell back to the sender
+          // this process has to send the needed
+          // cells back to the sender
           // the receiver is the old sender
           cell_data.receiver = status.MPI_SOURCE;
 
-          received_cells.push_back(cell_data);
+          for (unsigned int i = 0; i < n_cells; ++i)
+            {
+              cell_data.unpack_data(ptr, true);
+              received_cells.push_back(cell_data);
+            }
+          for (unsigned int i = 0; i < n_needs; ++i)
+            {
+              cell_data.unpack_data(ptr, false);
+              received_needs.push_back(cell_data);
+            }
+
+          Assert(ptr == receive.data() + receive.size(), ExcInternalError());
         }
 
       if (requests.size() > 0)
@@ -1225,8 +1281,9 @@ namespace FETools
           AssertThrowMPI(ierr);
         }
 
-      // finally sort the list of cells
+      // finally sort the lists of cells
       std::sort(received_cells.begin(), received_cells.end());
+      std::sort(received_needs.begin(), received_needs.end());
     }
 
 
@@ -1310,7 +1367,10 @@ namespace FETools
 
       // Send the cells needed to their owners and receive
       // a list of cells other processes need from us.
-      send_cells(cells_we_need, received_needs);
+      send_cells(std::vector<CellData>(),
+                 cells_we_need,
+                 received_cells,
+                 received_needs);
 
       // The list of received needs can contain some cells more than once
       // because different processes may need data from the same cell.
@@ -1362,12 +1422,21 @@ namespace FETools
                     ++recv;
                 }
             }
+          computed_cells.clear();
 
           // increase the round counter, such that we are sure to only send
           // and receive data from the correct call
           ++round;
 
-          send_cells(cells_to_send, received_cells);
+          // send the computed cells back to the processes that need them
+          // together with our new needs, and receive the same from the
+          // other processes in a single exchange. Everything sent has
+          // arrived afterwards, so clear the lists to not send the same
+          // data again in the next round
+          received_cells.clear();
+          send_cells(cells_to_send, new_needs, received_cells, received_needs);
+          cells_to_send.clear();
+          new_needs.clear();
 
           // store received cell_data
           for (typename std::vector<CellData>::const_iterator recv =
@@ -1377,13 +1446,6 @@ namespace FETools
             {
               cell_data_insert(*recv, available_cells);
             }
-
-          // increase the round counter, such that we are sure to only send
-          // and receive data from the correct call
-          ++round;
-
-          // finally send and receive new needs and start a new round
-          send_cells(new_needs, received_needs);
         }
       while (ready != 0);
     }
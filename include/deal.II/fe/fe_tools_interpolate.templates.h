@@ -22,7 +22,9 @@
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -104,39 +106,6 @@ namespace FETools
                       " index sets."));
 #endif
 
-    // allocate vectors at maximal
-    // size. will be reinited in inner
-    // cell, but Vector makes sure that
-    // this does not lead to
-    // reallocation of memory
-    Vector<typename OutVector::value_type> u1_local(
-      dof1.get_fe_collection().max_dofs_per_cell());
-    Vector<typename OutVector::value_type> u2_local(
-      dof2.get_fe_collection().max_dofs_per_cell());
-
-    // have a map for interpolation matrices.
-    // Using a unique_ptr makes sure that the
-    // memory is released again automatically.
-    std::map<const FiniteElement<dim, spacedim> *,
-             std::map<const FiniteElement<dim, spacedim> *,
-                      std::unique_ptr<FullMatrix<double>>>>
-      interpolation_matrices;
-
-    typename DoFHandler<dim, spacedim>::active_cell_iterator
-      cell1 = dof1.begin_active(),
-      endc1 = dof1.end();
-    typename DoFHandler<dim, spacedim>::active_cell_iterator
-      cell2 = dof2.begin_active(),
-      endc2 = dof2.end();
-    (void)endc2;
-
-    std::vector<types::global_dof_index> dofs;
-    dofs.reserve(dof2.get_fe_collection().max_dofs_per_cell());
-
-    u2 = typename OutVector::value_type(0.);
-    OutVector touch_count(u2);
-    touch_count = typename OutVector::value_type(0.);
-
     // for distributed triangulations,
     // we can only interpolate u1 on
     // a cell, which this processor owns,
@@ -144,78 +113,136 @@ namespace FETools
     const types::subdomain_id subdomain_id =
       dof1.get_triangulation().locally_owned_subdomain();
 
-    for (; cell1 != endc1; ++cell1, ++cell2)
-      if ((cell1->subdomain_id() == subdomain_id) ||
-          (subdomain_id == numbers::invalid_subdomain_id))
-        {
-          Assert(cell1->get_fe().n_components() ==
-                   cell2->get_fe().n_components(),
-                 ExcDimensionMismatch(cell1->get_fe().n_components(),
-                                      cell2->get_fe().n_components()));
+    using active_cell_iterator =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+    // compute the interpolation matrices for all pairs of elements that
+    // appear on our cells before the actual work, such that the cell loop
+    // below only reads them and can run in parallel
+    const hp::FECollection<dim, spacedim> &fe_collection1 =
+      dof1.get_fe_collection();
+    const hp::FECollection<dim, spacedim> &fe_collection2 =
+      dof2.get_fe_collection();
+    Table<2, FullMatrix<double>> interpolation_matrices(fe_collection1.size(),
+                                                        fe_collection2.size());
+    {
+      Table<2, bool> fe_pair_used(fe_collection1.size(),
+                                  fe_collection2.size());
+      active_cell_iterator cell1 = dof1.begin_active(), endc1 = dof1.end();
+      active_cell_iterator cell2 = dof2.begin_active(), endc2 = dof2.end();
+      (void)endc2;
+      for (; cell1 != endc1; ++cell1, ++cell2)
+        if ((cell1->subdomain_id() == subdomain_id) ||
+            (subdomain_id == numbers::invalid_subdomain_id))
+          fe_pair_used(cell1->active_fe_index(), cell2->active_fe_index()) =
+            true;
+      // cell1 is at the end, so should
+      // be cell2
+      Assert(cell2 == endc2, ExcInternalError());
+
+      for (unsigned int i = 0; i < fe_collection1.size(); ++i)
+        for (unsigned int j = 0; j < fe_collection2.size(); ++j)
+          if (fe_pair_used(i, j))
+            {
+              interpolation_matrices(i, j).reinit(
+                fe_collection2[j].n_dofs_per_cell(),
+                fe_collection1[i].n_dofs_per_cell());
+              get_interpolation_matrix(fe_collection1[i],
+                                       fe_collection2[j],
+                                       interpolation_matrices(i, j));
+            }
+    }
 
-#ifdef DEBUG
-          // For continuous elements on grids with hanging nodes we need
-          // hanging node constraints. Consequently, when the elements are
-          // continuous no hanging node constraints are allowed.
-          const bool hanging_nodes_not_allowed =
-            ((cell2->get_fe().n_dofs_per_vertex() != 0) &&
-             (constraints.n_constraints() == 0));
+    u2 = typename OutVector::value_type(0.);
+    OutVector touch_count(u2);
+    touch_count = typename OutVector::value_type(0.);
 
-          if (hanging_nodes_not_allowed)
-            for (const unsigned int face : cell1->face_indices())
-              Assert(cell1->at_boundary(face) ||
-                       cell1->neighbor(face)->level() == cell1->level(),
-                     ExcHangingNodesNotAllowed());
-#endif
+    // the local result of one cell, handed from the worker to the copier
+    struct CopyData
+    {
+      std::vector<types::global_dof_index>   dofs;
+      Vector<typename OutVector::value_type> u2_local;
+    };
 
-          const unsigned int dofs_per_cell1 = cell1->get_fe().n_dofs_per_cell();
-          const unsigned int dofs_per_cell2 = cell2->get_fe().n_dofs_per_cell();
-          u1_local.reinit(dofs_per_cell1);
-          u2_local.reinit(dofs_per_cell2);
-
-          // check if interpolation
-          // matrix for this particular
-          // pair of elements is already
-          // there
-          if (interpolation_matrices[&cell1->get_fe()][&cell2->get_fe()]
-                .get() == nullptr)
-            {
-              auto interpolation_matrix =
-                std::make_unique<FullMatrix<double>>(dofs_per_cell2,
-                                                     dofs_per_cell1);
+    // allocate vectors at maximal
+    // size. will be reinited in inner
+    // cell, but Vector makes sure that
+    // this does not lead to
+    // reallocation of memory
+    CopyData copy_data;
+    copy_data.dofs.reserve(fe_collection2.max_dofs_per_cell());
+    copy_data.u2_local.reinit(fe_collection2.max_dofs_per_cell());
+
+    const auto worker = [&](const active_cell_iterator &          cell1,
+                            Vector<typename OutVector::value_type> &u1_local,
+                            CopyData &                              copy_data) {
+      copy_data.dofs.clear();
+      if ((cell1->subdomain_id() != subdomain_id) &&
+          (subdomain_id != numbers::invalid_subdomain_id))
+        return;
 
-              get_interpolation_matrix(cell1->get_fe(),
-                                       cell2->get_fe(),
-                                       *interpolation_matrix);
+      const active_cell_iterator cell2(&dof2.get_triangulation(),
+                                       cell1->level(),
+                                       cell1->index(),
+                                       &dof2);
 
-              interpolation_matrices[&cell1->get_fe()][&cell2->get_fe()] =
-                std::move(interpolation_matrix);
-            }
+      Assert(cell1->get_fe().n_components() ==
+               cell2->get_fe().n_components(),
+             ExcDimensionMismatch(cell1->get_fe().n_components(),
+                                  cell2->get_fe().n_components()));
+
+#ifdef DEBUG
+      // For continuous elements on grids with hanging nodes we need
+      // hanging node constraints. Consequently, when the elements are
+      // continuous no hanging node constraints are allowed.
+      const bool hanging_nodes_not_allowed =
+        ((cell2->get_fe().n_dofs_per_vertex() != 0) &&
+         (constraints.n_constraints() == 0));
+
+      if (hanging_nodes_not_allowed)
+        for (const unsigned int face : cell1->face_indices())
+          Assert(cell1->at_boundary(face) ||
+                   cell1->neighbor(face)->level() == cell1->level(),
+                 ExcHangingNodesNotAllowed());
+#endif
+
+      const unsigned int dofs_per_cell1 = cell1->get_fe().n_dofs_per_cell();
+      const unsigned int dofs_per_cell2 = cell2->get_fe().n_dofs_per_cell();
+      u1_local.reinit(dofs_per_cell1);
+      copy_data.u2_local.reinit(dofs_per_cell2);
 
-          cell1->get_dof_values(u1, u1_local);
-          interpolation_matrices[&cell1->get_fe()][&cell2->get_fe()]->vmult(
-            u2_local, u1_local);
+      cell1->get_dof_values(u1, u1_local);
+      interpolation_matrices(cell1->active_fe_index(),
+                             cell2->active_fe_index())
+        .vmult(copy_data.u2_local, u1_local);
 
-          dofs.resize(dofs_per_cell2);
-          cell2->get_dof_indices(dofs);
+      copy_data.dofs.resize(dofs_per_cell2);
+      cell2->get_dof_indices(copy_data.dofs);
+    };
 
-          for (unsigned int i = 0; i < dofs_per_cell2; ++i)
+    const auto copier = [&](const CopyData &copy_data) {
+      for (unsigned int i = 0; i < copy_data.dofs.size(); ++i)
+        {
+          // if dof is locally_owned
+          const types::global_dof_index gdi = copy_data.dofs[i];
+          if (u2_elements.is_element(gdi))
             {
-              // if dof is locally_owned
-              const types::global_dof_index gdi = dofs[i];
-              if (u2_elements.is_element(gdi))
-                {
-                  ::dealii::internal::ElementAccess<OutVector>::add(u2_local(i),
-                                                                    dofs[i],
-                                                                    u2);
-                  ::dealii::internal::ElementAccess<OutVector>::add(
-                    1, dofs[i], touch_count);
-                }
+              ::dealii::internal::ElementAccess<OutVector>::add(
+                copy_data.u2_local(i), gdi, u2);
+              ::dealii::internal::ElementAccess<OutVector>::add(1,
+                                                                gdi,
+                                                                touch_count);
             }
         }
-    // cell1 is at the end, so should
-    // be cell2
-    Assert(cell2 == endc2, ExcInternalError());
+    };
+
+    WorkStream::run(dof1.begin_active(),
+                    static_cast<active_cell_iterator>(dof1.end()),
+                    worker,
+                    copier,
+                    Vector<typename OutVector::value_type>(
+                      fe_collection1.max_dofs_per_cell()),
+                    copy_data);
 
     u2.compress(VectorOperation::add);
     touch_count.compress(VectorOperation::add);
@@ -231,23 +258,22 @@ namespace FETools
     // for parallel vectors check,
     // if this component is owned by
     // this processor.
-    for (types::global_dof_index i = 0; i < dof2.n_dofs(); ++i)
-      if (locally_owned_dofs.is_element(i))
-        {
-          Assert(static_cast<typename OutVector::value_type>(
-                   ::dealii::internal::ElementAccess<OutVector>::get(
-                     touch_count, i)) != typename OutVector::value_type(0),
-                 ExcInternalError());
-
-
-          const typename OutVector::value_type val =
-            ::dealii::internal::ElementAccess<OutVector>::get(u2, i);
-          ::dealii::internal::ElementAccess<OutVector>::set(
-            val /
-              ::dealii::internal::ElementAccess<OutVector>::get(touch_count, i),
-            i,
-            u2);
-        }
+    for (const types::global_dof_index i : locally_owned_dofs)
+      {
+        Assert(static_cast<typename OutVector::value_type>(
+                 ::dealii::internal::ElementAccess<OutVector>::get(
+                   touch_count, i)) != typename OutVector::value_type(0),
+               ExcInternalError());
+
+
+        const typename OutVector::value_type val =
+          ::dealii::internal::ElementAccess<OutVector>::get(u2, i);
+        ::dealii::internal::ElementAccess<OutVector>::set(
+          val /
+            ::dealii::internal::ElementAccess<OutVector>::get(touch_count, i),
+          i,
+          u2);
+      }
 
     // finish the work on parallel vectors
     u2.compress(VectorOperation::insert);
@@ -285,63 +311,97 @@ namespace FETools
                       " index sets."));
 #endif
 
-    Vector<typename OutVector::value_type> u1_local(
-      dof1.get_fe_collection().max_dofs_per_cell());
-    Vector<typename OutVector::value_type> u1_int_local(
-      dof1.get_fe_collection().max_dofs_per_cell());
-
     const types::subdomain_id subdomain_id =
       dof1.get_triangulation().locally_owned_subdomain();
 
-    typename DoFHandler<dim, spacedim>::active_cell_iterator
-      cell = dof1.begin_active(),
-      endc = dof1.end();
+    using active_cell_iterator =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator;
 
-    // map from possible FE objects in
-    // dof1 to the back_interpolation
-    // matrices
-    std::map<const FiniteElement<dim> *, std::unique_ptr<FullMatrix<double>>>
-      interpolation_matrices;
+    // the back_interpolation matrices of all FE objects in dof1, computed
+    // up front for the elements used on our cells, such that the cell
+    // loop below only reads them and can run in parallel
+    const hp::FECollection<dim, spacedim> &fe_collection =
+      dof1.get_fe_collection();
+    std::vector<FullMatrix<double>> interpolation_matrices(
+      fe_collection.size());
+    {
+      std::vector<bool> fe_used(fe_collection.size(), false);
+      for (const auto &cell : dof1.active_cell_iterators())
+        if ((cell->subdomain_id() == subdomain_id) ||
+            (subdomain_id == numbers::invalid_subdomain_id))
+          fe_used[cell->active_fe_index()] = true;
+
+      for (unsigned int i = 0; i < fe_collection.size(); ++i)
+        if (fe_used[i])
+          {
+            const unsigned int dofs_per_cell =
+              fe_collection[i].n_dofs_per_cell();
+            interpolation_matrices[i].reinit(dofs_per_cell, dofs_per_cell);
+            get_back_interpolation_matrix(fe_collection[i],
+                                          fe2,
+                                          interpolation_matrices[i]);
+          }
+    }
 
-    for (; cell != endc; ++cell)
-      if ((cell->subdomain_id() == subdomain_id) ||
-          (subdomain_id == numbers::invalid_subdomain_id))
-        {
-#ifdef DEBUG
-          // For continuous elements on grids with hanging nodes we need
-          // hanging node constraints. Consequently, when the elements are
-          // continuous no hanging node constraints are allowed.
-          const bool hanging_nodes_not_allowed =
-            (cell->get_fe().n_dofs_per_vertex() != 0) ||
-            (fe2.n_dofs_per_vertex() != 0);
+    // the local result of one cell, handed from the worker to the copier
+    struct CopyData
+    {
+      bool                                   is_locally_owned;
+      active_cell_iterator                   cell;
+      Vector<typename OutVector::value_type> u1_int_local;
+    };
+
+    const auto worker = [&](const active_cell_iterator &          cell,
+                            Vector<typename OutVector::value_type> &u1_local,
+                            CopyData &                              copy_data) {
+      copy_data.is_locally_owned =
+        (cell->subdomain_id() == subdomain_id) ||
+        (subdomain_id == numbers::invalid_subdomain_id);
+      if (copy_data.is_locally_owned == false)
+        return;
 
-          if (hanging_nodes_not_allowed)
-            for (const unsigned int face : cell->face_indices())
-              Assert(cell->at_boundary(face) ||
-                       cell->neighbor(face)->level() == cell->level(),
-                     ExcHangingNodesNotAllowed());
+#ifdef DEBUG
+      // For continuous elements on grids with hanging nodes we need
+      // hanging node constraints. Consequently, when the elements are
+      // continuous no hanging node constraints are allowed.
+      const bool hanging_nodes_not_allowed =
+        (cell->get_fe().n_dofs_per_vertex() != 0) ||
+        (fe2.n_dofs_per_vertex() != 0);
+
+      if (hanging_nodes_not_allowed)
+        for (const unsigned int face : cell->face_indices())
+          Assert(cell->at_boundary(face) ||
+                   cell->neighbor(face)->level() == cell->level(),
+                 ExcHangingNodesNotAllowed());
 #endif
 
-          const unsigned int dofs_per_cell1 = cell->get_fe().n_dofs_per_cell();
-
-          // make sure back_interpolation matrix is available
-          if (interpolation_matrices[&cell->get_fe()] == nullptr)
-            {
-              interpolation_matrices[&cell->get_fe()] =
-                std::make_unique<FullMatrix<double>>(dofs_per_cell1,
-                                                     dofs_per_cell1);
-              get_back_interpolation_matrix(
-                cell->get_fe(), fe2, *interpolation_matrices[&cell->get_fe()]);
-            }
-
-          u1_local.reinit(dofs_per_cell1);
-          u1_int_local.reinit(dofs_per_cell1);
-
-          cell->get_dof_values(u1, u1_local);
-          interpolation_matrices[&cell->get_fe()]->vmult(u1_int_local,
-                                                         u1_local);
-          cell->set_dof_values(u1_int_local, u1_interpolated);
-        };
+      const unsigned int dofs_per_cell1 = cell->get_fe().n_dofs_per_cell();
+
+      u1_local.reinit(dofs_per_cell1);
+      copy_data.u1_int_local.reinit(dofs_per_cell1);
+
+      cell->get_dof_values(u1, u1_local);
+      interpolation_matrices[cell->active_fe_index()].vmult(
+        copy_data.u1_int_local, u1_local);
+      copy_data.cell = cell;
+    };
+
+    const auto copier = [&](const CopyData &copy_data) {
+      if (copy_data.is_locally_owned)
+        copy_data.cell->set_dof_values(copy_data.u1_int_local,
+                                       u1_interpolated);
+    };
+
+    CopyData copy_data;
+    copy_data.u1_int_local.reinit(fe_collection.max_dofs_per_cell());
+
+    WorkStream::run(dof1.begin_active(),
+                    static_cast<active_cell_iterator>(dof1.end()),
+                    worker,
+                    copier,
+                    Vector<typename OutVector::value_type>(
+                      fe_collection.max_dofs_per_cell()),
+                    copy_data);
 
     // if we work on a parallel vector, we have to finish the work
     u1_interpolated.compress(VectorOperation::insert);
@@ -433,6 +433,42 @@ namespace FEValuesViews
         typename OutputType<typename InputVector::value_type>::gradient_type>
         &gradients) const;
 
+    /**
+     * Return the values of the selected scalar component of several finite
+     * element functions, e.g. the current and the old solution, at the
+     * quadrature points of the current cell, face or subface. This is
+     * equivalent to calling get_function_values() for each of the vectors in
+     * @p fe_functions, but the shape function data of each shape function is
+     * only loaded once for all vectors.
+     *
+     * The output argument @p values must have as many entries as there are
+     * vectors in @p fe_functions, each with as many entries as there are
+     * quadrature points.
+     *
+     * @dealiiRequiresUpdateFlags{update_values}
+     */
+    template <class InputVector>
+    void
+    get_function_values_of_vectors(
+      const std::vector<const InputVector *> &fe_functions,
+      std::vector<std::vector<typename ProductType<
+        value_type,
+        typename InputVector::value_type>::type>> &values) const;
+
+    /**
+     * This function relates to get_function_gradients() in the same way as
+     * get_function_values_of_vectors() relates to get_function_values().
+     *
+     * @dealiiRequiresUpdateFlags{update_gradients}
+     */
+    template <class InputVector>
+    void
+    get_function_gradients_of_vectors(
+      const std::vector<const InputVector *> &fe_functions,
+      std::vector<std::vector<typename ProductType<
+        gradient_type,
+        typename InputVector::value_type>::type>> &gradients) const;
+
     /**
      * Return the Hessians of the selected scalar component of the finite
      * element function characterized by <tt>fe_function</tt> at the
@@ -570,6 +606,14 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions that may be nonzero in the selected
+     * component. For vector-valued elements with many components, this is
+     * only a small subset of all shape functions, and the evaluation of
+     * finite element fields only runs over this subset.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -1025,6 +1069,42 @@ namespace FEValuesViews
         typename OutputType<typename InputVector::value_type>::gradient_type>
         &gradients) const;
 
+    /**
+     * Return the values of the selected vector components of several finite
+     * element functions, e.g. the current and the old solution, at the
+     * quadrature points of the current cell, face or subface. This is
+     * equivalent to calling get_function_values() for each of the vectors in
+     * @p fe_functions, but the shape function data of each shape function is
+     * only loaded once for all vectors.
+     *
+     * The output argument @p values must have as many entries as there are
+     * vectors in @p fe_functions, each with as many entries as there are
+     * quadrature points.
+     *
+     * @dealiiRequiresUpdateFlags{update_values}
+     */
+    template <class InputVector>
+    void
+    get_function_values_of_vectors(
+      const std::vector<const InputVector *> &fe_functions,
+      std::vector<std::vector<typename ProductType<
+        value_type,
+        typename InputVector::value_type>::type>> &values) const;
+
+    /**
+     * This function relates to get_function_gradients() in the same way as
+     * get_function_values_of_vectors() relates to get_function_values().
+     *
+     * @dealiiRequiresUpdateFlags{update_gradients}
+     */
+    template <class InputVector>
+    void
+    get_function_gradients_of_vectors(
+      const std::vector<const InputVector *> &fe_functions,
+      std::vector<std::vector<typename ProductType<
+        gradient_type,
+        typename InputVector::value_type>::type>> &gradients) const;
+
     /**
      * Return the symmetrized gradients of the selected vector components of
      * the finite element function characterized by <tt>fe_function</tt> at
@@ -1283,6 +1363,13 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions that may be nonzero in at least one
+     * of the selected components. The evaluation of finite element fields
+     * only runs over this subset of the shape functions.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/function.h>
+#include <deal.II/base/index_set.h>
 #include <deal.II/base/mg_level_object.h>
 
 #include <deal.II/fe/mapping_q_generic.h>
@@ -56,8 +57,15 @@ public:
    * Constructor. @p polynomial_degree denotes the polynomial degree of the
    * polynomials that are used to map cells from the reference to the real
    * cell.
+   *
+   * If @p store_support_points_in_float is set to true, the cached support
+   * points are stored in single precision, which halves the memory
+   * consumption of the cache. The points are converted back to double
+   * precision when used by the mapping, i.e., the geometry is only
+   * represented with a relative accuracy of around $10^{-7}$.
    */
-  explicit MappingQCache(const unsigned int polynomial_degree);
+  explicit MappingQCache(const unsigned int polynomial_degree,
+                         const bool store_support_points_in_float = false);
 
   /**
    * Copy constructor.
@@ -203,6 +211,32 @@ public:
              const MGLevelObject<VectorType> &vectors,
              const bool vector_describes_relative_displacement);
 
+  /**
+   * Update the data cache of the active cells after a change of the
+   * discrete field @p vector that has previously been passed to the
+   * initialize() function with the same @p mapping, @p dof_handler and @p
+   * vector_describes_relative_displacement arguments. Only the support
+   * points of the cells with at least one dof in @p changed_dofs are
+   * recomputed, which is much cheaper than a full initialization when only
+   * a part of the mesh moves.
+   *
+   * The index set @p changed_dofs needs to contain all locally owned dofs
+   * whose value has changed since the last call to initialize() or
+   * update(); the information is exchanged between the processes to also
+   * update the ghost cells.
+   *
+   * @note The cache is invalidated upon the signal
+   * Triangulation::Signals::any_change of the underlying triangulation, in
+   * which case the data needs to be computed anew by initialize().
+   */
+  template <typename VectorType>
+  void
+  update(const Mapping<dim, spacedim> &   mapping,
+         const DoFHandler<dim, spacedim> &dof_handler,
+         const VectorType &               vector,
+         const IndexSet &                 changed_dofs,
+         const bool vector_describes_relative_displacement);
+
   /**
    * Return the memory consumption (in bytes) of the cache.
    */
@@ -219,6 +253,41 @@ protected:
     const override;
 
 private:
+  /**
+   * Compute the support points of all cells of the given triangulation for
+   * which @p cell_needs_update returns true (or of all cells if it is
+   * empty) with the function @p compute_points_on_cell and store them in
+   * the cache. The work is distributed among the available threads.
+   */
+  void
+  fill_support_point_cache(
+    const Triangulation<dim, spacedim> &triangulation,
+    const std::function<std::vector<Point<spacedim>>(
+      const typename Triangulation<dim, spacedim>::cell_iterator &)>
+      &compute_points_on_cell,
+    const std::function<
+      bool(const typename Triangulation<dim, spacedim>::cell_iterator &)>
+      &cell_needs_update);
+
+  /**
+   * Implementation of the initialize() and update() functions for a
+   * discrete field. If @p changed_dofs is a nullptr, all cells are
+   * computed, otherwise only the ones with dofs in the given set.
+   */
+  template <typename VectorType>
+  void
+  initialize_from_vector(const Mapping<dim, spacedim> &   mapping,
+                         const DoFHandler<dim, spacedim> &dof_handler,
+                         const VectorType &               vector,
+                         const bool      vector_describes_relative_displacement,
+                         const IndexSet *changed_dofs);
+
+  /**
+   * Whether the support points are stored in single precision in
+   * support_point_cache_float rather than in support_point_cache.
+   */
+  const bool store_support_points_in_float;
+
   /**
    * The point cache filled upon calling initialize(). It is made a shared
    * pointer to allow several instances (created via clone()) to share this
@@ -227,6 +296,14 @@ private:
   std::shared_ptr<std::vector<std::vector<std::vector<Point<spacedim>>>>>
     support_point_cache;
 
+  /**
+   * The same as support_point_cache, but with the points stored in single
+   * precision. Only used if store_support_points_in_float is set.
+   */
+  std::shared_ptr<
+    std::vector<std::vector<std::vector<Point<spacedim, float>>>>>
+    support_point_cache_float;
+
   /**
    * The connection to Triangulation::signals::any that must be reset once
    * this class goes out of scope.
@@ -248,6 +248,11 @@ public:
    * function. The types `Number` and `Number2` of the input and output arrays
    * must be such that `Number2 = apply_transformation(DerivativeForm<1,
    * spacedim, dim>, Number)`.
+   *
+   * If @p apply_transpose is set to true, the transpose of the transformation
+   * is applied instead. This is needed when integrating against gradients of
+   * test functions, where a quantity given in real coordinates needs to be
+   * expressed with respect to the reference coordinates.
    */
   template <typename Number, typename Number2>
   void
@@ -256,7 +261,8 @@ public:
     const MappingKind                                           kind,
     const ArrayView<const Point<dim>> &                         unit_points,
     const ArrayView<const Number> &                             input,
-    const ArrayView<Number2> &                                  output) const;
+    const ArrayView<Number2> &                                  output,
+    const bool apply_transpose = false) const;
 
   /**
    * @}
@@ -939,7 +945,8 @@ MappingQGeneric<dim, spacedim>::transform_variable(
   const MappingKind                                           kind,
   const ArrayView<const Point<dim>> &                         unit_points,
   const ArrayView<const Number> &                             input,
-  const ArrayView<Number2> &                                  output) const
+  const ArrayView<Number2> &                                  output,
+  const bool apply_transpose) const
 {
   AssertDimension(unit_points.size(), output.size());
   AssertDimension(unit_points.size(), input.size());
@@ -984,7 +991,10 @@ MappingQGeneric<dim, spacedim>::transform_variable(
             for (unsigned int d = 0; d < spacedim; ++d)
               for (unsigned int e = 0; e < dim; ++e)
                 jac_j[d][e] = jac[d][e][j];
-            output[i + j] = apply_transformation(jac_j, input[i + j]);
+            output[i + j] =
+              apply_transpose ?
+                apply_transformation(jac_j.transpose(), input[i + j]) :
+                apply_transformation(jac_j, input[i + j]);
           }
       }
     else
@@ -997,8 +1007,11 @@ MappingQGeneric<dim, spacedim>::transform_variable(
             polynomial_degree == 1,
             renumber_lexicographic_to_hierarchic)
             .second;
-        output[i] =
-          apply_transformation(grad.transpose().covariant_form(), input[i]);
+        const DerivativeForm<1, spacedim, dim> jac =
+          grad.transpose().covariant_form();
+        output[i] = apply_transpose ?
+                      apply_transformation(jac.transpose(), input[i]) :
+                      apply_transformation(jac, input[i]);
       }
 }
 
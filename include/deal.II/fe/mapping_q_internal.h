@@ -1247,6 +1247,51 @@ namespace internal
     }
 
 
+
+    /**
+     * Check whether the mapping described by the given support points is an
+     * affine transformation $\mathbf x = \mathbf A \hat{\mathbf x} +
+     * \mathbf b$ of the reference cell, i.e., whether all support points
+     * coincide (up to roundoff) with the affine image of their reference
+     * location. The affine transformation is constructed from the vertices
+     * which come first in the hierarchical numbering of the support points.
+     * If the check succeeds, @p A and @p b are set and the function returns
+     * true.
+     */
+    template <int dim, int spacedim>
+    inline bool
+    compute_affine_transformation(
+      const std::vector<Point<spacedim>> &support_points,
+      const std::vector<Point<dim>> &     unit_support_points,
+      DerivativeForm<1, dim, spacedim> &  A,
+      Point<spacedim> &                   b)
+    {
+      AssertDimension(support_points.size(), unit_support_points.size());
+      Assert(support_points.size() >= GeometryInfo<dim>::vertices_per_cell,
+             ExcInternalError());
+
+      b            = support_points[0];
+      double scale = 0.;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const Tensor<1, spacedim> column = support_points[1U << d] - b;
+          for (unsigned int e = 0; e < spacedim; ++e)
+            A[e][d] = column[e];
+          scale += column.norm();
+        }
+
+      const double tolerance = 1e-12 * scale;
+      for (unsigned int i = 1; i < support_points.size(); ++i)
+        if ((support_points[i] - b -
+             apply_transformation(A, Tensor<1, dim>(unit_support_points[i])))
+              .norm() > tolerance)
+          return false;
+
+      return true;
+    }
+
+
+
     /**
      * Compute the locations of quadrature points on the object described by
      * the first argument (and the cell for which the mapping support points
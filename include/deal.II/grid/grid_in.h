@@ -428,6 +428,23 @@ public:
   void
   read_vtu(std::istream &in);
 
+  /**
+   * Read a triangulation written by GridOut::write_compact_binary(), e.g.,
+   * to restart a computation. The coarse mesh is created directly from the
+   * stored cells, without calling GridReordering (the cells were already
+   * consistently oriented when they were written), and the refinement tree
+   * is then rebuilt level by level. Finally, the locations of all vertices
+   * as well as all material, boundary and manifold ids are restored.
+   *
+   * The triangulation has to be empty, and should use the same mesh
+   * smoothing flags as the triangulation that was written, since
+   * additional refinement introduced by the smoothing would change the
+   * stored refinement tree. Manifold objects have to be attached after this
+   * function has returned.
+   */
+  void
+  read_compact_binary(std::istream &in);
+
 
   /**
    * Read grid data from an unv file as generated by the Salome mesh
@@ -516,6 +533,11 @@ public:
    * and other whitespace. Therefore, deal.II will be able to read files in a
    * slightly more general format than %Gmsh.
    *
+   * @note Files of version 4.1 may also be stored in the binary variant of
+   * the format (as written by %Gmsh with "Mesh.Binary = 1"), which is
+   * considerably faster to read for large meshes. In that case, @p in has to
+   * be opened in binary mode.
+   *
    * @ingroup simplex
    */
   void
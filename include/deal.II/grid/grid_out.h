@@ -1341,6 +1341,25 @@ public:
   void
   write_vtu(const Triangulation<dim, spacedim> &tria, std::ostream &out) const;
 
+  /**
+   * Write the triangulation in a compact, versioned binary format that can
+   * be read back with GridIn::read_compact_binary(). In contrast to the
+   * other output formats, this format is not meant for visualization but to
+   * restart a computation quickly: it stores the coarse mesh, the
+   * refinement tree (including anisotropic refinement), the locations of
+   * all vertices, as well as the material, boundary and manifold ids of all
+   * cells, faces and edges. The manifold objects themselves are not stored
+   * and have to be attached again after reading.
+   *
+   * The data is stored as raw bytes in the native endianness of the
+   * machine, so the file can only be read on machines with the same byte
+   * order. @p out should be opened in binary mode.
+   */
+  template <int dim, int spacedim>
+  void
+  write_compact_binary(const Triangulation<dim, spacedim> &tria,
+                       std::ostream &                      out) const;
+
   /**
    * Write triangulation in VTU format for each processor, and add a .pvtu file
    * for visualization in VisIt or Paraview that describes the collection of VTU
@@ -2195,6 +2195,37 @@ namespace GridTools
                                  Triangulation<dim, spacedim> &triangulation,
                                  const bool group_siblings = true);
 
+  /**
+   * Generate a partitioning of the active cells of @p triangulation by
+   * sorting them along a Hilbert space filling curve through their centers
+   * and cutting the resulting sequence into @p n_partitions contiguous
+   * pieces of (approximately) equal weight. After calling this function,
+   * the subdomain ids of all active cells will have values between zero
+   * and @p n_partitions-1.
+   *
+   * In contrast to partition_triangulation(), no cell connectivity graph
+   * needs to be built and no external partitioner is called, and in
+   * contrast to partition_triangulation_zorder() the ordering does not
+   * depend on the coarse mesh: the curve runs through the bounding box of
+   * all active cells, so that also meshes consisting of many coarse cells
+   * (e.g., read from a file) are split into compact pieces. The cost of
+   * the function is dominated by sorting the active cells, i.e., it is
+   * $O(N \log N)$ in the number of active cells.
+   *
+   * If a function is attached to the Triangulation::Signals::cell_weight
+   * signal, the weights it returns are used to balance the partitions;
+   * otherwise, every cell has the same weight.
+   *
+   * @note Since only the cell centers enter the ordering, the partitions
+   * generated by this function are typically less compact than those
+   * generated by a graph partitioner, but can be computed considerably
+   * faster for large meshes.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int            n_partitions,
+                                  Triangulation<dim, spacedim> &triangulation);
+
   /**
    * Partitions the cells of a multigrid hierarchy by assigning level subdomain
    * ids using the "youngest child" rule, that is, each cell in the hierarchy is
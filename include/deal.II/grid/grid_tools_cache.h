@@ -35,6 +35,8 @@
 #include <boost/signals2.hpp>
 
 #include <cmath>
+#include <set>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -60,6 +62,25 @@ namespace GridTools
    * some vertex locations, then some of the structures in this class become
    * obsolete, and you will have to mark them as outdated, by calling the
    * method mark_for_update() manually.
+   *
+   * When the triangulation is refined or coarsened, the used vertices, the
+   * RTree of used vertices, and the RTrees of cell bounding boxes that have
+   * already been built are not thrown away. Instead, the entries of the
+   * cells that disappear are removed right away (using the
+   * Triangulation::Signals::pre_coarsening_on_cell and
+   * Triangulation::Signals::post_refinement_on_cell signals), and the
+   * entries of the new cells are added the next time one of these objects
+   * is requested. This makes refining or coarsening a small fraction of the
+   * cells considerably cheaper than rebuilding these objects from scratch.
+   * All other cached objects are recomputed after any change of the
+   * triangulation. For parallel triangulations, the RTree of locally owned
+   * cells is always recomputed, since the ownership of cells may change
+   * during refinement.
+   *
+   * Similarly, if only some cells have moved, for example because a
+   * MappingQCache was updated for a part of the mesh, the function
+   * mark_cells_for_update() can be used to refresh the entries of these
+   * cells only.
    */
   template <int dim, int spacedim = dim>
   class Cache : public Subscriptor
@@ -97,6 +118,27 @@ namespace GridTools
     void
     mark_for_update(const CacheUpdateFlags &flags = update_all);
 
+    /**
+     * Make sure that the geometric information associated with the given
+     * @p cells (their bounding boxes and the locations of their vertices) is
+     * recomputed during subsequent calls to the `get_*` functions defined in
+     * this class, while the information of all other cells is kept.
+     *
+     * Use this function instead of mark_for_update() if only a few cells of
+     * the triangulation have moved, for example because the mapping passed
+     * to the constructor is a MappingQCache that has been updated for these
+     * cells only. Objects that depend on the geometry but can not be updated
+     * cell by cell, such as the covering RTree and the vertex to cell center
+     * directions, are marked for a complete update.
+     *
+     * @note The entries of the moved cells are found by a single traversal
+     * of the cached RTrees, so the cost of this function is independent of
+     * the cost of evaluating the mapping on the cells that have not moved.
+     */
+    void
+    mark_cells_for_update(
+      const std::vector<
+        typename Triangulation<dim, spacedim>::active_cell_iterator> &cells);
 
     /**
      * Return the cached vertex_to_cell_map as computed by
@@ -208,11 +250,64 @@ namespace GridTools
     get_covering_rtree(const unsigned int level = 0) const;
 
   private:
+    /**
+     * Add the entries of the cells stored in cells_to_add to the objects
+     * listed in incremental_update_flags, and remove the vertices that are no
+     * longer used if prune_used_vertices is set.
+     */
+    void
+    apply_incremental_updates() const;
+
+    /**
+     * Remove the entry of @p cell from the RTrees of cell bounding boxes
+     * listed in incremental_update_flags. If an entry can not be found, the
+     * corresponding RTree is marked for a complete update instead.
+     */
+    void
+    remove_from_cell_rtrees(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Return whether @p cell or one of its ancestors is stored in
+     * cells_to_add, i.e., whether the entries of @p cell have not been added
+     * to the cached objects yet.
+     */
+    bool
+    is_scheduled_for_addition(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
     /**
      * Keep track of what needs to be updated next.
      */
     mutable CacheUpdateFlags update_flags;
 
+    /**
+     * The cached objects that are valid up to the changes recorded in
+     * cells_to_add and prune_used_vertices.
+     */
+    mutable CacheUpdateFlags incremental_update_flags;
+
+    /**
+     * Cells whose entries, or those of their active descendants, have not
+     * yet been added to the objects listed in incremental_update_flags.
+     */
+    mutable std::set<typename Triangulation<dim, spacedim>::cell_iterator>
+      cells_to_add;
+
+    /**
+     * Whether the cached used vertices may contain vertices that are no
+     * longer used by the triangulation.
+     */
+    mutable bool prune_used_vertices;
+
+    /**
+     * Whether the triangulation is currently being refined or coarsened,
+     * i.e., whether the Triangulation::Signals::pre_refinement signal has
+     * been triggered but the subsequent
+     * Triangulation::Signals::any_change signal has not.
+     */
+    bool refinement_in_progress;
+
     /**
      * A pointer to the Triangulation.
      */
@@ -288,9 +383,9 @@ namespace GridTools
     mutable std::vector<std::set<unsigned int>> vertex_to_neighbor_subdomain;
 
     /**
-     * Storage for the status of the triangulation signal.
+     * Storage for the status of the triangulation signals.
      */
-    boost::signals2::connection tria_signal;
+    std::vector<boost::signals2::connection> tria_signals;
   };
 
 
@@ -2836,6 +2836,42 @@ public:
   IteratorRange<active_cell_iterator>
   active_cell_iterators() const;
 
+  /**
+   * Return an iterator to the active cell whose
+   * CellAccessor::active_cell_index() equals @p active_cell_index.
+   *
+   * Advancing an active cell iterator needs to skip over all inactive cells
+   * in between, which involves several dependent memory accesses per step.
+   * This function instead looks up the level and index of the cell in an
+   * array that the triangulation keeps up to date upon creation and
+   * refinement, and thus has constant cost. Loops over the active cells can
+   * therefore be split into ranges of active cell indices without first
+   * collecting iterators in a vector, e.g., to work on them with several
+   * threads:
+   * @code
+   *   parallel::apply_to_subranges(
+   *     0U,
+   *     triangulation.n_active_cells(),
+   *     [&](const unsigned int begin, const unsigned int end) {
+   *       for (unsigned int i = begin; i < end; ++i)
+   *         {
+   *           const auto cell = triangulation.get_active_cell_iterator(i);
+   *           ...
+   *         }
+   *     },
+   *     64);
+   * @endcode
+   */
+  active_cell_iterator
+  get_active_cell_iterator(const unsigned int active_cell_index) const;
+
+  /**
+   * Return the level and the index within the level of all active cells,
+   * ordered by their active cell index. See get_active_cell_iterator().
+   */
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  get_active_cell_levels_and_indices() const;
+
   /**
    * Return an iterator range that contains all cells (active or not) that
    * make up the given level of this triangulation. Such a range is useful to
@@ -3971,6 +4007,14 @@ private:
     std::unique_ptr<dealii::internal::TriangulationImplementation::TriaLevel>>
     levels;
 
+  /**
+   * The level and the index within the level of all active cells, in the
+   * order of their active cell index. This array is filled by
+   * reset_active_cell_indices().
+   */
+  std::vector<std::pair<unsigned int, unsigned int>>
+    active_cell_levels_and_indices;
+
   /**
    * Pointer to the faces of the triangulation. In 1d this contains nothing,
    * in 2D it contains data concerning lines and in 3D quads and lines.  All
@@ -1693,7 +1693,10 @@ void *
 TriaAccessor<structdim, dim, spacedim>::user_pointer() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_pointer(this->present_index);
+  // use the read-only access, which does not need to allocate the user data
+  const dealii::internal::TriangulationImplementation::TriaObjects &objects =
+    this->objects();
+  return const_cast<void *>(objects.user_pointer(this->present_index));
 }
 
 
@@ -1750,7 +1753,10 @@ unsigned int
 TriaAccessor<structdim, dim, spacedim>::user_index() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_index(this->present_index);
+  // use the read-only access, which does not need to allocate the user data
+  const dealii::internal::TriangulationImplementation::TriaObjects &objects =
+    this->objects();
+  return objects.user_index(this->present_index);
 }
 
 
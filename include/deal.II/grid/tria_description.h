@@ -490,6 +490,54 @@ namespace TriangulationDescription
       const TriangulationDescription::Settings setting =
         TriangulationDescription::Settings::default_setting);
 
+
+    /**
+     * Construct a TriangulationDescription::Description of the coarse mesh
+     * that GridGenerator::subdivided_hyper_rectangle() would create, without
+     * ever building the serial mesh. In contrast to the functions above, each
+     * process only generates the cells it owns and one layer of ghost cells
+     * around them, so that the memory consumption and the run time per
+     * process are proportional to the size of the local partition and not to
+     * the size of the global mesh. This makes it possible to set up
+     * parallel::fullydistributed::Triangulation objects with billions of
+     * coarse cells.
+     *
+     * The cells are partitioned along a Morton (Z-order) space-filling curve
+     * through the box, which is cut into contiguous pieces of (almost) equal
+     * length, one per process. The position of a cell along this curve is
+     * used as its
+     * @ref GlossCoarseCellId.
+     * The vertex positions, the boundary ids and, if @p colorize is set, the
+     * material ids are the same as in
+     * GridGenerator::subdivided_hyper_rectangle().
+     *
+     * @param repetitions Number of cells in each coordinate direction.
+     * @param p1 First corner point of the box.
+     * @param p2 Second corner point of the box, opposite to @p p1.
+     * @param colorize Assign different boundary and material ids, see
+     *   GridGenerator::subdivided_hyper_rectangle().
+     * @param comm MPI communicator.
+     * @param smoothing Mesh smoothing type.
+     * @param settings See the description of the Settings enumerator.
+     * @return Description to be used to set up a Triangulation.
+     *
+     * @note If construct_multigrid_hierarchy is set in the settings, the
+     *   @p smoothing parameter is extended with the
+     *   limit_level_difference_at_vertices flag.
+     */
+    template <int dim>
+    Description<dim, dim>
+    create_description_for_subdivided_hyper_rectangle(
+      const std::vector<unsigned int> &repetitions,
+      const Point<dim> &               p1,
+      const Point<dim> &               p2,
+      const bool                       colorize,
+      const MPI_Comm &                 comm,
+      const typename Triangulation<dim, dim>::MeshSmoothing smoothing =
+        dealii::Triangulation<dim, dim>::none,
+      const TriangulationDescription::Settings settings =
+        TriangulationDescription::Settings::default_setting);
+
   } // namespace Utilities
 
 
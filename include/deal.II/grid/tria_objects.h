@@ -21,6 +21,7 @@
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/thread_management.h>
 
 #include <vector>
 
@@ -224,7 +225,8 @@ namespace internal
                     const unsigned int                  level);
 
       /**
-       * Access to user pointers.
+       * Access to user pointers. This allocates the user data, see the
+       * documentation of the member variable #user_data.
        */
       void *&
       user_pointer(const unsigned int i);
@@ -236,7 +238,8 @@ namespace internal
       user_pointer(const unsigned int i) const;
 
       /**
-       * Access to user indices.
+       * Access to user indices. This allocates the user data, see the
+       * documentation of the member variable #user_data.
        */
       unsigned int &
       user_index(const unsigned int i);
@@ -356,9 +359,28 @@ namespace internal
       /**
        * Pointer which is not used by the library but may be accessed and set
        * by the user to handle data local to a line/quad/etc.
+       *
+       * Since many programs never use the user data, but it would take eight
+       * bytes per object otherwise, this field is only allocated upon the
+       * first write access through the non-const versions of user_pointer()
+       * and user_index(). As long as it is empty, all user pointers and
+       * indices are zero, i.e., read access does not need to allocate it.
+       * Once allocated, it is resized together with the other fields.
        */
       std::vector<UserData> user_data;
 
+      /**
+       * Mutex guarding the allocation of #user_data, since the first write
+       * access might happen concurrently on different objects.
+       */
+      mutable Threads::Mutex user_data_mutex;
+
+      /**
+       * Allocate #user_data if this has not happened yet.
+       */
+      void
+      allocate_user_data();
+
       /**
        * In order to avoid confusion between user pointers and indices, this
        * enum is set by the first function accessing either and subsequent
@@ -448,6 +470,18 @@ namespace internal
     }
 
 
+    inline void
+    TriaObjects::allocate_user_data()
+    {
+      if (user_data.empty())
+        {
+          std::lock_guard<std::mutex> lock(user_data_mutex);
+          if (user_data.empty())
+            user_data.resize(n_objects());
+        }
+    }
+
+
     inline void *&
     TriaObjects::user_pointer(const unsigned int i)
     {
@@ -455,6 +489,7 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
+      allocate_user_data();
       AssertIndexRange(i, user_data.size());
       return user_data[i].p;
     }
@@ -467,6 +502,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
+      if (user_data.empty())
+        return nullptr;
+
       AssertIndexRange(i, user_data.size());
       return user_data[i].p;
     }
@@ -479,6 +517,7 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
+      allocate_user_data();
       AssertIndexRange(i, user_data.size());
       return user_data[i].i;
     }
@@ -487,6 +526,9 @@ namespace internal
     inline void
     TriaObjects::clear_user_data(const unsigned int i)
     {
+      if (user_data.empty())
+        return;
+
       AssertIndexRange(i, user_data.size());
       user_data[i].i = 0;
     }
@@ -517,6 +559,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
+      if (user_data.empty())
+        return 0;
+
       AssertIndexRange(i, user_data.size());
       return user_data[i].i;
     }
@@ -18,12 +18,16 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/thread_management.h>
+
 #include <deal.II/fe/component_mask.h>
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_values_extractors.h>
 
 #include <deal.II/hp/collection.h>
 
+#include <array>
+#include <map>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -281,6 +285,80 @@ namespace hp
     bool
     hp_constraints_are_implemented() const;
 
+    /**
+     * Return the matrix interpolating between the faces @p face_no of the
+     * elements with indices @p fe_index_1 and @p fe_index_2, i.e., the matrix
+     * computed by FiniteElement::get_face_interpolation_matrix() of the
+     * element @p fe_index_1 when called with the element @p fe_index_2 as
+     * argument.
+     *
+     * The matrix is computed the first time it is requested and stored in
+     * this object, so that subsequent calls, e.g. for other faces or in later
+     * adaptive refinement cycles, do not need to compute it again. The
+     * function can be called concurrently from several threads.
+     */
+    const FullMatrix<double> &
+    get_face_interpolation_matrix(const unsigned int fe_index_1,
+                                  const unsigned int fe_index_2,
+                                  const unsigned int face_no = 0) const;
+
+    /**
+     * Same as above, but for the matrix computed by
+     * FiniteElement::get_subface_interpolation_matrix() for the child
+     * @p subface of the face @p face_no.
+     */
+    const FullMatrix<double> &
+    get_subface_interpolation_matrix(const unsigned int fe_index_1,
+                                     const unsigned int fe_index_2,
+                                     const unsigned int subface,
+                                     const unsigned int face_no = 0) const;
+
+    /**
+     * Return the result of FiniteElement::compare_for_domination() of the
+     * element with index @p fe_index_1 when called with the element
+     * @p fe_index_2 as argument and the given codimension @p codim.
+     *
+     * All functions of this class that determine dominating or dominated
+     * elements use this function. The result is computed the first time it
+     * is requested and stored in this object, so that the many queries for
+     * the same pairs of elements in DoFHandler::distribute_dofs() and
+     * DoFTools::make_hanging_node_constraints() only compare each pair
+     * once. The function can be called concurrently from several threads.
+     */
+    FiniteElementDomination::Domination
+    compare_for_domination(const unsigned int fe_index_1,
+                           const unsigned int fe_index_2,
+                           const unsigned int codim = 0) const;
+
+    /**
+     * Return the identities between the degrees of freedom on a vertex of
+     * the elements with indices @p fe_index_1 and @p fe_index_2 as computed
+     * by FiniteElement::hp_vertex_dof_identities().
+     *
+     * As for compare_for_domination(), the identities are only computed the
+     * first time they are requested.
+     */
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    hp_vertex_dof_identities(const unsigned int fe_index_1,
+                             const unsigned int fe_index_2) const;
+
+    /**
+     * Same as above, but for the identities on a line computed by
+     * FiniteElement::hp_line_dof_identities().
+     */
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    hp_line_dof_identities(const unsigned int fe_index_1,
+                           const unsigned int fe_index_2) const;
+
+    /**
+     * Same as above, but for the identities on the quadrilateral face
+     * @p face_no computed by FiniteElement::hp_quad_dof_identities().
+     */
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    hp_quad_dof_identities(const unsigned int fe_index_1,
+                           const unsigned int fe_index_2,
+                           const unsigned int face_no = 0) const;
+
     /**
      * Return the indices of finite elements in this FECollection that dominate
      * all elements associated with the provided set of indices @p fes.
@@ -757,6 +835,57 @@ namespace hp
     std::function<unsigned int(const typename hp::FECollection<dim, spacedim> &,
                                const unsigned int)>
       hierarchy_prev;
+
+    /**
+     * A cache for the face and subface interpolation matrices between the
+     * elements of this collection, indexed by the two fe indices, the subface
+     * (numbers::invalid_unsigned_int for the face itself), and the face
+     * number. The cache is held by a shared pointer, so that copies of this
+     * object share the matrices already computed. It is replaced by an
+     * empty cache whenever an element is added.
+     */
+    struct InterpolationMatrixCache
+    {
+      Threads::Mutex mutex;
+
+      std::map<std::array<unsigned int, 4>, FullMatrix<double>> matrices;
+    };
+
+    std::shared_ptr<InterpolationMatrixCache> interpolation_matrix_cache;
+
+    /**
+     * A cache for the domination relations and the identities of degrees of
+     * freedom between the elements of this collection, shared between copies
+     * of this object in the same way as the interpolation matrices above.
+     * The dominations are indexed by the two fe indices and the codimension,
+     * the identities by the dimension of the object they live on, the two fe
+     * indices, and the face number.
+     */
+    struct DominationCache
+    {
+      Threads::Mutex mutex;
+
+      std::map<std::array<unsigned int, 3>,
+               FiniteElementDomination::Domination>
+        dominations;
+
+      std::map<std::array<unsigned int, 4>,
+               std::vector<std::pair<unsigned int, unsigned int>>>
+        dof_identities;
+    };
+
+    std::shared_ptr<DominationCache> domination_cache;
+
+    /**
+     * Return the identities between the degrees of freedom of the elements
+     * @p fe_index_1 and @p fe_index_2 on objects of dimension @p structdim,
+     * computing them if they are not yet stored in the cache.
+     */
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    get_dof_identities(const unsigned int structdim,
+                       const unsigned int fe_index_1,
+                       const unsigned int fe_index_2,
+                       const unsigned int face_no) const;
   };
 
 
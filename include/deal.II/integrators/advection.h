@@ -97,23 +97,35 @@ namespace LocalIntegrators
       AssertDimension(M.n(), n_dofs);
       AssertDimension(M.m(), t_dofs);
 
+      // Gather the values of the trial functions and the weighted
+      // directional derivatives of the test functions into matrices with one
+      // row per quadrature point and component, and compute the local matrix
+      // as a single matrix-matrix product.
+      const unsigned int n_rows = fe.n_quadrature_points * n_components;
+      FullMatrix<double> values(n_rows, n_dofs);
+      FullMatrix<double> derivatives(n_rows, t_dofs);
       for (unsigned k = 0; k < fe.n_quadrature_points; ++k)
         {
           const double       dx     = factor * fe.JxW(k);
           const unsigned int vindex = k * v_increment;
 
-          for (unsigned j = 0; j < n_dofs; ++j)
-            for (unsigned i = 0; i < t_dofs; ++i)
-              for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int c = 0; c < n_components; ++c)
+            {
+              const unsigned int row = k * n_components + c;
+              for (unsigned j = 0; j < n_dofs; ++j)
+                values(row, j) = fe.shape_value_component(j, k, c);
+              for (unsigned i = 0; i < t_dofs; ++i)
                 {
-                  double wgradv =
-                    velocity[0][vindex] * fe.shape_grad_component(i, k, c)[0];
+                  const Tensor<1, dim> grad = fe.shape_grad_component(i, k, c);
+                  double               wgradv = velocity[0][vindex] * grad[0];
                   for (unsigned int d = 1; d < dim; ++d)
-                    wgradv +=
-                      velocity[d][vindex] * fe.shape_grad_component(i, k, c)[d];
-                  M(i, j) -= dx * wgradv * fe.shape_value_component(j, k, c);
+                    wgradv += velocity[d][vindex] * grad[d];
+                  derivatives(row, i) = -dx * wgradv;
                 }
+            }
         }
+
+      derivatives.Tmmult(M, values, true);
     }
 
 
@@ -58,19 +58,30 @@ namespace LocalIntegrators
       AssertDimension(M.m(), n_dofs);
       AssertDimension(M.n(), n_dofs);
 
+      // Gather the symmetric gradients of all shape functions into a matrix
+      // with one row per quadrature point and tensor entry, and compute the
+      // local matrix as a single product with its weighted copy, see
+      // Laplace::cell_matrix().
+      const unsigned int n_rows = fe.n_quadrature_points * dim * dim;
+      FullMatrix<double> strains(n_rows, n_dofs);
+      FullMatrix<double> weighted_strains(n_rows, n_dofs);
       for (unsigned int k = 0; k < fe.n_quadrature_points; ++k)
         {
           const double dx = factor * fe.JxW(k);
           for (unsigned int i = 0; i < n_dofs; ++i)
-            for (unsigned int j = 0; j < n_dofs; ++j)
-              for (unsigned int d1 = 0; d1 < dim; ++d1)
-                for (unsigned int d2 = 0; d2 < dim; ++d2)
-                  M(i, j) += dx * .25 *
-                             (fe.shape_grad_component(j, k, d1)[d2] +
-                              fe.shape_grad_component(j, k, d2)[d1]) *
-                             (fe.shape_grad_component(i, k, d1)[d2] +
-                              fe.shape_grad_component(i, k, d2)[d1]);
+            for (unsigned int d1 = 0; d1 < dim; ++d1)
+              for (unsigned int d2 = 0; d2 < dim; ++d2)
+                {
+                  const unsigned int row = (k * dim + d1) * dim + d2;
+                  const double       strain =
+                    .5 * (fe.shape_grad_component(i, k, d1)[d2] +
+                          fe.shape_grad_component(i, k, d2)[d1]);
+                  strains(row, i)          = strain;
+                  weighted_strains(row, i) = dx * strain;
+                }
         }
+
+      strains.Tmmult(M, weighted_strains, true);
     }
 
 
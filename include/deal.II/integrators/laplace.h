@@ -56,30 +56,33 @@ namespace LocalIntegrators
       const unsigned int n_dofs       = fe.dofs_per_cell;
       const unsigned int n_components = fe.get_fe().n_components();
 
+      const unsigned int n_rows = fe.n_quadrature_points * n_components * dim;
+
+      // Gather all gradients into a matrix whose rows run over quadrature
+      // points, components and coordinate directions, and a copy scaled by
+      // the quadrature weights. The local matrix then is a single
+      // matrix-matrix product, which is executed by the blocked (and, if
+      // available, BLAS) kernel of FullMatrix instead of a scalar loop over
+      // pairs of shape functions.
+      FullMatrix<double> gradients(n_rows, n_dofs);
+      FullMatrix<double> weighted_gradients(n_rows, n_dofs);
       for (unsigned int k = 0; k < fe.n_quadrature_points; ++k)
         {
           const double dx = fe.JxW(k) * factor;
-          for (unsigned int i = 0; i < n_dofs; ++i)
-            {
-              double Mii = 0.0;
-              for (unsigned int d = 0; d < n_components; ++d)
-                Mii += dx * (fe.shape_grad_component(i, k, d) *
-                             fe.shape_grad_component(i, k, d));
-
-              M(i, i) += Mii;
-
-              for (unsigned int j = i + 1; j < n_dofs; ++j)
-                {
-                  double Mij = 0.0;
-                  for (unsigned int d = 0; d < n_components; ++d)
-                    Mij += dx * (fe.shape_grad_component(j, k, d) *
-                                 fe.shape_grad_component(i, k, d));
-
-                  M(i, j) += Mij;
-                  M(j, i) += Mij;
-                }
-            }
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              {
+                const Tensor<1, dim> grad = fe.shape_grad_component(i, k, c);
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    const unsigned int row = (k * n_components + c) * dim + d;
+                    gradients(row, i)          = grad[d];
+                    weighted_gradients(row, i) = dx * grad[d];
+                  }
+              }
         }
+
+      gradients.Tmmult(M, weighted_gradients, true);
     }
 
     /**
@@ -1436,6 +1436,48 @@ public:
                              VectorType &                  global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Same as the previous function for a deal.II SparseMatrix and Vector, but
+   * safe to call from several threads at the same time on the same global
+   * objects, also when the threads write into the same rows. This makes it
+   * possible to perform the whole assembly in the worker function of
+   * WorkStream::run() (with an empty copier) or in a plain parallel loop
+   * over the cells, without coloring the cells and without serializing the
+   * copy into the global objects.
+   *
+   * The constraints are resolved into the rows of the global objects just as
+   * for the function above, using thread-local scratch data. The additions
+   * are then protected by locks that each guard a block of consecutive
+   * rows. Since the rows touched by one call are visited in ascending order,
+   * at most one lock is held at any time and all entries of the local matrix
+   * that fall into the same block of rows are added under a single lock.
+   * Together with the fact that neighboring cells handled by different
+   * threads usually only share a few rows, contention on the locks stays
+   * small.
+   *
+   * @note The locks are shared between all global objects, so that no state
+   * needs to be attached to the matrix or vector. The result is identical to
+   * the one of the previous function up to roundoff, which depends on the
+   * order in which the threads add their contributions.
+   */
+  void
+  distribute_local_to_global_concurrently(
+    const FullMatrix<number> &    local_matrix,
+    const Vector<number> &        local_vector,
+    const std::vector<size_type> &local_dof_indices,
+    SparseMatrix<number> &        global_matrix,
+    Vector<number> &              global_vector,
+    const bool                    use_inhomogeneities_for_rhs = false) const;
+
+  /**
+   * Same as the previous function, but only writing into the matrix.
+   */
+  void
+  distribute_local_to_global_concurrently(
+    const FullMatrix<number> &    local_matrix,
+    const std::vector<size_type> &local_dof_indices,
+    SparseMatrix<number> &        global_matrix) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -1881,6 +1923,33 @@ private:
    */
   bool sorted;
 
+  /**
+   * A copy of the entries of all lines in compressed row storage, set up by
+   * close(): the entries of <code>lines[i]</code> are stored at the
+   * positions <code>closed_entry_starts[i]</code> to
+   * <code>closed_entry_starts[i+1]</code> of the arrays
+   * closed_entry_columns and closed_entry_weights.
+   *
+   * Functions that loop over all constraints, like distribute(), read the
+   * entries from here rather than from the individually allocated vectors
+   * of the lines, which keeps the memory accesses contiguous. The
+   * inhomogeneities are still taken from #lines since they may be changed
+   * by set_inhomogeneity() after close().
+   */
+  std::vector<size_type> closed_entry_starts;
+
+  /**
+   * The columns of the entries in compressed row storage, see
+   * closed_entry_starts.
+   */
+  std::vector<size_type> closed_entry_columns;
+
+  /**
+   * The weights of the entries in compressed row storage, see
+   * closed_entry_starts.
+   */
+  std::vector<number> closed_entry_weights;
+
   mutable Threads::ThreadLocalStorage<
     internal::AffineConstraints::ScratchData<number>>
     scratch_data;
@@ -1892,6 +1961,13 @@ private:
   size_type
   calculate_line_index(const size_type line_n) const;
 
+  /**
+   * Set up closed_entry_starts, closed_entry_columns, and
+   * closed_entry_weights from the entries of #lines.
+   */
+  void
+  build_closed_entries();
+
   /**
    * This function actually implements the local_to_global function for
    * standard (non-block) matrices.
@@ -2003,6 +2079,9 @@ inline AffineConstraints<number>::AffineConstraints(
   , lines_cache(affine_constraints.lines_cache)
   , local_lines(affine_constraints.local_lines)
   , sorted(affine_constraints.sorted)
+  , closed_entry_starts(affine_constraints.closed_entry_starts)
+  , closed_entry_columns(affine_constraints.closed_entry_columns)
+  , closed_entry_weights(affine_constraints.closed_entry_weights)
 {}
 
 template <typename number>
@@ -2430,6 +2509,8 @@ AffineConstraints<number>::copy_from(
   lines_cache = other.lines_cache;
   local_lines = other.local_lines;
   sorted      = other.sorted;
+  if (sorted)
+    build_closed_entries();
 }
 
 
@@ -20,6 +20,7 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -52,8 +53,10 @@
 #include <boost/serialization/utility.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <complex>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <ostream>
 #include <set>
@@ -322,245 +325,207 @@ AffineConstraints<number>::close()
       Assert(i == calculate_line_index(lines[lines_cache[i]].index),
              ExcInternalError());
 
-  // first, strip zero entries, as we have to do that only once
-  for (ConstraintLine &line : lines)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line.entries.erase(std::remove_if(line.entries.begin(),
-                                      line.entries.end(),
-                                      [](
-                                        const std::pair<size_type, number> &p) {
-                                        return p.second == number(0.);
-                                      }),
-                       line.entries.end());
-
-
-
-#ifdef DEBUG
-  // In debug mode we are computing an estimate for the maximum number
-  // of constraints so that we can bail out if there is a cycle in the
-  // constraints (which is easier than searching for cycles in the graph).
-  //
-  // Let us figure out the largest dof index. This is an upper bound for the
-  // number of constraints because it is an approximation for the number of dofs
-  // in our system.
-  size_type largest_idx = 0;
-  for (const ConstraintLine &line : lines)
-    for (const std::pair<size_type, number> &entry : line.entries)
-      largest_idx = std::max(largest_idx, entry.first);
-#endif
-
-  // replace references to dofs that are themselves constrained. note that
-  // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
+  // first, strip zero entries, as we have to do that only once. that would
+  // mean that in the linear constraint for a node, x_i = ax_1 + bx_2 + ...,
+  // another node times 0 appears. obviously, 0*something can be omitted
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        lines[l].entries.erase(
+          std::remove_if(lines[l].entries.begin(),
+                         lines[l].entries.end(),
+                         [](const std::pair<size_type, number> &p) {
+                           return p.second == number(0.);
+                         }),
+          lines[l].entries.end());
+    },
+    256);
+
+  // replace references to dofs that are themselves constrained. for
+  // example if x3=x0/2+x2/2 and x2=x0/2+x1/2, then the new list will be
+  // x3=x0/2+x0/4+x1/4. ignore elements that we don't store on the current
+  // processor
   //
-  // the iteration replaces references to constrained degrees of freedom by
-  // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
-  // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
-  // twice. we will throw this duplicate out in the following step, where
-  // we sort the list so that throwing out duplicates becomes much more
-  // efficient. also, we have to do it only once, rather than in each
-  // iteration
-  size_type iteration = 0;
-  while (true)
-    {
-      bool chained_constraint_replaced = false;
-
-      for (ConstraintLine &line : lines)
-        {
-#ifdef DEBUG
-          // we need to keep track of how many replacements we do in this line,
-          // because we can end up in a cycle A->B->C->A without the number of
-          // entries growing.
-          size_type n_replacements = 0;
-#endif
-
-          // loop over all entries of this line (including ones that we
-          // have appended in this go around) and see whether they are
-          // further constrained. ignore elements that we don't store on
-          // the current processor
-          size_type entry = 0;
-          while (entry < line.entries.size())
-            if (((local_lines.size() == 0) ||
-                 (local_lines.is_element(line.entries[entry].first))) &&
-                is_constrained(line.entries[entry].first))
-              {
-                // ok, this entry is further constrained:
-                chained_constraint_replaced = true;
-
-                // look up the chain of constraints for this entry
-                const size_type dof_index = line.entries[entry].first;
-                const number    weight    = line.entries[entry].second;
-
-                Assert(dof_index != line.index,
-                       ExcMessage("Cycle in constraints detected!"));
-
-                const ConstraintLine &constrained_line =
-                  lines[lines_cache[calculate_line_index(dof_index)]];
-                Assert(constrained_line.index == dof_index, ExcInternalError());
-
-                // now we have to replace an entry by its expansion. we do
-                // that by overwriting the entry by the first entry of the
-                // expansion and adding the remaining ones to the end,
-                // where we will later process them once more
-                //
-                // we can of course only do that if the DoF that we are
-                // currently handle is constrained by a linear combination
-                // of other dofs:
-                if (constrained_line.entries.size() > 0)
-                  {
-                    for (size_type i = 0; i < constrained_line.entries.size();
-                         ++i)
-                      Assert(dof_index != constrained_line.entries[i].first,
-                             ExcMessage("Cycle in constraints detected!"));
-
-                    // replace first entry, then tack the rest to the end
-                    // of the list
-                    line.entries[entry] = std::pair<size_type, number>(
-                      constrained_line.entries[0].first,
-                      constrained_line.entries[0].second * weight);
-
-                    for (size_type i = 1; i < constrained_line.entries.size();
-                         ++i)
-                      line.entries.emplace_back(
-                        constrained_line.entries[i].first,
-                        constrained_line.entries[i].second * weight);
-
-#ifdef DEBUG
-                    // keep track of how many entries we replace in this
-                    // line. If we do more than there are constraints or
-                    // dofs in our system, we must have a cycle.
-                    ++n_replacements;
-                    Assert(n_replacements / 2 < largest_idx,
-                           ExcMessage("Cycle in constraints detected!"));
-                    if (n_replacements / 2 >= largest_idx)
-                      return; // this enables us to test for this Exception.
-#endif
-                  }
-                else
-                  // the DoF that we encountered is not constrained by a
-                  // linear combination of other dofs but is equal to just
-                  // the inhomogeneity (i.e. its chain of entries is
-                  // empty). in that case, we can't just overwrite the
-                  // current entry, but we have to actually eliminate it
-                  {
-                    line.entries.erase(line.entries.begin() + entry);
-                  }
-
-                line.inhomogeneity += constrained_line.inhomogeneity * weight;
-
-                // now that we're here, do not increase index by one but
-                // rather make another pass for the present entry because
-                // we have replaced the present entry by another one, or
-                // because we have deleted it and shifted all following
-                // ones one forward
-              }
-            else
-              // entry not further constrained. just move ahead by one
-              ++entry;
-        }
-
-      // if we didn't do anything in this round, then quit the loop
-      if (chained_constraint_replaced == false)
-        break;
-
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size(), ExcInternalError());
-    }
+  // rather than sweeping over all lines until no chains of constraints are
+  // left, we first compute for each line its depth, i.e., the length of the
+  // longest chain of constraints starting at it. lines that only reference
+  // unconstrained dofs have depth zero. a line of depth d only references
+  // lines of smaller depth, so if we resolve the lines depth by depth, a
+  // single substitution of each constrained entry by the already resolved
+  // line suffices. moreover, all lines of the same depth are independent of
+  // each other and can be resolved in parallel
+  const auto line_of_constrained_entry =
+    [&](const size_type index) -> size_type {
+    if ((local_lines.size() == 0) || (local_lines.is_element(index)))
+      {
+        const size_type line_index = calculate_line_index(index);
+        if (line_index < lines_cache.size())
+          return lines_cache[line_index];
+      }
+    return numbers::invalid_size_type;
+  };
 
-  // finally sort the entries and re-scale them if necessary. in this step,
-  // we also throw out duplicates as mentioned above. moreover, as some
-  // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+  // compute the depths with a depth-first search that uses an explicit
+  // stack, as the chains can be long. lines on the stack are marked as in
+  // progress, so that finding them again means that there is a cycle
+  const size_type        unvisited   = numbers::invalid_size_type;
+  const size_type        in_progress = numbers::invalid_size_type - 1;
+  std::vector<size_type> depths(lines.size(), unvisited);
+  {
+    std::vector<std::pair<size_type, size_type>> stack;
+    for (size_type start = 0; start < lines.size(); ++start)
+      if (depths[start] == unvisited)
         {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
+          depths[start] = in_progress;
+          stack.emplace_back(start, 0);
+          while (!stack.empty())
             {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
+              const size_type       l    = stack.back().first;
+              const ConstraintLine &line = lines[l];
+              if (stack.back().second < line.entries.size())
+                {
+                  const size_type other = line_of_constrained_entry(
+                    line.entries[stack.back().second++].first);
+                  if (other == numbers::invalid_size_type)
+                    continue;
 
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+                  Assert(depths[other] != in_progress,
+                         ExcMessage("Cycle in constraints detected!"));
+                  if (depths[other] == in_progress)
+                    return; // this enables us to test for this Exception.
 
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
+                  if (depths[other] == unvisited)
+                    {
+                      depths[other] = in_progress;
+                      stack.emplace_back(other, 0);
+                    }
+                }
+              else
                 {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
-                         ExcInternalError());
+                  size_type depth = 0;
+                  for (const std::pair<size_type, number> &entry :
+                       line.entries)
+                    {
+                      const size_type other =
+                        line_of_constrained_entry(entry.first);
+                      if (other != numbers::invalid_size_type)
+                        depth = std::max(depth, depths[other] + 1);
+                    }
+                  depths[l] = depth;
+                  stack.pop_back();
                 }
             }
-
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
         }
+  }
 
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+  // sort the lines by their depth
+  const size_type max_depth =
+    lines.empty() ? 0 : *std::max_element(depths.begin(), depths.end());
+  std::vector<size_type> depth_starts(max_depth + 2, 0);
+  for (const size_type depth : depths)
+    ++depth_starts[depth + 1];
+  std::partial_sum(depth_starts.begin(),
+                   depth_starts.end(),
+                   depth_starts.begin());
+  std::vector<size_type> lines_by_depth(lines.size());
+  {
+    std::vector<size_type> positions(depth_starts.begin(),
+                                     depth_starts.end() - 1);
+    for (size_type l = 0; l < lines.size(); ++l)
+      lines_by_depth[positions[depths[l]]++] = l;
+  }
+
+  // now resolve the lines depth by depth. after the substitution, sort the
+  // entries and throw out duplicates by adding up their weights. moreover,
+  // as some entries might have had zero weights, we give the vector of
+  // entries a sharp size
+  const auto resolve_line = [&](ConstraintLine &line, const size_type depth) {
+    if (depth > 0)
+      {
+        typename ConstraintLine::Entries new_entries;
+        new_entries.reserve(line.entries.size());
+        for (const std::pair<size_type, number> &entry : line.entries)
+          {
+            const size_type other = line_of_constrained_entry(entry.first);
+            if (other == numbers::invalid_size_type)
+              new_entries.push_back(entry);
+            else
+              {
+                // the line we substitute has already been resolved. if it
+                // is not constrained by a linear combination of other dofs
+                // but is equal to just the inhomogeneity (i.e. its list of
+                // entries is empty), the entry simply disappears
+                const ConstraintLine &constrained_line = lines[other];
+                Assert(constrained_line.index == entry.first,
+                       ExcInternalError());
+                for (const std::pair<size_type, number> &other_entry :
+                     constrained_line.entries)
+                  new_entries.emplace_back(other_entry.first,
+                                           other_entry.second * entry.second);
+                line.inhomogeneity +=
+                  constrained_line.inhomogeneity * entry.second;
+              }
+          }
+        line.entries.swap(new_entries);
+      }
+
+    std::sort(line.entries.begin(),
+              line.entries.end(),
+              [](const std::pair<size_type, number> &a,
+                 const std::pair<size_type, number> &b) -> bool {
+                // Let's use lexicogrpahic ordering with std::abs for number
+                // type (it might be complex valued).
+                return (a.first < b.first) ||
+                       (a.first == b.first &&
+                        std::abs(a.second) < std::abs(b.second));
+              });
+
+    // merge duplicates in place, which keeps the list sorted
+    if (!line.entries.empty())
+      {
+        size_type n_unique = 0;
+        for (size_type j = 1; j < line.entries.size(); ++j)
+          if (line.entries[j].first == line.entries[n_unique].first)
+            line.entries[n_unique].second += line.entries[j].second;
+          else
+            line.entries[++n_unique] = line.entries[j];
+        line.entries.resize(n_unique + 1);
+      }
+    if (line.entries.size() < line.entries.capacity())
+      typename ConstraintLine::Entries(line.entries).swap(line.entries);
+
+    // Finally do the following check: if the sum of weights for the
+    // constraints is close to one, but not exactly one, then rescale all
+    // the weights so that they sum up to 1. this adds a little numerical
+    // stability and avoids all sorts of problems where the actual value
+    // is close to, but not quite what we expected
+    //
+    // the case where the weights don't quite sum up happens when we
+    // compute the interpolation weights "on the fly", i.e. not from
+    // precomputed tables. in this case, the interpolation weights are
+    // also subject to round-off
+    number sum = 0.;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      sum += entry.second;
+    if (std::abs(sum - number(1.)) < 1.e-13)
+      {
+        for (std::pair<size_type, number> &entry : line.entries)
+          entry.second /= sum;
+        line.inhomogeneity /= sum;
+      }
+  };
+
+  for (size_type depth = 0; depth <= max_depth; ++depth)
+    parallel::apply_to_subranges(
+      depth_starts[depth],
+      depth_starts[depth + 1],
+      [&](const size_type begin, const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          resolve_line(lines[lines_by_depth[i]], depth);
+      },
+      64);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -577,11 +542,40 @@ AffineConstraints<number>::close()
         }
 #endif
 
+  build_closed_entries();
+
   sorted = true;
 }
 
 
 
+template <typename number>
+void
+AffineConstraints<number>::build_closed_entries()
+{
+  closed_entry_starts.resize(lines.size() + 1);
+  closed_entry_starts[0] = 0;
+  for (size_type i = 0; i < lines.size(); ++i)
+    closed_entry_starts[i + 1] =
+      closed_entry_starts[i] + lines[i].entries.size();
+
+  // give the arrays a sharp size, as they are not modified until the next
+  // call to close()
+  std::vector<size_type>(closed_entry_starts.back())
+    .swap(closed_entry_columns);
+  std::vector<number>(closed_entry_starts.back()).swap(closed_entry_weights);
+  for (size_type i = 0; i < lines.size(); ++i)
+    for (size_type j = 0; j < lines[i].entries.size(); ++j)
+      {
+        closed_entry_columns[closed_entry_starts[i] + j] =
+          lines[i].entries[j].first;
+        closed_entry_weights[closed_entry_starts[i] + j] =
+          lines[i].entries[j].second;
+      }
+}
+
+
+
 template <typename number>
 void
 AffineConstraints<number>::merge(
@@ -746,6 +740,8 @@ AffineConstraints<number>::shift(const size_type offset)
       for (std::pair<size_type, number> &entry : line.entries)
         entry.first += offset;
     }
+  for (size_type &column : closed_entry_columns)
+    column += offset;
 
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
@@ -773,6 +769,21 @@ AffineConstraints<number>::clear()
     lines_cache.swap(tmp);
   }
 
+  {
+    std::vector<size_type> tmp;
+    closed_entry_starts.swap(tmp);
+  }
+
+  {
+    std::vector<size_type> tmp;
+    closed_entry_columns.swap(tmp);
+  }
+
+  {
+    std::vector<number> tmp;
+    closed_entry_weights.swap(tmp);
+  }
+
   sorted = false;
 }
 
@@ -936,7 +947,10 @@ AffineConstraints<number>::memory_consumption() const
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
           MemoryConsumption::memory_consumption(sorted) +
-          MemoryConsumption::memory_consumption(local_lines));
+          MemoryConsumption::memory_consumption(local_lines) +
+          MemoryConsumption::memory_consumption(closed_entry_starts) +
+          MemoryConsumption::memory_consumption(closed_entry_columns) +
+          MemoryConsumption::memory_consumption(closed_entry_weights));
 }
 
 
@@ -1424,20 +1438,23 @@ AffineConstraints<number>::condense(const VectorType &vec_ghosted,
   // one we need to set elements to zero. for parallel vectors, this can
   // only work if we can put a compress() in between, but we don't want to
   // call compress() twice per entry
-  for (const ConstraintLine &line : lines)
+  for (size_type i = 0; i < lines.size(); ++i)
     {
       // in case the constraint is inhomogeneous, this function is not
       // appropriate. Throw an exception.
-      Assert(line.inhomogeneity == number(0.),
+      Assert(lines[i].inhomogeneity == number(0.),
              ExcMessage("Inhomogeneous constraint cannot be condensed "
                         "without any matrix specified."));
 
-      const typename VectorType::value_type old_value = vec_ghosted(line.index);
-      for (const std::pair<size_type, number> &entry : line.entries)
-        if (vec.in_local_range(entry.first) == true)
-          vec(entry.first) +=
+      const typename VectorType::value_type old_value =
+        vec_ghosted(lines[i].index);
+      for (size_type k = closed_entry_starts[i];
+           k < closed_entry_starts[i + 1];
+           ++k)
+        if (vec.in_local_range(closed_entry_columns[k]) == true)
+          vec(closed_entry_columns[k]) +=
             (static_cast<typename VectorType::value_type>(old_value) *
-             entry.second);
+             closed_entry_weights[k]);
     }
 
   vec.compress(VectorOperation::add);
@@ -1831,6 +1848,12 @@ namespace internal
   {
     using size_type = types::global_dof_index;
 
+    /**
+     * The minimal number of constraint lines or constrained entries that a
+     * single thread works on in distribute() and set_zero().
+     */
+    constexpr unsigned int distribute_grain_size = 512;
+
     template <class VectorType>
     void
     set_zero_parallel(const std::vector<size_type> &cm,
@@ -1860,20 +1883,139 @@ namespace internal
                       LinearAlgebra::distributed::Vector<number> &vec,
                       size_type                                   shift = 0)
     {
-      for (const size_type index : cm)
-        {
-          // If shift>0 then we are working on a part of a BlockVector
-          // so vec(i) is actually the global entry i+shift.
-          // We first make sure the line falls into the range of vec,
-          // then check if is part of the local part of the vector, before
-          // finally setting the value to 0.
-          if (index < shift)
-            continue;
-          const size_type idx = index - shift;
-          if (vec.in_local_range(idx))
-            vec(idx) = 0.;
-        }
+      // the entries are distinct, so the work can be split among threads
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        cm.size(),
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            {
+              // If shift>0 then we are working on a part of a BlockVector
+              // so vec(i) is actually the global entry i+shift.
+              // We first make sure the line falls into the range of vec,
+              // then check if is part of the local part of the vector,
+              // before finally setting the value to 0.
+              if (cm[i] < shift)
+                continue;
+              const size_type idx = cm[i] - shift;
+              if (vec.in_local_range(idx))
+                vec(idx) = 0.;
+            }
+        },
+        distribute_grain_size);
+      vec.zero_out_ghost_values();
+    }
+
+
+
+    /**
+     * Compute the constrained entries of @p vec that are locally owned, from
+     * the constraints given by @p lines and the closed constraint entries in
+     * compressed row storage. This is the fast path of
+     * AffineConstraints::distribute() for LinearAlgebra::distributed::Vector:
+     * the constraint lines are processed in parallel by several threads, and
+     * the source entries are read directly from @p vec. If all sources are
+     * locally owned on all processes, no ghost exchange is done at all. If
+     * some are only available in the ghost range of @p vec, the ghost values
+     * are updated unless the caller has already done so. On exit, @p vec has
+     * no ghost values, as with the general implementation.
+     *
+     * Return false without changing @p vec if some sources are neither owned
+     * nor ghosts of @p vec on some process, in which case the general
+     * implementation that imports the sources into a temporary vector has to
+     * be used.
+     */
+    template <typename LineType, typename number, typename Number>
+    bool
+    distribute_with_vector_ghosts(
+      const std::vector<LineType> &               lines,
+      const std::vector<size_type> &              entry_starts,
+      const std::vector<size_type> &              entry_columns,
+      const std::vector<number> &                 entry_weights,
+      LinearAlgebra::distributed::Vector<Number> &vec)
+    {
+      const Utilities::MPI::Partitioner &partitioner = *vec.get_partitioner();
+
+      // classify the sources of the locally owned lines: 0 if all of them
+      // are owned, 1 if some are in the ghost range of the vector, and 2 if
+      // some are not available at all
+      std::atomic<int> local_state(0);
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        lines.size(),
+        [&](const std::size_t begin, const std::size_t end) {
+          int state = 0;
+          for (std::size_t i = begin; i < end && state < 2; ++i)
+            if (partitioner.in_local_range(lines[i].index))
+              for (size_type k = entry_starts[i]; k < entry_starts[i + 1]; ++k)
+                if (!partitioner.in_local_range(entry_columns[k]))
+                  {
+                    if (partitioner.is_ghost_entry(entry_columns[k]))
+                      state = std::max(state, 1);
+                    else
+                      {
+                        state = 2;
+                        break;
+                      }
+                  }
+          int previous = local_state.load();
+          while (previous < state &&
+                 !local_state.compare_exchange_weak(previous, state))
+            ;
+        },
+        distribute_grain_size);
+
+      const int state =
+        Utilities::MPI::max(local_state.load(), vec.get_mpi_communicator());
+      if (state == 2)
+        return false;
+
+      if (state == 1 && !vec.has_ghost_elements())
+        vec.update_ghost_values();
+
+      // the constrained entries are distinct and, since the constraints are
+      // closed, never act as sources, so the lines can be processed in any
+      // order
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        lines.size(),
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            if (partitioner.in_local_range(lines[i].index))
+              {
+                Number new_value = lines[i].inhomogeneity;
+                for (size_type k = entry_starts[i]; k < entry_starts[i + 1];
+                     ++k)
+                  new_value +=
+                    vec.local_element(
+                      partitioner.global_to_local(entry_columns[k])) *
+                    entry_weights[k];
+                AssertIsFinite(new_value);
+                vec.local_element(
+                  partitioner.global_to_local(lines[i].index)) = new_value;
+              }
+        },
+        distribute_grain_size);
+
       vec.zero_out_ghost_values();
+      return true;
+    }
+
+
+
+    /**
+     * For all other vector types, the general implementation of
+     * AffineConstraints::distribute() is used.
+     */
+    template <typename LineType, typename number, typename VectorType>
+    bool
+    distribute_with_vector_ghosts(const std::vector<LineType> &,
+                                  const std::vector<size_type> &,
+                                  const std::vector<size_type> &,
+                                  const std::vector<number> &,
+                                  VectorType &)
+    {
+      return false;
     }
 
 #ifdef DEAL_II_COMPILER_CUDA_AWARE
@@ -2231,6 +2373,14 @@ AffineConstraints<number>::distribute(VectorType &vec) const
   // that do not own anything because of that particular parallel model), and
   // call compress() finally. the first case here is for the complicated case,
   // the last else is for the simple case (sequential vector)
+  if (internal::AffineConstraintsImplementation::distribute_with_vector_ghosts(
+        lines,
+        closed_entry_starts,
+        closed_entry_columns,
+        closed_entry_weights,
+        vec))
+    return;
+
   const IndexSet vec_owned_elements = vec.locally_owned_elements();
 
   if (dealii::is_serial_vector<VectorType>::value == false)
@@ -2251,11 +2401,13 @@ AffineConstraints<number>::distribute(VectorType &vec) const
       // following.
       IndexSet needed_elements = vec_owned_elements;
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
-          for (const std::pair<size_type, number> &entry : line.entries)
-            if (!vec_owned_elements.is_element(entry.first))
-              needed_elements.add_index(entry.first);
+      for (size_type i = 0; i < lines.size(); ++i)
+        if (vec_owned_elements.is_element(lines[i].index))
+          for (size_type k = closed_entry_starts[i];
+               k < closed_entry_starts[i + 1];
+               ++k)
+            if (!vec_owned_elements.is_element(closed_entry_columns[k]))
+              needed_elements.add_index(closed_entry_columns[k]);
 
       VectorType ghosted_vector;
       internal::import_vector_with_ghost_elements(
@@ -2265,19 +2417,22 @@ AffineConstraints<number>::distribute(VectorType &vec) const
         ghosted_vector,
         std::integral_constant<bool, IsBlockVector<VectorType>::value>());
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
+      for (size_type i = 0; i < lines.size(); ++i)
+        if (vec_owned_elements.is_element(lines[i].index))
           {
-            typename VectorType::value_type new_value = line.inhomogeneity;
-            for (const std::pair<size_type, number> &entry : line.entries)
+            typename VectorType::value_type new_value =
+              lines[i].inhomogeneity;
+            for (size_type k = closed_entry_starts[i];
+                 k < closed_entry_starts[i + 1];
+                 ++k)
               new_value +=
                 (static_cast<typename VectorType::value_type>(
-                   internal::ElementAccess<VectorType>::get(ghosted_vector,
-                                                            entry.first)) *
-                 entry.second);
+                   internal::ElementAccess<VectorType>::get(
+                     ghosted_vector, closed_entry_columns[k])) *
+                 closed_entry_weights[k]);
             AssertIsFinite(new_value);
             internal::ElementAccess<VectorType>::set(new_value,
-                                                     line.index,
+                                                     lines[i].index,
                                                      vec);
           }
 
@@ -2293,22 +2448,21 @@ AffineConstraints<number>::distribute(VectorType &vec) const
     // support anything else or because it's completely stored
     // locally)
     {
-      for (const ConstraintLine &next_constraint : lines)
+      for (size_type i = 0; i < lines.size(); ++i)
         {
-          // fill entry in line
-          // next_constraint.index by adding the
-          // different contributions
-          typename VectorType::value_type new_value =
-            next_constraint.inhomogeneity;
-          for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
-            new_value +=
-              (static_cast<typename VectorType::value_type>(
-                 internal::ElementAccess<VectorType>::get(vec, entry.first)) *
-               entry.second);
+          // fill entry in line lines[i].index by adding the different
+          // contributions
+          typename VectorType::value_type new_value = lines[i].inhomogeneity;
+          for (size_type k = closed_entry_starts[i];
+               k < closed_entry_starts[i + 1];
+               ++k)
+            new_value += (static_cast<typename VectorType::value_type>(
+                            internal::ElementAccess<VectorType>::get(
+                              vec, closed_entry_columns[k])) *
+                          closed_entry_weights[k]);
           AssertIsFinite(new_value);
           internal::ElementAccess<VectorType>::set(new_value,
-                                                   next_constraint.index,
+                                                   lines[i].index,
                                                    vec);
         }
     }
@@ -3224,6 +3378,28 @@ namespace internal
         }
     }
 
+    // the number of consecutive rows of a global matrix and vector that are
+    // guarded by the same lock in distribute_local_to_global_concurrently(),
+    // and the number of locks. Blocks of rows are mapped onto the locks in a
+    // round-robin fashion, so distinct blocks may share a lock. This does not
+    // cause deadlocks because a thread never holds more than one lock.
+    static constexpr size_type    row_block_size      = 64;
+    static constexpr unsigned int n_row_block_mutexes = 1024;
+
+    // each mutex is placed on a cache line of its own to avoid false sharing
+    // between threads working on neighboring blocks of rows
+    struct alignas(64) RowBlockMutex
+    {
+      std::mutex mutex;
+    };
+
+    inline std::mutex &
+    get_row_block_mutex(const size_type row_block)
+    {
+      static RowBlockMutex mutexes[n_row_block_mutexes];
+      return mutexes[row_block % n_row_block_mutexes].mutex;
+    }
+
     // to make sure that the global matrix remains invertible, we need to do
     // something with the diagonal elements. Add the average of the
     // absolute values of the local matrix diagonals, so the resulting entry
@@ -3251,7 +3427,8 @@ namespace internal
       const dealii::AffineConstraints<number> &constraints,
       MatrixType &                             global_matrix,
       VectorType &                             global_vector,
-      bool                                     use_inhomogeneities_for_rhs)
+      bool                                     use_inhomogeneities_for_rhs,
+      const bool                               lock_rows = false)
     {
       if (global_rows.n_constraints() > 0)
         {
@@ -3275,6 +3452,11 @@ namespace internal
               const size_type local_row  = global_rows.constraint_origin(i);
               const size_type global_row = local_dof_indices[local_row];
 
+              std::unique_lock<std::mutex> lock;
+              if (lock_rows)
+                lock = std::unique_lock<std::mutex>(
+                  get_row_block_mutex(global_row / row_block_size));
+
               const number current_diagonal =
                 local_matrix(local_row, local_row);
               if (std::abs(current_diagonal) != 0.)
@@ -3679,6 +3861,98 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+// thread-safe variant of the function above for deal.II matrices and vectors.
+// The constraints are resolved into the global rows exactly as before, but
+// the additions into one block of rows are done while holding the lock of
+// that block
+template <typename number>
+void
+AffineConstraints<number>::distribute_local_to_global_concurrently(
+  const FullMatrix<number> &    local_matrix,
+  const Vector<number> &        local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  SparseMatrix<number> &        global_matrix,
+  Vector<number> &              global_vector,
+  const bool                    use_inhomogeneities_for_rhs) const
+{
+  const bool use_vectors =
+    (local_vector.size() == 0 && global_vector.size() == 0) ? false : true;
+
+  AssertDimension(local_matrix.n(), local_dof_indices.size());
+  AssertDimension(local_matrix.m(), local_dof_indices.size());
+  Assert(global_matrix.m() == global_matrix.n(), ExcNotQuadratic());
+  if (use_vectors == true)
+    {
+      AssertDimension(local_matrix.m(), local_vector.size());
+      AssertDimension(global_matrix.m(), global_vector.size());
+    }
+  Assert(lines.empty() || sorted == true, ExcMatrixNotClosed());
+
+  typename internal::AffineConstraints::ScratchDataAccessor<number>
+    scratch_data(this->scratch_data);
+
+  internal::AffineConstraints::GlobalRowsFromLocal<number> &global_rows =
+    scratch_data->global_rows;
+  global_rows.reinit(local_dof_indices.size());
+  make_sorted_row_list(local_dof_indices, global_rows);
+
+  const size_type n_actual_dofs = global_rows.size();
+
+  // the global rows are sorted, so we can go through them block by block and
+  // do all the work for the rows within one block under the same lock
+  const size_type block_size = internal::AffineConstraints::row_block_size;
+  size_type       i          = 0;
+  while (i < n_actual_dofs)
+    {
+      const size_type row_block = global_rows.global_row(i) / block_size;
+      std::lock_guard<std::mutex> lock(
+        internal::AffineConstraints::get_row_block_mutex(row_block));
+      for (; i < n_actual_dofs &&
+             global_rows.global_row(i) / block_size == row_block;
+           ++i)
+        {
+          internal::AffineConstraints::resolve_matrix_row(
+            global_rows, i, 0, n_actual_dofs, local_matrix, &global_matrix);
+
+          if (use_vectors == true)
+            {
+              const number val = resolve_vector_entry(
+                i, global_rows, local_vector, local_dof_indices, local_matrix);
+              AssertIsFinite(val);
+              if (val != number())
+                global_vector(global_rows.global_row(i)) += val;
+            }
+        }
+    }
+
+  internal::AffineConstraints::set_matrix_diagonals(
+    global_rows,
+    local_dof_indices,
+    local_matrix,
+    *this,
+    global_matrix,
+    global_vector,
+    use_inhomogeneities_for_rhs,
+    /*lock_rows = */ true);
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::distribute_local_to_global_concurrently(
+  const FullMatrix<number> &    local_matrix,
+  const std::vector<size_type> &local_dof_indices,
+  SparseMatrix<number> &        global_matrix) const
+{
+  // create a dummy and hand on to the function above
+  Vector<number> dummy(0);
+  distribute_local_to_global_concurrently(
+    local_matrix, dummy, local_dof_indices, global_matrix, dummy);
+}
+
+
+
 // similar function as above, but now specialized for block matrices. See the
 // other function for additional comments.
 template <typename number>
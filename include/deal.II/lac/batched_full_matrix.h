@@ -0,0 +1,324 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_batched_full_matrix_h
+#define dealii_batched_full_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/vectorization.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class Vector;
+template <typename number>
+class FullMatrix;
+#endif
+
+/**
+ * A collection of many small square matrices of the same size, together with
+ * their LU or Cholesky factorizations. The class is meant for the setting
+ * where thousands of local matrices of size, say, 20 to 150 need to be
+ * factored and solved with, as in block-Jacobi preconditioners, static
+ * condensation, or the local solvers of hybridized methods, and where the
+ * overhead of calling FullMatrix::gauss_jordan() or
+ * LAPACKFullMatrix::compute_lu_factorization() on each matrix separately
+ * dominates.
+ *
+ * The matrices are stored interleaved in batches of
+ * VectorizedArray<number>::size() matrices, i.e., entry $(i,j)$ of all
+ * matrices of a batch is held by one VectorizedArray. The factorizations
+ * thus run on all matrices of a batch at once with SIMD instructions, and
+ * the batches are processed in parallel. Only the search for pivots and the
+ * resulting row interchanges of the LU factorization work on the individual
+ * lanes.
+ *
+ * After reinit(), all matrices are identity matrices, and matrices smaller
+ * than n() can be set by set_matrix(). They are embedded into the leading
+ * block of the identity, which keeps the factorization and solves with the
+ * smaller matrix exact. This allows to collect blocks of different sizes
+ * as they appear in RelaxationBlock in one object.
+ *
+ * @ingroup Matrix1
+ */
+template <typename number>
+class BatchedFullMatrix
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = unsigned int;
+
+  /**
+   * Number of matrices stored interleaved in one batch.
+   */
+  static constexpr unsigned int n_lanes = VectorizedArray<number>::size();
+
+  /**
+   * Constructor. Initialize an empty object.
+   */
+  BatchedFullMatrix();
+
+  /**
+   * Constructor. Same as calling reinit() with the given arguments.
+   */
+  BatchedFullMatrix(const size_type n_matrices, const size_type n);
+
+  /**
+   * Set the number of matrices to @p n_matrices and their size to @p n
+   * times @p n. All matrices are set to the identity matrix.
+   */
+  void
+  reinit(const size_type n_matrices, const size_type n);
+
+  /**
+   * Return the number of matrices.
+   */
+  size_type
+  n_matrices() const;
+
+  /**
+   * Return the number of rows (and columns) of each matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of batches of matrices stored interleaved.
+   */
+  size_type
+  n_batches() const;
+
+  /**
+   * Read-write access to entry $(i,j)$ of the matrix with index @p index.
+   * Only allowed before one of the factorizations has been computed.
+   */
+  number &
+  operator()(const size_type index, const size_type i, const size_type j);
+
+  /**
+   * Read access to entry $(i,j)$ of the matrix with index @p index, or of its
+   * factorization once computed.
+   */
+  const number &
+  operator()(const size_type index,
+             const size_type i,
+             const size_type j) const;
+
+  /**
+   * Set the matrix with index @p index to @p matrix, which must be square
+   * and have at most n() rows. Entries outside of @p matrix are set to those
+   * of the identity matrix. This function can be called concurrently for
+   * different indices.
+   */
+  template <typename number2>
+  void
+  set_matrix(const size_type index, const FullMatrix<number2> &matrix);
+
+  /**
+   * Compute the LU factorization with partial pivoting of all matrices.
+   * Throws LACExceptions::ExcSingular if one of the matrices is singular.
+   */
+  void
+  compute_lu_factorization();
+
+  /**
+   * Compute the Cholesky factorization of all matrices, which must be
+   * symmetric and positive definite. Only the lower triangle of the matrices
+   * is accessed.
+   */
+  void
+  compute_cholesky_factorization();
+
+  /**
+   * Solve the linear system with the matrix with index @p index (or its
+   * transpose, if @p transposed is set) and right hand side @p v in place,
+   * using the factorization previously computed. The vector @p v can have
+   * fewer than n() entries if the matrix was set by set_matrix() with a
+   * matrix of that size.
+   */
+  template <typename number2>
+  void
+  solve(const size_type   index,
+        Vector<number2> & v,
+        const bool        transposed = false) const;
+
+  /**
+   * Solve the linear systems of all matrices in batch @p batch at once,
+   * with the right hand sides given with the same interleaved layout in
+   * @p v of length n(). The solution overwrites @p v.
+   */
+  void
+  solve(const size_type                          batch,
+        const ArrayView<VectorizedArray<number>> &v,
+        const bool                               transposed = false) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Kind of data currently stored.
+   */
+  enum class State
+  {
+    /**
+     * The matrices themselves.
+     */
+    matrix,
+    /**
+     * The LU factorizations of the matrices.
+     */
+    lu,
+    /**
+     * The Cholesky factorizations of the matrices.
+     */
+    cholesky
+  };
+
+  /**
+   * Factorize the matrices of the batches in the half-open range
+   * [@p begin, @p end) by LU factorization with partial pivoting.
+   */
+  void
+  lu_factorization_range(const size_type begin, const size_type end);
+
+  /**
+   * Factorize the matrices of the batches in the half-open range
+   * [@p begin, @p end) by Cholesky factorization.
+   */
+  void
+  cholesky_factorization_range(const size_type begin, const size_type end);
+
+  /**
+   * The kind of data currently stored in @p values.
+   */
+  State state;
+
+  /**
+   * The number of matrices.
+   */
+  size_type n_stored_matrices;
+
+  /**
+   * The number of rows and columns of each matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * The matrix entries, with entry $(i,j)$ of the batch $b$ at position
+   * $(b n + i) n + j$.
+   */
+  AlignedVector<VectorizedArray<number>> values;
+
+  /**
+   * The inverse of the diagonal of the factor $U$ of the LU factorization or
+   * of the Cholesky factor, respectively, at position $b n + i$.
+   */
+  AlignedVector<VectorizedArray<number>> inverse_diagonal;
+
+  /**
+   * The row interchanges of the LU factorization: In step $k$, row $k$ of
+   * lane $l$ of batch $b$ has been exchanged with the row stored at
+   * position $(b n + k) \cdot n_\text{lanes} + l$.
+   */
+  std::vector<size_type> pivots;
+};
+
+
+
+/*---------------------- Inline functions -----------------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename number>
+inline typename BatchedFullMatrix<number>::size_type
+BatchedFullMatrix<number>::n_matrices() const
+{
+  return n_stored_matrices;
+}
+
+
+
+template <typename number>
+inline typename BatchedFullMatrix<number>::size_type
+BatchedFullMatrix<number>::n() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename BatchedFullMatrix<number>::size_type
+BatchedFullMatrix<number>::n_batches() const
+{
+  return (n_stored_matrices + n_lanes - 1) / n_lanes;
+}
+
+
+
+template <typename number>
+inline number &
+BatchedFullMatrix<number>::operator()(const size_type index,
+                                      const size_type i,
+                                      const size_type j)
+{
+  AssertIndexRange(index, n_stored_matrices);
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_rows);
+  Assert(state == State::matrix,
+         ExcMessage("The matrix entries cannot be changed once a "
+                    "factorization has been computed."));
+  return values[(static_cast<std::size_t>(index / n_lanes) * n_rows + i) *
+                  n_rows +
+                j][index % n_lanes];
+}
+
+
+
+template <typename number>
+inline const number &
+BatchedFullMatrix<number>::operator()(const size_type index,
+                                      const size_type i,
+                                      const size_type j) const
+{
+  AssertIndexRange(index, n_stored_matrices);
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_rows);
+  return values[(static_cast<std::size_t>(index / n_lanes) * n_rows + i) *
+                  n_rows +
+                j][index % n_lanes];
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
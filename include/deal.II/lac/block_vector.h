@@ -27,6 +27,7 @@
 #include <deal.II/lac/vector_type_traits.h>
 
 #include <cstdio>
+#include <string>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -361,6 +362,17 @@ public:
   void
   block_read(std::istream &in);
 
+  /**
+   * Make the blocks of this vector use the entries stored by block_write()
+   * in the file @p filename in place instead of reading them into memory,
+   * see Vector::map_file() for details and for the meaning of
+   * @p write_through. The vector must have as many blocks as the one that
+   * was written to the file, but the sizes of the blocks are taken from the
+   * file.
+   */
+  void
+  map_file(const std::string &filename, const bool write_through = false);
+
   /**
    * @addtogroup Exceptions
    * @{
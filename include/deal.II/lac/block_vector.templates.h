@@ -206,6 +206,20 @@ BlockVector<Number>::block_read(std::istream &in)
 
 
 
+template <typename Number>
+void
+BlockVector<Number>::map_file(const std::string &filename,
+                              const bool         write_through)
+{
+  std::size_t offset = 0;
+  for (size_type i = 0; i < this->n_blocks(); ++i)
+    offset = this->components[i].map_file(filename, offset, write_through);
+
+  this->collect_sizes();
+}
+
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -21,6 +21,7 @@
 
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/chunk_sparse_matrix.h>
 #include <deal.II/lac/full_matrix.h>
@@ -165,6 +166,191 @@ namespace internal
 
 
 
+    /**
+     * Return the SIMD width used for the rows of chunks of size
+     * @p chunk_size, i.e., the largest width supported by VectorizedArray
+     * for @p Number that divides @p chunk_size.
+     */
+    template <typename Number>
+    constexpr std::size_t
+    chunk_simd_width(const std::size_t chunk_size)
+    {
+      std::size_t width = VectorizedArray<Number>::size();
+      while (width > 1 &&
+             (chunk_size % width != 0 || width * sizeof(Number) < 16))
+        width /= 2;
+      return width;
+    }
+
+
+
+    /**
+     * Add the product of the chunks in one chunk row, given by the values
+     * starting at @p val_ptr and the chunk columns in the range
+     * [@p colnum_ptr, @p colnum_end), with the source vector to the
+     * destination vector fragment @p dst_ptr, for a chunk size known at
+     * compile time. The chunk column @p irregular_col contains padding and
+     * only its first @p n_filled_last_cols columns are used.
+     *
+     * This general version is used for mixed precision and block vectors.
+     */
+    template <unsigned int chunk_size,
+              typename number,
+              typename InVector,
+              typename OutVector,
+              typename = void>
+    struct ChunkRowVmult
+    {
+      static void
+      add(const number *                val_ptr,
+          const size_type *             colnum_ptr,
+          const size_type *const        colnum_end,
+          const size_type               irregular_col,
+          const size_type               n_filled_last_cols,
+          const InVector &              src,
+          typename OutVector::iterator &dst_ptr)
+      {
+        for (; colnum_ptr != colnum_end;
+             ++colnum_ptr, val_ptr += chunk_size * chunk_size)
+          if (*colnum_ptr != irregular_col)
+            chunk_vmult_add(chunk_size,
+                            val_ptr,
+                            src.begin() + *colnum_ptr * chunk_size,
+                            dst_ptr);
+          else
+            for (size_type r = 0; r < chunk_size; ++r)
+              for (size_type c = 0; c < n_filled_last_cols; ++c)
+                dst_ptr[r] += (val_ptr[r * chunk_size + c] *
+                               src(*colnum_ptr * chunk_size + c));
+      }
+    };
+
+
+
+    /**
+     * Vectorized version of the above for matrix and vectors with the same
+     * floating point type and contiguous storage. Rather than forming a dot
+     * product for every row of every chunk, the products of a row of a chunk
+     * with the source vector are accumulated lane-wise over all chunks of the
+     * chunk row, and the horizontal sums are only taken at the end of the
+     * chunk row.
+     */
+    template <unsigned int chunk_size,
+              typename number,
+              typename InVector,
+              typename OutVector>
+    struct ChunkRowVmult<
+      chunk_size,
+      number,
+      InVector,
+      OutVector,
+      typename std::enable_if<
+        (std::is_same<number, double>::value ||
+         std::is_same<number, float>::value) &&
+        std::is_same<number, typename InVector::value_type>::value &&
+        std::is_same<number, typename OutVector::value_type>::value &&
+        std::is_pointer<typename InVector::const_iterator>::value &&
+        std::is_pointer<typename OutVector::iterator>::value &&
+        (chunk_simd_width<number>(chunk_size) > 1)>::type>
+    {
+      static void
+      add(const number *                val_ptr,
+          const size_type *             colnum_ptr,
+          const size_type *const        colnum_end,
+          const size_type               irregular_col,
+          const size_type               n_filled_last_cols,
+          const InVector &              src,
+          typename OutVector::iterator &dst_ptr)
+      {
+        constexpr std::size_t width     = chunk_simd_width<number>(chunk_size);
+        constexpr std::size_t n_vectors = chunk_size / width;
+        using VectorType                = VectorizedArray<number, width>;
+
+        VectorType sums[chunk_size][n_vectors];
+        for (unsigned int i = 0; i < chunk_size; ++i)
+          for (unsigned int v = 0; v < n_vectors; ++v)
+            sums[i][v] = number();
+
+        const number *src_ptr = src.begin();
+        for (; colnum_ptr != colnum_end;
+             ++colnum_ptr, val_ptr += chunk_size * chunk_size)
+          if (*colnum_ptr != irregular_col)
+            {
+              VectorType src_values[n_vectors];
+              for (unsigned int v = 0; v < n_vectors; ++v)
+                src_values[v].load(src_ptr + *colnum_ptr * chunk_size +
+                                   v * width);
+              for (unsigned int i = 0; i < chunk_size; ++i)
+                for (unsigned int v = 0; v < n_vectors; ++v)
+                  {
+                    VectorType matrix_values;
+                    matrix_values.load(val_ptr + i * chunk_size + v * width);
+                    sums[i][v] += matrix_values * src_values[v];
+                  }
+            }
+          else
+            for (size_type r = 0; r < chunk_size; ++r)
+              for (size_type c = 0; c < n_filled_last_cols; ++c)
+                dst_ptr[r] += (val_ptr[r * chunk_size + c] *
+                               src_ptr[*colnum_ptr * chunk_size + c]);
+
+        for (unsigned int i = 0; i < chunk_size; ++i)
+          {
+            number sum = 0;
+            for (unsigned int v = 0; v < n_vectors; ++v)
+              for (unsigned int l = 0; l < width; ++l)
+                sum += sums[i][v][l];
+            dst_ptr[i] += sum;
+          }
+      }
+    };
+
+
+
+    /**
+     * Perform the vmult_add for the chunk rows in the half-open range
+     * [@p begin_row, @p end_row), none of which may contain padding rows,
+     * with a chunk size known at compile time. The pointers into the values
+     * and column arrays as well as the destination iterator are advanced to
+     * the end of the range.
+     */
+    template <unsigned int chunk_size,
+              typename number,
+              typename InVector,
+              typename OutVector>
+    void
+    vmult_add_regular_chunk_rows(
+      const unsigned int            begin_row,
+      const unsigned int            end_row,
+      const size_type               irregular_col,
+      const size_type               n_filled_last_cols,
+      const std::size_t *           rowstart,
+      const size_type *             colnums,
+      const number *&               val_ptr,
+      const size_type *&            colnum_ptr,
+      const InVector &              src,
+      typename OutVector::iterator &dst_ptr)
+    {
+      for (unsigned int chunk_row = begin_row; chunk_row < end_row;
+           ++chunk_row)
+        {
+          const size_type *const colnum_end = &colnums[rowstart[chunk_row + 1]];
+          ChunkRowVmult<chunk_size, number, InVector, OutVector>::add(
+            val_ptr,
+            colnum_ptr,
+            colnum_end,
+            irregular_col,
+            n_filled_last_cols,
+            src,
+            dst_ptr);
+          val_ptr += (colnum_end - colnum_ptr) * chunk_size * chunk_size;
+          colnum_ptr = colnum_end;
+          dst_ptr += chunk_size;
+        }
+    }
+
+
+
     /**
      * Perform a vmult_add using the ChunkSparseMatrix data structures, but
      * only using a subinterval of the matrix rows.
@@ -204,31 +390,84 @@ namespace internal
       const number *val_ptr =
         &values[rowstart[begin_row] * chunk_size * chunk_size];
       const size_type *colnum_ptr = &colnums[rowstart[begin_row]];
-      for (unsigned int chunk_row = begin_row; chunk_row < last_regular_row;
-           ++chunk_row)
-        {
-          const number *const val_end_of_row =
-            &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
-          while (val_ptr != val_end_of_row)
-            {
-              if (*colnum_ptr != irregular_col)
-                chunk_vmult_add(chunk_size,
-                                val_ptr,
-                                src.begin() + *colnum_ptr * chunk_size,
-                                dst_ptr);
-              else
-                // we're at a chunk column that has padding
-                for (size_type r = 0; r < chunk_size; ++r)
-                  for (size_type c = 0; c < n_filled_last_cols; ++c)
-                    dst_ptr[r] += (val_ptr[r * chunk_size + c] *
-                                   src(*colnum_ptr * chunk_size + c));
 
-              ++colnum_ptr;
-              val_ptr += chunk_size * chunk_size;
-            }
+      // use kernels with compile-time loop bounds for common chunk sizes
+      // that arise, for example, from vector-valued problems with two,
+      // three, or four components
+      if (chunk_size == 2)
+        vmult_add_regular_chunk_rows<2, number, InVector, OutVector>(
+          begin_row,
+          last_regular_row,
+          irregular_col,
+          n_filled_last_cols,
+          rowstart,
+          colnums,
+          val_ptr,
+          colnum_ptr,
+          src,
+          dst_ptr);
+      else if (chunk_size == 3)
+        vmult_add_regular_chunk_rows<3, number, InVector, OutVector>(
+          begin_row,
+          last_regular_row,
+          irregular_col,
+          n_filled_last_cols,
+          rowstart,
+          colnums,
+          val_ptr,
+          colnum_ptr,
+          src,
+          dst_ptr);
+      else if (chunk_size == 4)
+        vmult_add_regular_chunk_rows<4, number, InVector, OutVector>(
+          begin_row,
+          last_regular_row,
+          irregular_col,
+          n_filled_last_cols,
+          rowstart,
+          colnums,
+          val_ptr,
+          colnum_ptr,
+          src,
+          dst_ptr);
+      else if (chunk_size == 8)
+        vmult_add_regular_chunk_rows<8, number, InVector, OutVector>(
+          begin_row,
+          last_regular_row,
+          irregular_col,
+          n_filled_last_cols,
+          rowstart,
+          colnums,
+          val_ptr,
+          colnum_ptr,
+          src,
+          dst_ptr);
+      else
+        for (unsigned int chunk_row = begin_row; chunk_row < last_regular_row;
+             ++chunk_row)
+          {
+            const number *const val_end_of_row =
+              &values[rowstart[chunk_row + 1] * chunk_size * chunk_size];
+            while (val_ptr != val_end_of_row)
+              {
+                if (*colnum_ptr != irregular_col)
+                  chunk_vmult_add(chunk_size,
+                                  val_ptr,
+                                  src.begin() + *colnum_ptr * chunk_size,
+                                  dst_ptr);
+                else
+                  // we're at a chunk column that has padding
+                  for (size_type r = 0; r < chunk_size; ++r)
+                    for (size_type c = 0; c < n_filled_last_cols; ++c)
+                      dst_ptr[r] += (val_ptr[r * chunk_size + c] *
+                                     src(*colnum_ptr * chunk_size + c));
 
-          dst_ptr += chunk_size;
-        }
+                ++colnum_ptr;
+                val_ptr += chunk_size * chunk_size;
+              }
+
+            dst_ptr += chunk_size;
+          }
 
       // now deal with last chunk row if necessary
       if (n_filled_last_rows > 0 && end_row == (m / chunk_size + 1))
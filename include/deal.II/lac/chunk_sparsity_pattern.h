@@ -510,6 +510,30 @@ public:
   void
   copy_from(const SparsityPatternType &dsp, const size_type chunk_size);
 
+  /**
+   * Same as above, but with the chunk size chosen automatically by
+   * determine_chunk_size().
+   */
+  template <typename SparsityPatternType>
+  void
+  copy_from(const SparsityPatternType &dsp);
+
+  /**
+   * Determine a chunk size for the sparsity pattern @p dsp among the chunk
+   * sizes 1, 2, 3, 4, and 8, for which ChunkSparseMatrix has specialized
+   * kernels. For each candidate, the function counts the chunks needed to
+   * cover all entries of @p dsp and selects the chunk size that minimizes
+   * the memory of matrix values (including the zeros with which chunks are
+   * filled up) and column indices, which is what a matrix-vector product
+   * has to read. A chunk size larger than one thus only wins if the
+   * entries of @p dsp come in blocks that are mostly filled, as is the case
+   * for vector-valued problems where all components of a support point are
+   * numbered consecutively.
+   */
+  template <typename SparsityPatternType>
+  static size_type
+  determine_chunk_size(const SparsityPatternType &dsp);
+
   /**
    * Take a full matrix and use its nonzero entries to generate a sparse
    * matrix entry pattern for this object.
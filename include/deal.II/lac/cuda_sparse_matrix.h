@@ -372,6 +372,19 @@ namespace CUDAWrappers
      * cuSPARSE description of the sparse matrix.
      */
     cusparseSpMatDescr_t sp_descr;
+
+    /**
+     * Workspace (on the device) required by cuSPARSE for the matrix-vector
+     * products. It is allocated on first use, reused by all subsequent
+     * calls to vmult(), Tvmult(), vmult_add(), and Tvmult_add(), and only
+     * reallocated if a larger workspace is requested.
+     */
+    mutable std::unique_ptr<char[], void (*)(char *)> buffer_dev;
+
+    /**
+     * Size in bytes of the workspace pointed to by buffer_dev.
+     */
+    mutable std::size_t buffer_size;
   };
 
 
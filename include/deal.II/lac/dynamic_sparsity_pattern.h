@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_tracker.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/utilities.h>
 
@@ -378,6 +379,11 @@ public:
    */
   DynamicSparsityPattern(const size_type n);
 
+  /**
+   * Destructor.
+   */
+  ~DynamicSparsityPattern() override;
+
   /**
    * Copy operator. For this the same holds as for the copy constructor: it is
    * declared, defined and fine to be called, but the latter only for empty
@@ -730,6 +736,20 @@ private:
    */
   std::vector<Line> lines;
 
+  /**
+   * The number of bytes of #lines and the rows stored therein that have been
+   * reported to MemoryTracker.
+   */
+  std::size_t n_tracked_bytes;
+
+  /**
+   * Report to MemoryTracker that the capacity of the entries of a row
+   * changed from @p old_capacity to @p new_capacity.
+   */
+  void
+  track_capacity_change(const std::size_t old_capacity,
+                        const std::size_t new_capacity);
+
   // make the accessor class a friend
   friend class DynamicSparsityPatternIterators::Accessor;
 };
@@ -1036,7 +1056,14 @@ DynamicSparsityPattern::add(const size_type i, const size_type j)
 
   const size_type rowindex =
     rowset.size() == 0 ? i : rowset.index_within_set(i);
-  lines[rowindex].add(j);
+  if (MemoryTracker::is_enabled())
+    {
+      const std::size_t old_capacity = lines[rowindex].entries.capacity();
+      lines[rowindex].add(j);
+      track_capacity_change(old_capacity, lines[rowindex].entries.capacity());
+    }
+  else
+    lines[rowindex].add(j);
 }
 
 
@@ -1058,7 +1085,41 @@ DynamicSparsityPattern::add_entries(const size_type row,
 
   const size_type rowindex =
     rowset.size() == 0 ? row : rowset.index_within_set(row);
-  lines[rowindex].add_entries(begin, end, indices_are_sorted);
+  if (MemoryTracker::is_enabled())
+    {
+      const std::size_t old_capacity = lines[rowindex].entries.capacity();
+      lines[rowindex].add_entries(begin, end, indices_are_sorted);
+      track_capacity_change(old_capacity, lines[rowindex].entries.capacity());
+    }
+  else
+    lines[rowindex].add_entries(begin, end, indices_are_sorted);
+}
+
+
+
+inline void
+DynamicSparsityPattern::track_capacity_change(const std::size_t old_capacity,
+                                              const std::size_t new_capacity)
+{
+  if (new_capacity > old_capacity)
+    {
+      const std::size_t n_bytes =
+        (new_capacity - old_capacity) * sizeof(size_type);
+      MemoryTracker::allocate(MemoryTracker::dynamic_sparsity_pattern,
+                              n_bytes);
+      n_tracked_bytes += n_bytes;
+    }
+  else if (new_capacity < old_capacity)
+    {
+      // the row may have been filled while tracking was disabled, so do not
+      // release more than was reported
+      const std::size_t n_bytes =
+        std::min((old_capacity - new_capacity) * sizeof(size_type),
+                 n_tracked_bytes);
+      MemoryTracker::deallocate(MemoryTracker::dynamic_sparsity_pattern,
+                                n_bytes);
+      n_tracked_bytes -= n_bytes;
+    }
 }
 
 
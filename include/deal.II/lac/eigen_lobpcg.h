@@ -0,0 +1,609 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_eigen_lobpcg_h
+#define dealii_eigen_lobpcg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_memory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * Locally optimal block preconditioned conjugate gradient method (LOBPCG)
+ * for computing the smallest eigenvalues and the corresponding eigenvectors
+ * of the symmetric generalized eigenvalue problem $Ax = \lambda Bx$ with
+ * symmetric positive definite $B$.
+ *
+ * The method iterates on a block of $m$ vectors $X$ at once, where $m$ is
+ * the number of requested eigenpairs. In each step, the preconditioned
+ * residuals $W = T(AX - BX\Lambda)$ are computed, and the new approximation
+ * of the eigenvectors is obtained by a Rayleigh-Ritz procedure on the space
+ * spanned by $X$, $W$ and the previous search directions $P$, see
+ * A. V. Knyazev, Toward the optimal preconditioned eigensolver: Locally
+ * optimal block preconditioned conjugate gradient method, SIAM J. Sci.
+ * Comput. 23 (2001), pp. 517-541.
+ *
+ * In contrast to ArpackSolver, PArpackSolver or the SLEPcWrappers, this
+ * class only needs the application of $A$, $B$ and of the preconditioner
+ * $T$ to single vectors through <tt>vmult()</tt>, so it can be used with
+ * matrix-free operators and, e.g., a geometric multigrid preconditioner
+ * (wrapped in a PreconditionMG object) approximating the inverse of $A$.
+ * The scalar products needed by the Rayleigh-Ritz procedure are computed
+ * for whole blocks of vectors at once. For
+ * LinearAlgebra::distributed::Vector, this is done with a single global
+ * reduction per block product instead of one reduction per scalar product.
+ *
+ * The Rayleigh-Ritz procedure orthonormalizes the basis $[X, W, P]$ with
+ * respect to $B$ by an eigenvalue decomposition of its Gram matrix and drops
+ * directions that are numerically linearly dependent, which keeps the
+ * method stable also close to convergence. The small dense eigenvalue
+ * problems are solved with LAPACK.
+ *
+ * The iteration stops when the largest $l_2$ norm of the residuals
+ * $Ax_i-\lambda_i Bx_i$ satisfies the given SolverControl object. Since
+ * this criterion depends on the scaling of the eigenvectors, they are kept
+ * normalized with respect to $B$.
+ */
+template <typename VectorType = Vector<double>>
+class EigenLOBPCG : private SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type of container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Relative threshold below which eigenvalues of the Gram matrix of the
+     * search space are considered zero, i.e., the corresponding directions
+     * are dropped from the search space as linearly dependent.
+     */
+    double linear_dependence_tolerance;
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double linear_dependence_tolerance = 1e-12)
+      : linear_dependence_tolerance(linear_dependence_tolerance)
+    {}
+  };
+
+  /**
+   * Constructor.
+   */
+  EigenLOBPCG(SolverControl &           cn,
+              VectorMemory<VectorType> &mem,
+              const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  EigenLOBPCG(SolverControl &cn, const AdditionalData &data = AdditionalData());
+
+  /**
+   * Compute the smallest <tt>eigenvectors.size()</tt> eigenvalues of
+   * $Ax=\lambda Bx$.
+   *
+   * On input, @p eigenvectors contains the start vectors of the iteration,
+   * which must be linearly independent. On output, it contains the
+   * approximate eigenvectors, orthonormal with respect to $B$, and
+   * @p eigenvalues the corresponding eigenvalues in ascending order.
+   *
+   * The @p preconditioner should approximate the inverse of $A$ (or of a
+   * shifted operator $A-\sigma B$ with $\sigma$ below the wanted
+   * eigenvalues). Use PreconditionIdentity for $B$ and $T$ to solve a
+   * standard eigenvalue problem without preconditioning.
+   */
+  template <typename MatrixType,
+            typename MassMatrixType,
+            typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        const MassMatrixType &    B,
+        const PreconditionerType &preconditioner,
+        std::vector<double> &     eigenvalues,
+        std::vector<VectorType> & eigenvectors);
+
+protected:
+  /**
+   * Flags for execution.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+
+namespace internal
+{
+  namespace EigenLOBPCGImplementation
+  {
+    /**
+     * Compute the matrix of scalar products $G_{ij} = u_i \cdot v_j$. The
+     * general version computes each entry with the scalar product of the
+     * vector type.
+     */
+    template <typename VectorType>
+    void
+    gram_matrix(const std::vector<VectorType *> &u,
+                const std::vector<VectorType *> &v,
+                FullMatrix<double> &             gram)
+    {
+      gram.reinit(u.size(), v.size());
+      for (unsigned int i = 0; i < u.size(); ++i)
+        for (unsigned int j = 0; j < v.size(); ++j)
+          gram(i, j) = (*u[i]) * (*v[j]);
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector. All entries are
+     * computed from the locally owned elements in one pass over the vectors,
+     * which works on chunks of elements that fit into cache, and are then
+     * summed up with a single global reduction.
+     */
+    template <typename Number>
+    void
+    gram_matrix(
+      const std::vector<LinearAlgebra::distributed::Vector<Number> *> &u,
+      const std::vector<LinearAlgebra::distributed::Vector<Number> *> &v,
+      FullMatrix<double> &                                             gram)
+    {
+      gram.reinit(u.size(), v.size());
+      if (u.empty() || v.empty())
+        return;
+
+      const unsigned int local_size = u[0]->locally_owned_size();
+      const unsigned int chunk_size = 256;
+      for (unsigned int begin = 0; begin < local_size; begin += chunk_size)
+        {
+          const unsigned int end = std::min(begin + chunk_size, local_size);
+          for (unsigned int i = 0; i < u.size(); ++i)
+            {
+              const Number *u_i = u[i]->begin();
+              for (unsigned int j = 0; j < v.size(); ++j)
+                {
+                  const Number *v_j = v[j]->begin();
+                  double        sum = 0.;
+                  for (unsigned int k = begin; k < end; ++k)
+                    sum += static_cast<double>(u_i[k]) * v_j[k];
+                  gram(i, j) += sum;
+                }
+            }
+        }
+
+      Utilities::MPI::sum(
+        ArrayView<const double>(&gram(0, 0), gram.m() * gram.n()),
+        u[0]->get_mpi_communicator(),
+        ArrayView<double>(&gram(0, 0), gram.m() * gram.n()));
+    }
+
+
+
+    /**
+     * Compute the squared $l_2$ norms of all vectors in @p u.
+     */
+    template <typename VectorType>
+    void
+    norms_squared(const std::vector<VectorType *> &u,
+                  std::vector<double> &            norms)
+    {
+      norms.resize(u.size());
+      for (unsigned int i = 0; i < u.size(); ++i)
+        norms[i] = u[i]->norm_sqr();
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, using a single
+     * global reduction.
+     */
+    template <typename Number>
+    void
+    norms_squared(
+      const std::vector<LinearAlgebra::distributed::Vector<Number> *> &u,
+      std::vector<double> &                                            norms)
+    {
+      norms.assign(u.size(), 0.);
+      if (u.empty())
+        return;
+
+      for (unsigned int i = 0; i < u.size(); ++i)
+        for (unsigned int k = 0; k < u[i]->locally_owned_size(); ++k)
+          norms[i] += static_cast<double>(u[i]->local_element(k)) *
+                      u[i]->local_element(k);
+
+      Utilities::MPI::sum(ArrayView<const double>(norms),
+                          u[0]->get_mpi_communicator(),
+                          ArrayView<double>(norms));
+    }
+
+
+
+    /**
+     * Set <tt>dst[j] = sum_i coefficients(row_offset + i, j) src[i]</tt>.
+     */
+    template <typename VectorType>
+    void
+    linear_combination(const std::vector<VectorType *> &src,
+                       const FullMatrix<double> &       coefficients,
+                       const unsigned int               row_offset,
+                       const std::vector<VectorType *> &dst)
+    {
+      for (unsigned int j = 0; j < dst.size(); ++j)
+        {
+          *dst[j] = 0.;
+          for (unsigned int i = 0; i < src.size(); ++i)
+            dst[j]->add(coefficients(row_offset + i, j), *src[i]);
+        }
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, in one pass over
+     * all vectors.
+     */
+    template <typename Number>
+    void
+    linear_combination(
+      const std::vector<LinearAlgebra::distributed::Vector<Number> *> &src,
+      const FullMatrix<double> &coefficients,
+      const unsigned int        row_offset,
+      const std::vector<LinearAlgebra::distributed::Vector<Number> *> &dst)
+    {
+      if (dst.empty())
+        return;
+
+      const unsigned int local_size = dst[0]->locally_owned_size();
+      for (unsigned int k = 0; k < local_size; ++k)
+        for (unsigned int j = 0; j < dst.size(); ++j)
+          {
+            double sum = 0.;
+            for (unsigned int i = 0; i < src.size(); ++i)
+              sum += coefficients(row_offset + i, j) * src[i]->local_element(k);
+            dst[j]->local_element(k) = sum;
+          }
+    }
+
+
+
+    /**
+     * Rayleigh-Ritz procedure: given the Gram matrices $S^TAS$ and $S^TBS$
+     * of a basis $S$ of the search space, compute the coefficients of the
+     * @p n_wanted Ritz vectors with the smallest Ritz values with respect to
+     * $S$. The basis is orthonormalized with respect to $B$ by an eigenvalue
+     * decomposition of the (diagonally scaled) matrix $S^TBS$, dropping all
+     * directions whose eigenvalue is below @p tolerance times the largest
+     * one. Return false if fewer than @p n_wanted directions remain.
+     */
+    inline bool
+    rayleigh_ritz(const FullMatrix<double> &gram_a,
+                  const FullMatrix<double> &gram_b,
+                  const unsigned int        n_wanted,
+                  const double              tolerance,
+                  std::vector<double> &     ritz_values,
+                  FullMatrix<double> &      coefficients)
+    {
+      const unsigned int n = gram_b.m();
+      const double max     = std::numeric_limits<double>::max();
+
+      // scale the basis vectors to unit B-norm, which improves the accuracy
+      // of the eigenvalue decomposition below
+      Vector<double> scaling(n);
+      for (unsigned int i = 0; i < n; ++i)
+        scaling(i) = gram_b(i, i) > 0. ? 1. / std::sqrt(gram_b(i, i)) : 0.;
+
+      LAPACKFullMatrix<double> b_scaled(n, n);
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n; ++j)
+          b_scaled(i, j) =
+            0.5 * (gram_b(i, j) + gram_b(j, i)) * scaling(i) * scaling(j);
+
+      Vector<double>     b_eigenvalues;
+      FullMatrix<double> b_eigenvectors;
+      b_scaled.compute_eigenvalues_symmetric(
+        -max, max, 0., b_eigenvalues, b_eigenvectors);
+
+      // B-orthonormal basis of the search space, in terms of S
+      const double threshold =
+        tolerance * b_eigenvalues(b_eigenvalues.size() - 1);
+      std::vector<unsigned int> kept;
+      for (unsigned int k = 0; k < b_eigenvalues.size(); ++k)
+        if (b_eigenvalues(k) > threshold)
+          kept.push_back(k);
+      if (kept.size() < n_wanted)
+        return false;
+
+      FullMatrix<double> basis(n, kept.size());
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int c = 0; c < kept.size(); ++c)
+          basis(i, c) = scaling(i) * b_eigenvectors(i, kept[c]) /
+                        std::sqrt(b_eigenvalues(kept[c]));
+
+      // project A onto this basis and solve the reduced eigenvalue problem
+      FullMatrix<double> a_reduced(kept.size(), kept.size());
+      a_reduced.triple_product(gram_a, basis, basis, true, false);
+
+      LAPACKFullMatrix<double> a_symmetric(kept.size(), kept.size());
+      for (unsigned int i = 0; i < kept.size(); ++i)
+        for (unsigned int j = 0; j < kept.size(); ++j)
+          a_symmetric(i, j) = 0.5 * (a_reduced(i, j) + a_reduced(j, i));
+
+      Vector<double>     a_eigenvalues;
+      FullMatrix<double> a_eigenvectors;
+      a_symmetric.compute_eigenvalues_symmetric(
+        -max, max, 0., a_eigenvalues, a_eigenvectors);
+
+      ritz_values.resize(n_wanted);
+      FullMatrix<double> wanted_eigenvectors(kept.size(), n_wanted);
+      for (unsigned int j = 0; j < n_wanted; ++j)
+        {
+          ritz_values[j] = a_eigenvalues(j);
+          for (unsigned int i = 0; i < kept.size(); ++i)
+            wanted_eigenvectors(i, j) = a_eigenvectors(i, j);
+        }
+
+      coefficients.reinit(n, n_wanted);
+      basis.mmult(coefficients, wanted_eigenvectors);
+
+      return true;
+    }
+  } // namespace EigenLOBPCGImplementation
+} // namespace internal
+
+//---------------------------------------------------------------------------
+
+
+template <class VectorType>
+EigenLOBPCG<VectorType>::EigenLOBPCG(SolverControl &           cn,
+                                     VectorMemory<VectorType> &mem,
+                                     const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+EigenLOBPCG<VectorType>::EigenLOBPCG(SolverControl &       cn,
+                                     const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+template <typename MatrixType,
+          typename MassMatrixType,
+          typename PreconditionerType>
+void
+EigenLOBPCG<VectorType>::solve(const MatrixType &        A,
+                               const MassMatrixType &    B,
+                               const PreconditionerType &preconditioner,
+                               std::vector<double> &     eigenvalues,
+                               std::vector<VectorType> & eigenvectors)
+{
+  using namespace internal::EigenLOBPCGImplementation;
+
+  LogStream::Prefix prefix("LOBPCG");
+
+  const unsigned int n_wanted = eigenvectors.size();
+  Assert(n_wanted > 0, ExcMessage("At least one start vector is needed."));
+  Assert(3 * n_wanted <= eigenvectors[0].size(),
+         ExcMessage("The number of requested eigenvalues is too large for "
+                    "the size of the problem."));
+
+  // Allocate the blocks of vectors X, W, P and their products with A and B.
+  // The search space S = [X, W, P] and its products are stored as lists of
+  // pointers into these blocks.
+  std::vector<typename VectorMemory<VectorType>::Pointer> storage;
+  const auto allocate_block = [&]() {
+    std::vector<VectorType *> block(n_wanted);
+    for (unsigned int i = 0; i < n_wanted; ++i)
+      {
+        storage.emplace_back(this->memory);
+        storage.back()->reinit(eigenvectors[0], true);
+        block[i] = storage.back().get();
+      }
+    return block;
+  };
+
+  std::vector<VectorType *> x(n_wanted);
+  for (unsigned int i = 0; i < n_wanted; ++i)
+    x[i] = &eigenvectors[i];
+  const std::vector<VectorType *> ax = allocate_block();
+  const std::vector<VectorType *> bx = allocate_block();
+  const std::vector<VectorType *> w  = allocate_block();
+  const std::vector<VectorType *> aw = allocate_block();
+  const std::vector<VectorType *> bw = allocate_block();
+  const std::vector<VectorType *> p  = allocate_block();
+  const std::vector<VectorType *> ap = allocate_block();
+  const std::vector<VectorType *> bp = allocate_block();
+
+  // temporary blocks for the update of X, whose old values are still needed
+  // to compute the new search directions
+  const std::vector<VectorType *> x_new  = allocate_block();
+  const std::vector<VectorType *> ax_new = allocate_block();
+  const std::vector<VectorType *> bx_new = allocate_block();
+
+  const auto join = [](const std::vector<std::vector<VectorType *>> &blocks) {
+    std::vector<VectorType *> joined;
+    for (const auto &block : blocks)
+      joined.insert(joined.end(), block.begin(), block.end());
+    return joined;
+  };
+
+  const auto apply = [](const auto &                     op,
+                        const std::vector<VectorType *> &src,
+                        const std::vector<VectorType *> &dst) {
+    for (unsigned int i = 0; i < src.size(); ++i)
+      op.vmult(*dst[i], *src[i]);
+  };
+
+  FullMatrix<double>  gram_a, gram_b, coefficients;
+  std::vector<double> residual_norms;
+
+  // Rayleigh-Ritz procedure on the span of the start vectors, which also
+  // orthonormalizes them with respect to B
+  apply(A, x, ax);
+  apply(B, x, bx);
+  gram_matrix(x, ax, gram_a);
+  gram_matrix(x, bx, gram_b);
+  AssertThrow(rayleigh_ritz(gram_a,
+                            gram_b,
+                            n_wanted,
+                            additional_data.linear_dependence_tolerance,
+                            eigenvalues,
+                            coefficients),
+              ExcMessage("The start vectors are linearly dependent."));
+  linear_combination(x, coefficients, 0, x_new);
+  linear_combination(ax, coefficients, 0, ax_new);
+  linear_combination(bx, coefficients, 0, bx_new);
+  for (unsigned int i = 0; i < n_wanted; ++i)
+    {
+      *x[i]  = *x_new[i];
+      *ax[i] = *ax_new[i];
+      *bx[i] = *bx_new[i];
+    }
+
+  bool                 have_directions = false;
+  SolverControl::State conv            = SolverControl::iterate;
+  unsigned int         iter            = 0;
+  double               max_residual    = 0.;
+  for (;; ++iter)
+    {
+      // residuals R = AX - BX Lambda, stored in W
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          *w[i] = *ax[i];
+          w[i]->add(-eigenvalues[i], *bx[i]);
+        }
+      norms_squared(w, residual_norms);
+      max_residual = std::sqrt(
+        *std::max_element(residual_norms.begin(), residual_norms.end()));
+
+      conv = this->iteration_status(iter, max_residual, *x[0]);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // preconditioned residuals W = T R
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          *aw[i] = *w[i];
+          preconditioner.vmult(*w[i], *aw[i]);
+        }
+      apply(A, w, aw);
+      apply(B, w, bw);
+
+      // Rayleigh-Ritz procedure on the search space S = [X, W, P]
+      const std::vector<VectorType *> s =
+        have_directions ? join({x, w, p}) : join({x, w});
+      const std::vector<VectorType *> as =
+        have_directions ? join({ax, aw, ap}) : join({ax, aw});
+      const std::vector<VectorType *> bs =
+        have_directions ? join({bx, bw, bp}) : join({bx, bw});
+      gram_matrix(s, as, gram_a);
+      gram_matrix(s, bs, gram_b);
+
+      if (!rayleigh_ritz(gram_a,
+                         gram_b,
+                         n_wanted,
+                         additional_data.linear_dependence_tolerance,
+                         eigenvalues,
+                         coefficients))
+        {
+          // The search space has become degenerate. Restart without the
+          // previous search directions, which are the most likely cause.
+          AssertThrow(have_directions,
+                      ExcMessage("The LOBPCG search space is degenerate."));
+          have_directions = false;
+          continue;
+        }
+
+      // new search directions P = W C_W + P C_P, i.e., the part of the new
+      // Ritz vectors that is not in the span of X ...
+      const std::vector<VectorType *> wp = have_directions ? join({w, p}) : w;
+      const std::vector<VectorType *> awp =
+        have_directions ? join({aw, ap}) : aw;
+      const std::vector<VectorType *> bwp =
+        have_directions ? join({bw, bp}) : bw;
+      linear_combination(wp, coefficients, n_wanted, x_new);
+      linear_combination(awp, coefficients, n_wanted, ax_new);
+      linear_combination(bwp, coefficients, n_wanted, bx_new);
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          *p[i]  = *x_new[i];
+          *ap[i] = *ax_new[i];
+          *bp[i] = *bx_new[i];
+        }
+      have_directions = true;
+
+      // ... and new Ritz vectors X = X C_X + P
+      linear_combination(x, coefficients, 0, x_new);
+      linear_combination(ax, coefficients, 0, ax_new);
+      linear_combination(bx, coefficients, 0, bx_new);
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          *x[i] = *x_new[i];
+          *x[i] += *p[i];
+          *ax[i] = *ax_new[i];
+          *ax[i] += *ap[i];
+          *bx[i] = *bx_new[i];
+          *bx[i] += *bp[i];
+        }
+    }
+
+  // in case of failure: throw exception
+  AssertThrow(conv == SolverControl::success,
+              SolverControl::NoConvergence(iter, max_residual));
+
+  // otherwise exit as normal
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -26,7 +26,10 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/lapack_full_matrix.h>
@@ -501,6 +504,249 @@ FullMatrix<number>::equ(const number               a,
 
 
 
+namespace internal
+{
+  namespace FullMatrixImplementation
+  {
+    // The register- and cache-blocked matrix-matrix product below relies on
+    // VectorizedArray and is only implemented for floats and doubles. For all
+    // other types, FullMatrix falls back to the simple loops.
+    template <typename number, typename number2, typename = void>
+    struct BlockedProduct
+    {
+      static bool
+      is_applicable(const std::size_t, const std::size_t, const std::size_t)
+      {
+        return false;
+      }
+
+      static void
+      run(const std::size_t,
+          const std::size_t,
+          const std::size_t,
+          const number *,
+          const std::size_t,
+          const std::size_t,
+          const number2 *,
+          number2 *,
+          const bool)
+      {
+        Assert(false, ExcInternalError());
+      }
+    };
+
+
+
+    // Compute C = A B (or C += A B if 'adding' is set), where C is a
+    // row-major m x n matrix, B a row-major l x n matrix, and the entry (i,k)
+    // of the m x l matrix A is found at A[i*a_row_stride + k*a_col_stride].
+    // The latter allows to express the product with A^T without a copy.
+    //
+    // The algorithm follows the usual structure of optimized gemm
+    // implementations: The columns of C are split into blocks of nc columns
+    // that are worked on in parallel. For every block of kc rows of B, the
+    // block of B is copied into panels of nr VectorizedArray entries per row
+    // that are accessed contiguously by the micro-kernel, and blocks of mc
+    // rows of A are copied into panels of mr rows. The micro-kernel then
+    // keeps an mr x nr block of C in registers while going through kc
+    // entries. The copies also convert the entries of A to the type of C.
+    template <typename number, typename number2>
+    struct BlockedProduct<
+      number,
+      number2,
+      typename std::enable_if<(std::is_same<number, float>::value ||
+                               std::is_same<number, double>::value) &&
+                              (std::is_same<number2, float>::value ||
+                               std::is_same<number2, double>::value)>::type>
+    {
+      using VectorizedType = VectorizedArray<number2>;
+
+      static constexpr std::size_t n_lanes = VectorizedType::size();
+
+      // rows and columns (the latter in units of VectorizedArray) of the
+      // block of C kept in registers by the micro-kernel
+      static constexpr std::size_t mr = 4;
+      static constexpr std::size_t nr = 2;
+
+      // size of the blocks of A (with mc x kc entries) and B (with kc x nc
+      // entries) that are meant to stay in cache
+      static constexpr std::size_t mc = 64;
+      static constexpr std::size_t kc = 128;
+      static constexpr std::size_t nc = 32 * n_lanes;
+
+      static bool
+      is_applicable(const std::size_t m,
+                    const std::size_t n,
+                    const std::size_t l)
+      {
+        // below this size, the copies into the blocks do not pay off
+        return m >= mr && n >= nr * n_lanes && l > 0 && m * n * l >= 32768;
+      }
+
+      static void
+      run(const std::size_t m,
+          const std::size_t n,
+          const std::size_t l,
+          const number *    A,
+          const std::size_t a_row_stride,
+          const std::size_t a_col_stride,
+          const number2 *   B,
+          number2 *         C,
+          const bool        adding)
+      {
+        const std::size_t n_column_blocks = (n + nc - 1) / nc;
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_column_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t block = begin; block < end; ++block)
+              column_block(m,
+                           n,
+                           l,
+                           A,
+                           a_row_stride,
+                           a_col_stride,
+                           B,
+                           C,
+                           adding,
+                           block * nc,
+                           std::min(n, (block + 1) * nc));
+          },
+          1);
+      }
+
+    private:
+      static void
+      column_block(const std::size_t m,
+                   const std::size_t n,
+                   const std::size_t l,
+                   const number *    A,
+                   const std::size_t a_row_stride,
+                   const std::size_t a_col_stride,
+                   const number2 *   B,
+                   number2 *         C,
+                   const bool        adding,
+                   const std::size_t j_begin,
+                   const std::size_t j_end)
+      {
+        const std::size_t panel_width = nr * n_lanes;
+        const std::size_t n_panels =
+          (j_end - j_begin + panel_width - 1) / panel_width;
+
+        AlignedVector<VectorizedType> B_packed(n_panels * kc * nr);
+        std::vector<number2>          A_packed(mc * kc);
+
+        if (adding == false)
+          for (std::size_t i = 0; i < m; ++i)
+            std::fill(C + i * n + j_begin, C + i * n + j_end, number2());
+
+        for (std::size_t k_begin = 0; k_begin < l; k_begin += kc)
+          {
+            const std::size_t k_size = std::min(kc, l - k_begin);
+
+            // copy the block of B, filling up the last panel with zeros
+            for (std::size_t p = 0; p < n_panels; ++p)
+              for (std::size_t k = 0; k < k_size; ++k)
+                {
+                  const number2 *B_row = B + (k_begin + k) * n;
+                  for (std::size_t v = 0; v < nr; ++v)
+                    {
+                      VectorizedType &  entry = B_packed[(p * kc + k) * nr + v];
+                      const std::size_t col =
+                        j_begin + p * panel_width + v * n_lanes;
+                      if (col + n_lanes <= j_end)
+                        entry.load(B_row + col);
+                      else
+                        for (std::size_t lane = 0; lane < n_lanes; ++lane)
+                          entry[lane] =
+                            (col + lane < j_end) ? B_row[col + lane] : 0;
+                    }
+                }
+
+            for (std::size_t i_begin = 0; i_begin < m; i_begin += mc)
+              {
+                const std::size_t i_end = std::min(m, i_begin + mc);
+                const std::size_t n_row_panels =
+                  (i_end - i_begin + mr - 1) / mr;
+
+                // copy the block of A, filling up the last panel with zeros
+                for (std::size_t ip = 0; ip < n_row_panels; ++ip)
+                  for (std::size_t k = 0; k < k_size; ++k)
+                    for (std::size_t r = 0; r < mr; ++r)
+                      {
+                        const std::size_t i = i_begin + ip * mr + r;
+                        A_packed[(ip * kc + k) * mr + r] =
+                          (i < i_end) ?
+                            static_cast<number2>(
+                              A[i * a_row_stride +
+                                (k_begin + k) * a_col_stride]) :
+                            number2();
+                      }
+
+                for (std::size_t p = 0; p < n_panels; ++p)
+                  for (std::size_t ip = 0; ip < n_row_panels; ++ip)
+                    {
+                      const std::size_t row = i_begin + ip * mr;
+                      const std::size_t col = j_begin + p * panel_width;
+                      micro_kernel(k_size,
+                                   A_packed.data() + ip * kc * mr,
+                                   B_packed.data() + p * kc * nr,
+                                   C + row * n + col,
+                                   n,
+                                   std::min(mr, i_end - row),
+                                   std::min(panel_width, j_end - col));
+                    }
+              }
+          }
+      }
+
+      static void
+      micro_kernel(const std::size_t     k_size,
+                   const number2 *       A_panel,
+                   const VectorizedType *B_panel,
+                   number2 *             C,
+                   const std::size_t     ldc,
+                   const std::size_t     n_valid_rows,
+                   const std::size_t     n_valid_columns)
+      {
+        VectorizedType sums[mr][nr];
+        for (std::size_t r = 0; r < mr; ++r)
+          for (std::size_t v = 0; v < nr; ++v)
+            sums[r][v] = 0.;
+
+        for (std::size_t k = 0; k < k_size; ++k)
+          {
+            VectorizedType b[nr];
+            for (std::size_t v = 0; v < nr; ++v)
+              b[v] = B_panel[k * nr + v];
+            for (std::size_t r = 0; r < mr; ++r)
+              {
+                const VectorizedType a = A_panel[k * mr + r];
+                for (std::size_t v = 0; v < nr; ++v)
+                  sums[r][v] += a * b[v];
+              }
+          }
+
+        if (n_valid_rows == mr && n_valid_columns == nr * n_lanes)
+          for (std::size_t r = 0; r < mr; ++r)
+            for (std::size_t v = 0; v < nr; ++v)
+              {
+                VectorizedType c;
+                c.load(C + r * ldc + v * n_lanes);
+                c += sums[r][v];
+                c.store(C + r * ldc + v * n_lanes);
+              }
+        else
+          for (std::size_t r = 0; r < n_valid_rows; ++r)
+            for (std::size_t j = 0; j < n_valid_columns; ++j)
+              C[r * ldc + j] += sums[r][j / n_lanes][j % n_lanes];
+      }
+    };
+  } // namespace FullMatrixImplementation
+} // namespace internal
+
+
+
 template <typename number>
 template <typename number2>
 void
@@ -567,6 +813,17 @@ FullMatrix<number>::mmult(FullMatrix<number2> &      dst,
 
   const size_type m = this->m(), n = src.n(), l = this->n();
 
+  // for larger matrices, use a cache-blocked and vectorized kernel unless
+  // BLAS has already been called above
+  using BlockedProduct =
+    internal::FullMatrixImplementation::BlockedProduct<number, number2>;
+  if (BlockedProduct::is_applicable(m, n, l))
+    {
+      BlockedProduct::run(
+        m, n, l, this->values.data(), l, 1, &src(0, 0), &dst(0, 0), adding);
+      return;
+    }
+
   // arrange the loops in a way that we keep write operations low, (writing is
   // usually more costly than reading), even though we need to access the data
   // in src not in a contiguous way.
@@ -651,6 +908,18 @@ FullMatrix<number>::Tmmult(FullMatrix<number2> &      dst,
 
   const size_type m = n(), n = src.n(), l = this->m();
 
+  // for larger matrices, use a cache-blocked and vectorized kernel unless
+  // BLAS has already been called above. The entry (i,k) of the transpose
+  // is found at position k*m+i in the row-major storage.
+  using BlockedProduct =
+    internal::FullMatrixImplementation::BlockedProduct<number, number2>;
+  if (BlockedProduct::is_applicable(m, n, l))
+    {
+      BlockedProduct::run(
+        m, n, l, this->values.data(), 1, m, &src(0, 0), &dst(0, 0), adding);
+      return;
+    }
+
   // symmetric matrix if the two matrices are the same
   if (PointerComparison::equal(this, &src))
     for (size_type i = 0; i < m; ++i)
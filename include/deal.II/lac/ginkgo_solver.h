@@ -111,6 +111,9 @@ namespace GinkgoWrappers
 
     /**
      * Initialize the matrix and copy over its data to Ginkgo's data structures.
+     * The matrix stays on the executor until the next call to this function,
+     * so that several systems with the same matrix can be solved by calling
+     * apply() repeatedly.
      */
     void
     initialize(const SparseMatrix<ValueType> &matrix);
@@ -119,6 +122,9 @@ namespace GinkgoWrappers
      * Solve the linear system <tt>Ax=b</tt>. Dependent on the information
      * provided by derived classes one of Ginkgo's linear solvers is
      * chosen.
+     *
+     * On host executors, Ginkgo operates directly on the memory of
+     * @p solution and @p rhs without copying them.
      */
     void
     apply(Vector<ValueType> &solution, const Vector<ValueType> &rhs);
@@ -197,6 +203,22 @@ namespace GinkgoWrappers
      */
     std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>> system_matrix;
 
+    /**
+     * The solver generated for the current system matrix. It is created in
+     * the first call to apply() after initialize() and reused by subsequent
+     * calls, so that the setup of the solver and its preconditioner is only
+     * done once per matrix.
+     */
+    std::shared_ptr<gko::LinOp> solver;
+
+    /**
+     * Right hand side and solution vectors on the executor. They are only
+     * used if the executor is not a host executor, and are kept between
+     * calls to apply() to avoid repeated allocations on the device.
+     */
+    std::unique_ptr<gko::matrix::Dense<ValueType>> device_rhs;
+    std::unique_ptr<gko::matrix::Dense<ValueType>> device_solution;
+
     /**
      * The execution paradigm as a string to be set by the user. The choices
      * are between `omp`, `cuda` and `reference` and more details can be found
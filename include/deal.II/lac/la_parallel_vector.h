@@ -37,6 +37,17 @@ DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
 #ifndef DOXYGEN
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    namespace VectorDataExchange
+    {
+      class Base;
+    }
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
 namespace LinearAlgebra
 {
   /**
@@ -242,6 +253,14 @@ namespace LinearAlgebra
      *                       &comm_sm);
      * @endcode
      *
+     * For vectors of type float and double set up with a non-default
+     * `comm_sm` through reinit() with a partitioner or with local and ghost
+     * sizes, update_ghost_values() and compress() with VectorOperation::add
+     * make use of the shared memory as well: Ghost entries owned by processes
+     * in the same shared-memory domain are read directly from the arrays of
+     * those processes (and contributions to them are added directly), and
+     * MPI messages are only exchanged with processes on other domains.
+     *
      * @see CUDAWrappers
      */
     template <typename Number, typename MemorySpace = MemorySpace::Host>
@@ -810,6 +829,17 @@ namespace LinearAlgebra
       real_type
       norm_sqr() const;
 
+      /**
+       * Start the computation of the $l_2$ norm of the vector like l2_norm(),
+       * but do not wait for the global reduction to complete. The local
+       * contribution is computed right away, and the result is obtained by
+       * calling get() on the returned object. This allows to overlap the
+       * reduction with other work, e.g., in pipelined solvers. The vector may
+       * be modified once this function has returned.
+       */
+      Utilities::MPI::Future<real_type>
+      l2_norm_async() const;
+
       /**
        * Return the maximum norm of the vector (i.e., the maximum absolute value
        * among all entries and among all processors).
@@ -842,6 +872,53 @@ namespace LinearAlgebra
                   const VectorSpaceVector<Number> &V,
                   const VectorSpaceVector<Number> &W) override;
 
+      /**
+       * Compute the inner products of this vector with all vectors in @p V
+       * and store them in @p results, i.e., the result is the same as if the
+       * user called
+       * @code
+       * for (unsigned int i = 0; i < V.size(); ++i)
+       *   results[i] = *this * (*V[i]);
+       * @endcode
+       *
+       * As opposed to the loop above, this function goes through the vectors
+       * in blocks that fit into caches, such that the entries of @p this are
+       * only loaded once from main memory, and a single global reduction is
+       * performed for all inner products. This is the core operation of
+       * classical Gram-Schmidt orthogonalization against several vectors,
+       * see e.g. SolverGMRES.
+       *
+       * The same applies for complex-valued vectors as for operator*().
+       */
+      void
+      multi_dot(const std::vector<const Vector<Number, MemorySpace> *> &V,
+                const ArrayView<Number> &results) const;
+
+      /**
+       * Add the linear combination of the vectors in @p V with the
+       * coefficients @p factors to this vector, i.e., perform
+       * @code
+       * for (unsigned int i = 0; i < V.size(); ++i)
+       *   this->add(factors[i], *V[i]);
+       * @endcode
+       * in a single pass through this vector.
+       */
+      void
+      multi_add(const ArrayView<const Number> &                        factors,
+                const std::vector<const Vector<Number, MemorySpace> *> &V);
+
+      /**
+       * Combination of multi_add() and a subsequent inner product with @p W,
+       * returning the value of the inner product, in analogy to
+       * add_and_dot(). If @p W equals @p this, the result is the square of
+       * the norm of the updated vector.
+       */
+      Number
+      multi_add_and_dot(
+        const ArrayView<const Number> &                        factors,
+        const std::vector<const Vector<Number, MemorySpace> *> &V,
+        const Vector<Number, MemorySpace> &                    W);
+
       /**
        * Return the global size of the vector, equal to the sum of the number of
        * locally owned indices among all processors.
@@ -1133,6 +1210,14 @@ namespace LinearAlgebra
       virtual Number
       mean_value() const override;
 
+      /**
+       * Start the computation of the mean value of all the entries in the
+       * vector without waiting for the global reduction to complete. See
+       * l2_norm_async() for details.
+       */
+      Utilities::MPI::Future<Number>
+      mean_value_async() const;
+
       /**
        * $l_p$-norm of the vector. The pth root of the sum of the pth powers
        * of the absolute values of the elements.
@@ -1323,6 +1408,16 @@ namespace LinearAlgebra
                         const Vector<Number, MemorySpace> &V,
                         const Vector<Number, MemorySpace> &W);
 
+      /**
+       * Local part of multi_add_and_dot(). If @p W is a nullptr, only the
+       * addition is performed and zero is returned.
+       */
+      Number
+      multi_add_and_dot_local(
+        const ArrayView<const Number> &                        factors,
+        const std::vector<const Vector<Number, MemorySpace> *> &V,
+        const Vector<Number, MemorySpace> *                    W);
+
       /**
        * Shared pointer to store the parallel partitioning information. This
        * information can be shared between several vectors that have the same
@@ -1395,6 +1490,18 @@ namespace LinearAlgebra
        */
       MPI_Comm comm_sm;
 
+      /**
+       * Object used for the data exchange in update_ghost_values() and
+       * compress() if the vector has been set up with a shared-memory
+       * communicator `comm_sm` different from MPI_COMM_SELF. It accesses the
+       * arrays of the processes in `comm_sm` directly and only sends messages
+       * to the remaining processes. Empty if the exchange goes through the
+       * partitioner.
+       */
+      std::shared_ptr<
+        const ::dealii::internal::MatrixFreeFunctions::VectorDataExchange::Base>
+        shared_memory_exchanger;
+
       /**
        * A helper function that clears the compress_requests and
        * update_ghost_values_requests field. Used in reinit() functions.
@@ -21,6 +21,7 @@
 
 #include <deal.II/base/cuda.h>
 #include <deal.II/base/cuda_size.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/la_parallel_vector.h>
@@ -29,6 +30,8 @@
 #include <deal.II/lac/trilinos_vector.h>
 #include <deal.II/lac/vector_operations_internal.h>
 
+#include <deal.II/matrix_free/vector_data_exchange.h>
+
 #include <memory>
 
 
@@ -473,6 +476,251 @@ namespace LinearAlgebra
         }
       };
 #endif
+
+
+
+      // Number of entries of the calling vector in multi_dot() and
+      // multi_add_and_dot() that are kept in the level-1 cache while the
+      // other vectors stream past it, and the number of such blocks that form
+      // one task of the threaded loop. The partial sums are computed per task
+      // and added in a fixed order, so the results do not depend on the
+      // number of threads.
+      constexpr unsigned int multi_vector_block_size     = 256;
+      constexpr unsigned int multi_vector_blocks_per_task = 64;
+
+
+
+      // Inner product of two arrays with several independent partial sums
+      template <typename Number>
+      inline Number
+      block_dot(const Number *v, const Number *w, const unsigned int n)
+      {
+        Number       sums[4] = {};
+        unsigned int i       = 0;
+        for (; i + 3 < n; i += 4)
+          for (unsigned int j = 0; j < 4; ++j)
+            sums[j] +=
+              v[i + j] * numbers::NumberTraits<Number>::conjugate(w[i + j]);
+        for (; i < n; ++i)
+          sums[0] += v[i] * numbers::NumberTraits<Number>::conjugate(w[i]);
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+      }
+
+
+
+      // Local part of multi_dot() on the host
+      template <typename Number>
+      void
+      multi_dot_local(const Number *                     values,
+                      const std::vector<const Number *> &others,
+                      const types::global_dof_index      size,
+                      Number *                           results)
+      {
+        using size_type              = types::global_dof_index;
+        const unsigned int n_vectors = others.size();
+        const size_type    task_size =
+          multi_vector_block_size * multi_vector_blocks_per_task;
+        const size_type n_tasks = (size + task_size - 1) / task_size;
+
+        std::vector<Number> partial_sums(n_tasks * n_vectors);
+        parallel::apply_to_subranges(
+          size_type(0),
+          n_tasks,
+          [&](const size_type begin, const size_type end) {
+            for (size_type t = begin; t < end; ++t)
+              {
+                Number *const   sums     = partial_sums.data() + t * n_vectors;
+                const size_type task_end = std::min(size, (t + 1) * task_size);
+                for (size_type start = t * task_size; start < task_end;
+                     start += multi_vector_block_size)
+                  {
+                    const unsigned int n = std::min<size_type>(
+                      multi_vector_block_size, task_end - start);
+                    for (unsigned int i = 0; i < n_vectors; ++i)
+                      sums[i] +=
+                        block_dot(values + start, others[i] + start, n);
+                  }
+              }
+          },
+          1);
+
+        for (unsigned int i = 0; i < n_vectors; ++i)
+          results[i] = Number();
+        for (size_type t = 0; t < n_tasks; ++t)
+          for (unsigned int i = 0; i < n_vectors; ++i)
+            results[i] += partial_sums[t * n_vectors + i];
+      }
+
+
+
+      // Local part of multi_add_and_dot() on the host. If w is a nullptr,
+      // only the addition is performed.
+      template <typename Number>
+      Number
+      multi_add_and_dot_local(Number *                           values,
+                              const Number *                     factors,
+                              const std::vector<const Number *> &others,
+                              const Number *                     w,
+                              const types::global_dof_index      size)
+      {
+        using size_type              = types::global_dof_index;
+        const unsigned int n_vectors = others.size();
+        const size_type    task_size =
+          multi_vector_block_size * multi_vector_blocks_per_task;
+        const size_type n_tasks = (size + task_size - 1) / task_size;
+
+        std::vector<Number> partial_sums(w != nullptr ? n_tasks : 0);
+        parallel::apply_to_subranges(
+          size_type(0),
+          n_tasks,
+          [&](const size_type begin, const size_type end) {
+            for (size_type t = begin; t < end; ++t)
+              {
+                const size_type task_end = std::min(size, (t + 1) * task_size);
+                for (size_type start = t * task_size; start < task_end;
+                     start += multi_vector_block_size)
+                  {
+                    const unsigned int n = std::min<size_type>(
+                      multi_vector_block_size, task_end - start);
+                    Number *const v = values + start;
+                    for (unsigned int i = 0; i < n_vectors; ++i)
+                      {
+                        const Number        factor = factors[i];
+                        const Number *const u      = others[i] + start;
+                        for (unsigned int j = 0; j < n; ++j)
+                          v[j] += factor * u[j];
+                      }
+                    if (w != nullptr)
+                      partial_sums[t] += block_dot(v, w + start, n);
+                  }
+              }
+          },
+          1);
+
+        Number result = Number();
+        for (const Number sum : partial_sums)
+          result += sum;
+        return result;
+      }
+
+
+
+      // The shared-memory data exchange of
+      // MatrixFreeFunctions::VectorDataExchange::Full is only implemented for
+      // float and double arrays on the host. For all other combinations, no
+      // exchanger is created and the functions below are never reached.
+      template <typename Number,
+                typename MemorySpaceType,
+                bool supported =
+                  std::is_same<MemorySpaceType,
+                               ::dealii::MemorySpace::Host>::value &&
+                  (std::is_same<Number, double>::value ||
+                   std::is_same<Number, float>::value)>
+      struct shared_memory_exchange
+      {
+        static constexpr bool is_supported = false;
+
+        using Exchanger =
+          ::dealii::internal::MatrixFreeFunctions::VectorDataExchange::Base;
+
+        static std::shared_ptr<const Exchanger>
+        create(const std::shared_ptr<const Utilities::MPI::Partitioner> &,
+               const MPI_Comm &)
+        {
+          return nullptr;
+        }
+
+        template <typename... Args>
+        static void
+        export_to_ghosted_array_start(const Exchanger &, Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+
+        template <typename... Args>
+        static void
+        export_to_ghosted_array_finish(const Exchanger &, Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+
+        template <typename... Args>
+        static void
+        import_from_ghosted_array_start(const Exchanger &, Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+
+        template <typename... Args>
+        static void
+        import_from_ghosted_array_finish(const Exchanger &, Args &&...)
+        {
+          Assert(false, ExcInternalError());
+        }
+      };
+
+
+
+      template <typename Number, typename MemorySpaceType>
+      struct shared_memory_exchange<Number, MemorySpaceType, true>
+      {
+        static constexpr bool is_supported = true;
+
+        using Exchanger =
+          ::dealii::internal::MatrixFreeFunctions::VectorDataExchange::Base;
+
+        static std::shared_ptr<const Exchanger>
+        create(
+          const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner,
+          const MPI_Comm &                                          comm_sm)
+        {
+#ifdef DEAL_II_WITH_MPI
+          if (comm_sm != MPI_COMM_SELF &&
+              partitioner->get_mpi_communicator() != MPI_COMM_SELF)
+            return std::make_shared<const ::dealii::internal::
+                                      MatrixFreeFunctions::VectorDataExchange::
+                                        Full>(partitioner, comm_sm);
+#else
+          (void)partitioner;
+          (void)comm_sm;
+#endif
+          return nullptr;
+        }
+
+        template <typename... Args>
+        static void
+        export_to_ghosted_array_start(const Exchanger &exchanger,
+                                      Args &&... args)
+        {
+          exchanger.export_to_ghosted_array_start(std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        static void
+        export_to_ghosted_array_finish(const Exchanger &exchanger,
+                                       Args &&... args)
+        {
+          exchanger.export_to_ghosted_array_finish(std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        static void
+        import_from_ghosted_array_start(const Exchanger &exchanger,
+                                        Args &&... args)
+        {
+          exchanger.import_from_ghosted_array_start(
+            std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        static void
+        import_from_ghosted_array_finish(const Exchanger &exchanger,
+                                         Args &&... args)
+        {
+          exchanger.import_from_ghosted_array_finish(
+            std::forward<Args>(args)...);
+        }
+      };
     } // namespace internal
 
 
@@ -481,18 +729,16 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::clear_mpi_requests()
     {
 #ifdef DEAL_II_WITH_MPI
-      for (auto &compress_request : compress_requests)
-        {
-          const int ierr = MPI_Request_free(&compress_request);
-          AssertThrowMPI(ierr);
-        }
-      compress_requests.clear();
-      for (auto &update_ghost_values_request : update_ghost_values_requests)
-        {
-          const int ierr = MPI_Request_free(&update_ghost_values_request);
-          AssertThrowMPI(ierr);
-        }
-      update_ghost_values_requests.clear();
+      // the requests may be persistent requests owned by the object that
+      // started the exchange, so let it free them
+      for (auto *requests : {&compress_requests, &update_ghost_values_requests})
+        if (requests->size() > 0)
+          {
+            if (shared_memory_exchanger != nullptr)
+              shared_memory_exchanger->free_requests(*requests);
+            else
+              partitioner->free_requests(*requests);
+          }
 #endif
     }
 
@@ -532,6 +778,7 @@ namespace LinearAlgebra
 
       // set partitioner to serial version
       partitioner = std::make_shared<Utilities::MPI::Partitioner>(size);
+      shared_memory_exchanger.reset();
 
       // set entries to zero if so requested
       if (omit_zeroing_entries == false)
@@ -565,6 +812,9 @@ namespace LinearAlgebra
       partitioner = std::make_shared<Utilities::MPI::Partitioner>(local_size,
                                                                   ghost_size,
                                                                   comm);
+      shared_memory_exchanger =
+        internal::shared_memory_exchange<Number, MemorySpaceType>::create(
+          partitioner, comm_sm);
 
       this->operator=(Number());
     }
@@ -583,6 +833,14 @@ namespace LinearAlgebra
 
       this->comm_sm = v.comm_sm;
 
+      // the exchanger only depends on the partitioner and comm_sm, so it can
+      // be shared with v as long as it supports our number type
+      if (internal::shared_memory_exchange<Number,
+                                           MemorySpaceType>::is_supported)
+        shared_memory_exchanger = v.shared_memory_exchanger;
+      else
+        shared_memory_exchanger.reset();
+
       // check whether the partitioners are
       // different (check only if the are allocated
       // differently, not if the actual data is
@@ -647,6 +905,15 @@ namespace LinearAlgebra
       const MPI_Comm &                                          comm_sm)
     {
       clear_mpi_requests();
+
+      // setting up the shared-memory exchanger involves global communication,
+      // so keep the present one if neither the partitioner nor comm_sm change
+      if (partitioner_in.get() != partitioner.get() ||
+          comm_sm != this->comm_sm || shared_memory_exchanger == nullptr)
+        shared_memory_exchanger =
+          internal::shared_memory_exchange<Number, MemorySpaceType>::create(
+            partitioner_in, comm_sm);
+
       partitioner = partitioner_in;
 
       this->comm_sm = comm_sm;
@@ -1039,15 +1306,42 @@ namespace LinearAlgebra
       else
 #  endif
         {
-          partitioner->import_from_ghosted_array_start(
-            operation,
-            communication_channel,
-            ArrayView<Number, MemorySpace::Host>(
-              data.values.get() + partitioner->locally_owned_size(),
-              partitioner->n_ghost_indices()),
-            ArrayView<Number, MemorySpace::Host>(
-              import_data.values.get(), partitioner->n_import_indices()),
-            compress_requests);
+          if (shared_memory_exchanger != nullptr &&
+              operation == VectorOperation::add)
+            {
+              // contributions to entries owned by processes in comm_sm are
+              // added directly from our ghost array by the owner in
+              // compress_finish(), so only data for the remaining processes
+              // is sent. the exchanger hence needs a subset of import_data.
+              Assert(shared_memory_exchanger->n_import_indices() <=
+                       partitioner->n_import_indices(),
+                     ExcInternalError());
+              internal::shared_memory_exchange<Number, MemorySpaceType>::
+                import_from_ghosted_array_start(
+                  *shared_memory_exchanger,
+                  operation,
+                  communication_channel,
+                  ArrayView<const Number>(data.values.get(),
+                                          partitioner->locally_owned_size()),
+                  data.values_sm,
+                  ArrayView<Number>(data.values.get() +
+                                      partitioner->locally_owned_size(),
+                                    partitioner->n_ghost_indices()),
+                  ArrayView<Number>(
+                    import_data.values.get(),
+                    shared_memory_exchanger->n_import_indices()),
+                  compress_requests);
+            }
+          else
+            partitioner->import_from_ghosted_array_start(
+              operation,
+              communication_channel,
+              ArrayView<Number, MemorySpace::Host>(
+                data.values.get() + partitioner->locally_owned_size(),
+                partitioner->n_ghost_indices()),
+              ArrayView<Number, MemorySpace::Host>(
+                import_data.values.get(), partitioner->n_import_indices()),
+              compress_requests);
         }
 #else
       (void)communication_channel;
@@ -1096,17 +1390,37 @@ namespace LinearAlgebra
           Assert(partitioner->n_import_indices() == 0 ||
                    import_data.values != nullptr,
                  ExcNotInitialized());
-          partitioner
-            ->import_from_ghosted_array_finish<Number, MemorySpace::Host>(
-              operation,
-              ArrayView<const Number, MemorySpace::Host>(
-                import_data.values.get(), partitioner->n_import_indices()),
-              ArrayView<Number, MemorySpace::Host>(
-                data.values.get(), partitioner->locally_owned_size()),
-              ArrayView<Number, MemorySpace::Host>(
-                data.values.get() + partitioner->locally_owned_size(),
-                partitioner->n_ghost_indices()),
-              compress_requests);
+          if (shared_memory_exchanger != nullptr &&
+              operation == VectorOperation::add)
+            {
+              internal::shared_memory_exchange<Number, MemorySpaceType>::
+                import_from_ghosted_array_finish(
+                  *shared_memory_exchanger,
+                  operation,
+                  ArrayView<Number>(data.values.get(),
+                                    partitioner->locally_owned_size()),
+                  data.values_sm,
+                  ArrayView<Number>(data.values.get() +
+                                      partitioner->locally_owned_size(),
+                                    partitioner->n_ghost_indices()),
+                  ArrayView<const Number>(
+                    import_data.values.get(),
+                    shared_memory_exchanger->n_import_indices()),
+                  compress_requests);
+              compress_requests.clear();
+            }
+          else
+            partitioner
+              ->import_from_ghosted_array_finish<Number, MemorySpace::Host>(
+                operation,
+                ArrayView<const Number, MemorySpace::Host>(
+                  import_data.values.get(), partitioner->n_import_indices()),
+                ArrayView<Number, MemorySpace::Host>(
+                  data.values.get(), partitioner->locally_owned_size()),
+                ArrayView<Number, MemorySpace::Host>(
+                  data.values.get() + partitioner->locally_owned_size(),
+                  partitioner->n_ghost_indices()),
+                compress_requests);
         }
 
 #  if defined DEAL_II_COMPILER_CUDA_AWARE && \
@@ -1200,16 +1514,36 @@ namespace LinearAlgebra
 
 #  if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
         defined(DEAL_II_MPI_WITH_CUDA_SUPPORT))
-      partitioner->export_to_ghosted_array_start<Number, MemorySpace::Host>(
-        communication_channel,
-        ArrayView<const Number, MemorySpace::Host>(
-          data.values.get(), partitioner->locally_owned_size()),
-        ArrayView<Number, MemorySpace::Host>(import_data.values.get(),
-                                             partitioner->n_import_indices()),
-        ArrayView<Number, MemorySpace::Host>(
-          data.values.get() + partitioner->locally_owned_size(),
-          partitioner->n_ghost_indices()),
-        update_ghost_values_requests);
+      if (shared_memory_exchanger != nullptr)
+        {
+          // ghost values owned by processes in comm_sm are read directly from
+          // their arrays in update_ghost_values_finish(), so only the data of
+          // the remaining processes is sent
+          internal::shared_memory_exchange<Number, MemorySpaceType>::
+            export_to_ghosted_array_start(
+              *shared_memory_exchanger,
+              communication_channel,
+              ArrayView<const Number>(data.values.get(),
+                                      partitioner->locally_owned_size()),
+              data.values_sm,
+              ArrayView<Number>(data.values.get() +
+                                  partitioner->locally_owned_size(),
+                                partitioner->n_ghost_indices()),
+              ArrayView<Number>(import_data.values.get(),
+                                shared_memory_exchanger->n_import_indices()),
+              update_ghost_values_requests);
+        }
+      else
+        partitioner->export_to_ghosted_array_start<Number, MemorySpace::Host>(
+          communication_channel,
+          ArrayView<const Number, MemorySpace::Host>(
+            data.values.get(), partitioner->locally_owned_size()),
+          ArrayView<Number, MemorySpace::Host>(
+            import_data.values.get(), partitioner->n_import_indices()),
+          ArrayView<Number, MemorySpace::Host>(
+            data.values.get() + partitioner->locally_owned_size(),
+            partitioner->n_ghost_indices()),
+          update_ghost_values_requests);
 #  else
       partitioner->export_to_ghosted_array_start<Number, MemorySpace::CUDA>(
         communication_channel,
@@ -1237,9 +1571,13 @@ namespace LinearAlgebra
 #ifdef DEAL_II_WITH_MPI
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
-      AssertDimension(partitioner->ghost_targets().size() +
-                        partitioner->import_targets().size(),
-                      update_ghost_values_requests.size());
+      Assert(shared_memory_exchanger != nullptr ||
+               partitioner->ghost_targets().size() +
+                   partitioner->import_targets().size() ==
+                 update_ghost_values_requests.size(),
+             ExcDimensionMismatch(partitioner->ghost_targets().size() +
+                                    partitioner->import_targets().size(),
+                                  update_ghost_values_requests.size()));
       if (update_ghost_values_requests.size() > 0)
         {
           // make this function thread safe
@@ -1247,11 +1585,26 @@ namespace LinearAlgebra
 
 #  if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
         defined(DEAL_II_MPI_WITH_CUDA_SUPPORT))
-          partitioner->export_to_ghosted_array_finish(
-            ArrayView<Number, MemorySpace::Host>(
-              data.values.get() + partitioner->locally_owned_size(),
-              partitioner->n_ghost_indices()),
-            update_ghost_values_requests);
+          if (shared_memory_exchanger != nullptr)
+            {
+              internal::shared_memory_exchange<Number, MemorySpaceType>::
+                export_to_ghosted_array_finish(
+                  *shared_memory_exchanger,
+                  ArrayView<const Number>(data.values.get(),
+                                          partitioner->locally_owned_size()),
+                  data.values_sm,
+                  ArrayView<Number>(data.values.get() +
+                                      partitioner->locally_owned_size(),
+                                    partitioner->n_ghost_indices()),
+                  update_ghost_values_requests);
+              update_ghost_values_requests.clear();
+            }
+          else
+            partitioner->export_to_ghosted_array_finish(
+              ArrayView<Number, MemorySpace::Host>(
+                data.values.get() + partitioner->locally_owned_size(),
+                partitioner->n_ghost_indices()),
+              update_ghost_values_requests);
 #  else
           partitioner->export_to_ghosted_array_finish(
             ArrayView<Number, MemorySpace::CUDA>(
@@ -1417,6 +1770,8 @@ namespace LinearAlgebra
       std::swap(data, v.data);
       std::swap(import_data, v.import_data);
       std::swap(vector_is_ghosted, v.vector_is_ghosted);
+      std::swap(comm_sm, v.comm_sm);
+      std::swap(shared_memory_exchanger, v.shared_memory_exchanger);
     }
 
 
@@ -1880,6 +2235,30 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    Utilities::MPI::Future<Number>
+    Vector<Number, MemorySpaceType>::mean_value_async() const
+    {
+      const Number local_result = mean_value_local();
+      if (partitioner->n_mpi_processes() > 1)
+        {
+          const auto sum = std::make_shared<Utilities::MPI::Future<Number>>(
+            Utilities::MPI::isum(local_result *
+                                   static_cast<real_type>(
+                                     partitioner->locally_owned_size()),
+                                 partitioner->get_mpi_communicator()));
+          const real_type size = partitioner->size();
+          return Utilities::MPI::Future<Number>(
+            [sum]() { sum->wait(); },
+            [sum, size]() { return sum->get() / size; });
+        }
+      else
+        return Utilities::MPI::Future<Number>(
+          []() {}, [local_result]() { return local_result; });
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     typename Vector<Number, MemorySpaceType>::real_type
     Vector<Number, MemorySpaceType>::l1_norm_local() const
@@ -1935,6 +2314,28 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    Utilities::MPI::Future<typename Vector<Number, MemorySpaceType>::real_type>
+    Vector<Number, MemorySpaceType>::l2_norm_async() const
+    {
+      const real_type local_result = norm_sqr_local();
+      if (partitioner->n_mpi_processes() > 1)
+        {
+          const auto norm_sqr = std::make_shared<
+            Utilities::MPI::Future<real_type>>(
+            Utilities::MPI::isum(local_result,
+                                 partitioner->get_mpi_communicator()));
+          return Utilities::MPI::Future<real_type>(
+            [norm_sqr]() { norm_sqr->wait(); },
+            [norm_sqr]() { return std::sqrt(norm_sqr->get()); });
+        }
+      else
+        return Utilities::MPI::Future<real_type>(
+          []() {}, [local_result]() { return std::sqrt(local_result); });
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     typename Vector<Number, MemorySpaceType>::real_type
     Vector<Number, MemorySpaceType>::lp_norm_local(const real_type p) const
@@ -2048,6 +2449,118 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multi_dot(
+      const std::vector<const Vector<Number, MemorySpaceType> *> &V,
+      const ArrayView<Number> &                                   results) const
+    {
+      AssertDimension(V.size(), results.size());
+      const size_type local_size = partitioner->locally_owned_size();
+
+      if (std::is_same<MemorySpaceType, ::dealii::MemorySpace::Host>::value)
+        {
+          std::vector<const Number *> others(V.size());
+          for (unsigned int i = 0; i < V.size(); ++i)
+            {
+              Assert(V[i] != nullptr, ExcNotInitialized());
+              AssertDimension(local_size, V[i]->locally_owned_size());
+              others[i] = V[i]->data.values.get();
+            }
+          internal::multi_dot_local(data.values.get(),
+                                    others,
+                                    local_size,
+                                    results.data());
+        }
+      else
+        for (unsigned int i = 0; i < V.size(); ++i)
+          results[i] = inner_product_local(*V[i]);
+
+      if (partitioner->n_mpi_processes() > 1)
+        Utilities::MPI::sum(ArrayView<const Number>(results.data(),
+                                                    results.size()),
+                            partitioner->get_mpi_communicator(),
+                            results);
+
+      for (unsigned int i = 0; i < results.size(); ++i)
+        AssertIsFinite(results[i]);
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    Number
+    Vector<Number, MemorySpaceType>::multi_add_and_dot_local(
+      const ArrayView<const Number> &                             factors,
+      const std::vector<const Vector<Number, MemorySpaceType> *> &V,
+      const Vector<Number, MemorySpaceType> *                     W)
+    {
+      AssertDimension(V.size(), factors.size());
+      const size_type local_size = partitioner->locally_owned_size();
+      for (unsigned int i = 0; i < V.size(); ++i)
+        {
+          Assert(V[i] != nullptr, ExcNotInitialized());
+          AssertDimension(local_size, V[i]->locally_owned_size());
+          AssertIsFinite(factors[i]);
+        }
+      if (W != nullptr)
+        AssertDimension(local_size, W->locally_owned_size());
+
+      if (std::is_same<MemorySpaceType, ::dealii::MemorySpace::Host>::value)
+        {
+          std::vector<const Number *> others(V.size());
+          for (unsigned int i = 0; i < V.size(); ++i)
+            others[i] = V[i]->data.values.get();
+          const Number sum = internal::multi_add_and_dot_local(
+            data.values.get(),
+            factors.data(),
+            others,
+            W != nullptr ? W->data.values.get() : nullptr,
+            local_size);
+          AssertIsFinite(sum);
+          return sum;
+        }
+      else
+        {
+          for (unsigned int i = 0; i < V.size(); ++i)
+            add_local(factors[i], *V[i]);
+          return W != nullptr ? inner_product_local(*W) : Number();
+        }
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multi_add(
+      const ArrayView<const Number> &                             factors,
+      const std::vector<const Vector<Number, MemorySpaceType> *> &V)
+    {
+      multi_add_and_dot_local(factors, V, nullptr);
+
+      if (vector_is_ghosted)
+        update_ghost_values();
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    Number
+    Vector<Number, MemorySpaceType>::multi_add_and_dot(
+      const ArrayView<const Number> &                             factors,
+      const std::vector<const Vector<Number, MemorySpaceType> *> &V,
+      const Vector<Number, MemorySpaceType> &                     W)
+    {
+      Number local_result = multi_add_and_dot_local(factors, V, &W);
+      if (partitioner->n_mpi_processes() > 1)
+        return Utilities::MPI::sum(local_result,
+                                   partitioner->get_mpi_communicator());
+      else
+        return local_result;
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     inline bool
     Vector<Number, MemorySpaceType>::partitioners_are_compatible(
@@ -24,8 +24,10 @@
 
 #include <boost/io/ios_state.hpp>
 
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <string>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -607,12 +609,9 @@ namespace LinearAlgebra
   {
     AssertThrow(in, ExcIO());
 
-    size_type sz;
-
-    char buf[16];
-
-    in.getline(buf, 16, '\n');
-    sz = std::atoi(buf);
+    std::string line;
+    std::getline(in, line);
+    const size_type sz = std::strtoull(line.c_str(), nullptr, 10);
     ReadWriteVector<Number>::reinit(sz, true);
 
     char c;
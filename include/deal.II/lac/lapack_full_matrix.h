@@ -835,6 +835,24 @@ public:
   std::complex<number>
   eigenvalue(const size_type i) const;
 
+  /**
+   * Return the right eigenvectors as the columns of a matrix, in the order
+   * of the eigenvalues returned by eigenvalue(). This function can only be
+   * called after compute_eigenvalues() with @p right_eigenvectors set to
+   * true. For real matrices, LAPACK stores the eigenvectors of a complex
+   * conjugate pair of eigenvalues in two consecutive real columns; they are
+   * expanded into their complex form here.
+   */
+  FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+  get_right_eigenvectors() const;
+
+  /**
+   * Same as get_right_eigenvectors(), but for the left eigenvectors, which
+   * need to have been requested in the call to compute_eigenvalues().
+   */
+  FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+  get_left_eigenvectors() const;
+
   /**
    * Retrieve singular values after compute_svd() or compute_inverse_svd() was
    * called.
@@ -512,10 +512,16 @@ operator*(typename Range::value_type                    number,
         v *= number;
       };
 
+      // for the _add variants, apply op to a temporary vector and merge the
+      // scaling into the addition. this needs one pass less over v than
+      // scaling v back and forth, and avoids dividing by number
       return_op.vmult_add = [number, op](Range &v, const Domain &u) {
-        v /= number;
-        op.vmult_add(v, u);
-        v *= number;
+        GrowingVectorMemory<Range> vector_memory;
+
+        typename VectorMemory<Range>::Pointer i(vector_memory);
+        op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
+        op.vmult(*i, u);
+        v.add(number, *i);
       };
 
       return_op.Tvmult = [number, op](Domain &v, const Range &u) {
@@ -524,9 +530,12 @@ operator*(typename Range::value_type                    number,
       };
 
       return_op.Tvmult_add = [number, op](Domain &v, const Range &u) {
-        v /= number;
-        op.Tvmult_add(v, u);
-        v *= number;
+        GrowingVectorMemory<Domain> vector_memory;
+
+        typename VectorMemory<Domain>::Pointer i(vector_memory);
+        op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
+        op.Tvmult(*i, u);
+        v.add(number, *i);
       };
 
       return return_op;
@@ -343,9 +343,15 @@ operator-(const PackagedOperation<Range> &first_comp,
 
   return_comp.apply_add = [first_comp, second_comp](Range &v) {
     first_comp.apply_add(v);
-    v *= -1.;
-    second_comp.apply_add(v);
-    v *= -1.;
+
+    // evaluate second_comp into a temporary vector and subtract it, rather
+    // than flipping the sign of v twice
+    GrowingVectorMemory<Range> vector_memory;
+
+    typename VectorMemory<Range>::Pointer i(vector_memory);
+    second_comp.reinit_vector(*i, /*bool omit_zeroing_entries =*/true);
+    second_comp.apply(*i);
+    v.add(-1., *i);
   };
 
   return return_comp;
@@ -381,10 +387,15 @@ PackagedOperation<Range> operator*(const PackagedOperation<Range> &comp,
         v *= number;
       };
 
+      // merge the scaling into the addition of a temporary vector, which
+      // needs one pass less over v than scaling v back and forth
       return_comp.apply_add = [comp, number](Range &v) {
-        v /= number;
-        comp.apply_add(v);
-        v *= number;
+        GrowingVectorMemory<Range> vector_memory;
+
+        typename VectorMemory<Range>::Pointer i(vector_memory);
+        comp.reinit_vector(*i, /*bool omit_zeroing_entries =*/true);
+        comp.apply(*i);
+        v.add(number, *i);
       };
     }
 
@@ -465,7 +476,31 @@ template <typename Range>
 PackagedOperation<Range>
 operator-(const Range &offset, const PackagedOperation<Range> &comp)
 {
-  return PackagedOperation<Range>(offset) - comp;
+  PackagedOperation<Range> return_comp;
+
+  return_comp.reinit_vector = [&offset](Range &x, bool omit_zeroing_entries) {
+    x.reinit(offset, omit_zeroing_entries);
+  };
+
+  // ensure to have a valid PackagedOperation object by catching comp by
+  // value, offset is caught by reference. the sign change and the addition
+  // of the offset are done in a single pass over the result vector
+
+  return_comp.apply = [comp, &offset](Range &v) {
+    comp.apply(v);
+    v.sadd(-1., 1., offset);
+  };
+
+  return_comp.apply_add = [comp, &offset](Range &v) {
+    GrowingVectorMemory<Range> vector_memory;
+
+    typename VectorMemory<Range>::Pointer i(vector_memory);
+    comp.reinit_vector(*i, /*bool omit_zeroing_entries =*/true);
+    comp.apply(*i);
+    v.add(1., offset, -1., *i);
+  };
+
+  return return_comp;
 }
 
 //@}
@@ -542,10 +577,7 @@ operator+(const Range &u, const Range &v)
     x += v;
   };
 
-  return_comp.apply_add = [&u, &v](Range &x) {
-    x += u;
-    x += v;
-  };
+  return_comp.apply_add = [&u, &v](Range &x) { x.add(1., u, 1., v); };
 
   return return_comp;
 }
@@ -587,10 +619,7 @@ operator-(const Range &u, const Range &v)
     x -= v;
   };
 
-  return_comp.apply_add = [&u, &v](Range &x) {
-    x += u;
-    x -= v;
-  };
+  return_comp.apply_add = [&u, &v](Range &x) { x.add(1., u, -1., v); };
 
   return return_comp;
 }
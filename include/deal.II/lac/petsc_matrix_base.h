@@ -548,6 +548,49 @@ namespace PETScWrappers
     clear_rows(const std::vector<size_type> &rows,
                const PetscScalar             new_diag_value = 0);
 
+    /**
+     * Prepare the matrix for assembly in coordinate (COO) format, using
+     * PETSc's <tt>MatSetPreallocationCOO</tt>. The arguments list the row and
+     * column indices of all entries that will later be passed to
+     * set_values_coo(), in this order. Indices may appear several times, in
+     * which case the corresponding values are summed, and rows may be owned
+     * by other processes. Typically, these arrays are filled with the
+     * (row, column) pairs of all local matrices that are computed on the
+     * locally owned cells.
+     *
+     * The COO structure is stored by PETSc and can be reused by any number
+     * of calls to set_values_coo(), e.g., when the matrix is reassembled in
+     * every time step. This avoids the hash lookups and the stash for
+     * off-process entries that add() incurs for every local matrix.
+     *
+     * This function is collective. It replaces the sparsity pattern the
+     * matrix was initialized with by the one given by the two arguments, and
+     * sets all entries of the matrix to zero.
+     *
+     * @note This function requires PETSc 3.14 or later.
+     */
+    void
+    set_coo_pattern(const std::vector<size_type> &row_indices,
+                    const std::vector<size_type> &col_indices);
+
+    /**
+     * Write the values of the entries previously described by
+     * set_coo_pattern() into the matrix. The @p values array must have the
+     * same length as the index arrays given to set_coo_pattern(), and is
+     * interpreted in the same order. Depending on @p operation, the values
+     * are either added to the current entries of the matrix or replace them.
+     *
+     * This function is collective and communicates the contributions to rows
+     * owned by other processes, so the matrix is in compressed state
+     * afterwards and there is no need to call compress().
+     *
+     * @note This function requires PETSc 3.14 or later.
+     */
+    void
+    set_values_coo(
+      const std::vector<PetscScalar> &values,
+      const VectorOperation::values   operation = VectorOperation::add);
+
     /**
      * PETSc matrices store their own sparsity patterns. So, in analogy to our
      * own SparsityPattern class, this function compresses the sparsity
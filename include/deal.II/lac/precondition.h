@@ -936,7 +936,51 @@ private:
  * AdditionalData::eig_cg_n_iterations to zero, and provide the variable
  * AdditionalData::max_eigenvalue instead. The minimal eigenvalue is
  * implicitly specified via `max_eigenvalue/smoothing_range`.
-
+ *
+ * <h4>Refreshing an eigenvalue estimate of a previous setup</h4>
+ *
+ * When the preconditioner is set up repeatedly for similar matrices, e.g.
+ * for the levels of a multigrid hierarchy that is rebuilt in every time step
+ * or adaptive cycle, the estimate of the largest eigenvalue usually changes
+ * only little between the setups. In that case, the estimate returned by
+ * estimate_eigenvalues() of the previous setup can be passed in
+ * AdditionalData::initial_max_eigenvalue. Instead of the full CG estimate,
+ * only AdditionalData::eig_power_n_iterations steps of a power iteration are
+ * then run to refresh the estimate, using the Rayleigh quotient of the
+ * preconditioned matrix in the energy inner product, which approaches the
+ * largest eigenvalue from below. If the refreshed estimate (including the
+ * safety factor of 1.2) differs from the given one by more than the relative
+ * tolerance AdditionalData::eig_warm_start_tolerance, the full CG estimate
+ * is computed instead. This in particular catches an increase of the largest
+ * eigenvalue beyond the given estimate, for which the Chebyshev iteration
+ * would amplify rather than damp the respective error components and thus
+ * diverge. Otherwise, the larger one of the given and the refreshed estimate
+ * is used. As the smallest eigenvalue is not estimated by the power
+ * iteration, the refresh is only done for a smoothing range larger than one.
+ *
+ * <h4>Merging the vector updates into the matrix-vector product</h4>
+ *
+ * Each step of the Chebyshev iteration consists of a matrix-vector product
+ * followed by an update that reads four and writes one vector. For
+ * matrix-free operators, this update is often as expensive as the product
+ * itself. If the vector type is LinearAlgebra::distributed::Vector, the
+ * preconditioner is a DiagonalMatrix, and the matrix provides a function
+ * @code
+ * void vmult(VectorType &dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_before_matrix_vector_product,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_after_matrix_vector_product) const;
+ * @endcode
+ * with the same contract as described for SolverCG, the vmult() and step()
+ * functions of this class perform the vector updates inside these two
+ * operations on the ranges of locally owned entries handed out by the
+ * matrix, while the data is still in caches. The first update of vmult(),
+ * which does not need a matrix-vector product, is placed into the operation
+ * before the first product. The results are the same as with the separate
+ * updates. Tvmult() and Tstep() always use the separate updates.
+ *
  * <h4>Using the PreconditionChebyshev as a solver</h4>
  *
  * If the range <tt>[max_eigenvalue/smoothing_range, max_eigenvalue]</tt>
@@ -1064,6 +1108,30 @@ public:
      */
     double max_eigenvalue;
 
+    /**
+     * Estimate of the largest eigenvalue from a previous setup, e.g. the
+     * value of EigenvalueInformation::max_eigenvalue_estimate returned by
+     * estimate_eigenvalues(), that is refreshed by a few steps of a power
+     * iteration instead of running the full CG estimate. Only in effect if
+     * positive, if @p eig_cg_n_iterations is positive, and if
+     * @p smoothing_range is larger than one. See the section on refreshing
+     * an eigenvalue estimate in the description of the class.
+     */
+    double initial_max_eigenvalue;
+
+    /**
+     * Number of power iteration steps to refresh
+     * @p initial_max_eigenvalue.
+     */
+    unsigned int eig_power_n_iterations;
+
+    /**
+     * Relative tolerance for the change of the refreshed estimate with
+     * respect to @p initial_max_eigenvalue, beyond which the full CG
+     * estimate is computed.
+     */
+    double eig_warm_start_tolerance;
+
     /**
      * Constraints to be used for the operator given. This variable is used to
      * zero out the correct entries when creating an initial guess.
@@ -1161,6 +1229,11 @@ public:
      * Number of CG iterations performed or 0.
      */
     unsigned int cg_iterations;
+    /**
+     * Number of power iterations performed to refresh
+     * AdditionalData::initial_max_eigenvalue or 0.
+     */
+    unsigned int power_iterations;
     /**
      * The degree of the Chebyshev polynomial (either as set using
      * AdditionalData::degree or estimated as described there).
@@ -1173,6 +1246,7 @@ public:
       : min_eigenvalue_estimate{std::numeric_limits<double>::max()}
       , max_eigenvalue_estimate{std::numeric_limits<double>::lowest()}
       , cg_iterations{0}
+      , power_iterations{0}
       , degree{0}
     {}
   };
@@ -1187,7 +1261,9 @@ public:
    * Initializes the factors theta and delta based on an eigenvalue
    * computation. If the user set provided values for the largest eigenvalue
    * in AdditionalData, no computation is performed and the information given
-   * by the user is used.
+   * by the user is used. If an estimate from a previous setup is given in
+   * AdditionalData::initial_max_eigenvalue, it is only refreshed by a few
+   * power iterations as long as it does not change too much.
    */
   EigenvalueInformation
   estimate_eigenvalues(const VectorType &src) const;
@@ -1244,6 +1320,15 @@ private:
    * overwrite the temporary vectors.
    */
   mutable Threads::Mutex mutex;
+
+  /**
+   * Return the indices and the two factors of the updates following the
+   * <tt>degree-1</tt> matrix-vector products of the Chebyshev iteration,
+   * starting with index @p first_index. Used for the variant that merges
+   * the vector updates into the matrix-vector product.
+   */
+  std::vector<std::pair<unsigned int, std::pair<double, double>>>
+  get_fused_iterations(const unsigned int first_index) const;
 };
 
 
@@ -2171,6 +2256,125 @@ namespace internal
 
       std::vector<double> values;
     };
+
+
+
+    // Types for which the vector updates can be merged into the
+    // matrix-vector product, see the class documentation
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    struct supports_fused_updates
+      : std::integral_constant<
+          bool,
+          internal::SolverCG::has_vmult_with_std_functions<MatrixType,
+                                                           VectorType>::value &&
+            internal::SolverCG::is_host_distributed_vector<VectorType>::value &&
+            std::is_same<PreconditionerType,
+                         DiagonalMatrix<VectorType>>::value>
+    {};
+
+
+
+    // Perform the matrix-vector products of the Chebyshev iteration with the
+    // vector updates merged into the loop of the matrix. Each entry of
+    // @p iterations holds the index of the update following a product and
+    // the two factors of the update. If @p perform_initial_update is set, the
+    // update with index zero and factor @p initial_factor2 is done on each
+    // range before the first product accesses it.
+    template <typename MatrixType, typename Number>
+    inline void
+    fused_iterations(
+      const MatrixType &matrix,
+      const DiagonalMatrix<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>> &jacobi,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &rhs,
+      const std::vector<std::pair<unsigned int, std::pair<double, double>>>
+        &          iterations,
+      const bool   perform_initial_update,
+      const double initial_factor2,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &solution_old,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &temp_vector1,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &solution,
+      std::true_type)
+    {
+      const auto do_nothing = [](const unsigned int, const unsigned int) {};
+
+      for (unsigned int i = 0; i < iterations.size(); ++i)
+        {
+          const unsigned int iteration_index = iterations[i].first;
+
+          // the update with index zero only writes into the solution vector,
+          // so it can be performed on a range just before the matrix reads it
+          const VectorUpdater<Number> initial_updater(
+            rhs.begin(),
+            jacobi.get_vector().begin(),
+            0,
+            0.,
+            initial_factor2,
+            solution_old.begin(),
+            temp_vector1.begin(),
+            solution.begin());
+          const VectorUpdater<Number> updater(rhs.begin(),
+                                              jacobi.get_vector().begin(),
+                                              iteration_index,
+                                              iterations[i].second.first,
+                                              iterations[i].second.second,
+                                              solution_old.begin(),
+                                              temp_vector1.begin(),
+                                              solution.begin());
+
+          // the updates for indices one and larger write into vectors that
+          // the matrix does not read, or into the destination vector once it
+          // is final on the range
+          const std::function<void(const unsigned int, const unsigned int)>
+            before = [&](const unsigned int begin, const unsigned int end) {
+              initial_updater.apply_to_subrange(begin, end);
+            };
+          matrix.vmult(temp_vector1,
+                       solution,
+                       (i == 0 && perform_initial_update) ?
+                         before :
+                         std::function<void(const unsigned int,
+                                            const unsigned int)>(do_nothing),
+                       [&](const unsigned int begin, const unsigned int end) {
+                         updater.apply_to_subrange(begin, end);
+                       });
+
+          // swap vectors x^{n+1}->x^{n} as in vector_updates()
+          if (iteration_index == 1)
+            {
+              solution.swap(temp_vector1);
+              solution_old.swap(temp_vector1);
+            }
+          else
+            solution.swap(solution_old);
+        }
+    }
+
+
+
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    inline void
+    fused_iterations(
+      const MatrixType &,
+      const PreconditionerType &,
+      const VectorType &,
+      const std::vector<std::pair<unsigned int, std::pair<double, double>>> &,
+      const bool,
+      const double,
+      VectorType &,
+      VectorType &,
+      VectorType &,
+      std::false_type)
+    {
+      Assert(false, ExcInternalError());
+    }
   } // namespace PreconditionChebyshevImplementation
 } // namespace internal
 
@@ -2188,6 +2392,9 @@ inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , initial_max_eigenvalue(0.)
+  , eig_power_n_iterations(4)
+  , eig_warm_start_tolerance(0.2)
 {}
 
 
@@ -2199,12 +2406,15 @@ inline typename PreconditionChebyshev<MatrixType,
                   PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   AdditionalData::operator=(const AdditionalData &other_data)
 {
-  degree              = other_data.degree;
-  smoothing_range     = other_data.smoothing_range;
-  eig_cg_n_iterations = other_data.eig_cg_n_iterations;
-  eig_cg_residual     = other_data.eig_cg_residual;
-  max_eigenvalue      = other_data.max_eigenvalue;
-  preconditioner      = other_data.preconditioner;
+  degree                   = other_data.degree;
+  smoothing_range          = other_data.smoothing_range;
+  eig_cg_n_iterations      = other_data.eig_cg_n_iterations;
+  eig_cg_residual          = other_data.eig_cg_residual;
+  max_eigenvalue           = other_data.max_eigenvalue;
+  initial_max_eigenvalue   = other_data.initial_max_eigenvalue;
+  eig_power_n_iterations   = other_data.eig_power_n_iterations;
+  eig_warm_start_tolerance = other_data.eig_warm_start_tolerance;
+  preconditioner           = other_data.preconditioner;
   constraints.copy_from(other_data.constraints);
 
   return *this;
@@ -2277,7 +2487,61 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   solution_old.reinit(src);
   temp_vector1.reinit(src, true);
 
-  if (data.eig_cg_n_iterations > 0)
+  // refresh an estimate of a previous setup by a few steps of a power
+  // iteration for the preconditioned matrix P^{-1} A. Since this matrix is
+  // self-adjoint in the energy inner product, the Rayleigh quotient
+  // (P^{-1} A x, A x) / (x, A x) approaches the largest eigenvalue from
+  // below
+  bool warm_start_accepted = false;
+  if (data.initial_max_eigenvalue > 0. && data.eig_cg_n_iterations > 0 &&
+      data.smoothing_range > 1.)
+    {
+      temp_vector2.reinit(src, true);
+      internal::PreconditionChebyshevImplementation::set_initial_guess(
+        temp_vector1);
+      data.constraints.set_zero(temp_vector1);
+
+      double rayleigh_quotient = 0.;
+      for (unsigned int it = 0; it < data.eig_power_n_iterations; ++it)
+        {
+          matrix_ptr->vmult(solution_old, temp_vector1);
+          data.preconditioner->vmult(temp_vector2, solution_old);
+          const double x_A_x = temp_vector1 * solution_old;
+          if (!(x_A_x > 0.))
+            {
+              rayleigh_quotient = 0.;
+              break;
+            }
+          rayleigh_quotient = (temp_vector2 * solution_old) / x_A_x;
+          info.power_iterations = it + 1;
+
+          const double norm = temp_vector2.l2_norm();
+          if (!(norm > 0.))
+            break;
+          temp_vector1.equ(1. / norm, temp_vector2);
+          data.constraints.set_zero(temp_vector1);
+        }
+
+      const double refreshed_estimate = 1.2 * rayleigh_quotient;
+      if (rayleigh_quotient > 0. &&
+          std::abs(refreshed_estimate - data.initial_max_eigenvalue) <=
+            data.eig_warm_start_tolerance * data.initial_max_eigenvalue)
+        {
+          warm_start_accepted          = true;
+          info.max_eigenvalue_estimate =
+            std::max(refreshed_estimate, data.initial_max_eigenvalue);
+          info.min_eigenvalue_estimate =
+            info.max_eigenvalue_estimate / data.smoothing_range;
+        }
+      else
+        {
+          // start the CG estimate from a clean state
+          solution_old = 0.;
+          temp_vector1 = 0.;
+        }
+    }
+
+  if (warm_start_accepted == false && data.eig_cg_n_iterations > 0)
     {
       Assert(data.eig_cg_n_iterations > 2,
              ExcMessage(
@@ -2331,7 +2595,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
 
       info.cg_iterations = control.last_step();
     }
-  else
+  else if (warm_start_accepted == false)
     {
       info.max_eigenvalue_estimate = data.max_eigenvalue;
       info.min_eigenvalue_estimate = data.max_eigenvalue / data.smoothing_range;
@@ -2401,6 +2665,28 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
 
 
 
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline std::vector<std::pair<unsigned int, std::pair<double, double>>>
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  get_fused_iterations(const unsigned int first_index) const
+{
+  std::vector<std::pair<unsigned int, std::pair<double, double>>> iterations;
+  iterations.reserve(data.degree - 1);
+
+  double rhok = delta / theta, sigma = theta / delta;
+  for (unsigned int k = 0; k < data.degree - 1; ++k)
+    {
+      const double rhokp   = 1. / (2. * sigma - rhok);
+      const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
+      rhok                 = rhokp;
+      iterations.emplace_back(k + first_index,
+                              std::make_pair(factor1, factor2));
+    }
+  return iterations;
+}
+
+
+
 template <typename MatrixType, typename VectorType, typename PreconditionerType>
 inline void
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
@@ -2411,6 +2697,25 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
+  using supports_fused_updates = internal::PreconditionChebyshevImplementation::
+    supports_fused_updates<MatrixType, VectorType, PreconditionerType>;
+  if (supports_fused_updates::value && data.degree >= 2 &&
+      std::abs(delta) >= 1e-40)
+    {
+      internal::PreconditionChebyshevImplementation::fused_iterations(
+        *matrix_ptr,
+        *data.preconditioner,
+        rhs,
+        get_fused_iterations(1),
+        true,
+        1. / theta,
+        solution_old,
+        temp_vector1,
+        solution,
+        supports_fused_updates());
+      return;
+    }
+
   internal::PreconditionChebyshevImplementation::vector_updates(
     rhs,
     *data.preconditioner,
@@ -2505,6 +2810,30 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
+  using supports_fused_updates = internal::PreconditionChebyshevImplementation::
+    supports_fused_updates<MatrixType, VectorType, PreconditionerType>;
+  if (supports_fused_updates::value)
+    {
+      auto iterations =
+        (data.degree < 2 || std::abs(delta) < 1e-40) ?
+          std::vector<std::pair<unsigned int, std::pair<double, double>>>() :
+          get_fused_iterations(2);
+      iterations.insert(iterations.begin(),
+                        std::make_pair(1u, std::make_pair(0., 1. / theta)));
+      internal::PreconditionChebyshevImplementation::fused_iterations(
+        *matrix_ptr,
+        *data.preconditioner,
+        rhs,
+        iterations,
+        false,
+        0.,
+        solution_old,
+        temp_vector1,
+        solution,
+        supports_fused_updates());
+      return;
+    }
+
   matrix_ptr->vmult(temp_vector1, solution);
   internal::PreconditionChebyshevImplementation::vector_updates(
     rhs,
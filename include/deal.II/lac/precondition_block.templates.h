@@ -151,6 +151,10 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
             this->inverse_svd(0) = M_cell;
             this->inverse_svd(0).compute_inverse_svd(0.);
             break;
+          case PreconditionBlockBase<inverse_type>::batched_lu:
+            this->inverse_batched().set_matrix(0, M_cell);
+            this->inverse_batched().compute_lu_factorization();
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -206,10 +210,17 @@ PreconditionBlock<MatrixType, inverse_type>::invert_permuted_diagblocks()
                 this->inverse_svd(cell) = M_cell;
                 this->inverse_svd(cell).compute_inverse_svd(0.);
                 break;
+              case PreconditionBlockBase<inverse_type>::batched_lu:
+                this->inverse_batched().set_matrix(cell, M_cell);
+                break;
               default:
                 Assert(false, ExcNotImplemented());
             }
         }
+
+      // factor all blocks at once
+      if (this->inversion == PreconditionBlockBase<inverse_type>::batched_lu)
+        this->inverse_batched().compute_lu_factorization();
     }
   this->inverses_computed(true);
 }
@@ -458,6 +469,10 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
             this->inverse_svd(0) = M_cell;
             this->inverse_svd(0).compute_inverse_svd(1.e-12);
             break;
+          case PreconditionBlockBase<inverse_type>::batched_lu:
+            this->inverse_batched().set_matrix(0, M_cell);
+            this->inverse_batched().compute_lu_factorization();
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -501,10 +516,17 @@ PreconditionBlock<MatrixType, inverse_type>::invert_diagblocks()
                 this->inverse_svd(cell) = M_cell;
                 this->inverse_svd(cell).compute_inverse_svd(1.e-12);
                 break;
+              case PreconditionBlockBase<inverse_type>::batched_lu:
+                this->inverse_batched().set_matrix(cell, M_cell);
+                break;
               default:
                 Assert(false, ExcNotImplemented());
             }
         }
+
+      // factor all blocks at once
+      if (this->inversion == PreconditionBlockBase<inverse_type>::batched_lu)
+        this->inverse_batched().compute_lu_factorization();
     }
   this->inverses_computed(true);
 }
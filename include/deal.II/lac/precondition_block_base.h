@@ -24,6 +24,7 @@
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/subscriptor.h>
 
+#include <deal.II/lac/batched_full_matrix.h>
 #include <deal.II/lac/householder.h>
 #include <deal.II/lac/lapack_full_matrix.h>
 
@@ -81,7 +82,14 @@ public:
     /**
      * Use the singular value decomposition of LAPACKFullMatrix.
      */
-    svd
+    svd,
+    /**
+     * Use the LU factorization of BatchedFullMatrix, which factors many
+     * blocks at once with SIMD instructions instead of calling a
+     * factorization for each block. Blocks smaller than the block size given
+     * to reinit() are padded by the identity matrix.
+     */
+    batched_lu
   };
 
   /**
@@ -178,6 +186,13 @@ public:
   LAPACKFullMatrix<number> &
   inverse_svd(size_type i);
 
+  /**
+   * Access to the factorizations of all diagonal blocks if Inversion is
+   * #batched_lu.
+   */
+  BatchedFullMatrix<number> &
+  inverse_batched();
+
   /**
    * Access to the inverse diagonal blocks.
    */
@@ -196,6 +211,13 @@ public:
   const LAPACKFullMatrix<number> &
   inverse_svd(size_type i) const;
 
+  /**
+   * Access to the factorizations of all diagonal blocks if Inversion is
+   * #batched_lu.
+   */
+  const BatchedFullMatrix<number> &
+  inverse_batched() const;
+
   /**
    * Access to the diagonal blocks.
    */
@@ -272,6 +294,12 @@ private:
    */
   std::vector<LAPACKFullMatrix<number>> var_inverse_svd;
 
+  /**
+   * Storage of the LU factorizations of all diagonal blocks (or of the single
+   * block if #var_same_diagonal is set) if Inversion #batched_lu is used.
+   */
+  BatchedFullMatrix<number> var_inverse_batched;
+
   /**
    * Storage of the original diagonal blocks.
    *
@@ -321,6 +349,7 @@ PreconditionBlockBase<number>::clear()
                                   var_inverse_householder.end());
   if (var_inverse_svd.size() != 0)
     var_inverse_svd.erase(var_inverse_svd.begin(), var_inverse_svd.end());
+  var_inverse_batched.reinit(0, 0);
   if (var_diagonal.size() != 0)
     var_diagonal.erase(var_diagonal.begin(), var_diagonal.end());
   var_same_diagonal  = false;
@@ -355,6 +384,9 @@ PreconditionBlockBase<number>::reinit(unsigned int n,
             var_inverse_svd.resize(1);
             var_inverse_svd[0].reinit(b, b);
             break;
+          case batched_lu:
+            var_inverse_batched.reinit(1, b);
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -399,6 +431,9 @@ PreconditionBlockBase<number>::reinit(unsigned int n,
               var_inverse_svd.swap(tmp);
               break;
             }
+          case batched_lu:
+            var_inverse_batched.reinit(n, b);
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -436,6 +471,10 @@ PreconditionBlockBase<number>::inverse_vmult(size_type              i,
         AssertIndexRange(ii, var_inverse_svd.size());
         var_inverse_svd[ii].vmult(dst, src);
         break;
+      case batched_lu:
+        dst = src;
+        var_inverse_batched.solve(ii, dst);
+        break;
       default:
         Assert(false, ExcNotImplemented());
     }
@@ -465,6 +504,10 @@ PreconditionBlockBase<number>::inverse_Tvmult(size_type              i,
         AssertIndexRange(ii, var_inverse_svd.size());
         var_inverse_svd[ii].Tvmult(dst, src);
         break;
+      case batched_lu:
+        dst = src;
+        var_inverse_batched.solve(ii, dst, true);
+        break;
       default:
         Assert(false, ExcNotImplemented());
     }
@@ -507,6 +550,14 @@ PreconditionBlockBase<number>::inverse_svd(size_type i) const
 }
 
 
+template <typename number>
+inline const BatchedFullMatrix<number> &
+PreconditionBlockBase<number>::inverse_batched() const
+{
+  return var_inverse_batched;
+}
+
+
 template <typename number>
 inline const FullMatrix<number> &
 PreconditionBlockBase<number>::diagonal(size_type i) const
@@ -563,6 +614,15 @@ PreconditionBlockBase<number>::inverse_svd(size_type i)
 }
 
 
+template <typename number>
+inline BatchedFullMatrix<number> &
+PreconditionBlockBase<number>::inverse_batched()
+{
+  Assert(inversion == batched_lu, ExcInverseNotAvailable());
+  return var_inverse_batched;
+}
+
+
 template <typename number>
 inline FullMatrix<number> &
 PreconditionBlockBase<number>::diagonal(size_type i)
@@ -653,6 +713,8 @@ PreconditionBlockBase<number>::log_statistics() const
     {}
   else if (inversion == gauss_jordan)
     {}
+  else if (inversion == batched_lu)
+    {}
   else
     {
       Assert(false, ExcNotImplemented());
@@ -669,6 +731,7 @@ PreconditionBlockBase<number>::memory_consumption() const
     mem += MemoryConsumption::memory_consumption(var_inverse_full[i]);
   for (size_type i = 0; i < var_diagonal.size(); ++i)
     mem += MemoryConsumption::memory_consumption(var_diagonal[i]);
+  mem += var_inverse_batched.memory_consumption();
   return mem;
 }
 
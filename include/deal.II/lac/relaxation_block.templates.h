@@ -68,8 +68,19 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::initialize(
   additional_data = &parameters;
   this->inversion = parameters.inversion;
 
+  // the batched factorization stores all blocks with the size of the
+  // largest one
+  size_type max_block_size = 0;
+  if (additional_data->inversion ==
+      PreconditionBlockBase<InverseNumberType>::batched_lu)
+    for (size_type block = 0; block < additional_data->block_list.n_rows();
+         ++block)
+      max_block_size =
+        std::max<size_type>(max_block_size,
+                 additional_data->block_list.row_length(block));
+
   this->reinit(additional_data->block_list.n_rows(),
-               0,
+               max_block_size,
                additional_data->same_diagonal,
                additional_data->inversion);
 
@@ -106,6 +117,10 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::invert_diagblocks()
                                      this->block_kernel(block_begin, block_end);
                                    },
                                    16);
+
+      if (this->inversion ==
+          PreconditionBlockBase<InverseNumberType>::batched_lu)
+        this->inverse_batched().compute_lu_factorization();
     }
   this->inverses_computed(true);
 }
@@ -168,6 +183,11 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
               this->inverse_svd(block).compute_inverse_svd(
                 this->additional_data->threshold);
             break;
+          case PreconditionBlockBase<InverseNumberType>::batched_lu:
+            // the factorization of all blocks is computed at once in
+            // invert_diagblocks()
+            this->inverse_batched().set_matrix(block, M_cell);
+            break;
           default:
             Assert(false, ExcNotImplemented());
         }
@@ -206,6 +206,29 @@ public:
   copy_from(const LAPACKFullMatrix<NumberType> &matrix,
             const unsigned int                  rank);
 
+  /**
+   * Start copying the content of the locally owned @p matrix on the process
+   * with rank @p rank to the distributed matrix, with the same requirements
+   * as copy_from(). In contrast to copy_from(), this function only posts
+   * nonblocking MPI sends and receives and returns immediately, so other
+   * work can be done while the data is in transit. The process @p rank packs
+   * the blocks of all processes into a send buffer, such that @p matrix can
+   * be modified or destroyed after this function returns.
+   *
+   * The copy has to be completed by a call to copy_from_finish() before the
+   * distributed matrix can be used. Only one copy can be in progress at a
+   * time for a given object.
+   */
+  void
+  copy_from_start(const LAPACKFullMatrix<NumberType> &matrix,
+                  const unsigned int                  rank);
+
+  /**
+   * Wait for the copy started by copy_from_start() to complete.
+   */
+  void
+  copy_from_finish();
+
   /**
    * Copy the contents of the distributed matrix into @p matrix.
    *
@@ -559,6 +582,35 @@ public:
     const std::pair<unsigned int, unsigned int> &index_limits,
     const bool                                   compute_eigenvectors);
 
+  /**
+   * Compute the eigenvalues and eigenvectors selected by the range of indices
+   * @p index_limits, like eigenpairs_symmetric_by_index(), but do the
+   * expensive part of the work, the reduction to tridiagonal form and the
+   * computation of the eigenvectors, in single precision. The single
+   * precision eigenvectors are then improved in @p NumberType by
+   * @p n_refinement_steps steps of a Rayleigh-Ritz projection onto the space
+   * spanned by the current eigenvectors $\mathbf{V}$ and $\mathbf{A}
+   * \mathbf{V}$.
+   *
+   * For $k$ selected eigenpairs, each refinement step costs two distributed
+   * matrix-matrix products with $M \times k$ matrices and the solution of a
+   * dense eigenvalue problem of size $2k$ on each process. This is cheap
+   * compared to the $\mathcal{O}(M^3)$ work of the reduction to tridiagonal
+   * form if $k \ll M$, which makes the function attractive for computing a
+   * few well-separated modes to moderate accuracy, e.g., in proper orthogonal
+   * decomposition. The accuracy of the eigenpairs depends on the separation
+   * of the selected eigenvalues from the rest of the spectrum, and clusters
+   * are resolved at most to the accuracy of the single precision solution.
+   *
+   * If successful, the computed eigenvalues are arranged in ascending order,
+   * and the eigenvectors are stored in the first columns of the matrix,
+   * thereby overwriting the original content of the matrix.
+   */
+  std::vector<NumberType>
+  eigenpairs_symmetric_by_index_mixed_precision(
+    const std::pair<unsigned int, unsigned int> &index_limits,
+    const unsigned int                           n_refinement_steps = 1);
+
   /**
    * Computing selected eigenvalues and, optionally, the eigenvectors of the
    * real symmetric matrix $\mathbf{A} \in \mathbb{R}^{M \times M}$ using the
@@ -950,6 +1002,17 @@ private:
    */
   std::vector<int> ipiv;
 
+  /**
+   * The requests of the MPI communication started by copy_from_start().
+   */
+  std::vector<MPI_Request> copy_from_requests;
+
+  /**
+   * The buffer holding the data sent by copy_from_start() on the sending
+   * process until copy_from_finish() is called.
+   */
+  std::vector<NumberType> copy_from_send_buffer;
+
   /**
    * A character to define where elements are stored in case
    * ScaLAPACK operations support this.
@@ -21,19 +21,35 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
 
+#include <array>
 #include <cmath>
+#include <functional>
+#include <mutex>
+#include <type_traits>
 
 DEAL_II_NAMESPACE_OPEN
 
 // forward declaration
 #ifndef DOXYGEN
 class PreconditionIdentity;
+template <typename VectorType>
+class DiagonalMatrix;
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  }
+} // namespace LinearAlgebra
 #endif
 
 
@@ -90,6 +106,36 @@ class PreconditionIdentity;
  * The solve() function of this class uses the mechanism described in the
  * Solver base class to determine convergence. This mechanism can also be used
  * to observe the progress of the iteration.
+ *
+ * <h3>Fused implementation for matrix-free operators</h3>
+ *
+ * The vector updates and inner products of the CG method read and write
+ * about six vectors per iteration, which is often more expensive than a
+ * matrix-vector product in matrix-free form. If the vector type is
+ * LinearAlgebra::distributed::Vector, the preconditioner is either
+ * PreconditionIdentity or DiagonalMatrix, and the matrix provides a function
+ * @code
+ * void vmult(VectorType &dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_before_matrix_vector_product,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_after_matrix_vector_product) const;
+ * @endcode
+ * the solver merges all vector operations into these two functions, which
+ * are called with ranges <tt>[begin, end)</tt> of locally owned entries in
+ * MPI-local numbering. The matrix must call the first function on a range
+ * before it reads @p src or writes @p dst in that range (including zeroing
+ * @p dst and the import of ghost values). It must call the second function
+ * on a range once @p dst is final there. This is exactly the contract of
+ * the variant of MatrixFree::cell_loop() with `operation_before_loop` and
+ * `operation_after_loop`, with the zeroing of @p dst placed into the former.
+ *
+ * In this mode, the update of the solution vector is deferred to the next
+ * iteration. The residual norm and the inner product with the preconditioned
+ * residual are computed from a recurrence of inner products involving the
+ * result of the matrix-vector product, so they can differ in the last
+ * digits from the classical variant.
  */
 template <typename VectorType = Vector<double>>
 class SolverCG : public SolverBase<VectorType>
@@ -193,6 +239,30 @@ protected:
       &                                          eigenvalues_signal,
     const boost::signals2::signal<void(double)> &cond_signal);
 
+  /**
+   * Implementation of solve() with separate vector operations, used for all
+   * general matrix and preconditioner types.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve_internal(const MatrixType &        A,
+                 VectorType &              x,
+                 const VectorType &        b,
+                 const PreconditionerType &preconditioner,
+                 std::false_type);
+
+  /**
+   * Implementation of solve() that merges the vector operations into the
+   * matrix-vector product, see the class documentation.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve_internal(const MatrixType &        A,
+                 VectorType &              x,
+                 const VectorType &        b,
+                 const PreconditionerType &preconditioner,
+                 std::true_type);
+
   /**
    * Additional parameters.
    */
@@ -237,6 +307,103 @@ protected:
 
 #ifndef DOXYGEN
 
+namespace internal
+{
+  namespace SolverCG
+  {
+    // A helper type-trait that leverages SFINAE to figure out if the matrix
+    // type has a vmult() function with functions to be called before and
+    // after the matrix-vector product on ranges of the vector
+    template <typename MatrixType, typename VectorType>
+    struct has_vmult_with_std_functions
+    {
+    private:
+      using RangeFunction =
+        std::function<void(const unsigned int, const unsigned int)>;
+
+      static bool
+      detect(...);
+
+      template <typename U>
+      static decltype(
+        std::declval<const U>().vmult(std::declval<VectorType &>(),
+                                      std::declval<const VectorType &>(),
+                                      std::declval<const RangeFunction &>(),
+                                      std::declval<const RangeFunction &>()))
+      detect(const U &);
+
+    public:
+      static const bool value =
+        !std::is_same<bool,
+                      decltype(detect(std::declval<MatrixType>()))>::value;
+    };
+
+
+
+    // The fused iteration needs direct access to the locally owned range
+    template <typename VectorType>
+    struct is_host_distributed_vector : std::false_type
+    {};
+
+    template <typename Number>
+    struct is_host_distributed_vector<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+      : std::true_type
+    {};
+
+
+
+    // Preconditioners that can be applied entry by entry
+    template <typename VectorType, typename PreconditionerType>
+    struct is_diagonal_preconditioner : std::false_type
+    {};
+
+    template <typename VectorType>
+    struct is_diagonal_preconditioner<VectorType, PreconditionIdentity>
+      : std::true_type
+    {};
+
+    template <typename VectorType>
+    struct is_diagonal_preconditioner<VectorType, DiagonalMatrix<VectorType>>
+      : std::true_type
+    {};
+
+
+
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    struct supports_fused_iteration
+      : std::integral_constant<
+          bool,
+          has_vmult_with_std_functions<MatrixType, VectorType>::value &&
+            is_host_distributed_vector<VectorType>::value &&
+            is_diagonal_preconditioner<VectorType, PreconditionerType>::value>
+    {};
+
+
+
+    // Return the locally owned entries of the diagonal preconditioner, or
+    // nullptr for the identity
+    template <typename VectorType>
+    inline const typename VectorType::value_type *
+    get_diagonal_entries(const PreconditionIdentity &)
+    {
+      return nullptr;
+    }
+
+
+
+    template <typename VectorType>
+    inline const typename VectorType::value_type *
+    get_diagonal_entries(const DiagonalMatrix<VectorType> &preconditioner)
+    {
+      return preconditioner.get_vector().begin();
+    }
+  } // namespace SolverCG
+} // namespace internal
+
+
 template <typename VectorType>
 SolverCG<VectorType>::SolverCG(SolverControl &           cn,
                                VectorMemory<VectorType> &mem,
@@ -319,6 +486,27 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
                             VectorType &              x,
                             const VectorType &        b,
                             const PreconditionerType &preconditioner)
+{
+  solve_internal(A,
+                 x,
+                 b,
+                 preconditioner,
+                 internal::SolverCG::supports_fused_iteration<
+                   MatrixType,
+                   VectorType,
+                   PreconditionerType>());
+}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCG<VectorType>::solve_internal(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner,
+                                     std::false_type)
 {
   using number = typename VectorType::value_type;
 
@@ -459,6 +647,210 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
 
 
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCG<VectorType>::solve_internal(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner,
+                                     std::true_type)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("cg");
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &g = *g_pointer;
+  VectorType &d = *d_pointer;
+  VectorType &h = *h_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues =
+    !condition_number_signal.empty() || !all_condition_numbers_signal.empty() ||
+    !eigenvalues_signal.empty() || !all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<typename VectorType::value_type> diagonal;
+  std::vector<typename VectorType::value_type> offdiagonal;
+
+  typename VectorType::value_type eigen_beta_alpha = 0;
+
+  // resize the vectors, but do not set the values since they'd be overwritten
+  // soon anyway.
+  g.reinit(x, true);
+  d.reinit(x, true);
+  h.reinit(x, true);
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(g, x);
+      g.add(-1., b);
+    }
+  else
+    g.equ(-1., b);
+
+  double res = g.l2_norm();
+  conv       = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  // entries of the diagonal preconditioner, a nullptr for the identity
+  const number *const inverse_diagonal =
+    internal::SolverCG::get_diagonal_entries<VectorType>(preconditioner);
+
+  number *const       x_ptr      = x.begin();
+  number *const       g_ptr      = g.begin();
+  number *const       d_ptr      = d.begin();
+  const number *const h_ptr      = h.begin();
+  const unsigned int  local_size = x.locally_owned_size();
+
+  int    it        = 0;
+  number beta      = number();
+  number alpha     = number();
+  number old_alpha = number();
+
+  // The inner products collected in the two operations around the
+  // matrix-vector product: g*g, g*Pg, g*d of the current residual and
+  // search direction, and d*h, g*h, h*h, (Pg)*h, h*(Ph) of the result of
+  // the product. The former are exact and let alpha minimize along d, the
+  // latter give the residual norm and the next beta without another pass
+  // through the vectors.
+  std::array<number, 8> sums;
+  std::mutex            sums_mutex;
+
+  while (conv == SolverControl::iterate)
+    {
+      it++;
+      old_alpha = alpha;
+      sums.fill(number());
+
+      const auto operation_before_vmult = [&](const unsigned int begin,
+                                              const unsigned int end) {
+        AssertIndexRange(end, local_size + 1);
+        number gg = number(), gz = number(), gd = number();
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            // apply the update of the previous iteration to x and g before
+            // computing the new search direction
+            if (it > 1)
+              {
+                x_ptr[i] += alpha * d_ptr[i];
+                g_ptr[i] += alpha * h_ptr[i];
+              }
+            const number z = inverse_diagonal == nullptr ?
+                               g_ptr[i] :
+                               inverse_diagonal[i] * g_ptr[i];
+            d_ptr[i] = (it > 1 ? beta * d_ptr[i] : number()) - z;
+            gg += g_ptr[i] * g_ptr[i];
+            gz += g_ptr[i] * z;
+            gd += g_ptr[i] * d_ptr[i];
+          }
+
+        // ranges are processed concurrently in threaded loops
+        std::lock_guard<std::mutex> lock(sums_mutex);
+        sums[0] += gg;
+        sums[1] += gz;
+        sums[2] += gd;
+      };
+
+      const auto operation_after_vmult = [&](const unsigned int begin,
+                                             const unsigned int end) {
+        AssertIndexRange(end, local_size + 1);
+        number dh = number(), gh = number(), hh = number();
+        number zh = number(), hzh = number();
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            dh += d_ptr[i] * h_ptr[i];
+            gh += g_ptr[i] * h_ptr[i];
+            hh += h_ptr[i] * h_ptr[i];
+            if (inverse_diagonal != nullptr)
+              {
+                zh += inverse_diagonal[i] * g_ptr[i] * h_ptr[i];
+                hzh += h_ptr[i] * inverse_diagonal[i] * h_ptr[i];
+              }
+          }
+        if (inverse_diagonal == nullptr)
+          {
+            zh  = gh;
+            hzh = hh;
+          }
+
+        std::lock_guard<std::mutex> lock(sums_mutex);
+        sums[3] += dh;
+        sums[4] += gh;
+        sums[5] += hh;
+        sums[6] += zh;
+        sums[7] += hzh;
+      };
+
+      A.vmult(h, d, operation_before_vmult, operation_after_vmult);
+
+      Utilities::MPI::sum(ArrayView<const number>(sums.data(), sums.size()),
+                          x.get_mpi_communicator(),
+                          ArrayView<number>(sums.data(), sums.size()));
+
+      Assert(std::abs(sums[3]) != 0., ExcDivideByZero());
+      alpha = -sums[2] / sums[3];
+
+      // the residual in the next iteration is g + alpha h, so compute its
+      // norm and its product with the preconditioned residual from the
+      // inner products collected above
+      res = std::sqrt(
+        std::abs(sums[0] + 2. * alpha * sums[4] + alpha * alpha * sums[5]));
+      const number gz_new =
+        std::abs(sums[1] + 2. * alpha * sums[6] + alpha * alpha * sums[7]);
+
+      print_vectors(it, x, g, d);
+
+      if (it > 1)
+        {
+          this->coefficients_signal(old_alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal of
+          // the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / old_alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / old_alpha;
+              offdiagonal.push_back(std::sqrt(beta) / old_alpha);
+            }
+          compute_eigs_and_cond(diagonal,
+                                offdiagonal,
+                                all_eigenvalues_signal,
+                                all_condition_numbers_signal);
+        }
+
+      Assert(std::abs(sums[1]) != 0., ExcDivideByZero());
+      beta = gz_new / sums[1];
+
+      conv = this->iteration_status(it, res, x);
+    }
+
+  // apply the last update to the solution that has been deferred so far
+  x.add(alpha, d);
+
+  compute_eigs_and_cond(diagonal,
+                        offdiagonal,
+                        eigenvalues_signal,
+                        condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+
+
 template <typename VectorType>
 boost::signals2::connection
 SolverCG<VectorType>::connect_coefficients_slot(
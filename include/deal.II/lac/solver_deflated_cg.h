@@ -0,0 +1,686 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_deflated_cg_h
+#define dealii_solver_deflated_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the deflated preconditioned Conjugate Gradients
+ * method of Y. Saad, M. Yeung, J. Erhel and F. Guyomarc'h, "A deflated
+ * version of the conjugate gradient algorithm", SIAM J. Sci. Comput. 21
+ * (2000), pp. 1909-1926. It solves the same problems as SolverCG, but
+ * removes the components of the error in a given deflation space $W$ of a
+ * few vectors: The initial guess is corrected such that the residual is
+ * orthogonal to $W$, and each new search direction is made $A$-orthogonal
+ * to $W$. If $W$ approximates the eigenvectors of the preconditioned matrix
+ * belonging to its smallest eigenvalues, the convergence of the method is
+ * governed by the remaining eigenvalues only. This is useful when a few
+ * near-null-space modes are not captured by the preconditioner, e.g., for
+ * diffusion problems with high-contrast coefficients and a multigrid
+ * preconditioner.
+ *
+ * The deflation space can be given through set_deflation_vectors(). It can
+ * also be extracted automatically from the Lanczos process underlying the
+ * CG iteration: If AdditionalData::n_extracted_vectors is positive, the
+ * solver keeps the first AdditionalData::n_lanczos_vectors Lanczos vectors,
+ * i.e., the normalized preconditioned residuals, and computes the Ritz
+ * vectors of the smallest Ritz values of the tridiagonal matrix built from
+ * the CG coefficients (as described in the documentation of SolverCG) at the
+ * end of each solve(). These vectors are appended to the deflation space and
+ * used in subsequent calls to solve(), until the deflation space holds
+ * AdditionalData::max_n_deflation_vectors vectors. This way, a sequence of
+ * linear systems with the same or a slowly changing matrix becomes cheaper
+ * with every solve.
+ *
+ * At the beginning of each solve(), the deflation vectors are multiplied by
+ * the matrix and orthonormalized with respect to the inner product induced
+ * by the matrix, which costs one matrix-vector product per deflation vector
+ * and makes the method valid also if the matrix changed since the previous
+ * call. Vectors that are numerically linearly dependent on the previous
+ * ones are removed. Each iteration then needs the inner products of the
+ * preconditioned residual with the images of all deflation vectors, which
+ * are computed together with the inner product of the residual and the
+ * preconditioned residual. For LinearAlgebra::distributed::Vector, this is
+ * done with LinearAlgebra::distributed::Vector::multi_dot() in a single pass
+ * through the vectors and with a single global reduction, and the update of
+ * the search direction uses LinearAlgebra::distributed::Vector::multi_add().
+ *
+ * Since the projected search directions cannot reduce the component of the
+ * residual in the deflation space, the rounding errors in that component
+ * limit the attainable accuracy. Unlike SolverCG, whose updated residual
+ * keeps decreasing below the accuracy of the true residual, the method
+ * stagnates at this level, so the tolerance should not be chosen below the
+ * accuracy the problem allows for.
+ *
+ * The class is derived from SolverCG and provides the same interface to
+ * observe the progress of the iteration. The eigenvalue and condition number
+ * estimates connected via SolverCG::connect_eigenvalues_slot() and
+ * SolverCG::connect_condition_number_slot() refer to the deflated operator.
+ *
+ * The computation of the Ritz vectors uses LAPACKFullMatrix and thus
+ * requires deal.II to be configured with LAPACK.
+ */
+template <typename VectorType = Vector<double>>
+class SolverDeflatedCG : public SolverCG<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, no vectors are extracted from the Lanczos
+     * process, i.e., only the vectors given by set_deflation_vectors() are
+     * used.
+     */
+    explicit AdditionalData(const unsigned int n_extracted_vectors     = 0,
+                            const unsigned int max_n_deflation_vectors = 20,
+                            const unsigned int n_lanczos_vectors       = 30);
+
+    /**
+     * Number of Ritz vectors that are added to the deflation space at the
+     * end of each call to solve().
+     */
+    unsigned int n_extracted_vectors;
+
+    /**
+     * Maximal size of the deflation space. Once it is reached, no further
+     * vectors are extracted.
+     */
+    unsigned int max_n_deflation_vectors;
+
+    /**
+     * Number of Lanczos vectors kept for the extraction of Ritz vectors. The
+     * memory consumption of the solver grows by this number of vectors when
+     * #n_extracted_vectors is positive.
+     */
+    unsigned int n_lanczos_vectors;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverDeflatedCG(SolverControl &           cn,
+                   VectorMemory<VectorType> &mem,
+                   const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverDeflatedCG(SolverControl &       cn,
+                   const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+  /**
+   * Set the deflation space to the span of the given @p vectors, replacing
+   * the current one. The vectors need not be orthogonal.
+   */
+  void
+  set_deflation_vectors(const std::vector<VectorType> &vectors);
+
+  /**
+   * Remove all vectors from the deflation space.
+   */
+  void
+  clear_deflation_vectors();
+
+  /**
+   * Return the number of vectors in the deflation space.
+   */
+  unsigned int
+  n_deflation_vectors() const;
+
+  /**
+   * Return the vectors spanning the deflation space. After a call to
+   * solve(), they are orthonormal with respect to the inner product induced
+   * by the matrix of that call, followed by the vectors extracted in that
+   * call.
+   */
+  const std::vector<VectorType> &
+  get_deflation_vectors() const;
+
+protected:
+  /**
+   * Compute the images of the deflation vectors under @p A and make the
+   * deflation vectors orthonormal in the inner product induced by @p A with
+   * the modified Gram-Schmidt method.
+   */
+  template <typename MatrixType>
+  void
+  setup_deflation_space(const MatrixType &A);
+
+  /**
+   * Append the Ritz vectors of the smallest Ritz values of the tridiagonal
+   * Lanczos matrix given by @p diagonal and @p offdiagonal to the deflation
+   * space, using the Lanczos vectors in @p lanczos_vectors.
+   */
+  void
+  extract_ritz_vectors(
+    const std::vector<typename VectorType::value_type> &diagonal,
+    const std::vector<typename VectorType::value_type> &offdiagonal,
+    const std::vector<typename VectorMemory<VectorType>::Pointer>
+      &lanczos_vectors);
+
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The vectors spanning the deflation space.
+   */
+  std::vector<VectorType> deflation_vectors;
+
+  /**
+   * The images of the deflation vectors under the matrix.
+   */
+  std::vector<VectorType> deflation_images;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverDeflatedCG
+  {
+    // Compute the inner products of @p z with all vectors in @p vectors. The
+    // general implementation uses the inner product of the vector class.
+    template <typename VectorType>
+    void
+    multi_dot(const VectorType &                            z,
+              const std::vector<const VectorType *> &       vectors,
+              std::vector<typename VectorType::value_type> &results)
+    {
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        results[i] = z * *vectors[i];
+    }
+
+
+
+    // Add the linear combination of @p vectors with coefficients @p factors
+    // to @p p.
+    template <typename VectorType>
+    void
+    multi_add(VectorType &                                        p,
+              const std::vector<typename VectorType::value_type> &factors,
+              const std::vector<const VectorType *> &             vectors)
+    {
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        p.add(factors[i], *vectors[i]);
+    }
+
+
+
+    // Specializations for LinearAlgebra::distributed::Vector, going once
+    // through the vectors with a single global reduction
+    template <typename Number>
+    void
+    multi_dot(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &z,
+      const std::vector<
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> *>
+        &                  vectors,
+      std::vector<Number> &results)
+    {
+      z.multi_dot(vectors, make_array_view(results));
+    }
+
+
+
+    template <typename Number>
+    void
+    multi_add(
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &p,
+      const std::vector<Number> &                                    factors,
+      const std::vector<
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> *>
+        &vectors)
+    {
+      p.multi_add(make_array_view(factors), vectors);
+    }
+  } // namespace SolverDeflatedCG
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverDeflatedCG<VectorType>::AdditionalData::AdditionalData(
+  const unsigned int n_extracted_vectors,
+  const unsigned int max_n_deflation_vectors,
+  const unsigned int n_lanczos_vectors)
+  : n_extracted_vectors(n_extracted_vectors)
+  , max_n_deflation_vectors(max_n_deflation_vectors)
+  , n_lanczos_vectors(n_lanczos_vectors)
+{
+  Assert(n_extracted_vectors == 0 || n_extracted_vectors <= n_lanczos_vectors,
+         ExcMessage("The number of extracted vectors must not exceed the "
+                    "number of Lanczos vectors."));
+}
+
+
+
+template <typename VectorType>
+SolverDeflatedCG<VectorType>::SolverDeflatedCG(SolverControl &           cn,
+                                               VectorMemory<VectorType> &mem,
+                                               const AdditionalData &    data)
+  : SolverCG<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverDeflatedCG<VectorType>::SolverDeflatedCG(SolverControl &       cn,
+                                               const AdditionalData &data)
+  : SolverCG<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+void
+SolverDeflatedCG<VectorType>::set_deflation_vectors(
+  const std::vector<VectorType> &vectors)
+{
+  deflation_vectors = vectors;
+  deflation_images.clear();
+}
+
+
+
+template <typename VectorType>
+void
+SolverDeflatedCG<VectorType>::clear_deflation_vectors()
+{
+  deflation_vectors.clear();
+  deflation_images.clear();
+}
+
+
+
+template <typename VectorType>
+inline unsigned int
+SolverDeflatedCG<VectorType>::n_deflation_vectors() const
+{
+  return deflation_vectors.size();
+}
+
+
+
+template <typename VectorType>
+inline const std::vector<VectorType> &
+SolverDeflatedCG<VectorType>::get_deflation_vectors() const
+{
+  return deflation_vectors;
+}
+
+
+
+template <typename VectorType>
+template <typename MatrixType>
+void
+SolverDeflatedCG<VectorType>::setup_deflation_space(const MatrixType &A)
+{
+  deflation_images.resize(deflation_vectors.size());
+
+  unsigned int n_kept = 0;
+  for (unsigned int i = 0; i < deflation_vectors.size(); ++i)
+    {
+      if (n_kept < i)
+        std::swap(deflation_vectors[n_kept], deflation_vectors[i]);
+      VectorType &w  = deflation_vectors[n_kept];
+      VectorType &aw = deflation_images[n_kept];
+      aw.reinit(w, true);
+      A.vmult(aw, w);
+
+      // orthogonalize twice to keep the projections accurate when the
+      // vectors are nearly dependent
+      const double initial_norm = std::sqrt(std::abs(w * aw));
+      for (unsigned int pass = 0; pass < 2; ++pass)
+        for (unsigned int l = 0; l < n_kept; ++l)
+          {
+            const typename VectorType::value_type h = deflation_images[l] * w;
+            w.add(-h, deflation_vectors[l]);
+            aw.add(-h, deflation_images[l]);
+          }
+
+      const double norm = std::sqrt(std::abs(w * aw));
+      if (norm > 1e-6 * initial_norm)
+        {
+          w /= norm;
+          aw /= norm;
+          ++n_kept;
+        }
+    }
+
+  deflation_vectors.resize(n_kept);
+  deflation_images.resize(n_kept);
+}
+
+
+
+template <typename VectorType>
+void
+SolverDeflatedCG<VectorType>::extract_ritz_vectors(
+  const std::vector<typename VectorType::value_type> &diagonal,
+  const std::vector<typename VectorType::value_type> &offdiagonal,
+  const std::vector<typename VectorMemory<VectorType>::Pointer>
+    &lanczos_vectors)
+{
+  const unsigned int m =
+    std::min<std::size_t>(diagonal.size(), lanczos_vectors.size());
+  const unsigned int n_new =
+    std::min({additional_data.n_extracted_vectors,
+              additional_data.max_n_deflation_vectors -
+                static_cast<unsigned int>(deflation_vectors.size()),
+              m / 2});
+  if (n_new == 0)
+    return;
+
+  // The tridiagonal matrix is positive definite, so its eigenvalues are
+  // contained in the interval (0, max row sum]
+  LAPACKFullMatrix<double> T(m, m);
+  double                   upper_bound = 0.;
+  for (unsigned int i = 0; i < m; ++i)
+    {
+      T(i, i) = diagonal[i];
+      if (i + 1 < m)
+        T(i, i + 1) = T(i + 1, i) = offdiagonal[i];
+      upper_bound =
+        std::max(upper_bound,
+                 std::abs(T(i, i)) + (i > 0 ? std::abs(T(i, i - 1)) : 0.) +
+                   (i + 1 < m ? std::abs(T(i, i + 1)) : 0.));
+    }
+
+  Vector<double>     eigenvalues;
+  FullMatrix<double> eigenvectors;
+  T.compute_eigenvalues_symmetric(
+    0., 1.01 * upper_bound, 0., eigenvalues, eigenvectors);
+
+  // The eigenvalues are returned in ascending order, so the Ritz vectors of
+  // the smallest Ritz values are the first columns. Only take those Ritz
+  // pairs that have converged to some degree, since poorly converged vectors
+  // slow down later solves rather than accelerating them. The residual of a
+  // Ritz pair is the coupling of T to the next Lanczos vector times the last
+  // entry of the eigenvector of T.
+  const double coupling =
+    (m < diagonal.size() ? std::abs(offdiagonal[m - 1]) : 0.);
+  unsigned int n_added = 0;
+  for (unsigned int l = 0; l < eigenvalues.size() && n_added < n_new; ++l)
+    {
+      if (coupling * std::abs(eigenvectors(m - 1, l)) >
+          0.05 * eigenvalues(l))
+        continue;
+      ++n_added;
+      deflation_vectors.emplace_back();
+      VectorType &w = deflation_vectors.back();
+      w.reinit(*lanczos_vectors[0]);
+      for (unsigned int j = 0; j < m; ++j)
+        w.add(eigenvectors(j, l), *lanczos_vectors[j]);
+    }
+}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverDeflatedCG<VectorType>::solve(const MatrixType &        A,
+                                    VectorType &              x,
+                                    const VectorType &        b,
+                                    const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("deflated_cg");
+
+  // Memory allocation. r is the residual, z the preconditioned residual, p the
+  // search direction and h = A p.
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &r = *r_pointer;
+  VectorType &z = *z_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &h = *h_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_extraction =
+    additional_data.n_extracted_vectors > 0 &&
+    deflation_vectors.size() < additional_data.max_n_deflation_vectors;
+  const bool do_eigenvalues = do_extraction ||
+                              !this->condition_number_signal.empty() ||
+                              !this->all_condition_numbers_signal.empty() ||
+                              !this->eigenvalues_signal.empty() ||
+                              !this->all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<typename VectorType::value_type> diagonal;
+  std::vector<typename VectorType::value_type> offdiagonal;
+
+  typename VectorType::value_type eigen_beta_alpha = 0;
+
+  // the Lanczos vectors kept for the extraction of Ritz vectors
+  std::vector<typename VectorMemory<VectorType>::Pointer> lanczos_vectors;
+
+  // resize the vectors, but do not set the values since they'd be overwritten
+  // soon anyway.
+  r.reinit(x, true);
+  z.reinit(x, true);
+  p.reinit(x, true);
+  h.reinit(x, true);
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  // Make the deflation space fit the current matrix
+  if (deflation_vectors.size() > 0)
+    {
+      Assert(deflation_vectors[0].size() == x.size(),
+             ExcMessage("The size of the deflation vectors does not match "
+                        "the size of the solution vector."));
+      setup_deflation_space(A);
+    }
+
+  // Pointers to the deflation vectors and their images, the latter followed
+  // by the residual for the combined reduction in each iteration
+  const unsigned int              k = deflation_vectors.size();
+  std::vector<const VectorType *> deflation_pointers(k);
+  std::vector<const VectorType *> image_pointers(k);
+  for (unsigned int i = 0; i < k; ++i)
+    {
+      deflation_pointers[i] = &deflation_vectors[i];
+      image_pointers[i]     = &deflation_images[i];
+    }
+  std::vector<const VectorType *> reduction_pointers(image_pointers);
+  reduction_pointers.push_back(&r);
+
+  std::vector<number> mu(k);
+  std::vector<number> inner_products(k + 1);
+
+  // The deflation vectors are orthonormal in the energy inner product, so
+  // the correction of x that makes the residual orthogonal to them is
+  // W W^T r, which changes the residual by -A W W^T r.
+  if (k > 0)
+    for (unsigned int pass = 0; pass < 2; ++pass)
+      {
+        internal::SolverDeflatedCG::multi_dot(r, deflation_pointers, mu);
+        internal::SolverDeflatedCG::multi_add(x, mu, deflation_pointers);
+        for (number &m : mu)
+          m = -m;
+        internal::SolverDeflatedCG::multi_add(r, mu, image_pointers);
+      }
+
+  double res = r.l2_norm();
+  conv       = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  int    it        = 0;
+  number rz        = number();
+  number beta      = number();
+  number alpha     = number();
+  number old_alpha = number();
+
+  while (conv == SolverControl::iterate)
+    {
+      it++;
+      old_alpha = alpha;
+
+      preconditioner.vmult(z, r);
+
+      // compute the inner products of z with the images of the deflation
+      // vectors and with the residual in one go, and project z onto the
+      // complement of the deflation space in the energy inner product. This
+      // does not change the inner product with r, which is orthogonal to the
+      // deflation space.
+      internal::SolverDeflatedCG::multi_dot(z,
+                                            reduction_pointers,
+                                            inner_products);
+      for (unsigned int i = 0; i < k; ++i)
+        mu[i] = -inner_products[i];
+      internal::SolverDeflatedCG::multi_add(z, mu, deflation_pointers);
+
+      const number old_rz = rz;
+      rz                  = inner_products[k];
+
+      // the projected preconditioned residuals, scaled to unit length in the
+      // inner product with r and with alternating signs, are the Lanczos
+      // vectors of the iteration
+      if (do_extraction &&
+          lanczos_vectors.size() < additional_data.n_lanczos_vectors)
+        {
+          lanczos_vectors.emplace_back(this->memory);
+          lanczos_vectors.back()->reinit(x, true);
+          lanczos_vectors.back()->equ((it % 2 == 1 ? 1. : -1.) /
+                                        std::sqrt(std::abs(rz)),
+                                      z);
+        }
+
+      if (it > 1)
+        {
+          Assert(std::abs(old_rz) != 0., ExcDivideByZero());
+          beta = rz / old_rz;
+          p.sadd(beta, 1., z);
+        }
+      else
+        p = z;
+
+      A.vmult(h, p);
+
+      alpha = p * h;
+      Assert(std::abs(alpha) != 0., ExcDivideByZero());
+      alpha = rz / alpha;
+
+      x.add(alpha, p);
+      res = std::sqrt(std::abs(r.add_and_dot(-alpha, h, r)));
+
+      this->print_vectors(it, x, r, p);
+
+      if (it > 1)
+        {
+          this->coefficients_signal(old_alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal of
+          // the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / old_alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / old_alpha;
+              offdiagonal.push_back(std::sqrt(beta) / old_alpha);
+            }
+          this->compute_eigs_and_cond(diagonal,
+                                      offdiagonal,
+                                      this->all_eigenvalues_signal,
+                                      this->all_condition_numbers_signal);
+        }
+
+      conv = this->iteration_status(it, res, x);
+    }
+
+  this->compute_eigs_and_cond(diagonal,
+                              offdiagonal,
+                              this->eigenvalues_signal,
+                              this->condition_number_signal);
+
+  if (do_extraction)
+    extract_ritz_vectors(diagonal, offdiagonal, lanczos_vectors);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,673 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_gcrodr_h
+#define dealii_solver_gcrodr_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/householder.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * Implementation of the restarted GMRES method with deflated restarting and
+ * Krylov subspace recycling, GCRO-DR, by Parks, de Sturler, Mackey, Johnson
+ * and Maiti (SIAM J. Sci. Comput. 28(5), 2006). The method is meant for
+ * sequences of linear systems whose matrices and right hand sides change
+ * slowly from one system to the next, as they appear in time stepping,
+ * nonlinear iterations, or parameter sweeps.
+ *
+ * Besides the Arnoldi basis of at most AdditionalData::max_basis_size
+ * vectors, the solver keeps a recycle space $U$ of
+ * AdditionalData::n_recycled_vectors vectors, together with the images
+ * $C=AP^{-1}U$ which are orthonormal. Each cycle of GMRES is run on the
+ * operator $(I-CC^T)AP^{-1}$ with the residual orthogonal to $C$, and the
+ * correction is minimized over the space spanned by both $U$ and the new
+ * Arnoldi vectors. At the end of each cycle, $U$ is replaced by the harmonic
+ * Ritz vectors belonging to the harmonic Ritz values of smallest magnitude
+ * in that space, i.e., by approximations of the eigenvectors that slow down
+ * restarted GMRES the most.
+ *
+ * The recycle space is kept by the solver object after solve() returns and
+ * is used by the next call to solve(). Since the matrix may have changed in
+ * between, solve() first recomputes and orthonormalizes the images $C$,
+ * which costs AdditionalData::n_recycled_vectors products with the matrix
+ * and the preconditioner, and then projects the initial residual onto the
+ * orthogonal complement of $C$. For a sequence of closely related systems,
+ * this typically reduces the number of iterations substantially compared to
+ * SolverGMRES, which starts every solve from an empty Krylov space. The
+ * recycle space can be inspected with get_recycle_space() and discarded with
+ * reset_recycle_space(), which is necessary when the size or the parallel
+ * layout of the vectors changes, e.g., after mesh refinement.
+ *
+ * The preconditioner is always applied from the right, so that the residual
+ * used for the stopping criterion is the one of the unpreconditioned system,
+ * and it has to be the same linear operator within one call to solve(). The
+ * solver works with any vector type that satisfies the requirements of the
+ * Solver base class; in particular, with LinearAlgebra::distributed::Vector
+ * all inner products are global reductions and the recycle space is
+ * distributed in the same way as the solution vector.
+ *
+ * The computation of the harmonic Ritz vectors solves a small
+ * nonsymmetric eigenvalue problem with LAPACKFullMatrix and thus requires
+ * deal.II to be configured with LAPACK when AdditionalData::n_recycled_vectors
+ * is positive.
+ *
+ * For the requirements on matrices and vectors in order to work with this
+ * class, see the documentation of the Solver base class.
+ */
+template <class VectorType = Vector<double>>
+class SolverGCRODR : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, set the maximum basis size to 30 and keep 10
+     * vectors in the recycle space.
+     */
+    explicit AdditionalData(const unsigned int max_basis_size     = 30,
+                            const unsigned int n_recycled_vectors = 10);
+
+    /**
+     * Maximum size of the space the solution is minimized over in one
+     * cycle, including the recycle space. Each cycle thus performs
+     * #max_basis_size minus the number of recycled vectors Arnoldi steps.
+     */
+    unsigned int max_basis_size;
+
+    /**
+     * Number of harmonic Ritz vectors that are kept from one cycle to the
+     * next and from one call to solve() to the next. Must be smaller than
+     * #max_basis_size. A value of zero results in restarted GMRES with
+     * right preconditioning.
+     */
+    unsigned int n_recycled_vectors;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverGCRODR(SolverControl &           cn,
+               VectorMemory<VectorType> &mem,
+               const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverGCRODR(SolverControl &       cn,
+               const AdditionalData &data = AdditionalData());
+
+  /**
+   * The copy constructor is deleted.
+   */
+  SolverGCRODR(const SolverGCRODR<VectorType> &) = delete;
+
+  /**
+   * Solve the linear system $Ax=b$ for x, using and updating the recycle
+   * space.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+  /**
+   * Discard the recycle space, such that the next call to solve() starts
+   * from an empty Krylov space.
+   */
+  void
+  reset_recycle_space();
+
+  /**
+   * Return the number of vectors currently held in the recycle space. This
+   * is zero before the first solve() and after reset_recycle_space(), and
+   * at most AdditionalData::n_recycled_vectors otherwise.
+   */
+  unsigned int
+  n_recycled_vectors() const;
+
+  /**
+   * Return the vectors spanning the recycle space, i.e., the harmonic Ritz
+   * vectors of the last cycle of the last call to solve(). They live in the
+   * space of the right-preconditioned variable, i.e., the solver adds
+   * $P^{-1}U$ to the solution.
+   */
+  const std::vector<VectorType> &
+  get_recycle_space() const;
+
+protected:
+  /**
+   * Apply the right-preconditioned operator, i.e., $dst = AP^{-1}src$, using
+   * @p tmp for the intermediate result.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  static void
+  apply_operator(const MatrixType &        A,
+                 const PreconditionerType &preconditioner,
+                 VectorType &              dst,
+                 const VectorType &        src,
+                 VectorType &              tmp);
+
+  /**
+   * Recompute the images $C=AP^{-1}U$ of the recycle space for the current
+   * matrix and orthonormalize them with the modified Gram-Schmidt method,
+   * applying the same transformation to $U$ such that $C=AP^{-1}U$ still
+   * holds. Vectors of $U$ whose image is numerically linearly dependent on
+   * the previous ones are dropped.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  compute_recycle_images(const MatrixType &        A,
+                         const PreconditionerType &preconditioner,
+                         VectorType &              tmp);
+
+  /**
+   * Replace the recycle space by the harmonic Ritz vectors of the space
+   * spanned by the scaled recycle space and the first @p n_steps Arnoldi
+   * vectors in @p v, given the matrix @p G of the relation
+   * $AP^{-1}\hat V = \hat W G$ between this space and the space spanned by
+   * the images $C$ and the first @p n_steps+1 Arnoldi vectors.
+   */
+  void
+  update_recycle_space(
+    const FullMatrix<double> & G,
+    const std::vector<double> &scaling,
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                v,
+    const unsigned int n_steps);
+
+  /**
+   * Additional flags.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The vectors $U$ spanning the recycle space.
+   */
+  std::vector<VectorType> recycle_space;
+
+  /**
+   * The orthonormal images $C=AP^{-1}U$ of the recycle space.
+   */
+  std::vector<VectorType> recycle_images;
+};
+
+/*@}*/
+/* --------------------- Inline and template functions ------------------- */
+
+
+#ifndef DOXYGEN
+
+template <class VectorType>
+inline SolverGCRODR<VectorType>::AdditionalData::AdditionalData(
+  const unsigned int max_basis_size,
+  const unsigned int n_recycled_vectors)
+  : max_basis_size(max_basis_size)
+  , n_recycled_vectors(n_recycled_vectors)
+{
+  Assert(n_recycled_vectors < max_basis_size,
+         ExcMessage("The number of recycled vectors must be smaller than "
+                    "the maximum basis size."));
+}
+
+
+
+template <class VectorType>
+SolverGCRODR<VectorType>::SolverGCRODR(SolverControl &           cn,
+                                       VectorMemory<VectorType> &mem,
+                                       const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+SolverGCRODR<VectorType>::SolverGCRODR(SolverControl &       cn,
+                                       const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+void
+SolverGCRODR<VectorType>::reset_recycle_space()
+{
+  recycle_space.clear();
+  recycle_images.clear();
+}
+
+
+
+template <class VectorType>
+inline unsigned int
+SolverGCRODR<VectorType>::n_recycled_vectors() const
+{
+  return recycle_space.size();
+}
+
+
+
+template <class VectorType>
+inline const std::vector<VectorType> &
+SolverGCRODR<VectorType>::get_recycle_space() const
+{
+  return recycle_space;
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+inline void
+SolverGCRODR<VectorType>::apply_operator(
+  const MatrixType &        A,
+  const PreconditionerType &preconditioner,
+  VectorType &              dst,
+  const VectorType &        src,
+  VectorType &              tmp)
+{
+  preconditioner.vmult(tmp, src);
+  A.vmult(dst, tmp);
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverGCRODR<VectorType>::compute_recycle_images(
+  const MatrixType &        A,
+  const PreconditionerType &preconditioner,
+  VectorType &              tmp)
+{
+  recycle_images.resize(recycle_space.size());
+
+  unsigned int n_kept = 0;
+  for (unsigned int i = 0; i < recycle_space.size(); ++i)
+    {
+      if (n_kept < i)
+        std::swap(recycle_space[n_kept], recycle_space[i]);
+      VectorType &u = recycle_space[n_kept];
+      VectorType &c = recycle_images[n_kept];
+      c.reinit(u, true);
+      apply_operator(A, preconditioner, c, u, tmp);
+
+      const double initial_norm = c.l2_norm();
+      for (unsigned int l = 0; l < n_kept; ++l)
+        {
+          const double h = recycle_images[l] * c;
+          c.add(-h, recycle_images[l]);
+          u.add(-h, recycle_space[l]);
+        }
+
+      const double norm = c.l2_norm();
+      if (norm > 1e-12 * initial_norm)
+        {
+          c /= norm;
+          u /= norm;
+          ++n_kept;
+        }
+    }
+
+  recycle_space.resize(n_kept);
+  recycle_images.resize(n_kept);
+}
+
+
+
+template <class VectorType>
+void
+SolverGCRODR<VectorType>::update_recycle_space(
+  const FullMatrix<double> & G,
+  const std::vector<double> &scaling,
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                v,
+  const unsigned int n_steps)
+{
+  const unsigned int k      = recycle_space.size();
+  const unsigned int n_cols = k + n_steps;
+  Assert(G.m() == n_cols + 1 && G.n() == n_cols, ExcInternalError());
+
+  // Set up the matrix W^T V, where the columns of V are the scaled recycle
+  // vectors followed by the Arnoldi vectors, and the columns of W are the
+  // images of the recycle vectors followed by the Arnoldi vectors. The
+  // Arnoldi vectors are orthonormal and orthogonal to the images, which
+  // leaves only the first k columns to be computed.
+  FullMatrix<double> WV(n_cols + 1, n_cols);
+  for (unsigned int l = 0; l < k; ++l)
+    {
+      for (unsigned int i = 0; i < k; ++i)
+        WV(i, l) = (recycle_images[i] * recycle_space[l]) * scaling[l];
+      for (unsigned int j = 0; j <= n_steps; ++j)
+        WV(k + j, l) = (v[j] * recycle_space[l]) * scaling[l];
+    }
+  for (unsigned int j = 0; j < n_steps; ++j)
+    WV(k + j, k + j) = 1.;
+
+  // The harmonic Ritz pairs (theta, z) solve the generalized eigenvalue
+  // problem G^T G z = theta G^T W^T V z. Since G has full column rank, this
+  // is equivalent to the eigenvalue problem G^+ W^T V z = 1/theta z with the
+  // pseudo-inverse of G, which we apply by least squares without squaring
+  // the condition number of G.
+  Householder<double>      house(G);
+  LAPACKFullMatrix<double> projected_matrix(n_cols, n_cols);
+  Vector<double>           src(n_cols + 1), dst(n_cols);
+  for (unsigned int c = 0; c < n_cols; ++c)
+    {
+      for (unsigned int i = 0; i <= n_cols; ++i)
+        src(i) = WV(i, c);
+      house.least_squares(dst, src);
+      for (unsigned int i = 0; i < n_cols; ++i)
+        projected_matrix(i, c) = dst(i);
+    }
+  projected_matrix.compute_eigenvalues(true);
+  const FullMatrix<std::complex<double>> eigenvectors =
+    projected_matrix.get_right_eigenvectors();
+
+  // Select the harmonic Ritz values with smallest magnitude, i.e., the
+  // eigenvalues above of largest magnitude. A complex conjugate pair of
+  // eigenvectors is represented by the real and imaginary parts of one of
+  // them.
+  std::vector<unsigned int> order(n_cols);
+  std::iota(order.begin(), order.end(), 0U);
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&](const unsigned int a, const unsigned int b) {
+                     return std::abs(projected_matrix.eigenvalue(a)) >
+                            std::abs(projected_matrix.eigenvalue(b));
+                   });
+
+  const unsigned int n_new =
+    std::min(additional_data.n_recycled_vectors, n_cols);
+  std::vector<Vector<double>> p;
+  p.reserve(n_new);
+  for (unsigned int i = 0; i < n_cols && p.size() < n_new; ++i)
+    {
+      const unsigned int         index = order[i];
+      const std::complex<double> mu    = projected_matrix.eigenvalue(index);
+      if (mu.imag() < 0.)
+        continue;
+
+      p.emplace_back(n_cols);
+      for (unsigned int j = 0; j < n_cols; ++j)
+        p.back()(j) = eigenvectors(j, index).real();
+      if (mu.imag() > 0. && p.size() < n_new)
+        {
+          p.emplace_back(n_cols);
+          for (unsigned int j = 0; j < n_cols; ++j)
+            p.back()(j) = eigenvectors(j, index).imag();
+        }
+    }
+
+  // Orthonormalize the columns of G P with the modified Gram-Schmidt method,
+  // applying the same operations to P. This is the QR factorization
+  // G P = Q R, with P overwritten by P R^{-1}.
+  std::vector<Vector<double>> g;
+  g.reserve(p.size());
+  unsigned int n_kept = 0;
+  for (unsigned int l = 0; l < p.size(); ++l)
+    {
+      if (n_kept < l)
+        p[n_kept].swap(p[l]);
+      g.emplace_back(n_cols + 1);
+      G.vmult(g.back(), p[n_kept]);
+
+      const double initial_norm = g.back().l2_norm();
+      for (unsigned int i = 0; i < n_kept; ++i)
+        {
+          const double h = g[i] * g.back();
+          g.back().add(-h, g[i]);
+          p[n_kept].add(-h, p[i]);
+        }
+
+      const double norm = g.back().l2_norm();
+      if (norm > 1e-12 * initial_norm)
+        {
+          g.back() /= norm;
+          p[n_kept] /= norm;
+          ++n_kept;
+        }
+      else
+        g.pop_back();
+    }
+
+  // Form the new recycle space U = V P R^{-1} and its images C = W Q.
+  std::vector<VectorType> new_space(n_kept);
+  std::vector<VectorType> new_images(n_kept);
+  for (unsigned int l = 0; l < n_kept; ++l)
+    {
+      new_space[l].reinit(v[0]);
+      new_images[l].reinit(v[0]);
+      for (unsigned int i = 0; i < k; ++i)
+        {
+          new_space[l].add(p[l](i) * scaling[i], recycle_space[i]);
+          new_images[l].add(g[l](i), recycle_images[i]);
+        }
+      for (unsigned int j = 0; j < n_steps; ++j)
+        new_space[l].add(p[l](k + j), v[j]);
+      for (unsigned int j = 0; j <= n_steps; ++j)
+        new_images[l].add(g[l](k + j), v[j]);
+    }
+
+  recycle_space.swap(new_space);
+  recycle_images.swap(new_images);
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverGCRODR<VectorType>::solve(const MatrixType &        A,
+                                VectorType &              x,
+                                const VectorType &        b,
+                                const PreconditionerType &preconditioner)
+{
+  LogStream::Prefix prefix("GCRODR");
+
+  SolverControl::State iteration_state = SolverControl::iterate;
+
+  const unsigned int basis_size = additional_data.max_basis_size;
+
+  typename VectorMemory<VectorType>::Pointer r(this->memory);
+  typename VectorMemory<VectorType>::Pointer aux(this->memory);
+  typename VectorMemory<VectorType>::Pointer tmp(this->memory);
+  r->reinit(x);
+  aux->reinit(x);
+  tmp->reinit(x);
+
+  A.vmult(*r, x);
+  r->sadd(-1., 1., b);
+
+  // Make the recycle space fit the current matrix and remove the part of
+  // the initial residual in the range of its images, i.e., update x by
+  // P^{-1} U C^T r and r by -C C^T r.
+  if (recycle_space.size() > 0)
+    {
+      Assert(recycle_space[0].size() == x.size(),
+             ExcMessage("The size of the recycle space does not match the "
+                        "size of the solution vector. Call "
+                        "reset_recycle_space() when the size of the "
+                        "linear system changes."));
+
+      compute_recycle_images(A, preconditioner, *tmp);
+
+      *aux = 0.;
+      for (unsigned int i = 0; i < recycle_space.size(); ++i)
+        {
+          const double alpha = recycle_images[i] * *r;
+          r->add(-alpha, recycle_images[i]);
+          aux->add(alpha, recycle_space[i]);
+        }
+      preconditioner.vmult(*tmp, *aux);
+      x += *tmp;
+    }
+
+  // Generate an object where the Arnoldi vectors are stored.
+  typename internal::SolverGMRESImplementation::TmpVectors<VectorType> v(
+    basis_size + 1, this->memory);
+
+  // number of the present iteration; this number is not reset to zero upon a
+  // restart
+  unsigned int accumulated_iterations = 0;
+
+  // The matrix G of the relation A P^{-1} V = W G between the scaled
+  // recycle vectors and the Arnoldi vectors on the one hand and the images
+  // of the recycle vectors and the Arnoldi vectors on the other hand
+  FullMatrix<double> G(basis_size + 1, basis_size);
+  FullMatrix<double> G1;
+
+  // Vectors for projected system
+  Vector<double> projected_rhs;
+  Vector<double> y;
+  Vector<double> Gy;
+
+  std::vector<double> scaling;
+
+  // Iteration starts here
+  double res = -std::numeric_limits<double>::max();
+
+  do
+    {
+      const double beta = r->l2_norm();
+      res               = beta;
+      iteration_state = this->iteration_status(accumulated_iterations, res, x);
+      if (iteration_state == SolverControl::success)
+        break;
+
+      // The residual is orthogonal to the images C of the recycle space, so
+      // the projected right hand side W^T r is beta times the unit vector of
+      // the first Arnoldi vector. The upper left block of G is the diagonal
+      // matrix of the scaling factors of the recycle vectors, as A P^{-1} U
+      // = C.
+      const unsigned int k = recycle_space.size();
+      G                    = 0.;
+      scaling.resize(k);
+      for (unsigned int i = 0; i < k; ++i)
+        {
+          scaling[i] = 1. / recycle_space[i].l2_norm();
+          G(i, i)    = scaling[i];
+        }
+
+      v(0, x).equ(1. / beta, *r);
+
+      unsigned int n_steps = 0;
+      for (unsigned int j = 0; k + j < basis_size; ++j)
+        {
+          apply_operator(A, preconditioner, *aux, v[j], *tmp);
+
+          // Orthogonalize against the images of the recycle space and the
+          // Arnoldi vectors with the modified Gram-Schmidt method
+          for (unsigned int i = 0; i < k; ++i)
+            {
+              G(i, k + j) = recycle_images[i] * *aux;
+              aux->add(-G(i, k + j), recycle_images[i]);
+            }
+          for (unsigned int i = 0; i <= j; ++i)
+            {
+              G(k + i, k + j) = *aux * v[i];
+              aux->add(-G(k + i, k + j), v[i]);
+            }
+          const double h      = aux->l2_norm();
+          G(k + j + 1, k + j) = h;
+          if (h != 0) // treat lucky breakdown
+            v(j + 1, x).equ(1. / h, *aux);
+          else
+            v(j + 1, x) = 0.;
+          n_steps = j + 1;
+
+          // Compute projected solution
+          G1.reinit(k + j + 2, k + j + 1);
+          G1.fill(G);
+          projected_rhs.reinit(k + j + 2);
+          projected_rhs(k) = beta;
+          y.reinit(k + j + 1);
+
+          // check convergence. note that the vector 'x' we pass to the
+          // criterion is not the final solution we compute if we decide to
+          // jump out of the iteration (we update 'x' again right after the
+          // current loop)
+          Householder<double> house(G1);
+          res = house.least_squares(y, projected_rhs);
+          iteration_state =
+            this->iteration_status(++accumulated_iterations, res, x);
+          if (iteration_state != SolverControl::iterate || h == 0)
+            break;
+        }
+
+      // Update solution vector by P^{-1} V y
+      *aux = 0.;
+      for (unsigned int i = 0; i < k; ++i)
+        aux->add(y(i) * scaling[i], recycle_space[i]);
+      for (unsigned int j = 0; j < n_steps; ++j)
+        aux->add(y(k + j), v[j]);
+      preconditioner.vmult(*tmp, *aux);
+      x += *tmp;
+
+      // Update the residual by -W G y, which is orthogonal to the range of
+      // W G and thus to the images of the new recycle space
+      Gy.reinit(k + n_steps + 1);
+      G1.vmult(Gy, y);
+      for (unsigned int i = 0; i < k; ++i)
+        r->add(-Gy(i), recycle_images[i]);
+      for (unsigned int j = 0; j <= n_steps; ++j)
+        r->add(-Gy(k + j), v[j]);
+
+      if (additional_data.n_recycled_vectors > 0)
+        update_recycle_space(G1, scaling, v, n_steps);
+    }
+  while (iteration_state == SolverControl::iterate);
+
+  // in case of failure: throw exception
+  if (iteration_state != SolverControl::success)
+    AssertThrow(false,
+                SolverControl::NoConvergence(accumulated_iterations, res));
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
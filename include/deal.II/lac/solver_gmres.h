@@ -20,6 +20,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/subscriptor.h>
 
@@ -37,9 +38,52 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
+namespace LinearAlgebra
+{
+  /**
+   * An enum that lists the possible choices to orthogonalize a new vector
+   * against the basis vectors of a Krylov space, see SolverGMRES.
+   */
+  enum class OrthogonalizationStrategy
+  {
+    /**
+     * Use the modified Gram-Schmidt algorithm. The new vector is
+     * orthogonalized against one basis vector after the other. This is
+     * numerically robust, but needs one inner product, and hence one global
+     * reduction in parallel, per basis vector.
+     */
+    modified_gram_schmidt,
+
+    /**
+     * Use the classical Gram-Schmidt algorithm. All inner products with the
+     * basis vectors are computed at once, followed by a single update of the
+     * new vector. For LinearAlgebra::distributed::Vector, this amounts to
+     * two passes through the vectors and two global reductions per iteration,
+     * independent of the size of the basis. Since classical Gram-Schmidt
+     * loses orthogonality faster than the modified variant, it should be
+     * combined with re-orthogonalization when the basis gets large or the
+     * system is ill-conditioned, which gives the numerically stable variant
+     * often called CGS2.
+     */
+    classical_gram_schmidt
+  };
+} // namespace LinearAlgebra
+
 namespace internal
 {
   /**
@@ -149,6 +193,26 @@ namespace internal
  * off between memory consumption and convergence speed, since a longer basis
  * means minimization over a larger space.
  *
+ *
+ * <h3>Orthogonalization of the Arnoldi basis</h3>
+ *
+ * Each new Arnoldi vector is orthogonalized against the previous ones. By
+ * default, this is done with the modified Gram-Schmidt algorithm, which
+ * requires as many inner products as there are vectors in the basis. In a
+ * parallel computation, each of them is a global reduction, whose latency
+ * can dominate the cost of an iteration on a large number of processes. The
+ * flag AdditionalData::orthogonalization_strategy allows to select the
+ * classical Gram-Schmidt algorithm instead, which computes all inner
+ * products, and the norm of the new vector, in a single pass through the
+ * vectors and then subtracts the projections in a second pass, requiring two
+ * global reductions per iteration. This variant is particularly efficient
+ * for LinearAlgebra::distributed::Vector, where both passes use
+ * LinearAlgebra::distributed::Vector::multi_dot() and
+ * LinearAlgebra::distributed::Vector::multi_add_and_dot(), which go through
+ * the vectors block by block such that the new vector stays in cache. Combining
+ * it with AdditionalData::force_re_orthogonalization doubles the number of
+ * reductions and makes it as robust as the modified variant.
+ *
  * For the requirements on matrices and vectors in order to work with this
  * class, see the documentation of the Solver base class.
  *
@@ -186,10 +250,14 @@ public:
      * left, the residual of the stopping criterion to the default residual,
      * and re-orthogonalization only if necessary.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int max_n_tmp_vectors          = 30,
+      const bool         right_preconditioning      = false,
+      const bool         use_default_residual       = true,
+      const bool         force_re_orthogonalization = false,
+      const LinearAlgebra::OrthogonalizationStrategy
+        orthogonalization_strategy =
+          LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -220,6 +288,13 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * Strategy to orthogonalize the new Arnoldi vectors against the
+     * previous ones. See the section on orthogonalization in the
+     * documentation of SolverGMRES.
+     */
+    LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -408,6 +483,26 @@ protected:
     const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
       boost::signals2::signal<void(int)>());
 
+  /**
+   * Orthogonalize the vector @p vv against the @p dim (orthogonal) vectors
+   * given by the first argument using the classical Gram-Schmidt algorithm,
+   * with the same meaning of the arguments as in modified_gram_schmidt().
+   * All inner products are computed at once, so the number of global
+   * reductions does not depend on @p dim. If @p re_orthogonalize is set, the
+   * algorithm is applied twice.
+   */
+  static double
+  classical_gram_schmidt(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                                       orthogonal_vectors,
+    const unsigned int                        dim,
+    const unsigned int                        accumulated_iterations,
+    VectorType &                              vv,
+    Vector<double> &                          h,
+    bool &                                    re_orthogonalize,
+    const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
+      boost::signals2::signal<void(int)>());
+
   /**
    * Estimates the eigenvalues from the Hessenberg matrix, H_orig, generated
    * during the inner iterations. Uses these estimate to compute the condition
@@ -581,6 +676,111 @@ namespace internal
       return x.real() < y.real() ||
              (x.real() == y.real() && x.imag() < y.imag());
     }
+
+
+
+    /**
+     * Compute the inner products of @p vv with the first @p dim vectors in
+     * @p orthogonal_vectors, store them in @p h, and return the square of
+     * the norm of @p vv. This general version uses the inner products
+     * provided by the vector class.
+     */
+    template <class VectorType>
+    inline double
+    block_inner_products(const TmpVectors<VectorType> &orthogonal_vectors,
+                         const unsigned int            dim,
+                         const VectorType &            vv,
+                         Vector<double> &              h)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) = vv * orthogonal_vectors[i];
+      return vv * vv;
+    }
+
+
+
+    /**
+     * Subtract the first @p dim vectors in @p orthogonal_vectors, scaled by
+     * the entries of @p h, from @p vv and return the square of the norm of
+     * the result.
+     */
+    template <class VectorType>
+    inline double
+    subtract_and_norm(const TmpVectors<VectorType> &orthogonal_vectors,
+                      const unsigned int            dim,
+                      const Vector<double> &        h,
+                      VectorType &                  vv)
+    {
+      for (unsigned int i = 0; i + 1 < dim; ++i)
+        vv.add(-h(i), orthogonal_vectors[i]);
+      return vv.add_and_dot(-h(dim - 1), orthogonal_vectors[dim - 1], vv);
+    }
+
+
+
+    template <typename Number, typename MemorySpace>
+    using DistributedVector =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace>;
+
+
+
+    /**
+     * Specialization of block_inner_products() for
+     * LinearAlgebra::distributed::Vector that computes all inner products,
+     * including the norm of @p vv, with
+     * LinearAlgebra::distributed::Vector::multi_dot() in a single pass
+     * through the vectors and with a single global reduction.
+     */
+    template <typename Number, typename MemorySpace>
+    inline double
+    block_inner_products(
+      const TmpVectors<DistributedVector<Number, MemorySpace>>
+        &                                            orthogonal_vectors,
+      const unsigned int                             dim,
+      const DistributedVector<Number, MemorySpace> &vv,
+      Vector<double> &                               h)
+    {
+      std::vector<const DistributedVector<Number, MemorySpace> *> vectors(
+        dim + 1);
+      for (unsigned int i = 0; i < dim; ++i)
+        vectors[i] = &orthogonal_vectors[i];
+      vectors[dim] = &vv;
+
+      std::vector<Number> sums(dim + 1);
+      vv.multi_dot(vectors, make_array_view(sums));
+
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) = sums[i];
+      return sums[dim];
+    }
+
+
+
+    /**
+     * Specialization of subtract_and_norm() for
+     * LinearAlgebra::distributed::Vector that updates @p vv with all basis
+     * vectors in a single pass via
+     * LinearAlgebra::distributed::Vector::multi_add_and_dot().
+     */
+    template <typename Number, typename MemorySpace>
+    inline double
+    subtract_and_norm(
+      const TmpVectors<DistributedVector<Number, MemorySpace>>
+        &                                      orthogonal_vectors,
+      const unsigned int                       dim,
+      const Vector<double> &                   h,
+      DistributedVector<Number, MemorySpace> &vv)
+    {
+      std::vector<const DistributedVector<Number, MemorySpace> *> vectors(dim);
+      std::vector<Number>                                         factors(dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          vectors[i] = &orthogonal_vectors[i];
+          factors[i] = -h(i);
+        }
+
+      return vv.multi_add_and_dot(make_array_view(factors), vectors, vv);
+    }
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -591,11 +791,13 @@ inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_n_tmp_vectors,
   const bool         right_preconditioning,
   const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const bool         force_re_orthogonalization,
+  const LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -724,6 +926,70 @@ SolverGMRES<VectorType>::modified_gram_schmidt(
 
 
 
+template <class VectorType>
+inline double
+SolverGMRES<VectorType>::classical_gram_schmidt(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                                       orthogonal_vectors,
+  const unsigned int                        dim,
+  const unsigned int                        accumulated_iterations,
+  VectorType &                              vv,
+  Vector<double> &                          h,
+  bool &                                    reorthogonalize,
+  const boost::signals2::signal<void(int)> &reorthogonalize_signal)
+{
+  Assert(dim > 0, ExcInternalError());
+  const unsigned int inner_iteration = dim - 1;
+
+  const bool consider_reorthogonalize =
+    (reorthogonalize == false) && (inner_iteration % 5 == 4);
+
+  // Orthogonalization. The initial norm of vv for the detection of
+  // re-orthogonalization comes for free with the inner products.
+  const double norm_vv_start = std::sqrt(
+    internal::SolverGMRESImplementation::block_inner_products(
+      orthogonal_vectors, dim, vv, h));
+  double norm_vv = std::sqrt(
+    internal::SolverGMRESImplementation::subtract_and_norm(orthogonal_vectors,
+                                                           dim,
+                                                           h,
+                                                           vv));
+
+  // Re-orthogonalization if loss of orthogonality detected, using the same
+  // test as in modified_gram_schmidt()
+  if (consider_reorthogonalize)
+    {
+      if (norm_vv >
+          10. * norm_vv_start *
+            std::sqrt(
+              std::numeric_limits<typename VectorType::value_type>::epsilon()))
+        return norm_vv;
+
+      else
+        {
+          reorthogonalize = true;
+          if (!reorthogonalize_signal.empty())
+            reorthogonalize_signal(accumulated_iterations);
+        }
+    }
+
+  if (reorthogonalize == true)
+    {
+      Vector<double> htmp(dim);
+      internal::SolverGMRESImplementation::block_inner_products(
+        orthogonal_vectors, dim, vv, htmp);
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) += htmp(i);
+      norm_vv = std::sqrt(
+        internal::SolverGMRESImplementation::subtract_and_norm(
+          orthogonal_vectors, dim, htmp, vv));
+    }
+
+  return norm_vv;
+}
+
+
+
 template <class VectorType>
 inline void
 SolverGMRES<VectorType>::compute_eigs_and_cond(
@@ -942,13 +1208,23 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+             LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt) ?
+              modified_gram_schmidt(tmp_vectors,
+                                    dim,
+                                    accumulated_iterations,
+                                    vv,
+                                    h,
+                                    re_orthogonalize,
+                                    re_orthogonalize_signal) :
+              classical_gram_schmidt(tmp_vectors,
+                                     dim,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal);
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
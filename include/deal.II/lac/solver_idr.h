@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/subscriptor.h>
@@ -30,9 +31,22 @@
 
 #include <cmath>
 #include <random>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -223,6 +237,67 @@ namespace internal
         }
       return *data[i];
     }
+
+
+
+    // Compute the inner products of v with all vectors in w
+    template <class VectorType>
+    inline void
+    multi_dot(const VectorType &                     v,
+              const std::vector<const VectorType *> &w,
+              std::vector<double> &                  results)
+    {
+      results.resize(w.size());
+      for (unsigned int i = 0; i < w.size(); ++i)
+        results[i] = *w[i] * v;
+    }
+
+
+
+    // Add the linear combination of the vectors in w with the given factors
+    // to v
+    template <class VectorType>
+    inline void
+    multi_add(VectorType &                           v,
+              const std::vector<double> &            factors,
+              const std::vector<const VectorType *> &w)
+    {
+      AssertDimension(factors.size(), w.size());
+      for (unsigned int i = 0; i < w.size(); ++i)
+        v.add(factors[i], *w[i]);
+    }
+
+
+
+    // For LinearAlgebra::distributed::Vector, use the block operations of the
+    // vector class that go through all vectors at once and only need a single
+    // global reduction
+    template <typename Number, typename MemorySpace>
+    inline void
+    multi_dot(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace> &v,
+      const std::vector<
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace> *> &w,
+      std::vector<double> &results)
+    {
+      std::vector<Number> sums(w.size());
+      v.multi_dot(w, make_array_view(sums));
+      results.assign(sums.begin(), sums.end());
+    }
+
+
+
+    template <typename Number, typename MemorySpace>
+    inline void
+    multi_add(
+      LinearAlgebra::distributed::Vector<Number, MemorySpace> &v,
+      const std::vector<double> &                              factors,
+      const std::vector<
+        const LinearAlgebra::distributed::Vector<Number, MemorySpace> *> &w)
+    {
+      const std::vector<Number> number_factors(factors.begin(), factors.end());
+      v.multi_add(make_array_view(number_factors), w);
+    }
   } // namespace SolverIDRImplementation
 } // namespace internal
 
@@ -345,6 +420,16 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
       M(i, i) = 1.;
     }
 
+  // Pointers to the vectors in G, U and Q for the block operations
+  std::vector<const VectorType *> G_vectors(s), U_vectors(s), Q_vectors(s);
+  for (unsigned int i = 0; i < s; ++i)
+    {
+      G_vectors[i] = &G[i];
+      U_vectors[i] = &U[i];
+      Q_vectors[i] = &Q[i];
+    }
+  std::vector<double> products;
+
   double omega = 1.;
 
   bool early_exit = false;
@@ -356,8 +441,9 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
 
       // Compute phi
       Vector<double> phi(s);
+      internal::SolverIDRImplementation::multi_dot(r, Q_vectors, products);
       for (unsigned int i = 0; i < s; ++i)
-        phi(i) = Q[i] * r;
+        phi(i) = products[i];
 
       // Inner iteration over s
       for (unsigned int k = 0; k < s; ++k)
@@ -382,18 +468,24 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
           }
 
           {
-            v = r;
+            const std::vector<const VectorType *> G_k(G_vectors.begin() + k,
+                                                      G_vectors.end());
+            const std::vector<const VectorType *> U_k(U_vectors.begin() + k,
+                                                      U_vectors.end());
+            std::vector<double> factors(gamma.size());
+            for (unsigned int j = 0; j < gamma.size(); ++j)
+              factors[j] = -gamma(j);
 
-            unsigned int j = 0;
-            for (unsigned int i = k; i < s; ++i, ++j)
-              v.add(-1.0 * gamma(j), G[i]);
+            v = r;
+            internal::SolverIDRImplementation::multi_add(v, factors, G_k);
             preconditioner.vmult(vhat, v);
 
+            for (unsigned int j = 0; j < gamma.size(); ++j)
+              factors[j] = gamma(j);
+
             uhat = vhat;
             uhat *= omega;
-            j = 0;
-            for (unsigned int i = k; i < s; ++i, ++j)
-              uhat.add(gamma(j), U[i]);
+            internal::SolverIDRImplementation::multi_add(uhat, factors, U_k);
             A.vmult(ghat, uhat);
           }
 
@@ -410,8 +502,13 @@ SolverIDR<VectorType>::solve(const MatrixType &        A,
           U[k] = uhat;
 
           // Update kth column of M
+          internal::SolverIDRImplementation::multi_dot(
+            G[k],
+            std::vector<const VectorType *>(Q_vectors.begin() + k,
+                                            Q_vectors.end()),
+            products);
           for (unsigned int i = k; i < s; ++i)
-            M(i, k) = Q[i] * G[k];
+            M(i, k) = products[i - k];
 
           // Orthogonalize r to Q0,...,Qk,
           // update x
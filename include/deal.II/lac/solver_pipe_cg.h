@@ -0,0 +1,451 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_pipe_cg_h
+#define dealii_solver_pipe_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the pipelined preconditioned Conjugate Gradients
+ * method of P. Ghysels and W. Vanroose, "Hiding global synchronization
+ * latency in the preconditioned Conjugate Gradient algorithm", Parallel
+ * Computing 40 (2014), pp. 224-238. It solves the same problems as SolverCG,
+ * i.e., linear systems with a symmetric positive definite matrix and a
+ * symmetric preconditioner, and produces the same iterates in exact
+ * arithmetic.
+ *
+ * The classical CG method needs two global reductions per iteration that
+ * depend on the result of the preceding matrix-vector product and
+ * preconditioner application, respectively. On a large number of MPI ranks,
+ * the latency of these reductions can exceed the cost of the matrix-vector
+ * product itself. The pipelined variant introduces auxiliary vectors that
+ * carry the action of the preconditioner and the matrix on the search
+ * direction in recurrences. This way, all three inner products of an
+ * iteration (including the residual norm used for the stopping criterion)
+ * are combined into a single reduction, and the next application of the
+ * preconditioner and the matrix does not depend on its result. For
+ * LinearAlgebra::distributed::Vector with real-valued entries, the reduction
+ * is issued as a nonblocking <code>MPI_Iallreduce</code> before the
+ * preconditioner and matrix are applied, and only completed afterwards, so
+ * that its latency is hidden behind the computations. For all other vector
+ * types, the inner products are computed with the functions of the vector
+ * class, without overlap.
+ *
+ * The price is a higher memory consumption, the algorithm needs nine
+ * auxiliary vectors as opposed to three in SolverCG, and eight vector
+ * updates per iteration. Furthermore, the residual is computed by a
+ * recurrence whose rounding errors accumulate differently than in the
+ * classical variant, which in some cases limits the attainable accuracy
+ * to a few digits above the one of SolverCG. The stopping criterion is
+ * evaluated on the residual of the recurrence.
+ *
+ * The class is derived from SolverCG and provides the same interface to
+ * observe the progress of the iteration: the solve() function calls
+ * SolverControl with the residual norm in each step, and the slots for the
+ * CG coefficients, the eigenvalue and condition number estimates connected
+ * via SolverCG::connect_coefficients_slot(),
+ * SolverCG::connect_eigenvalues_slot() and
+ * SolverCG::connect_condition_number_slot() are called in the same way as in
+ * SolverCG.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipeCG : public SolverCG<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it doesn't store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipeCG(SolverControl &           cn,
+               VectorMemory<VectorType> &mem,
+               const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipeCG(SolverControl &       cn,
+               const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverPipeCG
+  {
+    // Compute the three inner products r*u, w*u and r*r of an iteration of
+    // the pipelined CG method. The general implementation evaluates them
+    // with the functions of the vector class when start() is called.
+    template <typename VectorType,
+              bool = dealii::internal::SolverCG::is_host_distributed_vector<
+                       VectorType>::value &&
+                     std::is_floating_point<
+                       typename VectorType::value_type>::value>
+    class InnerProducts
+    {
+    public:
+      using number = typename VectorType::value_type;
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        values[0] = r * u;
+        values[1] = w * u;
+        values[2] = r * r;
+      }
+
+      void
+      finish()
+      {}
+
+      std::array<number, 3> values;
+    };
+
+
+
+    // For LinearAlgebra::distributed::Vector with real entries, compute the
+    // local contributions in a single pass through the three vectors and
+    // start a nonblocking reduction, which is completed by finish()
+    template <typename VectorType>
+    class InnerProducts<VectorType, true>
+    {
+    public:
+      using number = typename VectorType::value_type;
+
+      InnerProducts()
+        : communicator(MPI_COMM_SELF)
+        , request(MPI_REQUEST_NULL)
+      {}
+
+      ~InnerProducts()
+      {
+        // make sure no reduction is pending when the memory goes away, e.g.
+        // when an exception is thrown between start() and finish()
+#  ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          MPI_Wait(&request, MPI_STATUS_IGNORE);
+#  endif
+      }
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        const unsigned int  local_size = r.locally_owned_size();
+        const number *const r_ptr      = r.begin();
+        const number *const u_ptr      = u.begin();
+        const number *const w_ptr      = w.begin();
+
+        double ru = 0., wu = 0., rr = 0.;
+        for (unsigned int i = 0; i < local_size; ++i)
+          {
+            ru += r_ptr[i] * u_ptr[i];
+            wu += w_ptr[i] * u_ptr[i];
+            rr += r_ptr[i] * r_ptr[i];
+          }
+        local_values = {{ru, wu, rr}};
+        communicator = r.get_mpi_communicator();
+
+#  ifdef DEAL_II_WITH_MPI
+        if (Utilities::MPI::job_supports_mpi() &&
+            Utilities::MPI::n_mpi_processes(communicator) > 1)
+          {
+            const int ierr = MPI_Iallreduce(local_values.data(),
+                                            global_values.data(),
+                                            local_values.size(),
+                                            MPI_DOUBLE,
+                                            MPI_SUM,
+                                            communicator,
+                                            &request);
+            AssertThrowMPI(ierr);
+            return;
+          }
+#  endif
+
+        global_values = local_values;
+      }
+
+      void
+      finish()
+      {
+#  ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+#  endif
+
+        for (unsigned int i = 0; i < values.size(); ++i)
+          values[i] = global_values[i];
+      }
+
+      std::array<number, 3> values;
+
+    private:
+      std::array<double, 3> local_values;
+      std::array<double, 3> global_values;
+      MPI_Comm              communicator;
+      MPI_Request           request;
+    };
+  } // namespace SolverPipeCG
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverPipeCG<VectorType>::SolverPipeCG(SolverControl &           cn,
+                                       VectorMemory<VectorType> &mem,
+                                       const AdditionalData &    data)
+  : SolverCG<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipeCG<VectorType>::SolverPipeCG(SolverControl &       cn,
+                                       const AdditionalData &data)
+  : SolverCG<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipeCG<VectorType>::solve(const MatrixType &        A,
+                                VectorType &              x,
+                                const VectorType &        b,
+                                const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipe_cg");
+
+  // Memory allocation. The notation follows the paper by Ghysels and
+  // Vanroose: r is the residual, u = M r the preconditioned residual, w = A u,
+  // m = M w, n = A m, and p, s, q, z the search direction and the recurrences
+  // for A p, M A p and A M A p, respectively.
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &z = *z_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues = !this->condition_number_signal.empty() ||
+                              !this->all_condition_numbers_signal.empty() ||
+                              !this->eigenvalues_signal.empty() ||
+                              !this->all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<typename VectorType::value_type> diagonal;
+  std::vector<typename VectorType::value_type> offdiagonal;
+
+  typename VectorType::value_type eigen_beta_alpha = 0;
+
+  // resize the vectors, but do not set the values since they'd be overwritten
+  // soon anyway.
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  p.reinit(x, true);
+  s.reinit(x, true);
+  q.reinit(x, true);
+  z.reinit(x, true);
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverPipeCG::InnerProducts<VectorType> inner_products;
+
+  int    it        = 0;
+  double res       = 0.;
+  number gamma     = number();
+  number beta      = number();
+  number alpha     = number();
+  number old_alpha = number();
+
+  while (true)
+    {
+      // start the reduction of the inner products of this iteration and
+      // overlap it with the application of the preconditioner and the
+      // matrix, which do not depend on its result
+      inner_products.start(r, u, w);
+
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+
+      inner_products.finish();
+
+      const number old_gamma = gamma;
+      gamma                  = inner_products.values[0];
+      const number delta     = inner_products.values[1];
+      res = std::sqrt(std::abs(inner_products.values[2]));
+
+      this->print_vectors(it, x, r, p);
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      it++;
+      old_alpha = alpha;
+
+      if (it > 1)
+        {
+          Assert(std::abs(old_gamma) != 0., ExcDivideByZero());
+          beta = gamma / old_gamma;
+          Assert(std::abs(delta - beta * gamma / old_alpha) != 0.,
+                 ExcDivideByZero());
+          alpha = gamma / (delta - beta * gamma / old_alpha);
+
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+        }
+      else
+        {
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+
+          z = n;
+          q = m;
+          s = w;
+          p = u;
+        }
+
+      x.add(alpha, p);
+      r.add(-alpha, s);
+      u.add(-alpha, q);
+      w.add(-alpha, z);
+
+      if (it > 1)
+        {
+          this->coefficients_signal(old_alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal of
+          // the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / old_alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / old_alpha;
+              offdiagonal.push_back(std::sqrt(beta) / old_alpha);
+            }
+          this->compute_eigs_and_cond(diagonal,
+                                      offdiagonal,
+                                      this->all_eigenvalues_signal,
+                                      this->all_condition_numbers_signal);
+        }
+    }
+
+  this->compute_eigs_and_cond(diagonal,
+                              offdiagonal,
+                              this->eigenvalues_signal,
+                              this->condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
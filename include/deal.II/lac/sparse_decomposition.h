@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
@@ -94,6 +96,21 @@ DEAL_II_NAMESPACE_OPEN
  * restrictions on the sparsity see section `Fill-in' above).
  *
  *
+ * <h3>Parallelization</h3>
+ *
+ * The forward and backward substitutions with the two factors are
+ * inherently sequential when done row by row. To make use of several
+ * threads, initialize() computes a level schedule of the rows for each of
+ * the two factors (see prebuild_level_schedule()): rows within one level do
+ * not depend on each other and are processed in parallel in the vmult()
+ * functions of derived classes, and, for SparseILU, also during the
+ * factorization. How much parallelism the levels offer depends on the
+ * ordering of the unknowns; orderings that produce narrow levels, such as
+ * the Cuthill-McKee ordering, expose less parallelism than, e.g., a
+ * multicolor ordering computed with DoFRenumbering. The results do not
+ * depend on the number of threads.
+ *
+ *
  * <h3>Particular implementations</h3>
  *
  * It is enough to override the initialize() and vmult() methods to implement
@@ -323,7 +340,79 @@ protected:
   void
   prebuild_lower_bound();
 
+  /**
+   * Set up the level schedules for the substitutions with the lower and the
+   * upper triangular factor. The rows of the lower factor are grouped into
+   * levels such that the rows of each level only couple to rows of previous
+   * levels: the level of a row is one more than the largest level of the
+   * columns left of the diagonal in that row (or zero if there are no such
+   * columns). The rows within one level can then be processed in parallel.
+   * The same is done for the upper factor, going through the rows
+   * backwards and looking at the columns right of the diagonal.
+   *
+   * A schedule is only kept if more than one thread is available and its
+   * levels contain sufficiently many rows on average to make it worthwhile
+   * to work on them in parallel. Otherwise, the substitutions keep running
+   * row by row. Since the rows are computed with exactly the same operations
+   * in either case, the results do not depend on whether a schedule is used.
+   *
+   * This function needs the #prebuilt_lower_bound array and must thus be
+   * called after prebuild_lower_bound().
+   */
+  void
+  prebuild_level_schedule();
+
+  /**
+   * Call @p row_operation for all rows in an order that is valid for the
+   * substitution with the lower triangular factor, i.e., a row is processed
+   * only after all rows that correspond to its entries left of the diagonal.
+   * If a level schedule is available, the rows of each level are processed
+   * in parallel, otherwise the rows are processed in ascending order.
+   */
+  template <typename Function>
+  void
+  apply_forward_substitution(const Function &row_operation) const;
+
+  /**
+   * Same as apply_forward_substitution() for the substitution with the upper
+   * triangular factor, i.e., a row is processed only after all rows that
+   * correspond to its entries right of the diagonal. Without a level
+   * schedule, the rows are processed in descending order.
+   */
+  template <typename Function>
+  void
+  apply_backward_substitution(const Function &row_operation) const;
+
+  /**
+   * The rows of the lower triangular factor sorted by their level, with
+   * the rows of level <code>l</code> located in the range
+   * <code>[lower_level_starts[l], lower_level_starts[l+1])</code>. Both
+   * arrays are empty if no level schedule is used.
+   */
+  std::vector<size_type> lower_level_rows;
+
+  /**
+   * The start indices of the levels in #lower_level_rows.
+   */
+  std::vector<size_type> lower_level_starts;
+
+  /**
+   * Same as #lower_level_rows for the upper triangular factor.
+   */
+  std::vector<size_type> upper_level_rows;
+
+  /**
+   * The start indices of the levels in #upper_level_rows.
+   */
+  std::vector<size_type> upper_level_starts;
+
 private:
+  /**
+   * Release the memory of the level schedules.
+   */
+  void
+  clear_level_schedule();
+
   /**
    * In general this pointer is zero except for the case that no
    * SparsityPattern is given to this class. Then, a SparsityPattern is
@@ -407,6 +496,76 @@ SparseLUDecomposition<number>::Tvmult_add(OutVector &     dst,
   dst += tmp;
 }
 
+
+
+namespace internal
+{
+  namespace SparseLUDecompositionImplementation
+  {
+    // process all rows of a level schedule level by level. levels with few
+    // rows are processed serially, since splitting them among threads does
+    // not pay off
+    template <typename size_type, typename Function>
+    inline void
+    apply_level_schedule(const std::vector<size_type> &level_starts,
+                         const std::vector<size_type> &level_rows,
+                         const Function &              row_operation)
+    {
+      const size_type grain_size =
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size;
+      for (unsigned int level = 0; level + 1 < level_starts.size(); ++level)
+        {
+          const size_type begin = level_starts[level];
+          const size_type end   = level_starts[level + 1];
+          if (end - begin < 2 * grain_size)
+            for (size_type i = begin; i < end; ++i)
+              row_operation(level_rows[i]);
+          else
+            parallel::apply_to_subranges(
+              begin,
+              end,
+              [&](const size_type sub_begin, const size_type sub_end) {
+                for (size_type i = sub_begin; i < sub_end; ++i)
+                  row_operation(level_rows[i]);
+              },
+              grain_size);
+        }
+    }
+  } // namespace SparseLUDecompositionImplementation
+} // namespace internal
+
+
+
+template <typename number>
+template <typename Function>
+inline void
+SparseLUDecomposition<number>::apply_forward_substitution(
+  const Function &row_operation) const
+{
+  if (lower_level_starts.empty())
+    for (size_type row = 0; row < this->m(); ++row)
+      row_operation(row);
+  else
+    internal::SparseLUDecompositionImplementation::apply_level_schedule(
+      lower_level_starts, lower_level_rows, row_operation);
+}
+
+
+
+template <typename number>
+template <typename Function>
+inline void
+SparseLUDecomposition<number>::apply_backward_substitution(
+  const Function &row_operation) const
+{
+  if (upper_level_starts.empty())
+    for (size_type row = this->m(); row > 0;)
+      row_operation(--row);
+  else
+    internal::SparseLUDecompositionImplementation::apply_level_schedule(
+      upper_level_starts, upper_level_rows, row_operation);
+}
+
 //---------------------------------------------------------------------------
 
 
@@ -21,6 +21,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
 
@@ -28,6 +29,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -56,6 +58,7 @@ SparseLUDecomposition<number>::clear()
 {
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
+  clear_level_schedule();
 
   SparseMatrix<number>::clear();
 
@@ -133,6 +136,7 @@ SparseLUDecomposition<number>::initialize(
     std::vector<const size_type *> tmp;
     tmp.swap(prebuilt_lower_bound);
   }
+  clear_level_schedule();
   SparseMatrix<number>::reinit(*sparsity_pattern_to_use);
 }
 
@@ -159,6 +163,112 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
     }
 }
 
+
+
+namespace internal
+{
+  namespace SparseLUDecompositionImplementation
+  {
+    // sort the rows by their level with a counting sort, which keeps the
+    // rows within each level in ascending order. only set up the schedule if
+    // the levels are on average wide enough for parallel work
+    template <typename size_type>
+    void
+    sort_rows_by_level(const std::vector<size_type> &levels,
+                       const size_type               n_levels,
+                       std::vector<size_type> &      level_starts,
+                       std::vector<size_type> &      level_rows)
+    {
+      const size_type N = levels.size();
+      if (N / n_levels <
+          internal::SparseMatrixImplementation::minimum_parallel_grain_size)
+        return;
+
+      level_starts.resize(n_levels + 1);
+      for (size_type row = 0; row < N; ++row)
+        ++level_starts[levels[row] + 1];
+      std::partial_sum(level_starts.begin(),
+                       level_starts.end(),
+                       level_starts.begin());
+
+      std::vector<size_type> next(level_starts.begin(),
+                                  level_starts.end() - 1);
+      level_rows.resize(N);
+      for (size_type row = 0; row < N; ++row)
+        level_rows[next[levels[row]]++] = row;
+    }
+  } // namespace SparseLUDecompositionImplementation
+} // namespace internal
+
+
+
+template <typename number>
+void
+SparseLUDecomposition<number>::prebuild_level_schedule()
+{
+  clear_level_schedule();
+
+  const size_type N = this->m();
+  AssertDimension(prebuilt_lower_bound.size(), N);
+  if (MultithreadInfo::n_threads() == 1 || N == 0)
+    return;
+
+  const size_type *const column_numbers =
+    this->get_sparsity_pattern().colnums.get();
+  const std::size_t *const rowstart_indices =
+    this->get_sparsity_pattern().rowstart.get();
+
+  std::vector<size_type> levels(N);
+
+  // the lower factor: rows depend on the rows of the columns left of the
+  // diagonal, which we find between the diagonal (stored first) and the
+  // prebuilt lower bound
+  size_type n_levels = 0;
+  for (size_type row = 0; row < N; ++row)
+    {
+      size_type level = 0;
+      for (const size_type *col = &column_numbers[rowstart_indices[row] + 1];
+           col != prebuilt_lower_bound[row];
+           ++col)
+        level = std::max(level, levels[*col] + 1);
+      levels[row] = level;
+      n_levels    = std::max(n_levels, level + 1);
+    }
+  internal::SparseLUDecompositionImplementation::sort_rows_by_level(
+    levels, n_levels, lower_level_starts, lower_level_rows);
+
+  // the upper factor: rows depend on the rows of the columns right of the
+  // diagonal
+  n_levels = 0;
+  for (size_type row = N; row > 0;)
+    {
+      --row;
+      size_type level = 0;
+      for (const size_type *col = prebuilt_lower_bound[row];
+           col != &column_numbers[rowstart_indices[row + 1]];
+           ++col)
+        level = std::max(level, levels[*col] + 1);
+      levels[row] = level;
+      n_levels    = std::max(n_levels, level + 1);
+    }
+  internal::SparseLUDecompositionImplementation::sort_rows_by_level(
+    levels, n_levels, upper_level_starts, upper_level_rows);
+}
+
+
+
+template <typename number>
+void
+SparseLUDecomposition<number>::clear_level_schedule()
+{
+  std::vector<size_type>().swap(lower_level_rows);
+  std::vector<size_type>().swap(lower_level_starts);
+  std::vector<size_type>().swap(upper_level_rows);
+  std::vector<size_type>().swap(upper_level_starts);
+}
+
+
+
 template <typename number>
 template <typename somenumber>
 void
@@ -239,7 +349,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(lower_level_rows) +
+          MemoryConsumption::memory_consumption(lower_level_starts) +
+          MemoryConsumption::memory_consumption(upper_level_rows) +
+          MemoryConsumption::memory_consumption(upper_level_starts));
 }
 
 
@@ -33,6 +33,12 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class FullMatrix;
+#endif
+
 namespace types
 {
   /**
@@ -141,6 +147,14 @@ public:
    * This function copies the contents of the matrix into its own storage; the
    * matrix can therefore be deleted after this operation, even if subsequent
    * solves are required.
+   *
+   * The factorization consists of a symbolic phase that only depends on the
+   * sparsity pattern of the matrix, and of a numeric phase. The result of
+   * the symbolic phase is kept by this object, and it is reused if the
+   * matrix passed to a subsequent call of this function has the same
+   * sparsity pattern (and is again real- or complex-valued, respectively),
+   * as it happens when factorizing the Jacobian in every step of a Newton
+   * iteration. In that case, only the numeric phase is run again.
    */
   template <class Matrix>
   void
@@ -270,6 +284,33 @@ public:
   solve(BlockVector<std::complex<double>> &rhs_and_solution,
         const bool                         transpose = false) const;
 
+  /**
+   * Solve for several right hand sides at once, given by the columns of
+   * @p rhs_and_solution, which must have m() rows. The solutions are
+   * returned in place of the right hand sides. The individual solves are
+   * independent and are run in parallel on the available threads.
+   *
+   * @pre You need to call factorize() before this function can be called.
+   */
+  void
+  solve(FullMatrix<double> &rhs_and_solution,
+        const bool          transpose = false) const;
+
+  /**
+   * Same as before, but with the right hand sides given as a collection of
+   * vectors.
+   */
+  void
+  solve(std::vector<Vector<double>> &rhs_and_solution,
+        const bool                   transpose = false) const;
+
+  /**
+   * Same as before, but for a collection of block vectors.
+   */
+  void
+  solve(std::vector<BlockVector<double>> &rhs_and_solution,
+        const bool                        transpose = false) const;
+
   /**
    * Call the two functions factorize() and solve() in that order, i.e.
    * perform the whole solution process for the given right hand side vector.
@@ -373,6 +414,8 @@ private:
    * The UMFPACK routines allocate objects in which they store information
    * about symbolic and numeric values of the decomposition. The actual data
    * type of these objects is opaque, and only passed around as void pointers.
+   * The symbolic decomposition is kept after factorize() to be reused for
+   * matrices with the same sparsity pattern.
    */
   void *symbolic_decomposition;
   void *numeric_decomposition;
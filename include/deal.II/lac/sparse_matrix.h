@@ -1092,6 +1092,14 @@ public:
    * you want to multiply with BlockVector objects, you should consider using
    * a BlockSparseMatrix as well.
    *
+   * The number type of the matrix may differ from the one of the vectors.
+   * The products are summed in the number type of the destination vector,
+   * so a matrix stored in single precision can be applied to vectors in
+   * double precision, e.g. as a preconditioner in a mixed-precision
+   * iteration, with only the matrix entries being held in reduced precision.
+   * LinearAlgebra::distributed::Vector objects are supported as long as all
+   * elements are stored on the calling process.
+   *
    * Source and destination must not be the same vector.
    *
    * @dealiiOperationIsMultithreaded
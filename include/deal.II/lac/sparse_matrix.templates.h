@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/memory_space.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
@@ -44,6 +45,18 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 
 template <typename number>
 SparseMatrix<number>::SparseMatrix()
@@ -482,6 +495,77 @@ namespace internal
 {
   namespace SparseMatrixImplementation
   {
+    /**
+     * Return an object to read the entries of the vector @p src in the inner
+     * loop of the matrix-vector product. For general vectors, this is the
+     * vector itself.
+     */
+    template <typename VectorType>
+    inline const VectorType &
+    get_read_access(const VectorType &src)
+    {
+      return src;
+    }
+
+
+
+    /**
+     * For Vector, return the pointer to the underlying array, in order to
+     * let the compiler see a plain indirect load in the inner loop.
+     */
+    template <typename Number>
+    inline const Number *
+    get_read_access(const Vector<Number> &src)
+    {
+      return src.begin();
+    }
+
+
+
+    /**
+     * For LinearAlgebra::distributed::Vector, return the pointer to the
+     * locally owned array. This avoids the translation from global to local
+     * indices in operator(), which the vector needs to perform on every
+     * access otherwise. Since SparseMatrix is a serial object, the vector
+     * must not have ghost entries or other processes.
+     */
+    template <typename Number>
+    inline const Number *
+    get_read_access(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &src)
+    {
+      Assert(src.locally_owned_size() == src.size(),
+             ExcMessage("SparseMatrix::vmult can only work with vectors "
+                        "that are stored completely on one process."));
+      return src.begin();
+    }
+
+
+
+    /**
+     * Read the entry @p index from a vector.
+     */
+    template <typename VectorType>
+    inline typename VectorType::value_type
+    read_entry(const VectorType &src, const size_type index)
+    {
+      return src(index);
+    }
+
+
+
+    /**
+     * Read the entry @p index from an array.
+     */
+    template <typename Number>
+    inline Number
+    read_entry(const Number *src, const size_type index)
+    {
+      return src[index];
+    }
+
+
+
     /**
      * Perform a vmult using the SparseMatrix data structures, but only using
      * a subinterval for the row indices.
@@ -489,6 +573,11 @@ namespace internal
      * In the sequential case, this function is called on all rows, in the
      * parallel case it may be called on a subrange, at the discretion of the
      * task scheduler.
+     *
+     * The sum for each row is accumulated in the number type of the
+     * destination vector, i.e., a matrix in single precision applied to
+     * vectors in double precision only reads the matrix entries in reduced
+     * precision.
      */
     template <typename number, typename InVector, typename OutVector>
     void
@@ -501,28 +590,31 @@ namespace internal
                       OutVector &        dst,
                       const bool         add)
     {
+      using OutNumber = typename OutVector::value_type;
+
       const number *               val_ptr    = &values[rowstart[begin_row]];
       const size_type *            colnum_ptr = &colnums[rowstart[begin_row]];
       typename OutVector::iterator dst_ptr    = dst.begin() + begin_row;
+      decltype(auto)               src_data   = get_read_access(src);
 
       if (add == false)
         for (size_type row = begin_row; row < end_row; ++row)
           {
-            typename OutVector::value_type s   = 0.;
+            OutNumber           s              = 0.;
             const number *const val_end_of_row = &values[rowstart[row + 1]];
             while (val_ptr != val_end_of_row)
-              s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
+              s += OutNumber(*val_ptr++) *
+                   OutNumber(read_entry(src_data, *colnum_ptr++));
             *dst_ptr++ = s;
           }
       else
         for (size_type row = begin_row; row < end_row; ++row)
           {
-            typename OutVector::value_type s   = *dst_ptr;
+            OutNumber           s              = *dst_ptr;
             const number *const val_end_of_row = &values[rowstart[row + 1]];
             while (val_ptr != val_end_of_row)
-              s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
+              s += OutNumber(*val_ptr++) *
+                   OutNumber(read_entry(src_data, *colnum_ptr++));
             *dst_ptr++ = s;
           }
     }
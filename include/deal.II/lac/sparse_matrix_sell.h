@@ -0,0 +1,490 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class SparseMatrix;
+class SparsityPattern;
+template <typename number>
+class Vector;
+#endif
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix stored in the SELL-C-$\sigma$ (sliced ELLPACK) format,
+ * intended as a drop-in replacement of SparseMatrix for the matrix-vector
+ * products in iterative solvers and in PreconditionChebyshev.
+ *
+ * The rows of the matrix are grouped into chunks of $C$ consecutive rows,
+ * where $C$ is the number of lanes of VectorizedArray<number>. Within each
+ * chunk, all rows are padded to the length of the longest row of the chunk,
+ * and the entries are stored column by column, i.e., the $j$-th entry of all
+ * $C$ rows are next to each other in memory. This allows the matrix-vector
+ * product in vmult() to process $C$ rows at once with SIMD instructions: The
+ * matrix entries are loaded with a contiguous vector load, the source vector
+ * entries are gathered, and the results of all rows of the chunk are
+ * accumulated in the SIMD lanes, in contrast to the scalar loop over the
+ * entries of a single row of the compressed row storage used by
+ * SparseMatrix.
+ *
+ * In order to reduce the amount of padding when the row lengths vary, rows
+ * are sorted by their length within windows of $\sigma$ rows before being
+ * grouped into chunks. This reordering is internal to the class, i.e., all
+ * functions take and return rows and vectors in the original numbering. For
+ * the typical matrices of finite element discretizations with similar row
+ * lengths, a small window suffices.
+ *
+ * The structure of the matrix is set up from a SparsityPattern by reinit(),
+ * and the values can then be set with set() and add() as for SparseMatrix,
+ * i.e., the matrix can be assembled directly, e.g. by
+ * AffineConstraints::distribute_local_to_global(). Alternatively, the
+ * structure and the values can be taken from an assembled SparseMatrix by
+ * copy_from(). The column indices are stored as 32-bit integers.
+ *
+ * @note Instantiations for this template are provided for <tt>@<float@> and
+ * @<double@></tt>.
+ */
+template <typename number>
+class SparseMatrixSELL : public virtual Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * The number of rows that are processed together, given by the number of
+   * lanes in VectorizedArray<number>.
+   */
+  static constexpr unsigned int chunk_size = VectorizedArray<number>::size();
+
+  /**
+   * The default size of the window within which rows are sorted by length.
+   */
+  static constexpr unsigned int default_sigma = 64;
+
+  /**
+   * Constructor. Initializes an empty matrix of dimension zero times zero.
+   */
+  SparseMatrixSELL();
+
+  /**
+   * Constructor. Sets up the structure of the matrix from @p sparsity, see
+   * reinit().
+   */
+  explicit SparseMatrixSELL(const SparsityPattern &sparsity,
+                            const unsigned int     sigma = default_sigma);
+
+  /**
+   * Set up the structure of the matrix from the given sparsity pattern, with
+   * all values set to zero. The parameter @p sigma gives the size of the
+   * window within which rows are sorted by their length; it is rounded up to
+   * a multiple of chunk_size. A value of one disables the sorting.
+   *
+   * In contrast to SparseMatrix, this object does not keep a reference to
+   * the sparsity pattern.
+   */
+  void
+  reinit(const SparsityPattern &sparsity,
+         const unsigned int     sigma = default_sigma);
+
+  /**
+   * Set up the structure of the matrix from the sparsity pattern of
+   * @p matrix and copy its values.
+   */
+  template <typename number2>
+  SparseMatrixSELL<number> &
+  copy_from(const SparseMatrix<number2> &matrix,
+            const unsigned int           sigma = default_sigma);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Set all stored entries of the matrix to @p d, which must be zero. The
+   * structure of the matrix is kept.
+   */
+  SparseMatrixSELL<number> &
+  operator=(const double d);
+
+  /**
+   * Return the number of rows of this matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of this matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the matrix, excluding the
+   * padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of entries stored by the matrix, including the
+   * padding of the rows within each chunk.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Set the entry (<i>i,j</i>) to @p value. The entry must be part of the
+   * sparsity pattern.
+   */
+  void
+  set(const size_type i, const size_type j, const number value);
+
+  /**
+   * Add @p value to the entry (<i>i,j</i>). The entry must be part of the
+   * sparsity pattern, unless @p value is zero.
+   */
+  void
+  add(const size_type i, const size_type j, const number value);
+
+  /**
+   * Add an array of values given by @p values in the given global matrix row
+   * at columns specified by @p col_indices, with the same semantics as
+   * SparseMatrix::add().
+   */
+  template <typename number2>
+  void
+  add(const size_type  row,
+      const size_type  n_cols,
+      const size_type *col_indices,
+      const number2 *  values,
+      const bool       elide_zero_values      = true,
+      const bool       col_indices_are_sorted = false);
+
+  /**
+   * Return the value of the entry (<i>i,j</i>), which must be part of the
+   * sparsity pattern.
+   */
+  number
+  operator()(const size_type i, const size_type j) const;
+
+  /**
+   * Return the value of the entry (<i>i,j</i>), or zero if the entry is not
+   * part of the sparsity pattern.
+   */
+  number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Return the main diagonal element in the <i>i</i>th row. The matrix must
+   * be quadratic.
+   */
+  number
+  diag_element(const size_type i) const;
+
+  /**
+   * Matrix-vector multiplication: let <i>dst = M*src</i> with <i>M</i> being
+   * this matrix. The chunks of rows are split over the available threads.
+   *
+   * The vectors need to provide access to their elements via a contiguous
+   * array behind begin(), like Vector or LinearAlgebra::distributed::Vector
+   * in serial.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Matrix-vector multiplication: let <i>dst += M*src</i>.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Transposed matrix-vector multiplication: let <i>dst =
+   * M<sup>T</sup>*src</i>. This operation scatters into the destination
+   * vector and is performed serially.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Transposed matrix-vector multiplication: let <i>dst +=
+   * M<sup>T</sup>*src</i>.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * @p src vector by the inverse of the respective diagonal element and
+   * multiplies the result with the relaxation factor @p omega.
+   */
+  template <typename somenumber>
+  void
+  precondition_Jacobi(Vector<somenumber> &      dst,
+                      const Vector<somenumber> &src,
+                      const number              omega = 1.) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception
+   */
+  DeclException2(ExcInvalidIndex,
+                 int,
+                 int,
+                 << "You are trying to access the matrix entry with index <"
+                 << arg1 << ',' << arg2
+                 << ">, but this entry does not exist in the sparsity pattern "
+                    "of this matrix.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+  //@}
+
+private:
+  /**
+   * Return the position of the entry (<i>i,j</i>) in the arrays @p values
+   * and @p column_indices, or numbers::invalid_size_type if the entry is not
+   * part of the sparsity pattern.
+   */
+  std::size_t
+  find_entry(const size_type i, const size_type j) const;
+
+  /**
+   * Compute <i>dst = M*src</i> or <i>dst += M*src</i> on the chunks in the
+   * given half-open range.
+   */
+  template <typename number2, typename number3>
+  void
+  vmult_on_chunks(const unsigned int begin_chunk,
+                  const unsigned int end_chunk,
+                  const number2 *    src,
+                  number3 *          dst,
+                  const bool         add) const;
+
+  /**
+   * Number of rows of the matrix.
+   */
+  size_type n_matrix_rows;
+
+  /**
+   * Number of columns of the matrix.
+   */
+  size_type n_matrix_cols;
+
+  /**
+   * The offset of the first entry of each chunk in the arrays @p values and
+   * @p column_indices. The entries of chunk @p c are stored in the range
+   * <tt>[chunk_start[c], chunk_start[c+1])</tt>, with the entry of lane
+   * <tt>v</tt> in column position <tt>j</tt> at <tt>chunk_start[c] +
+   * j*chunk_size + v</tt>.
+   */
+  std::vector<std::size_t> chunk_start;
+
+  /**
+   * The original row number for each position (chunk times chunk_size plus
+   * lane) in the sorted order. Positions beyond the last row are filled with
+   * numbers::invalid_unsigned_int.
+   */
+  std::vector<unsigned int> row_of_position;
+
+  /**
+   * The position in the sorted order for each row, i.e., the inverse of
+   * @p row_of_position.
+   */
+  std::vector<unsigned int> position_of_row;
+
+  /**
+   * The number of entries in each row, excluding the padding.
+   */
+  std::vector<unsigned int> row_lengths;
+
+  /**
+   * The column index of each stored entry. Padding entries repeat the last
+   * column index of the row.
+   */
+  AlignedVector<unsigned int> column_indices;
+
+  /**
+   * The value of each stored entry. Padding entries are zero.
+   */
+  AlignedVector<number> values;
+};
+
+/**
+ * @}
+ */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::m() const
+{
+  return n_matrix_rows;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::n() const
+{
+  return n_matrix_cols;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::find_entry(const size_type i,
+                                     const size_type j) const
+{
+  AssertIndexRange(i, m());
+  AssertIndexRange(j, n());
+  const unsigned int position = position_of_row[i];
+  const std::size_t  start =
+    chunk_start[position / chunk_size] + position % chunk_size;
+  for (unsigned int k = 0; k < row_lengths[i]; ++k)
+    if (column_indices[start + k * chunk_size] == j)
+      return start + k * chunk_size;
+  return numbers::invalid_size_type;
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::set(const size_type i,
+                              const size_type j,
+                              const number    value)
+{
+  AssertIsFinite(value);
+  const std::size_t index = find_entry(i, j);
+  if (index == numbers::invalid_size_type)
+    {
+      Assert(value == number(), ExcInvalidIndex(i, j));
+      return;
+    }
+  values[index] = value;
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::add(const size_type i,
+                              const size_type j,
+                              const number    value)
+{
+  AssertIsFinite(value);
+  if (value == number())
+    return;
+  const std::size_t index = find_entry(i, j);
+  Assert(index != numbers::invalid_size_type, ExcInvalidIndex(i, j));
+  values[index] += value;
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::operator()(const size_type i,
+                                     const size_type j) const
+{
+  const std::size_t index = find_entry(i, j);
+  Assert(index != numbers::invalid_size_type, ExcInvalidIndex(i, j));
+  return values[index];
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::el(const size_type i, const size_type j) const
+{
+  const std::size_t index = find_entry(i, j);
+  return index == numbers::invalid_size_type ? number() : values[index];
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::diag_element(const size_type i) const
+{
+  Assert(m() == n(), ExcNotQuadratic());
+  return (*this)(i, i);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
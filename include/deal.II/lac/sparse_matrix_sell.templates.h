@@ -0,0 +1,484 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_templates_h
+#define dealii_sparse_matrix_sell_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace SparseMatrixSELLImplementation
+  {
+    /**
+     * Multiply the entries of a single chunk with the source vector and
+     * return the sum for each row of the chunk. This is the general variant
+     * for different number types of the matrix and the vectors, which
+     * accumulates in the number type of the destination vector.
+     */
+    template <typename number, typename number2, typename number3>
+    struct ChunkProduct
+    {
+      static void
+      run(const unsigned int  n_columns,
+          const number *      values,
+          const unsigned int *column_indices,
+          const number2 *     src,
+          number3 *           result)
+      {
+        constexpr unsigned int chunk_size = VectorizedArray<number>::size();
+        for (unsigned int v = 0; v < chunk_size; ++v)
+          result[v] = number3();
+        for (unsigned int k = 0; k < n_columns; ++k)
+          for (unsigned int v = 0; v < chunk_size; ++v)
+            result[v] +=
+              number3(values[k * chunk_size + v]) *
+              number3(src[column_indices[k * chunk_size + v]]);
+      }
+    };
+
+
+
+    /**
+     * Specialization for the case where the matrix and the vectors use the
+     * same number type, where we can use SIMD loads of the matrix entries
+     * and gather operations on the source vector.
+     */
+    template <typename number>
+    struct ChunkProduct<number, number, number>
+    {
+      static void
+      run(const unsigned int  n_columns,
+          const number *      values,
+          const unsigned int *column_indices,
+          const number *      src,
+          number *            result)
+      {
+        constexpr unsigned int chunk_size = VectorizedArray<number>::size();
+        VectorizedArray<number> sum       = number();
+        for (unsigned int k = 0; k < n_columns; ++k)
+          {
+            VectorizedArray<number> matrix_entries, vector_entries;
+            matrix_entries.load(values + k * chunk_size);
+            vector_entries.gather(src, column_indices + k * chunk_size);
+            sum += matrix_entries * vector_entries;
+          }
+        sum.store(result);
+      }
+    };
+  } // namespace SparseMatrixSELLImplementation
+} // namespace internal
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL()
+  : n_matrix_rows(0)
+  , n_matrix_cols(0)
+{}
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL(const SparsityPattern &sparsity,
+                                           const unsigned int     sigma)
+  : n_matrix_rows(0)
+  , n_matrix_cols(0)
+{
+  reinit(sparsity, sigma);
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::clear()
+{
+  n_matrix_rows = 0;
+  n_matrix_cols = 0;
+  chunk_start.clear();
+  row_of_position.clear();
+  position_of_row.clear();
+  row_lengths.clear();
+  column_indices.clear();
+  values.clear();
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::reinit(const SparsityPattern &sparsity,
+                                 const unsigned int     sigma)
+{
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  AssertThrow(sparsity.n_rows() < std::numeric_limits<unsigned int>::max() &&
+                sparsity.n_cols() < std::numeric_limits<unsigned int>::max(),
+              ExcMessage("SparseMatrixSELL stores 32-bit indices and can "
+                         "only represent matrices with less than 2^32 rows "
+                         "and columns."));
+
+  clear();
+  n_matrix_rows = sparsity.n_rows();
+  n_matrix_cols = sparsity.n_cols();
+
+  const unsigned int n_rows   = n_matrix_rows;
+  const unsigned int n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+
+  row_lengths.resize(n_rows);
+  for (unsigned int row = 0; row < n_rows; ++row)
+    row_lengths[row] = sparsity.row_length(row);
+
+  // sort the rows by decreasing length within windows of sigma rows; the
+  // sort is stable to keep the original order of rows with the same length,
+  // which retains the locality of the access to the destination vector
+  row_of_position.resize(n_chunks * chunk_size, numbers::invalid_unsigned_int);
+  std::iota(row_of_position.begin(),
+            row_of_position.begin() + n_rows,
+            0U);
+  const unsigned int window =
+    ((std::max(sigma, 1U) + chunk_size - 1) / chunk_size) * chunk_size;
+  if (window > chunk_size)
+    for (unsigned int start = 0; start < n_rows; start += window)
+      std::stable_sort(row_of_position.begin() + start,
+                       row_of_position.begin() +
+                         std::min(start + window, n_rows),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return row_lengths[a] > row_lengths[b];
+                       });
+
+  position_of_row.resize(n_rows);
+  for (unsigned int position = 0; position < n_rows; ++position)
+    position_of_row[row_of_position[position]] = position;
+
+  // compute the width of each chunk as the longest row in the chunk
+  chunk_start.resize(n_chunks + 1);
+  chunk_start[0] = 0;
+  for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+    {
+      unsigned int width = 0;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const unsigned int row = row_of_position[chunk * chunk_size + v];
+          if (row != numbers::invalid_unsigned_int)
+            width = std::max(width, row_lengths[row]);
+        }
+      chunk_start[chunk + 1] =
+        chunk_start[chunk] + std::size_t(width) * chunk_size;
+    }
+
+  // fill the column indices. Padding entries repeat the last column of the
+  // row, such that the gather operation stays within the cache lines
+  // accessed by the row anyway
+  column_indices.resize_fast(chunk_start.back());
+  values.resize(chunk_start.back());
+  for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+    {
+      const unsigned int width =
+        (chunk_start[chunk + 1] - chunk_start[chunk]) / chunk_size;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const std::size_t  start = chunk_start[chunk] + v;
+          const unsigned int row   = row_of_position[chunk * chunk_size + v];
+          unsigned int       k     = 0;
+          unsigned int       last_column = 0;
+          if (row != numbers::invalid_unsigned_int)
+            for (auto it = sparsity.begin(row); it != sparsity.end(row);
+                 ++it, ++k)
+              {
+                last_column = it->column();
+                column_indices[start + k * chunk_size] = last_column;
+              }
+          for (; k < width; ++k)
+            column_indices[start + k * chunk_size] = last_column;
+        }
+    }
+}
+
+
+
+template <typename number>
+template <typename number2>
+SparseMatrixSELL<number> &
+SparseMatrixSELL<number>::copy_from(const SparseMatrix<number2> &matrix,
+                                    const unsigned int           sigma)
+{
+  reinit(matrix.get_sparsity_pattern(), sigma);
+
+  // the entries of the SparseMatrix rows are in the same order as in the
+  // sparsity pattern
+  for (unsigned int row = 0; row < n_matrix_rows; ++row)
+    {
+      const unsigned int position = position_of_row[row];
+      const std::size_t  start =
+        chunk_start[position / chunk_size] + position % chunk_size;
+      unsigned int k = 0;
+      for (auto it = matrix.begin(row); it != matrix.end(row); ++it, ++k)
+        values[start + k * chunk_size] = it->value();
+    }
+
+  return *this;
+}
+
+
+
+template <typename number>
+SparseMatrixSELL<number> &
+SparseMatrixSELL<number>::operator=(const double d)
+{
+  (void)d;
+  Assert(d == 0, ExcScalarAssignmentOnlyForZeroValue());
+
+  std::fill(values.begin(), values.end(), number());
+
+  return *this;
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::n_nonzero_elements() const
+{
+  return std::accumulate(row_lengths.begin(),
+                         row_lengths.end(),
+                         std::size_t(0));
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::n_stored_elements() const
+{
+  return values.size();
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrixSELL<number>::add(const size_type  row,
+                              const size_type  n_cols,
+                              const size_type *col_indices,
+                              const number2 *  input_values,
+                              const bool       elide_zero_values,
+                              const bool /*col_indices_are_sorted*/)
+{
+  AssertIndexRange(row, m());
+  const unsigned int position = position_of_row[row];
+  const std::size_t  start =
+    chunk_start[position / chunk_size] + position % chunk_size;
+  const unsigned int row_length = row_lengths[row];
+
+  // the columns of the local matrices are usually given in a similar order
+  // as in the sparsity pattern, so we start the search for the next column
+  // after the position of the previous one
+  unsigned int hint = 0;
+  for (size_type j = 0; j < n_cols; ++j)
+    {
+      const number value = input_values[j];
+      AssertIsFinite(value);
+      if (value == number() && elide_zero_values)
+        continue;
+
+      bool found = false;
+      for (unsigned int i = 0; i < row_length; ++i)
+        {
+          const unsigned int k = (hint + i) % row_length;
+          if (column_indices[start + k * chunk_size] == col_indices[j])
+            {
+              values[start + k * chunk_size] += value;
+              hint  = k + 1;
+              found = true;
+              break;
+            }
+        }
+      (void)found;
+      Assert(found || value == number(), ExcInvalidIndex(row, col_indices[j]));
+    }
+}
+
+
+
+template <typename number>
+template <typename number2, typename number3>
+void
+SparseMatrixSELL<number>::vmult_on_chunks(const unsigned int begin_chunk,
+                                          const unsigned int end_chunk,
+                                          const number2 *    src,
+                                          number3 *          dst,
+                                          const bool         add) const
+{
+  number3 result[chunk_size];
+  for (unsigned int chunk = begin_chunk; chunk < end_chunk; ++chunk)
+    {
+      const std::size_t start = chunk_start[chunk];
+      internal::SparseMatrixSELLImplementation::
+        ChunkProduct<number, number2, number3>::run(
+          (chunk_start[chunk + 1] - start) / chunk_size,
+          values.data() + start,
+          column_indices.data() + start,
+          src,
+          result);
+
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const unsigned int row = row_of_position[chunk * chunk_size + v];
+          if (row == numbers::invalid_unsigned_int)
+            break;
+          if (add)
+            dst[row] += result[v];
+          else
+            dst[row] = result[v];
+        }
+    }
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult(OutVector &dst, const InVector &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+      vmult_on_chunks(begin, end, src.begin(), dst.begin(), false);
+    },
+    std::max(internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               chunk_size,
+             1U));
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+      vmult_on_chunks(begin, end, src.begin(), dst.begin(), true);
+    },
+    std::max(internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               chunk_size,
+             1U));
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult(OutVector &dst, const InVector &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  dst = 0;
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  using OutNumber = typename OutVector::value_type;
+  for (unsigned int row = 0; row < n_matrix_rows; ++row)
+    {
+      const unsigned int position = position_of_row[row];
+      const std::size_t  start =
+        chunk_start[position / chunk_size] + position % chunk_size;
+      const OutNumber src_value = src(row);
+      for (unsigned int k = 0; k < row_lengths[row]; ++k)
+        dst(column_indices[start + k * chunk_size]) +=
+          OutNumber(values[start + k * chunk_size]) * src_value;
+    }
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SparseMatrixSELL<number>::precondition_Jacobi(Vector<somenumber> &      dst,
+                                              const Vector<somenumber> &src,
+                                              const number om) const
+{
+  Assert(m() == n(), ExcNotQuadratic());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  for (unsigned int row = 0; row < n_matrix_rows; ++row)
+    dst(row) = om * src(row) / diag_element(row);
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(chunk_start) +
+         MemoryConsumption::memory_consumption(row_of_position) +
+         MemoryConsumption::memory_consumption(position_of_row) +
+         MemoryConsumption::memory_consumption(row_lengths) +
+         MemoryConsumption::memory_consumption(column_indices) +
+         MemoryConsumption::memory_consumption(values);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -79,6 +79,7 @@ SparseMIC<number>::initialize(const SparseMatrix<somenumber> &matrix,
   SparseLUDecomposition<number>::initialize(matrix, data);
   this->strengthen_diagonal = data.strengthen_diagonal;
   this->prebuild_lower_bound();
+  this->prebuild_level_schedule();
   this->copy_from(matrix);
 
   Assert(this->m() == this->n(), ExcNotQuadratic());
@@ -160,38 +161,34 @@ SparseMIC<number>::vmult(Vector<somenumber> &      dst,
   //
   // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // Now: (X-L)u = b
+  this->apply_forward_substitution([&](const size_type row) {
+    // Now: (X-L)u = b
 
-      // get start of this row. skip
-      // the diagonal element
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           (p != this->end(row)) && (p->column() < row);
-           ++p)
-        dst(row) -= p->value() * dst(p->column());
+    // get start of this row. skip
+    // the diagonal element
+    for (typename SparseMatrix<number>::const_iterator p = this->begin(row) + 1;
+         (p != this->end(row)) && (p->column() < row);
+         ++p)
+      dst(row) -= p->value() * dst(p->column());
 
-      dst(row) *= inv_diag[row];
-    }
+    dst(row) *= inv_diag[row];
+  });
 
   // Now: v = Xu
   for (size_type row = 0; row < N; ++row)
     dst(row) *= diag[row];
 
   // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           p != this->end(row);
-           ++p)
-        if (p->column() > static_cast<size_type>(row))
-          dst(row) -= p->value() * dst(p->column());
+  this->apply_backward_substitution([&](const size_type row) {
+    // get end of this row
+    for (typename SparseMatrix<number>::const_iterator p = this->begin(row) + 1;
+         p != this->end(row);
+         ++p)
+      if (p->column() > row)
+        dst(row) -= p->value() * dst(p->column());
 
-      dst(row) *= inv_diag[row];
-    }
+    dst(row) *= inv_diag[row];
+  });
 }
 
 
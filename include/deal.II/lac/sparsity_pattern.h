@@ -22,6 +22,7 @@
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/linear_index_iterator.h>
+#include <deal.II/base/memory_tracker.h>
 #include <deal.II/base/subscriptor.h>
 
 // boost::serialization::make_array used to be in array.hpp, but was
@@ -377,7 +378,7 @@ public:
   /**
    * Destructor.
    */
-  ~SparsityPatternBase() override = default;
+  ~SparsityPatternBase() override;
 
   /**
    * Reallocate memory and set up data structures for a new matrix with @p m
@@ -811,6 +812,20 @@ protected:
    */
   bool compressed;
 
+  /**
+   * The number of bytes of the #rowstart and #colnums arrays that have been
+   * reported to MemoryTracker.
+   */
+  std::size_t n_tracked_bytes;
+
+  /**
+   * Report the change of the size of the #rowstart and #colnums arrays since
+   * the last call to MemoryTracker, if memory tracking is enabled. Needs to
+   * be called whenever these arrays have been reallocated.
+   */
+  void
+  update_memory_tracking();
+
   // Make all sparse matrices friends of this class.
   template <typename number>
   friend class SparseMatrix;
@@ -1605,6 +1620,7 @@ SparsityPatternBase::load(Archive &ar, const unsigned int)
 
   rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
   colnums  = std::make_unique<size_type[]>(max_vec_len);
+  update_memory_tracking();
 
   ar &boost::serialization::make_array(rowstart.get(), max_dim + 1);
   ar &boost::serialization::make_array(colnums.get(), max_vec_len);
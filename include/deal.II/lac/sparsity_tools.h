@@ -25,10 +25,12 @@
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern.h>
 
+#include <functional>
 #include <memory>
 #include <vector>
 
 #ifdef DEAL_II_WITH_MPI
+#  include <deal.II/base/array_view.h>
 #  include <deal.II/base/index_set.h>
 
 #  include <mpi.h>
@@ -290,6 +292,53 @@ namespace SparsityTools
     const MPI_Comm &                                      mpi_comm,
     const IndexSet &                                      myrange);
 
+  /**
+   * Communicate rows in a dynamic sparsity pattern over MPI, similar to the
+   * functions above, but without modifying @p dsp. Instead, the function
+   * @p add_row is called for each non-empty locally owned row of @p dsp
+   * and for each row received from other processes, with the sorted column
+   * indices of the row as second argument. The same row might be passed
+   * several times, namely once for the local contribution and once for
+   * each process contributing to it, so that @p add_row has to merge
+   * the entries.
+   *
+   * This makes it possible to fill the final data structure, e.g., a
+   * TrilinosWrappers::SparsityPattern, directly from the sparsity pattern
+   * of the locally relevant rows without building an intermediate
+   * DynamicSparsityPattern containing all entries of the locally owned
+   * rows. See also the function below.
+   *
+   * The rows are sent with the consensus algorithms in
+   * Utilities::MPI::ConsensusAlgorithms, i.e., only to the processes that
+   * actually own some of them. To reduce the message size, row and column
+   * indices are delta-encoded and stored as variable-length integers.
+   */
+  void
+  distribute_sparsity_pattern(
+    const DynamicSparsityPattern &dsp,
+    const IndexSet &              locally_owned_rows,
+    const MPI_Comm &              mpi_comm,
+    const IndexSet &              locally_relevant_rows,
+    const std::function<
+      void(const DynamicSparsityPattern::size_type,
+           const ArrayView<const DynamicSparsityPattern::size_type> &)>
+      &add_row);
+
+  /**
+   * Same as above, but add the entries of the locally owned rows directly
+   * to @p sparsity_pattern, which has to provide a function
+   * `add_entries(row, begin, end, indices_are_sorted)` like, e.g.,
+   * TrilinosWrappers::SparsityPattern does. The object has to be
+   * initialized to accept the locally owned rows.
+   */
+  template <typename SparsityPatternType>
+  void
+  distribute_sparsity_pattern(const DynamicSparsityPattern &dsp,
+                              const IndexSet &              locally_owned_rows,
+                              const MPI_Comm &              mpi_comm,
+                              const IndexSet &         locally_relevant_rows,
+                              SparsityPatternType &    sparsity_pattern);
+
   /**
    * Similar to the function above, but for BlockDynamicSparsityPattern
    * instead.
@@ -402,6 +451,33 @@ namespace SparsityTools
     "configure deal.II with ZOLTAN or zoltan_cpp.h is not available.");
 } // namespace SparsityTools
 
+#ifndef DOXYGEN
+#  ifdef DEAL_II_WITH_MPI
+namespace SparsityTools
+{
+  template <typename SparsityPatternType>
+  void
+  distribute_sparsity_pattern(const DynamicSparsityPattern &dsp,
+                              const IndexSet &              locally_owned_rows,
+                              const MPI_Comm &              mpi_comm,
+                              const IndexSet &         locally_relevant_rows,
+                              SparsityPatternType &    sparsity_pattern)
+  {
+    distribute_sparsity_pattern(
+      dsp,
+      locally_owned_rows,
+      mpi_comm,
+      locally_relevant_rows,
+      [&sparsity_pattern](
+        const DynamicSparsityPattern::size_type                   row,
+        const ArrayView<const DynamicSparsityPattern::size_type> &columns) {
+        sparsity_pattern.add_entries(row, columns.begin(), columns.end(), true);
+      });
+  }
+} // namespace SparsityTools
+#  endif
+#endif
+
 /**
  * @}
  */
@@ -20,12 +20,18 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/lapack_full_matrix.h>
 
 #include <deal.II/matrix_free/tensor_product_kernels.h>
 
+#include <limits>
+#include <map>
+
 DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
@@ -399,6 +405,228 @@ private:
 };
 
 
+
+
+/**
+ * A collection of tensor product matrices of the form described in the
+ * documentation of TensorProductMatrixSymmetricSum for many cells or vertex
+ * patches at once, e.g., for all cell batches of a MatrixFree object. This is
+ * the building block of block-Jacobi or additive Schwarz smoothers based on
+ * the fast diagonalization method, and it differs from a plain
+ * std::vector of TensorProductMatrixSymmetricSum objects in three respects:
+ * <ul>
+ * <li> The 1D mass and derivative matrices of all entries are first collected
+ * by insert(), which may be called concurrently for different indices once
+ * the collection has been sized by reserve(). The generalized eigenproblems
+ * are then solved in parallel in finalize().
+ * <li> If AdditionalData::compress_matrices is set, identical pairs of 1D
+ * mass and derivative matrices (up to round-off) are stored and decomposed
+ * only once. On Cartesian-like meshes, this typically reduces the data to a
+ * handful of 1D problems, irrespective of the number of cells.
+ * <li> vmult() and apply_inverse() use thread-local scratch data rather than
+ * a mutex and can hence be called in parallel, as in MatrixFree::cell_loop().
+ * </ul>
+ *
+ * A typical setup in a matrix-free smoother reads
+ * @code
+ * TensorProductMatrixSymmetricSumCollection<dim, VectorizedArray<double>>
+ *   collection;
+ * collection.reserve(matrix_free.n_cell_batches());
+ * for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+ *   {
+ *     // compute 1D mass and Laplace matrices of the cell batch, ...
+ *     collection.insert(cell, mass_matrices, derivative_matrices);
+ *   }
+ * collection.finalize();
+ * @endcode
+ * after which the smoother reads the cell values with FEEvaluation, calls
+ * apply_inverse() with the index of the cell batch on them, and distributes
+ * the result back into the global vector.
+ *
+ * @tparam dim Dimension of the problem. Currently, 1D, 2D, and 3D codes are
+ * implemented.
+ *
+ * @tparam Number Arithmetic type of the underlying array elements, either
+ * float, double, or a VectorizedArray of these types.
+ *
+ * @tparam n_rows_1d Compile-time number of rows of 1D matrices, see
+ * TensorProductMatrixSymmetricSum. By default at -1, which means that the
+ * number of rows is determined at run-time from the matrices passed to
+ * insert().
+ */
+template <int dim, typename Number, int n_rows_1d = -1>
+class TensorProductMatrixSymmetricSumCollection
+{
+public:
+  /**
+   * Type of matrix entries. This alias is analogous to <tt>value_type</tt>
+   * in the standard library containers.
+   */
+  using value_type = Number;
+
+  /**
+   * Collects the options of this class.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const bool compress_matrices = true);
+
+    /**
+     * Store and decompose identical pairs of 1D mass and derivative matrices
+     * only once.
+     */
+    bool compress_matrices;
+  };
+
+  /**
+   * Constructor.
+   */
+  TensorProductMatrixSymmetricSumCollection(
+    const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Set the number of entries of the collection and release all data of a
+   * previous setup. Must be called before insert().
+   */
+  void
+  reserve(const unsigned int size);
+
+  /**
+   * Set the 1D mass matrices @p mass_matrices and 1D derivative matrices
+   * @p derivative_matrices of the entry with index @p index. The matrices
+   * must be square and of the same size in all directions. This function can
+   * be called concurrently for different indices.
+   */
+  void
+  insert(const unsigned int                       index,
+         const std::array<Table<2, Number>, dim> &mass_matrices,
+         const std::array<Table<2, Number>, dim> &derivative_matrices);
+
+  /**
+   * Compress the 1D matrices given to insert() (if requested) and compute
+   * the generalized eigenvalues and eigenvectors in parallel. Afterwards,
+   * the 1D matrices passed to insert() are no longer held.
+   */
+  void
+  finalize();
+
+  /**
+   * Matrix-vector product with the tensor product matrix of entry @p index.
+   */
+  void
+  vmult(const unsigned int             index,
+        const ArrayView<Number> &      dst,
+        const ArrayView<const Number> &src) const;
+
+  /**
+   * Apply the inverse of the tensor product matrix of entry @p index by the
+   * fast diagonalization method.
+   */
+  void
+  apply_inverse(const unsigned int             index,
+                const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src) const;
+
+  /**
+   * Return the number of entries of the collection.
+   */
+  unsigned int
+  size() const;
+
+  /**
+   * Return the number of rows of the tensor product matrix of entry
+   * @p index, which equals the number of columns.
+   */
+  unsigned int
+  m(const unsigned int index) const;
+
+  /**
+   * Return the number of distinct pairs of 1D matrices that are stored
+   * after finalize().
+   */
+  std::size_t
+  storage_size() const;
+
+  /**
+   * Return the memory consumption of this class in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Whether to compress identical 1D matrices in finalize().
+   */
+  bool compress_matrices;
+
+  /**
+   * The 1D mass matrices given to insert() until finalize() is called.
+   */
+  std::vector<std::array<Table<2, Number>, dim>> inserted_mass_matrices;
+
+  /**
+   * The 1D derivative matrices given to insert() until finalize() is
+   * called.
+   */
+  std::vector<std::array<Table<2, Number>, dim>> inserted_derivative_matrices;
+
+  /**
+   * The number of entries of the collection.
+   */
+  unsigned int n_entries;
+
+  /**
+   * For each entry and direction (in this order), the index of the stored
+   * pair of 1D matrices.
+   */
+  std::vector<unsigned int> indices;
+
+  /**
+   * The number of rows of each stored pair of 1D matrices.
+   */
+  std::vector<unsigned int> n_rows;
+
+  /**
+   * Offsets of the stored pairs into @p eigenvalues.
+   */
+  std::vector<std::size_t> vector_ptr;
+
+  /**
+   * Offsets of the stored pairs into @p mass_matrices,
+   * @p derivative_matrices, and @p eigenvectors.
+   */
+  std::vector<std::size_t> matrix_ptr;
+
+  /**
+   * The stored 1D mass matrices, row by row.
+   */
+  AlignedVector<Number> mass_matrices;
+
+  /**
+   * The stored 1D derivative matrices, row by row.
+   */
+  AlignedVector<Number> derivative_matrices;
+
+  /**
+   * The generalized eigenvalues of the stored pairs.
+   */
+  AlignedVector<Number> eigenvalues;
+
+  /**
+   * The generalized eigenvectors of the stored pairs, stored column-wise in
+   * row-major matrices.
+   */
+  AlignedVector<Number> eigenvectors;
+
+  /**
+   * Thread-local scratch data for vmult() and apply_inverse().
+   */
+  mutable Threads::ThreadLocalStorage<AlignedVector<Number>> tmp_array;
+};
+
 /*----------------------- Inline functions ----------------------------------*/
 
 #ifndef DOXYGEN
@@ -452,6 +680,251 @@ namespace internal
       for (unsigned int i = 0; i < n_rows; ++i, ++eigenvalues)
         *eigenvalues = deriv_copy.eigenvalue(i).real();
     }
+
+
+
+    /**
+     * Access to the individual lanes of the number type, used to run the
+     * LAPACK-based spectral_assembly() lane by lane for vectorized types.
+     */
+    template <typename Number>
+    struct LaneAccess
+    {
+      using scalar_type = Number;
+
+      static constexpr unsigned int n_lanes = 1;
+
+      static scalar_type
+      get(const Number &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static void
+      set(Number &value, const unsigned int, const scalar_type entry)
+      {
+        value = entry;
+      }
+    };
+
+
+
+    template <typename Number>
+    struct LaneAccess<VectorizedArray<Number>>
+    {
+      using scalar_type = Number;
+
+      static constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+
+      static scalar_type
+      get(const VectorizedArray<Number> &value, const unsigned int lane)
+      {
+        return value[lane];
+      }
+
+      static void
+      set(VectorizedArray<Number> &value,
+          const unsigned int       lane,
+          const scalar_type        entry)
+      {
+        value[lane] = entry;
+      }
+    };
+
+
+
+    /**
+     * Same as spectral_assembly() for square matrices of size @p n_rows,
+     * but for a number type that can also be a VectorizedArray, in which
+     * case every lane is decomposed separately.
+     */
+    template <typename Number>
+    void
+    spectral_assembly_by_lane(const Number *     mass_matrix,
+                              const Number *     derivative_matrix,
+                              const unsigned int n_rows,
+                              Number *           eigenvalues,
+                              Number *           eigenvectors)
+    {
+      using Lanes        = LaneAccess<Number>;
+      using scalar_type  = typename Lanes::scalar_type;
+      const unsigned int nm = n_rows * n_rows;
+
+      std::vector<scalar_type> mass_lane(nm), derivative_lane(nm);
+      std::vector<scalar_type> eigenvalues_lane(n_rows), eigenvectors_lane(nm);
+      for (unsigned int lane = 0; lane < Lanes::n_lanes; ++lane)
+        {
+          for (unsigned int i = 0; i < nm; ++i)
+            {
+              mass_lane[i]       = Lanes::get(mass_matrix[i], lane);
+              derivative_lane[i] = Lanes::get(derivative_matrix[i], lane);
+            }
+          spectral_assembly<scalar_type>(mass_lane.data(),
+                                         derivative_lane.data(),
+                                         n_rows,
+                                         n_rows,
+                                         eigenvalues_lane.data(),
+                                         eigenvectors_lane.data());
+          for (unsigned int i = 0; i < n_rows; ++i)
+            Lanes::set(eigenvalues[i], lane, eigenvalues_lane[i]);
+          for (unsigned int i = 0; i < nm; ++i)
+            Lanes::set(eigenvectors[i], lane, eigenvectors_lane[i]);
+        }
+    }
+
+
+
+    /**
+     * Matrix-vector product with the tensor product matrix described in the
+     * main documentation of TensorProductMatrixSymmetricSum, given the 1D
+     * mass and derivative matrices of size @p n_rows (stored row-wise) in
+     * each direction. The array @p tmp is used as scratch storage.
+     */
+    template <int n_rows_1d, std::size_t dim, typename Number>
+    void
+    vmult(Number *                               dst,
+          const Number *                         src,
+          AlignedVector<Number> &                tmp,
+          const unsigned int                     n_rows,
+          const std::array<const Number *, dim> &mass_matrix,
+          const std::array<const Number *, dim> &derivative_matrix)
+    {
+      const unsigned int n = Utilities::fixed_power<dim>(
+        n_rows_1d > 0 ? static_cast<unsigned int>(n_rows_1d) : n_rows);
+      tmp.resize_fast(n * 2);
+      constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       kernel_size,
+                                       kernel_size,
+                                       Number>
+              eval(AlignedVector<Number>{},
+             AlignedVector<Number>{},
+             AlignedVector<Number>{},
+             n_rows,
+             n_rows);
+      Number *t = tmp.begin();
+
+      if (dim == 1)
+        {
+          const Number *A = derivative_matrix[0];
+          eval.template apply<0, false, false>(A, src, dst);
+        }
+
+      else if (dim == 2)
+        {
+          const Number *A0 = derivative_matrix[0];
+          const Number *M0 = mass_matrix[0];
+          const Number *A1 = derivative_matrix[1];
+          const Number *M1 = mass_matrix[1];
+          eval.template apply<0, false, false>(M0, src, t);
+          eval.template apply<1, false, false>(A1, t, dst);
+          eval.template apply<0, false, false>(A0, src, t);
+          eval.template apply<1, false, true>(M1, t, dst);
+        }
+
+      else if (dim == 3)
+        {
+          const Number *A0 = derivative_matrix[0];
+          const Number *M0 = mass_matrix[0];
+          const Number *A1 = derivative_matrix[1];
+          const Number *M1 = mass_matrix[1];
+          const Number *A2 = derivative_matrix[2];
+          const Number *M2 = mass_matrix[2];
+          eval.template apply<0, false, false>(M0, src, t + n);
+          eval.template apply<1, false, false>(M1, t + n, t);
+          eval.template apply<2, false, false>(A2, t, dst);
+          eval.template apply<1, false, false>(A1, t + n, t);
+          eval.template apply<0, false, false>(A0, src, t + n);
+          eval.template apply<1, false, true>(M1, t + n, t);
+          eval.template apply<2, false, true>(M2, t, dst);
+        }
+
+      else
+        AssertThrow(false, ExcNotImplemented());
+    }
+
+
+
+    /**
+     * Application of the inverse of the tensor product matrix by the fast
+     * diagonalization method, given the generalized eigenvectors (stored
+     * columnwise in row-major matrices of size @p n_rows) and eigenvalues in
+     * each direction. The array @p tmp is used as scratch storage.
+     */
+    template <int n_rows_1d, std::size_t dim, typename Number>
+    void
+    apply_inverse(Number *                               dst,
+                  const Number *                         src,
+                  AlignedVector<Number> &                tmp,
+                  const unsigned int                     n_rows,
+                  const std::array<const Number *, dim> &eigenvectors,
+                  const std::array<const Number *, dim> &eigenvalues)
+    {
+      const unsigned int n =
+        n_rows_1d > 0 ? static_cast<unsigned int>(n_rows_1d) : n_rows;
+      tmp.resize_fast(Utilities::fixed_power<dim>(n));
+      constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       kernel_size,
+                                       kernel_size,
+                                       Number>
+              eval(AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             n,
+             n);
+      Number *t = tmp.begin();
+
+      // NOTE: dof_to_quad has to be interpreted as 'dof to eigenvalue index'
+      //       --> apply<.,true,.> (S,src,dst) calculates dst = S^T * src,
+      //       --> apply<.,false,.> (S,src,dst) calculates dst = S * src,
+      //       while the eigenvectors are stored column-wise in S, i.e.
+      //       rows correspond to dofs whereas columns to eigenvalue indices!
+      if (dim == 1)
+        {
+          const Number *S = eigenvectors[0];
+          eval.template apply<0, true, false>(S, src, t);
+          for (unsigned int i = 0; i < n; ++i)
+            t[i] /= eigenvalues[0][i];
+          eval.template apply<0, false, false>(S, t, dst);
+        }
+
+      else if (dim == 2)
+        {
+          const Number *S0 = eigenvectors[0];
+          const Number *S1 = eigenvectors[1];
+          eval.template apply<0, true, false>(S0, src, t);
+          eval.template apply<1, true, false>(S1, t, dst);
+          for (unsigned int i1 = 0, c = 0; i1 < n; ++i1)
+            for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
+              dst[c] /= (eigenvalues[1][i1] + eigenvalues[0][i0]);
+          eval.template apply<0, false, false>(S0, dst, t);
+          eval.template apply<1, false, false>(S1, t, dst);
+        }
+
+      else if (dim == 3)
+        {
+          const Number *S0 = eigenvectors[0];
+          const Number *S1 = eigenvectors[1];
+          const Number *S2 = eigenvectors[2];
+          eval.template apply<0, true, false>(S0, src, t);
+          eval.template apply<1, true, false>(S1, t, dst);
+          eval.template apply<2, true, false>(S2, dst, t);
+          for (unsigned int i2 = 0, c = 0; i2 < n; ++i2)
+            for (unsigned int i1 = 0; i1 < n; ++i1)
+              for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
+                t[c] /= (eigenvalues[2][i2] + eigenvalues[1][i1] +
+                         eigenvalues[0][i0]);
+          eval.template apply<0, false, false>(S0, t, dst);
+          eval.template apply<1, false, false>(S1, dst, t);
+          eval.template apply<2, false, false>(S2, t, dst);
+        }
+
+      else
+        Assert(false, ExcNotImplemented());
+    }
   } // namespace TensorProductMatrix
 } // namespace internal
 
@@ -489,61 +962,21 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
   AssertDimension(dst_view.size(), this->m());
   AssertDimension(src_view.size(), this->n());
   std::lock_guard<std::mutex> lock(this->mutex);
-  const unsigned int          n = Utilities::fixed_power<dim>(
-    n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size());
-  tmp_array.resize_fast(n * 2);
-  constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
-  internal::EvaluatorTensorProduct<internal::evaluate_general,
-                                   dim,
-                                   kernel_size,
-                                   kernel_size,
-                                   Number>
-                eval(AlignedVector<Number>{},
-         AlignedVector<Number>{},
-         AlignedVector<Number>{},
-         mass_matrix[0].n_rows(),
-         mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
-  const Number *src = src_view.begin();
-  Number *      dst = dst_view.data();
-
-  if (dim == 1)
-    {
-      const Number *A = &derivative_matrix[0](0, 0);
-      eval.template apply<0, false, false>(A, src, dst);
-    }
-
-  else if (dim == 2)
-    {
-      const Number *A0 = &derivative_matrix[0](0, 0);
-      const Number *M0 = &mass_matrix[0](0, 0);
-      const Number *A1 = &derivative_matrix[1](0, 0);
-      const Number *M1 = &mass_matrix[1](0, 0);
-      eval.template apply<0, false, false>(M0, src, t);
-      eval.template apply<1, false, false>(A1, t, dst);
-      eval.template apply<0, false, false>(A0, src, t);
-      eval.template apply<1, false, true>(M1, t, dst);
-    }
 
-  else if (dim == 3)
+  std::array<const Number *, dim> mass_matrices;
+  std::array<const Number *, dim> derivative_matrices;
+  for (unsigned int d = 0; d < dim; ++d)
     {
-      const Number *A0 = &derivative_matrix[0](0, 0);
-      const Number *M0 = &mass_matrix[0](0, 0);
-      const Number *A1 = &derivative_matrix[1](0, 0);
-      const Number *M1 = &mass_matrix[1](0, 0);
-      const Number *A2 = &derivative_matrix[2](0, 0);
-      const Number *M2 = &mass_matrix[2](0, 0);
-      eval.template apply<0, false, false>(M0, src, t + n);
-      eval.template apply<1, false, false>(M1, t + n, t);
-      eval.template apply<2, false, false>(A2, t, dst);
-      eval.template apply<1, false, false>(A1, t + n, t);
-      eval.template apply<0, false, false>(A0, src, t + n);
-      eval.template apply<1, false, true>(M1, t + n, t);
-      eval.template apply<2, false, true>(M2, t, dst);
+      mass_matrices[d]       = &mass_matrix[d](0, 0);
+      derivative_matrices[d] = &derivative_matrix[d](0, 0);
     }
 
-  else
-    AssertThrow(false, ExcNotImplemented());
+  internal::TensorProductMatrix::vmult<n_rows_1d>(dst_view.data(),
+                                                  src_view.data(),
+                                                  tmp_array,
+                                                  mass_matrix[0].n_rows(),
+                                                  mass_matrices,
+                                                  derivative_matrices);
 }
 
 
@@ -557,70 +990,22 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
   AssertDimension(dst_view.size(), this->n());
   AssertDimension(src_view.size(), this->m());
   std::lock_guard<std::mutex> lock(this->mutex);
-  const unsigned int n = n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size();
-  tmp_array.resize_fast(Utilities::fixed_power<dim>(n));
-  constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
-  internal::EvaluatorTensorProduct<internal::evaluate_general,
-                                   dim,
-                                   kernel_size,
-                                   kernel_size,
-                                   Number>
-                eval(AlignedVector<Number>(),
-         AlignedVector<Number>(),
-         AlignedVector<Number>(),
-         mass_matrix[0].n_rows(),
-         mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
-  const Number *src = src_view.data();
-  Number *      dst = dst_view.data();
-
-  // NOTE: dof_to_quad has to be interpreted as 'dof to eigenvalue index'
-  //       --> apply<.,true,.> (S,src,dst) calculates dst = S^T * src,
-  //       --> apply<.,false,.> (S,src,dst) calculates dst = S * src,
-  //       while the eigenvectors are stored column-wise in S, i.e.
-  //       rows correspond to dofs whereas columns to eigenvalue indices!
-  if (dim == 1)
-    {
-      const Number *S = &eigenvectors[0](0, 0);
-      eval.template apply<0, true, false>(S, src, t);
-      for (unsigned int i = 0; i < n; ++i)
-        t[i] /= eigenvalues[0][i];
-      eval.template apply<0, false, false>(S, t, dst);
-    }
 
-  else if (dim == 2)
+  std::array<const Number *, dim> eigenvector_matrices;
+  std::array<const Number *, dim> eigenvalue_arrays;
+  for (unsigned int d = 0; d < dim; ++d)
     {
-      const Number *S0 = &(eigenvectors[0](0, 0));
-      const Number *S1 = &(eigenvectors[1](0, 0));
-      eval.template apply<0, true, false>(S0, src, t);
-      eval.template apply<1, true, false>(S1, t, dst);
-      for (unsigned int i1 = 0, c = 0; i1 < n; ++i1)
-        for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
-          dst[c] /= (eigenvalues[1][i1] + eigenvalues[0][i0]);
-      eval.template apply<0, false, false>(S0, dst, t);
-      eval.template apply<1, false, false>(S1, t, dst);
+      eigenvector_matrices[d] = &eigenvectors[d](0, 0);
+      eigenvalue_arrays[d]    = eigenvalues[d].begin();
     }
 
-  else if (dim == 3)
-    {
-      const Number *S0 = &eigenvectors[0](0, 0);
-      const Number *S1 = &eigenvectors[1](0, 0);
-      const Number *S2 = &eigenvectors[2](0, 0);
-      eval.template apply<0, true, false>(S0, src, t);
-      eval.template apply<1, true, false>(S1, t, dst);
-      eval.template apply<2, true, false>(S2, dst, t);
-      for (unsigned int i2 = 0, c = 0; i2 < n; ++i2)
-        for (unsigned int i1 = 0; i1 < n; ++i1)
-          for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
-            t[c] /=
-              (eigenvalues[2][i2] + eigenvalues[1][i1] + eigenvalues[0][i0]);
-      eval.template apply<0, false, false>(S0, t, dst);
-      eval.template apply<1, false, false>(S1, dst, t);
-      eval.template apply<2, false, false>(S2, t, dst);
-    }
-
-  else
-    Assert(false, ExcNotImplemented());
+  internal::TensorProductMatrix::apply_inverse<n_rows_1d>(
+    dst_view.data(),
+    src_view.data(),
+    tmp_array,
+    n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size(),
+    eigenvector_matrices,
+    eigenvalue_arrays);
 }
 
 
@@ -901,6 +1286,334 @@ TensorProductMatrixSymmetricSum<dim, VectorizedArray<Number>, n_rows_1d>::
 
 
 
+//------------------ TensorProductMatrixSymmetricSumCollection ----------------
+
+template <int dim, typename Number, int n_rows_1d>
+inline TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  AdditionalData::AdditionalData(const bool compress_matrices)
+  : compress_matrices(compress_matrices)
+{}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  TensorProductMatrixSymmetricSumCollection(
+    const AdditionalData &additional_data)
+  : compress_matrices(additional_data.compress_matrices)
+  , n_entries(0)
+{}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::reserve(
+  const unsigned int size)
+{
+  n_entries = size;
+  inserted_mass_matrices.clear();
+  inserted_derivative_matrices.clear();
+  inserted_mass_matrices.resize(size);
+  inserted_derivative_matrices.resize(size);
+
+  indices.clear();
+  n_rows.clear();
+  vector_ptr.clear();
+  matrix_ptr.clear();
+  mass_matrices.clear();
+  derivative_matrices.clear();
+  eigenvalues.clear();
+  eigenvectors.clear();
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::insert(
+  const unsigned int                       index,
+  const std::array<Table<2, Number>, dim> &mass_matrices,
+  const std::array<Table<2, Number>, dim> &derivative_matrices)
+{
+  AssertIndexRange(index, inserted_mass_matrices.size());
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      Assert(n_rows_1d == -1 ||
+               (n_rows_1d > 0 && static_cast<unsigned int>(n_rows_1d) ==
+                                   mass_matrices[d].n_rows()),
+             ExcDimensionMismatch(n_rows_1d, mass_matrices[d].n_rows()));
+      AssertDimension(mass_matrices[d].n_rows(), mass_matrices[d].n_cols());
+      AssertDimension(mass_matrices[d].n_rows(),
+                      derivative_matrices[d].n_rows());
+      AssertDimension(mass_matrices[d].n_rows(),
+                      derivative_matrices[d].n_cols());
+      AssertDimension(mass_matrices[d].n_rows(), mass_matrices[0].n_rows());
+    }
+
+  inserted_mass_matrices[index]       = mass_matrices;
+  inserted_derivative_matrices[index] = derivative_matrices;
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::finalize()
+{
+  AssertDimension(inserted_mass_matrices.size(), n_entries);
+
+  using Lanes       = internal::TensorProductMatrix::LaneAccess<Number>;
+  using scalar_type = typename Lanes::scalar_type;
+
+  // identify the pairs of 1D matrices to be stored by the entry and
+  // direction they were inserted with. For the compression, the pairs are
+  // ordered lexicographically, where entries that agree up to round-off
+  // relative to the largest entry of the matrix are considered equal
+  using Key = std::pair<unsigned int, unsigned int>;
+
+  const auto compare_matrices = [](const Table<2, Number> &a,
+                                   const Table<2, Number> &b) -> int {
+    if (a.n_rows() != b.n_rows())
+      return a.n_rows() < b.n_rows() ? -1 : 1;
+
+    const std::size_t n_elements = a.n_elements();
+    const Number *    a_ptr      = n_elements > 0 ? &a(0, 0) : nullptr;
+    const Number *    b_ptr      = n_elements > 0 ? &b(0, 0) : nullptr;
+    for (unsigned int lane = 0; lane < Lanes::n_lanes; ++lane)
+      {
+        scalar_type scale = scalar_type();
+        for (std::size_t i = 0; i < n_elements; ++i)
+          scale = std::max(scale, std::abs(Lanes::get(a_ptr[i], lane)));
+        const scalar_type tolerance =
+          scale * 100 * std::numeric_limits<scalar_type>::epsilon();
+
+        for (std::size_t i = 0; i < n_elements; ++i)
+          {
+            const scalar_type a_entry = Lanes::get(a_ptr[i], lane);
+            const scalar_type b_entry = Lanes::get(b_ptr[i], lane);
+            if (a_entry < b_entry - tolerance)
+              return -1;
+            else if (b_entry < a_entry - tolerance)
+              return 1;
+          }
+      }
+    return 0;
+  };
+
+  const auto key_is_less = [&](const Key &a, const Key &b) {
+    const int mass_comparison =
+      compare_matrices(inserted_mass_matrices[a.first][a.second],
+                       inserted_mass_matrices[b.first][b.second]);
+    if (mass_comparison != 0)
+      return mass_comparison < 0;
+    return compare_matrices(
+             inserted_derivative_matrices[a.first][a.second],
+             inserted_derivative_matrices[b.first][b.second]) < 0;
+  };
+
+  std::map<Key, unsigned int, decltype(key_is_less)> unique_pairs(
+    key_is_less);
+  std::vector<Key> stored_pairs;
+
+  indices.resize(n_entries * dim);
+  for (unsigned int i = 0; i < n_entries; ++i)
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        const Key key(i, d);
+        if (compress_matrices)
+          {
+            const auto entry =
+              unique_pairs.insert(std::make_pair(key, stored_pairs.size()));
+            if (entry.second)
+              stored_pairs.push_back(key);
+            indices[i * dim + d] = entry.first->second;
+          }
+        else
+          {
+            indices[i * dim + d] = stored_pairs.size();
+            stored_pairs.push_back(key);
+          }
+      }
+
+  // set up the storage sequentially and compute the generalized eigenvalues
+  // and eigenvectors of the stored pairs in parallel
+  n_rows.resize(stored_pairs.size());
+  vector_ptr.resize(stored_pairs.size() + 1);
+  matrix_ptr.resize(stored_pairs.size() + 1);
+  vector_ptr[0] = 0;
+  matrix_ptr[0] = 0;
+  for (unsigned int p = 0; p < stored_pairs.size(); ++p)
+    {
+      n_rows[p] = inserted_mass_matrices[stored_pairs[p].first]
+                                        [stored_pairs[p].second]
+                                          .n_rows();
+      vector_ptr[p + 1] = vector_ptr[p] + n_rows[p];
+      matrix_ptr[p + 1] =
+        matrix_ptr[p] + static_cast<std::size_t>(n_rows[p]) * n_rows[p];
+    }
+
+  mass_matrices.resize_fast(matrix_ptr.back());
+  derivative_matrices.resize_fast(matrix_ptr.back());
+  eigenvectors.resize_fast(matrix_ptr.back());
+  eigenvalues.resize_fast(vector_ptr.back());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(stored_pairs.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int p = begin; p < end; ++p)
+        {
+          const unsigned int n_entries_1d =
+            static_cast<unsigned int>(matrix_ptr[p + 1] - matrix_ptr[p]);
+          if (n_entries_1d == 0)
+            continue;
+
+          const Table<2, Number> &mass =
+            inserted_mass_matrices[stored_pairs[p].first]
+                                  [stored_pairs[p].second];
+          const Table<2, Number> &derivative =
+            inserted_derivative_matrices[stored_pairs[p].first]
+                                        [stored_pairs[p].second];
+          std::copy(&mass(0, 0),
+                    &mass(0, 0) + n_entries_1d,
+                    mass_matrices.begin() + matrix_ptr[p]);
+          std::copy(&derivative(0, 0),
+                    &derivative(0, 0) + n_entries_1d,
+                    derivative_matrices.begin() + matrix_ptr[p]);
+
+          internal::TensorProductMatrix::spectral_assembly_by_lane(
+            mass_matrices.begin() + matrix_ptr[p],
+            derivative_matrices.begin() + matrix_ptr[p],
+            n_rows[p],
+            eigenvalues.begin() + vector_ptr[p],
+            eigenvectors.begin() + matrix_ptr[p]);
+        }
+    },
+    4);
+
+  inserted_mass_matrices.clear();
+  inserted_mass_matrices.shrink_to_fit();
+  inserted_derivative_matrices.clear();
+  inserted_derivative_matrices.shrink_to_fit();
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::vmult(
+  const unsigned int             index,
+  const ArrayView<Number> &      dst,
+  const ArrayView<const Number> &src) const
+{
+  AssertIndexRange(index, n_entries);
+  Assert(indices.size() == n_entries * dim,
+         ExcMessage("You need to call finalize() before using this class."));
+  AssertDimension(dst.size(), m(index));
+  AssertDimension(src.size(), m(index));
+
+  std::array<const Number *, dim> mass;
+  std::array<const Number *, dim> derivative;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      const unsigned int p = indices[index * dim + d];
+      mass[d]              = mass_matrices.begin() + matrix_ptr[p];
+      derivative[d]        = derivative_matrices.begin() + matrix_ptr[p];
+    }
+
+  internal::TensorProductMatrix::vmult<n_rows_1d>(
+    dst.data(),
+    src.data(),
+    tmp_array.get(),
+    n_rows[indices[index * dim]],
+    mass,
+    derivative);
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  apply_inverse(const unsigned int             index,
+                const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src) const
+{
+  AssertIndexRange(index, n_entries);
+  Assert(indices.size() == n_entries * dim,
+         ExcMessage("You need to call finalize() before using this class."));
+  AssertDimension(dst.size(), m(index));
+  AssertDimension(src.size(), m(index));
+
+  std::array<const Number *, dim> eigenvector_matrices;
+  std::array<const Number *, dim> eigenvalue_arrays;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      const unsigned int p    = indices[index * dim + d];
+      eigenvector_matrices[d] = eigenvectors.begin() + matrix_ptr[p];
+      eigenvalue_arrays[d]    = eigenvalues.begin() + vector_ptr[p];
+    }
+
+  internal::TensorProductMatrix::apply_inverse<n_rows_1d>(
+    dst.data(),
+    src.data(),
+    tmp_array.get(),
+    n_rows[indices[index * dim]],
+    eigenvector_matrices,
+    eigenvalue_arrays);
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline unsigned int
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::size() const
+{
+  return n_entries;
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline unsigned int
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::m(
+  const unsigned int index) const
+{
+  AssertIndexRange(index, n_entries);
+  Assert(indices.size() == n_entries * dim,
+         ExcMessage("You need to call finalize() before using this class."));
+  return Utilities::fixed_power<dim>(n_rows[indices[index * dim]]);
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline std::size_t
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  storage_size() const
+{
+  return n_rows.size();
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline std::size_t
+TensorProductMatrixSymmetricSumCollection<dim, Number, n_rows_1d>::
+  memory_consumption() const
+{
+  return MemoryConsumption::memory_consumption(indices) +
+         MemoryConsumption::memory_consumption(n_rows) +
+         MemoryConsumption::memory_consumption(vector_ptr) +
+         MemoryConsumption::memory_consumption(matrix_ptr) +
+         mass_matrices.memory_consumption() +
+         derivative_matrices.memory_consumption() +
+         eigenvalues.memory_consumption() + eigenvectors.memory_consumption();
+}
+
+
+
 #endif
 
 DEAL_II_NAMESPACE_CLOSE
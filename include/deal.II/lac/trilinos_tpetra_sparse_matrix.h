@@ -0,0 +1,236 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_trilinos_tpetra_sparse_matrix_h
+#define dealii_trilinos_tpetra_sparse_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#if defined(DEAL_II_TRILINOS_WITH_TPETRA) && defined(DEAL_II_WITH_MPI)
+
+#  include <deal.II/base/index_set.h>
+#  include <deal.II/base/subscriptor.h>
+
+#  include <deal.II/lac/full_matrix.h>
+#  include <deal.II/lac/trilinos_tpetra_vector.h>
+#  include <deal.II/lac/vector_operation.h>
+
+#  include <Teuchos_RCP.hpp>
+#  include <Tpetra_CrsGraph.hpp>
+#  include <Tpetra_CrsMatrix.hpp>
+#  include <Tpetra_Export.hpp>
+#  include <Tpetra_Map.hpp>
+#  include <mpi.h>
+
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declaration
+#  ifndef DOXYGEN
+class DynamicSparsityPattern;
+#  endif
+
+namespace LinearAlgebra
+{
+  namespace TpetraWrappers
+  {
+    /**
+     * This class implements a wrapper to the Trilinos sparse matrix class
+     * Tpetra::CrsMatrix. In contrast to TrilinosWrappers::SparseMatrix, which
+     * is based on Epetra, the matrix values are stored in Kokkos views, so
+     * that the matrix can live in the memory space Tpetra was configured
+     * for (see the documentation of TpetraWrappers::Vector).
+     *
+     * The sparsity pattern is fixed when the matrix is initialized. Two
+     * matrices share it: one with an overlapping row distribution that
+     * contains all locally relevant rows, into which local contributions are
+     * written, and one with the locally owned rows, which is used for all
+     * other operations. compress() adds the contributions to rows owned by
+     * other processes into the owned matrix.
+     *
+     * Since the pattern is fixed, the add() functions only update existing
+     * entries. They do so with atomic operations and can therefore be called
+     * concurrently from several threads, e.g. directly from the workers of
+     * WorkStream::run() or MeshWorker::mesh_loop(), without a separate
+     * copier step.
+     *
+     * The underlying Tpetra::CrsMatrix is accessible through
+     * trilinos_rcp(), which can be passed to Ifpack2 or MueLu, e.g., via
+     * <tt>MueLu::CreateTpetraPreconditioner()</tt>.
+     *
+     * @ingroup TrilinosWrappers
+     * @ingroup Matrix1
+     */
+    template <typename Number>
+    class SparseMatrix : public Subscriptor
+    {
+    public:
+      /**
+       * Declare some of the standard types used in all containers.
+       */
+      using value_type = Number;
+      using size_type  = types::global_dof_index;
+
+      /**
+       * Type of the underlying Tpetra objects.
+       */
+      using MapType    = Tpetra::Map<int, types::global_dof_index>;
+      using GraphType  = Tpetra::CrsGraph<int, types::global_dof_index>;
+      using MatrixType = Tpetra::CrsMatrix<Number, int, size_type>;
+
+      /**
+       * Default constructor. Generates an empty matrix.
+       */
+      SparseMatrix() = default;
+
+      /**
+       * Initialize the matrix.
+       *
+       * @param locally_owned_rows The rows (and columns) owned by the
+       * current process.
+       * @param locally_relevant_rows The rows the current process writes
+       * into during assembly, i.e., usually the locally relevant degrees of
+       * freedom. This set must contain @p locally_owned_rows.
+       * @param sparsity_pattern A sparsity pattern that contains all entries
+       * of the rows in @p locally_relevant_rows that are written to by this
+       * process, and all entries of the locally owned rows written to by any
+       * process. This is what SparsityTools::distribute_sparsity_pattern()
+       * produces.
+       * @param communicator The MPI communicator.
+       */
+      void
+      reinit(const IndexSet &              locally_owned_rows,
+             const IndexSet &              locally_relevant_rows,
+             const DynamicSparsityPattern &sparsity_pattern,
+             const MPI_Comm &              communicator);
+
+      /**
+       * Set all entries of the matrix to zero, keeping the sparsity pattern.
+       * Only zero is allowed as argument.
+       */
+      SparseMatrix &
+      operator=(const Number d);
+
+      /**
+       * Add the array of values given by @p values in the given global
+       * matrix row at the columns specified by @p col_indices. The row must
+       * be one of the locally relevant rows, and all entries must be part of
+       * the sparsity pattern.
+       *
+       * This function is thread-safe, i.e., several threads may add to the
+       * matrix concurrently, even to the same entries.
+       */
+      void
+      add(const size_type  row,
+          const size_type  n_cols,
+          const size_type *col_indices,
+          const Number *   values);
+
+      /**
+       * Add all elements of the local matrix @p values to the rows and
+       * columns given by @p indices. This function is thread-safe.
+       */
+      void
+      add(const std::vector<size_type> &indices,
+          const FullMatrix<Number> &    values);
+
+      /**
+       * Communicate the contributions to rows owned by other processes and
+       * finalize the matrix, so that it can be used in matrix-vector
+       * products. Only VectorOperation::add is supported.
+       */
+      void
+      compress(const VectorOperation::values operation);
+
+      /**
+       * Return the number of rows of the matrix.
+       */
+      size_type
+      m() const;
+
+      /**
+       * Return the number of columns of the matrix.
+       */
+      size_type
+      n() const;
+
+      /**
+       * Matrix-vector multiplication: let <i>dst = M*src</i> with <i>M</i>
+       * being this matrix.
+       */
+      void
+      vmult(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Return a const reference to the underlying Tpetra matrix with the
+       * locally owned rows.
+       */
+      const MatrixType &
+      trilinos_matrix() const;
+
+      /**
+       * Return a reference-counted pointer to the underlying Tpetra matrix
+       * with the locally owned rows, e.g. for setting up Ifpack2 or MueLu
+       * preconditioners.
+       */
+      Teuchos::RCP<MatrixType>
+      trilinos_rcp() const;
+
+      /**
+       * Exception
+       */
+      DeclExceptionMsg(ExcNotInitialized,
+                       "The matrix has not been initialized with reinit().");
+
+    private:
+      /**
+       * Map of the locally owned rows, which is also used as domain and
+       * range map.
+       */
+      Teuchos::RCP<const MapType> owned_map;
+
+      /**
+       * Map of the locally relevant rows.
+       */
+      Teuchos::RCP<const MapType> relevant_map;
+
+      /**
+       * Matrix with the locally relevant rows into which the local
+       * contributions are written.
+       */
+      Teuchos::RCP<MatrixType> relevant_matrix;
+
+      /**
+       * Matrix with the locally owned rows.
+       */
+      Teuchos::RCP<MatrixType> owned_matrix;
+
+      /**
+       * Export object to move the contributions from the relevant to the
+       * owned rows.
+       */
+      Teuchos::RCP<const Tpetra::Export<int, types::global_dof_index>>
+        exporter;
+    };
+  } // namespace TpetraWrappers
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
+
+#endif
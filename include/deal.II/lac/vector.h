@@ -35,6 +35,7 @@
 #include <initializer_list>
 #include <iosfwd>
 #include <iterator>
+#include <string>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -879,6 +880,37 @@ public:
   void
   block_read(std::istream &in);
 
+  /**
+   * Make this vector use the entries stored by block_write() in the file
+   * @p filename, starting at byte @p offset of the file, in place instead
+   * of reading them into memory. Only the header of the stored vector is
+   * parsed; the entries are accessed through a memory mapping as described
+   * in AlignedVector::map_file(), i.e., they are loaded by the operating
+   * system upon first access. This allows working with vectors that are too
+   * large for the main memory, as long as they are traversed in a mostly
+   * sequential way.
+   *
+   * If @p write_through is true, changes to the vector entries are written
+   * to the file. Otherwise, the file is not modified. Note that functions
+   * such as reinit() do not reallocate the memory if the size does not
+   * grow, so that zeroing the vector with <tt>write_through==true</tt> also
+   * zeroes the file.
+   *
+   * The return value is the position in the file just past the mapped
+   * vector, which allows mapping several vectors that have been written
+   * one after the other into the same file.
+   *
+   * The entries can only be mapped if they are aligned to the alignment of
+   * @p Number in the file, which block_write() ensures for streams that
+   * report their position, such as files. Vectors that were written by
+   * older versions of deal.II need to be read with block_read() and
+   * written again.
+   */
+  std::size_t
+  map_file(const std::string &filename,
+           const std::size_t  offset        = 0,
+           const bool         write_through = false);
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization using the [BOOST serialization
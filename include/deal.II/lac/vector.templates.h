@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/memory_tracker.h>
 #include <deal.II/base/numbers.h>
 #include <deal.II/base/template_constraints.h>
 
@@ -39,10 +40,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <string>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -235,6 +239,7 @@ template <typename Number>
 inline void
 Vector<Number>::grow_or_shrink(const size_type n)
 {
+  MemoryTracker::Scope memory_scope(MemoryTracker::vector);
   values.resize(n);
 
   maybe_reset_thread_partitioner();
@@ -874,9 +879,17 @@ Vector<Number>::block_write(std::ostream &out) const
   // unsigned long long int that is at least 64 bits to be able to output it on
   // all platforms, since std::uint64_t is not in C.
   const unsigned long long int sz = size();
-  char                         buf[16];
+  char                         buf[64];
 
   std::sprintf(buf, "%llu", sz);
+
+  // pad the line with the size by spaces, such that the entries start at a
+  // position of the stream that is a multiple of the alignment of Number. If
+  // the stream is a file, map_file() can then use the entries in place.
+  const std::streamoff position = out.tellp();
+  if (position >= 0)
+    while ((position + std::strlen(buf) + 2) % alignof(Number) != 0)
+      std::strcat(buf, " ");
   std::strcat(buf, "\n[");
 
   out.write(buf, std::strlen(buf));
@@ -899,13 +912,9 @@ Vector<Number>::block_read(std::istream &in)
 {
   AssertThrow(in, ExcIO());
 
-  size_type sz;
-
-  char buf[16];
-
-
-  in.getline(buf, 16, '\n');
-  sz = std::atoi(buf);
+  std::string line;
+  std::getline(in, line);
+  const size_type sz = std::strtoull(line.c_str(), nullptr, 10);
 
   // fast initialization, since the
   // data elements are overwritten anyway
@@ -927,6 +936,47 @@ Vector<Number>::block_read(std::istream &in)
 
 
 
+template <typename Number>
+std::size_t
+Vector<Number>::map_file(const std::string &filename,
+                         const std::size_t  offset,
+                         const bool         write_through)
+{
+  std::ifstream in(filename, std::ios::binary);
+  AssertThrow(in, ExcFileNotOpen(filename));
+  in.seekg(offset);
+
+  // parse the header written by block_write()
+  std::string line;
+  std::getline(in, line);
+  const size_type sz = std::strtoull(line.c_str(), nullptr, 10);
+
+  char c = 0;
+  in.read(&c, 1);
+  AssertThrow(in && c == '[', ExcIO());
+  const std::size_t data_offset = in.tellg();
+
+  // check the closing bracket, which also makes sure that the file contains
+  // all entries
+  const std::size_t end_offset = data_offset + sz * sizeof(Number);
+  in.seekg(end_offset);
+  in.read(&c, 1);
+  AssertThrow(in && c == ']', ExcIO());
+  in.close();
+
+  AssertThrow(data_offset % alignof(Number) == 0,
+              ExcMessage("The entries of the vector in the file " + filename +
+                         " are not aligned and cannot be mapped into memory. "
+                         "Read the vector with block_read() and write it to "
+                         "a file with block_write() again."));
+  values.map_file(filename, data_offset, sz, write_through);
+  maybe_reset_thread_partitioner();
+
+  return end_offset + 1;
+}
+
+
+
 template <typename Number>
 IndexSet
 Vector<Number>::locally_owned_elements() const
@@ -967,6 +1017,8 @@ Vector<Number>::do_reinit(const size_type new_size,
                           const bool      omit_zeroing_entries,
                           const bool      reset_partitioner)
 {
+  MemoryTracker::Scope memory_scope(MemoryTracker::vector);
+
   if (new_size <= size())
     {
       if (new_size == 0)
@@ -21,11 +21,15 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/vector.h>
 
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <list>
 #include <memory>
 #include <vector>
 
@@ -308,6 +312,19 @@ public:
  * GrowingVectorMemory object whenever needed without the performance penalty
  * of creating a new memory pool every time. A drawback of this policy is that
  * vectors once allocated are only released at the end of the program run.
+ *
+ * The pool is split into one pool per thread: alloc() takes vectors from the
+ * pool of the calling thread and only needs to lock that pool, such that
+ * solvers running concurrently on different threads do not compete for a
+ * lock. Since vectors are usually initialized by the thread that allocated
+ * them, this also keeps their memory close to that thread on systems with
+ * first-touch memory placement. A vector may be released by a different
+ * thread than the one that allocated it, in which case free() looks for it in
+ * the pools of the other threads, too.
+ *
+ * The use of the pools can be monitored by get_statistics(), and reserve()
+ * allows to fill the pool of the calling thread with initialized vectors
+ * before a solver is run.
  */
 template <typename VectorType = dealii::Vector<double>>
 class GrowingVectorMemory : public VectorMemory<VectorType>
@@ -380,6 +397,66 @@ public:
   static void
   release_unused_memory();
 
+  /**
+   * Make sure that the pool of the calling thread holds at least
+   * @p n_vectors vectors that are not in use, for example the number of
+   * auxiliary vectors used by a solver that is run on this thread
+   * afterwards. Vectors that need to be added to the pool are passed to
+   * @p initializer, if given, which can set them to the size and layout of
+   * the vectors the solver will request, such as in
+   * @code
+   *   GrowingVectorMemory<Vector<double>>::reserve(
+   *     5, [&](Vector<double> &v) { v.reinit(solution); });
+   * @endcode
+   */
+  static void
+  reserve(const size_type                          n_vectors,
+          const std::function<void(VectorType &)> &initializer =
+            std::function<void(VectorType &)>());
+
+  /**
+   * A structure collecting statistics on the use of the pools of all
+   * threads, as returned by get_statistics().
+   */
+  struct Statistics
+  {
+    /**
+     * Number of calls to alloc().
+     */
+    size_type n_allocations;
+
+    /**
+     * Number of calls to alloc() that could be served by a vector already
+     * stored in the pool of the calling thread.
+     */
+    size_type n_reuses;
+
+    /**
+     * Number of vectors stored in the pools, i.e., the high-water mark of the
+     * number of vectors in use since the last call to
+     * release_unused_memory(), summed over all threads.
+     */
+    size_type n_vectors;
+
+    /**
+     * Number of vectors currently in use.
+     */
+    size_type n_vectors_in_use;
+
+    /**
+     * Return the fraction of calls to alloc() that could be served from a
+     * pool, or one if alloc() has not been called yet.
+     */
+    double
+    hit_rate() const;
+  };
+
+  /**
+   * Return statistics on the use of the pools for the current vector type.
+   */
+  static Statistics
+  get_statistics();
+
   /**
    * Memory consumed by this class and all currently allocated vectors.
    */
@@ -399,8 +476,8 @@ private:
    * The class providing the actual storage for the memory pool.
    *
    * This is where the actual storage for GrowingVectorMemory is provided.
-   * Only one of these pools is used for each vector type, thus allocating all
-   * vectors from the same storage.
+   * There is one of these pools for each vector type and thread, which
+   * is shared by all GrowingVectorMemory objects used on that thread.
    */
   struct Pool
   {
@@ -424,25 +501,50 @@ private:
      * Pointer to the storage object
      */
     std::vector<entry_type> *data;
+
+    /**
+     * Mutex to synchronize access to the data of this pool. It is normally
+     * only locked by the thread owning the pool, but other threads access
+     * the pool when they release a vector allocated from it, or collect
+     * statistics.
+     */
+    Threads::Mutex mutex;
+
+    /**
+     * Number of calls to alloc() served by this pool.
+     */
+    size_type n_allocations;
+
+    /**
+     * Number of calls to alloc() served by a vector already in this pool.
+     */
+    size_type n_reuses;
   };
 
   /**
-   * Return an array of allocated vectors.
+   * Return the pool of the calling thread, creating it if necessary.
    */
   static Pool &
   get_pool();
 
+  /**
+   * Return the list of the pools of all threads. Access to the list needs
+   * to be synchronized via #mutex.
+   */
+  static std::list<Pool> &
+  get_all_pools();
+
   /**
    * Overall number of allocations. Only used for bookkeeping and to generate
    * output at the end of an object's lifetime.
    */
-  size_type total_alloc;
+  std::atomic<size_type> total_alloc;
 
   /**
    * Number of vectors currently allocated in this object; used for detecting
    * memory leaks.
    */
-  size_type current_alloc;
+  std::atomic<size_type> current_alloc;
 
   /**
    * A flag controlling the logging of statistics by the destructor.
@@ -450,8 +552,7 @@ private:
   bool log_statistics;
 
   /**
-   * Mutex to synchronize access to internal data of this object from multiple
-   * threads.
+   * Mutex to synchronize access to the list of pools from multiple threads.
    */
   static Threads::Mutex mutex;
 };
@@ -23,17 +23,39 @@
 
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
 
+template <typename VectorType>
+std::list<typename GrowingVectorMemory<VectorType>::Pool> &
+GrowingVectorMemory<VectorType>::get_all_pools()
+{
+  static std::list<GrowingVectorMemory<VectorType>::Pool> pools;
+  return pools;
+}
+
+
+
 template <typename VectorType>
 typename GrowingVectorMemory<VectorType>::Pool &
 GrowingVectorMemory<VectorType>::get_pool()
 {
-  static GrowingVectorMemory<VectorType>::Pool pool;
-  return pool;
+  static Threads::ThreadLocalStorage<Pool *> thread_pool(nullptr);
+
+  Pool *&pool = thread_pool.get();
+  if (pool == nullptr)
+    {
+      // first use of the pools on this thread: add a pool to the list. the
+      // elements of a list do not move, so we can keep a pointer to it
+      std::lock_guard<std::mutex> lock(mutex);
+      get_all_pools().emplace_back();
+      pool = &get_all_pools().back();
+      pool->initialize(0);
+    }
+  return *pool;
 }
 
 
@@ -46,6 +68,8 @@ Threads::Mutex GrowingVectorMemory<VectorType>::mutex;
 template <typename VectorType>
 inline GrowingVectorMemory<VectorType>::Pool::Pool()
   : data(nullptr)
+  , n_allocations(0)
+  , n_reuses(0)
 {}
 
 
@@ -92,8 +116,9 @@ inline GrowingVectorMemory<VectorType>::GrowingVectorMemory(
   , current_alloc(0)
   , log_statistics(log_statistics)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  get_pool().initialize(initial_size);
+  // the pool of this thread is created empty, so fill it up to the desired
+  // size
+  reserve(initial_size);
 }
 
 
@@ -107,7 +132,7 @@ inline GrowingVectorMemory<VectorType>::~GrowingVectorMemory()
       deallog << "GrowingVectorMemory:Overall allocated vectors: "
               << total_alloc << std::endl;
       deallog << "GrowingVectorMemory:Maximum allocated vectors: "
-              << get_pool().data->size() << std::endl;
+              << get_statistics().n_vectors << std::endl;
     }
 }
 
@@ -117,27 +142,30 @@ template <typename VectorType>
 inline VectorType *
 GrowingVectorMemory<VectorType>::alloc()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  Pool &                      pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
 
   ++total_alloc;
   ++current_alloc;
+  ++pool.n_allocations;
   // see if there is a free vector
   // available in our list
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
+  for (typename std::vector<entry_type>::iterator i = pool.data->begin();
+       i != pool.data->end();
        ++i)
     {
       if (i->first == false)
         {
           i->first = true;
+          ++pool.n_reuses;
           return i->second.get();
         }
     }
 
   // no free vector found, so let's just allocate a new one
-  get_pool().data->emplace_back(true, std::make_unique<VectorType>());
+  pool.data->emplace_back(true, std::make_unique<VectorType>());
 
-  return get_pool().data->back().second.get();
+  return pool.data->back().second.get();
 }
 
 
@@ -146,19 +174,39 @@ template <typename VectorType>
 inline void
 GrowingVectorMemory<VectorType>::free(const VectorType *const v)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
-    {
+  // the common case is that the vector is released by the thread that
+  // allocated it, so look into the own pool first
+  Pool &own_pool = get_pool();
+  {
+    std::lock_guard<std::mutex> lock(own_pool.mutex);
+    for (typename std::vector<entry_type>::iterator i =
+           own_pool.data->begin();
+         i != own_pool.data->end();
+         ++i)
       if (v == i->second.get())
         {
           i->first = false;
           --current_alloc;
           return;
         }
-    }
+  }
+
+  // otherwise, the vector was allocated by another thread
+  std::lock_guard<std::mutex> lock(mutex);
+  for (Pool &pool : get_all_pools())
+    if (&pool != &own_pool)
+      {
+        std::lock_guard<std::mutex> pool_lock(pool.mutex);
+        for (typename std::vector<entry_type>::iterator i = pool.data->begin();
+             i != pool.data->end();
+             ++i)
+          if (v == i->second.get())
+            {
+              i->first = false;
+              --current_alloc;
+              return;
+            }
+      }
   Assert(false, typename VectorMemory<VectorType>::ExcNotAllocatedHere());
 }
 
@@ -170,8 +218,77 @@ GrowingVectorMemory<VectorType>::release_unused_memory()
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  if (get_pool().data != nullptr)
-    get_pool().data->clear();
+  for (Pool &pool : get_all_pools())
+    {
+      std::lock_guard<std::mutex> pool_lock(pool.mutex);
+      if (pool.data != nullptr)
+        pool.data->erase(std::remove_if(pool.data->begin(),
+                                        pool.data->end(),
+                                        [](const entry_type &entry) {
+                                          return entry.first == false;
+                                        }),
+                         pool.data->end());
+    }
+}
+
+
+
+template <typename VectorType>
+inline void
+GrowingVectorMemory<VectorType>::reserve(
+  const size_type                          n_vectors,
+  const std::function<void(VectorType &)> &initializer)
+{
+  Pool &                      pool = get_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+
+  size_type n_unused = 0;
+  for (const entry_type &entry : *pool.data)
+    if (entry.first == false)
+      ++n_unused;
+
+  for (; n_unused < n_vectors; ++n_unused)
+    {
+      pool.data->emplace_back(false, std::make_unique<VectorType>());
+      if (initializer)
+        initializer(*pool.data->back().second);
+    }
+}
+
+
+
+template <typename VectorType>
+inline double
+GrowingVectorMemory<VectorType>::Statistics::hit_rate() const
+{
+  return n_allocations > 0 ? static_cast<double>(n_reuses) / n_allocations :
+                             1.;
+}
+
+
+
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::Statistics
+GrowingVectorMemory<VectorType>::get_statistics()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Statistics statistics{0, 0, 0, 0};
+  for (Pool &pool : get_all_pools())
+    {
+      std::lock_guard<std::mutex> pool_lock(pool.mutex);
+      statistics.n_allocations += pool.n_allocations;
+      statistics.n_reuses += pool.n_reuses;
+      if (pool.data != nullptr)
+        {
+          statistics.n_vectors += pool.data->size();
+          for (const entry_type &entry : *pool.data)
+            if (entry.first == true)
+              ++statistics.n_vectors_in_use;
+        }
+    }
+
+  return statistics;
 }
 
 
@@ -182,14 +299,18 @@ GrowingVectorMemory<VectorType>::memory_consumption() const
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  std::size_t                                            result = sizeof(*this);
-  const typename std::vector<entry_type>::const_iterator end =
-    get_pool().data->end();
-  for (typename std::vector<entry_type>::const_iterator i =
-         get_pool().data->begin();
-       i != end;
-       ++i)
-    result += sizeof(*i) + MemoryConsumption::memory_consumption(i->second);
+  std::size_t result = sizeof(*this);
+  for (Pool &pool : get_all_pools())
+    {
+      std::lock_guard<std::mutex> pool_lock(pool.mutex);
+      const typename std::vector<entry_type>::const_iterator end =
+        pool.data->end();
+      for (typename std::vector<entry_type>::const_iterator i =
+             pool.data->begin();
+           i != end;
+           ++i)
+        result += sizeof(*i) + MemoryConsumption::memory_consumption(i->second);
+    }
 
   return result;
 }
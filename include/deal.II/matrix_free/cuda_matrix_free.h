@@ -155,7 +155,11 @@ namespace CUDAWrappers
 
       /**
        *  Overlap MPI communications with computation. This requires CUDA-aware
-       *  MPI and use_coloring must be false.
+       *  MPI and use_coloring must be false. The cell kernels are then
+       *  launched on a separate non-blocking CUDA stream, such that the
+       *  kernels on the interior cells run concurrently with the packing and
+       *  unpacking of the ghost data done by the vector on the default
+       *  stream.
        */
       bool overlap_communication_computation;
     };
@@ -647,6 +651,19 @@ namespace CUDAWrappers
      */
     std::vector<std::vector<CellFilter>> graph;
 
+    /**
+     * Non-blocking stream on which the cell kernels are launched when
+     * communication and computation are overlapped. Only created in that
+     * case.
+     */
+    cudaStream_t stream;
+
+    /**
+     * Event used to order the work on @p stream with respect to the work on
+     * the default stream.
+     */
+    cudaEvent_t stream_event;
+
     friend class internal::ReinitHelper<dim, Number>;
   };
 
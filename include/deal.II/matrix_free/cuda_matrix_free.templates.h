@@ -611,6 +611,8 @@ namespace CUDAWrappers
     , padding_length(0)
     , my_id(-1)
     , dof_handler(nullptr)
+    , stream(nullptr)
+    , stream_event(nullptr)
   {}
 
 
@@ -739,6 +741,19 @@ namespace CUDAWrappers
 
     Utilities::CUDA::free(constrained_dofs);
 
+    if (stream_event != nullptr)
+      {
+        cudaError_t cuda_error = cudaEventDestroy(stream_event);
+        AssertCuda(cuda_error);
+        stream_event = nullptr;
+      }
+    if (stream != nullptr)
+      {
+        cudaError_t cuda_error = cudaStreamDestroy(stream);
+        AssertCuda(cuda_error);
+        stream = nullptr;
+      }
+
     internal::used_objects[my_id].store(false);
     my_id = -1;
   }
@@ -1053,6 +1068,16 @@ namespace CUDAWrappers
       }
     n_colors = graph.size();
 
+    if (overlap_communication_computation)
+      {
+        cudaError_t cuda_error =
+          cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+        AssertCuda(cuda_error);
+        cuda_error =
+          cudaEventCreateWithFlags(&stream_event, cudaEventDisableTiming);
+        AssertCuda(cuda_error);
+      }
+
     helper.setup_color_arrays(n_colors);
 
     IndexSet locally_relevant_dofs;
@@ -1186,16 +1211,23 @@ namespace CUDAWrappers
         // This code is inspired to the code in TaskInfo::loop.
         if (overlap_communication_computation)
           {
+            // The cell kernels run on a non-blocking stream, which is not
+            // synchronized with the default stream used by the vector
+            // operations. Therefore, we first make the stream wait for all
+            // work submitted so far.
+            cudaError_t cuda_error = cudaEventRecord(stream_event, 0);
+            AssertCuda(cuda_error);
+            cuda_error = cudaStreamWaitEvent(stream, stream_event, 0);
+            AssertCuda(cuda_error);
+
             src.update_ghost_values_start(0);
             // In parallel, it's possible that some processors do not own any
             // cells.
             if (n_cells[0] > 0)
               {
                 internal::apply_kernel_shmem<dim, Number, Functor>
-                  <<<grid_dim[0], block_dim[0]>>>(func,
-                                                  get_data(0),
-                                                  src.get_values(),
-                                                  dst.get_values());
+                  <<<grid_dim[0], block_dim[0], 0, stream>>>(
+                    func, get_data(0), src.get_values(), dst.get_values());
                 AssertCudaKernel();
               }
             src.update_ghost_values_finish();
@@ -1205,30 +1237,37 @@ namespace CUDAWrappers
             if (n_cells[1] > 0)
               {
                 internal::apply_kernel_shmem<dim, Number, Functor>
-                  <<<grid_dim[1], block_dim[1]>>>(func,
-                                                  get_data(1),
-                                                  src.get_values(),
-                                                  dst.get_values());
+                  <<<grid_dim[1], block_dim[1], 0, stream>>>(
+                    func, get_data(1), src.get_values(), dst.get_values());
                 AssertCudaKernel();
-                // We need a synchronization point because we don't want
-                // CUDA-aware MPI to start the MPI communication until the
-                // kernel is done.
-                cudaDeviceSynchronize();
               }
-
+            // We need a synchronization point because we don't want
+            // CUDA-aware MPI to start the MPI communication until the
+            // kernels are done. Only the cell stream needs to be waited for.
+            cuda_error = cudaStreamSynchronize(stream);
+            AssertCuda(cuda_error);
+
+            // The cells of color 2 do not share any degrees of freedom with
+            // ghost cells, so the kernel can run while the vector adds the
+            // imported data on the default stream
             dst.compress_start(0, VectorOperation::add);
             // When the mesh is coarse it is possible that some processors do
             // not own any cells
             if (n_cells[2] > 0)
               {
                 internal::apply_kernel_shmem<dim, Number, Functor>
-                  <<<grid_dim[2], block_dim[2]>>>(func,
-                                                  get_data(2),
-                                                  src.get_values(),
-                                                  dst.get_values());
+                  <<<grid_dim[2], block_dim[2], 0, stream>>>(
+                    func, get_data(2), src.get_values(), dst.get_values());
                 AssertCudaKernel();
               }
             dst.compress_finish(VectorOperation::add);
+
+            // let all subsequent work on the default stream wait for the
+            // cell kernels
+            cuda_error = cudaEventRecord(stream_event, stream);
+            AssertCuda(cuda_error);
+            cuda_error = cudaStreamWaitEvent(0, stream_event, 0);
+            AssertCuda(cuda_error);
           }
         else
           {
@@ -45,6 +45,30 @@ namespace internal
 {
   namespace MatrixFreeFunctions
   {
+    /**
+     * Bits of the compressed description of the hanging-node configuration
+     * of a cell as stored in DoFInfo::hanging_node_constraint_masks. The
+     * layout follows the one used by CUDAWrappers::MatrixFree: If the mask is
+     * zero, there are no hanging-node constraints on the cell. Otherwise,
+     * there are three fields with one bit per coordinate direction. The
+     * first field determines the position of the cell within its coarser
+     * parent along each direction (bit set: lower half). The second field
+     * determines whether there is a constrained face with the given
+     * direction as normal. The last field marks the constrained edges in 3D
+     * that are not part of a constrained face.
+     */
+    constexpr unsigned short constr_type_x  = 1 << 0;
+    constexpr unsigned short constr_type_y  = 1 << 1;
+    constexpr unsigned short constr_type_z  = 1 << 2;
+    constexpr unsigned short constr_face_x  = 1 << 3;
+    constexpr unsigned short constr_face_y  = 1 << 4;
+    constexpr unsigned short constr_face_z  = 1 << 5;
+    constexpr unsigned short constr_edge_xy = 1 << 6;
+    constexpr unsigned short constr_edge_yz = 1 << 7;
+    constexpr unsigned short constr_edge_zx = 1 << 8;
+
+
+
     /**
      * A struct that takes entries describing a constraint and puts them into
      * a sorted list where duplicates are filtered out
@@ -168,12 +192,21 @@ namespace internal
        * processor, get a temporary number by this function, and will later be
        * assigned the correct index after all the ghost indices have been
        * collected by the call to @p assign_ghosts.
+       *
+       * The indices in @p local_indices_resolved are the ones the constraints
+       * are resolved from. They differ from the plain indices of the cell,
+       * @p local_indices, if the hanging-node constraints of the cell have
+       * been absorbed into a mask according to
+       * @p cell_has_hanging_node_constraints, in which case the indices on
+       * the refined side are replaced by the ones of the coarser neighbor.
        */
       template <typename number>
       void
       read_dof_indices(
+        const std::vector<types::global_dof_index> &local_indices_resolved,
         const std::vector<types::global_dof_index> &local_indices,
-        const std::vector<unsigned int> &           lexicographic_inv,
+        const bool                       cell_has_hanging_node_constraints,
+        const std::vector<unsigned int> &lexicographic_inv,
         const dealii::AffineConstraints<number> &   constraints,
         const unsigned int                          cell_number,
         ConstraintValues<double> &                  constraint_values,
@@ -596,6 +629,17 @@ namespace internal
        */
       std::vector<unsigned int> plain_dof_indices;
 
+      /**
+       * Stores the compressed description of the hanging-node constraints of
+       * each cell, using the bits constr_type_x etc. The index of the entry
+       * of a cell is the same as for the plain indices, i.e., <tt>cell *
+       * vectorization_length + lane</tt> after the call to reorder_cells().
+       * The vector is empty if no cell has hanging nodes resolved in this
+       * way, in which case all constraints are contained in
+       * constraint_indicator.
+       */
+      std::vector<unsigned short> hanging_node_constraint_masks;
+
       /**
        * Stores the offset in terms of the number of base elements over all
        * DoFInfo objects.
@@ -126,6 +126,7 @@ namespace internal
       start_components.clear();
       row_starts_plain_indices.clear();
       plain_dof_indices.clear();
+      hanging_node_constraint_masks.clear();
       dof_indices_interleaved.clear();
       for (unsigned int i = 0; i < 3; ++i)
         {
@@ -176,7 +177,9 @@ namespace internal
           // shift for this cell within the block as compared to the next
           // one
           const bool has_constraints =
-            row_starts[ib].second != row_starts[ib + n_fe_components].second;
+            row_starts[ib].second != row_starts[ib + n_fe_components].second ||
+            (hanging_node_constraint_masks.size() > 0 &&
+             hanging_node_constraint_masks[cell * n_vectorization + v] != 0);
 
           auto do_copy = [&](const unsigned int *begin,
                              const unsigned int *end) {
@@ -212,12 +215,14 @@ namespace internal
     template <typename number>
     void
     DoFInfo::read_dof_indices(
+      const std::vector<types::global_dof_index> &local_indices_resolved,
       const std::vector<types::global_dof_index> &local_indices,
-      const std::vector<unsigned int> &           lexicographic_inv,
-      const dealii::AffineConstraints<number> &   constraints,
-      const unsigned int                          cell_number,
-      ConstraintValues<double> &                  constraint_values,
-      bool &                                      cell_at_subdomain_boundary)
+      const bool cell_has_hanging_node_constraints,
+      const std::vector<unsigned int> &        lexicographic_inv,
+      const dealii::AffineConstraints<number> &constraints,
+      const unsigned int                       cell_number,
+      ConstraintValues<double> &               constraint_values,
+      bool &                                   cell_at_subdomain_boundary)
     {
       Assert(vector_partitioner.get() != nullptr, ExcInternalError());
       const unsigned int n_mpi_procs = vector_partitioner->n_mpi_processes();
@@ -246,7 +251,7 @@ namespace internal
                i++)
             {
               types::global_dof_index current_dof =
-                local_indices[lexicographic_inv[i]];
+                local_indices_resolved[lexicographic_inv[i]];
               const auto *entries_ptr =
                 constraints.get_constraint_entries(current_dof);
 
@@ -355,6 +360,7 @@ namespace internal
               (row_starts.size() - 1) / n_components + 1);
           row_starts_plain_indices[cell_number] = plain_dof_indices.size();
           const bool cell_has_constraints =
+            cell_has_hanging_node_constraints ||
             (row_starts[(cell_number + 1) * n_components].second >
              row_starts[cell_number * n_components].second);
           if (cell_has_constraints == true)
@@ -466,7 +472,10 @@ namespace internal
               if (store_plain_indices == true)
                 {
                   if (row_starts[boundary_cells[i] * n_components].second !=
-                      row_starts[(boundary_cells[i] + 1) * n_components].second)
+                        row_starts[(boundary_cells[i] + 1) * n_components]
+                          .second ||
+                      (hanging_node_constraint_masks.size() > 0 &&
+                       hanging_node_constraint_masks[boundary_cells[i]] != 0))
                     {
                       unsigned int *data_ptr =
                         plain_dof_indices.data() +
@@ -563,9 +572,13 @@ namespace internal
       std::vector<std::pair<unsigned short, unsigned short>>
                                 new_constraint_indicator;
       std::vector<unsigned int> new_plain_indices, new_rowstart_plain;
-      unsigned int              position_cell = 0;
+      std::vector<unsigned short> new_hanging_node_constraint_masks;
+      unsigned int                position_cell = 0;
       new_dof_indices.reserve(dof_indices.size());
       new_constraint_indicator.reserve(constraint_indicator.size());
+      if (hanging_node_constraint_masks.size() > 0)
+        new_hanging_node_constraint_masks.resize(
+          vectorization_length * task_info.cell_partition_data.back(), 0);
       if (store_plain_indices == true)
         {
           new_rowstart_plain.resize(vectorization_length *
@@ -613,9 +626,17 @@ namespace internal
                     new_constraint_indicator.push_back(
                       constraint_indicator[index]);
                 }
+              const bool cell_has_hanging_node_constraints =
+                hanging_node_constraint_masks.size() > 0 &&
+                hanging_node_constraint_masks[cell_no / n_components] != 0;
+              if (cell_has_hanging_node_constraints)
+                new_hanging_node_constraint_masks[i * vectorization_length +
+                                                  j] =
+                  hanging_node_constraint_masks[cell_no / n_components];
               if (store_plain_indices &&
-                  row_starts[cell_no].second !=
-                    row_starts[cell_no + n_components].second)
+                  (row_starts[cell_no].second !=
+                     row_starts[cell_no + n_components].second ||
+                   cell_has_hanging_node_constraints))
                 {
                   new_rowstart_plain[i * vectorization_length + j] =
                     new_plain_indices.size();
@@ -658,6 +679,7 @@ namespace internal
       new_constraint_indicator.swap(constraint_indicator);
       new_plain_indices.swap(plain_dof_indices);
       new_rowstart_plain.swap(row_starts_plain_indices);
+      new_hanging_node_constraint_masks.swap(hanging_node_constraint_masks);
 
 #ifdef DEBUG
       // sanity check 1: all indices should be smaller than the number of dofs
@@ -2039,6 +2061,8 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(dof_indices);
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
       memory += MemoryConsumption::memory_consumption(plain_dof_indices);
+      memory +=
+        MemoryConsumption::memory_consumption(hanging_node_constraint_masks);
       memory += MemoryConsumption::memory_consumption(constraint_indicator);
       memory += MemoryConsumption::memory_consumption(*vector_partitioner);
       return memory;
@@ -0,0 +1,385 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_evaluation_kernel_cache_h
+#define dealii_matrix_free_evaluation_kernel_cache_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/matrix_free/evaluation_flags.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MatrixFreeTools
+{
+  /**
+   * Functions to generate specialized FEEvaluation kernels at run time.
+   *
+   * The cell evaluation and integration kernels of FEEvaluation with
+   * template parameter <tt>fe_degree=-1</tt> are taken from a set of kernels
+   * precompiled into the library for the polynomial degrees up to
+   * FE_EVAL_FACTORY_DEGREE_MAX (6 by default) and the numbers of 1D
+   * quadrature points $k$, $k+1$, $k+2$ and $\lfloor 3k/2 \rfloor+1$ for
+   * degree $k$. All other combinations, e.g., higher degrees or stronger
+   * over-integration, use a considerably slower kernel in which the loop
+   * bounds are not known at compile time.
+   *
+   * The function generate() closes this gap without recompiling deal.II: it
+   * writes a source file with the specialized kernels for a given
+   * combination of degree and number of quadrature points, compiles it into
+   * a shared library, and loads the library. From then on, FEEvaluation
+   * uses the generated kernels whenever it encounters this combination. The
+   * libraries are kept in a cache directory and reused by subsequent runs,
+   * as long as the deal.II version and the compile command do not change.
+   * In parallel runs, the library is compiled by the first process of the
+   * communicator, and loaded by all others, which requires the cache
+   * directory to be on a file system shared by all processes.
+   *
+   * Typically, generate() is called once after the setup of the MatrixFree
+   * object, e.g.
+   * @code
+   * MatrixFreeTools::EvaluationKernelCache::generate<dim, double>(
+   *   fe_degree, fe_degree + 3, MPI_COMM_WORLD);
+   * @endcode
+   * It must not be called concurrently to the evaluation of the same
+   * kernels in other threads.
+   *
+   * The generated code is compiled by the command given in
+   * AdditionalData::compile_command, or, if that is empty, in the
+   * environment variable <tt>DEAL_II_KERNEL_COMPILE_COMMAND</tt>. The
+   * command must create a shared library and needs to find the deal.II
+   * header files, e.g.,
+   * @code
+   * c++ -std=c++14 -O3 -march=native -fPIC -shared -I/path/to/deal.II/include
+   * @endcode
+   * To be compatible with the library, the compiler and the flags that
+   * affect the vectorization width should be the same as the ones deal.II
+   * has been compiled with. The options <tt>-o</tt> and the source file are
+   * appended by generate().
+   *
+   * @note This functionality relies on <tt>dlopen()</tt> and is not
+   * available on systems that do not provide it. Only the cell kernels are
+   * generated, FEFaceEvaluation continues to use the precompiled kernels.
+   */
+  namespace EvaluationKernelCache
+  {
+    /**
+     * Settings for generate().
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(
+        const std::string &cache_directory = "deal.II-kernel-cache",
+        const std::string &compile_command = "");
+
+      /**
+       * The directory in which the generated source files and libraries are
+       * stored. It is created if it does not exist, but its parent
+       * directory must exist.
+       */
+      std::string cache_directory;
+
+      /**
+       * The command used to compile the generated source file into a shared
+       * library, see the description of the namespace. If empty, the
+       * content of the environment variable
+       * <tt>DEAL_II_KERNEL_COMPILE_COMMAND</tt> is used.
+       */
+      std::string compile_command;
+    };
+
+    /**
+     * Generate, compile and load the cell evaluation kernels for the
+     * polynomial degree @p fe_degree and @p n_q_points_1d quadrature points
+     * per direction, unless they have been loaded before. The generated
+     * kernels are only used for combinations that are not precompiled into
+     * deal.II. This is a collective operation on @p mpi_communicator.
+     */
+    template <int dim,
+              typename Number,
+              typename VectorizedArrayType = VectorizedArray<Number>>
+    void
+    generate(const unsigned int    fe_degree,
+             const unsigned int    n_q_points_1d,
+             const MPI_Comm &      mpi_communicator = MPI_COMM_SELF,
+             const AdditionalData &additional_data  = AdditionalData());
+  } // namespace EvaluationKernelCache
+} // namespace MatrixFreeTools
+
+
+
+namespace internal
+{
+  /**
+   * The registry of the evaluation kernels loaded by
+   * MatrixFreeTools::EvaluationKernelCache::generate().
+   *
+   * Lookups happen in the evaluation of every cell, whereas new kernels are
+   * only added rarely. The kernels are therefore stored in immutable maps:
+   * insert() creates a new map and publishes it atomically, so that find()
+   * does not need a lock. The old maps are kept alive, since other threads
+   * might still access them.
+   */
+  template <int dim, typename VectorizedArrayType>
+  struct RuntimeEvaluationKernels
+  {
+    using EvaluateFunction = bool (*)(
+      const unsigned int                                         n_components,
+      const EvaluationFlags::EvaluationFlags                     flags,
+      const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &shape_info,
+      VectorizedArrayType *values_dofs,
+      VectorizedArrayType *values_quad,
+      VectorizedArrayType *gradients_quad,
+      VectorizedArrayType *hessians_quad,
+      VectorizedArrayType *scratch_data);
+
+    using IntegrateFunction = bool (*)(
+      const unsigned int                                         n_components,
+      const EvaluationFlags::EvaluationFlags                     flags,
+      const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &shape_info,
+      VectorizedArrayType *values_dofs,
+      VectorizedArrayType *values_quad,
+      VectorizedArrayType *gradients_quad,
+      VectorizedArrayType *scratch_data,
+      const bool           sum_into_values_array);
+
+    struct Kernels
+    {
+      EvaluateFunction  evaluate;
+      IntegrateFunction integrate;
+    };
+
+    /**
+     * Return the kernels for the given degree and number of quadrature
+     * points, or a null pointer if none have been loaded.
+     */
+    static const Kernels *
+    find(const unsigned int fe_degree, const unsigned int n_q_points_1d);
+
+    /**
+     * Add kernels for the given degree and number of quadrature points.
+     */
+    static void
+    insert(const unsigned int fe_degree,
+           const unsigned int n_q_points_1d,
+           const Kernels &    kernels);
+
+  private:
+    using KernelMap =
+      std::map<std::pair<unsigned int, unsigned int>, Kernels>;
+
+    struct Registry
+    {
+      std::mutex                     mutex;
+      std::list<KernelMap>           versions;
+      std::atomic<const KernelMap *> current{nullptr};
+    };
+
+    static Registry &
+    get_registry();
+  };
+
+
+
+  /**
+   * Compile the given @p source_code into a shared library in the cache
+   * directory, unless a library for the same code and compile command
+   * exists already, and load it on all processes of @p mpi_communicator.
+   * Return the addresses of the symbols @p symbol_names in the library.
+   */
+  std::vector<void *>
+  compile_and_load_kernels(
+    const std::string &              source_code,
+    const std::vector<std::string> & symbol_names,
+    const MPI_Comm &                 mpi_communicator,
+    const MatrixFreeTools::EvaluationKernelCache::AdditionalData &data);
+
+
+
+  /* ------------------------- inline functions ---------------------- */
+
+#ifndef DOXYGEN
+
+  template <int dim, typename VectorizedArrayType>
+  inline const typename RuntimeEvaluationKernels<dim,
+                                                 VectorizedArrayType>::Kernels *
+  RuntimeEvaluationKernels<dim, VectorizedArrayType>::find(
+    const unsigned int fe_degree,
+    const unsigned int n_q_points_1d)
+  {
+    const KernelMap *kernels =
+      get_registry().current.load(std::memory_order_acquire);
+    if (kernels == nullptr)
+      return nullptr;
+
+    const auto entry = kernels->find(std::make_pair(fe_degree, n_q_points_1d));
+    return entry == kernels->end() ? nullptr : &entry->second;
+  }
+
+
+
+  template <int dim, typename VectorizedArrayType>
+  inline void
+  RuntimeEvaluationKernels<dim, VectorizedArrayType>::insert(
+    const unsigned int fe_degree,
+    const unsigned int n_q_points_1d,
+    const Kernels &    kernels)
+  {
+    Registry &                  registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    const KernelMap *old_kernels = registry.current.load();
+    registry.versions.push_back(old_kernels != nullptr ? *old_kernels :
+                                                         KernelMap());
+    registry.versions.back()[std::make_pair(fe_degree, n_q_points_1d)] =
+      kernels;
+    registry.current.store(&registry.versions.back(),
+                           std::memory_order_release);
+  }
+
+
+
+  template <int dim, typename VectorizedArrayType>
+  inline typename RuntimeEvaluationKernels<dim, VectorizedArrayType>::Registry &
+  RuntimeEvaluationKernels<dim, VectorizedArrayType>::get_registry()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+#endif
+} // namespace internal
+
+
+
+#ifndef DOXYGEN
+
+namespace MatrixFreeTools
+{
+  namespace EvaluationKernelCache
+  {
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    generate(const unsigned int    fe_degree,
+             const unsigned int    n_q_points_1d,
+             const MPI_Comm &      mpi_communicator,
+             const AdditionalData &additional_data)
+    {
+      static_assert(
+        std::is_same<Number, typename VectorizedArrayType::value_type>::value,
+        "Type of Number and of VectorizedArrayType do not match.");
+
+      using RegistryType =
+        internal::RuntimeEvaluationKernels<dim, VectorizedArrayType>;
+
+      if (RegistryType::find(fe_degree, n_q_points_1d) != nullptr)
+        return;
+
+      const std::string type_name =
+        Utilities::type_to_string(VectorizedArrayType());
+      const std::string selector =
+        "dealii::internal::FEEvaluationImpl%Selector<" + std::to_string(dim) +
+        ", VectorizedArrayType>::run<" + std::to_string(fe_degree) +
+        ", " + std::to_string(n_q_points_1d) + ">";
+
+      std::string source =
+        "#include <deal.II/matrix_free/evaluation_kernels.h>\n"
+        "\n"
+        "using VectorizedArrayType = " +
+        type_name +
+        ";\n"
+        "using ShapeInfo = dealii::internal::MatrixFreeFunctions::"
+        "ShapeInfo<VectorizedArrayType>;\n"
+        "\n"
+        "extern \"C\" bool\n"
+        "dealii_runtime_evaluate(\n"
+        "  const unsigned int                             n_components,\n"
+        "  const dealii::EvaluationFlags::EvaluationFlags flags,\n"
+        "  const ShapeInfo &                              shape_info,\n"
+        "  VectorizedArrayType *values_dofs,\n"
+        "  VectorizedArrayType *values_quad,\n"
+        "  VectorizedArrayType *gradients_quad,\n"
+        "  VectorizedArrayType *hessians_quad,\n"
+        "  VectorizedArrayType *scratch_data)\n"
+        "{\n"
+        "  return " +
+        Utilities::replace_in_string(selector, "%", "Evaluate") +
+        "(\n"
+        "    n_components, flags, shape_info, values_dofs, values_quad,\n"
+        "    gradients_quad, hessians_quad, scratch_data);\n"
+        "}\n"
+        "\n"
+        "extern \"C\" bool\n"
+        "dealii_runtime_integrate(\n"
+        "  const unsigned int                             n_components,\n"
+        "  const dealii::EvaluationFlags::EvaluationFlags flags,\n"
+        "  const ShapeInfo &                              shape_info,\n"
+        "  VectorizedArrayType *values_dofs,\n"
+        "  VectorizedArrayType *values_quad,\n"
+        "  VectorizedArrayType *gradients_quad,\n"
+        "  VectorizedArrayType *scratch_data,\n"
+        "  const bool           sum_into_values_array)\n"
+        "{\n"
+        "  return " +
+        Utilities::replace_in_string(selector, "%", "Integrate") +
+        "(\n"
+        "    n_components, flags, shape_info, values_dofs, values_quad,\n"
+        "    gradients_quad, scratch_data, sum_into_values_array);\n"
+        "}\n";
+
+      const std::vector<void *> symbols = internal::compile_and_load_kernels(
+        source,
+        {"dealii_runtime_evaluate", "dealii_runtime_integrate"},
+        mpi_communicator,
+        additional_data);
+
+      typename RegistryType::Kernels kernels;
+      kernels.evaluate =
+        reinterpret_cast<typename RegistryType::EvaluateFunction>(symbols[0]);
+      kernels.integrate =
+        reinterpret_cast<typename RegistryType::IntegrateFunction>(
+          symbols[1]);
+      RegistryType::insert(fe_degree, n_q_points_1d, kernels);
+    }
+  } // namespace EvaluationKernelCache
+} // namespace MatrixFreeTools
+
+#endif
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -675,6 +675,220 @@ namespace internal
 
 
 
+  /**
+   * Kernels for the evaluation and integration of elements without
+   * tensor-product structure, MatrixFreeFunctions::tensor_none, as used for
+   * simplex elements. Rather than applying the shape values and each
+   * component of the shape gradients as separate matrix-vector products,
+   * the kernels use the interleaved storage in
+   * UnivariateShapeData::shape_values_gradients_interleaved to compute all
+   * of them in a single sweep over the dense shape matrix. Furthermore,
+   * several components of a vector-valued element are processed at once,
+   * which turns the operation into a small matrix-matrix product where each
+   * shape entry loaded from memory is used for all components of the block.
+   */
+  template <int dim, typename Number>
+  struct FEEvaluationImplDense
+  {
+    static constexpr unsigned int stride = dim + 1;
+
+    /**
+     * Evaluate values and/or gradients for @p n_block components, with the
+     * usual layout of the fields in FEEvaluation.
+     */
+    template <int n_block, bool evaluate_values, bool evaluate_gradients>
+    static void
+    evaluate_block(const unsigned int n_dofs,
+                   const unsigned int n_q_points,
+                   const Number *     shape_data,
+                   const Number *     values_dofs,
+                   Number *           values_quad,
+                   Number *           gradients_quad)
+    {
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          const Number *shape = shape_data + q * n_dofs * stride;
+          Number        value[n_block];
+          Number        gradient[n_block][dim];
+          for (int c = 0; c < n_block; ++c)
+            {
+              const Number u = values_dofs[c * n_dofs];
+              if (evaluate_values)
+                value[c] = shape[0] * u;
+              if (evaluate_gradients)
+                for (int d = 0; d < dim; ++d)
+                  gradient[c][d] = shape[1 + d] * u;
+            }
+          for (unsigned int i = 1; i < n_dofs; ++i)
+            {
+              shape += stride;
+              for (int c = 0; c < n_block; ++c)
+                {
+                  const Number u = values_dofs[c * n_dofs + i];
+                  if (evaluate_values)
+                    value[c] += shape[0] * u;
+                  if (evaluate_gradients)
+                    for (int d = 0; d < dim; ++d)
+                      gradient[c][d] += shape[1 + d] * u;
+                }
+            }
+          for (int c = 0; c < n_block; ++c)
+            {
+              if (evaluate_values)
+                values_quad[c * n_q_points + q] = value[c];
+              if (evaluate_gradients)
+                for (int d = 0; d < dim; ++d)
+                  gradients_quad[(c * dim + d) * n_q_points + q] =
+                    gradient[c][d];
+            }
+        }
+    }
+
+    /**
+     * Integrate values and/or gradients for @p n_block components, using the
+     * transposed interleaved shape data.
+     */
+    template <int  n_block,
+              bool integrate_values,
+              bool integrate_gradients,
+              bool add_into_values_array>
+    static void
+    integrate_block(const unsigned int n_dofs,
+                    const unsigned int n_q_points,
+                    const Number *     shape_data,
+                    Number *           values_dofs,
+                    const Number *     values_quad,
+                    const Number *     gradients_quad)
+    {
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          const Number *shape = shape_data + i * n_q_points * stride;
+          Number        sum[n_block];
+          for (int c = 0; c < n_block; ++c)
+            sum[c] =
+              add_into_values_array ? values_dofs[c * n_dofs + i] : Number();
+          for (unsigned int q = 0; q < n_q_points; ++q, shape += stride)
+            for (int c = 0; c < n_block; ++c)
+              {
+                if (integrate_values)
+                  sum[c] += shape[0] * values_quad[c * n_q_points + q];
+                if (integrate_gradients)
+                  for (int d = 0; d < dim; ++d)
+                    sum[c] += shape[1 + d] *
+                              gradients_quad[(c * dim + d) * n_q_points + q];
+              }
+          for (int c = 0; c < n_block; ++c)
+            values_dofs[c * n_dofs + i] = sum[c];
+        }
+    }
+
+    /**
+     * Run the evaluation for all components, subdivided into blocks of up
+     * to three components.
+     */
+    template <bool evaluate_values, bool evaluate_gradients>
+    static void
+    evaluate(const unsigned int n_components,
+             const unsigned int n_dofs,
+             const unsigned int n_q_points,
+             const Number *     shape_data,
+             const Number *     values_dofs,
+             Number *           values_quad,
+             Number *           gradients_quad)
+    {
+      for (unsigned int c = 0; c < n_components;)
+        {
+          const unsigned int n_remaining = n_components - c;
+          if (n_remaining >= 3)
+            evaluate_block<3, evaluate_values, evaluate_gradients>(
+              n_dofs,
+              n_q_points,
+              shape_data,
+              values_dofs + c * n_dofs,
+              values_quad + c * n_q_points,
+              gradients_quad + c * dim * n_q_points);
+          else if (n_remaining == 2)
+            evaluate_block<2, evaluate_values, evaluate_gradients>(
+              n_dofs,
+              n_q_points,
+              shape_data,
+              values_dofs + c * n_dofs,
+              values_quad + c * n_q_points,
+              gradients_quad + c * dim * n_q_points);
+          else
+            evaluate_block<1, evaluate_values, evaluate_gradients>(
+              n_dofs,
+              n_q_points,
+              shape_data,
+              values_dofs + c * n_dofs,
+              values_quad + c * n_q_points,
+              gradients_quad + c * dim * n_q_points);
+          c += std::min(n_remaining, 3U);
+        }
+    }
+
+    /**
+     * Run the integration for all components, subdivided into blocks of up
+     * to three components.
+     */
+    template <bool integrate_values,
+              bool integrate_gradients,
+              bool add_into_values_array>
+    static void
+    integrate(const unsigned int n_components,
+              const unsigned int n_dofs,
+              const unsigned int n_q_points,
+              const Number *     shape_data,
+              Number *           values_dofs,
+              const Number *     values_quad,
+              const Number *     gradients_quad)
+    {
+      for (unsigned int c = 0; c < n_components;)
+        {
+          const unsigned int n_remaining = n_components - c;
+          if (n_remaining >= 3)
+            integrate_block<3,
+                            integrate_values,
+                            integrate_gradients,
+                            add_into_values_array>(n_dofs,
+                                                   n_q_points,
+                                                   shape_data,
+                                                   values_dofs + c * n_dofs,
+                                                   values_quad +
+                                                     c * n_q_points,
+                                                   gradients_quad +
+                                                     c * dim * n_q_points);
+          else if (n_remaining == 2)
+            integrate_block<2,
+                            integrate_values,
+                            integrate_gradients,
+                            add_into_values_array>(n_dofs,
+                                                   n_q_points,
+                                                   shape_data,
+                                                   values_dofs + c * n_dofs,
+                                                   values_quad +
+                                                     c * n_q_points,
+                                                   gradients_quad +
+                                                     c * dim * n_q_points);
+          else
+            integrate_block<1,
+                            integrate_values,
+                            integrate_gradients,
+                            add_into_values_array>(n_dofs,
+                                                   n_q_points,
+                                                   shape_data,
+                                                   values_dofs + c * n_dofs,
+                                                   values_quad +
+                                                     c * n_q_points,
+                                                   gradients_quad +
+                                                     c * dim * n_q_points);
+          c += std::min(n_remaining, 3U);
+        }
+    }
+  };
+
+
+
   template <int dim, int fe_degree, int n_q_points_1d, typename Number>
   inline void
   FEEvaluationImpl<
@@ -695,52 +909,44 @@ namespace internal
 
     const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
     const unsigned int n_q_points = shape_info.n_q_points;
+    if (n_dofs == 0 || n_q_points == 0)
+      return;
 
-    using Eval =
-      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
-
-    if (evaluation_flag & EvaluationFlags::values)
-      {
-        const auto shape_values = shape_info.data.front().shape_values.data();
-        auto       values_quad_ptr        = values_quad;
-        auto       values_dofs_actual_ptr = values_dofs_actual;
-
-        Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            eval.template values<0, true, false>(values_dofs_actual_ptr,
-                                                 values_quad_ptr);
-
-            values_quad_ptr += n_q_points;
-            values_dofs_actual_ptr += n_dofs;
-          }
-      }
-
-    if (evaluation_flag & EvaluationFlags::gradients)
-      {
-        const auto shape_gradients =
-          shape_info.data.front().shape_gradients.data();
-        auto gradients_quad_ptr     = gradients_quad;
-        auto values_dofs_actual_ptr = values_dofs_actual;
-
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            for (unsigned int d = 0; d < dim; ++d)
-              {
-                Eval eval(nullptr,
-                          shape_gradients + n_q_points * n_dofs * d,
-                          nullptr,
-                          n_dofs,
-                          n_q_points);
-
-                eval.template gradients<0, true, false>(values_dofs_actual_ptr,
-                                                        gradients_quad_ptr);
-
-                gradients_quad_ptr += n_q_points;
-              }
-            values_dofs_actual_ptr += n_dofs;
-          }
-      }
+    const Number *shape_data =
+      shape_info.data.front().shape_values_gradients_interleaved.data();
+    AssertDimension(
+      shape_info.data.front().shape_values_gradients_interleaved.size(),
+      n_dofs * n_q_points * (dim + 1));
+
+    using Eval = FEEvaluationImplDense<dim, Number>;
+
+    const bool evaluate_values = evaluation_flag & EvaluationFlags::values;
+    const bool evaluate_gradients =
+      evaluation_flag & EvaluationFlags::gradients;
+    if (evaluate_values && evaluate_gradients)
+      Eval::template evaluate<true, true>(n_components,
+                                          n_dofs,
+                                          n_q_points,
+                                          shape_data,
+                                          values_dofs_actual,
+                                          values_quad,
+                                          gradients_quad);
+    else if (evaluate_values)
+      Eval::template evaluate<true, false>(n_components,
+                                           n_dofs,
+                                           n_q_points,
+                                           shape_data,
+                                           values_dofs_actual,
+                                           values_quad,
+                                           gradients_quad);
+    else if (evaluate_gradients)
+      Eval::template evaluate<false, true>(n_components,
+                                           n_dofs,
+                                           n_q_points,
+                                           shape_data,
+                                           values_dofs_actual,
+                                           values_quad,
+                                           gradients_quad);
 
     if (evaluation_flag & EvaluationFlags::hessians)
       {
@@ -771,61 +977,77 @@ namespace internal
 
     const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
     const unsigned int n_q_points = shape_info.n_q_points;
+    if (n_dofs == 0 || n_q_points == 0)
+      return;
 
-    using Eval =
-      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    const Number *shape_data =
+      shape_info.data.front()
+        .shape_values_gradients_interleaved_transposed.data();
+    AssertDimension(shape_info.data.front()
+                      .shape_values_gradients_interleaved_transposed.size(),
+                    n_dofs * n_q_points * (dim + 1));
 
-    if (integration_flag & EvaluationFlags::values)
-      {
-        const auto shape_values = shape_info.data.front().shape_values.data();
-        auto       values_quad_ptr        = values_quad;
-        auto       values_dofs_actual_ptr = values_dofs_actual;
+    using Eval = FEEvaluationImplDense<dim, Number>;
 
-        Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            if (add_into_values_array == false)
-              eval.template values<0, false, false>(values_quad_ptr,
-                                                    values_dofs_actual_ptr);
-            else
-              eval.template values<0, false, true>(values_quad_ptr,
-                                                   values_dofs_actual_ptr);
-
-            values_quad_ptr += n_q_points;
-            values_dofs_actual_ptr += n_dofs;
-          }
+    const bool integrate_values = integration_flag & EvaluationFlags::values;
+    const bool integrate_gradients =
+      integration_flag & EvaluationFlags::gradients;
+    if (integrate_values && integrate_gradients)
+      {
+        if (add_into_values_array)
+          Eval::template integrate<true, true, true>(n_components,
+                                                     n_dofs,
+                                                     n_q_points,
+                                                     shape_data,
+                                                     values_dofs_actual,
+                                                     values_quad,
+                                                     gradients_quad);
+        else
+          Eval::template integrate<true, true, false>(n_components,
+                                                      n_dofs,
+                                                      n_q_points,
+                                                      shape_data,
+                                                      values_dofs_actual,
+                                                      values_quad,
+                                                      gradients_quad);
       }
-
-    if (integration_flag & EvaluationFlags::gradients)
+    else if (integrate_values)
       {
-        const auto shape_gradients =
-          shape_info.data.front().shape_gradients.data();
-        auto gradients_quad_ptr     = gradients_quad;
-        auto values_dofs_actual_ptr = values_dofs_actual;
-
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            for (unsigned int d = 0; d < dim; ++d)
-              {
-                Eval eval(nullptr,
-                          shape_gradients + n_q_points * n_dofs * d,
-                          nullptr,
-                          n_dofs,
-                          n_q_points);
-
-                if ((add_into_values_array == false &&
-                     (integration_flag & EvaluationFlags::values) == false) &&
-                    d == 0)
-                  eval.template gradients<0, false, false>(
-                    gradients_quad_ptr, values_dofs_actual_ptr);
-                else
-                  eval.template gradients<0, false, true>(
-                    gradients_quad_ptr, values_dofs_actual_ptr);
-
-                gradients_quad_ptr += n_q_points;
-              }
-            values_dofs_actual_ptr += n_dofs;
-          }
+        if (add_into_values_array)
+          Eval::template integrate<true, false, true>(n_components,
+                                                      n_dofs,
+                                                      n_q_points,
+                                                      shape_data,
+                                                      values_dofs_actual,
+                                                      values_quad,
+                                                      gradients_quad);
+        else
+          Eval::template integrate<true, false, false>(n_components,
+                                                       n_dofs,
+                                                       n_q_points,
+                                                       shape_data,
+                                                       values_dofs_actual,
+                                                       values_quad,
+                                                       gradients_quad);
+      }
+    else if (integrate_gradients)
+      {
+        if (add_into_values_array)
+          Eval::template integrate<false, true, true>(n_components,
+                                                      n_dofs,
+                                                      n_q_points,
+                                                      shape_data,
+                                                      values_dofs_actual,
+                                                      values_quad,
+                                                      gradients_quad);
+        else
+          Eval::template integrate<false, true, false>(n_components,
+                                                       n_dofs,
+                                                       n_q_points,
+                                                       shape_data,
+                                                       values_dofs_actual,
+                                                       values_quad,
+                                                       gradients_quad);
       }
   }
 
@@ -4403,6 +4625,117 @@ namespace internal
     }
   };
 
+
+
+  /**
+   * This struct implements the interpolation of hanging-node constraints
+   * on continuous elements, based on the compressed constraint mask stored
+   * in MatrixFreeFunctions::DoFInfo::hanging_node_constraint_masks. Before
+   * the call, the entries on the refined side of a face or edge shared with
+   * a coarser cell hold the values of the coarser neighbor. The
+   * interpolation replaces them line by line with one-dimensional kernels
+   * along the three coordinate directions, using the matrix
+   * UnivariateShapeData::subface_interpolation_matrix. The transposed
+   * operation is used during integration. The same mask is applied to all
+   * SIMD lanes.
+   */
+  template <int dim, typename Number>
+  struct FEEvaluationImplHangingNodes
+  {
+    /**
+     * Apply the interpolation to the @p n_desired_components components
+     * stored one after the other in @p values. The array @p tmp must
+     * provide space for <tt>2 * (fe_degree + 1)</tt> entries.
+     */
+    template <bool transpose>
+    static void
+    run(const unsigned int           n_desired_components,
+        const unsigned int           fe_degree,
+        const unsigned short         constraint_mask,
+        const AlignedVector<Number> &weights,
+        Number *                     tmp,
+        Number *                     values)
+    {
+      using namespace MatrixFreeFunctions;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      AssertDimension(weights.size(), n_dofs_1d * n_dofs_1d);
+      const unsigned int dofs_per_component =
+        Utilities::fixed_power<dim>(n_dofs_1d);
+
+      const unsigned short type_bits[3] = {constr_type_x,
+                                           constr_type_y,
+                                           constr_type_z};
+      const unsigned short face_bits[3] = {constr_face_x,
+                                           constr_face_y,
+                                           constr_face_z};
+      const unsigned short edge_bits[3] = {constr_edge_yz,
+                                           constr_edge_zx,
+                                           constr_edge_xy};
+
+      for (unsigned int comp = 0; comp < n_desired_components; ++comp)
+        for (unsigned int direction = 0; direction < dim; ++direction)
+          {
+            // the lines along 'direction' that are constrained lie on the
+            // faces with the other two directions as normal, or on an edge
+            // shared by those faces
+            const unsigned int dir1 = (direction + 1) % dim;
+            const unsigned int dir2 = (direction + 2) % dim;
+            const unsigned int face1 = face_bits[dir1];
+            const unsigned int face2 = dim == 3 ? face_bits[dir2] : 0;
+            const unsigned int edge = dim == 3 ? edge_bits[direction] : 0;
+            if ((constraint_mask & (face1 | face2 | edge)) == 0)
+              continue;
+
+            const unsigned int stride  = Utilities::pow(n_dofs_1d, direction);
+            const unsigned int stride1 = Utilities::pow(n_dofs_1d, dir1);
+            const unsigned int stride2 =
+              dim == 3 ? Utilities::pow(n_dofs_1d, dir2) : 0;
+            const bool type = constraint_mask & type_bits[direction];
+            const unsigned int position1 =
+              (constraint_mask & type_bits[dir1]) ? 0 : fe_degree;
+            const unsigned int position2 =
+              (constraint_mask & type_bits[dir2]) ? 0 : fe_degree;
+
+            Number *values_comp = values + comp * dofs_per_component;
+            for (unsigned int i2 = 0; i2 < (dim == 3 ? n_dofs_1d : 1); ++i2)
+              for (unsigned int i1 = 0; i1 < n_dofs_1d; ++i1)
+                {
+                  const bool on_face1 = i1 == position1;
+                  const bool on_face2 = dim == 3 && i2 == position2;
+                  if (!(((constraint_mask & face1) && on_face1) ||
+                        ((constraint_mask & face2) && on_face2) ||
+                        ((constraint_mask & edge) && on_face1 && on_face2)))
+                    continue;
+
+                  Number *line = values_comp + i1 * stride1 + i2 * stride2;
+                  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                    tmp[i] = line[i * stride];
+
+                  Number *result = tmp + n_dofs_1d;
+                  for (unsigned int k = 0; k < n_dofs_1d; ++k)
+                    {
+                      Number sum = Number();
+                      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                        {
+                          // the interpolation matrix is given for the lower
+                          // child; the upper one is obtained by symmetry
+                          const unsigned int row =
+                            type ? (transpose ? i : k) :
+                                   fe_degree - (transpose ? i : k);
+                          const unsigned int col =
+                            type ? (transpose ? k : i) :
+                                   fe_degree - (transpose ? k : i);
+                          sum += weights[row * n_dofs_1d + col] * tmp[i];
+                        }
+                      result[k] = sum;
+                    }
+                  for (unsigned int k = 0; k < n_dofs_1d; ++k)
+                    line[k * stride] = result[k];
+                }
+          }
+    }
+  };
+
 } // end of namespace internal
 
 
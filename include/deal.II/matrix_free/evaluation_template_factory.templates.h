@@ -20,6 +20,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/matrix_free/evaluation_kernel_cache.h>
 #include <deal.II/matrix_free/evaluation_kernels.h>
 #include <deal.II/matrix_free/evaluation_selector.h>
 #include <deal.II/matrix_free/evaluation_template_factory.h>
@@ -65,6 +66,22 @@ namespace internal
 
 
 
+  /**
+   * Return whether instantiation_helper_run() has a precompiled kernel for
+   * the given degree and number of quadrature points.
+   */
+  inline bool
+  has_precompiled_kernel(const unsigned int fe_degree,
+                         const unsigned int n_q_points_1d)
+  {
+    return fe_degree >= 1 && fe_degree <= FE_EVAL_FACTORY_DEGREE_MAX &&
+           (n_q_points_1d == fe_degree + 1 || n_q_points_1d == fe_degree + 2 ||
+            n_q_points_1d == fe_degree ||
+            n_q_points_1d == (3 * fe_degree) / 2 + 1);
+  }
+
+
+
   template <int dim, typename Number, typename VectorizedArrayType>
   void
   FEEvaluationFactory<dim, Number, VectorizedArrayType>::evaluate(
@@ -77,6 +94,24 @@ namespace internal
     VectorizedArrayType *hessians_quad,
     VectorizedArrayType *scratch_data)
   {
+    // use kernels generated at run time instead of the slow path
+    if (has_precompiled_kernel(shape_info.data[0].fe_degree,
+                               shape_info.data[0].n_q_points_1d) == false)
+      if (const auto kernels =
+            RuntimeEvaluationKernels<dim, VectorizedArrayType>::find(
+              shape_info.data[0].fe_degree, shape_info.data[0].n_q_points_1d))
+        {
+          kernels->evaluate(n_components,
+                            evaluation_flag,
+                            shape_info,
+                            values_dofs_actual,
+                            values_quad,
+                            gradients_quad,
+                            hessians_quad,
+                            scratch_data);
+          return;
+        }
+
     instantiation_helper_run<
       1,
       FEEvaluationImplEvaluateSelector<dim, VectorizedArrayType>>(
@@ -106,6 +141,23 @@ namespace internal
     VectorizedArrayType *scratch_data,
     const bool           sum_into_values_array)
   {
+    if (has_precompiled_kernel(shape_info.data[0].fe_degree,
+                               shape_info.data[0].n_q_points_1d) == false)
+      if (const auto kernels =
+            RuntimeEvaluationKernels<dim, VectorizedArrayType>::find(
+              shape_info.data[0].fe_degree, shape_info.data[0].n_q_points_1d))
+        {
+          kernels->integrate(n_components,
+                             integration_flag,
+                             shape_info,
+                             values_dofs_actual,
+                             values_quad,
+                             gradients_quad,
+                             scratch_data,
+                             sum_into_values_array);
+          return;
+        }
+
     instantiation_helper_run<
       1,
       FEEvaluationImplIntegrateSelector<dim, VectorizedArrayType>>(
@@ -491,6 +491,29 @@ protected:
                     MappingDataOnTheFly<dim, Number, VectorizedArrayType>>
     mapped_geometry;
 
+  /**
+   * Compute the inverse Jacobians and the JxW values on the cell batch with
+   * index @p cell_index from the support points of the mapping stored in
+   * MappingInfo and let the pointers @p jacobian and @p J_value point to the
+   * result. Only used on cells with general geometry if
+   * MatrixFree::AdditionalData::compute_jacobians_on_the_fly was set.
+   */
+  void
+  compute_jacobians_from_support_points(const unsigned int cell_index);
+
+  /**
+   * Storage for the inverse Jacobians filled by
+   * compute_jacobians_from_support_points().
+   */
+  AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobian_buffer;
+
+  /**
+   * Storage for the JxW values filled by
+   * compute_jacobians_from_support_points(), followed by temporary data of
+   * the evaluation of the geometry.
+   */
+  AlignedVector<VectorizedArrayType> geometry_buffer;
+
   // Make FEEvaluation objects friends for access to protected member
   // mapped_geometry.
   template <int, int, int, int, typename, typename>
@@ -1255,6 +1278,32 @@ protected:
     const VectorOperation &                        operation,
     const std::array<VectorType *, n_components_> &vectors) const;
 
+  /**
+   * Return whether any of the cells in the current cell batch has its
+   * hanging-node constraints described by a mask in
+   * internal::MatrixFreeFunctions::DoFInfo::hanging_node_constraint_masks,
+   * see MatrixFree::AdditionalData::use_fast_hanging_node_algorithm.
+   */
+  bool
+  has_hanging_node_constraints() const;
+
+  /**
+   * Apply the interpolation of the hanging nodes described by the masks of
+   * the current cell batch to the dof values, or the transpose operation if
+   * @p transpose is true. SIMD lanes with the same mask are processed
+   * together.
+   */
+  void
+  apply_hanging_node_constraints(const bool transpose) const;
+
+  /**
+   * Temporary storage used by apply_hanging_node_constraints() and
+   * distribute_local_to_global() on cells with hanging nodes. The first
+   * part holds a copy of the dof values of all components, followed by the
+   * values of one component and the data of one line.
+   */
+  mutable AlignedVector<VectorizedArrayType> hanging_node_buffer;
+
   /**
    * This field stores the values for local degrees of freedom (e.g. after
    * reading out from a vector but before applying unit cell transformations
@@ -2342,6 +2391,40 @@ protected:
  * @p std::vector should be used, <code>src[0], src[1], ...,
  * src[n_components-1]</code>.
  *
+ * The same mechanism allows to apply a scalar operator to several vectors at
+ * once, e.g., for block Krylov methods, multiple right hand sides, or
+ * ensembles of simulations. Rather than running one MatrixFree::cell_loop()
+ * per vector, the @p k vectors are collected in an @p std::vector or a
+ * LinearAlgebra::distributed::BlockVector and passed to a single loop, whose
+ * cell function uses an FEEvaluation object with @p k components on the
+ * scalar element:
+ *
+ * @code
+ * FEEvaluation<dim,fe_degree,n_q_points_1d,k> phi(matrix_free);
+ * for (unsigned int cell=cell_range.first; cell<cell_range.second; ++cell)
+ *   {
+ *     phi.reinit(cell);
+ *     phi.read_dof_values(src);
+ *     phi.evaluate(EvaluationFlags::gradients);
+ *     for (unsigned int q=0; q<phi.n_q_points; ++q)
+ *       phi.submit_gradient(phi.get_gradient(q), q);
+ *     phi.integrate(EvaluationFlags::gradients);
+ *     phi.distribute_local_to_global(dst);
+ *   }
+ * @endcode
+ *
+ * In this setting, the DoF indices and the constraint information of each
+ * cell batch are read only once for all @p k vectors, the mapping data is
+ * loaded once in reinit() and shared by the quadrature point operations of
+ * all vectors, and the sum factorization kernels run over all components
+ * while the shape function tables are in cache. The memory traffic of
+ * everything except the vector entries themselves is thus reduced by a
+ * factor of @p k compared to @p k separate loops, and the ghost exchanges of
+ * the @p k vectors are started together by the loop. Note that this only
+ * applies to scalar elements: for a DoFHandler based on an FESystem, the
+ * components of FEEvaluation refer to the components of the element and
+ * are read from a single vector.
+ *
  * An alternative way for reading multi-component systems is possible if the
  * DoFHandler underlying the MatrixFree data is based on an FESystem of @p
  * n_components entries. In that case, a single vector is provided for the
@@ -4060,6 +4143,71 @@ FEEvaluationBaseData<dim, Number, is_face, VectorizedArrayType>::
 }
 
 
+
+template <int dim, typename Number, bool is_face, typename VectorizedArrayType>
+inline void
+FEEvaluationBaseData<dim, Number, is_face, VectorizedArrayType>::
+  compute_jacobians_from_support_points(const unsigned int cell_index)
+{
+  static_assert(is_face == false,
+                "Jacobians can only be reconstructed for cell integrals");
+
+  const internal::MatrixFreeFunctions::ShapeInfo<VectorizedArrayType>
+    &                shape_info       = mapping_data->mapping_shape_info;
+  const unsigned int n_mapping_points = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_q_points       = shape_info.n_q_points;
+  AssertDimension(n_q_points, n_quadrature_points);
+  AssertIndexRange(cell_index,
+                   mapping_data->mapping_support_point_offsets.size());
+  Assert(mapping_data->mapping_support_point_offsets[cell_index] !=
+           numbers::invalid_unsigned_int,
+         ExcInternalError());
+
+  // layout of the buffer: JxW values, support points, values, gradients,
+  // scratch data of the tensor product kernels
+  jacobian_buffer.resize_fast(n_q_points);
+  geometry_buffer.resize_fast(n_q_points +
+                              dim * (n_mapping_points + (dim + 1) * n_q_points +
+                                     2 * n_q_points + 3 * n_mapping_points));
+  VectorizedArrayType *JxW            = geometry_buffer.begin();
+  VectorizedArrayType *support_points = JxW + n_q_points;
+  VectorizedArrayType *values         = support_points + dim * n_mapping_points;
+  VectorizedArrayType *gradients      = values + dim * n_q_points;
+  VectorizedArrayType *scratch        = gradients + dim * dim * n_q_points;
+
+  std::copy_n(mapping_data->mapping_support_points.begin() +
+                mapping_data->mapping_support_point_offsets[cell_index],
+              dim * n_mapping_points,
+              support_points);
+  internal::MatrixFreeFunctions::count_bytes(
+    internal::MatrixFreeFunctions::counted_mapping_bytes,
+    dim * n_mapping_points * sizeof(VectorizedArrayType));
+
+  internal::FEEvaluationFactory<dim, Number, VectorizedArrayType>::evaluate(
+    dim,
+    EvaluationFlags::gradients,
+    shape_info,
+    support_points,
+    values,
+    gradients,
+    nullptr,
+    scratch);
+
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    {
+      Tensor<2, dim, VectorizedArrayType> jac;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          jac[d][e] = gradients[q + (d * dim + e) * n_q_points];
+      JxW[q]             = determinant(jac) * quadrature_weights[q];
+      jacobian_buffer[q] = transpose(invert(jac));
+    }
+
+  jacobian = jacobian_buffer.begin();
+  J_value  = JxW;
+}
+
+
 /*----------------------- FEEvaluationBase ----------------------------------*/
 
 template <int dim,
@@ -4412,17 +4560,33 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       internal::check_vector_compatibility(*src[0], *this->dof_info);
     }
 
+  internal::MatrixFreeFunctions::count_bytes(
+    internal::MatrixFreeFunctions::counted_vector_bytes,
+    std::uint64_t(mask.count()) * n_components *
+      this->data->dofs_per_component_on_cell * sizeof(Number));
+
+  // With hanging nodes resolved by FEEvaluation, the compressed index
+  // storage refers to the indices of the parent cells; the plain access
+  // must go through the unconstrained indices instead
+  const bool read_plain_hanging_nodes =
+    apply_constraints == false && this->has_hanging_node_constraints();
+
   // Case 2: contiguous indices which use reduced storage of indices and can
   // use vectorized load/store operations -> go to separate function
   AssertIndexRange(
     this->cell,
     this->dof_info->index_storage_variants[this->dof_access_index].size());
-  if (this->dof_info->index_storage_variants
+  if (read_plain_hanging_nodes == false &&
+      this->dof_info->index_storage_variants
         [is_face ? this->dof_access_index :
                    internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
         [this->cell] >=
       internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::contiguous)
     {
+      // only the first index of each lane is read
+      internal::MatrixFreeFunctions::count_bytes(
+        internal::MatrixFreeFunctions::counted_index_bytes,
+        mask.count() * sizeof(unsigned int));
       read_write_operation_contiguous(operation, src, src_sm, mask);
       return;
     }
@@ -4434,17 +4598,24 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
          ExcNotImplemented("Masking currently not implemented for "
                            "non-contiguous DoF storage"));
 
+  internal::MatrixFreeFunctions::count_bytes(
+    internal::MatrixFreeFunctions::counted_index_bytes,
+    std::uint64_t(n_lanes) * n_components *
+      this->data->dofs_per_component_on_cell * sizeof(unsigned int));
+
   std::integral_constant<bool,
                          internal::is_vectorizable<VectorType, Number>::value>
     vector_selector;
 
   const unsigned int dofs_per_component =
     this->data->dofs_per_component_on_cell;
-  if (this->dof_info->index_storage_variants
-        [is_face ? this->dof_access_index :
-                   internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
-        [this->cell] ==
-      internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::interleaved)
+  if (read_plain_hanging_nodes == false &&
+      this->dof_info->index_storage_variants
+          [is_face ? this->dof_access_index :
+                     internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
+          [this->cell] ==
+        internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
+          interleaved)
     {
       const unsigned int *dof_indices =
         this->dof_info->dof_indices_interleaved.data() +
@@ -4545,6 +4716,9 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
         dof_indices[v] = nullptr;
     }
 
+  if (read_plain_hanging_nodes)
+    has_constraints = true;
+
   // Case where we have no constraints throughout the whole cell: Can go
   // through the list of DoFs directly
   if (!has_constraints)
@@ -4600,9 +4774,11 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       // For read_dof_values_plain, redirect the dof_indices field to the
       // unconstrained indices
       if (apply_constraints == false &&
-          this->dof_info->row_starts[cell_dof_index].second !=
-            this->dof_info->row_starts[cell_dof_index + n_components_read]
-              .second)
+          (this->dof_info->row_starts[cell_dof_index].second !=
+             this->dof_info->row_starts[cell_dof_index + n_components_read]
+               .second ||
+           (this->dof_info->hanging_node_constraint_masks.empty() == false &&
+            this->dof_info->hanging_node_constraint_masks[cell_index] != 0)))
         {
           Assert(this->dof_info->row_starts_plain_indices[cell_index] !=
                    numbers::invalid_unsigned_int,
@@ -5240,6 +5416,117 @@ namespace internal
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline bool
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  has_hanging_node_constraints() const
+{
+  if (is_face || this->dof_info == nullptr ||
+      this->dof_info->hanging_node_constraint_masks.empty())
+    return false;
+
+  constexpr unsigned int n_lanes = VectorizedArrayType::size();
+  AssertIndexRange((this->cell + 1) * n_lanes - 1,
+                   this->dof_info->hanging_node_constraint_masks.size());
+  const unsigned short *masks =
+    this->dof_info->hanging_node_constraint_masks.data() + this->cell * n_lanes;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    if (masks[v] != 0)
+      return true;
+  return false;
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  apply_hanging_node_constraints(const bool transpose) const
+{
+  constexpr unsigned int n_lanes = VectorizedArrayType::size();
+  const unsigned short * masks =
+    this->dof_info->hanging_node_constraint_masks.data() + this->cell * n_lanes;
+
+  const internal::MatrixFreeFunctions::UnivariateShapeData<VectorizedArrayType>
+    &                shape_data = this->data->data.front();
+  const unsigned int fe_degree  = shape_data.fe_degree;
+  const unsigned int dofs_per_component =
+    this->data->dofs_per_component_on_cell;
+  Assert(shape_data.subface_interpolation_matrix.size() ==
+           (fe_degree + 1) * (fe_degree + 1),
+         ExcMessage("The element does not provide the interpolation matrix "
+                    "needed to resolve hanging nodes."));
+
+  hanging_node_buffer.resize_fast((n_components + 1) * dofs_per_component +
+                                  2 * (fe_degree + 1));
+  VectorizedArrayType *component_values =
+    hanging_node_buffer.begin() + n_components * dofs_per_component;
+  VectorizedArrayType *line_values = component_values + dofs_per_component;
+
+  // run through the distinct masks in the batch; all lanes with the same
+  // mask are processed at once
+  std::bitset<n_lanes> lanes_done;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    if (masks[v] == 0)
+      lanes_done[v] = true;
+
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    if (lanes_done[v] == false)
+      {
+        const unsigned short mask = masks[v];
+        std::bitset<n_lanes> lanes_with_mask;
+        for (unsigned int w = v; w < n_lanes; ++w)
+          if (masks[w] == mask)
+            lanes_with_mask[w] = true;
+        lanes_done |= lanes_with_mask;
+
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          {
+            // if not all lanes share the mask, interpolate a copy and only
+            // write back the entries of the affected lanes
+            VectorizedArrayType *values = lanes_with_mask.all() ?
+                                            this->values_dofs[comp] :
+                                            component_values;
+            if (values == component_values)
+              for (unsigned int i = 0; i < dofs_per_component; ++i)
+                values[i] = this->values_dofs[comp][i];
+
+            if (transpose)
+              internal::FEEvaluationImplHangingNodes<dim, VectorizedArrayType>::
+                template run<true>(1,
+                                   fe_degree,
+                                   mask,
+                                   shape_data.subface_interpolation_matrix,
+                                   line_values,
+                                   values);
+            else
+              internal::FEEvaluationImplHangingNodes<dim, VectorizedArrayType>::
+                template run<false>(1,
+                                    fe_degree,
+                                    mask,
+                                    shape_data.subface_interpolation_matrix,
+                                    line_values,
+                                    values);
+
+            if (values == component_values)
+              for (unsigned int w = 0; w < n_lanes; ++w)
+                if (lanes_with_mask[w])
+                  for (unsigned int i = 0; i < dofs_per_component; ++i)
+                    this->values_dofs[comp][i][w] = values[i][w];
+          }
+      }
+}
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -5265,6 +5552,9 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                        std::bitset<VectorizedArrayType::size()>().flip(),
                        true);
 
+  if (this->has_hanging_node_constraints())
+    apply_hanging_node_constraints(false);
+
 #  ifdef DEBUG
   dof_values_initialized = true;
 #  endif
@@ -5332,7 +5622,32 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   internal::VectorDistributorLocalToGlobal<Number, VectorizedArrayType>
     distributor;
-  read_write_operation(distributor, dst_data.first, dst_data.second, mask);
+
+  // on cells with hanging nodes, apply the transpose interpolation to the
+  // dof values before the summation into the vector, and restore the
+  // values afterwards since this function does not modify the object
+  if (this->has_hanging_node_constraints())
+    {
+      const unsigned int dofs_per_component =
+        this->data->dofs_per_component_on_cell;
+      const unsigned int fe_degree = this->data->data.front().fe_degree;
+      hanging_node_buffer.resize_fast((n_components + 1) * dofs_per_component +
+                                      2 * (fe_degree + 1));
+      for (unsigned int comp = 0; comp < n_components; ++comp)
+        std::copy(this->values_dofs[comp],
+                  this->values_dofs[comp] + dofs_per_component,
+                  hanging_node_buffer.begin() + comp * dofs_per_component);
+
+      apply_hanging_node_constraints(true);
+      read_write_operation(distributor, dst_data.first, dst_data.second, mask);
+
+      for (unsigned int comp = 0; comp < n_components; ++comp)
+        std::copy(hanging_node_buffer.begin() + comp * dofs_per_component,
+                  hanging_node_buffer.begin() + (comp + 1) * dofs_per_component,
+                  this->values_dofs[comp]);
+    }
+  else
+    read_write_operation(distributor, dst_data.first, dst_data.second, mask);
 }
 
 
@@ -5362,6 +5677,12 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     this->active_fe_index,
     this->dof_info);
 
+  Assert(this->has_hanging_node_constraints() == false,
+         ExcMessage("set_dof_values() is not implemented on cells with "
+                    "hanging nodes resolved by "
+                    "AdditionalData::use_fast_hanging_node_algorithm, "
+                    "use set_dof_values_plain() instead."));
+
   internal::VectorSetter<Number, VectorizedArrayType> setter;
   read_write_operation(setter, dst_data.first, dst_data.second, mask);
 }
@@ -7751,10 +8072,25 @@ FEEvaluation<dim,
   this->cell_type =
     this->matrix_info->get_mapping_info().get_cell_type(cell_index);
 
-  const unsigned int offsets =
-    this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
+  if (this->cell_type == internal::MatrixFreeFunctions::general &&
+      this->mapping_data->mapping_support_point_offsets.empty() == false)
+    this->compute_jacobians_from_support_points(cell_index);
+  else
+    {
+      const unsigned int offsets =
+        this->mapping_data->data_index_offsets[cell_index];
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+
+      // general cells store the data in all quadrature points, affine and
+      // Cartesian cells a single Jacobian and JxW value
+      internal::MatrixFreeFunctions::count_bytes(
+        internal::MatrixFreeFunctions::counted_mapping_bytes,
+        (this->cell_type == internal::MatrixFreeFunctions::general ?
+           this->n_quadrature_points :
+           1) *
+          (dim * dim + 1) * sizeof(VectorizedArrayType));
+    }
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -8621,6 +8957,14 @@ FEFaceEvaluation<dim,
     &this->mapping_data
        ->normals_times_jacobians[!this->is_interior_face][offsets];
 
+  // JxW value, normal vector, Jacobian and normal times Jacobian
+  internal::MatrixFreeFunctions::count_bytes(
+    internal::MatrixFreeFunctions::counted_mapping_bytes,
+    (this->cell_type == internal::MatrixFreeFunctions::general ?
+       this->n_quadrature_points :
+       1) *
+      (1 + 2 * dim + dim * dim) * sizeof(VectorizedArrayType));
+
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
   this->values_quad_initialized    = false;
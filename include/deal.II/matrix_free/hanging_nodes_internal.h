@@ -0,0 +1,767 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 - 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_matrix_free_hanging_nodes_internal_h
+#define dealii_matrix_free_hanging_nodes_internal_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/dof_info.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * This class creates the mask used in the treatment of hanging nodes in
+     * MatrixFree. For every cell, it identifies the faces and (in 3D) edges
+     * where the cell is adjacent to a coarser cell, replaces the indices of
+     * the hanging degrees of freedom by the ones of the coarser neighbor,
+     * and compresses the configuration into the bits constr_type_x etc. The
+     * interpolation from the coarse to the fine side is then applied on the
+     * fly by FEEvaluation with one-dimensional kernels. The implementation
+     * follows the one in CUDAWrappers::internal::HangingNodes, which is
+     * explained in <em>Section 3 of Matrix-Free Finite-Element Computations
+     * On Graphics Processors With Adaptively Refined Unstructured
+     * Meshes</em> by Karl Ljungkvist, SpringSim-HPC, 2017 April 23-26.
+     *
+     * The algorithm is restricted to elements that consist of a single base
+     * element of type FE_Q (possibly with several components) on a mesh
+     * without anisotropic refinement.
+     */
+    template <int dim>
+    class HangingNodes
+    {
+    public:
+      /**
+       * Constructor. The DoFHandler must be based on an element for which
+       * check_support() returns true.
+       */
+      HangingNodes(const DoFHandler<dim> &dof_handler);
+
+      /**
+       * Return whether the element is supported by the algorithm.
+       */
+      static bool
+      check_support(const FiniteElement<dim> &fe);
+
+      /**
+       * Compute the value of the constraint mask for the given cell. If the
+       * cell has hanging nodes, the entries of @p dof_indices (in the
+       * numbering of the element as returned by
+       * DoFCellAccessor::get_dof_indices()) are replaced by the indices of
+       * the coarser neighbor. The mask is only set if all replaced indices
+       * are constrained in @p constraints, which ensures that the user
+       * actually requested hanging-node constraints. Otherwise, zero is
+       * returned and @p dof_indices is left unchanged.
+       */
+      template <typename number>
+      unsigned short
+      setup_constraints(
+        const typename DoFHandler<dim>::cell_iterator &cell,
+        const dealii::AffineConstraints<number> &      constraints,
+        std::vector<types::global_dof_index> &         dof_indices) const;
+
+    private:
+      using cell_iterator = typename DoFHandler<dim>::cell_iterator;
+
+      /**
+       * Set up line-to-cell mapping for edge constraints in 3D.
+       */
+      void
+      setup_line_to_cell();
+
+      void
+      rotate_subface_index(int times, unsigned int &subface_index) const;
+
+      void
+      rotate_face(int                                   times,
+                  unsigned int                          n_dofs_1d,
+                  std::vector<types::global_dof_index> &dofs) const;
+
+      unsigned int
+      line_dof_idx(int          local_line,
+                   unsigned int dof,
+                   unsigned int n_dofs_1d) const;
+
+      void
+      transpose_face(std::vector<types::global_dof_index> &dofs) const;
+
+      void
+      transpose_subface_index(unsigned int &subface) const;
+
+      const DoFHandler<dim> &dof_handler;
+      const unsigned int     fe_degree;
+      const unsigned int     n_components;
+
+      /**
+       * Lexicographic to hierarchic numbering of a scalar FE_Q on cells
+       * and faces.
+       */
+      const std::vector<unsigned int> lexicographic_mapping;
+      const std::vector<unsigned int> lexicographic_face_mapping;
+
+      /**
+       * Index of the shape function of the (possibly vector-valued) element
+       * given a component and the index within the scalar base element, on
+       * cells and faces, respectively.
+       */
+      std::vector<std::vector<unsigned int>> component_to_system_index;
+      std::vector<std::pair<unsigned int, unsigned int>>
+        face_system_to_component_index;
+
+      std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+        line_to_cells;
+    };
+
+
+
+    template <int dim>
+    inline HangingNodes<dim>::HangingNodes(const DoFHandler<dim> &dof_handler)
+      : dof_handler(dof_handler)
+      , fe_degree(dof_handler.get_fe().degree)
+      , n_components(dof_handler.get_fe().n_components())
+      , lexicographic_mapping(
+          FETools::lexicographic_to_hierarchic_numbering<dim>(fe_degree))
+      , lexicographic_face_mapping(
+          FETools::lexicographic_to_hierarchic_numbering<dim - 1>(fe_degree))
+    {
+      const FiniteElement<dim> &fe = dof_handler.get_fe();
+      Assert(check_support(fe), ExcNotImplemented());
+
+      component_to_system_index.resize(
+        n_components,
+        std::vector<unsigned int>(fe.base_element(0).n_dofs_per_cell()));
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          const auto comp = fe.system_to_component_index(i);
+          component_to_system_index[comp.first][comp.second] = i;
+        }
+
+      face_system_to_component_index.resize(fe.n_dofs_per_face(0));
+      for (unsigned int i = 0; i < fe.n_dofs_per_face(0); ++i)
+        face_system_to_component_index[i] =
+          fe.face_system_to_component_index(i, 0);
+
+      // Set up line-to-cell mapping for edge constraints (only if dim = 3)
+      setup_line_to_cell();
+    }
+
+
+
+    template <int dim>
+    inline bool
+    HangingNodes<dim>::check_support(const FiniteElement<dim> &fe)
+    {
+      return dim > 1 && fe.n_base_elements() == 1 &&
+             dynamic_cast<const FE_Q<dim> *>(&fe.base_element(0)) != nullptr;
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::setup_line_to_cell()
+    {}
+
+
+
+    template <>
+    inline void
+    HangingNodes<3>::setup_line_to_cell()
+    {
+      // In 3D, we can have DoFs on only an edge being constrained (e.g. in a
+      // cartesian 2x2x2 grid, where only the upper left 2 cells are refined).
+      // This sets up a helper data structure in the form of a mapping from
+      // edges (i.e. lines) to neighboring cells.
+
+      // Mapping from an edge to which children that share that edge.
+      const unsigned int line_to_children[12][2] = {{0, 2},
+                                                    {1, 3},
+                                                    {0, 1},
+                                                    {2, 3},
+                                                    {4, 6},
+                                                    {5, 7},
+                                                    {4, 5},
+                                                    {6, 7},
+                                                    {0, 4},
+                                                    {1, 5},
+                                                    {2, 6},
+                                                    {3, 7}};
+
+      const unsigned int n_raw_lines =
+        dof_handler.get_triangulation().n_raw_lines();
+      line_to_cells.resize(n_raw_lines);
+      std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+        line_to_inactive_cells(n_raw_lines);
+
+      // First add active and inactive cells to their lines:
+      for (const auto &cell : dof_handler.cell_iterators())
+        {
+          for (unsigned int line = 0; line < GeometryInfo<3>::lines_per_cell;
+               ++line)
+            {
+              const unsigned int line_idx = cell->line(line)->index();
+              if (cell->is_active())
+                line_to_cells[line_idx].push_back(std::make_pair(cell, line));
+              else
+                line_to_inactive_cells[line_idx].push_back(
+                  std::make_pair(cell, line));
+            }
+        }
+
+      // Now, we can access edge-neighboring active cells on same level to also
+      // access of an edge to the edges "children". These are found from looking
+      // at the corresponding edge of children of inactive edge neighbors.
+      for (unsigned int line_idx = 0; line_idx < n_raw_lines; ++line_idx)
+        {
+          if ((line_to_cells[line_idx].size() > 0) &&
+              line_to_inactive_cells[line_idx].size() > 0)
+            {
+              // We now have cells to add (active ones) and edges to which they
+              // should be added (inactive cells).
+              const cell_iterator &inactive_cell =
+                line_to_inactive_cells[line_idx][0].first;
+              const unsigned int neighbor_line =
+                line_to_inactive_cells[line_idx][0].second;
+
+              for (unsigned int c = 0; c < 2; ++c)
+                {
+                  const cell_iterator &child =
+                    inactive_cell->child(line_to_children[neighbor_line][c]);
+                  const unsigned int child_line_idx =
+                    child->line(neighbor_line)->index();
+
+                  // Now add all active cells
+                  for (const auto &cl : line_to_cells[line_idx])
+                    line_to_cells[child_line_idx].push_back(cl);
+                }
+            }
+        }
+    }
+
+
+
+    template <int dim>
+    template <typename number>
+    inline unsigned short
+    HangingNodes<dim>::setup_constraints(
+      const cell_iterator &                     cell,
+      const dealii::AffineConstraints<number> & constraints,
+      std::vector<types::global_dof_index> &    dof_indices) const
+    {
+      unsigned short     mask      = 0;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      const unsigned int dofs_per_face =
+        Utilities::fixed_power<dim - 1>(n_dofs_1d);
+      const unsigned int dofs_per_component =
+        Utilities::fixed_power<dim>(n_dofs_1d);
+      AssertDimension(dof_indices.size(), dofs_per_component * n_components);
+
+      // Work on a copy of the indices of all components in lexicographic
+      // order
+      std::vector<types::global_dof_index> lex_dofs(dof_indices.size());
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int i = 0; i < dofs_per_component; ++i)
+          lex_dofs[c * dofs_per_component + i] =
+            dof_indices[component_to_system_index[c][lexicographic_mapping[i]]];
+
+      std::vector<types::global_dof_index> face_dofs(
+        face_system_to_component_index.size());
+      std::vector<types::global_dof_index> neighbor_dofs(dofs_per_face);
+
+      for (const unsigned int face : GeometryInfo<dim>::face_indices())
+        {
+          if ((!cell->at_boundary(face)) &&
+              (cell->neighbor(face)->has_children() == false))
+            {
+              const cell_iterator neighbor = cell->neighbor(face);
+
+              // Neighbor is coarser than us, i.e., face is constrained
+              if (neighbor->level() < cell->level())
+                {
+                  // We cannot access the unknowns on artificial cells, so
+                  // leave the constraints to the general code path
+                  if (neighbor->is_artificial())
+                    return 0;
+
+                  const unsigned int neighbor_face =
+                    cell->neighbor_face_no(face);
+
+                  // Find position of face on neighbor
+                  unsigned int subface = 0;
+                  for (; subface < GeometryInfo<dim>::max_children_per_face;
+                       ++subface)
+                    if (neighbor->neighbor_child_on_subface(neighbor_face,
+                                                            subface) == cell)
+                      break;
+
+                  // Get indices to read
+                  neighbor->face(neighbor_face)->get_dof_indices(face_dofs);
+
+                  int  rotate    = 0;
+                  bool transpose = false;
+                  if (dim == 2)
+                    {
+                      if (face < 2)
+                        {
+                          mask |= constr_face_x;
+                          if (face == 0)
+                            mask |= constr_type_x;
+                          if (subface == 0)
+                            mask |= constr_type_y;
+                        }
+                      else
+                        {
+                          mask |= constr_face_y;
+                          if (face == 2)
+                            mask |= constr_type_y;
+                          if (subface == 0)
+                            mask |= constr_type_x;
+                        }
+                    }
+                  else if (dim == 3)
+                    {
+                      transpose = !(cell->face_orientation(face));
+
+                      if (cell->face_rotation(face))
+                        rotate -= 1;
+                      if (cell->face_flip(face))
+                        rotate -= 2;
+
+                      rotate_subface_index(rotate, subface);
+                      if (transpose)
+                        transpose_subface_index(subface);
+
+                      // YZ-plane
+                      if (face < 2)
+                        {
+                          mask |= constr_face_x;
+                          if (face == 0)
+                            mask |= constr_type_x;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_y;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_z;
+                        }
+                      // XZ-plane
+                      else if (face < 4)
+                        {
+                          mask |= constr_face_y;
+                          if (face == 2)
+                            mask |= constr_type_y;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_z;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_x;
+                        }
+                      // XY-plane
+                      else
+                        {
+                          mask |= constr_face_z;
+                          if (face == 4)
+                            mask |= constr_type_z;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_x;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_y;
+                        }
+                    }
+                  else
+                    Assert(false, ExcNotImplemented());
+
+                  // Offset if upper/right/back face
+                  const unsigned int offset = (face % 2 == 1) ? fe_degree : 0;
+
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    {
+                      // Extract the indices of the current component in the
+                      // hierarchical numbering of the scalar face element
+                      for (unsigned int i = 0; i < face_dofs.size(); ++i)
+                        if (face_system_to_component_index[i].first == c)
+                          neighbor_dofs
+                            [face_system_to_component_index[i].second] =
+                              face_dofs[i];
+
+                      types::global_dof_index *component_dofs =
+                        lex_dofs.data() + c * dofs_per_component;
+
+                      if (dim == 2)
+                        {
+                          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                            {
+                              unsigned int idx = 0;
+                              // If X-line, i.e., if y = 0 or y = fe_degree
+                              if (face > 1)
+                                idx = n_dofs_1d * offset + i;
+                              // If Y-line, i.e., if x = 0 or x = fe_degree
+                              else
+                                idx = n_dofs_1d * i + offset;
+
+                              component_dofs[idx] =
+                                neighbor_dofs[lexicographic_face_mapping[i]];
+                            }
+                        }
+                      else
+                        {
+                          rotate_face(rotate, n_dofs_1d, neighbor_dofs);
+                          if (transpose)
+                            transpose_face(neighbor_dofs);
+
+                          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                            for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                              {
+                                unsigned int idx = 0;
+                                // If YZ-plane, i.e., if x = 0 or x =
+                                // fe_degree, and orientation standard
+                                if (face < 2)
+                                  idx = n_dofs_1d * n_dofs_1d * i +
+                                        n_dofs_1d * j + offset;
+                                // If XZ-plane, i.e., if y = 0 or y =
+                                // fe_degree, and orientation standard
+                                else if (face < 4)
+                                  idx = n_dofs_1d * n_dofs_1d * j +
+                                        n_dofs_1d * offset + i;
+                                // If XY-plane, i.e., if z = 0 or z =
+                                // fe_degree, and orientation standard
+                                else
+                                  idx = n_dofs_1d * n_dofs_1d * offset +
+                                        n_dofs_1d * i + j;
+
+                                component_dofs[idx] = neighbor_dofs
+                                  [lexicographic_face_mapping[n_dofs_1d * i +
+                                                              j]];
+                              }
+                        }
+                    }
+                }
+            }
+        }
+
+      // In 3D we can have a situation where only DoFs on an edge are
+      // constrained. Append these here.
+      if (dim == 3)
+        {
+          // For each line on cell, which faces does it belong to, what is the
+          // edge mask, what is the types of the faces it belong to, and what is
+          // the type along the edge.
+          const unsigned int line_to_edge[12][4] = {
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_x | constr_type_z,
+             constr_type_y},
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_z,
+             constr_type_y},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_y | constr_type_z,
+             constr_type_x},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_z,
+             constr_type_x},
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_x,
+             constr_type_y},
+            {constr_face_x | constr_face_z, constr_edge_zx, 0, constr_type_y},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_y,
+             constr_type_x},
+            {constr_face_y | constr_face_z, constr_edge_yz, 0, constr_type_x},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_x | constr_type_y,
+             constr_type_z},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_y,
+             constr_type_z},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_x,
+             constr_type_z},
+            {constr_face_x | constr_face_y, constr_edge_xy, 0, constr_type_z}};
+
+          std::vector<types::global_dof_index> neighbor_cell_dofs;
+
+          for (unsigned int local_line = 0;
+               local_line < GeometryInfo<dim>::lines_per_cell;
+               ++local_line)
+            {
+              // If we don't already have a constraint for as part of a face
+              if (!(mask & line_to_edge[local_line][0]))
+                {
+                  // For each cell which share that edge
+                  const unsigned int line = cell->line(local_line)->index();
+                  for (const auto &edge_neighbor : line_to_cells[line])
+                    {
+                      // If one of them is coarser than us
+                      const cell_iterator neighbor_cell = edge_neighbor.first;
+                      if (neighbor_cell->level() < cell->level())
+                        {
+                          if (neighbor_cell->is_artificial())
+                            return 0;
+
+                          const unsigned int local_line_neighbor =
+                            edge_neighbor.second;
+                          mask |= line_to_edge[local_line][1] |
+                                  line_to_edge[local_line][2];
+
+                          bool flipped = false;
+                          if (cell->line(local_line)->vertex_index(0) ==
+                              neighbor_cell->line(local_line_neighbor)
+                                ->vertex_index(0))
+                            {
+                              // Assuming line directions match axes directions,
+                              // we have an unflipped edge of first type
+                              mask |= line_to_edge[local_line][3];
+                            }
+                          else if (cell->line(local_line)->vertex_index(1) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(1))
+                            {
+                              // We have an unflipped edge of second type
+                            }
+                          else if (cell->line(local_line)->vertex_index(1) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(0))
+                            {
+                              // We have a flipped edge of second type
+                              flipped = true;
+                            }
+                          else if (cell->line(local_line)->vertex_index(0) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(1))
+                            {
+                              // We have a flipped edge of first type
+                              mask |= line_to_edge[local_line][3];
+                              flipped = true;
+                            }
+                          else
+                            Assert(false, ExcInternalError());
+
+                          // Copy the unconstrained values
+                          neighbor_cell_dofs.resize(
+                            dofs_per_component * n_components);
+                          neighbor_cell->get_dof_indices(neighbor_cell_dofs);
+
+                          for (unsigned int c = 0; c < n_components; ++c)
+                            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                              {
+                                // Get local dof index along line
+                                const unsigned int idx =
+                                  line_dof_idx(local_line, i, n_dofs_1d);
+                                lex_dofs[c * dofs_per_component + idx] =
+                                  neighbor_cell_dofs
+                                    [component_to_system_index
+                                       [c][lexicographic_mapping[line_dof_idx(
+                                         local_line_neighbor,
+                                         flipped ? fe_degree - i : i,
+                                         n_dofs_1d)]]];
+                              }
+
+                          // Stop looping over edge neighbors
+                          break;
+                        }
+                    }
+                }
+            }
+        }
+
+      if (mask == 0)
+        return 0;
+
+      // Only use the mask if the replaced unknowns are subject to
+      // constraints, i.e., hanging-node constraints have been requested by
+      // the user
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int i = 0; i < dofs_per_component; ++i)
+          {
+            const unsigned int system_index =
+              component_to_system_index[c][lexicographic_mapping[i]];
+            const types::global_dof_index original = dof_indices[system_index];
+            if (lex_dofs[c * dofs_per_component + i] != original &&
+                constraints.is_constrained(original) == false)
+              return 0;
+          }
+
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int i = 0; i < dofs_per_component; ++i)
+          dof_indices[component_to_system_index[c][lexicographic_mapping[i]]] =
+            lex_dofs[c * dofs_per_component + i];
+
+      return mask;
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::rotate_subface_index(int           times,
+                                            unsigned int &subface_index) const
+    {
+      const unsigned int rot_mapping[4] = {2, 0, 3, 1};
+
+      times = times % 4;
+      times = times < 0 ? times + 4 : times;
+      for (int t = 0; t < times; ++t)
+        subface_index = rot_mapping[subface_index];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::rotate_face(
+      int                                   times,
+      unsigned int                          n_dofs_1d,
+      std::vector<types::global_dof_index> &dofs) const
+    {
+      const unsigned int rot_mapping[4] = {2, 0, 3, 1};
+
+      times = times % 4;
+      times = times < 0 ? times + 4 : times;
+
+      std::vector<types::global_dof_index> copy(dofs.size());
+      for (int t = 0; t < times; ++t)
+        {
+          std::swap(copy, dofs);
+
+          // Vertices
+          for (unsigned int i = 0; i < 4; ++i)
+            dofs[rot_mapping[i]] = copy[i];
+
+          // Edges
+          const unsigned int n_int  = n_dofs_1d - 2;
+          unsigned int       offset = 4;
+          for (unsigned int i = 0; i < n_int; ++i)
+            {
+              // Left edge
+              dofs[offset + i] = copy[offset + 2 * n_int + (n_int - 1 - i)];
+              // Right edge
+              dofs[offset + n_int + i] =
+                copy[offset + 3 * n_int + (n_int - 1 - i)];
+              // Bottom edge
+              dofs[offset + 2 * n_int + i] = copy[offset + n_int + i];
+              // Top edge
+              dofs[offset + 3 * n_int + i] = copy[offset + i];
+            }
+
+          // Interior points
+          offset += 4 * n_int;
+
+          for (unsigned int i = 0; i < n_int; ++i)
+            for (unsigned int j = 0; j < n_int; ++j)
+              dofs[offset + i * n_int + j] =
+                copy[offset + j * n_int + (n_int - 1 - i)];
+        }
+    }
+
+
+
+    template <int dim>
+    inline unsigned int
+    HangingNodes<dim>::line_dof_idx(int          local_line,
+                                    unsigned int dof,
+                                    unsigned int n_dofs_1d) const
+    {
+      unsigned int x, y, z;
+
+      if (local_line < 8)
+        {
+          x =
+            (local_line % 4 == 0) ? 0 : (local_line % 4 == 1) ? fe_degree : dof;
+          y =
+            (local_line % 4 == 2) ? 0 : (local_line % 4 == 3) ? fe_degree : dof;
+          z = (local_line / 4) * fe_degree;
+        }
+      else
+        {
+          x = ((local_line - 8) % 2) * fe_degree;
+          y = ((local_line - 8) / 2) * fe_degree;
+          z = dof;
+        }
+
+      return n_dofs_1d * n_dofs_1d * z + n_dofs_1d * y + x;
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::transpose_face(
+      std::vector<types::global_dof_index> &dofs) const
+    {
+      const std::vector<types::global_dof_index> copy(dofs);
+
+      // Vertices
+      dofs[1] = copy[2];
+      dofs[2] = copy[1];
+
+      // Edges
+      const unsigned int n_int  = fe_degree - 1;
+      unsigned int       offset = 4;
+      for (unsigned int i = 0; i < n_int; ++i)
+        {
+          // Right edge
+          dofs[offset + i] = copy[offset + 2 * n_int + i];
+          // Left edge
+          dofs[offset + n_int + i] = copy[offset + 3 * n_int + i];
+          // Bottom edge
+          dofs[offset + 2 * n_int + i] = copy[offset + i];
+          // Top edge
+          dofs[offset + 3 * n_int + i] = copy[offset + n_int + i];
+        }
+
+      // Interior
+      offset += 4 * n_int;
+      for (unsigned int i = 0; i < n_int; ++i)
+        for (unsigned int j = 0; j < n_int; ++j)
+          dofs[offset + i * n_int + j] = copy[offset + j * n_int + i];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::transpose_subface_index(unsigned int &subface) const
+    {
+      if (subface == 1)
+        subface = 2;
+      else if (subface == 2)
+        subface = 1;
+    }
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
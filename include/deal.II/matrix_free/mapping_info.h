@@ -25,6 +25,7 @@
 #include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_dgq.h>
 #include <deal.II/fe/mapping.h>
 
 #include <deal.II/grid/reference_cell.h>
@@ -34,6 +35,7 @@
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/helper_functions.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
 
@@ -291,12 +293,52 @@ namespace internal
        */
       AlignedVector<Point<spacedim, VectorizedArrayType>> quadrature_points;
 
+      /**
+       * Stores the index offset of a particular cell batch into the array
+       * @p mapping_support_points. Only filled if the Jacobians of cells
+       * with general geometry are reconstructed on the fly, in which case
+       * the entries for Cartesian and affine cells are set to
+       * numbers::invalid_unsigned_int.
+       */
+      AlignedVector<unsigned int> mapping_support_point_offsets;
+
+      /**
+       * Stores the support points of the mapping on cells with general
+       * geometry, with <code>dim * n_mapping_points</code> entries per cell
+       * batch ordered component by component in the lexicographic order of
+       * the points of an FE_DGQ element of the mapping degree. When these
+       * points are present, the fields @p JxW_values and @p jacobians do
+       * not hold data for general cells and the Jacobians are computed in
+       * FEEvaluation::reinit() instead.
+       *
+       * Indexed by @p mapping_support_point_offsets.
+       */
+      AlignedVector<VectorizedArrayType> mapping_support_points;
+
+      /**
+       * The interpolation matrices from @p mapping_support_points to the
+       * quadrature points of this quadrature formula.
+       */
+      ShapeInfo<VectorizedArrayType> mapping_shape_info;
+
       /**
        * Clears all data fields except the descriptor vector.
        */
       void
       clear_data_fields();
 
+      /**
+       * Copy all data from @p other, which is stored in a different number
+       * type with the same number of SIMD lanes, converting the geometry
+       * fields to the number type of this class.
+       */
+      template <typename Number2, typename VectorizedArrayType2>
+      void
+      copy_from(const MappingInfoStorage<structdim,
+                                         spacedim,
+                                         Number2,
+                                         VectorizedArrayType2> &other);
+
       /**
        * Returns the quadrature index for a given number of quadrature
        * points. If not in hp-mode or if the index is not found, this
@@ -352,13 +394,22 @@ namespace internal
         const UpdateFlags update_flags_cells,
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
-        const UpdateFlags update_flags_faces_by_cells);
+        const UpdateFlags update_flags_faces_by_cells,
+        const bool        compute_jacobians_on_the_fly = false,
+        const bool        incremental_mapping_update   = false);
 
       /**
        * Update the information in the given cells and faces that is the
        * result of a change in the given `mapping` class, keeping the cells,
        * quadrature formulas and other unknowns unchanged. This call is only
        * valid if MappingInfo::initialize() has been called before.
+       *
+       * If @p incremental_mapping_update is set and the mapping is a
+       * MappingQGeneric or derived class, only the geometry of the cell
+       * batches whose mapping support points have changed since the last
+       * call, and of the faces adjacent to them, is recomputed, provided
+       * that the classification into Cartesian/affine/general cells is the
+       * same as before. Otherwise, all data is computed again.
        */
       void
       update_mapping(
@@ -380,6 +431,19 @@ namespace internal
       void
       clear();
 
+      /**
+       * Copy all data from @p other, which is stored in a different number
+       * type with the same number of SIMD lanes, converting the geometry
+       * fields to the number type of this class. The pointers to the mapping
+       * and the quadrature formulas are kept, such that a subsequent call
+       * to update_mapping() recomputes the data in the number type of this
+       * class.
+       */
+      template <typename Number2, typename VectorizedArrayType2>
+      void
+      copy_from(
+        const MappingInfo<dim, Number2, VectorizedArrayType2> &other);
+
       /**
        * Return the memory consumption of this class in bytes.
        */
@@ -418,6 +482,42 @@ namespace internal
        */
       UpdateFlags update_flags_faces_by_cells;
 
+      /**
+       * Stores whether only the support points of the mapping are kept for
+       * cells with general geometry, with the Jacobians reconstructed on the
+       * fly, see MatrixFree::AdditionalData::compute_jacobians_on_the_fly.
+       */
+      bool compute_jacobians_on_the_fly;
+
+      /**
+       * Stores whether update_mapping() only recomputes the data of cells
+       * that have moved, see
+       * MatrixFree::AdditionalData::incremental_mapping_update.
+       */
+      bool incremental_mapping_update;
+
+      /**
+       * The mapping support points of all cells, in the layout of the cell
+       * batches, as computed by the last call to compute_mapping_q(). Only
+       * filled if @p incremental_mapping_update is set, and used to detect
+       * the cells that have moved.
+       */
+      AlignedVector<double> cached_mapping_support_points;
+
+      /**
+       * The compression index of each cell's geometry data as computed by
+       * the last call to compute_mapping_q(). Only filled if @p
+       * incremental_mapping_update is set.
+       */
+      std::vector<unsigned int> cached_cell_data_index;
+
+      /**
+       * The geometry type of each cell (before grouping into batches) as
+       * computed by the last call to compute_mapping_q(). Only filled if @p
+       * incremental_mapping_update is set.
+       */
+      std::vector<GeometryType> cached_cell_type;
+
       /**
        * Stores whether a cell is Cartesian (cell type 0), has constant
        * transform data (Jacobians) (cell type 1), or is general (cell type
@@ -490,13 +590,19 @@ namespace internal
        *
        * @param faces The description of the connectivity from faces to cells
        * as filled in the MatrixFree class
+       *
+       * @param is_update Specifies whether the function is called from
+       * update_mapping(), in which case the data of unchanged cells is kept
+       * if @p incremental_mapping_update is set and the cell types have not
+       * changed
        */
       void
       compute_mapping_q(
         const dealii::Triangulation<dim> &                        tria,
         const std::vector<std::pair<unsigned int, unsigned int>> &cells,
         const std::vector<FaceToCellTopology<VectorizedArrayType::size()>>
-          &faces);
+          &        faces,
+        const bool is_update = false);
 
       /**
        * Computes the information in the given cells, called within
@@ -524,13 +630,18 @@ namespace internal
 
       /**
        * Computes the information in the given faces, called within
-       * initialize.
+       * initialize. The work is split into as many chunks of cell batches as
+       * there are threads. If @p cell_batch_changed is not empty, only the
+       * cell batches marked by a nonzero entry are computed, while the data
+       * of all other cell batches is kept.
        */
       void
       initialize_faces_by_cells(
         const dealii::Triangulation<dim> &                        tria,
         const std::vector<std::pair<unsigned int, unsigned int>> &cells,
-        const dealii::hp::MappingCollection<dim> &                mapping);
+        const dealii::hp::MappingCollection<dim> &                mapping,
+        const std::vector<unsigned char> &cell_batch_changed =
+          std::vector<unsigned char>());
 
       /**
        * Helper function to determine which update flags must be set in the
@@ -676,6 +787,170 @@ namespace internal
       return cell_type[cell_no];
     }
 
+
+
+    // Helper functions to convert the geometry data between number types
+    // with the same number of SIMD lanes
+    namespace MappingInfoConversion
+    {
+      template <typename Number, typename Number2>
+      inline typename std::enable_if<std::is_arithmetic<Number>::value>::type
+      convert(const Number2 &in, Number &out)
+      {
+        out = in;
+      }
+
+      template <typename Number,
+                std::size_t width,
+                typename Number2,
+                std::size_t width2>
+      inline void
+      convert(const VectorizedArray<Number2, width2> &in,
+              VectorizedArray<Number, width> &        out)
+      {
+        static_assert(width == width2,
+                      "The number of SIMD lanes must coincide.");
+        for (unsigned int v = 0; v < width; ++v)
+          out[v] = in[v];
+      }
+
+      template <int rank, int dim, typename Number, typename Number2>
+      inline void
+      convert(const Tensor<rank, dim, Number2> &in,
+              Tensor<rank, dim, Number> &       out)
+      {
+        for (unsigned int d = 0; d < dim; ++d)
+          convert(in[d], out[d]);
+      }
+
+      template <typename T, typename T2>
+      inline void
+      convert(const AlignedVector<T2> &in, AlignedVector<T> &out)
+      {
+        out.resize_fast(in.size());
+        for (unsigned int i = 0; i < in.size(); ++i)
+          convert(in[i], out[i]);
+      }
+
+      template <int dim, typename VectorizedArrayType>
+      inline void
+      reinit_mapping_shape_info(std::true_type,
+                                const Quadrature<dim> &         quadrature,
+                                const unsigned int              degree,
+                                ShapeInfo<VectorizedArrayType> &shape_info)
+      {
+        shape_info.reinit(quadrature, FE_DGQ<dim>(degree));
+      }
+
+      template <int structdim, typename VectorizedArrayType>
+      inline void
+      reinit_mapping_shape_info(std::false_type,
+                                const Quadrature<structdim> &,
+                                const unsigned int,
+                                ShapeInfo<VectorizedArrayType> &)
+      {
+        Assert(false, ExcInternalError());
+      }
+    } // namespace MappingInfoConversion
+
+
+
+    template <int structdim,
+              int spacedim,
+              typename Number,
+              typename VectorizedArrayType>
+    template <typename Number2, typename VectorizedArrayType2>
+    inline void
+    MappingInfoStorage<structdim, spacedim, Number, VectorizedArrayType>::
+      copy_from(const MappingInfoStorage<structdim,
+                                         spacedim,
+                                         Number2,
+                                         VectorizedArrayType2> &other)
+    {
+      static_assert(VectorizedArrayType::size() ==
+                      VectorizedArrayType2::size(),
+                    "The number of SIMD lanes must coincide.");
+      using namespace MappingInfoConversion;
+
+      descriptor.resize(other.descriptor.size());
+      for (unsigned int i = 0; i < descriptor.size(); ++i)
+        {
+          descriptor[i].n_q_points    = other.descriptor[i].n_q_points;
+          descriptor[i].quadrature_1d = other.descriptor[i].quadrature_1d;
+          descriptor[i].quadrature    = other.descriptor[i].quadrature;
+          for (unsigned int d = 0; d < structdim; ++d)
+            convert(other.descriptor[i].tensor_quadrature_weights[d],
+                    descriptor[i].tensor_quadrature_weights[d]);
+          convert(other.descriptor[i].quadrature_weights,
+                  descriptor[i].quadrature_weights);
+          descriptor[i].face_orientations =
+            other.descriptor[i].face_orientations;
+        }
+      q_collection       = other.q_collection;
+      data_index_offsets = other.data_index_offsets;
+      convert(other.JxW_values, JxW_values);
+      convert(other.normal_vectors, normal_vectors);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          convert(other.jacobians[i], jacobians[i]);
+          convert(other.jacobian_gradients[i], jacobian_gradients[i]);
+          convert(other.normals_times_jacobians[i], normals_times_jacobians[i]);
+        }
+      quadrature_point_offsets = other.quadrature_point_offsets;
+      convert(other.quadrature_points, quadrature_points);
+      mapping_support_point_offsets = other.mapping_support_point_offsets;
+      convert(other.mapping_support_points, mapping_support_points);
+
+      // the interpolation matrices for the Jacobians computed on the fly
+      // are cheap to set up, so compute them again in the new number type
+      if (other.mapping_shape_info.data.empty() == false)
+        reinit_mapping_shape_info(
+          std::integral_constant<bool, structdim == spacedim>(),
+          descriptor[0].quadrature,
+          other.mapping_shape_info.data.front().fe_degree,
+          mapping_shape_info);
+      else
+        mapping_shape_info = ShapeInfo<VectorizedArrayType>();
+    }
+
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    template <typename Number2, typename VectorizedArrayType2>
+    inline void
+    MappingInfo<dim, Number, VectorizedArrayType>::copy_from(
+      const MappingInfo<dim, Number2, VectorizedArrayType2> &other)
+    {
+      update_flags_cells           = other.update_flags_cells;
+      update_flags_boundary_faces  = other.update_flags_boundary_faces;
+      update_flags_inner_faces     = other.update_flags_inner_faces;
+      update_flags_faces_by_cells  = other.update_flags_faces_by_cells;
+      compute_jacobians_on_the_fly = other.compute_jacobians_on_the_fly;
+      incremental_mapping_update   = other.incremental_mapping_update;
+      cell_type                    = other.cell_type;
+      face_type                    = other.face_type;
+
+      // the cached support points are always kept in double precision and
+      // can be taken over as they are
+      cached_mapping_support_points = other.cached_mapping_support_points;
+      cached_cell_data_index        = other.cached_cell_data_index;
+      cached_cell_type              = other.cached_cell_type;
+
+      cell_data.resize(other.cell_data.size());
+      for (unsigned int i = 0; i < cell_data.size(); ++i)
+        cell_data[i].copy_from(other.cell_data[i]);
+      face_data.resize(other.face_data.size());
+      for (unsigned int i = 0; i < face_data.size(); ++i)
+        face_data[i].copy_from(other.face_data[i]);
+      face_data_by_cells.resize(other.face_data_by_cells.size());
+      for (unsigned int i = 0; i < face_data_by_cells.size(); ++i)
+        face_data_by_cells[i].copy_from(other.face_data_by_cells[i]);
+
+      mapping_collection   = other.mapping_collection;
+      mapping              = other.mapping;
+      reference_cell_types = other.reference_cell_types;
+    }
+
   } // end of namespace MatrixFreeFunctions
 } // end of namespace internal
 
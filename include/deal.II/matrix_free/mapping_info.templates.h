@@ -175,6 +175,8 @@ namespace internal
         }
       quadrature_point_offsets.clear();
       quadrature_points.clear();
+      mapping_support_point_offsets.clear();
+      mapping_support_points.clear();
     }
 
 
@@ -198,7 +200,10 @@ namespace internal
              MemoryConsumption::memory_consumption(normals_times_jacobians[0]) +
              MemoryConsumption::memory_consumption(normals_times_jacobians[1]) +
              MemoryConsumption::memory_consumption(quadrature_point_offsets) +
-             MemoryConsumption::memory_consumption(quadrature_points);
+             MemoryConsumption::memory_consumption(quadrature_points) +
+             MemoryConsumption::memory_consumption(
+               mapping_support_point_offsets) +
+             MemoryConsumption::memory_consumption(mapping_support_points);
     }
 
 
@@ -258,6 +263,19 @@ namespace internal
             MemoryConsumption::memory_consumption(quadrature_point_offsets) +
               MemoryConsumption::memory_consumption(quadrature_points));
         }
+
+      const std::size_t support_point_size =
+        Utilities::MPI::sum(mapping_support_points.size(),
+                            task_info.communicator);
+      if (support_point_size > 0)
+        {
+          out << "      Memory mapping support points: ";
+          task_info.print_memory_statistics(
+            out,
+            MemoryConsumption::memory_consumption(
+              mapping_support_point_offsets) +
+              MemoryConsumption::memory_consumption(mapping_support_points));
+        }
     }
 
 
@@ -273,8 +291,13 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
-      mapping_collection = nullptr;
-      mapping            = nullptr;
+      mapping_collection           = nullptr;
+      mapping                      = nullptr;
+      compute_jacobians_on_the_fly = false;
+      incremental_mapping_update   = false;
+      cached_mapping_support_points.clear();
+      cached_cell_data_index.clear();
+      cached_cell_type.clear();
     }
 
 
@@ -338,11 +361,15 @@ namespace internal
       const UpdateFlags update_flags_cells,
       const UpdateFlags update_flags_boundary_faces,
       const UpdateFlags update_flags_inner_faces,
-      const UpdateFlags update_flags_faces_by_cells)
+      const UpdateFlags update_flags_faces_by_cells,
+      const bool        compute_jacobians_on_the_fly,
+      const bool        incremental_mapping_update)
     {
       clear();
-      this->mapping_collection = mapping;
-      this->mapping            = &mapping->operator[](0);
+      this->mapping_collection           = mapping;
+      this->mapping                      = &mapping->operator[](0);
+      this->compute_jacobians_on_the_fly = compute_jacobians_on_the_fly;
+      this->incremental_mapping_update   = incremental_mapping_update;
 
       cell_data.resize(quad.size());
       face_data.resize(quad.size());
@@ -474,21 +501,25 @@ namespace internal
       AssertDimension(cells.size() / VectorizedArrayType::size(),
                       cell_type.size());
 
-      for (auto &data : cell_data)
-        data.clear_data_fields();
-      for (auto &data : face_data)
-        data.clear_data_fields();
-      for (auto &data : face_data_by_cells)
-        data.clear_data_fields();
-
       this->mapping_collection = mapping;
       this->mapping            = &mapping->operator[](0);
 
+      // the fast path decides itself which data can be kept
       if (active_fe_index.empty() && !cells.empty() && mapping->size() == 1 &&
           dynamic_cast<const MappingQGeneric<dim> *>(&mapping->operator[](0)))
-        compute_mapping_q(tria, cells, face_info.faces);
+        compute_mapping_q(tria, cells, face_info.faces, true);
       else
         {
+          for (auto &data : cell_data)
+            data.clear_data_fields();
+          for (auto &data : face_data)
+            data.clear_data_fields();
+          for (auto &data : face_data_by_cells)
+            data.clear_data_fields();
+          cached_mapping_support_points.clear();
+          cached_cell_data_index.clear();
+          cached_cell_type.clear();
+
           // Could call these functions in parallel, but not useful because
           // the work inside is nicely split up already
           initialize_cells(tria, cells, active_fe_index, *mapping);
@@ -1387,6 +1418,11 @@ namespace internal
           shape_info.dofs_per_component_on_cell;
         constexpr unsigned int hess_dim = dim * (dim + 1) / 2;
 
+        // if the support points are kept, the Jacobians on general cells are
+        // reconstructed by FEEvaluation and need not be stored here
+        const bool store_support_points =
+          my_data.mapping_support_point_offsets.empty() == false;
+
         AlignedVector<VectorizedDouble> cell_points(dim * n_mapping_points);
         AlignedVector<VectorizedDouble> cell_quads(dim * n_q_points);
         AlignedVector<VectorizedDouble> cell_grads(dim * dim * n_q_points);
@@ -1422,6 +1458,17 @@ namespace internal
                     cell_grad_grads.data(),
                     scratch_data.data());
                 }
+              if (store_support_points && cell_type[cell] > affine &&
+                  process_cell[cell])
+                {
+                  VectorizedArrayType *support_points =
+                    my_data.mapping_support_points.data() +
+                    my_data.mapping_support_point_offsets[cell];
+                  for (unsigned int i = 0; i < dim * n_mapping_points; ++i)
+                    store_vectorized_array(cell_points[i],
+                                           vv,
+                                           support_points[i]);
+                }
               if (update_flags_cells & update_quadrature_points)
                 {
                   Point<dim, VectorizedArrayType> *quadrature_points =
@@ -1444,7 +1491,8 @@ namespace internal
 
               const unsigned int n_points =
                 cell_type[cell] <= affine ? 1 : n_q_points;
-              if (process_cell[cell])
+              if (process_cell[cell] &&
+                  (cell_type[cell] <= affine || store_support_points == false))
                 for (unsigned int q = 0; q < n_points; ++q)
                   {
                     const unsigned int idx =
@@ -1521,6 +1569,40 @@ namespace internal
             }
       }
 
+
+
+      /**
+       * Call @p function on the contiguous sub-ranges of [begin, end) whose
+       * entries in @p marked are nonzero, or on the full range if @p marked
+       * is empty. This is used by the incremental update of the mapping
+       * data to skip the cell batches and faces that have not changed.
+       */
+      template <typename FunctionType>
+      void
+      apply_to_marked_ranges(const unsigned int                begin,
+                             const unsigned int                end,
+                             const std::vector<unsigned char> &marked,
+                             const FunctionType &              function)
+      {
+        if (marked.empty())
+          {
+            function(begin, end);
+            return;
+          }
+
+        for (unsigned int i = begin; i < end;)
+          if (marked[i] == 0)
+            ++i;
+          else
+            {
+              unsigned int range_end = i + 1;
+              while (range_end < end && marked[range_end] != 0)
+                ++range_end;
+              function(i, range_end);
+              i = range_end;
+            }
+      }
+
     } // namespace ExtractCellHelper
 
 
@@ -2705,7 +2787,9 @@ namespace internal
     MappingInfo<dim, Number, VectorizedArrayType>::compute_mapping_q(
       const dealii::Triangulation<dim> &                        tria,
       const std::vector<std::pair<unsigned int, unsigned int>> &cell_array,
-      const std::vector<FaceToCellTopology<VectorizedArrayType::size()>> &faces)
+      const std::vector<FaceToCellTopology<VectorizedArrayType::size()>>
+        &        faces,
+      const bool is_update)
     {
       // step 1: extract quadrature point data with the data appropriate for
       // MappingQGeneric
@@ -2764,14 +2848,82 @@ namespace internal
                                                         preliminary_cell_type);
       }
 
+      constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+      // step 1b: in case of an update, check whether the compression and
+      // the cell types are the same as in the previous computation. Then,
+      // the layout of all data fields stays the same and we only need to
+      // recompute the cell batches whose mapping support points have
+      // changed, as well as the faces next to them. The comparison is exact
+      // on purpose, as any change of the geometry must be reflected in the
+      // data.
+      const bool keep_layout =
+        is_update && incremental_mapping_update &&
+        cached_mapping_support_points.size() ==
+          plain_quadrature_points.size() &&
+        cached_cell_data_index == cell_data_index &&
+        cached_cell_type == preliminary_cell_type;
+
+      // a nonzero entry marks a cell (in the numbering of cell_array) or a
+      // cell batch to be recomputed; we use unsigned char rather than bool
+      // to allow concurrent writes
+      std::vector<unsigned char> cell_changed, cell_batch_changed;
+      if (keep_layout)
+        {
+          cell_changed.resize(cell_array.size());
+          cell_batch_changed.resize(cell_array.size() / n_lanes);
+          const std::size_t n_entries = n_mapping_points * dim;
+          dealii::parallel::apply_to_subranges(
+            0U,
+            cell_batch_changed.size(),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int batch = begin; batch < end; ++batch)
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    const unsigned int cell  = batch * n_lanes + v;
+                    const double *     point = plain_quadrature_points.data() +
+                                          cell * n_entries;
+                    if (!std::equal(point,
+                                    point + n_entries,
+                                    cached_mapping_support_points.data() +
+                                      cell * n_entries))
+                      {
+                        cell_changed[cell]        = 1;
+                        cell_batch_changed[batch] = 1;
+                      }
+                  }
+            },
+            std::max(cell_batch_changed.size() / MultithreadInfo::n_threads() /
+                       2,
+                     std::size_t(2U)));
+        }
+      else
+        {
+          for (auto &data : cell_data)
+            data.clear_data_fields();
+          for (auto &data : face_data)
+            data.clear_data_fields();
+          for (auto &data : face_data_by_cells)
+            data.clear_data_fields();
+        }
+
+      // keep the data of this computation for the next update, once all
+      // data has been computed
+      const auto store_cache = [&]() {
+        if (incremental_mapping_update)
+          {
+            cached_mapping_support_points.swap(plain_quadrature_points);
+            cached_cell_data_index.swap(cell_data_index);
+            cached_cell_type.swap(preliminary_cell_type);
+          }
+      };
+
       // step 2: compute the appropriate evaluation matrices for cells and
       // faces
 
       // We want to use vectorization for computing the quantities, but must
       // evaluate the geometry in double precision; thus, for floats we need
       // to do things in two sweeps and convert the final result.
-      constexpr unsigned int n_lanes = VectorizedArrayType::size();
-
       using VectorizedDouble =
         VectorizedArray<double,
                         ((std::is_same<Number, float>::value &&
@@ -2822,6 +2974,13 @@ namespace internal
                               preliminary_cell_type.data() + cell + n_lanes);
         }
 
+      // The reconstruction of Jacobians in FEEvaluation does not provide
+      // the derivatives of the Jacobians, so we keep the full data in that
+      // case
+      const bool store_support_points =
+        compute_jacobians_on_the_fly &&
+        (update_flags_cells & update_jacobian_grads) == 0;
+
       // step 4: compute the data on cells from the cached quadrature
       // points, filling up all SIMD lanes as appropriate
       for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
@@ -2832,7 +2991,9 @@ namespace internal
           // step 4a: set the index offsets, find out how much to allocate,
           // and allocate the memory
           const unsigned int n_q_points = my_data.descriptor[0].n_q_points;
-          unsigned int       max_size   = 0;
+          const unsigned int n_general_points =
+            store_support_points ? 0 : n_q_points;
+          unsigned int max_size = 0;
           my_data.data_index_offsets.resize(cell_type.size());
           for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
             {
@@ -2844,7 +3005,32 @@ namespace internal
               max_size =
                 std::max(max_size,
                          my_data.data_index_offsets[cell] +
-                           (cell_type[cell] <= affine ? 2 : n_q_points));
+                           (cell_type[cell] <= affine ? 2 : n_general_points));
+            }
+
+          if (store_support_points)
+            {
+              my_data.mapping_support_point_offsets.resize(cell_type.size());
+              unsigned int n_support_points = 0;
+              for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+                if (cell_type[cell] <= affine)
+                  my_data.mapping_support_point_offsets[cell] =
+                    numbers::invalid_unsigned_int;
+                else if (process_cell[cell] == false)
+                  my_data.mapping_support_point_offsets[cell] =
+                    my_data.mapping_support_point_offsets
+                      [cell_data_index_vect[cell]];
+                else
+                  {
+                    my_data.mapping_support_point_offsets[cell] =
+                      n_support_points;
+                    n_support_points += dim * n_mapping_points;
+                  }
+              my_data.mapping_support_points.resize_fast(n_support_points);
+
+              FE_DGQ<dim> fe_geometry(mapping_degree);
+              my_data.mapping_shape_info.reinit(
+                my_data.descriptor[0].quadrature, fe_geometry);
             }
 
           my_data.JxW_values.resize_fast(max_size);
@@ -2873,25 +3059,35 @@ namespace internal
             0U,
             cell_type.size(),
             [&](const unsigned int begin, const unsigned int end) {
-              ExtractCellHelper::mapping_q_compute_range<dim,
-                                                         Number,
-                                                         VectorizedArrayType,
-                                                         VectorizedDouble>(
+              ExtractCellHelper::apply_to_marked_ranges(
                 begin,
                 end,
-                cell_type,
-                process_cell,
-                update_flags_cells,
-                plain_quadrature_points,
-                shape_infos[my_q],
-                my_data);
+                cell_batch_changed,
+                [&](const unsigned int range_begin,
+                    const unsigned int range_end) {
+                  ExtractCellHelper::mapping_q_compute_range<
+                    dim,
+                    Number,
+                    VectorizedArrayType,
+                    VectorizedDouble>(range_begin,
+                                      range_end,
+                                      cell_type,
+                                      process_cell,
+                                      update_flags_cells,
+                                      plain_quadrature_points,
+                                      shape_infos[my_q],
+                                      my_data);
+                });
             },
             std::max(cell_type.size() / MultithreadInfo::n_threads() / 2,
                      std::size_t(2U)));
         }
 
       if (faces.empty())
-        return;
+        {
+          store_cache();
+          return;
+        }
 
       // step 5: find compression of faces with vectorization
       std::map<std::array<unsigned int, 2 * n_lanes + 3>, unsigned int>
@@ -2944,6 +3140,26 @@ namespace internal
                          preliminary_cell_type[faces[face].cells_exterior[i]]);
         }
 
+      // step 5b: for an incremental update, mark the faces with at least one
+      // adjacent cell that has changed
+      std::vector<unsigned char> face_changed;
+      if (keep_layout)
+        {
+          face_changed.resize(faces.size());
+          for (unsigned int face = 0; face < faces.size(); ++face)
+            for (unsigned int i = 0; i < n_lanes; ++i)
+              if ((faces[face].cells_interior[i] !=
+                     numbers::invalid_unsigned_int &&
+                   cell_changed[faces[face].cells_interior[i]]) ||
+                  (faces[face].cells_exterior[i] !=
+                     numbers::invalid_unsigned_int &&
+                   cell_changed[faces[face].cells_exterior[i]]))
+                {
+                  face_changed[face] = 1;
+                  break;
+                }
+        }
+
       // step 6: compute the data on faces from the cached cell quadrature
       // points, filling up all SIMD lanes as appropriate
       for (unsigned int my_q = 0; my_q < face_data.size(); ++my_q)
@@ -3001,19 +3217,26 @@ namespace internal
             0U,
             face_type.size(),
             [&](const unsigned int begin, const unsigned int end) {
-              ExtractFaceHelper::mapping_q_compute_range<dim,
-                                                         Number,
-                                                         VectorizedArrayType,
-                                                         VectorizedDouble>(
+              ExtractCellHelper::apply_to_marked_ranges(
                 begin,
                 end,
-                faces,
-                face_type,
-                process_face,
-                update_flags_common,
-                plain_quadrature_points,
-                shape_infos[my_q],
-                my_data);
+                face_changed,
+                [&](const unsigned int range_begin,
+                    const unsigned int range_end) {
+                  ExtractFaceHelper::mapping_q_compute_range<
+                    dim,
+                    Number,
+                    VectorizedArrayType,
+                    VectorizedDouble>(range_begin,
+                                      range_end,
+                                      faces,
+                                      face_type,
+                                      process_face,
+                                      update_flags_common,
+                                      plain_quadrature_points,
+                                      shape_infos[my_q],
+                                      my_data);
+                });
             },
             std::max(face_type.size() / MultithreadInfo::n_threads() / 2,
                      std::size_t(2U)));
@@ -3058,7 +3281,12 @@ namespace internal
       // transitioned to extracting the information from cell quadrature
       // points but we need to figure out the correct indices of neighbors
       // within the list of arrays still
-      initialize_faces_by_cells(tria, cell_array, *this->mapping_collection);
+      initialize_faces_by_cells(tria,
+                                cell_array,
+                                *this->mapping_collection,
+                                cell_batch_changed);
+
+      store_cache();
     }
 
 
@@ -3068,7 +3296,8 @@ namespace internal
     MappingInfo<dim, Number, VectorizedArrayType>::initialize_faces_by_cells(
       const dealii::Triangulation<dim> &                        tria,
       const std::vector<std::pair<unsigned int, unsigned int>> &cells,
-      const dealii::hp::MappingCollection<dim> &                mapping_in)
+      const dealii::hp::MappingCollection<dim> &                mapping_in,
+      const std::vector<unsigned char> &cell_batch_changed)
     {
       if (update_flags_faces_by_cells == update_default)
         return;
@@ -3148,185 +3377,208 @@ namespace internal
               face_data_by_cells[my_q].descriptor[0].n_q_points);
         }
 
-      FE_Nothing<dim> dummy_fe;
-      // currently no hp-indices implemented
-      const unsigned int fe_index = 0;
-      std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
-        fe_face_values(face_data_by_cells.size());
-      for (unsigned int i = 0; i < fe_face_values.size(); ++i)
-        fe_face_values[i].resize(face_data_by_cells[i].descriptor.size());
-      std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
-        fe_face_values_neigh(face_data_by_cells.size());
-      for (unsigned int i = 0; i < fe_face_values_neigh.size(); ++i)
-        fe_face_values_neigh[i].resize(face_data_by_cells[i].descriptor.size());
+      // collect the cell batches to be computed, and split the work into as
+      // many chunks as we have threads, as the setup of FEFaceValues is
+      // expensive
+      std::vector<unsigned int> cell_batches;
+      cell_batches.reserve(cell_type.size());
       for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
-        for (unsigned int my_q = 0; my_q < face_data_by_cells.size(); ++my_q)
-          for (const unsigned int face : GeometryInfo<dim>::face_indices())
-            {
-              if (fe_face_values[my_q][fe_index].get() == nullptr)
-                fe_face_values[my_q][fe_index] =
-                  std::make_shared<dealii::FEFaceValues<dim>>(
-                    mapping,
-                    dummy_fe,
-                    face_data[my_q].q_collection[fe_index],
-                    update_flags);
-              if (fe_face_values_neigh[my_q][fe_index].get() == nullptr)
-                fe_face_values_neigh[my_q][fe_index] =
-                  std::make_shared<dealii::FEFaceValues<dim>>(
-                    mapping,
-                    dummy_fe,
-                    face_data[my_q].q_collection[fe_index],
-                    update_flags);
-              dealii::FEFaceValues<dim> &fe_val =
-                *fe_face_values[my_q][fe_index];
-              dealii::FEFaceValues<dim> &fe_val_neigh =
-                *fe_face_values_neigh[my_q][fe_index];
-              const unsigned int offset =
-                face_data_by_cells[my_q]
-                  .data_index_offsets[cell * GeometryInfo<dim>::faces_per_cell +
-                                      face];
-
-              for (unsigned int v = 0; v < n_lanes; ++v)
-                {
-                  typename dealii::Triangulation<dim>::cell_iterator cell_it(
-                    &tria,
-                    cells[cell * n_lanes + v].first,
-                    cells[cell * n_lanes + v].second);
-                  fe_val.reinit(cell_it, face);
-
-                  const bool is_local =
-                    (cell_it->is_active() ?
-                       cell_it->is_locally_owned() :
-                       cell_it->is_locally_owned_on_level()) &&
-                    (!cell_it->at_boundary(face) ||
-                     (cell_it->at_boundary(face) &&
-                      cell_it->has_periodic_neighbor(face)));
-
-                  if (is_local)
-                    {
-                      auto cell_it_neigh =
-                        cell_it->neighbor_or_periodic_neighbor(face);
-                      fe_val_neigh.reinit(cell_it_neigh,
-                                          cell_it->at_boundary(face) ?
-                                            cell_it->periodic_neighbor_face_no(
-                                              face) :
-                                            cell_it->neighbor_face_no(face));
-                    }
+        if (cell_batch_changed.empty() || cell_batch_changed[cell] != 0)
+          cell_batches.push_back(cell);
 
-                  // copy data for affine data type
-                  if (cell_type[cell] <= affine)
-                    {
-                      if (update_flags & update_JxW_values)
-                        face_data_by_cells[my_q].JxW_values[offset][v] =
-                          fe_val.JxW(0) / fe_val.get_quadrature().weight(0);
-                      if (update_flags & update_jacobians)
-                        {
-                          DerivativeForm<1, dim, dim> inv_jac =
-                            fe_val.jacobian(0).covariant_form();
-                          for (unsigned int d = 0; d < dim; ++d)
-                            for (unsigned int e = 0; e < dim; ++e)
-                              {
-                                const unsigned int ee = ExtractFaceHelper::
-                                  reorder_face_derivative_indices<dim>(face, e);
-                                face_data_by_cells[my_q]
-                                  .jacobians[0][offset][d][e][v] =
-                                  inv_jac[d][ee];
-                              }
-                        }
-                      if (is_local && (update_flags & update_jacobians))
-                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                             ++q)
+      const auto compute_range = [&](const unsigned int begin,
+                                     const unsigned int end) {
+        FE_Nothing<dim> dummy_fe;
+        // currently no hp-indices implemented
+        const unsigned int fe_index = 0;
+        std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
+          fe_face_values(face_data_by_cells.size());
+        for (unsigned int i = 0; i < fe_face_values.size(); ++i)
+          fe_face_values[i].resize(face_data_by_cells[i].descriptor.size());
+        std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
+          fe_face_values_neigh(face_data_by_cells.size());
+        for (unsigned int i = 0; i < fe_face_values_neigh.size(); ++i)
+          fe_face_values_neigh[i].resize(
+            face_data_by_cells[i].descriptor.size());
+        for (unsigned int i = begin; i < end; ++i)
+          for (unsigned int my_q = 0; my_q < face_data_by_cells.size(); ++my_q)
+            for (const unsigned int face : GeometryInfo<dim>::face_indices())
+              {
+                const unsigned int cell = cell_batches[i];
+                if (fe_face_values[my_q][fe_index].get() == nullptr)
+                  fe_face_values[my_q][fe_index] =
+                    std::make_shared<dealii::FEFaceValues<dim>>(
+                      mapping,
+                      dummy_fe,
+                      face_data[my_q].q_collection[fe_index],
+                      update_flags);
+                if (fe_face_values_neigh[my_q][fe_index].get() == nullptr)
+                  fe_face_values_neigh[my_q][fe_index] =
+                    std::make_shared<dealii::FEFaceValues<dim>>(
+                      mapping,
+                      dummy_fe,
+                      face_data[my_q].q_collection[fe_index],
+                      update_flags);
+                dealii::FEFaceValues<dim> &fe_val =
+                  *fe_face_values[my_q][fe_index];
+                dealii::FEFaceValues<dim> &fe_val_neigh =
+                  *fe_face_values_neigh[my_q][fe_index];
+                const unsigned int n_q_points = fe_val.n_quadrature_points;
+                const unsigned int face_index =
+                  cell * GeometryInfo<dim>::faces_per_cell + face;
+                const unsigned int offset =
+                  face_data_by_cells[my_q].data_index_offsets[face_index];
+
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    typename dealii::Triangulation<dim>::cell_iterator cell_it(
+                      &tria,
+                      cells[cell * n_lanes + v].first,
+                      cells[cell * n_lanes + v].second);
+                    fe_val.reinit(cell_it, face);
+
+                    const bool is_local =
+                      (cell_it->is_active() ?
+                         cell_it->is_locally_owned() :
+                         cell_it->is_locally_owned_on_level()) &&
+                      (!cell_it->at_boundary(face) ||
+                       (cell_it->at_boundary(face) &&
+                        cell_it->has_periodic_neighbor(face)));
+
+                    if (is_local)
+                      {
+                        auto cell_it_neigh =
+                          cell_it->neighbor_or_periodic_neighbor(face);
+                        fe_val_neigh.reinit(
+                          cell_it_neigh,
+                          cell_it->at_boundary(face) ?
+                            cell_it->periodic_neighbor_face_no(face) :
+                            cell_it->neighbor_face_no(face));
+                      }
+
+                    // copy data for affine data type
+                    if (cell_type[cell] <= affine)
+                      {
+                        if (update_flags & update_JxW_values)
+                          face_data_by_cells[my_q].JxW_values[offset][v] =
+                            fe_val.JxW(0) / fe_val.get_quadrature().weight(0);
+                        if (update_flags & update_jacobians)
                           {
                             DerivativeForm<1, dim, dim> inv_jac =
-                              fe_val_neigh.jacobian(q).covariant_form();
+                              fe_val.jacobian(0).covariant_form();
                             for (unsigned int d = 0; d < dim; ++d)
                               for (unsigned int e = 0; e < dim; ++e)
                                 {
-                                  const unsigned int ee = ExtractFaceHelper::
-                                    reorder_face_derivative_indices<dim>(face,
-                                                                         e);
+                                  const unsigned int ee =
+                                    ExtractFaceHelper::
+                                      reorder_face_derivative_indices<dim>(
+                                        face, e);
                                   face_data_by_cells[my_q]
-                                    .jacobians[1][offset][d][e][v] =
+                                    .jacobians[0][offset][d][e][v] =
                                     inv_jac[d][ee];
                                 }
                           }
-                      if (update_flags & update_jacobian_grads)
-                        {
-                          Assert(false, ExcNotImplemented());
-                        }
-                      if (update_flags & update_normal_vectors)
-                        for (unsigned int d = 0; d < dim; ++d)
-                          face_data_by_cells[my_q]
-                            .normal_vectors[offset][d][v] =
-                            fe_val.normal_vector(0)[d];
-                    }
-                  // copy data for general data type
-                  else
-                    {
-                      if (update_flags & update_JxW_values)
-                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                             ++q)
-                          face_data_by_cells[my_q].JxW_values[offset + q][v] =
-                            fe_val.JxW(q);
-                      if (update_flags & update_jacobians)
-                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                             ++q)
+                        if (is_local && (update_flags & update_jacobians))
+                          for (unsigned int q = 0; q < n_q_points; ++q)
+                            {
+                              DerivativeForm<1, dim, dim> inv_jac =
+                                fe_val_neigh.jacobian(q).covariant_form();
+                              for (unsigned int d = 0; d < dim; ++d)
+                                for (unsigned int e = 0; e < dim; ++e)
+                                  {
+                                    const unsigned int ee = ExtractFaceHelper::
+                                      reorder_face_derivative_indices<dim>(face,
+                                                                           e);
+                                    face_data_by_cells[my_q]
+                                      .jacobians[1][offset][d][e][v] =
+                                      inv_jac[d][ee];
+                                  }
+                            }
+                        if (update_flags & update_jacobian_grads)
                           {
-                            DerivativeForm<1, dim, dim> inv_jac =
-                              fe_val.jacobian(q).covariant_form();
-                            for (unsigned int d = 0; d < dim; ++d)
-                              for (unsigned int e = 0; e < dim; ++e)
-                                {
-                                  const unsigned int ee = ExtractFaceHelper::
-                                    reorder_face_derivative_indices<dim>(face,
-                                                                         e);
-                                  face_data_by_cells[my_q]
-                                    .jacobians[0][offset + q][d][e][v] =
-                                    inv_jac[d][ee];
-                                }
+                            Assert(false, ExcNotImplemented());
                           }
-                      if (update_flags & update_jacobian_grads)
-                        {
-                          Assert(false, ExcNotImplemented());
-                        }
-                      if (update_flags & update_normal_vectors)
-                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                             ++q)
+                        if (update_flags & update_normal_vectors)
                           for (unsigned int d = 0; d < dim; ++d)
                             face_data_by_cells[my_q]
-                              .normal_vectors[offset + q][d][v] =
-                              fe_val.normal_vector(q)[d];
-                    }
-                  if (update_flags & update_quadrature_points)
-                    for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                         ++q)
-                      for (unsigned int d = 0; d < dim; ++d)
-                        face_data_by_cells[my_q].quadrature_points
-                          [face_data_by_cells[my_q].quadrature_point_offsets
-                             [cell * GeometryInfo<dim>::faces_per_cell + face] +
-                           q][d][v] = fe_val.quadrature_point(q)[d];
-                }
-              if (update_flags & update_normal_vectors &&
-                  update_flags & update_jacobians)
-                for (unsigned int q = 0; q < (cell_type[cell] <= affine ?
-                                                1 :
-                                                fe_val.n_quadrature_points);
-                     ++q)
-                  face_data_by_cells[my_q]
-                    .normals_times_jacobians[0][offset + q] =
-                    face_data_by_cells[my_q].normal_vectors[offset + q] *
-                    face_data_by_cells[my_q].jacobians[0][offset + q];
-              if (update_flags & update_normal_vectors &&
-                  update_flags & update_jacobians)
-                for (unsigned int q = 0; q < (cell_type[cell] <= affine ?
-                                                1 :
-                                                fe_val.n_quadrature_points);
-                     ++q)
-                  face_data_by_cells[my_q]
-                    .normals_times_jacobians[1][offset + q] =
-                    face_data_by_cells[my_q].normal_vectors[offset + q] *
-                    face_data_by_cells[my_q].jacobians[1][offset + q];
-            }
+                              .normal_vectors[offset][d][v] =
+                              fe_val.normal_vector(0)[d];
+                      }
+                    // copy data for general data type
+                    else
+                      {
+                        if (update_flags & update_JxW_values)
+                          for (unsigned int q = 0; q < n_q_points; ++q)
+                            face_data_by_cells[my_q].JxW_values[offset + q][v] =
+                              fe_val.JxW(q);
+                        if (update_flags & update_jacobians)
+                          for (unsigned int q = 0; q < n_q_points; ++q)
+                            {
+                              DerivativeForm<1, dim, dim> inv_jac =
+                                fe_val.jacobian(q).covariant_form();
+                              for (unsigned int d = 0; d < dim; ++d)
+                                for (unsigned int e = 0; e < dim; ++e)
+                                  {
+                                    const unsigned int ee = ExtractFaceHelper::
+                                      reorder_face_derivative_indices<dim>(face,
+                                                                           e);
+                                    face_data_by_cells[my_q]
+                                      .jacobians[0][offset + q][d][e][v] =
+                                      inv_jac[d][ee];
+                                  }
+                            }
+                        if (update_flags & update_jacobian_grads)
+                          {
+                            Assert(false, ExcNotImplemented());
+                          }
+                        if (update_flags & update_normal_vectors)
+                          for (unsigned int q = 0; q < n_q_points; ++q)
+                            for (unsigned int d = 0; d < dim; ++d)
+                              face_data_by_cells[my_q]
+                                .normal_vectors[offset + q][d][v] =
+                                fe_val.normal_vector(q)[d];
+                      }
+                    if (update_flags & update_quadrature_points)
+                      for (unsigned int q = 0; q < n_q_points; ++q)
+                        for (unsigned int d = 0; d < dim; ++d)
+                          face_data_by_cells[my_q].quadrature_points
+                            [face_data_by_cells[my_q]
+                               .quadrature_point_offsets[face_index] +
+                             q][d][v] = fe_val.quadrature_point(q)[d];
+                  }
+                if (update_flags & update_normal_vectors &&
+                    update_flags & update_jacobians)
+                  for (unsigned int q = 0;
+                       q < (cell_type[cell] <= affine ? 1 : n_q_points);
+                       ++q)
+                    face_data_by_cells[my_q]
+                      .normals_times_jacobians[0][offset + q] =
+                      face_data_by_cells[my_q].normal_vectors[offset + q] *
+                      face_data_by_cells[my_q].jacobians[0][offset + q];
+                if (update_flags & update_normal_vectors &&
+                    update_flags & update_jacobians)
+                  for (unsigned int q = 0;
+                       q < (cell_type[cell] <= affine ? 1 : n_q_points);
+                       ++q)
+                    face_data_by_cells[my_q]
+                      .normals_times_jacobians[1][offset + q] =
+                      face_data_by_cells[my_q].normal_vectors[offset + q] *
+                      face_data_by_cells[my_q].jacobians[1][offset + q];
+              }
+      };
+
+      const std::size_t work_per_chunk =
+        std::max(std::size_t(1),
+                 (cell_batches.size() + MultithreadInfo::n_threads() - 1) /
+                   MultithreadInfo::n_threads());
+      Threads::TaskGroup<> tasks;
+      for (std::size_t begin = 0; begin < cell_batches.size();
+           begin += work_per_chunk)
+        tasks += Threads::new_task([&, begin]() {
+          compute_range(begin,
+                        std::min(cell_batches.size(), begin + work_per_chunk));
+        });
+      tasks.join_all();
     }
 
 
@@ -3339,6 +3591,10 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(face_data);
       memory += cell_type.capacity() * sizeof(GeometryType);
       memory += face_type.capacity() * sizeof(GeometryType);
+      memory +=
+        MemoryConsumption::memory_consumption(cached_mapping_support_points);
+      memory += MemoryConsumption::memory_consumption(cached_cell_data_index);
+      memory += cached_cell_type.capacity() * sizeof(GeometryType);
       memory += sizeof(*this);
       return memory;
     }
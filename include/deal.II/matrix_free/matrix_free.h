@@ -24,6 +24,7 @@
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_local_storage.h>
+#include <deal.II/base/tracing.h>
 #include <deal.II/base/vectorization.h>
 
 #include <deal.II/dofs/dof_handler.h>
@@ -205,7 +206,13 @@ public:
        * Use the traditional coloring algorithm: this is like
        * TasksParallelScheme::partition_color, but only uses one partition.
        */
-      color = internal::MatrixFreeFunctions::TaskInfo::color
+      color = internal::MatrixFreeFunctions::TaskInfo::color,
+      /**
+       * Like TasksParallelScheme::partition_partition, but let the threads
+       * pick the conflict-free chunks of cells dynamically.
+       */
+      partition_partition_dynamic =
+        internal::MatrixFreeFunctions::TaskInfo::partition_partition_dynamic
     };
 
     // remove with level_mg_handler
@@ -245,6 +252,10 @@ public:
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
       , communicator_sm(MPI_COMM_SELF)
+      , test_communication_progress(false)
+      , compute_jacobians_on_the_fly(false)
+      , use_fast_hanging_node_algorithm(false)
+      , incremental_mapping_update(false)
     {}
 
     /**
@@ -271,6 +282,10 @@ public:
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
       , communicator_sm(other.communicator_sm)
+      , test_communication_progress(other.test_communication_progress)
+      , compute_jacobians_on_the_fly(other.compute_jacobians_on_the_fly)
+      , use_fast_hanging_node_algorithm(other.use_fast_hanging_node_algorithm)
+      , incremental_mapping_update(other.incremental_mapping_update)
     {}
 
     // remove with level_mg_handler
@@ -300,13 +315,17 @@ public:
       cell_vectorization_category   = other.cell_vectorization_category;
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
-      communicator_sm = other.communicator_sm;
+      communicator_sm                 = other.communicator_sm;
+      test_communication_progress     = other.test_communication_progress;
+      compute_jacobians_on_the_fly    = other.compute_jacobians_on_the_fly;
+      use_fast_hanging_node_algorithm = other.use_fast_hanging_node_algorithm;
+      incremental_mapping_update      = other.incremental_mapping_update;
 
       return *this;
     }
 
     /**
-     * Set the scheme for task parallelism. There are four options available.
+     * Set the scheme for task parallelism. There are five options available.
      * If set to @p none, the operator application is done in serial without
      * shared memory parallelism. If this class is used together with MPI and
      * MPI is also used for parallelism within the nodes, this flag should be
@@ -333,6 +352,19 @@ public:
      * might degrade parallel performance (bad cache behavior, many
      * synchronization points).
      *
+     * The fourth option @p partition_partition_dynamic builds the same
+     * two-level partitions as @p partition_partition, but replaces the
+     * static task graph by dynamic scheduling: the chunks are collected in
+     * four phases (the even and odd chunks of the odd partitions, followed
+     * by the even and odd chunks of the even partitions) that contain only
+     * chunks that can be worked on at the same time. Within a phase, each
+     * thread picks the next free chunk, with the largest chunks first, as
+     * soon as it is done with the previous one. This balances the work
+     * better if the cost per cell varies, e.g. in hp-adaptive computations,
+     * at the price of a synchronization at the end of each phase. The busy
+     * and idle times of the threads are recorded, see
+     * MatrixFree::get_task_load_statistics().
+     *
      * @note Threading support is currently experimental for the case inner
      * face integrals are performed and it is recommended to use MPI
      * parallelism if possible. While the scheme has been verified to work
@@ -538,6 +570,83 @@ public:
      * Shared-memory MPI communicator. Default: MPI_COMM_SELF.
      */
     MPI_Comm communicator_sm;
+
+    /**
+     * Many MPI implementations only progress non-blocking messages when the
+     * library is entered, which in the matrix-free loops mostly happens in
+     * the finish() calls of the data exchange. In that case, the overlap of
+     * communication and computation enabled by @p
+     * overlap_communication_computation is only nominal. If this flag is set
+     * to true, the loops test the outstanding requests of
+     * LinearAlgebra::distributed::Vector after each range of cells that does
+     * not depend on remote data, in order to keep the messages moving, and
+     * record how much of the exchange was actually hidden. The statistics
+     * can be queried by MatrixFree::get_communication_overlap_statistics().
+     *
+     * The option is currently only effective for loops without threads,
+     * i.e., with @p tasks_parallel_scheme set to @p none. The default is
+     * false.
+     */
+    bool test_communication_progress;
+
+    /**
+     * On deformed cells, the inverse Jacobians and the JxW values stored at
+     * every quadrature point often make up the largest part of the memory
+     * transfer in a matrix-free operator evaluation. If this flag is set to
+     * true, MappingInfo only keeps the support points of the mapping (i.e.,
+     * <code>dim * (mapping_degree+1)^dim</code> values per cell batch) for
+     * cells with general geometry, and FEEvaluation::reinit() computes the
+     * Jacobians at the quadrature points with the tensor-product kernels of
+     * the matrix-free framework. This trades memory traffic for arithmetic
+     * operations. Cartesian and affine cells are not affected.
+     *
+     * The option is only effective for MappingQGeneric and derived classes
+     * without hp-adaptivity, and is ignored when Jacobian gradients are
+     * needed, e.g. by update_hessians. Note that the Jacobians are computed
+     * in the precision of @p Number, whereas the stored data is always
+     * computed in double. The default is false.
+     */
+    bool compute_jacobians_on_the_fly;
+
+    /**
+     * On adaptively refined meshes with continuous elements, the cells
+     * adjacent to a coarser neighbor resolve their hanging-node constraints
+     * through the general constraint code path, which processes one SIMD
+     * lane and one unknown at a time. If this flag is set to true, DoFInfo
+     * instead stores a compressed mask of the hanging-node configuration of
+     * each cell and replaces the indices on the refined side by the ones of
+     * the coarser neighbor. FEEvaluation::read_dof_values() and
+     * FEEvaluation::distribute_local_to_global() then apply the
+     * interpolation with one-dimensional kernels on all SIMD lanes, and the
+     * indices of these cells can be accessed with vectorized gather
+     * operations if no other constraints are present.
+     *
+     * The option is only effective for DoFHandler objects based on a single
+     * base element of type FE_Q (possibly with several components) without
+     * hp-adaptivity, on the active level of meshes in 2D and 3D, and if no
+     * face integrals are requested. Furthermore, the hanging nodes must be
+     * present in the given AffineConstraints object. For cells with hanging
+     * nodes, FEEvaluation::set_dof_values() is not supported. The default
+     * is false.
+     */
+    bool use_fast_hanging_node_algorithm;
+
+    /**
+     * For moving meshes, e.g. with MappingQCache or MappingQ1Eulerian, it
+     * is often only a part of the domain that deforms between two calls to
+     * MatrixFree::update_mapping(). If this flag is set to true, MappingInfo
+     * keeps the support points of the mapping of all cells from the last
+     * computation and update_mapping() only recomputes the geometry data of
+     * the cell batches whose support points have changed, and of the faces
+     * adjacent to them. If a change of the geometry makes a cell switch
+     * between the Cartesian, affine, and general types, all data is
+     * computed again.
+     *
+     * The option is only effective for MappingQGeneric and derived classes
+     * without hp-adaptivity. It costs <code>dim * (mapping_degree+1)^dim</code>
+     * doubles of memory per cell. The default is false.
+     */
+    bool incremental_mapping_update;
   };
 
   /**
@@ -727,6 +836,26 @@ public:
   copy_from(
     const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free_base);
 
+  /**
+   * Copy function from an object with a different number type, e.g. to set
+   * up a single-precision operator for a multigrid preconditioner next to
+   * a double-precision one without calling reinit() a second time. The
+   * index data (DoFInfo, TaskInfo, FaceInfo) is taken over from @p other,
+   * the geometry data and the constraint weights are converted to the
+   * number type of this class, and the shape functions are evaluated again
+   * for the quadrature formulas of @p other. A subsequent call to
+   * update_mapping() on this object recomputes the geometry data in the
+   * number type of this class.
+   *
+   * Since the cell batches are taken over, the two vectorized array types
+   * need to have the same number of lanes, e.g. an object of type
+   * MatrixFree<dim, double, VectorizedArray<double, 4>> can be converted to
+   * MatrixFree<dim, float, VectorizedArray<float, 4>>.
+   */
+  template <typename Number2, typename VectorizedArrayType2>
+  void
+  copy_from(const MatrixFree<dim, Number2, VectorizedArrayType2> &other);
+
   /**
    * Refreshes the geometry data stored in the MappingInfo fields when the
    * underlying geometry has changed (e.g. by a mapping that can deform
@@ -734,7 +863,9 @@ public:
    * whereas the topology of the mesh and unknowns have remained the
    * same. Compared to reinit(), this operation only has to re-generate the
    * geometry arrays and can thus be significantly cheaper (depending on the
-   * cost to evaluate the geometry).
+   * cost to evaluate the geometry). The geometry is computed with the same
+   * multithreading as in reinit(), and only for the cells that have moved
+   * if AdditionalData::incremental_mapping_update was set.
    */
   void
   update_mapping(const Mapping<dim> &mapping);
@@ -1942,6 +2073,38 @@ public:
   const internal::MatrixFreeFunctions::TaskInfo &
   get_task_info() const;
 
+  /**
+   * Return the statistics on the overlap of communication and computation
+   * that the loops collect if AdditionalData::test_communication_progress is
+   * set. The counters accumulate over all loops since the last
+   * initialization of the indices in reinit() or the last call to
+   * reset_communication_overlap_statistics().
+   */
+  const internal::MatrixFreeFunctions::CommunicationOverlapStatistics &
+  get_communication_overlap_statistics() const;
+
+  /**
+   * Reset the statistics returned by get_communication_overlap_statistics().
+   */
+  void
+  reset_communication_overlap_statistics() const;
+
+  /**
+   * Return the busy and idle times of the threads that the loops collect if
+   * AdditionalData::tasks_parallel_scheme is set to
+   * AdditionalData::partition_partition_dynamic. The counters accumulate
+   * over all loops since the last initialization of the indices in reinit()
+   * or the last call to reset_task_load_statistics().
+   */
+  const internal::MatrixFreeFunctions::TaskLoadStatistics &
+  get_task_load_statistics() const;
+
+  /**
+   * Reset the statistics returned by get_task_load_statistics().
+   */
+  void
+  reset_task_load_statistics() const;
+
   /*
    * Return geometry-dependent information on the cells.
    */
@@ -2182,6 +2345,10 @@ private:
    * Stored the level of the mesh to be worked on.
    */
   unsigned int mg_level;
+
+  // Allow copy_from() to access the data of objects with other number types
+  template <int, typename, typename>
+  friend class MatrixFree;
 };
 
 
@@ -2192,6 +2359,61 @@ private:
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename Number2, typename VectorizedArrayType2>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
+  const MatrixFree<dim, Number2, VectorizedArrayType2> &other)
+{
+  static_assert(VectorizedArrayType::size() == VectorizedArrayType2::size(),
+                "The conversion between MatrixFree objects of different "
+                "number types is only possible with the same number of SIMD "
+                "lanes, as the cell batches are taken over.");
+  Assert(other.indices_are_initialized && other.mapping_is_initialized,
+         ExcMessage("The MatrixFree object to copy from must have been "
+                    "initialized with indices and mapping data."));
+
+  clear();
+  dof_handlers = other.dof_handlers;
+  dof_info     = other.dof_info;
+  constraint_pool_data.assign(other.constraint_pool_data.begin(),
+                              other.constraint_pool_data.end());
+  constraint_pool_row_index  = other.constraint_pool_row_index;
+  cell_level_index           = other.cell_level_index;
+  cell_level_index_end_local = other.cell_level_index_end_local;
+  task_info                  = other.task_info;
+  face_info                  = other.face_info;
+  mg_level                   = other.mg_level;
+  mapping_info.copy_from(other.mapping_info);
+
+  // evaluate the shape functions again for the quadrature formulas stored
+  // in the mapping data, in the same order as in internal_reinit()
+  shape_info.reinit(TableIndices<4>(other.shape_info.size(0),
+                                    other.shape_info.size(1),
+                                    other.shape_info.size(2),
+                                    other.shape_info.size(3)));
+  AssertDimension(shape_info.size(1), mapping_info.cell_data.size());
+  for (unsigned int no = 0, c = 0; no < dof_handlers.size(); no++)
+    for (unsigned int b = 0; b < dof_handlers[no]->get_fe(0).n_base_elements();
+         ++b, ++c)
+      for (unsigned int fe_no = 0;
+           fe_no < dof_handlers[no]->get_fe_collection().size();
+           ++fe_no)
+        for (unsigned int nq = 0; nq < shape_info.size(1); nq++)
+          for (unsigned int q_no = 0;
+               q_no < mapping_info.cell_data[nq].descriptor.size();
+               ++q_no)
+            shape_info(c, nq, fe_no, q_no)
+              .reinit(mapping_info.cell_data[nq].descriptor[q_no].quadrature,
+                      dof_handlers[no]->get_fe(fe_no),
+                      b);
+
+  indices_are_initialized = true;
+  mapping_is_initialized  = true;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 template <typename VectorType>
 inline void
@@ -2271,6 +2493,45 @@ MatrixFree<dim, Number, VectorizedArrayType>::get_task_info() const
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+inline const internal::MatrixFreeFunctions::CommunicationOverlapStatistics &
+MatrixFree<dim, Number, VectorizedArrayType>::
+  get_communication_overlap_statistics() const
+{
+  return task_info.communication_statistics;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::
+  reset_communication_overlap_statistics() const
+{
+  task_info.communication_statistics.clear();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline const internal::MatrixFreeFunctions::TaskLoadStatistics &
+MatrixFree<dim, Number, VectorizedArrayType>::get_task_load_statistics() const
+{
+  return task_info.load_statistics;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::reset_task_load_statistics()
+  const
+{
+  task_info.load_statistics.clear();
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline unsigned int
 MatrixFree<dim, Number, VectorizedArrayType>::n_macro_cells() const
@@ -3899,6 +4160,37 @@ namespace internal
 
 
 
+    /**
+     * Test whether all MPI requests of the data exchange currently in flight
+     * have completed. This gives the MPI library a chance to progress the
+     * messages. As opposed to MPI_Testall(), the requests are not
+     * deallocated, such that the _finish() functions can still wait for
+     * them in the usual way. Vectors that do not expose their requests
+     * (i.e., everything except LinearAlgebra::distributed::Vector) are
+     * reported as completed.
+     */
+    bool
+    test_requests() const
+    {
+      bool all_completed = true;
+#  ifdef DEAL_II_WITH_MPI
+      for (const auto &component_requests : requests)
+        for (MPI_Request request : component_requests)
+          if (request != MPI_REQUEST_NULL)
+            {
+              int       flag = 0;
+              const int ierr =
+                MPI_Request_get_status(request, &flag, MPI_STATUS_IGNORE);
+              AssertThrowMPI(ierr);
+              if (flag == 0)
+                all_completed = false;
+            }
+#  endif
+      return all_completed;
+    }
+
+
+
     const dealii::MatrixFree<dim, Number, VectorizedArrayType> &matrix_free;
     const typename dealii::MatrixFree<dim, Number, VectorizedArrayType>::
       DataAccessOnFaces vector_face_access;
@@ -4606,6 +4898,8 @@ namespace internal
     virtual void
     cell(const std::pair<unsigned int, unsigned int> &cell_range) override
     {
+      Tracing::Scope trace_scope("MatrixFree cell range", "MatrixFree");
+
       if (cell_function != nullptr && cell_range.second > cell_range.first)
         for (unsigned int i = 0; i < matrix_free.n_active_fe_indices(); ++i)
           {
@@ -4623,6 +4917,7 @@ namespace internal
     virtual void
     cell(const unsigned int range_index) override
     {
+      Tracing::Scope trace_scope("MatrixFree cell range", "MatrixFree");
       process_range(cell_function,
                     matrix_free.get_task_info().cell_partition_data_hp_ptr,
                     matrix_free.get_task_info().cell_partition_data_hp,
@@ -4632,6 +4927,7 @@ namespace internal
     virtual void
     face(const unsigned int range_index) override
     {
+      Tracing::Scope trace_scope("MatrixFree face range", "MatrixFree");
       process_range(face_function,
                     matrix_free.get_task_info().face_partition_data_hp_ptr,
                     matrix_free.get_task_info().face_partition_data_hp,
@@ -4641,6 +4937,7 @@ namespace internal
     virtual void
     boundary(const unsigned int range_index) override
     {
+      Tracing::Scope trace_scope("MatrixFree boundary range", "MatrixFree");
       process_range(boundary_function,
                     matrix_free.get_task_info().boundary_partition_data_hp_ptr,
                     matrix_free.get_task_info().boundary_partition_data_hp,
@@ -4686,6 +4983,15 @@ namespace internal
         internal::update_ghost_values_finish(src, src_data_exchanger);
     }
 
+    // Tests the communication for the update ghost values operation
+    virtual bool
+    vector_update_ghosts_test() override
+    {
+      if (!src_and_dst_are_same)
+        return src_data_exchanger.test_requests();
+      return true;
+    }
+
     // Starts the communication for the vector compress operation
     virtual void
     vector_compress_start() override
@@ -4702,6 +5008,13 @@ namespace internal
         internal::reset_ghost_values(src, src_data_exchanger);
     }
 
+    // Tests the communication for the vector compress operation
+    virtual bool
+    vector_compress_test() override
+    {
+      return dst_data_exchanger.test_requests();
+    }
+
     // Zeros the given input vector
     virtual void
     zero_dst_vector_range(const unsigned int range_index) override
@@ -40,6 +40,7 @@
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/face_setup_internal.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/matrix_free.h>
 
 #ifdef DEAL_II_WITH_TBB
@@ -451,6 +452,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
 #endif
         task_info.scheme = internal::MatrixFreeFunctions::TaskInfo::none;
 
+      task_info.test_communication_progress =
+        additional_data.test_communication_progress;
+
       // set dof_indices together with constraint_indicator and
       // constraint_pool_data. It also reorders the way cells are gone through
       // (to separate cells with overlap to other processors from others
@@ -779,7 +783,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.compute_jacobians_on_the_fly,
+        additional_data.incremental_mapping_update);
 
       mapping_is_initialized = true;
     }
@@ -1026,6 +1032,7 @@ namespace internal
     const bool                       cell_vectorization_categories_strict,
     const bool                       do_face_integrals,
     const bool                       overlap_communication_computation,
+    const bool                       use_fast_hanging_node_algorithm,
     MatrixFreeFunctions::TaskInfo &  task_info,
     std::vector<std::pair<unsigned int, unsigned int>> &cell_level_index,
     std::vector<MatrixFreeFunctions::DoFInfo> &         dof_info,
@@ -1047,10 +1054,25 @@ namespace internal
     AssertDimension(n_dof_handlers, locally_owned_dofs.size());
     AssertDimension(n_dof_handlers, constraint.size());
 
-    std::vector<types::global_dof_index>                local_dof_indices;
+    std::vector<types::global_dof_index> local_dof_indices,
+      local_dof_indices_resolved;
     std::vector<std::vector<std::vector<unsigned int>>> lexicographic(
       n_dof_handlers);
 
+    // set up the compressed treatment of hanging nodes for the DoFHandler
+    // objects that support it
+    std::vector<std::unique_ptr<MatrixFreeFunctions::HangingNodes<dim>>>
+      hanging_nodes(n_dof_handlers);
+    if (use_fast_hanging_node_algorithm &&
+        mg_level == numbers::invalid_unsigned_int && tria.has_hanging_nodes())
+      for (unsigned int no = 0; no < n_dof_handlers; ++no)
+        if (dof_handler[no]->get_fe_collection().size() == 1 &&
+            MatrixFreeFunctions::HangingNodes<dim>::check_support(
+              dof_handler[no]->get_fe()))
+          hanging_nodes[no] =
+            std::make_unique<MatrixFreeFunctions::HangingNodes<dim>>(
+              *dof_handler[no]);
+
     std::vector<bool> is_fe_dg(n_dof_handlers, false);
 
     bool cell_categorization_enabled = !cell_vectorization_category.empty();
@@ -1195,12 +1217,33 @@ namespace internal
                   dof_info[no].cell_active_fe_index[counter] = fe_index;
                 local_dof_indices.resize(dof_info[no].dofs_per_cell[fe_index]);
                 cell_it->get_dof_indices(local_dof_indices);
-                dof_info[no].read_dof_indices(local_dof_indices,
-                                              lexicographic[no][fe_index],
-                                              *constraint[no],
-                                              counter,
-                                              constraint_values,
-                                              cell_at_subdomain_boundary);
+
+                unsigned short hanging_node_mask = 0;
+                if (hanging_nodes[no])
+                  {
+                    local_dof_indices_resolved = local_dof_indices;
+                    hanging_node_mask = hanging_nodes[no]->setup_constraints(
+                      cell_it, *constraint[no], local_dof_indices_resolved);
+                  }
+                if (hanging_node_mask != 0)
+                  {
+                    if (dof_info[no].hanging_node_constraint_masks.empty())
+                      dof_info[no].hanging_node_constraint_masks.resize(
+                        n_active_cells, 0);
+                    dof_info[no].hanging_node_constraint_masks[counter] =
+                      hanging_node_mask;
+                  }
+
+                dof_info[no].read_dof_indices(
+                  hanging_node_mask != 0 ? local_dof_indices_resolved :
+                                           local_dof_indices,
+                  local_dof_indices,
+                  hanging_node_mask != 0,
+                  lexicographic[no][fe_index],
+                  *constraint[no],
+                  counter,
+                  constraint_values,
+                  cell_at_subdomain_boundary);
                 if (dofh->get_fe_collection().size() == 1 &&
                     cell_categorization_enabled)
                   {
@@ -1223,6 +1266,8 @@ namespace internal
                 local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
                 cell_it->get_mg_dof_indices(local_dof_indices);
                 dof_info[no].read_dof_indices(local_dof_indices,
+                                              local_dof_indices,
+                                              false,
                                               lexicographic[no][0],
                                               *constraint[no],
                                               counter,
@@ -1673,6 +1718,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
     additional_data.cell_vectorization_categories_strict,
     do_face_integrals,
     additional_data.overlap_communication_computation,
+    additional_data.use_fast_hanging_node_algorithm && !do_face_integrals &&
+      additional_data.mapping_update_flags_faces_by_cells == update_default,
     task_info,
     cell_level_index,
     dof_info,
@@ -0,0 +1,235 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_operation_counter_h
+#define dealii_matrix_free_operation_counter_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/vectorization.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MatrixFreeTools
+{
+  /**
+   * A summary of the work done by the matrix-free evaluation kernels, as
+   * collected by OperationCounter.
+   */
+  struct OperationCount
+  {
+    /**
+     * The number of floating point operations, counted per SIMD lane, i.e.,
+     * an addition of two VectorizedArray<double> objects with four lanes
+     * counts as four operations.
+     */
+    std::uint64_t arithmetic_operations = 0;
+
+    /**
+     * The number of bytes read from and written to the solution vectors.
+     */
+    std::uint64_t vector_bytes = 0;
+
+    /**
+     * The number of bytes of degree of freedom indices read for accessing
+     * the vectors.
+     */
+    std::uint64_t index_bytes = 0;
+
+    /**
+     * The number of bytes of mapping data (Jacobians and their
+     * determinants) read.
+     */
+    std::uint64_t mapping_bytes = 0;
+
+    /**
+     * Return the sum of all bytes transferred.
+     */
+    std::uint64_t
+    total_bytes() const;
+
+    /**
+     * Return the arithmetic intensity, i.e., the number of operations per
+     * byte transferred.
+     */
+    double
+    arithmetic_intensity() const;
+  };
+
+
+
+  /**
+   * Functions to query the number of arithmetic operations and the amount
+   * of data transferred by the matrix-free evaluation routines, in order to
+   * put the achieved performance of an operator into relation with the
+   * limits of the hardware (the so-called roofline model).
+   *
+   * Counting is only active if deal.II has been configured with
+   * <tt>-DDEAL_II_MATRIX_FREE_COUNT_OPERATIONS=ON</tt>. In that case, the
+   * tensor product kernels of FEEvaluation and FEFaceEvaluation add the
+   * operations they execute to global counters, the vector access functions
+   * such as FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global() add the bytes of vector
+   * entries and indices they access, and FEEvaluation::reinit() adds the
+   * bytes of the mapping data of the cell. Otherwise, the counting functions
+   * are empty and all counts stay zero.
+   *
+   * The counts are approximate: the vector and index bytes are those
+   * requested by the evaluators, i.e., they ignore caches and count entries
+   * shared by neighboring cells multiple times, and the operations of the
+   * quadrature point operations defined by the user are not included. The
+   * counters are atomic so that they can be used with threads, which adds
+   * some overhead to the measured run times. A typical use is
+   * @code
+   * MatrixFreeTools::OperationCounter::reset();
+   * Timer timer;
+   * matrix_free.cell_loop(&LaplaceOperator::local_apply, this, dst, src);
+   * timer.stop();
+   * MatrixFreeTools::OperationCounter::print_roofline(
+   *   std::cout,
+   *   MatrixFreeTools::OperationCounter::get(),
+   *   timer.wall_time(),
+   *   "machine.txt",
+   *   MPI_COMM_WORLD);
+   * @endcode
+   */
+  namespace OperationCounter
+  {
+    /**
+     * Set all counters to zero.
+     */
+    void
+    reset();
+
+    /**
+     * Return the counts accumulated on the current process since the last
+     * call to reset().
+     */
+    OperationCount
+    get();
+
+    /**
+     * Sum the counts @p count over all processes in @p mpi_communicator and
+     * print the achieved GFLOP/s and GB/s for the given @p wall_time in
+     * seconds to @p out on the root process.
+     *
+     * If @p machine_model_file is not empty, the achieved values are
+     * additionally compared to the peak performance of the machine, which
+     * is read from the given file. The file contains lines of the form
+     * @code
+     * peak_gflops 3000
+     * memory_bandwidth_gbs 200
+     * @endcode
+     * for the theoretical arithmetic throughput and the memory bandwidth of
+     * all resources used by @p mpi_communicator. Empty lines and lines
+     * starting with <tt>#</tt> are ignored.
+     */
+    void
+    print_roofline(std::ostream &        out,
+                   const OperationCount &count,
+                   const double          wall_time,
+                   const std::string &   machine_model_file = "",
+                   const MPI_Comm &      mpi_communicator   = MPI_COMM_SELF);
+  } // namespace OperationCounter
+} // namespace MatrixFreeTools
+
+
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * The categories of counted quantities, used as index into
+     * operation_counters.
+     */
+    enum CountedQuantity : unsigned char
+    {
+      counted_arithmetic_operations,
+      counted_vector_bytes,
+      counted_index_bytes,
+      counted_mapping_bytes,
+      n_counted_quantities
+    };
+
+    /**
+     * The global counters behind MatrixFreeTools::OperationCounter.
+     */
+    extern std::atomic<std::uint64_t> operation_counters[n_counted_quantities];
+
+    /**
+     * The number of SIMD lanes of a number type.
+     */
+    template <typename Number>
+    struct CountedLanes
+    {
+      static constexpr unsigned int value = 1;
+    };
+
+    template <typename Number, std::size_t width>
+    struct CountedLanes<VectorizedArray<Number, width>>
+    {
+      static constexpr unsigned int value = width;
+    };
+
+    /**
+     * Add @p n_operations operations on objects of type @p Number to the
+     * operation counter. This function does nothing unless deal.II has been
+     * configured with DEAL_II_MATRIX_FREE_COUNT_OPERATIONS.
+     */
+    template <typename Number>
+    inline DEAL_II_ALWAYS_INLINE void
+    count_arithmetic_operations(const std::uint64_t n_operations)
+    {
+#ifdef DEAL_II_MATRIX_FREE_COUNT_OPERATIONS
+      operation_counters[counted_arithmetic_operations].fetch_add(
+        n_operations * CountedLanes<Number>::value, std::memory_order_relaxed);
+#else
+      (void)n_operations;
+#endif
+    }
+
+    /**
+     * Add @p n_bytes to the counter of the given @p quantity. This function
+     * does nothing unless deal.II has been configured with
+     * DEAL_II_MATRIX_FREE_COUNT_OPERATIONS.
+     */
+    inline DEAL_II_ALWAYS_INLINE void
+    count_bytes(const CountedQuantity quantity, const std::uint64_t n_bytes)
+    {
+#ifdef DEAL_II_MATRIX_FREE_COUNT_OPERATIONS
+      operation_counters[quantity].fetch_add(n_bytes,
+                                             std::memory_order_relaxed);
+#else
+      (void)quantity;
+      (void)n_bytes;
+#endif
+    }
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -261,6 +261,16 @@ namespace internal
        */
       std::array<AlignedVector<Number>, 2> hessians_within_subface;
 
+      /**
+       * For elements with nodal degrees of freedom at the cell boundaries,
+       * stores the one-dimensional interpolation matrix from the unknowns of
+       * a parent element to the unknowns of its first (lower) child, i.e.,
+       * the value of shape function `j` in the support point `i` of the
+       * child at position <tt>i * n_dofs_1d + j</tt>. This matrix is used
+       * for the resolution of hanging-node constraints in FEEvaluation.
+       */
+      AlignedVector<Number> subface_interpolation_matrix;
+
       /**
        * We store a copy of the one-dimensional quadrature formula
        * used for initialization.
@@ -296,6 +306,27 @@ namespace internal
        * (no tensor-product structure  exploited).
        */
       Table<4, Number> shape_gradients_face;
+
+      /**
+       * For elements without tensor-product structure
+       * (ElementType::tensor_none), stores the shape values and gradients in
+       * all quadrature points of the cell in an interleaved layout that
+       * allows to compute values and gradients in one sweep over the degrees
+       * of freedom. The entry for quadrature point `q`, shape function `i`
+       * and index `k` is found at position <tt>(q * n_dofs + i) * (dim + 1) +
+       * k</tt>, where `k=0` denotes the value and `k=1,...,dim` the
+       * components of the gradient in reference coordinates.
+       */
+      AlignedVector<Number> shape_values_gradients_interleaved;
+
+      /**
+       * Same data as in shape_values_gradients_interleaved, but with the
+       * roles of shape functions and quadrature points exchanged, i.e., the
+       * entry is found at position <tt>(i * n_q_points + q) * (dim + 1) +
+       * k</tt>. This layout is used for the integration step, where the sum
+       * runs over the quadrature points.
+       */
+      AlignedVector<Number> shape_values_gradients_interleaved_transposed;
     };
 
 
@@ -315,6 +315,26 @@ namespace internal
                                   q] = grad[d];
               }
 
+          // interleaved layout of values and gradients for the fused
+          // evaluation and integration kernels
+          auto &shape_data_qi =
+            univariate_shape_data.shape_values_gradients_interleaved;
+          auto &shape_data_iq =
+            univariate_shape_data.shape_values_gradients_interleaved_transposed;
+          shape_data_qi.resize_fast(array_size * (dim + 1));
+          shape_data_iq.resize_fast(array_size * (dim + 1));
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              for (unsigned int k = 0; k < dim + 1; ++k)
+                {
+                  const Number entry =
+                    k == 0 ? shape_values[i * n_q_points + q] :
+                             shape_gradients[(k - 1) * n_dofs * n_q_points +
+                                             i * n_q_points + q];
+                  shape_data_qi[(q * n_dofs + i) * (dim + 1) + k]     = entry;
+                  shape_data_iq[(i * n_q_points + q) * (dim + 1) + k] = entry;
+                }
+
           {
             const auto reference_cell = fe.reference_cell();
 
@@ -755,6 +775,25 @@ namespace internal
               1e-13)
           nodal_at_cell_boundaries = false;
 
+      // the interpolation from the unknowns of the parent interval [0,1] to
+      // the left child [0,1/2], needed to resolve hanging nodes
+      if (nodal_at_cell_boundaries == true && fe.has_support_points())
+        {
+          auto &subface_interpolation_matrix =
+            univariate_shape_data.subface_interpolation_matrix;
+          subface_interpolation_matrix.resize_fast(n_dofs_1d * n_dofs_1d);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            for (unsigned int j = 0; j < n_dofs_1d; ++j)
+              {
+                Point<dim> q_point = unit_point;
+                q_point[0] =
+                  0.5 *
+                  fe.get_unit_support_points()[scalar_lexicographic[i]][0];
+                subface_interpolation_matrix[i * n_dofs_1d + j] =
+                  fe.shape_value(scalar_lexicographic[j], q_point);
+              }
+        }
+
       if (nodal_at_cell_boundaries == true)
         {
           face_to_cell_index_nodal.reinit(GeometryInfo<dim>::faces_per_cell,
@@ -1073,6 +1112,10 @@ namespace internal
         MemoryConsumption::memory_consumption(shape_gradients_collocation_eo);
       memory +=
         MemoryConsumption::memory_consumption(shape_hessians_collocation_eo);
+      memory += MemoryConsumption::memory_consumption(
+        shape_values_gradients_interleaved);
+      memory += MemoryConsumption::memory_consumption(
+        shape_values_gradients_interleaved_transposed);
       for (unsigned int i = 0; i < 2; ++i)
         {
           memory +=
@@ -1084,6 +1127,8 @@ namespace internal
           memory +=
             MemoryConsumption::memory_consumption(gradients_within_subface[i]);
         }
+      memory +=
+        MemoryConsumption::memory_consumption(subface_interpolation_matrix);
       return memory;
     }
 
@@ -62,6 +62,24 @@ namespace internal
     virtual void
     vector_compress_finish() = 0;
 
+    /// Tests the requests of the update ghost values operation, giving the
+    /// MPI library a chance to progress the messages. Returns true if all
+    /// messages have arrived
+    virtual bool
+    vector_update_ghosts_test()
+    {
+      return true;
+    }
+
+    /// Tests the requests of the vector compress operation, giving the MPI
+    /// library a chance to progress the messages. Returns true if all
+    /// messages have arrived
+    virtual bool
+    vector_compress_test()
+    {
+      return true;
+    }
+
     /// Zeros part of the vector according to a given range as stored in
     /// DoFInfo
     virtual void
@@ -98,6 +116,152 @@ namespace internal
 
   namespace MatrixFreeFunctions
   {
+    /**
+     * A struct that collects statistics about how much of the MPI data
+     * exchange in the matrix-free loops could be overlapped with the work on
+     * cells that do not depend on remote data. The statistics are only
+     * collected if TaskInfo::test_communication_progress is set and the loop
+     * is run without threads.
+     *
+     * For each data exchange (an update of ghost values or a compress
+     * operation) we record the wall time between the start of the exchange
+     * and the point when the data is available, either because the tests
+     * between two cell ranges found all messages to be completed or because
+     * the respective finish() call returned. The part of that time that
+     * passed before the finish() call was entered counts as hidden.
+     */
+    struct CommunicationOverlapStatistics
+    {
+      /**
+       * Constructor.
+       */
+      CommunicationOverlapStatistics();
+
+      /**
+       * Resets all counters to zero.
+       */
+      void
+      clear();
+
+      /**
+       * Returns the fraction of the time spent in data exchanges that was
+       * hidden behind computations, i.e., time_hidden / time_exchange. If no
+       * exchange has been recorded, zero is returned.
+       */
+      double
+      hidden_fraction() const;
+
+      /**
+       * Prints the statistics, accumulated over all MPI processes in the
+       * given communicator, to the given stream. This is a collective call.
+       */
+      template <typename StreamType>
+      void
+      print(StreamType &out, const MPI_Comm &communicator) const;
+
+      /**
+       * Number of data exchanges recorded.
+       */
+      unsigned long long int n_exchanges;
+
+      /**
+       * Number of data exchanges whose messages had all arrived before the
+       * finish() call was entered, i.e., which were completely hidden.
+       */
+      unsigned long long int n_exchanges_hidden;
+
+      /**
+       * Number of calls to the test functions of the worker.
+       */
+      unsigned long long int n_tests;
+
+      /**
+       * Accumulated wall time in seconds between the start of the data
+       * exchanges and the point when their data was available.
+       */
+      double time_exchange;
+
+      /**
+       * Accumulated part of @p time_exchange that passed before the finish()
+       * calls were entered.
+       */
+      double time_hidden;
+    };
+
+
+
+    /**
+     * A struct that collects per-worker statistics of the dynamically
+     * scheduled loop, TaskInfo::partition_partition_dynamic. Each of the
+     * workers spawned by the loop picks the next free chunk of cells from
+     * the list of conflict-free chunks of the current phase. For every
+     * worker we record the wall time spent working on chunks and the wall
+     * time spent waiting for the other workers to complete the phase.
+     *
+     * The workers are numbered by the slot they occupy in the loop, which
+     * need not coincide with a particular operating system thread.
+     */
+    struct TaskLoadStatistics
+    {
+      /**
+       * Constructor.
+       */
+      TaskLoadStatistics();
+
+      /**
+       * Resets all counters to zero.
+       */
+      void
+      clear();
+
+      /**
+       * Make sure that the counters can hold @p n_workers entries.
+       */
+      void
+      resize(const unsigned int n_workers);
+
+      /**
+       * Returns the fraction of the total time of all workers that they
+       * spent waiting, i.e., the sum of @p idle_time divided by the sum of
+       * @p busy_time and @p idle_time. If nothing has been recorded, zero is
+       * returned.
+       */
+      double
+      idle_fraction() const;
+
+      /**
+       * Prints the statistics of the workers, accumulated over all MPI
+       * processes in the given communicator, to the given stream. This is a
+       * collective call.
+       */
+      template <typename StreamType>
+      void
+      print(StreamType &out, const MPI_Comm &communicator) const;
+
+      /**
+       * Number of loops recorded.
+       */
+      unsigned long long int n_loops;
+
+      /**
+       * Number of chunks processed by each worker.
+       */
+      std::vector<unsigned long long int> n_chunks;
+
+      /**
+       * Accumulated wall time in seconds each worker spent on chunks.
+       */
+      std::vector<double> busy_time;
+
+      /**
+       * Accumulated wall time in seconds each worker spent waiting for the
+       * end of a phase, including the time before it got started.
+       */
+      std::vector<double> idle_time;
+    };
+
+
+
     /**
      * A struct that collects all information related to parallelization with
      * threads: The work is subdivided into tasks that can be done
@@ -108,13 +272,15 @@ namespace internal
       // enum for choice of how to build the task graph. Odd add versions with
       // preblocking and even versions with postblocking. partition_partition
       // and partition_color are deprecated but kept for backward
-      // compatibility.
+      // compatibility. partition_partition_dynamic uses the same graph as
+      // partition_partition but schedules the subpartitions dynamically.
       enum TasksParallelScheme
       {
         none,
         partition_partition,
         partition_color,
-        color
+        color,
+        partition_partition_dynamic
       };
 
       /**
@@ -623,6 +789,28 @@ namespace internal
        * Number of MPI rank for the current communicator
        */
       unsigned int n_procs;
+
+      /**
+       * If set to true, the serial loop tests the outstanding MPI requests of
+       * the ghost value update and compress operations after each range of
+       * cells that does not depend on remote data. This gives MPI
+       * implementations without asynchronous progress a chance to move the
+       * messages while computations are done, and records the achieved
+       * overlap in @p communication_statistics.
+       */
+      bool test_communication_progress;
+
+      /**
+       * Statistics about the overlap of communication and computation,
+       * collected in loop() if @p test_communication_progress is set.
+       */
+      mutable CommunicationOverlapStatistics communication_statistics;
+
+      /**
+       * Busy and idle times of the workers, collected in loop() for the
+       * scheme partition_partition_dynamic.
+       */
+      mutable TaskLoadStatistics load_statistics;
     };
 
   } // end of namespace MatrixFreeFunctions
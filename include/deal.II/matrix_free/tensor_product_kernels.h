@@ -23,6 +23,8 @@
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/matrix_free/operation_counter.h>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -357,6 +359,9 @@ namespace internal
     constexpr int n_blocks2 =
       Utilities::pow(n_rows, (direction >= dim) ? 0 : (dim - direction - 1));
 
+    MatrixFreeFunctions::count_arithmetic_operations<Number>(
+      n_blocks1 * n_blocks2 * nn * (2 * mm - 1 + add));
+
     for (int i2 = 0; i2 < n_blocks2; ++i2)
       {
         for (int i1 = 0; i1 < n_blocks1; ++i1)
@@ -443,6 +448,9 @@ namespace internal
     constexpr int out_stride = Utilities::pow(n_rows, dim - 1);
     const Number *DEAL_II_RESTRICT shape_values = this->shape_values;
 
+    MatrixFreeFunctions::count_arithmetic_operations<Number>(
+      n_blocks1 * n_blocks2 * (max_derivative + 1) * (2 * n_rows - 1 + add));
+
     for (int i2 = 0; i2 < n_blocks2; ++i2)
       {
         for (int i1 = 0; i1 < n_blocks1; ++i1)
@@ -741,6 +749,9 @@ namespace internal
                             Utilities::fixed_power<dim - direction - 1>(n_rows);
     Assert(n_rows <= 128, ExcNotImplemented());
 
+    MatrixFreeFunctions::count_arithmetic_operations<Number>(
+      n_blocks1 * n_blocks2 * nn * (2 * mm - 1 + add));
+
     // specialization for n_rows = 2 that manually unrolls the innermost loop
     // to make the operation perform better (not completely as good as the
     // templated one, but much better than the generic version down below,
@@ -884,6 +895,9 @@ namespace internal
     const int out_stride =
       dim > 1 ? Utilities::fixed_power<dim - 1>(n_rows) : 1;
 
+    MatrixFreeFunctions::count_arithmetic_operations<Number>(
+      n_blocks1 * n_blocks2 * (max_derivative + 1) * (2 * n_rows - 1 + add));
+
     for (int i2 = 0; i2 < n_blocks2; ++i2)
       {
         for (int i1 = 0; i1 < n_blocks1; ++i1)
@@ -1794,6 +1808,13 @@ namespace internal
 
     constexpr int offset = (n_columns + 1) / 2;
 
+    // per line, form the mid sums and differences of the input, contract
+    // them for n_cols pairs of output, and possibly a middle output entry
+    MatrixFreeFunctions::count_arithmetic_operations<Number>(
+      n_blocks1 * n_blocks2 *
+      (2 * mid + n_cols * (4 * mid + 2 * (mm % 2) + 2 * add) +
+       (nn % 2) * (2 * mid + (mm % 2) + add)));
+
     // this code may look very inefficient at first sight due to the many
     // different cases with if's at the innermost loop part, but all of the
     // conditionals can be evaluated at compile time because they are
@@ -2520,29 +2541,91 @@ namespace internal
 
 
   /**
-   * Same as evaluate_tensor_product_value_and_gradient() but for integration.
+   * Same as evaluate_tensor_product_value_and_gradient() but for integration,
+   * i.e., the transpose operation: The contributions of the tensor product
+   * shape functions $\varphi_i$ tested by @p value and of their gradients in
+   * reference coordinates tested by @p gradient at the point @p p are added
+   * into the coefficients @p values, i.e., $u_i \mathrel{+}= \varphi_i(p)
+   * \cdot \text{value} + \nabla \varphi_i(p) \cdot \text{gradient}$.
+   *
+   * The type `Number2` of the point is typically a VectorizedArray, which
+   * means that all lanes of the point are integrated at once. In that case,
+   * the coefficients @p values are of vectorized type as well and the caller
+   * has to sum the lanes to obtain the final integral. The optional
+   * parameter @p renumber has the same meaning as for the evaluation.
    */
   template <int dim, typename Number, typename Number2>
   inline void
   integrate_tensor_product_value_and_gradient(
-    const std::vector<Polynomials::Polynomial<double>> &      poly,
-    const std::vector<Number> &                               values,
-    const typename ProductTypeNoPoint<Number, Number2>::type &value,
-    const Tensor<1, dim, typename ProductTypeNoPoint<Number, Number2>::type>
-      &                              gradient,
-    const Point<dim, Number2> &      p,
-    const bool                       d_linear = false,
-    const std::vector<unsigned int> &renumber = {})
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    AlignedVector<Number> &                             values,
+    const Number &                                      value,
+    const Tensor<1, dim, Number> &                      gradient,
+    const Point<dim, Number2> &                         p,
+    const std::vector<unsigned int> &                   renumber = {})
   {
-    Assert(false, ExcNotImplemented());
-
-    (void)poly;
-    (void)values;
-    (void)value;
-    (void)gradient;
-    (void)p;
-    (void)d_linear;
-    (void)renumber;
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    const unsigned int n_shapes = poly.size();
+    AssertDimension(Utilities::pow(n_shapes, dim), values.size());
+    Assert(renumber.empty() || renumber.size() == values.size(),
+           ExcDimensionMismatch(renumber.size(), values.size()));
+
+    AssertIndexRange(n_shapes, 200);
+    std::array<Number2, 2 * dim * 200> shapes;
+
+    // Evaluate 1D polynomials and their derivatives
+    for (unsigned int d = 0; d < dim; ++d)
+      for (unsigned int i = 0; i < n_shapes; ++i)
+        poly[i].value(p[d], 1, shapes.data() + 2 * (d * n_shapes + i));
+
+    // Go through the tensor product of shape functions in the same order as
+    // for evaluation, but apply the 1D factors from the outermost direction
+    // inwards
+    for (unsigned int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
+      {
+        // Test in z direction
+        Number value_y = {}, deriv_x = {}, deriv_y = {};
+        if (dim == 3)
+          {
+            value_y = shapes[4 * n_shapes + 2 * i2] * value +
+                      shapes[4 * n_shapes + 2 * i2 + 1] * gradient[dim - 1];
+            deriv_x = shapes[4 * n_shapes + 2 * i2] * gradient[0];
+            deriv_y = shapes[4 * n_shapes + 2 * i2] * gradient[dim > 1 ? 1 : 0];
+          }
+        else if (dim == 2)
+          {
+            value_y = value;
+            deriv_x = gradient[0];
+            deriv_y = gradient[dim > 1 ? 1 : 0];
+          }
+        for (unsigned int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
+          {
+            // Test in y direction
+            Number value_x = {}, deriv = {};
+            if (dim > 1)
+              {
+                value_x = shapes[2 * n_shapes + 2 * i1] * value_y +
+                          shapes[2 * n_shapes + 2 * i1 + 1] * deriv_y;
+                deriv   = shapes[2 * n_shapes + 2 * i1] * deriv_x;
+              }
+            else
+              {
+                value_x = value;
+                deriv   = gradient[0];
+              }
+
+            // Test in x direction and add into the coefficients
+            if (renumber.empty())
+              for (unsigned int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                values[i] +=
+                  shapes[2 * i0] * value_x + shapes[2 * i0 + 1] * deriv;
+            else
+              for (unsigned int i0 = 0; i0 < n_shapes; ++i0, ++i)
+                values[renumber[i]] +=
+                  shapes[2 * i0] * value_x + shapes[2 * i0 + 1] * deriv;
+          }
+      }
   }
 
 
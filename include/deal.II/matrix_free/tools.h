@@ -18,12 +18,26 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/function.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/partitioner.h>
+
+#include <deal.II/distributed/tria_base.h>
+
 #include <deal.II/grid/tria.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
 #include <deal.II/matrix_free/fe_evaluation.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/vector_access_internal.h>
 
+#include <deal.II/numerics/error_estimator.h>
+#include <deal.II/numerics/vector_tools_common.h>
+
+#include <mutex>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -102,6 +116,14 @@ namespace MatrixFreeTools
    * @p matrix_free and the local cell integral operation @p local_vmult.
    * Constrained entries on the diagonal are set to one.
    *
+   * The cell matrices are computed within MatrixFree::cell_loop(), i.e., in
+   * parallel with threads if the MatrixFree object was set up with a
+   * AdditionalData::tasks_parallel_scheme different from
+   * AdditionalData::none. The cell matrices of each range of cell batches
+   * are first collected and then added to @p matrix in one go. Since the
+   * matrix classes of external libraries are not thread-safe when adding
+   * entries, the insertion in the threaded case is serialized by a mutex.
+   *
    * The parameters @p dof_no, @p quad_no, and @p first_selected_component are
    * passed to the constructor of the FEEvaluation that is internally set up.
    */
@@ -154,6 +176,171 @@ namespace MatrixFreeTools
     const unsigned int quad_no                  = 0,
     const unsigned int first_selected_component = 0);
 
+  /**
+   * Compute the cell matrices of all cells of the cell batch @p integrator
+   * is currently initialized on, given the local cell integral operation
+   * @p local_vmult (a callable taking the FEEvaluation object as argument).
+   * Upon return, lane <i>v</i> of @p cell_matrix(i, j) holds the entry
+   * $(i,j)$ of the matrix of the <i>v</i>-th cell in the batch, with the
+   * unknowns numbered as in FEEvaluation::begin_dof_values(). All cells of
+   * the batch are thus computed at once with SIMD instructions.
+   *
+   * Together with distribute_local_to_global() below, this function allows
+   * to write matrix-based assembly loops over cell batches by hand, e.g. to
+   * fill several matrices or to add contributions not expressible by
+   * compute_matrix().
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename LocalOperation>
+  void
+  compute_cell_matrix(FEEvaluation<dim,
+                                   fe_degree,
+                                   n_q_points_1d,
+                                   n_components,
+                                   Number,
+                                   VectorizedArrayType> &integrator,
+                      const LocalOperation &              local_vmult,
+                      Table<2, VectorizedArrayType> &     cell_matrix);
+
+  /**
+   * Add the cell matrices of the cell batch @p integrator is currently
+   * initialized on, as computed by compute_cell_matrix(), to the global
+   * @p matrix, resolving the constraints in @p constraints. Only the lanes
+   * that are filled with actual cells are considered. The parameter
+   * @p dof_no must be the same as the one the FEEvaluation object was
+   * constructed with.
+   *
+   * This function is not thread-safe for the matrix types of external
+   * libraries, see compute_matrix() for how to guard the insertion when
+   * running inside MatrixFree::cell_loop() with threads.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename MatrixType>
+  void
+  distribute_local_to_global(
+    const FEEvaluation<dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number,
+                       VectorizedArrayType> &                 integrator,
+    const Table<2, VectorizedArrayType> &                     cell_matrix,
+    const AffineConstraints<typename MatrixType::value_type> &constraints,
+    MatrixType &                                              matrix,
+    const unsigned int                                        dof_no = 0);
+
+  /**
+   * Compute the error indicator of KellyErrorEstimator for the solution
+   * @p solution with the face loops of @p matrix_free, i.e., the square root
+   * of the (scaled) integrals of the squared jumps of the normal derivative
+   * of @p solution over the faces of each cell. Instead of visiting every
+   * face from both adjacent cells and evaluating it with FEFaceValues, every
+   * inner face is evaluated exactly once, for a batch of faces at a time
+   * with FEFaceEvaluation and the vectorized sum factorization kernels of
+   * the matrix-free framework. The result matches the one of
+   * KellyErrorEstimator::estimate() with default arguments (constant
+   * coefficient, no Neumann boundary data, i.e., boundary faces do not
+   * contribute) and the given @p strategy, up to the differences in the
+   * quadrature formula on the faces.
+   *
+   * Faces with hanging nodes are included: the face integral over the
+   * refined side of the face is added to both the fine and the coarse cell,
+   * as done by KellyErrorEstimator. If @p solution is a
+   * LinearAlgebra::distributed::Vector, it is read in place; its ghost values
+   * are imported if they are not already present, and reset afterwards. For
+   * faces between cells owned by different processes, the contribution to
+   * the cell on the other process is sent to its owner, so @p error
+   * contains the correct values on all locally owned cells. The values on
+   * all other cells are set to zero.
+   *
+   * @p matrix_free needs to be set up with
+   * MatrixFree::AdditionalData::mapping_update_flags_inner_faces including
+   * update_gradients and update_JxW_values, and @p quad_no needs to refer to
+   * a quadrature formula for which this information was computed. The
+   * template arguments @p fe_degree and @p n_q_points_1d are the ones of
+   * FEFaceEvaluation. If @p n_components is smaller than the number of
+   * components of the finite element, the components starting at
+   * @p first_selected_component are considered.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  estimate_kelly_error(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  solution,
+    Vector<float> &                                     error,
+    const unsigned int                                  dof_no = 0,
+    const unsigned int                                  quad_no = 0,
+    const unsigned int first_selected_component                 = 0,
+    const typename KellyErrorEstimator<dim>::Strategy strategy =
+      KellyErrorEstimator<dim>::cell_diameter_over_24);
+
+  /**
+   * Compute the cellwise error of the finite element function @p fe_function
+   * with respect to @p exact_solution in the norm @p norm, like
+   * VectorTools::integrate_difference(), but with the data structures of
+   * @p matrix_free: the finite element function is evaluated with
+   * FEEvaluation for a whole batch of cells at a time, the quadrature points
+   * of a cell are handed to @p exact_solution in batches through
+   * Function::vectorized_vector_value_list(), and the cell batches are split
+   * among threads. The results are written into @p difference, indexed by
+   * the active cell index, with zeros on all cells that are not locally
+   * owned, so that VectorTools::compute_global_error() can be used to
+   * compute the global error, including the reduction over all processes.
+   *
+   * The norms VectorTools::L1_norm, VectorTools::L2_norm,
+   * VectorTools::Linfty_norm, VectorTools::H1_seminorm, and
+   * VectorTools::H1_norm are supported. In contrast to
+   * VectorTools::integrate_difference(), there is no weight function, and
+   * the quadrature formula is the one with index @p quad_no in
+   * @p matrix_free. The @p n_components components of the finite element
+   * starting at @p first_selected_component are compared to the components
+   * of @p exact_solution, which needs to have @p n_components components.
+   *
+   * The entries of @p fe_function are read without resolving constraints,
+   * i.e., @p fe_function needs to hold the correct values for the
+   * constrained degrees of freedom as well, as it is the case after calling
+   * AffineConstraints::distribute(). This requires
+   * MatrixFree::AdditionalData::store_plain_indices, which is set by
+   * default. In addition, @p matrix_free needs to be set up with
+   * update_quadrature_points in
+   * MatrixFree::AdditionalData::mapping_update_flags. If @p fe_function is a
+   * LinearAlgebra::distributed::Vector without ghost values, they are
+   * imported before and reset after the computation.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  fe_function,
+    const Function<dim> &                               exact_solution,
+    Vector<float> &                                     difference,
+    const VectorTools::NormType &                       norm,
+    const unsigned int                                  dof_no  = 0,
+    const unsigned int                                  quad_no = 0,
+    const unsigned int first_selected_component                 = 0);
+
 
   // implementations
 
@@ -421,6 +608,18 @@ namespace MatrixFreeTools
                   }
               }
 
+            // STEP 2a': on cells where hanging nodes are resolved by
+            //   FEEvaluation, the constraints above act on the values
+            //   interpolated from the parent cell; compose them with the
+            //   interpolation matrix
+            const unsigned short hanging_node_mask =
+              dof_info.hanging_node_constraint_masks.empty() ?
+                0 :
+                dof_info.hanging_node_constraint_masks[cell * n_lanes + v];
+            if (hanging_node_mask != 0)
+              apply_hanging_node_interpolation(hanging_node_mask,
+                                               locally_relevant_constrains);
+
             // STEP 2b: transpose COO
 
             // presort vector for transposed access
@@ -567,6 +766,84 @@ namespace MatrixFreeTools
       }
 
     private:
+      /**
+       * Replace the entries (local index, global index, weight) of the
+       * locally-relevant constraint matrix, given in terms of the values
+       * interpolated from the parent cell, by the entries acting on the
+       * degrees of freedom of the cell itself, using the hanging-node
+       * interpolation identified by @p mask.
+       */
+      void
+      apply_hanging_node_interpolation(
+        const unsigned short mask,
+        std::vector<std::tuple<unsigned int, unsigned int, Number>>
+          &locally_relevant_constrains) const
+      {
+        const auto &shape_data = phi.get_shape_info().data.front();
+        const unsigned int degree             = shape_data.fe_degree;
+        const unsigned int dofs_per_component = phi.dofs_per_component;
+
+        using HangingNodesKernel =
+          dealii::internal::FEEvaluationImplHangingNodes<dim,
+                                                         VectorizedArrayType>;
+
+        // compute the interpolation matrix column by column by applying
+        // the hanging-node kernel to unit vectors
+        AlignedVector<VectorizedArrayType> buffer(dofs_per_component +
+                                                  2 * (degree + 1));
+        std::vector<Number> interpolation(dofs_per_component *
+                                          dofs_per_component);
+        for (unsigned int j = 0; j < dofs_per_component; ++j)
+          {
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              buffer[i] = static_cast<Number>(i == j);
+            HangingNodesKernel::template run<false>(
+              1,
+              degree,
+              mask,
+              shape_data.subface_interpolation_matrix,
+              buffer.begin() + dofs_per_component,
+              buffer.begin());
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              interpolation[i * dofs_per_component + j] = buffer[i][0];
+          }
+
+        std::vector<std::tuple<unsigned int, unsigned int, Number>> composed;
+        for (const auto &entry : locally_relevant_constrains)
+          {
+            const unsigned int comp = std::get<0>(entry) / dofs_per_component;
+            const unsigned int j    = std::get<0>(entry) % dofs_per_component;
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              if (interpolation[i * dofs_per_component + j] != Number())
+                composed.emplace_back(
+                  comp * dofs_per_component + i,
+                  std::get<1>(entry),
+                  interpolation[i * dofs_per_component + j] *
+                    std::get<2>(entry));
+          }
+
+        // several parent values can contribute to the same entry, so sum
+        // up duplicates rather than only removing them
+        std::sort(composed.begin(),
+                  composed.end(),
+                  [](const auto &a, const auto &b) {
+                    return std::get<0>(a) < std::get<0>(b) ||
+                           (std::get<0>(a) == std::get<0>(b) &&
+                            std::get<1>(a) < std::get<1>(b));
+                  });
+        locally_relevant_constrains.clear();
+        for (const auto &entry : composed)
+          if (!locally_relevant_constrains.empty() &&
+              std::get<0>(locally_relevant_constrains.back()) ==
+                std::get<0>(entry) &&
+              std::get<1>(locally_relevant_constrains.back()) ==
+                std::get<1>(entry))
+            std::get<2>(locally_relevant_constrains.back()) +=
+              std::get<2>(entry);
+          else
+            locally_relevant_constrains.push_back(entry);
+      }
+
       FEEvaluation<dim,
                    fe_degree,
                    n_q_points_1d,
@@ -736,6 +1013,65 @@ namespace MatrixFreeTools
 
       return *new_constraints;
     }
+
+    /**
+     * Append the cell matrices stored in the filled lanes of @p cell_matrix
+     * to @p matrices, together with the respective dof indices of the cells
+     * in the cell batch @p integrator is currently initialized on, permuted
+     * to the numbering of the unknowns within FEEvaluation.
+     */
+    template <int dim,
+              int fe_degree,
+              int n_q_points_1d,
+              int n_components,
+              typename Number,
+              typename VectorizedArrayType,
+              typename MatrixNumber>
+    void
+    extract_cell_matrices(
+      const FEEvaluation<dim,
+                         fe_degree,
+                         n_q_points_1d,
+                         n_components,
+                         Number,
+                         VectorizedArrayType> &      integrator,
+      const Table<2, VectorizedArrayType> &          cell_matrix,
+      const unsigned int                             dof_no,
+      std::vector<FullMatrix<MatrixNumber>> &        matrices,
+      std::vector<std::vector<types::global_dof_index>> &dof_indices_mf)
+    {
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free =
+        integrator.get_matrix_free();
+      const unsigned int dofs_per_cell = integrator.dofs_per_cell;
+      const unsigned int cell          = integrator.get_current_cell_index();
+      const unsigned int n_filled_lanes =
+        matrix_free.n_active_entries_per_cell_batch(cell);
+      const std::vector<unsigned int> &lexicographic_numbering =
+        integrator.get_shape_info().lexicographic_numbering;
+
+      AssertDimension(cell_matrix.size(0), dofs_per_cell);
+      AssertDimension(cell_matrix.size(1), dofs_per_cell);
+
+      std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+      for (unsigned int v = 0; v < n_filled_lanes; ++v)
+        {
+          const auto cell_v = matrix_free.get_cell_iterator(cell, v, dof_no);
+
+          if (matrix_free.get_mg_level() != numbers::invalid_unsigned_int)
+            cell_v->get_mg_dof_indices(dof_indices);
+          else
+            cell_v->get_dof_indices(dof_indices);
+
+          dof_indices_mf.emplace_back(dofs_per_cell);
+          for (unsigned int j = 0; j < dof_indices.size(); ++j)
+            dof_indices_mf.back()[j] = dof_indices[lexicographic_numbering[j]];
+
+          matrices.emplace_back(dofs_per_cell, dofs_per_cell);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              matrices.back()(i, j) = cell_matrix(i, j)[v];
+        }
+    }
   } // namespace internal
 
   template <int dim,
@@ -767,6 +1103,13 @@ namespace MatrixFreeTools
                                                         constraints_in,
                                                         constraints_for_matrix);
 
+    // cell ranges get scheduled concurrently when tasks are enabled, so the
+    // addition of the cell matrices into the global matrix must be guarded
+    const bool use_lock =
+      matrix_free.get_task_info().scheme !=
+      dealii::internal::MatrixFreeFunctions::TaskInfo::none;
+    std::mutex insertion_mutex;
+
     matrix_free.template cell_loop<MatrixType, MatrixType>(
       [&](const auto &, auto &dst, const auto &, const auto range) {
         FEEvaluation<dim,
@@ -778,70 +1121,31 @@ namespace MatrixFreeTools
           integrator(
             matrix_free, range, dof_no, quad_no, first_selected_component);
 
-        unsigned int const dofs_per_cell = integrator.dofs_per_cell;
-
-        std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
-        std::vector<types::global_dof_index> dof_indices_mf(dofs_per_cell);
-
-        std::array<FullMatrix<typename MatrixType::value_type>,
-                   VectorizedArrayType::size()>
-          matrices;
-
-        std::fill_n(matrices.begin(),
-                    VectorizedArrayType::size(),
-                    FullMatrix<typename MatrixType::value_type>(dofs_per_cell,
-                                                                dofs_per_cell));
-
-        const auto lexicographic_numbering =
-          matrix_free
-            .get_shape_info(dof_no,
-                            quad_no,
-                            first_selected_component,
-                            integrator.get_active_fe_index(),
-                            integrator.get_active_quadrature_index())
-            .lexicographic_numbering;
+        // collect the cell matrices and the indices of all cells in the
+        // range before adding them to the global matrix
+        const unsigned int n_cells_max =
+          (range.second - range.first) * VectorizedArrayType::size();
+        std::vector<FullMatrix<typename MatrixType::value_type>> matrices;
+        std::vector<std::vector<types::global_dof_index>> dof_indices_mf;
+        matrices.reserve(n_cells_max);
+        dof_indices_mf.reserve(n_cells_max);
 
+        Table<2, VectorizedArrayType> cell_matrix;
         for (auto cell = range.first; cell < range.second; ++cell)
           {
             integrator.reinit(cell);
-
-            unsigned int const n_filled_lanes =
-              matrix_free.n_active_entries_per_cell_batch(cell);
-
-            for (unsigned int v = 0; v < n_filled_lanes; ++v)
-              matrices[v] = 0.0;
-
-            for (unsigned int j = 0; j < dofs_per_cell; ++j)
-              {
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  integrator.begin_dof_values()[i] =
-                    static_cast<Number>(i == j);
-
-                local_vmult(integrator);
-
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  for (unsigned int v = 0; v < n_filled_lanes; ++v)
-                    matrices[v](i, j) = integrator.begin_dof_values()[i][v];
-              }
-
-            for (unsigned int v = 0; v < n_filled_lanes; ++v)
-              {
-                const auto cell_v =
-                  matrix_free.get_cell_iterator(cell, v, dof_no);
-
-                if (matrix_free.get_mg_level() != numbers::invalid_unsigned_int)
-                  cell_v->get_mg_dof_indices(dof_indices);
-                else
-                  cell_v->get_dof_indices(dof_indices);
-
-                for (unsigned int j = 0; j < dof_indices.size(); ++j)
-                  dof_indices_mf[j] = dof_indices[lexicographic_numbering[j]];
-
-                constraints.distribute_local_to_global(matrices[v],
-                                                       dof_indices_mf,
-                                                       dst);
-              }
+            compute_cell_matrix(integrator, local_vmult, cell_matrix);
+            internal::extract_cell_matrices(
+              integrator, cell_matrix, dof_no, matrices, dof_indices_mf);
           }
+
+        std::unique_lock<std::mutex> lock(insertion_mutex, std::defer_lock);
+        if (use_lock)
+          lock.lock();
+        for (unsigned int c = 0; c < matrices.size(); ++c)
+          constraints.distribute_local_to_global(matrices[c],
+                                                 dof_indices_mf[c],
+                                                 dst);
       },
       matrix,
       matrix);
@@ -890,6 +1194,435 @@ namespace MatrixFreeTools
                                first_selected_component);
   }
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename LocalOperation>
+  void
+  compute_cell_matrix(FEEvaluation<dim,
+                                   fe_degree,
+                                   n_q_points_1d,
+                                   n_components,
+                                   Number,
+                                   VectorizedArrayType> &integrator,
+                      const LocalOperation &              local_vmult,
+                      Table<2, VectorizedArrayType> &     cell_matrix)
+  {
+    const unsigned int dofs_per_cell = integrator.dofs_per_cell;
+    cell_matrix.reinit(dofs_per_cell, dofs_per_cell);
+
+    // apply the local operator to all unit vectors, which gives the columns
+    // of the cell matrices of all cells in the batch at once
+    for (unsigned int j = 0; j < dofs_per_cell; ++j)
+      {
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          integrator.begin_dof_values()[i] = static_cast<Number>(i == j);
+
+        local_vmult(integrator);
+
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          cell_matrix(i, j) = integrator.begin_dof_values()[i];
+      }
+  }
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename MatrixType>
+  void
+  distribute_local_to_global(
+    const FEEvaluation<dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number,
+                       VectorizedArrayType> &                 integrator,
+    const Table<2, VectorizedArrayType> &                     cell_matrix,
+    const AffineConstraints<typename MatrixType::value_type> &constraints,
+    MatrixType &                                              matrix,
+    const unsigned int                                        dof_no)
+  {
+    std::vector<FullMatrix<typename MatrixType::value_type>> matrices;
+    std::vector<std::vector<types::global_dof_index>>        dof_indices_mf;
+    matrices.reserve(VectorizedArrayType::size());
+    dof_indices_mf.reserve(VectorizedArrayType::size());
+
+    internal::extract_cell_matrices(
+      integrator, cell_matrix, dof_no, matrices, dof_indices_mf);
+
+    for (unsigned int c = 0; c < matrices.size(); ++c)
+      constraints.distribute_local_to_global(matrices[c],
+                                             dof_indices_mf[c],
+                                             matrix);
+  }
+
+  namespace internal
+  {
+    /**
+     * Import the ghost values of @p vector if they are not present yet, and
+     * return whether this was done. Vectors other than
+     * LinearAlgebra::distributed::Vector are expected to allow read access
+     * to all the entries needed by the local cells already.
+     */
+    template <typename VectorType>
+    bool
+    import_ghost_values_if_needed(const VectorType &)
+    {
+      return false;
+    }
+
+    template <typename Number>
+    bool
+    import_ghost_values_if_needed(
+      const LinearAlgebra::distributed::Vector<Number> &vector)
+    {
+      if (vector.has_ghost_elements())
+        return false;
+
+      vector.update_ghost_values();
+      return true;
+    }
+
+    template <typename VectorType>
+    void
+    zero_out_ghost_values(const VectorType &)
+    {}
+
+    template <typename Number>
+    void
+    zero_out_ghost_values(
+      const LinearAlgebra::distributed::Vector<Number> &vector)
+    {
+      vector.zero_out_ghost_values();
+    }
+  } // namespace internal
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  estimate_kelly_error(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  solution,
+    Vector<float> &                                     error,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no,
+    const unsigned int first_selected_component,
+    const typename KellyErrorEstimator<dim>::Strategy strategy)
+  {
+    const Triangulation<dim> &tria =
+      matrix_free.get_dof_handler(dof_no).get_triangulation();
+
+    const bool ghosts_imported =
+      internal::import_ghost_values_if_needed(solution);
+
+    // compute the integrals of the squared jump of the normal derivative
+    // over all inner faces, one batch of faces at a time. every face is
+    // owned by exactly one process, so no face is computed twice
+    const unsigned int n_face_batches = matrix_free.n_inner_face_batches();
+    std::vector<VectorizedArrayType> face_integrals(n_face_batches);
+
+    parallel::apply_to_subranges(
+      0U,
+      n_face_batches,
+      [&](const unsigned int begin, const unsigned int end) {
+        FEFaceEvaluation<dim,
+                         fe_degree,
+                         n_q_points_1d,
+                         n_components,
+                         Number,
+                         VectorizedArrayType>
+          phi_m(matrix_free, true, dof_no, quad_no, first_selected_component);
+        FEFaceEvaluation<dim,
+                         fe_degree,
+                         n_q_points_1d,
+                         n_components,
+                         Number,
+                         VectorizedArrayType>
+          phi_p(matrix_free, false, dof_no, quad_no, first_selected_component);
+
+        for (unsigned int face = begin; face < end; ++face)
+          {
+            phi_m.reinit(face);
+            phi_m.gather_evaluate(solution, EvaluationFlags::gradients);
+            phi_p.reinit(face);
+            phi_p.gather_evaluate(solution, EvaluationFlags::gradients);
+
+            // both normal derivatives are taken with respect to the normal
+            // of the interior cell
+            VectorizedArrayType integral = 0.;
+            for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+              {
+                const auto jump = phi_m.get_normal_derivative(q) -
+                                  phi_p.get_normal_derivative(q);
+                integral += (jump * jump) * phi_m.JxW(q);
+              }
+            face_integrals[face] = integral;
+          }
+      },
+      std::max<unsigned int>(1, 64 / VectorizedArrayType::size()));
+
+    if (ghosts_imported)
+      internal::zero_out_ghost_values(solution);
+
+    // add the face integrals to the cells on both sides of the faces. the
+    // cells are identified by their global active cell index, which allows
+    // to send the contributions to cells on other processes to their owners
+    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
+    if (const auto tria_parallel =
+          dynamic_cast<const parallel::TriangulationBase<dim> *>(&tria))
+      partitioner =
+        tria_parallel->global_active_cell_index_partitioner().lock();
+    else
+      partitioner = std::make_shared<const Utilities::MPI::Partitioner>(
+        tria.n_active_cells());
+
+    LinearAlgebra::distributed::Vector<double> cell_integrals(partitioner);
+
+    for (unsigned int face = 0; face < n_face_batches; ++face)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_face_batch(face);
+           ++v)
+        {
+          const auto interior = matrix_free.get_face_iterator(face, v, true);
+          const auto exterior = matrix_free.get_face_iterator(face, v, false);
+
+          double face_factor = 1.;
+          if (strategy ==
+              KellyErrorEstimator<dim>::face_diameter_over_twice_max_degree)
+            {
+              // the interior cell is always the one on the refined side of
+              // a face with hanging nodes, so the diameter of its face is
+              // the one of the subface
+              const double max_degree =
+                std::max(interior.first->get_fe().degree,
+                         exterior.first->get_fe().degree);
+              face_factor =
+                interior.first->face(interior.second)->diameter() /
+                max_degree / 2.0;
+            }
+
+          const double value = face_factor * face_integrals[face][v];
+          cell_integrals[interior.first->global_active_cell_index()] += value;
+          cell_integrals[exterior.first->global_active_cell_index()] += value;
+        }
+
+    cell_integrals.compress(VectorOperation::add);
+
+    error.reinit(tria.n_active_cells());
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          double cell_factor = 1.;
+          if (strategy == KellyErrorEstimator<dim>::cell_diameter_over_24)
+            cell_factor = cell->diameter() / 24;
+          else if (strategy == KellyErrorEstimator<dim>::cell_diameter)
+            cell_factor = cell->diameter();
+
+          error(cell->active_cell_index()) = std::sqrt(
+            cell_factor * cell_integrals[cell->global_active_cell_index()]);
+        }
+  }
+
+  namespace internal
+  {
+    /**
+     * Access the component @p component of a value or gradient as returned
+     * by FEEvaluation::get_value() or FEEvaluation::get_gradient(), which
+     * are tensors over the components for vector-valued elements, but the
+     * plain value or gradient for scalar elements.
+     */
+    template <int n_components>
+    struct ComponentAccess
+    {
+      template <typename T>
+      static const T &
+      get(const Tensor<1, n_components, T> &value, const unsigned int component)
+      {
+        return value[component];
+      }
+    };
+
+    template <>
+    struct ComponentAccess<1>
+    {
+      template <typename T>
+      static const T &
+      get(const T &value, const unsigned int)
+      {
+        return value;
+      }
+    };
+  } // namespace internal
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType &                                  fe_function,
+    const Function<dim> &                               exact_solution,
+    Vector<float> &                                     difference,
+    const VectorTools::NormType &                       norm,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no,
+    const unsigned int first_selected_component)
+  {
+    AssertDimension(exact_solution.n_components, n_components);
+    AssertThrow(norm == VectorTools::L1_norm || norm == VectorTools::L2_norm ||
+                  norm == VectorTools::Linfty_norm ||
+                  norm == VectorTools::H1_seminorm ||
+                  norm == VectorTools::H1_norm,
+                ExcNotImplemented());
+
+    const bool needs_values    = (norm != VectorTools::H1_seminorm);
+    const bool needs_gradients = (norm == VectorTools::H1_seminorm ||
+                                  norm == VectorTools::H1_norm);
+
+    EvaluationFlags::EvaluationFlags evaluation_flags =
+      EvaluationFlags::nothing;
+    if (needs_values)
+      evaluation_flags |= EvaluationFlags::values;
+    if (needs_gradients)
+      evaluation_flags |= EvaluationFlags::gradients;
+
+    const bool ghosts_imported =
+      internal::import_ghost_values_if_needed(fe_function);
+
+    difference.reinit(
+      matrix_free.get_dof_handler(dof_no).get_triangulation().n_active_cells());
+
+    parallel::apply_to_subranges(
+      0U,
+      matrix_free.n_cell_batches(),
+      [&](const unsigned int begin, const unsigned int end) {
+        FEEvaluation<dim,
+                     fe_degree,
+                     n_q_points_1d,
+                     n_components,
+                     Number,
+                     VectorizedArrayType>
+          phi(matrix_free, dof_no, quad_no, first_selected_component);
+
+        // the quadrature points of a single cell, packed into batches for
+        // the evaluation of the exact solution, and unpacked for its
+        // gradients
+        constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+        const unsigned int     n_q_points = phi.n_q_points;
+        std::vector<Point<dim, VectorizedArray<double>>> vectorized_points(
+          (n_q_points + n_lanes - 1) / n_lanes);
+        std::vector<Point<dim>> points(n_q_points);
+
+        std::vector<Vector<double>> exact_values(
+          n_q_points, Vector<double>(n_components));
+        std::vector<std::vector<Tensor<1, dim>>> exact_gradients(
+          n_q_points, std::vector<Tensor<1, dim>>(n_components));
+
+        for (unsigned int cell = begin; cell < end; ++cell)
+          {
+            phi.reinit(cell);
+            phi.read_dof_values_plain(fe_function);
+            phi.evaluate(evaluation_flags);
+
+            for (unsigned int v = 0;
+                 v < matrix_free.n_active_entries_per_cell_batch(cell);
+                 ++v)
+              {
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  for (unsigned int d = 0; d < dim; ++d)
+                    points[q][d] = phi.quadrature_point(q)[d][v];
+
+                if (needs_values)
+                  {
+                    // the unused lanes of the last batch get copies of the
+                    // last point
+                    for (unsigned int b = 0; b < vectorized_points.size(); ++b)
+                      for (unsigned int l = 0; l < n_lanes; ++l)
+                        for (unsigned int d = 0; d < dim; ++d)
+                          vectorized_points[b][d][l] =
+                            points[std::min(b * n_lanes + l, n_q_points - 1)]
+                                  [d];
+                    exact_solution.vectorized_vector_value_list(
+                      vectorized_points, exact_values);
+                  }
+                if (needs_gradients)
+                  exact_solution.vector_gradient_list(points, exact_gradients);
+
+                double diff = 0;
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  {
+                    const double JxW = phi.JxW(q)[v];
+
+                    if (needs_values)
+                      {
+                        const auto value = phi.get_value(q);
+
+                        double sum = 0;
+                        for (unsigned int c = 0; c < n_components; ++c)
+                          {
+                            const double error =
+                              internal::ComponentAccess<n_components>::get(
+                                value, c)[v] -
+                              exact_values[q](c);
+                            if (norm == VectorTools::L1_norm)
+                              sum += std::abs(error);
+                            else if (norm == VectorTools::Linfty_norm)
+                              diff = std::max(diff, std::abs(error));
+                            else
+                              sum += error * error;
+                          }
+                        diff += sum * JxW;
+                      }
+
+                    if (needs_gradients)
+                      {
+                        const auto gradient = phi.get_gradient(q);
+
+                        double sum = 0;
+                        for (unsigned int c = 0; c < n_components; ++c)
+                          for (unsigned int d = 0; d < dim; ++d)
+                            {
+                              const double error =
+                                internal::ComponentAccess<n_components>::get(
+                                  gradient, c)[d][v] -
+                                exact_gradients[q][c][d];
+                              sum += error * error;
+                            }
+                        diff += sum * JxW;
+                      }
+                  }
+
+                if (norm != VectorTools::L1_norm &&
+                    norm != VectorTools::Linfty_norm)
+                  diff = std::sqrt(diff);
+
+                difference(
+                  matrix_free.get_cell_iterator(cell, v, dof_no)
+                    ->active_cell_index()) = diff;
+              }
+          }
+      },
+      std::max<unsigned int>(1, 64 / VectorizedArrayType::size()));
+
+    if (ghosts_imported)
+      internal::zero_out_ghost_values(fe_function);
+  }
+
 } // namespace MatrixFreeTools
 
 DEAL_II_NAMESPACE_CLOSE
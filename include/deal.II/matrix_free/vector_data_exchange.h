@@ -133,6 +133,15 @@ namespace internal
 
         virtual void
         reset_ghost_values(const ArrayView<float> &ghost_array) const = 0;
+
+        /**
+         * Free the MPI requests of an exchange that was started but is
+         * abandoned without calling the matching finish function, and clear
+         * @p requests. The requests may be persistent requests that are owned
+         * by this object, so they must not be freed directly.
+         */
+        virtual void
+        free_requests(std::vector<MPI_Request> &requests) const = 0;
       };
 
 
@@ -239,6 +248,9 @@ namespace internal
         void
         reset_ghost_values(const ArrayView<float> &ghost_array) const override;
 
+        void
+        free_requests(std::vector<MPI_Request> &requests) const override;
+
       private:
         template <typename Number>
         void
@@ -355,6 +367,9 @@ namespace internal
         void
         reset_ghost_values(const ArrayView<float> &ghost_array) const override;
 
+        void
+        free_requests(std::vector<MPI_Request> &requests) const override;
+
       private:
         template <typename Number>
         void
@@ -508,6 +523,16 @@ namespace internal
         std::pair<std::vector<unsigned int>,
                   std::vector<std::pair<unsigned int, unsigned int>>>
           sm_import_data_this;
+
+#ifdef DEAL_II_WITH_MPI
+        /**
+         * The persistent MPI requests of the exchanges with remote processes,
+         * which are set up once and reused by all later exchanges with the
+         * same arrays.
+         */
+        mutable Utilities::MPI::internal::PersistentRequests
+          persistent_requests;
+#endif
       };
 
     } // namespace VectorDataExchange
@@ -84,6 +84,18 @@ namespace MeshWorker
      */
     cells_after_faces = 0x0080,
 
+    /**
+     * Color the cells before the loop such that no two cells of the same
+     * color share a vertex with each other or with each other's face
+     * neighbors, and run the loop color by color. Within a color, the
+     * copier is then called concurrently on several threads for different
+     * cells, because the cells of a color cannot write to the same degrees
+     * of freedom as long as these are located on the closures of the cell
+     * and its face neighbors, as is the case for discontinuous Galerkin
+     * discretizations with face terms.
+     */
+    concurrent_copiers = 0x0100,
+
     /**
      * Combination of flags to determine if any work on cells is done.
      */
@@ -128,6 +140,8 @@ namespace MeshWorker
       s << "|ghost_faces_both";
     if (u & assemble_boundary_faces)
       s << "|boundary_faces";
+    if (u & concurrent_copiers)
+      s << "|concurrent_copiers";
     return s;
   }
 
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/graph_coloring.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/types.h>
 #include <deal.II/base/work_stream.h>
@@ -261,6 +262,18 @@ namespace MeshWorker
    * helpful to keep in mind that queue_length copies of the ScratchData object
    * and `queue_length*chunk_size` copies of the CopyData object are generated.
    *
+   * If the flag AssembleFlags::concurrent_copiers is passed, the cells are
+   * first colored such that no two cells of the same color share a vertex
+   * with each other or with each other's face neighbors, and the loop is
+   * run color by color. Since the cells of a color can then not write to the
+   * same degrees of freedom, the @p copier is called concurrently for
+   * different cells of the same color instead of one cell after the other.
+   * This is correct as long as the copier only writes to entries associated
+   * with the degrees of freedom on the closures of the cell and its face
+   * neighbors, which is the case for the usual (discontinuous Galerkin)
+   * assembly without constraints that couple to degrees of freedom further
+   * away. The workers are called exactly as without the flag.
+   *
    * @note The types of the function arguments and the default values (empty worker functions)
    * displayed in the Doxygen documentation here are slightly simplified
    * compared to the real types.
@@ -620,15 +633,63 @@ namespace MeshWorker
         cell_worker(cell, scratch, copy);
     };
 
-    // Submit to workstream
-    WorkStream::run(begin,
-                    end,
-                    cell_action,
-                    copier,
-                    sample_scratch_data,
-                    sample_copy_data,
-                    queue_length,
-                    chunk_size);
+    // Submit to workstream, possibly color by color to allow concurrent
+    // calls of the copier
+    if (flags & concurrent_copiers)
+      {
+        if (begin == end)
+          return;
+
+        // Two cells conflict if their own or their face neighbors' closures
+        // share a vertex. This is the case whenever the cells or their face
+        // terms can write to the same degrees of freedom. The vertex indices
+        // are bounded by the number of vertices, as required by the parallel
+        // coloring, and the function only reads the mesh, so it can be
+        // called concurrently.
+        const auto get_conflict_indices = [flags](
+                                            const CellIteratorType &iterator) {
+          const CellIteratorBaseType &cell = iterator;
+
+          std::vector<types::global_dof_index> conflict_indices;
+          for (const unsigned int v : cell->vertex_indices())
+            conflict_indices.push_back(cell->vertex_index(v));
+
+          if (flags & work_on_faces)
+            for (const unsigned int face_no : cell->face_indices())
+              if (!cell->at_boundary(face_no) ||
+                  cell->has_periodic_neighbor(face_no))
+                {
+                  const auto neighbor =
+                    cell->neighbor_or_periodic_neighbor(face_no);
+                  for (const unsigned int v : neighbor->vertex_indices())
+                    conflict_indices.push_back(neighbor->vertex_index(v));
+                }
+
+          return conflict_indices;
+        };
+
+        const std::vector<std::vector<CellIteratorType>> colored_iterators =
+          GraphColoring::make_parallel_graph_coloring(begin,
+                                                      end,
+                                                      get_conflict_indices);
+
+        WorkStream::run(colored_iterators,
+                        cell_action,
+                        copier,
+                        sample_scratch_data,
+                        sample_copy_data,
+                        queue_length,
+                        chunk_size);
+      }
+    else
+      WorkStream::run(begin,
+                      end,
+                      cell_action,
+                      copier,
+                      sample_scratch_data,
+                      sample_copy_data,
+                      queue_length,
+                      chunk_size);
   }
 
   /**
@@ -26,6 +26,10 @@
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/mapping_collection.h>
+#include <deal.II/hp/q_collection.h>
+
 #include <boost/any.hpp>
 
 #include <algorithm>
@@ -151,6 +155,16 @@ namespace MeshWorker
    * The user code should be structured without interleaving work on cells and
    * work on faces.
    *
+   * If the class is constructed with collections of mappings, finite
+   * elements, and quadrature formulas, the internal FEValues, FEFaceValues,
+   * FESubfaceValues, and FEInterfaceValues objects are kept separately for
+   * every active FE index, and each reinit() function uses the objects that
+   * belong to the active FE index of the cell it is given. Since the finite
+   * element also determines the kind of cell (see ReferenceCell), this
+   * allows to work on hp-adaptive discretizations and on meshes with
+   * different kinds of cells without rebuilding any of the internal objects
+   * when the element or the kind of cell changes from one cell to the next.
+   *
    * Consider, for example, the following snippet of code:
    *
    * @code
@@ -326,6 +340,39 @@ namespace MeshWorker
       const UpdateFlags &        face_update_flags = update_default,
       const UpdateFlags &        neighbor_face_update_flags = update_default);
 
+    /**
+     * Create a ScratchData object for a DoFHandler that uses several finite
+     * elements, e.g., in hp-adaptive computations or on meshes with
+     * different kinds of cells. A SmartPointer to each element of @p mapping
+     * and @p fe is stored internally. Make sure they live longer than this
+     * class instance.
+     *
+     * The internal FEValues objects are created the first time one of the
+     * reinit() functions is called on a cell with a given active FE index,
+     * using the finite element with this index, and the mapping and
+     * quadrature formulas with the same index. Collections of mappings and
+     * quadrature formulas may also consist of a single element that is then
+     * used for all finite elements.
+     *
+     * @param mapping The mappings to use in the internal FEValues objects
+     * @param fe The finite elements, indexed by the active FE index
+     * @param quadrature The cell quadratures
+     * @param update_flags UpdateFlags for the current cell FEValues and
+     * neighbor cell FEValues
+     * @param face_quadrature Face quadratures, used for FEFaceValues and
+     * FESubfaceValues for both the current cell and the neighbor cell
+     * @param face_update_flags UpdateFlags used for FEFaceValues and
+     * FESubfaceValues for both the current cell and the neighbor cell
+     */
+    ScratchData(
+      const hp::MappingCollection<dim, spacedim> &mapping,
+      const hp::FECollection<dim, spacedim> &     fe,
+      const hp::QCollection<dim> &                quadrature,
+      const UpdateFlags &                         update_flags,
+      const hp::QCollection<dim - 1> &face_quadrature =
+        hp::QCollection<dim - 1>(),
+      const UpdateFlags &face_update_flags = update_default);
+
     /**
      * Deep copy constructor. FEValues objects are not copied.
      */
@@ -820,7 +867,10 @@ namespace MeshWorker
     /** @} */ // CurrentCellEvaluation
 
     /**
-     * Return a reference to the used mapping.
+     * Return a reference to the used mapping. If the object was constructed
+     * with a collection of mappings, this is the mapping used on the cell
+     * passed to the last call of one of the reinit() functions, or the first
+     * mapping of the collection if none has been called yet.
      */
     const Mapping<dim, spacedim> &
     get_mapping() const;
@@ -848,28 +898,55 @@ namespace MeshWorker
                          const Number &     exemplar_number) const;
 
     /**
-     * The mapping used by the internal FEValues. Make sure it lives
-     * longer than this class.
+     * Size the caches of FEValues objects for the number of finite elements.
      */
-    SmartPointer<const Mapping<dim, spacedim>> mapping;
+    void
+    initialize_fe_values_caches();
+
+    /**
+     * Return the mapping to use on cells with the active FE index
+     * @p fe_index.
+     */
+    const Mapping<dim, spacedim> &
+    get_mapping(const unsigned int fe_index) const;
+
+    /**
+     * Return the cell quadrature formula to use on cells with the active FE
+     * index @p fe_index.
+     */
+    const Quadrature<dim> &
+    get_cell_quadrature(const unsigned int fe_index) const;
+
+    /**
+     * Return the face quadrature formula to use on cells with the active FE
+     * index @p fe_index.
+     */
+    const Quadrature<dim - 1> &
+    get_face_quadrature(const unsigned int fe_index) const;
 
     /**
-     * The finite element used by the internal FEValues. Make sure it lives
+     * The mappings used by the internal FEValues. Make sure they live
      * longer than this class.
      */
-    SmartPointer<const FiniteElement<dim, spacedim>> fe;
+    std::vector<SmartPointer<const Mapping<dim, spacedim>>> mappings;
+
+    /**
+     * The finite elements used by the internal FEValues, indexed by the
+     * active FE index. Make sure they live longer than this class.
+     */
+    std::vector<SmartPointer<const FiniteElement<dim, spacedim>>> fes;
 
     /**
-     * Quadrature formula used to integrate on the current cell, and on its
+     * Quadrature formulas used to integrate on the current cell, and on its
      * neighbor.
      */
-    Quadrature<dim> cell_quadrature;
+    hp::QCollection<dim> cell_quadrature;
 
     /**
-     * Quadrature formula used to integrate on faces, subfaces, and neighbor
+     * Quadrature formulas used to integrate on faces, subfaces, and neighbor
      * faces and subfaces.
      */
-    Quadrature<dim - 1> face_quadrature;
+    hp::QCollection<dim - 1> face_quadrature;
 
     /**
      * UpdateFlags to use when initializing the cell FEValues object.
@@ -894,39 +971,49 @@ namespace MeshWorker
     UpdateFlags neighbor_face_update_flags;
 
     /**
-     * Finite element values on the current cell.
+     * Finite element values on the current cell, one object per active FE
+     * index.
      */
-    std::unique_ptr<FEValues<dim, spacedim>> fe_values;
+    std::vector<std::unique_ptr<FEValues<dim, spacedim>>> fe_values;
 
     /**
-     * Finite element values on the current face.
+     * Finite element values on the current face, one object per active FE
+     * index.
      */
-    std::unique_ptr<FEFaceValues<dim, spacedim>> fe_face_values;
+    std::vector<std::unique_ptr<FEFaceValues<dim, spacedim>>> fe_face_values;
 
     /**
-     * Finite element values on the current subface.
+     * Finite element values on the current subface, one object per active
+     * FE index.
      */
-    std::unique_ptr<FESubfaceValues<dim, spacedim>> fe_subface_values;
+    std::vector<std::unique_ptr<FESubfaceValues<dim, spacedim>>>
+      fe_subface_values;
 
     /**
-     * Finite element values on the neighbor cell.
+     * Finite element values on the neighbor cell, one object per active FE
+     * index.
      */
-    std::unique_ptr<FEValues<dim, spacedim>> neighbor_fe_values;
+    std::vector<std::unique_ptr<FEValues<dim, spacedim>>> neighbor_fe_values;
 
     /**
-     * Finite element values on the neighbor face.
+     * Finite element values on the neighbor face, one object per active FE
+     * index.
      */
-    std::unique_ptr<FEFaceValues<dim, spacedim>> neighbor_fe_face_values;
+    std::vector<std::unique_ptr<FEFaceValues<dim, spacedim>>>
+      neighbor_fe_face_values;
 
     /**
-     * Finite element values on the neighbor subface.
+     * Finite element values on the neighbor subface, one object per active
+     * FE index.
      */
-    std::unique_ptr<FESubfaceValues<dim, spacedim>> neighbor_fe_subface_values;
+    std::vector<std::unique_ptr<FESubfaceValues<dim, spacedim>>>
+      neighbor_fe_subface_values;
 
     /**
-     * Interface values on facets.
+     * Interface values on facets, one object per active FE index.
      */
-    std::unique_ptr<FEInterfaceValues<dim, spacedim>> interface_fe_values;
+    std::vector<std::unique_ptr<FEInterfaceValues<dim, spacedim>>>
+      interface_fe_values;
 
     /**
      * Dof indices on the current cell.
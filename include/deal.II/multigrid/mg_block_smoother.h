@@ -23,6 +23,7 @@
 #include <deal.II/base/smartpointer.h>
 
 #include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/linear_operator.h>
 #include <deal.II/lac/vector_memory.h>
 
@@ -127,6 +128,160 @@ private:
     mem;
 };
 
+
+
+/**
+ * Smoother for saddle point problems of the form
+ * @f[
+ *   \begin{pmatrix} A & B^T \\ B & C \end{pmatrix}
+ *   \begin{pmatrix} u \\ p \end{pmatrix} =
+ *   \begin{pmatrix} f \\ g \end{pmatrix},
+ * @f]
+ * e.g. from Stokes or linearized Navier-Stokes problems, that does not need
+ * assembled level matrices. In contrast to MGSmootherBlock, the level
+ * operators only need to provide a function `vmult(VectorType &, const
+ * VectorType &)` for the whole block system, which makes this class
+ * suitable for matrix-free level operators working on
+ * LinearAlgebra::distributed::BlockVector.
+ *
+ * The smoother performs a preconditioned Richardson iteration with a block
+ * preconditioner built from an approximate inverse of the first diagonal
+ * block $A$ and an approximate inverse of the Schur complement
+ * $S = C - B A^{-1} B^T$. Both of them are provided by the user and work on
+ * the individual blocks of the vector. A typical choice for the first block
+ * is a PreconditionChebyshev object based on a matrix-free operator for
+ * $A$, and a (scaled) inverse pressure mass matrix or its diagonal for the
+ * Schur complement. Note that the approximation of the inverse Schur
+ * complement needs to have the sign of $S$, i.e., be negative definite for
+ * Stokes problems with $C=0$.
+ *
+ * Two variants of the block relaxation are available, see
+ * AdditionalData::Relaxation:
+ * - A block-diagonal (block-Jacobi) relaxation, which only needs one
+ *   application of the level operator per step and is usually combined with
+ *   a damping factor below one.
+ * - An inexact Uzawa relaxation, which uses a block lower triangular
+ *   preconditioner, i.e., the update of the first block is used to correct
+ *   the residual of the second block before the Schur complement step. As
+ *   the operator only provides the action of the whole block system, this
+ *   needs a second application of the level operator per step. If the
+ *   smoother is set up to be symmetric, steps with the block lower and the
+ *   block upper triangular preconditioner alternate.
+ *
+ * Only systems with exactly two blocks are supported. All operators and
+ * preconditioners need to be derived from Subscriptor, as is the case for
+ * the matrix-free operators in MatrixFreeOperators and for
+ * PreconditionChebyshev.
+ */
+template <typename MatrixType,
+          typename PreconditionerAType,
+          typename PreconditionerSType,
+          typename VectorType = LinearAlgebra::distributed::BlockVector<double>>
+class MGSmootherBlockUzawa : public MGSmoother<VectorType>
+{
+public:
+  /**
+   * Additional data controlling the relaxation.
+   */
+  struct AdditionalData
+  {
+    /**
+     * The variants of the block relaxation.
+     */
+    enum Relaxation
+    {
+      /**
+       * Block-diagonal relaxation.
+       */
+      block_diagonal,
+      /**
+       * Inexact Uzawa relaxation with a block triangular preconditioner.
+       */
+      uzawa
+    };
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(const Relaxation relaxation = uzawa,
+                   const double     damping    = 1.)
+      : relaxation(relaxation)
+      , damping(damping)
+    {}
+
+    /**
+     * The block relaxation to use.
+     */
+    Relaxation relaxation;
+
+    /**
+     * Damping factor applied to the update in each step.
+     */
+    double damping;
+  };
+
+  /**
+   * Constructor.
+   */
+  MGSmootherBlockUzawa(const unsigned int steps     = 1,
+                       const bool         variable  = false,
+                       const bool         symmetric = false);
+
+  /**
+   * Initialize with the level operators @p matrices, the approximate inverses
+   * @p preconditioners_a of the first diagonal block, and the approximate
+   * inverses @p preconditioners_s of the Schur complement. The objects are
+   * not copied, but only pointers to them are stored, so they need to live
+   * longer than this object.
+   */
+  void
+  initialize(const MGLevelObject<MatrixType> &         matrices,
+             const MGLevelObject<PreconditionerAType> &preconditioners_a,
+             const MGLevelObject<PreconditionerSType> &preconditioners_s,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Empty all pointers.
+   */
+  virtual void
+  clear() override;
+
+  /**
+   * Implementation of the interface for @p Multigrid.
+   */
+  virtual void
+  smooth(const unsigned int level,
+         VectorType &       u,
+         const VectorType & rhs) const override;
+
+  /**
+   * Memory used by this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Pointers to the level operators.
+   */
+  MGLevelObject<SmartPointer<const MatrixType>> matrices;
+
+  /**
+   * Pointers to the approximate inverses of the first diagonal block.
+   */
+  MGLevelObject<SmartPointer<const PreconditionerAType>> preconditioners_a;
+
+  /**
+   * Pointers to the approximate inverses of the Schur complement.
+   */
+  MGLevelObject<SmartPointer<const PreconditionerSType>> preconditioners_s;
+
+  /**
+   * Settings of the relaxation.
+   */
+  AdditionalData additional_data;
+};
+
 /**@}*/
 
 //---------------------------------------------------------------------------
@@ -247,6 +402,173 @@ MGSmootherBlock<MatrixType, RelaxationType, number>::smooth(
     }
 }
 
+
+
+template <typename MatrixType,
+          typename PreconditionerAType,
+          typename PreconditionerSType,
+          typename VectorType>
+inline MGSmootherBlockUzawa<MatrixType,
+                            PreconditionerAType,
+                            PreconditionerSType,
+                            VectorType>::
+  MGSmootherBlockUzawa(const unsigned int steps,
+                       const bool         variable,
+                       const bool         symmetric)
+  : MGSmoother<VectorType>(steps, variable, symmetric, false)
+{}
+
+
+template <typename MatrixType,
+          typename PreconditionerAType,
+          typename PreconditionerSType,
+          typename VectorType>
+inline void
+MGSmootherBlockUzawa<MatrixType,
+                     PreconditionerAType,
+                     PreconditionerSType,
+                     VectorType>::
+  initialize(const MGLevelObject<MatrixType> &         m,
+             const MGLevelObject<PreconditionerAType> &pa,
+             const MGLevelObject<PreconditionerSType> &ps,
+             const AdditionalData &                    data)
+{
+  const unsigned int min = m.min_level();
+  const unsigned int max = m.max_level();
+
+  Assert(pa.min_level() <= min && pa.max_level() >= max,
+         ExcMessage("The preconditioners of the first block do not cover "
+                    "the levels of the operators."));
+  Assert(ps.min_level() <= min && ps.max_level() >= max,
+         ExcMessage("The Schur complement preconditioners do not cover "
+                    "the levels of the operators."));
+
+  matrices.resize(min, max);
+  preconditioners_a.resize(min, max);
+  preconditioners_s.resize(min, max);
+
+  for (unsigned int i = min; i <= max; ++i)
+    {
+      matrices[i]          = &m[i];
+      preconditioners_a[i] = &pa[i];
+      preconditioners_s[i] = &ps[i];
+    }
+
+  additional_data = data;
+}
+
+
+template <typename MatrixType,
+          typename PreconditionerAType,
+          typename PreconditionerSType,
+          typename VectorType>
+inline void
+MGSmootherBlockUzawa<MatrixType,
+                     PreconditionerAType,
+                     PreconditionerSType,
+                     VectorType>::clear()
+{
+  for (unsigned int i = matrices.min_level(); i <= matrices.max_level(); ++i)
+    {
+      matrices[i]          = nullptr;
+      preconditioners_a[i] = nullptr;
+      preconditioners_s[i] = nullptr;
+    }
+}
+
+
+template <typename MatrixType,
+          typename PreconditionerAType,
+          typename PreconditionerSType,
+          typename VectorType>
+inline std::size_t
+MGSmootherBlockUzawa<MatrixType,
+                     PreconditionerAType,
+                     PreconditionerSType,
+                     VectorType>::memory_consumption() const
+{
+  return sizeof(*this) + matrices.memory_consumption() +
+         preconditioners_a.memory_consumption() +
+         preconditioners_s.memory_consumption() +
+         this->vector_memory.memory_consumption();
+}
+
+
+template <typename MatrixType,
+          typename PreconditionerAType,
+          typename PreconditionerSType,
+          typename VectorType>
+inline void
+MGSmootherBlockUzawa<MatrixType,
+                     PreconditionerAType,
+                     PreconditionerSType,
+                     VectorType>::smooth(const unsigned int level,
+                                         VectorType &       u,
+                                         const VectorType & rhs) const
+{
+  AssertDimension(u.n_blocks(), 2);
+  AssertDimension(rhs.n_blocks(), 2);
+
+  const MatrixType &         matrix           = *matrices[level];
+  const PreconditionerAType &preconditioner_a = *preconditioners_a[level];
+  const PreconditionerSType &preconditioner_s = *preconditioners_s[level];
+
+  unsigned int steps2 = this->steps;
+
+  if (this->variable)
+    steps2 *= (1 << (matrices.max_level() - level));
+
+  typename VectorMemory<VectorType>::Pointer r(this->vector_memory);
+  typename VectorMemory<VectorType>::Pointer d(this->vector_memory);
+  r->reinit(u, true);
+  d->reinit(u, true);
+
+  typename VectorMemory<VectorType>::Pointer t(this->vector_memory);
+  if (additional_data.relaxation == AdditionalData::uzawa)
+    t->reinit(u, true);
+
+  // in the symmetric case, alternate between the block lower triangular
+  // preconditioner (first block first) and the block upper triangular one
+  // (Schur complement first)
+  bool lower = true;
+
+  for (unsigned int i = 0; i < steps2; ++i)
+    {
+      matrix.vmult(*r, u);
+      r->sadd(-1., 1., rhs);
+
+      const unsigned int first  = lower ? 0 : 1;
+      const unsigned int second = 1 - first;
+
+      if (first == 0)
+        preconditioner_a.vmult(d->block(0), r->block(0));
+      else
+        preconditioner_s.vmult(d->block(1), r->block(1));
+
+      if (additional_data.relaxation == AdditionalData::uzawa)
+        {
+          // correct the residual of the second block by the coupling term
+          // of the update of the first block, computed by applying the
+          // operator to the update padded with zeros
+          *t              = 0.;
+          t->block(first) = d->block(first);
+          matrix.vmult(*d, *t);
+          r->block(second) -= d->block(second);
+          d->block(first) = t->block(first);
+        }
+
+      if (second == 1)
+        preconditioner_s.vmult(d->block(1), r->block(1));
+      else
+        preconditioner_a.vmult(d->block(0), r->block(0));
+
+      u.add(additional_data.damping, *d);
+
+      if (this->symmetric)
+        lower = !lower;
+    }
+}
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
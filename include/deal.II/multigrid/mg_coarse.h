@@ -19,8 +19,12 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
+
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/linear_operator.h>
 
 #include <deal.II/multigrid/mg_base.h>
@@ -237,6 +241,142 @@ private:
   LAPACKFullMatrix<number> matrix;
 };
 
+
+
+/**
+ * Coarse grid solver running on a subset of the MPI processes.
+ *
+ * On large process counts, the coarsest levels of a multigrid hierarchy
+ * only hold a few cells per process and the coarse grid solver is dominated
+ * by the latency of its global communication. This latency can be reduced
+ * by agglomerating the coarse level onto a subset of the processes, e.g. by
+ * setting up the coarsest DoFHandler on a triangulation whose cells are
+ * partitioned onto a few processes only (as it is possible with
+ * parallel::fullydistributed::Triangulation and the global coarsening
+ * transfer operators in MGTransferGlobalCoarsening, which support
+ * different partitions on each level). The remaining processes do not own
+ * any degree of freedom on that level.
+ *
+ * This class wraps a coarse grid solver that works on vectors distributed
+ * over the sub-communicator of the processes owning degrees of freedom on
+ * the coarse level. The sub-communicator and a matching partitioner are
+ * created by reinit(), and can be queried via get_communicator() and
+ * get_partitioner() to set up the coarse matrix and solver. Upon
+ * application, the locally owned entries are copied between the vectors of
+ * the multigrid hierarchy and the vectors of the sub-communicator, which
+ * does not involve any communication since the ownership of the entries is
+ * the same. Processes without degrees of freedom on the coarse level skip
+ * the coarse grid solve entirely.
+ */
+template <typename Number>
+class MGCoarseGridAgglomerated
+  : public MGCoarseGridBase<LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  /**
+   * Vector type.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Default constructor.
+   */
+  MGCoarseGridAgglomerated();
+
+  /**
+   * Destructor. Frees the sub-communicator.
+   */
+  ~MGCoarseGridAgglomerated() override;
+
+  /**
+   * Set up the sub-communicator containing the processes that own
+   * degrees of freedom in the given @p partitioner of the coarse level
+   * vectors, and a partitioner with the same locally owned indices on the
+   * sub-communicator. This is a collective operation on the communicator of
+   * @p partitioner.
+   */
+  void
+  reinit(const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner);
+
+  /**
+   * Store a pointer to the coarse grid solver acting on vectors set up with
+   * the partitioner returned by get_partitioner(). Only needs to be called
+   * on the processes for which is_active() returns true.
+   */
+  void
+  initialize(const MGCoarseGridBase<VectorType> &coarse_grid_solver);
+
+  /**
+   * Clear the pointer to the coarse grid solver and free the
+   * sub-communicator.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the current process owns degrees of freedom on the
+   * coarse level and thus takes part in the coarse grid solve.
+   */
+  bool
+  is_active() const;
+
+  /**
+   * Return the sub-communicator of the processes taking part in the coarse
+   * grid solve. On the other processes, the MPI null handle is returned.
+   * Without MPI, this is the communicator of the coarse level vectors.
+   */
+  const MPI_Comm &
+  get_communicator() const;
+
+  /**
+   * Return the partitioner of the coarse level vectors on the
+   * sub-communicator, or an empty pointer on processes that do not take
+   * part in the coarse grid solve.
+   */
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  get_partitioner() const;
+
+  /**
+   * Implementation of the abstract function. Copies @p src into a vector
+   * on the sub-communicator, calls the coarse grid solver, and copies the
+   * result back into @p dst. Returns immediately on processes that do not
+   * take part in the coarse grid solve.
+   */
+  void
+  operator()(const unsigned int level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+private:
+  /**
+   * The sub-communicator of the processes owning degrees of freedom on the
+   * coarse level.
+   */
+  MPI_Comm sub_communicator;
+
+  /**
+   * Partitioner of the coarse level vectors on the sub-communicator.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> sub_partitioner;
+
+  /**
+   * Reference to the coarse grid solver.
+   */
+  SmartPointer<const MGCoarseGridBase<VectorType>,
+               MGCoarseGridAgglomerated<Number>>
+    coarse_grid_solver;
+
+  /**
+   * Right hand side of the coarse grid solve on the sub-communicator.
+   */
+  mutable VectorType src_sub;
+
+  /**
+   * Solution of the coarse grid solve on the sub-communicator.
+   */
+  mutable VectorType dst_sub;
+};
+
 /*@}*/
 
 #ifndef DOXYGEN
@@ -446,6 +586,149 @@ MGCoarseGridSVD<number, VectorType>::log() const
 }
 
 
+/* ------------------ Functions for MGCoarseGridAgglomerated ------------ */
+
+template <typename Number>
+MGCoarseGridAgglomerated<Number>::MGCoarseGridAgglomerated()
+#ifdef DEAL_II_WITH_MPI
+  : sub_communicator(MPI_COMM_NULL)
+#else
+  : sub_communicator(MPI_COMM_SELF)
+#endif
+  , coarse_grid_solver(nullptr)
+{}
+
+
+
+template <typename Number>
+MGCoarseGridAgglomerated<Number>::~MGCoarseGridAgglomerated()
+{
+  clear();
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridAgglomerated<Number>::reinit(
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
+{
+  Assert(partitioner.get() != nullptr, ExcNotInitialized());
+
+  clear();
+
+  const bool process_is_active = partitioner->locally_owned_size() > 0;
+
+#ifdef DEAL_II_WITH_MPI
+  const int ierr =
+    MPI_Comm_split(partitioner->get_mpi_communicator(),
+                   process_is_active ? 0 : MPI_UNDEFINED,
+                   Utilities::MPI::this_mpi_process(
+                     partitioner->get_mpi_communicator()),
+                   &sub_communicator);
+  AssertThrowMPI(ierr);
+#else
+  sub_communicator = partitioner->get_mpi_communicator();
+#endif
+
+  if (process_is_active)
+    sub_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+      partitioner->locally_owned_range(), sub_communicator);
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridAgglomerated<Number>::initialize(
+  const MGCoarseGridBase<VectorType> &coarse_grid_solver_)
+{
+  coarse_grid_solver = &coarse_grid_solver_;
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridAgglomerated<Number>::clear()
+{
+  coarse_grid_solver = nullptr;
+  src_sub.reinit(0);
+  dst_sub.reinit(0);
+  sub_partitioner.reset();
+
+#ifdef DEAL_II_WITH_MPI
+  if (sub_communicator != MPI_COMM_NULL)
+    Utilities::MPI::free_communicator(sub_communicator);
+  sub_communicator = MPI_COMM_NULL;
+#endif
+}
+
+
+
+template <typename Number>
+bool
+MGCoarseGridAgglomerated<Number>::is_active() const
+{
+  return sub_partitioner.get() != nullptr;
+}
+
+
+
+template <typename Number>
+const MPI_Comm &
+MGCoarseGridAgglomerated<Number>::get_communicator() const
+{
+  return sub_communicator;
+}
+
+
+
+template <typename Number>
+const std::shared_ptr<const Utilities::MPI::Partitioner> &
+MGCoarseGridAgglomerated<Number>::get_partitioner() const
+{
+  return sub_partitioner;
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridAgglomerated<Number>::operator()(const unsigned int level,
+                                             VectorType &       dst,
+                                             const VectorType & src) const
+{
+  if (is_active() == false)
+    {
+      AssertDimension(src.locally_owned_size(), 0);
+      AssertDimension(dst.locally_owned_size(), 0);
+      return;
+    }
+
+  Assert(coarse_grid_solver != nullptr, ExcNotInitialized());
+  AssertDimension(src.locally_owned_size(),
+                  sub_partitioner->locally_owned_size());
+  AssertDimension(dst.locally_owned_size(),
+                  sub_partitioner->locally_owned_size());
+
+  if (src_sub.get_partitioner().get() != sub_partitioner.get())
+    {
+      src_sub.reinit(sub_partitioner);
+      dst_sub.reinit(sub_partitioner);
+    }
+
+  // the entries are owned by the same process on both communicators, so
+  // the data can be copied locally
+  src_sub.copy_locally_owned_data_from(src);
+  dst_sub = Number();
+
+  (*coarse_grid_solver)(level, dst_sub, src_sub);
+
+  dst.copy_locally_owned_data_from(dst_sub);
+}
+
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -20,6 +20,7 @@
 
 #include <deal.II/base/mg_level_object.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/affine_constraints.h>
 
@@ -254,82 +255,93 @@ MGConstrainedDoFs::initialize(
   refinement_edge_indices.resize(nlevels);
   level_constraints.resize(nlevels);
   user_constraints.resize(nlevels);
+
+  // Initialize with empty IndexSet of correct size
   for (unsigned int l = min_level; l <= max_level; ++l)
-    {
-      if (user_level_dofs)
-        {
-          level_constraints[l].reinit(level_relevant_dofs[l]);
-        }
-      else
+    refinement_edge_indices[l] = IndexSet(dof.n_dofs(l));
+
+  // The level constraints are independent of each other and of the
+  // refinement edge indices, so we set them up in parallel
+  Threads::TaskGroup<> tasks;
+  tasks += Threads::new_task([&]() {
+    MGTools::extract_inner_interface_dofs(dof, refinement_edge_indices);
+  });
+
+  const auto setup_level_constraints = [&](const unsigned int l) {
+    if (user_level_dofs)
+      {
+        level_constraints[l].reinit(level_relevant_dofs[l]);
+      }
+    else
+      {
+        IndexSet relevant_dofs;
+        DoFTools::extract_locally_relevant_level_dofs(dof, l, relevant_dofs);
+        level_constraints[l].reinit(relevant_dofs);
+      }
+
+    // Loop through relevant cells and faces finding those which are periodic
+    // neighbors.
+    typename DoFHandler<dim, spacedim>::cell_iterator cell = dof.begin(l),
+                                                      endc = dof.end(l);
+    for (; cell != endc; ++cell)
+      if (cell->level_subdomain_id() != numbers::artificial_subdomain_id)
         {
-          IndexSet relevant_dofs;
-          DoFTools::extract_locally_relevant_level_dofs(dof, l, relevant_dofs);
-          level_constraints[l].reinit(relevant_dofs);
-        }
-
-      // Loop through relevant cells and faces finding those which are periodic
-      // neighbors.
-      typename DoFHandler<dim, spacedim>::cell_iterator cell = dof.begin(l),
-                                                        endc = dof.end(l);
-      for (; cell != endc; ++cell)
-        if (cell->level_subdomain_id() != numbers::artificial_subdomain_id)
-          {
-            for (auto f : cell->face_indices())
-              if (cell->has_periodic_neighbor(f) &&
-                  cell->periodic_neighbor(f)->level() == cell->level())
-                {
-                  if (cell->is_locally_owned_on_level())
+          for (auto f : cell->face_indices())
+            if (cell->has_periodic_neighbor(f) &&
+                cell->periodic_neighbor(f)->level() == cell->level())
+              {
+                if (cell->is_locally_owned_on_level())
+                  {
+                    Assert(
+                      cell->periodic_neighbor(f)->level_subdomain_id() !=
+                        numbers::artificial_subdomain_id,
+                      ExcMessage(
+                        "Periodic neighbor of a locally owned cell must either be owned or ghost."));
+                  }
+                // Cell is a level-ghost and its neighbor is a
+                // level-artificial cell nothing to do here
+                else if (cell->periodic_neighbor(f)->level_subdomain_id() ==
+                         numbers::artificial_subdomain_id)
+                  {
+                    Assert(cell->is_locally_owned_on_level() == false,
+                           ExcInternalError());
+                    continue;
+                  }
+
+                const unsigned int dofs_per_face =
+                  dof.get_fe(0).n_dofs_per_face(f);
+                std::vector<types::global_dof_index> dofs_1(dofs_per_face);
+                std::vector<types::global_dof_index> dofs_2(dofs_per_face);
+
+                cell->periodic_neighbor(f)
+                  ->face(cell->periodic_neighbor_face_no(f))
+                  ->get_mg_dof_indices(l, dofs_1, 0);
+                cell->face(f)->get_mg_dof_indices(l, dofs_2, 0);
+                // Store periodicity information in the level
+                // AffineConstraints object. Skip DoFs for which we've
+                // previously entered periodicity constraints already; this
+                // can happen, for example, for a vertex dof at a periodic
+                // boundary that we visit from more than one cell
+                for (unsigned int i = 0; i < dofs_per_face; ++i)
+                  if (level_constraints[l].can_store_line(dofs_2[i]) &&
+                      level_constraints[l].can_store_line(dofs_1[i]) &&
+                      !level_constraints[l].is_constrained(dofs_2[i]) &&
+                      !level_constraints[l].is_constrained(dofs_1[i]))
                     {
-                      Assert(
-                        cell->periodic_neighbor(f)->level_subdomain_id() !=
-                          numbers::artificial_subdomain_id,
-                        ExcMessage(
-                          "Periodic neighbor of a locally owned cell must either be owned or ghost."));
-                    }
-                  // Cell is a level-ghost and its neighbor is a
-                  // level-artificial cell nothing to do here
-                  else if (cell->periodic_neighbor(f)->level_subdomain_id() ==
-                           numbers::artificial_subdomain_id)
-                    {
-                      Assert(cell->is_locally_owned_on_level() == false,
-                             ExcInternalError());
-                      continue;
+                      level_constraints[l].add_line(dofs_2[i]);
+                      level_constraints[l].add_entry(dofs_2[i],
+                                                     dofs_1[i],
+                                                     1.);
                     }
+              }
+        }
+    level_constraints[l].close();
+  };
 
-                  const unsigned int dofs_per_face =
-                    dof.get_fe(0).n_dofs_per_face(f);
-                  std::vector<types::global_dof_index> dofs_1(dofs_per_face);
-                  std::vector<types::global_dof_index> dofs_2(dofs_per_face);
-
-                  cell->periodic_neighbor(f)
-                    ->face(cell->periodic_neighbor_face_no(f))
-                    ->get_mg_dof_indices(l, dofs_1, 0);
-                  cell->face(f)->get_mg_dof_indices(l, dofs_2, 0);
-                  // Store periodicity information in the level
-                  // AffineConstraints object. Skip DoFs for which we've
-                  // previously entered periodicity constraints already; this
-                  // can happen, for example, for a vertex dof at a periodic
-                  // boundary that we visit from more than one cell
-                  for (unsigned int i = 0; i < dofs_per_face; ++i)
-                    if (level_constraints[l].can_store_line(dofs_2[i]) &&
-                        level_constraints[l].can_store_line(dofs_1[i]) &&
-                        !level_constraints[l].is_constrained(dofs_2[i]) &&
-                        !level_constraints[l].is_constrained(dofs_1[i]))
-                      {
-                        level_constraints[l].add_line(dofs_2[i]);
-                        level_constraints[l].add_entry(dofs_2[i],
-                                                       dofs_1[i],
-                                                       1.);
-                      }
-                }
-          }
-      level_constraints[l].close();
-
-      // Initialize with empty IndexSet of correct size
-      refinement_edge_indices[l] = IndexSet(dof.n_dofs(l));
-    }
-
-  MGTools::extract_inner_interface_dofs(dof, refinement_edge_indices);
+  for (unsigned int l = min_level; l <= max_level; ++l)
+    tasks += Threads::new_task(
+      [&setup_level_constraints, l]() { setup_level_constraints(l); });
+  tasks.join_all();
 }
 
 
@@ -0,0 +1,617 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_global_coarsening_hierarchy_h
+#define dealii_mg_global_coarsening_hierarchy_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A class that automatically sets up a hybrid multigrid hierarchy for the
+ * global coarsening infrastructure, i.e., the level DoFHandler objects, the
+ * level constraints, the level operators, and the two-level transfers
+ * between them, as well as an MGTransferGlobalCoarsening object working on
+ * the latter.
+ *
+ * Starting from the DoFHandler of the finest level, the hierarchy is
+ * created as follows:
+ * - First, the polynomial degree is reduced on the fine mesh according to
+ *   the given MGTransferGlobalCoarseningTools::PolynomialCoarseningSequenceType
+ *   (p-multigrid). The finite elements of lower degree are obtained from the
+ *   name of the fine finite element, replacing the degree, so that, e.g.,
+ *   FE_DGQ<3>(6) results in FE_DGQ<3>(3) and FE_DGQ<3>(1) for
+ *   the sequence type
+ *   MGTransferGlobalCoarseningTools::PolynomialCoarseningSequenceType::bisect.
+ *   This also works for FESystem objects whose base elements all have the
+ *   same degree.
+ * - Second, the mesh is coarsened globally with the lowest polynomial
+ *   degree as long as possible (h-multigrid), see
+ *   MGTransferGlobalCoarseningTools::create_geometric_coarsening_sequence().
+ *   This step is only performed for
+ *   parallel::distributed::Triangulation objects and is skipped otherwise.
+ *
+ * Going down to the coarse mesh of the triangulation typically leaves a
+ * few processes with a handful of unknowns each, which makes the coarsest
+ * levels dominated by communication latency. For this reason, the
+ * h-coarsening can be stopped once the average number of unknowns per
+ * process drops below AdditionalData::min_n_dofs_per_process. The resulting
+ * coarsest level is then meant to be solved by an algebraic multigrid
+ * method, which distributes its own hierarchy more evenly among the
+ * processes.
+ *
+ * The operators on the levels are created by a user-provided function that
+ * receives the level DoFHandler and the level constraints. The typical
+ * implementation initializes a MatrixFree object and a matrix-free operator
+ * on top of it. The operator type needs to be default-constructible and
+ * provide a function `initialize_dof_vector(VectorType &)`, which is used
+ * to initialize the level vectors in the transfer.
+ *
+ * A typical use case looks as follows:
+ * @code
+ *   MGGlobalCoarseningHierarchy<dim, double, LaplaceOperator> hierarchy;
+ *
+ *   hierarchy.build(
+ *     dof_handler,
+ *     [&](const DoFHandler<dim> &dof, AffineConstraints<double> &constraints) {
+ *       IndexSet relevant_dofs;
+ *       DoFTools::extract_locally_relevant_dofs(dof, relevant_dofs);
+ *       constraints.reinit(relevant_dofs);
+ *       DoFTools::make_hanging_node_constraints(dof, constraints);
+ *       VectorTools::interpolate_boundary_values(
+ *         mapping, dof, 0, Functions::ZeroFunction<dim>(), constraints);
+ *       constraints.close();
+ *     },
+ *     [&](const DoFHandler<dim> &           dof,
+ *         const AffineConstraints<double> &constraints,
+ *         LaplaceOperator &                 op) {
+ *       op.reinit(mapping, dof, constraints, quadrature);
+ *     });
+ *
+ *   // set up smoothers on the levels hierarchy.min_level()+1 to
+ *   // hierarchy.max_level() with hierarchy.get_operator(level), an
+ *   // algebraic multigrid coarse solver on hierarchy.min_level(), and
+ *   // run the multigrid algorithm with hierarchy.get_transfer()
+ * @endcode
+ *
+ * @note The coarse grid solver is not set up by this class, since algebraic
+ *   multigrid methods need an assembled matrix, which is not available for
+ *   a generic (matrix-free) operator. The coarsest operator returned by
+ *   get_operator(min_level()) is the natural place to assemble it.
+ */
+template <int dim, typename Number, typename OperatorType>
+class MGGlobalCoarseningHierarchy : public Subscriptor
+{
+public:
+  /**
+   * The vector type used on all levels.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Type of the function that fills the constraints of a level. The
+   * constraints object passed to the function is empty.
+   */
+  using ConstraintsFunction =
+    std::function<void(const DoFHandler<dim> &, AffineConstraints<Number> &)>;
+
+  /**
+   * Type of the function that sets up the operator of a level.
+   */
+  using OperatorFunction = std::function<void(const DoFHandler<dim> &,
+                                              const AffineConstraints<Number> &,
+                                              OperatorType &)>;
+
+  /**
+   * Additional data to control the construction of the hierarchy.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(
+      const MGTransferGlobalCoarseningTools::PolynomialCoarseningSequenceType
+                         p_sequence = MGTransferGlobalCoarseningTools::
+                           PolynomialCoarseningSequenceType::bisect,
+      const bool         perform_h_coarsening         = true,
+      const unsigned int min_n_dofs_per_process       = 0,
+      const bool         setup_operators_concurrently = true)
+      : p_sequence(p_sequence)
+      , perform_h_coarsening(perform_h_coarsening)
+      , min_n_dofs_per_process(min_n_dofs_per_process)
+      , setup_operators_concurrently(setup_operators_concurrently)
+    {}
+
+    /**
+     * The sequence of polynomial degrees on the fine mesh.
+     */
+    MGTransferGlobalCoarseningTools::PolynomialCoarseningSequenceType
+      p_sequence;
+
+    /**
+     * Whether to add levels obtained by global coarsening of the mesh below
+     * the polynomial levels.
+     */
+    bool perform_h_coarsening;
+
+    /**
+     * The h-coarsening stops at the first level with fewer unknowns per
+     * process (on average) than given here. That level becomes the coarsest
+     * level of the hierarchy. The default value of zero means that the
+     * coarsening continues down to the coarse mesh.
+     */
+    unsigned int min_n_dofs_per_process;
+
+    /**
+     * Whether to run the user function setting up the level operators for
+     * all levels concurrently as separate tasks. Since the setup of a
+     * MatrixFree object involves collective MPI communication, which must
+     * not be issued concurrently by several threads, this option is only
+     * effective if the triangulation lives on a single process; otherwise,
+     * the levels are set up one after the other.
+     */
+    bool setup_operators_concurrently;
+  };
+
+  /**
+   * Build the hierarchy starting from the DoFHandler @p dof_handler_fine
+   * of the finest level. Previous content is discarded.
+   *
+   * The constraints and the operator of the finest level are also created
+   * via @p constraints_function and @p operator_function, i.e., the
+   * hierarchy does not share them with the caller.
+   */
+  void
+  build(const DoFHandler<dim> &    dof_handler_fine,
+        const ConstraintsFunction &constraints_function,
+        const OperatorFunction &   operator_function,
+        const AdditionalData &     additional_data = AdditionalData());
+
+  /**
+   * Release all data.
+   */
+  void
+  clear();
+
+  /**
+   * Return the coarsest level of the hierarchy.
+   */
+  unsigned int
+  min_level() const;
+
+  /**
+   * Return the finest level of the hierarchy.
+   */
+  unsigned int
+  max_level() const;
+
+  /**
+   * Return the DoFHandler of the given @p level. On the finest level, this
+   * is the DoFHandler passed to build().
+   */
+  const DoFHandler<dim> &
+  get_dof_handler(const unsigned int level) const;
+
+  /**
+   * Return the constraints of the given @p level.
+   */
+  const AffineConstraints<Number> &
+  get_constraints(const unsigned int level) const;
+
+  /**
+   * Return the operator of the given @p level.
+   */
+  const OperatorType &
+  get_operator(const unsigned int level) const;
+
+  /**
+   * Return all level operators, e.g. for the construction of an
+   * mg::Matrix object.
+   */
+  const MGLevelObject<OperatorType> &
+  get_operators() const;
+
+  /**
+   * Return the two-level transfers. The entry on level `l` transfers
+   * between the levels `l-1` and `l`.
+   */
+  const MGLevelObject<MGTwoLevelTransfer<dim, VectorType>> &
+  get_two_level_transfers() const;
+
+  /**
+   * Return the multigrid transfer for the whole hierarchy.
+   */
+  const MGTransferGlobalCoarsening<dim, VectorType> &
+  get_transfer() const;
+
+  /**
+   * Return whether the given @p level was obtained by coarsening the mesh
+   * (as opposed to reducing the polynomial degree) with respect to the next
+   * finer level.
+   */
+  bool
+  is_h_level(const unsigned int level) const;
+
+private:
+  /**
+   * Create the finite element of degree @p degree that corresponds to the
+   * fine finite element @p fe_fine.
+   */
+  static std::unique_ptr<FiniteElement<dim>>
+  create_coarse_fe(const FiniteElement<dim> &fe_fine,
+                   const unsigned int        degree);
+
+  /**
+   * Triangulations of the levels. The triangulations created by coarsening
+   * are owned by this object, whereas the fine one is only referenced.
+   */
+  MGLevelObject<std::shared_ptr<const Triangulation<dim>>> triangulations;
+
+  /**
+   * Finite elements of the levels.
+   */
+  std::vector<std::shared_ptr<const FiniteElement<dim>>> fes;
+
+  /**
+   * DoFHandler objects of the levels. The one on the finest level only
+   * references the DoFHandler passed to build().
+   */
+  MGLevelObject<std::shared_ptr<const DoFHandler<dim>>> dof_handlers;
+
+  /**
+   * Constraints of the levels.
+   */
+  MGLevelObject<AffineConstraints<Number>> constraints;
+
+  /**
+   * Operators of the levels.
+   */
+  MGLevelObject<OperatorType> operators;
+
+  /**
+   * Two-level transfers.
+   */
+  MGLevelObject<MGTwoLevelTransfer<dim, VectorType>> transfers;
+
+  /**
+   * Transfer for the whole hierarchy.
+   */
+  std::unique_ptr<MGTransferGlobalCoarsening<dim, VectorType>> transfer;
+
+  /**
+   * The number of levels below the finest mesh, i.e., the levels
+   * `0,...,n_h_levels-1` (before the removal of levels because of
+   * AdditionalData::min_n_dofs_per_process) were obtained by mesh coarsening.
+   */
+  unsigned int n_h_levels;
+};
+
+/*@}*/
+
+
+
+#ifndef DOXYGEN
+
+/* ----------------------- Inline functions --------------------------- */
+
+
+
+template <int dim, typename Number, typename OperatorType>
+std::unique_ptr<FiniteElement<dim>>
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::create_coarse_fe(
+  const FiniteElement<dim> &fe_fine,
+  const unsigned int        degree)
+{
+  if (degree == fe_fine.degree)
+    return fe_fine.clone();
+
+  // replace all occurrences of the degree within parentheses, which covers
+  // both simple elements like FE_Q<2>(4) and systems like
+  // FESystem<2>[FE_Q<2>(4)^2-FE_DGQ<2>(4)]
+  const std::string old_degree = "(" + std::to_string(fe_fine.degree) + ")";
+  const std::string new_degree = "(" + std::to_string(degree) + ")";
+
+  std::string name = fe_fine.get_name();
+
+  bool found = false;
+  for (std::size_t pos = name.find(old_degree); pos != std::string::npos;
+       pos             = name.find(old_degree, pos + new_degree.size()))
+    {
+      name.replace(pos, old_degree.size(), new_degree);
+      found = true;
+    }
+
+  AssertThrow(found,
+              ExcMessage("The polynomial degree of the finite element <" +
+                         fe_fine.get_name() +
+                         "> could not be identified from its name."));
+
+  return FETools::get_fe_by_name<dim>(name);
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+void
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::build(
+  const DoFHandler<dim> &    dof_handler_fine,
+  const ConstraintsFunction &constraints_function,
+  const OperatorFunction &   operator_function,
+  const AdditionalData &     additional_data)
+{
+  clear();
+
+  const FiniteElement<dim> &fe_fine = dof_handler_fine.get_fe();
+  const Triangulation<dim> &tria_fine =
+    dof_handler_fine.get_triangulation();
+
+  // the polynomial degrees, in ascending order
+  const std::vector<unsigned int> degrees =
+    MGTransferGlobalCoarseningTools::create_polynomial_coarsening_sequence(
+      fe_fine.degree, additional_data.p_sequence);
+
+  // the meshes, in ascending order; only parallel::distributed
+  // triangulations can be coarsened globally
+  std::vector<std::shared_ptr<const Triangulation<dim>>> meshes;
+  if (additional_data.perform_h_coarsening &&
+      dynamic_cast<const parallel::distributed::Triangulation<dim> *>(
+        &tria_fine) != nullptr)
+    meshes = MGTransferGlobalCoarseningTools::
+      create_geometric_coarsening_sequence(tria_fine);
+  else
+    meshes.emplace_back(&tria_fine, [](auto *) {
+      // empty deleter, since the triangulation is owned by the user
+    });
+
+  n_h_levels = meshes.size() - 1;
+
+  const unsigned int n_levels  = n_h_levels + degrees.size();
+  const unsigned int max_level = n_levels - 1;
+
+  // the finite elements, one per degree
+  for (const unsigned int degree : degrees)
+    fes.emplace_back(create_coarse_fe(fe_fine, degree));
+
+  // distribute the degrees of freedom on all levels, going from the finest
+  // level down; we stop the h-coarsening once the level is small enough
+  const unsigned int n_processes =
+    Utilities::MPI::n_mpi_processes(dof_handler_fine.get_communicator());
+
+  std::vector<std::shared_ptr<const DoFHandler<dim>>> level_dof_handlers(
+    n_levels);
+  unsigned int min_level = 0;
+
+  for (unsigned int l = max_level; l < n_levels; --l)
+    {
+      if (l == max_level)
+        level_dof_handlers[l].reset(&dof_handler_fine, [](auto *) {
+          // empty deleter, since the DoFHandler is owned by the user
+        });
+      else
+        {
+          const unsigned int mesh   = std::min(l, n_h_levels);
+          const unsigned int degree = l < n_h_levels ? 0 : l - n_h_levels;
+
+          auto dof_handler = std::make_shared<DoFHandler<dim>>(*meshes[mesh]);
+          dof_handler->distribute_dofs(*fes[degree]);
+          level_dof_handlers[l] = dof_handler;
+        }
+
+      if (l < n_h_levels &&
+          level_dof_handlers[l]->n_dofs() <
+            static_cast<types::global_dof_index>(
+              additional_data.min_n_dofs_per_process) *
+              n_processes)
+        {
+          min_level = l;
+          break;
+        }
+    }
+
+  triangulations.resize(min_level, max_level);
+  dof_handlers.resize(min_level, max_level);
+  constraints.resize(min_level, max_level);
+  operators.resize(min_level, max_level);
+  transfers.resize(min_level, max_level);
+
+  for (unsigned int l = min_level; l <= max_level; ++l)
+    {
+      triangulations[l] = meshes[std::min(l, n_h_levels)];
+      dof_handlers[l]   = level_dof_handlers[l];
+    }
+
+  // set up the constraints, followed by the operators, which might be done
+  // concurrently on the different levels
+  for (unsigned int l = min_level; l <= max_level; ++l)
+    constraints_function(*dof_handlers[l], constraints[l]);
+
+  if (additional_data.setup_operators_concurrently && n_processes == 1)
+    {
+      Threads::TaskGroup<void> tasks;
+      for (unsigned int l = min_level; l <= max_level; ++l)
+        tasks += Threads::new_task([&, l]() {
+          operator_function(*dof_handlers[l], constraints[l], operators[l]);
+        });
+      tasks.join_all();
+    }
+  else
+    for (unsigned int l = min_level; l <= max_level; ++l)
+      operator_function(*dof_handlers[l], constraints[l], operators[l]);
+
+  // set up the two-level transfers
+  for (unsigned int l = min_level + 1; l <= max_level; ++l)
+    if (l <= n_h_levels)
+      transfers[l].reinit_geometric_transfer(*dof_handlers[l],
+                                             *dof_handlers[l - 1],
+                                             constraints[l],
+                                             constraints[l - 1]);
+    else
+      transfers[l].reinit_polynomial_transfer(*dof_handlers[l],
+                                              *dof_handlers[l - 1],
+                                              constraints[l],
+                                              constraints[l - 1]);
+
+  transfer = std::make_unique<MGTransferGlobalCoarsening<dim, VectorType>>(
+    transfers, [this](const unsigned int level, VectorType &vec) {
+      operators[level].initialize_dof_vector(vec);
+    });
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+void
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::clear()
+{
+  // release the objects in the reverse order of their dependencies
+  transfer.reset();
+  transfers.resize(0, 0);
+  operators.resize(0, 0);
+  constraints.resize(0, 0);
+  dof_handlers.resize(0, 0);
+  triangulations.resize(0, 0);
+  fes.clear();
+  n_h_levels = 0;
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline unsigned int
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::min_level() const
+{
+  return operators.min_level();
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline unsigned int
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::max_level() const
+{
+  return operators.max_level();
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline const DoFHandler<dim> &
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::get_dof_handler(
+  const unsigned int level) const
+{
+  Assert(dof_handlers[level] != nullptr, ExcNotInitialized());
+  return *dof_handlers[level];
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline const AffineConstraints<Number> &
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::get_constraints(
+  const unsigned int level) const
+{
+  return constraints[level];
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline const OperatorType &
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::get_operator(
+  const unsigned int level) const
+{
+  return operators[level];
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline const MGLevelObject<OperatorType> &
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::get_operators() const
+{
+  return operators;
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline const MGLevelObject<
+  MGTwoLevelTransfer<dim,
+                     typename MGGlobalCoarseningHierarchy<dim,
+                                                          Number,
+                                                          OperatorType>::
+                       VectorType>> &
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::
+  get_two_level_transfers() const
+{
+  return transfers;
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline const MGTransferGlobalCoarsening<
+  dim,
+  typename MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::VectorType> &
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::get_transfer() const
+{
+  Assert(transfer != nullptr, ExcNotInitialized());
+  return *transfer;
+}
+
+
+
+template <int dim, typename Number, typename OperatorType>
+inline bool
+MGGlobalCoarseningHierarchy<dim, Number, OperatorType>::is_h_level(
+  const unsigned int level) const
+{
+  AssertIndexRange(level, max_level() + 1);
+  return level < n_h_levels;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,466 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_profiler_h
+#define dealii_mg_profiler_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/multigrid/multigrid.h>
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A class that measures the time spent in the individual phases of a
+ * multigrid cycle on each level. It attaches to the signals of a Multigrid
+ * object (see Multigrid::connect_pre_smoother_step() and the related
+ * functions) and collects the wall time for pre-smoothing, post-smoothing,
+ * restriction, prolongation, and the coarse grid solve on each level.
+ *
+ * From the sizes of the level vectors, the class also derives the
+ * throughput in degrees of freedom per second and an estimate of the memory
+ * bandwidth. The latter only counts the accesses to the level vectors
+ * involved in the respective phase (e.g., reading the fine vector and
+ * reading and writing the coarse vector in the restriction) and thus is a
+ * lower bound of the actual memory traffic, as it neither includes the
+ * matrix data nor the vector accesses inside the smoothers beyond a single
+ * pass. The smoother estimate assumes a single read of the defect and a
+ * read and write of the solution per call. Since the global sizes of the
+ * vectors are used, both numbers refer to all processes together.
+ *
+ * The results are printed by print_summary() in the form of a table similar
+ * to the one of TimerOutput, with the minimum, average, and maximum of the
+ * time over all MPI processes:
+ * @code
+ *   Multigrid<VectorType> mg(...);
+ *   MGProfiler<VectorType> profiler;
+ *   profiler.connect(mg);
+ *   // ... solve with PreconditionMG ...
+ *   profiler.print_summary(std::cout, MPI_COMM_WORLD);
+ * @endcode
+ *
+ * The profiler only adds the cost of reading a clock twice per phase and
+ * level, but it is entirely opt-in: without calling connect(), nothing is
+ * measured.
+ */
+template <typename VectorType>
+class MGProfiler : public Subscriptor
+{
+public:
+  /**
+   * The phases of a multigrid cycle measured by this class.
+   */
+  enum Phase
+  {
+    /// Pre-smoothing, see mg::Signals::pre_smoother_step
+    pre_smoothing,
+    /// Post-smoothing, see mg::Signals::post_smoother_step
+    post_smoothing,
+    /// Restriction from a level, see mg::Signals::restriction
+    restriction,
+    /// Prolongation to a level, see mg::Signals::prolongation
+    prolongation,
+    /// Coarse grid solve, see mg::Signals::coarse_solve
+    coarse_solve,
+    /// Number of phases
+    n_phases
+  };
+
+  /**
+   * Constructor. Does not connect to any multigrid object yet.
+   */
+  MGProfiler();
+
+  /**
+   * Destructor. Disconnects from the multigrid object.
+   */
+  ~MGProfiler() override;
+
+  /**
+   * Connect to the signals of @p mg and reset all measurements. The
+   * multigrid object needs to outlive this object or the next call to
+   * disconnect().
+   */
+  void
+  connect(Multigrid<VectorType> &mg);
+
+  /**
+   * Disconnect from the signals of the multigrid object. The collected data
+   * remains available.
+   */
+  void
+  disconnect();
+
+  /**
+   * Reset all measurements.
+   */
+  void
+  reset();
+
+  /**
+   * Return the accumulated wall time in seconds spent on the given @p level
+   * in @p phase on the current process.
+   */
+  double
+  get_wall_time(const unsigned int level, const Phase phase) const;
+
+  /**
+   * Return how often @p phase has been run on @p level.
+   */
+  unsigned int
+  get_n_calls(const unsigned int level, const Phase phase) const;
+
+  /**
+   * Print a table of the measurements per level and phase to @p out. The
+   * times are reduced over all processes in @p mpi_communicator (minimum,
+   * average, and maximum), so this is a collective operation. The
+   * throughput numbers are based on the maximal time. Only the process with
+   * rank zero writes output.
+   */
+  void
+  print_summary(std::ostream &out, const MPI_Comm &mpi_communicator) const;
+
+private:
+  /**
+   * Measurements of one phase on one level.
+   */
+  struct Data
+  {
+    /**
+     * Constructor.
+     */
+    Data();
+
+    /**
+     * Accumulated wall time in seconds.
+     */
+    double wall_time;
+
+    /**
+     * Number of calls.
+     */
+    unsigned int n_calls;
+
+    /**
+     * Accumulated number of degrees of freedom processed.
+     */
+    double n_dofs;
+
+    /**
+     * Accumulated estimate of the bytes moved from and to memory.
+     */
+    double bytes;
+
+    /**
+     * Start time of the currently running measurement.
+     */
+    std::chrono::steady_clock::time_point start_time;
+  };
+
+  /**
+   * Start (@p before is true) or stop (@p before is false) the measurement
+   * of @p phase on @p level.
+   */
+  void
+  measure(const bool before, const unsigned int level, const Phase phase);
+
+  /**
+   * Return the number of bytes of the level vector on @p level, or zero if
+   * the vector has not been set up.
+   */
+  double
+  vector_bytes(const unsigned int level) const;
+
+  /**
+   * Return the name of the given phase for output.
+   */
+  static const char *
+  phase_name(const Phase phase);
+
+  /**
+   * Pointer to the multigrid object we are connected to.
+   */
+  SmartPointer<const Multigrid<VectorType>, MGProfiler<VectorType>> mg;
+
+  /**
+   * The measurements, indexed by level and phase.
+   */
+  std::vector<std::array<Data, n_phases>> data;
+
+  /**
+   * The connections to the signals of the multigrid object.
+   */
+  std::vector<boost::signals2::connection> connections;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/* ------------------------- Inline functions --------------------------- */
+
+template <typename VectorType>
+MGProfiler<VectorType>::Data::Data()
+  : wall_time(0.)
+  , n_calls(0)
+  , n_dofs(0.)
+  , bytes(0.)
+{}
+
+
+
+template <typename VectorType>
+MGProfiler<VectorType>::MGProfiler()
+  : mg(nullptr, typeid(*this).name())
+{}
+
+
+
+template <typename VectorType>
+MGProfiler<VectorType>::~MGProfiler()
+{
+  disconnect();
+}
+
+
+
+template <typename VectorType>
+void
+MGProfiler<VectorType>::connect(Multigrid<VectorType> &mg_in)
+{
+  disconnect();
+  mg = &mg_in;
+  data.clear();
+  data.resize(mg_in.get_maxlevel() + 1);
+
+  connections.push_back(mg_in.connect_pre_smoother_step(
+    [this](const bool before, const unsigned int level) {
+      this->measure(before, level, pre_smoothing);
+    }));
+  connections.push_back(mg_in.connect_post_smoother_step(
+    [this](const bool before, const unsigned int level) {
+      this->measure(before, level, post_smoothing);
+    }));
+  connections.push_back(mg_in.connect_restriction(
+    [this](const bool before, const unsigned int level) {
+      this->measure(before, level, restriction);
+    }));
+  connections.push_back(mg_in.connect_prolongation(
+    [this](const bool before, const unsigned int level) {
+      this->measure(before, level, prolongation);
+    }));
+  connections.push_back(mg_in.connect_coarse_solve(
+    [this](const bool before, const unsigned int level) {
+      this->measure(before, level, coarse_solve);
+    }));
+}
+
+
+
+template <typename VectorType>
+void
+MGProfiler<VectorType>::disconnect()
+{
+  for (auto &connection : connections)
+    connection.disconnect();
+  connections.clear();
+  mg = nullptr;
+}
+
+
+
+template <typename VectorType>
+void
+MGProfiler<VectorType>::reset()
+{
+  for (auto &level_data : data)
+    for (auto &phase_data : level_data)
+      phase_data = Data();
+}
+
+
+
+template <typename VectorType>
+double
+MGProfiler<VectorType>::get_wall_time(const unsigned int level,
+                                      const Phase        phase) const
+{
+  AssertIndexRange(level, data.size());
+  return data[level][phase].wall_time;
+}
+
+
+
+template <typename VectorType>
+unsigned int
+MGProfiler<VectorType>::get_n_calls(const unsigned int level,
+                                    const Phase        phase) const
+{
+  AssertIndexRange(level, data.size());
+  return data[level][phase].n_calls;
+}
+
+
+
+template <typename VectorType>
+double
+MGProfiler<VectorType>::vector_bytes(const unsigned int level) const
+{
+  if (mg == nullptr || level < mg->defect.min_level() ||
+      level > mg->defect.max_level())
+    return 0.;
+  return static_cast<double>(mg->defect[level].size()) *
+         sizeof(typename VectorType::value_type);
+}
+
+
+
+template <typename VectorType>
+void
+MGProfiler<VectorType>::measure(const bool         before,
+                                const unsigned int level,
+                                const Phase        phase)
+{
+  // the signals of different levels may be triggered concurrently (see
+  // Multigrid::set_concurrent_level_smoothing()), so the data must already
+  // be allocated here
+  AssertIndexRange(level, data.size());
+  Data &d = data[level][phase];
+  if (before)
+    {
+      d.start_time = std::chrono::steady_clock::now();
+      return;
+    }
+
+  d.wall_time += std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - d.start_time)
+                   .count();
+  ++d.n_calls;
+
+  // estimate the number of vector entries read and written: the
+  // transfer reads the source vector and reads and writes the destination,
+  // the smoothers and the coarse solver read the defect and read and write
+  // the solution
+  const double bytes_fine   = vector_bytes(level);
+  const double bytes_coarse = level > 0 ? vector_bytes(level - 1) : 0.;
+  switch (phase)
+    {
+      case restriction:
+        d.bytes += bytes_fine + 2. * bytes_coarse;
+        break;
+      case prolongation:
+        d.bytes += bytes_coarse + 2. * bytes_fine;
+        break;
+      default:
+        d.bytes += 3. * bytes_fine;
+    }
+  d.n_dofs += bytes_fine / sizeof(typename VectorType::value_type);
+}
+
+
+
+template <typename VectorType>
+const char *
+MGProfiler<VectorType>::phase_name(const Phase phase)
+{
+  switch (phase)
+    {
+      case pre_smoothing:
+        return "pre-smoothing";
+      case post_smoothing:
+        return "post-smoothing";
+      case restriction:
+        return "restriction";
+      case prolongation:
+        return "prolongation";
+      case coarse_solve:
+        return "coarse solve";
+      default:
+        Assert(false, ExcInternalError());
+    }
+  return "";
+}
+
+
+
+template <typename VectorType>
+void
+MGProfiler<VectorType>::print_summary(std::ostream &  out,
+                                      const MPI_Comm &mpi_communicator) const
+{
+  // collect the times of all levels and phases to reduce them at once
+  std::vector<double> times;
+  for (const auto &level_data : data)
+    for (const auto &phase_data : level_data)
+      times.push_back(phase_data.wall_time);
+  std::vector<Utilities::MPI::MinMaxAvg> reduced_times(times.size());
+  Utilities::MPI::min_max_avg(times, reduced_times, mpi_communicator);
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0)
+    return;
+
+  const std::ios_base::fmtflags old_flags     = out.flags();
+  const std::streamsize         old_precision = out.precision();
+
+  const std::string separator =
+    "+-------+----------------+---------+------------+------------+"
+    "------------+------------+------------+";
+  out << std::endl
+      << separator << std::endl
+      << "| Level | Phase          | # calls |  min t [s] |  avg t [s] |"
+      << "  max t [s] |   MDoFs/s  |    GB/s    |" << std::endl
+      << separator << std::endl;
+
+  out << std::fixed;
+  for (unsigned int level = 0, index = 0; level < data.size(); ++level)
+    for (unsigned int phase = 0; phase < n_phases; ++phase, ++index)
+      {
+        const Data &d = data[level][phase];
+        if (d.n_calls == 0)
+          continue;
+        const Utilities::MPI::MinMaxAvg &t = reduced_times[index];
+        out << "| " << std::setw(5) << level << " | " << std::left
+            << std::setw(14) << phase_name(static_cast<Phase>(phase))
+            << std::right << " | " << std::setw(7) << d.n_calls << " | "
+            << std::setprecision(4) << std::setw(10) << t.min << " | "
+            << std::setw(10) << t.avg << " | " << std::setw(10) << t.max
+            << " | " << std::setprecision(2) << std::setw(10)
+            << (t.max > 0. ? 1e-6 * d.n_dofs / t.max : 0.) << " | "
+            << std::setw(10) << (t.max > 0. ? 1e-9 * d.bytes / t.max : 0.)
+            << " |" << std::endl;
+      }
+  out << separator << std::endl << std::endl;
+
+  out.flags(old_flags);
+  out.precision(old_precision);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
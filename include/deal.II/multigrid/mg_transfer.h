@@ -445,6 +445,31 @@ public:
     LinearAlgebra::distributed::Vector<Number2> &dst,
     const MGLevelObject<LinearAlgebra::distributed::Vector<Number>> &src) const;
 
+  /**
+   * Same as copy_from_mg(), but for the case that the active degrees of
+   * freedom coincide with the ones of the finest level (e.g. for uniformly
+   * refined meshes), the storage of @p dst is exchanged with the one of the
+   * finest level vector of @p src instead of copying the entries. This
+   * requires the two vectors to share the same partitioner object, as is
+   * the case when both of them were initialized by the same MatrixFree
+   * object, or when the partitioner used for @p dst was passed to
+   * MGTransferMatrixFree::build() as the external partitioner of the finest
+   * level. After the call, the finest level of @p src holds the previous content of @p dst.
+   * If the storage cannot be exchanged, this function falls back to
+   * copy_from_mg().
+   *
+   * This function is used by PreconditionMG::vmult(), which avoids one pass
+   * over the finest level vector per multigrid cycle in this way, since the
+   * content of the multigrid solution vectors is not needed after the
+   * cycle.
+   */
+  template <int dim, int spacedim>
+  void
+  swap_from_mg(
+    const DoFHandler<dim, spacedim> &                          dof_handler,
+    LinearAlgebra::distributed::Vector<Number> &               dst,
+    MGLevelObject<LinearAlgebra::distributed::Vector<Number>> &src) const;
+
   /**
    * Add a multi-level vector to a normal vector.
    *
@@ -589,6 +589,34 @@ MGLevelGlobalTransfer<LinearAlgebra::distributed::Vector<Number>>::copy_from_mg(
 
 
 
+template <typename Number>
+template <int dim, int spacedim>
+void
+MGLevelGlobalTransfer<LinearAlgebra::distributed::Vector<Number>>::swap_from_mg(
+  const DoFHandler<dim, spacedim> &                          dof_handler,
+  LinearAlgebra::distributed::Vector<Number> &               dst,
+  MGLevelObject<LinearAlgebra::distributed::Vector<Number>> &src) const
+{
+  assert_built(dof_handler);
+
+  // we require the very same partitioner object, so that the swap does not
+  // change the partitioner seen by the user, e.g. by MatrixFree, which
+  // identifies vectors by the address of their partitioner; the check only
+  // involves local data, and different processes might take different
+  // paths here, which is fine since neither of them involves communication
+  LinearAlgebra::distributed::Vector<Number> &src_level = src[src.max_level()];
+  if (perform_plain_copy && src_level.get_partitioner() != nullptr &&
+      src_level.get_partitioner() == dst.get_partitioner())
+    {
+      src_level.zero_out_ghost_values();
+      dst.swap(src_level);
+    }
+  else
+    copy_from_mg(dof_handler, dst, src);
+}
+
+
+
 template <typename Number>
 template <int dim, typename Number2, int spacedim>
 void
@@ -17,6 +17,7 @@
 #define dealii_mg_transfer_global_coarsening_h
 
 #include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
@@ -25,6 +26,8 @@
 
 #include <deal.II/multigrid/mg_base.h>
 
+#include <functional>
+
 DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
@@ -117,6 +120,12 @@ public:
   void
   prolongate(VectorType &dst, const VectorType &src) const;
 
+  /**
+   * Perform prolongation, summing into the previous content of @p dst.
+   */
+  void
+  prolongate_and_add(VectorType &dst, const VectorType &src) const;
+
   /**
    * Perform restriction.
    */
@@ -186,6 +195,36 @@ public:
   prolongate(LinearAlgebra::distributed::Vector<Number> &      dst,
              const LinearAlgebra::distributed::Vector<Number> &src) const;
 
+  /**
+   * Perform prolongation, summing into the previous content of @p dst.
+   *
+   * The prolongated values are added to @p dst in the last pass of the
+   * prolongation, which avoids the separate pass through the fine vector of
+   * a call to prolongate() followed by the addition of the result.
+   */
+  void
+  prolongate_and_add(
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src) const;
+
+  /**
+   * Same as above, but call @p operation_after_prolongation on consecutive
+   * ranges $[\text{begin}, \text{end})$ of local indices of the locally
+   * owned part of @p dst as soon as the entries in this range are final.
+   * The ranges are short enough for the entries to be still in cache when
+   * the operation accesses them, so the first update of a smoother, e.g.
+   * the addition of a scaled vector in a Jacobi or Chebyshev iteration, can
+   * be fused with the prolongation rather than going through the fine
+   * vector once again. This is similar to the @p operation_after_loop
+   * argument of MatrixFree::cell_loop().
+   */
+  void
+  prolongate_and_add(
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_prolongation) const;
+
   /**
    * Perform restriction.
    */
@@ -193,6 +232,27 @@ public:
   restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
                    const LinearAlgebra::distributed::Vector<Number> &src) const;
 
+  /**
+   * Same as above, but call @p operation_before_restriction on consecutive
+   * ranges $[\text{begin}, \text{end})$ of local indices of the locally
+   * owned part of @p src right before the entries in this range are read
+   * by the restriction. This allows to fuse the final step of a residual
+   * computation $r = b - Ax$ after the cell loop of the matrix-vector
+   * product, i.e., the subtraction from the right hand side and the
+   * treatment of constrained entries, with the restriction, such that the
+   * residual is only written once and read while still in cache. The
+   * operation may modify the entries of @p src in the given range, e.g.
+   * through a reference to the vector captured by a lambda function. This
+   * is similar to the @p operation_before_loop argument of
+   * MatrixFree::cell_loop().
+   */
+  void
+  restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                   const LinearAlgebra::distributed::Vector<Number> &src,
+                   const std::function<void(const unsigned int,
+                                            const unsigned int)>
+                     &operation_before_restriction) const;
+
   /**
    * Perform interpolation of a solution vector from the fine level to the
    * coarse level. This function is different from restriction, where a
@@ -204,6 +264,19 @@ public:
               const LinearAlgebra::distributed::Vector<Number> &src) const;
 
 private:
+  /**
+   * Perform prolongation, overwriting or adding to @p dst depending on
+   * @p add, and call @p operation_after_prolongation on the final ranges of
+   * @p dst if given.
+   */
+  void
+  do_prolongate(LinearAlgebra::distributed::Vector<Number> &      dst,
+                const LinearAlgebra::distributed::Vector<Number> &src,
+                const bool                                        add,
+                const std::function<void(const unsigned int,
+                                         const unsigned int)>
+                  &operation_after_prolongation) const;
+
   /**
    * A multigrid transfer scheme. A multrigrid transfer class can have different
    * transfer schemes to enable p-adaptivity (one transfer scheme per
@@ -402,6 +475,14 @@ public:
              VectorType &       dst,
              const VectorType & src) const override;
 
+  /**
+   * Perform prolongation, summing into the previous content of @p dst.
+   */
+  void
+  prolongate_and_add(const unsigned int to_level,
+                     VectorType &       dst,
+                     const VectorType & src) const override;
+
   /**
    * Perform restriction.
    */
@@ -434,6 +515,23 @@ public:
                OutVector &                      dst,
                const MGLevelObject<VectorType> &src) const;
 
+  /**
+   * Same as copy_from_mg(), but exchange the storage of @p dst with the one of
+   * the finest level vector of @p src instead of copying the entries, if the
+   * two vectors share the same partitioner object, e.g. because the finest
+   * level operator uses the same MatrixFree object as the one on the active
+   * mesh. After the call, the finest
+   * level of @p src holds the previous content of @p dst. See also
+   * MGLevelGlobalTransfer::swap_from_mg().
+   *
+   * @note DoFHandler is not needed here, but is required by the interface.
+   */
+  template <int spacedim>
+  void
+  swap_from_mg(const DoFHandler<dim, spacedim> &dof_handler,
+               VectorType &                     dst,
+               MGLevelObject<VectorType> &      src) const;
+
   /**
    * Interpolate fine-mesh field @p src to each multigrid level in
    * @p dof_handler and store the result in @p dst. This function is different
@@ -498,6 +596,18 @@ MGTransferGlobalCoarsening<dim, VectorType>::prolongate(
 
 
 
+template <int dim, typename VectorType>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::prolongate_and_add(
+  const unsigned int to_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  this->transfer[to_level].prolongate_and_add(dst, src);
+}
+
+
+
 template <int dim, typename VectorType>
 void
 MGTransferGlobalCoarsening<dim, VectorType>::restrict_and_add(
@@ -550,6 +660,27 @@ MGTransferGlobalCoarsening<dim, VectorType>::copy_from_mg(
 
 
 
+template <int dim, typename VectorType>
+template <int spacedim>
+void
+MGTransferGlobalCoarsening<dim, VectorType>::swap_from_mg(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  VectorType &                     dst,
+  MGLevelObject<VectorType> &      src) const
+{
+  VectorType &src_level = src[src.max_level()];
+  if (src_level.get_partitioner() != nullptr &&
+      src_level.get_partitioner() == dst.get_partitioner())
+    {
+      src_level.zero_out_ghost_values();
+      dst.swap(src_level);
+    }
+  else
+    copy_from_mg(dof_handler, dst, src);
+}
+
+
+
 template <int dim, typename VectorType>
 template <class InVector, int spacedim>
 void
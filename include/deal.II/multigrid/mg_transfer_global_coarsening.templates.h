@@ -2119,6 +2119,47 @@ void
 MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::prolongate(
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  do_prolongate(dst, src, false, {});
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  prolongate_and_add(
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  do_prolongate(dst, src, true, {});
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  prolongate_and_add(
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_prolongation) const
+{
+  do_prolongate(dst, src, true, operation_after_prolongation);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  do_prolongate(LinearAlgebra::distributed::Vector<Number> &      dst,
+                const LinearAlgebra::distributed::Vector<Number> &src,
+                const bool                                        add,
+                const std::function<void(const unsigned int,
+                                         const unsigned int)>
+                  &operation_after_prolongation) const
 {
   using VectorizedArrayType = VectorizedArray<Number>;
 
@@ -2272,7 +2313,33 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::prolongate(
   if (schemes.size() > 0 && schemes.front().fine_element_is_continuous)
     this->vec_fine.compress(VectorOperation::add);
 
-  dst.copy_locally_owned_data_from(this->vec_fine);
+  // write the result into dst in chunks small enough to stay in the L1
+  // cache, and pass each chunk to the user operation
+  AssertDimension(dst.locally_owned_size(),
+                  this->vec_fine.locally_owned_size());
+  constexpr unsigned int chunk_size         = 512;
+  const unsigned int     locally_owned_size = dst.locally_owned_size();
+  Number *               dst_ptr            = dst.begin();
+  const Number *         fine_ptr           = this->vec_fine.begin();
+  for (unsigned int begin = 0; begin < locally_owned_size; begin += chunk_size)
+    {
+      const unsigned int end = std::min(begin + chunk_size, locally_owned_size);
+      if (add)
+        {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = begin; i < end; ++i)
+            dst_ptr[i] += fine_ptr[i];
+        }
+      else
+        {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = begin; i < end; ++i)
+            dst_ptr[i] = fine_ptr[i];
+        }
+
+      if (operation_after_prolongation)
+        operation_after_prolongation(begin, end);
+    }
 }
 
 
@@ -2282,12 +2349,50 @@ void
 MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
   restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
                    const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  restrict_and_add(dst, src, {});
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
+  restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                   const LinearAlgebra::distributed::Vector<Number> &src,
+                   const std::function<void(const unsigned int,
+                                            const unsigned int)>
+                     &operation_before_restriction) const
 {
   using VectorizedArrayType = VectorizedArray<Number>;
 
   const unsigned int n_lanes = VectorizedArrayType::size();
 
-  this->vec_fine.copy_locally_owned_data_from(src);
+  // read src in chunks small enough to stay in the L1 cache, and let the
+  // user operation finish the entries of each chunk right before they are
+  // copied
+  if (operation_before_restriction)
+    {
+      AssertDimension(src.locally_owned_size(),
+                      this->vec_fine.locally_owned_size());
+      constexpr unsigned int chunk_size         = 512;
+      const unsigned int     locally_owned_size = src.locally_owned_size();
+      const Number *         src_ptr            = src.begin();
+      Number *               fine_ptr           = this->vec_fine.begin();
+      for (unsigned int begin = 0; begin < locally_owned_size;
+           begin += chunk_size)
+        {
+          const unsigned int end =
+            std::min(begin + chunk_size, locally_owned_size);
+          operation_before_restriction(begin, end);
+
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = begin; i < end; ++i)
+            fine_ptr[i] = src_ptr[i];
+        }
+    }
+  else
+    this->vec_fine.copy_locally_owned_data_from(src);
   this->vec_fine.update_ghost_values();
 
   this->vec_coarse.copy_locally_owned_data_from(dst);
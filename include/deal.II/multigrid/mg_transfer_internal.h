@@ -118,6 +118,8 @@ namespace internal
 
     /**
      * Set up most of the internal data structures of MGTransferMatrixFree
+     * for the degrees of freedom of the base element with index
+     * @p base_element of the finite element in @p dof_handler.
      */
     template <int dim, typename Number>
     void
@@ -135,7 +137,8 @@ namespace internal
       std::vector<std::vector<Number>> &                     weights_on_refined,
       std::vector<Table<2, unsigned int>> &copy_indices_global_mine,
       MGLevelObject<std::shared_ptr<const Utilities::MPI::Partitioner>>
-        &vector_partitioners);
+        &                vector_partitioners,
+      const unsigned int base_element = 0);
 
   } // namespace MGTransfer
 } // namespace internal
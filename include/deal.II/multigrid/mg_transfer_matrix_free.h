@@ -47,8 +47,13 @@ DEAL_II_NAMESPACE_OPEN
  *
  * This class currently only works for tensor-product finite elements based on
  * FE_Q and FE_DGQ elements, including systems involving multiple components
- * of one of these elements. Systems with different elements or other elements
- * are currently not implemented.
+ * of one or several of these elements such as the Taylor--Hood element
+ * FESystem<dim>(FE_Q<dim>(2), dim, FE_Q<dim>(1), 1). For systems with several
+ * base elements, the transfer is applied separately to the degrees of freedom
+ * of each base element with the respective sum-factorization kernel, and all
+ * base elements share the same vector partitioners and thus a single ghost
+ * exchange per transfer operation. Other elements are currently not
+ * implemented.
  */
 template <int dim, typename Number>
 class MGTransferMatrixFree
@@ -187,42 +192,88 @@ public:
 
 private:
   /**
-   * A variable storing the degree of the finite element contained in the
-   * DoFHandler passed to build(). The selection of the computational kernel is
-   * based on this number.
+   * A structure holding the data of the transfer of the degrees of freedom
+   * of one base element of the finite element passed to build().
    */
-  unsigned int fe_degree;
-
-  /**
-   * A variable storing whether the element is continuous and there is a joint
-   * degree of freedom in the center of the 1D line.
-   */
-  bool element_is_continuous;
-
-  /**
-   * A variable storing the number of components in the finite element contained
-   * in the DoFHandler passed to build().
-   */
-  unsigned int n_components;
-
-  /**
-   * A variable storing the number of degrees of freedom on all child cells. It
-   * is <tt>2<sup>dim</sup>*fe.n_dofs_per_cell()</tt> for DG elements and
-   * somewhat less for continuous elements.
-   */
-  unsigned int n_child_cell_dofs;
-
-  /**
-   * This variable holds the indices for cells on a given level, extracted from
-   * DoFHandler for fast access. All DoF indices on a given level are stored as
-   * a plain array (since this class assumes constant DoFs per cell). To index
-   * into this array, use the cell number times dofs_per_cell.
-   *
-   * This array first is arranged such that all locally owned level cells come
-   * first (found in the variable n_owned_level_cells) and then other cells
-   * necessary for the transfer to the next level.
-   */
-  std::vector<std::vector<unsigned int>> level_dof_indices;
+  struct BaseElementData
+  {
+    /**
+     * A variable storing the degree of the base element. The selection of
+     * the computational kernel is based on this number.
+     */
+    unsigned int fe_degree;
+
+    /**
+     * A variable storing whether the element is continuous and there is a
+     * joint degree of freedom in the center of the 1D line.
+     */
+    bool element_is_continuous;
+
+    /**
+     * A variable storing the number of components of the base element, i.e.,
+     * its multiplicity in the finite element passed to build().
+     */
+    unsigned int n_components;
+
+    /**
+     * A variable storing the number of degrees of freedom of the base
+     * element on all child cells. It is
+     * <tt>2<sup>dim</sup>*fe.n_dofs_per_cell()</tt> for DG elements and
+     * somewhat less for continuous elements.
+     */
+    unsigned int n_child_cell_dofs;
+
+    /**
+     * This variable holds the indices of the degrees of freedom of the base
+     * element for cells on a given level, extracted from DoFHandler for fast
+     * access. All DoF indices on a given level are stored as a plain array
+     * (since this class assumes constant DoFs per cell). To index into this
+     * array, use the cell number times n_child_cell_dofs.
+     *
+     * This array first is arranged such that all locally owned level cells
+     * come first (found in the variable n_owned_level_cells) and then other
+     * cells necessary for the transfer to the next level.
+     */
+    std::vector<std::vector<unsigned int>> level_dof_indices;
+
+    /**
+     * This variable holds the one-dimensional embedding (prolongation)
+     * matrix from mother element to all the children.
+     */
+    AlignedVector<VectorizedArray<Number>> prolongation_matrix_1d;
+
+    /**
+     * For continuous elements, restriction is not additive and we need to
+     * weight the result at the end of prolongation (and at the start of
+     * restriction) by the valence of the degrees of freedom, i.e., on how
+     * many elements they appear. We store the data in vectorized form to
+     * allow for cheap access. Moreover, we utilize the fact that we only
+     * need to store <tt>3<sup>dim</sup></tt> indices.
+     *
+     * Data is organized in terms of each level (outer vector) and the cells
+     * on each level (inner vector).
+     */
+    std::vector<AlignedVector<VectorizedArray<Number>>> weights_on_refined;
+
+    /**
+     * A variable storing the local indices of Dirichlet boundary conditions
+     * on cells for all levels (outer index), the cells within the levels
+     * (second index), and the indices on the cell (inner index).
+     */
+    std::vector<std::vector<std::vector<unsigned short>>> dirichlet_indices;
+
+    /**
+     * Memory used by this object.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * The transfer data for each base element of the finite element passed to
+   * build().
+   */
+  std::vector<BaseElementData> base_element_data;
 
   /**
    * A variable storing the connectivity from parent to child cell numbers for
@@ -238,36 +289,11 @@ private:
   std::vector<unsigned int> n_owned_level_cells;
 
   /**
-   * This variable holds the one-dimensional embedding (prolongation) matrix
-   * from mother element to all the children.
-   */
-  AlignedVector<VectorizedArray<Number>> prolongation_matrix_1d;
-
-  /**
-   * This variable holds the temporary values for the tensor evaluation
+   * This variable holds the temporary values for the tensor evaluation,
+   * sized for the base element with the most child degrees of freedom.
    */
   mutable AlignedVector<VectorizedArray<Number>> evaluation_data;
 
-  /**
-   * For continuous elements, restriction is not additive and we need to
-   * weight the result at the end of prolongation (and at the start of
-   * restriction) by the valence of the degrees of freedom, i.e., on how many
-   * elements they appear. We store the data in vectorized form to allow for
-   * cheap access. Moreover, we utilize the fact that we only need to store
-   * <tt>3<sup>dim</sup></tt> indices.
-   *
-   * Data is organized in terms of each level (outer vector) and the cells on
-   * each level (inner vector).
-   */
-  std::vector<AlignedVector<VectorizedArray<Number>>> weights_on_refined;
-
-  /**
-   * A variable storing the local indices of Dirichlet boundary conditions on
-   * cells for all levels (outer index), the cells within the levels (second
-   * index), and the indices on the cell (inner index).
-   */
-  std::vector<std::vector<std::vector<unsigned short>>> dirichlet_indices;
-
   /**
    * A vector that holds shared pointers to the partitioners of the
    * transfer. These partitioners might be shared with what was passed in from
@@ -278,21 +304,25 @@ private:
     vector_partitioners;
 
   /**
-   * Perform the prolongation operation.
+   * Perform the prolongation operation for the degrees of freedom of the
+   * given base element.
    */
   template <int degree>
   void
   do_prolongate_add(
     const unsigned int                                to_level,
+    const BaseElementData &                           data,
     LinearAlgebra::distributed::Vector<Number> &      dst,
     const LinearAlgebra::distributed::Vector<Number> &src) const;
 
   /**
-   * Performs the restriction operation.
+   * Performs the restriction operation for the degrees of freedom of the
+   * given base element.
    */
   template <int degree>
   void
   do_restrict_add(const unsigned int                                from_level,
+                  const BaseElementData &                           data,
                   LinearAlgebra::distributed::Vector<Number> &      dst,
                   const LinearAlgebra::distributed::Vector<Number> &src) const;
 };
@@ -135,7 +135,8 @@ namespace mg
  * The function which starts a multigrid cycle on the finest level is cycle().
  * Depending on the cycle type chosen with the constructor (see enum Cycle),
  * this function triggers one of the cycles level_v_step() or level_step(),
- * where the latter one can do different types of cycles.
+ * where the latter one can do different types of cycles, or the additive
+ * cycle additive_step().
  *
  * Using this class, it is expected that the right hand side has been
  * converted from a vector living on the locally finest level to a multilevel
@@ -162,7 +163,23 @@ public:
     /// The W-cycle
     w_cycle,
     /// The F-cycle
-    f_cycle
+    f_cycle,
+    /**
+     * An additive cycle in the spirit of the BPX preconditioner: the defect
+     * is restricted to all levels first, then the smoothers on all levels
+     * and the coarse grid solver are applied independently of each other,
+     * and finally the corrections are prolongated and summed up. Since the
+     * work on the levels is independent, it can be run concurrently, see
+     * set_concurrent_level_smoothing(). The resulting operator is symmetric
+     * if the post-smoother is the adjoint of the pre-smoother, so it can be
+     * used as a preconditioner of the conjugate gradient method, but it is
+     * a weaker solver than the V-cycle when used on its own.
+     *
+     * @note This cycle does not support edge matrices, i.e., it requires
+     * the levels to cover the whole domain or the matrix on the refinement
+     * edges to be part of the level matrices.
+     */
+    additive_cycle
   };
 
   using vector_type       = VectorType;
@@ -287,6 +304,24 @@ public:
    */
   void set_cycle(Cycle);
 
+  /**
+   * Select whether the smoothing on the individual levels and the coarse
+   * grid solve of the additive cycle are run concurrently as tasks (see
+   * Threads::TaskGroup) or one after another, which is the default. Since
+   * the levels are independent, running them concurrently keeps the cores
+   * busy on the coarse levels, where the work per level is small.
+   *
+   * @note Concurrent smoothing requires the smoothers, the level matrices,
+   * and the coarse grid solver to be safe to call from several threads at
+   * once on different levels. In particular, the communication of
+   * distributed vectors on different levels needs MPI to be initialized
+   * with support for concurrent calls (MPI_THREAD_MULTIPLE), which is not
+   * the default in Utilities::MPI::MPI_InitFinalize. The slots connected to
+   * the smoother and coarse solve signals are also called concurrently.
+   */
+  void
+  set_concurrent_level_smoothing(const bool concurrent);
+
   /**
    * Connect a function to mg::Signals::coarse_solve.
    */
@@ -347,11 +382,33 @@ private:
   void
   level_step(const unsigned int level, Cycle cycle);
 
+  /**
+   * The additive multigrid method. The defect is first restricted from the
+   * finest level to all coarser levels, then the smoothers and the coarse
+   * grid solver are applied on each level independently, and finally the
+   * corrections are prolongated from the coarsest to the finest level and
+   * added up.
+   */
+  void
+  additive_step();
+
+  /**
+   * Smoothing on a single level (or coarse grid solve on #minlevel) as part
+   * of the additive cycle.
+   */
+  void
+  additive_level_smoothing(const unsigned int level);
+
   /**
    * Cycle type performed by the method cycle().
    */
   Cycle cycle_type;
 
+  /**
+   * Whether the levels of the additive cycle are processed concurrently.
+   */
+  bool concurrent_level_smoothing;
+
   /**
    * Level for coarse grid solution.
    */
@@ -615,6 +672,7 @@ Multigrid<VectorType>::Multigrid(const MGMatrixBase<VectorType> &    matrix,
                                  const unsigned int                max_level,
                                  Cycle                             cycle)
   : cycle_type(cycle)
+  , concurrent_level_smoothing(false)
   , matrix(&matrix, typeid(*this).name())
   , coarse(&coarse, typeid(*this).name())
   , transfer(&transfer, typeid(*this).name())
@@ -658,6 +716,38 @@ namespace internal
 {
   namespace PreconditionMGImplementation
   {
+    /**
+     * Copy the result of the multigrid cycle into @p dst, exchanging the
+     * storage of the finest level instead of copying if the transfer
+     * supports it (through a function swap_from_mg()). The multigrid
+     * solution vectors are not needed after the cycle, so this is safe.
+     */
+    template <int dim, typename VectorType, class TRANSFER>
+    auto
+    copy_or_swap_from_mg(const dealii::DoFHandler<dim> &dof_handler,
+                         dealii::Multigrid<VectorType> &multigrid,
+                         const TRANSFER &               transfer,
+                         VectorType &                   dst,
+                         int)
+      -> decltype(transfer.swap_from_mg(dof_handler, dst, multigrid.solution))
+    {
+      transfer.swap_from_mg(dof_handler, dst, multigrid.solution);
+    }
+
+    template <int dim,
+              typename VectorType,
+              class TRANSFER,
+              typename OtherVectorType>
+    void
+    copy_or_swap_from_mg(const dealii::DoFHandler<dim> &dof_handler,
+                         dealii::Multigrid<VectorType> &multigrid,
+                         const TRANSFER &               transfer,
+                         OtherVectorType &              dst,
+                         ...)
+    {
+      transfer.copy_from_mg(dof_handler, dst, multigrid.solution);
+    }
+
     template <int dim,
               typename VectorType,
               class TRANSFER,
@@ -686,7 +776,8 @@ namespace internal
       if (uses_dof_handler_vector)
         transfer.copy_from_mg(dof_handler_vector, dst, multigrid.solution);
       else
-        transfer.copy_from_mg(*dof_handler_vector[0], dst, multigrid.solution);
+        copy_or_swap_from_mg(
+          *dof_handler_vector[0], multigrid, transfer, dst, 0);
       signals.transfer_to_global(false);
     }
 
@@ -715,7 +806,7 @@ namespace internal
       multigrid.cycle();
 
       signals.transfer_to_global(true);
-      transfer.copy_from_mg(*dof_handler_vector[0], dst, multigrid.solution);
+      copy_or_swap_from_mg(*dof_handler_vector[0], multigrid, transfer, dst, 0);
       signals.transfer_to_global(false);
     }
 
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/multigrid/multigrid.h>
 
@@ -74,6 +75,15 @@ Multigrid<VectorType>::set_cycle(typename Multigrid<VectorType>::Cycle c)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::set_concurrent_level_smoothing(const bool concurrent)
+{
+  concurrent_level_smoothing = concurrent;
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::set_edge_matrices(const MGMatrixBase<VectorType> &down,
@@ -246,6 +256,75 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
 
 
 
+template <typename VectorType>
+void
+Multigrid<VectorType>::additive_level_smoothing(const unsigned int level)
+{
+  if (level == minlevel)
+    {
+      this->signals.coarse_solve(true, level);
+      (*coarse)(level, solution[level], defect[level]);
+      this->signals.coarse_solve(false, level);
+      return;
+    }
+
+  this->signals.pre_smoother_step(true, level);
+  pre_smooth->apply(level, solution[level], defect[level]);
+  this->signals.pre_smoother_step(false, level);
+
+  this->signals.post_smoother_step(true, level);
+  post_smooth->smooth(level, solution[level], defect[level]);
+  this->signals.post_smoother_step(false, level);
+}
+
+
+
+template <typename VectorType>
+void
+Multigrid<VectorType>::additive_step()
+{
+  Assert(edge_out == nullptr && edge_in == nullptr && edge_down == nullptr &&
+           edge_up == nullptr,
+         ExcMessage("The additive cycle does not support edge matrices."));
+
+  // Restrict the defect to all levels. In contrast to the V-cycle, no
+  // residual is computed in between, so the defect on each level is the
+  // restriction of the defect on the next finer level, plus the part of the
+  // defect that lives on that level from copy_to_mg.
+  for (unsigned int level = maxlevel; level > minlevel; --level)
+    {
+      this->signals.restriction(true, level);
+      transfer->restrict_and_add(level, defect[level - 1], defect[level]);
+      this->signals.restriction(false, level);
+    }
+
+  // The smoothing on the levels is independent, so it can be done in any
+  // order or concurrently
+  if (concurrent_level_smoothing)
+    {
+      Threads::TaskGroup<> tasks;
+      for (unsigned int level = minlevel; level <= maxlevel; ++level)
+        tasks += Threads::new_task(
+          [this, level]() { this->additive_level_smoothing(level); });
+      tasks.join_all();
+    }
+  else
+    for (unsigned int level = minlevel; level <= maxlevel; ++level)
+      additive_level_smoothing(level);
+
+  // Sum up the corrections, starting from the coarsest level
+  for (unsigned int level = minlevel + 1; level <= maxlevel; ++level)
+    {
+      this->signals.prolongation(true, level);
+      transfer->prolongate_and_add(level,
+                                   solution[level],
+                                   solution[level - 1]);
+      this->signals.prolongation(false, level);
+    }
+}
+
+
+
 template <typename VectorType>
 void
 Multigrid<VectorType>::cycle()
@@ -257,7 +336,8 @@ Multigrid<VectorType>::cycle()
       solution.resize(minlevel, maxlevel);
       t.resize(minlevel, maxlevel);
     }
-  if (cycle_type != v_cycle &&
+  const bool needs_defect2 = cycle_type == w_cycle || cycle_type == f_cycle;
+  if (needs_defect2 &&
       (defect2.min_level() != minlevel || defect2.max_level() != maxlevel))
     defect2.resize(minlevel, maxlevel);
 
@@ -268,12 +348,14 @@ Multigrid<VectorType>::cycle()
       // method of the smoother -> do not force them to be zeroed out here
       solution[level].reinit(defect[level], level > minlevel);
       t[level].reinit(defect[level], level > minlevel);
-      if (cycle_type != v_cycle)
+      if (needs_defect2)
         defect2[level].reinit(defect[level]);
     }
 
   if (cycle_type == v_cycle)
     level_v_step(maxlevel);
+  else if (cycle_type == additive_cycle)
+    additive_step();
   else
     level_step(maxlevel, cycle_type);
 }
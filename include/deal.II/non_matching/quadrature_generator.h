@@ -0,0 +1,460 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_non_matching_quadrature_generator_h
+#define dealii_non_matching_quadrature_generator_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/non_matching/immersed_surface_quadrature.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  /**
+   * The location of a cell, or a part of it, relative to the zero contour of
+   * a level set function $\psi$. The region where $\psi < 0$ is called
+   * inside, and the region where $\psi > 0$ is called outside.
+   */
+  enum class LocationToLevelSet
+  {
+    /**
+     * The level set function is negative on the whole cell.
+     */
+    inside,
+    /**
+     * The level set function is positive on the whole cell.
+     */
+    outside,
+    /**
+     * The zero contour of the level set function intersects the cell.
+     */
+    intersected
+  };
+
+
+
+  /**
+   * A class that creates quadrature formulas for the regions of a box that
+   * are cut by the zero contour of a level set function $\psi$: a formula
+   * for the region where $\psi < 0$ (inside), one for the region where
+   * $\psi > 0$ (outside), and an ImmersedSurfaceQuadrature for the zero
+   * contour $\psi = 0$ itself.
+   *
+   * The formulas are built from a given one-dimensional quadrature formula on
+   * $[0,1]$ in the spirit of the algorithm by Saye (SIAM J. Sci. Comput.,
+   * 2015): The level set function is first sampled on a grid of points in
+   * the box. If it does not change its sign, the box is entirely inside or
+   * outside, and the tensor product of the one-dimensional formula is used.
+   * Otherwise, the coordinate direction $h$ in which the derivative of
+   * $\psi$ is largest is chosen as height direction. If the derivative in
+   * this direction does not change its sign in the box, the zero contour is
+   * the graph of a function over the other coordinate directions. Then the
+   * tensor product of the one-dimensional formula is used in the other
+   * directions, and along the line in direction $h$ through each of these
+   * points, the roots of $\psi$ are found by bracketing and regula falsi
+   * iterations. The one-dimensional formula is then used on each of the
+   * intervals between the roots, and the roots themselves become the points
+   * of the surface quadrature. If the derivative in the height direction
+   * does change its sign, the box is split into $2^\text{dim}$ boxes that
+   * are treated recursively, up to a maximal number of splits.
+   *
+   * The resulting formulas are of the order of the one-dimensional formula
+   * where the zero contour leaves the box through the faces parallel to the
+   * height direction. Where it leaves through one of the two faces
+   * orthogonal to the height direction, the integrand of the outer
+   * quadrature has a kink, and the order is reduced. Splitting the box
+   * reduces the error of such boxes.
+   *
+   * The surface normals point from the inside to the outside region, i.e.,
+   * they are given by $\nabla \psi / |\nabla \psi|$.
+   *
+   * @note The sign of the level set function is only tested on a grid of
+   * points, so features of the zero contour that are smaller than the
+   * spacing of this grid may be missed.
+   */
+  template <int dim>
+  class QuadratureGenerator
+  {
+  public:
+    /**
+     * Parameters of the algorithm.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(const unsigned int max_box_splits      = 4,
+                     const double       root_tolerance      = 1e-12,
+                     const unsigned int max_root_iterations = 50);
+
+      /**
+       * The maximal number of times a box is split into smaller boxes if
+       * the zero contour is not the graph of a function over one of its
+       * faces.
+       */
+      unsigned int max_box_splits;
+
+      /**
+       * The tolerance for the location of a root along a line, relative to
+       * the side length of the box.
+       */
+      double root_tolerance;
+
+      /**
+       * The maximal number of iterations to locate a root along a line.
+       */
+      unsigned int max_root_iterations;
+    };
+
+    /**
+     * Constructor. @p quadrature_1D is the quadrature formula on $[0,1]$
+     * from which all formulas are built.
+     */
+    QuadratureGenerator(
+      const Quadrature<1> & quadrature_1D,
+      const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Create the quadrature formulas for the regions of @p box defined by
+     * the scalar function @p level_set, which has to implement both the
+     * value and the gradient.
+     */
+    void
+    generate(const Function<dim> &level_set, const BoundingBox<dim> &box);
+
+    /**
+     * Return the quadrature formula for the region $\psi < 0$ computed by
+     * the last call to generate().
+     */
+    const Quadrature<dim> &
+    get_inside_quadrature() const;
+
+    /**
+     * Return the quadrature formula for the region $\psi > 0$ computed by
+     * the last call to generate().
+     */
+    const Quadrature<dim> &
+    get_outside_quadrature() const;
+
+    /**
+     * Return the quadrature formula for the zero contour $\psi = 0$ computed
+     * by the last call to generate().
+     */
+    const ImmersedSurfaceQuadrature<dim> &
+    get_surface_quadrature() const;
+
+  private:
+    /**
+     * Add the quadrature points of @p box to the vectors of points and
+     * weights, either recursively or using generate_on_graph_box().
+     */
+    void
+    generate_on_box(const Function<dim> &   level_set,
+                    const BoundingBox<dim> &box,
+                    const unsigned int      n_splits);
+
+    /**
+     * Add the quadrature points of @p box, in which the zero contour is the
+     * graph of a function over the directions other than
+     * @p height_direction.
+     */
+    void
+    generate_on_graph_box(const Function<dim> &   level_set,
+                          const BoundingBox<dim> &box,
+                          const unsigned int      height_direction);
+
+    /**
+     * Add the tensor product points of @p box to @p points and @p weights.
+     */
+    void
+    add_tensor_product_points(const BoundingBox<dim> & box,
+                              std::vector<Point<dim>> &points,
+                              std::vector<double> &    weights) const;
+
+    /**
+     * Find the roots of @p level_set in the interior of the line through
+     * @p point in direction @p height_direction between @p lower and
+     * @p upper, and write them in ascending order into @p roots.
+     */
+    void
+    find_roots(const Function<dim> &level_set,
+               const Point<dim> &   point,
+               const unsigned int   height_direction,
+               const double         lower,
+               const double         upper,
+               std::vector<double> &roots) const;
+
+    /**
+     * The one-dimensional quadrature formula on $[0,1]$.
+     */
+    const Quadrature<1> quadrature_1D;
+
+    /**
+     * The parameters of the algorithm.
+     */
+    const AdditionalData additional_data;
+
+    /**
+     * The points and weights collected during the last call to generate().
+     */
+    std::vector<Point<dim>>     inside_points;
+    std::vector<double>         inside_weights;
+    std::vector<Point<dim>>     outside_points;
+    std::vector<double>         outside_weights;
+    std::vector<Point<dim>>     surface_points;
+    std::vector<double>         surface_weights;
+    std::vector<Tensor<1, dim>> surface_normals;
+
+    /**
+     * The quadrature formulas computed by the last call to generate().
+     */
+    Quadrature<dim>                inside_quadrature;
+    Quadrature<dim>                outside_quadrature;
+    ImmersedSurfaceQuadrature<dim> surface_quadrature;
+  };
+
+
+
+  /**
+   * A class that creates and stores the quadrature formulas of
+   * QuadratureGenerator for the cells of a mesh, where the level set
+   * function is given as a finite element function, i.e., by a DoFHandler
+   * with a scalar finite element and a vector of nodal values.
+   *
+   * The formulas are computed on the reference cell, from the expansion of
+   * the local values of the level set function in the shape functions of the
+   * finite element, and are therefore directly usable with FEValues objects
+   * (and, for the surface formula, with the normals transformed as described
+   * in ImmersedSurfaceQuadrature). The formulas of a cell are computed once
+   * and reused until reinit() is called again with a new level set
+   * function. They can either be computed for one cell at a time with
+   * generate(), or for all cells at once, and in parallel, with
+   * update_quadratures():
+   * @code
+   * NonMatching::DiscreteQuadratureGenerator<dim> generator(QGauss<1>(4));
+   * generator.reinit(level_set_dof_handler, level_set);
+   * generator.update_quadratures();
+   *
+   * for (const auto &cell : dof_handler.active_cell_iterators())
+   *   if (generator.location_to_level_set(cell) !=
+   *       NonMatching::LocationToLevelSet::outside)
+   *     {
+   *       FEValues<dim> fe_values(fe,
+   *                               generator.get_inside_quadrature(cell),
+   *                               update_values | update_JxW_values);
+   *       fe_values.reinit(cell);
+   *       ...
+   *     }
+   * @endcode
+   *
+   * The level set function has to be defined on all cells that are not
+   * artificial, so vectors of a parallel computation have to contain the
+   * values of the ghost entries.
+   */
+  template <int dim>
+  class DiscreteQuadratureGenerator
+  {
+  public:
+    using AdditionalData = typename QuadratureGenerator<dim>::AdditionalData;
+
+    /**
+     * Constructor. The arguments are passed on to the QuadratureGenerator
+     * objects used for the cells.
+     */
+    DiscreteQuadratureGenerator(
+      const Quadrature<1> & quadrature_1D,
+      const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Set the level set function to the finite element function given by
+     * @p dof_handler and @p level_set, and discard all formulas computed
+     * before. The local values of the level set function are copied, so
+     * @p level_set may change afterwards without affecting this object.
+     */
+    template <typename VectorType>
+    void
+    reinit(const DoFHandler<dim> &dof_handler, const VectorType &level_set);
+
+    /**
+     * Compute the quadrature formulas of @p cell, unless they have been
+     * computed already.
+     */
+    void
+    generate(const typename Triangulation<dim>::active_cell_iterator &cell);
+
+    /**
+     * Compute the quadrature formulas of all cells that are not artificial
+     * and for which they have not been computed yet, processing the cells
+     * in parallel.
+     */
+    void
+    update_quadratures();
+
+    /**
+     * Return the location of @p cell relative to the zero contour of the
+     * level set function. The quadrature formulas of @p cell have to be
+     * computed already.
+     */
+    LocationToLevelSet
+    location_to_level_set(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature formula for the region of @p cell where the level
+     * set function is negative. The quadrature formulas of @p cell have to be
+     * computed already.
+     */
+    const Quadrature<dim> &
+    get_inside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature formula for the region of @p cell where the level
+     * set function is positive. The quadrature formulas of @p cell have to be
+     * computed already.
+     */
+    const Quadrature<dim> &
+    get_outside_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * Return the quadrature formula for the zero contour of the level set
+     * function in @p cell. The quadrature formulas of @p cell have to be
+     * computed already.
+     */
+    const ImmersedSurfaceQuadrature<dim> &
+    get_surface_quadrature(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+  private:
+    /**
+     * The quadrature formulas of a cell.
+     */
+    struct CellQuadratures
+    {
+      Quadrature<dim>                inside;
+      Quadrature<dim>                outside;
+      ImmersedSurfaceQuadrature<dim> surface;
+    };
+
+    /**
+     * Compute the quadrature formulas of the cell with the given active cell
+     * index using @p generator.
+     */
+    void
+    generate_cell(const unsigned int        active_cell_index,
+                  QuadratureGenerator<dim> &generator);
+
+    /**
+     * Return the quadrature formulas of @p cell, which have to be computed
+     * already.
+     */
+    const CellQuadratures &
+    get_cell_quadratures(
+      const typename Triangulation<dim>::active_cell_iterator &cell) const;
+
+    /**
+     * The one-dimensional quadrature formula on $[0,1]$.
+     */
+    const Quadrature<1> quadrature_1D;
+
+    /**
+     * The parameters of the algorithm.
+     */
+    const AdditionalData additional_data;
+
+    /**
+     * The finite element of the level set function.
+     */
+    SmartPointer<const FiniteElement<dim>> fe;
+
+    /**
+     * The local values of the level set function, indexed by the active cell
+     * index. The vectors of artificial cells are empty.
+     */
+    std::vector<std::vector<double>> local_level_set_values;
+
+    /**
+     * The quadrature formulas, indexed by the active cell index.
+     */
+    std::vector<CellQuadratures> cell_quadratures;
+
+    /**
+     * Whether the quadrature formulas of a cell have been computed, indexed
+     * by the active cell index. This is not a <tt>std::vector@<bool@></tt>,
+     * since entries are written concurrently by update_quadratures().
+     */
+    std::vector<unsigned char> is_generated;
+  };
+
+
+
+#ifndef DOXYGEN
+  template <int dim>
+  template <typename VectorType>
+  void
+  DiscreteQuadratureGenerator<dim>::reinit(const DoFHandler<dim> &dof_handler,
+                                           const VectorType &     level_set)
+  {
+    AssertDimension(level_set.size(), dof_handler.n_dofs());
+    Assert(dof_handler.get_fe().n_components() == 1,
+           ExcMessage("The level set function has to be scalar."));
+    Assert(dof_handler.get_fe().reference_cell() ==
+             ReferenceCells::get_hypercube<dim>(),
+           ExcNotImplemented());
+
+    fe = &dof_handler.get_fe();
+
+    const unsigned int n_cells =
+      dof_handler.get_triangulation().n_active_cells();
+    local_level_set_values.assign(n_cells, std::vector<double>());
+    cell_quadratures.clear();
+    cell_quadratures.resize(n_cells);
+    is_generated.assign(n_cells, 0);
+
+    Vector<typename VectorType::value_type> local_values(
+      fe->n_dofs_per_cell());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (!cell->is_artificial())
+        {
+          cell->get_dof_values(level_set, local_values);
+          local_level_set_values[cell->active_cell_index()].assign(
+            local_values.begin(), local_values.end());
+        }
+  }
+#endif
+
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -332,6 +332,59 @@ public:
     const unsigned int     n_subdivisions = 0,
     const CurvedCellRegion curved_region  = curved_boundary);
 
+  /**
+   * A variation of build_patches() for output that is too large to be held
+   * in memory as a whole. Rather than building the patches of all selected
+   * cells at once, this function builds them in chunks of at most
+   * @p max_patches_per_chunk patches. After each chunk has been built, it
+   * calls @p patch_sink with the number of the chunk (counting from zero).
+   * During this call, the patches of the current chunk are the ones stored
+   * in this object, so the sink can call any of the write functions of the
+   * base class DataOutInterface, for example to write each chunk into a
+   * separate VTU file that is then referenced from a .pvtu record, or to
+   * append it to an already opened stream. Once the sink returns, the
+   * patches of the chunk are released again, so the memory used by the
+   * patches never exceeds the one of a single chunk.
+   *
+   * Within each chunk, patches are numbered from zero and the neighbor
+   * information only refers to patches of the same chunk; neighbors in
+   * other chunks are marked as not existing. The construction of the
+   * patches of one chunk runs in parallel in the same way as in
+   * build_patches().
+   *
+   * After this function returns, this object does not store any patches.
+   * If there are no cells selected for output, @p patch_sink is not called.
+   *
+   * @code
+   *   data_out.build_patches_in_chunks(
+   *     mapping, 4, 100000, [&](const unsigned int chunk) {
+   *       std::ofstream out("solution-" + Utilities::int_to_string(chunk, 4) +
+   *                         ".vtu");
+   *       data_out.write_vtu(out);
+   *     });
+   * @endcode
+   */
+  void
+  build_patches_in_chunks(
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &                                            mapping,
+    const unsigned int                             n_subdivisions,
+    const unsigned int                             max_patches_per_chunk,
+    const std::function<void(const unsigned int)> &patch_sink,
+    const CurvedCellRegion curved_region = curved_boundary);
+
+  /**
+   * Same as above, but for hp::MappingCollection.
+   */
+  void
+  build_patches_in_chunks(
+    const hp::MappingCollection<DoFHandlerType::dimension,
+                                DoFHandlerType::space_dimension> &mapping,
+    const unsigned int                             n_subdivisions,
+    const unsigned int                             max_patches_per_chunk,
+    const std::function<void(const unsigned int)> &patch_sink,
+    const CurvedCellRegion curved_region = curved_boundary);
+
   /**
    * A function that allows selecting for which cells output should be
    * generated. This function takes two arguments, both `std::function`
@@ -506,6 +559,10 @@ private:
    * WorkStream::run(). The function does not take a CopyData object but
    * rather allocates one on its own stack for memory access efficiency
    * reasons.
+   *
+   * The patch is stored in the patches array at its global patch index
+   * minus @p first_patch_index, i.e., the index of the first patch of the
+   * chunk currently being built.
    */
   void
   build_one_patch(const std::pair<cell_iterator, unsigned int> *cell_and_index,
@@ -513,7 +570,8 @@ private:
                     DoFHandlerType::dimension,
                     DoFHandlerType::space_dimension> &scratch_data,
                   const unsigned int                  n_subdivisions,
-                  const CurvedCellRegion              curved_cell_region);
+                  const CurvedCellRegion              curved_cell_region,
+                  const unsigned int                  first_patch_index);
 };
 
 namespace Legacy
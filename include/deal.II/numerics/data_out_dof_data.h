@@ -434,6 +434,13 @@ namespace internal
       DataPostprocessorInputs::Vector<spacedim>        patch_values_system;
       std::vector<std::vector<dealii::Vector<double>>> postprocessed_values;
 
+      /**
+       * Input and output of postprocessors that support batched evaluation,
+       * see DataPostprocessor::evaluate_vector_field_batch().
+       */
+      DataPostprocessorInputs::VectorBatch<spacedim> patch_values_batch;
+      Table<2, double>                               postprocessed_values_batch;
+
       const dealii::hp::MappingCollection<dim, spacedim> mapping_collection;
       const std::vector<
         std::shared_ptr<dealii::hp::FECollection<dim, spacedim>>>
@@ -431,6 +431,8 @@ namespace internal
       , patch_values_scalar(data.patch_values_scalar)
       , patch_values_system(data.patch_values_system)
       , postprocessed_values(data.postprocessed_values)
+      , patch_values_batch(data.patch_values_batch)
+      , postprocessed_values_batch(data.postprocessed_values_batch)
       , mapping_collection(data.mapping_collection)
       , finite_elements(data.finite_elements)
       , update_flags(data.update_flags)
@@ -0,0 +1,192 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_data_out_xdmf_time_series_h
+#define dealii_data_out_xdmf_time_series_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A class that writes the output of a time dependent simulation as a series
+ * of HDF5 files, together with an XDMF file that describes the whole series.
+ *
+ * The functions DataOutInterface::write_hdf5_parallel() and
+ * DataOutInterface::create_xdmf_entry() already allow writing the mesh and
+ * the solution of a snapshot to separate files. This class adds the
+ * bookkeeping for time series on top of that: It keeps track of whether the
+ * mesh has changed since it was last written, by listening to the
+ * Triangulation::Signals::any_change and Triangulation::Signals::mesh_movement
+ * signals of the triangulation. As long as it has not changed, every new
+ * snapshot only writes the solution datasets to a new file, while the XDMF
+ * entry of the snapshot refers to the geometry datasets of the last mesh
+ * file that was written. For long transient simulations on a fixed mesh,
+ * this removes the repeated output of nodes and cells.
+ *
+ * A typical use looks as follows:
+ * @code
+ *   DataOutXDMFTimeSeries<dim> time_series(triangulation,
+ *                                          "output/",
+ *                                          "solution",
+ *                                          MPI_COMM_WORLD);
+ *   ...
+ *   for (; time < end_time; time += time_step)
+ *     {
+ *       ...
+ *       DataOut<dim> data_out;
+ *       data_out.attach_dof_handler(dof_handler);
+ *       data_out.add_data_vector(solution, "u");
+ *       data_out.build_patches();
+ *       time_series.write_time_step(data_out, time);
+ *     }
+ * @endcode
+ * This writes the files <tt>solution_mesh_0000.h5</tt> (and further mesh
+ * files whenever the mesh changes), <tt>solution_0000.h5</tt>,
+ * <tt>solution_0001.h5</tt>, etc. for the solution, and updates
+ * <tt>solution.xdmf</tt> after every time step.
+ *
+ * Changes to the geometry of the output that the triangulation does not
+ * know about, for example a different Mapping, a different number of
+ * subdivisions in DataOut::build_patches(), or vertices moved by hand, can
+ * not be detected through the signals. Call mark_mesh_changed() in these
+ * cases. As a safety net, the mesh is also written again whenever the
+ * number of nodes or cells of the output differs from the one of the last
+ * mesh file.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim = dim>
+class DataOutXDMFTimeSeries
+{
+public:
+  /**
+   * Constructor. All files are written to @p directory, and their names
+   * start with @p filename_without_extension. The XDMF file refers to the
+   * HDF5 files relative to @p directory, so it can be moved together with
+   * them. @p directory has to contain a trailing "/" if it is not empty.
+   * @p flags determines the filtering of duplicate vertices and the
+   * chunking and compression of the HDF5 datasets.
+   */
+  DataOutXDMFTimeSeries(
+    const Triangulation<dim, spacedim> &   triangulation,
+    const std::string &                    directory,
+    const std::string &                    filename_without_extension,
+    const MPI_Comm &                       comm,
+    const DataOutBase::DataOutFilterFlags &flags =
+      DataOutBase::DataOutFilterFlags(true, true));
+
+  /**
+   * Destructor. Disconnects from the signals of the triangulation.
+   */
+  ~DataOutXDMFTimeSeries();
+
+  /**
+   * Write the patches of @p data_out as the snapshot at time @p time. The
+   * mesh is only written if it changed since the last call (or if this is
+   * the first call), otherwise only the solution datasets are written.
+   * Afterwards, the XDMF file is rewritten with the entries of all
+   * snapshots so far, so that it is always valid, even if the simulation
+   * is interrupted.
+   *
+   * This is a collective operation on the communicator given to the
+   * constructor.
+   */
+  void
+  write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                  const double                           time);
+
+  /**
+   * Make sure the mesh is written again with the next snapshot. This is
+   * needed for changes of the output geometry that are not signaled by the
+   * triangulation.
+   */
+  void
+  mark_mesh_changed();
+
+  /**
+   * Return the XDMF entries of all snapshots written so far.
+   */
+  const std::vector<XDMFEntry> &
+  get_xdmf_entries() const;
+
+private:
+  /**
+   * The triangulation whose signals we listen to.
+   */
+  SmartPointer<const Triangulation<dim, spacedim>> triangulation;
+
+  /**
+   * The directory and the common beginning of the names of all files.
+   */
+  const std::string directory;
+  const std::string filename_without_extension;
+
+  /**
+   * The communicator used for output.
+   */
+  const MPI_Comm comm;
+
+  /**
+   * The flags used for filtering the data and writing the datasets.
+   */
+  const DataOutBase::DataOutFilterFlags flags;
+
+  /**
+   * Whether the mesh needs to be written with the next snapshot.
+   */
+  bool mesh_changed;
+
+  /**
+   * The number of mesh files and of snapshots written so far.
+   */
+  unsigned int n_mesh_files;
+  unsigned int n_time_steps;
+
+  /**
+   * The name of the last mesh file written, relative to the output
+   * directory, and the global number of nodes and cells in it.
+   */
+  std::string             mesh_filename;
+  types::global_dof_index n_mesh_nodes;
+  types::global_dof_index n_mesh_cells;
+
+  /**
+   * The XDMF entries of all snapshots written so far.
+   */
+  std::vector<XDMFEntry> xdmf_entries;
+
+  /**
+   * The connections to the signals of the triangulation.
+   */
+  std::vector<boost::signals2::connection> tria_listeners;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/dofs/dof_handler.h>
@@ -386,6 +387,123 @@ namespace DataPostprocessorInputs
     std::vector<std::vector<Tensor<2, spacedim>>> solution_hessians;
   };
 
+
+
+  /**
+   * A structure that is used to pass information to
+   * DataPostprocessor::evaluate_vector_field_batch(). It contains the same
+   * information as the Vector class, but stores the values, gradients, and
+   * second derivatives of all components in contiguous arrays in which the
+   * index of the evaluation point runs fastest ("structure of arrays").
+   * Compared to the nested vectors of tensors of the Vector class, this
+   * allows postprocessors to run simple loops over all evaluation points
+   * of one component or one derivative, which the compiler can vectorize.
+   *
+   * The value of component $c$ at evaluation point $q$ is stored at
+   * position <code>c * n_points + q</code> of solution_values, derivative
+   * $d$ of it at position <code>(c * spacedim + d) * n_points + q</code>
+   * of solution_gradients, and the second derivative $(d,e)$ at position
+   * <code>((c * spacedim + d) * spacedim + e) * n_points + q</code> of
+   * solution_hessians. The functions get_values(), get_gradients(), and
+   * get_hessians() return pointers to the start of these contiguous
+   * ranges. As for the Vector class, the arrays of complex-valued solutions
+   * first contain all real parts and then all imaginary parts.
+   */
+  template <int spacedim>
+  struct VectorBatch : public CommonInputs<spacedim>
+  {
+    /**
+     * Set the sizes of the arrays for @p n_components components at
+     * @p n_points evaluation points. Only the arrays for which
+     * @p update_flags contains update_values, update_gradients, or
+     * update_hessians are allocated.
+     */
+    void
+    reinit(const unsigned int n_components,
+           const unsigned int n_points,
+           const UpdateFlags  update_flags);
+
+    /**
+     * Fill this object from the data of a scalar field, as one component.
+     * Only the fields selected by @p update_flags are copied.
+     */
+    void
+    copy_from(const Scalar<spacedim> &input, const UpdateFlags update_flags);
+
+    /**
+     * Fill this object from the data of a vector field. Only the fields
+     * selected by @p update_flags are copied.
+     */
+    void
+    copy_from(const Vector<spacedim> &input, const UpdateFlags update_flags);
+
+    /**
+     * Return a pointer to the values of component @p component at all
+     * evaluation points.
+     */
+    const double *
+    get_values(const unsigned int component) const;
+
+    /**
+     * Return a pointer to the derivative in direction @p d of component
+     * @p component at all evaluation points.
+     */
+    const double *
+    get_gradients(const unsigned int component, const unsigned int d) const;
+
+    /**
+     * Return a pointer to the second derivative in directions @p d and
+     * @p e of component @p component at all evaluation points.
+     */
+    const double *
+    get_hessians(const unsigned int component,
+                 const unsigned int d,
+                 const unsigned int e) const;
+
+    /**
+     * The number of solution components.
+     */
+    unsigned int n_components = 0;
+
+    /**
+     * The number of evaluation points.
+     */
+    unsigned int n_points = 0;
+
+    /**
+     * The values of all components at all evaluation points, in the layout
+     * described in the documentation of this class.
+     *
+     * This array is only filled if a user-derived class overloads the
+     * DataPostprocessor::get_needed_update_flags(), and the function
+     * returns (possibly among other flags)
+     * UpdateFlags::update_values.
+     */
+    std::vector<double> solution_values;
+
+    /**
+     * The gradients of all components at all evaluation points, in the
+     * layout described in the documentation of this class.
+     *
+     * This array is only filled if a user-derived class overloads the
+     * DataPostprocessor::get_needed_update_flags(), and the function
+     * returns (possibly among other flags)
+     * UpdateFlags::update_gradients.
+     */
+    std::vector<double> solution_gradients;
+
+    /**
+     * The second derivatives of all components at all evaluation points, in
+     * the layout described in the documentation of this class.
+     *
+     * This array is only filled if a user-derived class overloads the
+     * DataPostprocessor::get_needed_update_flags(), and the function
+     * returns (possibly among other flags)
+     * UpdateFlags::update_hessians.
+     */
+    std::vector<double> solution_hessians;
+  };
+
 } // namespace DataPostprocessorInputs
 
 
@@ -564,6 +682,43 @@ public:
   evaluate_vector_field(const DataPostprocessorInputs::Vector<dim> &input_data,
                         std::vector<Vector<double>> &computed_quantities) const;
 
+  /**
+   * Same as the evaluate_vector_field() function, but with the input data
+   * passed as contiguous arrays over all evaluation points, see
+   * DataPostprocessorInputs::VectorBatch. The output @p computed_quantities
+   * has the same layout: it already has the size (number of computed
+   * quantities) times (number of evaluation points), and entry
+   * <code>(i, q)</code> is to be set to quantity $i$ at point $q$.
+   *
+   * DataOut calls this function instead of evaluate_scalar_field() and
+   * evaluate_vector_field() if supports_batched_evaluation() returns true.
+   * In that case, the number of input components is one for real-valued
+   * scalar fields.
+   *
+   * The default implementation copies the data into a
+   * DataPostprocessorInputs::Vector object and calls
+   * evaluate_vector_field().
+   */
+  virtual void
+  evaluate_vector_field_batch(
+    const DataPostprocessorInputs::VectorBatch<dim> &input_data,
+    Table<2, double> &                               computed_quantities) const;
+
+  /**
+   * Return whether this postprocessor implements
+   * evaluate_vector_field_batch(), and DataOut should use it. The default
+   * implementation returns false.
+   *
+   * Derived classes that return true here need not implement
+   * evaluate_scalar_field() and evaluate_vector_field(): Their default
+   * implementations then copy the data into a
+   * DataPostprocessorInputs::VectorBatch object and call
+   * evaluate_vector_field_batch(), which is what classes like DataOutFaces
+   * that do not use the batched interface rely on.
+   */
+  virtual bool
+  supports_batched_evaluation() const;
+
   /**
    * Return the vector of strings describing the names of the computed
    * quantities.
@@ -1263,6 +1418,48 @@ namespace DataPostprocessorInputs
     return boost::any_cast<typename DoFHandler<dim, spacedim>::cell_iterator>(
       cell);
   }
+
+
+
+  template <int spacedim>
+  inline const double *
+  VectorBatch<spacedim>::get_values(const unsigned int component) const
+  {
+    AssertIndexRange(component, n_components);
+    AssertDimension(solution_values.size(), n_components * n_points);
+    return solution_values.data() + component * n_points;
+  }
+
+
+
+  template <int spacedim>
+  inline const double *
+  VectorBatch<spacedim>::get_gradients(const unsigned int component,
+                                       const unsigned int d) const
+  {
+    AssertIndexRange(component, n_components);
+    AssertIndexRange(d, spacedim);
+    AssertDimension(solution_gradients.size(),
+                    n_components * spacedim * n_points);
+    return solution_gradients.data() + (component * spacedim + d) * n_points;
+  }
+
+
+
+  template <int spacedim>
+  inline const double *
+  VectorBatch<spacedim>::get_hessians(const unsigned int component,
+                                      const unsigned int d,
+                                      const unsigned int e) const
+  {
+    AssertIndexRange(component, n_components);
+    AssertIndexRange(d, spacedim);
+    AssertIndexRange(e, spacedim);
+    AssertDimension(solution_hessians.size(),
+                    n_components * spacedim * spacedim * n_points);
+    return solution_hessians.data() +
+           ((component * spacedim + d) * spacedim + e) * n_points;
+  }
 } // namespace DataPostprocessorInputs
 
 #endif
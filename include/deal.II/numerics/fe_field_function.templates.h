@@ -19,9 +19,12 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/fe/fe_point_evaluation.h>
 #include <deal.II/fe/fe_values.h>
 
 #include <deal.II/grid/grid_tools.h>
@@ -35,12 +38,142 @@
 #include <deal.II/numerics/fe_field_function.h>
 #include <deal.II/numerics/vector_tools_common.h>
 
+#include <memory>
 #include <tuple>
+#include <type_traits>
 
 
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace FEFieldFunctionImplementation
+  {
+    /**
+     * Evaluate the values and/or gradients of @p data_vector at the points
+     * given by @p unit_points in the reference coordinates of @p cells, as
+     * returned by GridTools::compute_point_locations(), and store them at
+     * the positions given by @p maps. The cells are processed in parallel
+     * and each of them is evaluated with one scalar FEPointEvaluation
+     * object per component, which is set up only once per finite element
+     * and thread. Either of @p values and @p gradients may be a null
+     * pointer.
+     *
+     * FEPointEvaluation works on real-valued data only, so this function
+     * returns false without doing anything for other number types, in
+     * which case the caller has to fall back to FEValues.
+     */
+    template <int dim, typename CellIterator, typename VectorType>
+    typename std::enable_if<
+      std::is_floating_point<typename VectorType::value_type>::value,
+      bool>::type
+    evaluate_at_unit_points(
+      const Mapping<dim> &                                  mapping,
+      const std::vector<CellIterator> &                     cells,
+      const std::vector<std::vector<Point<dim>>> &          unit_points,
+      const std::vector<std::vector<unsigned int>> &        maps,
+      const VectorType &                                    data_vector,
+      std::vector<Vector<typename VectorType::value_type>> *values,
+      std::vector<std::vector<Tensor<1, dim, typename VectorType::value_type>>>
+        *gradients)
+    {
+      using Number = typename VectorType::value_type;
+
+      if (cells.empty())
+        return true;
+
+      for (const auto &cell : cells)
+        AssertThrow(!cell->is_artificial(),
+                    VectorTools::ExcPointNotAvailableHere());
+
+      const hp::FECollection<dim> &fe_collection =
+        cells[0]->get_dof_handler().get_fe_collection();
+      const unsigned int n_components = fe_collection.n_components();
+
+      const EvaluationFlags::EvaluationFlags evaluation_flags =
+        (values != nullptr ? EvaluationFlags::values :
+                             EvaluationFlags::nothing) |
+        (gradients != nullptr ? EvaluationFlags::gradients :
+                                EvaluationFlags::nothing);
+
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          std::vector<std::unique_ptr<FEPointEvaluation<1, dim>>> evaluators(
+            fe_collection.size() * n_components);
+          Vector<Number>      local_values;
+          std::vector<double> local_values_double;
+
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              const auto &             cell     = cells[i];
+              const unsigned int       fe_index = cell->active_fe_index();
+              const FiniteElement<dim> &fe      = fe_collection[fe_index];
+
+              local_values.reinit(fe.n_dofs_per_cell());
+              cell->get_dof_values(data_vector, local_values);
+              local_values_double.assign(local_values.begin(),
+                                         local_values.end());
+
+              for (unsigned int c = 0; c < n_components; ++c)
+                {
+                  auto &evaluator = evaluators[fe_index * n_components + c];
+                  if (evaluator.get() == nullptr)
+                    evaluator =
+                      std::make_unique<FEPointEvaluation<1, dim>>(mapping,
+                                                                  fe,
+                                                                  c);
+
+                  evaluator->evaluate(
+                    cell,
+                    make_array_view(unit_points[i]),
+                    ArrayView<const double>(local_values_double.data(),
+                                            local_values_double.size()),
+                    evaluation_flags);
+
+                  for (unsigned int q = 0; q < unit_points[i].size(); ++q)
+                    {
+                      if (values != nullptr)
+                        (*values)[maps[i][q]](c) = evaluator->get_value(q);
+                      if (gradients != nullptr)
+                        {
+                          auto &gradient = (*gradients)[maps[i][q]];
+                          gradient.resize(n_components);
+                          gradient[c] = evaluator->get_gradient(q);
+                        }
+                    }
+                }
+            }
+        },
+        8);
+
+      return true;
+    }
+
+
+
+    template <int dim, typename CellIterator, typename VectorType>
+    typename std::enable_if<
+      !std::is_floating_point<typename VectorType::value_type>::value,
+      bool>::type
+    evaluate_at_unit_points(
+      const Mapping<dim> &,
+      const std::vector<CellIterator> &,
+      const std::vector<std::vector<Point<dim>>> &,
+      const std::vector<std::vector<unsigned int>> &,
+      const VectorType &,
+      std::vector<Vector<typename VectorType::value_type>> *,
+      std::vector<
+        std::vector<Tensor<1, dim, typename VectorType::value_type>>> *)
+    {
+      return false;
+    }
+  } // namespace FEFieldFunctionImplementation
+} // namespace internal
+
+
 namespace Functions
 {
   template <int dim, typename DoFHandlerType, typename VectorType>
@@ -276,6 +409,10 @@ namespace Functions
     const unsigned int n_cells =
       compute_point_locations(points, cells, qpoints, maps);
 
+    if (internal::FEFieldFunctionImplementation::evaluate_at_unit_points<dim>(
+          mapping, cells, qpoints, maps, data_vector, &values, nullptr))
+      return;
+
     // Create quadrature collection
     hp::QCollection<dim> quadrature_collection;
     for (unsigned int i = 0; i < n_cells; ++i)
@@ -356,6 +493,10 @@ namespace Functions
     const unsigned int n_cells =
       compute_point_locations(points, cells, qpoints, maps);
 
+    if (internal::FEFieldFunctionImplementation::evaluate_at_unit_points<dim>(
+          mapping, cells, qpoints, maps, data_vector, nullptr, &values))
+      return;
+
     // Create quadrature collection
     hp::QCollection<dim> quadrature_collection;
     for (unsigned int i = 0; i < n_cells; ++i)
@@ -528,6 +669,12 @@ namespace Functions
       cells[i++] = typename DoFHandlerType::cell_iterator(*c, dh);
     qpoints = std::get<1>(cell_qpoint_map);
     maps    = std::get<2>(cell_qpoint_map);
+
+    // start the search of the next batch of points, which is often close to
+    // the current one, from the last cell found
+    if (!cells.empty())
+      cell_hint.get() = cells.back();
+
     return cells.size();
   }
 
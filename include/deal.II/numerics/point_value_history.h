@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/smartpointer.h>
@@ -43,6 +44,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -116,11 +118,19 @@ namespace internal
  * point will most likely change slightly, making the interpretation of the
  * data difficult, hence this is not implemented currently.)
  *
- * <li> Secondly, @p evaluate_field_at_requested_location calls @p
- * VectorTools::point_value to compute values at the specific point requested.
- * This method is valid for any FE that is supported by @p
+ * <li> Secondly, @p evaluate_field_at_requested_location computes values at
+ * the specific points requested. If deal.II is configured with MPI, all
+ * points are evaluated together with a Utilities::MPI::RemotePointEvaluation
+ * object, which locates the points once and then evaluates them with
+ * FEPointEvaluation in a single exchange among the processes each time the
+ * function is called. Otherwise, @p VectorTools::point_value is called for
+ * each point. This method is valid for any FE that is supported by @p
  * VectorTools::point_value. Specifically, this method can be called by codes
- * using adaptive mesh refinement.
+ * using adaptive mesh refinement, and it is the only method that can be
+ * used on distributed triangulations. In the latter case, the values of all
+ * points are available on all processes. The requested points can be moved
+ * between evaluations with update_requested_locations(), e.g., for probes
+ * that follow a moving body.
  *
  * <li>Finally, the class offers a function @p evaluate_field that takes a @p
  * DataPostprocessor object. This method allows the deal.II data postprocessor
@@ -209,6 +219,12 @@ namespace internal
  * node_monitor.write_gnuplot("node"); // write out data files
  *
  * @endcode
+ *
+ * For long runs with many points, the data need not be kept in memory until
+ * the end of the computation: flush_to_hdf5() writes the data collected so
+ * far to an HDF5 file and removes it from memory, so it can be called
+ * periodically, e.g., every few hundred time steps, with a new file name
+ * each time.
  */
 template <int dim>
 class PointValueHistory
@@ -283,6 +299,19 @@ public:
   void
   add_points(const std::vector<Point<dim>> &locations);
 
+  /**
+   * Move the requested points to the new @p locations, e.g., for points
+   * attached to a moving body. @p locations has to contain one entry for
+   * each point added with add_point() or add_points(), in the same order.
+   * The data of the support points closest to the original points is not
+   * updated, so only evaluate_field_at_requested_location() should be used
+   * after the points have been moved. This method can be called while the
+   * class is closed. Points that are still in the same cell or in a
+   * neighbor of it are located without a global search.
+   */
+  void
+  update_requested_locations(const std::vector<Point<dim>> &locations);
+
 
 
   /**
@@ -437,6 +466,28 @@ public:
                 const std::vector<Point<dim>> &postprocessor_locations =
                   std::vector<Point<dim>>());
 
+  /**
+   * Write the datasets stored so far to the HDF5 file @p filename and
+   * remove them from memory, while the points, field names and component
+   * masks remain unchanged, so that new datasets can be added afterwards.
+   * The file contains the dataset "keys" with the keys of all datasets, the
+   * dataset "independent_values" with one row per independent value if
+   * independent values are used, and a group for each field name. Each of
+   * these groups contains the dataset "values" with one row per point and
+   * selected component, in the same order as used by write_gnuplot(), and
+   * one column per dataset, as well as the dataset "requested_locations"
+   * with the current coordinates of the points.
+   *
+   * If the DoFHandler is based on a parallel triangulation, only the first
+   * process of its communicator writes the file, but this function needs to
+   * be called on all processes.
+   *
+   * @note This function is only available if deal.II is configured with
+   * HDF5.
+   */
+  void
+  flush_to_hdf5(const std::string &filename);
+
 
   /**
    * Return a @p Vector with the indices of selected points flagged with a 1.
@@ -662,6 +713,15 @@ private:
    */
   unsigned int n_indep;
 
+  /**
+   * The object used to locate the requested points and to exchange the
+   * values computed at them in evaluate_field_at_requested_location(). It
+   * is set up the first time it is needed and again after the
+   * triangulation has changed.
+   */
+  std::shared_ptr<Utilities::MPI::RemotePointEvaluation<dim>>
+    remote_point_evaluation;
+
 
   /**
    * A function that will be triggered through signals whenever the
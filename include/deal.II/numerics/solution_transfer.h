@@ -29,6 +29,7 @@
 
 #  include <deal.II/lac/vector.h>
 
+#  include <limits>
 #  include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -224,16 +225,13 @@ DEAL_II_NAMESPACE_OPEN
  * <tt>vector<Vector<number> > all_in</tt> includes all discrete
  * functions to be interpolated onto the new grid.
  *
- * As we need two different kinds of pointers (<tt>vector<unsigned int> *</tt>
- * for the Dof indices and <tt>vector<Vector<number> > *</tt> for the
- * interpolated DoF values) we use the @p Pointerstruct that includes both of
- * these pointers and the pointer for each cell points to these @p
- * Pointerstructs. On each cell only one of the two different pointers is used
- * at one time hence we could use a <tt>void * pointer</tt> as
- * <tt>vector<unsigned int> *</tt> at one time and as
- * <tt>vector<Vector<number> > *</tt> at the other but using this @p
- * Pointerstruct in between makes the use of these pointers more safe and
- * gives better possibility to expand their usage.
+ * The DoF indices and the interpolated DoF values of all cells are stored
+ * contiguously in two flat arrays, and a @p CellData object for each cell,
+ * indexed by the level and the index of the cell, records where the data of
+ * this cell starts and which of the two arrays it refers to. Compared to
+ * storing a separate vector for each cell, this avoids many small memory
+ * allocations for meshes with many cells. The interpolation of the values
+ * to the father cells is done in parallel using multiple threads.
  *
  * In <tt>interpolate(all_in, all_out)</tt> the refined cells are treated
  * according to the solution transfer while pure refinement. Additionally, on
@@ -246,6 +244,14 @@ DEAL_II_NAMESPACE_OPEN
  * the parameter of the <tt>prepare_for_coarsening_and_refinement(all_in)</tt>
  * function. Hence <tt>interpolate(all_in, all_out)</tt> can (in contrast to
  * <tt>refine_interpolate(in, out)</tt>) only be called once.
+ *
+ * Both <tt>refine_interpolate(in,out)</tt> and
+ * <tt>interpolate(all_in, all_out)</tt> work on the cells in parallel using
+ * WorkStream: The local values of all vectors are read and prolongated to
+ * the active descendants of a cell by multiple threads, using the
+ * prolongation matrices of the finite element and interpolation matrices
+ * between the elements of an hp::FECollection that are computed only once,
+ * while the results are written into the output vectors sequentially.
  * </ul>
  *
  *
@@ -515,63 +521,87 @@ private:
   /**
    * Is used for @p prepare_for_refining (of course also for @p
    * repare_for_refining_and_coarsening) and stores all dof indices of the
-   * cells that'll be refined
+   * cells that'll be refined. The indices of all cells are stored one after
+   * the other, and the CellData object of a cell contains the position of
+   * its first index.
+   */
+  std::vector<types::global_dof_index> indices_on_cell;
+
+  /**
+   * Is used for @p prepare_for_refining_and_coarsening The interpolated dof
+   * values of all cells that'll be coarsened will be stored in this vector.
+   * For each cell, the values of all input vectors are stored one after the
+   * other, and the CellData object of a cell contains the position of its
+   * first value.
    */
-  std::vector<std::vector<types::global_dof_index>> indices_on_cell;
+  std::vector<typename VectorType::value_type> dof_values_on_cell;
+
+  /**
+   * The number of vectors whose values are stored in @p dof_values_on_cell.
+   */
+  unsigned int n_stored_vectors;
 
   /**
    * All cell data (the dof indices and the dof values) should be accessible
-   * from each cell. As each cell has got only one @p user_pointer, multiple
-   * pointers to the data need to be packetized in a structure. Note that in
-   * our case on each cell either the <tt>vector<unsigned int> indices</tt>
-   * (if the cell will be refined) or the <tt>vector<double> dof_values</tt>
-   * (if the children of this cell will be deleted) is needed, hence one @p
-   * user_pointer should be sufficient, but to allow some error checks and to
-   * preserve the user from making user errors the @p user_pointer will be
-   * 'multiplied' by this structure.
+   * from each cell. On each cell either the dof indices (if the cell will be
+   * refined or stays as it is) or the dof values (if the children of this
+   * cell will be deleted) are needed. This structure stores the position of
+   * the data of a cell in @p indices_on_cell or @p dof_values_on_cell,
+   * respectively, along with the FE index the data refers to.
    */
-  struct Pointerstruct
+  struct CellData
   {
-    Pointerstruct()
-      : indices_ptr(nullptr)
-      , dof_values_ptr(nullptr)
+    CellData()
+      : offset(std::numeric_limits<std::size_t>::max())
       , active_fe_index(0)
+      , has_dof_values(false)
     {}
-    Pointerstruct(std::vector<types::global_dof_index> *indices_ptr_in,
-                  const unsigned int                    active_fe_index_in = 0)
-      : indices_ptr(indices_ptr_in)
-      , dof_values_ptr(nullptr)
-      , active_fe_index(active_fe_index_in)
-    {}
-    Pointerstruct(
-      std::vector<Vector<typename VectorType::value_type>> *dof_values_ptr_in,
-      const unsigned int active_fe_index_in = 0)
-      : indices_ptr(nullptr)
-      , dof_values_ptr(dof_values_ptr_in)
+    CellData(const std::size_t  offset_in,
+             const unsigned int active_fe_index_in,
+             const bool         has_dof_values_in)
+      : offset(offset_in)
       , active_fe_index(active_fe_index_in)
+      , has_dof_values(has_dof_values_in)
     {}
     std::size_t
     memory_consumption() const;
 
-    std::vector<types::global_dof_index> *                indices_ptr;
-    std::vector<Vector<typename VectorType::value_type>> *dof_values_ptr;
-    unsigned int                                          active_fe_index;
+    std::size_t  offset;
+    unsigned int active_fe_index;
+    bool         has_dof_values;
   };
 
   /**
-   * Map mapping from level and index of cell to the @p Pointerstructs (cf.
-   * there). This map makes it possible to keep all the information needed to
-   * transfer the solution inside this object rather than using user pointers
-   * of the Triangulation for this purpose.
+   * The CellData objects of all cells, indexed by the level and the index of
+   * the cell. This makes it possible to keep all the information needed to
+   * transfer the solution inside this object rather than using user
+   * pointers of the Triangulation for this purpose. Cells without data have
+   * an invalid offset.
    */
-  std::map<std::pair<unsigned int, unsigned int>, Pointerstruct> cell_map;
+  std::vector<std::vector<CellData>> cell_data;
 
   /**
-   * Is used for @p prepare_for_refining_and_coarsening The interpolated dof
-   * values of all cells that'll be coarsened will be stored in this vector.
+   * Return the data stored for the cell with the given @p level and
+   * @p index, or a null pointer if no data is stored for this cell.
+   */
+  const CellData *
+  get_cell_data(const unsigned int level, const unsigned int index) const;
+
+  /**
+   * Store @p data as the data of @p cell in @p cell_data.
    */
-  std::vector<std::vector<Vector<typename VectorType::value_type>>>
-    dof_values_on_cell;
+  void
+  set_cell_data(const typename DoFHandlerType::cell_iterator &cell,
+                const CellData &                              data);
+
+  /**
+   * Transfer the vectors @p all_in on the old mesh to the vectors @p all_out
+   * on the current mesh, using the data stored for each cell. The cells are
+   * processed in parallel, and the output vectors are written sequentially.
+   */
+  void
+  interpolate_on_cells(const std::vector<const VectorType *> &all_in,
+                       const std::vector<VectorType *> &      all_out) const;
 };
 
 namespace Legacy
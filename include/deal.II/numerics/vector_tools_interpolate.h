@@ -61,6 +61,13 @@ namespace VectorTools
    * with the hanging nodes from space @p dof afterwards, to make the result
    * continuous again.
    *
+   * The work on the cells is done in parallel on several threads, see
+   * WorkStream. The support points of a cell are handed to @p function in
+   * batches through Function::vectorized_vector_value_list(), which derived
+   * classes can implement with SIMD instructions. As a consequence,
+   * @p function needs to allow evaluation from several threads at the same
+   * time.
+   *
    * See the general documentation of this namespace for further information.
    */
   template <int dim, int spacedim, typename VectorType>
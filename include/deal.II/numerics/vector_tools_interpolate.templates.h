@@ -17,6 +17,8 @@
 #define dealii_vector_tools_interpolate_templates_h
 
 
+#include <deal.II/base/work_stream.h>
+
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_system.h>
 
@@ -208,6 +210,49 @@ namespace VectorTools
     }
 
 
+    // Scratch data for the work on one cell in interpolate(): an FEValues
+    // object to evaluate the (generalized) support points and the Jacobians
+    // on the cell, and buffers for the support points and function values,
+    // one for each finite element of the collection.
+    template <int dim, int spacedim, typename number>
+    struct InterpolateScratchData
+    {
+      InterpolateScratchData(
+        const hp::MappingCollection<dim, spacedim> &mapping_collection,
+        const hp::FECollection<dim, spacedim> &     fe,
+        const hp::QCollection<dim> &                support_quadrature,
+        const UpdateFlags                           update_flags)
+        : fe_values(mapping_collection, fe, support_quadrature, update_flags)
+        , fe_function_values(fe.size())
+      {}
+
+      InterpolateScratchData(const InterpolateScratchData &scratch_data)
+        : fe_values(scratch_data.fe_values.get_mapping_collection(),
+                    scratch_data.fe_values.get_fe_collection(),
+                    scratch_data.fe_values.get_quadrature_collection(),
+                    scratch_data.fe_values.get_update_flags())
+        , fe_function_values(scratch_data.fe_function_values.size())
+      {}
+
+      hp::FEValues<dim, spacedim>                           fe_values;
+      std::vector<Point<spacedim, VectorizedArray<double>>> vectorized_points;
+      std::vector<std::vector<Vector<number>>>              fe_function_values;
+    };
+
+
+    // The result of the work on one cell in interpolate(): the dof values
+    // computed on the cell, and whether the dofs are selected by the
+    // component mask. If the list of dof indices is empty, the cell was
+    // skipped.
+    template <typename number>
+    struct InterpolateCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<number>                  dof_values;
+      std::vector<bool>                    selected;
+    };
+
+
     // Internal implementation of interpolate that takes a generic functor
     // function such that function(cell) is of type
     // Function<spacedim, typename VectorType::value_type>*
@@ -273,18 +318,6 @@ namespace VectorTools
       const hp::FECollection<dim, spacedim> &fe(
         dof_handler.get_fe_collection());
 
-      std::vector<types::global_dof_index> dofs_on_cell(fe.max_dofs_per_cell());
-
-      // Temporary storage for cell-wise interpolation operation. We store a
-      // variant for every FE we encounter to speed up resizing operations.
-      // The first vector is used for local function evaluation. The vector
-      // dof_values is used to store intermediate cell-wise interpolation
-      // results (see the detailed explanation in the for loop further down
-      // below).
-
-      std::vector<std::vector<Vector<number>>> fe_function_values(fe.size());
-      std::vector<std::vector<number>>         fe_dof_values(fe.size());
-
       // We will need two temporary global vectors that store the new values
       // and weights.
       VectorType interpolation;
@@ -308,65 +341,79 @@ namespace VectorTools
           support_quadrature.push_back(Quadrature<dim>(points));
         }
 
-      // An FEValues object to evaluate (generalized) support point
-      // locations as well as Jacobians and their inverses.
-      // the latter are only needed for Hcurl or Hdiv conforming elements,
-      // but we'll just always include them.
-      hp::FEValues<dim, spacedim> fe_values(mapping_collection,
-                                            fe,
-                                            support_quadrature,
-                                            update_quadrature_points |
-                                              update_jacobians |
-                                              update_inverse_jacobians);
-
       //
-      // Now loop over all locally owned, active cells.
+      // Now loop over all locally owned, active cells. The local work on
+      // the cells is independent of each other and is done in parallel,
+      // whereas the local results are added to the global vectors one cell
+      // at a time, in the order of the cells.
       //
 
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        {
+      const auto worker =
+        [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+              &                                            cell,
+            InterpolateScratchData<dim, spacedim, number> &scratch_data,
+            InterpolateCopyData<number> &                  copy_data) {
+          copy_data.dof_indices.clear();
+
           // If this cell is not locally owned, do nothing.
           if (!cell->is_locally_owned())
-            continue;
+            return;
 
           const unsigned int fe_index = cell->active_fe_index();
 
           // Do nothing if there are no local degrees of freedom.
           if (fe[fe_index].n_dofs_per_cell() == 0)
-            continue;
+            return;
 
           // Skip processing of the current cell if the function object is
           // invalid. This is used by interpolate_by_material_id to skip
           // interpolating over cells with unknown material id.
           if (!function(cell))
-            continue;
+            return;
 
           // Get transformed, generalized support points
-          fe_values.reinit(cell);
+          scratch_data.fe_values.reinit(cell);
           const std::vector<Point<spacedim>> &generalized_support_points =
-            fe_values.get_present_fe_values().get_quadrature_points();
+            scratch_data.fe_values.get_present_fe_values()
+              .get_quadrature_points();
 
           // Get indices of the dofs on this cell
           const auto n_dofs = fe[fe_index].n_dofs_per_cell();
-          dofs_on_cell.resize(n_dofs);
-          cell->get_dof_indices(dofs_on_cell);
+          copy_data.dof_indices.resize(n_dofs);
+          cell->get_dof_indices(copy_data.dof_indices);
 
           // Prepare temporary storage
-          auto &function_values = fe_function_values[fe_index];
-          auto &dof_values      = fe_dof_values[fe_index];
+          auto &function_values = scratch_data.fe_function_values[fe_index];
+          auto &dof_values      = copy_data.dof_values;
 
           const auto n_components = fe[fe_index].n_components();
           function_values.resize(generalized_support_points.size(),
                                  Vector<number>(n_components));
           dof_values.resize(n_dofs);
 
+          // Collect the support points in batches of the width of
+          // VectorizedArray, so that the function can evaluate several
+          // points at once. The unused lanes of the last batch get copies of
+          // the last point.
+          constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+          const unsigned int     n_points = generalized_support_points.size();
+          auto &vectorized_points = scratch_data.vectorized_points;
+          vectorized_points.resize((n_points + n_lanes - 1) / n_lanes);
+          for (unsigned int b = 0; b < vectorized_points.size(); ++b)
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              {
+                const unsigned int q = std::min(b * n_lanes + v, n_points - 1);
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  vectorized_points[b][d][v] = generalized_support_points[q][d];
+              }
+
           // Get all function values:
           Assert(
             n_components == function(cell)->n_components,
             ExcDimensionMismatch(dof_handler.get_fe_collection().n_components(),
                                  function(cell)->n_components));
-          function(cell)->vector_value_list(generalized_support_points,
-                                            function_values);
+          function(cell)->vectorized_vector_value_list(vectorized_points,
+                                                       function_values);
 
           {
             // Before we can average, we have to transform all function values
@@ -378,7 +425,7 @@ namespace VectorTools
             const unsigned int offset =
               apply_transform(fe[fe_index],
                               /* starting_offset = */ 0,
-                              fe_values,
+                              scratch_data.fe_values,
                               function_values);
             (void)offset;
             Assert(offset == n_components, ExcInternalError());
@@ -387,6 +434,7 @@ namespace VectorTools
           FETools::convert_generalized_support_point_values_to_dof_values(
             fe[fe_index], function_values, dof_values);
 
+          copy_data.selected.resize(n_dofs);
           for (unsigned int i = 0; i < n_dofs; ++i)
             {
               const auto &nonzero_components =
@@ -399,54 +447,76 @@ namespace VectorTools
               for (unsigned int c = 0; c < nonzero_components.size(); ++c)
                 selected =
                   selected || (nonzero_components[c] && component_mask[c]);
+              copy_data.selected[i] = selected;
 
-              if (selected)
-                {
 #ifdef DEBUG
-                  // make sure that all selected base elements are indeed
-                  // interpolatory
-
-                  if (const auto fe_system =
-                        dynamic_cast<const FESystem<dim> *>(&fe[fe_index]))
-                    {
-                      const auto index =
-                        fe_system->system_to_base_index(i).first.first;
-                      Assert(fe_system->base_element(index)
-                               .has_generalized_support_points(),
-                             ExcMessage("The component mask supplied to "
-                                        "VectorTools::interpolate selects a "
-                                        "non-interpolatory element."));
-                    }
+              // make sure that all selected base elements are indeed
+              // interpolatory
+              if (selected)
+                if (const auto fe_system =
+                      dynamic_cast<const FESystem<dim> *>(&fe[fe_index]))
+                  {
+                    const auto index =
+                      fe_system->system_to_base_index(i).first.first;
+                    Assert(fe_system->base_element(index)
+                             .has_generalized_support_points(),
+                           ExcMessage("The component mask supplied to "
+                                      "VectorTools::interpolate selects a "
+                                      "non-interpolatory element."));
+                  }
 #endif
-
-                  // Add local values to the global vectors
-                  ::dealii::internal::ElementAccess<VectorType>::add(
-                    dof_values[i], dofs_on_cell[i], interpolation);
-                  ::dealii::internal::ElementAccess<VectorType>::add(
-                    typename VectorType::value_type(1.0),
-                    dofs_on_cell[i],
-                    weights);
-                }
-              else
-                {
-                  // If a component is ignored, copy the dof values
-                  // from the vector "vec", but only if they are locally
-                  // available
-                  if (locally_owned_dofs.is_element(dofs_on_cell[i]))
-                    {
-                      const auto value =
-                        ::dealii::internal::ElementAccess<VectorType>::get(
-                          vec, dofs_on_cell[i]);
-                      ::dealii::internal::ElementAccess<VectorType>::add(
-                        value, dofs_on_cell[i], interpolation);
-                      ::dealii::internal::ElementAccess<VectorType>::add(
-                        typename VectorType::value_type(1.0),
-                        dofs_on_cell[i],
-                        weights);
-                    }
-                }
             }
-        } /* loop over dof_handler.active_cell_iterators() */
+        };
+
+      const auto copier = [&](const InterpolateCopyData<number> &copy_data) {
+        for (unsigned int i = 0; i < copy_data.dof_indices.size(); ++i)
+          {
+            const types::global_dof_index dof_index = copy_data.dof_indices[i];
+
+            if (copy_data.selected[i])
+              {
+                // Add local values to the global vectors
+                ::dealii::internal::ElementAccess<VectorType>::add(
+                  copy_data.dof_values[i], dof_index, interpolation);
+                ::dealii::internal::ElementAccess<VectorType>::add(
+                  typename VectorType::value_type(1.0), dof_index, weights);
+              }
+            else
+              {
+                // If a component is ignored, copy the dof values
+                // from the vector "vec", but only if they are locally
+                // available
+                if (locally_owned_dofs.is_element(dof_index))
+                  {
+                    const auto value =
+                      ::dealii::internal::ElementAccess<VectorType>::get(
+                        vec, dof_index);
+                    ::dealii::internal::ElementAccess<VectorType>::add(
+                      value, dof_index, interpolation);
+                    ::dealii::internal::ElementAccess<VectorType>::add(
+                      typename VectorType::value_type(1.0),
+                      dof_index,
+                      weights);
+                  }
+              }
+          }
+      };
+
+      // The scratch data contains an FEValues object to evaluate
+      // (generalized) support point locations as well as Jacobians and
+      // their inverses. the latter are only needed for Hcurl or Hdiv
+      // conforming elements, but we'll just always include them.
+      WorkStream::run(dof_handler.begin_active(),
+                      dof_handler.end(),
+                      worker,
+                      copier,
+                      InterpolateScratchData<dim, spacedim, number>(
+                        mapping_collection,
+                        fe,
+                        support_quadrature,
+                        update_quadrature_points | update_jacobians |
+                          update_inverse_jacobians),
+                      InterpolateCopyData<number>());
 
       interpolation.compress(VectorOperation::add);
       weights.compress(VectorOperation::add);
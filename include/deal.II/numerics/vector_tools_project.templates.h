@@ -17,6 +17,11 @@
 #define dealii_vector_tools_project_templates_h
 
 
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/hp/mapping_collection.h>
+#include <deal.II/hp/q_collection.h>
+
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/la_parallel_vector.h>
@@ -334,6 +339,379 @@ namespace VectorTools
 
 
 
+    /**
+     * Return whether all elements of @p fe_collection only have degrees of
+     * freedom in the interior of the cell, and are composed of base elements
+     * of the same degree that are complete tensor product spaces, i.e.,
+     * FE_DGQ and its variants. For these elements, the mass matrix is block
+     * diagonal, and its blocks can be inverted cell by cell with
+     * MatrixFreeOperators::CellwiseInverseMassMatrix.
+     */
+    template <int dim>
+    bool
+    has_cellwise_inverse_mass_matrix(
+      const hp::FECollection<dim> &fe_collection)
+    {
+      for (unsigned int i = 0; i < fe_collection.size(); ++i)
+        {
+          const FiniteElement<dim> &fe = fe_collection[i];
+          if (fe.reference_cell() != ReferenceCells::get_hypercube<dim>() ||
+              fe.n_dofs_per_cell() != fe.template n_dofs_per_object<dim>())
+            return false;
+
+          for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+            if (fe.base_element(b).n_components() != 1 ||
+                fe.base_element(b).degree != fe.degree ||
+                fe.base_element(b).n_dofs_per_cell() !=
+                  Utilities::pow(fe.degree + 1, dim))
+              return false;
+        }
+      return true;
+    }
+
+
+
+    /**
+     * Evaluate @p function at the quadrature points of the cells in the
+     * batch @p phi is currently initialized on, and store the values of the
+     * cell in lane <tt>v</tt> in <tt>values[v]</tt>.
+     */
+    template <int dim, typename Number>
+    void
+    evaluate_function_on_cell_batch(
+      const Function<dim, Number> &                     function,
+      const FEEvaluation<dim, -1, 0, 1, Number> &       phi,
+      const unsigned int                                n_filled_lanes,
+      std::vector<Point<dim, VectorizedArray<double>>> &points,
+      std::vector<std::vector<Vector<Number>>> &        values)
+    {
+      constexpr unsigned int n_lanes    = VectorizedArray<double>::size();
+      const unsigned int     n_q_points = phi.n_q_points;
+
+      points.resize((n_q_points + n_lanes - 1) / n_lanes);
+      values.resize(n_filled_lanes);
+      for (unsigned int v = 0; v < n_filled_lanes; ++v)
+        {
+          // the unused lanes of the last batch of points get copies of the
+          // last point
+          for (unsigned int b = 0; b < points.size(); ++b)
+            for (unsigned int l = 0; l < n_lanes; ++l)
+              {
+                const Point<dim, VectorizedArray<Number>> point =
+                  phi.quadrature_point(
+                    std::min(b * n_lanes + l, n_q_points - 1));
+                for (unsigned int d = 0; d < dim; ++d)
+                  points[b][d][l] = point[d][v];
+              }
+
+          values[v].resize(n_q_points, Vector<Number>(function.n_components));
+          function.vectorized_vector_value_list(points, values[v]);
+        }
+    }
+
+
+
+    /**
+     * The mass matrix for the matrix-free implementation of project() for
+     * general finite elements and hp::FECollection objects. The action of
+     * the mass matrix is computed with one scalar FEEvaluation object per
+     * vector component, which works for arbitrary FESystem elements since
+     * the mass matrix does not couple different vector components. The
+     * evaluators are set up for the cell ranges of the loops of MatrixFree,
+     * so that every range uses the finite element of its active FE index.
+     * As in MatrixFreeOperators::MassOperator, the lumped mass matrix is
+     * used as diagonal for preconditioning.
+     */
+    template <int dim, typename Number>
+    class ComponentwiseMassOperator
+      : public MatrixFreeOperators::Base<
+          dim,
+          LinearAlgebra::distributed::Vector<Number>>
+    {
+    public:
+      using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+      virtual void
+      compute_diagonal() override
+      {
+        this->inverse_diagonal_entries =
+          std::make_shared<DiagonalMatrix<VectorType>>();
+        this->diagonal_entries = std::make_shared<DiagonalMatrix<VectorType>>();
+        VectorType &inverse_diagonal_vector =
+          this->inverse_diagonal_entries->get_vector();
+        VectorType &diagonal_vector = this->diagonal_entries->get_vector();
+        this->initialize_dof_vector(inverse_diagonal_vector);
+        this->initialize_dof_vector(diagonal_vector);
+        inverse_diagonal_vector = Number(1.);
+        apply_add(diagonal_vector, inverse_diagonal_vector);
+
+        this->set_constrained_entries_to_one(diagonal_vector);
+        inverse_diagonal_vector = diagonal_vector;
+
+        const unsigned int locally_owned_size =
+          inverse_diagonal_vector.locally_owned_size();
+        for (unsigned int i = 0; i < locally_owned_size; ++i)
+          inverse_diagonal_vector.local_element(i) =
+            Number(1.) / inverse_diagonal_vector.local_element(i);
+
+        inverse_diagonal_vector.update_ghost_values();
+        diagonal_vector.update_ghost_values();
+      }
+
+    private:
+      virtual void
+      apply_add(VectorType &dst, const VectorType &src) const override
+      {
+        this->data->cell_loop(
+          [](const MatrixFree<dim, Number> &              data,
+             VectorType &                                 dst,
+             const VectorType &                           src,
+             const std::pair<unsigned int, unsigned int> &cell_range) {
+            for (unsigned int c = 0;
+                 c < data.get_dof_handler().get_fe_collection().n_components();
+                 ++c)
+              {
+                FEEvaluation<dim, -1, 0, 1, Number> phi(
+                  data, cell_range, 0, 0, c);
+                for (unsigned int cell = cell_range.first;
+                     cell < cell_range.second;
+                     ++cell)
+                  {
+                    phi.reinit(cell);
+                    phi.gather_evaluate(src, EvaluationFlags::values);
+                    for (unsigned int q = 0; q < phi.n_q_points; ++q)
+                      phi.submit_value(phi.get_value(q), q);
+                    phi.integrate_scatter(EvaluationFlags::values, dst);
+                  }
+              }
+          },
+          dst,
+          src);
+      }
+    };
+
+
+
+    /*
+     * MatrixFree implementation of project() for hp::FECollection objects
+     * and general FESystem elements, i.e., elements with several base
+     * elements or more components than supported by project_matrix_free().
+     * For discontinuous tensor product elements without constraints, the
+     * mass matrix is inverted cell by cell, so no linear system needs to be
+     * solved. Otherwise, the mass matrix is inverted with a CG solver using
+     * ComponentwiseMassOperator.
+     *
+     * The right hand side is integrated with the Gauss quadrature formulas
+     * set up for the mass matrix, and @p quadrature is only used for
+     * elements on non-hypercube cells.
+     */
+    template <int dim, typename Number>
+    void
+    project_matrix_free_componentwise(
+      const hp::MappingCollection<dim> &          mapping,
+      const DoFHandler<dim> &                     dof,
+      const AffineConstraints<Number> &           constraints,
+      const hp::QCollection<dim> &                quadrature,
+      const Function<dim, Number> &               function,
+      LinearAlgebra::distributed::Vector<Number> &work_result)
+    {
+      using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+      const hp::FECollection<dim> &fe = dof.get_fe_collection();
+      Assert(fe.n_components() == function.n_components,
+             ExcDimensionMismatch(fe.n_components(), function.n_components));
+
+      const bool use_cellwise_inverse =
+        constraints.n_constraints() == 0 &&
+        has_cellwise_inverse_mass_matrix(fe);
+
+      // the cellwise inverse of the mass matrix needs as many quadrature
+      // points as there are shape functions in each direction
+      hp::QCollection<dim> quadrature_mf;
+      for (unsigned int i = 0; i < fe.size(); ++i)
+        if (fe[i].reference_cell() == ReferenceCells::get_hypercube<dim>())
+          quadrature_mf.push_back(
+            QGauss<dim>(fe[i].degree + (use_cellwise_inverse ? 1 : 2)));
+        else
+          quadrature_mf.push_back(quadrature[quadrature.size() == 1 ? 0 : i]);
+
+      typename MatrixFree<dim, Number>::AdditionalData additional_data;
+      additional_data.tasks_parallel_scheme =
+        MatrixFree<dim, Number>::AdditionalData::partition_color;
+      additional_data.mapping_update_flags =
+        (update_values | update_JxW_values | update_quadrature_points);
+      std::shared_ptr<MatrixFree<dim, Number>> matrix_free(
+        new MatrixFree<dim, Number>());
+      matrix_free->reinit(
+        mapping, dof, constraints, quadrature_mf, additional_data);
+      matrix_free->initialize_dof_vector(work_result);
+
+      const unsigned int n_components = fe.n_components();
+
+      if (use_cellwise_inverse)
+        {
+          // the cells do not share any degrees of freedom, so the cell
+          // batches can be processed independently of each other
+          parallel::apply_to_subranges(
+            0U,
+            matrix_free->n_cell_batches(),
+            [&](const unsigned int begin, const unsigned int end) {
+              std::vector<Point<dim, VectorizedArray<double>>> points;
+              std::vector<std::vector<Vector<Number>>>         values;
+
+              for (unsigned int cell = begin; cell < end; ++cell)
+                {
+                  const unsigned int n_filled_lanes =
+                    matrix_free->n_active_entries_per_cell_batch(cell);
+
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    {
+                      FEEvaluation<dim, -1, 0, 1, Number> phi(
+                        *matrix_free, std::make_pair(cell, cell + 1), 0, 0, c);
+                      MatrixFreeOperators::
+                        CellwiseInverseMassMatrix<dim, -1, 1, Number>
+                          inverse_mass(phi);
+                      phi.reinit(cell);
+
+                      if (c == 0)
+                        evaluate_function_on_cell_batch(
+                          function, phi, n_filled_lanes, points, values);
+
+                      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+                        {
+                          VectorizedArray<Number> value = Number();
+                          for (unsigned int v = 0; v < n_filled_lanes; ++v)
+                            value[v] = values[v][q](c);
+                          phi.submit_value(value, q);
+                        }
+                      phi.integrate(EvaluationFlags::values);
+                      inverse_mass.apply(phi.begin_dof_values(),
+                                         phi.begin_dof_values());
+                      phi.set_dof_values(work_result);
+                    }
+                }
+            },
+            16);
+
+          return;
+        }
+
+      // set up mass matrix and right hand side
+      ComponentwiseMassOperator<dim, Number> mass_matrix;
+      mass_matrix.initialize(matrix_free);
+      mass_matrix.compute_diagonal();
+
+      VectorType rhs, inhomogeneities;
+      matrix_free->initialize_dof_vector(rhs);
+      matrix_free->initialize_dof_vector(inhomogeneities);
+      constraints.distribute(inhomogeneities);
+      inhomogeneities *= -1.;
+
+      // integrate the function and account for inhomogeneous constraints in
+      // a single pass over the cells
+      matrix_free->cell_loop(
+        [&](const MatrixFree<dim, Number> &              data,
+            VectorType &                                 dst,
+            const VectorType &                           src,
+            const std::pair<unsigned int, unsigned int> &cell_range) {
+          std::vector<std::unique_ptr<FEEvaluation<dim, -1, 0, 1, Number>>>
+            phi(n_components);
+          for (unsigned int c = 0; c < n_components; ++c)
+            phi[c] = std::make_unique<FEEvaluation<dim, -1, 0, 1, Number>>(
+              data, cell_range, 0, 0, c);
+
+          std::vector<Point<dim, VectorizedArray<double>>> points;
+          std::vector<std::vector<Vector<Number>>>         values;
+
+          for (unsigned int cell = cell_range.first; cell < cell_range.second;
+               ++cell)
+            {
+              const unsigned int n_filled_lanes =
+                data.n_active_entries_per_cell_batch(cell);
+
+              for (unsigned int c = 0; c < n_components; ++c)
+                {
+                  phi[c]->reinit(cell);
+                  if (c == 0)
+                    evaluate_function_on_cell_batch(
+                      function, *phi[0], n_filled_lanes, points, values);
+
+                  phi[c]->read_dof_values_plain(src);
+                  phi[c]->evaluate(EvaluationFlags::values);
+                  for (unsigned int q = 0; q < phi[c]->n_q_points; ++q)
+                    {
+                      VectorizedArray<Number> value = phi[c]->get_value(q);
+                      for (unsigned int v = 0; v < n_filled_lanes; ++v)
+                        value[v] += values[v][q](c);
+                      phi[c]->submit_value(value, q);
+                    }
+                  phi[c]->integrate(EvaluationFlags::values);
+                  phi[c]->distribute_local_to_global(dst);
+                }
+            }
+        },
+        rhs,
+        inhomogeneities);
+
+      // now invert the matrix
+      ReductionControl control(6 * rhs.size(), 0., 1e-12, false, false);
+      SolverCG<VectorType> cg(control);
+      PreconditionJacobi<ComponentwiseMassOperator<dim, Number>> preconditioner;
+      preconditioner.initialize(mass_matrix, 1.);
+      cg.solve(mass_matrix, work_result, rhs, preconditioner);
+      work_result += inhomogeneities;
+
+      constraints.distribute(work_result);
+    }
+
+
+
+    /**
+     * Copy the locally owned entries of @p work_result into @p vec_result.
+     */
+    template <int dim, typename VectorType, int spacedim>
+    void
+    copy_locally_owned_entries(
+      const DoFHandler<dim, spacedim> &dof,
+      const LinearAlgebra::distributed::Vector<typename VectorType::value_type>
+        &         work_result,
+      VectorType &vec_result)
+    {
+      const IndexSet &          locally_owned_dofs = dof.locally_owned_dofs();
+      IndexSet::ElementIterator it                 = locally_owned_dofs.begin();
+      for (; it != locally_owned_dofs.end(); ++it)
+        ::dealii::internal::ElementAccess<VectorType>::set(work_result(*it),
+                                                           *it,
+                                                           vec_result);
+      vec_result.compress(VectorOperation::insert);
+    }
+
+
+
+    /**
+     * Return whether project() can use project_matrix_free_componentwise()
+     * for the finite elements of @p dof and the given boundary settings.
+     */
+    template <int dim, typename Number>
+    bool
+    can_project_matrix_free_componentwise(
+      const DoFHandler<dim> &dof,
+      const bool             enforce_zero_boundary,
+      const bool             project_to_boundary_first)
+    {
+      if (enforce_zero_boundary || project_to_boundary_first)
+        return false;
+
+      const hp::FECollection<dim> &fe = dof.get_fe_collection();
+      for (unsigned int i = 0; i < fe.size(); ++i)
+        if (!MatrixFree<dim, Number>::is_supported(fe[i]))
+          return false;
+
+      return true;
+    }
+
+
+
     /**
      * Helper interface for the matrix-free implementation of project(): avoid
      * instantiating the other helper functions for more than one VectorType
@@ -367,13 +745,9 @@ namespace VectorTools
                                     q_boundary,
                                     project_to_boundary_first);
 
-      const IndexSet &          locally_owned_dofs = dof.locally_owned_dofs();
-      IndexSet::ElementIterator it                 = locally_owned_dofs.begin();
-      for (; it != locally_owned_dofs.end(); ++it)
-        ::dealii::internal::ElementAccess<VectorType>::set(work_result(*it),
-                                                           *it,
-                                                           vec_result);
-      vec_result.compress(VectorOperation::insert);
+      copy_locally_owned_entries<dim, VectorType, spacedim>(dof,
+                                                            work_result,
+                                                            vec_result);
     }
 
     /**
@@ -729,7 +1103,10 @@ namespace VectorTools
           dof.get_fe(0).n_components() > 4)
         use_matrix_free = false;
 
-      if (use_matrix_free)
+      using Number = typename VectorType::value_type;
+
+      if (use_matrix_free &&
+          !has_cellwise_inverse_mass_matrix(dof.get_fe_collection()))
         project_matrix_free_copy_vector(mapping,
                                         dof,
                                         constraints,
@@ -739,6 +1116,76 @@ namespace VectorTools
                                         enforce_zero_boundary,
                                         q_boundary,
                                         project_to_boundary_first);
+      else if (can_project_matrix_free_componentwise<dim, Number>(
+                 dof, enforce_zero_boundary, project_to_boundary_first))
+        {
+          // systems with several base elements or many components, and
+          // discontinuous elements whose mass matrix can be inverted cell by
+          // cell
+          AssertDimension(vec_result.size(), dof.n_dofs());
+          LinearAlgebra::distributed::Vector<Number> work_result;
+          project_matrix_free_componentwise(hp::MappingCollection<dim>(mapping),
+                                            dof,
+                                            constraints,
+                                            hp::QCollection<dim>(quadrature),
+                                            function,
+                                            work_result);
+          copy_locally_owned_entries<dim, VectorType, dim>(dof,
+                                                           work_result,
+                                                           vec_result);
+        }
+      else
+        {
+          Assert((dynamic_cast<const parallel::TriangulationBase<dim> *>(
+                    &(dof.get_triangulation())) == nullptr),
+                 ExcNotImplemented());
+          do_project(mapping,
+                     dof,
+                     constraints,
+                     quadrature,
+                     function,
+                     vec_result,
+                     enforce_zero_boundary,
+                     q_boundary,
+                     project_to_boundary_first);
+        }
+    }
+
+
+
+    /**
+     * Specialization of project() with hp::MappingCollection and
+     * hp::QCollection arguments for the case dim==spacedim. Use the
+     * MatrixFree implementation if all elements of the collection are
+     * supported by MatrixFree and no boundary values are to be projected,
+     * and the matrix based one otherwise.
+     */
+    template <typename VectorType, int dim>
+    void
+    project(
+      const hp::MappingCollection<dim> &                        mapping,
+      const DoFHandler<dim> &                                   dof,
+      const AffineConstraints<typename VectorType::value_type> &constraints,
+      const hp::QCollection<dim> &                              quadrature,
+      const Function<dim, typename VectorType::value_type> &    function,
+      VectorType &                                              vec_result,
+      const bool                      enforce_zero_boundary,
+      const hp::QCollection<dim - 1> &q_boundary,
+      const bool                      project_to_boundary_first)
+    {
+      using Number = typename VectorType::value_type;
+
+      if (can_project_matrix_free_componentwise<dim, Number>(
+            dof, enforce_zero_boundary, project_to_boundary_first))
+        {
+          AssertDimension(vec_result.size(), dof.n_dofs());
+          LinearAlgebra::distributed::Vector<Number> work_result;
+          project_matrix_free_componentwise(
+            mapping, dof, constraints, quadrature, function, work_result);
+          copy_locally_owned_entries<dim, VectorType, dim>(dof,
+                                                           work_result,
+                                                           vec_result);
+        }
       else
         {
           Assert((dynamic_cast<const parallel::TriangulationBase<dim> *>(
@@ -913,19 +1360,44 @@ namespace VectorTools
           const hp::QCollection<dim - 1> &q_boundary,
           const bool                      project_to_boundary_first)
   {
-    Assert((dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
-              &(dof.get_triangulation())) == nullptr),
-           ExcNotImplemented());
-
-    internal::do_project(mapping,
-                         dof,
-                         constraints,
-                         quadrature,
-                         function,
-                         vec_result,
-                         enforce_zero_boundary,
-                         q_boundary,
-                         project_to_boundary_first);
+    if (dim == spacedim)
+      {
+        const hp::MappingCollection<dim> *const mapping_ptr =
+          dynamic_cast<const hp::MappingCollection<dim> *>(&mapping);
+        const DoFHandler<dim> *const dof_ptr =
+          dynamic_cast<const DoFHandler<dim> *>(&dof);
+        const Function<dim,
+                       typename VectorType::value_type> *const function_ptr =
+          dynamic_cast<const Function<dim, typename VectorType::value_type> *>(
+            &function);
+        Assert(mapping_ptr != nullptr, ExcInternalError());
+        Assert(dof_ptr != nullptr, ExcInternalError());
+        internal::project<VectorType, dim>(*mapping_ptr,
+                                           *dof_ptr,
+                                           constraints,
+                                           quadrature,
+                                           *function_ptr,
+                                           vec_result,
+                                           enforce_zero_boundary,
+                                           q_boundary,
+                                           project_to_boundary_first);
+      }
+    else
+      {
+        Assert(
+          (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+             &(dof.get_triangulation())) == nullptr),
+          ExcNotImplemented());
+        internal::do_project(mapping,
+                             dof,
+                             constraints,
+                             quadrature,
+                             function,
+                             vec_result,
+                             enforce_zero_boundary,
+                             q_boundary,
+                             project_to_boundary_first);
+      }
   }
 
 
@@ -0,0 +1,268 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_cell_weights_h
+#define dealii_particles_cell_weights_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include <boost/signals2/connection.hpp>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  /**
+   * A class that balances the work of a simulation with particles across
+   * the processes of a parallel::distributed::Triangulation.
+   *
+   * Cells that contain many particles are more expensive than cells without
+   * particles, and a partition of the mesh that assigns each process the
+   * same number of cells is therefore not balanced. The usual remedy is to
+   * connect a function to the Triangulation::Signals::cell_weight signal
+   * that returns a weight like <tt>n_particles_in_cell * factor</tt>, where
+   * the @p factor has to be tuned by hand for every application. This class
+   * determines this factor by itself from timings of the actual simulation.
+   *
+   * To this end, the application surrounds the parts of each time step that
+   * work on the mesh (e.g., assembling and solving) and the parts that work
+   * on the particles (e.g., advecting and sorting them) by calls to
+   * start_mesh_work() and stop_mesh_work(), or start_particle_work() and
+   * stop_particle_work(), respectively, and calls finish_step() at the end of
+   * every time step. From the accumulated times and the numbers of locally
+   * owned cells and particles, the class computes the average cost of a
+   * particle relative to the cost of a cell, and the imbalance of the work,
+   * i.e., the ratio between the maximal and the average time per process.
+   * A typical time loop then looks as follows:
+   * @code
+   * Particles::CellWeights<dim> cell_weights(triangulation, particle_handler);
+   *
+   * for (unsigned int step = 0; step < n_steps; ++step)
+   *   {
+   *     cell_weights.start_mesh_work();
+   *     assemble_and_solve();
+   *     cell_weights.stop_mesh_work();
+   *
+   *     cell_weights.start_particle_work();
+   *     advect_particles();
+   *     particle_handler.sort_particles_into_subdomains_and_cells();
+   *     cell_weights.stop_particle_work();
+   *
+   *     cell_weights.finish_step();
+   *     if (cell_weights.repartition_if_imbalanced())
+   *       setup_dofs();
+   *   }
+   * @endcode
+   *
+   * The weight of a cell is the default weight of 1000 that the
+   * Triangulation assigns to every cell, plus 1000 times the number of
+   * particles in the cell times the measured cost ratio. Until the first
+   * measurement is complete, the particles do not contribute to the
+   * weights. The weights are used for every repartitioning of the
+   * triangulation while an object of this class exists, including the ones
+   * that happen during Triangulation::execute_coarsening_and_refinement().
+   *
+   * @note The timers measure the wall time of the calling process. Work
+   * that is not enclosed by one of the pairs of functions above is not
+   * taken into account.
+   *
+   * @ingroup Particle
+   */
+  template <int dim, int spacedim = dim>
+  class CellWeights
+  {
+  public:
+    /**
+     * Constructor. Connect the weighting function to the cell_weight signal
+     * of @p triangulation.
+     *
+     * @param[in] triangulation The triangulation that will be repartitioned.
+     * @param[in] particle_handler The particle handler whose particles are
+     *   attached to @p triangulation.
+     * @param[in] imbalance_threshold The ratio between the maximal and the
+     *   average time per process above which repartition_if_imbalanced()
+     *   repartitions the triangulation.
+     * @param[in] n_measurement_steps The number of time steps over which the
+     *   times are accumulated before repartition_if_imbalanced() evaluates
+     *   them.
+     */
+    CellWeights(
+      parallel::distributed::Triangulation<dim, spacedim> &triangulation,
+      ParticleHandler<dim, spacedim> &                     particle_handler,
+      const double       imbalance_threshold = 1.1,
+      const unsigned int n_measurement_steps = 10);
+
+    /**
+     * Destructor. Disconnect the weighting function from the cell_weight
+     * signal of the triangulation.
+     */
+    ~CellWeights();
+
+    /**
+     * Start measuring work on the mesh.
+     */
+    void
+    start_mesh_work();
+
+    /**
+     * Stop measuring work on the mesh.
+     */
+    void
+    stop_mesh_work();
+
+    /**
+     * Start measuring work on the particles.
+     */
+    void
+    start_particle_work();
+
+    /**
+     * Stop measuring work on the particles.
+     */
+    void
+    stop_particle_work();
+
+    /**
+     * Record the end of a time step together with the current numbers of
+     * locally owned cells and particles.
+     */
+    void
+    finish_step();
+
+    /**
+     * Once the times of at least @p n_measurement_steps time steps (as given
+     * to the constructor) have been recorded since the last evaluation,
+     * update the cost of a particle relative to the cost of a cell, compute
+     * the imbalance of the recorded times, and restart the measurements. If
+     * the imbalance exceeds the threshold given to the constructor, the
+     * triangulation is repartitioned with the updated weights, and the
+     * particles are transferred to their new owners.
+     *
+     * Return whether the triangulation has been repartitioned. In that case,
+     * all other data attached to the triangulation, like DoFHandler objects,
+     * has to be set up again. If the application needs to transfer data
+     * like solution vectors, it should instead call evaluate_measurements()
+     * and repartition the triangulation itself.
+     *
+     * This function has to be called on all processes.
+     */
+    bool
+    repartition_if_imbalanced();
+
+    /**
+     * Update the cost of a particle relative to the cost of a cell from the
+     * times recorded since the last evaluation, restart the measurements,
+     * and return the imbalance of the recorded times, i.e., the ratio
+     * between the maximal and the average time over all processes. Return
+     * zero if no time steps have been recorded.
+     *
+     * This function has to be called on all processes.
+     */
+    double
+    evaluate_measurements();
+
+    /**
+     * Return the cost of a particle relative to the cost of a cell as
+     * determined by the last evaluation of the measurements.
+     */
+    double
+    get_particle_cost_ratio() const;
+
+    /**
+     * Return the imbalance determined by the last evaluation of the
+     * measurements.
+     */
+    double
+    get_imbalance() const;
+
+  private:
+    /**
+     * The triangulation that is repartitioned.
+     */
+    SmartPointer<parallel::distributed::Triangulation<dim, spacedim>,
+                 CellWeights<dim, spacedim>>
+      triangulation;
+
+    /**
+     * The particle handler whose particles determine the weights.
+     */
+    SmartPointer<ParticleHandler<dim, spacedim>, CellWeights<dim, spacedim>>
+      particle_handler;
+
+    /**
+     * The imbalance above which the triangulation is repartitioned.
+     */
+    const double imbalance_threshold;
+
+    /**
+     * The number of time steps that are recorded before the measurements
+     * are evaluated.
+     */
+    const unsigned int n_measurement_steps;
+
+    /**
+     * Timers for the work on the mesh and on the particles.
+     */
+    Timer mesh_timer;
+    Timer particle_timer;
+
+    /**
+     * The number of time steps recorded since the last evaluation.
+     */
+    unsigned int n_recorded_steps;
+
+    /**
+     * The sums of the numbers of locally owned cells and particles over
+     * the recorded time steps.
+     */
+    double accumulated_n_cells;
+    double accumulated_n_particles;
+
+    /**
+     * The cost of a particle relative to the cost of a cell.
+     */
+    double particle_cost_ratio;
+
+    /**
+     * The imbalance determined by the last evaluation.
+     */
+    double imbalance;
+
+    /**
+     * The connection to the cell_weight signal of the triangulation.
+     */
+    boost::signals2::connection connection;
+
+    /**
+     * Return the weight of @p cell for the given @p status, as required by
+     * the cell_weight signal of the triangulation.
+     */
+    unsigned int
+    cell_weight(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const typename Triangulation<dim, spacedim>::CellStatus     status) const;
+  };
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
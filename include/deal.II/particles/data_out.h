@@ -18,6 +18,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
 
 #include <deal.II/numerics/data_component_interpretation.h>
 
@@ -128,6 +129,55 @@ namespace Particles
       data_component_interpretations;
   };
 
+
+
+  /**
+   * Write the locally owned particles of @p particle_handler in parallel into
+   * the HDF5 file @p h5_filename, without building patches first.
+   *
+   * The file follows the layout of the H5Part format: The group
+   * <tt>Step#0</tt> contains one-dimensional datasets named <tt>x</tt>,
+   * <tt>y</tt>, and (if @p spacedim is three) <tt>z</tt> with the coordinates
+   * of the particles, a dataset <tt>id</tt> with their ids, and one dataset
+   * per property component. The datasets of components that are part of a
+   * vector or tensor are named after the component with the index within the
+   * vector or tensor appended, e.g., <tt>velocity_0</tt>. In one space
+   * dimension, the dataset <tt>y</tt> contains zeros.
+   *
+   * Each process writes its particles into a contiguous section of each
+   * dataset through a collective write. Data is copied directly from the
+   * particles into a buffer that holds one value per locally owned particle
+   * and is reused for all datasets, so the memory overhead is much smaller
+   * than the one of DataOut::build_patches() followed by a generic writer.
+   * The @p flags determine the chunk size and the compression level of the
+   * datasets as for DataOutBase::write_hdf5_parallel().
+   *
+   * If @p xdmf_filename is not empty, the first process additionally writes
+   * an XDMF file that describes the particles as a set of vertices at time
+   * @p time, so that the HDF5 file can be read by visualization programs
+   * like ParaView or VisIt.
+   *
+   * The arguments @p data_component_names and
+   * @p data_component_interpretations have the same meaning as in
+   * DataOut::build_patches(). Properties are only written if names are
+   * provided.
+   *
+   * This function has to be called on all processes of @p mpi_communicator.
+   */
+  template <int dim, int spacedim>
+  void
+  write_h5part(
+    const ParticleHandler<dim, spacedim> &particle_handler,
+    const std::string &                   h5_filename,
+    const std::string &                   xdmf_filename,
+    const MPI_Comm &                      mpi_communicator,
+    const std::vector<std::string> &      data_component_names = {},
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &data_component_interpretations = {},
+    const DataOutBase::DataOutFilterFlags &flags =
+      DataOutBase::DataOutFilterFlags(),
+    const double time = 0.);
+
 } // namespace Particles
 
 DEAL_II_NAMESPACE_CLOSE
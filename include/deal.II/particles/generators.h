@@ -50,6 +50,11 @@ namespace Particles
      * locations in @p particle_reference_locations. An optional @p mapping argument
      * can be used to map from @p particle_reference_locations to the real particle locations.
      *
+     * The real locations of the particles are computed for all reference
+     * locations of a cell at once, and the cells are processed in parallel
+     * using WorkStream. The particles are inserted in the order of the cells,
+     * so their ids do not depend on the number of threads.
+     *
      * @param triangulation The triangulation associated with the @p particle_handler.
      *
      * @param particle_reference_locations A vector of positions in the unit cell.
@@ -127,6 +132,13 @@ namespace Particles
      * (if option @p random_cell_selection set to true). In either case the position of
      * individual particles inside the cell is computed randomly.
      *
+     * The particles of different cells are generated in parallel using
+     * WorkStream. Each cell uses its own random number generator, which is
+     * seeded with the combination of @p random_number_seed, the MPI rank, and
+     * the active cell index of the cell. The generated particles therefore
+     * only depend on the seed and the number of MPI processes, but not on the
+     * number of threads.
+     *
      * The algorithm implemented in the function is described in
      * @cite GLHPW2018.
      *
@@ -0,0 +1,264 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_neighbor_search_h
+#define dealii_particles_neighbor_search_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  /**
+   * A class that finds, for the particles of a ParticleHandler, all other
+   * particles within a given distance, e.g., to compute the interactions
+   * between particles in smoothed particle hydrodynamics (SPH) or discrete
+   * element methods (DEM).
+   *
+   * The search uses the active cells of the triangulation as a cell list: For
+   * every locally owned cell, the class determines the candidate cells
+   * whose bounding boxes are closer to the bounding box of the cell than the
+   * search radius. These are the locally owned and ghost cells that can
+   * contain particles within the search radius of a particle in the cell.
+   * The candidate cells only depend on the mesh and the radius, so they are
+   * computed once and reused until the triangulation changes or moves, or
+   * the radius is changed. The particles within the radius are then found
+   * by testing the particles of the candidate cells only.
+   *
+   * The neighbor lists of all locally owned particles can be computed at
+   * once with update_neighbor_lists(), which processes the cells in parallel
+   * and stores the neighbors of the particles of each cell in the order in
+   * which ParticleHandler::particles_in_cell() returns them:
+   * @code
+   * Particles::NeighborSearch<dim> neighbor_search(triangulation,
+   *                                                mapping,
+   *                                                particle_handler,
+   *                                                smoothing_length);
+   * for (unsigned int step = 0; step < n_steps; ++step)
+   *   {
+   *     particle_handler.exchange_ghost_particles();
+   *     neighbor_search.update_neighbor_lists();
+   *
+   *     for (const auto &cell : triangulation.active_cell_iterators())
+   *       if (cell->is_locally_owned())
+   *         {
+   *           unsigned int i = 0;
+   *           for (const auto &particle :
+   *                particle_handler.particles_in_cell(cell))
+   *             {
+   *               for (const auto &neighbor :
+   *                    neighbor_search.get_neighbors(cell, i))
+   *                 add_interaction(particle, *neighbor);
+   *               ++i;
+   *             }
+   *         }
+   *
+   *     move_particles();
+   *     particle_handler.sort_particles_into_subdomains_and_cells();
+   *   }
+   * @endcode
+   *
+   * The neighbors include ghost particles, so the ghost particles have to be
+   * exchanged before the neighbors are searched, and the layer of ghost
+   * cells has to be at least as wide as the search radius. The neighbor
+   * lists contain iterators into the particle handler and become invalid
+   * as soon as particles are inserted, removed, sorted into cells, or
+   * exchanged.
+   *
+   * @ingroup Particle
+   */
+  template <int dim, int spacedim = dim>
+  class NeighborSearch
+  {
+  public:
+    /**
+     * The type of the iterators to the neighbors of a particle.
+     */
+    using particle_iterator =
+      typename ParticleHandler<dim, spacedim>::particle_iterator;
+
+    /**
+     * Constructor.
+     *
+     * @param[in] triangulation The triangulation the particles live in.
+     * @param[in] mapping The mapping used to compute the bounding boxes of
+     *   the cells.
+     * @param[in] particle_handler The particle handler whose particles are
+     *   searched.
+     * @param[in] radius The distance up to which particles are neighbors.
+     */
+    NeighborSearch(const Triangulation<dim, spacedim> &  triangulation,
+                   const Mapping<dim, spacedim> &        mapping,
+                   const ParticleHandler<dim, spacedim> &particle_handler,
+                   const double                          radius);
+
+    /**
+     * Destructor.
+     */
+    ~NeighborSearch();
+
+    /**
+     * Change the search radius. The candidate cells are recomputed upon the
+     * next search.
+     */
+    void
+    set_radius(const double radius);
+
+    /**
+     * Return the search radius.
+     */
+    double
+    get_radius() const;
+
+    /**
+     * Compute the candidate cells of all locally owned cells in parallel,
+     * unless they are still up to date.
+     */
+    void
+    update_candidate_cells();
+
+    /**
+     * Return the locally owned and ghost cells that may contain particles
+     * within the search radius of a particle in the locally owned @p cell.
+     * The list includes @p cell itself.
+     *
+     * This function may only be called after update_candidate_cells() or
+     * update_neighbor_lists() as long as the candidate cells are up to date.
+     */
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator> &
+    get_candidate_cells(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Return the locally owned and ghost particles within the search radius
+     * of @p particle, which must be a locally owned particle. The particle
+     * itself is not part of the result.
+     *
+     * This function may only be called after update_candidate_cells() or
+     * update_neighbor_lists() as long as the candidate cells are up to date.
+     */
+    std::vector<particle_iterator>
+    find_neighbors(const particle_iterator &particle) const;
+
+    /**
+     * Compute the neighbors of all locally owned particles, processing the
+     * cells in parallel. The candidate cells are updated first if
+     * necessary.
+     */
+    void
+    update_neighbor_lists();
+
+    /**
+     * Return the neighbors of the particle with index @p particle_index
+     * within the locally owned @p cell, i.e., the particle at position
+     * @p particle_index in the range returned by
+     * ParticleHandler::particles_in_cell(). The particle itself is not part
+     * of its neighbors.
+     *
+     * This function may only be called after update_neighbor_lists() as
+     * long as the particles have not changed.
+     */
+    const std::vector<particle_iterator> &
+    get_neighbors(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int particle_index) const;
+
+  private:
+    /**
+     * The triangulation the particles live in.
+     */
+    SmartPointer<const Triangulation<dim, spacedim>, NeighborSearch>
+      triangulation;
+
+    /**
+     * The mapping used to compute the bounding boxes of the cells.
+     */
+    SmartPointer<const Mapping<dim, spacedim>, NeighborSearch> mapping;
+
+    /**
+     * The particle handler whose particles are searched.
+     */
+    SmartPointer<const ParticleHandler<dim, spacedim>, NeighborSearch>
+      particle_handler;
+
+    /**
+     * A cache of the bounding boxes of the active cells.
+     */
+    GridTools::Cache<dim, spacedim> cache;
+
+    /**
+     * The search radius.
+     */
+    double radius;
+
+    /**
+     * Whether the candidate cells have to be recomputed because the
+     * triangulation or the radius changed.
+     */
+    bool candidate_cells_outdated;
+
+    /**
+     * The candidate cells of each locally owned cell, indexed by the active
+     * cell index.
+     */
+    std::vector<
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      candidate_cells;
+
+    /**
+     * The neighbors of each particle of each locally owned cell, indexed by
+     * the active cell index and the index of the particle within the cell.
+     */
+    std::vector<std::vector<std::vector<particle_iterator>>> neighbor_lists;
+
+    /**
+     * The connections to the signals of the triangulation that invalidate
+     * the candidate cells.
+     */
+    std::vector<boost::signals2::connection> tria_listeners;
+
+    /**
+     * Append the particles of the candidate cells of @p cell that are
+     * within the search radius of @p location, except for @p particle, to
+     * @p neighbors.
+     */
+    void
+    add_neighbors(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const Point<spacedim> &          location,
+      const particle_iterator &        particle,
+      std::vector<particle_iterator> &neighbors) const;
+  };
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -20,11 +20,13 @@
 
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/strided_array_view.h>
 #include <deal.II/base/types.h>
 
 #include <deal.II/particles/property_pool.h>
 
 #include <cstdint>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -361,6 +363,10 @@ namespace Particles
      * throw an exception.
      *
      * @return An ArrayView of the properties of this particle.
+     *
+     * @note This function can only be used if the property pool stores the
+     *   properties in the PropertyPool::array_of_structures layout. Use
+     *   get_property_view() otherwise.
      */
     const ArrayView<double>
     get_properties();
@@ -370,10 +376,44 @@ namespace Particles
      * has no properties this function throws an exception.
      *
      * @return An ArrayView of the properties of this particle.
+     *
+     * @note This function can only be used if the property pool stores the
+     *   properties in the PropertyPool::array_of_structures layout. Use
+     *   get_property_view() otherwise.
      */
     const ArrayView<const double>
     get_properties() const;
 
+    /**
+     * Get write-access to the properties of this particle, independent of
+     * the layout in which the property pool stores them.
+     */
+    StridedArrayView<double, 1>
+    get_property_view();
+
+    /**
+     * Get read-access to the properties of this particle, independent of
+     * the layout in which the property pool stores them.
+     */
+    StridedArrayView<const double, 1>
+    get_property_view() const;
+
+    /**
+     * Return the handle under which the property pool stores the data of
+     * this particle.
+     */
+    typename PropertyPool<dim, spacedim>::Handle
+    get_handle() const;
+
+    /**
+     * Set the handle under which the property pool stores the data of this
+     * particle. This function is only meant to be used after
+     * PropertyPool::sort_memory_slots() has moved the data of the particle
+     * to a new handle. The previous handle is not released.
+     */
+    void
+    set_handle(const typename PropertyPool<dim, spacedim>::Handle handle);
+
     /**
      * Return the size in bytes this particle occupies if all of its data is
      * serialized (i.e. the number of bytes that is written by the write_data
@@ -466,17 +506,20 @@ namespace Particles
 
     if (n_properties > 0)
       {
-        ArrayView<double> properties(get_properties());
+        const StridedArrayView<double, 1> properties = get_property_view();
         Assert(
-          properties.size() == n_properties,
+          properties.n_elements() == n_properties,
           ExcMessage(
             "This particle was serialized with " +
             std::to_string(n_properties) +
             " properties, but the new property handler provides space for " +
-            std::to_string(properties.size()) +
+            std::to_string(properties.n_elements()) +
             " properties. Deserializing a particle only works for matching property sizes."));
 
-        ar &boost::serialization::make_array(properties.data(), n_properties);
+        std::vector<double> values(n_properties);
+        ar &boost::serialization::make_array(values.data(), n_properties);
+        for (unsigned int i = 0; i < n_properties; ++i)
+          properties(i) = values[i];
       }
   }
 
@@ -490,7 +533,7 @@ namespace Particles
     unsigned int n_properties = 0;
     if ((property_pool != nullptr) &&
         (property_pool_handle != PropertyPool<dim, spacedim>::invalid_handle))
-      n_properties = get_properties().size();
+      n_properties = property_pool->n_properties_per_slot();
 
     Point<spacedim>       location           = get_location();
     Point<dim>            reference_location = get_reference_location();
@@ -499,8 +542,14 @@ namespace Particles
     ar &location &reference_location &id &n_properties;
 
     if (n_properties > 0)
-      ar &boost::serialization::make_array(get_properties().data(),
-                                           n_properties);
+      {
+        const StridedArrayView<const double, 1> properties =
+          get_property_view();
+        std::vector<double> values(n_properties);
+        for (unsigned int i = 0; i < n_properties; ++i)
+          values[i] = properties(i);
+        ar &boost::serialization::make_array(values.data(), n_properties);
+      }
   }
 
 
@@ -584,12 +633,14 @@ namespace Particles
 
     if (/* old pool */ has_properties())
       {
-        ArrayView<const double> old_properties = this->get_properties();
-        ArrayView<double>       new_properties =
-          new_property_pool.get_properties(new_handle);
-        std::copy(old_properties.cbegin(),
-                  old_properties.cend(),
-                  new_properties.begin());
+        const StridedArrayView<const double, 1> old_properties =
+          this->get_property_view();
+        const StridedArrayView<double, 1> new_properties =
+          new_property_pool.get_property_view(new_handle);
+        AssertDimension(old_properties.n_elements(),
+                        new_properties.n_elements());
+        for (unsigned int i = 0; i < old_properties.n_elements(); ++i)
+          new_properties(i) = old_properties(i);
       }
 
     // Now release the old memory handle
@@ -621,6 +672,44 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  inline StridedArrayView<double, 1>
+  Particle<dim, spacedim>::get_property_view()
+  {
+    return property_pool->get_property_view(property_pool_handle);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline StridedArrayView<const double, 1>
+  Particle<dim, spacedim>::get_property_view() const
+  {
+    return static_cast<const PropertyPool<dim, spacedim> *>(property_pool)
+      ->get_property_view(property_pool_handle);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline typename PropertyPool<dim, spacedim>::Handle
+  Particle<dim, spacedim>::get_handle() const
+  {
+    return property_pool_handle;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline void
+  Particle<dim, spacedim>::set_handle(
+    const typename PropertyPool<dim, spacedim>::Handle handle)
+  {
+    property_pool_handle = handle;
+  }
+
+
+
   template <int dim, int spacedim>
   inline bool
   Particle<dim, spacedim>::has_properties() const
@@ -23,6 +23,7 @@
 #include <deal.II/grid/tria.h>
 
 #include <deal.II/particles/particle.h>
+#include <deal.II/particles/particle_container.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -189,6 +190,20 @@ namespace Particles
     const ArrayView<const double>
     get_properties() const;
 
+    /**
+     * Get write-access to the properties of this particle, independent of
+     * the layout in which the property pool stores them.
+     */
+    StridedArrayView<double, 1>
+    get_property_view();
+
+    /**
+     * Get read-access to the properties of this particle, independent of
+     * the layout in which the property pool stores them.
+     */
+    StridedArrayView<const double, 1>
+    get_property_view() const;
+
     /**
      * Return the size in bytes this particle occupies if all of its data is
      * serialized (i.e. the number of bytes that is written by the write_data
@@ -246,29 +261,33 @@ namespace Particles
     ParticleAccessor();
 
     /**
-     * Construct an accessor from a reference to a map and an iterator to the
-     * map. This constructor is protected so that it can only be accessed by
-     * friend classes.
+     * Construct an accessor from a reference to a container and the
+     * position of a particle within the container. This constructor is
+     * protected so that it can only be accessed by friend classes.
      */
     ParticleAccessor(
-      const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-      const typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-        &particle);
+      const internal::ParticleContainer<dim, spacedim> &container,
+      const typename internal::ParticleContainer<dim, spacedim>::Position
+        &position);
 
   private:
+    /**
+     * Return the particle this accessor points to.
+     */
+    Particle<dim, spacedim> &
+    get_particle() const;
+
     /**
      * A pointer to the container that stores the particles. Obviously,
      * this accessor is invalidated if the container changes.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> *map;
+    internal::ParticleContainer<dim, spacedim> *container;
 
     /**
-     * An iterator into the container of particles. Obviously,
+     * The position of the particle within the container. Obviously,
      * this accessor is invalidated if the container changes.
      */
-    typename std::multimap<internal::LevelInd,
-                           Particle<dim, spacedim>>::iterator particle;
+    typename internal::ParticleContainer<dim, spacedim>::Position position;
 
     // Make ParticleIterator a friend to allow it constructing
     // ParticleAccessors.
@@ -286,7 +305,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::serialize(Archive &          ar,
                                              const unsigned int version)
   {
-    return particle->second.serialize(ar, version);
+    return get_particle().serialize(ar, version);
   }
 
 
@@ -294,32 +313,44 @@ namespace Particles
 
   template <int dim, int spacedim>
   inline ParticleAccessor<dim, spacedim>::ParticleAccessor()
-    : map(nullptr)
-    , particle()
+    : container(nullptr)
+    , position()
   {}
 
 
 
   template <int dim, int spacedim>
   inline ParticleAccessor<dim, spacedim>::ParticleAccessor(
-    const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-    const typename std::multimap<internal::LevelInd,
-                                 Particle<dim, spacedim>>::iterator & particle)
-    : map(const_cast<
-          std::multimap<internal::LevelInd, Particle<dim, spacedim>> *>(&map))
-    , particle(particle)
+    const internal::ParticleContainer<dim, spacedim> &container,
+    const typename internal::ParticleContainer<dim, spacedim>::Position
+      &position)
+    : container(
+        const_cast<internal::ParticleContainer<dim, spacedim> *>(&container))
+    , position(position)
   {}
 
 
 
+  template <int dim, int spacedim>
+  inline Particle<dim, spacedim> &
+  ParticleAccessor<dim, spacedim>::get_particle() const
+  {
+    Assert(container != nullptr, ExcInternalError());
+    Assert(position != container->end(), ExcInternalError());
+
+    return (*container)[position];
+  }
+
+
+
   template <int dim, int spacedim>
   inline const void *
   ParticleAccessor<dim, spacedim>::read_particle_data_from_memory(
     const void *data)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.read_particle_data_from_memory(data);
+    const void *data_end = get_particle().read_particle_data_from_memory(data);
+    container->mark_locations_changed(position.cell);
+    return data_end;
   }
 
 
@@ -329,9 +360,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::write_particle_data_to_memory(
     void *data) const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.write_particle_data_to_memory(data);
+    return get_particle().write_particle_data_to_memory(data);
   }
 
 
@@ -340,9 +369,8 @@ namespace Particles
   inline void
   ParticleAccessor<dim, spacedim>::set_location(const Point<spacedim> &new_loc)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_location(new_loc);
+    get_particle().set_location(new_loc);
+    container->mark_locations_changed(position.cell);
   }
 
 
@@ -351,9 +379,7 @@ namespace Particles
   inline const Point<spacedim> &
   ParticleAccessor<dim, spacedim>::get_location() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_location();
+    return get_particle().get_location();
   }
 
 
@@ -363,9 +389,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_reference_location(
     const Point<dim> &new_loc)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_reference_location(new_loc);
+    get_particle().set_reference_location(new_loc);
   }
 
 
@@ -374,9 +398,7 @@ namespace Particles
   inline const Point<dim> &
   ParticleAccessor<dim, spacedim>::get_reference_location() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_reference_location();
+    return get_particle().get_reference_location();
   }
 
 
@@ -385,9 +407,7 @@ namespace Particles
   inline types::particle_index
   ParticleAccessor<dim, spacedim>::get_id() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_id();
+    return get_particle().get_id();
   }
 
 
@@ -397,9 +417,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_property_pool(
     PropertyPool<dim, spacedim> &new_property_pool)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_property_pool(new_property_pool);
+    get_particle().set_property_pool(new_property_pool);
   }
 
 
@@ -408,9 +426,7 @@ namespace Particles
   inline bool
   ParticleAccessor<dim, spacedim>::has_properties() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.has_properties();
+    return get_particle().has_properties();
   }
 
 
@@ -420,9 +436,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_properties(
     const std::vector<double> &new_properties)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_properties(new_properties);
+    get_particle().set_properties(new_properties);
   }
 
 
@@ -432,9 +446,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_properties(
     const ArrayView<const double> &new_properties)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_properties(new_properties);
+    get_particle().set_properties(new_properties);
   }
 
 
@@ -443,9 +455,7 @@ namespace Particles
   inline const ArrayView<const double>
   ParticleAccessor<dim, spacedim>::get_properties() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_properties();
+    return get_particle().get_properties();
   }
 
 
@@ -455,10 +465,11 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::get_surrounding_cell(
     const Triangulation<dim, spacedim> &triangulation) const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(container != nullptr, ExcInternalError());
+    Assert(position != container->end(), ExcInternalError());
 
     const typename Triangulation<dim, spacedim>::cell_iterator cell(
-      &triangulation, particle->first.first, particle->first.second);
+      &triangulation, position.cell.first, position.cell.second);
     return cell;
   }
 
@@ -468,9 +479,26 @@ namespace Particles
   inline const ArrayView<double>
   ParticleAccessor<dim, spacedim>::get_properties()
   {
-    Assert(particle != map->end(), ExcInternalError());
+    return get_particle().get_properties();
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline StridedArrayView<double, 1>
+  ParticleAccessor<dim, spacedim>::get_property_view()
+  {
+    return get_particle().get_property_view();
+  }
 
-    return particle->second.get_properties();
+
+
+  template <int dim, int spacedim>
+  inline StridedArrayView<const double, 1>
+  ParticleAccessor<dim, spacedim>::get_property_view() const
+  {
+    return static_cast<const Particle<dim, spacedim> &>(get_particle())
+      .get_property_view();
   }
 
 
@@ -479,9 +507,7 @@ namespace Particles
   inline std::size_t
   ParticleAccessor<dim, spacedim>::serialized_size_in_bytes() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.serialized_size_in_bytes();
+    return get_particle().serialized_size_in_bytes();
   }
 
 
@@ -490,8 +516,8 @@ namespace Particles
   inline void
   ParticleAccessor<dim, spacedim>::next()
   {
-    Assert(particle != map->end(), ExcInternalError());
-    ++particle;
+    Assert(container != nullptr, ExcInternalError());
+    container->advance(position);
   }
 
 
@@ -500,8 +526,8 @@ namespace Particles
   inline void
   ParticleAccessor<dim, spacedim>::prev()
   {
-    Assert(particle != map->begin(), ExcInternalError());
-    --particle;
+    Assert(container != nullptr, ExcInternalError());
+    container->retreat(position);
   }
 
 
@@ -511,7 +537,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::
   operator!=(const ParticleAccessor<dim, spacedim> &other) const
   {
-    return (map != other.map) || (particle != other.particle);
+    return (container != other.container) || (position != other.position);
   }
 
 
@@ -521,7 +547,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::
   operator==(const ParticleAccessor<dim, spacedim> &other) const
   {
-    return (map == other.map) && (particle == other.particle);
+    return (container == other.container) && (position == other.position);
   }
 
 
@@ -0,0 +1,648 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_particle_container_h
+#define dealii_particles_particle_container_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/particles/particle.h>
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  namespace internal
+  {
+    /**
+     * The container in which ParticleHandler stores its particles. The
+     * particles of each cell are stored contiguously in a block of their
+     * own, and the blocks are addressed directly by the level and index of
+     * the cell. Compared to a <code>std::multimap</code> keyed by the cell,
+     * which allocates a separate tree node for every particle, iterating
+     * over the particles of a cell thus walks over consecutive memory, and
+     * inserting or removing a particle is of amortized constant complexity.
+     *
+     * Particles are ordered by the level and index of their cell, and within
+     * a cell by the order in which they were inserted, unless particles of
+     * that cell were removed since. The position of a particle is described
+     * by a Position object that remains valid when other particles are
+     * inserted, but not when a particle of the same cell is removed.
+     *
+     * In addition, the container records for each cell whether particles
+     * were inserted into it or changed their location since the last call
+     * to reset_locations_changed(). This allows ParticleHandler to skip the
+     * cells whose particles cannot have left them when sorting particles
+     * into cells.
+     */
+    template <int dim, int spacedim = dim>
+    class ParticleContainer
+    {
+    public:
+      /**
+       * The position of a particle within the container, given by the cell
+       * the particle is in and its index within the block of particles of
+       * that cell.
+       */
+      struct Position
+      {
+        /**
+         * The level and index of the cell.
+         */
+        LevelInd cell;
+
+        /**
+         * The index of the particle within the particles of the cell.
+         */
+        unsigned int index_within_cell;
+
+        /**
+         * Compare for equality.
+         */
+        bool
+        operator==(const Position &other) const;
+
+        /**
+         * Compare for inequality.
+         */
+        bool
+        operator!=(const Position &other) const;
+
+        /**
+         * Compare the order of two positions, i.e., first by the cell and
+         * then by the index within the cell.
+         */
+        bool
+        operator<(const Position &other) const;
+      };
+
+      /**
+       * Return the number of particles stored.
+       */
+      std::size_t
+      size() const;
+
+      /**
+       * Return the number of particles in the cell with level and index
+       * given by @p cell.
+       */
+      unsigned int
+      n_particles_in_cell(const LevelInd &cell) const;
+
+      /**
+       * Return the largest number of particles in any cell.
+       */
+      unsigned int
+      max_particles_per_cell() const;
+
+      /**
+       * Return the position of the first particle, or end() if the
+       * container is empty.
+       */
+      Position
+      begin() const;
+
+      /**
+       * Return the position past the last particle.
+       */
+      Position
+      end() const;
+
+      /**
+       * Return the position of the first particle in @p cell. If the cell
+       * contains no particles, this is the same as end(cell).
+       */
+      Position
+      begin(const LevelInd &cell) const;
+
+      /**
+       * Return the position past the last particle in @p cell, i.e., the
+       * position of the first particle of the next cell that contains
+       * particles, or end().
+       */
+      Position
+      end(const LevelInd &cell) const;
+
+      /**
+       * Move @p position to the next particle.
+       */
+      void
+      advance(Position &position) const;
+
+      /**
+       * Move @p position to the previous particle.
+       */
+      void
+      retreat(Position &position) const;
+
+      /**
+       * Return the particle at @p position.
+       */
+      Particle<dim, spacedim> &operator[](const Position &position);
+
+      /**
+       * Return the particle at @p position.
+       */
+      const Particle<dim, spacedim> &operator[](const Position &position) const;
+
+      /**
+       * Return the particles stored in @p cell.
+       */
+      const std::vector<Particle<dim, spacedim>> &
+      particles_in_cell(const LevelInd &cell) const;
+
+      /**
+       * Add @p particle at the end of the particles of @p cell and return its
+       * position.
+       */
+      Position
+      insert(const LevelInd &cell, Particle<dim, spacedim> &&particle);
+
+      /**
+       * Same as above, but copy the particle.
+       */
+      Position
+      insert(const LevelInd &cell, const Particle<dim, spacedim> &particle);
+
+      /**
+       * Remove the particle at @p position. The last particle of the same
+       * cell is moved into the gap, so positions of other particles of that
+       * cell may no longer refer to the same particle.
+       */
+      void
+      erase(const Position &position);
+
+      /**
+       * Remove the particles at all of the given @p positions. In contrast
+       * to calling erase() for each of them, this function takes into
+       * account that the removal of one particle moves another one.
+       */
+      void
+      erase(std::vector<Position> positions);
+
+      /**
+       * Remove all particles.
+       */
+      void
+      clear();
+
+      /**
+       * Record that the location of a particle in @p cell has changed.
+       */
+      void
+      mark_locations_changed(const LevelInd &cell);
+
+      /**
+       * Record that the locations of all particles have to be considered
+       * changed, e.g., because the mesh was moved.
+       */
+      void
+      mark_all_locations_changed();
+
+      /**
+       * Return whether particles were inserted into @p cell or changed their
+       * location since the last call to reset_locations_changed().
+       */
+      bool
+      locations_changed(const LevelInd &cell) const;
+
+      /**
+       * Forget about all changes of locations recorded so far.
+       */
+      void
+      reset_locations_changed();
+
+      /**
+       * Release the memory of blocks of particles that is no longer needed
+       * after many particles have left their cells, e.g., after sorting the
+       * particles into new cells. This moves particles in memory, but does
+       * not change their positions.
+       */
+      void
+      compress();
+
+    private:
+      /**
+       * The blocks of particles, indexed by the level and the index of the
+       * cell.
+       */
+      std::vector<std::vector<std::vector<Particle<dim, spacedim>>>> cells;
+
+      /**
+       * The level and index of all cells that contain particles, used to
+       * find the next or previous cell when iterating.
+       */
+      std::set<LevelInd> non_empty_cells;
+
+      /**
+       * Whether particles were inserted into a cell or changed their
+       * location, indexed like the blocks of particles.
+       */
+      std::vector<std::vector<bool>> cell_locations_changed;
+
+      /**
+       * Whether the locations of all particles are to be considered changed.
+       */
+      bool all_locations_changed = false;
+
+      /**
+       * The total number of particles.
+       */
+      std::size_t n_particles = 0;
+
+      /**
+       * Return the first position of @p cell, which must contain particles.
+       */
+      static Position
+      first_in_cell(const LevelInd &cell);
+
+      /**
+       * Return the block of particles of @p cell, creating it if necessary.
+       */
+      std::vector<Particle<dim, spacedim>> &
+      get_or_create_cell(const LevelInd &cell);
+    };
+
+
+
+    // ------------------------- inline functions ---------------------------
+
+    template <int dim, int spacedim>
+    inline bool
+    ParticleContainer<dim, spacedim>::Position::
+    operator==(const Position &other) const
+    {
+      return (cell == other.cell) &&
+             (index_within_cell == other.index_within_cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    ParticleContainer<dim, spacedim>::Position::
+    operator!=(const Position &other) const
+    {
+      return !(*this == other);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    ParticleContainer<dim, spacedim>::Position::
+    operator<(const Position &other) const
+    {
+      return (cell < other.cell) || ((cell == other.cell) &&
+                                     (index_within_cell <
+                                      other.index_within_cell));
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline std::size_t
+    ParticleContainer<dim, spacedim>::size() const
+    {
+      return n_particles;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline unsigned int
+    ParticleContainer<dim, spacedim>::n_particles_in_cell(
+      const LevelInd &cell) const
+    {
+      if (static_cast<std::size_t>(cell.first) >= cells.size() ||
+          static_cast<std::size_t>(cell.second) >= cells[cell.first].size())
+        return 0;
+      return cells[cell.first][cell.second].size();
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline unsigned int
+    ParticleContainer<dim, spacedim>::max_particles_per_cell() const
+    {
+      unsigned int max_particles = 0;
+      for (const auto &cell : non_empty_cells)
+        max_particles = std::max(max_particles, n_particles_in_cell(cell));
+      return max_particles;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::first_in_cell(const LevelInd &cell)
+    {
+      return Position{cell, 0};
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::begin() const
+    {
+      if (non_empty_cells.empty())
+        return end();
+      return first_in_cell(*non_empty_cells.begin());
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::end() const
+    {
+      // a position past all cells, so that the comparison operators order
+      // it after all particles
+      return Position{LevelInd(std::numeric_limits<int>::max(), 0), 0};
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::begin(const LevelInd &cell) const
+    {
+      if (n_particles_in_cell(cell) == 0)
+        return end(cell);
+      return first_in_cell(cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::end(const LevelInd &cell) const
+    {
+      const auto next_cell = non_empty_cells.upper_bound(cell);
+      if (next_cell == non_empty_cells.end())
+        return end();
+      return first_in_cell(*next_cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::advance(Position &position) const
+    {
+      Assert(position != end(), ExcInternalError());
+
+      ++position.index_within_cell;
+      if (position.index_within_cell >= n_particles_in_cell(position.cell))
+        position = end(position.cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::retreat(Position &position) const
+    {
+      Assert(position != begin(), ExcInternalError());
+
+      if (position.index_within_cell > 0)
+        {
+          --position.index_within_cell;
+          return;
+        }
+
+      auto previous_cell = non_empty_cells.lower_bound(position.cell);
+      --previous_cell;
+      position.cell              = *previous_cell;
+      position.index_within_cell = n_particles_in_cell(*previous_cell) - 1;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline Particle<dim, spacedim> &ParticleContainer<dim, spacedim>::
+                                    operator[](const Position &position)
+    {
+      AssertIndexRange(position.index_within_cell,
+                       n_particles_in_cell(position.cell));
+      return cells[position.cell.first][position.cell.second]
+                  [position.index_within_cell];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const Particle<dim, spacedim> &
+    ParticleContainer<dim, spacedim>::
+    operator[](const Position &position) const
+    {
+      AssertIndexRange(position.index_within_cell,
+                       n_particles_in_cell(position.cell));
+      return cells[position.cell.first][position.cell.second]
+                  [position.index_within_cell];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const std::vector<Particle<dim, spacedim>> &
+    ParticleContainer<dim, spacedim>::particles_in_cell(
+      const LevelInd &cell) const
+    {
+      Assert(n_particles_in_cell(cell) > 0,
+             ExcMessage("There are no particles in this cell."));
+      return cells[cell.first][cell.second];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline std::vector<Particle<dim, spacedim>> &
+    ParticleContainer<dim, spacedim>::get_or_create_cell(const LevelInd &cell)
+    {
+      Assert(cell.first >= 0 && cell.second >= 0, ExcInternalError());
+
+      if (static_cast<std::size_t>(cell.first) >= cells.size())
+        {
+          cells.resize(cell.first + 1);
+          cell_locations_changed.resize(cell.first + 1);
+        }
+      if (static_cast<std::size_t>(cell.second) >= cells[cell.first].size())
+        {
+          cells[cell.first].resize(cell.second + 1);
+          cell_locations_changed[cell.first].resize(cell.second + 1, false);
+        }
+
+      std::vector<Particle<dim, spacedim>> &particles =
+        cells[cell.first][cell.second];
+      if (particles.empty())
+        non_empty_cells.insert(cell);
+      cell_locations_changed[cell.first][cell.second] = true;
+      return particles;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::insert(
+      const LevelInd &          cell,
+      Particle<dim, spacedim> &&particle)
+    {
+      std::vector<Particle<dim, spacedim>> &particles =
+        get_or_create_cell(cell);
+      particles.push_back(std::move(particle));
+      ++n_particles;
+      return Position{cell, static_cast<unsigned int>(particles.size() - 1)};
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleContainer<dim, spacedim>::Position
+    ParticleContainer<dim, spacedim>::insert(
+      const LevelInd &               cell,
+      const Particle<dim, spacedim> &particle)
+    {
+      std::vector<Particle<dim, spacedim>> &particles =
+        get_or_create_cell(cell);
+      particles.push_back(particle);
+      ++n_particles;
+      return Position{cell, static_cast<unsigned int>(particles.size() - 1)};
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::erase(const Position &position)
+    {
+      AssertIndexRange(position.index_within_cell,
+                       n_particles_in_cell(position.cell));
+
+      std::vector<Particle<dim, spacedim>> &particles =
+        cells[position.cell.first][position.cell.second];
+      if (position.index_within_cell + 1 < particles.size())
+        particles[position.index_within_cell] = std::move(particles.back());
+      particles.pop_back();
+      --n_particles;
+
+      if (particles.empty())
+        non_empty_cells.erase(position.cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::erase(std::vector<Position> positions)
+    {
+      // remove the particles from the back of each cell to the front: the
+      // particle that fills the gap of a removed one then always comes from
+      // behind all positions that remain to be removed
+      std::sort(positions.begin(), positions.end());
+      for (auto position = positions.rbegin(); position != positions.rend();
+           ++position)
+        erase(*position);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::clear()
+    {
+      cells.clear();
+      non_empty_cells.clear();
+      cell_locations_changed.clear();
+      all_locations_changed = false;
+      n_particles = 0;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::mark_locations_changed(
+      const LevelInd &cell)
+    {
+      AssertIndexRange(cell.first, cell_locations_changed.size());
+      AssertIndexRange(cell.second, cell_locations_changed[cell.first].size());
+      cell_locations_changed[cell.first][cell.second] = true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::mark_all_locations_changed()
+    {
+      all_locations_changed = true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    ParticleContainer<dim, spacedim>::locations_changed(
+      const LevelInd &cell) const
+    {
+      if (all_locations_changed)
+        return true;
+      if (static_cast<std::size_t>(cell.first) >=
+            cell_locations_changed.size() ||
+          static_cast<std::size_t>(cell.second) >=
+            cell_locations_changed[cell.first].size())
+        return false;
+      return cell_locations_changed[cell.first][cell.second];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::reset_locations_changed()
+    {
+      for (auto &level : cell_locations_changed)
+        std::fill(level.begin(), level.end(), false);
+      all_locations_changed = false;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline void
+    ParticleContainer<dim, spacedim>::compress()
+    {
+      for (auto &level : cells)
+        for (auto &particles : level)
+          if (particles.capacity() > 2 * particles.size())
+            particles.shrink_to_fit();
+    }
+  } // namespace internal
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -32,6 +32,7 @@
 #include <deal.II/grid/grid_tools_cache.h>
 
 #include <deal.II/particles/particle.h>
+#include <deal.II/particles/particle_container.h>
 #include <deal.II/particles/particle_iterator.h>
 #include <deal.II/particles/partitioner.h>
 #include <deal.II/particles/property_pool.h>
@@ -86,22 +87,39 @@ namespace Particles
      */
     ParticleHandler(const Triangulation<dim, spacedim> &tria,
                     const Mapping<dim, spacedim> &      mapping,
-                    const unsigned int                  n_properties = 0);
+                    const unsigned int                  n_properties = 0,
+                    const typename PropertyPool<dim, spacedim>::Layout
+                      property_layout =
+                        PropertyPool<dim, spacedim>::array_of_structures);
 
     /**
      * Destructor.
      */
-    virtual ~ParticleHandler() override = default;
+    virtual ~ParticleHandler() override;
 
     /**
      * Initialize the particle handler. This function does not clear the
      * internal data structures, it just sets the triangulation and the
      * mapping to be used.
+     *
+     * If @p property_layout is PropertyPool::structure_of_arrays, the
+     * properties of the particles are stored such that the values of one
+     * property for all particles of a cell are contiguous in memory after
+     * each call to sort_particles_into_subdomains_and_cells(). They can then
+     * be accessed via get_property_values_in_cell(). In this layout, the
+     * properties of individual particles have to be accessed via
+     * ParticleAccessor::get_property_view() instead of
+     * ParticleAccessor::get_properties(). Since sorting the memory changes
+     * where the data of every particle is stored, no copies of the particles
+     * of this object may exist at that time.
      */
     void
     initialize(const Triangulation<dim, spacedim> &tria,
                const Mapping<dim, spacedim> &      mapping,
-               const unsigned int                  n_properties = 0);
+               const unsigned int                  n_properties = 0,
+               const typename PropertyPool<dim, spacedim>::Layout
+                 property_layout =
+                   PropertyPool<dim, spacedim>::array_of_structures);
 
     /**
      * Copy the state of particle handler @p particle_handler into the
@@ -202,25 +220,9 @@ namespace Particles
     /**
      * Return the number of particles that live on the given cell.
      *
-     * @note While this function is used in step-19, it is not an efficient
-     *   function to use if the number of particles is large. That is because
-     *   to find the particles that are located in one cell costs
-     *   ${\cal O}(\log N)$ where $N$ is the number of overall particles. Since
-     *   you will likely do this for every cell, and assuming that the number
-     *   of particles and the number of cells are roughly proportional,
-     *   you end up with an ${\cal O}(N \log N)$ algorithm. A better approach
-     *   is to use the fact that internally, particles are arranged in the
-     *   order of the active cells they are in. In other words, if you iterate
-     *   over all particles, you will encounter them in the same order as
-     *   you walk over the active cells. You can exploit this by keeping an
-     *   iterator to the first particle of the first cell, and when you move
-     *   to the next cell, you increment the particle iterator as well until
-     *   you find a particle located on that next cell. Counting how many
-     *   steps this took will then give you the number you are looking for,
-     *   at a cost of ${\cal O}(\log N)$ when accumulated over all cells.
-     *   This is the approach used in step-70, for example. The approach is
-     *   also detailed in the "Possibilities for extensions section"
-     *   of step-19.
+     * Since the particles of each cell are stored in a block of their own
+     * that is addressed directly by the cell, this function is of constant
+     * complexity.
      */
     types::particle_index
     n_particles_in_cell(
@@ -235,24 +237,10 @@ namespace Particles
      * The number of elements in the returned range equals what the
      * n_particles_in_cell() function returns.
      *
-     * @note While this function is used in step-19, it is not an efficient
-     *   function to use if the number of particles is large. That is because
-     *   to find the particles that are located in one cell costs
-     *   ${\cal O}(\log N)$ where $N$ is the number of overall particles. Since
-     *   you will likely do this for every cell, and assuming that the number
-     *   of particles and the number of cells are roughly proportional,
-     *   you end up with an ${\cal O}(N \log N)$ algorithm. A better approach
-     *   is to use the fact that internally, particles are arranged in the
-     *   order of the active cells they are in. In other words, if you iterate
-     *   over all particles, you will encounter them in the same order as
-     *   you walk over the active cells. You can exploit this by keeping an
-     *   iterator to the first particle of the first cell, and when you move
-     *   to the next cell, you increment the particle iterator as well until
-     *   you find a particle located on that next cell. This is the approach
-     *   used in step-70, for example, and has an overall cost of
-     *   ${\cal O}(\log N)$ when accumulated over all cells. The approach is
-     *   also detailed in the "Possibilities for extensions section"
-     *   of step-19.
+     * The particles of a cell are stored contiguously. Finding the first
+     * particle of the cell is of constant complexity, whereas finding the end
+     * of the range costs ${\cal O}(\log M)$, where $M$ is the number of
+     * cells that contain particles.
      */
     particle_iterator_range
     particles_in_cell(
@@ -266,24 +254,10 @@ namespace Particles
      * The number of elements in the returned range equals what the
      * n_particles_in_cell() function returns.
      *
-     * @note While this function is used in step-19, it is not an efficient
-     *   function to use if the number of particles is large. That is because
-     *   to find the particles that are located in one cell costs
-     *   ${\cal O}(\log N)$ where $N$ is the number of overall particles. Since
-     *   you will likely do this for every cell, and assuming that the number
-     *   of particles and the number of cells are roughly proportional,
-     *   you end up with an ${\cal O}(N \log N)$ algorithm. A better approach
-     *   is to use the fact that internally, particles are arranged in the
-     *   order of the active cells they are in. In other words, if you iterate
-     *   over all particles, you will encounter them in the same order as
-     *   you walk over the active cells. You can exploit this by keeping an
-     *   iterator to the first particle of the first cell, and when you move
-     *   to the next cell, you increment the particle iterator as well until
-     *   you find a particle located on that next cell. This is the approach
-     *   used in step-70, for example, and has an overall cost of
-     *   ${\cal O}(\log N)$ when accumulated over all cells. The approach is
-     *   also detailed in the "Possibilities for extensions section"
-     *   of step-19.
+     * The particles of a cell are stored contiguously. Finding the first
+     * particle of the cell is of constant complexity, whereas finding the end
+     * of the range costs ${\cal O}(\log M)$, where $M$ is the number of
+     * cells that contain particles.
      */
     particle_iterator_range
     particles_in_cell(
@@ -291,16 +265,66 @@ namespace Particles
       const;
 
     /**
-     * Remove a particle pointed to by the iterator.
+     * Return the values of the property with index @p component for all
+     * particles in @p cell, in the order in which particles_in_cell()
+     * returns the particles. The values are stored contiguously, so they can
+     * be processed with VectorizedArray:
+     * @code
+     *   const ArrayView<double> temperatures =
+     *     particle_handler.get_property_values_in_cell(cell, 0);
+     *   constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+     *   for (unsigned int i = 0; i + n_lanes <= temperatures.size();
+     *        i += n_lanes)
+     *     {
+     *       VectorizedArray<double> t;
+     *       t.load(temperatures.data() + i);
+     *       t *= decay;
+     *       t.store(temperatures.data() + i);
+     *     }
+     *   // ...and the remaining values one by one
+     * @endcode
+     *
+     * This function requires the PropertyPool::structure_of_arrays layout
+     * (see initialize()), and may only be called if no particles were
+     * inserted into or removed from the cell since the last call to
+     * sort_particles_into_subdomains_and_cells().
+     */
+    ArrayView<double>
+    get_property_values_in_cell(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int component);
+
+    /**
+     * Same as above, but for read-only access.
+     */
+    ArrayView<const double>
+    get_property_values_in_cell(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int component) const;
+
+    /**
+     * Remove a particle pointed to by the iterator. The last particle of the
+     * same cell takes the place of the removed one, so iterators to the
+     * particles of that cell are invalidated. In order to remove several
+     * particles, use remove_particles() instead.
      */
     void
     remove_particle(const particle_iterator &particle);
 
+    /**
+     * Remove all particles pointed to by the iterators in @p particles. This
+     * function takes into account that removing one particle moves another
+     * one of the same cell, so it can be used with iterators collected
+     * before any of the particles is removed.
+     */
+    void
+    remove_particles(const std::vector<particle_iterator> &particles);
+
     /**
      * Insert a particle into the collection of particles. Return an iterator
      * to the new position of the particle. This function involves a copy of
-     * the particle and its properties. Note that this function is of $O(N \log
-     * N)$ complexity for $N$ particles.
+     * the particle and its properties. Note that this function is of
+     * amortized constant complexity.
      */
     particle_iterator
     insert_particle(
@@ -319,6 +343,25 @@ namespace Particles
         typename Triangulation<dim, spacedim>::active_cell_iterator,
         Particle<dim, spacedim>> &particles);
 
+    /**
+     * Create particles at the given @p positions in @p cell and insert them
+     * into the collection of particles. The particles get the reference
+     * locations @p reference_locations and consecutive ids starting at
+     * @p first_id. Since the particles are directly appended to the
+     * particles of @p cell, this function is of complexity
+     * ${\cal O}(n)$ in the number $n$ of new particles.
+     *
+     * Like insert_particle(), this function does not update the cached
+     * global numbers of particles. Call update_cached_numbers() after all
+     * particles have been inserted.
+     */
+    void
+    insert_particles(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Point<spacedim>> &positions,
+      const ArrayView<const Point<dim>> &     reference_locations,
+      const types::particle_index             first_id);
+
     /**
      * Create and insert a number of particles into the collection of particles.
      * This function takes a list of positions and creates a set of particles
@@ -696,10 +739,35 @@ namespace Particles
      * triggered whenever a particle is deleted, and the connected functions
      * are called passing an iterator to the particle in question, and its last
      * known cell association.
+     *
+     * Only the cells into which particles were inserted, or in which
+     * particles changed their location through
+     * ParticleAccessor::set_location(), since the last call to this function
+     * are considered; the particles of all other cells cannot have left
+     * them. Moving the vertices of the triangulation marks all particles as
+     * changed. If the geometry described by the mapping changes without the
+     * triangulation noticing, e.g., for a MappingQEulerian object whose
+     * displacement vector changed, call mark_all_particle_locations_changed()
+     * before this function.
+     *
+     * For each considered particle, the function first checks whether it is
+     * still in its cell. On cells that are parallelograms or parallelepipeds
+     * and mapped by a MappingQGeneric of degree one or a MappingCartesian,
+     * this is done by a check against the bounding box of the cell followed
+     * by an inverse affine transformation. Only the remaining particles, and
+     * those that left their cell, go through
+     * Mapping::transform_real_to_unit_cell() and the search for a new cell.
      */
     void
     sort_particles_into_subdomains_and_cells();
 
+    /**
+     * Mark the locations of all particles as changed, so that the next call
+     * to sort_particles_into_subdomains_and_cells() checks all of them.
+     */
+    void
+    mark_all_particle_locations_changed();
+
     /**
      * Exchange all particles that live in cells that are ghost cells to
      * other processes. Clears and re-populates the ghost_neighbors
@@ -714,10 +782,35 @@ namespace Particles
      * location and the properties of the ghost particles assuming that
      * the ghost particles have not changed cells. Consequently, this will
      * not update the reference location of the particles.
+     *
+     * The communication pattern set up by
+     * exchange_ghost_particles(true) is reused through persistent MPI
+     * requests. If set_dynamic_ghost_properties() was called before the
+     * ghost particles were exchanged, only the locations and the selected
+     * properties are sent.
      */
     void
     update_ghost_particles();
 
+    /**
+     * Select the properties that change between calls of
+     * update_ghost_particles(), e.g., velocities in a particle simulation
+     * in which material parameters stay constant. Afterwards,
+     * update_ghost_particles() only sends the locations of the ghost
+     * particles and the properties with the indices given in
+     * @p property_indices, together with the data of the store and load
+     * functions registered via register_additional_store_load_functions().
+     * The remaining properties and the ids of the ghost particles keep the
+     * values they had when exchange_ghost_particles() was called.
+     *
+     * This function has to be called on all processes with the same
+     * arguments, and before exchange_ghost_particles() builds the cache
+     * used by update_ghost_particles().
+     */
+    void
+    set_dynamic_ghost_properties(
+      const std::vector<unsigned int> &property_indices);
+
     /**
      * Callback function that should be called before every refinement
      * and when writing checkpoints. This function is used to
@@ -812,14 +905,14 @@ namespace Particles
      * Set of particles currently living in the local domain, organized by
      * the level/index of the cell they are in.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> particles;
+    internal::ParticleContainer<dim, spacedim> particles;
 
     /**
      * Set of particles that currently live in the ghost cells of the local
      * domain, organized by the level/index of the cell they are in. These
      * particles are equivalent to the ghost entries in distributed vectors.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> ghost_particles;
+    internal::ParticleContainer<dim, spacedim> ghost_particles;
 
     /**
      * This variable stores how many particles are stored globally. It is
@@ -900,20 +993,42 @@ namespace Particles
      */
     std::unique_ptr<GridTools::Cache<dim, spacedim>> triangulation_cache;
 
+    /**
+     * Connections to the signals of the triangulation, used to notice when
+     * the mesh is moved.
+     */
+    std::vector<boost::signals2::connection> tria_listeners;
+
+    /**
+     * Connect to the signals of the current triangulation, disconnecting
+     * from those of a previous one.
+     */
+    void
+    connect_to_triangulation_signals();
+
+    /**
+     * For the PropertyPool::structure_of_arrays layout, rearrange the memory
+     * of the property pool in the order in which the particles are stored,
+     * so that the property values of the particles of each cell are
+     * contiguous. Does nothing for the other layout.
+     */
+    void
+    sort_property_pool_memory();
+
 #ifdef DEAL_II_WITH_MPI
     /**
      * Transfer particles that have crossed subdomain boundaries to other
      * processors.
      * All received particles and their new cells will be appended to the
-     * @p received_particles vector.
+     * @p received_particles container.
      *
      * @param [in] particles_to_send All particles that should be sent and
      * their new subdomain_ids are in this map.
      *
-     * @param [in,out] received_particles Vector that stores all received
-     * particles. Note that it is not required nor checked that the list
-     * is empty, received particles are simply attached to the end of
-     * the vector.
+     * @param [in,out] received_particles Container that stores all received
+     * particles. Note that it is not required nor checked that the container
+     * is empty, received particles are simply added to the particles of
+     * their cells.
      *
      * @param [in] new_cells_for_particles Optional vector of cell
      * iterators with the same structure as @p particles_to_send. If this
@@ -933,8 +1048,7 @@ namespace Particles
     send_recv_particles(
       const std::map<types::subdomain_id, std::vector<particle_iterator>>
         &particles_to_send,
-      std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-        &received_particles,
+      internal::ParticleContainer<dim, spacedim> &received_particles,
       const std::map<
         types::subdomain_id,
         std::vector<
@@ -956,22 +1070,52 @@ namespace Particles
      * @param [in] particles_to_send All particles for which information
      * should be sent and their new subdomain_ids are in this map.
      *
-     * @param [in,out] received_particles A map with all received
+     * @param [in,out] received_particles A container with all received
      * particles. Note that it is not required nor checked that the container
      * is empty, received particles are simply inserted into
-     * the map.
+     * the container.
      *
      */
     void
     send_recv_particles_properties_and_location(
       const std::map<types::subdomain_id, std::vector<particle_iterator>>
         &particles_to_send,
-      std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-        &received_particles);
-
+      internal::ParticleContainer<dim, spacedim> &received_particles);
 
+    /**
+     * Set up the persistent MPI requests with which
+     * send_recv_particles_properties_and_location() exchanges the data
+     * stored in the ghost particle cache.
+     */
+    void
+    setup_ghost_update_requests();
 #endif
 
+    /**
+     * Return the number of bytes per particle that
+     * update_ghost_particles() sends.
+     */
+    unsigned int
+    ghost_update_data_size() const;
+
+    /**
+     * Free the persistent MPI requests of the ghost particle cache, if any.
+     */
+    void
+    free_ghost_update_requests();
+
+    /**
+     * Whether only the locations and the properties listed in
+     * dynamic_ghost_properties are sent when updating ghost particles, see
+     * set_dynamic_ghost_properties().
+     */
+    bool only_dynamic_ghost_properties;
+
+    /**
+     * The indices of the properties sent when updating ghost particles.
+     */
+    std::vector<unsigned int> dynamic_ghost_properties;
+
     /**
      * Cache structure used to store the elements which are required to
      * exchange the particle information (location and properties) accross
@@ -980,10 +1124,20 @@ namespace Particles
      */
     internal::GhostParticlePartitioner<dim, spacedim> ghost_particles_cache;
 
+    /**
+     * Return the number of bytes of the record that store_particles() writes
+     * for each particle: the id, the location, the reference location, and
+     * the properties of the particle.
+     */
+    std::size_t
+    particle_record_size() const;
+
     /**
      * Called by listener functions from Triangulation for every cell
      * before a refinement step. All particles have to be attached to their
-     * cell to be sent around to the new processes.
+     * cell to be sent around to the new processes. The particles are
+     * written directly from their containers into one record of
+     * particle_record_size() bytes each.
      */
     std::vector<char>
     store_particles(
@@ -991,8 +1145,9 @@ namespace Particles
       const typename Triangulation<dim, spacedim>::CellStatus     status) const;
 
     /**
-     * Called by listener functions after a refinement step. The local map
-     * of particles has to be read from the triangulation user_pointer.
+     * Called by listener functions after a refinement step. The records
+     * written by store_particles() are read directly into the property pool
+     * and the particle containers of this object.
      */
     void
     load_particles(
@@ -46,13 +46,12 @@ namespace Particles
 
     /**
      * Constructor of the iterator. Takes a reference to the particle
-     * container, and an iterator to the cell-particle pair.
+     * container, and the position of the particle within the container.
      */
     ParticleIterator(
-      const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-      const typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-        &particle);
+      const internal::ParticleContainer<dim, spacedim> &container,
+      const typename internal::ParticleContainer<dim, spacedim>::Position
+        &position);
 
     /**
      * Dereferencing operator, returns a reference to an accessor. Usage is thus
@@ -146,10 +145,10 @@ namespace Particles
 
   template <int dim, int spacedim>
   inline ParticleIterator<dim, spacedim>::ParticleIterator(
-    const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-    const typename std::multimap<internal::LevelInd,
-                                 Particle<dim, spacedim>>::iterator & particle)
-    : accessor(map, particle)
+    const internal::ParticleContainer<dim, spacedim> &container,
+    const typename internal::ParticleContainer<dim, spacedim>::Position
+      &position)
+    : accessor(container, position)
   {}
 
 
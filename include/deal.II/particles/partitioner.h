@@ -18,6 +18,9 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/particles/particle_container.h>
 #include <deal.II/particles/particle_iterator.h>
 
 DEAL_II_NAMESPACE_OPEN
@@ -88,14 +91,14 @@ namespace Particles
       std::vector<unsigned int> recv_pointers;
 
       /**
-       * Vector of ghost particles in the order in which they are inserted
-       * in the multimap used to store particles on the triangulation. This
-       * information is used to update the ghost particle information
-       * without clearing the multimap of ghost particles, thus greatly
-       * reducing the cost of exchanging the ghost particles information.
+       * Positions of the ghost particles in the order in which they are
+       * inserted in the container used to store particles on the
+       * triangulation. This information is used to update the ghost particle
+       * information without clearing the container of ghost particles, thus
+       * greatly reducing the cost of exchanging the ghost particles
+       * information.
        */
-      std::vector<typename std::multimap<internal::LevelInd,
-                                         Particle<dim, spacedim>>::iterator>
+      std::vector<typename ParticleContainer<dim, spacedim>::Position>
         ghost_particles_iterators;
 
       /**
@@ -113,6 +116,23 @@ namespace Particles
        * send_recv_particles_properties_and_location()
        */
       std::vector<char> recv_data;
+
+      /**
+       * The number of bytes per particle for which send_pointers and
+       * recv_pointers were computed.
+       */
+      unsigned int particle_data_size = 0;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * Persistent MPI requests that receive into recv_data and send
+       * send_data, in this order. Since the neighbors and the amount of data
+       * exchanged with each of them do not change as long as the cache is
+       * valid, the requests are set up once and then only started for each
+       * update of the ghost particles.
+       */
+      std::vector<MPI_Request> requests;
+#endif
     };
   } // namespace internal
 
@@ -20,6 +20,7 @@
 
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/strided_array_view.h>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -97,6 +98,25 @@ namespace Particles
    * course the PropertyType could contain a pointer to dynamically allocated
    * memory with varying sizes per particle (this memory would not be managed by
    * this class).
+   *
+   * <h3>Memory layout of the properties</h3>
+   *
+   * By default, the properties of each particle are stored next to each
+   * other (Layout::array_of_structures), and get_properties() returns them
+   * as an ArrayView. Algorithms that loop over one property of many
+   * particles, say the temperature of all particles in a cell, then access
+   * memory with a stride of n_properties_per_slot() and cannot be
+   * vectorized. With Layout::structure_of_arrays, the values of each
+   * property are instead stored in an array of their own, indexed by the
+   * handles. If consecutive particles have consecutive handles, which
+   * sort_memory_slots() ensures, the values of one property for these
+   * particles are contiguous in memory and are returned as an ArrayView by
+   * get_property_values(). They can then be processed with VectorizedArray
+   * using VectorizedArray::load() and VectorizedArray::store().
+   *
+   * In the structure-of-arrays layout, the properties of a single particle
+   * are no longer contiguous and can only be accessed via
+   * get_property_view(), which works for both layouts.
    */
   template <int dim, int spacedim = dim>
   class PropertyPool
@@ -115,9 +135,27 @@ namespace Particles
     static const Handle invalid_handle;
 
     /**
-     * Constructor. Stores the number of properties per reserved slot.
+     * The ways in which the properties of the particles can be arranged in
+     * memory. See the general documentation of this class for details.
      */
-    PropertyPool(const unsigned int n_properties_per_slot);
+    enum Layout
+    {
+      /**
+       * Store the properties of each particle contiguously.
+       */
+      array_of_structures,
+      /**
+       * Store the values of each property for all particles contiguously.
+       */
+      structure_of_arrays
+    };
+
+    /**
+     * Constructor. Stores the number of properties per reserved slot and the
+     * layout in which the properties are stored.
+     */
+    PropertyPool(const unsigned int n_properties_per_slot,
+                 const Layout       layout = array_of_structures);
 
     /**
      * Destructor. This function ensures that all memory that had
@@ -194,10 +232,61 @@ namespace Particles
     /**
      * Return an ArrayView to the properties that correspond to the given
      * handle @p handle.
+     *
+     * This function can only be called if the properties are stored in the
+     * Layout::array_of_structures layout. Use get_property_view() otherwise.
      */
     ArrayView<double>
     get_properties(const Handle handle);
 
+    /**
+     * Return a view to the properties that correspond to the given handle
+     * @p handle. In contrast to get_properties(), this function works for
+     * both layouts.
+     */
+    StridedArrayView<double, 1>
+    get_property_view(const Handle handle);
+
+    /**
+     * Same as above, but for read-only access.
+     */
+    StridedArrayView<const double, 1>
+    get_property_view(const Handle handle) const;
+
+    /**
+     * Return an ArrayView to the values of the property with index
+     * @p component for the @p n_handles consecutive handles starting at
+     * @p first_handle.
+     *
+     * This function can only be called if the properties are stored in the
+     * Layout::structure_of_arrays layout.
+     */
+    ArrayView<double>
+    get_property_values(const unsigned int component,
+                        const Handle       first_handle,
+                        const unsigned int n_handles);
+
+    /**
+     * Same as above, but for read-only access.
+     */
+    ArrayView<const double>
+    get_property_values(const unsigned int component,
+                        const Handle       first_handle,
+                        const unsigned int n_handles) const;
+
+    /**
+     * Rearrange the memory of the pool such that the data of the particle
+     * with handle <code>sorted_handles[i]</code> is afterwards found at
+     * handle <code>i</code>. The caller is responsible for updating the
+     * handles stored by the particles accordingly.
+     *
+     * Since all handles change, @p sorted_handles has to contain all handles
+     * that are currently registered. Memory that is no longer needed, for
+     * example because many particles have been deregistered, is released.
+     */
+    void
+    sort_memory_slots(const std::vector<Handle> &sorted_handles);
+
     /**
      * Reserve the dynamic memory needed for storing the properties of
      * @p size particles.
@@ -211,12 +300,31 @@ namespace Particles
     unsigned int
     n_properties_per_slot() const;
 
+    /**
+     * Return the layout in which the properties are stored.
+     */
+    Layout
+    get_layout() const;
+
   private:
     /**
      * The number of properties that are reserved per particle.
      */
     const unsigned int n_properties;
 
+    /**
+     * The layout in which the properties are stored.
+     */
+    const Layout layout;
+
+    /**
+     * For the Layout::structure_of_arrays layout, the number of slots for
+     * which each of the arrays of property values inside `properties` has
+     * space. The value of property `c` for handle `h` is then stored at
+     * index `c * slot_capacity + h`. Unused for the other layout.
+     */
+    std::size_t slot_capacity;
+
     /**
      * A vector that stores the locations of particles. It is indexed in the
      * same way as the `reference_locations` and `properties` arrays, i.e., via
@@ -253,6 +361,12 @@ namespace Particles
      * to avoid memory allocation.
      */
     std::vector<Handle> currently_available_handles;
+    /**
+     * For the Layout::structure_of_arrays layout, move the property values
+     * into arrays with space for @p new_slot_capacity slots each.
+     */
+    void
+    set_slot_capacity(const std::size_t new_slot_capacity);
   };
 
 
@@ -414,6 +528,10 @@ namespace Particles
     // just check against the array range, and rely on the fact
     // that handles are invalidated when handed over to
     // deallocate_properties_array().
+    Assert(layout == array_of_structures,
+           ExcMessage("The properties of a single particle are only stored "
+                      "contiguously in the array-of-structures layout. Use "
+                      "get_property_view() instead."));
     Assert(data_index <= properties.size() - n_properties,
            ExcMessage("Invalid property handle. This can happen if the "
                       "handle was duplicated and then one copy was deallocated "
@@ -423,6 +541,76 @@ namespace Particles
   }
 
 
+
+  template <int dim, int spacedim>
+  inline StridedArrayView<double, 1>
+  PropertyPool<dim, spacedim>::get_property_view(const Handle handle)
+  {
+    const std::vector<double>::size_type slot =
+      (handle != invalid_handle) ? handle : 0;
+
+    // See get_location() for why we can only check against the array range
+    Assert(slot <= locations.size() - 1,
+           ExcMessage("Invalid property handle. This can happen if the "
+                      "handle was duplicated and then one copy was deallocated "
+                      "before trying to access the properties."));
+
+    if (layout == array_of_structures)
+      return StridedArrayView<double, 1>(properties.data() +
+                                           slot * n_properties,
+                                         {{n_properties}});
+    else
+      return StridedArrayView<double, 1>(properties.data() + slot,
+                                         {{n_properties}},
+                                         {{slot_capacity}});
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline StridedArrayView<const double, 1>
+  PropertyPool<dim, spacedim>::get_property_view(const Handle handle) const
+  {
+    return const_cast<PropertyPool<dim, spacedim> *>(this)->get_property_view(
+      handle);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline ArrayView<double>
+  PropertyPool<dim, spacedim>::get_property_values(
+    const unsigned int component,
+    const Handle       first_handle,
+    const unsigned int n_handles)
+  {
+    Assert(layout == structure_of_arrays,
+           ExcMessage("The values of one property of several particles are "
+                      "only stored contiguously in the structure-of-arrays "
+                      "layout."));
+    AssertIndexRange(component, n_properties);
+    AssertIndexRange(std::size_t(first_handle) + n_handles,
+                     locations.size() + 1);
+
+    return ArrayView<double>(properties.data() + component * slot_capacity +
+                               first_handle,
+                             n_handles);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline ArrayView<const double>
+  PropertyPool<dim, spacedim>::get_property_values(
+    const unsigned int component,
+    const Handle       first_handle,
+    const unsigned int n_handles) const
+  {
+    return const_cast<PropertyPool<dim, spacedim> *>(this)
+      ->get_property_values(component, first_handle, n_handles);
+  }
+
+
 } // namespace Particles
 
 DEAL_II_NAMESPACE_CLOSE
@@ -21,16 +21,19 @@
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
 #include <deal.II/fe/component_mask.h>
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_point_evaluation.h>
 #include <deal.II/fe/mapping_q1.h>
 
 #include <deal.II/grid/grid_tools_cache.h>
 
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
 
 #include <deal.II/particles/particle_handler.h>
 
@@ -252,6 +255,307 @@ namespace Particles
       interpolated_field.compress(VectorOperation::add);
     }
 
+
+
+    /**
+     * Evaluate the finite element field @p field_vector at the locations of
+     * all locally owned particles and store the values in the particle
+     * properties with indices <code>first_property</code>, ...,
+     * <code>first_property + n_components - 1</code>.
+     *
+     * The field is evaluated with an FEPointEvaluation object for the
+     * components <code>first_selected_component</code>, ...,
+     * <code>first_selected_component + n_components - 1</code> of the finite
+     * element of @p dof_handler, using the reference locations that the
+     * particles store. These have to be up to date, i.e., the particles have
+     * to be sorted into their cells by
+     * ParticleHandler::sort_particles_into_subdomains_and_cells() after they
+     * were moved. The cells are processed in parallel via WorkStream::run(),
+     * and each thread reuses its FEPointEvaluation object for all of its
+     * cells.
+     *
+     * In parallel computations, @p field_vector must contain the values of
+     * the ghost entries of the locally owned cells.
+     */
+    template <int n_components, int dim, typename VectorType>
+    void
+    interpolate_field_to_particle_properties(
+      const Mapping<dim> &    mapping,
+      const DoFHandler<dim> & dof_handler,
+      const VectorType &      field_vector,
+      ParticleHandler<dim> &  particle_handler,
+      const unsigned int      first_property,
+      const unsigned int      first_selected_component = 0);
+
+    /**
+     * Deposit the particle properties with indices
+     * <code>first_property</code>, ..., <code>first_property +
+     * n_components - 1</code> of all locally owned particles into the finite
+     * element vector @p field_vector, i.e., add
+     * \f[
+     *   F_i \mathrel{+}= \sum_p \mathbf v_i(\mathbf x_p) \cdot
+     *   \mathbf q_p
+     * \f]
+     * for each degree of freedom $i$, where $\mathbf x_p$ is the location
+     * of particle $p$ and $\mathbf q_p$ the vector of the selected
+     * properties. Only the components <code>first_selected_component</code>,
+     * ..., <code>first_selected_component + n_components - 1</code> of the
+     * finite element of @p dof_handler are considered.
+     *
+     * This is the transpose of interpolate_field_to_particle_properties().
+     * The local contributions of each cell are computed in parallel via
+     * WorkStream::run() with FEPointEvaluation::integrate(), and added into
+     * @p field_vector with @p constraints. Since particles in locally owned
+     * cells also contribute to degrees of freedom owned by other processes,
+     * the function ends with a call to
+     * <code>field_vector.compress(VectorOperation::add)</code>.
+     */
+    template <int n_components, int dim, typename VectorType>
+    void
+    deposit_particle_properties(
+      const Mapping<dim> &        mapping,
+      const DoFHandler<dim> &     dof_handler,
+      const ParticleHandler<dim> &particle_handler,
+      const unsigned int          first_property,
+      VectorType &                field_vector,
+      const AffineConstraints<typename VectorType::value_type> &constraints,
+      const unsigned int first_selected_component = 0);
+
+
+
+#ifndef DOXYGEN
+    namespace internal
+    {
+      /**
+       * Return component @p c of a value of FEPointEvaluation, which is a
+       * scalar for a single component and a tensor otherwise.
+       */
+      inline double
+      get_component(const double value, const unsigned int)
+      {
+        return value;
+      }
+
+
+
+      template <int n_components>
+      inline double
+      get_component(const Tensor<1, n_components> &value, const unsigned int c)
+      {
+        return value[c];
+      }
+
+
+
+      inline void
+      set_component(double &value, const unsigned int, const double entry)
+      {
+        value = entry;
+      }
+
+
+
+      template <int n_components>
+      inline void
+      set_component(Tensor<1, n_components> &value,
+                    const unsigned int       c,
+                    const double             entry)
+      {
+        value[c] = entry;
+      }
+
+
+
+      /**
+       * Scratch data for the functions evaluating fields at particles or
+       * depositing particle properties, holding one FEPointEvaluation object
+       * per thread.
+       */
+      template <int n_components, int dim>
+      struct ParticleEvaluationScratch
+      {
+        ParticleEvaluationScratch(const Mapping<dim> &      mapping,
+                                  const FiniteElement<dim> &fe,
+                                  const unsigned int first_selected_component)
+          : mapping(&mapping)
+          , fe(&fe)
+          , first_selected_component(first_selected_component)
+          , evaluator(std::make_unique<FEPointEvaluation<n_components, dim>>(
+              mapping,
+              fe,
+              first_selected_component))
+          , local_values(fe.n_dofs_per_cell())
+        {}
+
+        ParticleEvaluationScratch(const ParticleEvaluationScratch &scratch)
+          : ParticleEvaluationScratch(*scratch.mapping,
+                                      *scratch.fe,
+                                      scratch.first_selected_component)
+        {}
+
+        const Mapping<dim> *       mapping;
+        const FiniteElement<dim> * fe;
+        const unsigned int         first_selected_component;
+        std::unique_ptr<FEPointEvaluation<n_components, dim>> evaluator;
+        std::vector<Point<dim>> reference_locations;
+        Vector<double>          local_values;
+      };
+
+
+
+      /**
+       * Copy data for deposit_particle_properties().
+       */
+      struct ParticleDepositionCopyData
+      {
+        std::vector<types::global_dof_index> dof_indices;
+        Vector<double>                       cell_rhs;
+      };
+    } // namespace internal
+
+
+
+    template <int n_components, int dim, typename VectorType>
+    void
+    interpolate_field_to_particle_properties(
+      const Mapping<dim> &    mapping,
+      const DoFHandler<dim> & dof_handler,
+      const VectorType &      field_vector,
+      ParticleHandler<dim> &  particle_handler,
+      const unsigned int      first_property,
+      const unsigned int      first_selected_component)
+    {
+      AssertIndexRange(first_property + n_components - 1,
+                       particle_handler.n_properties_per_particle());
+      AssertIndexRange(first_selected_component + n_components - 1,
+                       dof_handler.get_fe().n_components());
+
+      using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+      using Scratch = internal::ParticleEvaluationScratch<n_components, dim>;
+
+      // Each cell only writes to the properties of its own particles, so
+      // there is nothing to be done in the copier
+      const auto worker =
+        [&](const CellIterator &cell, Scratch &scratch, unsigned int &) {
+          if (!cell->is_locally_owned() ||
+              particle_handler.n_particles_in_cell(cell) == 0)
+            return;
+
+          const auto particles = particle_handler.particles_in_cell(cell);
+
+          scratch.reference_locations.clear();
+          for (const auto &particle : particles)
+            scratch.reference_locations.push_back(
+              particle.get_reference_location());
+
+          cell->get_dof_values(field_vector, scratch.local_values);
+          scratch.evaluator->evaluate(
+            cell,
+            scratch.reference_locations,
+            make_array_view(scratch.local_values),
+            EvaluationFlags::values);
+
+          unsigned int q = 0;
+          for (auto &particle : particles)
+            {
+              const StridedArrayView<double, 1> properties =
+                particle.get_property_view();
+              const auto &value = scratch.evaluator->get_value(q++);
+              for (unsigned int c = 0; c < n_components; ++c)
+                properties(first_property + c) =
+                  internal::get_component(value, c);
+            }
+        };
+
+      unsigned int dummy_copy_data = 0;
+      WorkStream::run(dof_handler.begin_active(),
+                      static_cast<CellIterator>(dof_handler.end()),
+                      worker,
+                      [](const unsigned int &) {},
+                      Scratch(mapping,
+                              dof_handler.get_fe(),
+                              first_selected_component),
+                      dummy_copy_data);
+    }
+
+
+
+    template <int n_components, int dim, typename VectorType>
+    void
+    deposit_particle_properties(
+      const Mapping<dim> &        mapping,
+      const DoFHandler<dim> &     dof_handler,
+      const ParticleHandler<dim> &particle_handler,
+      const unsigned int          first_property,
+      VectorType &                field_vector,
+      const AffineConstraints<typename VectorType::value_type> &constraints,
+      const unsigned int first_selected_component)
+    {
+      AssertIndexRange(first_property + n_components - 1,
+                       particle_handler.n_properties_per_particle());
+      AssertIndexRange(first_selected_component + n_components - 1,
+                       dof_handler.get_fe().n_components());
+
+      using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+      using Scratch  = internal::ParticleEvaluationScratch<n_components, dim>;
+      using CopyData = internal::ParticleDepositionCopyData;
+
+      const auto worker =
+        [&](const CellIterator &cell, Scratch &scratch, CopyData &copy_data) {
+          copy_data.dof_indices.clear();
+          if (!cell->is_locally_owned() ||
+              particle_handler.n_particles_in_cell(cell) == 0)
+            return;
+
+          const auto particles = particle_handler.particles_in_cell(cell);
+
+          scratch.reference_locations.clear();
+          unsigned int q = 0;
+          for (const auto &particle : particles)
+            {
+              scratch.reference_locations.push_back(
+                particle.get_reference_location());
+
+              const StridedArrayView<const double, 1> properties =
+                particle.get_property_view();
+              typename FEPointEvaluation<n_components, dim>::value_type value;
+              for (unsigned int c = 0; c < n_components; ++c)
+                internal::set_component(value,
+                                        c,
+                                        properties(first_property + c));
+              scratch.evaluator->submit_value(value, q++);
+            }
+
+          copy_data.cell_rhs.reinit(cell->get_fe().n_dofs_per_cell());
+          scratch.evaluator->integrate(cell,
+                                       scratch.reference_locations,
+                                       make_array_view(copy_data.cell_rhs),
+                                       EvaluationFlags::values);
+
+          copy_data.dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+          cell->get_dof_indices(copy_data.dof_indices);
+        };
+
+      const auto copier = [&](const CopyData &copy_data) {
+        if (!copy_data.dof_indices.empty())
+          constraints.distribute_local_to_global(copy_data.cell_rhs,
+                                                 copy_data.dof_indices,
+                                                 field_vector);
+      };
+
+      WorkStream::run(dof_handler.begin_active(),
+                      static_cast<CellIterator>(dof_handler.end()),
+                      worker,
+                      copier,
+                      Scratch(mapping,
+                              dof_handler.get_fe(),
+                              first_selected_component),
+                      CopyData());
+
+      field_vector.compress(VectorOperation::add);
+    }
+#endif
+
   } // namespace Utilities
 } // namespace Particles
 DEAL_II_NAMESPACE_CLOSE
@@ -1024,6 +1024,13 @@ namespace SUNDIALS
      * The user must specify this function if a non-identity mass matrix is used
      * and applied in mass_times_vector().
      *
+     * @note If the mass matrix does not change in time, set
+     *   AdditionalData::mass_is_time_independent. ARKode then sets up the mass
+     *   solver only once, and operators and preconditioners used in this
+     *   function, e.g., a matrix-free inverse mass operator such as
+     *   MatrixFreeOperators::CellwiseInverseMassMatrix, can be created once
+     *   and reused for all solves.
+     *
      * For more details on the function type refer to LinearSolveFunction.
      */
     LinearSolveFunction<VectorType> solve_mass;
@@ -1086,6 +1093,12 @@ namespace SUNDIALS
      *   jacobian_preconditioner_setup() it is possible to call
      *   jacobian_preconditioner_solve().
      *
+     * @note ARKode calls this function whenever $\gamma$ changes, e.g.,
+     *   after every change of the step size, even if the Jacobian $J$ itself
+     *   can be reused (@p jok is SUNTRUE). SUNDIALS::CachedPreconditioner can
+     *   be used to keep an expensive preconditioner as long as $\gamma$ only
+     *   changes slightly.
+     *
      * @param[in] t  The current time
      * @param[in] y  The current $y$ vector for the current ARKode internal
      *   step
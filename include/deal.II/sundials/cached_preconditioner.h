@@ -0,0 +1,242 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2021 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_cached_preconditioner_h
+#define dealii_sundials_cached_preconditioner_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  /**
+   * A helper class that stores a preconditioner for the linear systems
+   * $M-\gamma J$ (ARKode) or $\partial F/\partial y + \alpha \partial
+   * F/\partial \dot y$ (IDA) that appear in the nonlinear solvers of
+   * SUNDIALS, and that only rebuilds it when this is actually necessary.
+   *
+   * The setup functions of the time integrators, e.g.
+   * ARKode::jacobian_preconditioner_setup() or IDA::setup_jacobian(), are
+   * called whenever SUNDIALS decides that the linear solver needs to be
+   * updated. This happens, for example, after every change of the time step
+   * size, since the factor $\gamma$ (or $\alpha$) changes with it. Setting
+   * up expensive preconditioners such as algebraic multigrid or Chebyshev
+   * smoothers in each of these calls is often not necessary: small changes
+   * of $\gamma$ only slightly degrade the quality of the preconditioner,
+   * which is then compensated by a few more iterations of the Krylov
+   * solver.
+   *
+   * This class rebuilds the preconditioner if it has not been built yet, if
+   * the caller indicates that the Jacobian has changed, or if the relative
+   * change of $\gamma$ since the last rebuild exceeds a given tolerance. A
+   * typical use within ARKode looks as follows:
+   * @code
+   * SUNDIALS::CachedPreconditioner<TrilinosWrappers::PreconditionAMG>
+   *   preconditioner(0.2);
+   *
+   * ode.jacobian_preconditioner_setup = [&](const double      t,
+   *                                         const VectorType &y,
+   *                                         const VectorType &fy,
+   *                                         const int         jok,
+   *                                         int &             jcur,
+   *                                         const double      gamma) {
+   *   // only assemble a new Jacobian if ARKode asks for it
+   *   if (!jok)
+   *     assemble_jacobian(t, y);
+   *   jcur = !jok;
+   *
+   *   preconditioner.update(gamma, !jok, [&](auto &amg, const double gamma) {
+   *     assemble_system_matrix(gamma); // M - gamma J
+   *     amg.initialize(system_matrix);
+   *   });
+   *   return 0;
+   * };
+   * @endcode
+   * The preconditioner can then be applied through vmult() or accessed
+   * through get(), e.g., in ARKode::jacobian_preconditioner_solve().
+   *
+   * @tparam PreconditionerType The type of the stored preconditioner. It
+   *   needs to be default constructible.
+   */
+  template <typename PreconditionerType>
+  class CachedPreconditioner : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. @p gamma_tolerance is the largest relative change of
+     * $\gamma$, i.e., $|\gamma/\gamma_\text{last}-1|$, for which the
+     * preconditioner built for $\gamma_\text{last}$ is still used.
+     * Setting it to zero rebuilds the preconditioner for every change of
+     * $\gamma$.
+     */
+    CachedPreconditioner(const double gamma_tolerance = 0.2);
+
+    /**
+     * Make sure the preconditioner is usable for the factor @p gamma.
+     *
+     * The function @p rebuild is called with the stored preconditioner and
+     * @p gamma if no preconditioner has been built yet, if
+     * @p jacobian_changed is true, or if @p gamma differs from the value of
+     * the last rebuild by more than the tolerance given to the constructor.
+     * Otherwise, the existing preconditioner is kept.
+     *
+     * @return Whether the preconditioner has been rebuilt.
+     */
+    bool
+    update(const double gamma,
+           const bool   jacobian_changed,
+           const std::function<void(PreconditionerType &, const double)>
+             &rebuild);
+
+    /**
+     * Return the stored preconditioner. update() must have been called
+     * before.
+     */
+    const PreconditionerType &
+    get() const;
+
+    /**
+     * Apply the stored preconditioner, i.e., forward to
+     * <tt>PreconditionerType::vmult()</tt>.
+     */
+    template <typename VectorType>
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the value of $\gamma$ for which the preconditioner was last
+     * rebuilt.
+     */
+    double
+    get_gamma() const;
+
+    /**
+     * Delete the stored preconditioner, so that the next call to update()
+     * rebuilds it. This should be called, e.g., after the mesh has changed.
+     */
+    void
+    clear();
+
+  private:
+    /**
+     * The tolerance given to the constructor.
+     */
+    const double gamma_tolerance;
+
+    /**
+     * The value of $\gamma$ of the last rebuild.
+     */
+    double gamma;
+
+    /**
+     * The stored preconditioner.
+     */
+    std::unique_ptr<PreconditionerType> preconditioner;
+  };
+
+
+
+  /* ------------------------- inline functions ---------------------- */
+
+#ifndef DOXYGEN
+
+  template <typename PreconditionerType>
+  inline CachedPreconditioner<PreconditionerType>::CachedPreconditioner(
+    const double gamma_tolerance)
+    : gamma_tolerance(gamma_tolerance)
+    , gamma(0.)
+  {
+    Assert(gamma_tolerance >= 0.,
+           ExcMessage("The tolerance must not be negative."));
+  }
+
+
+
+  template <typename PreconditionerType>
+  inline bool
+  CachedPreconditioner<PreconditionerType>::update(
+    const double gamma,
+    const bool   jacobian_changed,
+    const std::function<void(PreconditionerType &, const double)> &rebuild)
+  {
+    const double gamma_change = std::abs(gamma - this->gamma);
+    if (preconditioner != nullptr && !jacobian_changed &&
+        gamma_change <= gamma_tolerance * std::abs(this->gamma))
+      return false;
+
+    if (preconditioner == nullptr)
+      preconditioner = std::make_unique<PreconditionerType>();
+    rebuild(*preconditioner, gamma);
+    this->gamma = gamma;
+
+    return true;
+  }
+
+
+
+  template <typename PreconditionerType>
+  inline const PreconditionerType &
+  CachedPreconditioner<PreconditionerType>::get() const
+  {
+    Assert(preconditioner != nullptr,
+           ExcMessage("The preconditioner has not been built yet."));
+    return *preconditioner;
+  }
+
+
+
+  template <typename PreconditionerType>
+  template <typename VectorType>
+  inline void
+  CachedPreconditioner<PreconditionerType>::vmult(VectorType &      dst,
+                                                  const VectorType &src) const
+  {
+    get().vmult(dst, src);
+  }
+
+
+
+  template <typename PreconditionerType>
+  inline double
+  CachedPreconditioner<PreconditionerType>::get_gamma() const
+  {
+    return gamma;
+  }
+
+
+
+  template <typename PreconditionerType>
+  inline void
+  CachedPreconditioner<PreconditionerType>::clear()
+  {
+    preconditioner.reset();
+    gamma = 0.;
+  }
+
+#endif
+
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
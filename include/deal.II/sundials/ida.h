@@ -663,6 +663,12 @@ namespace SUNDIALS
      * setup_jacobian() it is possible to call solve_jacobian_system(), to
      * obtain a solution $x$ to the system $J x = b$.
      *
+     * Since $\alpha$ depends on the time step size and on the order of the
+     * BDF scheme, this function is also called when only $\alpha$ has
+     * changed. SUNDIALS::CachedPreconditioner can be used to rebuild an
+     * expensive preconditioner only if $\alpha$ changes by more than a given
+     * relative tolerance.
+     *
      * This function should return:
      * - 0: Success
      * - >0: Recoverable error (IDAReinit will be called if this happens, and
@@ -135,6 +135,65 @@ namespace SUNDIALS
     N_Vector
     create_empty_nvector();
 
+    /**
+     * A traits class that determines whether the locally owned elements of
+     * a vector type are stored in one or several
+     * LinearAlgebra::distributed::Vector objects. For these types, the fused
+     * vector operations of SUNDIALS are implemented directly on the local
+     * data, in a single pass and with at most one global reduction.
+     */
+    template <typename VectorType>
+    struct HasLocalElementAccess : std::false_type
+    {};
+
+    template <typename Number>
+    struct HasLocalElementAccess<LinearAlgebra::distributed::Vector<Number>>
+      : std::true_type
+    {};
+
+    template <typename Number>
+    struct HasLocalElementAccess<
+      LinearAlgebra::distributed::BlockVector<Number>> : std::true_type
+    {};
+
+    /**
+     * Return pointers to the LinearAlgebra::distributed::Vector objects that
+     * make up @p v, i.e., @p v itself or its blocks.
+     */
+    template <typename Number>
+    std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+    get_local_blocks(const LinearAlgebra::distributed::Vector<Number> &v)
+    {
+      return {&v};
+    }
+
+    template <typename Number>
+    std::vector<LinearAlgebra::distributed::Vector<Number> *>
+    get_local_blocks(LinearAlgebra::distributed::Vector<Number> &v)
+    {
+      return {&v};
+    }
+
+    template <typename Number>
+    std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+    get_local_blocks(const LinearAlgebra::distributed::BlockVector<Number> &v)
+    {
+      std::vector<const LinearAlgebra::distributed::Vector<Number> *> blocks;
+      for (unsigned int b = 0; b < v.n_blocks(); ++b)
+        blocks.push_back(&v.block(b));
+      return blocks;
+    }
+
+    template <typename Number>
+    std::vector<LinearAlgebra::distributed::Vector<Number> *>
+    get_local_blocks(LinearAlgebra::distributed::BlockVector<Number> &v)
+    {
+      std::vector<LinearAlgebra::distributed::Vector<Number> *> blocks;
+      for (unsigned int b = 0; b < v.n_blocks(); ++b)
+        blocks.push_back(&v.block(b));
+      return blocks;
+    }
+
     /**
      * Collection of all operations specified by SUNDIALS N_Vector
      * documentation. These functions are attached to the generic N_Vector
@@ -250,6 +309,41 @@ namespace SUNDIALS
       void
       add_constant(N_Vector x, realtype b, N_Vector z);
 
+      template <typename VectorType>
+      int
+      linear_combination(int n_vectors, realtype *c, N_Vector *X, N_Vector z);
+
+      template <typename VectorType>
+      int
+      scale_add_multi(int       n_vectors,
+                      realtype *a,
+                      N_Vector  x,
+                      N_Vector *Y,
+                      N_Vector *Z);
+
+      template <typename VectorType>
+      int
+      dot_product_multi(int n_vectors, N_Vector x, N_Vector *Y, realtype *d);
+
+      /**
+       * Attach the fused operations above to @p v if they are implemented
+       * for @p VectorType, otherwise leave them unset so that SUNDIALS falls
+       * back to the standard vector operations.
+       */
+      template <typename VectorType,
+                typename std::enable_if_t<
+                  HasLocalElementAccess<VectorType>::value,
+                  int> = 0>
+      void
+      set_fused_operations(N_Vector v);
+
+      template <typename VectorType,
+                typename std::enable_if_t<
+                  !HasLocalElementAccess<VectorType>::value,
+                  int> = 0>
+      void
+      set_fused_operations(N_Vector v);
+
       template <
         typename VectorType,
         typename std::enable_if_t<!IsBlockVector<VectorType>::value, int> = 0>
@@ -599,6 +693,140 @@ SUNDIALS::internal::NVectorOperations::add_constant(N_Vector x,
 
 
 
+template <typename VectorType>
+int
+SUNDIALS::internal::NVectorOperations::linear_combination(int       n_vectors,
+                                                          realtype *c,
+                                                          N_Vector *X,
+                                                          N_Vector  z)
+{
+  using Number    = typename VectorType::value_type;
+  using BlockType = LinearAlgebra::distributed::Vector<Number>;
+
+  std::vector<std::vector<const BlockType *>> x_blocks(n_vectors);
+  for (int j = 0; j < n_vectors; ++j)
+    x_blocks[j] = get_local_blocks(*unwrap_nvector_const<VectorType>(X[j]));
+  const std::vector<BlockType *> z_blocks =
+    get_local_blocks(*unwrap_nvector<VectorType>(z));
+
+  // Compute z = sum_j c_j X_j in a single pass over all vectors. z may be
+  // the same vector as X[0], which is safe since each entry of z is only
+  // written after all vectors have been read at that position.
+  for (unsigned int b = 0; b < z_blocks.size(); ++b)
+    for (unsigned int i = 0; i < z_blocks[b]->locally_owned_size(); ++i)
+      {
+        Number sum = c[0] * x_blocks[0][b]->local_element(i);
+        for (int j = 1; j < n_vectors; ++j)
+          sum += c[j] * x_blocks[j][b]->local_element(i);
+        z_blocks[b]->local_element(i) = sum;
+      }
+
+  return 0;
+}
+
+
+
+template <typename VectorType>
+int
+SUNDIALS::internal::NVectorOperations::scale_add_multi(int       n_vectors,
+                                                       realtype *a,
+                                                       N_Vector  x,
+                                                       N_Vector *Y,
+                                                       N_Vector *Z)
+{
+  using Number    = typename VectorType::value_type;
+  using BlockType = LinearAlgebra::distributed::Vector<Number>;
+
+  const std::vector<const BlockType *> x_blocks =
+    get_local_blocks(*unwrap_nvector_const<VectorType>(x));
+  std::vector<std::vector<const BlockType *>> y_blocks(n_vectors);
+  std::vector<std::vector<BlockType *>>       z_blocks(n_vectors);
+  for (int j = 0; j < n_vectors; ++j)
+    {
+      y_blocks[j] = get_local_blocks(*unwrap_nvector_const<VectorType>(Y[j]));
+      z_blocks[j] = get_local_blocks(*unwrap_nvector<VectorType>(Z[j]));
+    }
+
+  // Compute Z_j = a_j x + Y_j for all j, reading x only once. Z_j may be the
+  // same vector as Y_j.
+  for (unsigned int b = 0; b < x_blocks.size(); ++b)
+    for (unsigned int i = 0; i < x_blocks[b]->locally_owned_size(); ++i)
+      {
+        const Number x_i = x_blocks[b]->local_element(i);
+        for (int j = 0; j < n_vectors; ++j)
+          z_blocks[j][b]->local_element(i) =
+            a[j] * x_i + y_blocks[j][b]->local_element(i);
+      }
+
+  return 0;
+}
+
+
+
+template <typename VectorType>
+int
+SUNDIALS::internal::NVectorOperations::dot_product_multi(int       n_vectors,
+                                                         N_Vector  x,
+                                                         N_Vector *Y,
+                                                         realtype *d)
+{
+  using Number    = typename VectorType::value_type;
+  using BlockType = LinearAlgebra::distributed::Vector<Number>;
+
+  const std::vector<const BlockType *> x_blocks =
+    get_local_blocks(*unwrap_nvector_const<VectorType>(x));
+  std::vector<std::vector<const BlockType *>> y_blocks(n_vectors);
+  for (int j = 0; j < n_vectors; ++j)
+    y_blocks[j] = get_local_blocks(*unwrap_nvector_const<VectorType>(Y[j]));
+
+  // Compute the local parts of all dot products in one pass over x ...
+  std::fill(d, d + n_vectors, 0.);
+  for (unsigned int b = 0; b < x_blocks.size(); ++b)
+    for (unsigned int i = 0; i < x_blocks[b]->locally_owned_size(); ++i)
+      {
+        const Number x_i = x_blocks[b]->local_element(i);
+        for (int j = 0; j < n_vectors; ++j)
+          d[j] += x_i * y_blocks[j][b]->local_element(i);
+      }
+
+  // ... and sum them up with a single reduction
+  Utilities::MPI::sum(ArrayView<const realtype>(d, n_vectors),
+                      get_communicator<VectorType>(x),
+                      ArrayView<realtype>(d, n_vectors));
+
+  return 0;
+}
+
+
+
+template <typename VectorType,
+          std::enable_if_t<
+            SUNDIALS::internal::HasLocalElementAccess<VectorType>::value,
+            int>>
+void
+SUNDIALS::internal::NVectorOperations::set_fused_operations(N_Vector v)
+{
+#  if DEAL_II_SUNDIALS_VERSION_GTE(5, 0, 0)
+  v->ops->nvlinearcombination = linear_combination<VectorType>;
+  v->ops->nvscaleaddmulti     = scale_add_multi<VectorType>;
+  v->ops->nvdotprodmulti      = dot_product_multi<VectorType>;
+#  else
+  (void)v;
+#  endif
+}
+
+
+
+template <typename VectorType,
+          std::enable_if_t<
+            !SUNDIALS::internal::HasLocalElementAccess<VectorType>::value,
+            int>>
+void
+SUNDIALS::internal::NVectorOperations::set_fused_operations(N_Vector)
+{}
+
+
+
 template <typename VectorType>
 void
 SUNDIALS::internal::NVectorOperations::elementwise_product(N_Vector x,
@@ -919,7 +1147,9 @@ SUNDIALS::internal::create_empty_nvector()
   //  v->ops->nvconstrmask   = undef;
   //  v->ops->nvminquotient  = undef;
 
-  /* fused and vector array operations are disabled (NULL) by default */
+  /* fused operations are only available for some vector types, vector
+   * array operations are disabled (NULL) by default */
+  NVectorOperations::set_fused_operations<VectorType>(v);
 
   /* local reduction operations */
   //  v->ops->nvdotprodlocal     = undef;
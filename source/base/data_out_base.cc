@@ -34,6 +34,8 @@
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_tags.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -62,6 +64,10 @@
 #  include <hdf5.h>
 #endif
 
+#ifdef DEAL_II_WITH_ADIOS2
+#  include <adios2.h>
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -107,6 +113,11 @@ namespace
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
    * result is then written to the given stream.
+   *
+   * The data is split into blocks of VtkFlags::compression_block_size bytes
+   * (or a single block if that is zero) that are compressed independently
+   * and in parallel, as allowed by the header format of compressed data in
+   * VTK XML files.
    */
   template <typename T>
   void
@@ -116,40 +127,128 @@ namespace
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(data.size() * sizeof(T));
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err =
-          compress2(&compressed_data[0],
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
-
-        // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        const std::size_t n_bytes = data.size() * sizeof(T);
+        const std::size_t block_size =
+          ((flags.compression_block_size == 0) ||
+           (flags.compression_block_size > n_bytes)) ?
+            n_bytes :
+            flags.compression_block_size;
+        const std::size_t n_blocks = (n_bytes + block_size - 1) / block_size;
+        const std::size_t last_block_size =
+          n_bytes - (n_blocks - 1) * block_size;
+        AssertThrow(block_size <= std::numeric_limits<uint32_t>::max(),
+                    ExcMessage("The VTK file format can only represent "
+                               "blocks of compressed data smaller than 4GB. "
+                               "Choose a smaller compression block size."));
+
+        // allocate a buffer for compressing each block and do so, on
+        // as many threads as there are blocks to work on
+        std::vector<std::vector<unsigned char>> compressed_blocks(n_blocks);
+        const auto *const uncompressed_data =
+          reinterpret_cast<const Bytef *>(data.data());
+        const int compression_level =
+          get_zlib_compression_level(flags.compression_level);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t block = begin; block < end; ++block)
+              {
+                const uLong this_block_size =
+                  (block == n_blocks - 1) ? last_block_size : block_size;
+                auto compressed_data_length = compressBound(this_block_size);
+                compressed_blocks[block].resize(compressed_data_length);
+
+                int err = compress2(compressed_blocks[block].data(),
+                                    &compressed_data_length,
+                                    uncompressed_data + block * block_size,
+                                    this_block_size,
+                                    compression_level);
+                (void)err;
+                Assert(err == Z_OK, ExcInternalError());
+
+                // Discard the unnecessary bytes
+                compressed_blocks[block].resize(compressed_data_length);
+              }
+          },
+          1);
+
+        // now encode the compression header: the number of blocks, the
+        // size of a block, the size of the last block, and the list of
+        // compressed sizes of the blocks
+        std::vector<uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = static_cast<uint32_t>(n_blocks);
+        compression_header[1] = static_cast<uint32_t>(block_size);
+        compression_header[2] = static_cast<uint32_t>(last_block_size);
+        std::size_t total_compressed_size = 0;
+        for (std::size_t block = 0; block < n_blocks; ++block)
+          {
+            compression_header[3 + block] =
+              static_cast<uint32_t>(compressed_blocks[block].size());
+            total_compressed_size += compressed_blocks[block].size();
+          }
 
         const auto header_start =
-          reinterpret_cast<const unsigned char *>(&compression_header[0]);
+          reinterpret_cast<const unsigned char *>(compression_header.data());
+
+        // the blocks are encoded as one contiguous stream of bytes
+        std::vector<unsigned char> compressed_data;
+        if (n_blocks == 1)
+          compressed_data.swap(compressed_blocks[0]);
+        else
+          {
+            compressed_data.reserve(total_compressed_size);
+            for (const auto &block : compressed_blocks)
+              compressed_data.insert(compressed_data.end(),
+                                     block.begin(),
+                                     block.end());
+          }
 
         output_stream << Utilities::encode_base64(
-                           {header_start, header_start + 4 * sizeof(uint32_t)})
+                           {header_start,
+                            header_start +
+                              compression_header.size() * sizeof(uint32_t)})
                       << Utilities::encode_base64(compressed_data);
       }
   }
 #endif
+
+#ifdef DEAL_II_WITH_HDF5
+  /**
+   * Create the property list for the creation of a dataset with @p n_rows
+   * rows and @p n_columns columns, using chunked storage and compression as
+   * requested by the given flags. The caller has to close the returned
+   * property list.
+   */
+  hid_t
+  create_hdf5_dataset_properties(const DataOutBase::DataOutFilterFlags &flags,
+                                 const hsize_t                          n_rows,
+                                 const hsize_t n_columns)
+  {
+    const hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+    AssertThrow(plist_id >= 0, ExcIO());
+
+    // chunks can not be empty, so empty datasets are stored contiguously
+    if (((flags.hdf5_chunk_size > 0) || (flags.hdf5_compression_level > 0)) &&
+        (n_rows > 0) && (n_columns > 0))
+      {
+        const hsize_t chunk_rows =
+          (flags.hdf5_chunk_size > 0) ? flags.hdf5_chunk_size : 65536;
+        const hsize_t chunk_dims[2] = {std::min(chunk_rows, n_rows),
+                                       n_columns};
+        herr_t        status        = H5Pset_chunk(plist_id, 2, chunk_dims);
+        AssertThrow(status >= 0, ExcIO());
+
+        if (flags.hdf5_compression_level > 0)
+          {
+            status = H5Pset_deflate(plist_id, flags.hdf5_compression_level);
+            AssertThrow(status >= 0, ExcIO());
+          }
+      }
+
+    return plist_id;
+  }
+#endif
 } // namespace
 
 
@@ -449,6 +548,14 @@ namespace DataOutBase
 
 
 
+  const DataOutBase::DataOutFilterFlags &
+  DataOutFilter::get_flags() const
+  {
+    return flags;
+  }
+
+
+
   void
   DataOutFilter::flush_points()
   {}
@@ -546,6 +653,174 @@ namespace DataOutBase
           }
       }
   }
+
+
+
+#ifdef DEAL_II_WITH_ADIOS2
+  struct ADIOS2Writer::Implementation
+  {
+    Implementation(const MPI_Comm &comm)
+      : comm(comm)
+#  ifdef DEAL_II_WITH_MPI
+      , adios(comm)
+#  endif
+    {}
+
+    /**
+     * Set the global shape and the part of this process of the array
+     * variable @p name, defining the variable in the first step, and hand
+     * the data of this process over to the engine.
+     */
+    template <typename Number>
+    void
+    put(const std::string & name,
+        const adios2::Dims &shape,
+        const adios2::Dims &start,
+        const adios2::Dims &count,
+        const Number *      data)
+    {
+      adios2::Variable<Number> variable = io.InquireVariable<Number>(name);
+      if (variable)
+        {
+          variable.SetShape(shape);
+          variable.SetSelection({start, count});
+        }
+      else
+        variable = io.DefineVariable<Number>(name, shape, start, count);
+
+      // the data is copied to the buffers of ADIOS2 right away, so the
+      // caller may release its arrays before the step is completed
+      if (count[0] > 0)
+        engine.Put(variable, data, adios2::Mode::Sync);
+    }
+
+    MPI_Comm       comm;
+    adios2::ADIOS  adios;
+    adios2::IO     io;
+    adios2::Engine engine;
+  };
+#else
+  struct ADIOS2Writer::Implementation
+  {};
+#endif
+
+
+
+  ADIOS2Writer::ADIOS2Writer(
+    const std::string &                       name,
+    const MPI_Comm &                          comm,
+    const std::string &                       engine_type,
+    const std::map<std::string, std::string> &engine_parameters)
+  {
+#ifdef DEAL_II_WITH_ADIOS2
+    implementation = std::make_unique<Implementation>(comm);
+    implementation->io = implementation->adios.DeclareIO("deal.II output");
+    implementation->io.SetEngine(engine_type);
+    implementation->io.SetParameters(engine_parameters);
+    implementation->engine =
+      implementation->io.Open(name, adios2::Mode::Write);
+#else
+    (void)name;
+    (void)comm;
+    (void)engine_type;
+    (void)engine_parameters;
+    AssertThrow(false, ExcMessage("ADIOS2 support is disabled."));
+#endif
+  }
+
+
+
+  ADIOS2Writer::~ADIOS2Writer()
+  {
+#ifdef DEAL_II_WITH_ADIOS2
+    if (implementation != nullptr && implementation->engine)
+      implementation->engine.Close();
+#endif
+  }
+
+
+
+  void
+  ADIOS2Writer::write(const DataOutFilter &data_filter, const double time)
+  {
+#ifdef DEAL_II_WITH_ADIOS2
+    const MPI_Comm &comm = implementation->comm;
+
+    // determine the total number of nodes and cells and the position of the
+    // data of this process in the global arrays
+    const unsigned long long int local_counts[2] = {data_filter.n_nodes(),
+                                                    data_filter.n_cells()};
+    unsigned long long int       global_counts[2];
+    Utilities::MPI::sum(ArrayView<const unsigned long long int>(local_counts,
+                                                                2),
+                        comm,
+                        ArrayView<unsigned long long int>(global_counts, 2));
+
+    unsigned long long int offsets[2] = {0, 0};
+#  ifdef DEAL_II_WITH_MPI
+    const int ierr = MPI_Exscan(
+      local_counts, offsets, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    AssertThrowMPI(ierr);
+    // the result of MPI_Exscan is undefined on the first process
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      offsets[0] = offsets[1] = 0;
+#  endif
+
+    std::vector<double>       node_data;
+    std::vector<unsigned int> cell_data;
+    data_filter.fill_node_data(node_data);
+    data_filter.fill_cell_data(offsets[0], cell_data);
+
+    // processes without cells cannot deduce the number of coordinates per
+    // node and of vertices per cell from their data, so take the maximum
+    // over all processes
+    const unsigned int local_widths[2] = {
+      local_counts[0] > 0 ?
+        static_cast<unsigned int>(node_data.size() / local_counts[0]) :
+        0,
+      local_counts[1] > 0 ?
+        static_cast<unsigned int>(cell_data.size() / local_counts[1]) :
+        0};
+    unsigned int widths[2];
+    Utilities::MPI::max(ArrayView<const unsigned int>(local_widths, 2),
+                        comm,
+                        ArrayView<unsigned int>(widths, 2));
+
+    implementation->engine.BeginStep();
+
+    implementation->put<double>("nodes",
+                                {global_counts[0], widths[0]},
+                                {offsets[0], 0},
+                                {local_counts[0], widths[0]},
+                                node_data.data());
+    implementation->put<unsigned int>("cells",
+                                      {global_counts[1], widths[1]},
+                                      {offsets[1], 0},
+                                      {local_counts[1], widths[1]},
+                                      cell_data.data());
+    for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+      {
+        const std::size_t n_components = data_filter.get_data_set_dim(i);
+        implementation->put<double>(data_filter.get_data_set_name(i),
+                                    {global_counts[0], n_components},
+                                    {offsets[0], 0},
+                                    {local_counts[0], n_components},
+                                    data_filter.get_data_set(i));
+      }
+
+    adios2::Variable<double> time_variable =
+      implementation->io.InquireVariable<double>("time");
+    if (!time_variable)
+      time_variable = implementation->io.DefineVariable<double>("time");
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      implementation->engine.Put(time_variable, time, adios2::Mode::Sync);
+
+    implementation->engine.EndStep();
+#else
+    (void)data_filter;
+    (void)time;
+#endif
+  }
 } // namespace DataOutBase
 
 
@@ -2098,11 +2373,19 @@ namespace DataOutBase
   {}
 
 
-  DataOutFilterFlags::DataOutFilterFlags(const bool filter_duplicate_vertices,
-                                         const bool xdmf_hdf5_output)
+  DataOutFilterFlags::DataOutFilterFlags(
+    const bool         filter_duplicate_vertices,
+    const bool         xdmf_hdf5_output,
+    const unsigned int hdf5_chunk_size,
+    const unsigned int hdf5_compression_level)
     : filter_duplicate_vertices(filter_duplicate_vertices)
     , xdmf_hdf5_output(xdmf_hdf5_output)
-  {}
+    , hdf5_chunk_size(hdf5_chunk_size)
+    , hdf5_compression_level(hdf5_compression_level)
+  {
+    Assert(hdf5_compression_level <= 9,
+           ExcIndexRange(hdf5_compression_level, 0, 10));
+  }
 
 
   void
@@ -2139,6 +2422,17 @@ namespace DataOutBase
       "false",
       Patterns::Bool(),
       "Whether the data will be used in an XDMF/HDF5 combination.");
+    prm.declare_entry("HDF5 chunk size",
+                      "0",
+                      Patterns::Integer(0),
+                      "The number of nodes or cells per chunk of the HDF5 "
+                      "datasets. Zero means contiguous storage, unless "
+                      "compression is requested.");
+    prm.declare_entry("HDF5 compression level",
+                      "0",
+                      Patterns::Integer(0, 9),
+                      "The gzip compression level of the HDF5 datasets. "
+                      "Zero means no compression.");
   }
 
 
@@ -2148,6 +2442,8 @@ namespace DataOutBase
   {
     filter_duplicate_vertices = prm.get_bool("Filter duplicate vertices");
     xdmf_hdf5_output          = prm.get_bool("XDMF HDF5 output");
+    hdf5_chunk_size           = prm.get_integer("HDF5 chunk size");
+    hdf5_compression_level    = prm.get_integer("HDF5 compression level");
   }
 
 
@@ -2535,12 +2831,14 @@ namespace DataOutBase
                      const unsigned int                   cycle,
                      const bool                           print_date_and_time,
                      const VtkFlags::ZlibCompressionLevel compression_level,
-                     const bool write_higher_order_cells)
+                     const bool         write_higher_order_cells,
+                     const unsigned int compression_block_size)
     : time(time)
     , cycle(cycle)
     , print_date_and_time(print_date_and_time)
     , compression_level(compression_level)
     , write_higher_order_cells(write_higher_order_cells)
+    , compression_block_size(compression_block_size)
   {}
 
 
@@ -7209,22 +7507,39 @@ template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   const std::string &filename,
-  const MPI_Comm &   comm) const
+  const MPI_Comm &   comm,
+  const unsigned int n_aggregators) const
 {
 #ifndef DEAL_II_WITH_MPI
   // without MPI fall back to the normal way to write a vtu file:
   (void)comm;
+  (void)n_aggregators;
 
   std::ofstream f(filename);
   AssertThrow(f, ExcFileNotOpen(filename));
   write_vtu(f);
 #else
 
-  const int myrank = Utilities::MPI::this_mpi_process(comm);
+  const int          myrank  = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
+
+  // the number of groups of processes whose data is written by one
+  // aggregator each, or zero if every process writes its own data
+  const unsigned int n_groups = std::min(n_aggregators, n_ranks);
 
   MPI_Info info;
   int ierr = MPI_Info_create(&info);
   AssertThrowMPI(ierr);
+  if (n_groups > 0)
+    {
+      // tell MPI I/O to use as many nodes for the collective write as we
+      // have aggregators
+      ierr = MPI_Info_set(info,
+                          DEAL_II_MPI_CONST_CAST("cb_nodes"),
+                          DEAL_II_MPI_CONST_CAST(
+                            Utilities::to_string(n_groups).c_str()));
+      AssertThrowMPI(ierr);
+    }
   MPI_File fh;
   ierr = MPI_File_open(comm,
                        DEAL_II_MPI_CONST_CAST(filename.c_str()),
@@ -7242,66 +7557,203 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   ierr = MPI_Info_free(&info);
   AssertThrowMPI(ierr);
 
-  unsigned int header_size;
-
-  // write header
-  if (myrank == 0)
+  if (n_groups == 0)
     {
-      std::stringstream ss;
-      DataOutBase::write_vtu_header(ss, vtk_flags);
-      header_size = ss.str().size();
-      ierr = MPI_File_write(fh,
-                            DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                            header_size,
-                            MPI_CHAR,
-                            MPI_STATUS_IGNORE);
+      unsigned int header_size;
+
+      // write header
+      if (myrank == 0)
+        {
+          std::stringstream ss;
+          DataOutBase::write_vtu_header(ss, vtk_flags);
+          header_size = ss.str().size();
+          ierr        = MPI_File_write(fh,
+                                DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
+                                header_size,
+                                MPI_CHAR,
+                                MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
       AssertThrowMPI(ierr);
+
+      ierr = MPI_File_seek_shared(fh, header_size, MPI_SEEK_SET);
+      AssertThrowMPI(ierr);
+      {
+        const auto &                  patches      = get_patches();
+        const types::global_dof_index my_n_patches = patches.size();
+        const types::global_dof_index global_n_patches =
+          Utilities::MPI::sum(my_n_patches, comm);
+
+        // Do not write pieces with 0 cells as this will crash paraview if
+        // this is the first piece written. But if nobody has any pieces to
+        // write (file is empty), let processor 0 write their empty data,
+        // otherwise the vtk file is invalid.
+        std::stringstream ss;
+        if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
+          DataOutBase::write_vtu_main(patches,
+                                      get_dataset_names(),
+                                      get_nonscalar_data_ranges(),
+                                      vtk_flags,
+                                      ss);
+
+        ierr = MPI_File_write_ordered(fh,
+                                      DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
+                                      ss.str().size(),
+                                      MPI_CHAR,
+                                      MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+      // write footer
+      if (myrank == 0)
+        {
+          std::stringstream ss;
+          DataOutBase::write_vtu_footer(ss);
+          unsigned int footer_size = ss.str().size();
+          ierr = MPI_File_write_shared(fh,
+                                       DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
+                                       footer_size,
+                                       MPI_CHAR,
+                                       MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
     }
+  else
+    {
+      // Two-phase output: first every process compresses and encodes its
+      // own piece, with the same rules for empty pieces as above. Then the
+      // pieces are collected on the aggregators, which write them with
+      // large collective writes. Ranks are assigned to aggregators in
+      // contiguous blocks, so that the data of one aggregator is contiguous
+      // in the file and the order of pieces is the same as above.
+      std::string piece;
+      {
+        const auto &                  patches      = get_patches();
+        const types::global_dof_index my_n_patches = patches.size();
+        const types::global_dof_index global_n_patches =
+          Utilities::MPI::sum(my_n_patches, comm);
+
+        std::stringstream ss;
+        if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
+          DataOutBase::write_vtu_main(patches,
+                                      get_dataset_names(),
+                                      get_nonscalar_data_ranges(),
+                                      vtk_flags,
+                                      ss);
+        piece = ss.str();
+      }
 
-  ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
-  AssertThrowMPI(ierr);
+      const unsigned int my_group = static_cast<unsigned int>(
+        (static_cast<std::uint64_t>(myrank) * n_groups) / n_ranks);
+      MPI_Comm group_comm;
+      ierr = MPI_Comm_split(comm, my_group, myrank, &group_comm);
+      AssertThrowMPI(ierr);
+      const unsigned int group_rank =
+        Utilities::MPI::this_mpi_process(group_comm);
+      const unsigned int group_size =
+        Utilities::MPI::n_mpi_processes(group_comm);
+
+      const int mpi_tag = Utilities::MPI::internal::Tags::
+        data_out_base_write_vtu_in_parallel;
+
+      // the data this process writes. only aggregators write anything, the
+      // first one also writes the header and the last one the footer
+      std::vector<char> data;
+      if (group_rank == 0)
+        {
+          if (myrank == 0)
+            {
+              std::stringstream ss;
+              DataOutBase::write_vtu_header(ss, vtk_flags);
+              const std::string header = ss.str();
+              data.insert(data.end(), header.begin(), header.end());
+            }
+          data.insert(data.end(), piece.begin(), piece.end());
+          piece.clear();
 
-  ierr = MPI_File_seek_shared(fh, header_size, MPI_SEEK_SET);
-  AssertThrowMPI(ierr);
-  {
-    const auto &patches = get_patches();
-    const types::global_dof_index my_n_patches = patches.size();
-    const types::global_dof_index global_n_patches =
-      Utilities::MPI::sum(my_n_patches, comm);
-
-    // Do not write pieces with 0 cells as this will crash paraview if this is
-    // the first piece written. But if nobody has any pieces to write (file is
-    // empty), let processor 0 write their empty data, otherwise the vtk file is
-    // invalid.
-    std::stringstream ss;
-    if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
-      DataOutBase::write_vtu_main(patches,
-                                  get_dataset_names(),
-                                  get_nonscalar_data_ranges(),
-                                  vtk_flags,
-                                  ss);
-
-    ierr = MPI_File_write_ordered(fh,
-                                  DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                                  ss.str().size(),
-                                  MPI_CHAR,
-                                  MPI_STATUS_IGNORE);
-    AssertThrowMPI(ierr);
-  }
+          for (unsigned int sender = 1; sender < group_size; ++sender)
+            {
+              MPI_Status status;
+              ierr = MPI_Probe(sender, mpi_tag, group_comm, &status);
+              AssertThrowMPI(ierr);
+
+              int len;
+              ierr = MPI_Get_count(&status, MPI_CHAR, &len);
+              AssertThrowMPI(ierr);
+
+              const std::size_t old_size = data.size();
+              data.resize(old_size + len);
+              ierr = MPI_Recv(data.data() + old_size,
+                              len,
+                              MPI_CHAR,
+                              sender,
+                              mpi_tag,
+                              group_comm,
+                              MPI_STATUS_IGNORE);
+              AssertThrowMPI(ierr);
+            }
 
-  // write footer
-  if (myrank == 0)
-    {
-      std::stringstream ss;
-      DataOutBase::write_vtu_footer(ss);
-      unsigned int footer_size = ss.str().size();
-      ierr = MPI_File_write_shared(fh,
-                                   DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                                   footer_size,
-                                   MPI_CHAR,
-                                   MPI_STATUS_IGNORE);
+          if (my_group == n_groups - 1)
+            {
+              std::stringstream ss;
+              DataOutBase::write_vtu_footer(ss);
+              const std::string footer = ss.str();
+              data.insert(data.end(), footer.begin(), footer.end());
+            }
+        }
+      else
+        {
+          AssertThrow(piece.size() <=
+                        static_cast<std::size_t>(
+                          std::numeric_limits<int>::max()),
+                      ExcMessage("The output of a single process must not "
+                                 "exceed 2GB."));
+          ierr = MPI_Send(DEAL_II_MPI_CONST_CAST(piece.data()),
+                          piece.size(),
+                          MPI_CHAR,
+                          0,
+                          mpi_tag,
+                          group_comm);
+          AssertThrowMPI(ierr);
+        }
+
+      ierr = MPI_Comm_free(&group_comm);
+      AssertThrowMPI(ierr);
+
+      // every aggregator writes behind the data of all aggregators before
+      // it. MPI_Exscan leaves the result on rank 0 undefined
+      unsigned long long my_size = data.size(), my_offset = 0;
+      ierr = MPI_Exscan(
+        &my_size, &my_offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
       AssertThrowMPI(ierr);
+      if (myrank == 0)
+        my_offset = 0;
+
+      // the collective writes can only write up to 2GB each, so split
+      // larger data into several calls that all processes participate in
+      const std::size_t max_write_size = std::numeric_limits<int>::max();
+      const unsigned int n_writes      = Utilities::MPI::max(
+        static_cast<unsigned int>((data.size() + max_write_size - 1) /
+                                  max_write_size),
+        comm);
+      for (unsigned int w = 0; w < n_writes; ++w)
+        {
+          const std::size_t begin =
+            std::min<std::size_t>(w * max_write_size, data.size());
+          const std::size_t end =
+            std::min<std::size_t>(begin + max_write_size, data.size());
+          ierr = MPI_File_write_at_all(fh,
+                                       my_offset + begin,
+                                       data.data() + begin,
+                                       end - begin,
+                                       MPI_CHAR,
+                                       MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
     }
+
   ierr = MPI_File_close(&fh);
   AssertThrowMPI(ierr);
 #endif
@@ -7329,7 +7781,8 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
   const unsigned int counter,
   const MPI_Comm &   mpi_communicator,
   const unsigned int n_digits_for_counter,
-  const unsigned int n_groups) const
+  const unsigned int n_groups,
+  const unsigned int n_aggregators) const
 {
   const unsigned int rank = Utilities::MPI::this_mpi_process(mpi_communicator);
   const unsigned int n_ranks =
@@ -7359,7 +7812,9 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
   else if (n_groups == 1)
     {
       // write only a single data file in parallel
-      this->write_vtu_in_parallel(filename.c_str(), mpi_communicator);
+      this->write_vtu_in_parallel(filename.c_str(),
+                                  mpi_communicator,
+                                  n_aggregators);
     }
   else
     {
@@ -7368,7 +7823,9 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
       MPI_Comm comm_group;
       int ierr = MPI_Comm_split(mpi_communicator, color, rank, &comm_group);
       AssertThrowMPI(ierr);
-      this->write_vtu_in_parallel(filename.c_str(), comm_group);
+      this->write_vtu_in_parallel(filename.c_str(),
+                                  comm_group,
+                                  n_aggregators);
       ierr = MPI_Comm_free(&comm_group);
       AssertThrowMPI(ierr);
 #else
@@ -7773,6 +8230,7 @@ DataOutBase::write_hdf5_parallel(
     cell_memory_dataspace;
   hid_t pt_data_dataspace, pt_data_dataset, pt_data_file_dataspace,
     pt_data_memory_dataspace;
+  hid_t dataset_plist_id;
   herr_t status;
   unsigned int local_node_cell_count[2];
   hsize_t count[2], offset[2], node_ds_dim[2], cell_ds_dim[2];
@@ -7788,6 +8246,17 @@ DataOutBase::write_hdf5_parallel(
     ExcMessage(
       "Serial HDF5 output on multiple processes is not yet supported."));
 #    endif
+#  endif
+
+  // Parallel writes into compressed datasets are only supported by newer
+  // versions of HDF5
+#  if defined(DEAL_II_WITH_MPI) && defined(H5_HAVE_PARALLEL)
+#    if !H5_VERSION_GE(1, 10, 2)
+  AssertThrow(data_filter.get_flags().hdf5_compression_level == 0 ||
+                Utilities::MPI::n_mpi_processes(comm) == 1,
+              ExcMessage("Parallel HDF5 output with compression requires "
+                         "HDF5 version 1.10.2 or newer."));
+#    endif
 #  endif
 
   local_node_cell_count[0] = data_filter.n_nodes();
@@ -7864,35 +8333,51 @@ DataOutBase::write_hdf5_parallel(
       AssertThrow(cell_dataspace >= 0, ExcIO());
 
       // Create the dataset for the nodes and cells
+      dataset_plist_id =
+        create_hdf5_dataset_properties(data_filter.get_flags(),
+                                       node_ds_dim[0],
+                                       node_ds_dim[1]);
 #  if H5Gcreate_vers == 1
       node_dataset = H5Dcreate(h5_mesh_file_id,
                                "nodes",
                                H5T_NATIVE_DOUBLE,
                                node_dataspace,
-                               H5P_DEFAULT);
+                               dataset_plist_id);
 #  else
       node_dataset = H5Dcreate(h5_mesh_file_id,
                                "nodes",
                                H5T_NATIVE_DOUBLE,
                                node_dataspace,
                                H5P_DEFAULT,
-                               H5P_DEFAULT,
+                               dataset_plist_id,
                                H5P_DEFAULT);
 #  endif
       AssertThrow(node_dataset >= 0, ExcIO());
+      status = H5Pclose(dataset_plist_id);
+      AssertThrow(status >= 0, ExcIO());
+
+      dataset_plist_id =
+        create_hdf5_dataset_properties(data_filter.get_flags(),
+                                       cell_ds_dim[0],
+                                       cell_ds_dim[1]);
 #  if H5Gcreate_vers == 1
-      cell_dataset = H5Dcreate(
-        h5_mesh_file_id, "cells", H5T_NATIVE_UINT, cell_dataspace, H5P_DEFAULT);
+      cell_dataset = H5Dcreate(h5_mesh_file_id,
+                               "cells",
+                               H5T_NATIVE_UINT,
+                               cell_dataspace,
+                               dataset_plist_id);
 #  else
       cell_dataset = H5Dcreate(h5_mesh_file_id,
                                "cells",
                                H5T_NATIVE_UINT,
                                cell_dataspace,
                                H5P_DEFAULT,
-                               H5P_DEFAULT,
+                               dataset_plist_id,
                                H5P_DEFAULT);
 #  endif
       AssertThrow(cell_dataset >= 0, ExcIO());
+      status = H5Pclose(dataset_plist_id);
+      AssertThrow(status >= 0, ExcIO());
 
       // Close the node and cell dataspaces since we're done with them
       status = H5Sclose(node_dataspace);
@@ -8012,22 +8497,28 @@ DataOutBase::write_hdf5_parallel(
       pt_data_dataspace = H5Screate_simple(2, node_ds_dim, nullptr);
       AssertThrow(pt_data_dataspace >= 0, ExcIO());
 
+      dataset_plist_id =
+        create_hdf5_dataset_properties(data_filter.get_flags(),
+                                       node_ds_dim[0],
+                                       node_ds_dim[1]);
 #  if H5Gcreate_vers == 1
       pt_data_dataset = H5Dcreate(h5_solution_file_id,
                                   vector_name.c_str(),
                                   H5T_NATIVE_DOUBLE,
                                   pt_data_dataspace,
-                                  H5P_DEFAULT);
+                                  dataset_plist_id);
 #  else
       pt_data_dataset = H5Dcreate(h5_solution_file_id,
                                   vector_name.c_str(),
                                   H5T_NATIVE_DOUBLE,
                                   pt_data_dataspace,
                                   H5P_DEFAULT,
-                                  H5P_DEFAULT,
+                                  dataset_plist_id,
                                   H5P_DEFAULT);
 #  endif
       AssertThrow(pt_data_dataset >= 0, ExcIO());
+      status = H5Pclose(dataset_plist_id);
+      AssertThrow(status >= 0, ExcIO());
 
       // Create the data subset we'll use to read from memory
       count[0] = local_node_cell_count[0];
@@ -29,6 +29,27 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace Functions
 {
+  namespace
+  {
+    // Write the values of a function at the points of the batch with index
+    // @p batch, stored in the lanes of @p batch_values, to all components of
+    // the corresponding entries of @p values. Lanes beyond the number of
+    // points are ignored.
+    void
+    distribute_batch_values(const VectorizedArray<double> &batch_values,
+                            const unsigned int             batch,
+                            std::vector<Vector<double>> &  values)
+    {
+      constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+      const unsigned int     n_filled =
+        std::min<unsigned int>(n_lanes, values.size() - batch * n_lanes);
+      for (unsigned int v = 0; v < n_filled; ++v)
+        for (unsigned int c = 0; c < values[batch * n_lanes + v].size(); ++c)
+          values[batch * n_lanes + v](c) = batch_values[v];
+    }
+  } // namespace
+
+
   template <int dim>
   double
   SquareFunction<dim>::value(const Point<dim> &p, const unsigned int) const
@@ -64,6 +85,21 @@ namespace Functions
   }
 
 
+  template <int dim>
+  void
+  SquareFunction<dim>::vectorized_vector_value_list(
+    const std::vector<Point<dim, VectorizedArray<double>>> &points,
+    std::vector<Vector<double>> &                           values) const
+  {
+    AssertDimension(points.size(),
+                    (values.size() + VectorizedArray<double>::size() - 1) /
+                      VectorizedArray<double>::size());
+
+    for (unsigned int b = 0; b < points.size(); ++b)
+      distribute_batch_values(points[b].square(), b, values);
+  }
+
+
   template <int dim>
   double
   SquareFunction<dim>::laplacian(const Point<dim> &, const unsigned int) const
@@ -171,6 +207,22 @@ namespace Functions
   }
 
 
+  template <int dim>
+  void
+  Q1WedgeFunction<dim>::vectorized_vector_value_list(
+    const std::vector<Point<dim, VectorizedArray<double>>> &points,
+    std::vector<Vector<double>> &                           values) const
+  {
+    AssertDimension(points.size(),
+                    (values.size() + VectorizedArray<double>::size() - 1) /
+                      VectorizedArray<double>::size());
+
+    Assert(dim >= 2, ExcInternalError());
+    for (unsigned int b = 0; b < points.size(); ++b)
+      distribute_batch_values(points[b][0] * points[b][1], b, values);
+  }
+
+
   template <int dim>
   double
   Q1WedgeFunction<dim>::laplacian(const Point<dim> &, const unsigned int) const
@@ -481,6 +533,26 @@ namespace Functions
   }
 
 
+  template <int dim>
+  void
+  CosineFunction<dim>::vectorized_vector_value_list(
+    const std::vector<Point<dim, VectorizedArray<double>>> &points,
+    std::vector<Vector<double>> &                           values) const
+  {
+    AssertDimension(points.size(),
+                    (values.size() + VectorizedArray<double>::size() - 1) /
+                      VectorizedArray<double>::size());
+
+    for (unsigned int b = 0; b < points.size(); ++b)
+      {
+        VectorizedArray<double> value = 1.;
+        for (unsigned int d = 0; d < dim; ++d)
+          value *= std::cos(numbers::PI_2 * points[b][d]);
+        distribute_batch_values(value, b, values);
+      }
+  }
+
+
   template <int dim>
   double
   CosineFunction<dim>::laplacian(const Point<dim> &p, const unsigned int) const
@@ -1061,6 +1133,26 @@ namespace Functions
       }
   }
 
+
+  template <int dim>
+  void
+  ExpFunction<dim>::vectorized_vector_value_list(
+    const std::vector<Point<dim, VectorizedArray<double>>> &points,
+    std::vector<Vector<double>> &                           values) const
+  {
+    AssertDimension(points.size(),
+                    (values.size() + VectorizedArray<double>::size() - 1) /
+                      VectorizedArray<double>::size());
+
+    for (unsigned int b = 0; b < points.size(); ++b)
+      {
+        VectorizedArray<double> value = 1.;
+        for (unsigned int d = 0; d < dim; ++d)
+          value *= std::exp(points[b][d]);
+        distribute_batch_values(value, b, values);
+      }
+  }
+
   template <int dim>
   double
   ExpFunction<dim>::laplacian(const Point<dim> &p, const unsigned int) const
@@ -1948,6 +2040,26 @@ namespace Functions
   }
 
 
+  template <int dim>
+  void
+  FourierCosineFunction<dim>::vectorized_vector_value_list(
+    const std::vector<Point<dim, VectorizedArray<double>>> &points,
+    std::vector<Vector<double>> &                           values) const
+  {
+    AssertDimension(points.size(),
+                    (values.size() + VectorizedArray<double>::size() - 1) /
+                      VectorizedArray<double>::size());
+
+    for (unsigned int b = 0; b < points.size(); ++b)
+      {
+        VectorizedArray<double> argument = 0.;
+        for (unsigned int d = 0; d < dim; ++d)
+          argument += fourier_coefficients[d] * points[b][d];
+        distribute_batch_values(std::cos(argument), b, values);
+      }
+  }
+
+
 
   template <int dim>
   Tensor<1, dim>
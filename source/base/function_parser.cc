@@ -22,6 +22,8 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <map>
 
@@ -29,9 +31,133 @@
 #  include <muParser.h>
 #endif
 
+#ifdef DEAL_II_WITH_SYMENGINE
+#  include <deal.II/differentiation/sd.h>
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace FunctionParser
+  {
+    /**
+     * The compiled expressions of all components of a FunctionParser on one
+     * thread, together with the symbols of the variables and a place for
+     * their values.
+     */
+    class CompiledExpressions
+    {
+    public:
+      /**
+       * Evaluate all components for the values currently stored in
+       * #variables.
+       */
+      const std::vector<double> &
+      evaluate() const
+      {
+#ifdef DEAL_II_WITH_SYMENGINE
+        optimizer.substitute(symbols, variables);
+        return optimizer.evaluate();
+#else
+        Assert(false, ExcInternalError());
+        return variables;
+#endif
+      }
+
+      std::vector<double> variables;
+
+#ifdef DEAL_II_WITH_SYMENGINE
+      Differentiation::SD::types::symbol_vector   symbols;
+      Differentiation::SD::BatchOptimizer<double> optimizer;
+#endif
+    };
+  } // namespace FunctionParser
+} // namespace internal
+
+
+
+#if defined(DEAL_II_WITH_MUPARSER) && defined(DEAL_II_WITH_SYMENGINE)
+namespace
+{
+  /**
+   * Return whether @p expression only consists of the given variables and
+   * constants, numbers, arithmetic operators, and functions that SymEngine
+   * interprets in the same way as muparser. This is a conservative check:
+   * everything else, e.g., the if() function, the ternary operator, or
+   * comparisons, is left to muparser.
+   */
+  bool
+  can_be_compiled(const std::string &                  expression,
+                  const std::vector<std::string> &     variables,
+                  const std::map<std::string, double> &constants)
+  {
+    static const std::vector<std::string> functions = {"sin",
+                                                       "cos",
+                                                       "tan",
+                                                       "asin",
+                                                       "acos",
+                                                       "atan",
+                                                       "sinh",
+                                                       "cosh",
+                                                       "tanh",
+                                                       "asinh",
+                                                       "acosh",
+                                                       "atanh",
+                                                       "atan2",
+                                                       "exp",
+                                                       "sqrt",
+                                                       "abs",
+                                                       "log",
+                                                       "pow"};
+
+    std::string::size_type pos = 0;
+    while (pos < expression.size())
+      {
+        const char c = expression[pos];
+        if (std::isdigit(c) || c == '.')
+          {
+            // skip over a number, including a possible exponent
+            while (pos < expression.size() &&
+                   (std::isdigit(expression[pos]) || expression[pos] == '.'))
+              ++pos;
+            if (pos < expression.size() &&
+                (expression[pos] == 'e' || expression[pos] == 'E'))
+              {
+                ++pos;
+                if (pos < expression.size() &&
+                    (expression[pos] == '+' || expression[pos] == '-'))
+                  ++pos;
+                while (pos < expression.size() && std::isdigit(expression[pos]))
+                  ++pos;
+              }
+          }
+        else if (std::isalpha(c) || c == '_')
+          {
+            const std::string::size_type begin = pos;
+            while (pos < expression.size() &&
+                   (std::isalnum(expression[pos]) || expression[pos] == '_'))
+              ++pos;
+            const std::string name = expression.substr(begin, pos - begin);
+            if (std::find(variables.begin(), variables.end(), name) ==
+                  variables.end() &&
+                constants.find(name) == constants.end() &&
+                std::find(functions.begin(), functions.end(), name) ==
+                  functions.end())
+              return false;
+          }
+        else if (std::string("+-*/^(), \t").find(c) != std::string::npos)
+          ++pos;
+        else
+          return false;
+      }
+    return true;
+  }
+} // namespace
+#endif
+
+
 template <int dim>
 const std::vector<std::string> &
 FunctionParser<dim>::get_expressions() const
@@ -41,12 +167,22 @@ FunctionParser<dim>::get_expressions() const
 
 
 
+template <int dim>
+bool
+FunctionParser<dim>::is_compiled() const
+{
+  return compiled;
+}
+
+
+
 template <int dim>
 FunctionParser<dim>::FunctionParser(const unsigned int n_components,
                                     const double       initial_time,
                                     const double       h)
   : AutoDerivativeFunction<dim>(h, n_components, initial_time)
   , initialized(false)
+  , compiled(false)
   , n_vars(0)
 {}
 
@@ -60,6 +196,7 @@ FunctionParser<dim>::FunctionParser(const std::string &expression,
       h,
       Utilities::split_string_list(expression, ';').size())
   , initialized(false)
+  , compiled(false)
   , n_vars(0)
 {
   auto constants_map = Patterns::Tools::Convert<ConstMap>::to_value(
@@ -97,6 +234,8 @@ FunctionParser<dim>::initialize(const std::string &             variables,
                                 const bool time_dependent)
 {
   this->fp.clear(); // this will reset all thread-local objects
+  this->compiled_fp.clear();
+  compiled = false;
 
   this->constants   = constants;
   this->var_names   = Utilities::split_string_list(variables, ',');
@@ -256,6 +395,83 @@ FunctionParser<dim>::init_muparser() const
 
 
 
+template <int dim>
+bool
+FunctionParser<dim>::compile()
+{
+  Assert(initialized == true, ExcNotInitialized());
+
+  compiled_fp.clear();
+  compiled = false;
+
+#  ifdef DEAL_II_WITH_SYMENGINE
+  for (const auto &expression : expressions)
+    if (!can_be_compiled(expression, var_names, constants))
+      return false;
+
+  // SymEngine may still reject an expression, e.g., because it parses
+  // some construct differently. in that case, simply stay with muparser
+  try
+    {
+      init_compiled_expressions();
+    }
+  catch (...)
+    {
+      compiled_fp.clear();
+      return false;
+    }
+
+  compiled = true;
+#  endif
+
+  return compiled;
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::init_compiled_expressions() const
+{
+#  ifdef DEAL_II_WITH_SYMENGINE
+  namespace SD = Differentiation::SD;
+
+  // check that we have not already initialized the compiled expressions on
+  // the current thread
+  Assert(compiled_fp.get() == nullptr, ExcInternalError());
+
+  auto data = std::make_unique<internal::FunctionParser::CompiledExpressions>();
+
+  for (const auto &name : var_names)
+    data->symbols.push_back(SD::make_symbol(name));
+  data->variables.resize(var_names.size());
+
+  SD::types::substitution_map constant_values;
+  for (const auto &constant : constants)
+    constant_values[SD::make_symbol(constant.first)] =
+      SD::Expression(constant.second);
+
+#    ifdef DEAL_II_SYMENGINE_WITH_LLVM
+  data->optimizer.set_optimization_method(SD::OptimizerType::llvm,
+                                          SD::OptimizationFlags::optimize_all);
+#    else
+  data->optimizer.set_optimization_method(SD::OptimizerType::lambda,
+                                          SD::OptimizationFlags::optimize_all);
+#    endif
+  data->optimizer.register_symbols(data->symbols);
+  for (const auto &expression : expressions)
+    data->optimizer.register_function(
+      SD::Expression(expression, true).substitute(constant_values));
+  data->optimizer.optimize();
+
+  compiled_fp.get() = std::move(data);
+#  else
+  Assert(false, ExcInternalError());
+#  endif
+}
+
+
+
 template <int dim>
 void
 FunctionParser<dim>::initialize(const std::string &                  vars,
@@ -271,6 +487,26 @@ FunctionParser<dim>::initialize(const std::string &                  vars,
 
 
 
+template <int dim>
+const std::vector<double> &
+FunctionParser<dim>::evaluate_compiled(const Point<dim> &p) const
+{
+  // initialize the compiled expressions if that hasn't happened yet on the
+  // current thread
+  if (compiled_fp.get() == nullptr)
+    init_compiled_expressions();
+
+  internal::FunctionParser::CompiledExpressions &data = *compiled_fp.get();
+  for (unsigned int i = 0; i < dim; ++i)
+    data.variables[i] = p(i);
+  if (dim != n_vars)
+    data.variables[dim] = this->get_time();
+
+  return data.evaluate();
+}
+
+
+
 template <int dim>
 double
 FunctionParser<dim>::value(const Point<dim> & p,
@@ -279,6 +515,9 @@ FunctionParser<dim>::value(const Point<dim> & p,
   Assert(initialized == true, ExcNotInitialized());
   AssertIndexRange(component, this->n_components);
 
+  if (compiled)
+    return evaluate_compiled(p)[component];
+
   // initialize the parser if that hasn't happened yet on the current thread
   if (fp.get().size() == 0)
     init_muparser();
@@ -316,6 +555,15 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
          ExcDimensionMismatch(values.size(), this->n_components));
 
 
+  if (compiled)
+    {
+      const std::vector<double> &result = evaluate_compiled(p);
+      for (unsigned int component = 0; component < this->n_components;
+           ++component)
+        values(component) = result[component];
+      return;
+    }
+
   // initialize the parser if that hasn't happened yet on the current thread
   if (fp.get().size() == 0)
     init_muparser();
@@ -329,6 +577,59 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
     values(component) = fp.get()[component]->Eval();
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>> &  values) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  if (compiled)
+    {
+      for (unsigned int q = 0; q < points.size(); ++q)
+        {
+          Assert(values[q].size() == this->n_components,
+                 ExcDimensionMismatch(values[q].size(), this->n_components));
+
+          const std::vector<double> &result = evaluate_compiled(points[q]);
+          for (unsigned int component = 0; component < this->n_components;
+               ++component)
+            values[q](component) = result[component];
+        }
+      return;
+    }
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  // the parsers of all components refer to the same variables, so we only
+  // need to access the thread-local objects once
+  std::vector<double> &                           variables = vars.get();
+  const std::vector<std::unique_ptr<mu::Parser>> &parsers   = fp.get();
+
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  for (unsigned int q = 0; q < points.size(); ++q)
+    {
+      Assert(values[q].size() == this->n_components,
+             ExcDimensionMismatch(values[q].size(), this->n_components));
+
+      for (unsigned int i = 0; i < dim; ++i)
+        variables[i] = points[q](i);
+
+      for (unsigned int component = 0; component < this->n_components;
+           ++component)
+        values[q](component) = parsers[component]->Eval();
+    }
+}
+
 #else
 
 
@@ -354,6 +655,16 @@ FunctionParser<dim>::initialize(const std::string &,
 
 
 
+template <int dim>
+bool
+FunctionParser<dim>::compile()
+{
+  AssertThrow(false, ExcNeedsFunctionparser());
+  return false;
+}
+
+
+
 template <int dim>
 double
 FunctionParser<dim>::value(const Point<dim> &, unsigned int) const
@@ -371,6 +682,16 @@ FunctionParser<dim>::vector_value(const Point<dim> &, Vector<double> &) const
 }
 
 
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(const std::vector<Point<dim>> &,
+                                       std::vector<Vector<double>> &) const
+{
+  AssertThrow(false, ExcNeedsFunctionparser());
+}
+
+
 #endif
 
 // Explicit Instantiations.
@@ -17,6 +17,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 
+#include <algorithm>
 #include <vector>
 
 #ifdef DEAL_II_WITH_TRILINOS
@@ -104,6 +105,18 @@ IndexSet::do_compress() const
   // which itself calls the current function)
   std::lock_guard<std::mutex> lock(compress_mutex);
 
+  // ranges added since the last call of this function have been appended at
+  // the end, possibly out of order. sort only this part and merge it with
+  // the sorted part in front, which keeps the cost linear if a few indices
+  // are added between calls of this function
+  const std::vector<Range>::iterator first_unsorted =
+    std::is_sorted_until(ranges.begin(), ranges.end());
+  if (first_unsorted != ranges.end())
+    {
+      std::sort(first_unsorted, ranges.end());
+      std::inplace_merge(ranges.begin(), first_unsorted, ranges.end());
+    }
+
   // see if any of the contiguous ranges can be merged. do not use
   // std::vector::erase in-place as it is quadratic in the number of
   // ranges. since the ranges are sorted by their first index, determining
@@ -214,6 +227,8 @@ IndexSet::get_view(const size_type begin, const size_type end) const
          ExcMessage("End index needs to be larger or equal to begin index!"));
   Assert(end <= size(), ExcMessage("Given range exceeds index set dimension"));
 
+  compress();
+
   IndexSet                           result(end - begin);
   std::vector<Range>::const_iterator r1 = ranges.begin();
 
@@ -259,68 +274,42 @@ IndexSet::subtract_set(const IndexSet &other)
 {
   compress();
   other.compress();
-  is_compressed = false;
-
 
-  // we save new ranges to be added to our IndexSet in an temporary vector and
-  // add all of them in one go at the end.
+  // walk through both sets of sorted ranges in one sweep and collect the
+  // parts of our ranges not covered by the ranges of the other set. this
+  // keeps the cost linear also for index sets made up of many small ranges
   std::vector<Range> new_ranges;
+  new_ranges.reserve(ranges.size());
 
-  std::vector<Range>::iterator own_it   = ranges.begin();
-  std::vector<Range>::iterator other_it = other.ranges.begin();
-
-  while (own_it != ranges.end() && other_it != other.ranges.end())
+  std::vector<Range>::const_iterator other_begin = other.ranges.begin();
+  for (const Range &own_range : ranges)
     {
-      // advance own iterator until we get an overlap
-      if (own_it->end <= other_it->begin)
-        {
-          ++own_it;
-          continue;
-        }
-      // we are done with other_it, so advance
-      if (own_it->begin >= other_it->end)
+      // ranges of the other set that end before the current range cannot
+      // overlap any of the following ones either
+      while (other_begin != other.ranges.end() &&
+             other_begin->end <= own_range.begin)
+        ++other_begin;
+
+      size_type begin = own_range.begin;
+      for (std::vector<Range>::const_iterator other_it = other_begin;
+           begin < own_range.end;
+           ++other_it)
         {
-          ++other_it;
-          continue;
-        }
+          if (other_it == other.ranges.end() ||
+              other_it->begin >= own_range.end)
+            {
+              new_ranges.emplace_back(begin, own_range.end);
+              break;
+            }
 
-      // Now own_it and other_it overlap.  First save the part of own_it that
-      // is before other_it (if not empty).
-      if (own_it->begin < other_it->begin)
-        {
-          Range r(own_it->begin, other_it->begin);
-          r.nth_index_in_set = 0; // fix warning of unused variable
-          new_ranges.push_back(r);
+          if (other_it->begin > begin)
+            new_ranges.emplace_back(begin, other_it->begin);
+          begin = std::max(begin, other_it->end);
         }
-      // change own_it to the sub range behind other_it. Do not delete own_it
-      // in any case. As removal would invalidate iterators, we just shrink
-      // the range to an empty one.
-      own_it->begin = other_it->end;
-      if (own_it->begin > own_it->end)
-        {
-          own_it->begin = own_it->end;
-          ++own_it;
-        }
-
-      // continue without advancing iterators, the right one will be advanced
-      // next.
-    }
-
-  // Now delete all empty ranges we might
-  // have created.
-  for (std::vector<Range>::iterator it = ranges.begin(); it != ranges.end();)
-    {
-      if (it->begin >= it->end)
-        it = ranges.erase(it);
-      else
-        ++it;
     }
 
-  // done, now add the temporary ranges
-  const std::vector<Range>::iterator end = new_ranges.end();
-  for (std::vector<Range>::iterator it = new_ranges.begin(); it != end; ++it)
-    add_range(it->begin, it->end);
-
+  ranges.swap(new_ranges);
+  is_compressed = false;
   compress();
 }
 
@@ -345,6 +334,8 @@ IndexSet::pop_back()
          ExcMessage(
            "pop_back() failed, because this IndexSet contains no entries."));
 
+  compress();
+
   const size_type index = ranges.back().end - 1;
   --ranges.back().end;
 
@@ -363,6 +354,8 @@ IndexSet::pop_front()
          ExcMessage(
            "pop_front() failed, because this IndexSet contains no entries."));
 
+  compress();
+
   const size_type index = ranges.front().begin;
   ++ranges.front().begin;
 
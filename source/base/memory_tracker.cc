@@ -0,0 +1,250 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_tracker.h>
+#include <deal.II/base/mpi.h>
+
+#include <boost/io/ios_state.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <iostream>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace MemoryTracker
+{
+  namespace internal
+  {
+    std::atomic<bool> tracking_is_enabled(false);
+  }
+
+
+
+  namespace
+  {
+    /**
+     * The counters of the current and peak number of bytes for each
+     * subsystem. The last entry holds the numbers for all subsystems
+     * together.
+     */
+    std::array<std::atomic<std::size_t>, n_subsystems + 1> current_bytes;
+    std::array<std::atomic<std::size_t>, n_subsystems + 1> peak_bytes;
+
+    /**
+     * The subsystem of the innermost Scope on the current thread.
+     */
+    thread_local Subsystem thread_subsystem = general;
+
+
+
+    /**
+     * Add @p n_bytes to the counter @p index and update its peak.
+     */
+    void
+    increase(const unsigned int index, const std::size_t n_bytes)
+    {
+      const std::size_t new_bytes = (current_bytes[index] += n_bytes);
+
+      std::size_t peak = peak_bytes[index].load();
+      while (new_bytes > peak &&
+             !peak_bytes[index].compare_exchange_weak(peak, new_bytes))
+        {
+        }
+    }
+  } // namespace
+
+
+
+  void
+  enable()
+  {
+    for (unsigned int i = 0; i <= n_subsystems; ++i)
+      {
+        current_bytes[i] = 0;
+        peak_bytes[i]    = 0;
+      }
+    internal::tracking_is_enabled = true;
+  }
+
+
+
+  void
+  disable()
+  {
+    internal::tracking_is_enabled = false;
+  }
+
+
+
+  void
+  allocate(const Subsystem subsystem, const std::size_t n_bytes)
+  {
+    AssertIndexRange(subsystem, n_subsystems);
+    increase(subsystem, n_bytes);
+    increase(n_subsystems, n_bytes);
+  }
+
+
+
+  void
+  deallocate(const Subsystem subsystem, const std::size_t n_bytes)
+  {
+    AssertIndexRange(subsystem, n_subsystems);
+    current_bytes[subsystem] -= n_bytes;
+    current_bytes[n_subsystems] -= n_bytes;
+  }
+
+
+
+  Subsystem
+  current_subsystem()
+  {
+    return thread_subsystem;
+  }
+
+
+
+  std::size_t
+  get_current_bytes(const Subsystem subsystem)
+  {
+    AssertIndexRange(subsystem, n_subsystems);
+    return current_bytes[subsystem];
+  }
+
+
+
+  std::size_t
+  get_peak_bytes(const Subsystem subsystem)
+  {
+    AssertIndexRange(subsystem, n_subsystems);
+    return peak_bytes[subsystem];
+  }
+
+
+
+  std::size_t
+  get_total_current_bytes()
+  {
+    return current_bytes[n_subsystems];
+  }
+
+
+
+  std::size_t
+  get_total_peak_bytes()
+  {
+    return peak_bytes[n_subsystems];
+  }
+
+
+
+  void
+  reset_peaks()
+  {
+    for (unsigned int i = 0; i <= n_subsystems; ++i)
+      peak_bytes[i] = current_bytes[i].load();
+  }
+
+
+
+  std::string
+  get_name(const Subsystem subsystem)
+  {
+    switch (subsystem)
+      {
+        case general:
+          return "general";
+        case vector:
+          return "Vector";
+        case sparsity_pattern:
+          return "SparsityPattern";
+        case dynamic_sparsity_pattern:
+          return "DynamicSparsityPattern";
+        case data_out:
+          return "DataOut";
+        default:
+          Assert(false, ExcNotImplemented());
+      }
+    return "";
+  }
+
+
+
+  void
+  print_statistics(std::ostream &out, const MPI_Comm &mpi_communicator)
+  {
+    const boost::io::ios_base_all_saver restore_stream(out);
+
+    const double mb = 1. / (1024. * 1024.);
+
+    const auto print_line = [&](const std::string &name,
+                                const std::size_t  current,
+                                const std::size_t  peak) {
+      const Utilities::MPI::MinMaxAvg current_data =
+        Utilities::MPI::min_max_avg(current * mb, mpi_communicator);
+      const Utilities::MPI::MinMaxAvg peak_data =
+        Utilities::MPI::min_max_avg(peak * mb, mpi_communicator);
+
+      out << "| " << std::left << std::setw(23) << name << "|" << std::right
+          << std::fixed << std::setprecision(1);
+      for (const auto &data : {current_data, peak_data})
+        out << std::setw(10) << data.min << " " << std::setw(10) << data.avg
+            << " " << std::setw(10) << data.max << " |";
+      out << "\n";
+    };
+
+    const std::string separator =
+      "+------------------------+"
+      "---------------------------------+"
+      "---------------------------------+\n";
+
+    out << "\n"
+        << separator
+        << "| Memory in MB           |"
+        << "           current (min/avg/max) |"
+        << "              peak (min/avg/max) |\n"
+        << separator;
+    for (unsigned int i = 0; i < n_subsystems; ++i)
+      print_line(get_name(static_cast<Subsystem>(i)),
+                 current_bytes[i],
+                 peak_bytes[i]);
+    out << separator;
+    print_line("Total",
+               current_bytes[n_subsystems],
+               peak_bytes[n_subsystems]);
+    out << separator;
+  }
+
+
+
+  Scope::Scope(const Subsystem subsystem)
+    : previous_subsystem(thread_subsystem)
+  {
+    AssertIndexRange(subsystem, n_subsystems);
+    thread_subsystem = subsystem;
+  }
+
+
+
+  Scope::~Scope()
+  {
+    thread_subsystem = previous_subsystem;
+  }
+} // namespace MemoryTracker
+
+DEAL_II_NAMESPACE_CLOSE
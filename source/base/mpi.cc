@@ -28,6 +28,7 @@
 #include <deal.II/lac/vector_memory.h>
 
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <set>
 #include <vector>
@@ -112,6 +113,26 @@ namespace Utilities
 
 
 
+    Future<MinMaxAvg>
+    imin_max_avg(const double my_value, const MPI_Comm &mpi_communicator)
+    {
+      const auto value  = std::make_shared<double>(my_value);
+      const auto result = std::make_shared<MinMaxAvg>();
+
+      const auto reduction = std::make_shared<Future<void>>(
+        imin_max_avg(ArrayView<const double>(*value),
+                     ArrayView<MinMaxAvg>(*result),
+                     mpi_communicator));
+
+      return Future<MinMaxAvg>([reduction]() { reduction->wait(); },
+                               [reduction, value, result]() {
+                                 reduction->get();
+                                 return *result;
+                               });
+    }
+
+
+
 #ifdef DEAL_II_WITH_MPI
     unsigned int
     n_mpi_processes(const MPI_Comm &mpi_communicator)
@@ -688,6 +709,90 @@ namespace Utilities
     }
 
 
+
+    Future<void>
+    imin_max_avg(const ArrayView<const double> &my_values,
+                 const ArrayView<MinMaxAvg> &   result,
+                 const MPI_Comm &               mpi_communicator)
+    {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+      if (job_supports_mpi() &&
+          Utilities::MPI::n_mpi_processes(mpi_communicator) > 1)
+        {
+          AssertDimension(my_values.size(), result.size());
+
+          const unsigned int my_id =
+            dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+          const unsigned int numproc =
+            dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+          // the input of the reduction must stay alive until the operation
+          // has completed, so share it with the returned object
+          const auto in = std::make_shared<std::vector<MinMaxAvg>>(
+            my_values.size());
+          for (unsigned int i = 0; i < my_values.size(); i++)
+            {
+              (*in)[i].sum = (*in)[i].min = (*in)[i].max = my_values[i];
+              (*in)[i].min_index = (*in)[i].max_index = my_id;
+              (*in)[i].avg                            = 0.;
+            }
+
+          MPI_Op op;
+          int    ierr =
+            MPI_Op_create(reinterpret_cast<MPI_User_function *>(&max_reduce),
+                          true,
+                          &op);
+          AssertThrowMPI(ierr);
+
+          MPI_Datatype type;
+          int          lengths[]       = {3, 2, 1};
+          MPI_Aint     displacements[] = {0,
+                                      offsetof(MinMaxAvg, min_index),
+                                      offsetof(MinMaxAvg, avg)};
+          MPI_Datatype types[]         = {MPI_DOUBLE, MPI_INT, MPI_DOUBLE};
+
+          ierr =
+            MPI_Type_create_struct(3, lengths, displacements, types, &type);
+          AssertThrowMPI(ierr);
+
+          ierr = MPI_Type_commit(&type);
+          AssertThrowMPI(ierr);
+
+          const auto request = std::make_shared<MPI_Request>();
+          ierr               = MPI_Iallreduce(in->data(),
+                                result.data(),
+                                my_values.size(),
+                                type,
+                                op,
+                                mpi_communicator,
+                                request.get());
+          AssertThrowMPI(ierr);
+
+          return Future<void>(
+            [request]() {
+              const int ierr = MPI_Wait(request.get(), MPI_STATUS_IGNORE);
+              AssertThrowMPI(ierr);
+            },
+            [in, result, numproc, type, op]() mutable {
+              int ierr = MPI_Type_free(&type);
+              AssertThrowMPI(ierr);
+
+              ierr = MPI_Op_free(&op);
+              AssertThrowMPI(ierr);
+
+              for (auto &r : result)
+                r.avg = r.sum / numproc;
+            });
+        }
+#  endif
+
+      // without support for nonblocking collectives, or if there is nothing
+      // to communicate, compute the result right away
+      min_max_avg(my_values, result, mpi_communicator);
+      return Future<void>([]() {}, []() {});
+    }
+
+
 #else
 
     unsigned int
@@ -762,6 +867,17 @@ namespace Utilities
         }
     }
 
+
+
+    Future<void>
+    imin_max_avg(const ArrayView<const double> &my_values,
+                 const ArrayView<MinMaxAvg> &   result,
+                 const MPI_Comm &               mpi_communicator)
+    {
+      min_max_avg(my_values, result, mpi_communicator);
+      return Future<void>([]() {}, []() {});
+    }
+
 #endif
 
 
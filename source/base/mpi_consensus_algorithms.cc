@@ -27,6 +27,8 @@ namespace Utilities
 
       template class NBX<unsigned int, unsigned int>;
 
+      template class HierarchicalNBX<unsigned int, unsigned int>;
+
       template class PEX<unsigned int, unsigned int>;
 
       template class Serial<unsigned int, unsigned int>;
@@ -46,6 +48,10 @@ namespace Utilities
         std::pair<types::global_dof_index, types::global_dof_index>,
         unsigned int>;
 
+      template class HierarchicalNBX<
+        std::pair<types::global_dof_index, types::global_dof_index>,
+        unsigned int>;
+
       template class Serial<
         std::pair<types::global_dof_index, types::global_dof_index>,
         unsigned int>;
@@ -59,6 +65,8 @@ namespace Utilities
 
       template class NBX<types::global_dof_index, unsigned int>;
 
+      template class HierarchicalNBX<types::global_dof_index, unsigned int>;
+
       template class Serial<types::global_dof_index, unsigned int>;
 
       template class PEX<types::global_dof_index, unsigned int>;
@@ -70,6 +78,8 @@ namespace Utilities
 
       template class NBX<char, char>;
 
+      template class HierarchicalNBX<char, char>;
+
       template class PEX<char, char>;
 
       template class Serial<char, char>;
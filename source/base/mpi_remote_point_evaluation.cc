@@ -28,6 +28,11 @@
 #include <deal.II/grid/grid_tools_cache.h>
 #include <deal.II/grid/tria.h>
 
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <tuple>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -35,6 +40,36 @@ namespace Utilities
 {
   namespace MPI
   {
+    namespace
+    {
+      /**
+       * Return the bounding boxes of the locally owned cells of all
+       * processes, each compressed to a small number of boxes.
+       */
+      template <int dim, int spacedim>
+      std::vector<std::vector<BoundingBox<spacedim>>>
+      compute_global_bounding_boxes(const Triangulation<dim, spacedim> &tria,
+                                    const Mapping<dim, spacedim> &mapping)
+      {
+        std::vector<BoundingBox<spacedim>> local_boxes;
+        for (const auto &cell : tria.active_cell_iterators())
+          if (cell->is_locally_owned())
+            local_boxes.push_back(mapping.get_bounding_box(cell));
+
+        // create r-tree of bounding boxes
+        const auto local_tree = pack_rtree(local_boxes);
+
+        // compress r-tree to a minimal set of bounding boxes
+        const auto local_reduced_box = extract_rtree_level(local_tree, 0);
+
+        // gather bounding boxes of other processes
+        return Utilities::MPI::all_gather(tria.get_communicator(),
+                                          local_reduced_box);
+      }
+    } // namespace
+
+
+
     template <int dim, int spacedim>
     RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation(
       const double tolerance)
@@ -75,20 +110,7 @@ namespace Utilities
       this->tria    = &tria;
       this->mapping = &mapping;
 
-      std::vector<BoundingBox<spacedim>> local_boxes;
-      for (const auto &cell : tria.active_cell_iterators())
-        if (cell->is_locally_owned())
-          local_boxes.push_back(mapping.get_bounding_box(cell));
-
-      // create r-tree of bounding boxes
-      const auto local_tree = pack_rtree(local_boxes);
-
-      // compress r-tree to a minimal set of bounding boxes
-      const auto local_reduced_box = extract_rtree_level(local_tree, 0);
-
-      // gather bounding boxes of other processes
-      const auto global_bboxes =
-        Utilities::MPI::all_gather(tria.get_communicator(), local_reduced_box);
+      const auto global_bboxes = compute_global_bounding_boxes(tria, mapping);
 
       const GridTools::Cache<dim, spacedim> cache(tria, mapping);
 
@@ -150,6 +172,417 @@ namespace Utilities
     }
 
 
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::update(
+      const std::vector<Point<spacedim>> &points)
+    {
+#ifndef DEAL_II_WITH_MPI
+      Assert(false, ExcNeedsMPI());
+      (void)points;
+#else
+      Assert(ready_flag,
+             ExcMessage("reinit() has to be called before update() and the "
+                        "triangulation must not have been changed since."));
+      AssertDimension(points.size() + 1, point_ptrs.size());
+
+      using active_cell_iterator =
+        typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+      const MPI_Comm     comm           = tria->get_communicator();
+      const unsigned int n_cell_entries = send_permutation.size();
+
+      // The messages of evaluate_and_process() and process_and_evaluate()
+      // are matched by tag only. Make sure that no process starts the next
+      // round while another one is still receiving messages of the previous
+      // one.
+      const auto barrier = [&]() {
+        const int ierr = MPI_Barrier(comm);
+        AssertThrowMPI(ierr);
+      };
+
+      // rank requesting each entry of cell_data
+      std::vector<unsigned int> cell_entry_ranks(n_cell_entries);
+      for (unsigned int j = 0; j < n_cell_entries; ++j)
+        {
+          const auto ptr = std::upper_bound(send_ptrs.begin(),
+                                            send_ptrs.end(),
+                                            send_permutation[j]);
+          cell_entry_ranks[j] =
+            send_ranks[std::distance(send_ptrs.begin(), ptr) - 1];
+        }
+
+      // 1) send the new positions together with the point indices to the
+      //    processes that have evaluated the points so far
+      std::vector<std::pair<unsigned int, Point<spacedim>>> cell_entry_points(
+        n_cell_entries);
+      {
+        std::vector<std::pair<unsigned int, Point<spacedim>>> indexed_points(
+          points.size());
+        for (unsigned int i = 0; i < points.size(); ++i)
+          indexed_points[i] = {i, points[i]};
+
+        using IndexedPoint = std::pair<unsigned int, Point<spacedim>>;
+
+        std::vector<IndexedPoint> buffer;
+        this->template process_and_evaluate<IndexedPoint>(
+          indexed_points,
+          buffer,
+          [&](const ArrayView<const IndexedPoint> &values, const CellData &) {
+            AssertDimension(values.size(), n_cell_entries);
+            std::copy(values.begin(), values.end(), cell_entry_points.begin());
+          });
+        barrier();
+      }
+
+      // 2) try to find the points in their previous cells or in the locally
+      //    owned face neighbors of these cells
+      std::vector<std::pair<int, int>> new_cells(n_cell_entries);
+      std::vector<Point<dim>>          new_reference_points(n_cell_entries);
+      std::vector<unsigned int>        found(n_cell_entries, 0);
+
+      const auto try_cell = [&](const active_cell_iterator &cell,
+                                const unsigned int          j) {
+        if (!cell->is_locally_owned())
+          return false;
+
+        try
+          {
+            const Point<dim> reference_point =
+              mapping->transform_real_to_unit_cell(
+                cell, cell_entry_points[j].second);
+
+            if (GeometryInfo<dim>::is_inside_unit_cell(reference_point,
+                                                       tolerance))
+              {
+                new_cells[j]            = {cell->level(), cell->index()};
+                new_reference_points[j] = reference_point;
+                return true;
+              }
+          }
+        catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+          {}
+
+        return false;
+      };
+
+      const auto face_neighbors = [](const active_cell_iterator &cell) {
+        std::vector<active_cell_iterator> neighbors;
+        for (const unsigned int f : cell->face_indices())
+          {
+            if (cell->at_boundary(f))
+              continue;
+
+            auto neighbor = cell->neighbor(f);
+            if (neighbor->is_active())
+              neighbors.emplace_back(neighbor);
+            else if (dim == 1)
+              {
+                while (neighbor->has_children())
+                  neighbor = neighbor->child(1 - f);
+                neighbors.emplace_back(neighbor);
+              }
+            else
+              for (unsigned int sf = 0; sf < cell->face(f)->n_children(); ++sf)
+                neighbors.emplace_back(cell->neighbor_child_on_subface(f, sf));
+          }
+        return neighbors;
+      };
+
+      for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+        {
+          const active_cell_iterator cell(&*tria,
+                                          cell_data.cells[c].first,
+                                          cell_data.cells[c].second);
+
+          std::vector<active_cell_iterator> neighbors;
+
+          for (unsigned int j = cell_data.reference_point_ptrs[c];
+               j < cell_data.reference_point_ptrs[c + 1];
+               ++j)
+            {
+              if (try_cell(cell, j))
+                {
+                  found[j] = 1;
+                  continue;
+                }
+
+              if (neighbors.empty())
+                neighbors = face_neighbors(cell);
+
+              for (const auto &neighbor : neighbors)
+                if (try_cell(neighbor, j))
+                  {
+                    found[j] = 1;
+                    break;
+                  }
+            }
+        }
+
+      // several entries of the same point must not end up in the same cell
+      {
+        std::set<std::tuple<unsigned int, unsigned int, std::pair<int, int>>>
+          entries;
+        for (unsigned int j = 0; j < n_cell_entries; ++j)
+          if (found[j] && !entries
+                              .emplace(cell_entry_ranks[j],
+                                       cell_entry_points[j].first,
+                                       new_cells[j])
+                              .second)
+            found[j] = 0;
+      }
+
+      // 3) return the result to the requesting processes: a point is
+      //    settled if it has been found before and all its entries have
+      //    been found again
+      std::vector<unsigned int> settled(points.size(), 0);
+      {
+        std::vector<unsigned int> found_requester, buffer;
+        this->template evaluate_and_process<unsigned int>(
+          found_requester,
+          buffer,
+          [&](const ArrayView<unsigned int> &values, const CellData &) {
+            AssertDimension(values.size(), n_cell_entries);
+            std::copy(found.begin(), found.end(), values.begin());
+          });
+        barrier();
+
+        for (unsigned int i = 0; i < points.size(); ++i)
+          settled[i] =
+            (point_ptrs[i + 1] > point_ptrs[i]) &&
+            std::all_of(found_requester.begin() + point_ptrs[i],
+                        found_requester.begin() + point_ptrs[i + 1],
+                        [](const unsigned int flag) { return flag == 1; });
+      }
+
+      const unsigned int n_unsettled =
+        Utilities::MPI::sum<unsigned int>(std::count(settled.begin(),
+                                                     settled.end(),
+                                                     0),
+                                          comm);
+
+      if (n_unsettled == 0)
+        {
+          // all points have been found by the processes that evaluated them
+          // so far, so that the communication pattern can be kept; only
+          // regroup the entries according to their new cells
+          std::vector<unsigned int> order(n_cell_entries);
+          std::iota(order.begin(), order.end(), 0);
+          std::sort(order.begin(),
+                    order.end(),
+                    [&](const unsigned int a, const unsigned int b) {
+                      if (new_cells[a] != new_cells[b])
+                        return new_cells[a] < new_cells[b];
+                      return send_permutation[a] < send_permutation[b];
+                    });
+
+          const auto old_send_permutation = send_permutation;
+
+          cell_data = {};
+          send_permutation.clear();
+
+          for (const unsigned int j : order)
+            {
+              if (cell_data.cells.empty() ||
+                  cell_data.cells.back() != new_cells[j])
+                {
+                  cell_data.cells.emplace_back(new_cells[j]);
+                  cell_data.reference_point_ptrs.emplace_back(
+                    cell_data.reference_point_values.size());
+                }
+
+              cell_data.reference_point_values.emplace_back(
+                new_reference_points[j]);
+              send_permutation.emplace_back(old_send_permutation[j]);
+            }
+
+          cell_data.reference_point_ptrs.emplace_back(
+            cell_data.reference_point_values.size());
+
+          return;
+        }
+
+      // 4) tell the evaluating processes which points are settled, so that
+      //    they can drop the entries of the remaining ones
+      std::vector<unsigned int> keep(n_cell_entries, 0);
+      {
+        std::vector<unsigned int> buffer;
+        this->template process_and_evaluate<unsigned int>(
+          settled,
+          buffer,
+          [&](const ArrayView<const unsigned int> &values, const CellData &) {
+            AssertDimension(values.size(), n_cell_entries);
+            for (unsigned int j = 0; j < n_cell_entries; ++j)
+              keep[j] = found[j] && values[j];
+          });
+        barrier();
+      }
+
+      // 5) perform the full search for the points that are not settled
+      std::vector<unsigned int>    unsettled_indices;
+      std::vector<Point<spacedim>> unsettled_points;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        if (settled[i] == 0)
+          {
+            unsettled_indices.push_back(i);
+            unsettled_points.push_back(points[i]);
+          }
+
+      const GridTools::Cache<dim, spacedim> cache(*tria, *mapping);
+
+      const auto data =
+        GridTools::internal::distributed_compute_point_locations(
+          cache,
+          unsettled_points,
+          compute_global_bounding_boxes(*tria, *mapping),
+          tolerance,
+          true);
+
+      // 6) merge the kept entries and the ones found by the search. Both
+      //    sides order the entries of each rank such that the kept entries
+      //    come first, followed by the new ones, each sorted by point index.
+      //    Since the unsettled points are extracted in ascending order, the
+      //    indices within the set of unsettled points, which are the only
+      //    ones known to the evaluating process, result in the same order as
+      //    the original indices.
+      struct SendEntry
+      {
+        std::pair<int, int> cell;
+        unsigned int        rank;
+        bool                is_new;
+        unsigned int        point;
+        Point<dim>          reference_point;
+        unsigned int        index;
+      };
+
+      std::vector<SendEntry> send_entries;
+      for (unsigned int j = 0; j < n_cell_entries; ++j)
+        if (keep[j])
+          send_entries.push_back({new_cells[j],
+                                  cell_entry_ranks[j],
+                                  false,
+                                  cell_entry_points[j].first,
+                                  new_reference_points[j],
+                                  numbers::invalid_unsigned_int});
+      for (const auto &i : data.send_components)
+        send_entries.push_back({std::get<0>(i),
+                                std::get<1>(i),
+                                true,
+                                std::get<2>(i),
+                                std::get<3>(i),
+                                numbers::invalid_unsigned_int});
+
+      std::sort(send_entries.begin(),
+                send_entries.end(),
+                [](const SendEntry &a, const SendEntry &b) {
+                  return std::tie(a.rank, a.is_new, a.point, a.cell) <
+                         std::tie(b.rank, b.is_new, b.point, b.cell);
+                });
+
+      send_ranks.clear();
+      send_ptrs.clear();
+      for (unsigned int i = 0; i < send_entries.size(); ++i)
+        {
+          send_entries[i].index = i;
+
+          if (send_ranks.empty() || send_ranks.back() != send_entries[i].rank)
+            {
+              send_ranks.push_back(send_entries[i].rank);
+              send_ptrs.push_back(i);
+            }
+        }
+      send_ptrs.push_back(send_entries.size());
+
+      std::sort(send_entries.begin(),
+                send_entries.end(),
+                [](const SendEntry &a, const SendEntry &b) {
+                  return std::tie(a.cell, a.index) < std::tie(b.cell, b.index);
+                });
+
+      cell_data = {};
+      send_permutation.clear();
+
+      for (const auto &entry : send_entries)
+        {
+          if (cell_data.cells.empty() || cell_data.cells.back() != entry.cell)
+            {
+              cell_data.cells.emplace_back(entry.cell);
+              cell_data.reference_point_ptrs.emplace_back(
+                cell_data.reference_point_values.size());
+            }
+
+          cell_data.reference_point_values.emplace_back(
+            entry.reference_point);
+          send_permutation.emplace_back(entry.index);
+        }
+
+      cell_data.reference_point_ptrs.emplace_back(
+        cell_data.reference_point_values.size());
+
+      // rank providing each kept entry on the requesting side, i.e., each
+      // entry of the output of evaluate_and_process()
+      std::vector<unsigned int> output_ranks(recv_permutation.size());
+      for (unsigned int r = 0; r < recv_ranks.size(); ++r)
+        for (unsigned int b = recv_ptrs[r]; b < recv_ptrs[r + 1]; ++b)
+          output_ranks[recv_permutation[b]] = recv_ranks[r];
+
+      // entries as (rank, is_new, point index, enumeration index)
+      std::vector<std::tuple<unsigned int, bool, unsigned int, unsigned int>>
+        recv_entries;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        if (settled[i])
+          for (unsigned int j = point_ptrs[i]; j < point_ptrs[i + 1]; ++j)
+            recv_entries.emplace_back(output_ranks[j], false, i, 0);
+      for (const auto &i : data.recv_components)
+        recv_entries.emplace_back(std::get<0>(i),
+                                  true,
+                                  unsettled_indices[std::get<1>(i)],
+                                  0);
+
+      std::sort(recv_entries.begin(), recv_entries.end());
+
+      recv_ranks.clear();
+      recv_ptrs.clear();
+      for (unsigned int i = 0; i < recv_entries.size(); ++i)
+        {
+          std::get<3>(recv_entries[i]) = i;
+
+          if (recv_ranks.empty() ||
+              recv_ranks.back() != std::get<0>(recv_entries[i]))
+            {
+              recv_ranks.push_back(std::get<0>(recv_entries[i]));
+              recv_ptrs.push_back(i);
+            }
+        }
+      recv_ptrs.push_back(recv_entries.size());
+
+      // sort according to point index (while keeping partial ordering)
+      std::stable_sort(recv_entries.begin(),
+                       recv_entries.end(),
+                       [](const auto &a, const auto &b) {
+                         return std::get<2>(a) < std::get<2>(b);
+                       });
+
+      recv_permutation.resize(recv_entries.size());
+      point_ptrs.assign(points.size() + 1, 0);
+      for (unsigned int i = 0; i < recv_entries.size(); ++i)
+        {
+          recv_permutation[std::get<3>(recv_entries[i])] = i;
+          point_ptrs[std::get<2>(recv_entries[i]) + 1]++;
+        }
+
+      unique_mapping = true;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        {
+          if (unique_mapping && point_ptrs[i + 1] != 1)
+            unique_mapping = false;
+          point_ptrs[i + 1] += point_ptrs[i];
+        }
+#endif
+    }
+
+
     template <int dim, int spacedim>
     const std::vector<unsigned int> &
     RemotePointEvaluation<dim, spacedim>::get_point_ptrs() const
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2000 - 2020 by the deal.II authors
+// Copyright (C) 2000 - 2021 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -17,11 +17,18 @@
 #include <deal.II/base/utilities.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib> // for std::getenv
 #include <thread>
+#include <vector>
 
 #ifdef DEAL_II_WITH_TBB
 #  include <tbb/task_scheduler_init.h>
+#  include <tbb/task_scheduler_observer.h>
+#endif
+
+#ifdef DEAL_II_WITH_HWLOC
+#  include <hwloc.h>
 #endif
 
 
@@ -34,6 +41,83 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 DEAL_II_NAMESPACE_OPEN
 
 
+#ifdef DEAL_II_WITH_HWLOC
+namespace
+{
+  /**
+   * Return the topology of the compute node, which is detected upon the
+   * first call of this function.
+   */
+  hwloc_topology_t
+  get_topology()
+  {
+    static struct Topology
+    {
+      Topology()
+      {
+        hwloc_topology_init(&topology);
+        const int ierr = hwloc_topology_load(topology);
+        AssertThrow(ierr == 0,
+                    ExcMessage("The topology of this compute node could not "
+                               "be detected by hwloc."));
+      }
+
+      ~Topology()
+      {
+        hwloc_topology_destroy(topology);
+      }
+
+      hwloc_topology_t topology;
+    } topology;
+
+    return topology.topology;
+  }
+
+
+
+  /**
+   * The sets of processing units of the cores the threads of this process
+   * are pinned to by MultithreadInfo::pin_threads(), and the number of
+   * worker threads pinned so far.
+   */
+  std::vector<hwloc_bitmap_t> pinned_cores;
+  std::atomic<unsigned int>   n_pinned_workers(0);
+
+
+
+#  ifdef DEAL_II_WITH_TBB
+  /**
+   * An observer that pins each worker thread of the TBB to one of the cores
+   * in pinned_cores when the thread first joins the task scheduler.
+   */
+  class PinningObserver : public tbb::task_scheduler_observer
+  {
+  public:
+    PinningObserver()
+    {
+      observe(true);
+    }
+
+    virtual void
+    on_scheduler_entry(bool is_worker) override
+    {
+      thread_local bool is_pinned = false;
+      if (is_worker && !is_pinned && pinned_cores.size() > 0)
+        {
+          const unsigned int core = n_pinned_workers++ % pinned_cores.size();
+          hwloc_set_cpubind(get_topology(),
+                            pinned_cores[core],
+                            HWLOC_CPUBIND_THREAD);
+          is_pinned = true;
+        }
+    }
+  };
+#  endif
+} // namespace
+#endif
+
+
+
 unsigned int
 MultithreadInfo::n_cores()
 {
@@ -143,6 +227,120 @@ MultithreadInfo::initialize_multithreading()
   done = true;
 }
 
+unsigned int
+MultithreadInfo::n_numa_domains()
+{
+#ifdef DEAL_II_WITH_HWLOC
+  const int n_domains =
+    hwloc_get_nbobjs_by_type(get_topology(), HWLOC_OBJ_NUMANODE);
+  return std::max(n_domains, 1);
+#else
+  return 1;
+#endif
+}
+
+
+
+unsigned int
+MultithreadInfo::current_numa_domain()
+{
+#ifdef DEAL_II_WITH_HWLOC
+  const hwloc_topology_t topology = get_topology();
+
+  unsigned int   domain = 0;
+  hwloc_bitmap_t cpuset = hwloc_bitmap_alloc();
+  if (hwloc_get_last_cpu_location(topology, cpuset, HWLOC_CPUBIND_THREAD) ==
+      0)
+    {
+      const int n_domains =
+        hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NUMANODE);
+      for (int d = 0; d < n_domains; ++d)
+        if (hwloc_bitmap_intersects(
+              hwloc_get_obj_by_type(topology, HWLOC_OBJ_NUMANODE, d)->cpuset,
+              cpuset))
+          {
+            domain = d;
+            break;
+          }
+    }
+  hwloc_bitmap_free(cpuset);
+
+  return domain;
+#else
+  return 0;
+#endif
+}
+
+
+
+void
+MultithreadInfo::pin_threads(const MPI_Comm &mpi_communicator)
+{
+  // find out how many processes of the communicator share this node and
+  // which of them we are
+  int process_on_node     = 0;
+  int n_processes_on_node = 1;
+#ifdef DEAL_II_WITH_MPI
+  MPI_Comm node_communicator;
+  int      ierr = MPI_Comm_split_type(mpi_communicator,
+                                      MPI_COMM_TYPE_SHARED,
+                                      0,
+                                      MPI_INFO_NULL,
+                                      &node_communicator);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Comm_rank(node_communicator, &process_on_node);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Comm_size(node_communicator, &n_processes_on_node);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Comm_free(&node_communicator);
+  AssertThrowMPI(ierr);
+#else
+  (void)mpi_communicator;
+#endif
+
+#ifdef DEAL_II_WITH_HWLOC
+  const hwloc_topology_t topology = get_topology();
+
+  // give each process a contiguous range of cores. if there are more
+  // processes than cores, several processes share a core
+  const int n_cores = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_CORE);
+  if (n_cores <= 0)
+    return;
+  int first_core = process_on_node * n_cores / n_processes_on_node;
+  int end_core   = (process_on_node + 1) * n_cores / n_processes_on_node;
+  if (first_core == end_core)
+    {
+      first_core = process_on_node % n_cores;
+      end_core   = first_core + 1;
+    }
+
+  for (hwloc_bitmap_t &cpuset : pinned_cores)
+    hwloc_bitmap_free(cpuset);
+  pinned_cores.clear();
+  for (int c = first_core; c < end_core; ++c)
+    pinned_cores.push_back(hwloc_bitmap_dup(
+      hwloc_get_obj_by_type(topology, HWLOC_OBJ_CORE, c)->cpuset));
+  n_pinned_workers = 0;
+
+  // pin the calling thread, and stop if the operating system does not
+  // support it
+  if (hwloc_set_cpubind(topology, pinned_cores[0], HWLOC_CPUBIND_THREAD) !=
+      0)
+    return;
+
+#  ifdef DEAL_II_WITH_TBB
+  static PinningObserver observer;
+#  endif
+
+  set_thread_limit(std::min<unsigned int>(n_threads(), end_core - first_core));
+#else
+  (void)process_on_node;
+  (void)n_processes_on_node;
+#endif
+}
+
+
+
 #ifdef DEAL_II_WITH_TASKFLOW
 tf::Executor &
 MultithreadInfo::get_taskflow_executor()
@@ -23,6 +23,155 @@ namespace Utilities
 {
   namespace MPI
   {
+#ifdef DEAL_II_WITH_MPI
+    namespace internal
+    {
+      bool
+      PersistentRequests::Message::operator==(const Message &other) const
+      {
+        return is_send == other.is_send && buffer == other.buffer &&
+               count == other.count && datatype == other.datatype &&
+               rank == other.rank && tag == other.tag && comm == other.comm;
+      }
+
+
+
+      PersistentRequests::PersistentRequests(
+        const unsigned int max_n_exchanges)
+        : max_n_exchanges(max_n_exchanges)
+      {}
+
+
+
+      PersistentRequests::~PersistentRequests()
+      {
+        // the requests can not be freed any more once MPI has been finalized
+        int       finalized = 0;
+        const int ierr      = MPI_Finalized(&finalized);
+        AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+        (void)ierr;
+        if (finalized != 0)
+          return;
+
+        for (auto &exchange : exchanges)
+          for (auto &request : exchange.requests)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+              (void)ierr;
+            }
+      }
+
+
+
+      const std::vector<MPI_Request> &
+      PersistentRequests::get(const std::vector<Message> &messages)
+      {
+        if (messages.empty())
+          return no_requests;
+
+        for (auto it = exchanges.begin(); it != exchanges.end(); ++it)
+          if (it->in_use == false && it->messages == messages)
+            {
+              it->in_use = true;
+              exchanges.splice(exchanges.begin(), exchanges, it);
+              return exchanges.front().requests;
+            }
+
+        // free the least recently used exchanges that are not in use to make
+        // room for the new one
+        unsigned int n_unused = 0;
+        for (auto it = exchanges.begin(); it != exchanges.end();)
+          if (it->in_use == false && ++n_unused >= max_n_exchanges)
+            {
+              for (auto &request : it->requests)
+                {
+                  const int ierr = MPI_Request_free(&request);
+                  AssertThrowMPI(ierr);
+                }
+              it = exchanges.erase(it);
+            }
+          else
+            ++it;
+
+        Exchange exchange;
+        exchange.messages = messages;
+        exchange.requests.resize(messages.size());
+        exchange.in_use = true;
+        for (unsigned int i = 0; i < messages.size(); ++i)
+          {
+            const Message &m = messages[i];
+            const int      ierr =
+              m.is_send ? MPI_Send_init(m.buffer,
+                                        m.count,
+                                        m.datatype,
+                                        m.rank,
+                                        m.tag,
+                                        m.comm,
+                                        &exchange.requests[i]) :
+                          MPI_Recv_init(m.buffer,
+                                        m.count,
+                                        m.datatype,
+                                        m.rank,
+                                        m.tag,
+                                        m.comm,
+                                        &exchange.requests[i]);
+            AssertThrowMPI(ierr);
+          }
+        exchanges.push_front(std::move(exchange));
+
+        return exchanges.front().requests;
+      }
+
+
+
+      std::list<PersistentRequests::Exchange>::iterator
+      PersistentRequests::find(const MPI_Request *requests,
+                               const unsigned int n_requests)
+      {
+        for (auto it = exchanges.begin(); it != exchanges.end(); ++it)
+          if (it->in_use && it->requests.size() == n_requests &&
+              std::equal(it->requests.begin(), it->requests.end(), requests))
+            return it;
+        return exchanges.end();
+      }
+
+
+
+      void
+      PersistentRequests::release(const MPI_Request *requests,
+                                  const unsigned int n_requests)
+      {
+        if (n_requests == 0)
+          return;
+
+        const auto it = find(requests, n_requests);
+        Assert(it != exchanges.end(),
+               ExcMessage("The given requests are not managed by this "
+                          "object or have already been released."));
+        if (it != exchanges.end())
+          it->in_use = false;
+      }
+
+
+
+      void
+      PersistentRequests::forget(const MPI_Request *requests,
+                                 const unsigned int n_requests)
+      {
+        for (auto it = exchanges.begin(); it != exchanges.end();)
+          if (it->in_use &&
+              std::find(requests, requests + n_requests, it->requests[0]) !=
+                requests + n_requests)
+            it = exchanges.erase(it);
+          else
+            ++it;
+      }
+    } // namespace internal
+#endif
+
+
+
     Partitioner::Partitioner()
       : global_size(0)
       , local_range_data(
@@ -502,6 +651,23 @@ namespace Utilities
 
 
 
+#ifdef DEAL_II_WITH_MPI
+    void
+    Partitioner::free_requests(std::vector<MPI_Request> &requests) const
+    {
+      persistent_requests.forget(requests.data(), requests.size());
+      for (auto &request : requests)
+        if (request != MPI_REQUEST_NULL)
+          {
+            const int ierr = MPI_Request_free(&request);
+            AssertThrowMPI(ierr);
+          }
+      requests.clear();
+    }
+#endif
+
+
+
     std::size_t
     Partitioner::memory_consumption() const
     {
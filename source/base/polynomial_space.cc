@@ -400,6 +400,30 @@ PolynomialSpace<dim>::evaluate(
 
 
 
+template <int dim>
+void
+PolynomialSpace<dim>::evaluate_on_points(
+  const std::vector<Point<dim>> &unit_points,
+  Table<2, double> &             values,
+  Table<2, Tensor<1, dim>> &     grads,
+  Table<2, Tensor<2, dim>> &     grad_grads,
+  Table<2, Tensor<3, dim>> &     third_derivatives) const
+{
+  std::vector<std::array<unsigned int, dim>> tensor_indices(this->n());
+  for (unsigned int i = 0; i < this->n(); ++i)
+    tensor_indices[i] = compute_index(i);
+
+  internal::evaluate_tensor_products_on_points(polynomials,
+                                               tensor_indices,
+                                               unit_points,
+                                               values,
+                                               grads,
+                                               grad_grads,
+                                               third_derivatives);
+}
+
+
+
 template <int dim>
 std::unique_ptr<ScalarPolynomialsBase<dim>>
 PolynomialSpace<dim>::clone() const
@@ -21,6 +21,9 @@
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -58,6 +61,89 @@ QGaussLobatto<0>::QGaussLobatto(const unsigned int)
 
 
 
+namespace internal
+{
+  namespace QuadratureCache
+  {
+    /**
+     * The one-dimensional formulas stored in the cache.
+     */
+    enum class Type
+    {
+      gauss,
+      gauss_lobatto
+    };
+
+
+
+    /**
+     * Return the one-dimensional quadrature formula of the given @p type
+     * with @p n points from a process-wide cache. The formula is computed by
+     * @p compute upon the first request and shared by all later requests,
+     * so that the roots of the Jacobi polynomials are not recomputed every
+     * time a QGauss or QGaussLobatto object (or one of higher dimension,
+     * which is built from the one-dimensional formula) is created. The
+     * returned object is never modified and remains valid until the end of
+     * the program.
+     */
+    const Quadrature<1> &
+    get(const Type                                type,
+        const unsigned int                        n,
+        const std::function<Quadrature<1>(void)> &compute)
+    {
+      static std::mutex mutex;
+      static std::map<std::pair<Type, unsigned int>,
+                      std::unique_ptr<const Quadrature<1>>>
+        cache;
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      std::unique_ptr<const Quadrature<1>> &entry = cache[{type, n}];
+      if (entry == nullptr)
+        entry = std::make_unique<const Quadrature<1>>(compute());
+      return *entry;
+    }
+  } // namespace QuadratureCache
+
+
+
+  namespace QGauss
+  {
+    /**
+     * Compute the points and weights of the Gauss-Legendre formula with
+     * @p n points.
+     */
+    Quadrature<1>
+    compute_quadrature(const unsigned int n)
+    {
+      std::vector<Point<1>> quadrature_points(n);
+      std::vector<double>   weights(n);
+
+      std::vector<long double> points =
+        Polynomials::jacobi_polynomial_roots<long double>(n, 0, 0);
+
+      for (unsigned int i = 0; i < (points.size() + 1) / 2; ++i)
+        {
+          quadrature_points[i][0]         = points[i];
+          quadrature_points[n - i - 1][0] = 1. - points[i];
+
+          // derivative of Jacobi polynomial
+          const long double pp =
+            0.5 * (n + 1) *
+            Polynomials::jacobi_polynomial_value(n - 1, 1, 1, points[i]);
+          const long double x = -1. + 2. * points[i];
+          const double      w = 1. / ((1. - x * x) * pp * pp);
+          weights[i]          = w;
+          weights[n - i - 1]  = w;
+        }
+
+      return Quadrature<1>(quadrature_points, weights);
+    }
+  } // namespace QGauss
+} // namespace internal
+
+
+
 template <>
 QGauss<1>::QGauss(const unsigned int n)
   : Quadrature<1>(n)
@@ -65,23 +151,12 @@ QGauss<1>::QGauss(const unsigned int n)
   if (n == 0)
     return;
 
-  std::vector<long double> points =
-    Polynomials::jacobi_polynomial_roots<long double>(n, 0, 0);
-
-  for (unsigned int i = 0; i < (points.size() + 1) / 2; ++i)
-    {
-      this->quadrature_points[i][0]         = points[i];
-      this->quadrature_points[n - i - 1][0] = 1. - points[i];
-
-      // derivative of Jacobi polynomial
-      const long double pp =
-        0.5 * (n + 1) *
-        Polynomials::jacobi_polynomial_value(n - 1, 1, 1, points[i]);
-      const long double x      = -1. + 2. * points[i];
-      const double      w      = 1. / ((1. - x * x) * pp * pp);
-      this->weights[i]         = w;
-      this->weights[n - i - 1] = w;
-    }
+  const Quadrature<1> &quadrature = internal::QuadratureCache::get(
+    internal::QuadratureCache::Type::gauss, n, [n]() {
+      return internal::QGauss::compute_quadrature(n);
+    });
+  this->quadrature_points = quadrature.get_points();
+  this->weights           = quadrature.get_weights();
 }
 
 namespace internal
@@ -143,19 +218,27 @@ QGaussLobatto<1>::QGaussLobatto(const unsigned int n)
 {
   Assert(n >= 2, ExcNotImplemented());
 
-  std::vector<long double> points =
-    Polynomials::jacobi_polynomial_roots<long double>(n - 2, 1, 1);
-  points.insert(points.begin(), 0);
-  points.push_back(1.);
-  std::vector<long double> w =
-    internal::QGaussLobatto::compute_quadrature_weights(points, 0, 0);
-
-  // scale weights to the interval [0.0, 1.0]:
-  for (unsigned int i = 0; i < points.size(); ++i)
-    {
-      this->quadrature_points[i][0] = points[i];
-      this->weights[i]              = 0.5 * w[i];
-    }
+  const Quadrature<1> &quadrature = internal::QuadratureCache::get(
+    internal::QuadratureCache::Type::gauss_lobatto, n, [n]() {
+      std::vector<long double> points =
+        Polynomials::jacobi_polynomial_roots<long double>(n - 2, 1, 1);
+      points.insert(points.begin(), 0);
+      points.push_back(1.);
+      std::vector<long double> w =
+        internal::QGaussLobatto::compute_quadrature_weights(points, 0, 0);
+
+      // scale weights to the interval [0.0, 1.0]:
+      std::vector<Point<1>> quadrature_points(n);
+      std::vector<double>   weights(n);
+      for (unsigned int i = 0; i < points.size(); ++i)
+        {
+          quadrature_points[i][0] = points[i];
+          weights[i]              = 0.5 * w[i];
+        }
+      return Quadrature<1>(quadrature_points, weights);
+    });
+  this->quadrature_points = quadrature.get_points();
+  this->weights           = quadrature.get_weights();
 }
 #endif
 
@@ -34,6 +34,47 @@ ScalarPolynomialsBase<dim>::ScalarPolynomialsBase(
 
 
 
+template <int dim>
+void
+ScalarPolynomialsBase<dim>::evaluate_on_points(
+  const std::vector<Point<dim>> &unit_points,
+  Table<2, double> &             values,
+  Table<2, Tensor<1, dim>> &     grads,
+  Table<2, Tensor<2, dim>> &     grad_grads,
+  Table<2, Tensor<3, dim>> &     third_derivatives) const
+{
+  const unsigned int n_points = unit_points.size();
+
+  std::vector<double>         point_values(values.n_rows() > 0 ? n() : 0);
+  std::vector<Tensor<1, dim>> point_grads(grads.n_rows() > 0 ? n() : 0);
+  std::vector<Tensor<2, dim>> point_grad_grads(
+    grad_grads.n_rows() > 0 ? n() : 0);
+  std::vector<Tensor<3, dim>> point_third_derivatives(
+    third_derivatives.n_rows() > 0 ? n() : 0);
+  std::vector<Tensor<4, dim>> point_fourth_derivatives;
+
+  for (unsigned int q = 0; q < n_points; ++q)
+    {
+      evaluate(unit_points[q],
+               point_values,
+               point_grads,
+               point_grad_grads,
+               point_third_derivatives,
+               point_fourth_derivatives);
+
+      for (unsigned int i = 0; i < point_values.size(); ++i)
+        values(i, q) = point_values[i];
+      for (unsigned int i = 0; i < point_grads.size(); ++i)
+        grads(i, q) = point_grads[i];
+      for (unsigned int i = 0; i < point_grad_grads.size(); ++i)
+        grad_grads(i, q) = point_grad_grads[i];
+      for (unsigned int i = 0; i < point_third_derivatives.size(); ++i)
+        third_derivatives(i, q) = point_third_derivatives[i];
+    }
+}
+
+
+
 template <int dim>
 std::size_t
 ScalarPolynomialsBase<dim>::memory_consumption() const
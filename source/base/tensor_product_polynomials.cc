@@ -484,6 +484,47 @@ TensorProductPolynomials<0, Polynomials::Polynomial<double>>::evaluate(
 
 
 
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim, PolynomialType>::evaluate_on_points(
+  const std::vector<Point<dim>> &unit_points,
+  Table<2, double> &             values,
+  Table<2, Tensor<1, dim>> &     grads,
+  Table<2, Tensor<2, dim>> &     grad_grads,
+  Table<2, Tensor<3, dim>> &     third_derivatives) const
+{
+  Assert(dim <= 3, ExcNotImplemented());
+
+  std::vector<std::array<unsigned int, dim>> tensor_indices(this->n());
+  for (unsigned int i = 0; i < this->n(); ++i)
+    compute_index(i, tensor_indices[i]);
+
+  internal::evaluate_tensor_products_on_points(polynomials,
+                                               tensor_indices,
+                                               unit_points,
+                                               values,
+                                               grads,
+                                               grad_grads,
+                                               third_derivatives);
+}
+
+
+
+template <>
+void
+TensorProductPolynomials<0, Polynomials::Polynomial<double>>::
+  evaluate_on_points(const std::vector<Point<0>> &,
+                     Table<2, double> &,
+                     Table<2, Tensor<1, 0>> &,
+                     Table<2, Tensor<2, 0>> &,
+                     Table<2, Tensor<3, 0>> &) const
+{
+  constexpr int dim = 0;
+  AssertThrow(dim > 0, ExcNotImplemented());
+}
+
+
+
 template <int dim, typename PolynomialType>
 std::unique_ptr<ScalarPolynomialsBase<dim>>
 TensorProductPolynomials<dim, PolynomialType>::clone() const
@@ -14,9 +14,14 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/types.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <exception>
+#include <iomanip>
 #include <iostream>
 
 #ifdef DEAL_II_HAVE_UNISTD_H
@@ -139,6 +144,185 @@ namespace Threads
       }
     return return_values;
   }
+
+
+
+  TaskGraph::TaskId
+  TaskGraph::add_task(const std::string &          name,
+                      const std::function<void()> &function,
+                      const std::vector<TaskId> &  dependencies)
+  {
+    for (const TaskId d : dependencies)
+      AssertIndexRange(d, nodes.size());
+
+    nodes.push_back(Node{name, function, dependencies, 0.});
+    return nodes.size() - 1;
+  }
+
+
+
+  unsigned int
+  TaskGraph::n_tasks() const
+  {
+    return nodes.size();
+  }
+
+
+
+  void
+  TaskGraph::run()
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    // tasks can only depend on tasks added before them, so starting them in
+    // the order they were added means that all tasks a task waits for are
+    // already running. each task first waits for its dependencies and then
+    // runs its own function. if one of the dependencies threw an exception,
+    // join() throws that exception again, so the function is not run and the
+    // exception propagates to all tasks depending on it
+    std::vector<Task<void>> tasks(nodes.size());
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+      {
+        std::vector<Task<void>> dependencies;
+        for (const TaskId d : nodes[i].dependencies)
+          dependencies.push_back(tasks[d]);
+
+        Node &node = nodes[i];
+        tasks[i]   = new_task([&node, dependencies]() {
+          for (const Task<void> &d : dependencies)
+            d.join();
+
+          const auto task_start = std::chrono::steady_clock::now();
+          node.function();
+          node.wall_time = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - task_start)
+                             .count();
+        });
+      }
+
+    // wait for all tasks, also if some of them failed, before we pass on the
+    // first exception: the tasks refer to the nodes of this object
+    std::exception_ptr exception;
+    for (const Task<void> &task : tasks)
+      try
+        {
+          task.join();
+        }
+      catch (...)
+        {
+          if (!exception)
+            exception = std::current_exception();
+        }
+
+    total_wall_time = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
+
+
+  double
+  TaskGraph::get_wall_time(const TaskId task) const
+  {
+    AssertIndexRange(task, nodes.size());
+    return nodes[task].wall_time;
+  }
+
+
+
+  double
+  TaskGraph::get_total_wall_time() const
+  {
+    return total_wall_time;
+  }
+
+
+
+  std::vector<TaskGraph::TaskId>
+  TaskGraph::critical_path() const
+  {
+    if (nodes.empty())
+      return {};
+
+    // the nodes are topologically sorted, so a single sweep computes the
+    // longest accumulated time of a chain ending in each node
+    const TaskId        invalid = numbers::invalid_unsigned_int;
+    std::vector<double> path_time(nodes.size());
+    std::vector<TaskId> predecessor(nodes.size(), invalid);
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+      {
+        double longest_dependency = 0.;
+        for (const TaskId d : nodes[i].dependencies)
+          if (predecessor[i] == invalid || path_time[d] > longest_dependency)
+            {
+              longest_dependency = path_time[d];
+              predecessor[i]     = d;
+            }
+        path_time[i] = longest_dependency + nodes[i].wall_time;
+      }
+
+    std::vector<TaskId> path;
+    for (TaskId i = std::max_element(path_time.begin(), path_time.end()) -
+                    path_time.begin();
+         i != invalid;
+         i = predecessor[i])
+      path.push_back(i);
+    std::reverse(path.begin(), path.end());
+
+    return path;
+  }
+
+
+
+  double
+  TaskGraph::critical_path_length() const
+  {
+    double length = 0.;
+    for (const TaskId i : critical_path())
+      length += nodes[i].wall_time;
+    return length;
+  }
+
+
+
+  void
+  TaskGraph::print_summary(std::ostream &out) const
+  {
+    std::size_t name_width = 0;
+    for (const Node &node : nodes)
+      name_width = std::max(name_width, node.name.size());
+
+    const std::vector<TaskId> path = critical_path();
+
+    const auto flags     = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+      out << (std::find(path.begin(), path.end(), i) != path.end() ? "* " :
+                                                                     "  ")
+          << std::left << std::setw(name_width) << nodes[i].name << "  "
+          << std::right << std::setw(10) << nodes[i].wall_time << " s"
+          << std::endl;
+    out << "Total wall time:      " << total_wall_time << " s" << std::endl
+        << "Critical path length: " << critical_path_length() << " s"
+        << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+  }
+
+
+
+  void
+  TaskGraph::clear()
+  {
+    nodes.clear();
+    total_wall_time = 0.;
+  }
 } // namespace Threads
 
 
@@ -17,6 +17,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/timer.h>
+#include <deal.II/base/tracing.h>
 #include <deal.II/base/utilities.h>
 
 #include <boost/io/ios_state.hpp>
@@ -38,6 +39,13 @@
 #  include <windows.h>
 #endif
 
+#ifdef DEAL_II_WITH_LIKWID
+#  include <likwid.h>
+
+#  include <cstdlib>
+#  include <mutex>
+#endif
+
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -101,6 +109,30 @@ namespace internal
         data.min_index = numbers::invalid_unsigned_int;
         data.max_index = numbers::invalid_unsigned_int;
       }
+
+#ifdef DEAL_II_WITH_LIKWID
+      /**
+       * Make sure that the LIKWID marker API has been initialized for the
+       * process and for the calling thread. The marker API is closed again
+       * when the program exits.
+       */
+      void
+      ensure_likwid_marker_initialization()
+      {
+        static std::once_flag process_initialization;
+        std::call_once(process_initialization, []() {
+          likwid_markerInit();
+          std::atexit(likwid_markerClose);
+        });
+
+        thread_local bool thread_is_initialized = false;
+        if (!thread_is_initialized)
+          {
+            likwid_markerThreadInit();
+            thread_is_initialized = true;
+          }
+      }
+#endif
     } // namespace
   }   // namespace TimerImplementation
 } // namespace internal
@@ -305,6 +337,7 @@ TimerOutput::TimerOutput(std::ostream &        stream,
   , output_type(output_type)
   , out_stream(stream, true)
   , output_is_enabled(true)
+  , use_likwid_markers(false)
   , mpi_communicator(MPI_COMM_SELF)
 {}
 
@@ -317,6 +350,7 @@ TimerOutput::TimerOutput(ConditionalOStream &  stream,
   , output_type(output_type)
   , out_stream(stream)
   , output_is_enabled(true)
+  , use_likwid_markers(false)
   , mpi_communicator(MPI_COMM_SELF)
 {}
 
@@ -330,6 +364,7 @@ TimerOutput::TimerOutput(const MPI_Comm &      mpi_communicator,
   , output_type(output_type)
   , out_stream(stream, true)
   , output_is_enabled(true)
+  , use_likwid_markers(false)
   , mpi_communicator(mpi_communicator)
 {}
 
@@ -343,6 +378,7 @@ TimerOutput::TimerOutput(const MPI_Comm &      mpi_communicator,
   , output_type(output_type)
   , out_stream(stream)
   , output_is_enabled(true)
+  , use_likwid_markers(false)
   , mpi_communicator(mpi_communicator)
 {}
 
@@ -430,12 +466,25 @@ TimerOutput::enter_subsection(const std::string &section_name)
       sections[section_name].total_cpu_time  = 0;
       sections[section_name].total_wall_time = 0;
       sections[section_name].n_calls         = 0;
+      sections[section_name].n_flops         = 0;
+      sections[section_name].n_bytes         = 0;
     }
 
   sections[section_name].timer.reset();
   sections[section_name].timer.start();
   ++sections[section_name].n_calls;
 
+  if (Tracing::is_enabled())
+    sections[section_name].trace_start_time = std::chrono::steady_clock::now();
+
+#ifdef DEAL_II_WITH_LIKWID
+  if (use_likwid_markers)
+    {
+      internal::TimerImplementation::ensure_likwid_marker_initialization();
+      likwid_markerStartRegion(section_name.c_str());
+    }
+#endif
+
   active_sections.push_back(section_name);
 }
 
@@ -444,11 +493,11 @@ TimerOutput::enter_subsection(const std::string &section_name)
 void
 TimerOutput::leave_subsection(const std::string &section_name)
 {
+  std::lock_guard<std::mutex> lock(mutex);
+
   Assert(!active_sections.empty(),
          ExcMessage("Cannot exit any section because none has been entered!"));
 
-  std::lock_guard<std::mutex> lock(mutex);
-
   if (!section_name.empty())
     {
       Assert(sections.find(section_name) != sections.end(),
@@ -465,6 +514,15 @@ TimerOutput::leave_subsection(const std::string &section_name)
     (section_name.empty() ? active_sections.back() : section_name);
 
   sections[actual_section_name].timer.stop();
+#ifdef DEAL_II_WITH_LIKWID
+  if (use_likwid_markers)
+    likwid_markerStopRegion(actual_section_name.c_str());
+#endif
+  if (Tracing::is_enabled())
+    Tracing::add_event(actual_section_name,
+                       "TimerOutput",
+                       sections[actual_section_name].trace_start_time,
+                       std::chrono::steady_clock::now());
   sections[actual_section_name].total_wall_time +=
     sections[actual_section_name].timer.last_wall_time();
 
@@ -1019,6 +1077,115 @@ TimerOutput::print_wall_time_statistics(const MPI_Comm &mpi_comm,
 
 
 
+void
+TimerOutput::add_operation_counts(const std::string &section_name,
+                                  const double       n_flops,
+                                  const double       n_bytes)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Assert(sections.find(section_name) != sections.end(),
+         ExcMessage("Cannot add operation counts to the section <" +
+                    section_name + "> that has never been entered."));
+
+  Section &section = sections[section_name];
+  section.n_flops += n_flops;
+  section.n_bytes += n_bytes;
+}
+
+
+
+void
+TimerOutput::print_throughput_statistics(const MPI_Comm &mpi_comm) const
+{
+  // we are going to change the precision and width of output below. store the
+  // old values so the get restored when exiting this function
+  const boost::io::ios_base_all_saver restore_stream(out_stream.get_stream());
+
+  AssertDimension(sections.size(),
+                  Utilities::MPI::max(sections.size(), mpi_comm));
+
+  // collect the data of all sections to reduce them in a single
+  // communication step each
+  const unsigned int  n_sections = sections.size();
+  std::vector<double> times(n_sections), counts(2 * n_sections);
+  {
+    unsigned int index = 0;
+    for (const auto &i : sections)
+      {
+        times[index]               = i.second.total_wall_time;
+        counts[index]              = i.second.n_flops;
+        counts[n_sections + index] = i.second.n_bytes;
+        ++index;
+      }
+  }
+  Utilities::MPI::max(times, mpi_comm, times);
+  Utilities::MPI::sum(counts, mpi_comm, counts);
+
+  // get the maximum width among all sections
+  unsigned int max_width = 0;
+  for (const auto &i : sections)
+    max_width =
+      std::max(max_width, static_cast<unsigned int>(i.first.length()));
+
+  // 17 is the default width until | character
+  max_width = std::max(max_width + 1, static_cast<unsigned int>(17));
+  const std::string extra_dash  = std::string(max_width - 17, '-');
+  const std::string extra_space = std::string(max_width - 17, ' ');
+
+  const std::string separator =
+    "+------------------" + extra_dash +
+    "+-----------+------------+------------+------------+------------+\n";
+
+  out_stream << "\n" << separator;
+  out_stream << "| Section          " << extra_space << "| no. calls "
+             << "|   max time |    GFLOP/s |       GB/s |  FLOP/byte |\n";
+  out_stream << separator;
+
+  unsigned int index = 0;
+  for (const auto &i : sections)
+    {
+      const double time    = times[index];
+      const double n_flops = counts[index];
+      const double n_bytes = counts[n_sections + index];
+      ++index;
+
+      // only list sections for which we got some counts
+      if (n_flops == 0. && n_bytes == 0.)
+        continue;
+
+      std::string name_out = i.first;
+      name_out.resize(max_width, ' ');
+      out_stream << "| " << name_out << "| " << std::setw(9)
+                 << i.second.n_calls << " |";
+      out_stream << std::setw(10) << std::setprecision(4) << std::right
+                 << time << "s |";
+      out_stream << std::setw(11) << std::setprecision(4) << std::right
+                 << (time > 0. ? 1e-9 * n_flops / time : 0.) << " |";
+      out_stream << std::setw(11) << std::setprecision(4) << std::right
+                 << (time > 0. ? 1e-9 * n_bytes / time : 0.) << " |";
+      out_stream << std::setw(11) << std::setprecision(4) << std::right
+                 << (n_bytes > 0. ? n_flops / n_bytes : 0.) << " |\n";
+    }
+  out_stream << separator;
+}
+
+
+
+void
+TimerOutput::enable_likwid_markers(const bool enable)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Assert(active_sections.empty(),
+         ExcMessage("LIKWID markers can only be enabled or disabled while "
+                    "no section is active."));
+
+  use_likwid_markers = enable;
+}
+
+
+
 void
 TimerOutput::disable_output()
 {
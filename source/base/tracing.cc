@@ -0,0 +1,239 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/tracing.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Tracing
+{
+  namespace internal
+  {
+    std::atomic<bool> recording_is_enabled(false);
+  }
+
+
+
+  namespace
+  {
+    /**
+     * The data stored for each event. Times are in microseconds since the
+     * call to enable().
+     */
+    struct Event
+    {
+      std::string name;
+      const char *category;
+      double      start;
+      double      duration;
+    };
+
+    /**
+     * The ring buffer of events of one thread. The events are stored at
+     * position <tt>n_recorded % events.size()</tt>, so once the buffer is
+     * full, the oldest events are overwritten.
+     */
+    struct ThreadBuffer
+    {
+      unsigned int       thread_index;
+      std::vector<Event> events;
+      std::size_t        n_recorded;
+    };
+
+    /**
+     * The buffers of all threads that have recorded events, together with a
+     * mutex guarding the list.
+     */
+    std::mutex                                 buffer_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers;
+
+    /**
+     * The size of the ring buffer of each thread.
+     */
+    unsigned int events_per_thread = 0;
+
+    /**
+     * The time at which recording was enabled.
+     */
+    std::chrono::steady_clock::time_point epoch;
+
+    /**
+     * A counter that is incremented whenever the list of buffers is reset,
+     * which tells the threads that the buffer they cached is gone.
+     */
+    std::atomic<unsigned int> buffer_generation(0);
+
+
+
+    /**
+     * Return the buffer of the calling thread, creating it upon the first
+     * event recorded by this thread.
+     */
+    ThreadBuffer &
+    get_thread_buffer()
+    {
+      thread_local ThreadBuffer *buffer            = nullptr;
+      thread_local unsigned int  cached_generation = 0;
+
+      const unsigned int generation = buffer_generation.load();
+      if (buffer == nullptr || cached_generation != generation)
+        {
+          std::lock_guard<std::mutex> lock(buffer_mutex);
+          thread_buffers.push_back(std::make_unique<ThreadBuffer>());
+          buffer               = thread_buffers.back().get();
+          buffer->thread_index = thread_buffers.size() - 1;
+          buffer->events.resize(events_per_thread);
+          buffer->n_recorded = 0;
+          cached_generation  = generation;
+        }
+      return *buffer;
+    }
+
+
+
+    /**
+     * Escape the characters of @p name that have a special meaning in JSON
+     * strings.
+     */
+    std::string
+    escape_json(const std::string &name)
+    {
+      std::string escaped;
+      escaped.reserve(name.size());
+      for (const char c : name)
+        if (c == '"' || c == '\\')
+          {
+            escaped += '\\';
+            escaped += c;
+          }
+        else if (static_cast<unsigned char>(c) < 0x20)
+          escaped += ' ';
+        else
+          escaped += c;
+      return escaped;
+    }
+  } // namespace
+
+
+
+  void
+  enable(const unsigned int n_events_per_thread)
+  {
+    Assert(n_events_per_thread > 0,
+           ExcMessage("The buffer must be able to hold at least one event."));
+
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    thread_buffers.clear();
+    ++buffer_generation;
+    events_per_thread = n_events_per_thread;
+    epoch             = std::chrono::steady_clock::now();
+
+    internal::recording_is_enabled = true;
+  }
+
+
+
+  void
+  disable()
+  {
+    internal::recording_is_enabled = false;
+  }
+
+
+
+  void
+  clear()
+  {
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    thread_buffers.clear();
+    ++buffer_generation;
+  }
+
+
+
+  void
+  add_event(const std::string &                          name,
+            const char *                                 category,
+            const std::chrono::steady_clock::time_point &start,
+            const std::chrono::steady_clock::time_point &end)
+  {
+    if (!is_enabled())
+      return;
+
+    using microseconds = std::chrono::duration<double, std::micro>;
+
+    ThreadBuffer &buffer = get_thread_buffer();
+    Event &event = buffer.events[buffer.n_recorded % buffer.events.size()];
+
+    event.name     = name;
+    event.category = category;
+    event.start    = microseconds(start - epoch).count();
+    event.duration = microseconds(end - start).count();
+    ++buffer.n_recorded;
+  }
+
+
+
+  void
+  write_chrome_trace(const std::string &filename_without_extension,
+                     const MPI_Comm &   mpi_communicator)
+  {
+    const unsigned int rank =
+      Utilities::MPI::this_mpi_process(mpi_communicator);
+    const std::string filename = filename_without_extension + "_" +
+                                 Utilities::int_to_string(rank, 4) + ".json";
+
+    std::ofstream out(filename);
+    AssertThrow(out, ExcIO());
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+        << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+    std::lock_guard<std::mutex> lock(buffer_mutex);
+    for (const auto &buffer : thread_buffers)
+      {
+        // write the events in the order they were recorded, starting with
+        // the oldest one still in the buffer
+        const std::size_t n_events =
+          std::min<std::size_t>(buffer->n_recorded, buffer->events.size());
+        const std::size_t first = buffer->n_recorded - n_events;
+        for (std::size_t i = first; i < buffer->n_recorded; ++i)
+          {
+            const Event &event = buffer->events[i % buffer->events.size()];
+            out << ",\n{\"name\":\"" << escape_json(event.name)
+                << "\",\"cat\":\"" << event.category
+                << "\",\"ph\":\"X\",\"ts\":" << event.start
+                << ",\"dur\":" << event.duration << ",\"pid\":" << rank
+                << ",\"tid\":" << buffer->thread_index << "}";
+          }
+      }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    AssertThrow(out, ExcIO());
+  }
+} // namespace Tracing
+
+DEAL_II_NAMESPACE_CLOSE
@@ -62,6 +62,13 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #  include <cstdlib>
 #endif
 
+#if defined(__linux__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 
 #ifdef DEAL_II_WITH_TRILINOS
 #  ifdef DEAL_II_WITH_MPI
@@ -1065,6 +1072,85 @@ namespace Utilities
 
 
 
+    void
+    advise_transparent_huge_pages(void *memptr, std::size_t size)
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+      // this is only a hint: if the kernel does not support transparent huge
+      // pages or they are disabled, the memory simply uses regular pages, so
+      // there is no need to check the return value
+      ::madvise(memptr, size, MADV_HUGEPAGE);
+#else
+      (void)memptr;
+      (void)size;
+#endif
+    }
+
+
+
+    std::pair<void *, std::function<void()>>
+    map_file(const std::string &filename,
+             const std::size_t  offset,
+             const std::size_t  size,
+             const bool         write_through)
+    {
+      Assert(size > 0, ExcMessage("Cannot map an empty range of a file."));
+#if defined(__linux__)
+      const int file =
+        ::open(filename.c_str(), write_through ? O_RDWR : O_RDONLY);
+      AssertThrow(file >= 0, ExcFileNotOpen(filename));
+
+      struct stat file_status;
+      if (::fstat(file, &file_status) != 0 ||
+          static_cast<std::size_t>(file_status.st_size) < offset + size)
+        {
+          ::close(file);
+          AssertThrow(false,
+                      ExcMessage("The file " + filename +
+                                 " is too short for the requested range."));
+        }
+
+      // mmap() requires the offset to be a multiple of the page size, so we
+      // map from the beginning of the page that contains the first byte.
+      // Private mappings are writable as well: pages that are modified get
+      // copied, rather than written to the file.
+      const std::size_t page_size   = ::sysconf(_SC_PAGESIZE);
+      const std::size_t page_offset = offset % page_size;
+      const std::size_t length      = size + page_offset;
+
+      void *mapping = ::mmap(nullptr,
+                             length,
+                             PROT_READ | PROT_WRITE,
+                             write_through ? MAP_SHARED : MAP_PRIVATE,
+                             file,
+                             offset - page_offset);
+
+      const int error = errno;
+      // the mapping keeps its own reference to the file
+      ::close(file);
+      AssertThrow(mapping != MAP_FAILED,
+                  ExcMessage("Could not map the file " + filename +
+                             " into memory: " + std::strerror(error)));
+
+      // this is only a hint to read ahead, so the return value is not checked
+      ::madvise(mapping, length, MADV_SEQUENTIAL);
+
+      return {static_cast<char *>(mapping) + page_offset,
+              [mapping, length]() { ::munmap(mapping, length); }};
+#else
+      (void)filename;
+      (void)offset;
+      (void)size;
+      (void)write_through;
+      AssertThrow(false,
+                  ExcMessage("Memory-mapped files are only supported on "
+                             "Linux."));
+      return {nullptr, std::function<void()>()};
+#endif
+    }
+
+
+
     bool
     job_supports_mpi()
     {
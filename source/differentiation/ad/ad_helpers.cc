@@ -790,6 +790,46 @@ namespace Differentiation
 
 
 
+    template <enum AD::NumberTypes ADNumberTypeCode, typename ScalarType>
+    bool
+    CellLevelBase<ADNumberTypeCode, ScalarType>::
+      compute_residuals_and_linearizations(
+        const std::vector<std::vector<scalar_type>> &dof_values,
+        std::vector<Vector<scalar_type>> &           residuals,
+        std::vector<FullMatrix<scalar_type>> &       linearizations)
+    {
+      Assert(ADNumberTraits<ad_type>::is_taped == true,
+             ExcMessage("The evaluation of a batch of linearization points "
+                        "requires a taped AD number type."));
+      Assert(this->is_recording() == false,
+             ExcMessage("Cannot evaluate the recorded tape while it is "
+                        "being recorded."));
+
+      residuals.resize(dof_values.size());
+      linearizations.resize(dof_values.size());
+
+      bool tape_is_reusable = true;
+      for (unsigned int b = 0; b < dof_values.size(); ++b)
+        {
+          // The tape stays active between the individual evaluations, so
+          // only the values of the independent variables have to be
+          // exchanged before it is replayed.
+          set_dof_values(dof_values[b]);
+
+          compute_residual(residuals[b]);
+          if (this->active_tape_requires_retaping())
+            tape_is_reusable = false;
+
+          compute_linearization(linearizations[b]);
+          if (this->active_tape_requires_retaping())
+            tape_is_reusable = false;
+        }
+
+      return tape_is_reusable;
+    }
+
+
+
     /* ------------------ EnergyFunctional ------------------ */
 
 
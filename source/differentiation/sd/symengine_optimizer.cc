@@ -23,6 +23,9 @@
 #  include <boost/archive/text_iarchive.hpp>
 #  include <boost/archive/text_oarchive.hpp>
 
+#  include <fstream>
+#  include <iterator>
+#  include <sstream>
 #  include <utility>
 
 DEAL_II_NAMESPACE_OPEN
@@ -372,6 +375,81 @@ namespace Differentiation
 
 
 
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::optimize(const std::string &cache_file,
+                                         const MPI_Comm &   mpi_communicator)
+    {
+      Assert(optimized() == false,
+             ExcMessage("Cannot call optimize() more than once."));
+
+      // Compute a key that identifies the optimization problem from the
+      // hashes of all symbols and expressions. SymEngine computes these
+      // from the structure of the expressions, so they are the same on all
+      // processes and in subsequent runs.
+      std::size_t hash         = 0;
+      const auto  combine_hash = [&hash](const std::size_t value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      };
+      combine_hash(static_cast<std::size_t>(optimization_method()));
+      combine_hash(static_cast<std::size_t>(optimization_flags()));
+      for (const auto &entry : independent_variables_symbols)
+        combine_hash(entry.first.get_RCP()->hash());
+      for (const auto &function : dependent_variables_functions)
+        combine_hash(function.get_RCP()->hash());
+      const std::string key = std::to_string(hash) + ' ' +
+                              std::to_string(n_independent_variables()) + ' ' +
+                              std::to_string(n_dependent_variables());
+
+      // Only the root process reads or writes the cache file. It performs
+      // the optimization if the cache does not match.
+      std::string serialized_optimizer;
+      if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+        {
+          std::ifstream in(cache_file);
+          std::string   cached_key;
+          if (in && std::getline(in, cached_key) && cached_key == key)
+            serialized_optimizer.assign(std::istreambuf_iterator<char>(in),
+                                        std::istreambuf_iterator<char>());
+          else
+            {
+              optimize();
+
+              std::ostringstream oss;
+              {
+                boost::archive::text_oarchive oa(oss,
+                                                 boost::archive::no_header);
+                oa << *this;
+              }
+              serialized_optimizer = oss.str();
+
+              std::ofstream out(cache_file);
+              AssertThrow(out, ExcFileNotOpen(cache_file));
+              out << key << '\n' << serialized_optimizer;
+            }
+        }
+
+      serialized_optimizer =
+        dealii::Utilities::MPI::broadcast(mpi_communicator,
+                                          serialized_optimizer);
+
+      // All processes that have not optimized the expressions themselves
+      // load the optimizer. This replaces the registered symbols and
+      // functions by their (equivalent) deserialized counterparts.
+      if (optimized() == false)
+        {
+          independent_variables_symbols.clear();
+          dependent_variables_functions.clear();
+          map_dep_expr_vec_entry.clear();
+
+          std::istringstream            iss(serialized_optimizer);
+          boost::archive::text_iarchive ia(iss, boost::archive::no_header);
+          ia >> *this;
+        }
+    }
+
+
+
     template <typename ReturnType>
     void
     BatchOptimizer<ReturnType>::substitute(
@@ -37,6 +37,7 @@
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
 
+#  include <cstring>
 #  include <functional>
 #  include <numeric>
 
@@ -169,119 +170,144 @@ namespace parallel
       typename DoFHandler<dim, spacedim>::cell_iterator cell(*cell_,
                                                              dof_handler);
 
-      // create buffer for each individual input vector
-      std::vector<float> predicted_errors(error_indicators.size());
-
-      auto predicted_error_it = predicted_errors.begin();
-      auto estimated_error_it = error_indicators.cbegin();
-      for (; estimated_error_it != error_indicators.cend();
-           ++predicted_error_it, ++estimated_error_it)
-        switch (status)
-          {
-            case parallel::distributed::Triangulation<dim,
-                                                      spacedim>::CELL_PERSIST:
-              {
-                if (cell->future_fe_index_set())
-                  {
-                    const int degree_difference =
-                      dof_handler->get_fe_collection()[cell->future_fe_index()]
-                        .degree -
-                      cell->get_fe().degree;
-
-                    *predicted_error_it =
-                      (**estimated_error_it)[cell->active_cell_index()] *
-                      std::pow(gamma_p, degree_difference);
-                  }
-                else
-                  {
-                    *predicted_error_it =
-                      (**estimated_error_it)[cell->active_cell_index()] *
-                      gamma_n;
-                  }
-                break;
-              }
-
-            case parallel::distributed::Triangulation<dim,
-                                                      spacedim>::CELL_REFINE:
-              {
-                // Determine the exponent by the finite element degree on the
-                // adapted mesh.
-                const unsigned int future_fe_degree =
-                  dof_handler->get_fe_collection()[cell->future_fe_index()]
-                    .degree;
-
-                *predicted_error_it =
-                  (**estimated_error_it)[cell->active_cell_index()] *
-                  (gamma_h * std::pow(.5, future_fe_degree));
-
-                // If the future FE index differs from the active one, also take
-                // into account p-adaptation.
-                if (cell->future_fe_index_set())
-                  *predicted_error_it *=
-                    std::pow(gamma_p,
-                             static_cast<int>(future_fe_degree -
-                                              cell->get_fe().degree));
-
-                break;
-              }
-
-            case parallel::distributed::Triangulation<dim,
-                                                      spacedim>::CELL_COARSEN:
-              {
-                // First figure out which finite element will be assigned to the
-                // parent cell after h-adaptation analogously to
-                // dealii::internal::hp::DoFHandlerImplementation::Implementation::
-                //   collect_fe_indices_on_cells_to_be_refined()
+      // The predicted errors of all registered vectors are written as one
+      // contiguous block of floats, i.e., as fixed-size data. The factors of
+      // the prediction only depend on the cell, so they are computed once for
+      // all vectors.
+      const unsigned int n_vectors = error_indicators.size();
+      std::vector<char>  buffer(n_vectors * sizeof(float));
+
+      const auto write_predicted_error =
+        [&buffer](const unsigned int v, const float predicted_error) {
+          std::memcpy(buffer.data() + v * sizeof(float),
+                      &predicted_error,
+                      sizeof(float));
+        };
+
+      switch (status)
+        {
+          case parallel::distributed::Triangulation<dim,
+                                                    spacedim>::CELL_PERSIST:
+            {
+              double factor = gamma_n;
+              if (cell->future_fe_index_set())
+                {
+                  const int degree_difference =
+                    dof_handler->get_fe_collection()[cell->future_fe_index()]
+                      .degree -
+                    cell->get_fe().degree;
+
+                  factor = std::pow(gamma_p, degree_difference);
+                }
+
+              for (unsigned int v = 0; v < n_vectors; ++v)
+                write_predicted_error(v,
+                                      (*error_indicators[v])
+                                          [cell->active_cell_index()] *
+                                        factor);
+              break;
+            }
+
+          case parallel::distributed::Triangulation<dim,
+                                                    spacedim>::CELL_REFINE:
+            {
+              // Determine the exponent by the finite element degree on the
+              // adapted mesh.
+              const unsigned int future_fe_degree =
+                dof_handler->get_fe_collection()[cell->future_fe_index()]
+                  .degree;
+
+              const double h_factor = gamma_h * std::pow(.5, future_fe_degree);
+
+              // If the future FE index differs from the active one, also take
+              // into account p-adaptation.
+              const double p_factor =
+                cell->future_fe_index_set() ?
+                  std::pow(gamma_p,
+                           static_cast<int>(future_fe_degree -
+                                            cell->get_fe().degree)) :
+                  1.;
+
+              for (unsigned int v = 0; v < n_vectors; ++v)
+                {
+                  float predicted_error =
+                    (*error_indicators[v])[cell->active_cell_index()] *
+                    h_factor;
+                  predicted_error *= p_factor;
+
+                  write_predicted_error(v, predicted_error);
+                }
+              break;
+            }
+
+          case parallel::distributed::Triangulation<dim,
+                                                    spacedim>::CELL_COARSEN:
+            {
+              // First figure out which finite element will be assigned to the
+              // parent cell after h-adaptation analogously to
+              // dealii::internal::hp::DoFHandlerImplementation::
+              //   Implementation::collect_fe_indices_on_cells_to_be_refined()
 #  ifdef DEBUG
-                for (const auto &child : cell->child_iterators())
-                  Assert(child->is_active() && child->coarsen_flag_set(),
-                         typename dealii::Triangulation<
-                           dim>::ExcInconsistentCoarseningFlags());
+              for (const auto &child : cell->child_iterators())
+                Assert(child->is_active() && child->coarsen_flag_set(),
+                       typename dealii::Triangulation<
+                         dim>::ExcInconsistentCoarseningFlags());
 #  endif
 
-                const unsigned int future_fe_index =
-                  dealii::internal::hp::DoFHandlerImplementation::
-                    dominated_future_fe_on_children<dim, spacedim>(cell);
-
-                const unsigned int future_fe_degree =
-                  dof_handler->get_fe_collection()[future_fe_index].degree;
+              const unsigned int future_fe_index =
+                dealii::internal::hp::DoFHandlerImplementation::
+                  dominated_future_fe_on_children<dim, spacedim>(cell);
 
-                // Then determine the actually contirbution to the predicted
-                // error of every single cells that is about to be coarsened.
-                float sqrsum_of_predicted_errors = 0.;
-                float predicted_error            = 0.;
-                int   degree_difference          = 0;
-                for (const auto &child : cell->child_iterators())
-                  {
-                    predicted_error =
-                      (**estimated_error_it)[child->active_cell_index()] /
-                      (gamma_h * std::pow(.5, future_fe_degree));
+              const unsigned int future_fe_degree =
+                dof_handler->get_fe_collection()[future_fe_index].degree;
 
-                    degree_difference =
-                      future_fe_degree - child->get_fe().degree;
+              const double h_factor = gamma_h * std::pow(.5, future_fe_degree);
 
-                    if (degree_difference != 0)
-                      predicted_error *= std::pow(gamma_p, degree_difference);
-
-                    sqrsum_of_predicted_errors +=
-                      predicted_error * predicted_error;
-                  }
-                *predicted_error_it = std::sqrt(sqrsum_of_predicted_errors);
+              // Collect the indices and the p-adaptation factors of the
+              // children, which are the same for all vectors.
+              std::vector<unsigned int> child_indices;
+              std::vector<double>       p_factors;
+              child_indices.reserve(cell->n_children());
+              p_factors.reserve(cell->n_children());
+              for (const auto &child : cell->child_iterators())
+                {
+                  const int degree_difference =
+                    future_fe_degree - child->get_fe().degree;
+
+                  child_indices.push_back(child->active_cell_index());
+                  p_factors.push_back(degree_difference != 0 ?
+                                        std::pow(gamma_p, degree_difference) :
+                                        1.);
+                }
+
+              // Then determine the actually contirbution to the predicted
+              // error of every single cells that is about to be coarsened.
+              for (unsigned int v = 0; v < n_vectors; ++v)
+                {
+                  float sqrsum_of_predicted_errors = 0.;
+                  for (unsigned int c = 0; c < child_indices.size(); ++c)
+                    {
+                      float predicted_error =
+                        (*error_indicators[v])[child_indices[c]] / h_factor;
+
+                      predicted_error *= p_factors[c];
+
+                      sqrsum_of_predicted_errors +=
+                        predicted_error * predicted_error;
+                    }
+
+                  write_predicted_error(v,
+                                        std::sqrt(sqrsum_of_predicted_errors));
+                }
+              break;
+            }
 
-                break;
-              }
+          default:
+            Assert(false, ExcInternalError());
+            break;
+        }
 
-            default:
-              Assert(false, ExcInternalError());
-              break;
-          }
-
-      // We don't have to pack the whole container if there is just one entry.
-      if (error_indicators.size() == 1)
-        return Utilities::pack(predicted_errors[0],
-                               /*allow_compression=*/false);
-      else
-        return Utilities::pack(predicted_errors, /*allow_compression=*/false);
+      return buffer;
     }
 
 
@@ -295,45 +321,40 @@ namespace parallel
         &                           data_range,
       std::vector<Vector<float> *> &all_out)
     {
-      std::vector<float> predicted_errors;
-
-      if (all_out.size() == 1)
-        predicted_errors.push_back(
-          Utilities::unpack<float>(data_range.begin(),
-                                   data_range.end(),
-                                   /*allow_compression=*/false));
-      else
-        predicted_errors =
-          Utilities::unpack<std::vector<float>>(data_range.begin(),
-                                                data_range.end(),
-                                                /*allow_compression=*/false);
-
-      Assert(predicted_errors.size() == all_out.size(), ExcInternalError());
-
-      auto it_input  = predicted_errors.cbegin();
-      auto it_output = all_out.begin();
-      for (; it_input != predicted_errors.cend(); ++it_input, ++it_output)
-        switch (status)
-          {
-            case parallel::distributed::Triangulation<dim,
-                                                      spacedim>::CELL_PERSIST:
-            case parallel::distributed::Triangulation<dim,
-                                                      spacedim>::CELL_COARSEN:
-              (**it_output)[cell->active_cell_index()] = *it_input;
-              break;
+      Assert(static_cast<std::size_t>(data_range.size()) ==
+               all_out.size() * sizeof(float),
+             ExcInternalError());
+
+      const char *data = &(*data_range.begin());
+      for (unsigned int v = 0; v < all_out.size(); ++v)
+        {
+          float predicted_error;
+          std::memcpy(&predicted_error,
+                      data + v * sizeof(float),
+                      sizeof(float));
+
+          switch (status)
+            {
+              case parallel::distributed::Triangulation<dim,
+                                                        spacedim>::CELL_PERSIST:
+              case parallel::distributed::Triangulation<dim,
+                                                        spacedim>::CELL_COARSEN:
+                (*all_out[v])[cell->active_cell_index()] = predicted_error;
+                break;
 
 
-            case parallel::distributed::Triangulation<dim,
-                                                      spacedim>::CELL_REFINE:
-              for (const auto &child : cell->child_iterators())
-                (**it_output)[child->active_cell_index()] =
-                  (*it_input) / std::sqrt(cell->n_children());
-              break;
+              case parallel::distributed::Triangulation<dim,
+                                                        spacedim>::CELL_REFINE:
+                for (const auto &child : cell->child_iterators())
+                  (*all_out[v])[child->active_cell_index()] =
+                    predicted_error / std::sqrt(cell->n_children());
+                break;
 
-            default:
-              Assert(false, ExcInternalError());
-              break;
-          }
+              default:
+                Assert(false, ExcInternalError());
+                break;
+            }
+        }
     }
   } // namespace distributed
 } // namespace parallel
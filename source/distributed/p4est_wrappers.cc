@@ -438,6 +438,10 @@ namespace internal
                                                 p4est_weight_t weight_fn) =
       p4est_partition_ext;
 
+    types<2>::gloidx (&functions<2>::partition_given)(
+      types<2>::forest *      p4est,
+      const types<2>::locidx *num_quadrants_in_proc) = p4est_partition_given;
+
     void (&functions<2>::save)(const char *      filename,
                                types<2>::forest *p4est,
                                int               save_data) = p4est_save;
@@ -646,6 +650,10 @@ namespace internal
                                                 p8est_weight_t weight_fn) =
       p8est_partition_ext;
 
+    types<3>::gloidx (&functions<3>::partition_given)(
+      types<3>::forest *      p8est,
+      const types<3>::locidx *num_quadrants_in_proc) = p8est_partition_given;
+
     void (&functions<3>::save)(const char *      filename,
                                types<3>::forest *p4est,
                                int               save_data) = p8est_save;
@@ -50,13 +50,14 @@ namespace parallel
     {
       const auto partition_settings =
         (partition_zoltan | partition_metis | partition_zorder |
-         partition_custom_signal) &
+         partition_hilbert | partition_custom_signal) &
         settings;
       (void)partition_settings;
       Assert(partition_settings == partition_auto ||
                partition_settings == partition_metis ||
                partition_settings == partition_zoltan ||
                partition_settings == partition_zorder ||
+               partition_settings == partition_hilbert ||
                partition_settings == partition_custom_signal,
              ExcMessage("Settings must contain exactly one type of the active "
                         "cell partitioning scheme."));
@@ -95,9 +96,10 @@ namespace parallel
           "agree on the number of active cells."));
 #  endif
 
-      auto partition_settings = (partition_zoltan | partition_metis |
-                                 partition_zorder | partition_custom_signal) &
-                                settings;
+      auto partition_settings =
+        (partition_zoltan | partition_metis | partition_zorder |
+         partition_hilbert | partition_custom_signal) &
+        settings;
       if (partition_settings == partition_auto)
 #  ifdef DEAL_II_TRILINOS_WITH_ZOLTAN
         partition_settings = partition_zoltan;
@@ -142,6 +144,11 @@ namespace parallel
         {
           GridTools::partition_triangulation_zorder(this->n_subdomains, *this);
         }
+      else if (partition_settings == partition_hilbert)
+        {
+          GridTools::partition_triangulation_hilbert(this->n_subdomains,
+                                                     *this);
+        }
       else if (partition_settings == partition_custom_signal)
         {
           // User partitions mesh manually
@@ -24,12 +24,15 @@
 #  include <deal.II/dofs/dof_accessor.h>
 #  include <deal.II/dofs/dof_tools.h>
 
+#  include <deal.II/fe/fe.h>
+
 #  include <deal.II/grid/tria_accessor.h>
 #  include <deal.II/grid/tria_iterator.h>
 
 #  include <deal.II/hp/dof_handler.h>
 
 #  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/full_matrix.h>
 #  include <deal.II/lac/la_parallel_block_vector.h>
 #  include <deal.II/lac/la_parallel_vector.h>
 #  include <deal.II/lac/petsc_block_vector.h>
@@ -37,7 +40,10 @@
 #  include <deal.II/lac/trilinos_parallel_block_vector.h>
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
+#  include <deal.II/lac/vector_element_access.h>
 
+#  include <algorithm>
+#  include <cstring>
 #  include <functional>
 #  include <numeric>
 
@@ -48,63 +54,133 @@ DEAL_II_NAMESPACE_OPEN
 namespace
 {
   /**
-   * Optimized pack function for values assigned on degrees of freedom.
+   * Write the values of all @p vectors on @p cell consecutively to
+   * @p values, one block of <code>fe.n_dofs_per_cell()</code> entries per
+   * vector. If @p cell is not active, the values are restricted from its
+   * children.
    *
-   * Given that the elements of @p dof_values are stored in consecutive
-   * locations, we can just memcpy them. Since floating point values don't
-   * compress well, we also waive the compression that the default
-   * Utilities::pack() and Utilities::unpack() functions offer.
+   * This does the same as calling
+   * DoFCellAccessor::get_interpolated_dof_values() for each vector if
+   * hp-capabilities are disabled, but looks up the dof indices and
+   * restriction matrices of each cell only once for all vectors and
+   * does not need temporary vectors for each of them.
    */
-  template <typename value_type>
-  std::vector<char>
-  pack_dof_values(std::vector<Vector<value_type>> &dof_values,
-                  const unsigned int               dofs_per_cell)
+  template <typename value_type,
+            typename DoFCellIteratorType,
+            int dim,
+            int spacedim,
+            typename VectorType>
+  void
+  get_interpolated_dof_values(const DoFCellIteratorType &           cell,
+                              const FiniteElement<dim, spacedim> &  fe,
+                              const std::vector<const VectorType *> &vectors,
+                              value_type *                          values)
   {
-    for (const auto &values : dof_values)
+    const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+    const unsigned int n_vectors     = vectors.size();
+
+    if (cell->is_active())
       {
-        AssertDimension(values.size(), dofs_per_cell);
-        (void)values;
+        std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+        cell->get_dof_indices(dof_indices);
+        for (unsigned int v = 0; v < n_vectors; ++v)
+          vectors[v]->extract_subvector_to(dof_indices.begin(),
+                                           dof_indices.end(),
+                                           values + v * dofs_per_cell);
+      }
+    else
+      {
+        std::fill(values, values + n_vectors * dofs_per_cell, value_type());
+
+        // see DoFCellAccessor::get_interpolated_dof_values() on why we
+        // either add up or overwrite the contributions of the children
+        std::vector<value_type> child_values(n_vectors * dofs_per_cell);
+        for (unsigned int child = 0; child < cell->n_children(); ++child)
+          {
+            get_interpolated_dof_values(cell->child(child),
+                                        fe,
+                                        vectors,
+                                        child_values.data());
+
+            const FullMatrix<double> &restriction =
+              fe.get_restriction_matrix(child, cell->refinement_case());
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              {
+                const bool is_additive = fe.restriction_is_additive(i);
+                for (unsigned int v = 0; v < n_vectors; ++v)
+                  {
+                    const value_type *child_v =
+                      child_values.data() + v * dofs_per_cell;
+                    value_type value = value_type();
+                    for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                      value += restriction(i, j) * child_v[j];
+
+                    if (is_additive)
+                      values[v * dofs_per_cell + i] += value;
+                    else if (value != value_type())
+                      values[v * dofs_per_cell + i] = value;
+                  }
+              }
+          }
       }
-
-    const std::size_t bytes_per_entry = sizeof(value_type) * dofs_per_cell;
-
-    std::vector<char> buffer(dof_values.size() * bytes_per_entry);
-    for (unsigned int i = 0; i < dof_values.size(); ++i)
-      std::memcpy(&buffer[i * bytes_per_entry],
-                  &dof_values[i](0),
-                  bytes_per_entry);
-
-    return buffer;
   }
 
 
 
   /**
-   * Optimized unpack function for values assigned on degrees of freedom.
+   * The counterpart of get_interpolated_dof_values() above: set the values
+   * of all @p vectors on @p cell from @p values, which stores one block of
+   * <code>fe.n_dofs_per_cell()</code> entries per vector. If @p cell is not
+   * active, the values are prolongated to its children.
    */
-  template <typename value_type>
-  std::vector<Vector<value_type>>
-  unpack_dof_values(
-    const boost::iterator_range<std::vector<char>::const_iterator> &data_range,
-    const unsigned int dofs_per_cell)
+  template <typename value_type,
+            typename DoFCellIteratorType,
+            int dim,
+            int spacedim,
+            typename VectorType>
+  void
+  set_dof_values_by_interpolation(const DoFCellIteratorType &         cell,
+                                  const FiniteElement<dim, spacedim> &fe,
+                                  const value_type *                  values,
+                                  const std::vector<VectorType *> &   vectors)
   {
-    const std::size_t  bytes_per_entry = sizeof(value_type) * dofs_per_cell;
-    const unsigned int n_elements      = data_range.size() / bytes_per_entry;
+    const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+    const unsigned int n_vectors     = vectors.size();
 
-    Assert((data_range.size() % bytes_per_entry == 0), ExcInternalError());
-
-    std::vector<Vector<value_type>> unpacked_data;
-    unpacked_data.reserve(n_elements);
-    for (unsigned int i = 0; i < n_elements; ++i)
+    if (cell->is_active())
       {
-        Vector<value_type> dof_values(dofs_per_cell);
-        std::memcpy(&dof_values(0),
-                    &(*std::next(data_range.begin(), i * bytes_per_entry)),
-                    bytes_per_entry);
-        unpacked_data.emplace_back(std::move(dof_values));
+        if (cell->is_artificial())
+          return;
+
+        std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+        cell->get_dof_indices(dof_indices);
+        for (unsigned int v = 0; v < n_vectors; ++v)
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            internal::ElementAccess<VectorType>::set(
+              values[v * dofs_per_cell + i], dof_indices[i], *vectors[v]);
       }
+    else
+      {
+        std::vector<value_type> child_values(n_vectors * dofs_per_cell);
+        for (unsigned int child = 0; child < cell->n_children(); ++child)
+          {
+            const FullMatrix<double> &prolongation =
+              fe.get_prolongation_matrix(child, cell->refinement_case());
+            for (unsigned int v = 0; v < n_vectors; ++v)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                {
+                  value_type value = value_type();
+                  for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                    value += prolongation(i, j) * values[v * dofs_per_cell + j];
+                  child_values[v * dofs_per_cell + i] = value;
+                }
 
-    return unpacked_data;
+            set_dof_values_by_interpolation(cell->child(child),
+                                            fe,
+                                            child_values.data(),
+                                            vectors);
+          }
+      }
   }
 } // namespace
 
@@ -290,10 +366,6 @@ namespace parallel
     {
       typename DoFHandlerType::cell_iterator cell(*cell_, dof_handler);
 
-      // create buffer for each individual object
-      std::vector<::dealii::Vector<typename VectorType::value_type>> dof_values(
-        input_vectors.size());
-
       unsigned int fe_index = 0;
       if (dof_handler->has_hp_capabilities())
         {
@@ -343,16 +415,35 @@ namespace parallel
       if (dofs_per_cell == 0)
         return std::vector<char>(); // nothing to do for FE_Nothing
 
-      auto it_input  = input_vectors.cbegin();
-      auto it_output = dof_values.begin();
-      for (; it_input != input_vectors.cend(); ++it_input, ++it_output)
+      // write the values of all vectors directly into the buffer that is
+      // handed over to the triangulation. since floating point values don't
+      // compress well, we do not use Utilities::pack() here
+      using value_type = typename VectorType::value_type;
+      std::vector<char> buffer(input_vectors.size() * dofs_per_cell *
+                               sizeof(value_type));
+      value_type *const dof_values =
+        reinterpret_cast<value_type *>(buffer.data());
+
+      if (dof_handler->has_hp_capabilities() == false)
+        get_interpolated_dof_values(cell,
+                                    dof_handler->get_fe(),
+                                    input_vectors,
+                                    dof_values);
+      else
         {
-          it_output->reinit(dofs_per_cell);
-          cell->get_interpolated_dof_values(*(*it_input), *it_output, fe_index);
+          ::dealii::Vector<value_type> values(dofs_per_cell);
+          for (unsigned int v = 0; v < input_vectors.size(); ++v)
+            {
+              cell->get_interpolated_dof_values(*input_vectors[v],
+                                                values,
+                                                fe_index);
+              std::copy(values.begin(),
+                        values.end(),
+                        dof_values + v * dofs_per_cell);
+            }
         }
 
-      return pack_dof_values<typename VectorType::value_type>(dof_values,
-                                                              dofs_per_cell);
+      return buffer;
     }
 
 
@@ -418,32 +509,47 @@ namespace parallel
       if (dofs_per_cell == 0)
         return; // nothing to do for FE_Nothing
 
-      const std::vector<::dealii::Vector<typename VectorType::value_type>>
-        dof_values =
-          unpack_dof_values<typename VectorType::value_type>(data_range,
-                                                             dofs_per_cell);
-
-      // check if sizes match
-      Assert(dof_values.size() == all_out.size(), ExcInternalError());
+      using value_type                  = typename VectorType::value_type;
+      const std::size_t bytes_per_entry = sizeof(value_type) * dofs_per_cell;
 
       // check if we have enough dofs provided by the FE object
       // to interpolate the transferred data correctly
-      for (auto it_dof_values = dof_values.begin();
-           it_dof_values != dof_values.end();
-           ++it_dof_values)
-        Assert(
-          dofs_per_cell == it_dof_values->size(),
-          ExcMessage(
-            "The transferred data was packed with a different number of dofs than the "
-            "currently registered FE object assigned to the DoFHandler has."));
+      Assert(
+        data_range.size() % bytes_per_entry == 0,
+        ExcMessage(
+          "The transferred data was packed with a different number of dofs than the "
+          "currently registered FE object assigned to the DoFHandler has."));
+      // check if sizes match
+      Assert(data_range.size() / bytes_per_entry == all_out.size(),
+             ExcInternalError());
+
+      // copy the data out of the buffer first, since it is not necessarily
+      // aligned for value_type
+      std::vector<value_type> dof_values(all_out.size() * dofs_per_cell);
+      if (data_range.size() > 0)
+        std::memcpy(dof_values.data(),
+                    &(*data_range.begin()),
+                    data_range.size());
 
       // distribute data for each registered vector on mesh
-      auto it_input  = dof_values.cbegin();
-      auto it_output = all_out.begin();
-      for (; it_input != dof_values.cend(); ++it_input, ++it_output)
-        cell->set_dof_values_by_interpolation(*it_input,
-                                              *(*it_output),
-                                              fe_index);
+      if (dof_handler->has_hp_capabilities() == false)
+        set_dof_values_by_interpolation(cell,
+                                        dof_handler->get_fe(),
+                                        dof_values.data(),
+                                        all_out);
+      else
+        {
+          ::dealii::Vector<value_type> values(dofs_per_cell);
+          for (unsigned int v = 0; v < all_out.size(); ++v)
+            {
+              std::copy(dof_values.begin() + v * dofs_per_cell,
+                        dof_values.begin() + (v + 1) * dofs_per_cell,
+                        values.begin());
+              cell->set_dof_values_by_interpolation(values,
+                                                    *all_out[v],
+                                                    fe_index);
+            }
+        }
     }
   } // namespace distributed
 } // namespace parallel
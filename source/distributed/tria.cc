@@ -898,6 +898,32 @@ namespace
   };
 
 
+  /**
+   * Return the number of cells that change their owner when going from the
+   * partition described by @p old_first to the one described by
+   * @p new_first. Both arrays store the first global index of the cells
+   * owned by each process, followed by the total number of cells.
+   */
+  template <int dim>
+  types::global_cell_index
+  count_migrating_cells(
+    const typename internal::p4est::types<dim>::gloidx *             old_first,
+    const std::vector<typename internal::p4est::types<dim>::gloidx> &new_first)
+  {
+    types::global_cell_index n_migrating_cells = 0;
+    for (unsigned int p = 0; p + 1 < new_first.size(); ++p)
+      {
+        const auto overlap_begin = std::max(old_first[p], new_first[p]);
+        const auto overlap_end   = std::min(old_first[p + 1], new_first[p + 1]);
+        n_migrating_cells +=
+          (old_first[p + 1] - old_first[p]) -
+          (overlap_end > overlap_begin ? overlap_end - overlap_begin : 0);
+      }
+    return n_migrating_cells;
+  }
+
+
+
   template <int dim, int spacedim>
   PartitionWeights<dim, spacedim>::PartitionWeights(
     const std::vector<unsigned int> &cell_weights)
@@ -1423,6 +1449,29 @@ namespace parallel
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::save(const std::string &filename) const
+    {
+      do_save(filename, false, 0);
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::save_asynchronously(
+      const std::string &filename,
+      const std::size_t  max_staging_memory) const
+    {
+      do_save(filename, true, max_staging_memory);
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::do_save(
+      const std::string &filename,
+      const bool         asynchronous,
+      const std::size_t  max_staging_memory) const
     {
       Assert(
         this->cell_attached_data.n_attached_deserialize == 0,
@@ -1463,7 +1512,9 @@ namespace parallel
       // Save cell attached data.
       this->save_attached_data(parallel_forest->global_first_quadrant[myrank],
                                parallel_forest->global_num_quadrants,
-                               filename);
+                               filename,
+                               asynchronous,
+                               max_staging_memory);
 
       dealii::internal::p4est::functions<dim>::save(filename.c_str(),
                                                     parallel_forest,
@@ -1492,6 +1543,9 @@ namespace parallel
       const int myrank =
         Utilities::MPI::this_mpi_process(this->mpi_communicator);
 
+      // make sure a previous asynchronous save has reached the file system
+      this->wait_for_save();
+
       // signal that de-serialization is going to happen
       this->signals.pre_distributed_load();
 
@@ -2206,13 +2260,16 @@ namespace parallel
       this->save_coarsen_flags(flags_before[0]);
       this->save_refine_flags(flags_before[1]);
 
+      // the periodic face map only depends on the mesh, not on the flags,
+      // so it needs to be updated only once rather than in every round
+      this->update_periodic_face_map();
+
       bool         mesh_changed = false;
       unsigned int loop_counter = 0;
       do
         {
           this->dealii::Triangulation<dim, spacedim>::
             prepare_coarsening_and_refinement();
-          this->update_periodic_face_map();
           // enforce 2:1 mesh balance over periodic boundaries
           mesh_changed = enforce_mesh_balance_over_periodic_boundaries(*this);
 
@@ -2897,6 +2954,221 @@ namespace parallel
           parallel_forest->user_pointer = this;
         }
 
+      update_after_repartition(previous_global_first_quadrant);
+    }
+
+
+
+    template <int dim, int spacedim>
+    types::global_cell_index
+    Triangulation<dim, spacedim>::repartition_incrementally(
+      const double imbalance_tolerance)
+    {
+#  ifdef DEBUG
+      for (const auto &cell : this->active_cell_iterators())
+        if (cell->is_locally_owned())
+          Assert(
+            !cell->refine_flag_set() && !cell->coarsen_flag_set(),
+            ExcMessage(
+              "Error: There shouldn't be any cells flagged for coarsening/refinement when calling repartition_incrementally()."));
+#  endif
+
+      const std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+        new_global_first_quadrant =
+          compute_incremental_partition(imbalance_tolerance);
+
+      if (new_global_first_quadrant.empty())
+        return 0;
+
+      const types::global_cell_index n_migrating_cells =
+        count_migrating_cells<dim>(parallel_forest->global_first_quadrant,
+                                   new_global_first_quadrant);
+      if (n_migrating_cells == 0)
+        return 0;
+
+      // signal that repartitioning is going to happen
+      this->signals.pre_distributed_repartition();
+
+      // save a copy of the current positions of quadrants, but only if data
+      // needs to be transferred later
+      std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+        previous_global_first_quadrant;
+
+      if (this->cell_attached_data.n_attached_data_sets > 0)
+        previous_global_first_quadrant.assign(
+          parallel_forest->global_first_quadrant,
+          parallel_forest->global_first_quadrant + parallel_forest->mpisize +
+            1);
+
+      std::vector<typename dealii::internal::p4est::types<dim>::locidx>
+        n_quadrants_per_process(parallel_forest->mpisize);
+      for (int p = 0; p < parallel_forest->mpisize; ++p)
+        n_quadrants_per_process[p] =
+          new_global_first_quadrant[p + 1] - new_global_first_quadrant[p];
+
+      dealii::internal::p4est::functions<dim>::partition_given(
+        parallel_forest, n_quadrants_per_process.data());
+
+      update_after_repartition(previous_global_first_quadrant);
+
+      return n_migrating_cells;
+    }
+
+
+
+    template <int dim, int spacedim>
+    types::global_cell_index
+    Triangulation<dim, spacedim>::n_cells_to_migrate(
+      const double imbalance_tolerance) const
+    {
+      const std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+        new_global_first_quadrant =
+          compute_incremental_partition(imbalance_tolerance);
+
+      if (new_global_first_quadrant.empty())
+        return 0;
+
+      return count_migrating_cells<dim>(parallel_forest->global_first_quadrant,
+                                        new_global_first_quadrant);
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+    Triangulation<dim, spacedim>::compute_incremental_partition(
+      const double imbalance_tolerance) const
+    {
+      Assert(imbalance_tolerance >= 0,
+             ExcMessage("The imbalance tolerance must not be negative."));
+
+      using gloidx = typename dealii::internal::p4est::types<dim>::gloidx;
+
+      const unsigned int n_procs = parallel_forest->mpisize;
+      const unsigned int myrank  = parallel_forest->mpirank;
+
+      // get the weights of the locally owned cells in the order of p4est,
+      // and the accumulated weights of all processes
+      const std::vector<unsigned int> cell_weights = get_cell_weights();
+      const std::uint64_t             local_weight =
+        std::accumulate(cell_weights.begin(),
+                        cell_weights.end(),
+                        std::uint64_t(0));
+
+      const std::vector<std::uint64_t> weights_per_process =
+        Utilities::MPI::all_gather(this->mpi_communicator, local_weight);
+
+      std::vector<std::uint64_t> weight_offsets(n_procs + 1, 0);
+      for (unsigned int p = 0; p < n_procs; ++p)
+        weight_offsets[p + 1] = weight_offsets[p] + weights_per_process[p];
+
+      const double average_weight =
+        static_cast<double>(weight_offsets.back()) / n_procs;
+
+      if (*std::max_element(weights_per_process.begin(),
+                            weights_per_process.end()) <=
+          (1. + imbalance_tolerance) * average_weight)
+        return {};
+
+      // Move each boundary between the ranges of two processes, expressed as
+      // the accumulated weight of all cells before it, the shortest
+      // distance that brings it within half of the tolerance of its ideal
+      // position. This bounds the load of every process while keeping
+      // boundaries that are good enough where they are.
+      const double half_width = 0.5 * imbalance_tolerance * average_weight;
+      std::vector<double> target_offsets(n_procs + 1);
+      for (unsigned int p = 0; p <= n_procs; ++p)
+        {
+          const double ideal   = p * average_weight;
+          const double current = weight_offsets[p];
+          target_offsets[p] =
+            std::min(std::max(current, ideal - half_width), ideal + half_width);
+        }
+
+      // Collect the locally owned quadrants in the order of the space filling
+      // curve, together with their trees, so that we can avoid splitting a
+      // family of cells between two processes. Otherwise, the family could
+      // not be coarsened later on.
+      std::vector<const typename dealii::internal::p4est::types<dim>::quadrant
+                    *>
+                       quadrants;
+      std::vector<int> quadrant_trees;
+      quadrants.reserve(parallel_forest->local_num_quadrants);
+      quadrant_trees.reserve(parallel_forest->local_num_quadrants);
+      for (int t = parallel_forest->first_local_tree;
+           t >= 0 && t <= parallel_forest->last_local_tree;
+           ++t)
+        {
+          typename dealii::internal::p4est::types<dim>::tree *tree =
+            static_cast<typename dealii::internal::p4est::types<dim>::tree *>(
+              sc_array_index(parallel_forest->trees, t));
+          for (std::size_t q = 0; q < tree->quadrants.elem_count; ++q)
+            {
+              quadrants.push_back(
+                static_cast<
+                  const typename dealii::internal::p4est::types<dim>::quadrant
+                    *>(sc_array_index(&tree->quadrants, q)));
+              quadrant_trees.push_back(t);
+            }
+        }
+      Assert(quadrants.size() == cell_weights.size(), ExcInternalError());
+
+      // Every boundary whose target lies within the range of weights owned
+      // by this process is located here.
+      std::vector<std::pair<unsigned int, gloidx>> local_boundaries;
+      {
+        std::uint64_t accumulated_weight = weight_offsets[myrank];
+        unsigned int  cell               = 0;
+        for (unsigned int p = 1; p < n_procs; ++p)
+          if (target_offsets[p] > weight_offsets[myrank] &&
+              target_offsets[p] <= weight_offsets[myrank + 1])
+            {
+              while (cell < cell_weights.size() &&
+                     accumulated_weight < target_offsets[p])
+                accumulated_weight += cell_weights[cell++];
+
+              unsigned int boundary = cell;
+              while (boundary > 0 && boundary < quadrants.size() &&
+                     quadrant_trees[boundary - 1] == quadrant_trees[boundary] &&
+                     dealii::internal::p4est::functions<dim>::
+                       quadrant_is_sibling(quadrants[boundary - 1],
+                                           quadrants[boundary]))
+                --boundary;
+
+              local_boundaries.emplace_back(
+                p, parallel_forest->global_first_quadrant[myrank] + boundary);
+            }
+      }
+
+      const std::vector<std::vector<std::pair<unsigned int, gloidx>>>
+        all_boundaries =
+          Utilities::MPI::all_gather(this->mpi_communicator, local_boundaries);
+
+      // Boundaries whose target is zero are not located by any process, and
+      // moving boundaries to the beginning of a family may make them
+      // decrease. Both are taken care of by making the sequence monotone.
+      std::vector<gloidx> new_global_first_quadrant(n_procs + 1, 0);
+      for (const auto &boundaries : all_boundaries)
+        for (const auto &boundary : boundaries)
+          new_global_first_quadrant[boundary.first] = boundary.second;
+      new_global_first_quadrant[n_procs] =
+        parallel_forest->global_num_quadrants;
+      for (unsigned int p = 1; p <= n_procs; ++p)
+        new_global_first_quadrant[p] =
+          std::max(new_global_first_quadrant[p],
+                   new_global_first_quadrant[p - 1]);
+
+      return new_global_first_quadrant;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::update_after_repartition(
+      const std::vector<typename dealii::internal::p4est::types<dim>::gloidx>
+        &previous_global_first_quadrant)
+    {
       // pack data before triangulation gets updated
       if (this->cell_attached_data.n_attached_data_sets > 0)
         {
@@ -692,7 +692,9 @@ namespace parallel
   DistributedTriangulationBase<dim, spacedim>::save_attached_data(
     const unsigned int global_first_cell,
     const unsigned int global_num_cells,
-    const std::string &filename) const
+    const std::string &filename,
+    const bool         asynchronous,
+    const std::size_t  max_staging_memory) const
   {
     // cast away constness
     auto tria = const_cast<
@@ -706,8 +708,18 @@ namespace parallel
           tria->cell_attached_data.pack_callbacks_fixed,
           tria->cell_attached_data.pack_callbacks_variable);
 
-        // then store buffers in file
-        tria->data_transfer.save(global_first_cell, global_num_cells, filename);
+        // then store buffers in file, or start doing so in the background.
+        // processes whose data does not fit into the staging memory write
+        // it right away
+        const std::size_t staging_memory =
+          tria->data_transfer.src_data_fixed.size() +
+          tria->data_transfer.src_sizes_variable.size() * sizeof(int) +
+          tria->data_transfer.src_data_variable.size();
+        tria->data_transfer.save(global_first_cell,
+                                 global_num_cells,
+                                 filename,
+                                 asynchronous,
+                                 staging_memory > max_staging_memory);
 
         // and release the memory afterwards
         tria->data_transfer.clear();
@@ -723,6 +735,28 @@ namespace parallel
   }
 
 
+  template <int dim, int spacedim>
+  bool
+  DistributedTriangulationBase<dim, spacedim>::test_save() const
+  {
+    return data_transfer.test_save();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DistributedTriangulationBase<dim, spacedim>::wait_for_save() const
+  {
+    // cast away constness
+    auto tria = const_cast<
+      dealii::parallel::DistributedTriangulationBase<dim, spacedim> *>(this);
+
+    tria->data_transfer.wait_for_save();
+  }
+
+
+
   template <int dim, int spacedim>
   void
   DistributedTriangulationBase<dim, spacedim>::load_attached_data(
@@ -843,6 +877,20 @@ namespace parallel
 
 
 
+  template <int dim, int spacedim>
+  DistributedTriangulationBase<dim, spacedim>::DataTransfer::~DataTransfer()
+  {
+    // the staging buffers must stay alive until all writes have completed
+    try
+      {
+        wait_for_save();
+      }
+    catch (...)
+      {}
+  }
+
+
+
   template <int dim, int spacedim>
   void
   DistributedTriangulationBase<dim, spacedim>::DataTransfer::pack_data(
@@ -1384,7 +1432,9 @@ namespace parallel
   DistributedTriangulationBase<dim, spacedim>::DataTransfer::save(
     const unsigned int global_first_cell,
     const unsigned int global_num_cells,
-    const std::string &filename) const
+    const std::string &filename,
+    const bool         asynchronous,
+    const bool         write_immediately)
   {
 #ifdef DEAL_II_WITH_MPI
     // Large fractions of this function have been copied from
@@ -1394,8 +1444,76 @@ namespace parallel
     Assert(sizes_fixed_cumulative.size() > 0,
            ExcMessage("No data has been packed!"));
 
+    // A previous asynchronous save might still write into the files we are
+    // about to open, so complete it first.
+    wait_for_save();
+
     const int myrank = Utilities::MPI::this_mpi_process(mpi_communicator);
 
+    // For an asynchronous save, move the packed data into staging buffers
+    // that live until wait_for_save() is called, so that the transfer
+    // buffers can be reused right away.
+    if (asynchronous)
+      {
+        pending_save = std::make_unique<PendingSave>();
+        pending_save->sizes_fixed_cumulative = sizes_fixed_cumulative;
+        pending_save->data_fixed             = std::move(src_data_fixed);
+        pending_save->sizes_variable         = std::move(src_sizes_variable);
+        pending_save->data_variable          = std::move(src_data_variable);
+      }
+
+    const std::vector<char> &data_fixed =
+      asynchronous ? pending_save->data_fixed : src_data_fixed;
+    const std::vector<int> &sizes_variable =
+      asynchronous ? pending_save->sizes_variable : src_sizes_variable;
+    const std::vector<char> &data_variable =
+      asynchronous ? pending_save->data_variable : src_data_variable;
+
+    // Write a buffer into the file, either right away or via nonblocking
+    // MPI-IO. The data written by this process does not overlap with the
+    // data written by others, so independent (non-collective) writes are
+    // sufficient.
+    const auto write_at = [&](MPI_File           fh,
+                              const MPI_Offset   offset,
+                              const void *       data,
+                              const int          count,
+                              const MPI_Datatype datatype) {
+      if (asynchronous && !write_immediately)
+        {
+          MPI_Request request;
+          const int   ierr = MPI_File_iwrite_at(fh,
+                                                offset,
+                                                DEAL_II_MPI_CONST_CAST(data),
+                                                count,
+                                                datatype,
+                                                &request);
+          AssertThrowMPI(ierr);
+          pending_save->requests.push_back(request);
+        }
+      else
+        {
+          const int ierr = MPI_File_write_at(fh,
+                                             offset,
+                                             DEAL_II_MPI_CONST_CAST(data),
+                                             count,
+                                             datatype,
+                                             MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+    };
+
+    // Close a file, or leave this to wait_for_save() for an asynchronous
+    // save.
+    const auto close = [&](MPI_File &fh) {
+      if (asynchronous)
+        pending_save->files.push_back(fh);
+      else
+        {
+          const int ierr = MPI_File_close(&fh);
+          AssertThrowMPI(ierr);
+        }
+    };
+
     //
     // ---------- Fixed size data ----------
     //
@@ -1428,37 +1546,26 @@ namespace parallel
       // Since each processor owns the same information about the data sizes,
       // it is sufficient to let only the first processor perform this task.
       if (myrank == 0)
-        {
-          const unsigned int *data = sizes_fixed_cumulative.data();
-
-          ierr = MPI_File_write_at(fh,
-                                   0,
-                                   DEAL_II_MPI_CONST_CAST(data),
-                                   sizes_fixed_cumulative.size(),
-                                   MPI_UNSIGNED,
-                                   MPI_STATUS_IGNORE);
-          AssertThrowMPI(ierr);
-        }
+        write_at(fh,
+                 0,
+                 asynchronous ? pending_save->sizes_fixed_cumulative.data() :
+                                sizes_fixed_cumulative.data(),
+                 sizes_fixed_cumulative.size(),
+                 MPI_UNSIGNED);
 
       // Write packed data to file simultaneously.
       const unsigned int offset_fixed =
         sizes_fixed_cumulative.size() * sizeof(unsigned int);
 
-      const char *data = src_data_fixed.data();
-
-      ierr = MPI_File_write_at(
-        fh,
-        offset_fixed +
-          global_first_cell *
-            sizes_fixed_cumulative.back(), // global position in file
-        DEAL_II_MPI_CONST_CAST(data),
-        src_data_fixed.size(), // local buffer
-        MPI_CHAR,
-        MPI_STATUS_IGNORE);
-      AssertThrowMPI(ierr);
+      write_at(fh,
+               offset_fixed +
+                 global_first_cell *
+                   sizes_fixed_cumulative.back(), // global position in file
+               data_fixed.data(),
+               data_fixed.size(), // local buffer
+               MPI_CHAR);
 
-      ierr = MPI_File_close(&fh);
-      AssertThrowMPI(ierr);
+      close(fh);
     }
 
     //
@@ -1491,25 +1598,19 @@ namespace parallel
         AssertThrowMPI(ierr);
 
         // Write sizes of each cell into file simultaneously.
-        {
-          const int *data = src_sizes_variable.data();
-          ierr =
-            MPI_File_write_at(fh,
-                              global_first_cell *
-                                sizeof(unsigned int), // global position in file
-                              DEAL_II_MPI_CONST_CAST(data),
-                              src_sizes_variable.size(), // local buffer
-                              MPI_INT,
-                              MPI_STATUS_IGNORE);
-          AssertThrowMPI(ierr);
-        }
+        write_at(fh,
+                 global_first_cell *
+                   sizeof(unsigned int), // global position in file
+                 sizes_variable.data(),
+                 sizes_variable.size(), // local buffer
+                 MPI_INT);
 
 
         const unsigned int offset_variable =
           global_num_cells * sizeof(unsigned int);
 
         // Gather size of data in bytes we want to store from this processor.
-        const unsigned int size_on_proc = src_data_variable.size();
+        const unsigned int size_on_proc = data_variable.size();
 
         // Compute prefix sum
         unsigned int prefix_sum = 0;
@@ -1521,25 +1622,21 @@ namespace parallel
                           mpi_communicator);
         AssertThrowMPI(ierr);
 
-        const char *data = src_data_variable.data();
-
         // Write data consecutively into file.
-        ierr = MPI_File_write_at(fh,
-                                 offset_variable +
-                                   prefix_sum, // global position in file
-                                 DEAL_II_MPI_CONST_CAST(data),
-                                 src_data_variable.size(), // local buffer
-                                 MPI_CHAR,
-                                 MPI_STATUS_IGNORE);
-        AssertThrowMPI(ierr);
+        write_at(fh,
+                 offset_variable + prefix_sum, // global position in file
+                 data_variable.data(),
+                 data_variable.size(), // local buffer
+                 MPI_CHAR);
 
-        ierr = MPI_File_close(&fh);
-        AssertThrowMPI(ierr);
+        close(fh);
       }
 #else
     (void)global_first_cell;
     (void)global_num_cells;
     (void)filename;
+    (void)asynchronous;
+    (void)write_immediately;
 
     AssertThrow(false, ExcNeedsMPI());
 #endif
@@ -1547,6 +1644,53 @@ namespace parallel
 
 
 
+  template <int dim, int spacedim>
+  bool
+  DistributedTriangulationBase<dim, spacedim>::DataTransfer::test_save() const
+  {
+    if (pending_save == nullptr)
+      return true;
+
+#ifdef DEAL_II_WITH_MPI
+    int       flag = 0;
+    const int ierr = MPI_Testall(pending_save->requests.size(),
+                                 pending_save->requests.data(),
+                                 &flag,
+                                 MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+    return (flag != 0);
+#else
+    return true;
+#endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DistributedTriangulationBase<dim, spacedim>::DataTransfer::wait_for_save()
+  {
+    if (pending_save == nullptr)
+      return;
+
+#ifdef DEAL_II_WITH_MPI
+    int ierr = MPI_Waitall(pending_save->requests.size(),
+                           pending_save->requests.data(),
+                           MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+
+    for (MPI_File &fh : pending_save->files)
+      {
+        ierr = MPI_File_close(&fh);
+        AssertThrowMPI(ierr);
+      }
+#endif
+
+    pending_save.reset();
+  }
+
+
+
   template <int dim, int spacedim>
   void
   DistributedTriangulationBase<dim, spacedim>::DataTransfer::load(
@@ -18,6 +18,8 @@
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/cell_data_transfer.templates.h>
 #include <deal.II/distributed/fully_distributed_tria.h>
@@ -939,6 +941,61 @@ namespace internal
           local_index,
           global_index);
       }
+
+
+
+      /**
+       * Fill the cache of the level DoF indices of all cells on the given
+       * @p level, which is then used by DoFCellAccessor::get_mg_dof_indices()
+       * instead of collecting the indices from the vertices, lines, etc. of
+       * the cell. Since the level DoFs are only supported for elements
+       * without hp-capabilities, all cells have the same number of DoFs and
+       * the cache is a contiguous array indexed by the cell index.
+       */
+      template <int dim, int spacedim>
+      static void
+      update_mg_cell_dof_indices_cache(DoFHandler<dim, spacedim> &dof_handler,
+                                       const unsigned int         level)
+      {
+        AssertIndexRange(level, dof_handler.mg_levels.size());
+
+        const unsigned int dofs_per_cell =
+          dof_handler.get_fe().n_dofs_per_cell();
+        std::vector<types::global_dof_index> &cache =
+          dof_handler.mg_levels[level]->cell_dof_indices_cache;
+
+        // clear the cache first, so that the calls to get_mg_dof_indices()
+        // below go through the objects of the cell
+        cache.clear();
+        if (dofs_per_cell == 0)
+          return;
+
+        std::vector<types::global_dof_index> new_cache(
+          dof_handler.get_triangulation().n_raw_cells(level) * dofs_per_cell,
+          numbers::invalid_dof_index);
+
+        const auto worker = [&](const auto &cell, void *, void *) {
+          if (cell->level_subdomain_id() == numbers::artificial_subdomain_id)
+            return;
+
+          std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+          cell->get_mg_dof_indices(dof_indices);
+          std::copy(dof_indices.begin(),
+                    dof_indices.end(),
+                    new_cache.begin() + cell->index() * dofs_per_cell);
+        };
+
+        WorkStream::run(dof_handler.begin_mg(level),
+                        dof_handler.end_mg(level),
+                        worker,
+                        /* copier */ std::function<void(void *)>(),
+                        /* scratch_data */ nullptr,
+                        /* copy_data */ nullptr,
+                        2 * MultithreadInfo::n_threads(),
+                        /* chunk_size = */ 32);
+
+        cache.swap(new_cache);
+      }
     };
   } // namespace DoFHandlerImplementation
 
@@ -2333,6 +2390,24 @@ DoFHandler<dim, spacedim>::active_cell_iterators() const
 
 
 
+template <int dim, int spacedim>
+typename DoFHandler<dim, spacedim>::active_cell_iterator
+DoFHandler<dim, spacedim>::get_active_cell_iterator(
+  const unsigned int active_cell_index) const
+{
+  AssertIndexRange(active_cell_index,
+                   this->get_triangulation().n_active_cells());
+  const std::pair<unsigned int, unsigned int> &level_and_index =
+    this->get_triangulation()
+      .get_active_cell_levels_and_indices()[active_cell_index];
+  return active_cell_iterator(&this->get_triangulation(),
+                              level_and_index.first,
+                              level_and_index.second,
+                              this);
+}
+
+
+
 template <int dim, int spacedim>
 IteratorRange<typename DoFHandler<dim, spacedim>::level_cell_iterator>
 DoFHandler<dim, spacedim>::mg_cell_iterators() const
@@ -2767,6 +2842,10 @@ DoFHandler<dim, spacedim>::distribute_mg_dofs()
   internal::DoFHandlerImplementation::Implementation::reserve_space_mg(*this);
   this->mg_number_cache = this->policy->distribute_mg_dofs();
 
+  for (unsigned int level = 0; level < this->mg_levels.size(); ++level)
+    internal::DoFHandlerImplementation::Implementation::
+      update_mg_cell_dof_indices_cache(*this, level);
+
   // initialize the block info object only if this is a sequential
   // triangulation. it doesn't work correctly yet if it is parallel
   if (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
@@ -3006,8 +3085,15 @@ DoFHandler<dim, spacedim>::renumber_dofs(
                "New DoF index is not less than the total number of dofs."));
 #endif
 
+  // the cached indices on this level become invalid while the policy
+  // renumbers, so only build the cache again afterwards
+  this->mg_levels[level]->cell_dof_indices_cache.clear();
+
   this->mg_number_cache[level] =
     this->policy->renumber_mg_dofs(level, new_numbers);
+
+  internal::DoFHandlerImplementation::Implementation::
+    update_mg_cell_dof_indices_cache(*this, level);
 }
 
 
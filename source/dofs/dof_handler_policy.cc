@@ -16,6 +16,8 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -35,6 +37,7 @@
 #include <deal.II/grid/tria_iterator.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -124,79 +127,6 @@ namespace internal
                           2 * MultithreadInfo::n_threads(),
                           /* chunk_size = */ 32);
         }
-
-
-        using DoFIdentities =
-          std::vector<std::pair<unsigned int, unsigned int>>;
-
-
-        /**
-         * Make sure that the given @p identities pointer points to a
-         * valid array. If the pointer is zero beforehand, create an
-         * entry with the correct data. If it is nonzero, don't touch
-         * it.
-         *
-         * @p structdim denotes the dimension of the objects on which
-         * identities are to be represented, i.e. zero for vertices,
-         * one for lines, etc.
-         */
-        template <int structdim, int dim, int spacedim>
-        const std::unique_ptr<DoFIdentities> &
-        ensure_existence_and_return_dof_identities(
-          const FiniteElement<dim, spacedim> &fe1,
-          const FiniteElement<dim, spacedim> &fe2,
-          std::unique_ptr<DoFIdentities> &    identities,
-          const unsigned int face_no = numbers::invalid_unsigned_int)
-        {
-          Assert(structdim == 2 || face_no == numbers::invalid_unsigned_int,
-                 ExcInternalError());
-
-          // see if we need to fill this entry, or whether it already
-          // exists
-          if (identities.get() == nullptr)
-            {
-              switch (structdim)
-                {
-                  case 0:
-                    {
-                      identities = std::make_unique<DoFIdentities>(
-                        fe1.hp_vertex_dof_identities(fe2));
-                      break;
-                    }
-
-                  case 1:
-                    {
-                      identities = std::make_unique<DoFIdentities>(
-                        fe1.hp_line_dof_identities(fe2));
-                      break;
-                    }
-
-                  case 2:
-                    {
-                      identities = std::make_unique<DoFIdentities>(
-                        fe1.hp_quad_dof_identities(fe2, face_no));
-                      break;
-                    }
-
-                  default:
-                    Assert(false, ExcNotImplemented());
-                }
-
-              // double check whether the newly created entries make
-              // any sense at all
-              for (unsigned int i = 0; i < identities->size(); ++i)
-                {
-                  Assert((*identities)[i].first <
-                           fe1.template n_dofs_per_object<structdim>(face_no),
-                         ExcInternalError());
-                  Assert((*identities)[i].second <
-                           fe2.template n_dofs_per_object<structdim>(face_no),
-                         ExcInternalError());
-                }
-            }
-
-          return identities;
-        }
       } // namespace
 
 
@@ -227,9 +157,6 @@ namespace internal
           // it is not clear whether this is actually necessary for
           // vertices at all, I can't think of a finite element that
           // would make that necessary...
-          dealii::Table<2, std::unique_ptr<DoFIdentities>>
-            vertex_dof_identities(dof_handler.get_fe_collection().size(),
-                                  dof_handler.get_fe_collection().size());
 
           // loop over all vertices and see which one we need to work on
           for (unsigned int vertex_index = 0;
@@ -285,11 +212,9 @@ namespace internal
                           // make sure the entry in the equivalence
                           // table exists
                           const auto &identities =
-                            *ensure_existence_and_return_dof_identities<0>(
-                              dof_handler.get_fe(most_dominating_fe_index),
-                              dof_handler.get_fe(other_fe_index),
-                              vertex_dof_identities[most_dominating_fe_index]
-                                                   [other_fe_index]);
+                            dof_handler.get_fe_collection()
+                              .hp_vertex_dof_identities(
+                                most_dominating_fe_index, other_fe_index);
 
                           // then loop through the identities we
                           // have. first get the global numbers of the
@@ -420,9 +345,6 @@ namespace internal
           // pairs of finite elements that have *identical* dofs, and then only
           // deal with those that are not identical of which we can handle at
           // most 2
-          dealii::Table<2, std::unique_ptr<DoFIdentities>> line_dof_identities(
-            dof_handler.fe_collection.size(), dof_handler.fe_collection.size());
-
           for (const auto &cell : dof_handler.active_cell_iterators())
             for (const auto l : cell->line_indices())
               if (cell->line(l)->user_flag_set() == false)
@@ -472,10 +394,9 @@ namespace internal
                               dof_handler.get_fe(fe_index_1).n_dofs_per_line();
 
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<1>(
-                                dof_handler.get_fe(fe_index_1),
-                                dof_handler.get_fe(fe_index_2),
-                                line_dof_identities[fe_index_1][fe_index_2]);
+                              dof_handler.get_fe_collection()
+                                .hp_line_dof_identities(fe_index_1,
+                                                        fe_index_2);
                             // see if these sets of dofs are identical. the
                             // first condition for this is that indeed there are
                             // n identities
@@ -659,13 +580,10 @@ namespace internal
                             if (other_fe_index != most_dominating_fe_index)
                               {
                                 const auto &identities =
-                                  *ensure_existence_and_return_dof_identities<
-                                    1>(dof_handler.get_fe(
-                                         most_dominating_fe_index),
-                                       dof_handler.get_fe(other_fe_index),
-                                       line_dof_identities
-                                         [most_dominating_fe_index]
-                                         [other_fe_index]);
+                                  dof_handler.get_fe_collection()
+                                    .hp_line_dof_identities(
+                                      most_dominating_fe_index,
+                                      other_fe_index);
 
                                 for (const auto &identity : identities)
                                   {
@@ -786,11 +704,6 @@ namespace internal
           // trouble. note that this only happens for lines in 3d and
           // higher, and for quads only in 4d and higher, so this
           // isn't a particularly frequent case
-          dealii::Table<3, std::unique_ptr<DoFIdentities>> quad_dof_identities(
-            dof_handler.fe_collection.size(),
-            dof_handler.fe_collection.size(),
-            2 /*triangle (0) or quadrilateral (1)*/);
-
           for (const auto &cell : dof_handler.active_cell_iterators())
             for (const auto q : cell->face_indices())
               if ((cell->quad(q)->user_flag_set() == false) &&
@@ -830,14 +743,11 @@ namespace internal
                         if (other_fe_index != most_dominating_fe_index)
                           {
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<2>(
-                                dof_handler.get_fe(most_dominating_fe_index),
-                                dof_handler.get_fe(other_fe_index),
-                                quad_dof_identities
-                                  [most_dominating_fe_index][other_fe_index]
-                                  [cell->quad(q)->reference_cell() ==
-                                   dealii::ReferenceCells::Quadrilateral],
-                                most_dominating_fe_index_face_no);
+                              dof_handler.get_fe_collection()
+                                .hp_quad_dof_identities(
+                                  most_dominating_fe_index,
+                                  other_fe_index,
+                                  most_dominating_fe_index_face_no);
 
                             for (const auto &identity : identities)
                               {
@@ -1072,9 +982,6 @@ namespace internal
           // it is not clear whether this is actually necessary for
           // vertices at all, I can't think of a finite element that
           // would make that necessary...
-          dealii::Table<2, std::unique_ptr<DoFIdentities>>
-            vertex_dof_identities(dof_handler.get_fe_collection().size(),
-                                  dof_handler.get_fe_collection().size());
 
           // mark all vertices on ghost cells
           std::vector<bool> include_vertex(
@@ -1143,11 +1050,9 @@ namespace internal
                           // make sure the entry in the equivalence
                           // table exists
                           const auto &identities =
-                            *ensure_existence_and_return_dof_identities<0>(
-                              dof_handler.get_fe(most_dominating_fe_index),
-                              dof_handler.get_fe(other_fe_index),
-                              vertex_dof_identities[most_dominating_fe_index]
-                                                   [other_fe_index]);
+                            dof_handler.get_fe_collection()
+                              .hp_vertex_dof_identities(
+                                most_dominating_fe_index, other_fe_index);
 
                           // then loop through the identities we
                           // have. first get the global numbers of the
@@ -1268,9 +1173,6 @@ namespace internal
           // pairs of finite elements that have *identical* dofs, and then only
           // deal with those that are not identical of which we can handle at
           // most 2
-          dealii::Table<2, std::unique_ptr<DoFIdentities>> line_dof_identities(
-            dof_handler.fe_collection.size(), dof_handler.fe_collection.size());
-
           for (const auto &cell : dof_handler.active_cell_iterators())
             for (const auto l : cell->line_indices())
               if ((cell->is_locally_owned()) &&
@@ -1305,10 +1207,9 @@ namespace internal
                               dof_handler.get_fe(fe_index_1).n_dofs_per_line();
 
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<1>(
-                                dof_handler.get_fe(fe_index_1),
-                                dof_handler.get_fe(fe_index_2),
-                                line_dof_identities[fe_index_1][fe_index_2]);
+                              dof_handler.get_fe_collection()
+                                .hp_line_dof_identities(fe_index_1,
+                                                        fe_index_2);
                             // see if these sets of dofs are identical. the
                             // first condition for this is that indeed there are
                             // n identities
@@ -1432,13 +1333,10 @@ namespace internal
                             if (other_fe_index != most_dominating_fe_index)
                               {
                                 const auto &identities =
-                                  *ensure_existence_and_return_dof_identities<
-                                    1>(dof_handler.get_fe(
-                                         most_dominating_fe_index),
-                                       dof_handler.get_fe(other_fe_index),
-                                       line_dof_identities
-                                         [most_dominating_fe_index]
-                                         [other_fe_index]);
+                                  dof_handler.get_fe_collection()
+                                    .hp_line_dof_identities(
+                                      most_dominating_fe_index,
+                                      other_fe_index);
 
                                 for (const auto &identity : identities)
                                   {
@@ -1540,11 +1438,6 @@ namespace internal
           // trouble. note that this only happens for lines in 3d and
           // higher, and for quads only in 4d and higher, so this
           // isn't a particularly frequent case
-          dealii::Table<3, std::unique_ptr<DoFIdentities>> quad_dof_identities(
-            dof_handler.fe_collection.size(),
-            dof_handler.fe_collection.size(),
-            2 /*triangle (0) or quadrilateral (1)*/);
-
           for (const auto &cell : dof_handler.active_cell_iterators())
             for (const auto q : cell->face_indices())
               if ((cell->is_locally_owned()) &&
@@ -1585,14 +1478,11 @@ namespace internal
                         if (other_fe_index != most_dominating_fe_index)
                           {
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<2>(
-                                dof_handler.get_fe(most_dominating_fe_index),
-                                dof_handler.get_fe(other_fe_index),
-                                quad_dof_identities
-                                  [most_dominating_fe_index][other_fe_index]
-                                  [cell->quad(q)->reference_cell() ==
-                                   dealii::ReferenceCells::Quadrilateral],
-                                most_dominating_fe_index_face_no);
+                              dof_handler.get_fe_collection()
+                                .hp_quad_dof_identities(
+                                  most_dominating_fe_index,
+                                  other_fe_index,
+                                  most_dominating_fe_index_face_no);
 
                             for (const auto &identity : identities)
                               {
@@ -1685,6 +1575,224 @@ namespace internal
 
 
 
+        /**
+         * Same as distribute_dofs(), but using several threads. The result is
+         * identical to the one of the serial loop over the cells: there, a
+         * degree of freedom gets its index from the first cell (in the order
+         * of active cell iteration) that contains it, and the indices within
+         * each cell are handed out in the order of the cell-local degrees of
+         * freedom. Here, this is reproduced by first determining for each
+         * vertex, line, and quad (and finite element index) the first cell it
+         * belongs to, then counting the indices each cell has to assign,
+         * computing the offsets of the cells by a prefix sum, and finally
+         * letting each cell number the objects it owns.
+         */
+        template <int dim, int spacedim>
+        static types::global_dof_index
+        distribute_dofs_in_parallel(const types::subdomain_id  subdomain_id,
+                                    DoFHandler<dim, spacedim> &dof_handler)
+        {
+          using active_cell_iterator =
+            typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+          const dealii::Triangulation<dim, spacedim> &tria =
+            dof_handler.get_triangulation();
+
+          std::vector<active_cell_iterator> cells;
+          for (const auto &cell : dof_handler.active_cell_iterators())
+            if (!cell->is_artificial())
+              if ((subdomain_id == numbers::invalid_subdomain_id) ||
+                  (cell->subdomain_id() == subdomain_id))
+                cells.push_back(cell);
+
+          const unsigned int n_cells = cells.size();
+          const unsigned int grainsize = 128;
+
+          // the first cell containing a given object with a given finite
+          // element, as position within the vector of cells above
+          const unsigned int n_fes = dof_handler.get_fe_collection().size();
+
+          std::vector<std::atomic<unsigned int>> vertex_owners(
+            tria.n_vertices() * n_fes);
+          std::vector<std::atomic<unsigned int>> line_owners(
+            dim > 1 ? tria.n_raw_lines() * n_fes : 0);
+          std::vector<std::atomic<unsigned int>> quad_owners(
+            dim > 2 ? tria.n_raw_quads() * n_fes : 0);
+
+          for (auto *owners : {&vertex_owners, &line_owners, &quad_owners})
+            for (auto &owner : *owners)
+              owner.store(numbers::invalid_unsigned_int,
+                          std::memory_order_relaxed);
+
+          // call the given function for each object of the cell in the
+          // order in which their degrees of freedom appear in the result of
+          // get_dof_indices(). the arguments are the owner of the object
+          // (nullptr for the interior of the cell, which is always owned by
+          // the cell itself), the number of degrees of freedom on the object,
+          // and a function setting the value of the i-th degree of freedom
+          // of the object in the cell-local ordering
+          const auto for_each_object = [&](const active_cell_iterator &cell,
+                                           const auto &                f) {
+            const auto &       fe       = cell->get_fe();
+            const unsigned int fe_index = cell->active_fe_index();
+
+            for (const unsigned int v : cell->vertex_indices())
+              f(&vertex_owners[cell->vertex_index(v) * n_fes + fe_index],
+                fe.n_dofs_per_vertex(),
+                [&](const unsigned int i, const types::global_dof_index index) {
+                  cell->set_vertex_dof_index(v, i, index, fe_index);
+                });
+
+            if (dim > 1)
+              for (const unsigned int l : cell->line_indices())
+                f(&line_owners[cell->line(l)->index() * n_fes + fe_index],
+                  fe.n_dofs_per_line(),
+                  [&](const unsigned int              i,
+                      const types::global_dof_index index) {
+                    cell->line(l)->set_dof_index(
+                      fe.adjust_line_dof_index_for_line_orientation(
+                        i, cell->line_orientation(l)),
+                      index,
+                      fe_index);
+                  });
+
+            if (dim > 2)
+              for (const unsigned int q : cell->face_indices())
+                f(&quad_owners[cell->quad(q)->index() * n_fes + fe_index],
+                  fe.n_dofs_per_quad(q),
+                  [&](const unsigned int              i,
+                      const types::global_dof_index index) {
+                    cell->quad(q)->set_dof_index(
+                      fe.adjust_quad_dof_index_for_face_orientation(
+                        i,
+                        q,
+                        cell->face_orientation(q),
+                        cell->face_flip(q),
+                        cell->face_rotation(q)),
+                      index,
+                      fe_index);
+                  });
+
+            f(nullptr,
+              dim == 1 ? fe.n_dofs_per_line() :
+                         (dim == 2 ? fe.n_dofs_per_quad(0) :
+                                     fe.n_dofs_per_hex()),
+              [&](const unsigned int i, const types::global_dof_index index) {
+                cell->set_dof_index(i, index, fe_index);
+              });
+          };
+
+          // Step 1: determine the owner of each object as the first cell
+          // containing it
+          dealii::parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
+                for_each_object(cells[c],
+                                [c](std::atomic<unsigned int> *owner,
+                                    const unsigned int,
+                                    const auto &) {
+                                  if (owner == nullptr)
+                                    return;
+                                  unsigned int current =
+                                    owner->load(std::memory_order_relaxed);
+                                  while (c < current &&
+                                         !owner->compare_exchange_weak(
+                                           current,
+                                           c,
+                                           std::memory_order_relaxed))
+                                    {
+                                    }
+                                });
+            },
+            grainsize);
+
+          // loop over the cell-local degrees of freedom of the objects owned
+          // by the c-th cell that do not have an index yet
+          const auto for_each_new_dof =
+            [&](const unsigned int                          c,
+                const std::vector<types::global_dof_index> &dof_indices,
+                const auto &                                f) {
+              unsigned int index = 0;
+              for_each_object(cells[c],
+                              [&](std::atomic<unsigned int> *owner,
+                                  const unsigned int          n_dofs,
+                                  const auto &                set_dof) {
+                                if (owner == nullptr ||
+                                    owner->load(std::memory_order_relaxed) ==
+                                      c)
+                                  {
+                                    for (unsigned int i = 0; i < n_dofs; ++i)
+                                      if (dof_indices[index + i] ==
+                                          numbers::invalid_dof_index)
+                                        f(i, set_dof);
+                                  }
+                                index += n_dofs;
+                              });
+            };
+
+          const auto get_dof_indices =
+            [](const active_cell_iterator &          cell,
+               std::vector<types::global_dof_index> &dof_indices) {
+              dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+
+              // circumvent cache
+              internal::DoFAccessorImplementation::Implementation::
+                get_dof_indices(*cell, dof_indices, cell->active_fe_index());
+            };
+
+          // Step 2: count the new indices of each cell
+          std::vector<types::global_dof_index> offsets(n_cells + 1, 0);
+          dealii::parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              std::vector<types::global_dof_index> dof_indices;
+              for (unsigned int c = begin; c < end; ++c)
+                {
+                  get_dof_indices(cells[c], dof_indices);
+                  for_each_new_dof(c,
+                                   dof_indices,
+                                   [&](const unsigned int, const auto &) {
+                                     ++offsets[c + 1];
+                                   });
+                }
+            },
+            grainsize);
+
+          std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+          // Step 3: assign the indices. each cell only writes to the objects
+          // it owns
+          dealii::parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              std::vector<types::global_dof_index> dof_indices;
+              for (unsigned int c = begin; c < end; ++c)
+                {
+                  get_dof_indices(cells[c], dof_indices);
+
+                  types::global_dof_index next_free_dof = offsets[c];
+                  for_each_new_dof(c,
+                                   dof_indices,
+                                   [&](const unsigned int i,
+                                       const auto &       set_dof) {
+                                     set_dof(i, next_free_dof++);
+                                   });
+                  AssertDimension(next_free_dof, offsets[c + 1]);
+                }
+            },
+            grainsize);
+
+          update_all_active_cell_dof_indices_caches(dof_handler);
+
+          return offsets.back();
+        }
+
+
+
         /**
          * Distribute degrees of freedom on all cells, or on cells with the
          * correct subdomain_id if the corresponding argument is not equal to
@@ -1699,6 +1807,9 @@ namespace internal
           Assert(dof_handler.get_triangulation().n_levels() > 0,
                  ExcMessage("Empty triangulation"));
 
+          if (MultithreadInfo::n_threads() > 1)
+            return distribute_dofs_in_parallel(subdomain_id, dof_handler);
+
           // Step 1: distribute dofs on all cells, but definitely
           // exclude artificial cells
           types::global_dof_index next_free_dof = 0;
@@ -60,6 +60,7 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #include <cmath>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <vector>
 
 
@@ -2249,6 +2250,210 @@ namespace DoFRenumbering
            ExcInternalError());
   }
 
+
+  template <int dim, int spacedim>
+  void
+  hilbert(DoFHandler<dim, spacedim> &dof_handler)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs(), numbers::invalid_dof_index);
+    compute_hilbert(renumbering, dof_handler);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_hilbert(std::vector<types::global_dof_index> &new_dof_indices,
+                  const DoFHandler<dim, spacedim> &     dof_handler)
+  {
+    Assert(dof_handler.has_active_dofs(), ExcDoFHandlerNotInitialized());
+
+    const IndexSet &owned_dofs = dof_handler.locally_owned_dofs();
+    const types::global_dof_index n_owned_dofs = owned_dofs.n_elements();
+    AssertDimension(new_dof_indices.size(), n_owned_dofs);
+
+    using active_cell_iterator =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+    // sort the locally owned cells along a Hilbert curve through their
+    // centers
+    std::vector<active_cell_iterator> cells;
+    std::vector<Point<spacedim>>      centers;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cells.push_back(cell);
+          centers.push_back(cell->center());
+        }
+
+    const auto hilbert_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers);
+    std::vector<unsigned int> cell_order(cells.size());
+    std::iota(cell_order.begin(), cell_order.end(), 0U);
+    std::sort(cell_order.begin(),
+              cell_order.end(),
+              [&](const unsigned int a, const unsigned int b) {
+                return std::lexicographical_compare(hilbert_indices[a].begin(),
+                                                    hilbert_indices[a].end(),
+                                                    hilbert_indices[b].begin(),
+                                                    hilbert_indices[b].end());
+              });
+
+    // collect the subdomain ids of the ghost cells adjacent to a cell over
+    // one of its faces
+    const auto ghost_neighbors = [](const active_cell_iterator &cell) {
+      std::vector<types::subdomain_id> subdomains;
+      for (const unsigned int f : cell->face_indices())
+        {
+          if (cell->at_boundary(f) && !cell->has_periodic_neighbor(f))
+            continue;
+
+          const bool periodic = cell->at_boundary(f);
+          const auto neighbor = cell->neighbor_or_periodic_neighbor(f);
+          if (!neighbor->has_children())
+            {
+              if (neighbor->is_ghost())
+                subdomains.push_back(neighbor->subdomain_id());
+            }
+          else if (dim == 1)
+            {
+              auto child = neighbor;
+              while (child->has_children())
+                child = child->child(1 - f);
+              if (child->is_ghost())
+                subdomains.push_back(child->subdomain_id());
+            }
+          else
+            for (unsigned int sf = 0; sf < cell->face(f)->n_children(); ++sf)
+              {
+                const auto child =
+                  periodic ? cell->periodic_neighbor_child_on_subface(f, sf) :
+                             cell->neighbor_child_on_subface(f, sf);
+                if (child->is_ghost())
+                  subdomains.push_back(child->subdomain_id());
+              }
+        }
+      return subdomains;
+    };
+
+    // determine for each locally owned dof the set of other processes that
+    // need it, i.e., that own a cell where it is located
+    std::vector<std::vector<types::subdomain_id>> sharing_processes(
+      n_owned_dofs);
+    std::vector<types::global_dof_index> cell_dofs;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_ghost())
+        {
+          cell_dofs.resize(cell->get_fe().n_dofs_per_cell());
+          cell->get_dof_indices(cell_dofs);
+          for (const auto dof : cell_dofs)
+            {
+              const auto local_dof = owned_dofs.index_within_set(dof);
+              if (local_dof != numbers::invalid_dof_index)
+                sharing_processes[local_dof].push_back(cell->subdomain_id());
+            }
+        }
+
+    // cells whose dofs are not shared over faces (e.g. discontinuous
+    // elements) communicate all their dofs to face neighbors on other
+    // processes
+    std::vector<bool> is_boundary_cell(cells.size(), false);
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      {
+        const auto &cell = cells[c];
+        cell_dofs.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(cell_dofs);
+
+        const std::vector<types::subdomain_id> neighbors =
+          ghost_neighbors(cell);
+        if (!neighbors.empty())
+          is_boundary_cell[c] = true;
+
+        const bool dofs_on_faces = cell->get_fe().n_dofs_per_face() > 0;
+        for (const auto dof : cell_dofs)
+          {
+            const auto local_dof = owned_dofs.index_within_set(dof);
+            if (local_dof == numbers::invalid_dof_index)
+              is_boundary_cell[c] = true;
+            else
+              {
+                if (!dofs_on_faces)
+                  sharing_processes[local_dof].insert(
+                    sharing_processes[local_dof].end(),
+                    neighbors.begin(),
+                    neighbors.end());
+                if (!sharing_processes[local_dof].empty())
+                  is_boundary_cell[c] = true;
+              }
+          }
+      }
+
+    // assign each dof to a group: 0 for dofs only touched by interior
+    // cells, 1 for the other dofs touched by boundary cells, and 2 + i for
+    // the dofs shared with the i-th set of processes
+    std::map<std::vector<types::subdomain_id>, unsigned int> process_sets;
+    for (auto &processes : sharing_processes)
+      if (!processes.empty())
+        {
+          std::sort(processes.begin(), processes.end());
+          processes.erase(std::unique(processes.begin(), processes.end()),
+                          processes.end());
+          process_sets.emplace(processes, 0);
+        }
+    {
+      unsigned int counter = 2;
+      for (auto &process_set : process_sets)
+        process_set.second = counter++;
+    }
+
+    std::vector<unsigned int> dof_group(n_owned_dofs, 0);
+    for (types::global_dof_index i = 0; i < n_owned_dofs; ++i)
+      if (!sharing_processes[i].empty())
+        dof_group[i] = process_sets[sharing_processes[i]];
+
+    // enumerate the dofs in the order the sorted cells touch them
+    std::vector<types::global_dof_index> reverse;
+    reverse.reserve(n_owned_dofs);
+    std::vector<bool> already_sorted(n_owned_dofs, false);
+    for (const unsigned int c : cell_order)
+      {
+        const auto &cell = cells[c];
+        cell_dofs.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(cell_dofs);
+        std::sort(cell_dofs.begin(), cell_dofs.end());
+        for (const auto dof : cell_dofs)
+          {
+            const auto local_dof = owned_dofs.index_within_set(dof);
+            if (local_dof == numbers::invalid_dof_index)
+              continue;
+            if (is_boundary_cell[c] && dof_group[local_dof] == 0)
+              dof_group[local_dof] = 1;
+            if (!already_sorted[local_dof])
+              {
+                already_sorted[local_dof] = true;
+                reverse.push_back(local_dof);
+              }
+          }
+      }
+    Assert(reverse.size() == n_owned_dofs,
+           ExcMessage("The locally owned cells did not cover all locally "
+                      "owned degrees of freedom."));
+
+    std::stable_sort(reverse.begin(),
+                     reverse.end(),
+                     [&](const types::global_dof_index a,
+                         const types::global_dof_index b) {
+                       return dof_group[a] < dof_group[b];
+                     });
+
+    for (types::global_dof_index i = 0; i < reverse.size(); ++i)
+      new_dof_indices[reverse[i]] = owned_dofs.nth_index_in_set(i);
+  }
+
+
 } // namespace DoFRenumbering
 
 
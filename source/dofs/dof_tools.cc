@@ -17,6 +17,7 @@
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -2222,13 +2223,20 @@ namespace DoFTools
   {
     namespace
     {
-      template <int dim, int spacedim>
+      /**
+       * Compute the support points of the degrees of freedom on all
+       * locally relevant cells and call @p store with the index and the
+       * location of each degree of freedom selected by @p in_mask. The
+       * support points are computed in parallel on the available threads,
+       * whereas @p store is only ever called by one thread at a time.
+       */
+      template <int dim, int spacedim, typename StoreFunction>
       void
-      map_dofs_to_support_points(
-        const hp::MappingCollection<dim, spacedim> &        mapping,
-        const DoFHandler<dim, spacedim> &                   dof_handler,
-        std::map<types::global_dof_index, Point<spacedim>> &support_points,
-        const ComponentMask &                               in_mask)
+      compute_support_points(
+        const hp::MappingCollection<dim, spacedim> &mapping,
+        const DoFHandler<dim, spacedim> &           dof_handler,
+        const ComponentMask &                       in_mask,
+        const StoreFunction &                       store)
       {
         const hp::FECollection<dim, spacedim> &fe_collection =
           dof_handler.get_fe_collection();
@@ -2257,39 +2265,75 @@ namespace DoFTools
         //
         // The weights of the quadrature rule have been set to invalid
         // values by the used constructor.
-        hp::FEValues<dim, spacedim> hp_fe_values(mapping,
-                                                 fe_collection,
-                                                 q_coll_dummy,
-                                                 update_quadrature_points);
-        typename DoFHandler<dim, spacedim>::active_cell_iterator
-          cell = dof_handler.begin_active(),
-          endc = dof_handler.end();
-
-        std::vector<types::global_dof_index> local_dof_indices;
-        for (; cell != endc; ++cell)
-          // only work on locally relevant cells
-          if (cell->is_artificial() == false)
-            {
-              hp_fe_values.reinit(cell);
-              const FEValues<dim, spacedim> &fe_values =
-                hp_fe_values.get_present_fe_values();
-
-              local_dof_indices.resize(cell->get_fe().n_dofs_per_cell());
-              cell->get_dof_indices(local_dof_indices);
+        //
+        // Evaluating the mapping is the expensive part, so every thread
+        // works on its own copy of the hp::FEValues object and only hands
+        // the selected degrees of freedom and their locations to the copier
+        struct CopyData
+        {
+          std::vector<types::global_dof_index> dof_indices;
+          std::vector<Point<spacedim>>         points;
+        };
+
+        WorkStream::run(
+          dof_handler.begin_active(),
+          dof_handler.end(),
+          [&mask](const typename DoFHandler<dim, spacedim>::
+                    active_cell_iterator &     cell,
+                  hp::FEValues<dim, spacedim> &hp_fe_values,
+                  CopyData &                   copy_data) {
+            copy_data.dof_indices.clear();
+            copy_data.points.clear();
+
+            // only work on locally relevant cells
+            if (cell->is_artificial())
+              return;
+
+            hp_fe_values.reinit(cell);
+            const std::vector<Point<spacedim>> &points =
+              hp_fe_values.get_present_fe_values().get_quadrature_points();
+
+            const FiniteElement<dim, spacedim> &fe = cell->get_fe();
+            std::vector<types::global_dof_index> local_dof_indices(
+              fe.n_dofs_per_cell());
+            cell->get_dof_indices(local_dof_indices);
 
-              const std::vector<Point<spacedim>> &points =
-                fe_values.get_quadrature_points();
-              for (unsigned int i = 0; i < cell->get_fe().n_dofs_per_cell();
-                   ++i)
+            for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+              // only store the values for valid components
+              if (mask[fe.system_to_component_index(i).first])
                 {
-                  const unsigned int dof_comp =
-                    cell->get_fe().system_to_component_index(i).first;
-
-                  // insert the values into the map if it is a valid component
-                  if (mask[dof_comp])
-                    support_points[local_dof_indices[i]] = points[i];
+                  copy_data.dof_indices.push_back(local_dof_indices[i]);
+                  copy_data.points.push_back(points[i]);
                 }
-            }
+          },
+          [&store](const CopyData &copy_data) {
+            for (unsigned int i = 0; i < copy_data.dof_indices.size(); ++i)
+              store(copy_data.dof_indices[i], copy_data.points[i]);
+          },
+          hp::FEValues<dim, spacedim>(mapping,
+                                      fe_collection,
+                                      q_coll_dummy,
+                                      update_quadrature_points),
+          CopyData());
+      }
+
+
+      template <int dim, int spacedim>
+      void
+      map_dofs_to_support_points(
+        const hp::MappingCollection<dim, spacedim> &        mapping,
+        const DoFHandler<dim, spacedim> &                   dof_handler,
+        std::map<types::global_dof_index, Point<spacedim>> &support_points,
+        const ComponentMask &                               mask)
+      {
+        compute_support_points(
+          mapping,
+          dof_handler,
+          mask,
+          [&support_points](const types::global_dof_index dof_index,
+                            const Point<spacedim> &       point) {
+            support_points[dof_index] = point;
+          });
       }
 
 
@@ -2301,22 +2345,25 @@ namespace DoFTools
         std::vector<Point<spacedim>> &              support_points,
         const ComponentMask &                       mask)
       {
-        // get the data in the form of the map as above
-        std::map<types::global_dof_index, Point<spacedim>> x_support_points;
-        map_dofs_to_support_points(mapping,
-                                   dof_handler,
-                                   x_support_points,
-                                   mask);
-
-        // now convert from the map to the linear vector. make sure every
-        // entry really appeared in the map
-        for (types::global_dof_index i = 0; i < dof_handler.n_dofs(); ++i)
-          {
-            Assert(x_support_points.find(i) != x_support_points.end(),
-                   ExcInternalError());
-
-            support_points[i] = x_support_points[i];
-          }
+        // write the points directly into the vector. make sure every entry
+        // really gets a value
+        std::fill(support_points.begin(),
+                  support_points.end(),
+                  Point<spacedim>());
+        std::vector<bool> dof_found(dof_handler.n_dofs(), false);
+        compute_support_points(
+          mapping,
+          dof_handler,
+          mask,
+          [&](const types::global_dof_index dof_index,
+              const Point<spacedim> &       point) {
+            support_points[dof_index] = point;
+            dof_found[dof_index]      = true;
+          });
+
+        Assert(std::find(dof_found.begin(), dof_found.end(), false) ==
+                 dof_found.end(),
+               ExcInternalError());
       }
     } // namespace
   }   // namespace internal
@@ -13,8 +13,10 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/work_stream.h>
 
@@ -334,64 +336,6 @@ namespace DoFTools
 
 
 
-      /**
-       * Make sure that the given @p face_interpolation_matrix pointer points
-       * to a valid matrix. If the pointer is zero beforehand, create an entry
-       * with the correct data. If it is nonzero, don't touch it.
-       */
-      template <int dim, int spacedim>
-      void
-      ensure_existence_of_face_matrix(
-        const FiniteElement<dim, spacedim> & fe1,
-        const FiniteElement<dim, spacedim> & fe2,
-        std::unique_ptr<FullMatrix<double>> &matrix)
-      {
-        // TODO: the implementation makes the assumption that all faces have the
-        // same number of dofs
-        AssertDimension(fe1.n_unique_faces(), 1);
-        AssertDimension(fe2.n_unique_faces(), 1);
-        const unsigned int face_no = 0;
-
-        if (matrix == nullptr)
-          {
-            matrix = std::make_unique<FullMatrix<double>>(
-              fe2.n_dofs_per_face(face_no), fe1.n_dofs_per_face(face_no));
-            fe1.get_face_interpolation_matrix(fe2, *matrix, face_no);
-          }
-      }
-
-
-
-      /**
-       * Same, but for subface interpolation matrices.
-       */
-      template <int dim, int spacedim>
-      void
-      ensure_existence_of_subface_matrix(
-        const FiniteElement<dim, spacedim> & fe1,
-        const FiniteElement<dim, spacedim> & fe2,
-        const unsigned int                   subface,
-        std::unique_ptr<FullMatrix<double>> &matrix)
-      {
-        // TODO: the implementation makes the assumption that all faces have the
-        // same number of dofs
-        AssertDimension(fe1.n_unique_faces(), 1);
-        AssertDimension(fe2.n_unique_faces(), 1);
-        const unsigned int face_no = 0;
-
-        if (matrix == nullptr)
-          {
-            matrix = std::make_unique<FullMatrix<double>>(
-              fe2.n_dofs_per_face(face_no), fe1.n_dofs_per_face(face_no));
-            fe1.get_subface_interpolation_matrix(fe2,
-                                                 subface,
-                                                 *matrix,
-                                                 face_no);
-          }
-      }
-
-
-
       /**
        * Given the face interpolation matrix between two elements, split it into
        * its primary and dependent parts and invert the primary part as
@@ -574,6 +518,22 @@ namespace DoFTools
     } // namespace
 
 
+
+    /**
+     * The constraints computed on one face, to be handed to
+     * filter_constraints() at a later time. The matrix either points to an
+     * interpolation matrix that lives longer than this object, or is stored
+     * in @p own_matrix if @p matrix is a null pointer.
+     */
+    struct FaceConstraints
+    {
+      std::vector<types::global_dof_index> primary_dofs;
+      std::vector<types::global_dof_index> dependent_dofs;
+      const FullMatrix<double> *           matrix;
+      FullMatrix<double>                   own_matrix;
+    };
+
+
     template <typename number>
     void
     make_hp_hanging_node_constraints(const dealii::DoFHandler<1> &,
@@ -1040,28 +1000,15 @@ namespace DoFTools
       // on here
 
 
-      // a matrix to be used for constraints below. declared here and simply
-      // resized down below to avoid permanent re-allocation of memory
-      FullMatrix<double> constraint_matrix;
+      const dealii::hp::FECollection<dim, spacedim> &fe_collection =
+        dof_handler.get_fe_collection();
 
-      // similarly have arrays that will hold primary and dependent dof numbers,
-      // as well as a scratch array needed for the complicated case below
-      std::vector<types::global_dof_index> primary_dofs;
-      std::vector<types::global_dof_index> dependent_dofs;
-      std::vector<types::global_dof_index> scratch_dofs;
-
-      // caches for the face and subface interpolation matrices between
-      // different (or the same) finite elements. we compute them only once,
-      // namely the first time they are needed, and then just reuse them
-      Table<2, std::unique_ptr<FullMatrix<double>>> face_interpolation_matrices(
-        n_finite_elements(dof_handler), n_finite_elements(dof_handler));
-      Table<3, std::unique_ptr<FullMatrix<double>>>
-        subface_interpolation_matrices(
-          n_finite_elements(dof_handler),
-          n_finite_elements(dof_handler),
-          GeometryInfo<dim>::max_children_per_face);
-
-      // similarly have a cache for the matrices that are split into their
+      // the face and subface interpolation matrices between different (or
+      // the same) finite elements are cached in the FECollection, which
+      // computes them the first time they are needed and keeps them for
+      // later calls of this function, e.g. in the next refinement cycle.
+      //
+      // in addition, have a cache for the matrices that are split into their
       // primary and dependent parts, and for which the primary part is
       // inverted. these two matrices are derived from the face interpolation
       // matrix
@@ -1077,17 +1024,40 @@ namespace DoFTools
       Table<2, std::unique_ptr<std::vector<bool>>> primary_dof_masks(
         n_finite_elements(dof_handler), n_finite_elements(dof_handler));
 
+      // the two caches above are filled while several threads work on the
+      // faces, so guard their creation
+      Threads::Mutex split_matrix_mutex;
+
+      // we work on the cells in parallel and first collect the constraints of
+      // each cell. they are entered into the AffineConstraints object
+      // afterwards in the order of the cells, since filter_constraints()
+      // skips DoFs already constrained from another face and the result
+      // must not depend on the scheduling of the threads
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+        cells;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        // artificial cells can at best neighbor ghost cells, but we're not
+        // interested in these interfaces
+        if (!cell->is_artificial())
+          cells.push_back(cell);
+      std::vector<std::vector<FaceConstraints>> cell_constraints(cells.size());
+
       // loop over all faces
       //
       // note that even though we may visit a face twice if the neighboring
       // cells are equally refined, we can only visit each face with hanging
       // nodes once
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        {
-          // artificial cells can at best neighbor ghost cells, but we're not
-          // interested in these interfaces
-          if (cell->is_artificial())
-            continue;
+      const auto process_cell =
+        [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+              &                           cell,
+            std::vector<FaceConstraints> &face_constraints) {
+          // a matrix to be used for constraints below, as well as arrays that
+          // will hold primary and dependent dof numbers, and a scratch array
+          // needed for the complicated case below
+          FullMatrix<double>                   constraint_matrix;
+          std::vector<types::global_dof_index> primary_dofs;
+          std::vector<types::global_dof_index> dependent_dofs;
+          std::vector<types::global_dof_index> scratch_dofs;
 
           for (const unsigned int face : cell->face_indices())
             if (cell->face(face)->has_children())
@@ -1148,8 +1118,10 @@ namespace DoFTools
                         {
                           mother_face_dominates =
                             mother_face_dominates &
-                            (cell->get_fe().compare_for_domination(
-                              subcell->get_fe(), /*codim=*/1));
+                            fe_collection.compare_for_domination(
+                              cell->active_fe_index(),
+                              subcell->active_fe_index(),
+                              /*codim=*/1);
                           fe_ind_face_subface.insert(
                             subcell->active_fe_index());
                         }
@@ -1204,8 +1176,9 @@ namespace DoFTools
                             // subface between FE_Q(1) and FE_Nothing, there are
                             // no constraints that we need to take care of. in
                             // that case, just continue
-                            if (cell->get_fe().compare_for_domination(
-                                  subface->get_fe(subface_fe_index),
+                            if (fe_collection.compare_for_domination(
+                                  cell->active_fe_index(),
+                                  subface_fe_index,
                                   /*codim=*/1) ==
                                 FiniteElementDomination::no_requirements)
                               continue;
@@ -1249,21 +1222,15 @@ namespace DoFTools
                             // and the results of those tests show that the
                             // result of projection verifies the approximation
                             // properties of a finite element onto that mesh
-                            ensure_existence_of_subface_matrix(
-                              cell->get_fe(),
-                              subface->get_fe(subface_fe_index),
-                              c,
-                              subface_interpolation_matrices
-                                [cell->active_fe_index()][subface_fe_index][c]);
-
-                            // Add constraints to global AffineConstraints
-                            // object.
-                            filter_constraints(primary_dofs,
-                                               dependent_dofs,
-                                               *(subface_interpolation_matrices
-                                                   [cell->active_fe_index()]
-                                                   [subface_fe_index][c]),
-                                               constraints);
+                            //
+                            // Record the constraints for the global
+                            // AffineConstraints object.
+                            face_constraints.push_back(
+                              {primary_dofs,
+                               dependent_dofs,
+                               &fe_collection.get_subface_interpolation_matrix(
+                                 cell->active_fe_index(), subface_fe_index, c),
+                               FullMatrix<double>()});
                           } // loop over subfaces
 
                         break;
@@ -1281,9 +1248,6 @@ namespace DoFTools
                         // dof handlers, add a check here...
                         Assert(dof_handler.has_hp_capabilities() == true,
                                ExcInternalError());
-
-                        const dealii::hp::FECollection<dim, spacedim>
-                          &fe_collection = dof_handler.get_fe_collection();
                         // we first have to find the finite element that is able
                         // to generate a space that all the other ones can be
                         // constrained to. At this point we potentially have
@@ -1327,29 +1291,28 @@ namespace DoFTools
                                  cell->get_fe().n_dofs_per_face(face),
                                ExcInternalError());
 
-                        ensure_existence_of_face_matrix(
-                          dominating_fe,
-                          cell->get_fe(),
-                          face_interpolation_matrices[dominating_fe_index]
-                                                     [cell->active_fe_index()]);
+                        const FullMatrix<double> &face_interpolation_matrix =
+                          fe_collection.get_face_interpolation_matrix(
+                            dominating_fe_index, cell->active_fe_index());
 
                         // split this matrix into primary and dependent
                         // components. invert the primary component
-                        ensure_existence_of_primary_dof_mask(
-                          cell->get_fe(),
-                          dominating_fe,
-                          (*face_interpolation_matrices
-                             [dominating_fe_index][cell->active_fe_index()]),
-                          primary_dof_masks[dominating_fe_index]
-                                           [cell->active_fe_index()]);
-
-                        ensure_existence_of_split_face_matrix(
-                          *face_interpolation_matrices[dominating_fe_index]
-                                                      [cell->active_fe_index()],
-                          (*primary_dof_masks[dominating_fe_index]
-                                             [cell->active_fe_index()]),
-                          split_face_interpolation_matrices
-                            [dominating_fe_index][cell->active_fe_index()]);
+                        {
+                          std::lock_guard<std::mutex> lock(split_matrix_mutex);
+                          ensure_existence_of_primary_dof_mask(
+                            cell->get_fe(),
+                            dominating_fe,
+                            face_interpolation_matrix,
+                            primary_dof_masks[dominating_fe_index]
+                                             [cell->active_fe_index()]);
+
+                          ensure_existence_of_split_face_matrix(
+                            face_interpolation_matrix,
+                            (*primary_dof_masks[dominating_fe_index]
+                                               [cell->active_fe_index()]),
+                            split_face_interpolation_matrices
+                              [dominating_fe_index][cell->active_fe_index()]);
+                        }
 
                         const FullMatrix<double>
                           &restrict_mother_to_virtual_primary_inv =
@@ -1400,10 +1363,10 @@ namespace DoFTools
                                         cell->get_fe().n_dofs_per_face(face) -
                                           dominating_fe.n_dofs_per_face(face));
 
-                        filter_constraints(primary_dofs,
-                                           dependent_dofs,
-                                           constraint_matrix,
-                                           constraints);
+                        face_constraints.push_back({primary_dofs,
+                                                    dependent_dofs,
+                                                    nullptr,
+                                                    constraint_matrix});
 
 
 
@@ -1438,17 +1401,10 @@ namespace DoFTools
                             Assert(dominating_fe.n_dofs_per_face(face) <=
                                      subface_fe.n_dofs_per_face(face),
                                    ExcInternalError());
-                            ensure_existence_of_subface_matrix(
-                              dominating_fe,
-                              subface_fe,
-                              sf,
-                              subface_interpolation_matrices
-                                [dominating_fe_index][subface_fe_index][sf]);
-
                             const FullMatrix<double>
-                              &restrict_subface_to_virtual = *(
-                                subface_interpolation_matrices
-                                  [dominating_fe_index][subface_fe_index][sf]);
+                              &restrict_subface_to_virtual =
+                                fe_collection.get_subface_interpolation_matrix(
+                                  dominating_fe_index, subface_fe_index, sf);
 
                             constraint_matrix.reinit(
                               subface_fe.n_dofs_per_face(face),
@@ -1463,10 +1419,10 @@ namespace DoFTools
                             cell->face(face)->child(sf)->get_dof_indices(
                               dependent_dofs, subface_fe_index);
 
-                            filter_constraints(primary_dofs,
-                                               dependent_dofs,
-                                               constraint_matrix,
-                                               constraints);
+                            face_constraints.push_back({primary_dofs,
+                                                        dependent_dofs,
+                                                        nullptr,
+                                                        constraint_matrix});
                           } // loop over subfaces
 
                         break;
@@ -1512,9 +1468,10 @@ namespace DoFTools
                       neighbor = cell->neighbor(face);
 
                     // see which side of the face we have to constrain
-                    switch (
-                      cell->get_fe().compare_for_domination(neighbor->get_fe(),
-                                                            /*codim=*/1))
+                    switch (fe_collection.compare_for_domination(
+                      cell->active_fe_index(),
+                      neighbor->active_fe_index(),
+                      /*codim=*/1))
                       {
                         case FiniteElementDomination::this_element_dominates:
                           {
@@ -1536,23 +1493,15 @@ namespace DoFTools
                             cell->face(face)->get_dof_indices(
                               dependent_dofs, neighbor->active_fe_index());
 
-                            // make sure the element constraints for this face
-                            // are available
-                            ensure_existence_of_face_matrix(
-                              cell->get_fe(),
-                              neighbor->get_fe(),
-                              face_interpolation_matrices
-                                [cell->active_fe_index()]
-                                [neighbor->active_fe_index()]);
-
-                            // Add constraints to global constraint matrix.
-                            filter_constraints(
-                              primary_dofs,
-                              dependent_dofs,
-                              *(face_interpolation_matrices
-                                  [cell->active_fe_index()]
-                                  [neighbor->active_fe_index()]),
-                              constraints);
+                            // Record constraints for the global constraint
+                            // matrix.
+                            face_constraints.push_back(
+                              {primary_dofs,
+                               dependent_dofs,
+                               &fe_collection.get_face_interpolation_matrix(
+                                 cell->active_fe_index(),
+                                 neighbor->active_fe_index()),
+                               FullMatrix<double>()});
 
                             break;
                           }
@@ -1615,8 +1564,6 @@ namespace DoFTools
                             std::set<unsigned int> fes;
                             fes.insert(this_fe_index);
                             fes.insert(neighbor_fe_index);
-                            const dealii::hp::FECollection<dim, spacedim>
-                              &fe_collection = dof_handler.get_fe_collection();
 
                             const unsigned int dominating_fe_index =
                               fe_collection.find_dominating_fe_extended(
@@ -1643,30 +1590,31 @@ namespace DoFTools
                                      cell->get_fe().n_dofs_per_face(face),
                                    ExcInternalError());
 
-                            ensure_existence_of_face_matrix(
-                              dominating_fe,
-                              cell->get_fe(),
-                              face_interpolation_matrices
-                                [dominating_fe_index][cell->active_fe_index()]);
+                            const FullMatrix<double>
+                              &face_interpolation_matrix =
+                                fe_collection.get_face_interpolation_matrix(
+                                  dominating_fe_index, cell->active_fe_index());
 
                             // split this matrix into primary and dependent
                             // components. invert the primary component
-                            ensure_existence_of_primary_dof_mask(
-                              cell->get_fe(),
-                              dominating_fe,
-                              (*face_interpolation_matrices
-                                 [dominating_fe_index]
-                                 [cell->active_fe_index()]),
-                              primary_dof_masks[dominating_fe_index]
-                                               [cell->active_fe_index()]);
-
-                            ensure_existence_of_split_face_matrix(
-                              *face_interpolation_matrices
-                                [dominating_fe_index][cell->active_fe_index()],
-                              (*primary_dof_masks[dominating_fe_index]
-                                                 [cell->active_fe_index()]),
-                              split_face_interpolation_matrices
-                                [dominating_fe_index][cell->active_fe_index()]);
+                            {
+                              std::lock_guard<std::mutex> lock(
+                                split_matrix_mutex);
+                              ensure_existence_of_primary_dof_mask(
+                                cell->get_fe(),
+                                dominating_fe,
+                                face_interpolation_matrix,
+                                primary_dof_masks[dominating_fe_index]
+                                                 [cell->active_fe_index()]);
+
+                              ensure_existence_of_split_face_matrix(
+                                face_interpolation_matrix,
+                                (*primary_dof_masks[dominating_fe_index]
+                                                   [cell->active_fe_index()]),
+                                split_face_interpolation_matrices
+                                  [dominating_fe_index]
+                                  [cell->active_fe_index()]);
+                            }
 
                             const FullMatrix<
                               double> &restrict_mother_to_virtual_primary_inv =
@@ -1718,10 +1666,10 @@ namespace DoFTools
                               cell->get_fe().n_dofs_per_face(face) -
                                 dominating_fe.n_dofs_per_face(face));
 
-                            filter_constraints(primary_dofs,
-                                               dependent_dofs,
-                                               constraint_matrix,
-                                               constraints);
+                            face_constraints.push_back({primary_dofs,
+                                                        dependent_dofs,
+                                                        nullptr,
+                                                        constraint_matrix});
 
                             // now do the same for another FE this is pretty
                             // much the same we do above to resolve h-refinement
@@ -1730,18 +1678,11 @@ namespace DoFTools
                                      neighbor->get_fe().n_dofs_per_face(face),
                                    ExcInternalError());
 
-                            ensure_existence_of_face_matrix(
-                              dominating_fe,
-                              neighbor->get_fe(),
-                              face_interpolation_matrices
-                                [dominating_fe_index]
-                                [neighbor->active_fe_index()]);
-
                             const FullMatrix<double>
                               &restrict_secondface_to_virtual =
-                                *(face_interpolation_matrices
-                                    [dominating_fe_index]
-                                    [neighbor->active_fe_index()]);
+                                fe_collection.get_face_interpolation_matrix(
+                                  dominating_fe_index,
+                                  neighbor->active_fe_index());
 
                             constraint_matrix.reinit(
                               neighbor->get_fe().n_dofs_per_face(face),
@@ -1756,10 +1697,10 @@ namespace DoFTools
                             cell->face(face)->get_dof_indices(
                               dependent_dofs, neighbor->active_fe_index());
 
-                            filter_constraints(primary_dofs,
-                                               dependent_dofs,
-                                               constraint_matrix,
-                                               constraints);
+                            face_constraints.push_back({primary_dofs,
+                                                        dependent_dofs,
+                                                        nullptr,
+                                                        constraint_matrix});
 
                             break;
                           }
@@ -1776,7 +1717,24 @@ namespace DoFTools
                       }
                   }
               }
-        }
+        };
+
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            process_cell(cells[i], cell_constraints[i]);
+        },
+        32);
+
+      for (const auto &face_constraints : cell_constraints)
+        for (const auto &entry : face_constraints)
+          filter_constraints(entry.primary_dofs,
+                             entry.dependent_dofs,
+                             entry.matrix != nullptr ? *entry.matrix :
+                                                       entry.own_matrix,
+                             constraints);
     }
   } // namespace internal
 
@@ -1812,9 +1770,107 @@ namespace DoFTools
      *
      * Internally used in make_periodicity_constraints.
      *
-     * enter constraints for periodicity into the given AffineConstraints
-     * object. this function is called when at least one of the two face
-     * iterators corresponds to an active object without further children
+     * A constraint for one degree of freedom on a periodic face as computed
+     * by compute_periodicity_constraints(). Computing these constraints does
+     * not depend on the content of the AffineConstraints object, so it can
+     * be done for many faces in parallel. Entering them with
+     * add_periodicity_constraints() then has to happen in a fixed order,
+     * since whether and how a constraint is entered depends on which
+     * degrees of freedom are already constrained.
+     */
+    template <typename number>
+    struct PeriodicityConstraint
+    {
+      /**
+       * The degree of freedom to be constrained.
+       */
+      types::global_dof_index dof;
+
+      /**
+       * For "identity constraints" of the form
+       * <code>dof == identity_factor * identity_dof</code>, the degree of
+       * freedom on the other face. numbers::invalid_dof_index otherwise.
+       */
+      types::global_dof_index identity_dof;
+
+      /**
+       * The factor of an identity constraint.
+       */
+      number identity_factor;
+
+      /**
+       * For all other constraints, the entries of the constraint.
+       */
+      std::vector<std::pair<types::global_dof_index, double>> entries;
+    };
+
+
+
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * A pair of matching faces of which at least one is active, together
+     * with the orientation and the matrix of the pair of (possibly coarser)
+     * periodic faces it was found on.
+     */
+    template <typename FaceIterator>
+    struct ActivePeriodicFacePair
+    {
+      FaceIterator              face_1;
+      FaceIterator              face_2;
+      bool                      face_orientation;
+      bool                      face_flip;
+      bool                      face_rotation;
+      const FullMatrix<double> *matrix;
+    };
+
+
+
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * Data that compute_periodicity_constraints() would otherwise compute
+     * again for every pair of faces.
+     */
+    template <int dim, int spacedim>
+    struct PeriodicityCache
+    {
+      /**
+       * The transformation computed by compute_transformation() for a
+       * finite element and the matrix of a pair of periodic faces, and its
+       * inverse (only computed if needed).
+       */
+      std::map<std::pair<const FiniteElement<dim, spacedim> *,
+                         const FullMatrix<double> *>,
+               std::pair<FullMatrix<double>, FullMatrix<double>>>
+        transformations;
+
+      /**
+       * For a finite element and an orientation, the index of the degree of
+       * freedom on the first face that matches each degree of freedom on the
+       * second face.
+       */
+      std::map<
+        std::tuple<const FiniteElement<dim, spacedim> *, bool, bool, bool>,
+        std::vector<unsigned int>>
+        rotated_face_indices;
+    };
+
+
+
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * compute the constraints for periodicity between the given faces and
+     * append them to @p constraints. this function is called when at least
+     * one of the two face iterators corresponds to an active object without
+     * further children
      *
      * @param transformation A matrix that maps degrees of freedom from one face
      * to another. If the DoFs on the two faces are supposed to match exactly,
@@ -1823,14 +1879,6 @@ namespace DoFTools
      * matrix from a face to this particular child
      *
      * @precondition: face_1 is supposed to be active
-     *
-     * @note We have to be careful not to accidentally create constraint
-     * cycles when adding periodic constraints: For example, as the
-     * corresponding testcase bits/periodicity_05 demonstrates, we can
-     * occasionally get into trouble if we already have the constraint
-     * x1 == x2 and want to insert x2 == x1. We avoid this by skipping
-     * such "identity constraints" if the opposite constraint already
-     * exists.
      */
     template <typename FaceIterator, typename number>
     void
@@ -1838,12 +1886,14 @@ namespace DoFTools
       const FaceIterator &                         face_1,
       const typename identity<FaceIterator>::type &face_2,
       const FullMatrix<double> &                   transformation,
-      AffineConstraints<number> &                  affine_constraints,
       const ComponentMask &                        component_mask,
       const bool                                   face_orientation,
       const bool                                   face_flip,
       const bool                                   face_rotation,
-      const number                                 periodicity_factor)
+      const number                                 periodicity_factor,
+      PeriodicityCache<FaceIterator::AccessorType::dimension,
+                       FaceIterator::AccessorType::space_dimension> &cache,
+      std::vector<PeriodicityConstraint<number>> &constraints)
     {
       static const int dim      = FaceIterator::AccessorType::dimension;
       static const int spacedim = FaceIterator::AccessorType::space_dimension;
@@ -1874,30 +1924,33 @@ namespace DoFTools
             face_1->get_fe(face_1->nth_active_fe_index(0))
               .n_dofs_per_face(face_no);
           FullMatrix<double> child_transformation(dofs_per_face, dofs_per_face);
-          FullMatrix<double> subface_interpolation(dofs_per_face,
-                                                   dofs_per_face);
 
           for (unsigned int c = 0; c < face_2->n_children(); ++c)
             {
               // get the interpolation matrix recursively from the one that
               // interpolated from face_1 to face_2 by multiplying from the left
-              // with the one that interpolates from face_2 to its child
-              const auto &fe = face_1->get_fe(face_1->nth_active_fe_index(0));
-              fe.get_subface_interpolation_matrix(fe,
-                                                  c,
-                                                  subface_interpolation,
-                                                  face_no);
+              // with the one that interpolates from face_2 to its child. the
+              // latter is cached by the FECollection
+              const unsigned int fe_index = face_1->nth_active_fe_index(0);
+              const FullMatrix<double> &subface_interpolation =
+                face_1->get_dof_handler()
+                  .get_fe_collection()
+                  .get_subface_interpolation_matrix(fe_index,
+                                                    fe_index,
+                                                    c,
+                                                    face_no);
               subface_interpolation.mmult(child_transformation, transformation);
 
               set_periodicity_constraints(face_1,
                                           face_2->child(c),
                                           child_transformation,
-                                          affine_constraints,
                                           component_mask,
                                           face_orientation,
                                           face_flip,
                                           face_rotation,
-                                          periodicity_factor);
+                                          periodicity_factor,
+                                          cache,
+                                          constraints);
             }
           return;
         }
@@ -1952,36 +2005,59 @@ namespace DoFTools
             return;
           }
 
-      // Well, this is a hack:
-      //
-      // There is no
-      //   face_to_face_index(face_index,
-      //                      face_orientation,
-      //                      face_flip,
-      //                      face_rotation)
-      // function in FiniteElementData, so we have to use
-      //   face_to_cell_index(face_index, face
-      //                      face_orientation,
-      //                      face_flip,
-      //                      face_rotation)
-      // But this will give us an index on a cell - something we cannot work
-      // with directly. But luckily we can match them back :-]
-
-      std::map<unsigned int, unsigned int> cell_to_rotated_face_index;
-
-      // Build up a cell to face index for face_2:
-      for (unsigned int i = 0; i < dofs_per_face; ++i)
+      // Get the index on face_1 of the dof matching each dof on face_2,
+      // respecting the given orientation. This only depends on the element
+      // and the orientation, so we compute it once and store it in the cache
+      auto rotated_face_index = cache.rotated_face_indices.find(
+        std::make_tuple(&fe, face_orientation, face_flip, face_rotation));
+      if (rotated_face_index == cache.rotated_face_indices.end())
         {
-          const unsigned int cell_index =
-            fe.face_to_cell_index(i,
-                                  0, /* It doesn't really matter, just
-                                      * assume we're on the first face...
-                                      */
-                                  true,
-                                  false,
-                                  false // default orientation
-            );
-          cell_to_rotated_face_index[cell_index] = i;
+          // Well, this is a hack:
+          //
+          // There is no
+          //   face_to_face_index(face_index,
+          //                      face_orientation,
+          //                      face_flip,
+          //                      face_rotation)
+          // function in FiniteElementData, so we have to use
+          //   face_to_cell_index(face_index, face
+          //                      face_orientation,
+          //                      face_flip,
+          //                      face_rotation)
+          // But this will give us an index on a cell - something we cannot
+          // work with directly. But luckily we can match them back :-]
+
+          std::map<unsigned int, unsigned int> cell_to_rotated_face_index;
+
+          // Build up a cell to face index for face_2:
+          for (unsigned int i = 0; i < dofs_per_face; ++i)
+            {
+              const unsigned int cell_index =
+                fe.face_to_cell_index(i,
+                                      0, /* It doesn't really matter, just
+                                          * assume we're on the first face...
+                                          */
+                                      true,
+                                      false,
+                                      false // default orientation
+                );
+              cell_to_rotated_face_index[cell_index] = i;
+            }
+
+          std::vector<unsigned int> face_indices(dofs_per_face);
+          for (unsigned int jj = 0; jj < dofs_per_face; ++jj)
+            face_indices[jj] =
+              cell_to_rotated_face_index[fe.face_to_cell_index(
+                jj, 0, face_orientation, face_flip, face_rotation)];
+
+          rotated_face_index =
+            cache.rotated_face_indices
+              .emplace(std::make_tuple(&fe,
+                                       face_orientation,
+                                       face_flip,
+                                       face_rotation),
+                       std::move(face_indices))
+              .first;
         }
 
       //
@@ -2034,49 +2110,82 @@ namespace DoFTools
                 }
             }
 
-          // Next, we work on all constraints that are not identity
-          // constraints, i.e., constraints that involve an interpolation
-          // step that constrains the current dof (on face 2) to more than
-          // one dof on face 1.
+          constraints.emplace_back();
+          PeriodicityConstraint<number> &constraint = constraints.back();
+          constraint.dof                            = dofs_2[i];
 
-          if (!is_identity_constrained)
+          if (is_identity_constrained)
+            {
+              constraint.identity_dof =
+                dofs_1[rotated_face_index->second[target]];
+              constraint.identity_factor = constraint_factor;
+            }
+          else
+            {
+              // A constraint that involves an interpolation step that
+              // constrains the current dof (on face 2) to more than one dof
+              // on face 1.
+              constraint.identity_dof    = numbers::invalid_dof_index;
+              constraint.identity_factor = number();
+              for (unsigned int jj = 0; jj < dofs_per_face; ++jj)
+                if (std::abs(transformation(i, jj)) > eps)
+                  constraint.entries.emplace_back(
+                    dofs_1[rotated_face_index->second[jj]],
+                    transformation(i, jj));
+            }
+        } /* for dofs_per_face */
+    }
+
+
+
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * Enter the constraints computed by set_periodicity_constraints() into
+     * @p affine_constraints.
+     *
+     * @note We have to be careful not to accidentally create constraint
+     * cycles when adding periodic constraints: For example, as the
+     * corresponding testcase bits/periodicity_05 demonstrates, we can
+     * occasionally get into trouble if we already have the constraint
+     * x1 == x2 and want to insert x2 == x1. We avoid this by skipping
+     * such "identity constraints" if the opposite constraint already
+     * exists.
+     */
+    template <typename number>
+    void
+    add_periodicity_constraints(
+      const std::vector<PeriodicityConstraint<number>> &constraints,
+      AffineConstraints<number> &                       affine_constraints)
+    {
+      constexpr double eps = 1.e-13;
+
+      for (const PeriodicityConstraint<number> &constraint : constraints)
+        {
+          if (constraint.identity_dof == numbers::invalid_dof_index)
             {
               // The current dof is already constrained. There is nothing
               // left to do.
-              if (affine_constraints.is_constrained(dofs_2[i]))
+              if (affine_constraints.is_constrained(constraint.dof))
                 continue;
 
               // Enter the constraint piece by piece:
-              affine_constraints.add_line(dofs_2[i]);
-
-              for (unsigned int jj = 0; jj < dofs_per_face; ++jj)
-                {
-                  // Get the correct dof index on face_1 respecting the
-                  // given orientation:
-                  const unsigned int j =
-                    cell_to_rotated_face_index[fe.face_to_cell_index(
-                      jj, 0, face_orientation, face_flip, face_rotation)];
-
-                  if (std::abs(transformation(i, jj)) > eps)
-                    affine_constraints.add_entry(dofs_2[i],
-                                                 dofs_1[j],
-                                                 transformation(i, jj));
-                }
+              affine_constraints.add_line(constraint.dof);
+              for (const auto &entry : constraint.entries)
+                affine_constraints.add_entry(constraint.dof,
+                                             entry.first,
+                                             entry.second);
 
               // Continue with next dof.
               continue;
             }
 
           // We are left with an "identity constraint".
-
-          // Get the correct dof index on face_1 respecting the given
-          // orientation:
-          const unsigned int j =
-            cell_to_rotated_face_index[fe.face_to_cell_index(
-              target, 0, face_orientation, face_flip, face_rotation)];
-
-          auto dof_left  = dofs_1[j];
-          auto dof_right = dofs_2[i];
+          auto   dof_left          = constraint.identity_dof;
+          auto   dof_right         = constraint.dof;
+          number constraint_factor = constraint.identity_factor;
 
           // If dof_left is already constrained, or dof_left < dof_right we
           // flip the order to ensure that dofs are constrained in a stable
@@ -2173,7 +2282,7 @@ namespace DoFTools
                 ExcMessage(
                   "The periodicity constraint is too large. The parameter periodicity_factor might be too large or too small."));
             }
-        } /* for dofs_per_face */
+        }
     }
 
 
@@ -2277,252 +2386,387 @@ namespace DoFTools
         }
       return transformation;
     }
-  } /*namespace*/
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * Descend into the children of the given pair of periodic faces for as
+     * long as both faces have children, and append the pairs of faces found
+     * this way to @p face_pairs.
+     */
+    template <typename FaceIterator>
+    void
+    collect_active_periodic_face_pairs(
+      const FaceIterator &                         face_1,
+      const typename identity<FaceIterator>::type &face_2,
+      const bool                                   face_orientation,
+      const bool                                   face_flip,
+      const bool                                   face_rotation,
+      const FullMatrix<double> &                   matrix,
+      const std::vector<unsigned int> &            first_vector_components,
+      std::vector<ActivePeriodicFacePair<FaceIterator>> &face_pairs)
+    {
+      // TODO: the implementation makes the assumption that all faces have the
+      // same number of dofs
+      AssertDimension(
+        face_1->get_fe(face_1->nth_active_fe_index(0)).n_unique_faces(), 1);
+      AssertDimension(
+        face_2->get_fe(face_2->nth_active_fe_index(0)).n_unique_faces(), 1);
+      const unsigned int face_no = 0;
+      (void)face_no;
 
+      static const int dim      = FaceIterator::AccessorType::dimension;
+      static const int spacedim = FaceIterator::AccessorType::space_dimension;
+      (void)spacedim;
 
-  // Low level interface:
+      Assert((dim != 1) || (face_orientation == true && face_flip == false &&
+                            face_rotation == false),
+             ExcMessage("The supplied orientation "
+                        "(face_orientation, face_flip, face_rotation) "
+                        "is invalid for 1D"));
 
+      Assert((dim != 2) || (face_orientation == true && face_rotation == false),
+             ExcMessage("The supplied orientation "
+                        "(face_orientation, face_flip, face_rotation) "
+                        "is invalid for 2D"));
 
-  template <typename FaceIterator, typename number>
-  void
-  make_periodicity_constraints(
-    const FaceIterator &                         face_1,
-    const typename identity<FaceIterator>::type &face_2,
-    AffineConstraints<number> &                  affine_constraints,
-    const ComponentMask &                        component_mask,
-    const bool                                   face_orientation,
-    const bool                                   face_flip,
-    const bool                                   face_rotation,
-    const FullMatrix<double> &                   matrix,
-    const std::vector<unsigned int> &            first_vector_components,
-    const number                                 periodicity_factor)
-  {
-    // TODO: the implementation makes the assumption that all faces have the
-    // same number of dofs
-    AssertDimension(
-      face_1->get_fe(face_1->nth_active_fe_index(0)).n_unique_faces(), 1);
-    AssertDimension(
-      face_2->get_fe(face_2->nth_active_fe_index(0)).n_unique_faces(), 1);
-    const unsigned int face_no = 0;
-
-    static const int dim      = FaceIterator::AccessorType::dimension;
-    static const int spacedim = FaceIterator::AccessorType::space_dimension;
-
-    Assert((dim != 1) || (face_orientation == true && face_flip == false &&
-                          face_rotation == false),
-           ExcMessage("The supplied orientation "
-                      "(face_orientation, face_flip, face_rotation) "
-                      "is invalid for 1D"));
-
-    Assert((dim != 2) || (face_orientation == true && face_rotation == false),
-           ExcMessage("The supplied orientation "
-                      "(face_orientation, face_flip, face_rotation) "
-                      "is invalid for 2D"));
-
-    Assert(face_1 != face_2,
-           ExcMessage("face_1 and face_2 are equal! Cannot constrain DoFs "
-                      "on the very same face"));
-
-    Assert(face_1->at_boundary() && face_2->at_boundary(),
-           ExcMessage("Faces for periodicity constraints must be on the "
-                      "boundary"));
-
-    Assert(matrix.m() == matrix.n(),
-           ExcMessage("The supplied (rotation or interpolation) matrix must "
-                      "be a square matrix"));
-
-    Assert(first_vector_components.empty() || matrix.m() == spacedim,
-           ExcMessage("first_vector_components is nonempty, so matrix must "
-                      "be a rotation matrix exactly of size spacedim"));
+      Assert(face_1 != face_2,
+             ExcMessage("face_1 and face_2 are equal! Cannot constrain DoFs "
+                        "on the very same face"));
+
+      Assert(face_1->at_boundary() && face_2->at_boundary(),
+             ExcMessage("Faces for periodicity constraints must be on the "
+                        "boundary"));
+
+      Assert(matrix.m() == matrix.n(),
+             ExcMessage("The supplied (rotation or interpolation) matrix must "
+                        "be a square matrix"));
+
+      Assert(first_vector_components.empty() || matrix.m() == spacedim,
+             ExcMessage("first_vector_components is nonempty, so matrix must "
+                        "be a rotation matrix exactly of size spacedim"));
 
 #ifdef DEBUG
-    if (!face_1->has_children())
-      {
-        Assert(face_1->n_active_fe_indices() == 1, ExcInternalError());
-        const unsigned int n_dofs_per_face =
-          face_1->get_fe(face_1->nth_active_fe_index(0))
-            .n_dofs_per_face(face_no);
-
-        Assert(matrix.m() == 0 ||
-                 (first_vector_components.empty() &&
-                  matrix.m() == n_dofs_per_face) ||
-                 (!first_vector_components.empty() && matrix.m() == spacedim),
-               ExcMessage(
-                 "The matrix must have either size 0 or spacedim "
-                 "(if first_vector_components is nonempty) "
-                 "or the size must be equal to the # of DoFs on the face "
-                 "(if first_vector_components is empty)."));
-      }
+      if (!face_1->has_children())
+        {
+          Assert(face_1->n_active_fe_indices() == 1, ExcInternalError());
+          const unsigned int n_dofs_per_face =
+            face_1->get_fe(face_1->nth_active_fe_index(0))
+              .n_dofs_per_face(face_no);
 
-    if (!face_2->has_children())
-      {
-        Assert(face_2->n_active_fe_indices() == 1, ExcInternalError());
-        const unsigned int n_dofs_per_face =
-          face_2->get_fe(face_2->nth_active_fe_index(0))
-            .n_dofs_per_face(face_no);
-
-        Assert(matrix.m() == 0 ||
-                 (first_vector_components.empty() &&
-                  matrix.m() == n_dofs_per_face) ||
-                 (!first_vector_components.empty() && matrix.m() == spacedim),
-               ExcMessage(
-                 "The matrix must have either size 0 or spacedim "
-                 "(if first_vector_components is nonempty) "
-                 "or the size must be equal to the # of DoFs on the face "
-                 "(if first_vector_components is empty)."));
-      }
+          Assert(matrix.m() == 0 ||
+                   (first_vector_components.empty() &&
+                    matrix.m() == n_dofs_per_face) ||
+                   (!first_vector_components.empty() &&
+                    matrix.m() == spacedim),
+                 ExcMessage(
+                   "The matrix must have either size 0 or spacedim "
+                   "(if first_vector_components is nonempty) "
+                   "or the size must be equal to the # of DoFs on the face "
+                   "(if first_vector_components is empty)."));
+        }
+
+      if (!face_2->has_children())
+        {
+          Assert(face_2->n_active_fe_indices() == 1, ExcInternalError());
+          const unsigned int n_dofs_per_face =
+            face_2->get_fe(face_2->nth_active_fe_index(0))
+              .n_dofs_per_face(face_no);
+
+          Assert(matrix.m() == 0 ||
+                   (first_vector_components.empty() &&
+                    matrix.m() == n_dofs_per_face) ||
+                   (!first_vector_components.empty() &&
+                    matrix.m() == spacedim),
+                 ExcMessage(
+                   "The matrix must have either size 0 or spacedim "
+                   "(if first_vector_components is nonempty) "
+                   "or the size must be equal to the # of DoFs on the face "
+                   "(if first_vector_components is empty)."));
+        }
 #endif
 
-    // A lookup table on how to go through the child faces depending on the
-    // orientation:
+      // A lookup table on how to go through the child faces depending on the
+      // orientation:
 
-    static const int lookup_table_2d[2][2] = {
-      //          flip:
-      {0, 1}, //  false
-      {1, 0}, //  true
-    };
+      static const int lookup_table_2d[2][2] = {
+        //          flip:
+        {0, 1}, //  false
+        {1, 0}, //  true
+      };
 
-    static const int lookup_table_3d[2][2][2][4] = {
-      //                    orientation flip  rotation
-      {
+      static const int lookup_table_3d[2][2][2][4] = {
+        //                    orientation flip  rotation
         {
-          {0, 2, 1, 3}, //  false       false false
-          {2, 3, 0, 1}, //  false       false true
+          {
+            {0, 2, 1, 3}, //  false       false false
+            {2, 3, 0, 1}, //  false       false true
+          },
+          {
+            {3, 1, 2, 0}, //  false       true  false
+            {1, 0, 3, 2}, //  false       true  true
+          },
         },
         {
-          {3, 1, 2, 0}, //  false       true  false
-          {1, 0, 3, 2}, //  false       true  true
-        },
-      },
-      {
-        {
-          {0, 1, 2, 3}, //  true        false false
-          {1, 3, 0, 2}, //  true        false true
+          {
+            {0, 1, 2, 3}, //  true        false false
+            {1, 3, 0, 2}, //  true        false true
+          },
+          {
+            {3, 2, 1, 0}, //  true        true  false
+            {2, 0, 3, 1}, //  true        true  true
+          },
         },
+      };
+
+      if (face_1->has_children() && face_2->has_children())
         {
-          {3, 2, 1, 0}, //  true        true  false
-          {2, 0, 3, 1}, //  true        true  true
-        },
-      },
-    };
+          // In the case that both faces have children, we loop over all
+          // children and collect the pairs recursively:
 
-    if (face_1->has_children() && face_2->has_children())
-      {
-        // In the case that both faces have children, we loop over all children
-        // and apply make_periodicty_constrains recursively:
+          Assert(face_1->n_children() ==
+                     GeometryInfo<dim>::max_children_per_face &&
+                   face_2->n_children() ==
+                     GeometryInfo<dim>::max_children_per_face,
+                 ExcNotImplemented());
 
-        Assert(face_1->n_children() ==
-                   GeometryInfo<dim>::max_children_per_face &&
-                 face_2->n_children() ==
-                   GeometryInfo<dim>::max_children_per_face,
-               ExcNotImplemented());
+          for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face;
+               ++i)
+            {
+              // Lookup the index for the second face
+              unsigned int j;
+              switch (dim)
+                {
+                  case 2:
+                    j = lookup_table_2d[face_flip][i];
+                    break;
+                  case 3:
+                    j = lookup_table_3d[face_orientation][face_flip]
+                                       [face_rotation][i];
+                    break;
+                  default:
+                    AssertThrow(false, ExcNotImplemented());
+                }
 
-        for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face;
-             ++i)
-          {
-            // Lookup the index for the second face
-            unsigned int j;
-            switch (dim)
-              {
-                case 2:
-                  j = lookup_table_2d[face_flip][i];
-                  break;
-                case 3:
-                  j = lookup_table_3d[face_orientation][face_flip]
-                                     [face_rotation][i];
-                  break;
-                default:
-                  AssertThrow(false, ExcNotImplemented());
-              }
+              collect_active_periodic_face_pairs(face_1->child(i),
+                                                 face_2->child(j),
+                                                 face_orientation,
+                                                 face_flip,
+                                                 face_rotation,
+                                                 matrix,
+                                                 first_vector_components,
+                                                 face_pairs);
+            }
+        }
+      else
+        face_pairs.push_back(ActivePeriodicFacePair<FaceIterator>{
+          face_1, face_2, face_orientation, face_flip, face_rotation, &matrix});
+    }
 
-            make_periodicity_constraints(face_1->child(i),
-                                         face_2->child(j),
-                                         affine_constraints,
-                                         component_mask,
-                                         face_orientation,
-                                         face_flip,
-                                         face_rotation,
-                                         matrix,
-                                         first_vector_components,
-                                         periodicity_factor);
-          }
-      }
-    else
-      {
-        // Otherwise at least one of the two faces is active and we need to do
-        // some work and enter the constraints!
 
-        // The finite element that matters is the one on the active face:
-        const FiniteElement<dim, spacedim> &fe =
-          face_1->has_children() ?
-            face_2->get_fe(face_2->nth_active_fe_index(0)) :
-            face_1->get_fe(face_1->nth_active_fe_index(0));
 
-        const unsigned int n_dofs_per_face = fe.n_dofs_per_face(face_no);
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * Compute the constraints for a pair of faces of which at least one is
+     * active and append them to @p constraints.
+     */
+    template <typename FaceIterator, typename number>
+    void
+    compute_periodicity_constraints(
+      const ActivePeriodicFacePair<FaceIterator> &face_pair,
+      const ComponentMask &                       component_mask,
+      const std::vector<unsigned int> &           first_vector_components,
+      const number                                periodicity_factor,
+      PeriodicityCache<FaceIterator::AccessorType::dimension,
+                       FaceIterator::AccessorType::space_dimension> &cache,
+      std::vector<PeriodicityConstraint<number>> &constraints)
+    {
+      static const int dim      = FaceIterator::AccessorType::dimension;
+      static const int spacedim = FaceIterator::AccessorType::space_dimension;
 
-        // Sometimes we just have nothing to do (for all finite elements, or
-        // systems which accidentally don't have any dofs on the boundary).
-        if (n_dofs_per_face == 0)
-          return;
+      const FaceIterator &      face_1           = face_pair.face_1;
+      const FaceIterator &      face_2           = face_pair.face_2;
+      const bool                face_orientation = face_pair.face_orientation;
+      const bool                face_flip        = face_pair.face_flip;
+      const bool                face_rotation    = face_pair.face_rotation;
+      const FullMatrix<double> &matrix           = *face_pair.matrix;
 
-        const FullMatrix<double> transformation =
-          compute_transformation(fe, matrix, first_vector_components);
+      // The finite element that matters is the one on the active face:
+      const FiniteElement<dim, spacedim> &fe =
+        face_1->has_children() ?
+          face_2->get_fe(face_2->nth_active_fe_index(0)) :
+          face_1->get_fe(face_1->nth_active_fe_index(0));
 
-        if (!face_2->has_children())
-          {
-            // Performance hack: We do not need to compute an inverse if the
-            // matrix is the identity matrix.
-            if (first_vector_components.empty() && matrix.m() == 0)
-              {
-                set_periodicity_constraints(face_2,
-                                            face_1,
-                                            transformation,
-                                            affine_constraints,
-                                            component_mask,
-                                            face_orientation,
-                                            face_flip,
-                                            face_rotation,
-                                            periodicity_factor);
-              }
-            else
-              {
-                FullMatrix<double> inverse(transformation.m());
-                inverse.invert(transformation);
+      // TODO: the implementation makes the assumption that all faces have the
+      // same number of dofs
+      const unsigned int n_dofs_per_face = fe.n_dofs_per_face(0);
+
+      // Sometimes we just have nothing to do (for all finite elements, or
+      // systems which accidentally don't have any dofs on the boundary).
+      if (n_dofs_per_face == 0)
+        return;
+
+      // The transformation only depends on the element and the matrix of the
+      // periodic face pair, so compute it once and store it in the cache
+      auto transformations =
+        cache.transformations.find(std::make_pair(&fe, face_pair.matrix));
+      if (transformations == cache.transformations.end())
+        transformations =
+          cache.transformations
+            .emplace(std::make_pair(&fe, face_pair.matrix),
+                     std::make_pair(compute_transformation(
+                                      fe, matrix, first_vector_components),
+                                    FullMatrix<double>()))
+            .first;
+      const FullMatrix<double> &transformation =
+        transformations->second.first;
+
+      if (!face_2->has_children())
+        {
+          // Performance hack: We do not need to compute an inverse if the
+          // matrix is the identity matrix.
+          if (first_vector_components.empty() && matrix.m() == 0)
+            {
+              set_periodicity_constraints(face_2,
+                                          face_1,
+                                          transformation,
+                                          component_mask,
+                                          face_orientation,
+                                          face_flip,
+                                          face_rotation,
+                                          periodicity_factor,
+                                          cache,
+                                          constraints);
+            }
+          else
+            {
+              FullMatrix<double> &inverse = transformations->second.second;
+              if (inverse.m() == 0)
+                {
+                  inverse.reinit(transformation.m(), transformation.m());
+                  inverse.invert(transformation);
+                }
 
-                set_periodicity_constraints(face_2,
-                                            face_1,
-                                            inverse,
-                                            affine_constraints,
-                                            component_mask,
-                                            face_orientation,
-                                            face_flip,
-                                            face_rotation,
-                                            periodicity_factor);
-              }
-          }
-        else
-          {
-            Assert(!face_1->has_children(), ExcInternalError());
-
-            // Important note:
-            // In 3D we have to take care of the fact that face_rotation gives
-            // the relative rotation of face_1 to face_2, i.e. we have to invert
-            // the rotation when constraining face_2 to face_1. Therefore
-            // face_flip has to be toggled if face_rotation is true: In case of
-            // inverted orientation, nothing has to be done.
-            set_periodicity_constraints(face_1,
-                                        face_2,
-                                        transformation,
-                                        affine_constraints,
-                                        component_mask,
-                                        face_orientation,
-                                        face_orientation ?
-                                          face_rotation ^ face_flip :
+              set_periodicity_constraints(face_2,
+                                          face_1,
+                                          inverse,
+                                          component_mask,
+                                          face_orientation,
                                           face_flip,
-                                        face_rotation,
-                                        periodicity_factor);
-          }
-      }
+                                          face_rotation,
+                                          periodicity_factor,
+                                          cache,
+                                          constraints);
+            }
+        }
+      else
+        {
+          Assert(!face_1->has_children(), ExcInternalError());
+
+          // Important note:
+          // In 3D we have to take care of the fact that face_rotation gives
+          // the relative rotation of face_1 to face_2, i.e. we have to invert
+          // the rotation when constraining face_2 to face_1. Therefore
+          // face_flip has to be toggled if face_rotation is true: In case of
+          // inverted orientation, nothing has to be done.
+          set_periodicity_constraints(face_1,
+                                      face_2,
+                                      transformation,
+                                      component_mask,
+                                      face_orientation,
+                                      face_orientation ?
+                                        face_rotation ^ face_flip :
+                                        face_flip,
+                                      face_rotation,
+                                      periodicity_factor,
+                                      cache,
+                                      constraints);
+        }
+    }
+
+
+
+    /**
+     * @internal
+     *
+     * Internally used in make_periodicity_constraints.
+     *
+     * Compute the constraints for all the given pairs of faces in parallel
+     * and then enter them into @p affine_constraints in the order of the
+     * pairs.
+     */
+    template <typename FaceIterator, typename number>
+    void
+    make_periodicity_constraints_on_face_pairs(
+      const std::vector<ActivePeriodicFacePair<FaceIterator>> &face_pairs,
+      AffineConstraints<number> &      affine_constraints,
+      const ComponentMask &            component_mask,
+      const std::vector<unsigned int> &first_vector_components,
+      const number                     periodicity_factor)
+    {
+      std::vector<std::vector<PeriodicityConstraint<number>>> constraints(
+        face_pairs.size());
+
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        face_pairs.size(),
+        [&](const std::size_t begin, const std::size_t end) {
+          PeriodicityCache<FaceIterator::AccessorType::dimension,
+                           FaceIterator::AccessorType::space_dimension>
+            cache;
+          for (std::size_t i = begin; i < end; ++i)
+            compute_periodicity_constraints(face_pairs[i],
+                                            component_mask,
+                                            first_vector_components,
+                                            periodicity_factor,
+                                            cache,
+                                            constraints[i]);
+        },
+        32);
+
+      for (const std::vector<PeriodicityConstraint<number>> &face_constraints :
+           constraints)
+        add_periodicity_constraints(face_constraints, affine_constraints);
+    }
+  } /*namespace*/
+
+
+  // Low level interface:
+
+
+  template <typename FaceIterator, typename number>
+  void
+  make_periodicity_constraints(
+    const FaceIterator &                         face_1,
+    const typename identity<FaceIterator>::type &face_2,
+    AffineConstraints<number> &                  affine_constraints,
+    const ComponentMask &                        component_mask,
+    const bool                                   face_orientation,
+    const bool                                   face_flip,
+    const bool                                   face_rotation,
+    const FullMatrix<double> &                   matrix,
+    const std::vector<unsigned int> &            first_vector_components,
+    const number                                 periodicity_factor)
+  {
+    std::vector<ActivePeriodicFacePair<FaceIterator>> face_pairs;
+    collect_active_periodic_face_pairs(face_1,
+                                       face_2,
+                                       face_orientation,
+                                       face_flip,
+                                       face_rotation,
+                                       matrix,
+                                       first_vector_components,
+                                       face_pairs);
+
+    make_periodicity_constraints_on_face_pairs(face_pairs,
+                                               affine_constraints,
+                                               component_mask,
+                                               first_vector_components,
+                                               periodicity_factor);
   }
 
 
@@ -2537,10 +2781,13 @@ namespace DoFTools
     const std::vector<unsigned int> &first_vector_components,
     const number                     periodicity_factor)
   {
-    // Loop over all periodic faces...
+    using FaceIterator = typename DoFHandler<dim, spacedim>::face_iterator;
+
+    // Collect the pairs of matching faces of which at least one is active
+    // from all periodic faces...
+    std::vector<ActivePeriodicFacePair<FaceIterator>> face_pairs;
     for (auto &pair : periodic_faces)
       {
-        using FaceIterator = typename DoFHandler<dim, spacedim>::face_iterator;
         const FaceIterator face_1 = pair.cell[0]->face(pair.face_idx[0]);
         const FaceIterator face_2 = pair.cell[1]->face(pair.face_idx[1]);
 
@@ -2549,19 +2796,22 @@ namespace DoFTools
 
         Assert(face_1 != face_2, ExcInternalError());
 
-        // ... and apply the low level make_periodicity_constraints function to
-        // every matching pair:
-        make_periodicity_constraints(face_1,
-                                     face_2,
-                                     constraints,
-                                     component_mask,
-                                     pair.orientation[0],
-                                     pair.orientation[1],
-                                     pair.orientation[2],
-                                     pair.matrix,
-                                     first_vector_components,
-                                     periodicity_factor);
+        collect_active_periodic_face_pairs(face_1,
+                                           face_2,
+                                           pair.orientation[0],
+                                           pair.orientation[1],
+                                           pair.orientation[2],
+                                           pair.matrix,
+                                           first_vector_components,
+                                           face_pairs);
       }
+
+    // ... and compute and enter the constraints for all of them:
+    make_periodicity_constraints_on_face_pairs(face_pairs,
+                                               constraints,
+                                               component_mask,
+                                               first_vector_components,
+                                               periodicity_factor);
   }
 
 
@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -40,6 +41,7 @@
 
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/chunk_sparsity_pattern.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/trilinos_sparsity_pattern.h>
@@ -48,6 +50,7 @@
 #include <deal.II/numerics/vector_tools.h>
 
 #include <algorithm>
+#include <mutex>
 #include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
@@ -117,6 +120,338 @@ namespace DoFTools
 
 
 
+  namespace internal
+  {
+    // the number of consecutive rows that share a lock while the lists of
+    // objects contributing to each row are set up in
+    // make_compressed_pattern(). Similar to the buckets used for the
+    // connectivity in MatrixFree, this keeps the number of locks at a
+    // reasonable level while making contention rare
+    static constexpr unsigned int row_block_size = 256;
+
+    // the number of objects whose data is stored in one contiguous chunk
+    static constexpr unsigned int cells_per_chunk = 128;
+
+    // the degrees of freedom of the objects of one chunk, with the
+    // constraints already resolved. For each object, three sorted lists are
+    // stored back to back: the indices of the rows (and columns) that get
+    // entries after resolving the constraints, and, only in case the
+    // entries of constrained degrees of freedom are kept and the object has
+    // some, the degrees of freedom of the object and the subset of those
+    // that are constrained
+    struct CellDoFChunk
+    {
+      std::vector<types::global_dof_index> indices;
+      std::vector<unsigned int>            offsets;
+    };
+
+    // the roles in which a row can be affected by an object, see above
+    enum CellDoFList : unsigned int
+    {
+      resolved_dofs    = 0,
+      cell_dofs        = 1,
+      constrained_dofs = 2
+    };
+
+    // call the given function for each of the sorted indices in the range
+    // [begin, end), while holding the lock of the block of rows the index
+    // belongs to. Since the indices are sorted, all indices within one
+    // block are processed under the same lock
+    template <typename Function>
+    void
+    apply_with_row_locks(const types::global_dof_index *begin,
+                         const types::global_dof_index *end,
+                         std::vector<std::mutex> &      mutexes,
+                         const Function &               function)
+    {
+      while (begin != end)
+        {
+          const types::global_dof_index block = *begin / row_block_size;
+          std::lock_guard<std::mutex>   lock(mutexes[block]);
+          for (; begin != end && *begin / row_block_size == block; ++begin)
+            function(*begin);
+        }
+    }
+
+
+
+    // Set up the sparsity pattern of a matrix in which each of @p n_objects
+    // objects couples all of its degrees of freedom with each other, in the
+    // same way as AffineConstraints::add_entries_local_to_global() does for
+    // the degrees of freedom of one cell. The objects are typically cells,
+    // but may also be pairs of cells sharing a face; @p get_dof_indices
+    // fills the given vector with the degrees of freedom of the object with
+    // the given number.
+    //
+    // If @p chunk_size is larger than one, the pattern is built for the
+    // chunks of @p chunk_size consecutive rows and columns instead, as
+    // needed by ChunkSparsityPattern::create_from()
+    template <typename number, typename DoFIndicesFunction>
+    void
+    make_compressed_pattern(const types::global_dof_index    n_dofs,
+                            const unsigned int               n_objects,
+                            const DoFIndicesFunction &       get_dof_indices,
+                            const AffineConstraints<number> &constraints,
+                            const bool         keep_constrained_dofs,
+                            const unsigned int chunk_size,
+                            SparsityPattern &  sparsity)
+    {
+      Assert(chunk_size > 0, ExcMessage("The chunk size must be positive."));
+
+      const unsigned int n_chunks =
+        (n_objects + cells_per_chunk - 1) / cells_per_chunk;
+      std::vector<CellDoFChunk> chunks(n_chunks);
+
+      // Pass 1a: collect the degrees of freedom of all objects and resolve
+      // the constraints, in the same way as
+      // AffineConstraints::add_entries_local_to_global() does
+      dealii::parallel::apply_to_subranges(
+        0U,
+        n_chunks,
+        [&](const unsigned int begin, const unsigned int end) {
+          std::vector<types::global_dof_index> dof_indices;
+          for (unsigned int c = begin; c < end; ++c)
+            {
+              CellDoFChunk &chunk = chunks[c];
+              chunk.offsets.push_back(0);
+              for (unsigned int i = c * cells_per_chunk;
+                   i < std::min((c + 1) * cells_per_chunk, n_objects);
+                   ++i)
+                {
+                  get_dof_indices(i, dof_indices);
+
+                  const std::size_t start = chunk.indices.size();
+                  bool              has_constraints = false;
+                  for (const types::global_dof_index index : dof_indices)
+                    if (constraints.is_constrained(index))
+                      {
+                        has_constraints = true;
+                        for (const auto &entry :
+                             *constraints.get_constraint_entries(index))
+                          chunk.indices.push_back(entry.first);
+                      }
+                    else
+                      chunk.indices.push_back(index);
+                  std::sort(chunk.indices.begin() + start,
+                            chunk.indices.end());
+                  chunk.indices.erase(
+                    std::unique(chunk.indices.begin() + start,
+                                chunk.indices.end()),
+                    chunk.indices.end());
+                  chunk.offsets.push_back(chunk.indices.size());
+
+                  const std::size_t start_cell_dofs = chunk.indices.size();
+                  if (keep_constrained_dofs && has_constraints)
+                    {
+                      chunk.indices.insert(chunk.indices.end(),
+                                           dof_indices.begin(),
+                                           dof_indices.end());
+                      std::sort(chunk.indices.begin() + start_cell_dofs,
+                                chunk.indices.end());
+                      chunk.indices.erase(
+                        std::unique(chunk.indices.begin() + start_cell_dofs,
+                                    chunk.indices.end()),
+                        chunk.indices.end());
+                    }
+                  chunk.offsets.push_back(chunk.indices.size());
+
+                  if (keep_constrained_dofs && has_constraints)
+                    for (std::size_t j = start_cell_dofs;
+                         j < chunk.offsets.back();
+                         ++j)
+                      if (constraints.is_constrained(chunk.indices[j]))
+                        chunk.indices.push_back(chunk.indices[j]);
+                  chunk.offsets.push_back(chunk.indices.size());
+                }
+            }
+        },
+        1);
+
+      // Pass 1b: set up the list of objects that affect each row, together
+      // with the role through which they do, by first counting and then
+      // filling the lists. The entries encode the object number and the
+      // role as 3 * object + role
+      std::vector<std::mutex>   mutexes(n_dofs / row_block_size + 1);
+      std::vector<unsigned int> counts(n_dofs);
+      const auto                for_each_row_of_chunk =
+        [&](const unsigned int chunk_index, const auto &function) {
+          const CellDoFChunk &chunk = chunks[chunk_index];
+          for (unsigned int i = 0; 3 * i + 1 < chunk.offsets.size(); ++i)
+            for (unsigned int role = 0; role < 3; ++role)
+              apply_with_row_locks(
+                chunk.indices.data() + chunk.offsets[3 * i + role],
+                chunk.indices.data() + chunk.offsets[3 * i + role + 1],
+                mutexes,
+                [&](const types::global_dof_index row) {
+                  function(row,
+                           3 * (std::size_t(chunk_index) * cells_per_chunk +
+                                i) +
+                             role);
+                });
+        };
+
+      dealii::parallel::apply_to_subranges(
+        0U,
+        n_chunks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int c = begin; c < end; ++c)
+            for_each_row_of_chunk(c,
+                                  [&](const types::global_dof_index row,
+                                      const std::size_t) { ++counts[row]; });
+        },
+        1);
+
+      std::vector<std::size_t> row_starts(n_dofs + 1);
+      for (types::global_dof_index row = 0; row < n_dofs; ++row)
+        {
+          row_starts[row + 1] = row_starts[row] + counts[row];
+          counts[row]         = 0;
+        }
+      std::vector<std::size_t> cells_of_rows(row_starts.back());
+
+      dealii::parallel::apply_to_subranges(
+        0U,
+        n_chunks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int c = begin; c < end; ++c)
+            for_each_row_of_chunk(c,
+                                  [&](const types::global_dof_index row,
+                                      const std::size_t             entry) {
+                                    cells_of_rows[row_starts[row] +
+                                                  counts[row]++] = entry;
+                                  });
+        },
+        1);
+
+      // Pass 2: the rows are now independent of each other. Collect the
+      // column indices of each row from the objects affecting it: an object
+      // adds its resolved degrees of freedom to the rows of its resolved
+      // degrees of freedom, its constrained degrees of freedom to the rows
+      // of all its degrees of freedom, and vice versa. For chunked patterns,
+      // the columns of all rows of a chunk are merged and mapped to chunk
+      // indices. We do this twice, once to get the exact row lengths and
+      // once to fill the allocated pattern
+      const types::global_dof_index n_rows =
+        (n_dofs + chunk_size - 1) / chunk_size;
+      const auto collect_row =
+        [&](const types::global_dof_index         chunk_row,
+            std::vector<types::global_dof_index> &columns) {
+          columns.clear();
+          columns.push_back(chunk_row);
+          for (types::global_dof_index row = chunk_row * chunk_size;
+               row < std::min<types::global_dof_index>((chunk_row + 1) *
+                                                         chunk_size,
+                                                       n_dofs);
+               ++row)
+            for (std::size_t k = row_starts[row]; k < row_starts[row + 1];
+                 ++k)
+              {
+                const std::size_t   cell  = cells_of_rows[k] / 3;
+                const unsigned int  role  = cells_of_rows[k] % 3;
+                const CellDoFChunk &chunk = chunks[cell / cells_per_chunk];
+                const unsigned int  list =
+                  3 * (cell % cells_per_chunk) +
+                  (role == resolved_dofs ?
+                     resolved_dofs :
+                     (role == cell_dofs ? constrained_dofs : cell_dofs));
+                const auto begin =
+                  chunk.indices.begin() + chunk.offsets[list];
+                const auto end =
+                  chunk.indices.begin() + chunk.offsets[list + 1];
+                if (chunk_size == 1)
+                  columns.insert(columns.end(), begin, end);
+                else
+                  for (auto it = begin; it != end; ++it)
+                    if (columns.back() != *it / chunk_size)
+                      columns.push_back(*it / chunk_size);
+              }
+          std::sort(columns.begin(), columns.end());
+          columns.erase(std::unique(columns.begin(), columns.end()),
+                        columns.end());
+        };
+
+      std::vector<unsigned int> row_lengths(n_rows);
+      dealii::parallel::apply_to_subranges(
+        types::global_dof_index(0),
+        n_rows,
+        [&](const types::global_dof_index begin,
+            const types::global_dof_index end) {
+          std::vector<types::global_dof_index> columns;
+          for (types::global_dof_index row = begin; row < end; ++row)
+            {
+              collect_row(row, columns);
+              row_lengths[row] = columns.size();
+            }
+        },
+        row_block_size);
+
+      sparsity.reinit(n_rows, n_rows, row_lengths);
+
+      dealii::parallel::apply_to_subranges(
+        types::global_dof_index(0),
+        n_rows,
+        [&](const types::global_dof_index begin,
+            const types::global_dof_index end) {
+          std::vector<types::global_dof_index> columns;
+          for (types::global_dof_index row = begin; row < end; ++row)
+            {
+              collect_row(row, columns);
+              sparsity.add_entries(row, columns.begin(), columns.end(), true);
+            }
+        },
+        row_block_size);
+
+      // all the allocated entries are used, so this only marks the pattern
+      // as compressed without copying it
+      sparsity.compress();
+    }
+  } // namespace internal
+
+
+
+  template <int dim, int spacedim, typename number>
+  void
+  make_compressed_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof,
+    SparsityPattern &                sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    Assert((dof.get_triangulation().locally_owned_subdomain() ==
+            numbers::invalid_subdomain_id) ||
+             (subdomain_id == numbers::invalid_subdomain_id) ||
+             (subdomain_id ==
+              dof.get_triangulation().locally_owned_subdomain()),
+           ExcMessage(
+             "For parallel::distributed::Triangulation objects and "
+             "associated DoF handler objects, asking for any subdomain other "
+             "than the locally owned one does not make sense."));
+
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+      cells;
+    for (const auto &cell : dof.active_cell_iterators())
+      if (((subdomain_id == numbers::invalid_subdomain_id) ||
+           (subdomain_id == cell->subdomain_id())) &&
+          cell->is_locally_owned())
+        cells.push_back(cell);
+
+    internal::make_compressed_pattern(
+      dof.n_dofs(),
+      cells.size(),
+      [&](const unsigned int                    i,
+          std::vector<types::global_dof_index> &dof_indices) {
+        dof_indices.resize(cells[i]->get_fe().n_dofs_per_cell());
+        cells[i]->get_dof_indices(dof_indices);
+      },
+      constraints,
+      keep_constrained_dofs,
+      1,
+      sparsity);
+  }
+
+
+
   template <int dim,
             int spacedim,
             typename SparsityPatternType,
@@ -703,6 +1038,156 @@ namespace DoFTools
     make_flux_sparsity_pattern(dof, sparsity, dummy);
   }
 
+
+
+  namespace internal
+  {
+    // the work of both make_compressed_flux_sparsity_pattern() functions,
+    // with @p chunk_size equal to one for the non-chunked one
+    template <int dim, int spacedim, typename number>
+    void
+    make_compressed_flux_pattern(
+      const DoFHandler<dim, spacedim> &dof,
+      const AffineConstraints<number> &constraints,
+      const bool                       keep_constrained_dofs,
+      const types::subdomain_id        subdomain_id,
+      const unsigned int               chunk_size,
+      SparsityPattern &                sparsity)
+    {
+      Assert((dof.get_triangulation().locally_owned_subdomain() ==
+              numbers::invalid_subdomain_id) ||
+               (subdomain_id == numbers::invalid_subdomain_id) ||
+               (subdomain_id ==
+                dof.get_triangulation().locally_owned_subdomain()),
+             ExcMessage(
+               "For parallel::distributed::Triangulation objects and "
+               "associated DoF handler objects, asking for any subdomain other "
+               "than the locally owned one does not make sense."));
+
+      using cell_iterator =
+        typename DoFHandler<dim, spacedim>::level_cell_iterator;
+
+      // The objects whose degrees of freedom couple: each locally owned cell
+      // on its own (stored with dof.end() as second entry), and each pair of
+      // cells sharing a face, exactly once. Since the couplings between the
+      // degrees of freedom of two neighbors include the couplings within
+      // both cells, the pair also takes care of neighbors we do not own, as
+      // make_flux_sparsity_pattern() does. Faces between two cells we own are
+      // handled from the coarser cell, or from the one with the smaller index
+      // if both are on the same level. Faces to cells of other subdomains are
+      // handled from both sides, since the other side might not be visited
+      std::vector<std::pair<cell_iterator, cell_iterator>> objects;
+      for (const auto &cell : dof.active_cell_iterators())
+        if (((subdomain_id == numbers::invalid_subdomain_id) ||
+             (subdomain_id == cell->subdomain_id())) &&
+            cell->is_locally_owned())
+          {
+            objects.emplace_back(cell, dof.end());
+
+            for (const unsigned int face : cell->face_indices())
+              {
+                const bool periodic_neighbor =
+                  cell->has_periodic_neighbor(face);
+                if (cell->at_boundary(face) && !periodic_neighbor)
+                  continue;
+
+                cell_iterator neighbor =
+                  cell->neighbor_or_periodic_neighbor(face);
+                const bool neighbor_is_finer = !neighbor->is_active();
+
+                // see make_flux_sparsity_pattern()
+                if (dim == 1)
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                if (neighbor->has_children())
+                  {
+                    for (unsigned int sub_nr = 0;
+                         sub_nr != cell->face(face)->number_of_children();
+                         ++sub_nr)
+                      objects.emplace_back(
+                        cell,
+                        periodic_neighbor ?
+                          cell->periodic_neighbor_child_on_subface(face,
+                                                                   sub_nr) :
+                          cell->neighbor_child_on_subface(face, sub_nr));
+                  }
+                else if (neighbor->subdomain_id() != cell->subdomain_id() ||
+                         neighbor_is_finer ||
+                         (!(periodic_neighbor ?
+                              cell->periodic_neighbor_is_coarser(face) :
+                              cell->neighbor_is_coarser(face)) &&
+                          cell->index() < neighbor->index()))
+                  objects.emplace_back(cell, neighbor);
+              }
+          }
+
+      make_compressed_pattern(
+        dof.n_dofs(),
+        objects.size(),
+        [&](const unsigned int                    i,
+            std::vector<types::global_dof_index> &dof_indices) {
+          const cell_iterator &cell     = objects[i].first;
+          const cell_iterator &neighbor = objects[i].second;
+          dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+          cell->get_dof_indices(dof_indices);
+          if (neighbor != dof.end())
+            {
+              std::vector<types::global_dof_index> neighbor_dofs(
+                neighbor->get_fe().n_dofs_per_cell());
+              neighbor->get_dof_indices(neighbor_dofs);
+              dof_indices.insert(dof_indices.end(),
+                                 neighbor_dofs.begin(),
+                                 neighbor_dofs.end());
+            }
+        },
+        constraints,
+        keep_constrained_dofs,
+        chunk_size,
+        sparsity);
+    }
+  } // namespace internal
+
+
+
+  template <int dim, int spacedim, typename number>
+  void
+  make_compressed_flux_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof,
+    SparsityPattern &                sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    internal::make_compressed_flux_pattern(
+      dof, constraints, keep_constrained_dofs, subdomain_id, 1, sparsity);
+  }
+
+
+
+  template <int dim, int spacedim, typename number>
+  void
+  make_compressed_flux_sparsity_pattern(
+    const DoFHandler<dim, spacedim> &dof,
+    ChunkSparsityPattern &           sparsity,
+    const unsigned int               chunk_size,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    SparsityPattern chunk_sparsity;
+    internal::make_compressed_flux_pattern(dof,
+                                           constraints,
+                                           keep_constrained_dofs,
+                                           subdomain_id,
+                                           chunk_size,
+                                           chunk_sparsity);
+    sparsity.create_from(dof.n_dofs(),
+                         dof.n_dofs(),
+                         chunk_sparsity,
+                         chunk_size);
+  }
+
   template <int dim, int spacedim>
   Table<2, Coupling>
   dof_couplings_from_component_couplings(
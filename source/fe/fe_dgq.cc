@@ -432,22 +432,31 @@ FE_DGQ<dim, spacedim>::get_prolongation_matrix(
         const_cast<FE_DGQ<dim, spacedim> &>(*this);
       if (refinement_case == RefinementCase<dim>::isotropic_refinement)
         {
-          std::vector<std::vector<FullMatrix<double>>> isotropic_matrices(
-            RefinementCase<dim>::isotropic_refinement);
-          isotropic_matrices.back().resize(
-            GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
-            FullMatrix<double>(this->n_dofs_per_cell(),
-                               this->n_dofs_per_cell()));
-          if (dim == spacedim)
-            FETools::compute_embedding_matrices(*this,
-                                                isotropic_matrices,
-                                                true);
-          else
-            FETools::compute_embedding_matrices(FE_DGQ<dim>(this->degree),
-                                                isotropic_matrices,
-                                                true);
-          this_nonconst.prolongation[refinement_case - 1].swap(
-            isotropic_matrices.back());
+          const auto compute_matrices = [&]() {
+            std::vector<std::vector<FullMatrix<double>>> isotropic_matrices(
+              RefinementCase<dim>::isotropic_refinement);
+            isotropic_matrices.back().resize(
+              GeometryInfo<dim>::n_children(
+                RefinementCase<dim>(refinement_case)),
+              FullMatrix<double>(this->n_dofs_per_cell(),
+                                 this->n_dofs_per_cell()));
+            if (dim == spacedim)
+              FETools::compute_embedding_matrices(*this,
+                                                  isotropic_matrices,
+                                                  true);
+            else
+              FETools::compute_embedding_matrices(FE_DGQ<dim>(this->degree),
+                                                  isotropic_matrices,
+                                                  true);
+            return isotropic_matrices.back();
+          };
+
+          // the matrices only depend on the element, so compute them only
+          // once for all element objects of the same kind
+          this_nonconst.prolongation[refinement_case - 1] =
+            FETools::get_shared_transfer_matrices(this->get_name() +
+                                                    ":isotropic_prolongation",
+                                                  compute_matrices);
         }
       else
         {
@@ -508,22 +517,31 @@ FE_DGQ<dim, spacedim>::get_restriction_matrix(
         const_cast<FE_DGQ<dim, spacedim> &>(*this);
       if (refinement_case == RefinementCase<dim>::isotropic_refinement)
         {
-          std::vector<std::vector<FullMatrix<double>>> isotropic_matrices(
-            RefinementCase<dim>::isotropic_refinement);
-          isotropic_matrices.back().resize(
-            GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
-            FullMatrix<double>(this->n_dofs_per_cell(),
-                               this->n_dofs_per_cell()));
-          if (dim == spacedim)
-            FETools::compute_projection_matrices(*this,
-                                                 isotropic_matrices,
-                                                 true);
-          else
-            FETools::compute_projection_matrices(FE_DGQ<dim>(this->degree),
-                                                 isotropic_matrices,
-                                                 true);
-          this_nonconst.restriction[refinement_case - 1].swap(
-            isotropic_matrices.back());
+          const auto compute_matrices = [&]() {
+            std::vector<std::vector<FullMatrix<double>>> isotropic_matrices(
+              RefinementCase<dim>::isotropic_refinement);
+            isotropic_matrices.back().resize(
+              GeometryInfo<dim>::n_children(
+                RefinementCase<dim>(refinement_case)),
+              FullMatrix<double>(this->n_dofs_per_cell(),
+                                 this->n_dofs_per_cell()));
+            if (dim == spacedim)
+              FETools::compute_projection_matrices(*this,
+                                                   isotropic_matrices,
+                                                   true);
+            else
+              FETools::compute_projection_matrices(FE_DGQ<dim>(this->degree),
+                                                   isotropic_matrices,
+                                                   true);
+            return isotropic_matrices.back();
+          };
+
+          // the matrices only depend on the element, so compute them only
+          // once for all element objects of the same kind
+          this_nonconst.restriction[refinement_case - 1] =
+            FETools::get_shared_transfer_matrices(this->get_name() +
+                                                    ":isotropic_restriction",
+                                                  compute_matrices);
         }
       else
         {
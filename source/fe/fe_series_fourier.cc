@@ -16,6 +16,7 @@
 
 
 #include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/fe/fe_series.h>
@@ -60,98 +61,25 @@ namespace
 
 
 
-  template <int dim, int spacedim>
-  std::complex<double>
-  integrate(const FiniteElement<dim, spacedim> &fe,
-            const Quadrature<dim> &             quadrature,
-            const Tensor<1, dim> &              k_vector,
-            const unsigned int                  j,
-            const unsigned int                  component)
-  {
-    std::complex<double> sum = 0;
-    for (unsigned int q = 0; q < quadrature.size(); ++q)
-      {
-        const Point<dim> &x_q = quadrature.point(q);
-        sum += std::exp(std::complex<double>(0, 1) * (k_vector * x_q)) *
-               fe.shape_value_component(j, x_q, component) *
-               quadrature.weight(q);
-      }
-    return sum;
-  }
-
-
-
   /*
    * Ensure that the transformation matrix for FiniteElement index
    * @p fe_index is calculated. If not, calculate it.
+   *
+   * Entry $(k,j)$ of the matrix is the integral of the exponential with the
+   * $k$-th wave vector times the $j$-th shape function. Rather than
+   * evaluating the shape functions anew for every wave vector, both are
+   * tabulated at the quadrature points once, with the quadrature weights
+   * folded into the exponentials, and the real and imaginary parts of the
+   * matrix are then computed as matrix-matrix products. The tabulation runs
+   * in parallel.
    */
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &              n_coefficients_per_direction,
-    const hp::FECollection<1, spacedim> &          fe_collection,
-    const hp::QCollection<1> &                     q_collection,
-    const Table<1, Tensor<1, 1>> &                 k_vectors,
-    const unsigned int                             fe,
-    const unsigned int                             component,
-    std::vector<FullMatrix<std::complex<double>>> &fourier_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (fourier_transform_matrices[fe].m() == 0)
-      {
-        fourier_transform_matrices[fe].reinit(
-          n_coefficients_per_direction[fe],
-          fe_collection[fe].n_dofs_per_cell());
-
-        for (unsigned int k = 0; k < n_coefficients_per_direction[fe]; ++k)
-          for (unsigned int j = 0; j < fe_collection[fe].n_dofs_per_cell(); ++j)
-            fourier_transform_matrices[fe](k, j) = integrate(
-              fe_collection[fe], q_collection[fe], k_vectors(k), j, component);
-      }
-  }
-
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &              n_coefficients_per_direction,
-    const hp::FECollection<2, spacedim> &          fe_collection,
-    const hp::QCollection<2> &                     q_collection,
-    const Table<2, Tensor<1, 2>> &                 k_vectors,
-    const unsigned int                             fe,
-    const unsigned int                             component,
-    std::vector<FullMatrix<std::complex<double>>> &fourier_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (fourier_transform_matrices[fe].m() == 0)
-      {
-        fourier_transform_matrices[fe].reinit(
-          Utilities::fixed_power<2>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].n_dofs_per_cell());
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe];
-               ++k2, ++k)
-            for (unsigned int j = 0; j < fe_collection[fe].n_dofs_per_cell();
-                 ++j)
-              fourier_transform_matrices[fe](k, j) =
-                integrate(fe_collection[fe],
-                          q_collection[fe],
-                          k_vectors(k1, k2),
-                          j,
-                          component);
-      }
-  }
-
-  template <int spacedim>
+  template <int dim, int spacedim>
   void
   ensure_existence(
     const std::vector<unsigned int> &              n_coefficients_per_direction,
-    const hp::FECollection<3, spacedim> &          fe_collection,
-    const hp::QCollection<3> &                     q_collection,
-    const Table<3, Tensor<1, 3>> &                 k_vectors,
+    const hp::FECollection<dim, spacedim> &        fe_collection,
+    const hp::QCollection<dim> &                   q_collection,
+    const Table<dim, Tensor<1, dim>> &             k_vectors,
     const unsigned int                             fe,
     const unsigned int                             component,
     std::vector<FullMatrix<std::complex<double>>> &fourier_transform_matrices)
@@ -160,23 +88,66 @@ namespace
 
     if (fourier_transform_matrices[fe].m() == 0)
       {
-        fourier_transform_matrices[fe].reinit(
-          Utilities::fixed_power<3>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].n_dofs_per_cell());
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe]; ++k2)
-            for (unsigned int k3 = 0; k3 < n_coefficients_per_direction[fe];
-                 ++k3, ++k)
-              for (unsigned int j = 0; j < fe_collection[fe].n_dofs_per_cell();
-                   ++j)
-                fourier_transform_matrices[fe](k, j) =
-                  integrate(fe_collection[fe],
-                            q_collection[fe],
-                            k_vectors(k1, k2, k3),
-                            j,
-                            component);
+        const FiniteElement<dim, spacedim> &finite_element = fe_collection[fe];
+        const Quadrature<dim> &             quadrature     = q_collection[fe];
+
+        const unsigned int n_coefficients = n_coefficients_per_direction[fe];
+        const unsigned int n_modes =
+          Utilities::fixed_power<dim>(n_coefficients);
+        const unsigned int n_dofs     = finite_element.n_dofs_per_cell();
+        const unsigned int n_q_points = quadrature.size();
+
+        FullMatrix<double> cos_values(n_modes, n_q_points);
+        FullMatrix<double> sin_values(n_modes, n_q_points);
+        parallel::apply_to_subranges(
+          0U,
+          n_modes,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int k = begin; k < end; ++k)
+              {
+                // unroll the index with the last direction running fastest,
+                // which is the order Table::fill() expects
+                TableIndices<dim> indices;
+                for (unsigned int d = 0, k_d = k; d < dim;
+                     ++d, k_d /= n_coefficients)
+                  indices[dim - 1 - d] = k_d % n_coefficients;
+
+                const Tensor<1, dim> &k_vector = k_vectors(indices);
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  {
+                    const double phase = k_vector * quadrature.point(q);
+                    cos_values(k, q) = std::cos(phase) * quadrature.weight(q);
+                    sin_values(k, q) = std::sin(phase) * quadrature.weight(q);
+                  }
+              }
+          },
+          8);
+
+        FullMatrix<double> shape_values(n_dofs, n_q_points);
+        parallel::apply_to_subranges(
+          0U,
+          n_dofs,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int j = begin; j < end; ++j)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                shape_values(j, q) =
+                  finite_element.shape_value_component(j,
+                                                       quadrature.point(q),
+                                                       component);
+          },
+          8);
+
+        FullMatrix<double> real_part(n_modes, n_dofs);
+        FullMatrix<double> imag_part(n_modes, n_dofs);
+        cos_values.mTmult(real_part, shape_values);
+        sin_values.mTmult(imag_part, shape_values);
+
+        FullMatrix<std::complex<double>> matrix(n_modes, n_dofs);
+        for (unsigned int k = 0; k < n_modes; ++k)
+          for (unsigned int j = 0; j < n_dofs; ++j)
+            matrix(k, j) =
+              std::complex<double>(real_part(k, j), imag_part(k, j));
+        fourier_transform_matrices[fe] = std::move(matrix);
       }
   }
 } // namespace
@@ -217,7 +188,7 @@ namespace FESeries
     set_k_vectors(k_vectors, max_n_coefficients_per_direction);
 
     // reserve sufficient memory
-    unrolled_coefficients.reserve(k_vectors.n_elements());
+    unrolled_coefficients.get().reserve(k_vectors.n_elements());
   }
 
 
@@ -306,22 +277,21 @@ namespace FESeries
     const FullMatrix<CoefficientType> &matrix =
       fourier_transform_matrices[cell_active_fe_index];
 
-    unrolled_coefficients.resize(Utilities::fixed_power<dim>(
+    std::vector<CoefficientType> &coefficients = unrolled_coefficients.get();
+    coefficients.resize(Utilities::fixed_power<dim>(
       n_coefficients_per_direction[cell_active_fe_index]));
-    std::fill(unrolled_coefficients.begin(),
-              unrolled_coefficients.end(),
-              CoefficientType(0.));
+    std::fill(coefficients.begin(), coefficients.end(), CoefficientType(0.));
 
-    Assert(unrolled_coefficients.size() == matrix.m(), ExcInternalError());
+    Assert(coefficients.size() == matrix.m(), ExcInternalError());
 
     Assert(local_dof_values.size() == matrix.n(),
            ExcDimensionMismatch(local_dof_values.size(), matrix.n()));
 
-    for (unsigned int i = 0; i < unrolled_coefficients.size(); i++)
+    for (unsigned int i = 0; i < coefficients.size(); i++)
       for (unsigned int j = 0; j < local_dof_values.size(); j++)
-        unrolled_coefficients[i] += matrix[i][j] * local_dof_values[j];
+        coefficients[i] += matrix[i][j] * local_dof_values[j];
 
-    fourier_coefficients.fill(unrolled_coefficients.begin());
+    fourier_coefficients.fill(coefficients.begin());
   }
 } // namespace FESeries
 
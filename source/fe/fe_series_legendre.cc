@@ -15,6 +15,7 @@
 
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx17/cmath.h>
 #include <deal.II/base/thread_management.h>
 
@@ -69,124 +70,80 @@ namespace
 
 
 
-  template <int dim, int spacedim>
-  double
-  integrate(const FiniteElement<dim, spacedim> &fe,
-            const Quadrature<dim> &             quadrature,
-            const TableIndices<dim> &           indices,
-            const unsigned int                  dof,
-            const unsigned int                  component)
-  {
-    double sum = 0;
-    for (unsigned int q = 0; q < quadrature.size(); ++q)
-      {
-        const Point<dim> &x_q = quadrature.point(q);
-        sum += Lh(x_q, indices) *
-               fe.shape_value_component(dof, x_q, component) *
-               quadrature.weight(q);
-      }
-    return sum * multiplier(indices);
-  }
-
-
-
   /**
    * Ensure that the transformation matrix for FiniteElement index
    * @p fe_index is calculated. If not, calculate it.
+   *
+   * Entry $(k,j)$ of the matrix is the integral of the Legendre function
+   * with the $k$-th multi-index times the $j$-th shape function. Rather than
+   * evaluating the shape functions anew for every Legendre function, both
+   * are tabulated at the quadrature points once, with the quadrature
+   * weights and the multiplier folded into the Legendre functions, and the
+   * matrix is then computed as a single matrix-matrix product. The
+   * tabulation runs in parallel.
    */
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &    n_coefficients_per_direction,
-    const hp::FECollection<1, spacedim> &fe_collection,
-    const hp::QCollection<1> &           q_collection,
-    const unsigned int                   fe,
-    const unsigned int                   component,
-    std::vector<FullMatrix<double>> &    legendre_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (legendre_transform_matrices[fe].m() == 0)
-      {
-        legendre_transform_matrices[fe].reinit(
-          n_coefficients_per_direction[fe],
-          fe_collection[fe].n_dofs_per_cell());
-
-        for (unsigned int k = 0; k < n_coefficients_per_direction[fe]; ++k)
-          for (unsigned int j = 0; j < fe_collection[fe].n_dofs_per_cell(); ++j)
-            legendre_transform_matrices[fe](k, j) =
-              integrate(fe_collection[fe],
-                        q_collection[fe],
-                        TableIndices<1>(k),
-                        j,
-                        component);
-      }
-  }
-
-  template <int spacedim>
-  void
-  ensure_existence(
-    const std::vector<unsigned int> &    n_coefficients_per_direction,
-    const hp::FECollection<2, spacedim> &fe_collection,
-    const hp::QCollection<2> &           q_collection,
-    const unsigned int                   fe,
-    const unsigned int                   component,
-    std::vector<FullMatrix<double>> &    legendre_transform_matrices)
-  {
-    AssertIndexRange(fe, fe_collection.size());
-
-    if (legendre_transform_matrices[fe].m() == 0)
-      {
-        legendre_transform_matrices[fe].reinit(
-          Utilities::fixed_power<2>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].n_dofs_per_cell());
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe];
-               ++k2, k++)
-            for (unsigned int j = 0; j < fe_collection[fe].n_dofs_per_cell();
-                 ++j)
-              legendre_transform_matrices[fe](k, j) =
-                integrate(fe_collection[fe],
-                          q_collection[fe],
-                          TableIndices<2>(k1, k2),
-                          j,
-                          component);
-      }
-  }
-
-  template <int spacedim>
+  template <int dim, int spacedim>
   void
   ensure_existence(
-    const std::vector<unsigned int> &    n_coefficients_per_direction,
-    const hp::FECollection<3, spacedim> &fe_collection,
-    const hp::QCollection<3> &           q_collection,
-    const unsigned int                   fe,
-    const unsigned int                   component,
-    std::vector<FullMatrix<double>> &    legendre_transform_matrices)
+    const std::vector<unsigned int> &      n_coefficients_per_direction,
+    const hp::FECollection<dim, spacedim> &fe_collection,
+    const hp::QCollection<dim> &           q_collection,
+    const unsigned int                     fe,
+    const unsigned int                     component,
+    std::vector<FullMatrix<double>> &      legendre_transform_matrices)
   {
     AssertIndexRange(fe, fe_collection.size());
 
     if (legendre_transform_matrices[fe].m() == 0)
       {
-        legendre_transform_matrices[fe].reinit(
-          Utilities::fixed_power<3>(n_coefficients_per_direction[fe]),
-          fe_collection[fe].n_dofs_per_cell());
-
-        unsigned int k = 0;
-        for (unsigned int k1 = 0; k1 < n_coefficients_per_direction[fe]; ++k1)
-          for (unsigned int k2 = 0; k2 < n_coefficients_per_direction[fe]; ++k2)
-            for (unsigned int k3 = 0; k3 < n_coefficients_per_direction[fe];
-                 ++k3, k++)
-              for (unsigned int j = 0; j < fe_collection[fe].n_dofs_per_cell();
-                   ++j)
-                legendre_transform_matrices[fe](k, j) =
-                  integrate(fe_collection[fe],
-                            q_collection[fe],
-                            TableIndices<3>(k1, k2, k3),
-                            j,
-                            component);
+        const FiniteElement<dim, spacedim> &finite_element = fe_collection[fe];
+        const Quadrature<dim> &             quadrature     = q_collection[fe];
+
+        const unsigned int n_coefficients = n_coefficients_per_direction[fe];
+        const unsigned int n_modes =
+          Utilities::fixed_power<dim>(n_coefficients);
+        const unsigned int n_dofs     = finite_element.n_dofs_per_cell();
+        const unsigned int n_q_points = quadrature.size();
+
+        FullMatrix<double> legendre_values(n_modes, n_q_points);
+        parallel::apply_to_subranges(
+          0U,
+          n_modes,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int k = begin; k < end; ++k)
+              {
+                // unroll the index with the last direction running fastest,
+                // which is the order Table::fill() expects
+                TableIndices<dim> indices;
+                for (unsigned int d = 0, k_d = k; d < dim;
+                     ++d, k_d /= n_coefficients)
+                  indices[dim - 1 - d] = k_d % n_coefficients;
+
+                const double factor = multiplier(indices);
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  legendre_values(k, q) = Lh(quadrature.point(q), indices) *
+                                          quadrature.weight(q) * factor;
+              }
+          },
+          8);
+
+        FullMatrix<double> shape_values(n_dofs, n_q_points);
+        parallel::apply_to_subranges(
+          0U,
+          n_dofs,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int j = begin; j < end; ++j)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                shape_values(j, q) =
+                  finite_element.shape_value_component(j,
+                                                       quadrature.point(q),
+                                                       component);
+          },
+          8);
+
+        FullMatrix<double> matrix(n_modes, n_dofs);
+        legendre_values.mTmult(matrix, shape_values);
+        legendre_transform_matrices[fe] = std::move(matrix);
       }
   }
 } // namespace
@@ -225,7 +182,7 @@ namespace FESeries
     const unsigned int max_n_coefficients_per_direction =
       *std::max_element(n_coefficients_per_direction.cbegin(),
                         n_coefficients_per_direction.cend());
-    unrolled_coefficients.reserve(
+    unrolled_coefficients.get().reserve(
       Utilities::fixed_power<dim>(max_n_coefficients_per_direction));
   }
 
@@ -312,22 +269,21 @@ namespace FESeries
     const FullMatrix<CoefficientType> &matrix =
       legendre_transform_matrices[cell_active_fe_index];
 
-    unrolled_coefficients.resize(Utilities::fixed_power<dim>(
+    std::vector<CoefficientType> &coefficients = unrolled_coefficients.get();
+    coefficients.resize(Utilities::fixed_power<dim>(
       n_coefficients_per_direction[cell_active_fe_index]));
-    std::fill(unrolled_coefficients.begin(),
-              unrolled_coefficients.end(),
-              CoefficientType(0.));
+    std::fill(coefficients.begin(), coefficients.end(), CoefficientType(0.));
 
-    Assert(unrolled_coefficients.size() == matrix.m(), ExcInternalError());
+    Assert(coefficients.size() == matrix.m(), ExcInternalError());
 
     Assert(local_dof_values.size() == matrix.n(),
            ExcDimensionMismatch(local_dof_values.size(), matrix.n()));
 
-    for (unsigned int i = 0; i < unrolled_coefficients.size(); i++)
+    for (unsigned int i = 0; i < coefficients.size(); i++)
       for (unsigned int j = 0; j < local_dof_values.size(); j++)
-        unrolled_coefficients[i] += matrix[i][j] * local_dof_values[j];
+        coefficients[i] += matrix[i][j] * local_dof_values[j];
 
-    legendre_coefficients.fill(unrolled_coefficients.begin());
+    legendre_coefficients.fill(coefficients.begin());
   }
 } // namespace FESeries
 
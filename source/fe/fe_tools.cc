@@ -16,6 +16,9 @@
 
 #include <deal.II/fe/fe_tools.templates.h>
 
+#include <map>
+#include <mutex>
+
 DEAL_II_NAMESPACE_OPEN
 
 /*-------------- Explicit Instantiations -------------------------------*/
@@ -33,6 +36,36 @@ namespace FETools
 
   template std::vector<unsigned int>
   lexicographic_to_hierarchic_numbering<0>(unsigned int);
+
+
+
+  std::vector<FullMatrix<double>>
+  get_shared_transfer_matrices(
+    const std::string &                                      key,
+    const std::function<std::vector<FullMatrix<double>>()> &compute)
+  {
+    // names of elements on unidentified support points do not describe the
+    // element uniquely
+    if (key.find("QUnknownNodes") != std::string::npos)
+      return compute();
+
+    static std::map<std::string, std::vector<FullMatrix<double>>> cache;
+    static std::mutex                                             mutex;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto                  entry = cache.find(key);
+      if (entry != cache.end())
+        return entry->second;
+    }
+
+    // compute without holding the lock. if another thread inserted the same
+    // key in the meantime, emplace() keeps the existing entry
+    std::vector<FullMatrix<double>> matrices = compute();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return cache.emplace(key, std::move(matrices)).first->second;
+  }
 } // namespace FETools
 
 DEAL_II_NAMESPACE_CLOSE
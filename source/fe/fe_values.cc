@@ -173,6 +173,9 @@ namespace FEValuesViews
             shape_function_to_row_table[i * fe.n_components() + component];
         else
           shape_function_data[i].row_index = numbers::invalid_unsigned_int;
+
+        if (shape_function_data[i].is_nonzero_shape_function_component == true)
+          nonzero_shape_functions.push_back(i);
       }
   }
 
@@ -235,6 +238,9 @@ namespace FEValuesViews
               true)
             ++n_nonzero_components;
 
+        if (n_nonzero_components > 0)
+          nonzero_shape_functions.push_back(i);
+
         if (n_nonzero_components == 0)
           shape_function_data[i].single_nonzero_component = -2;
         else if (n_nonzero_components > 1)
@@ -437,99 +443,175 @@ namespace FEValuesViews
     // values/gradients/... at quadrature points
 
     // ------------------------- scalar functions --------------------------
+    //
+    // the functions are written for several vectors of dof values at once,
+    // so that the row of shape function data of a shape function is loaded
+    // once and then applied to all vectors while it is still in cache
     template <int dim, int spacedim, typename Number>
     void
-    do_function_values(
-      const ArrayView<Number> &dof_values,
-      const Table<2, double> & shape_values,
+    do_function_values_of_vectors(
+      const ArrayView<const ArrayView<Number>> &dof_values,
+      const Table<2, double> &                  shape_values,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
-      std::vector<typename ProductType<Number, double>::type> &values)
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      const ArrayView<std::vector<typename ProductType<Number, double>::type>>
+        &values)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
-      const unsigned int n_quadrature_points = values.size();
+      AssertDimension(dof_values.size(), values.size());
+      const unsigned int n_vectors = dof_values.size();
+      if (n_vectors == 0)
+        return;
+      const unsigned int n_quadrature_points = values[0].size();
 
-      std::fill(values.begin(),
-                values.end(),
-                dealii::internal::NumberType<Number>::value(0.0));
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        {
+          AssertDimension(dof_values[v].size(), shape_function_data.size());
+          AssertDimension(values[v].size(), n_quadrature_points);
+          std::fill(values[v].begin(),
+                    values[v].end(),
+                    dealii::internal::NumberType<Number>::value(0.0));
+        }
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         if (shape_function_data[shape_function]
               .is_nonzero_shape_function_component)
           {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
             const double *shape_value_ptr =
               &shape_values(shape_function_data[shape_function].row_index, 0);
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              values[q_point] += value * (*shape_value_ptr++);
+            for (unsigned int v = 0; v < n_vectors; ++v)
+              {
+                const Number &value = dof_values[v][shape_function];
+                // For auto-differentiable numbers, the fact that a DoF value
+                // is zero does not imply that its derivatives are zero as
+                // well. So we can't filter by value for these number types.
+                if (dealii::internal::CheckForZero<Number>::value(value) ==
+                    true)
+                  continue;
+
+                auto &values_v = values[v];
+                for (unsigned int q_point = 0; q_point < n_quadrature_points;
+                     ++q_point)
+                  values_v[q_point] += value * shape_value_ptr[q_point];
+              }
           }
     }
 
 
 
+    template <int dim, int spacedim, typename Number>
+    void
+    do_function_values(
+      const ArrayView<Number> &dof_values,
+      const Table<2, double> & shape_values,
+      const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      std::vector<typename ProductType<Number, double>::type> &values)
+    {
+      do_function_values_of_vectors<dim, spacedim>(
+        ArrayView<const ArrayView<Number>>(&dof_values, 1),
+        shape_values,
+        shape_function_data,
+        nonzero_shape_functions,
+        make_array_view(&values, &values + 1));
+    }
+
+
+
     // same code for gradient and Hessian, template argument 'order' to give
     // the order of the derivative (= rank of gradient/Hessian tensor)
     template <int order, int dim, int spacedim, typename Number>
     void
-    do_function_derivatives(
-      const ArrayView<Number> &                        dof_values,
+    do_function_derivatives_of_vectors(
+      const ArrayView<const ArrayView<Number>> &       dof_values,
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
-      std::vector<
-        typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      const ArrayView<std::vector<
+        typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>>
         &derivatives)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
-      const unsigned int n_quadrature_points = derivatives.size();
-
-      std::fill(
-        derivatives.begin(),
-        derivatives.end(),
-        typename ProductType<Number, dealii::Tensor<order, spacedim>>::type());
+      AssertDimension(dof_values.size(), derivatives.size());
+      const unsigned int n_vectors = dof_values.size();
+      if (n_vectors == 0)
+        return;
+      const unsigned int n_quadrature_points = derivatives[0].size();
+
+      using derivative_type =
+        typename ProductType<Number, dealii::Tensor<order, spacedim>>::type;
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        {
+          AssertDimension(dof_values[v].size(), shape_function_data.size());
+          AssertDimension(derivatives[v].size(), n_quadrature_points);
+          std::fill(derivatives[v].begin(),
+                    derivatives[v].end(),
+                    derivative_type());
+        }
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         if (shape_function_data[shape_function]
               .is_nonzero_shape_function_component)
           {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
             const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
               &shape_derivatives[shape_function_data[shape_function].row_index]
                                 [0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              derivatives[q_point] += value * (*shape_derivative_ptr++);
+            for (unsigned int v = 0; v < n_vectors; ++v)
+              {
+                const Number &value = dof_values[v][shape_function];
+                // For auto-differentiable numbers, the fact that a DoF value
+                // is zero does not imply that its derivatives are zero as
+                // well. So we can't filter by value for these number types.
+                if (dealii::internal::CheckForZero<Number>::value(value) ==
+                    true)
+                  continue;
+
+                auto &derivatives_v = derivatives[v];
+                for (unsigned int q_point = 0; q_point < n_quadrature_points;
+                     ++q_point)
+                  derivatives_v[q_point] +=
+                    value * shape_derivative_ptr[q_point];
+              }
           }
     }
 
 
 
+    template <int order, int dim, int spacedim, typename Number>
+    void
+    do_function_derivatives(
+      const ArrayView<Number> &                        dof_values,
+      const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
+      const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      std::vector<
+        typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>
+        &derivatives)
+    {
+      do_function_derivatives_of_vectors<order, dim, spacedim>(
+        ArrayView<const ArrayView<Number>>(&dof_values, 1),
+        shape_derivatives,
+        shape_function_data,
+        nonzero_shape_functions,
+        make_array_view(&derivatives, &derivatives + 1));
+    }
+
+
+
     template <int dim, int spacedim, typename Number>
     void
     do_function_laplacians(
       const ArrayView<Number> &                    dof_values,
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &                         shape_function_data,
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Scalar<dim, spacedim>::template OutputType<
         Number>::laplacian_type> &laplacians)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
+      AssertDimension(dof_values.size(), shape_function_data.size());
       const unsigned int n_quadrature_points = laplacians.size();
 
       std::fill(laplacians.begin(),
@@ -537,8 +619,7 @@ namespace FEValuesViews
                 typename Scalar<dim, spacedim>::template OutputType<
                   Number>::laplacian_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         if (shape_function_data[shape_function]
               .is_nonzero_shape_function_component)
           {
@@ -563,25 +644,55 @@ namespace FEValuesViews
 
     template <int dim, int spacedim, typename Number>
     void
-    do_function_values(
-      const ArrayView<Number> &dof_values,
-      const Table<2, double> & shape_values,
+    do_function_values_of_vectors(
+      const ArrayView<const ArrayView<Number>> &dof_values,
+      const Table<2, double> &                  shape_values,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
-      std::vector<
-        typename ProductType<Number, dealii::Tensor<1, spacedim>>::type>
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      const ArrayView<std::vector<
+        typename ProductType<Number, dealii::Tensor<1, spacedim>>::type>>
         &values)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
-      const unsigned int n_quadrature_points = values.size();
+      AssertDimension(dof_values.size(), values.size());
+      const unsigned int n_vectors = dof_values.size();
+      if (n_vectors == 0)
+        return;
+      const unsigned int n_quadrature_points = values[0].size();
 
-      std::fill(
-        values.begin(),
-        values.end(),
-        typename ProductType<Number, dealii::Tensor<1, spacedim>>::type());
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        {
+          AssertDimension(dof_values[v].size(), shape_function_data.size());
+          AssertDimension(values[v].size(), n_quadrature_points);
+          std::fill(
+            values[v].begin(),
+            values[v].end(),
+            typename ProductType<Number, dealii::Tensor<1, spacedim>>::type());
+        }
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      // add the contribution of the shape values in row @p row_index to
+      // component @p comp of the values of all vectors
+      const auto add_component = [&](const unsigned int shape_function,
+                                     const unsigned int row_index,
+                                     const unsigned int comp) {
+        const double *shape_value_ptr = &shape_values(row_index, 0);
+        for (unsigned int v = 0; v < n_vectors; ++v)
+          {
+            const Number &value = dof_values[v][shape_function];
+            // For auto-differentiable numbers, the fact that a DoF value is
+            // zero does not imply that its derivatives are zero as well. So
+            // we can't filter by value for these number types.
+            if (dealii::internal::CheckForZero<Number>::value(value) == true)
+              continue;
+
+            auto &values_v = values[v];
+            for (unsigned int q_point = 0; q_point < n_quadrature_points;
+                 ++q_point)
+              values_v[q_point][comp] += value * shape_value_ptr[q_point];
+          }
+      };
+
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
@@ -590,60 +701,99 @@ namespace FEValuesViews
             // shape function is zero for the selected components
             continue;
 
-          const Number &value = dof_values[shape_function];
-          // For auto-differentiable numbers, the fact that a DoF value is zero
-          // does not imply that its derivatives are zero as well. So we
-          // can't filter by value for these number types.
-          if (dealii::internal::CheckForZero<Number>::value(value) == true)
-            continue;
-
           if (snc != -1)
-            {
-              const unsigned int comp = shape_function_data[shape_function]
-                                          .single_nonzero_component_index;
-              const double *shape_value_ptr = &shape_values(snc, 0);
-              for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                   ++q_point)
-                values[q_point][comp] += value * (*shape_value_ptr++);
-            }
+            add_component(shape_function,
+                          snc,
+                          shape_function_data[shape_function]
+                            .single_nonzero_component_index);
           else
             for (unsigned int d = 0; d < spacedim; ++d)
               if (shape_function_data[shape_function]
                     .is_nonzero_shape_function_component[d])
-                {
-                  const double *shape_value_ptr = &shape_values(
-                    shape_function_data[shape_function].row_index[d], 0);
-                  for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                       ++q_point)
-                    values[q_point][d] += value * (*shape_value_ptr++);
-                }
+                add_component(shape_function,
+                              shape_function_data[shape_function].row_index[d],
+                              d);
         }
     }
 
 
 
+    template <int dim, int spacedim, typename Number>
+    void
+    do_function_values(
+      const ArrayView<Number> &dof_values,
+      const Table<2, double> & shape_values,
+      const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      std::vector<
+        typename ProductType<Number, dealii::Tensor<1, spacedim>>::type>
+        &values)
+    {
+      do_function_values_of_vectors<dim, spacedim>(
+        ArrayView<const ArrayView<Number>>(&dof_values, 1),
+        shape_values,
+        shape_function_data,
+        nonzero_shape_functions,
+        make_array_view(&values, &values + 1));
+    }
+
+
+
     template <int order, int dim, int spacedim, typename Number>
     void
-    do_function_derivatives(
-      const ArrayView<Number> &                        dof_values,
+    do_function_derivatives_of_vectors(
+      const ArrayView<const ArrayView<Number>> &       dof_values,
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
-      std::vector<
-        typename ProductType<Number, dealii::Tensor<order + 1, spacedim>>::type>
-        &derivatives)
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      const ArrayView<std::vector<typename ProductType<
+        Number,
+        dealii::Tensor<order + 1, spacedim>>::type>> &derivatives)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
-      const unsigned int n_quadrature_points = derivatives.size();
+      AssertDimension(dof_values.size(), derivatives.size());
+      const unsigned int n_vectors = dof_values.size();
+      if (n_vectors == 0)
+        return;
+      const unsigned int n_quadrature_points = derivatives[0].size();
 
-      std::fill(
-        derivatives.begin(),
-        derivatives.end(),
-        typename ProductType<Number,
-                             dealii::Tensor<order + 1, spacedim>>::type());
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        {
+          AssertDimension(dof_values[v].size(), shape_function_data.size());
+          AssertDimension(derivatives[v].size(), n_quadrature_points);
+          std::fill(derivatives[v].begin(),
+                    derivatives[v].end(),
+                    typename ProductType<
+                      Number,
+                      dealii::Tensor<order + 1, spacedim>>::type());
+        }
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      // add the contribution of the shape derivatives in row @p row_index to
+      // component @p comp of the derivatives of all vectors
+      const auto add_component = [&](const unsigned int shape_function,
+                                     const unsigned int row_index,
+                                     const unsigned int comp) {
+        const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
+          &shape_derivatives[row_index][0];
+        for (unsigned int v = 0; v < n_vectors; ++v)
+          {
+            const Number &value = dof_values[v][shape_function];
+            // For auto-differentiable numbers, the fact that a DoF value is
+            // zero does not imply that its derivatives are zero as well. So
+            // we can't filter by value for these number types.
+            if (dealii::internal::CheckForZero<Number>::value(value) == true)
+              continue;
+
+            auto &derivatives_v = derivatives[v];
+            for (unsigned int q_point = 0; q_point < n_quadrature_points;
+                 ++q_point)
+              derivatives_v[q_point][comp] +=
+                value * shape_derivative_ptr[q_point];
+          }
+      };
+
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
@@ -652,41 +802,45 @@ namespace FEValuesViews
             // shape function is zero for the selected components
             continue;
 
-          const Number &value = dof_values[shape_function];
-          // For auto-differentiable numbers, the fact that a DoF value is zero
-          // does not imply that its derivatives are zero as well. So we
-          // can't filter by value for these number types.
-          if (dealii::internal::CheckForZero<Number>::value(value) == true)
-            continue;
-
           if (snc != -1)
-            {
-              const unsigned int comp = shape_function_data[shape_function]
-                                          .single_nonzero_component_index;
-              const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
-                &shape_derivatives[snc][0];
-              for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                   ++q_point)
-                derivatives[q_point][comp] += value * (*shape_derivative_ptr++);
-            }
+            add_component(shape_function,
+                          snc,
+                          shape_function_data[shape_function]
+                            .single_nonzero_component_index);
           else
             for (unsigned int d = 0; d < spacedim; ++d)
               if (shape_function_data[shape_function]
                     .is_nonzero_shape_function_component[d])
-                {
-                  const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
-                    &shape_derivatives[shape_function_data[shape_function]
-                                         .row_index[d]][0];
-                  for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                       ++q_point)
-                    derivatives[q_point][d] +=
-                      value * (*shape_derivative_ptr++);
-                }
+                add_component(shape_function,
+                              shape_function_data[shape_function].row_index[d],
+                              d);
         }
     }
 
 
 
+    template <int order, int dim, int spacedim, typename Number>
+    void
+    do_function_derivatives(
+      const ArrayView<Number> &                        dof_values,
+      const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
+      const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
+      std::vector<
+        typename ProductType<Number, dealii::Tensor<order + 1, spacedim>>::type>
+        &derivatives)
+    {
+      do_function_derivatives_of_vectors<order, dim, spacedim>(
+        ArrayView<const ArrayView<Number>>(&dof_values, 1),
+        shape_derivatives,
+        shape_function_data,
+        nonzero_shape_functions,
+        make_array_view(&derivatives, &derivatives + 1));
+    }
+
+
+
     template <int dim, int spacedim, typename Number>
     void
     do_function_symmetric_gradients(
@@ -694,12 +848,13 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type>
         &symmetric_gradients)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
+      AssertDimension(dof_values.size(), shape_function_data.size());
       const unsigned int n_quadrature_points = symmetric_gradients.size();
 
       std::fill(
@@ -708,8 +863,7 @@ namespace FEValuesViews
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
@@ -763,11 +917,12 @@ namespace FEValuesViews
       const ArrayView<Number> &                    dof_values,
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
-        &                          shape_function_data,
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Vector<dim, spacedim>::template OutputType<
         Number>::divergence_type> &divergences)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
+      AssertDimension(dof_values.size(), shape_function_data.size());
       const unsigned int n_quadrature_points = divergences.size();
 
       std::fill(divergences.begin(),
@@ -775,8 +930,7 @@ namespace FEValuesViews
                 typename Vector<dim, spacedim>::template OutputType<
                   Number>::divergence_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
@@ -826,11 +980,12 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<
         Number,
         typename dealii::internal::CurlType<spacedim>::type>::type> &curls)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
+      AssertDimension(dof_values.size(), shape_function_data.size());
       const unsigned int n_quadrature_points = curls.size();
 
       std::fill(curls.begin(),
@@ -851,9 +1006,7 @@ namespace FEValuesViews
 
           case 2:
             {
-              for (unsigned int shape_function = 0;
-                   shape_function < dofs_per_cell;
-                   ++shape_function)
+              for (const unsigned int shape_function : nonzero_shape_functions)
                 {
                   const int snc = shape_function_data[shape_function]
                                     .single_nonzero_component;
@@ -935,9 +1088,7 @@ namespace FEValuesViews
 
           case 3:
             {
-              for (unsigned int shape_function = 0;
-                   shape_function < dofs_per_cell;
-                   ++shape_function)
+              for (const unsigned int shape_function : nonzero_shape_functions)
                 {
                   const int snc = shape_function_data[shape_function]
                                     .single_nonzero_component;
@@ -1087,11 +1238,12 @@ namespace FEValuesViews
       const ArrayView<Number> &                    dof_values,
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
-        &                         shape_function_data,
+        &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Vector<dim, spacedim>::template OutputType<
         Number>::laplacian_type> &laplacians)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
+      AssertDimension(dof_values.size(), shape_function_data.size());
       const unsigned int n_quadrature_points = laplacians.size();
 
       std::fill(laplacians.begin(),
@@ -1099,8 +1251,7 @@ namespace FEValuesViews
                 typename Vector<dim, spacedim>::template OutputType<
                   Number>::laplacian_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
@@ -1563,6 +1714,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1588,6 +1740,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1619,6 +1772,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1644,11 +1798,98 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
 
 
+  template <int dim, int spacedim>
+  template <class InputVector>
+  void
+  Scalar<dim, spacedim>::get_function_values_of_vectors(
+    const std::vector<const InputVector *> &fe_functions,
+    std::vector<std::vector<typename ProductType<
+      value_type,
+      typename InputVector::value_type>::type>> &values) const
+  {
+    Assert(fe_values->update_flags & update_values,
+           (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+             "update_values")));
+    Assert(fe_values->present_cell.get() != nullptr,
+           ExcMessage("FEValues object is not reinit'ed to any cell"));
+    AssertDimension(values.size(), fe_functions.size());
+
+    // get function values of dofs on this cell for all vectors and call
+    // internal worker function
+    std::vector<dealii::Vector<typename InputVector::value_type>> dof_values(
+      fe_functions.size());
+    std::vector<ArrayView<typename InputVector::value_type>> dof_values_view;
+    dof_values_view.reserve(fe_functions.size());
+    for (unsigned int v = 0; v < fe_functions.size(); ++v)
+      {
+        AssertDimension(fe_functions[v]->size(),
+                        fe_values->present_cell->n_dofs_for_dof_handler());
+        dof_values[v].reinit(fe_values->dofs_per_cell);
+        fe_values->present_cell->get_interpolated_dof_values(*fe_functions[v],
+                                                             dof_values[v]);
+        dof_values_view.push_back(
+          make_array_view(dof_values[v].begin(), dof_values[v].end()));
+      }
+    internal::do_function_values_of_vectors<dim, spacedim>(
+      ArrayView<const ArrayView<typename InputVector::value_type>>(
+        dof_values_view.data(), dof_values_view.size()),
+      fe_values->finite_element_output.shape_values,
+      shape_function_data,
+      nonzero_shape_functions,
+      make_array_view(values));
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <class InputVector>
+  void
+  Scalar<dim, spacedim>::get_function_gradients_of_vectors(
+    const std::vector<const InputVector *> &fe_functions,
+    std::vector<std::vector<typename ProductType<
+      gradient_type,
+      typename InputVector::value_type>::type>> &gradients) const
+  {
+    Assert(fe_values->update_flags & update_gradients,
+           (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+             "update_gradients")));
+    Assert(fe_values->present_cell.get() != nullptr,
+           ExcMessage("FEValues object is not reinit'ed to any cell"));
+    AssertDimension(gradients.size(), fe_functions.size());
+
+    // get function values of dofs on this cell for all vectors and call
+    // internal worker function
+    std::vector<dealii::Vector<typename InputVector::value_type>> dof_values(
+      fe_functions.size());
+    std::vector<ArrayView<typename InputVector::value_type>> dof_values_view;
+    dof_values_view.reserve(fe_functions.size());
+    for (unsigned int v = 0; v < fe_functions.size(); ++v)
+      {
+        AssertDimension(fe_functions[v]->size(),
+                        fe_values->present_cell->n_dofs_for_dof_handler());
+        dof_values[v].reinit(fe_values->dofs_per_cell);
+        fe_values->present_cell->get_interpolated_dof_values(*fe_functions[v],
+                                                             dof_values[v]);
+        dof_values_view.push_back(
+          make_array_view(dof_values[v].begin(), dof_values[v].end()));
+      }
+    internal::do_function_derivatives_of_vectors<1, dim, spacedim>(
+      ArrayView<const ArrayView<typename InputVector::value_type>>(
+        dof_values_view.data(), dof_values_view.size()),
+      fe_values->finite_element_output.shape_gradients,
+      shape_function_data,
+      nonzero_shape_functions,
+      make_array_view(gradients));
+  }
+
+
+
   template <int dim, int spacedim>
   template <class InputVector>
   void
@@ -1675,6 +1916,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -1700,6 +1942,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -1731,6 +1974,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -1756,6 +2000,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -1787,6 +2032,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -1811,6 +2057,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -1842,6 +2089,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1867,6 +2115,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1898,6 +2147,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1923,11 +2173,98 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
 
 
+  template <int dim, int spacedim>
+  template <class InputVector>
+  void
+  Vector<dim, spacedim>::get_function_values_of_vectors(
+    const std::vector<const InputVector *> &fe_functions,
+    std::vector<std::vector<typename ProductType<
+      value_type,
+      typename InputVector::value_type>::type>> &values) const
+  {
+    Assert(fe_values->update_flags & update_values,
+           (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+             "update_values")));
+    Assert(fe_values->present_cell.get() != nullptr,
+           ExcMessage("FEValues object is not reinit'ed to any cell"));
+    AssertDimension(values.size(), fe_functions.size());
+
+    // get function values of dofs on this cell for all vectors and call
+    // internal worker function
+    std::vector<dealii::Vector<typename InputVector::value_type>> dof_values(
+      fe_functions.size());
+    std::vector<ArrayView<typename InputVector::value_type>> dof_values_view;
+    dof_values_view.reserve(fe_functions.size());
+    for (unsigned int v = 0; v < fe_functions.size(); ++v)
+      {
+        AssertDimension(fe_functions[v]->size(),
+                        fe_values->present_cell->n_dofs_for_dof_handler());
+        dof_values[v].reinit(fe_values->dofs_per_cell);
+        fe_values->present_cell->get_interpolated_dof_values(*fe_functions[v],
+                                                             dof_values[v]);
+        dof_values_view.push_back(
+          make_array_view(dof_values[v].begin(), dof_values[v].end()));
+      }
+    internal::do_function_values_of_vectors<dim, spacedim>(
+      ArrayView<const ArrayView<typename InputVector::value_type>>(
+        dof_values_view.data(), dof_values_view.size()),
+      fe_values->finite_element_output.shape_values,
+      shape_function_data,
+      nonzero_shape_functions,
+      make_array_view(values));
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <class InputVector>
+  void
+  Vector<dim, spacedim>::get_function_gradients_of_vectors(
+    const std::vector<const InputVector *> &fe_functions,
+    std::vector<std::vector<typename ProductType<
+      gradient_type,
+      typename InputVector::value_type>::type>> &gradients) const
+  {
+    Assert(fe_values->update_flags & update_gradients,
+           (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+             "update_gradients")));
+    Assert(fe_values->present_cell.get() != nullptr,
+           ExcMessage("FEValues object is not reinit'ed to any cell"));
+    AssertDimension(gradients.size(), fe_functions.size());
+
+    // get function values of dofs on this cell for all vectors and call
+    // internal worker function
+    std::vector<dealii::Vector<typename InputVector::value_type>> dof_values(
+      fe_functions.size());
+    std::vector<ArrayView<typename InputVector::value_type>> dof_values_view;
+    dof_values_view.reserve(fe_functions.size());
+    for (unsigned int v = 0; v < fe_functions.size(); ++v)
+      {
+        AssertDimension(fe_functions[v]->size(),
+                        fe_values->present_cell->n_dofs_for_dof_handler());
+        dof_values[v].reinit(fe_values->dofs_per_cell);
+        fe_values->present_cell->get_interpolated_dof_values(*fe_functions[v],
+                                                             dof_values[v]);
+        dof_values_view.push_back(
+          make_array_view(dof_values[v].begin(), dof_values[v].end()));
+      }
+    internal::do_function_derivatives_of_vectors<1, dim, spacedim>(
+      ArrayView<const ArrayView<typename InputVector::value_type>>(
+        dof_values_view.data(), dof_values_view.size()),
+      fe_values->finite_element_output.shape_gradients,
+      shape_function_data,
+      nonzero_shape_functions,
+      make_array_view(gradients));
+  }
+
+
+
   template <int dim, int spacedim>
   template <class InputVector>
   void
@@ -1954,6 +2291,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       symmetric_gradients);
   }
 
@@ -1978,6 +2316,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       symmetric_gradients);
   }
 
@@ -2010,6 +2349,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2035,6 +2375,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2066,6 +2407,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       curls);
   }
 
@@ -2091,6 +2433,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       curls);
   }
 
@@ -2122,6 +2465,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -2147,6 +2491,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -2183,6 +2528,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -2211,6 +2557,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -2242,6 +2589,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -2266,6 +2614,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -38,8 +38,10 @@ DEAL_II_NAMESPACE_OPEN
 
 template <int dim, int spacedim>
 MappingQCache<dim, spacedim>::MappingQCache(
-  const unsigned int polynomial_degree)
+  const unsigned int polynomial_degree,
+  const bool         store_support_points_in_float)
   : MappingQGeneric<dim, spacedim>(polynomial_degree)
+  , store_support_points_in_float(store_support_points_in_float)
 {}
 
 
@@ -48,7 +50,9 @@ template <int dim, int spacedim>
 MappingQCache<dim, spacedim>::MappingQCache(
   const MappingQCache<dim, spacedim> &mapping)
   : MappingQGeneric<dim, spacedim>(mapping)
+  , store_support_points_in_float(mapping.store_support_points_in_float)
   , support_point_cache(mapping.support_point_cache)
+  , support_point_cache_float(mapping.support_point_cache_float)
 {}
 
 
@@ -61,6 +65,7 @@ MappingQCache<dim, spacedim>::~MappingQCache()
   // invalid memory that has been left back by freeing an object of this
   // class.
   support_point_cache.reset();
+  support_point_cache_float.reset();
   clear_signal.disconnect();
 }
 
@@ -154,26 +159,71 @@ MappingQCache<dim, spacedim>::initialize(
     &compute_points_on_cell)
 {
   clear_signal.disconnect();
-  clear_signal = triangulation.signals.any_change.connect(
-    [&]() -> void { this->support_point_cache.reset(); });
+  clear_signal = triangulation.signals.any_change.connect([&]() -> void {
+    this->support_point_cache.reset();
+    this->support_point_cache_float.reset();
+  });
 
-  support_point_cache =
-    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
-      triangulation.n_levels());
-  for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
-    (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+  support_point_cache.reset();
+  support_point_cache_float.reset();
+  if (store_support_points_in_float)
+    {
+      support_point_cache_float = std::make_shared<
+        std::vector<std::vector<std::vector<Point<spacedim, float>>>>>(
+        triangulation.n_levels());
+      for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+        (*support_point_cache_float)[l].resize(triangulation.n_raw_cells(l));
+    }
+  else
+    {
+      support_point_cache = std::make_shared<
+        std::vector<std::vector<std::vector<Point<spacedim>>>>>(
+        triangulation.n_levels());
+      for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+        (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+    }
 
+  fill_support_point_cache(triangulation, compute_points_on_cell, {});
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::fill_support_point_cache(
+  const Triangulation<dim, spacedim> &triangulation,
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &compute_points_on_cell,
+  const std::function<
+    bool(const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &cell_needs_update)
+{
   WorkStream::run(
     triangulation.begin(),
     triangulation.end(),
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
         void *,
         void *) {
-      (*support_point_cache)[cell->level()][cell->index()] =
-        compute_points_on_cell(cell);
-      AssertDimension(
-        (*support_point_cache)[cell->level()][cell->index()].size(),
-        Utilities::pow(this->get_degree() + 1, dim));
+      if (cell_needs_update && cell_needs_update(cell) == false)
+        return;
+
+      std::vector<Point<spacedim>> points = compute_points_on_cell(cell);
+      AssertDimension(points.size(),
+                      Utilities::pow(this->get_degree() + 1, dim));
+
+      if (store_support_points_in_float)
+        {
+          std::vector<Point<spacedim, float>> &points_float =
+            (*support_point_cache_float)[cell->level()][cell->index()];
+          points_float.resize(points.size());
+          for (unsigned int i = 0; i < points.size(); ++i)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              points_float[i][d] = points[i][d];
+        }
+      else
+        (*support_point_cache)[cell->level()][cell->index()] =
+          std::move(points);
     },
     /* copier */ std::function<void(void *)>(),
     /* scratch_data */ nullptr,
@@ -286,6 +336,37 @@ namespace
     temp.import(vector, VectorOperation::insert);
     vector_ghosted.import(temp, VectorOperation::insert);
   }
+
+
+
+  template <typename VectorType>
+  const LinearAlgebra::distributed::Vector<typename VectorType::value_type> *
+  get_vector_if_ghosted(const VectorType &, const IndexSet &)
+  {
+    return nullptr;
+  }
+
+
+
+  // A LinearAlgebra::distributed::Vector whose ghost values are up to date
+  // and include all locally relevant dofs can be read directly, without
+  // creating a ghosted copy
+  template <typename Number>
+  const LinearAlgebra::distributed::Vector<Number> *
+  get_vector_if_ghosted(
+    const LinearAlgebra::distributed::Vector<Number> &vector,
+    const IndexSet &                                  locally_relevant_dofs)
+  {
+    if (vector.has_ghost_elements() == false)
+      return nullptr;
+
+    IndexSet available_dofs = vector.get_partitioner()->locally_owned_range();
+    available_dofs.add_indices(vector.get_partitioner()->ghost_indices());
+    if ((locally_relevant_dofs & available_dofs) == locally_relevant_dofs)
+      return &vector;
+    else
+      return nullptr;
+  }
 } // namespace
 
 
@@ -298,6 +379,49 @@ MappingQCache<dim, spacedim>::initialize(
   const DoFHandler<dim, spacedim> &dof_handler,
   const VectorType &               vector,
   const bool                       vector_describes_relative_displacement)
+{
+  initialize_from_vector(mapping,
+                         dof_handler,
+                         vector,
+                         vector_describes_relative_displacement,
+                         nullptr);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::update(
+  const Mapping<dim, spacedim> &   mapping,
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const VectorType &               vector,
+  const IndexSet &                 changed_dofs,
+  const bool                       vector_describes_relative_displacement)
+{
+  Assert(support_point_cache.get() != nullptr ||
+           support_point_cache_float.get() != nullptr,
+         ExcMessage("Must call MappingQCache::initialize() before "
+                    "MappingQCache::update() or after mesh has changed!"));
+
+  initialize_from_vector(mapping,
+                         dof_handler,
+                         vector,
+                         vector_describes_relative_displacement,
+                         &changed_dofs);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::initialize_from_vector(
+  const Mapping<dim, spacedim> &   mapping,
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const VectorType &               vector,
+  const bool                       vector_describes_relative_displacement,
+  const IndexSet *                 changed_dofs)
 {
   AssertDimension(dof_handler.get_fe_collection().size(), 1);
   const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
@@ -315,16 +439,29 @@ MappingQCache<dim, spacedim>::initialize(
         this->get_degree()));
 
   // Step 1: copy global vector so that the ghost values are such that the
-  // cache can be set up for all ghost cells
-  LinearAlgebra::distributed::Vector<typename VectorType::value_type>
-           vector_ghosted;
+  // cache can be set up for all ghost cells, unless the given vector already
+  // holds these ghost values on all processes
   IndexSet locally_relevant_dofs;
   DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
-  vector_ghosted.reinit(dof_handler.locally_owned_dofs(),
-                        locally_relevant_dofs,
-                        dof_handler.get_communicator());
-  copy_locally_owned_data_from(vector, vector_ghosted);
-  vector_ghosted.update_ghost_values();
+  const LinearAlgebra::distributed::Vector<typename VectorType::value_type>
+    *vector_with_ghosts = get_vector_if_ghosted(vector, locally_relevant_dofs);
+  if (Utilities::MPI::min(vector_with_ghosts != nullptr ? 1 : 0,
+                          dof_handler.get_communicator()) == 0)
+    vector_with_ghosts = nullptr;
+
+  LinearAlgebra::distributed::Vector<typename VectorType::value_type>
+    vector_ghosted_copy;
+  if (vector_with_ghosts == nullptr)
+    {
+      vector_ghosted_copy.reinit(dof_handler.locally_owned_dofs(),
+                                 locally_relevant_dofs,
+                                 dof_handler.get_communicator());
+      copy_locally_owned_data_from(vector, vector_ghosted_copy);
+      vector_ghosted_copy.update_ghost_values();
+    }
+  const LinearAlgebra::distributed::Vector<typename VectorType::value_type>
+    &vector_ghosted =
+      vector_with_ghosts != nullptr ? *vector_with_ghosts : vector_ghosted_copy;
 
   // FE and FEValues in the case they are needed
   FE_Nothing<dim, spacedim> fe_nothing;
@@ -338,8 +475,7 @@ MappingQCache<dim, spacedim>::initialize(
     ((is_fe_q || is_fe_dgq) && fe.degree == this->get_degree()) == false;
 
   // Step 2: loop over all cells
-  this->initialize(
-    dof_handler.get_triangulation(),
+  const auto compute_points_on_cell =
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell_tria)
       -> std::vector<Point<spacedim>> {
       const bool is_active_non_artificial_cell =
@@ -480,6 +616,44 @@ MappingQCache<dim, spacedim>::initialize(
         }
 
       return result;
+    };
+
+  if (changed_dofs == nullptr)
+    {
+      this->initialize(dof_handler.get_triangulation(), compute_points_on_cell);
+      return;
+    }
+
+  // Step 3: in case of an update, mark the changed dofs in a ghosted vector
+  // so that the ghost cells with changed dofs are recomputed as well, and
+  // only recompute the active non-artificial cells with changed dofs
+  LinearAlgebra::distributed::Vector<float> dof_is_changed(
+    dof_handler.locally_owned_dofs(),
+    locally_relevant_dofs,
+    dof_handler.get_communicator());
+  for (const types::global_dof_index i :
+       (*changed_dofs) & dof_handler.locally_owned_dofs())
+    dof_is_changed(i) = 1.f;
+  dof_is_changed.update_ghost_values();
+
+  fill_support_point_cache(
+    dof_handler.get_triangulation(),
+    compute_points_on_cell,
+    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell_tria) {
+      if (cell_tria->is_active() == false || cell_tria->is_artificial())
+        return false;
+
+      const typename DoFHandler<dim, spacedim>::cell_iterator cell_dofs(
+        &cell_tria->get_triangulation(),
+        cell_tria->level(),
+        cell_tria->index(),
+        &dof_handler);
+      std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+      cell_dofs->get_dof_indices(dof_indices);
+      for (const types::global_dof_index i : dof_indices)
+        if (dof_is_changed(i) != 0.f)
+          return true;
+      return false;
     });
 }
 
@@ -705,6 +879,9 @@ MappingQCache<dim, spacedim>::memory_consumption() const
   if (support_point_cache.get() != nullptr)
     return sizeof(*this) +
            MemoryConsumption::memory_consumption(*support_point_cache);
+  else if (support_point_cache_float.get() != nullptr)
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(*support_point_cache_float);
   else
     return sizeof(*this);
 }
@@ -716,6 +893,24 @@ std::vector<Point<spacedim>>
 MappingQCache<dim, spacedim>::compute_mapping_support_points(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
 {
+  if (store_support_points_in_float)
+    {
+      Assert(support_point_cache_float.get() != nullptr,
+             ExcMessage("Must call MappingQCache::initialize() before "
+                        "using it or after mesh has changed!"));
+
+      AssertIndexRange(cell->level(), support_point_cache_float->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache_float)[cell->level()].size());
+      const std::vector<Point<spacedim, float>> &points_float =
+        (*support_point_cache_float)[cell->level()][cell->index()];
+      std::vector<Point<spacedim>> points(points_float.size());
+      for (unsigned int i = 0; i < points.size(); ++i)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          points[i][d] = points_float[i][d];
+      return points;
+    }
+
   Assert(support_point_cache.get() != nullptr,
          ExcMessage("Must call MappingQCache::initialize() before "
                     "using it or after mesh has changed!"));
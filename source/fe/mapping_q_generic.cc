@@ -951,6 +951,75 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
   const CellSimilarity::Similarity computed_cell_similarity =
     (polynomial_degree == 1 ? cell_similarity : CellSimilarity::none);
 
+  const UpdateFlags          update_flags = data.update_each;
+  const std::vector<double> &weights      = quadrature.get_weights();
+
+  // if the cell is an affine image of the reference cell (which includes
+  // scaled, rotated and mirrored cells, not only translated ones), the
+  // Jacobian is the same at all quadrature points and the quadrature points
+  // are an affine transformation of the reference points. in that case, we
+  // can avoid evaluating the mapping shape functions altogether, provided no
+  // derivatives of the Jacobian are requested
+  const UpdateFlags affine_flags =
+    update_quadrature_points | update_contravariant_transformation |
+    update_covariant_transformation | update_volume_elements |
+    update_JxW_values | update_jacobians | update_inverse_jacobians;
+  DerivativeForm<1, dim, spacedim> A;
+  Point<spacedim>                  b;
+  if (dim == spacedim && (update_flags & ~affine_flags) == update_default &&
+      internal::MappingQGenericImplementation::compute_affine_transformation(
+        data.mapping_support_points, unit_cell_support_points, A, b))
+    {
+      if (update_flags & update_quadrature_points)
+        {
+          AssertDimension(output_data.quadrature_points.size(), n_q_points);
+          for (unsigned int point = 0; point < n_q_points; ++point)
+            output_data.quadrature_points[point] =
+              b + apply_transformation(A, quadrature.point(point));
+        }
+
+      if (computed_cell_similarity == CellSimilarity::translation)
+        return computed_cell_similarity;
+
+      const double det = A.determinant();
+      Assert(det > 1e-12 * Utilities::fixed_power<dim>(cell->diameter() /
+                                                       std::sqrt(double(dim))),
+             (typename Mapping<dim, spacedim>::ExcDistortedMappedCell(
+               cell->center(), det, 0)));
+      const DerivativeForm<1, dim, spacedim> covariant = A.covariant_form();
+
+      if (update_flags & update_contravariant_transformation)
+        std::fill(data.contravariant.begin(), data.contravariant.end(), A);
+      if (update_flags & update_covariant_transformation)
+        std::fill(data.covariant.begin(), data.covariant.end(), covariant);
+      if (update_flags & update_volume_elements)
+        std::fill(data.volume_elements.begin(),
+                  data.volume_elements.end(),
+                  det);
+      if (update_flags & update_JxW_values)
+        {
+          AssertDimension(output_data.JxW_values.size(), n_q_points);
+          for (unsigned int point = 0; point < n_q_points; ++point)
+            output_data.JxW_values[point] = weights[point] * det;
+        }
+      if (update_flags & update_jacobians)
+        {
+          AssertDimension(output_data.jacobians.size(), n_q_points);
+          std::fill(output_data.jacobians.begin(),
+                    output_data.jacobians.end(),
+                    A);
+        }
+      if (update_flags & update_inverse_jacobians)
+        {
+          AssertDimension(output_data.inverse_jacobians.size(), n_q_points);
+          std::fill(output_data.inverse_jacobians.begin(),
+                    output_data.inverse_jacobians.end(),
+                    covariant.transpose());
+        }
+
+      return computed_cell_similarity;
+    }
+
   if (dim > 1 && data.tensor_product_quadrature)
     {
       internal::MappingQGenericImplementation::
@@ -1017,9 +1086,6 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
       data,
       output_data.jacobian_pushed_forward_3rd_derivatives);
 
-  const UpdateFlags          update_flags = data.update_each;
-  const std::vector<double> &weights      = quadrature.get_weights();
-
   // Multiply quadrature weights by absolute value of Jacobian determinants or
   // the area element g=sqrt(DX^t DX) in case of codim > 0
 
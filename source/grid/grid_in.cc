@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <map>
@@ -96,6 +97,66 @@ namespace
     // vertices except in 1d
     Assert(dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * Read a single value of type @p T from a Gmsh file. For ASCII files, the
+   * value is parsed from its text representation. For binary files, the raw
+   * bytes are read; the caller has to ask for the type that the file format
+   * prescribes at this position (int for entity tags and element types,
+   * std::size_t for node and element tags and counts, double for
+   * coordinates).
+   */
+  template <typename T>
+  T
+  read_gmsh_value(std::istream &in, const bool is_binary)
+  {
+    T value;
+    if (is_binary)
+      in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    else
+      in >> value;
+    return value;
+  }
+
+
+
+  /**
+   * Call @p function for @p cell and, recursively, for all of its descendants
+   * up to level @p max_level, in depth-first order. This is the order in
+   * which GridOut::write_compact_binary() stores all per-cell data.
+   */
+  template <typename CellIterator, typename Function>
+  void
+  for_each_cell_depth_first(const CellIterator &cell,
+                            const unsigned int  max_level,
+                            const Function &    function)
+  {
+    function(cell);
+    if (cell->has_children() &&
+        static_cast<unsigned int>(cell->level()) < max_level)
+      for (unsigned int c = 0; c < cell->n_children(); ++c)
+        for_each_cell_depth_first(cell->child(c), max_level, function);
+  }
+
+
+
+  /**
+   * Extract a value of type @p T from the raw bytes in @p buffer, starting at
+   * @p position, and advance @p position past it.
+   */
+  template <typename T>
+  T
+  extract_raw_bytes(const std::string &buffer, std::size_t &position)
+  {
+    AssertThrow(position + sizeof(T) <= buffer.size(),
+                ExcMessage("Unexpected end of the compact binary mesh file."));
+    T value;
+    std::memcpy(&value, buffer.data() + position, sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
 } // namespace
 
 template <int dim, int spacedim>
@@ -616,6 +677,152 @@ GridIn<dim, spacedim>::read_vtu(std::istream &in)
 }
 
 
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_compact_binary(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+  AssertThrow(in, ExcIO());
+
+  // read the whole file at once and parse it from memory
+  std::string buffer;
+  {
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    buffer = contents.str();
+  }
+  std::size_t position = 0;
+
+  // header
+  const std::string magic = "dealmesh";
+  AssertThrow(buffer.compare(0, magic.size(), magic) == 0,
+              ExcMessage("The input is not a mesh written by "
+                         "GridOut::write_compact_binary()."));
+  position += magic.size();
+
+  const auto version = extract_raw_bytes<std::uint32_t>(buffer, position);
+  AssertThrow(version == 1,
+              ExcMessage("Unsupported version " + std::to_string(version) +
+                         " of the compact binary mesh format."));
+  AssertThrow(extract_raw_bytes<std::uint32_t>(buffer, position) == dim &&
+                extract_raw_bytes<std::uint32_t>(buffer, position) == spacedim,
+              ExcMessage("The dimensions of the stored mesh do not match the "
+                         "dimensions of the triangulation."));
+
+  const auto n_levels = extract_raw_bytes<std::uint32_t>(buffer, position);
+  AssertThrow(n_levels > 0, ExcMessage("The stored mesh is empty."));
+  std::vector<std::uint64_t> n_cells(n_levels);
+  for (auto &n : n_cells)
+    n = extract_raw_bytes<std::uint64_t>(buffer, position);
+
+  // coarse mesh
+  {
+    std::vector<Point<spacedim>> vertices(
+      extract_raw_bytes<std::uint64_t>(buffer, position));
+    for (auto &vertex : vertices)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        vertex[d] = extract_raw_bytes<double>(buffer, position);
+
+    std::vector<CellData<dim>> cells(n_cells[0]);
+    for (auto &cell : cells)
+      {
+        cell.vertices.resize(extract_raw_bytes<std::uint8_t>(buffer, position));
+        for (auto &vertex : cell.vertices)
+          vertex = extract_raw_bytes<std::uint32_t>(buffer, position);
+      }
+
+    // the cells have been written by a triangulation, so they are already
+    // oriented consistently and need not go through GridReordering
+    tria->create_triangulation(vertices, cells, SubCellData());
+  }
+
+  // refinement tree, rebuilt level by level
+  for (unsigned int level = 0; level + 1 < n_levels; ++level)
+    {
+      for (const auto &coarse_cell : tria->cell_iterators_on_level(0))
+        for_each_cell_depth_first(coarse_cell, level, [&](const auto &cell) {
+          if (static_cast<unsigned int>(cell->level()) == level)
+            {
+              const RefinementCase<dim> refinement_case(
+                extract_raw_bytes<std::uint8_t>(buffer, position));
+              if (refinement_case != RefinementCase<dim>::no_refinement)
+                cell->set_refine_flag(refinement_case);
+            }
+        });
+
+      tria->execute_coarsening_and_refinement();
+
+      AssertThrow(tria->n_levels() > level + 1 &&
+                    tria->n_cells(level + 1) == n_cells[level + 1],
+                  ExcMessage("The refinement tree could not be reproduced. "
+                             "Make sure the triangulation uses the same mesh "
+                             "smoothing flags as the one that was written."));
+    }
+
+  // vertex locations and material, boundary and manifold ids, in the same
+  // order in which they were written
+  {
+    std::vector<bool> vertex_visited(tria->n_vertices(), false);
+    std::vector<bool> line_visited(dim > 1 ? tria->n_raw_lines() : 0, false);
+    std::vector<bool> quad_visited(dim > 2 ? tria->n_raw_quads() : 0, false);
+
+    for (const auto &coarse_cell : tria->cell_iterators_on_level(0))
+      for_each_cell_depth_first(coarse_cell, n_levels, [&](const auto &cell) {
+        for (const unsigned int v : cell->vertex_indices())
+          if (vertex_visited[cell->vertex_index(v)] == false)
+            {
+              vertex_visited[cell->vertex_index(v)] = true;
+              for (unsigned int d = 0; d < spacedim; ++d)
+                cell->vertex(v)[d] =
+                  extract_raw_bytes<double>(buffer, position);
+            }
+
+        cell->set_material_id(
+          extract_raw_bytes<types::material_id>(buffer, position));
+        cell->set_manifold_id(
+          extract_raw_bytes<types::manifold_id>(buffer, position));
+
+        if (dim == 1)
+          for (const unsigned int f : cell->face_indices())
+            if (cell->face(f)->at_boundary())
+              cell->face(f)->set_boundary_id(
+                extract_raw_bytes<types::boundary_id>(buffer, position));
+
+        if (dim > 1)
+          for (const unsigned int l : cell->line_indices())
+            if (line_visited[cell->line(l)->index()] == false)
+              {
+                line_visited[cell->line(l)->index()] = true;
+                const auto boundary_id =
+                  extract_raw_bytes<types::boundary_id>(buffer, position);
+                if (boundary_id != numbers::internal_face_boundary_id)
+                  cell->line(l)->set_boundary_id(boundary_id);
+                cell->line(l)->set_manifold_id(
+                  extract_raw_bytes<types::manifold_id>(buffer, position));
+              }
+
+        if (dim > 2)
+          for (const unsigned int f : cell->face_indices())
+            if (quad_visited[cell->face(f)->index()] == false)
+              {
+                quad_visited[cell->face(f)->index()] = true;
+                const auto boundary_id =
+                  extract_raw_bytes<types::boundary_id>(buffer, position);
+                if (boundary_id != numbers::internal_face_boundary_id)
+                  cell->face(f)->set_boundary_id(boundary_id);
+                cell->face(f)->set_manifold_id(
+                  extract_raw_bytes<types::manifold_id>(buffer, position));
+              }
+      });
+  }
+
+  AssertThrow(position == buffer.size(),
+              ExcMessage("The compact binary mesh file contains more data "
+                         "than expected."));
+}
+
+
 template <int dim, int spacedim>
 void
 GridIn<dim, spacedim>::read_unv(std::istream &in)
@@ -1446,6 +1653,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   // points, curves, surfaces and volumes. We use this information later to
   // assign boundary ids.
   std::array<std::map<int, int>, 4> tag_maps;
+  // Files of format 4.1 may store the entities, nodes and elements in
+  // binary instead of text form.
+  bool is_binary = false;
 
   in >> line;
 
@@ -1470,9 +1680,23 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       Assert((version >= 2.0) && (version <= 4.1), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version * 10);
 
-      Assert(file_type == 0, ExcNotImplemented());
+      AssertThrow(file_type == 0 || (file_type == 1 && gmsh_file_format == 41),
+                  ExcMessage("Binary Gmsh files are only supported for the "
+                             "file format 4.1."));
       Assert(data_size == sizeof(double), ExcNotImplemented());
 
+      // binary files store the integer one directly after the header line,
+      // which allows to detect files written on a machine with a different
+      // endianness
+      is_binary = (file_type == 1);
+      if (is_binary)
+        {
+          in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+          AssertThrow(read_gmsh_value<int>(in, is_binary) == 1,
+                      ExcMessage("The binary Gmsh file has been written on a "
+                                 "machine with a different endianness."));
+        }
+
       // read the end of the header and the first line of the nodes description
       // to synch ourselves with the format 1 handling above
       in >> line;
@@ -1493,116 +1717,55 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // if the next block is of kind $Entities, parse it
       if (line == "$Entities")
         {
-          unsigned long n_points, n_curves, n_surfaces, n_volumes;
-
-          in >> n_points >> n_curves >> n_surfaces >> n_volumes;
-          for (unsigned int i = 0; i < n_points; ++i)
-            {
-              // parse point ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[0]
-              if (gmsh_file_format > 40)
-                {
-                  in >> tag >> box_min_x >> box_min_y >> box_min_z >>
-                    n_physicals;
-                  box_max_x = box_min_x;
-                  box_max_y = box_min_y;
-                  box_max_z = box_min_z;
-                }
-              else
-                {
-                  in >> tag >> box_min_x >> box_min_y >> box_min_z >>
-                    box_max_x >> box_max_y >> box_max_z >> n_physicals;
-                }
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[0][tag] = physical_tag;
-            }
-          for (unsigned int i = 0; i < n_curves; ++i)
-            {
-              // parse curve ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[1]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[1][tag] = physical_tag;
-              // we don't care about the points associated to a curve, but have
-              // to parse them anyway because their format is unstructured
-              in >> n_points;
-              for (unsigned int j = 0; j < n_points; ++j)
-                in >> tag;
-            }
-
-          for (unsigned int i = 0; i < n_surfaces; ++i)
-            {
-              // parse surface ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[2]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[2][tag] = physical_tag;
-              // we don't care about the curves associated to a surface, but
-              // have to parse them anyway because their format is unstructured
-              in >> n_curves;
-              for (unsigned int j = 0; j < n_curves; ++j)
-                in >> tag;
-            }
-          for (unsigned int i = 0; i < n_volumes; ++i)
-            {
-              // parse volume ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[3]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              // if there is no physical tag, use 0 as default
-              int physical_tag = 0;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              tag_maps[3][tag] = physical_tag;
-              // we don't care about the surfaces associated to a volume, but
-              // have to parse them anyway because their format is unstructured
-              in >> n_surfaces;
-              for (unsigned int j = 0; j < n_surfaces; ++j)
-                in >> tag;
-            }
+          if (is_binary)
+            in.get();
+
+          const auto n_points   = read_gmsh_value<std::size_t>(in, is_binary);
+          const auto n_curves   = read_gmsh_value<std::size_t>(in, is_binary);
+          const auto n_surfaces = read_gmsh_value<std::size_t>(in, is_binary);
+          const auto n_volumes  = read_gmsh_value<std::size_t>(in, is_binary);
+
+          // points, curves, surfaces and volumes are all described by a tag,
+          // a bounding box (only a single point for points in format 4.1),
+          // their physical tags and (except for points) the tags of the
+          // entities bounding them
+          const std::array<std::size_t, 4> n_entities = {
+            {n_points, n_curves, n_surfaces, n_volumes}};
+          for (unsigned int entity_dim = 0; entity_dim < 4; ++entity_dim)
+            for (std::size_t i = 0; i < n_entities[entity_dim]; ++i)
+              {
+                const int tag = read_gmsh_value<int>(in, is_binary);
+
+                // we only care for 'tag' as key for tag_maps[entity_dim],
+                // but have to parse the bounding box anyway
+                const unsigned int n_box_coordinates =
+                  (entity_dim == 0 && gmsh_file_format > 40) ? 3 : 6;
+                for (unsigned int j = 0; j < n_box_coordinates; ++j)
+                  read_gmsh_value<double>(in, is_binary);
+
+                const auto n_physicals =
+                  read_gmsh_value<std::size_t>(in, is_binary);
+                // if there is a physical tag, we will use it as boundary id
+                // below
+                AssertThrow(n_physicals < 2,
+                            ExcMessage("More than one tag is not supported!"));
+                // if there is no physical tag, use 0 as default
+                int physical_tag = 0;
+                for (std::size_t j = 0; j < n_physicals; ++j)
+                  physical_tag = read_gmsh_value<int>(in, is_binary);
+                tag_maps[entity_dim][tag] = physical_tag;
+
+                // we don't care about the entities bounding a curve, surface
+                // or volume, but have to parse them anyway because their
+                // format is unstructured
+                if (entity_dim > 0)
+                  {
+                    const auto n_bounding_entities =
+                      read_gmsh_value<std::size_t>(in, is_binary);
+                    for (std::size_t j = 0; j < n_bounding_entities; ++j)
+                      read_gmsh_value<int>(in, is_binary);
+                  }
+              }
           in >> line;
           AssertThrow(line == "$EndEntities", ExcInvalidGMSHInput(line));
           in >> line;
@@ -1623,15 +1786,19 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // in any case, be the list of
       // nodes:
       AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
+      if (is_binary)
+        in.get();
     }
 
   // now read the nodes list
   int n_entity_blocks = 1;
   if (gmsh_file_format > 40)
     {
-      int min_node_tag;
-      int max_node_tag;
-      in >> n_entity_blocks >> n_vertices >> min_node_tag >> max_node_tag;
+      n_entity_blocks = read_gmsh_value<std::size_t>(in, is_binary);
+      n_vertices      = read_gmsh_value<std::size_t>(in, is_binary);
+      // ignore the minimal and maximal node tag
+      read_gmsh_value<std::size_t>(in, is_binary);
+      read_gmsh_value<std::size_t>(in, is_binary);
     }
   else if (gmsh_file_format == 40)
     {
@@ -1657,24 +1824,28 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             numNodes   = n_vertices;
             parametric = 0;
           }
+        else if (gmsh_file_format == 40)
+          {
+            int tagEntity, dimEntity;
+            in >> tagEntity >> dimEntity >> parametric >> numNodes;
+          }
         else
           {
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             // but we are ignoring both anyway.
-            int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> parametric >> numNodes;
+            read_gmsh_value<int>(in, is_binary);
+            read_gmsh_value<int>(in, is_binary);
+            parametric = read_gmsh_value<int>(in, is_binary);
+            numNodes   = read_gmsh_value<std::size_t>(in, is_binary);
           }
 
         std::vector<int> vertex_numbers;
-        int              vertex_number;
         if (gmsh_file_format > 40)
-          for (unsigned long vertex_per_entity = 0;
-               vertex_per_entity < numNodes;
-               ++vertex_per_entity)
-            {
-              in >> vertex_number;
-              vertex_numbers.push_back(vertex_number);
-            }
+          {
+            vertex_numbers.resize(numNodes);
+            for (int &vertex_number : vertex_numbers)
+              vertex_number = read_gmsh_value<std::size_t>(in, is_binary);
+          }
 
         for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes;
              ++vertex_per_entity, ++global_vertex)
@@ -1686,7 +1857,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             if (gmsh_file_format > 40)
               {
                 vertex_number = vertex_numbers[vertex_per_entity];
-                in >> x[0] >> x[1] >> x[2];
+                for (double &coordinate : x)
+                  coordinate = read_gmsh_value<double>(in, is_binary);
               }
             else
               in >> vertex_number >> x[0] >> x[1] >> x[2];
@@ -1699,11 +1871,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             // ignore parametric coordinates
             if (parametric != 0)
               {
-                double u = 0.;
-                double v = 0.;
-                in >> u >> v;
-                (void)u;
-                (void)v;
+                read_gmsh_value<double>(in, is_binary);
+                read_gmsh_value<double>(in, is_binary);
               }
           }
       }
@@ -1721,13 +1890,17 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   static const std::string begin_elements_marker[] = {"$ELM", "$Elements"};
   AssertThrow(line == begin_elements_marker[gmsh_file_format == 10 ? 0 : 1],
               ExcInvalidGMSHInput(line));
+  if (is_binary)
+    in.get();
 
   // now read the cell list
   if (gmsh_file_format > 40)
     {
-      int min_node_tag;
-      int max_node_tag;
-      in >> n_entity_blocks >> n_cells >> min_node_tag >> max_node_tag;
+      n_entity_blocks = read_gmsh_value<std::size_t>(in, is_binary);
+      n_cells         = read_gmsh_value<std::size_t>(in, is_binary);
+      // ignore the minimal and maximal element tag
+      read_gmsh_value<std::size_t>(in, is_binary);
+      read_gmsh_value<std::size_t>(in, is_binary);
     }
   else if (gmsh_file_format == 40)
     {
@@ -1749,6 +1922,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   bool                                       is_tria_or_tet_mesh = false;
 
   {
+    // the (gmsh) node numbers of the current element
+    std::vector<unsigned int> node_indices;
+
     unsigned int global_cell = 0;
     for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
       {
@@ -1771,9 +1947,11 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
         else
           {
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
-            int tagEntity, dimEntity;
-            in >> dimEntity >> tagEntity >> cell_type >> numElements;
-            material_id = tag_maps[dimEntity][tagEntity];
+            const int dimEntity = read_gmsh_value<int>(in, is_binary);
+            const int tagEntity = read_gmsh_value<int>(in, is_binary);
+            cell_type           = read_gmsh_value<int>(in, is_binary);
+            numElements         = read_gmsh_value<std::size_t>(in, is_binary);
+            material_id         = tag_maps[dimEntity][tagEntity];
           }
 
         for (unsigned int cell_per_entity = 0; cell_per_entity < numElements;
@@ -1786,7 +1964,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             // so check this:
             AssertThrow(in, ExcIO());
 
-            unsigned int nod_num;
+            unsigned int nod_num = 0;
 
             /*
               For file format version 1, the format of each cell is as follows:
@@ -1844,12 +2022,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                   nod_num = 4;
                 else if (cell_type == 5) // hex
                   nod_num = 8;
+                else if (cell_type == 15) // point
+                  nod_num = 1;
               }
             else
               {
                 // ignore tag
-                int tag;
-                in >> tag;
+                read_gmsh_value<std::size_t>(in, is_binary);
 
                 if (cell_type == 1) // line
                   nod_num = 2;
@@ -1861,8 +2040,16 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                   nod_num = 4;
                 else if (cell_type == 5) // hex
                   nod_num = 8;
+                else if (cell_type == 15) // point
+                  nod_num = 1;
               }
 
+            // read the node numbers of this element (unknown element types
+            // have no nodes at this point and are rejected below)
+            node_indices.resize(nod_num);
+            for (unsigned int &node_index : node_indices)
+              node_index = read_gmsh_value<std::size_t>(in, is_binary);
+
 
             /*       `ELM-TYPE'
                      defines the geometrical type of the N-th element:
@@ -1930,12 +2117,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                     if (vertices_per_cell ==
                         GeometryInfo<dim>::vertices_per_cell)
                       {
-                        in >> cells.back()
-                                .vertices[GeometryInfo<dim>::ucd_to_deal[i]];
+                        cells.back()
+                          .vertices[GeometryInfo<dim>::ucd_to_deal[i]] =
+                          node_indices[i];
                       }
                     else
                       {
-                        in >> cells.back().vertices[i];
+                        cells.back().vertices[i] = node_indices[i];
                       }
                   }
 
@@ -1970,9 +2158,14 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             else if ((cell_type == 1) && ((dim == 2) || (dim == 3)))
               // boundary info
               {
+                AssertThrow(nod_num == 2,
+                            ExcMessage(
+                              "Number of nodes does not coincide with the "
+                              "number required for this object"));
+
                 subcelldata.boundary_lines.emplace_back();
-                in >> subcelldata.boundary_lines.back().vertices[0] >>
-                  subcelldata.boundary_lines.back().vertices[1];
+                subcelldata.boundary_lines.back().vertices[0] = node_indices[0];
+                subcelldata.boundary_lines.back().vertices[1] = node_indices[1];
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -2026,9 +2219,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 // resize vertices
                 subcelldata.boundary_quads.back().vertices.resize(
                   vertices_per_cell);
-                // for loop
+                AssertThrow(nod_num == vertices_per_cell,
+                            ExcMessage(
+                              "Number of nodes does not coincide with the "
+                              "number required for this object"));
                 for (unsigned int i = 0; i < vertices_per_cell; ++i)
-                  in >> subcelldata.boundary_quads.back().vertices[i];
+                  subcelldata.boundary_quads.back().vertices[i] =
+                    node_indices[i];
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -2062,19 +2259,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               }
             else if (cell_type == 15)
               {
-                // read the indices of nodes given
-                unsigned int node_index = 0;
-                if (gmsh_file_format < 20)
-                  {
-                    // For points (cell_type==15), we can only ever
-                    // list one node index.
-                    AssertThrow(nod_num == 1, ExcInternalError());
-                    in >> node_index;
-                  }
-                else
-                  {
-                    in >> node_index;
-                  }
+                // For points (cell_type==15), we can only ever
+                // list one node index.
+                AssertThrow(nod_num == 1, ExcInternalError());
+                const unsigned int node_index = node_indices[0];
 
                 // we only care about boundary indicators assigned to individual
                 // vertices in 1d (because otherwise the vertices are not faces)
@@ -3577,7 +3765,11 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
     }
   else
     {
-      std::ifstream in(name.c_str());
+      // msh files may contain binary data, which must not be subject to
+      // any newline translation
+      std::ifstream in(name.c_str(),
+                       format == msh ? std::ios::in | std::ios::binary :
+                                       std::ios::in);
       read(in, format);
     }
 }
@@ -3633,6 +3633,164 @@ GridOut::write_vtu(const Triangulation<dim, spacedim> &tria,
 
 
 
+namespace
+{
+  /**
+   * Call @p function for @p cell and, recursively, for all of its descendants
+   * up to level @p max_level, in depth-first order. Since this order only
+   * depends on the refinement tree and not on the internal numbering of the
+   * cells, GridOut::write_compact_binary() uses it to store all per-cell data,
+   * and GridIn::read_compact_binary() reproduces it.
+   */
+  template <typename CellIterator, typename Function>
+  void
+  for_each_cell_depth_first(const CellIterator &cell,
+                            const unsigned int  max_level,
+                            const Function &    function)
+  {
+    function(cell);
+    if (cell->has_children() &&
+        static_cast<unsigned int>(cell->level()) < max_level)
+      for (unsigned int c = 0; c < cell->n_children(); ++c)
+        for_each_cell_depth_first(cell->child(c), max_level, function);
+  }
+
+
+
+  /**
+   * Append the raw bytes of @p value to @p buffer.
+   */
+  template <typename T>
+  void
+  append_raw_bytes(std::vector<char> &buffer, const T value)
+  {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridOut::write_compact_binary(const Triangulation<dim, spacedim> &tria,
+                              std::ostream &                      out) const
+{
+  AssertThrow(out, ExcIO());
+
+  // assemble the whole file in memory and write it with a single call
+  std::vector<char> buffer;
+
+  // header: magic string, version of the format, and dimensions
+  const std::string magic = "dealmesh";
+  buffer.insert(buffer.end(), magic.begin(), magic.end());
+  append_raw_bytes<std::uint32_t>(buffer, 1);
+  append_raw_bytes<std::uint32_t>(buffer, dim);
+  append_raw_bytes<std::uint32_t>(buffer, spacedim);
+
+  const unsigned int n_levels = tria.n_levels();
+  append_raw_bytes<std::uint32_t>(buffer, n_levels);
+  for (unsigned int level = 0; level < n_levels; ++level)
+    append_raw_bytes<std::uint64_t>(buffer, tria.n_cells(level));
+
+  // coarse mesh: vertices (numbered in the order in which they are first
+  // used) and connectivity of the cells on level 0
+  {
+    std::vector<unsigned int> coarse_vertex_indices(
+      tria.n_vertices(), numbers::invalid_unsigned_int);
+    std::vector<Point<spacedim>> coarse_vertices;
+    for (const auto &cell : tria.cell_iterators_on_level(0))
+      for (const unsigned int v : cell->vertex_indices())
+        if (coarse_vertex_indices[cell->vertex_index(v)] ==
+            numbers::invalid_unsigned_int)
+          {
+            coarse_vertex_indices[cell->vertex_index(v)] =
+              coarse_vertices.size();
+            coarse_vertices.push_back(cell->vertex(v));
+          }
+
+    append_raw_bytes<std::uint64_t>(buffer, coarse_vertices.size());
+    for (const auto &vertex : coarse_vertices)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        append_raw_bytes<double>(buffer, vertex[d]);
+
+    for (const auto &cell : tria.cell_iterators_on_level(0))
+      {
+        append_raw_bytes<std::uint8_t>(buffer, cell->n_vertices());
+        for (const unsigned int v : cell->vertex_indices())
+          append_raw_bytes<std::uint32_t>(
+            buffer, coarse_vertex_indices[cell->vertex_index(v)]);
+      }
+  }
+
+  // refinement tree: the refinement case of each cell on all but the finest
+  // level
+  for (unsigned int level = 0; level + 1 < n_levels; ++level)
+    for (const auto &coarse_cell : tria.cell_iterators_on_level(0))
+      for_each_cell_depth_first(coarse_cell, level, [&](const auto &cell) {
+        if (static_cast<unsigned int>(cell->level()) == level)
+          append_raw_bytes<std::uint8_t>(buffer, cell->refinement_case());
+      });
+
+  // the data attached to the cells and to their vertices, faces and edges;
+  // objects shared between cells are stored only once, with the first cell
+  // in depth-first order that uses them
+  {
+    std::vector<bool> vertex_visited(tria.n_vertices(), false);
+    std::vector<bool> line_visited(dim > 1 ? tria.n_raw_lines() : 0, false);
+    std::vector<bool> quad_visited(dim > 2 ? tria.n_raw_quads() : 0, false);
+
+    for (const auto &coarse_cell : tria.cell_iterators_on_level(0))
+      for_each_cell_depth_first(coarse_cell, n_levels, [&](const auto &cell) {
+        for (const unsigned int v : cell->vertex_indices())
+          if (vertex_visited[cell->vertex_index(v)] == false)
+            {
+              vertex_visited[cell->vertex_index(v)] = true;
+              for (unsigned int d = 0; d < spacedim; ++d)
+                append_raw_bytes<double>(buffer, cell->vertex(v)[d]);
+            }
+
+        append_raw_bytes<types::material_id>(buffer, cell->material_id());
+        append_raw_bytes<types::manifold_id>(buffer, cell->manifold_id());
+
+        // in 1d, the faces are vertices, which only carry boundary ids
+        if (dim == 1)
+          for (const unsigned int f : cell->face_indices())
+            if (cell->face(f)->at_boundary())
+              append_raw_bytes<types::boundary_id>(
+                buffer, cell->face(f)->boundary_id());
+
+        if (dim > 1)
+          for (const unsigned int l : cell->line_indices())
+            if (line_visited[cell->line(l)->index()] == false)
+              {
+                line_visited[cell->line(l)->index()] = true;
+                append_raw_bytes<types::boundary_id>(
+                  buffer, cell->line(l)->boundary_id());
+                append_raw_bytes<types::manifold_id>(
+                  buffer, cell->line(l)->manifold_id());
+              }
+
+        if (dim > 2)
+          for (const unsigned int f : cell->face_indices())
+            if (quad_visited[cell->face(f)->index()] == false)
+              {
+                quad_visited[cell->face(f)->index()] = true;
+                append_raw_bytes<types::boundary_id>(
+                  buffer, cell->face(f)->boundary_id());
+                append_raw_bytes<types::manifold_id>(
+                  buffer, cell->face(f)->manifold_id());
+              }
+      });
+  }
+
+  out.write(buffer.data(), buffer.size());
+  out << std::flush;
+  AssertThrow(out, ExcIO());
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridOut::write_mesh_per_processor_as_vtu(
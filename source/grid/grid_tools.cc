@@ -16,9 +16,14 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_consensus_algorithms.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
+#ifdef DEAL_II_WITH_ARBORX
+#  include <deal.II/arborx/bvh.h>
+#endif
+
 #include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/p4est_wrappers.h>
 #include <deal.II/distributed/shared_tria.h>
@@ -62,6 +67,7 @@ DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 #include <boost/random/uniform_real_distribution.hpp>
 DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
@@ -2669,6 +2675,54 @@ namespace GridTools
 
 
 
+  namespace internal
+  {
+    /**
+     * Return the weights of all active cells as provided by the functions
+     * attached to the Triangulation::Signals::cell_weight signal, or an
+     * empty vector if no function is attached.
+     */
+    template <int dim, int spacedim>
+    std::vector<unsigned int>
+    get_cell_weights(const Triangulation<dim, spacedim> &triangulation)
+    {
+      std::vector<unsigned int> cell_weights;
+
+      // Get cell weighting if a signal has been attached to the triangulation
+      if (!triangulation.signals.cell_weight.empty())
+        {
+          cell_weights.resize(triangulation.n_active_cells(), 0U);
+
+          // In a first step, obtain the weights of the locally owned
+          // cells. For all others, the weight remains at the zero the
+          // vector was initialized with above.
+          for (const auto &cell : triangulation.active_cell_iterators())
+            if (cell->is_locally_owned())
+              cell_weights[cell->active_cell_index()] =
+                triangulation.signals.cell_weight(
+                  cell,
+                  Triangulation<dim, spacedim>::CellStatus::CELL_PERSIST);
+
+          // If this is a parallel triangulation, we then need to also
+          // get the weights for all other cells. The callers of this
+          // function assert that it isn't used for
+          // parallel::distribute::Triangulation objects, so the only
+          // ones we have to worry about here are
+          // parallel::shared::Triangulation
+          if (const auto shared_tria = dynamic_cast<
+                const parallel::shared::Triangulation<dim, spacedim> *>(
+                &triangulation))
+            Utilities::MPI::sum(cell_weights,
+                                shared_tria->get_communicator(),
+                                cell_weights);
+        }
+
+      return cell_weights;
+    }
+  } // namespace internal
+
+
+
   template <int dim, int spacedim>
   void
   partition_triangulation(const unsigned int               n_partitions,
@@ -2681,35 +2735,8 @@ namespace GridTools
                       "are already partitioned implicitly and can not be "
                       "partitioned again explicitly."));
 
-    std::vector<unsigned int> cell_weights;
-
-    // Get cell weighting if a signal has been attached to the triangulation
-    if (!triangulation.signals.cell_weight.empty())
-      {
-        cell_weights.resize(triangulation.n_active_cells(), 0U);
-
-        // In a first step, obtain the weights of the locally owned
-        // cells. For all others, the weight remains at the zero the
-        // vector was initialized with above.
-        for (const auto &cell : triangulation.active_cell_iterators())
-          if (cell->is_locally_owned())
-            cell_weights[cell->active_cell_index()] =
-              triangulation.signals.cell_weight(
-                cell, Triangulation<dim, spacedim>::CellStatus::CELL_PERSIST);
-
-        // If this is a parallel triangulation, we then need to also
-        // get the weights for all other cells. We have asserted above
-        // that this function can't be used for
-        // parallel::distribute::Triangulation objects, so the only
-        // ones we have to worry about here are
-        // parallel::shared::Triangulation
-        if (const auto shared_tria =
-              dynamic_cast<parallel::shared::Triangulation<dim, spacedim> *>(
-                &triangulation))
-          Utilities::MPI::sum(cell_weights,
-                              shared_tria->get_communicator(),
-                              cell_weights);
-      }
+    const std::vector<unsigned int> cell_weights =
+      internal::get_cell_weights(triangulation);
 
     // Call the other more general function
     partition_triangulation(n_partitions,
@@ -3001,6 +3028,103 @@ namespace GridTools
   }
 
 
+
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int            n_partitions,
+                                  Triangulation<dim, spacedim> &triangulation)
+  {
+    Assert((dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+              &triangulation) == nullptr),
+           ExcMessage("Objects of type parallel::distributed::Triangulation "
+                      "are already partitioned implicitly and can not be "
+                      "partitioned again explicitly."));
+    Assert(n_partitions > 0, ExcInvalidNumberOfPartitions(n_partitions));
+
+    // signal that partitioning is going to happen
+    triangulation.signals.pre_partition();
+
+    // check for an easy return
+    if (n_partitions == 1)
+      {
+        for (const auto &cell : triangulation.active_cell_iterators())
+          cell->set_subdomain_id(0);
+        return;
+      }
+
+    // the weights have to be queried before any subdomain id is changed,
+    // since they are only evaluated on locally owned cells
+    const std::vector<unsigned int> cell_weights =
+      internal::get_cell_weights(triangulation);
+
+    const unsigned int n_active_cells = triangulation.n_active_cells();
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                 cells(n_active_cells);
+    std::vector<Point<spacedim>> centers(n_active_cells);
+    for (const auto &cell : triangulation.active_cell_iterators())
+      cells[cell->active_cell_index()] = cell;
+
+    // computing the centers is the only part that involves the geometry of
+    // the cells, so do it in parallel
+    parallel::apply_to_subranges(
+      0U,
+      n_active_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          centers[i] = cells[i]->center();
+      },
+      1000);
+
+    // the indices along the curve are returned as spacedim-tuples of
+    // integers that can be compared lexicographically
+    const std::vector<std::array<std::uint64_t, spacedim>> curve_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers);
+
+    std::vector<unsigned int> permutation(n_active_cells);
+    std::iota(permutation.begin(), permutation.end(), 0U);
+    std::sort(permutation.begin(),
+              permutation.end(),
+              [&](const unsigned int a, const unsigned int b) {
+                return curve_indices[a] < curve_indices[b] ||
+                       (curve_indices[a] == curve_indices[b] && a < b);
+              });
+
+    // cut the sequence of cells into pieces of equal weight. a cell is
+    // assigned to the partition that contains the midpoint of its weight
+    // interval, so that heavy cells are not all pushed to the next
+    // partition
+    std::uint64_t total_weight = 0;
+    if (cell_weights.empty())
+      total_weight = n_active_cells;
+    else
+      total_weight = std::accumulate(cell_weights.begin(),
+                                     cell_weights.end(),
+                                     std::uint64_t(0));
+
+    std::uint64_t weight_so_far = 0;
+    for (unsigned int i = 0; i < n_active_cells; ++i)
+      {
+        const unsigned int  index = permutation[i];
+        const std::uint64_t weight =
+          cell_weights.empty() ? 1 : cell_weights[index];
+
+        // if all cells have zero weight, fall back to cutting by count
+        const types::subdomain_id subdomain =
+          total_weight == 0 ?
+            static_cast<types::subdomain_id>(std::uint64_t(i) * n_partitions /
+                                             n_active_cells) :
+            static_cast<types::subdomain_id>(
+              std::min<std::uint64_t>((2 * weight_so_far + weight) *
+                                        n_partitions / (2 * total_weight),
+                                      n_partitions - 1));
+        cells[index]->set_subdomain_id(subdomain);
+
+        weight_so_far += weight;
+      }
+  }
+
+
   template <int dim, int spacedim>
   void
   partition_multigrid_levels(Triangulation<dim, spacedim> &triangulation)
@@ -4527,9 +4651,62 @@ namespace GridTools
                              std::move(maps_out),
                              std::move(missing_points_out));
 
+    // Buffers for the points treated together in the last used cell
+    std::vector<Point<spacedim>> batch_real_points;
+    std::vector<Point<dim>>      batch_unit_points;
+
     // Cycle over all points left
     for (unsigned int p = points_checked; p < np; ++p)
       {
+        // Points are often sorted such that many consecutive points lie in
+        // the same cell. If the last used cell is the candidate, we collect
+        // all following points within its bounding box and compute their
+        // reference coordinates with a single call to the mapping, which
+        // evaluates several points at once with vectorization (for
+        // MappingQGeneric) and computes the mapping support points of the
+        // cell only once. The points that turn out to be outside the cell
+        // are passed on to the general search below.
+        if (cell_candidate_idx != -1 &&
+            box_cell[cell_candidate_idx].second == cells_out.back())
+          {
+            const BoundingBox<spacedim> &box =
+              box_cell[cell_candidate_idx].first;
+            unsigned int p_end = p;
+            while (p_end < np && box.point_inside(points[p_end]))
+              ++p_end;
+
+            if (p_end > p + 1)
+              {
+                const unsigned int p_begin = p;
+                batch_real_points.assign(points.begin() + p_begin,
+                                         points.begin() + p_end);
+                batch_unit_points.resize(batch_real_points.size());
+                cache.get_mapping().transform_points_real_to_unit_cell(
+                  cells_out.back(),
+                  make_array_view(batch_real_points),
+                  make_array_view(batch_unit_points));
+
+                for (; p < p_end; ++p)
+                  if (GeometryInfo<dim>::is_inside_unit_cell(
+                        batch_unit_points[p - p_begin], 1e-10))
+                    {
+                      qpoints_out.back().emplace_back(
+                        batch_unit_points[p - p_begin]);
+                      maps_out.back().emplace_back(p);
+                    }
+                  else
+                    break;
+
+                // if all points of the batch were found in the cell, go on
+                // with the next point, which is outside the bounding box
+                if (p == p_end)
+                  {
+                    p = p_end - 1;
+                    continue;
+                  }
+              }
+          }
+
         // We assume the last used cell contains the point: checking it
         if (cell_candidate_idx != -1)
           if (!box_cell[cell_candidate_idx].first.point_inside(points[p]))
@@ -4768,6 +4945,58 @@ namespace GridTools
 
   namespace internal
   {
+#ifdef DEAL_II_WITH_ARBORX
+    /**
+     * Find the boxes of @p boxes_and_ranks that contain the @p points with a
+     * threaded batched query of an ArborX bounding volume hierarchy, and
+     * append the pairs of the rank of the box and the index of the point to
+     * @p ranks_and_indices. Return false without doing anything if Kokkos is
+     * not initialized, which ArborX requires.
+     */
+    template <int spacedim>
+    bool
+    query_point_owners_with_arborx(
+      const std::vector<std::pair<BoundingBox<spacedim>, unsigned int>>
+        &                                                 boxes_and_ranks,
+      const std::vector<Point<spacedim>> &                points,
+      std::vector<std::pair<unsigned int, unsigned int>> &ranks_and_indices)
+    {
+      if (!Kokkos::is_initialized())
+        return false;
+
+      std::vector<BoundingBox<spacedim>> boxes;
+      boxes.reserve(boxes_and_ranks.size());
+      for (const auto &box_and_rank : boxes_and_ranks)
+        boxes.push_back(box_and_rank.first);
+
+      ArborXWrappers::BVH                           bvh(boxes);
+      const ArborXWrappers::PointIntersectPredicate intersect(points);
+      const auto indices_and_offsets = bvh.query(intersect);
+
+      const std::vector<int> &indices = indices_and_offsets.first;
+      const std::vector<int> &offsets = indices_and_offsets.second;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        for (int j = offsets[i]; j < offsets[i + 1]; ++j)
+          ranks_and_indices.emplace_back(boxes_and_ranks[indices[j]].second, i);
+
+      return true;
+    }
+
+
+
+    // The ArborX wrappers are not available in 1d.
+    bool
+    query_point_owners_with_arborx(
+      const std::vector<std::pair<BoundingBox<1>, unsigned int>> &,
+      const std::vector<Point<1>> &,
+      std::vector<std::pair<unsigned int, unsigned int>> &)
+    {
+      return false;
+    }
+#endif
+
+
+
     template <int spacedim>
     std::tuple<std::vector<unsigned int>,
                std::vector<unsigned int>,
@@ -4776,23 +5005,63 @@ namespace GridTools
       const std::vector<std::vector<BoundingBox<spacedim>>> &global_bboxes,
       const std::vector<Point<spacedim>> &                   points)
     {
+      // Collect the boxes of all processes together with their ranks. The
+      // boxes are enlarged by the tolerance of BoundingBox::point_inside(),
+      // so that a point lies in an enlarged box exactly if it is inside the
+      // original one.
+      const double tolerance = std::numeric_limits<double>::epsilon();
+      std::vector<std::pair<BoundingBox<spacedim>, unsigned int>>
+        boxes_and_ranks;
+      for (unsigned int rank = 0; rank < global_bboxes.size(); ++rank)
+        for (const auto &box : global_bboxes[rank])
+          {
+            Point<spacedim> lower = box.get_boundary_points().first;
+            Point<spacedim> upper = box.get_boundary_points().second;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                const double extent = tolerance * std::abs(upper[d] - lower[d]);
+                lower[d] -= extent;
+                upper[d] += extent;
+              }
+            boxes_and_ranks.emplace_back(
+              BoundingBox<spacedim>(std::make_pair(lower, upper)), rank);
+          }
+
+      // Find the boxes that contain the points with a spatial index instead
+      // of testing every point against all boxes of all processes. If
+      // available, ArborX builds and queries the index in parallel.
       std::vector<std::pair<unsigned int, unsigned int>> ranks_and_indices;
       ranks_and_indices.reserve(points.size());
 
-      for (unsigned int i = 0; i < points.size(); ++i)
+      bool found_with_arborx = false;
+#ifdef DEAL_II_WITH_ARBORX
+      found_with_arborx =
+        query_point_owners_with_arborx(boxes_and_ranks,
+                                       points,
+                                       ranks_and_indices);
+#endif
+      if (!found_with_arborx)
         {
-          const auto &point = points[i];
-          for (unsigned rank = 0; rank < global_bboxes.size(); ++rank)
-            for (const auto &box : global_bboxes[rank])
-              if (box.point_inside(point))
-                {
-                  ranks_and_indices.emplace_back(rank, i);
-                  break;
-                }
+          const auto tree = pack_rtree(boxes_and_ranks);
+
+          std::vector<std::pair<BoundingBox<spacedim>, unsigned int>>
+            search_result;
+          for (unsigned int i = 0; i < points.size(); ++i)
+            {
+              search_result.clear();
+              tree.query(boost::geometry::index::intersects(points[i]),
+                         std::back_inserter(search_result));
+              for (const auto &box_and_rank : search_result)
+                ranks_and_indices.emplace_back(box_and_rank.second, i);
+            }
         }
 
-      // convert to CRS
+      // convert to CRS, counting every rank only once per point even if
+      // several of its boxes contain the point
       std::sort(ranks_and_indices.begin(), ranks_and_indices.end());
+      ranks_and_indices.erase(std::unique(ranks_and_indices.begin(),
+                                          ranks_and_indices.end()),
+                              ranks_and_indices.end());
 
       std::vector<unsigned int> ranks;
       std::vector<unsigned int> ptr;
@@ -16,10 +16,18 @@
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi.h>
 
+#include <deal.II/distributed/tria_base.h>
+
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <iterator>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
@@ -28,20 +36,86 @@ namespace GridTools
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
     : update_flags(update_all)
+    , incremental_update_flags(update_nothing)
+    , prune_used_vertices(false)
+    , refinement_in_progress(false)
     , tria(&tria)
     , mapping(&mapping)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    // Before the mesh is refined, decide which of the cached objects are
+    // going to be updated cell by cell. The RTree of locally owned cells
+    // can only be kept for serial triangulations, since the owners of the
+    // cells of parallel triangulations may change during refinement.
+    tria_signals.push_back(tria.signals.pre_refinement.connect([this]() {
+      refinement_in_progress = true;
+
+      if (incremental_update_flags == update_nothing)
+        {
+          cells_to_add.clear();
+          prune_used_vertices = false;
+
+          CacheUpdateFlags flags =
+            update_used_vertices | update_used_vertices_rtree |
+            update_cell_bounding_boxes_rtree;
+          if (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+                &*this->tria) == nullptr)
+            flags |= update_locally_owned_cell_bounding_boxes_rtree;
+          incremental_update_flags = flags & ~update_flags;
+        }
+    }));
+
+    // The children of a coarsened cell disappear, so remove them right
+    // away while their iterators are still valid, and add the parent once
+    // it has become active.
+    tria_signals.push_back(tria.signals.pre_coarsening_on_cell.connect(
+      [this](
+        const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        if (incremental_update_flags == update_nothing)
+          return;
+
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          {
+            remove_from_cell_rtrees(cell->child(c));
+            cells_to_add.erase(cell->child(c));
+          }
+        prune_used_vertices = true;
+
+        if (!is_scheduled_for_addition(cell))
+          cells_to_add.insert(cell);
+      }));
+
+    tria_signals.push_back(tria.signals.post_refinement_on_cell.connect(
+      [this](
+        const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        if (incremental_update_flags == update_nothing)
+          return;
+
+        remove_from_cell_rtrees(cell);
+        if (!is_scheduled_for_addition(cell))
+          cells_to_add.insert(cell);
+      }));
+
+    // Everything that is not updated cell by cell has to be recomputed
+    // after any change of the triangulation
+    tria_signals.push_back(tria.signals.any_change.connect([this]() {
+      if (refinement_in_progress)
+        {
+          refinement_in_progress = false;
+          mark_for_update(update_all & ~incremental_update_flags);
+        }
+      else
+        mark_for_update(update_all);
+    }));
   }
 
   template <int dim, int spacedim>
   Cache<dim, spacedim>::~Cache()
   {
-    // Make sure that the signals that was attached to the triangulation
-    // is removed here.
-    if (tria_signal.connected())
-      tria_signal.disconnect();
+    // Make sure that the signals that were attached to the triangulation
+    // are removed here.
+    for (auto &connection : tria_signals)
+      if (connection.connected())
+        connection.disconnect();
   }
 
 
@@ -51,6 +125,215 @@ namespace GridTools
   Cache<dim, spacedim>::mark_for_update(const CacheUpdateFlags &flags)
   {
     update_flags |= flags;
+
+    // objects that are recomputed from scratch do not need to be updated
+    // cell by cell any more
+    incremental_update_flags &= ~flags;
+    if (incremental_update_flags == update_nothing)
+      {
+        cells_to_add.clear();
+        prune_used_vertices = false;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::mark_cells_for_update(
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator> &cells)
+  {
+    // bring the cached objects up to date with the current mesh before
+    // removing the entries of the moved cells
+    apply_incremental_updates();
+
+    mark_for_update(update_vertex_to_cell_centers_directions |
+                    update_covering_rtree);
+
+    CacheUpdateFlags flags = update_used_vertices | update_used_vertices_rtree |
+                             update_cell_bounding_boxes_rtree |
+                             update_locally_owned_cell_bounding_boxes_rtree;
+    incremental_update_flags = flags & ~update_flags;
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    std::vector<bool> moved(tria->n_active_cells(), false);
+    for (const auto &cell : cells)
+      {
+        moved[cell->active_cell_index()] = true;
+        cells_to_add.insert(cell);
+      }
+
+    // find the entries of the moved cells in a single traversal of each
+    // tree, since their old bounding boxes are not known any more
+    const auto remove_moved_cells = [&](auto &rtree) {
+      std::vector<typename std::decay<decltype(rtree)>::type::value_type>
+        entries;
+      rtree.query(boost::geometry::index::satisfies([&](const auto &entry) {
+                    return moved[entry.second->active_cell_index()];
+                  }),
+                  std::back_inserter(entries));
+      for (const auto &entry : entries)
+        rtree.remove(entry);
+    };
+
+    if (incremental_update_flags & update_cell_bounding_boxes_rtree)
+      remove_moved_cells(cell_bounding_boxes_rtree);
+    if (incremental_update_flags &
+        update_locally_owned_cell_bounding_boxes_rtree)
+      remove_moved_cells(locally_owned_cell_bounding_boxes_rtree);
+
+    if (incremental_update_flags & update_used_vertices)
+      for (const auto &cell : cells)
+        for (const unsigned int v : cell->vertex_indices())
+          {
+            const auto vertex = used_vertices.find(cell->vertex_index(v));
+            if (vertex != used_vertices.end())
+              {
+                if (incremental_update_flags & update_used_vertices_rtree)
+                  used_vertices_rtree.remove(
+                    std::make_pair(vertex->second, vertex->first));
+                used_vertices.erase(vertex);
+              }
+          }
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  Cache<dim, spacedim>::is_scheduled_for_addition(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+  {
+    for (auto c = cell;; c = c->parent())
+      {
+        if (cells_to_add.find(c) != cells_to_add.end())
+          return true;
+        if (c->level() == 0)
+          return false;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::remove_from_cell_rtrees(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    // the entries of cells that have not been added yet can not be removed
+    if (is_scheduled_for_addition(cell))
+      return;
+
+    const BoundingBox<spacedim> box = mapping->get_bounding_box(cell);
+
+    const auto remove_cell = [&](auto &rtree, const CacheUpdateFlags flag) {
+      if (!(incremental_update_flags & flag))
+        return;
+
+      std::vector<typename std::decay<decltype(rtree)>::type::value_type>
+        entries;
+      rtree.query(boost::geometry::index::intersects(box) &&
+                    boost::geometry::index::satisfies(
+                      [&](const auto &entry) {
+                        return typename Triangulation<dim, spacedim>::
+                                 cell_iterator(entry.second) == cell;
+                      }),
+                  std::back_inserter(entries));
+
+      // if the cell has moved without us being told, we can not find its
+      // entry any more and have to rebuild the tree from scratch
+      if (entries.size() == 1)
+        rtree.remove(entries[0]);
+      else
+        mark_for_update(flag);
+    };
+
+    remove_cell(cell_bounding_boxes_rtree, update_cell_bounding_boxes_rtree);
+    remove_cell(locally_owned_cell_bounding_boxes_rtree,
+                update_locally_owned_cell_bounding_boxes_rtree);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::apply_incremental_updates() const
+  {
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    // the RTree of used vertices can only be updated together with the
+    // map of used vertices
+    if (!(incremental_update_flags & update_used_vertices) &&
+        (incremental_update_flags & update_used_vertices_rtree))
+      {
+        update_flags |= update_used_vertices_rtree;
+        incremental_update_flags &= ~update_used_vertices_rtree;
+      }
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      new_cells;
+    for (const auto &cell : cells_to_add)
+      if (cell->is_active())
+        new_cells.emplace_back(cell);
+      else
+        {
+          const auto children =
+            GridTools::get_active_child_cells<Triangulation<dim, spacedim>>(
+              cell);
+          new_cells.insert(new_cells.end(), children.begin(), children.end());
+        }
+
+    if (incremental_update_flags & update_used_vertices)
+      {
+        if (prune_used_vertices)
+          {
+            const std::vector<bool> &vertex_used = tria->get_used_vertices();
+            for (auto vertex = used_vertices.begin();
+                 vertex != used_vertices.end();)
+              if (vertex_used[vertex->first] == false)
+                {
+                  if (incremental_update_flags & update_used_vertices_rtree)
+                    used_vertices_rtree.remove(
+                      std::make_pair(vertex->second, vertex->first));
+                  vertex = used_vertices.erase(vertex);
+                }
+              else
+                ++vertex;
+          }
+
+        for (const auto &cell : new_cells)
+          {
+            const auto vertices = mapping->get_vertices(cell);
+            for (const unsigned int v : cell->vertex_indices())
+              if (used_vertices.emplace(cell->vertex_index(v), vertices[v])
+                    .second &&
+                  (incremental_update_flags & update_used_vertices_rtree))
+                used_vertices_rtree.insert(
+                  std::make_pair(vertices[v], cell->vertex_index(v)));
+          }
+      }
+
+    if (incremental_update_flags &
+        (update_cell_bounding_boxes_rtree |
+         update_locally_owned_cell_bounding_boxes_rtree))
+      for (const auto &cell : new_cells)
+        {
+          const BoundingBox<spacedim> box = mapping->get_bounding_box(cell);
+          if (incremental_update_flags & update_cell_bounding_boxes_rtree)
+            cell_bounding_boxes_rtree.insert(std::make_pair(box, cell));
+          if ((incremental_update_flags &
+               update_locally_owned_cell_bounding_boxes_rtree) &&
+              cell->is_locally_owned())
+            locally_owned_cell_bounding_boxes_rtree.insert(
+              std::make_pair(box, cell));
+        }
+
+    cells_to_add.clear();
+    prune_used_vertices      = false;
+    incremental_update_flags = update_nothing;
   }
 
 
@@ -89,6 +372,8 @@ namespace GridTools
   const std::map<unsigned int, Point<spacedim>> &
   Cache<dim, spacedim>::get_used_vertices() const
   {
+    apply_incremental_updates();
+
     if (update_flags & update_used_vertices)
       {
         used_vertices = GridTools::extract_used_vertices(*tria, *mapping);
@@ -103,6 +388,8 @@ namespace GridTools
   const RTree<std::pair<Point<spacedim>, unsigned int>> &
   Cache<dim, spacedim>::get_used_vertices_rtree() const
   {
+    apply_incremental_updates();
+
     if (update_flags & update_used_vertices_rtree)
       {
         const auto &used_vertices = get_used_vertices();
@@ -125,6 +412,8 @@ namespace GridTools
               typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_cell_bounding_boxes_rtree() const
   {
+    apply_incremental_updates();
+
     if (update_flags & update_cell_bounding_boxes_rtree)
       {
         std::vector<std::pair<
@@ -149,6 +438,8 @@ namespace GridTools
               typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_locally_owned_cell_bounding_boxes_rtree() const
   {
+    apply_incremental_updates();
+
     if (update_flags & update_locally_owned_cell_bounding_boxes_rtree)
       {
         std::vector<std::pair<
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
 
@@ -41,6 +42,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <list>
 #include <map>
 #include <numeric>
@@ -2053,39 +2055,122 @@ namespace GridTools
     }
 #endif
 
-    unsigned int n_matches = 0;
-
-    // Match with a complexity of O(n^2). This could be improved...
-    std::bitset<3> orientation;
-    using PairIterator =
-      typename std::set<std::pair<CellIterator, unsigned int>>::const_iterator;
-    for (PairIterator it1 = pairs1.begin(); it1 != pairs1.end(); ++it1)
-      {
-        for (PairIterator it2 = pairs2.begin(); it2 != pairs2.end(); ++it2)
+    // Match the faces by sorting the centers of the faces in pairs2 into a
+    // grid of boxes in the plane orthogonal to the periodic direction, and
+    // then only comparing each face in pairs1 with the faces in the boxes
+    // around the image of its center. If the vertices of two faces match up
+    // to the tolerance used in orthogonal_equality(), so do their centers,
+    // and with boxes at least as large as this tolerance all candidates are
+    // found in the neighboring boxes. Since the faces do not overlap, a box
+    // size in the order of the size of the cells keeps the number of faces
+    // per box small, and the matching has a complexity of O(n log n).
+    using FacePair = std::pair<CellIterator, unsigned int>;
+    const std::vector<FacePair> faces1(pairs1.begin(), pairs1.end());
+    const std::vector<FacePair> faces2(pairs2.begin(), pairs2.end());
+
+    double box_size = std::numeric_limits<double>::max();
+    for (const FacePair &face : faces2)
+      box_size = std::min(box_size, face.first->minimum_vertex_distance());
+    box_size = std::max(0.5 * box_size, 1.e-10);
+
+    using BoxIndex = std::array<long long int, space_dim>;
+    const auto get_box_index = [&](const Point<space_dim> &point) {
+      BoxIndex index;
+      for (int d = 0; d < space_dim; ++d)
+        index[d] =
+          (d == direction) ?
+            0 :
+            static_cast<long long int>(std::floor(point[d] / box_size));
+      return index;
+    };
+
+    std::map<BoxIndex, std::vector<unsigned int>> boxes;
+    for (unsigned int i = 0; i < faces2.size(); ++i)
+      boxes[get_box_index(faces2[i].first->face(faces2[i].second)->center())]
+        .push_back(i);
+
+    // For each face in pairs1, find all faces in pairs2 it matches, together
+    // with the orientation of the match. These searches are independent of
+    // each other and are done in parallel.
+    std::vector<std::vector<std::pair<unsigned int, std::bitset<3>>>> matches(
+      faces1.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(faces1.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<unsigned int> candidates;
+        for (unsigned int i = begin; i < end; ++i)
           {
-            const CellIterator cell1     = it1->first;
-            const CellIterator cell2     = it2->first;
-            const unsigned int face_idx1 = it1->second;
-            const unsigned int face_idx2 = it2->second;
-            if (GridTools::orthogonal_equality(orientation,
-                                               cell1->face(face_idx1),
-                                               cell2->face(face_idx2),
-                                               direction,
-                                               offset,
-                                               matrix))
+            const Point<space_dim> center =
+              faces1[i].first->face(faces1[i].second)->center();
+            Point<space_dim> image;
+            if (matrix.m() == space_dim)
+              for (int d = 0; d < space_dim; ++d)
+                for (int e = 0; e < space_dim; ++e)
+                  image(d) += matrix(d, e) * center(e);
+            else
+              image = center;
+            image += offset;
+
+            // collect the faces in the 3^(space_dim-1) boxes around the
+            // image, in the order in which they appear in pairs2
+            const BoxIndex box_index = get_box_index(image);
+            candidates.clear();
+            for (int n = 0; n < Utilities::pow(3, space_dim); ++n)
               {
-                // We have a match, so insert the matching pairs and
-                // remove the matched cell in pairs2 to speed up the
-                // matching:
-                const PeriodicFacePair<CellIterator> matched_face = {
-                  {cell1, cell2}, {face_idx1, face_idx2}, orientation, matrix};
-                matched_pairs.push_back(matched_face);
-                pairs2.erase(it2);
-                ++n_matches;
-                break;
+                BoxIndex neighbor_index = box_index;
+                bool     is_valid       = true;
+                for (int d = 0, m = n; d < space_dim; ++d, m /= 3)
+                  {
+                    if (d == direction && m % 3 != 1)
+                      is_valid = false;
+                    neighbor_index[d] += m % 3 - 1;
+                  }
+                if (!is_valid)
+                  continue;
+
+                const auto box = boxes.find(neighbor_index);
+                if (box != boxes.end())
+                  candidates.insert(candidates.end(),
+                                    box->second.begin(),
+                                    box->second.end());
               }
+            std::sort(candidates.begin(), candidates.end());
+
+            std::bitset<3> orientation;
+            for (const unsigned int j : candidates)
+              if (GridTools::orthogonal_equality(
+                    orientation,
+                    faces1[i].first->face(faces1[i].second),
+                    faces2[j].first->face(faces2[j].second),
+                    direction,
+                    offset,
+                    matrix))
+                matches[i].emplace_back(j, orientation);
+          }
+      },
+      /* grainsize */ 64);
+
+    // Now assign to each face in pairs1 the first face in pairs2 it matches
+    // that has not been matched before, insert the matching pairs, and
+    // remove the matched faces from pairs2:
+    std::vector<bool> is_matched(faces2.size(), false);
+    unsigned int      n_matches = 0;
+    for (unsigned int i = 0; i < faces1.size(); ++i)
+      for (const auto &match : matches[i])
+        if (!is_matched[match.first])
+          {
+            const PeriodicFacePair<CellIterator> matched_face = {
+              {faces1[i].first, faces2[match.first].first},
+              {faces1[i].second, faces2[match.first].second},
+              match.second,
+              matrix};
+            matched_pairs.push_back(matched_face);
+            pairs2.erase(faces2[match.first]);
+            is_matched[match.first] = true;
+            ++n_matches;
+            break;
           }
-      }
 
     // Assure that all faces are matched if not
     // parallel::fullydistributed::Triangulation is used. This is related to the
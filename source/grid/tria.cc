@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
@@ -40,6 +41,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <set>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -1477,8 +1479,12 @@ namespace internal
               tria_objects.boundary_or_material_id.reserve(new_size);
               tria_objects.boundary_or_material_id.resize(new_size);
 
-              tria_objects.user_data.reserve(new_size);
-              tria_objects.user_data.resize(new_size);
+              // the user data is allocated lazily, see TriaObjects::user_data
+              if (tria_objects.user_data.empty() == false)
+                {
+                  tria_objects.user_data.reserve(new_size);
+                  tria_objects.user_data.resize(new_size);
+                }
 
               tria_objects.manifold_id.reserve(new_size);
               tria_objects.manifold_id.insert(tria_objects.manifold_id.end(),
@@ -1552,8 +1558,12 @@ namespace internal
                                                 tria_objects.manifold_id.size(),
                                               numbers::flat_manifold_id);
 
-              tria_objects.user_data.reserve(new_size);
-              tria_objects.user_data.resize(new_size);
+              // the user data is allocated lazily, see TriaObjects::user_data
+              if (tria_objects.user_data.empty() == false)
+                {
+                  tria_objects.user_data.reserve(new_size);
+                  tria_objects.user_data.resize(new_size);
+                }
 
               tria_objects.refinement_cases.reserve(new_size);
               tria_objects.refinement_cases.insert(
@@ -1588,7 +1598,8 @@ namespace internal
       Assert(tria_object.n_objects() == tria_object.manifold_id.size(),
              ExcMemoryInexact(tria_object.n_objects(),
                               tria_object.manifold_id.size()));
-      Assert(tria_object.n_objects() == tria_object.user_data.size(),
+      Assert(tria_object.user_data.empty() ||
+               tria_object.n_objects() == tria_object.user_data.size(),
              ExcMemoryInexact(tria_object.n_objects(),
                               tria_object.user_data.size()));
 
@@ -2738,7 +2749,7 @@ namespace internal
             BoundaryOrMaterialId());
         obj.manifold_id.assign(size, -1);
         obj.user_flags.assign(size, false);
-        obj.user_data.resize(size);
+        obj.user_data.clear();
 
         if (structdim > 1) // TODO: why?
           obj.refinement_cases.assign(size, 0);
@@ -3655,7 +3666,10 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &next_unused_cell,
-        const typename Triangulation<2, spacedim>::cell_iterator &cell)
+        const typename Triangulation<2, spacedim>::cell_iterator &cell,
+        std::vector<
+          std::pair<typename Triangulation<2, spacedim>::cell_iterator,
+                    std::pair<unsigned int, bool>>> &new_cell_vertices)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -3791,24 +3805,23 @@ namespace internal
             // ones. If this is
             // not the case, then
             // we need to ask a
-            // boundary object
+            // boundary object.
+            // the location is
+            // computed by the
+            // caller once all
+            // cells of this level
+            // have been refined
             if (dim == spacedim)
               {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
                 // if the user_flag is set, i.e. if the cell is at the
                 // boundary, use a different calculation of the middle vertex
                 // here. this is of advantage if the boundary is strongly
                 // curved (whereas the cell is not) and the cell has a high
                 // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
+                const bool use_interpolation = cell->user_flag_set();
+                cell->clear_user_flag();
+                new_cell_vertices.emplace_back(
+                  cell, std::make_pair(next_unused_vertex, use_interpolation));
               }
             else
               {
@@ -3822,8 +3835,8 @@ namespace internal
                 // determine middle vertex by transfinite interpolation to be
                 // consistent with what happens to quads in a Triangulation<3,
                 // 3> when they are refined
-                triangulation.vertices[next_unused_vertex] =
-                  cell->center(true, true);
+                new_cell_vertices.emplace_back(
+                  cell, std::make_pair(next_unused_vertex, true));
               }
           }
 
@@ -4063,6 +4076,66 @@ namespace internal
 
 
 
+      /**
+       * Compute the locations of vertices that were created in the middle of
+       * the objects in @p new_vertices during refinement, where the second
+       * entry of each pair is the index of the new vertex. The refinement
+       * functions first set up the topology of the new objects for all
+       * objects of a kind serially, collecting the new vertices, and then
+       * call this function to query the manifolds for the new locations,
+       * which is typically the most expensive part of the refinement of
+       * curved meshes. Since the locations of the new vertices only depend
+       * on the vertices of the parent objects, these queries are
+       * independent of each other and are run in parallel.
+       */
+      template <int dim, int spacedim, typename IteratorType>
+      static void
+      compute_new_vertex_locations(
+        Triangulation<dim, spacedim> &triangulation,
+        const std::vector<std::pair<IteratorType, unsigned int>> &new_vertices,
+        const bool interpolate_from_surrounding)
+      {
+        dealii::parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(new_vertices.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              triangulation.vertices[new_vertices[i].second] =
+                new_vertices[i].first->center(true,
+                                              interpolate_from_surrounding);
+          },
+          /* grainsize */ 256);
+      }
+
+
+
+      /**
+       * Same as above, but with an individual choice for each new vertex of
+       * whether its location is interpolated from the surrounding objects.
+       * The second entry of each pair contains the index of the new vertex
+       * and this choice.
+       */
+      template <int dim, int spacedim, typename IteratorType>
+      static void
+      compute_new_vertex_locations(
+        Triangulation<dim, spacedim> &triangulation,
+        const std::vector<
+          std::pair<IteratorType, std::pair<unsigned int, bool>>> &new_vertices)
+      {
+        dealii::parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(new_vertices.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              triangulation.vertices[new_vertices[i].second.first] =
+                new_vertices[i].first->center(true,
+                                              new_vertices[i].second.second);
+          },
+          /* grainsize */ 256);
+      }
+
+
+
       template <int dim, int spacedim>
       static typename Triangulation<dim, spacedim>::DistortedCellList
       execute_refinement_isotropic(Triangulation<dim, spacedim> &triangulation,
@@ -4183,6 +4256,13 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the new vertices in the middle of the refined lines, whose
+          // locations are computed after the loop
+          std::vector<std::pair<
+            typename Triangulation<dim, spacedim>::active_line_iterator,
+            unsigned int>>
+            new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -4198,7 +4278,7 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_line_vertices.emplace_back(line, next_unused_vertex);
 
                 bool pair_found = false;
                 (void)pair_found;
@@ -4249,6 +4329,11 @@ namespace internal
 
                 line->clear_user_flag();
               }
+
+          // now compute the locations of the new vertices
+          compute_new_vertex_locations(triangulation,
+                                       new_line_vertices,
+                                       false);
         }
 
         reserve_space(triangulation.faces->lines, 0, n_single_lines);
@@ -4259,11 +4344,17 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
-        const auto create_children = [](auto &        triangulation,
-                                        unsigned int &next_unused_vertex,
-                                        auto &        next_unused_line,
-                                        auto &        next_unused_cell,
-                                        const auto &  cell) {
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                    std::pair<unsigned int, bool>>>
+          new_cell_vertices;
+
+        const auto create_children = [&new_cell_vertices](
+                                       auto &        triangulation,
+                                       unsigned int &next_unused_vertex,
+                                       auto &        next_unused_line,
+                                       auto &        next_unused_cell,
+                                       const auto &  cell) {
           const auto ref_case = cell->refine_flag_set();
           cell->clear_refine_flag();
 
@@ -4298,25 +4389,13 @@ namespace internal
 
               new_vertices[8] = next_unused_vertex;
 
-              if (dim == spacedim)
-                {
-                  triangulation.vertices[next_unused_vertex] =
-                    cell->center(true);
-
-                  if (cell->user_flag_set())
-                    {
-                      cell->clear_user_flag();
-                      triangulation.vertices[next_unused_vertex] =
-                        cell->center(true, true);
-                    }
-                }
-              else
-                {
-                  cell->clear_user_flag();
-
-                  triangulation.vertices[next_unused_vertex] =
-                    cell->center(true, true);
-                }
+              // the location of the new vertex is computed once all cells
+              // of this level have been refined
+              const bool use_interpolation =
+                (dim == spacedim ? cell->user_flag_set() : true);
+              cell->clear_user_flag();
+              new_cell_vertices.emplace_back(
+                cell, std::make_pair(next_unused_vertex, use_interpolation));
             }
 
           std::array<typename Triangulation<dim, spacedim>::raw_line_iterator,
@@ -4574,6 +4653,10 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+              refined_cells;
+            new_cell_vertices.clear();
+
             for (const auto &cell :
                  triangulation.active_cell_iterators_on_level(level))
               if (cell->refine_flag_set())
@@ -4587,15 +4670,21 @@ namespace internal
                                   next_unused_cell,
                                   cell);
 
-                  if (cell->reference_cell() ==
-                        dealii::ReferenceCells::Quadrilateral &&
-                      check_for_distorted_cells &&
-                      has_distorted_children<dim, spacedim>(cell))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      cell);
-
-                  triangulation.signals.post_refinement_on_cell(cell);
+                  refined_cells.push_back(cell);
                 }
+
+            compute_new_vertex_locations(triangulation, new_cell_vertices);
+
+            for (const auto &cell : refined_cells)
+              {
+                if (cell->reference_cell() ==
+                      dealii::ReferenceCells::Quadrilateral &&
+                    check_for_distorted_cells &&
+                    has_distorted_children<dim, spacedim>(cell))
+                  cells_with_distorted_children.distorted_cells.push_back(cell);
+
+                triangulation.signals.post_refinement_on_cell(cell);
+              }
           }
 
         return cells_with_distorted_children;
@@ -4700,6 +4789,11 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            std::vector<
+              std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                        unsigned int>>
+              new_cell_vertices;
+
             for (const auto &cell :
                  triangulation.active_cell_iterators_on_level(level))
               if (cell->refine_flag_set())
@@ -4719,9 +4813,9 @@ namespace internal
 
                   // Now we always ask the cell itself where to put
                   // the new point. The cell in turn will query the
-                  // manifold object internally.
-                  triangulation.vertices[next_unused_vertex] =
-                    cell->center(true);
+                  // manifold object internally, which happens for all
+                  // cells of this level at once below.
+                  new_cell_vertices.emplace_back(cell, next_unused_vertex);
 
                   triangulation.vertices_used[next_unused_vertex] = true;
 
@@ -4830,9 +4924,16 @@ namespace internal
                           right_neighbor->set_neighbor(nbnb, second_child);
                         }
                     }
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(cell);
                 }
+
+            compute_new_vertex_locations(triangulation,
+                                         new_cell_vertices,
+                                         false);
+
+            // inform all listeners that cell refinement is done
+            for (const auto &new_cell_vertex : new_cell_vertices)
+              triangulation.signals.post_refinement_on_cell(
+                new_cell_vertex.first);
           }
 
         // in 1d, we can not have distorted children unless the parent
@@ -5043,6 +5144,13 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the new vertices in the middle of the refined lines, whose
+          // locations are computed after the loop
+          std::vector<std::pair<
+            typename Triangulation<dim, spacedim>::active_line_iterator,
+            unsigned int>>
+            new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5058,7 +5166,7 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_line_vertices.emplace_back(line, next_unused_vertex);
 
                 // now that we created the right point, make up the
                 // two child lines.  To this end, find a pair of
@@ -5121,6 +5229,11 @@ namespace internal
                 // refinement
                 line->clear_user_flag();
               }
+
+          // now compute the locations of the new vertices
+          compute_new_vertex_locations(triangulation,
+                                       new_line_vertices,
+                                       false);
         }
 
 
@@ -5145,6 +5258,13 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+              refined_cells;
+            std::vector<
+              std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                        std::pair<unsigned int, bool>>>
+              new_cell_vertices;
+
             for (const auto &cell :
                  triangulation.active_cell_iterators_on_level(level))
               if (cell->refine_flag_set())
@@ -5164,15 +5284,24 @@ namespace internal
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
+                                  cell,
+                                  new_cell_vertices);
 
-                  if (check_for_distorted_cells &&
-                      has_distorted_children<dim, spacedim>(cell))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      cell);
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(cell);
+                  refined_cells.push_back(cell);
                 }
+
+            // now compute the locations of the vertices in the middle of
+            // the refined cells, which are needed for the distortion check
+            compute_new_vertex_locations(triangulation, new_cell_vertices);
+
+            for (const auto &cell : refined_cells)
+              {
+                if (check_for_distorted_cells &&
+                    has_distorted_children<dim, spacedim>(cell))
+                  cells_with_distorted_children.distorted_cells.push_back(cell);
+                // inform all listeners that cell refinement is done
+                triangulation.signals.post_refinement_on_cell(cell);
+              }
           }
 
         return cells_with_distorted_children;
@@ -5514,6 +5643,13 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the new vertices in the middle of the refined lines, whose
+          // locations are computed after the loop
+          std::vector<std::pair<
+            typename Triangulation<dim, spacedim>::active_line_iterator,
+            unsigned int>>
+            new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5529,7 +5665,7 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_line_vertices.emplace_back(line, next_unused_vertex);
 
                 // now that we created the right point, make up the
                 // two child lines (++ takes care of the end of the
@@ -5585,6 +5721,11 @@ namespace internal
                 // for refinement
                 line->clear_user_flag();
               }
+
+          // now compute the locations of the new vertices
+          compute_new_vertex_locations(triangulation,
+                                       new_line_vertices,
+                                       false);
         }
 
 
@@ -5611,6 +5752,15 @@ namespace internal
         // anisotropically (this is transformed to case c), however we
         // might have to renumber/rename children...)
 
+        // the new vertices in the middle of isotropically refined quads,
+        // whose locations are computed after the loop. note that the
+        // locations of these vertices are not needed for the refinement of
+        // other quads, which only involves the vertices on lines
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::quad_iterator,
+                    unsigned int>>
+          new_quad_vertices;
+
         // we need a loop in cases c) and d), as the anisotropic
         // children migt have a lower index than the mother quad
         for (unsigned int loop = 0; loop < 2; ++loop)
@@ -6285,9 +6435,9 @@ namespace internal
                     // minimize the distortion of the four new quads from the
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
-                    // implementation
-                    triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                    // implementation. the location is computed after the
+                    // loop, together with the ones of all other quads
+                    new_quad_vertices.emplace_back(quad, next_unused_vertex);
                     triangulation.vertices_used[next_unused_vertex] = true;
 
                     // now that we created the right point, make up
@@ -6519,6 +6669,9 @@ namespace internal
               }     // for all quads
           }         // looped two times over all quads, all quads refined now
 
+        // now compute the locations of the new vertices in the quads
+        compute_new_vertex_locations(triangulation, new_quad_vertices, true);
+
         ///////////////////////////////////
         // Now, finally, set up the new
         // cells
@@ -6539,6 +6692,16 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_hex_iterator
               next_unused_hex = triangulation.begin_raw_hex(level + 1);
 
+            // the hexes refined on this level and the vertices in their
+            // middle, whose locations are computed once the topology of
+            // all of these hexes has been set up
+            std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+              refined_hexes;
+            std::vector<
+              std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                        unsigned int>>
+              new_hex_vertices;
+
             for (; hex != endh; ++hex)
               if (hex->refine_flag_set())
                 {
@@ -8797,9 +8960,10 @@ namespace internal
                           // boundary. However we need to worry about
                           // Manifolds. Let the cell compute its own
                           // center, by querying the underlying manifold
-                          // object.
-                          triangulation.vertices[next_unused_vertex] =
-                            hex->center(true, true);
+                          // object, once all hexes of this level are
+                          // refined.
+                          new_hex_vertices.emplace_back(hex,
+                                                        next_unused_vertex);
 
                           // set the data of the six lines.  first collect
                           // the indices of the seven vertices (consider
@@ -9528,19 +9692,26 @@ namespace internal
                         new_hexes[current_child]->set_face_rotation(f, f_ro[f]);
                       }
 
-                  // now see if we have created cells that are
-                  // distorted and if so add them to our list
-                  if (check_for_distorted_cells &&
-                      has_distorted_children<dim, spacedim>(hex))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      hex);
-
                   // note that the refinement flag was already cleared
                   // at the beginning of this loop
 
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(hex);
+                  refined_hexes.push_back(hex);
                 }
+
+            compute_new_vertex_locations(triangulation, new_hex_vertices, true);
+
+            for (const auto &refined_hex : refined_hexes)
+              {
+                // now see if we have created cells that are
+                // distorted and if so add them to our list
+                if (check_for_distorted_cells &&
+                    has_distorted_children<dim, spacedim>(refined_hex))
+                  cells_with_distorted_children.distorted_cells.push_back(
+                    refined_hex);
+
+                // inform all listeners that cell refinement is done
+                triangulation.signals.post_refinement_on_cell(refined_hex);
+              }
           }
 
         // clear user data on quads. we used some of this data to
@@ -10105,6 +10276,8 @@ Triangulation<dim, spacedim>::Triangulation(
   , periodic_face_pairs_level_0(std::move(tria.periodic_face_pairs_level_0))
   , periodic_face_map(std::move(tria.periodic_face_map))
   , levels(std::move(tria.levels))
+  , active_cell_levels_and_indices(
+      std::move(tria.active_cell_levels_and_indices))
   , faces(std::move(tria.faces))
   , vertices(std::move(tria.vertices))
   , vertices_used(std::move(tria.vertices_used))
@@ -10140,6 +10313,9 @@ operator=(Triangulation<dim, spacedim> &&tria) noexcept
   vertex_to_boundary_id_map_1d = std::move(tria.vertex_to_boundary_id_map_1d);
   vertex_to_manifold_id_map_1d = std::move(tria.vertex_to_manifold_id_map_1d);
 
+  active_cell_levels_and_indices =
+    std::move(tria.active_cell_levels_and_indices);
+
   tria.number_cache = internal::TriangulationImplementation::NumberCache<dim>();
 
   return *this;
@@ -10438,6 +10614,7 @@ Triangulation<dim, spacedim>::copy_triangulation(
     levels.push_back(
       std::make_unique<internal::TriangulationImplementation::TriaLevel>(
         *other_tria.levels[level]));
+  active_cell_levels_and_indices = other_tria.active_cell_levels_and_indices;
 
   number_cache = other_tria.number_cache;
 
@@ -12111,6 +12288,29 @@ Triangulation<dim, spacedim>::create_cell_iterator(const CellId &cell_id) const
 
 
 
+template <int dim, int spacedim>
+typename Triangulation<dim, spacedim>::active_cell_iterator
+Triangulation<dim, spacedim>::get_active_cell_iterator(
+  const unsigned int active_cell_index) const
+{
+  AssertIndexRange(active_cell_index, active_cell_levels_and_indices.size());
+  return active_cell_iterator(
+    const_cast<Triangulation<dim, spacedim> *>(this),
+    active_cell_levels_and_indices[active_cell_index].first,
+    active_cell_levels_and_indices[active_cell_index].second);
+}
+
+
+
+template <int dim, int spacedim>
+const std::vector<std::pair<unsigned int, unsigned int>> &
+Triangulation<dim, spacedim>::get_active_cell_levels_and_indices() const
+{
+  return active_cell_levels_and_indices;
+}
+
+
+
 template <int dim, int spacedim>
 typename Triangulation<dim, spacedim>::cell_iterator
 Triangulation<dim, spacedim>::end() const
@@ -13426,6 +13626,9 @@ template <int dim, int spacedim>
 void
 Triangulation<dim, spacedim>::reset_active_cell_indices()
 {
+  active_cell_levels_and_indices.clear();
+  active_cell_levels_and_indices.reserve(n_active_cells());
+
   unsigned int active_cell_index = 0;
   for (raw_cell_iterator cell = begin_raw(); cell != end(); ++cell)
     if ((cell->used() == false) || cell->has_children())
@@ -13433,6 +13636,8 @@ Triangulation<dim, spacedim>::reset_active_cell_indices()
     else
       {
         cell->set_active_cell_index(active_cell_index);
+        active_cell_levels_and_indices.emplace_back(cell->level(),
+                                                    cell->index());
         ++active_cell_index;
       }
 
@@ -13569,6 +13774,7 @@ void
 Triangulation<dim, spacedim>::clear_despite_subscriptions()
 {
   levels.clear();
+  active_cell_levels_and_indices.clear();
   faces.reset();
 
   vertices.clear();
@@ -14669,445 +14875,469 @@ Triangulation<dim, spacedim>::prepare_coarsening_and_refinement()
       //    global loop. when this function terminates, the
       //    requirement will be fulfilled. However, it might be faster
       //    to insert an inner loop here.
+      //
+      //    this step only adds refine flags. it is therefore sufficient
+      //    to visit the cells flagged for refinement, collected once
+      //    below and ordered like the active cell iterators, plus the
+      //    neighbors that get flagged along the way. traversing this set
+      //    backwards, with newly flagged cells visited in the same sweep
+      //    if they come after the current one, gives the same result as
+      //    a backward loop over all active cells
+      std::set<std::pair<int, int>> refine_flagged_cells;
+      for (const auto &cell : active_cell_iterators())
+        if (cell->refine_flag_set())
+          refine_flagged_cells.emplace(cell->level(), cell->index());
+
       bool changed = true;
       while (changed)
         {
-          changed                   = false;
-          active_cell_iterator cell = last_active(), endc = end();
+          changed = false;
 
-          for (; cell != endc; --cell)
-            if (cell->refine_flag_set())
-              {
-                // loop over neighbors of cell
-                for (const auto i : cell->face_indices())
-                  {
-                    // only do something if the face is not at the
-                    // boundary and if the face will be refined with
-                    // the RefineCase currently flagged for
-                    const bool has_periodic_neighbor =
-                      cell->has_periodic_neighbor(i);
-                    const bool has_neighbor_or_periodic_neighbor =
-                      !cell->at_boundary(i) || has_periodic_neighbor;
-                    if (has_neighbor_or_periodic_neighbor &&
-                        GeometryInfo<dim>::face_refinement_case(
-                          cell->refine_flag_set(), i) !=
-                          RefinementCase<dim - 1>::no_refinement)
-                      {
-                        // 1) if the neighbor has children: nothing to
-                        // worry about.  2) if the neighbor is active
-                        // and a coarser one, ensure, that its
-                        // refine_flag is set 3) if the neighbor is
-                        // active and as refined along the face as our
-                        // current cell, make sure, that no
-                        // coarsen_flag is set. if we remove the
-                        // coarsen flag of our neighbor,
-                        // fix_coarsen_flags() makes sure, that the
-                        // mother cell will not be coarsened
-                        if (cell->neighbor_or_periodic_neighbor(i)->is_active())
-                          {
-                            if ((!has_periodic_neighbor &&
-                                 cell->neighbor_is_coarser(i)) ||
-                                (has_periodic_neighbor &&
-                                 cell->periodic_neighbor_is_coarser(i)))
-                              {
-                                if (cell->neighbor_or_periodic_neighbor(i)
-                                      ->coarsen_flag_set())
-                                  cell->neighbor_or_periodic_neighbor(i)
-                                    ->clear_coarsen_flag();
-                                // we'll set the refine flag for this
-                                // neighbor below. we note, that we
-                                // have changed something by setting
-                                // the changed flag to true. We do not
-                                // need to do so, if we just removed
-                                // the coarsen flag, as the changed
-                                // flag only indicates the need to
-                                // re-run the inner loop. however, we
-                                // only loop over cells flagged for
-                                // refinement here, so nothing to
-                                // worry about if we remove coarsen
-                                // flags
-
-                                if (dim == 2)
-                                  {
-                                    if (smooth_grid &
-                                        allow_anisotropic_smoothing)
-                                      changed =
-                                        has_periodic_neighbor ?
-                                          cell->periodic_neighbor(i)
-                                            ->flag_for_face_refinement(
-                                              cell
-                                                ->periodic_neighbor_of_coarser_periodic_neighbor(
-                                                  i)
-                                                .first,
-                                              RefinementCase<dim - 1>::cut_x) :
-                                          cell->neighbor(i)
-                                            ->flag_for_face_refinement(
-                                              cell
-                                                ->neighbor_of_coarser_neighbor(
-                                                  i)
-                                                .first,
-                                              RefinementCase<dim - 1>::cut_x);
-                                    else
+          for (auto entry = refine_flagged_cells.rbegin();
+               entry != refine_flagged_cells.rend();
+               ++entry)
+            {
+              active_cell_iterator cell(this, entry->first, entry->second);
+
+              // loop over neighbors of cell
+              for (const auto i : cell->face_indices())
+                {
+                  // only do something if the face is not at the
+                  // boundary and if the face will be refined with
+                  // the RefineCase currently flagged for
+                  const bool has_periodic_neighbor =
+                    cell->has_periodic_neighbor(i);
+                  const bool has_neighbor_or_periodic_neighbor =
+                    !cell->at_boundary(i) || has_periodic_neighbor;
+                  if (has_neighbor_or_periodic_neighbor &&
+                      GeometryInfo<dim>::face_refinement_case(
+                        cell->refine_flag_set(), i) !=
+                        RefinementCase<dim - 1>::no_refinement)
+                    {
+                      // 1) if the neighbor has children: nothing to
+                      // worry about.  2) if the neighbor is active
+                      // and a coarser one, ensure, that its
+                      // refine_flag is set 3) if the neighbor is
+                      // active and as refined along the face as our
+                      // current cell, make sure, that no
+                      // coarsen_flag is set. if we remove the
+                      // coarsen flag of our neighbor,
+                      // fix_coarsen_flags() makes sure, that the
+                      // mother cell will not be coarsened
+                      if (cell->neighbor_or_periodic_neighbor(i)->is_active())
+                        {
+                          if ((!has_periodic_neighbor &&
+                               cell->neighbor_is_coarser(i)) ||
+                              (has_periodic_neighbor &&
+                               cell->periodic_neighbor_is_coarser(i)))
+                            {
+                              if (cell->neighbor_or_periodic_neighbor(i)
+                                    ->coarsen_flag_set())
+                                cell->neighbor_or_periodic_neighbor(i)
+                                  ->clear_coarsen_flag();
+                              // we'll set the refine flag for this
+                              // neighbor below. we note, that we
+                              // have changed something by setting
+                              // the changed flag to true. We do not
+                              // need to do so, if we just removed
+                              // the coarsen flag, as the changed
+                              // flag only indicates the need to
+                              // re-run the inner loop. however, we
+                              // only loop over cells flagged for
+                              // refinement here, so nothing to
+                              // worry about if we remove coarsen
+                              // flags
+
+                              if (dim == 2)
+                                {
+                                  if (smooth_grid &
+                                      allow_anisotropic_smoothing)
+                                    changed =
+                                      has_periodic_neighbor ?
+                                        cell->periodic_neighbor(i)
+                                          ->flag_for_face_refinement(
+                                            cell
+                                              ->periodic_neighbor_of_coarser_periodic_neighbor(
+                                                i)
+                                              .first,
+                                            RefinementCase<dim - 1>::cut_x) :
+                                        cell->neighbor(i)
+                                          ->flag_for_face_refinement(
+                                            cell
+                                              ->neighbor_of_coarser_neighbor(
+                                                i)
+                                              .first,
+                                            RefinementCase<dim - 1>::cut_x);
+                                  else
+                                    {
+                                      if (!cell
+                                             ->neighbor_or_periodic_neighbor(
+                                               i)
+                                             ->refine_flag_set())
+                                        changed = true;
+                                      cell->neighbor_or_periodic_neighbor(i)
+                                        ->set_refine_flag();
+                                    }
+                                }
+                              else // i.e. if (dim==3)
+                                {
+                                  // ugly situations might arise here,
+                                  // consider the following situation, which
+                                  // shows neighboring cells at the common
+                                  // face, where the upper right element is
+                                  // coarser at the given face. Now the upper
+                                  // child element of the lower left wants to
+                                  // refine according to cut_z, such that
+                                  // there is a 'horizontal' refinement of the
+                                  // face marked with #####
+                                  //
+                                  //                            / /
+                                  //                           / /
+                                  //                          *---------------*
+                                  //                          |               |
+                                  //                          |               |
+                                  //                          |               |
+                                  //                          |               |
+                                  //                          |               |
+                                  //                          |               | /
+                                  //                          |               |/
+                                  //                          *---------------*
+                                  //
+                                  //
+                                  //     *---------------*
+                                  //    /|              /|
+                                  //   / |     #####   / |
+                                  //     |               |
+                                  //     *---------------*
+                                  //    /|              /|
+                                  //   / |             / |
+                                  //     |               |
+                                  //     *---------------*
+                                  //    /               /
+                                  //   /               /
+                                  //
+                                  // this introduces too many hanging nodes
+                                  // and the neighboring (coarser) cell (upper
+                                  // right) has to be refined. If it is only
+                                  // refined according to cut_z, then
+                                  // everything is ok:
+                                  //
+                                  //                            / /
+                                  //                           / /
+                                  //                          *---------------*
+                                  //                          |               |
+                                  //                          |               | /
+                                  //                          |               |/
+                                  //                          *---------------*
+                                  //                          |               |
+                                  //                          |               | /
+                                  //                          |               |/
+                                  //                          *---------------*
+                                  //
+                                  //
+                                  //     *---------------*
+                                  //    /|              /|
+                                  //   / *---------------*
+                                  //    /|              /|
+                                  //     *---------------*
+                                  //    /|              /|
+                                  //   / |             / |
+                                  //     |               |
+                                  //     *---------------*
+                                  //    /               /
+                                  //   /               /
+                                  //
+                                  // if however the cell wants to refine
+                                  // itself in an other way, or if we disallow
+                                  // anisotropic smoothing, then simply
+                                  // refining the neighbor isotropically is
+                                  // not going to work, since this introduces
+                                  // a refinement of face ##### with both
+                                  // cut_x and cut_y, which is not possible:
+                                  //
+                                  //                            /       / /
+                                  //                           /       / /
+                                  //                          *-------*-------*
+                                  //                          |       |       |
+                                  //                          |       |       | /
+                                  //                          |       |       |/
+                                  //                          *-------*-------*
+                                  //                          |       |       |
+                                  //                          |       |       | /
+                                  //                          |       |       |/
+                                  //                          *-------*-------*
+                                  //
+                                  //
+                                  //     *---------------*
+                                  //    /|              /|
+                                  //   / *---------------*
+                                  //    /|              /|
+                                  //     *---------------*
+                                  //    /|              /|
+                                  //   / |             / |
+                                  //     |               |
+                                  //     *---------------*
+                                  //    /               /
+                                  //   /               /
+                                  //
+                                  // thus, in this case we also need to refine
+                                  // our current cell in the new direction:
+                                  //
+                                  //                            /       / /
+                                  //                           /       / /
+                                  //                          *-------*-------*
+                                  //                          |       |       |
+                                  //                          |       |       | /
+                                  //                          |       |       |/
+                                  //                          *-------*-------*
+                                  //                          |       |       |
+                                  //                          |       |       | /
+                                  //                          |       |       |/
+                                  //                          *-------*-------*
+                                  //
+                                  //
+                                  //     *-------*-------*
+                                  //    /|      /|      /|
+                                  //   / *-------*-------*
+                                  //    /|      /|      /|
+                                  //     *-------*-------*
+                                  //    /|      /       /|
+                                  //   / |             / |
+                                  //     |               |
+                                  //     *---------------*
+                                  //    /               /
+                                  //   /               /
+
+                                  std::pair<unsigned int, unsigned int>
+                                    nb_indices =
+                                      has_periodic_neighbor ?
+                                        cell
+                                          ->periodic_neighbor_of_coarser_periodic_neighbor(
+                                            i) :
+                                        cell->neighbor_of_coarser_neighbor(i);
+                                  unsigned int refined_along_x       = 0,
+                                               refined_along_y       = 0,
+                                               to_be_refined_along_x = 0,
+                                               to_be_refined_along_y = 0;
+
+                                  const int this_face_index =
+                                    cell->face_index(i);
+
+                                  // step 1: detect, along which axis the face
+                                  // is currently refined
+
+                                  // first, we need an iterator pointing to
+                                  // the parent face. This requires a slight
+                                  // detour in case the neighbor is behind a
+                                  // periodic face.
+                                  const auto parent_face = [&]() {
+                                    if (has_periodic_neighbor)
                                       {
-                                        if (!cell
-                                               ->neighbor_or_periodic_neighbor(
-                                                 i)
-                                               ->refine_flag_set())
-                                          changed = true;
-                                        cell->neighbor_or_periodic_neighbor(i)
-                                          ->set_refine_flag();
-                                      }
-                                  }
-                                else // i.e. if (dim==3)
-                                  {
-                                    // ugly situations might arise here,
-                                    // consider the following situation, which
-                                    // shows neighboring cells at the common
-                                    // face, where the upper right element is
-                                    // coarser at the given face. Now the upper
-                                    // child element of the lower left wants to
-                                    // refine according to cut_z, such that
-                                    // there is a 'horizontal' refinement of the
-                                    // face marked with #####
-                                    //
-                                    //                            / /
-                                    //                           / /
-                                    //                          *---------------*
-                                    //                          |               |
-                                    //                          |               |
-                                    //                          |               |
-                                    //                          |               |
-                                    //                          |               |
-                                    //                          |               | /
-                                    //                          |               |/
-                                    //                          *---------------*
-                                    //
-                                    //
-                                    //     *---------------*
-                                    //    /|              /|
-                                    //   / |     #####   / |
-                                    //     |               |
-                                    //     *---------------*
-                                    //    /|              /|
-                                    //   / |             / |
-                                    //     |               |
-                                    //     *---------------*
-                                    //    /               /
-                                    //   /               /
-                                    //
-                                    // this introduces too many hanging nodes
-                                    // and the neighboring (coarser) cell (upper
-                                    // right) has to be refined. If it is only
-                                    // refined according to cut_z, then
-                                    // everything is ok:
-                                    //
-                                    //                            / /
-                                    //                           / /
-                                    //                          *---------------*
-                                    //                          |               |
-                                    //                          |               | /
-                                    //                          |               |/
-                                    //                          *---------------*
-                                    //                          |               |
-                                    //                          |               | /
-                                    //                          |               |/
-                                    //                          *---------------*
-                                    //
-                                    //
-                                    //     *---------------*
-                                    //    /|              /|
-                                    //   / *---------------*
-                                    //    /|              /|
-                                    //     *---------------*
-                                    //    /|              /|
-                                    //   / |             / |
-                                    //     |               |
-                                    //     *---------------*
-                                    //    /               /
-                                    //   /               /
-                                    //
-                                    // if however the cell wants to refine
-                                    // itself in an other way, or if we disallow
-                                    // anisotropic smoothing, then simply
-                                    // refining the neighbor isotropically is
-                                    // not going to work, since this introduces
-                                    // a refinement of face ##### with both
-                                    // cut_x and cut_y, which is not possible:
-                                    //
-                                    //                            /       / /
-                                    //                           /       / /
-                                    //                          *-------*-------*
-                                    //                          |       |       |
-                                    //                          |       |       | /
-                                    //                          |       |       |/
-                                    //                          *-------*-------*
-                                    //                          |       |       |
-                                    //                          |       |       | /
-                                    //                          |       |       |/
-                                    //                          *-------*-------*
-                                    //
-                                    //
-                                    //     *---------------*
-                                    //    /|              /|
-                                    //   / *---------------*
-                                    //    /|              /|
-                                    //     *---------------*
-                                    //    /|              /|
-                                    //   / |             / |
-                                    //     |               |
-                                    //     *---------------*
-                                    //    /               /
-                                    //   /               /
-                                    //
-                                    // thus, in this case we also need to refine
-                                    // our current cell in the new direction:
-                                    //
-                                    //                            /       / /
-                                    //                           /       / /
-                                    //                          *-------*-------*
-                                    //                          |       |       |
-                                    //                          |       |       | /
-                                    //                          |       |       |/
-                                    //                          *-------*-------*
-                                    //                          |       |       |
-                                    //                          |       |       | /
-                                    //                          |       |       |/
-                                    //                          *-------*-------*
-                                    //
-                                    //
-                                    //     *-------*-------*
-                                    //    /|      /|      /|
-                                    //   / *-------*-------*
-                                    //    /|      /|      /|
-                                    //     *-------*-------*
-                                    //    /|      /       /|
-                                    //   / |             / |
-                                    //     |               |
-                                    //     *---------------*
-                                    //    /               /
-                                    //   /               /
-
-                                    std::pair<unsigned int, unsigned int>
-                                      nb_indices =
-                                        has_periodic_neighbor ?
-                                          cell
-                                            ->periodic_neighbor_of_coarser_periodic_neighbor(
-                                              i) :
-                                          cell->neighbor_of_coarser_neighbor(i);
-                                    unsigned int refined_along_x       = 0,
-                                                 refined_along_y       = 0,
-                                                 to_be_refined_along_x = 0,
-                                                 to_be_refined_along_y = 0;
-
-                                    const int this_face_index =
-                                      cell->face_index(i);
-
-                                    // step 1: detect, along which axis the face
-                                    // is currently refined
-
-                                    // first, we need an iterator pointing to
-                                    // the parent face. This requires a slight
-                                    // detour in case the neighbor is behind a
-                                    // periodic face.
-                                    const auto parent_face = [&]() {
-                                      if (has_periodic_neighbor)
-                                        {
-                                          const auto neighbor =
-                                            cell->periodic_neighbor(i);
-                                          const auto parent_face_no =
-                                            neighbor
-                                              ->periodic_neighbor_of_periodic_neighbor(
-                                                nb_indices.first);
-                                          auto parent =
-                                            neighbor->periodic_neighbor(
+                                        const auto neighbor =
+                                          cell->periodic_neighbor(i);
+                                        const auto parent_face_no =
+                                          neighbor
+                                            ->periodic_neighbor_of_periodic_neighbor(
                                               nb_indices.first);
-                                          return parent->face(parent_face_no);
-                                        }
-                                      else
-                                        return cell->neighbor(i)->face(
-                                          nb_indices.first);
-                                    }();
-
-                                    if ((this_face_index ==
-                                         parent_face->child_index(0)) ||
-                                        (this_face_index ==
-                                         parent_face->child_index(1)))
-                                      {
-                                        // this might be an
-                                        // anisotropic child. get the
-                                        // face refine case of the
-                                        // neighbors face and count
-                                        // refinements in x and y
-                                        // direction.
-                                        RefinementCase<dim - 1> frc =
-                                          parent_face->refinement_case();
-                                        if (frc & RefinementCase<dim>::cut_x)
-                                          ++refined_along_x;
-                                        if (frc & RefinementCase<dim>::cut_y)
-                                          ++refined_along_y;
+                                        auto parent =
+                                          neighbor->periodic_neighbor(
+                                            nb_indices.first);
+                                        return parent->face(parent_face_no);
                                       }
                                     else
-                                      // this has to be an isotropic
-                                      // child
-                                      {
+                                      return cell->neighbor(i)->face(
+                                        nb_indices.first);
+                                  }();
+
+                                  if ((this_face_index ==
+                                       parent_face->child_index(0)) ||
+                                      (this_face_index ==
+                                       parent_face->child_index(1)))
+                                    {
+                                      // this might be an
+                                      // anisotropic child. get the
+                                      // face refine case of the
+                                      // neighbors face and count
+                                      // refinements in x and y
+                                      // direction.
+                                      RefinementCase<dim - 1> frc =
+                                        parent_face->refinement_case();
+                                      if (frc & RefinementCase<dim>::cut_x)
                                         ++refined_along_x;
+                                      if (frc & RefinementCase<dim>::cut_y)
                                         ++refined_along_y;
-                                      }
-                                    // step 2: detect, along which axis the face
-                                    // has to be refined given the current
-                                    // refine flag
-                                    RefinementCase<dim - 1> flagged_frc =
-                                      GeometryInfo<dim>::face_refinement_case(
-                                        cell->refine_flag_set(),
-                                        i,
-                                        cell->face_orientation(i),
-                                        cell->face_flip(i),
-                                        cell->face_rotation(i));
-                                    if (flagged_frc &
-                                        RefinementCase<dim>::cut_x)
-                                      ++to_be_refined_along_x;
-                                    if (flagged_frc &
-                                        RefinementCase<dim>::cut_y)
-                                      ++to_be_refined_along_y;
-
-                                    // step 3: set the refine flag of the
-                                    // (coarser and active) neighbor.
-                                    if ((smooth_grid &
-                                         allow_anisotropic_smoothing) ||
-                                        cell->neighbor_or_periodic_neighbor(i)
-                                          ->refine_flag_set())
-                                      {
-                                        if (refined_along_x +
-                                              to_be_refined_along_x >
-                                            1)
-                                          changed |=
-                                            cell
-                                              ->neighbor_or_periodic_neighbor(i)
-                                              ->flag_for_face_refinement(
-                                                nb_indices.first,
-                                                RefinementCase<dim -
-                                                               1>::cut_axis(0));
-                                        if (refined_along_y +
-                                              to_be_refined_along_y >
-                                            1)
-                                          changed |=
-                                            cell
-                                              ->neighbor_or_periodic_neighbor(i)
-                                              ->flag_for_face_refinement(
-                                                nb_indices.first,
-                                                RefinementCase<dim -
-                                                               1>::cut_axis(1));
-                                      }
-                                    else
-                                      {
-                                        if (cell
-                                              ->neighbor_or_periodic_neighbor(i)
-                                              ->refine_flag_set() !=
-                                            RefinementCase<
-                                              dim>::isotropic_refinement)
-                                          changed = true;
-                                        cell->neighbor_or_periodic_neighbor(i)
-                                          ->set_refine_flag();
-                                      }
+                                    }
+                                  else
+                                    // this has to be an isotropic
+                                    // child
+                                    {
+                                      ++refined_along_x;
+                                      ++refined_along_y;
+                                    }
+                                  // step 2: detect, along which axis the face
+                                  // has to be refined given the current
+                                  // refine flag
+                                  RefinementCase<dim - 1> flagged_frc =
+                                    GeometryInfo<dim>::face_refinement_case(
+                                      cell->refine_flag_set(),
+                                      i,
+                                      cell->face_orientation(i),
+                                      cell->face_flip(i),
+                                      cell->face_rotation(i));
+                                  if (flagged_frc &
+                                      RefinementCase<dim>::cut_x)
+                                    ++to_be_refined_along_x;
+                                  if (flagged_frc &
+                                      RefinementCase<dim>::cut_y)
+                                    ++to_be_refined_along_y;
+
+                                  // step 3: set the refine flag of the
+                                  // (coarser and active) neighbor.
+                                  if ((smooth_grid &
+                                       allow_anisotropic_smoothing) ||
+                                      cell->neighbor_or_periodic_neighbor(i)
+                                        ->refine_flag_set())
+                                    {
+                                      if (refined_along_x +
+                                            to_be_refined_along_x >
+                                          1)
+                                        changed |=
+                                          cell
+                                            ->neighbor_or_periodic_neighbor(i)
+                                            ->flag_for_face_refinement(
+                                              nb_indices.first,
+                                              RefinementCase<dim -
+                                                             1>::cut_axis(0));
+                                      if (refined_along_y +
+                                            to_be_refined_along_y >
+                                          1)
+                                        changed |=
+                                          cell
+                                            ->neighbor_or_periodic_neighbor(i)
+                                            ->flag_for_face_refinement(
+                                              nb_indices.first,
+                                              RefinementCase<dim -
+                                                             1>::cut_axis(1));
+                                    }
+                                  else
+                                    {
+                                      if (cell
+                                            ->neighbor_or_periodic_neighbor(i)
+                                            ->refine_flag_set() !=
+                                          RefinementCase<
+                                            dim>::isotropic_refinement)
+                                        changed = true;
+                                      cell->neighbor_or_periodic_neighbor(i)
+                                        ->set_refine_flag();
+                                    }
 
-                                    // step 4: if necessary (see above) add to
-                                    // the refine flag of the current cell
-                                    cell_iterator nb =
-                                      cell->neighbor_or_periodic_neighbor(i);
-                                    RefinementCase<dim - 1> nb_frc =
-                                      GeometryInfo<dim>::face_refinement_case(
-                                        nb->refine_flag_set(),
-                                        nb_indices.first,
-                                        nb->face_orientation(nb_indices.first),
-                                        nb->face_flip(nb_indices.first),
-                                        nb->face_rotation(nb_indices.first));
-                                    if ((nb_frc & RefinementCase<dim>::cut_x) &&
-                                        !(refined_along_x ||
-                                          to_be_refined_along_x))
-                                      changed |= cell->flag_for_face_refinement(
-                                        i,
-                                        RefinementCase<dim - 1>::cut_axis(0));
-                                    if ((nb_frc & RefinementCase<dim>::cut_y) &&
-                                        !(refined_along_y ||
-                                          to_be_refined_along_y))
-                                      changed |= cell->flag_for_face_refinement(
-                                        i,
-                                        RefinementCase<dim - 1>::cut_axis(1));
-                                  }
-                              }  // if neighbor is coarser
-                            else // -> now the neighbor is not coarser
-                              {
-                                cell->neighbor_or_periodic_neighbor(i)
-                                  ->clear_coarsen_flag();
-                                const unsigned int nb_nb =
-                                  has_periodic_neighbor ?
-                                    cell
-                                      ->periodic_neighbor_of_periodic_neighbor(
-                                        i) :
-                                    cell->neighbor_of_neighbor(i);
-                                const cell_iterator neighbor =
-                                  cell->neighbor_or_periodic_neighbor(i);
-                                RefinementCase<dim - 1> face_ref_case =
-                                  GeometryInfo<dim>::face_refinement_case(
-                                    neighbor->refine_flag_set(),
-                                    nb_nb,
-                                    neighbor->face_orientation(nb_nb),
-                                    neighbor->face_flip(nb_nb),
-                                    neighbor->face_rotation(nb_nb));
-                                RefinementCase<dim - 1> needed_face_ref_case =
-                                  GeometryInfo<dim>::face_refinement_case(
-                                    cell->refine_flag_set(),
-                                    i,
-                                    cell->face_orientation(i),
-                                    cell->face_flip(i),
-                                    cell->face_rotation(i));
-                                // if the neighbor wants to refine the
-                                // face with cut_x and we want cut_y
-                                // or vice versa, we have to refine
-                                // isotropically at the given face
-                                if ((face_ref_case ==
-                                       RefinementCase<dim>::cut_x &&
-                                     needed_face_ref_case ==
-                                       RefinementCase<dim>::cut_y) ||
-                                    (face_ref_case ==
-                                       RefinementCase<dim>::cut_y &&
-                                     needed_face_ref_case ==
-                                       RefinementCase<dim>::cut_x))
-                                  {
-                                    changed = cell->flag_for_face_refinement(
-                                      i, face_ref_case);
-                                    neighbor->flag_for_face_refinement(
-                                      nb_nb, needed_face_ref_case);
-                                  }
-                              }
-                          }
-                        else //-> the neighbor is not active
-                          {
-                            RefinementCase<dim - 1>
-                              face_ref_case = cell->face(i)->refinement_case(),
-                              needed_face_ref_case =
+                                  // step 4: if necessary (see above) add to
+                                  // the refine flag of the current cell
+                                  cell_iterator nb =
+                                    cell->neighbor_or_periodic_neighbor(i);
+                                  RefinementCase<dim - 1> nb_frc =
+                                    GeometryInfo<dim>::face_refinement_case(
+                                      nb->refine_flag_set(),
+                                      nb_indices.first,
+                                      nb->face_orientation(nb_indices.first),
+                                      nb->face_flip(nb_indices.first),
+                                      nb->face_rotation(nb_indices.first));
+                                  if ((nb_frc & RefinementCase<dim>::cut_x) &&
+                                      !(refined_along_x ||
+                                        to_be_refined_along_x))
+                                    changed |= cell->flag_for_face_refinement(
+                                      i,
+                                      RefinementCase<dim - 1>::cut_axis(0));
+                                  if ((nb_frc & RefinementCase<dim>::cut_y) &&
+                                      !(refined_along_y ||
+                                        to_be_refined_along_y))
+                                    changed |= cell->flag_for_face_refinement(
+                                      i,
+                                      RefinementCase<dim - 1>::cut_axis(1));
+                                }
+                            }  // if neighbor is coarser
+                          else // -> now the neighbor is not coarser
+                            {
+                              cell->neighbor_or_periodic_neighbor(i)
+                                ->clear_coarsen_flag();
+                              const unsigned int nb_nb =
+                                has_periodic_neighbor ?
+                                  cell
+                                    ->periodic_neighbor_of_periodic_neighbor(
+                                      i) :
+                                  cell->neighbor_of_neighbor(i);
+                              const cell_iterator neighbor =
+                                cell->neighbor_or_periodic_neighbor(i);
+                              RefinementCase<dim - 1> face_ref_case =
+                                GeometryInfo<dim>::face_refinement_case(
+                                  neighbor->refine_flag_set(),
+                                  nb_nb,
+                                  neighbor->face_orientation(nb_nb),
+                                  neighbor->face_flip(nb_nb),
+                                  neighbor->face_rotation(nb_nb));
+                              RefinementCase<dim - 1> needed_face_ref_case =
                                 GeometryInfo<dim>::face_refinement_case(
                                   cell->refine_flag_set(),
                                   i,
                                   cell->face_orientation(i),
                                   cell->face_flip(i),
                                   cell->face_rotation(i));
-                            // if the face is refined with cut_x and
-                            // we want cut_y or vice versa, we have to
-                            // refine isotropically at the given face
-                            if ((face_ref_case == RefinementCase<dim>::cut_x &&
-                                 needed_face_ref_case ==
-                                   RefinementCase<dim>::cut_y) ||
-                                (face_ref_case == RefinementCase<dim>::cut_y &&
-                                 needed_face_ref_case ==
-                                   RefinementCase<dim>::cut_x))
-                              changed =
-                                cell->flag_for_face_refinement(i,
-                                                               face_ref_case);
-                          }
-                      }
-                  }
-              }
+                              // if the neighbor wants to refine the
+                              // face with cut_x and we want cut_y
+                              // or vice versa, we have to refine
+                              // isotropically at the given face
+                              if ((face_ref_case ==
+                                     RefinementCase<dim>::cut_x &&
+                                   needed_face_ref_case ==
+                                     RefinementCase<dim>::cut_y) ||
+                                  (face_ref_case ==
+                                     RefinementCase<dim>::cut_y &&
+                                   needed_face_ref_case ==
+                                     RefinementCase<dim>::cut_x))
+                                {
+                                  changed = cell->flag_for_face_refinement(
+                                    i, face_ref_case);
+                                  neighbor->flag_for_face_refinement(
+                                    nb_nb, needed_face_ref_case);
+                                }
+                            }
+                        }
+                      else //-> the neighbor is not active
+                        {
+                          RefinementCase<dim - 1>
+                            face_ref_case = cell->face(i)->refinement_case(),
+                            needed_face_ref_case =
+                              GeometryInfo<dim>::face_refinement_case(
+                                cell->refine_flag_set(),
+                                i,
+                                cell->face_orientation(i),
+                                cell->face_flip(i),
+                                cell->face_rotation(i));
+                          // if the face is refined with cut_x and
+                          // we want cut_y or vice versa, we have to
+                          // refine isotropically at the given face
+                          if ((face_ref_case == RefinementCase<dim>::cut_x &&
+                               needed_face_ref_case ==
+                                 RefinementCase<dim>::cut_y) ||
+                              (face_ref_case == RefinementCase<dim>::cut_y &&
+                               needed_face_ref_case ==
+                                 RefinementCase<dim>::cut_x))
+                            changed =
+                              cell->flag_for_face_refinement(i,
+                                                             face_ref_case);
+                        }
+
+                      // neighbors that are flagged now need to be visited
+                      // as well, still in this sweep if they come after
+                      // the current cell
+                      const cell_iterator neighbor =
+                        cell->neighbor_or_periodic_neighbor(i);
+                      if (neighbor->is_active() && neighbor->refine_flag_set())
+                        refine_flagged_cells.emplace(neighbor->level(),
+                                                     neighbor->index());
+                    }
+                }
+            }
         }
 
       //////////////////////////////////////
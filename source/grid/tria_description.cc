@@ -93,6 +93,130 @@ namespace TriangulationDescription
         if (cell->level() != 0)
           set_user_flag_and_of_its_parents(cell->parent());
       }
+
+
+
+      /**
+       * Return the number of cells of a structured box with @p repetitions
+       * cells per direction that lie in the (Morton) subtree of edge length
+       * @p size whose lower corner is at @p origin.
+       */
+      template <int dim>
+      std::uint64_t
+      n_box_cells_in_subtree(const std::array<unsigned int, dim> &origin,
+                             const unsigned int                   size,
+                             const std::vector<unsigned int> &    repetitions)
+      {
+        std::uint64_t n_cells = 1;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            if (origin[d] >= repetitions[d])
+              return 0;
+            n_cells *= std::min(size, repetitions[d] - origin[d]);
+          }
+        return n_cells;
+      }
+
+
+
+      /**
+       * Collect all cells of a structured box whose position along the
+       * Morton curve lies in the half-open range [@p begin, @p end). The
+       * subtree with lower corner @p origin and edge length @p size is
+       * preceded by @p offset cells along the curve. Subtrees that are
+       * completely outside of the box or of the range are skipped, such
+       * that the cost is proportional to the number of collected cells.
+       */
+      template <int dim>
+      void
+      collect_box_cells_on_curve_range(
+        const std::array<unsigned int, dim> &origin,
+        const unsigned int                   size,
+        const std::uint64_t                  offset,
+        const std::uint64_t                  begin,
+        const std::uint64_t                  end,
+        const std::vector<unsigned int> &    repetitions,
+        std::vector<std::pair<std::uint64_t, std::array<unsigned int, dim>>>
+          &cells)
+      {
+        const std::uint64_t n_cells =
+          n_box_cells_in_subtree<dim>(origin, size, repetitions);
+
+        if (n_cells == 0 || offset >= end || offset + n_cells <= begin)
+          return;
+
+        if (size == 1)
+          {
+            cells.emplace_back(offset, origin);
+            return;
+          }
+
+        const unsigned int half         = size / 2;
+        std::uint64_t      child_offset = offset;
+        for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell;
+             ++c)
+          {
+            std::array<unsigned int, dim> child_origin = origin;
+            for (unsigned int d = 0; d < dim; ++d)
+              if (c & (1u << d))
+                child_origin[d] += half;
+
+            collect_box_cells_on_curve_range<dim>(child_origin,
+                                                  half,
+                                                  child_offset,
+                                                  begin,
+                                                  end,
+                                                  repetitions,
+                                                  cells);
+            child_offset +=
+              n_box_cells_in_subtree<dim>(child_origin, half, repetitions);
+          }
+      }
+
+
+
+      /**
+       * Return the position of @p cell along the Morton curve through a
+       * structured box, where the curve is defined on the smallest enclosing
+       * box with edge length @p root_size (a power of two) and cells outside
+       * of the actual box are skipped.
+       */
+      template <int dim>
+      std::uint64_t
+      box_cell_curve_index(const std::array<unsigned int, dim> &cell,
+                           const unsigned int                   root_size,
+                           const std::vector<unsigned int> &    repetitions)
+      {
+        std::array<unsigned int, dim> origin;
+        origin.fill(0);
+
+        std::uint64_t index = 0;
+        for (unsigned int size = root_size; size > 1; size /= 2)
+          {
+            const unsigned int half = size / 2;
+
+            unsigned int child = 0;
+            for (unsigned int d = 0; d < dim; ++d)
+              if (cell[d] >= origin[d] + half)
+                child |= (1u << d);
+
+            for (unsigned int c = 0; c < child; ++c)
+              {
+                std::array<unsigned int, dim> child_origin = origin;
+                for (unsigned int d = 0; d < dim; ++d)
+                  if (c & (1u << d))
+                    child_origin[d] += half;
+                index +=
+                  n_box_cells_in_subtree<dim>(child_origin, half, repetitions);
+              }
+
+            for (unsigned int d = 0; d < dim; ++d)
+              if (child & (1u << d))
+                origin[d] += half;
+          }
+
+        return index;
+      }
     } // namespace
 
 
@@ -525,6 +649,232 @@ namespace TriangulationDescription
 #endif
     }
 
+
+
+    template <int dim>
+    Description<dim, dim>
+    create_description_for_subdivided_hyper_rectangle(
+      const std::vector<unsigned int> &                     repetitions,
+      const Point<dim> &                                    p_1,
+      const Point<dim> &                                    p_2,
+      const bool                                            colorize,
+      const MPI_Comm &                                      comm,
+      const typename Triangulation<dim, dim>::MeshSmoothing smoothing,
+      const TriangulationDescription::Settings              settings)
+    {
+      AssertDimension(repetitions.size(), dim);
+
+      const bool construct_multigrid =
+        settings &
+        TriangulationDescription::Settings::construct_multigrid_hierarchy;
+
+      const unsigned int my_rank =
+        dealii::Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_procs =
+        dealii::Utilities::MPI::n_mpi_processes(comm);
+
+      // normalize such that p1 is lower in all coordinate directions and
+      // compute the mesh size in each direction
+      Point<dim>     p1;
+      Tensor<1, dim> delta;
+      std::uint64_t  n_global_cells = 1;
+      unsigned int   root_size      = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          Assert(repetitions[d] >= 1,
+                 ExcMessage("The number of repetitions must be positive."));
+
+          p1[d]    = std::min(p_1[d], p_2[d]);
+          delta[d] = (std::max(p_1[d], p_2[d]) - p1[d]) / repetitions[d];
+          Assert(
+            delta[d] > 0.0,
+            ExcMessage(
+              "The coordinates of p1 and p2 need to be different in each direction."));
+
+          n_global_cells *= repetitions[d];
+          while (root_size < repetitions[d])
+            root_size *= 2;
+        }
+
+      // the Morton curve is cut into n_procs pieces of (almost) equal
+      // length: process r owns the positions [r*n/p, (r+1)*n/p)
+      const auto owner_of = [&](const std::uint64_t curve_index) {
+        return static_cast<unsigned int>(
+          ((curve_index + 1) * n_procs - 1) / n_global_cells);
+      };
+      const std::uint64_t my_begin = (n_global_cells * my_rank) / n_procs;
+      const std::uint64_t my_end   = (n_global_cells * (my_rank + 1)) / n_procs;
+
+      // 1) collect the locally owned cells, sorted along the curve
+      std::vector<std::pair<std::uint64_t, std::array<unsigned int, dim>>>
+        cells;
+      {
+        std::array<unsigned int, dim> origin;
+        origin.fill(0);
+        collect_box_cells_on_curve_range<dim>(
+          origin, root_size, 0, my_begin, my_end, repetitions, cells);
+      }
+      AssertDimension(cells.size(), my_end - my_begin);
+
+      const auto lexicographic_index =
+        [&](const std::array<unsigned int, dim> &cell) {
+          std::uint64_t index = 0;
+          for (int d = dim - 1; d >= 0; --d)
+            index = index * repetitions[d] + cell[d];
+          return index;
+        };
+
+      // 2) add all cells that share a vertex with a locally owned cell
+      {
+        std::vector<std::uint64_t> owned_cells;
+        owned_cells.reserve(cells.size());
+        for (const auto &cell : cells)
+          owned_cells.push_back(lexicographic_index(cell.second));
+        std::sort(owned_cells.begin(), owned_cells.end());
+
+        std::map<std::uint64_t, std::array<unsigned int, dim>> ghost_cells;
+
+        const unsigned int n_neighbors = dealii::Utilities::pow(3, dim);
+        const unsigned int n_owned     = cells.size();
+        for (unsigned int c = 0; c < n_owned; ++c)
+          for (unsigned int n = 0; n < n_neighbors; ++n)
+            {
+              std::array<unsigned int, dim> neighbor = cells[c].second;
+
+              bool inside = true;
+              for (unsigned int d = 0, code = n; d < dim; ++d, code /= 3)
+                {
+                  const int index = static_cast<int>(neighbor[d]) +
+                                    static_cast<int>(code % 3) - 1;
+                  if (index < 0 || index >= static_cast<int>(repetitions[d]))
+                    inside = false;
+                  neighbor[d] = index;
+                }
+              if (inside == false)
+                continue;
+
+              const std::uint64_t index = lexicographic_index(neighbor);
+              if (std::binary_search(owned_cells.begin(),
+                                     owned_cells.end(),
+                                     index) == false)
+                ghost_cells.emplace(index, neighbor);
+            }
+
+        for (const auto &ghost : ghost_cells)
+          cells.emplace_back(box_cell_curve_index<dim>(ghost.second,
+                                                       root_size,
+                                                       repetitions),
+                             ghost.second);
+
+        std::sort(cells.begin(),
+                  cells.end(),
+                  [](const auto &a, const auto &b) {
+                    return a.first < b.first;
+                  });
+      }
+
+      Description<dim, dim> construction_data;
+
+      construction_data.comm     = comm;
+      construction_data.settings = settings;
+      construction_data.smoothing =
+        construct_multigrid ?
+          static_cast<typename Triangulation<dim, dim>::MeshSmoothing>(
+            smoothing |
+            Triangulation<dim, dim>::limit_level_difference_at_vertices) :
+          smoothing;
+
+      // 3) enumerate the vertices of the locally relevant cells
+      std::map<std::uint64_t, unsigned int> vertices_locally_relevant;
+      const auto vertex_of_cell = [&](const std::array<unsigned int, dim> &cell,
+                                      const unsigned int                   v) {
+        std::uint64_t index = 0;
+        for (int d = dim - 1; d >= 0; --d)
+          index = index * (repetitions[d] + 1) + cell[d] + ((v >> d) & 1);
+        return index;
+      };
+
+      for (const auto &cell : cells)
+        for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+          vertices_locally_relevant[vertex_of_cell(cell.second, v)] =
+            numbers::invalid_unsigned_int;
+
+      construction_data.coarse_cell_vertices.reserve(
+        vertices_locally_relevant.size());
+      unsigned int vertex_counter = 0;
+      for (auto &vertex : vertices_locally_relevant)
+        {
+          Point<dim>    point = p1;
+          std::uint64_t index = vertex.first;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              point[d] += (index % (repetitions[d] + 1)) * delta[d];
+              index /= (repetitions[d] + 1);
+            }
+          construction_data.coarse_cell_vertices.push_back(point);
+          vertex.second = vertex_counter++;
+        }
+
+      // 4) set up the coarse cells and the cell infos (all on level 0)
+      construction_data.coarse_cells.reserve(cells.size());
+      construction_data.coarse_cell_index_to_coarse_cell_id.reserve(
+        cells.size());
+      construction_data.cell_infos.resize(1);
+      construction_data.cell_infos[0].reserve(cells.size());
+
+      for (const auto &cell : cells)
+        {
+          const std::uint64_t                  curve_index = cell.first;
+          const std::array<unsigned int, dim> &position    = cell.second;
+
+          dealii::CellData<dim> cell_data(
+            GeometryInfo<dim>::vertices_per_cell);
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            cell_data.vertices[v] =
+              vertices_locally_relevant[vertex_of_cell(position, v)];
+
+          // same material ids as colorize_subdivided_hyper_rectangle(),
+          // which looks at the sign of the coordinates of the cell center
+          cell_data.material_id = 0;
+          if (colorize)
+            for (unsigned int d = 0; d < dim; ++d)
+              if (p1[d] + (position[d] + 0.5) * delta[d] > 0)
+                cell_data.material_id += (1 << d);
+
+          construction_data.coarse_cells.push_back(cell_data);
+          construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+            curve_index);
+
+          CellData<dim> cell_info;
+          cell_info.id = CellId(curve_index, {}).template to_binary<dim>();
+
+          cell_info.manifold_id = numbers::flat_manifold_id;
+          cell_info.manifold_line_ids.fill(numbers::flat_manifold_id);
+          cell_info.manifold_quad_ids.fill(numbers::flat_manifold_id);
+
+          // faces 2d and 2d+1 are the lower and upper faces in direction d;
+          // in 1d the two end points are always distinguished
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              if (position[d] == 0)
+                cell_info.boundary_ids.emplace_back(
+                  2 * d, (colorize || dim == 1) ? 2 * d : 0);
+              if (position[d] + 1 == repetitions[d])
+                cell_info.boundary_ids.emplace_back(
+                  2 * d + 1, (colorize || dim == 1) ? 2 * d + 1 : 0);
+            }
+
+          cell_info.subdomain_id = owner_of(curve_index);
+          cell_info.level_subdomain_id =
+            construct_multigrid ? cell_info.subdomain_id :
+                                  numbers::artificial_subdomain_id;
+
+          construction_data.cell_infos[0].emplace_back(cell_info);
+        }
+
+      return construction_data;
+    }
+
   } // namespace Utilities
 } // namespace TriangulationDescription
 
@@ -47,9 +47,7 @@ namespace hp
           FiniteElementDomination::no_requirements;
         for (const auto &other_fe : fes)
           domination =
-            domination &
-            this->operator[](current_fe)
-              .compare_for_domination(this->operator[](other_fe), codim);
+            domination & compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe dominates, add it to the set.
         if ((domination == FiniteElementDomination::this_element_dominates) ||
@@ -87,9 +85,7 @@ namespace hp
           FiniteElementDomination::no_requirements;
         for (const auto &other_fe : fes)
           domination =
-            domination &
-            this->operator[](current_fe)
-              .compare_for_domination(this->operator[](other_fe), codim);
+            domination & compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe is dominated, add it to the set.
         if ((domination == FiniteElementDomination::other_element_dominates) ||
@@ -132,9 +128,7 @@ namespace hp
         for (const auto &other_fe : fes)
           if (current_fe != other_fe)
             domination =
-              domination &
-              this->operator[](current_fe)
-                .compare_for_domination(this->operator[](other_fe), codim);
+              domination & compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe dominates, return its index.
         if ((domination == FiniteElementDomination::this_element_dominates) ||
@@ -179,9 +173,7 @@ namespace hp
         for (const auto &other_fe : fes)
           if (current_fe != other_fe)
             domination =
-              domination &
-              this->operator[](current_fe)
-                .compare_for_domination(this->operator[](other_fe), codim);
+              domination & compare_for_domination(current_fe, other_fe, codim);
 
         // If current_fe is dominated, return its index.
         if ((domination == FiniteElementDomination::other_element_dominates) ||
@@ -282,6 +274,214 @@ namespace hp
                       "same number of vector components!"));
 
     Collection<FiniteElement<dim, spacedim>>::push_back(new_fe.clone());
+
+    // the interpolation matrices computed so far are still valid, but copies
+    // of this object might share them with us, so start from a new cache
+    interpolation_matrix_cache = std::make_shared<InterpolationMatrixCache>();
+    domination_cache           = std::make_shared<DominationCache>();
+  }
+
+
+
+  template <int dim, int spacedim>
+  const FullMatrix<double> &
+  FECollection<dim, spacedim>::get_face_interpolation_matrix(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int face_no) const
+  {
+    AssertIndexRange(fe_index_1, this->size());
+    AssertIndexRange(fe_index_2, this->size());
+
+    const std::array<unsigned int, 4> key = {
+      {fe_index_1, fe_index_2, numbers::invalid_unsigned_int, face_no}};
+
+    std::lock_guard<std::mutex> lock(interpolation_matrix_cache->mutex);
+    auto &matrices = interpolation_matrix_cache->matrices;
+
+    const auto entry = matrices.find(key);
+    if (entry != matrices.end())
+      return entry->second;
+
+    const FiniteElement<dim, spacedim> &fe_1 = this->operator[](fe_index_1);
+    const FiniteElement<dim, spacedim> &fe_2 = this->operator[](fe_index_2);
+
+    FullMatrix<double> matrix(fe_2.n_dofs_per_face(face_no),
+                              fe_1.n_dofs_per_face(face_no));
+    fe_1.get_face_interpolation_matrix(fe_2, matrix, face_no);
+
+    return matrices.emplace(key, std::move(matrix)).first->second;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const FullMatrix<double> &
+  FECollection<dim, spacedim>::get_subface_interpolation_matrix(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int subface,
+    const unsigned int face_no) const
+  {
+    AssertIndexRange(fe_index_1, this->size());
+    AssertIndexRange(fe_index_2, this->size());
+    AssertIndexRange(subface, GeometryInfo<dim>::max_children_per_face);
+
+    const std::array<unsigned int, 4> key = {
+      {fe_index_1, fe_index_2, subface, face_no}};
+
+    std::lock_guard<std::mutex> lock(interpolation_matrix_cache->mutex);
+    auto &matrices = interpolation_matrix_cache->matrices;
+
+    const auto entry = matrices.find(key);
+    if (entry != matrices.end())
+      return entry->second;
+
+    const FiniteElement<dim, spacedim> &fe_1 = this->operator[](fe_index_1);
+    const FiniteElement<dim, spacedim> &fe_2 = this->operator[](fe_index_2);
+
+    FullMatrix<double> matrix(fe_2.n_dofs_per_face(face_no),
+                              fe_1.n_dofs_per_face(face_no));
+    fe_1.get_subface_interpolation_matrix(fe_2, subface, matrix, face_no);
+
+    return matrices.emplace(key, std::move(matrix)).first->second;
+  }
+
+
+
+  template <int dim, int spacedim>
+  FiniteElementDomination::Domination
+  FECollection<dim, spacedim>::compare_for_domination(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int codim) const
+  {
+    AssertIndexRange(fe_index_1, this->size());
+    AssertIndexRange(fe_index_2, this->size());
+    Assert(codim <= dim, ExcImpossibleInDim(dim));
+
+    const std::array<unsigned int, 3> key = {{fe_index_1, fe_index_2, codim}};
+
+    std::lock_guard<std::mutex> lock(domination_cache->mutex);
+    auto &dominations = domination_cache->dominations;
+
+    const auto entry = dominations.find(key);
+    if (entry != dominations.end())
+      return entry->second;
+
+    const FiniteElementDomination::Domination domination =
+      this->operator[](fe_index_1)
+        .compare_for_domination(this->operator[](fe_index_2), codim);
+
+    dominations.emplace(key, domination);
+
+    return domination;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  FECollection<dim, spacedim>::hp_vertex_dof_identities(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2) const
+  {
+    return get_dof_identities(0,
+                              fe_index_1,
+                              fe_index_2,
+                              numbers::invalid_unsigned_int);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  FECollection<dim, spacedim>::hp_line_dof_identities(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2) const
+  {
+    return get_dof_identities(1,
+                              fe_index_1,
+                              fe_index_2,
+                              numbers::invalid_unsigned_int);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  FECollection<dim, spacedim>::hp_quad_dof_identities(
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int face_no) const
+  {
+    return get_dof_identities(2, fe_index_1, fe_index_2, face_no);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  FECollection<dim, spacedim>::get_dof_identities(
+    const unsigned int structdim,
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int face_no) const
+  {
+    AssertIndexRange(fe_index_1, this->size());
+    AssertIndexRange(fe_index_2, this->size());
+    AssertIndexRange(structdim, 3);
+
+    const std::array<unsigned int, 4> key = {
+      {structdim, fe_index_1, fe_index_2, face_no}};
+
+    std::lock_guard<std::mutex> lock(domination_cache->mutex);
+    auto &dof_identities = domination_cache->dof_identities;
+
+    const auto entry = dof_identities.find(key);
+    if (entry != dof_identities.end())
+      return entry->second;
+
+    const FiniteElement<dim, spacedim> &fe_1 = this->operator[](fe_index_1);
+    const FiniteElement<dim, spacedim> &fe_2 = this->operator[](fe_index_2);
+
+    std::vector<std::pair<unsigned int, unsigned int>> identities;
+    unsigned int n_dofs_1 = 0, n_dofs_2 = 0;
+    switch (structdim)
+      {
+        case 0:
+          identities = fe_1.hp_vertex_dof_identities(fe_2);
+          n_dofs_1   = fe_1.template n_dofs_per_object<0>();
+          n_dofs_2   = fe_2.template n_dofs_per_object<0>();
+          break;
+
+        case 1:
+          identities = fe_1.hp_line_dof_identities(fe_2);
+          n_dofs_1   = fe_1.template n_dofs_per_object<1>();
+          n_dofs_2   = fe_2.template n_dofs_per_object<1>();
+          break;
+
+        case 2:
+          identities = fe_1.hp_quad_dof_identities(fe_2, face_no);
+          n_dofs_1   = fe_1.template n_dofs_per_object<2>(face_no);
+          n_dofs_2   = fe_2.template n_dofs_per_object<2>(face_no);
+          break;
+
+        default:
+          Assert(false, ExcNotImplemented());
+      }
+
+    // double check whether the newly created entries make any sense at all
+    for (const auto &identity : identities)
+      {
+        (void)identity;
+        Assert(identity.first < n_dofs_1, ExcInternalError());
+        Assert(identity.second < n_dofs_2, ExcInternalError());
+      }
+    (void)n_dofs_1;
+    (void)n_dofs_2;
+
+    return dof_identities.emplace(key, std::move(identities)).first->second;
   }
 
 
@@ -17,6 +17,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/distributed/grid_refinement.h>
 #include <deal.II/distributed/shared_tria.h>
@@ -39,6 +40,58 @@ namespace hp
 {
   namespace Refinement
   {
+    namespace
+    {
+      /**
+       * The degrees of the elements of an hp::FECollection and the indices
+       * of the elements following and preceding each of them in the
+       * hierarchy, stored in contiguous arrays indexed by the fe index so
+       * that the loops over all cells below do not have to query the
+       * collection and its hierarchy functions for every cell.
+       */
+      template <int dim, int spacedim>
+      struct FECollectionTables
+      {
+        FECollectionTables(
+          const dealii::hp::FECollection<dim, spacedim> &fe_collection)
+          : degrees(fe_collection.size())
+          , next_indices(fe_collection.size())
+          , previous_indices(fe_collection.size())
+        {
+          for (unsigned int i = 0; i < fe_collection.size(); ++i)
+            {
+              degrees[i]          = fe_collection[i].degree;
+              next_indices[i]     = fe_collection.next_in_hierarchy(i);
+              previous_indices[i] = fe_collection.previous_in_hierarchy(i);
+            }
+        }
+
+        std::vector<unsigned int> degrees;
+        std::vector<unsigned int> next_indices;
+        std::vector<unsigned int> previous_indices;
+      };
+
+
+
+      /**
+       * The adaptation of a single cell as far as it matters for the error
+       * prediction, i.e., whether the cell is locally owned, whether it will
+       * be p-adapted, refined, or coarsened, and the degrees of its current
+       * and its future finite element.
+       */
+      struct CellAdaptation
+      {
+        bool         locally_owned = false;
+        bool         p_adapted     = false;
+        bool         refined       = false;
+        bool         coarsened     = false;
+        unsigned int active_degree = 0;
+        unsigned int future_degree = 0;
+      };
+    } // namespace
+
+
+
     /**
      * Setting p-adaptivity flags
      */
@@ -78,14 +131,16 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       p_flags.size());
 
+      const FECollectionTables<dim, spacedim> tables(
+        dof_handler.get_fe_collection());
+
       for (const auto &cell : dof_handler.active_cell_iterators())
         if (cell->is_locally_owned() && p_flags[cell->active_cell_index()])
           {
             if (cell->refine_flag_set())
               {
                 const unsigned int super_fe_index =
-                  dof_handler.get_fe_collection().next_in_hierarchy(
-                    cell->active_fe_index());
+                  tables.next_indices[cell->active_fe_index()];
 
                 // Reject update if already most superordinate element.
                 if (super_fe_index != cell->active_fe_index())
@@ -94,8 +149,7 @@ namespace hp
             else if (cell->coarsen_flag_set())
               {
                 const unsigned int sub_fe_index =
-                  dof_handler.get_fe_collection().previous_in_hierarchy(
-                    cell->active_fe_index());
+                  tables.previous_indices[cell->active_fe_index()];
 
                 // Reject update if already least subordinate element.
                 if (sub_fe_index != cell->active_fe_index())
@@ -459,20 +513,22 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       sobolev_indices.size());
 
+      const FECollectionTables<dim, spacedim> tables(
+        dof_handler.get_fe_collection());
+
       for (const auto &cell : dof_handler.active_cell_iterators())
         if (cell->is_locally_owned())
           {
             if (cell->refine_flag_set())
               {
                 const unsigned int super_fe_index =
-                  dof_handler.get_fe_collection().next_in_hierarchy(
-                    cell->active_fe_index());
+                  tables.next_indices[cell->active_fe_index()];
 
                 // Reject update if already most superordinate element.
                 if (super_fe_index != cell->active_fe_index())
                   {
                     const unsigned int super_fe_degree =
-                      dof_handler.get_fe_collection()[super_fe_index].degree;
+                      tables.degrees[super_fe_index];
 
                     if (sobolev_indices[cell->active_cell_index()] >
                         super_fe_degree)
@@ -482,14 +538,13 @@ namespace hp
             else if (cell->coarsen_flag_set())
               {
                 const unsigned int sub_fe_index =
-                  dof_handler.get_fe_collection().previous_in_hierarchy(
-                    cell->active_fe_index());
+                  tables.previous_indices[cell->active_fe_index()];
 
                 // Reject update if already least subordinate element.
                 if (sub_fe_index != cell->active_fe_index())
                   {
                     const unsigned int sub_fe_degree =
-                      dof_handler.get_fe_collection()[sub_fe_index].degree;
+                      tables.degrees[sub_fe_index];
 
                     if (sobolev_indices[cell->active_cell_index()] <
                         sub_fe_degree)
@@ -566,36 +621,46 @@ namespace hp
       Assert(0 < gamma_h, dealii::GridRefinement::ExcInvalidParameterValue());
       Assert(0 < gamma_n, dealii::GridRefinement::ExcInvalidParameterValue());
 
-      // auxiliary variables
-      unsigned int future_fe_degree       = numbers::invalid_unsigned_int;
-      unsigned int parent_future_fe_index = numbers::invalid_unsigned_int;
+      const FECollectionTables<dim, spacedim> tables(
+        dof_handler.get_fe_collection());
+
       // store all determined future finite element indices on parent cells for
       // coarsening
       std::map<typename DoFHandler<dim, spacedim>::cell_iterator, unsigned int>
         future_fe_indices_on_coarsened_cells;
 
-      // deep copy error indicators
-      predicted_errors = error_indicators;
+      // First collect how each locally owned cell will be adapted in a
+      // contiguous array indexed by the active cell index. This is the only
+      // part that needs to access the cells.
+      std::vector<CellAdaptation> adaptations(
+        dof_handler.get_triangulation().n_active_cells());
 
       for (const auto &cell : dof_handler.active_cell_iterators())
         if (cell->is_locally_owned())
           {
+            CellAdaptation &adaptation = adaptations[cell->active_cell_index()];
+            adaptation.locally_owned   = true;
+            adaptation.p_adapted       = cell->future_fe_index_set();
+            adaptation.refined         = cell->refine_flag_set();
+            adaptation.coarsened       = cell->coarsen_flag_set();
+
+            adaptation.active_degree = tables.degrees[cell->active_fe_index()];
+
             // current cell will not be adapted
-            if (!(cell->future_fe_index_set()) && !(cell->refine_flag_set()) &&
-                !(cell->coarsen_flag_set()))
-              {
-                predicted_errors[cell->active_cell_index()] *= gamma_n;
-                continue;
-              }
+            if (!adaptation.p_adapted && !adaptation.refined &&
+                !adaptation.coarsened)
+              continue;
 
             // current cell will be adapted
             // determine degree of its future finite element
-            if (cell->coarsen_flag_set())
+            if (adaptation.coarsened)
               {
                 // cell will be coarsened, thus determine future finite element
                 // on parent cell
                 const auto &parent = cell->parent();
-                if (future_fe_indices_on_coarsened_cells.find(parent) ==
+                auto        parent_future_fe_index =
+                  future_fe_indices_on_coarsened_cells.find(parent);
+                if (parent_future_fe_index ==
                     future_fe_indices_on_coarsened_cells.end())
                   {
 #ifdef DEBUG
@@ -605,56 +670,77 @@ namespace hp
                                dim>::ExcInconsistentCoarseningFlags());
 #endif
 
-                    parent_future_fe_index =
+                    const unsigned int future_fe_index =
                       dealii::internal::hp::DoFHandlerImplementation::
                         dominated_future_fe_on_children<dim, spacedim>(parent);
 
-                    future_fe_indices_on_coarsened_cells.insert(
-                      {parent, parent_future_fe_index});
-                  }
-                else
-                  {
                     parent_future_fe_index =
-                      future_fe_indices_on_coarsened_cells[parent];
+                      future_fe_indices_on_coarsened_cells
+                        .insert({parent, future_fe_index})
+                        .first;
                   }
 
-                future_fe_degree =
-                  dof_handler.get_fe_collection()[parent_future_fe_index]
-                    .degree;
+                adaptation.future_degree =
+                  tables.degrees[parent_future_fe_index->second];
               }
             else
               {
                 // future finite element on current cell is already set
-                future_fe_degree =
-                  dof_handler.get_fe_collection()[cell->future_fe_index()]
-                    .degree;
+                adaptation.future_degree =
+                  tables.degrees[cell->future_fe_index()];
               }
+          }
 
-            // step 1: exponential decay with p-adaptation
-            if (cell->future_fe_index_set())
-              {
-                predicted_errors[cell->active_cell_index()] *=
-                  std::pow(gamma_p, future_fe_degree - cell->get_fe().degree);
-              }
+      // deep copy error indicators
+      predicted_errors = error_indicators;
 
-            // step 2: algebraic decay with h-adaptation
-            if (cell->refine_flag_set())
-              {
-                predicted_errors[cell->active_cell_index()] *=
-                  (gamma_h * std::pow(.5, future_fe_degree));
+      // Then compute the predicted errors from the contiguous arrays, which
+      // can be done independently for each cell and hence in parallel.
+      dealii::parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(adaptations.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              const CellAdaptation &adaptation = adaptations[i];
 
-                // predicted error will be split on children cells
-                // after adaptation via CellDataTransfer
-              }
-            else if (cell->coarsen_flag_set())
-              {
-                predicted_errors[cell->active_cell_index()] /=
-                  (gamma_h * std::pow(.5, future_fe_degree));
+              if (!adaptation.locally_owned)
+                continue;
 
-                // predicted error will be summed up on parent cell
-                // after adaptation via CellDataTransfer
-              }
-          }
+              // current cell will not be adapted
+              if (!adaptation.p_adapted && !adaptation.refined &&
+                  !adaptation.coarsened)
+                {
+                  predicted_errors[i] *= gamma_n;
+                  continue;
+                }
+
+              // step 1: exponential decay with p-adaptation
+              if (adaptation.p_adapted)
+                predicted_errors[i] *=
+                  std::pow(gamma_p,
+                           adaptation.future_degree - adaptation.active_degree);
+
+              // step 2: algebraic decay with h-adaptation
+              if (adaptation.refined)
+                {
+                  predicted_errors[i] *=
+                    (gamma_h * std::pow(.5, adaptation.future_degree));
+
+                  // predicted error will be split on children cells
+                  // after adaptation via CellDataTransfer
+                }
+              else if (adaptation.coarsened)
+                {
+                  predicted_errors[i] /=
+                    (gamma_h * std::pow(.5, adaptation.future_degree));
+
+                  // predicted error will be summed up on parent cell
+                  // after adaptation via CellDataTransfer
+                }
+            }
+        },
+        1024);
     }
 
 
@@ -0,0 +1,462 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/batched_full_matrix.h>
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+#include <utility>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <typename number>
+BatchedFullMatrix<number>::BatchedFullMatrix()
+  : state(State::matrix)
+  , n_stored_matrices(0)
+  , n_rows(0)
+{}
+
+
+
+template <typename number>
+BatchedFullMatrix<number>::BatchedFullMatrix(const size_type n_matrices,
+                                             const size_type n)
+  : BatchedFullMatrix()
+{
+  reinit(n_matrices, n);
+}
+
+
+
+template <typename number>
+void
+BatchedFullMatrix<number>::reinit(const size_type n_matrices,
+                                  const size_type n)
+{
+  state             = State::matrix;
+  n_stored_matrices = n_matrices;
+  n_rows            = n;
+
+  const std::size_t n_entries =
+    static_cast<std::size_t>(n_batches()) * n_rows * n_rows;
+  values.resize_fast(n_entries);
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    n_entries,
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t e = begin; e < end; ++e)
+        values[e] = ((e / n_rows) % n_rows == e % n_rows) ? number(1.) :
+                                                            number(0.);
+    },
+    internal::VectorImplementation::minimum_parallel_grain_size);
+
+  inverse_diagonal.clear();
+  pivots.clear();
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+BatchedFullMatrix<number>::set_matrix(const size_type            index,
+                                      const FullMatrix<number2> &matrix)
+{
+  AssertIndexRange(index, n_stored_matrices);
+  Assert(state == State::matrix,
+         ExcMessage("The matrix entries cannot be changed once a "
+                    "factorization has been computed."));
+  Assert(matrix.m() == matrix.n(), LACExceptions::ExcNotQuadratic());
+  AssertIndexRange(matrix.m(), n_rows + 1);
+
+  const size_type m = matrix.m();
+  for (size_type i = 0; i < n_rows; ++i)
+    for (size_type j = 0; j < n_rows; ++j)
+      (*this)(index, i, j) =
+        (i < m && j < m) ? number(matrix(i, j)) :
+                           (i == j ? number(1.) : number(0.));
+}
+
+
+
+template <typename number>
+void
+BatchedFullMatrix<number>::compute_lu_factorization()
+{
+  Assert(state == State::matrix,
+         ExcMessage("A factorization has already been computed."));
+
+  inverse_diagonal.resize_fast(static_cast<std::size_t>(n_batches()) *
+                               n_rows);
+  pivots.resize(static_cast<std::size_t>(n_batches()) * n_rows * n_lanes);
+
+  // the work per batch is cubic in the matrix size, so a small number of
+  // batches per task suffices to amortize the task overhead
+  parallel::apply_to_subranges(
+    0U,
+    n_batches(),
+    [this](const size_type begin, const size_type end) {
+      lu_factorization_range(begin, end);
+    },
+    std::max<unsigned int>(1U, 4096U / (n_rows * n_rows + 1)));
+
+  state = State::lu;
+}
+
+
+
+template <typename number>
+void
+BatchedFullMatrix<number>::lu_factorization_range(const size_type begin,
+                                                  const size_type end)
+{
+  const size_type n = n_rows;
+  for (size_type b = begin; b < end; ++b)
+    {
+      VectorizedArray<number> *a =
+        values.begin() + static_cast<std::size_t>(b) * n * n;
+      VectorizedArray<number> *inv_diag =
+        inverse_diagonal.begin() + static_cast<std::size_t>(b) * n;
+      size_type *pivot = pivots.data() + static_cast<std::size_t>(b) * n *
+                                           n_lanes;
+
+      for (size_type k = 0; k < n; ++k)
+        {
+          // find the pivot in each lane separately and exchange rows lane
+          // by lane
+          for (unsigned int l = 0; l < n_lanes; ++l)
+            {
+              size_type p       = k;
+              number    max_val = std::abs(a[k * n + k][l]);
+              for (size_type r = k + 1; r < n; ++r)
+                if (std::abs(a[r * n + k][l]) > max_val)
+                  {
+                    max_val = std::abs(a[r * n + k][l]);
+                    p       = r;
+                  }
+              AssertThrow(max_val > number(0.), LACExceptions::ExcSingular());
+
+              pivot[k * n_lanes + l] = p;
+              if (p != k)
+                for (size_type j = 0; j < n; ++j)
+                  std::swap(a[k * n + j][l], a[p * n + j][l]);
+            }
+
+          // the elimination works on all lanes at once
+          const VectorizedArray<number> inv_pivot =
+            VectorizedArray<number>(1.) / a[k * n + k];
+          inv_diag[k] = inv_pivot;
+          for (size_type r = k + 1; r < n; ++r)
+            {
+              const VectorizedArray<number> factor = a[r * n + k] * inv_pivot;
+              a[r * n + k]                         = factor;
+              for (size_type j = k + 1; j < n; ++j)
+                a[r * n + j] -= factor * a[k * n + j];
+            }
+        }
+    }
+}
+
+
+
+template <typename number>
+void
+BatchedFullMatrix<number>::compute_cholesky_factorization()
+{
+  Assert(state == State::matrix,
+         ExcMessage("A factorization has already been computed."));
+
+  inverse_diagonal.resize_fast(static_cast<std::size_t>(n_batches()) *
+                               n_rows);
+  pivots.clear();
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches(),
+    [this](const size_type begin, const size_type end) {
+      cholesky_factorization_range(begin, end);
+    },
+    std::max<unsigned int>(1U, 4096U / (n_rows * n_rows + 1)));
+
+  state = State::cholesky;
+}
+
+
+
+template <typename number>
+void
+BatchedFullMatrix<number>::cholesky_factorization_range(const size_type begin,
+                                                        const size_type end)
+{
+  const size_type n = n_rows;
+  for (size_type b = begin; b < end; ++b)
+    {
+      VectorizedArray<number> *a =
+        values.begin() + static_cast<std::size_t>(b) * n * n;
+      VectorizedArray<number> *inv_diag =
+        inverse_diagonal.begin() + static_cast<std::size_t>(b) * n;
+
+      // column-wise right-looking variant on the lower triangle
+      for (size_type j = 0; j < n; ++j)
+        {
+          const VectorizedArray<number> diagonal = a[j * n + j];
+          for (unsigned int l = 0; l < n_lanes; ++l)
+            AssertThrow(diagonal[l] > number(0.),
+                        ExcMessage("The matrix is not positive definite."));
+
+          const VectorizedArray<number> l_jj = std::sqrt(diagonal);
+          const VectorizedArray<number> inv_l_jj =
+            VectorizedArray<number>(1.) / l_jj;
+          a[j * n + j] = l_jj;
+          inv_diag[j]  = inv_l_jj;
+
+          for (size_type i = j + 1; i < n; ++i)
+            a[i * n + j] *= inv_l_jj;
+          for (size_type k = j + 1; k < n; ++k)
+            for (size_type i = k; i < n; ++i)
+              a[i * n + k] -= a[i * n + j] * a[k * n + j];
+        }
+    }
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+BatchedFullMatrix<number>::solve(const size_type  index,
+                                 Vector<number2> &v,
+                                 const bool       transposed) const
+{
+  AssertIndexRange(index, n_stored_matrices);
+  Assert(state == State::lu || state == State::cholesky,
+         ExcMessage("You need to compute a factorization first."));
+  AssertIndexRange(v.size(), n_rows + 1);
+
+  // the matrices set by set_matrix() with fewer rows are embedded into the
+  // identity, so it suffices to work on the leading m x m block
+  const size_type m = v.size();
+  const size_type n = n_rows;
+  const size_type l = index % n_lanes;
+
+  const VectorizedArray<number> *a =
+    values.begin() + static_cast<std::size_t>(index / n_lanes) * n * n;
+  const VectorizedArray<number> *inv_diag =
+    inverse_diagonal.begin() + static_cast<std::size_t>(index / n_lanes) * n;
+
+  if (state == State::lu && transposed == false)
+    {
+      const size_type *pivot =
+        pivots.data() + static_cast<std::size_t>(index / n_lanes) * n * n_lanes;
+      for (size_type k = 0; k < m; ++k)
+        if (pivot[k * n_lanes + l] != k)
+          std::swap(v(k), v(pivot[k * n_lanes + l]));
+
+      // L has unit diagonal
+      for (size_type i = 1; i < m; ++i)
+        {
+          number2 sum = v(i);
+          for (size_type j = 0; j < i; ++j)
+            sum -= a[i * n + j][l] * v(j);
+          v(i) = sum;
+        }
+      for (size_type i = m; i-- > 0;)
+        {
+          number2 sum = v(i);
+          for (size_type j = i + 1; j < m; ++j)
+            sum -= a[i * n + j][l] * v(j);
+          v(i) = sum * inv_diag[i][l];
+        }
+    }
+  else if (state == State::lu)
+    {
+      // solve U^T L^T P x = v
+      for (size_type i = 0; i < m; ++i)
+        {
+          number2 sum = v(i);
+          for (size_type j = 0; j < i; ++j)
+            sum -= a[j * n + i][l] * v(j);
+          v(i) = sum * inv_diag[i][l];
+        }
+      for (size_type i = m; i-- > 0;)
+        {
+          number2 sum = v(i);
+          for (size_type j = i + 1; j < m; ++j)
+            sum -= a[j * n + i][l] * v(j);
+          v(i) = sum;
+        }
+
+      const size_type *pivot =
+        pivots.data() + static_cast<std::size_t>(index / n_lanes) * n * n_lanes;
+      for (size_type k = m; k-- > 0;)
+        if (pivot[k * n_lanes + l] != k)
+          std::swap(v(k), v(pivot[k * n_lanes + l]));
+    }
+  else
+    {
+      // the Cholesky factorization is symmetric, so the transposed solve is
+      // the same
+      for (size_type i = 0; i < m; ++i)
+        {
+          number2 sum = v(i);
+          for (size_type j = 0; j < i; ++j)
+            sum -= a[i * n + j][l] * v(j);
+          v(i) = sum * inv_diag[i][l];
+        }
+      for (size_type i = m; i-- > 0;)
+        {
+          number2 sum = v(i);
+          for (size_type j = i + 1; j < m; ++j)
+            sum -= a[j * n + i][l] * v(j);
+          v(i) = sum * inv_diag[i][l];
+        }
+    }
+}
+
+
+
+template <typename number>
+void
+BatchedFullMatrix<number>::solve(
+  const size_type                           batch,
+  const ArrayView<VectorizedArray<number>> &v,
+  const bool                                transposed) const
+{
+  AssertIndexRange(batch, n_batches());
+  Assert(state == State::lu || state == State::cholesky,
+         ExcMessage("You need to compute a factorization first."));
+  AssertDimension(v.size(), n_rows);
+
+  const size_type n = n_rows;
+
+  const VectorizedArray<number> *a =
+    values.begin() + static_cast<std::size_t>(batch) * n * n;
+  const VectorizedArray<number> *inv_diag =
+    inverse_diagonal.begin() + static_cast<std::size_t>(batch) * n;
+
+  const auto apply_pivots = [&](const size_type k) {
+    const size_type *pivot =
+      pivots.data() + (static_cast<std::size_t>(batch) * n + k) * n_lanes;
+    for (unsigned int l = 0; l < n_lanes; ++l)
+      if (pivot[l] != k)
+        std::swap(v[k][l], v[pivot[l]][l]);
+  };
+
+  if (state == State::lu && transposed == false)
+    {
+      for (size_type k = 0; k < n; ++k)
+        apply_pivots(k);
+      for (size_type i = 1; i < n; ++i)
+        {
+          VectorizedArray<number> sum = v[i];
+          for (size_type j = 0; j < i; ++j)
+            sum -= a[i * n + j] * v[j];
+          v[i] = sum;
+        }
+      for (size_type i = n; i-- > 0;)
+        {
+          VectorizedArray<number> sum = v[i];
+          for (size_type j = i + 1; j < n; ++j)
+            sum -= a[i * n + j] * v[j];
+          v[i] = sum * inv_diag[i];
+        }
+    }
+  else if (state == State::lu)
+    {
+      for (size_type i = 0; i < n; ++i)
+        {
+          VectorizedArray<number> sum = v[i];
+          for (size_type j = 0; j < i; ++j)
+            sum -= a[j * n + i] * v[j];
+          v[i] = sum * inv_diag[i];
+        }
+      for (size_type i = n; i-- > 0;)
+        {
+          VectorizedArray<number> sum = v[i];
+          for (size_type j = i + 1; j < n; ++j)
+            sum -= a[j * n + i] * v[j];
+          v[i] = sum;
+        }
+      for (size_type k = n; k-- > 0;)
+        apply_pivots(k);
+    }
+  else
+    {
+      for (size_type i = 0; i < n; ++i)
+        {
+          VectorizedArray<number> sum = v[i];
+          for (size_type j = 0; j < i; ++j)
+            sum -= a[i * n + j] * v[j];
+          v[i] = sum * inv_diag[i];
+        }
+      for (size_type i = n; i-- > 0;)
+        {
+          VectorizedArray<number> sum = v[i];
+          for (size_type j = i + 1; j < n; ++j)
+            sum -= a[j * n + i] * v[j];
+          v[i] = sum * inv_diag[i];
+        }
+    }
+}
+
+
+
+template <typename number>
+std::size_t
+BatchedFullMatrix<number>::memory_consumption() const
+{
+  return sizeof(*this) + values.memory_consumption() +
+         inverse_diagonal.memory_consumption() +
+         MemoryConsumption::memory_consumption(pivots);
+}
+
+
+
+template class BatchedFullMatrix<float>;
+template class BatchedFullMatrix<double>;
+
+template void
+BatchedFullMatrix<float>::set_matrix(const size_type,
+                                     const FullMatrix<float> &);
+template void
+BatchedFullMatrix<float>::set_matrix(const size_type,
+                                     const FullMatrix<double> &);
+template void
+BatchedFullMatrix<double>::set_matrix(const size_type,
+                                      const FullMatrix<float> &);
+template void
+BatchedFullMatrix<double>::set_matrix(const size_type,
+                                      const FullMatrix<double> &);
+
+template void
+BatchedFullMatrix<float>::solve(const size_type, Vector<float> &, const bool)
+  const;
+template void
+BatchedFullMatrix<float>::solve(const size_type, Vector<double> &, const bool)
+  const;
+template void
+BatchedFullMatrix<double>::solve(const size_type, Vector<float> &, const bool)
+  const;
+template void
+BatchedFullMatrix<double>::solve(const size_type, Vector<double> &, const bool)
+  const;
+
+DEAL_II_NAMESPACE_CLOSE
@@ -18,6 +18,8 @@
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
 
+#include <algorithm>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -220,6 +222,66 @@ ChunkSparsityPattern::copy_from(const SparsityPatternType &dsp,
 
 
 
+template <typename SparsityPatternType>
+void
+ChunkSparsityPattern::copy_from(const SparsityPatternType &dsp)
+{
+  copy_from(dsp, determine_chunk_size(dsp));
+}
+
+
+
+template <typename SparsityPatternType>
+ChunkSparsityPattern::size_type
+ChunkSparsityPattern::determine_chunk_size(const SparsityPatternType &dsp)
+{
+  const size_type candidates[] = {1, 2, 3, 4, 8};
+
+  size_type              best_chunk_size = 1;
+  double                 best_cost       = 0;
+  std::vector<size_type> chunk_columns;
+  for (const size_type chunk_size : candidates)
+    {
+      if (chunk_size > 1 &&
+          (chunk_size > dsp.n_rows() || chunk_size > dsp.n_cols()))
+        break;
+
+      // count the number of chunks needed to cover all entries
+      std::size_t n_chunks = 0;
+      for (size_type row_begin = 0; row_begin < dsp.n_rows();
+           row_begin += chunk_size)
+        {
+          chunk_columns.clear();
+          const size_type row_end =
+            std::min(row_begin + chunk_size, dsp.n_rows());
+          for (size_type row = row_begin; row < row_end; ++row)
+            for (typename SparsityPatternType::iterator col_num =
+                   dsp.begin(row);
+                 col_num != dsp.end(row);
+                 ++col_num)
+              chunk_columns.push_back(col_num->column() / chunk_size);
+          std::sort(chunk_columns.begin(), chunk_columns.end());
+          n_chunks += std::unique(chunk_columns.begin(), chunk_columns.end()) -
+                      chunk_columns.begin();
+        }
+
+      // the data read by a matrix-vector product: one value per entry of a
+      // chunk and one column index per chunk
+      const double cost =
+        static_cast<double>(n_chunks) *
+        (chunk_size * chunk_size * sizeof(double) + sizeof(size_type));
+      if (chunk_size == 1 || cost < best_cost)
+        {
+          best_chunk_size = chunk_size;
+          best_cost       = cost;
+        }
+    }
+
+  return best_chunk_size;
+}
+
+
+
 template <typename number>
 void
 ChunkSparsityPattern::copy_from(const FullMatrix<number> &matrix,
@@ -599,6 +661,15 @@ ChunkSparsityPattern::copy_from<DynamicSparsityPattern>(
   const DynamicSparsityPattern &,
   const size_type);
 template void
+ChunkSparsityPattern::copy_from<DynamicSparsityPattern>(
+  const DynamicSparsityPattern &);
+template ChunkSparsityPattern::size_type
+ChunkSparsityPattern::determine_chunk_size<DynamicSparsityPattern>(
+  const DynamicSparsityPattern &);
+template ChunkSparsityPattern::size_type
+ChunkSparsityPattern::determine_chunk_size<SparsityPattern>(
+  const SparsityPattern &);
+template void
 ChunkSparsityPattern::create_from<SparsityPattern>(const size_type,
                                                    const size_type,
                                                    const SparsityPattern &,
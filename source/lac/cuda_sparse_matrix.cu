@@ -96,14 +96,16 @@ namespace CUDAWrappers
 
 
     void
-    csrmv(cusparseHandle_t           handle,
-          bool                       transpose,
-          int                        m,
-          int                        n,
-          const cusparseSpMatDescr_t sp_descr,
-          const float *              x,
-          bool                       add,
-          float *                    y)
+    csrmv(cusparseHandle_t                           handle,
+          bool                                       transpose,
+          int                                        m,
+          int                                        n,
+          const cusparseSpMatDescr_t                 sp_descr,
+          const float *                              x,
+          bool                                       add,
+          float *                                    y,
+          std::unique_ptr<char[], void (*)(char *)> &buffer,
+          std::size_t &                              buffer_size)
     {
       float               alpha = 1.;
       float               beta  = add ? 1. : 0.;
@@ -129,8 +131,9 @@ namespace CUDAWrappers
       AssertCusparse(error_code);
 
       // This function performs y = alpha*op(A)*x + beta*y
-      size_t buffer_size = 0;
-      error_code         = cusparseSpMV_bufferSize(handle,
+      size_t required_buffer_size = 0;
+
+      error_code = cusparseSpMV_bufferSize(handle,
                                            cusparse_operation,
                                            &alpha,
                                            sp_descr,
@@ -139,11 +142,21 @@ namespace CUDAWrappers
                                            y_cuvec,
                                            CUDA_R_32F,
                                            CUSPARSE_MV_ALG_DEFAULT,
-                                           &buffer_size);
+                                           &required_buffer_size);
+      AssertCusparse(error_code);
 
-      void *      buffer          = nullptr;
-      cudaError_t cuda_error_code = cudaMalloc(&buffer, buffer_size);
-      AssertCuda(cuda_error_code);
+      // The workspace is kept between calls and only reallocated if it is
+      // too small, which avoids a cudaMalloc/cudaFree pair (and the implied
+      // device synchronization) in every matrix-vector product.
+      if (required_buffer_size > buffer_size)
+        {
+          char *            new_buffer      = nullptr;
+          const cudaError_t cuda_error_code =
+            cudaMalloc(&new_buffer, required_buffer_size);
+          AssertCuda(cuda_error_code);
+          buffer.reset(new_buffer);
+          buffer_size = required_buffer_size;
+        }
 
       // execute SpMV
       error_code = cusparseSpMV(handle,
@@ -155,11 +168,9 @@ namespace CUDAWrappers
                                 y_cuvec,
                                 CUDA_R_32F,
                                 CUSPARSE_MV_ALG_DEFAULT,
-                                buffer);
+                                buffer.get());
       AssertCusparse(error_code);
 
-      cuda_error_code = cudaFree(buffer);
-      AssertCuda(cuda_error_code);
       error_code = cusparseDestroyDnVec(x_cuvec);
       AssertCusparse(error_code);
       error_code = cusparseDestroyDnVec(y_cuvec);
@@ -169,14 +180,16 @@ namespace CUDAWrappers
 
 
     void
-    csrmv(cusparseHandle_t           handle,
-          bool                       transpose,
-          int                        m,
-          int                        n,
-          const cusparseSpMatDescr_t sp_descr,
-          const double *             x,
-          bool                       add,
-          double *                   y)
+    csrmv(cusparseHandle_t                           handle,
+          bool                                       transpose,
+          int                                        m,
+          int                                        n,
+          const cusparseSpMatDescr_t                 sp_descr,
+          const double *                             x,
+          bool                                       add,
+          double *                                   y,
+          std::unique_ptr<char[], void (*)(char *)> &buffer,
+          std::size_t &                              buffer_size)
     {
       double              alpha = 1.;
       double              beta  = add ? 1. : 0.;
@@ -202,8 +215,9 @@ namespace CUDAWrappers
       AssertCusparse(error_code);
 
       // This function performs y = alpha*op(A)*x + beta*y
-      size_t buffer_size = 0;
-      error_code         = cusparseSpMV_bufferSize(handle,
+      size_t required_buffer_size = 0;
+
+      error_code = cusparseSpMV_bufferSize(handle,
                                            cusparse_operation,
                                            &alpha,
                                            sp_descr,
@@ -212,11 +226,21 @@ namespace CUDAWrappers
                                            y_cuvec,
                                            CUDA_R_64F,
                                            CUSPARSE_MV_ALG_DEFAULT,
-                                           &buffer_size);
+                                           &required_buffer_size);
+      AssertCusparse(error_code);
 
-      void *      buffer          = nullptr;
-      cudaError_t cuda_error_code = cudaMalloc(&buffer, buffer_size);
-      AssertCuda(cuda_error_code);
+      // The workspace is kept between calls and only reallocated if it is
+      // too small, which avoids a cudaMalloc/cudaFree pair (and the implied
+      // device synchronization) in every matrix-vector product.
+      if (required_buffer_size > buffer_size)
+        {
+          char *            new_buffer      = nullptr;
+          const cudaError_t cuda_error_code =
+            cudaMalloc(&new_buffer, required_buffer_size);
+          AssertCuda(cuda_error_code);
+          buffer.reset(new_buffer);
+          buffer_size = required_buffer_size;
+        }
 
       // execute SpMV
       error_code = cusparseSpMV(handle,
@@ -228,11 +252,9 @@ namespace CUDAWrappers
                                 y_cuvec,
                                 CUDA_R_64F,
                                 CUSPARSE_MV_ALG_DEFAULT,
-                                buffer);
+                                buffer.get());
       AssertCusparse(error_code);
 
-      cuda_error_code = cudaFree(buffer);
-      AssertCuda(cuda_error_code);
       error_code = cusparseDestroyDnVec(x_cuvec);
       AssertCusparse(error_code);
       error_code = cusparseDestroyDnVec(y_cuvec);
@@ -292,6 +314,8 @@ namespace CUDAWrappers
     , row_ptr_dev(nullptr, Utilities::CUDA::delete_device_data<int>)
     , descr(nullptr)
     , sp_descr(nullptr)
+    , buffer_dev(nullptr, Utilities::CUDA::delete_device_data<char>)
+    , buffer_size(0)
   {}
 
 
@@ -305,6 +329,8 @@ namespace CUDAWrappers
     , row_ptr_dev(nullptr, Utilities::CUDA::delete_device_data<int>)
     , descr(nullptr)
     , sp_descr(nullptr)
+    , buffer_dev(nullptr, Utilities::CUDA::delete_device_data<char>)
+    , buffer_size(0)
   {
     reinit(handle, sparse_matrix_host);
   }
@@ -322,12 +348,15 @@ namespace CUDAWrappers
     , row_ptr_dev(std::move(other.row_ptr_dev))
     , descr(other.descr)
     , sp_descr(other.sp_descr)
+    , buffer_dev(std::move(other.buffer_dev))
+    , buffer_size(other.buffer_size)
   {
     other.nnz      = 0;
     other.n_rows   = 0;
     other.n_cols   = 0;
-    other.descr    = nullptr;
-    other.sp_descr = nullptr;
+    other.descr       = nullptr;
+    other.sp_descr    = nullptr;
+    other.buffer_size = 0;
   }
 
 
@@ -370,12 +399,15 @@ namespace CUDAWrappers
     row_ptr_dev      = std::move(other.row_ptr_dev);
     descr            = other.descr;
     sp_descr         = other.sp_descr;
+    buffer_dev       = std::move(other.buffer_dev);
+    buffer_size      = other.buffer_size;
 
-    other.nnz      = 0;
-    other.n_rows   = 0;
-    other.n_cols   = 0;
-    other.descr    = nullptr;
-    other.sp_descr = nullptr;
+    other.nnz         = 0;
+    other.n_rows      = 0;
+    other.n_cols      = 0;
+    other.descr       = nullptr;
+    other.sp_descr    = nullptr;
+    other.buffer_size = 0;
 
     return *this;
   }
@@ -520,7 +552,9 @@ namespace CUDAWrappers
                     sp_descr,
                     src.get_values(),
                     false,
-                    dst.get_values());
+                    dst.get_values(),
+                    buffer_dev,
+                    buffer_size);
   }
 
 
@@ -538,7 +572,9 @@ namespace CUDAWrappers
                     sp_descr,
                     src.get_values(),
                     false,
-                    dst.get_values());
+                    dst.get_values(),
+                    buffer_dev,
+                    buffer_size);
   }
 
 
@@ -556,7 +592,9 @@ namespace CUDAWrappers
                     sp_descr,
                     src.get_values(),
                     true,
-                    dst.get_values());
+                    dst.get_values(),
+                    buffer_dev,
+                    buffer_size);
   }
 
 
@@ -574,7 +612,9 @@ namespace CUDAWrappers
                     sp_descr,
                     src.get_values(),
                     true,
-                    dst.get_values());
+                    dst.get_values(),
+                    buffer_dev,
+                    buffer_size);
   }
 
 
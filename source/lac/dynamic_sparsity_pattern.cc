@@ -224,6 +224,7 @@ DynamicSparsityPattern::DynamicSparsityPattern()
   , rows(0)
   , cols(0)
   , rowset(0)
+  , n_tracked_bytes(0)
 {}
 
 
@@ -234,6 +235,7 @@ DynamicSparsityPattern::DynamicSparsityPattern(const DynamicSparsityPattern &s)
   , rows(0)
   , cols(0)
   , rowset(0)
+  , n_tracked_bytes(0)
 {
   (void)s;
   Assert(s.rows == 0 && s.cols == 0,
@@ -252,6 +254,7 @@ DynamicSparsityPattern::DynamicSparsityPattern(const size_type m,
   , rows(0)
   , cols(0)
   , rowset(0)
+  , n_tracked_bytes(0)
 {
   reinit(m, n, rowset_);
 }
@@ -262,6 +265,7 @@ DynamicSparsityPattern::DynamicSparsityPattern(const IndexSet &rowset_)
   , rows(0)
   , cols(0)
   , rowset(0)
+  , n_tracked_bytes(0)
 {
   reinit(rowset_.size(), rowset_.size(), rowset_);
 }
@@ -272,12 +276,22 @@ DynamicSparsityPattern::DynamicSparsityPattern(const size_type n)
   , rows(0)
   , cols(0)
   , rowset(0)
+  , n_tracked_bytes(0)
 {
   reinit(n, n);
 }
 
 
 
+DynamicSparsityPattern::~DynamicSparsityPattern()
+{
+  if (n_tracked_bytes > 0)
+    MemoryTracker::deallocate(MemoryTracker::dynamic_sparsity_pattern,
+                              n_tracked_bytes);
+}
+
+
+
 DynamicSparsityPattern &
 DynamicSparsityPattern::operator=(const DynamicSparsityPattern &s)
 {
@@ -318,6 +332,19 @@ DynamicSparsityPattern::reinit(const size_type m,
 
   std::vector<Line> new_lines(rowset.size() == 0 ? rows : rowset.n_elements());
   lines.swap(new_lines);
+
+  // the old rows are released at the end of this function, and only the
+  // array of (empty) rows remains
+  if (n_tracked_bytes > 0)
+    MemoryTracker::deallocate(MemoryTracker::dynamic_sparsity_pattern,
+                              n_tracked_bytes);
+  n_tracked_bytes = 0;
+  if (MemoryTracker::is_enabled())
+    {
+      n_tracked_bytes = lines.capacity() * sizeof(Line);
+      MemoryTracker::allocate(MemoryTracker::dynamic_sparsity_pattern,
+                              n_tracked_bytes);
+    }
 }
 
 
@@ -423,6 +450,7 @@ DynamicSparsityPattern::clear_row(const size_type row)
     rowset.size() == 0 ? row : rowset.index_within_set(row);
 
   AssertIndexRange(rowindex, lines.size());
+  track_capacity_change(lines[rowindex].entries.capacity(), 0);
   lines[rowindex].entries = std::vector<size_type>();
 }
 
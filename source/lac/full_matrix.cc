@@ -24,9 +24,10 @@ DEAL_II_NAMESPACE_OPEN
 #ifndef DOXYGEN
 
 #  ifndef DEAL_II_WITH_COMPLEX_VALUES
-// instantiate for std::complex<double> because we use it internally in
-// FESeries.
+// instantiate for the complex types because we use them internally in
+// FESeries and for the eigenvectors returned by LAPACKFullMatrix.
 template class FullMatrix<std::complex<double>>;
+template class FullMatrix<std::complex<float>>;
 #  endif
 
 // instantiate for long double manually because we use it in a few places
@@ -97,27 +97,46 @@ namespace GinkgoWrappers
     Assert(rhs.size() == solution.size(),
            ExcDimensionMismatch(rhs.size(), solution.size()));
 
-    // Generate the solver from the solver using the system matrix.
-    auto solver = solver_gen->generate(system_matrix);
-
-    // Create the rhs vector in Ginkgo's format.
-    std::vector<ValueType> f(rhs.size());
-    std::copy(rhs.begin(), rhs.begin() + rhs.size(), f.begin());
-    auto b =
-      vec::create(executor,
+    // Generate the solver from the solver using the system matrix. This is
+    // only necessary once after each call to initialize().
+    if (!solver)
+      solver = solver_gen->generate(system_matrix);
+
+    // Wrap the rhs and solution vectors in Ginkgo's format without copying
+    // them. Ginkgo does not modify the rhs, so we can safely cast away the
+    // constness here.
+    auto b_master =
+      vec::create(executor->get_master(),
                   gko::dim<2>(rhs.size(), 1),
-                  val_array::view(executor->get_master(), rhs.size(), f.data()),
+                  val_array::view(executor->get_master(),
+                                  rhs.size(),
+                                  const_cast<ValueType *>(rhs.begin())),
                   1);
-
-    // Create the solution vector in Ginkgo's format.
-    std::vector<ValueType> u(solution.size());
-    std::copy(solution.begin(), solution.begin() + solution.size(), u.begin());
-    auto x = vec::create(executor,
-                         gko::dim<2>(solution.size(), 1),
-                         val_array::view(executor->get_master(),
-                                         solution.size(),
-                                         u.data()),
-                         1);
+    auto x_master = vec::create(executor->get_master(),
+                                gko::dim<2>(solution.size(), 1),
+                                val_array::view(executor->get_master(),
+                                                solution.size(),
+                                                solution.begin()),
+                                1);
+
+    // On a host executor the solver works directly on these views. Otherwise
+    // the data is copied into the work vectors on the device, which are kept
+    // between the calls of this function.
+    vec *b = b_master.get();
+    vec *x = x_master.get();
+    if (executor != executor->get_master())
+      {
+        if (!device_rhs || device_rhs->get_size()[0] != rhs.size())
+          {
+            device_rhs = vec::create(executor, gko::dim<2>(rhs.size(), 1));
+            device_solution =
+              vec::create(executor, gko::dim<2>(solution.size(), 1));
+          }
+        device_rhs->copy_from(b_master.get());
+        device_solution->copy_from(x_master.get());
+        b = device_rhs.get();
+        x = device_solution.get();
+      }
 
     // Create the logger object to log some data from the solvers to confirm
     // convergence.
@@ -129,7 +148,7 @@ namespace GinkgoWrappers
     combined_factory->add_logger(convergence_logger);
 
     // Finally, apply the solver to b and get the solution in x.
-    solver->apply(gko::lend(b), gko::lend(x));
+    solver->apply(b, x);
 
     // The convergence_logger object contains the residual vector after the
     // solver has returned. use this vector to compute the residual norm of the
@@ -154,20 +173,7 @@ namespace GinkgoWrappers
     // residual, we divide by the norm of the rhs.
     auto b_norm = gko::matrix::Dense<ValueType>::create(executor->get_master(),
                                                         gko::dim<2>{1, 1});
-    if (executor != executor->get_master())
-      {
-        auto b_master = vec::create(executor->get_master(),
-                                    gko::dim<2>(rhs.size(), 1),
-                                    val_array::view(executor->get_master(),
-                                                    rhs.size(),
-                                                    f.data()),
-                                    1);
-        b_master->compute_norm2(b_norm.get());
-      }
-    else
-      {
-        b->compute_norm2(b_norm.get());
-      }
+    b_master->compute_norm2(b_norm.get());
 
     Assert(b_norm.get()->at(0, 0) != 0.0, ExcDivideByZero());
     // Pass the number of iterations and residual norm to the solver_control
@@ -185,21 +191,10 @@ namespace GinkgoWrappers
                                                solver_control.last_value()));
 
     // Check if the solution is on a CUDA device, if so, copy it over to the
-    // host.
+    // host. Otherwise, the solver has already written into deal.II's solution
+    // vector.
     if (executor != executor->get_master())
-      {
-        auto x_master = vec::create(executor->get_master(),
-                                    gko::dim<2>(solution.size(), 1),
-                                    val_array::view(executor,
-                                                    solution.size(),
-                                                    x->get_values()),
-                                    1);
-        x.reset(x_master.release());
-      }
-    // Finally copy over the solution vector to deal.II's solution vector.
-    std::copy(x->get_values(),
-              x->get_values() + solution.size(),
-              solution.begin());
+      x_master->copy_from(device_solution.get());
   }
 
 
@@ -280,9 +275,20 @@ namespace GinkgoWrappers
       for (size_type i = 0; i < N - 1; ++i)
         Assert(row_pointers[i] == mat_row_ptrs[i + 1], ExcInternalError());
     }
-    system_matrix =
-      mtx::create(executor, gko::dim<2>(N), matrix.n_nonzero_elements());
-    system_matrix->copy_from(system_matrix_compute.get());
+
+    // On a host executor the matrix assembled above can be used directly;
+    // otherwise, it is copied to the executor once and kept there.
+    if (executor == executor->get_master())
+      system_matrix = std::move(system_matrix_compute);
+    else
+      {
+        system_matrix =
+          mtx::create(executor, gko::dim<2>(N), matrix.n_nonzero_elements());
+        system_matrix->copy_from(system_matrix_compute.get());
+      }
+
+    // The solver has to be generated anew for the new matrix.
+    solver.reset();
   }
 
 
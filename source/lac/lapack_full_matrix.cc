@@ -1956,6 +1956,94 @@ LAPACKFullMatrix<number>::compute_eigenvalues(const bool right, const bool left)
 }
 
 
+
+namespace
+{
+  // Unpack the eigenvectors in the column-major array @p lapack_vectors as
+  // returned by xGEEV into the columns of @p eigenvectors. For real
+  // matrices, a complex conjugate pair of eigenvalues is signaled by a
+  // nonzero imaginary part, in which case the two columns hold the real and
+  // imaginary parts of the eigenvector of the first eigenvalue of the pair.
+  template <typename RealNumber>
+  void
+  unpack_eigenvectors(const std::vector<RealNumber> &       lapack_vectors,
+                      const std::vector<RealNumber> &       imag_eigenvalues,
+                      FullMatrix<std::complex<RealNumber>> &eigenvectors)
+  {
+    const std::size_t n = eigenvectors.n();
+    for (std::size_t j = 0; j < n;)
+      if (imag_eigenvalues[j] == RealNumber() || j + 1 == n)
+        {
+          for (std::size_t i = 0; i < n; ++i)
+            eigenvectors(i, j) = lapack_vectors[j * n + i];
+          ++j;
+        }
+      else
+        {
+          for (std::size_t i = 0; i < n; ++i)
+            {
+              const std::complex<RealNumber> value(
+                lapack_vectors[j * n + i], lapack_vectors[(j + 1) * n + i]);
+              eigenvectors(i, j)     = value;
+              eigenvectors(i, j + 1) = std::conj(value);
+            }
+          j += 2;
+        }
+  }
+
+
+
+  template <typename RealNumber>
+  void
+  unpack_eigenvectors(
+    const std::vector<std::complex<RealNumber>> &lapack_vectors,
+    const std::vector<std::complex<RealNumber>> & /*eigenvalues*/,
+    FullMatrix<std::complex<RealNumber>> &eigenvectors)
+  {
+    const std::size_t n = eigenvectors.n();
+    for (std::size_t j = 0; j < n; ++j)
+      for (std::size_t i = 0; i < n; ++i)
+        eigenvectors(i, j) = lapack_vectors[j * n + i];
+  }
+} // namespace
+
+
+
+template <typename number>
+FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+LAPACKFullMatrix<number>::get_right_eigenvectors() const
+{
+  Assert(state & LAPACKSupport::eigenvalues, ExcInvalidState());
+  const std::size_t nn = this->n();
+  Assert(vr.size() == nn * nn,
+         ExcMessage("Right eigenvectors are not available. Call "
+                    "compute_eigenvalues() with right_eigenvectors=true."));
+
+  FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+    eigenvectors(nn, nn);
+  unpack_eigenvectors(vr, wi, eigenvectors);
+  return eigenvectors;
+}
+
+
+
+template <typename number>
+FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+LAPACKFullMatrix<number>::get_left_eigenvectors() const
+{
+  Assert(state & LAPACKSupport::eigenvalues, ExcInvalidState());
+  const std::size_t nn = this->n();
+  Assert(vl.size() == nn * nn,
+         ExcMessage("Left eigenvectors are not available. Call "
+                    "compute_eigenvalues() with left_eigenvectors=true."));
+
+  FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+    eigenvectors(nn, nn);
+  unpack_eigenvectors(vl, wi, eigenvectors);
+  return eigenvectors;
+}
+
+
 template <typename number>
 void
 LAPACKFullMatrix<number>::compute_eigenvalues_symmetric(
@@ -161,6 +161,61 @@ namespace PETScWrappers
 
 
 
+  void
+  MatrixBase::set_coo_pattern(const std::vector<size_type> &row_indices,
+                              const std::vector<size_type> &col_indices)
+  {
+    AssertDimension(row_indices.size(), col_indices.size());
+    assert_is_compressed();
+
+#  if DEAL_II_PETSC_VERSION_LT(3, 14, 0)
+    (void)row_indices;
+    (void)col_indices;
+    AssertThrow(false,
+                ExcMessage("Assembly in COO format requires PETSc 3.14 or "
+                           "later."));
+#  else
+    // PETSc may modify the index arrays, so we always pass copies
+    std::vector<PetscInt> petsc_rows(row_indices.begin(), row_indices.end());
+    std::vector<PetscInt> petsc_cols(col_indices.begin(), col_indices.end());
+
+    const PetscErrorCode ierr = MatSetPreallocationCOO(matrix,
+                                                       petsc_rows.size(),
+                                                       petsc_rows.data(),
+                                                       petsc_cols.data());
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+#  endif
+  }
+
+
+
+  void
+  MatrixBase::set_values_coo(const std::vector<PetscScalar> &values,
+                             const VectorOperation::values   operation)
+  {
+    Assert(operation == VectorOperation::add ||
+             operation == VectorOperation::insert,
+           ExcMessage("Only adding or inserting values is supported."));
+    assert_is_compressed();
+
+#  if DEAL_II_PETSC_VERSION_LT(3, 14, 0)
+    (void)values;
+    (void)operation;
+    AssertThrow(false,
+                ExcMessage("Assembly in COO format requires PETSc 3.14 or "
+                           "later."));
+#  else
+    const PetscErrorCode ierr =
+      MatSetValuesCOO(matrix,
+                      values.data(),
+                      operation == VectorOperation::add ? ADD_VALUES :
+                                                          INSERT_VALUES);
+    AssertThrow(ierr == 0, ExcPETScError(ierr));
+#  endif
+  }
+
+
+
   PetscScalar
   MatrixBase::el(const size_type i, const size_type j) const
   {
@@ -23,11 +23,15 @@
 #  include <deal.II/base/mpi.templates.h>
 
 #  include <deal.II/lac/scalapack.templates.h>
+#  include <deal.II/lac/vector.h>
 
 #  ifdef DEAL_II_WITH_HDF5
 #    include <hdf5.h>
 #  endif
 
+#  include <algorithm>
+#  include <cmath>
+#  include <limits>
 #  include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -491,6 +495,162 @@ ScaLAPACKMatrix<NumberType>::copy_from(const LAPACKFullMatrix<NumberType> &B,
 
 
 
+template <typename NumberType>
+void
+ScaLAPACKMatrix<NumberType>::copy_from_start(
+  const LAPACKFullMatrix<NumberType> &B,
+  const unsigned int                  rank)
+{
+  Assert(copy_from_requests.empty(),
+         ExcMessage("The previous copy started by copy_from_start() has to "
+                    "be completed by copy_from_finish() first."));
+
+  if (n_rows * n_columns == 0)
+    return;
+
+  const unsigned int this_mpi_process(
+    Utilities::MPI::this_mpi_process(this->grid->mpi_communicator));
+
+#  ifdef DEBUG
+  Assert(Utilities::MPI::max(rank, this->grid->mpi_communicator) == rank,
+         ExcMessage("All processes have to call routine with identical rank"));
+  Assert(Utilities::MPI::min(rank, this->grid->mpi_communicator) == rank,
+         ExcMessage("All processes have to call routine with identical rank"));
+#  endif
+
+  const int mpi_tag = Utilities::MPI::internal::Tags::scalapack_copy_from_start;
+
+  // The processes of the grid and the ranks in the MPI communicator of the
+  // grid are related through the BLACS system context. The local array of
+  // each process is stored in column-major order with leading dimension
+  // n_local_rows, so the data can be received directly into the local array
+  // and only the sending process needs to reorder the entries.
+  if (this_mpi_process == rank)
+    {
+      Assert(grid->mpi_process_is_active, ExcInternalError());
+      Assert(n_rows == int(B.m()), ExcDimensionMismatch(n_rows, B.m()));
+      Assert(n_columns == int(B.n()), ExcDimensionMismatch(n_columns, B.n()));
+
+      const int n_active_processes =
+        grid->n_process_rows * grid->n_process_columns;
+
+      // determine the size of the local arrays of all processes to set up
+      // a single send buffer
+      std::vector<int>         process_rows(n_active_processes);
+      std::vector<int>         process_columns(n_active_processes);
+      std::vector<int>         n_process_local_rows(n_active_processes);
+      std::vector<int>         n_process_local_columns(n_active_processes);
+      std::vector<std::size_t> offsets(n_active_processes + 1, 0);
+      for (int p = 0; p < n_active_processes; ++p)
+        {
+          Cblacs_pcoord(grid->blacs_context,
+                        p,
+                        &process_rows[p],
+                        &process_columns[p]);
+          n_process_local_rows[p]    = numroc_(&n_rows,
+                                            &row_block_size,
+                                            &process_rows[p],
+                                            &first_process_row,
+                                            &(grid->n_process_rows));
+          n_process_local_columns[p] = numroc_(&n_columns,
+                                               &column_block_size,
+                                               &process_columns[p],
+                                               &first_process_column,
+                                               &(grid->n_process_columns));
+          offsets[p + 1] = offsets[p] + static_cast<std::size_t>(
+                                          n_process_local_rows[p]) *
+                                          n_process_local_columns[p];
+        }
+
+      copy_from_send_buffer.resize(offsets.back());
+      copy_from_requests.reserve(n_active_processes);
+      for (int p = 0; p < n_active_processes; ++p)
+        {
+          const bool  is_root = (static_cast<unsigned int>(p) == rank);
+          NumberType *buffer =
+            is_root ? this->values.data() :
+                      copy_from_send_buffer.data() + offsets[p];
+          for (int j = 0; j < n_process_local_columns[p]; ++j)
+            {
+              const int loc_j = j + 1;
+              const int glob_j =
+                indxl2g_(&loc_j,
+                         &column_block_size,
+                         &process_columns[p],
+                         &first_process_column,
+                         &(grid->n_process_columns)) -
+                1;
+              for (int i = 0; i < n_process_local_rows[p]; ++i)
+                {
+                  const int loc_i  = i + 1;
+                  const int glob_i = indxl2g_(&loc_i,
+                                              &row_block_size,
+                                              &process_rows[p],
+                                              &first_process_row,
+                                              &(grid->n_process_rows)) -
+                                     1;
+                  buffer[static_cast<std::size_t>(j) *
+                           n_process_local_rows[p] +
+                         i] = B(glob_i, glob_j);
+                }
+            }
+
+          if (!is_root && offsets[p + 1] > offsets[p])
+            {
+              copy_from_requests.emplace_back();
+              const int ierr = MPI_Isend(
+                buffer,
+                offsets[p + 1] - offsets[p],
+                Utilities::MPI::internal::mpi_type_id(buffer),
+                p,
+                mpi_tag,
+                grid->mpi_communicator,
+                &copy_from_requests.back());
+              AssertThrowMPI(ierr);
+            }
+        }
+    }
+  else if (grid->mpi_process_is_active && n_local_rows * n_local_columns > 0)
+    {
+      copy_from_requests.emplace_back();
+      const int ierr =
+        MPI_Irecv(this->values.data(),
+                  n_local_rows * n_local_columns,
+                  Utilities::MPI::internal::mpi_type_id(this->values.data()),
+                  rank,
+                  mpi_tag,
+                  grid->mpi_communicator,
+                  &copy_from_requests.back());
+      AssertThrowMPI(ierr);
+    }
+
+  // the matrix must not be used before the copy has completed
+  state = LAPACKSupport::unusable;
+}
+
+
+
+template <typename NumberType>
+void
+ScaLAPACKMatrix<NumberType>::copy_from_finish()
+{
+  if (copy_from_requests.size() > 0)
+    {
+      const int ierr = MPI_Waitall(copy_from_requests.size(),
+                                   copy_from_requests.data(),
+                                   MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+  copy_from_requests.clear();
+
+  // release the memory of the send buffer
+  std::vector<NumberType>().swap(copy_from_send_buffer);
+
+  state = LAPACKSupport::matrix;
+}
+
+
+
 template <typename NumberType>
 unsigned int
 ScaLAPACKMatrix<NumberType>::global_row(const unsigned int loc_row) const
@@ -1799,6 +1959,201 @@ ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_by_value_MRRR(
 
 
 
+template <typename NumberType>
+std::vector<NumberType>
+ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_by_index_mixed_precision(
+  const std::pair<unsigned int, unsigned int> &index_limits,
+  const unsigned int                           n_refinement_steps)
+{
+  Assert(state == LAPACKSupport::matrix,
+         ExcMessage(
+           "Matrix has to be in Matrix state before calling this function."));
+  Assert(property == LAPACKSupport::symmetric,
+         ExcMessage("Matrix has to be symmetric for this operation."));
+  Assert(row_block_size == column_block_size,
+         ExcMessage("The row and column block sizes have to be equal for "
+                    "this operation."));
+  AssertIndexRange(index_limits.first, static_cast<unsigned int>(n_rows));
+  AssertIndexRange(index_limits.second, static_cast<unsigned int>(n_rows));
+
+  const int block_size = row_block_size;
+
+  // keep the matrix for the refinement steps, and compute the eigenpairs of
+  // the single precision copy of the matrix, which has the same
+  // distribution
+  ScaLAPACKMatrix<NumberType> A(
+    n_rows, n_columns, grid, block_size, block_size, property);
+  copy_to(A);
+
+  ScaLAPACKMatrix<float> A_single(
+    n_rows, n_columns, grid, block_size, block_size, property);
+  if (grid->mpi_process_is_active)
+    for (int j = 0; j < n_local_columns; ++j)
+      for (int i = 0; i < n_local_rows; ++i)
+        A_single.local_el(i, j) = static_cast<float>(local_el(i, j));
+
+  const std::vector<float> eigenvalues_single =
+    A_single.eigenpairs_symmetric_by_index(index_limits, true);
+  std::vector<NumberType> eigenvalues(eigenvalues_single.begin(),
+                                      eigenvalues_single.end());
+  const int k = eigenvalues.size();
+
+  // The eigenvectors are stored in the first k columns of A_single. Since
+  // the local columns are numbered in the order of the global columns, they
+  // are the first local columns of a matrix with k columns and the same
+  // distribution.
+  ScaLAPACKMatrix<NumberType> V(n_rows, k, grid, block_size, block_size);
+  if (grid->mpi_process_is_active)
+    for (unsigned int j = 0; j < V.local_n(); ++j)
+      for (unsigned int i = 0; i < V.local_m(); ++i)
+        V.local_el(i, j) = A_single.local_el(i, j);
+
+  ScaLAPACKMatrix<NumberType> AV(n_rows, k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> R(n_rows, k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> AR(n_rows, k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> S(n_rows, 2 * k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> AS(n_rows, 2 * k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> C(k, k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> G(2 * k, 2 * k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> H(2 * k, 2 * k, grid, block_size, block_size);
+  ScaLAPACKMatrix<NumberType> Z(2 * k, k, grid, block_size, block_size);
+
+  // offsets and size of the blocks of k columns within S
+  const std::pair<unsigned int, unsigned int> origin(0, 0);
+  const std::pair<unsigned int, unsigned int> second_block(0, k);
+  const std::pair<unsigned int, unsigned int> block(n_rows, k);
+
+  for (unsigned int step = 0; step < n_refinement_steps && k > 0; ++step)
+    {
+      // Compute the residuals R = A V - V diag(eigenvalues) and make them
+      // orthogonal to V, which retains the accuracy of the small corrections
+      // contained in them. Then scale them to unit length.
+      A.mmult(AV, V);
+      AV.copy_to(R);
+      if (grid->mpi_process_is_active)
+        for (unsigned int j = 0; j < R.local_n(); ++j)
+          {
+            const NumberType lambda = eigenvalues[R.global_column(j)];
+            for (unsigned int i = 0; i < R.local_m(); ++i)
+              R.local_el(i, j) -= lambda * V.local_el(i, j);
+          }
+      for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+          V.Tmmult(C, R);
+          V.mult(-1., C, 1., R, false, false);
+        }
+
+      FullMatrix<NumberType> small_matrix(k, k);
+      R.Tmmult(C, R);
+      C.copy_to(small_matrix);
+      std::vector<NumberType> factors(k);
+      for (int j = 0; j < k; ++j)
+        factors[j] = (small_matrix(j, j) > NumberType() ?
+                        NumberType(1.) / std::sqrt(small_matrix(j, j)) :
+                        NumberType());
+      if (grid->mpi_process_is_active)
+        for (unsigned int j = 0; j < R.local_n(); ++j)
+          for (unsigned int i = 0; i < R.local_m(); ++i)
+            R.local_el(i, j) *= factors[R.global_column(j)];
+      A.mmult(AR, R);
+
+      // project the matrix onto the space spanned by S = [V, R]
+      V.copy_to(S, origin, origin, block);
+      R.copy_to(S, origin, second_block, block);
+      AV.copy_to(AS, origin, origin, block);
+      AR.copy_to(AS, origin, second_block, block);
+      S.Tmmult(G, S);
+      S.Tmmult(H, AS);
+
+      FullMatrix<NumberType> gram(2 * k, 2 * k), projected(2 * k, 2 * k);
+      G.copy_to(gram);
+      H.copy_to(projected);
+
+      // The columns of S are close to orthonormal, but R can be rank
+      // deficient once some eigenpairs are accurate. Orthonormalize S by
+      // the eigendecomposition of its Gram matrix, dropping the directions
+      // that are numerically dependent.
+      Vector<NumberType>     gram_eigenvalues;
+      FullMatrix<NumberType> gram_eigenvectors;
+      {
+        LAPACKFullMatrix<NumberType> lapack_gram(2 * k);
+        lapack_gram            = gram;
+        const NumberType bound = 1.01 * gram.linfty_norm();
+        lapack_gram.compute_eigenvalues_symmetric(
+          std::sqrt(std::numeric_limits<NumberType>::epsilon()) * bound,
+          bound,
+          NumberType(),
+          gram_eigenvalues,
+          gram_eigenvectors);
+      }
+      const unsigned int n_kept = gram_eigenvalues.size();
+      if (n_kept < static_cast<unsigned int>(k))
+        break;
+
+      FullMatrix<NumberType> basis(2 * k, n_kept);
+      for (unsigned int i = 0; i < static_cast<unsigned int>(2 * k); ++i)
+        for (unsigned int j = 0; j < n_kept; ++j)
+          basis(i, j) =
+            gram_eigenvectors(i, j) / std::sqrt(gram_eigenvalues(j));
+
+      FullMatrix<NumberType> tmp(2 * k, n_kept), reduced(n_kept, n_kept);
+      projected.mmult(tmp, basis);
+      basis.Tmmult(reduced, tmp);
+      reduced.symmetrize();
+
+      Vector<NumberType>     ritz_values;
+      FullMatrix<NumberType> ritz_vectors;
+      {
+        LAPACKFullMatrix<NumberType> lapack_reduced(n_kept);
+        lapack_reduced         = reduced;
+        const NumberType bound = 1.01 * reduced.linfty_norm() +
+                                 std::numeric_limits<NumberType>::min();
+        lapack_reduced.compute_eigenvalues_symmetric(
+          -bound, bound, NumberType(), ritz_values, ritz_vectors);
+      }
+      if (ritz_values.size() < static_cast<unsigned int>(k))
+        break;
+
+      // assign to each eigenvalue the closest Ritz value not used before,
+      // and sort the selected Ritz pairs in ascending order
+      std::vector<bool>         used(ritz_values.size(), false);
+      std::vector<unsigned int> selected;
+      for (int j = 0; j < k; ++j)
+        {
+          unsigned int best = numbers::invalid_unsigned_int;
+          for (unsigned int l = 0; l < ritz_values.size(); ++l)
+            if (!used[l] && (best == numbers::invalid_unsigned_int ||
+                             std::abs(ritz_values(l) - eigenvalues[j]) <
+                               std::abs(ritz_values(best) - eigenvalues[j])))
+              best = l;
+          used[best] = true;
+          selected.push_back(best);
+        }
+      std::sort(selected.begin(), selected.end());
+
+      FullMatrix<NumberType> coefficients(2 * k, k);
+      for (int j = 0; j < k; ++j)
+        {
+          eigenvalues[j] = ritz_values(selected[j]);
+          for (unsigned int i = 0; i < static_cast<unsigned int>(2 * k); ++i)
+            for (unsigned int l = 0; l < n_kept; ++l)
+              coefficients(i, j) += basis(i, l) * ritz_vectors(l, selected[j]);
+        }
+      Z = coefficients;
+      S.mmult(V, Z);
+    }
+
+  // store the eigenvectors in the first columns of the matrix
+  V.copy_to(*this, origin, origin, block);
+
+  property = LAPACKSupport::Property::general;
+  state    = LAPACKSupport::eigenvalues;
+
+  return eigenvalues;
+}
+
+
+
 template <typename NumberType>
 std::vector<NumberType>
 ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_MRRR(
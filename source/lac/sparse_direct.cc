@@ -15,8 +15,10 @@
 
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparse_direct.h>
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/vector.h>
@@ -215,10 +217,24 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
 {
   Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
 
-  clear();
-
   using number = typename Matrix::value_type;
 
+  // release the previous numeric factorization, but keep the symbolic one
+  // along with the sparsity structure it was computed for, in order to check
+  // below whether it can be reused
+  if (numeric_decomposition != nullptr)
+    {
+      umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+
+  std::vector<types::suitesparse_index> previous_Ap, previous_Ai;
+  previous_Ap.swap(Ap);
+  previous_Ai.swap(Ai);
+  const bool previous_is_complex = (Az.size() != 0);
+  Ax.clear();
+  Az.clear();
+
   n_rows = matrix.m();
   n_cols = matrix.n();
 
@@ -292,28 +308,44 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // different function
   sort_arrays(matrix);
 
+  // the symbolic factorization only depends on the sparsity structure, so
+  // skip it if it has already been computed for the same structure
+  const bool reuse_symbolic_decomposition =
+    (symbolic_decomposition != nullptr) &&
+    (previous_is_complex == numbers::NumberTraits<number>::is_complex) &&
+    (previous_Ap == Ap) && (previous_Ai == Ai);
+
   int status;
-  if (numbers::NumberTraits<number>::is_complex == false)
-    status = umfpack_dl_symbolic(N,
-                                 N,
-                                 Ap.data(),
-                                 Ai.data(),
-                                 Ax.data(),
-                                 &symbolic_decomposition,
-                                 control.data(),
-                                 nullptr);
-  else
-    status = umfpack_zl_symbolic(N,
-                                 N,
-                                 Ap.data(),
-                                 Ai.data(),
-                                 Ax.data(),
-                                 Az.data(),
-                                 &symbolic_decomposition,
-                                 control.data(),
-                                 nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_symbolic", status));
+  if (reuse_symbolic_decomposition == false)
+    {
+      if (symbolic_decomposition != nullptr)
+        {
+          umfpack_dl_free_symbolic(&symbolic_decomposition);
+          symbolic_decomposition = nullptr;
+        }
+
+      if (numbers::NumberTraits<number>::is_complex == false)
+        status = umfpack_dl_symbolic(N,
+                                     N,
+                                     Ap.data(),
+                                     Ai.data(),
+                                     Ax.data(),
+                                     &symbolic_decomposition,
+                                     control.data(),
+                                     nullptr);
+      else
+        status = umfpack_zl_symbolic(N,
+                                     N,
+                                     Ap.data(),
+                                     Ai.data(),
+                                     Ax.data(),
+                                     Az.data(),
+                                     &symbolic_decomposition,
+                                     control.data(),
+                                     nullptr);
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_symbolic", status));
+    }
 
   if (numbers::NumberTraits<number>::is_complex == false)
     status = umfpack_dl_numeric(Ap.data(),
@@ -334,8 +366,6 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                                 nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
-
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
 }
 
 
@@ -794,6 +824,68 @@ SparseDirectUMFPACK::Tvmult(BlockVector<double> &      dst,
   this->solve(dst, /*transpose=*/true);
 }
 
+
+
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &rhs_and_solution,
+                           const bool          transpose /*=false*/) const
+{
+  Assert(rhs_and_solution.m() == n_rows,
+         ExcDimensionMismatch(rhs_and_solution.m(), n_rows));
+
+  // the UMFPACK solve functions only read from the factorization, so the
+  // right hand sides can be worked on concurrently
+  parallel::apply_to_subranges(
+    0u,
+    rhs_and_solution.n(),
+    [&](const unsigned int begin, const unsigned int end) {
+      Vector<double> tmp(rhs_and_solution.m());
+      for (unsigned int j = begin; j < end; ++j)
+        {
+          for (unsigned int i = 0; i < tmp.size(); ++i)
+            tmp(i) = rhs_and_solution(i, j);
+          solve(tmp, transpose);
+          for (unsigned int i = 0; i < tmp.size(); ++i)
+            rhs_and_solution(i, j) = tmp(i);
+        }
+    },
+    1);
+}
+
+
+
+void
+SparseDirectUMFPACK::solve(std::vector<Vector<double>> &rhs_and_solution,
+                           const bool transpose /*=false*/) const
+{
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    rhs_and_solution.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t j = begin; j < end; ++j)
+        solve(rhs_and_solution[j], transpose);
+    },
+    1);
+}
+
+
+
+void
+SparseDirectUMFPACK::solve(std::vector<BlockVector<double>> &rhs_and_solution,
+                           const bool transpose /*=false*/) const
+{
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    rhs_and_solution.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t j = begin; j < end; ++j)
+        solve(rhs_and_solution[j], transpose);
+    },
+    1);
+}
+
+
+
 SparseDirectUMFPACK::size_type
 SparseDirectUMFPACK::m() const
 {
@@ -46,10 +46,43 @@ SparsityPatternBase::SparsityPatternBase()
   , rowstart(nullptr)
   , colnums(nullptr)
   , compressed(false)
+  , n_tracked_bytes(0)
 {}
 
 
 
+SparsityPatternBase::~SparsityPatternBase()
+{
+  if (n_tracked_bytes > 0)
+    MemoryTracker::deallocate(MemoryTracker::sparsity_pattern,
+                              n_tracked_bytes);
+}
+
+
+
+void
+SparsityPatternBase::update_memory_tracking()
+{
+  std::size_t n_bytes = 0;
+  if (MemoryTracker::is_enabled())
+    {
+      if (rowstart != nullptr)
+        n_bytes += (max_dim + 1) * sizeof(std::size_t);
+      if (colnums != nullptr)
+        n_bytes += max_vec_len * sizeof(size_type);
+    }
+
+  if (n_bytes > n_tracked_bytes)
+    MemoryTracker::allocate(MemoryTracker::sparsity_pattern,
+                            n_bytes - n_tracked_bytes);
+  else if (n_bytes < n_tracked_bytes)
+    MemoryTracker::deallocate(MemoryTracker::sparsity_pattern,
+                              n_tracked_bytes - n_bytes);
+  n_tracked_bytes = n_bytes;
+}
+
+
+
 SparsityPattern::SparsityPattern()
   : SparsityPatternBase()
   , store_diagonal_first_in_row(false)
@@ -245,6 +278,7 @@ SparsityPattern::reinit(const size_type                      m,
       // if dimension is zero: ignore max_per_row
       max_row_length = 0;
       compressed     = false;
+      update_memory_tracking();
 
       return;
     }
@@ -306,6 +340,7 @@ SparsityPattern::reinit(const size_type                      m,
       max_vec_len = vec_len;
       colnums     = std::make_unique<size_type[]>(max_vec_len);
     }
+  update_memory_tracking();
 
   // set the rowstart array
   rowstart[0] = 0;
@@ -356,9 +391,33 @@ SparsityPattern::compress()
     std::count_if(&colnums[rowstart[0]],
                   &colnums[rowstart[rows]],
                   [](const size_type col) { return col != invalid_entry; });
+
+  // if all the allocated entries are in use, e.g. because the object was
+  // set up with the exact row lengths, we can sort the rows in place and
+  // avoid allocating and copying into a second array of the same size
+  if (nonzero_elements == max_vec_len)
+    {
+      for (size_type line = 0; line < rows; ++line)
+        if (rowstart[line + 1] - rowstart[line] > 1)
+          std::sort(&colnums[rowstart[line]] +
+                      (store_diagonal_first_in_row ? 1 : 0),
+                    &colnums[rowstart[line + 1]]);
+      compressed = true;
+      return;
+    }
+
   // now allocate the respective memory
   std::unique_ptr<size_type[]> new_colnums(new size_type[nonzero_elements]);
 
+  // the old and the new array of column numbers coexist until the end of
+  // this function, so report the new one right away
+  if (MemoryTracker::is_enabled())
+    {
+      MemoryTracker::allocate(MemoryTracker::sparsity_pattern,
+                              nonzero_elements * sizeof(size_type));
+      n_tracked_bytes += nonzero_elements * sizeof(size_type);
+    }
+
 
   // reserve temporary storage to store the entries of one row
   std::vector<size_type> tmp_entries(max_row_length);
@@ -432,6 +491,7 @@ SparsityPattern::compress()
 
   // store the size
   max_vec_len = nonzero_elements;
+  update_memory_tracking();
 
   compressed = true;
 }
@@ -1008,6 +1068,7 @@ SparsityPattern::block_read(std::istream &in)
   // reallocate space
   rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
   colnums  = std::make_unique<size_type[]>(max_vec_len);
+  update_memory_tracking();
 
   // then read data
   in.read(reinterpret_cast<char *>(rowstart.get()),
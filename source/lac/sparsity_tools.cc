@@ -27,6 +27,7 @@
 
 #ifdef DEAL_II_WITH_MPI
 #  include <deal.II/base/mpi.h>
+#  include <deal.II/base/mpi_consensus_algorithms.h>
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_sparsity_pattern.h>
@@ -912,6 +913,147 @@ namespace SparsityTools
 
 #ifdef DEAL_II_WITH_MPI
 
+  namespace
+  {
+    /**
+     * Append @p value to @p buffer as variable-length integer, using seven
+     * bits per byte and the highest bit to indicate that more bytes follow.
+     */
+    void
+    append_compressed(std::vector<char> &buffer, types::global_dof_index value)
+    {
+      while (value >= 0x80)
+        {
+          buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+          value >>= 7;
+        }
+      buffer.push_back(static_cast<char>(value));
+    }
+
+
+
+    /**
+     * Read a variable-length integer written by append_compressed() and
+     * advance @p ptr past it.
+     */
+    types::global_dof_index
+    read_compressed(const char *&ptr, const char *end)
+    {
+      (void)end;
+
+      types::global_dof_index value = 0;
+      for (unsigned int shift = 0;; shift += 7)
+        {
+          Assert(ptr != end, ExcInternalError());
+          const auto byte = static_cast<unsigned char>(*(ptr++));
+          value |= static_cast<types::global_dof_index>(byte & 0x7F) << shift;
+          if ((byte & 0x80) == 0)
+            return value;
+        }
+    }
+
+
+
+    /**
+     * Send the non-empty rows of @p dsp that are locally relevant but not
+     * locally owned to their owners and call @p add_row for each row
+     * received. The rows of each message are sent in ascending order as
+     * the difference to the previous row, followed by the number of
+     * entries and the column indices, again stored as differences. All
+     * numbers are compressed with append_compressed().
+     */
+    template <typename SparsityPatternType>
+    void
+    exchange_off_processor_rows(
+      const SparsityPatternType &dsp,
+      const IndexSet &           locally_owned_rows,
+      const MPI_Comm &           mpi_comm,
+      const IndexSet &           locally_relevant_rows,
+      const std::function<
+        void(const types::global_dof_index,
+             const ArrayView<const types::global_dof_index> &)> &add_row)
+    {
+      IndexSet requested_rows(locally_relevant_rows);
+      requested_rows.subtract_set(locally_owned_rows);
+
+      const std::vector<unsigned int> index_owner =
+        Utilities::MPI::compute_index_owner(locally_owned_rows,
+                                            requested_rows,
+                                            mpi_comm);
+
+      // encode the rows for each owner, together with the last row written
+      std::map<unsigned int,
+               std::pair<std::vector<char>, types::global_dof_index>>
+        send_data;
+
+      std::vector<types::global_dof_index> columns;
+      for (types::global_dof_index i = 0; i < requested_rows.n_elements(); ++i)
+        {
+          const types::global_dof_index row =
+            requested_rows.nth_index_in_set(i);
+
+          const auto rlen = dsp.row_length(row);
+
+          // skip empty lines
+          if (rlen == 0)
+            continue;
+
+          columns.resize(rlen);
+          for (types::global_dof_index c = 0; c < rlen; ++c)
+            columns[c] = dsp.column_number(row, c);
+          if (!std::is_sorted(columns.begin(), columns.end()))
+            std::sort(columns.begin(), columns.end());
+
+          auto &data = send_data[index_owner[i]];
+          append_compressed(data.first, row - data.second);
+          append_compressed(data.first, rlen);
+          append_compressed(data.first, columns[0]);
+          for (types::global_dof_index c = 1; c < rlen; ++c)
+            append_compressed(data.first, columns[c] - columns[c - 1]);
+
+          data.second = row;
+        }
+
+      std::vector<unsigned int> targets;
+      targets.reserve(send_data.size());
+      for (const auto &data : send_data)
+        targets.push_back(data.first);
+
+      Utilities::MPI::ConsensusAlgorithms::AnonymousProcess<char, char> process(
+        [&]() { return targets; },
+        [&](const unsigned int other_rank, std::vector<char> &send_buffer) {
+          // the encoded rows are not needed any more, so hand them over
+          send_buffer.swap(send_data[other_rank].first);
+        },
+        [&](const unsigned int,
+            const std::vector<char> &recv_buffer,
+            std::vector<char> &) {
+          const char *ptr = recv_buffer.data();
+          const char *end = recv_buffer.data() + recv_buffer.size();
+
+          types::global_dof_index row = 0;
+          while (ptr != end)
+            {
+              row += read_compressed(ptr, end);
+
+              columns.resize(read_compressed(ptr, end));
+              Assert(columns.size() > 0, ExcInternalError());
+              columns[0] = read_compressed(ptr, end);
+              for (types::global_dof_index c = 1; c < columns.size(); ++c)
+                columns[c] = columns[c - 1] + read_compressed(ptr, end);
+
+              add_row(row, make_array_view(columns));
+            }
+        });
+
+      Utilities::MPI::ConsensusAlgorithms::Selector<char, char>(process,
+                                                                mpi_comm)
+        .run();
+    }
+  } // namespace
+
+
+
   void
   gather_sparsity_pattern(DynamicSparsityPattern &     dsp,
                           const std::vector<IndexSet> &owned_rows_per_processor,
@@ -1047,63 +1189,50 @@ namespace SparsityTools
                               const MPI_Comm &        mpi_comm,
                               const IndexSet &        locally_relevant_rows)
   {
-    IndexSet requested_rows(locally_relevant_rows);
-    requested_rows.subtract_set(locally_owned_rows);
-
-    std::vector<unsigned int> index_owner =
-      Utilities::MPI::compute_index_owner(locally_owned_rows,
-                                          requested_rows,
-                                          mpi_comm);
+    exchange_off_processor_rows(
+      dsp,
+      locally_owned_rows,
+      mpi_comm,
+      locally_relevant_rows,
+      [&dsp](const types::global_dof_index                   row,
+             const ArrayView<const types::global_dof_index> &columns) {
+        dsp.add_entries(row, columns.begin(), columns.end(), true);
+      });
+  }
 
-    using map_vec_t =
-      std::map<unsigned int, std::vector<DynamicSparsityPattern::size_type>>;
 
-    map_vec_t send_data;
 
-    for (DynamicSparsityPattern::size_type i = 0;
-         i < requested_rows.n_elements();
-         ++i)
+  void
+  distribute_sparsity_pattern(
+    const DynamicSparsityPattern &dsp,
+    const IndexSet &              locally_owned_rows,
+    const MPI_Comm &              mpi_comm,
+    const IndexSet &              locally_relevant_rows,
+    const std::function<
+      void(const DynamicSparsityPattern::size_type,
+           const ArrayView<const DynamicSparsityPattern::size_type> &)>
+      &add_row)
+  {
+    // first pass on the locally owned rows
+    const IndexSet &                     stored_rows = dsp.row_index_set();
+    std::vector<types::global_dof_index> columns;
+    for (const auto row : locally_owned_rows)
       {
-        const DynamicSparsityPattern::size_type row =
-          requested_rows.nth_index_in_set(i);
+        if (stored_rows.size() != 0 && !stored_rows.is_element(row))
+          continue;
 
         const auto rlen = dsp.row_length(row);
-
-        // skip empty lines
-        if (!rlen)
+        if (rlen == 0)
           continue;
 
-        // save entries
-        send_data[index_owner[i]].push_back(row);  // row index
-        send_data[index_owner[i]].push_back(rlen); // number of entries
+        columns.resize(rlen);
         for (DynamicSparsityPattern::size_type c = 0; c < rlen; ++c)
-          {
-            // columns
-            const auto column = dsp.column_number(row, c);
-            send_data[index_owner[i]].push_back(column);
-          }
+          columns[c] = dsp.column_number(row, c);
+        add_row(row, make_array_view(columns));
       }
 
-    const auto receive_data = Utilities::MPI::some_to_some(mpi_comm, send_data);
-
-    // add what we received
-    for (const auto &data : receive_data)
-      {
-        const auto &recv_buf = data.second;
-        auto        ptr      = recv_buf.begin();
-        const auto  end      = recv_buf.end();
-        while (ptr != end)
-          {
-            const auto row = *(ptr++);
-            Assert(ptr != end, ExcInternalError());
-            const auto n_entries = *(ptr++);
-
-            Assert(ptr + (n_entries - 1) != end, ExcInternalError());
-            dsp.add_entries(row, ptr, ptr + n_entries, true);
-            ptr += n_entries;
-          }
-        Assert(ptr == end, ExcInternalError());
-      }
+    exchange_off_processor_rows(
+      dsp, locally_owned_rows, mpi_comm, locally_relevant_rows, add_row);
   }
 
 
@@ -1129,136 +1258,15 @@ namespace SparsityTools
                               const MPI_Comm &             mpi_comm,
                               const IndexSet &locally_relevant_rows)
   {
-    using map_vec_t =
-      std::map<BlockDynamicSparsityPattern::size_type,
-               std::vector<BlockDynamicSparsityPattern::size_type>>;
-    map_vec_t send_data;
-
-    IndexSet requested_rows(locally_relevant_rows);
-    requested_rows.subtract_set(locally_owned_rows);
-
-    std::vector<unsigned int> index_owner =
-      Utilities::MPI::compute_index_owner(locally_owned_rows,
-                                          requested_rows,
-                                          mpi_comm);
-
-    for (DynamicSparsityPattern::size_type i = 0;
-         i < requested_rows.n_elements();
-         ++i)
-      {
-        const DynamicSparsityPattern::size_type row =
-          requested_rows.nth_index_in_set(i);
-
-        BlockDynamicSparsityPattern::size_type rlen = dsp.row_length(row);
-
-        // skip empty lines
-        if (!rlen)
-          continue;
-
-        // save entries
-        std::vector<BlockDynamicSparsityPattern::size_type> &dst =
-          send_data[index_owner[i]];
-
-        dst.push_back(rlen); // number of entries
-        dst.push_back(row);  // row index
-        for (BlockDynamicSparsityPattern::size_type c = 0; c < rlen; ++c)
-          {
-            // columns
-            BlockDynamicSparsityPattern::size_type column =
-              dsp.column_number(row, c);
-            dst.push_back(column);
-          }
-      }
-
-    unsigned int num_receive = 0;
-    {
-      std::vector<unsigned int> send_to;
-      send_to.reserve(send_data.size());
-      for (const auto &sparsity_line : send_data)
-        send_to.push_back(sparsity_line.first);
-
-      num_receive =
-        Utilities::MPI::compute_n_point_to_point_communications(mpi_comm,
-                                                                send_to);
-    }
-
-    std::vector<MPI_Request> requests(send_data.size());
-
-
-    // send data
-
-    static Utilities::MPI::CollectiveMutex      mutex;
-    Utilities::MPI::CollectiveMutex::ScopedLock lock(mutex, mpi_comm);
-
-    const int mpi_tag = Utilities::MPI::internal::Tags::
-      sparsity_tools_distribute_sparsity_pattern;
-
-    {
-      unsigned int idx = 0;
-      for (const auto &sparsity_line : send_data)
-        {
-          const int ierr =
-            MPI_Isend(DEAL_II_MPI_CONST_CAST(sparsity_line.second.data()),
-                      sparsity_line.second.size(),
-                      DEAL_II_DOF_INDEX_MPI_TYPE,
-                      sparsity_line.first,
-                      mpi_tag,
-                      mpi_comm,
-                      &requests[idx++]);
-          AssertThrowMPI(ierr);
-        }
-    }
-
-    {
-      // receive
-      std::vector<BlockDynamicSparsityPattern::size_type> recv_buf;
-      for (unsigned int index = 0; index < num_receive; ++index)
-        {
-          MPI_Status status;
-          int ierr = MPI_Probe(MPI_ANY_SOURCE, mpi_tag, mpi_comm, &status);
-          AssertThrowMPI(ierr);
-
-          int len;
-          ierr = MPI_Get_count(&status, DEAL_II_DOF_INDEX_MPI_TYPE, &len);
-          AssertThrowMPI(ierr);
-
-          recv_buf.resize(len);
-          ierr = MPI_Recv(recv_buf.data(),
-                          len,
-                          DEAL_II_DOF_INDEX_MPI_TYPE,
-                          status.MPI_SOURCE,
-                          status.MPI_TAG,
-                          mpi_comm,
-                          &status);
-          AssertThrowMPI(ierr);
-
-          std::vector<BlockDynamicSparsityPattern::size_type>::const_iterator
-            ptr = recv_buf.begin();
-          std::vector<BlockDynamicSparsityPattern::size_type>::const_iterator
-            end = recv_buf.end();
-          while (ptr != end)
-            {
-              BlockDynamicSparsityPattern::size_type num = *(ptr++);
-              Assert(ptr != end, ExcInternalError());
-              BlockDynamicSparsityPattern::size_type row = *(ptr++);
-              for (unsigned int c = 0; c < num; ++c)
-                {
-                  Assert(ptr != end, ExcInternalError());
-                  dsp.add(row, *ptr);
-                  ++ptr;
-                }
-            }
-          Assert(ptr == end, ExcInternalError());
-        }
-    }
-
-    // complete all sends, so that we can safely destroy the buffers.
-    if (requests.size())
-      {
-        const int ierr =
-          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-        AssertThrowMPI(ierr);
-      }
+    exchange_off_processor_rows(
+      dsp,
+      locally_owned_rows,
+      mpi_comm,
+      locally_relevant_rows,
+      [&dsp](const types::global_dof_index                   row,
+             const ArrayView<const types::global_dof_index> &columns) {
+        dsp.add_entries(row, columns.begin(), columns.end(), true);
+      });
   }
 #endif
 } // namespace SparsityTools
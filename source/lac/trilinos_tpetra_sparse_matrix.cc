@@ -0,0 +1,242 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/lac/trilinos_tpetra_sparse_matrix.h>
+
+#ifdef DEAL_II_TRILINOS_WITH_TPETRA
+
+#  ifdef DEAL_II_WITH_MPI
+
+#    include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#    include <Teuchos_OrdinalTraits.hpp>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace LinearAlgebra
+{
+  namespace TpetraWrappers
+  {
+    template <typename Number>
+    void
+    SparseMatrix<Number>::reinit(
+      const IndexSet &              locally_owned_rows,
+      const IndexSet &              locally_relevant_rows,
+      const DynamicSparsityPattern &sparsity_pattern,
+      const MPI_Comm &              communicator)
+    {
+      Assert(locally_owned_rows.is_subset_of(locally_relevant_rows),
+             ExcMessage("The locally owned rows must be a subset of the "
+                        "locally relevant rows."));
+
+      owned_map = Teuchos::rcp(
+        new MapType(locally_owned_rows.make_tpetra_map(communicator, false)));
+      relevant_map = Teuchos::rcp(
+        new MapType(locally_relevant_rows.make_tpetra_map(communicator, true)));
+
+      // Create a graph with the given rows from the sparsity pattern. The
+      // local row indices of the map follow the order of the elements in the
+      // index set.
+      const auto make_graph = [&](const Teuchos::RCP<const MapType> &row_map,
+                                  const IndexSet &                   rows) {
+        std::vector<size_t> n_entries_per_row;
+        n_entries_per_row.reserve(rows.n_elements());
+        for (const size_type row : rows)
+          n_entries_per_row.push_back(sparsity_pattern.row_length(row));
+
+        Teuchos::RCP<GraphType> graph = Teuchos::rcp(
+          new GraphType(row_map,
+                        Teuchos::arrayViewFromVector(n_entries_per_row)));
+
+        std::vector<size_type> columns;
+        for (const size_type row : rows)
+          {
+            columns.resize(sparsity_pattern.row_length(row));
+            for (unsigned int j = 0; j < columns.size(); ++j)
+              columns[j] = sparsity_pattern.column_number(row, j);
+            graph->insertGlobalIndices(row,
+                                       Teuchos::arrayViewFromVector(columns));
+          }
+
+        graph->fillComplete(owned_map, owned_map);
+        return graph;
+      };
+
+      // Both matrices are created with a static graph, which is what allows
+      // adding to existing entries concurrently
+      relevant_matrix = Teuchos::rcp(
+        new MatrixType(make_graph(relevant_map, locally_relevant_rows)));
+      owned_matrix =
+        Teuchos::rcp(new MatrixType(make_graph(owned_map, locally_owned_rows)));
+
+      exporter = Teuchos::rcp(
+        new Tpetra::Export<int, types::global_dof_index>(relevant_map,
+                                                         owned_map));
+    }
+
+
+
+    template <typename Number>
+    SparseMatrix<Number> &
+    SparseMatrix<Number>::operator=(const Number d)
+    {
+      Assert(d == Number(), ExcMessage("Only zero can be assigned."));
+      (void)d;
+      Assert(!relevant_matrix.is_null(), ExcNotInitialized());
+
+      relevant_matrix->resumeFill();
+      relevant_matrix->setAllToScalar(Number());
+
+      owned_matrix->resumeFill();
+      owned_matrix->setAllToScalar(Number());
+      owned_matrix->fillComplete(owned_map, owned_map);
+
+      return *this;
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::add(const size_type  row,
+                              const size_type  n_cols,
+                              const size_type *col_indices,
+                              const Number *   values)
+    {
+      Assert(!relevant_matrix.is_null(), ExcNotInitialized());
+
+      const int local_row = relevant_map->getLocalElement(row);
+      Assert(local_row != Teuchos::OrdinalTraits<int>::invalid(),
+             ExcMessage("The row " + std::to_string(row) +
+                        " is not a locally relevant row."));
+
+      const MapType &  col_map = *relevant_matrix->getColMap();
+      std::vector<int> local_columns(n_cols);
+      for (size_type j = 0; j < n_cols; ++j)
+        local_columns[j] = col_map.getLocalElement(col_indices[j]);
+
+      // Sum into the existing entries with atomic updates, so that several
+      // threads can call this function at the same time
+      const int n_added =
+        relevant_matrix->sumIntoLocalValues(local_row,
+                                            static_cast<int>(n_cols),
+                                            values,
+                                            local_columns.data(),
+                                            true /*atomic*/);
+      Assert(n_added == static_cast<int>(n_cols),
+             ExcMessage("Some of the entries of row " + std::to_string(row) +
+                        " are not part of the sparsity pattern."));
+      (void)n_added;
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::add(const std::vector<size_type> &indices,
+                              const FullMatrix<Number> &    values)
+    {
+      AssertDimension(indices.size(), values.m());
+      AssertDimension(values.m(), values.n());
+
+      for (size_type i = 0; i < indices.size(); ++i)
+        add(indices[i], indices.size(), indices.data(), &values(i, 0));
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::compress(const VectorOperation::values operation)
+    {
+      Assert(operation == VectorOperation::add, ExcNotImplemented());
+      (void)operation;
+      Assert(!relevant_matrix.is_null(), ExcNotInitialized());
+
+      // The owned matrix is recomputed from all contributions collected so
+      // far, so that several rounds of add() and compress() accumulate
+      relevant_matrix->fillComplete(owned_map, owned_map);
+
+      owned_matrix->resumeFill();
+      owned_matrix->setAllToScalar(Number());
+      owned_matrix->doExport(*relevant_matrix, *exporter, Tpetra::ADD);
+      owned_matrix->fillComplete(owned_map, owned_map);
+
+      relevant_matrix->resumeFill();
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::m() const
+    {
+      return owned_matrix.is_null() ? 0 : owned_matrix->getGlobalNumRows();
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::n() const
+    {
+      return owned_matrix.is_null() ? 0 : owned_matrix->getGlobalNumCols();
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::vmult(Vector<Number> &      dst,
+                                const Vector<Number> &src) const
+    {
+      Assert(!owned_matrix.is_null(), ExcNotInitialized());
+      Assert(owned_matrix->isFillComplete(),
+             ExcMessage("The matrix must be compressed before it can be "
+                        "used in matrix-vector products."));
+
+      owned_matrix->apply(src.trilinos_vector(), dst.trilinos_vector());
+    }
+
+
+
+    template <typename Number>
+    const typename SparseMatrix<Number>::MatrixType &
+    SparseMatrix<Number>::trilinos_matrix() const
+    {
+      Assert(!owned_matrix.is_null(), ExcNotInitialized());
+      return *owned_matrix;
+    }
+
+
+
+    template <typename Number>
+    Teuchos::RCP<typename SparseMatrix<Number>::MatrixType>
+    SparseMatrix<Number>::trilinos_rcp() const
+    {
+      return owned_matrix;
+    }
+
+
+
+    template class SparseMatrix<float>;
+    template class SparseMatrix<double>;
+  } // namespace TpetraWrappers
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#  endif
+#endif
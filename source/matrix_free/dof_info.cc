@@ -34,6 +34,8 @@ namespace internal
     template void
     DoFInfo::read_dof_indices<double>(
       const std::vector<types::global_dof_index> &,
+      const std::vector<types::global_dof_index> &,
+      const bool,
       const std::vector<unsigned int> &,
       const dealii::AffineConstraints<double> &,
       const unsigned int,
@@ -43,6 +45,8 @@ namespace internal
     template void
     DoFInfo::read_dof_indices<float>(
       const std::vector<types::global_dof_index> &,
+      const std::vector<types::global_dof_index> &,
+      const bool,
       const std::vector<unsigned int> &,
       const dealii::AffineConstraints<float> &,
       const unsigned int,
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/revision.h>
+
+#include <deal.II/matrix_free/evaluation_kernel_cache.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#ifdef DEAL_II_HAVE_DLOPEN
+#  include <dlfcn.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MatrixFreeTools
+{
+  namespace EvaluationKernelCache
+  {
+    AdditionalData::AdditionalData(const std::string &cache_directory,
+                                   const std::string &compile_command)
+      : cache_directory(cache_directory)
+      , compile_command(compile_command)
+    {}
+  } // namespace EvaluationKernelCache
+} // namespace MatrixFreeTools
+
+
+
+namespace internal
+{
+  std::vector<void *>
+  compile_and_load_kernels(
+    const std::string &              source_code,
+    const std::vector<std::string> & symbol_names,
+    const MPI_Comm &                 mpi_communicator,
+    const MatrixFreeTools::EvaluationKernelCache::AdditionalData &data)
+  {
+#ifdef DEAL_II_HAVE_DLOPEN
+    std::string compile_command = data.compile_command;
+    if (compile_command.empty())
+      if (const char *command = std::getenv("DEAL_II_KERNEL_COMPILE_COMMAND"))
+        compile_command = command;
+    AssertThrow(!compile_command.empty(),
+                ExcMessage(
+                  "No command to compile the evaluation kernels was given. "
+                  "Set AdditionalData::compile_command or the environment "
+                  "variable DEAL_II_KERNEL_COMPILE_COMMAND."));
+
+    // the name of the library identifies the code, the compile command and
+    // the deal.II version, so that outdated libraries are not reused
+    std::ostringstream key;
+    key << std::hex
+        << std::hash<std::string>()(source_code + compile_command +
+                                    DEAL_II_PACKAGE_VERSION +
+                                    DEAL_II_GIT_REVISION);
+    const std::string base_name = data.cache_directory + "/kernel_" + key.str();
+    const std::string library_name = base_name + ".so";
+    const std::string log_name     = base_name + ".log";
+
+    // compile on the root process only. The library is written to a
+    // temporary file first and then renamed, so that other programs using
+    // the same cache never see an incomplete library.
+    int error = 0;
+    if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0 &&
+        std::ifstream(library_name).good() == false)
+      {
+        if (mkdir(data.cache_directory.c_str(), 0755) != 0 && errno != EEXIST)
+          error = 1;
+
+        const std::string source_name = base_name + ".cc";
+        const std::string temporary_name =
+          base_name + "." + std::to_string(getpid()) + ".so";
+        if (error == 0)
+          {
+            std::ofstream source_file(source_name);
+            source_file << source_code;
+            source_file.close();
+            if (!source_file)
+              error = 1;
+          }
+
+        if (error == 0)
+          {
+            const std::string command = compile_command + " -o " +
+                                        temporary_name + " " + source_name +
+                                        " > " + log_name + " 2>&1";
+            if (std::system(command.c_str()) != 0)
+              error = 2;
+          }
+
+        if (error == 0 &&
+            std::rename(temporary_name.c_str(), library_name.c_str()) != 0)
+          error = 1;
+      }
+
+    error = Utilities::MPI::broadcast(mpi_communicator, error, 0);
+    AssertThrow(error != 1,
+                ExcMessage("Could not write to the kernel cache directory " +
+                           data.cache_directory + "."));
+    AssertThrow(error != 2,
+                ExcMessage("Compiling the evaluation kernels failed, see " +
+                           log_name + " for the output of the compiler."));
+
+    // the library stays loaded until the end of the program, since the
+    // kernels are registered for all subsequent evaluations
+    void *library = dlopen(library_name.c_str(), RTLD_NOW | RTLD_LOCAL);
+    AssertThrow(library != nullptr,
+                ExcMessage("Could not load the kernel library " +
+                           library_name + ": " + std::string(dlerror())));
+
+    std::vector<void *> symbols;
+    for (const std::string &name : symbol_names)
+      {
+        symbols.push_back(dlsym(library, name.c_str()));
+        AssertThrow(symbols.back() != nullptr,
+                    ExcMessage("The kernel library " + library_name +
+                               " does not contain the symbol " + name + "."));
+      }
+    return symbols;
+#else
+    (void)source_code;
+    (void)symbol_names;
+    (void)mpi_communicator;
+    (void)data;
+    AssertThrow(false,
+                ExcMessage("The run-time generation of evaluation kernels "
+                           "requires dlopen(), which is not available on "
+                           "this system."));
+    return {};
+#endif
+  }
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,194 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/matrix_free/operation_counter.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    std::atomic<std::uint64_t> operation_counters[n_counted_quantities] = {};
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+
+
+namespace MatrixFreeTools
+{
+  std::uint64_t
+  OperationCount::total_bytes() const
+  {
+    return vector_bytes + index_bytes + mapping_bytes;
+  }
+
+
+
+  double
+  OperationCount::arithmetic_intensity() const
+  {
+    return total_bytes() > 0 ?
+             static_cast<double>(arithmetic_operations) / total_bytes() :
+             0.;
+  }
+
+
+
+  namespace OperationCounter
+  {
+    void
+    reset()
+    {
+      for (auto &counter : internal::MatrixFreeFunctions::operation_counters)
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+
+
+    OperationCount
+    get()
+    {
+      using namespace internal::MatrixFreeFunctions;
+
+      OperationCount count;
+      count.arithmetic_operations =
+        operation_counters[counted_arithmetic_operations].load();
+      count.vector_bytes  = operation_counters[counted_vector_bytes].load();
+      count.index_bytes   = operation_counters[counted_index_bytes].load();
+      count.mapping_bytes = operation_counters[counted_mapping_bytes].load();
+      return count;
+    }
+
+
+
+    void
+    print_roofline(std::ostream &        out,
+                   const OperationCount &count,
+                   const double          wall_time,
+                   const std::string &   machine_model_file,
+                   const MPI_Comm &      mpi_communicator)
+    {
+      Assert(wall_time > 0., ExcMessage("The wall time must be positive."));
+
+      // sum the counts over all processes in one reduction
+      const unsigned long long int local_counts[4] = {
+        count.arithmetic_operations,
+        count.vector_bytes,
+        count.index_bytes,
+        count.mapping_bytes};
+      unsigned long long int global_counts[4];
+      Utilities::MPI::sum(
+        ArrayView<const unsigned long long int>(local_counts, 4),
+        mpi_communicator,
+        ArrayView<unsigned long long int>(global_counts, 4));
+
+      OperationCount sum;
+      sum.arithmetic_operations = global_counts[0];
+      sum.vector_bytes          = global_counts[1];
+      sum.index_bytes           = global_counts[2];
+      sum.mapping_bytes         = global_counts[3];
+
+      if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0)
+        return;
+
+#ifndef DEAL_II_MATRIX_FREE_COUNT_OPERATIONS
+      out << "Note: deal.II was configured without "
+          << "DEAL_II_MATRIX_FREE_COUNT_OPERATIONS, all counts are zero."
+          << std::endl;
+#endif
+
+      const double gflops = 1e-9 * sum.arithmetic_operations / wall_time;
+      const double gbytes = 1e-9 * sum.total_bytes() / wall_time;
+
+      out << "Matrix-free operation counts in " << wall_time << " s:"
+          << std::endl
+          << "  GFLOP:                  " << 1e-9 * sum.arithmetic_operations
+          << std::endl
+          << "  GB vector data:         " << 1e-9 * sum.vector_bytes
+          << std::endl
+          << "  GB index data:          " << 1e-9 * sum.index_bytes
+          << std::endl
+          << "  GB mapping data:        " << 1e-9 * sum.mapping_bytes
+          << std::endl
+          << "  Arithmetic intensity:   " << sum.arithmetic_intensity()
+          << " FLOP/byte" << std::endl
+          << "  Achieved GFLOP/s:       " << gflops << std::endl
+          << "  Achieved GB/s:          " << gbytes << std::endl;
+
+      if (machine_model_file.empty())
+        return;
+
+      std::ifstream file(machine_model_file);
+      AssertThrow(file, ExcFileNotOpen(machine_model_file));
+
+      double      peak_gflops = 0., memory_bandwidth = 0.;
+      std::string line;
+      while (std::getline(file, line))
+        {
+          line = Utilities::trim(line);
+          if (line.empty() || line[0] == '#')
+            continue;
+
+          std::istringstream line_stream(line);
+          std::string        key;
+          double             value = 0.;
+          line_stream >> key >> value;
+          AssertThrow(!line_stream.fail(),
+                      ExcMessage("Could not parse the line <" + line +
+                                 "> of the machine model file " +
+                                 machine_model_file + "."));
+          if (key == "peak_gflops")
+            peak_gflops = value;
+          else if (key == "memory_bandwidth_gbs")
+            memory_bandwidth = value;
+          else
+            AssertThrow(false,
+                        ExcMessage("Unknown key <" + key +
+                                   "> in the machine model file " +
+                                   machine_model_file + "."));
+        }
+      AssertThrow(peak_gflops > 0. && memory_bandwidth > 0.,
+                  ExcMessage("The machine model file " + machine_model_file +
+                             " must specify positive values for "
+                             "peak_gflops and memory_bandwidth_gbs."));
+
+      // the roofline is the minimum of the arithmetic peak and the
+      // performance that the memory bandwidth permits at the given
+      // arithmetic intensity
+      const double roofline =
+        std::min(peak_gflops, sum.arithmetic_intensity() * memory_bandwidth);
+
+      out << "  Fraction of peak GFLOP/s:   " << gflops / peak_gflops
+          << std::endl
+          << "  Fraction of peak GB/s:      " << gbytes / memory_bandwidth
+          << std::endl
+          << "  Roofline limit GFLOP/s:     " << roofline << std::endl
+          << "  Fraction of roofline limit: "
+          << (roofline > 0. ? gflops / roofline : 0.) << std::endl;
+    }
+  } // namespace OperationCounter
+} // namespace MatrixFreeTools
+
+DEAL_II_NAMESPACE_CLOSE
@@ -31,6 +31,9 @@
 #  include <tbb/task_scheduler_init.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <set>
 
@@ -322,13 +325,393 @@ namespace internal
       const bool         do_compress;
     };
 
+
+
+    // This defines the data structures for the partition-partition variant
+    // with dynamic scheduling. The subpartitions of the partition-partition
+    // graph are collected into four phases such that all subpartitions
+    // within a phase are conflict-free: the even and odd subpartitions of
+    // the odd partitions, followed by the even and odd subpartitions of the
+    // even partitions. Within a phase, the workers pick the next free chunk
+    // from a shared counter until the phase is exhausted.
+
+    namespace dynamic
+    {
+      // Marks the chunk in the first phase that finishes the ghost update
+      constexpr unsigned int ghost_update_chunk = numbers::invalid_unsigned_int;
+
+      class PhaseWork
+      {
+      public:
+        PhaseWork(MFWorkerInterface &              worker,
+                  const TaskInfo &                 task_info,
+                  const std::vector<unsigned int> &chunks,
+                  std::atomic<unsigned int> &      next_chunk,
+                  std::atomic<unsigned int> &      n_boundary_chunks_left,
+                  std::vector<double> &            busy_time_phase)
+          : worker(worker)
+          , task_info(task_info)
+          , chunks(chunks)
+          , next_chunk(next_chunk)
+          , n_boundary_chunks_left(n_boundary_chunks_left)
+          , busy_time_phase(busy_time_phase)
+        {}
+
+        void
+        operator()(const tbb::blocked_range<unsigned int> &range) const
+        {
+          TaskLoadStatistics &statistics = task_info.load_statistics;
+          for (unsigned int slot = range.begin(); slot < range.end(); ++slot)
+            {
+              double busy_time = 0.;
+              for (unsigned int c = next_chunk++; c < chunks.size();
+                   c               = next_chunk++)
+                {
+                  const auto start = std::chrono::steady_clock::now();
+                  run_chunk(chunks[c]);
+                  busy_time += std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+                  ++statistics.n_chunks[slot];
+                }
+              busy_time_phase[slot] = busy_time;
+            }
+        }
+
+      private:
+        void
+        run_chunk(const unsigned int chunk) const
+        {
+          if (chunk == ghost_update_chunk)
+            {
+              worker.vector_update_ghosts_finish();
+              return;
+            }
+
+          worker.cell(chunk);
+          if (task_info.face_partition_data.empty() == false)
+            {
+              worker.face(chunk);
+              worker.boundary(chunk);
+            }
+
+          // the first partition holds the cells at MPI boundaries, so the
+          // data exchange of the result can start once it is done
+          if (chunk < task_info.partition_row_index[1] &&
+              --n_boundary_chunks_left == 0)
+            worker.vector_compress_start();
+        }
+
+        MFWorkerInterface &              worker;
+        const TaskInfo &                 task_info;
+        const std::vector<unsigned int> &chunks;
+        std::atomic<unsigned int> &      next_chunk;
+        std::atomic<unsigned int> &      n_boundary_chunks_left;
+        std::vector<double> &            busy_time_phase;
+      };
+
+
+
+      void
+      run(MFWorkerInterface &worker, const TaskInfo &task_info)
+      {
+        const unsigned int n_partitions = task_info.partition_evens.size();
+
+        // build the four phases. Within each phase, the subpartitions of the
+        // first partition come first, in order to start the data exchange
+        // early, followed by the others sorted by decreasing number of cell
+        // batches to reduce the time the workers wait at the end of a phase
+        std::vector<std::vector<unsigned int>> phases(4);
+        phases[0].push_back(ghost_update_chunk);
+        for (unsigned int part = 0; part < n_partitions; ++part)
+          for (unsigned int i = task_info.partition_row_index[part];
+               i < task_info.partition_row_index[part + 1];
+               ++i)
+            phases[2 * (1 - part % 2) +
+                   (i - task_info.partition_row_index[part]) % 2]
+              .push_back(i);
+        for (auto &phase : phases)
+          std::stable_sort(phase.begin(),
+                           phase.end(),
+                           [&task_info](const unsigned int a,
+                                        const unsigned int b) {
+                             if (a == ghost_update_chunk ||
+                                 b == ghost_update_chunk)
+                               return a == ghost_update_chunk &&
+                                      b != ghost_update_chunk;
+                             const bool a_first =
+                               a < task_info.partition_row_index[1];
+                             const bool b_first =
+                               b < task_info.partition_row_index[1];
+                             if (a_first != b_first)
+                               return a_first;
+                             return task_info.cell_partition_data[a + 1] -
+                                      task_info.cell_partition_data[a] >
+                                    task_info.cell_partition_data[b + 1] -
+                                      task_info.cell_partition_data[b];
+                           });
+
+        std::atomic<unsigned int> n_boundary_chunks_left(
+          n_partitions > 0 ? task_info.partition_row_index[1] : 0);
+        const bool compress_started_by_chunks = n_boundary_chunks_left > 0;
+
+        const unsigned int n_slots = MultithreadInfo::n_threads();
+        TaskLoadStatistics &statistics = task_info.load_statistics;
+        statistics.resize(n_slots);
+        std::vector<double> busy_time_phase(n_slots);
+
+        for (const auto &phase : phases)
+          {
+            if (phase.empty())
+              continue;
+            std::fill(busy_time_phase.begin(), busy_time_phase.end(), 0.);
+            std::atomic<unsigned int> next_chunk(0);
+            const auto                start = std::chrono::steady_clock::now();
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_slots, 1),
+                              PhaseWork(worker,
+                                        task_info,
+                                        phase,
+                                        next_chunk,
+                                        n_boundary_chunks_left,
+                                        busy_time_phase),
+                              tbb::simple_partitioner());
+            const double phase_time =
+              std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start)
+                .count();
+            for (unsigned int slot = 0; slot < n_slots; ++slot)
+              {
+                statistics.busy_time[slot] += busy_time_phase[slot];
+                statistics.idle_time[slot] +=
+                  std::max(0., phase_time - busy_time_phase[slot]);
+              }
+          }
+        ++statistics.n_loops;
+
+        if (compress_started_by_chunks == false)
+          worker.vector_compress_start();
+      }
+    } // end of namespace dynamic
+
 #endif // DEAL_II_WITH_TBB
 
 
 
+    namespace
+    {
+      // Keeps track of the timing of a single data exchange (update of ghost
+      // values or compress) in the loop and adds the collected data to the
+      // statistics when the exchange is finished
+      class CommunicationProgressTracker
+      {
+      public:
+        CommunicationProgressTracker(
+          CommunicationOverlapStatistics &statistics,
+          const bool                      active)
+          : statistics(statistics)
+          , active(active)
+          , started(false)
+          , completed(false)
+        {}
+
+        void
+        start()
+        {
+          if (active)
+            {
+              start_time = std::chrono::steady_clock::now();
+              started    = true;
+              completed  = false;
+            }
+        }
+
+        template <typename TestFunction>
+        void
+        test(const TestFunction &test_function)
+        {
+          if (active && started && !completed)
+            {
+              ++statistics.n_tests;
+              if (test_function())
+                {
+                  completion_time = std::chrono::steady_clock::now();
+                  completed       = true;
+                }
+            }
+        }
+
+        template <typename FinishFunction>
+        void
+        finish(const FinishFunction &finish_function)
+        {
+          if (!active || !started)
+            {
+              finish_function();
+              return;
+            }
+
+          const auto finish_begin = std::chrono::steady_clock::now();
+          finish_function();
+          const auto end_time =
+            completed ? completion_time : std::chrono::steady_clock::now();
+
+          ++statistics.n_exchanges;
+          if (completed)
+            ++statistics.n_exchanges_hidden;
+          statistics.time_exchange +=
+            std::chrono::duration<double>(end_time - start_time).count();
+          statistics.time_hidden +=
+            std::chrono::duration<double>(
+              (completed ? completion_time : finish_begin) - start_time)
+              .count();
+          started = false;
+        }
+
+      private:
+        CommunicationOverlapStatistics &                   statistics;
+        const bool                                         active;
+        bool                                               started;
+        bool                                               completed;
+        std::chrono::time_point<std::chrono::steady_clock> start_time;
+        std::chrono::time_point<std::chrono::steady_clock> completion_time;
+      };
+    } // namespace
+
+
+
+    TaskLoadStatistics::TaskLoadStatistics()
+    {
+      clear();
+    }
+
+
+
+    void
+    TaskLoadStatistics::clear()
+    {
+      n_loops = 0;
+      n_chunks.clear();
+      busy_time.clear();
+      idle_time.clear();
+    }
+
+
+
+    void
+    TaskLoadStatistics::resize(const unsigned int n_workers)
+    {
+      if (n_workers > n_chunks.size())
+        {
+          n_chunks.resize(n_workers, 0);
+          busy_time.resize(n_workers, 0.);
+          idle_time.resize(n_workers, 0.);
+        }
+    }
+
+
+
+    double
+    TaskLoadStatistics::idle_fraction() const
+    {
+      double busy = 0., idle = 0.;
+      for (unsigned int i = 0; i < busy_time.size(); ++i)
+        {
+          busy += busy_time[i];
+          idle += idle_time[i];
+        }
+      return busy + idle > 0. ? idle / (busy + idle) : 0.;
+    }
+
+
+
+    template <typename StreamType>
+    void
+    TaskLoadStatistics::print(StreamType &    out,
+                              const MPI_Comm &communicator) const
+    {
+      const Utilities::MPI::MinMaxAvg fraction =
+        Utilities::MPI::min_max_avg(idle_fraction(), communicator);
+      out << "Idle fraction of workers min/avg/max: " << fraction.min << " / "
+          << fraction.avg << " / " << fraction.max << std::endl;
+      for (unsigned int i = 0; i < busy_time.size(); ++i)
+        {
+          const Utilities::MPI::MinMaxAvg busy =
+            Utilities::MPI::min_max_avg(busy_time[i], communicator);
+          const Utilities::MPI::MinMaxAvg idle =
+            Utilities::MPI::min_max_avg(idle_time[i], communicator);
+          out << "Worker " << i << " chunks: " << n_chunks[i]
+              << ", busy min/avg/max (s): " << busy.min << " / " << busy.avg
+              << " / " << busy.max << ", idle min/avg/max (s): " << idle.min
+              << " / " << idle.avg << " / " << idle.max << std::endl;
+        }
+    }
+
+
+
+    CommunicationOverlapStatistics::CommunicationOverlapStatistics()
+    {
+      clear();
+    }
+
+
+
+    void
+    CommunicationOverlapStatistics::clear()
+    {
+      n_exchanges        = 0;
+      n_exchanges_hidden = 0;
+      n_tests            = 0;
+      time_exchange      = 0.;
+      time_hidden        = 0.;
+    }
+
+
+
+    double
+    CommunicationOverlapStatistics::hidden_fraction() const
+    {
+      return time_exchange > 0. ? time_hidden / time_exchange : 0.;
+    }
+
+
+
+    template <typename StreamType>
+    void
+    CommunicationOverlapStatistics::print(StreamType &    out,
+                                          const MPI_Comm &communicator) const
+    {
+      const Utilities::MPI::MinMaxAvg fraction =
+        Utilities::MPI::min_max_avg(hidden_fraction(), communicator);
+      const Utilities::MPI::MinMaxAvg time =
+        Utilities::MPI::min_max_avg(time_exchange, communicator);
+      const unsigned long long int n_hidden_global =
+        Utilities::MPI::sum(n_exchanges_hidden, communicator);
+      const unsigned long long int n_exchanges_global =
+        Utilities::MPI::sum(n_exchanges, communicator);
+
+      out << "Data exchanges completely hidden: " << n_hidden_global << " of "
+          << n_exchanges_global << std::endl;
+      out << "Time in data exchanges min/avg/max (s): " << time.min << " / "
+          << time.avg << " / " << time.max << std::endl;
+      out << "Hidden fraction of exchange time min/avg/max: " << fraction.min
+          << " / " << fraction.avg << " / " << fraction.max << std::endl;
+    }
+
+
+
     void
     TaskInfo::loop(MFWorkerInterface &funct) const
     {
+      // The statistics on the overlap of communication and computation are
+      // only collected for the serial loop, where we can test the requests
+      // between the ranges of cells that do not need any remote data
+      const bool track_communication =
+        test_communication_progress && scheme == none;
+      CommunicationProgressTracker ghost_tracker(communication_statistics,
+                                                 track_communication);
+      CommunicationProgressTracker compress_tracker(communication_statistics,
+                                                    track_communication);
+
       // If we use thread parallelism, we do not currently support to schedule
       // pieces of updates within the loop, so this index will collect all
       // calls in that case and work like a single complete loop over all
@@ -340,13 +723,16 @@ namespace internal
           partition_row_index[partition_row_index.size() - 2]);
 
       funct.vector_update_ghosts_start();
+      ghost_tracker.start();
 
 #ifdef DEAL_II_WITH_TBB
 
       if (scheme != none)
         {
           funct.zero_dst_vector_range(numbers::invalid_unsigned_int);
-          if (scheme == partition_partition && evens > 0)
+          if (scheme == partition_partition_dynamic)
+            dynamic::run(funct, *this);
+          else if (scheme == partition_partition && evens > 0)
             {
               tbb::empty_task *root =
                 new (tbb::task::allocate_root()) tbb::empty_task;
@@ -589,7 +975,8 @@ namespace internal
                ++part)
             {
               if (part == 1)
-                funct.vector_update_ghosts_finish();
+                ghost_tracker.finish(
+                  [&funct]() { funct.vector_update_ghosts_finish(); });
 
               for (unsigned int i = partition_row_index[part];
                    i < partition_row_index[part + 1];
@@ -612,13 +999,25 @@ namespace internal
                         funct.boundary(i);
                     }
                   funct.cell_loop_post_range(i);
+
+                  // give MPI a chance to progress the messages while we work
+                  // on the cells that do not depend on remote data
+                  if (part == 0)
+                    ghost_tracker.test(
+                      [&funct]() { return funct.vector_update_ghosts_test(); });
+                  else if (part == 2)
+                    compress_tracker.test(
+                      [&funct]() { return funct.vector_compress_test(); });
                 }
 
               if (part == 1)
-                funct.vector_compress_start();
+                {
+                  funct.vector_compress_start();
+                  compress_tracker.start();
+                }
             }
         }
-      funct.vector_compress_finish();
+      compress_tracker.finish([&funct]() { funct.vector_compress_finish(); });
 
       if (scheme != none)
         funct.cell_loop_post_range(numbers::invalid_unsigned_int);
@@ -661,6 +1060,10 @@ namespace internal
       communicator = MPI_COMM_SELF;
       my_pid       = 0;
       n_procs      = 1;
+
+      test_communication_progress = false;
+      communication_statistics.clear();
+      load_statistics.clear();
     }
 
 
@@ -1350,7 +1753,8 @@ namespace internal
       // make_partitioning defines that the no. of cells in each partition
       // should be a multiple of cluster_size.
       unsigned int cluster_size = 1;
-      if (scheme == partition_partition)
+      if (scheme == partition_partition ||
+          scheme == partition_partition_dynamic)
         cluster_size = block_size * vectorization_length;
 
       // Make the partitioning of the first layer of the blocks of cells.
@@ -1370,7 +1774,8 @@ namespace internal
                           partition);
 
       // Partition or color second layer
-      if (scheme == partition_partition)
+      if (scheme == partition_partition ||
+          scheme == partition_partition_dynamic)
 
         {
           // Partition within partitions.
@@ -1409,7 +1814,9 @@ namespace internal
       // Set the new renumbering
       std::vector<unsigned int> renumbering_in(n_active_cells, 0);
       renumbering_in.swap(renumbering);
-      if (scheme == partition_partition) // blocking_connectivity == false
+      // blocking_connectivity == false
+      if (scheme == partition_partition ||
+          scheme == partition_partition_dynamic)
         {
           // This is the simple case. The renumbering is just a combination of
           // the renumbering that we were given as an input and the
@@ -2272,6 +2679,20 @@ internal::MatrixFreeFunctions::TaskInfo::print_memory_statistics<std::ostream>(
 template void
 internal::MatrixFreeFunctions::TaskInfo::print_memory_statistics<
   ConditionalOStream>(ConditionalOStream &, const std::size_t) const;
+template void
+internal::MatrixFreeFunctions::CommunicationOverlapStatistics::print<
+  std::ostream>(std::ostream &, const MPI_Comm &) const;
+template void
+internal::MatrixFreeFunctions::CommunicationOverlapStatistics::print<
+  ConditionalOStream>(ConditionalOStream &, const MPI_Comm &) const;
+template void
+internal::MatrixFreeFunctions::TaskLoadStatistics::print<std::ostream>(
+  std::ostream &,
+  const MPI_Comm &) const;
+template void
+internal::MatrixFreeFunctions::TaskLoadStatistics::print<ConditionalOStream>(
+  ConditionalOStream &,
+  const MPI_Comm &) const;
 
 
 DEAL_II_NAMESPACE_CLOSE
@@ -307,6 +307,19 @@ namespace internal
 
 
 
+      void
+      PartitionerWrapper::free_requests(
+        std::vector<MPI_Request> &requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)requests;
+#else
+        partitioner->free_requests(requests);
+#endif
+      }
+
+
+
       template <typename Number>
       void
       PartitionerWrapper::reset_ghost_values_impl(
@@ -886,22 +899,49 @@ namespace internal
             AssertThrowMPI(ierr);
           }
 
-        // receive data from remote processes
+        // the exchange with remote processes is typically repeated many
+        // times with the same arrays, so use persistent requests that are
+        // only set up once
+        std::vector<Utilities::MPI::internal::PersistentRequests::Message>
+          messages;
+        messages.reserve(ghost_targets_data.size() +
+                         import_targets_data.size());
         for (unsigned int i = 0; i < ghost_targets_data.size(); i++)
           {
             const unsigned int offset =
               n_ghost_indices_in_larger_set_by_remote_rank[i] -
               ghost_targets_data[i][2];
 
+            messages.push_back(
+              {false,
+               buffer.data() + ghost_targets_data[i][1] + offset,
+               static_cast<int>(ghost_targets_data[i][2]),
+               Utilities::MPI::internal::mpi_type_id(buffer.data()),
+               static_cast<int>(ghost_targets_data[i][0]),
+               static_cast<int>(communication_channel + 1),
+               comm});
+          }
+        for (unsigned int i = 0; i < import_targets_data.size(); i++)
+          messages.push_back(
+            {true,
+             temporary_storage.data() + import_targets_data[i][1],
+             static_cast<int>(import_targets_data[i][2]),
+             Utilities::MPI::internal::mpi_type_id(data_this.data()),
+             static_cast<int>(import_targets_data[i][0]),
+             static_cast<int>(communication_channel + 1),
+             comm});
+
+        MPI_Request *remote_requests =
+          requests.data() + sm_import_ranks.size() + sm_ghost_ranks.size();
+        const std::vector<MPI_Request> &persistent =
+          persistent_requests.get(messages);
+        std::copy(persistent.begin(), persistent.end(), remote_requests);
+
+        // receive data from remote processes
+        if (ghost_targets_data.size() > 0)
+          {
             const int ierr =
-              MPI_Irecv(buffer.data() + ghost_targets_data[i][1] + offset,
-                        ghost_targets_data[i][2],
-                        Utilities::MPI::internal::mpi_type_id(buffer.data()),
-                        ghost_targets_data[i][0],
-                        communication_channel + 1,
-                        comm,
-                        requests.data() + sm_import_ranks.size() +
-                          sm_ghost_ranks.size() + i);
+              MPI_Startall(ghost_targets_data.size(), remote_requests);
             AssertThrowMPI(ierr);
           }
 
@@ -918,15 +958,7 @@ namespace internal
 
             // send data away
             const int ierr =
-              MPI_Isend(temporary_storage.data() + import_targets_data[i][1],
-                        import_targets_data[i][2],
-                        Utilities::MPI::internal::mpi_type_id(data_this.data()),
-                        import_targets_data[i][0],
-                        communication_channel + 1,
-                        comm,
-                        requests.data() + sm_import_ranks.size() +
-                          sm_ghost_ranks.size() + ghost_targets_data.size() +
-                          i);
+              MPI_Start(remote_requests + ghost_targets_data.size() + i);
             AssertThrowMPI(ierr);
           }
 #endif
@@ -1068,6 +1100,10 @@ namespace internal
           MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
         AssertThrowMPI(ierr);
 
+        persistent_requests.release(requests.data() + sm_import_ranks.size() +
+                                      sm_ghost_ranks.size(),
+                                    ghost_targets_data.size() +
+                                      import_targets_data.size());
 #endif
       }
 
@@ -1132,6 +1168,48 @@ namespace internal
             AssertThrowMPI(ierr);
           }
 
+        // the exchange with remote processes is typically repeated many
+        // times with the same arrays, so use persistent requests that are
+        // only set up once
+        std::vector<Utilities::MPI::internal::PersistentRequests::Message>
+          messages;
+        messages.reserve(ghost_targets_data.size() +
+                         import_targets_data.size());
+        for (unsigned int i = 0; i < ghost_targets_data.size(); i++)
+          messages.push_back(
+            {true,
+             buffer.data() + ghost_targets_data[i][1],
+             static_cast<int>(ghost_targets_data[i][2]),
+             Utilities::MPI::internal::mpi_type_id(buffer.data()),
+             static_cast<int>(ghost_targets_data[i][0]),
+             static_cast<int>(communication_channel + 0),
+             comm});
+        for (unsigned int i = 0; i < import_targets_data.size(); i++)
+          messages.push_back(
+            {false,
+             temporary_storage.data() + import_targets_data[i][1],
+             static_cast<int>(import_targets_data[i][2]),
+             Utilities::MPI::internal::mpi_type_id(temporary_storage.data()),
+             static_cast<int>(import_targets_data[i][0]),
+             static_cast<int>(communication_channel + 0),
+             comm});
+
+        MPI_Request *remote_requests =
+          requests.data() + sm_ghost_ranks.size() + sm_import_ranks.size();
+        const std::vector<MPI_Request> &persistent =
+          persistent_requests.get(messages);
+        std::copy(persistent.begin(), persistent.end(), remote_requests);
+
+        // receive data from remote processes
+        if (import_targets_data.size() > 0)
+          {
+            const int ierr =
+              MPI_Startall(import_targets_data.size(),
+                           remote_requests + ghost_targets_data.size());
+            AssertThrowMPI(ierr);
+          }
+
+        // send data to remote processes
         for (unsigned int i = 0; i < ghost_targets_data.size(); i++)
           {
             for (unsigned int c  = 0,
@@ -1170,29 +1248,7 @@ namespace internal
                   }
               }
 
-            const int ierr =
-              MPI_Isend(buffer.data() + ghost_targets_data[i][1],
-                        ghost_targets_data[i][2],
-                        Utilities::MPI::internal::mpi_type_id(buffer.data()),
-                        ghost_targets_data[i][0],
-                        communication_channel + 0,
-                        comm,
-                        requests.data() + sm_ghost_ranks.size() +
-                          sm_import_ranks.size() + i);
-            AssertThrowMPI(ierr);
-          }
-
-        for (unsigned int i = 0; i < import_targets_data.size(); i++)
-          {
-            const int ierr = MPI_Irecv(
-              temporary_storage.data() + import_targets_data[i][1],
-              import_targets_data[i][2],
-              Utilities::MPI::internal::mpi_type_id(temporary_storage.data()),
-              import_targets_data[i][0],
-              communication_channel + 0,
-              comm,
-              requests.data() + sm_ghost_ranks.size() + sm_import_ranks.size() +
-                ghost_targets_data.size() + i);
+            const int ierr = MPI_Start(remote_requests + i);
             AssertThrowMPI(ierr);
           }
 #endif
@@ -1320,6 +1376,11 @@ namespace internal
         const int ierr =
           MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
         AssertThrowMPI(ierr);
+
+        persistent_requests.release(requests.data() + sm_ghost_ranks.size() +
+                                      sm_import_ranks.size(),
+                                    ghost_targets_data.size() +
+                                      import_targets_data.size());
 #endif
       }
 
@@ -1391,6 +1452,25 @@ namespace internal
 
 
 
+      void
+      Full::free_requests(std::vector<MPI_Request> &requests) const
+      {
+#ifndef DEAL_II_WITH_MPI
+        (void)requests;
+#else
+        persistent_requests.forget(requests.data(), requests.size());
+        for (auto &request : requests)
+          if (request != MPI_REQUEST_NULL)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertThrowMPI(ierr);
+            }
+        requests.clear();
+#endif
+      }
+
+
+
       template <typename Number>
       void
       Full::reset_ghost_values_impl(const ArrayView<Number> &ghost_array) const
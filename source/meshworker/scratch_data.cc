@@ -29,8 +29,8 @@ namespace MeshWorker
     const UpdateFlags &                 update_flags,
     const Quadrature<dim - 1> &         face_quadrature,
     const UpdateFlags &                 face_update_flags)
-    : mapping(&mapping)
-    , fe(&fe)
+    : mappings(1, &mapping)
+    , fes(1, &fe)
     , cell_quadrature(quadrature)
     , face_quadrature(face_quadrature)
     , cell_update_flags(update_flags)
@@ -39,7 +39,9 @@ namespace MeshWorker
     , neighbor_face_update_flags(face_update_flags)
     , local_dof_indices(fe.n_dofs_per_cell())
     , neighbor_dof_indices(fe.n_dofs_per_cell())
-  {}
+  {
+    initialize_fe_values_caches();
+  }
 
 
 
@@ -53,8 +55,8 @@ namespace MeshWorker
     const Quadrature<dim - 1> &         face_quadrature,
     const UpdateFlags &                 face_update_flags,
     const UpdateFlags &                 neighbor_face_update_flags)
-    : mapping(&mapping)
-    , fe(&fe)
+    : mappings(1, &mapping)
+    , fes(1, &fe)
     , cell_quadrature(quadrature)
     , face_quadrature(face_quadrature)
     , cell_update_flags(update_flags)
@@ -63,7 +65,9 @@ namespace MeshWorker
     , neighbor_face_update_flags(neighbor_face_update_flags)
     , local_dof_indices(fe.n_dofs_per_cell())
     , neighbor_dof_indices(fe.n_dofs_per_cell())
-  {}
+  {
+    initialize_fe_values_caches();
+  }
 
 
 
@@ -107,11 +111,54 @@ namespace MeshWorker
 
 
 
+  template <int dim, int spacedim>
+  ScratchData<dim, spacedim>::ScratchData(
+    const hp::MappingCollection<dim, spacedim> &mapping,
+    const hp::FECollection<dim, spacedim> &     fe,
+    const hp::QCollection<dim> &                quadrature,
+    const UpdateFlags &                         update_flags,
+    const hp::QCollection<dim - 1> &            face_quadrature,
+    const UpdateFlags &                         face_update_flags)
+    : cell_quadrature(quadrature)
+    , face_quadrature(face_quadrature)
+    , cell_update_flags(update_flags)
+    , neighbor_cell_update_flags(update_flags)
+    , face_update_flags(face_update_flags)
+    , neighbor_face_update_flags(face_update_flags)
+    , local_dof_indices(fe.max_dofs_per_cell())
+    , neighbor_dof_indices(fe.max_dofs_per_cell())
+  {
+    Assert(fe.size() > 0,
+           ExcMessage("The finite element collection must not be empty."));
+    Assert(mapping.size() == 1 || mapping.size() == fe.size(),
+           ExcMessage("The mapping collection must have either one element "
+                      "or as many elements as the finite element "
+                      "collection."));
+    Assert(quadrature.size() == 1 || quadrature.size() == fe.size(),
+           ExcMessage("The quadrature collection must have either one "
+                      "element or as many elements as the finite element "
+                      "collection."));
+    Assert(face_quadrature.size() <= 1 ||
+             face_quadrature.size() == fe.size(),
+           ExcMessage("The face quadrature collection must have at most one "
+                      "element or as many elements as the finite element "
+                      "collection."));
+
+    for (unsigned int i = 0; i < mapping.size(); ++i)
+      mappings.emplace_back(&mapping[i]);
+    for (unsigned int i = 0; i < fe.size(); ++i)
+      fes.emplace_back(&fe[i]);
+
+    initialize_fe_values_caches();
+  }
+
+
+
   template <int dim, int spacedim>
   ScratchData<dim, spacedim>::ScratchData(
     const ScratchData<dim, spacedim> &scratch)
-    : mapping(scratch.mapping)
-    , fe(scratch.fe)
+    : mappings(scratch.mappings)
+    , fes(scratch.fes)
     , cell_quadrature(scratch.cell_quadrature)
     , face_quadrature(scratch.face_quadrature)
     , cell_update_flags(scratch.cell_update_flags)
@@ -122,7 +169,61 @@ namespace MeshWorker
     , neighbor_dof_indices(scratch.neighbor_dof_indices)
     , user_data_storage(scratch.user_data_storage)
     , internal_data_storage(scratch.internal_data_storage)
-  {}
+  {
+    initialize_fe_values_caches();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ScratchData<dim, spacedim>::initialize_fe_values_caches()
+  {
+    const unsigned int n_fes = fes.size();
+
+    fe_values.resize(n_fes);
+    fe_face_values.resize(n_fes);
+    fe_subface_values.resize(n_fes);
+    neighbor_fe_values.resize(n_fes);
+    neighbor_fe_face_values.resize(n_fes);
+    neighbor_fe_subface_values.resize(n_fes);
+    interface_fe_values.resize(n_fes);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const Mapping<dim, spacedim> &
+  ScratchData<dim, spacedim>::get_mapping(const unsigned int fe_index) const
+  {
+    AssertIndexRange(fe_index, fes.size());
+    return *mappings[mappings.size() == 1 ? 0 : fe_index];
+  }
+
+
+
+  template <int dim, int spacedim>
+  const Quadrature<dim> &
+  ScratchData<dim, spacedim>::get_cell_quadrature(
+    const unsigned int fe_index) const
+  {
+    AssertIndexRange(fe_index, fes.size());
+    return cell_quadrature[cell_quadrature.size() == 1 ? 0 : fe_index];
+  }
+
+
+
+  template <int dim, int spacedim>
+  const Quadrature<dim - 1> &
+  ScratchData<dim, spacedim>::get_face_quadrature(
+    const unsigned int fe_index) const
+  {
+    AssertIndexRange(fe_index, fes.size());
+    Assert(face_quadrature.size() > 0,
+           ExcMessage("You have to provide a face quadrature to work on "
+                      "faces."));
+    return face_quadrature[face_quadrature.size() == 1 ? 0 : fe_index];
+  }
 
 
 
@@ -131,17 +232,22 @@ namespace MeshWorker
   ScratchData<dim, spacedim>::reinit(
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell)
   {
-    if (!fe_values)
-      fe_values = std::make_unique<FEValues<dim, spacedim>>(*mapping,
-                                                            *fe,
-                                                            cell_quadrature,
-                                                            cell_update_flags);
-
-    fe_values->reinit(cell);
-    local_dof_indices.resize(fe_values->dofs_per_cell);
+    const unsigned int fe_index = cell->active_fe_index();
+    AssertIndexRange(fe_index, fes.size());
+
+    auto &cell_fe_values = fe_values[fe_index];
+    if (!cell_fe_values)
+      cell_fe_values =
+        std::make_unique<FEValues<dim, spacedim>>(get_mapping(fe_index),
+                                                  *fes[fe_index],
+                                                  get_cell_quadrature(fe_index),
+                                                  cell_update_flags);
+
+    cell_fe_values->reinit(cell);
+    local_dof_indices.resize(cell_fe_values->dofs_per_cell);
     cell->get_dof_indices(local_dof_indices);
-    current_fe_values = fe_values.get();
-    return *fe_values;
+    current_fe_values = cell_fe_values.get();
+    return *cell_fe_values;
   }
 
 
@@ -152,15 +258,22 @@ namespace MeshWorker
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
     const unsigned int                                              face_no)
   {
-    if (!fe_face_values)
-      fe_face_values = std::make_unique<FEFaceValues<dim, spacedim>>(
-        *mapping, *fe, face_quadrature, face_update_flags);
-
-    fe_face_values->reinit(cell, face_no);
-    local_dof_indices.resize(fe->n_dofs_per_cell());
+    const unsigned int fe_index = cell->active_fe_index();
+    AssertIndexRange(fe_index, fes.size());
+
+    auto &face_fe_values = fe_face_values[fe_index];
+    if (!face_fe_values)
+      face_fe_values = std::make_unique<FEFaceValues<dim, spacedim>>(
+        get_mapping(fe_index),
+        *fes[fe_index],
+        get_face_quadrature(fe_index),
+        face_update_flags);
+
+    face_fe_values->reinit(cell, face_no);
+    local_dof_indices.resize(fes[fe_index]->n_dofs_per_cell());
     cell->get_dof_indices(local_dof_indices);
-    current_fe_values = fe_face_values.get();
-    return *fe_face_values;
+    current_fe_values = face_fe_values.get();
+    return *face_fe_values;
   }
 
 
@@ -174,15 +287,22 @@ namespace MeshWorker
   {
     if (subface_no != numbers::invalid_unsigned_int)
       {
-        if (!fe_subface_values)
-          fe_subface_values = std::make_unique<FESubfaceValues<dim, spacedim>>(
-            *mapping, *fe, face_quadrature, face_update_flags);
-        fe_subface_values->reinit(cell, face_no, subface_no);
-        local_dof_indices.resize(fe->n_dofs_per_cell());
+        const unsigned int fe_index = cell->active_fe_index();
+        AssertIndexRange(fe_index, fes.size());
+
+        auto &subface_fe_values = fe_subface_values[fe_index];
+        if (!subface_fe_values)
+          subface_fe_values = std::make_unique<FESubfaceValues<dim, spacedim>>(
+            get_mapping(fe_index),
+            *fes[fe_index],
+            get_face_quadrature(fe_index),
+            face_update_flags);
+        subface_fe_values->reinit(cell, face_no, subface_no);
+        local_dof_indices.resize(fes[fe_index]->n_dofs_per_cell());
         cell->get_dof_indices(local_dof_indices);
 
-        current_fe_values = fe_subface_values.get();
-        return *fe_subface_values;
+        current_fe_values = subface_fe_values.get();
+        return *subface_fe_values;
       }
     else
       return reinit(cell, face_no);
@@ -201,22 +321,34 @@ namespace MeshWorker
     const unsigned int face_no_neighbor,
     const unsigned int sub_face_no_neighbor)
   {
-    if (!interface_fe_values)
-      interface_fe_values = std::make_unique<FEInterfaceValues<dim, spacedim>>(
-        *mapping, *fe, face_quadrature, face_update_flags);
-    interface_fe_values->reinit(cell,
+    const unsigned int fe_index = cell->active_fe_index();
+    AssertIndexRange(fe_index, fes.size());
+    Assert(cell_neighbor->active_fe_index() == fe_index,
+           ExcMessage("FEInterfaceValues can only be used on faces between "
+                      "cells with the same finite element."));
+
+    auto &fe_interface_values = interface_fe_values[fe_index];
+    if (!fe_interface_values)
+      fe_interface_values =
+        std::make_unique<FEInterfaceValues<dim, spacedim>>(
+          get_mapping(fe_index),
+          *fes[fe_index],
+          get_face_quadrature(fe_index),
+          face_update_flags);
+    fe_interface_values->reinit(cell,
                                 face_no,
                                 sub_face_no,
                                 cell_neighbor,
                                 face_no_neighbor,
                                 sub_face_no_neighbor);
 
-    current_fe_values          = &interface_fe_values->get_fe_face_values(0);
-    current_neighbor_fe_values = &interface_fe_values->get_fe_face_values(1);
+    current_fe_values          = &fe_interface_values->get_fe_face_values(0);
+    current_neighbor_fe_values = &fe_interface_values->get_fe_face_values(1);
 
+    neighbor_dof_indices.resize(fes[fe_index]->n_dofs_per_cell());
     cell_neighbor->get_dof_indices(neighbor_dof_indices);
-    local_dof_indices = interface_fe_values->get_interface_dof_indices();
-    return *interface_fe_values;
+    local_dof_indices = fe_interface_values->get_interface_dof_indices();
+    return *fe_interface_values;
   }
 
 
@@ -226,14 +358,22 @@ namespace MeshWorker
   ScratchData<dim, spacedim>::reinit_neighbor(
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell)
   {
-    if (!neighbor_fe_values)
-      neighbor_fe_values = std::make_unique<FEValues<dim, spacedim>>(
-        *mapping, *fe, cell_quadrature, neighbor_cell_update_flags);
-
-    neighbor_fe_values->reinit(cell);
+    const unsigned int fe_index = cell->active_fe_index();
+    AssertIndexRange(fe_index, fes.size());
+
+    auto &cell_fe_values = neighbor_fe_values[fe_index];
+    if (!cell_fe_values)
+      cell_fe_values =
+        std::make_unique<FEValues<dim, spacedim>>(get_mapping(fe_index),
+                                                  *fes[fe_index],
+                                                  get_cell_quadrature(fe_index),
+                                                  neighbor_cell_update_flags);
+
+    cell_fe_values->reinit(cell);
+    neighbor_dof_indices.resize(cell_fe_values->dofs_per_cell);
     cell->get_dof_indices(neighbor_dof_indices);
-    current_neighbor_fe_values = neighbor_fe_values.get();
-    return *neighbor_fe_values;
+    current_neighbor_fe_values = cell_fe_values.get();
+    return *cell_fe_values;
   }
 
 
@@ -244,13 +384,21 @@ namespace MeshWorker
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
     const unsigned int                                              face_no)
   {
-    if (!neighbor_fe_face_values)
-      neighbor_fe_face_values = std::make_unique<FEFaceValues<dim, spacedim>>(
-        *mapping, *fe, face_quadrature, neighbor_face_update_flags);
-    neighbor_fe_face_values->reinit(cell, face_no);
+    const unsigned int fe_index = cell->active_fe_index();
+    AssertIndexRange(fe_index, fes.size());
+
+    auto &face_fe_values = neighbor_fe_face_values[fe_index];
+    if (!face_fe_values)
+      face_fe_values = std::make_unique<FEFaceValues<dim, spacedim>>(
+        get_mapping(fe_index),
+        *fes[fe_index],
+        get_face_quadrature(fe_index),
+        neighbor_face_update_flags);
+    face_fe_values->reinit(cell, face_no);
+    neighbor_dof_indices.resize(fes[fe_index]->n_dofs_per_cell());
     cell->get_dof_indices(neighbor_dof_indices);
-    current_neighbor_fe_values = neighbor_fe_face_values.get();
-    return *neighbor_fe_face_values;
+    current_neighbor_fe_values = face_fe_values.get();
+    return *face_fe_values;
   }
 
 
@@ -264,14 +412,21 @@ namespace MeshWorker
   {
     if (subface_no != numbers::invalid_unsigned_int)
       {
-        if (!neighbor_fe_subface_values)
-          neighbor_fe_subface_values =
-            std::make_unique<FESubfaceValues<dim, spacedim>>(
-              *mapping, *fe, face_quadrature, neighbor_face_update_flags);
-        neighbor_fe_subface_values->reinit(cell, face_no, subface_no);
+        const unsigned int fe_index = cell->active_fe_index();
+        AssertIndexRange(fe_index, fes.size());
+
+        auto &subface_fe_values = neighbor_fe_subface_values[fe_index];
+        if (!subface_fe_values)
+          subface_fe_values = std::make_unique<FESubfaceValues<dim, spacedim>>(
+            get_mapping(fe_index),
+            *fes[fe_index],
+            get_face_quadrature(fe_index),
+            neighbor_face_update_flags);
+        subface_fe_values->reinit(cell, face_no, subface_no);
+        neighbor_dof_indices.resize(fes[fe_index]->n_dofs_per_cell());
         cell->get_dof_indices(neighbor_dof_indices);
-        current_neighbor_fe_values = neighbor_fe_subface_values.get();
-        return *neighbor_fe_subface_values;
+        current_neighbor_fe_values = subface_fe_values.get();
+        return *subface_fe_values;
       }
     else
       return reinit_neighbor(cell, face_no);
@@ -388,7 +543,9 @@ namespace MeshWorker
   const Mapping<dim, spacedim> &
   ScratchData<dim, spacedim>::get_mapping() const
   {
-    return *mapping;
+    if (current_fe_values != nullptr)
+      return current_fe_values->get_mapping();
+    return *mappings[0];
   }
 
 } // namespace MeshWorker
@@ -1331,146 +1331,124 @@ namespace MGTools
     const unsigned int n_components = dof.get_fe_collection().n_components();
     const bool         fe_is_system = (n_components != 1);
 
-    std::vector<types::global_dof_index> local_dofs;
-    local_dofs.reserve(dof.get_fe_collection().max_dofs_per_face());
-    std::fill(local_dofs.begin(), local_dofs.end(), numbers::invalid_dof_index);
+    Assert(component_mask.n_selected_components(n_components) > 0,
+           ExcMessage(
+             "It's probably worthwhile to select at least one component."));
+
+    // the levels are independent of each other, so we work on them in
+    // parallel. On each level, we only visit the locally relevant cells,
+    // collect the indices in a vector and sort it at the end, which is much
+    // cheaper than inserting the indices into the IndexSet one by one
+    const auto process_level = [&](const unsigned int level) {
+      std::vector<types::global_dof_index> local_dofs;
+      local_dofs.reserve(dof.get_fe_collection().max_dofs_per_face());
+      std::vector<types::global_dof_index> dofs_on_level;
+
+      for (const auto &cell : dof.cell_iterators_on_level(level))
+        {
+          if (dof.get_triangulation().locally_owned_subdomain() !=
+                numbers::invalid_subdomain_id &&
+              cell->level_subdomain_id() == numbers::artificial_subdomain_id)
+            continue;
+          if (cell->at_boundary() == false)
+            continue;
 
-    std::vector<std::vector<types::global_dof_index>> dofs_by_level(
-      dof.get_triangulation().n_levels());
+          const FiniteElement<dim> &fe = cell->get_fe();
 
-    // First, deal with the simpler case when we have to identify all boundary
-    // dofs
-    if (component_mask.n_selected_components(n_components) == n_components)
-      {
-        for (const auto &cell : dof.cell_iterators())
-          {
-            if (dof.get_triangulation().locally_owned_subdomain() !=
-                  numbers::invalid_subdomain_id &&
-                cell->level_subdomain_id() == numbers::artificial_subdomain_id)
-              continue;
-            const FiniteElement<dim> &fe    = cell->get_fe();
-            const unsigned int        level = cell->level();
-
-            for (const unsigned int face_no : GeometryInfo<dim>::face_indices())
-              if (cell->at_boundary(face_no) == true)
-                {
-                  const typename DoFHandler<dim, spacedim>::face_iterator face =
-                    cell->face(face_no);
-                  const types::boundary_id bi = face->boundary_id();
-                  // Face is listed in boundary map
-                  if (boundary_ids.find(bi) != boundary_ids.end())
-                    {
-                      local_dofs.resize(fe.n_dofs_per_face(face_no));
-                      face->get_mg_dof_indices(level, local_dofs);
-                      dofs_by_level[level].insert(dofs_by_level[level].end(),
-                                                  local_dofs.begin(),
-                                                  local_dofs.end());
-                    }
-                }
-          }
-      }
-    else
-      {
-        Assert(component_mask.n_selected_components(n_components) > 0,
-               ExcMessage(
-                 "It's probably worthwhile to select at least one component."));
-
-        for (const auto &cell : dof.cell_iterators())
-          if (dof.get_triangulation().locally_owned_subdomain() ==
-                numbers::invalid_subdomain_id ||
-              cell->level_subdomain_id() != numbers::artificial_subdomain_id)
-            for (const unsigned int face_no : GeometryInfo<dim>::face_indices())
+          for (const unsigned int face_no : GeometryInfo<dim>::face_indices())
+            if (cell->at_boundary(face_no) == true)
               {
-                if (cell->at_boundary(face_no) == false)
+                const typename DoFHandler<dim, spacedim>::face_iterator face =
+                  cell->face(face_no);
+                // skip faces that are not listed in the boundary map
+                if (boundary_ids.find(face->boundary_id()) ==
+                    boundary_ids.end())
                   continue;
 
-                const FiniteElement<dim> &fe    = cell->get_fe();
-                const unsigned int        level = cell->level();
+                local_dofs.resize(fe.n_dofs_per_face(face_no));
+                face->get_mg_dof_indices(level, local_dofs);
 
-                typename DoFHandler<dim, spacedim>::face_iterator face =
-                  cell->face(face_no);
-                const types::boundary_id boundary_component =
-                  face->boundary_id();
-                if (boundary_ids.find(boundary_component) != boundary_ids.end())
-                  // we want to constrain this boundary
+                // First, deal with the simpler case when we have to identify
+                // all boundary dofs
+                if (component_mask.n_selected_components(n_components) ==
+                      n_components ||
+                    fe_is_system == false)
+                  {
+                    dofs_on_level.insert(dofs_on_level.end(),
+                                         local_dofs.begin(),
+                                         local_dofs.end());
+                    continue;
+                  }
+
+#ifdef DEBUG
+                for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+                  {
+                    const ComponentMask &nonzero_component_array =
+                      fe.get_nonzero_components(i);
+                    // if we want to constrain one of the nonzero
+                    // components, we have to constrain all of them
+                    bool selected = false;
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      if (nonzero_component_array[c] == true &&
+                          component_mask[c] == true)
+                        {
+                          selected = true;
+                          break;
+                        }
+                    if (selected)
+                      for (unsigned int c = 0; c < n_components; ++c)
+                        Assert(
+                          nonzero_component_array[c] == false ||
+                            component_mask[c] == true,
+                          ExcMessage(
+                            "You are using a non-primitive FiniteElement "
+                            "and try to constrain just some of its components!"));
+                  }
+#endif
+
+                for (unsigned int i = 0; i < local_dofs.size(); ++i)
                   {
-                    for (unsigned int i = 0;
-                         i < cell->get_fe().n_dofs_per_cell();
-                         ++i)
+                    unsigned int component = numbers::invalid_unsigned_int;
+                    if (fe.is_primitive())
+                      component =
+                        fe.face_system_to_component_index(i, face_no).first;
+                    else
                       {
+                        // Just pick the first of the components
+                        // We already know that either all or none
+                        // of the components are selected
                         const ComponentMask &nonzero_component_array =
-                          cell->get_fe().get_nonzero_components(i);
-                        // if we want to constrain one of the nonzero
-                        // components, we have to constrain all of them
-
-                        bool selected = false;
+                          fe.get_nonzero_components(
+                            fe.face_to_cell_index(i, face_no));
                         for (unsigned int c = 0; c < n_components; ++c)
-                          if (nonzero_component_array[c] == true &&
-                              component_mask[c] == true)
+                          if (nonzero_component_array[c] == true)
                             {
-                              selected = true;
+                              component = c;
                               break;
                             }
-                        if (selected)
-                          for (unsigned int c = 0; c < n_components; ++c)
-                            Assert(
-                              nonzero_component_array[c] == false ||
-                                component_mask[c] == true,
-                              ExcMessage(
-                                "You are using a non-primitive FiniteElement "
-                                "and try to constrain just some of its components!"));
                       }
-
-                    // get indices, physical location and boundary values of
-                    // dofs on this face
-                    local_dofs.resize(fe.n_dofs_per_face(face_no));
-                    face->get_mg_dof_indices(level, local_dofs);
-                    if (fe_is_system)
-                      {
-                        for (unsigned int i = 0; i < local_dofs.size(); ++i)
-                          {
-                            unsigned int component =
-                              numbers::invalid_unsigned_int;
-                            if (fe.is_primitive())
-                              component =
-                                fe.face_system_to_component_index(i, face_no)
-                                  .first;
-                            else
-                              {
-                                // Just pick the first of the components
-                                // We already know that either all or none
-                                // of the components are selected
-                                const ComponentMask &nonzero_component_array =
-                                  cell->get_fe().get_nonzero_components(i);
-                                for (unsigned int c = 0; c < n_components; ++c)
-                                  if (nonzero_component_array[c] == true)
-                                    {
-                                      component = c;
-                                      break;
-                                    }
-                              }
-                            Assert(component != numbers::invalid_unsigned_int,
-                                   ExcInternalError());
-                            if (component_mask[component] == true)
-                              dofs_by_level[level].push_back(local_dofs[i]);
-                          }
-                      }
-                    else
-                      dofs_by_level[level].insert(dofs_by_level[level].end(),
-                                                  local_dofs.begin(),
-                                                  local_dofs.end());
+                    Assert(component != numbers::invalid_unsigned_int,
+                           ExcInternalError());
+                    if (component_mask[component] == true)
+                      dofs_on_level.push_back(local_dofs[i]);
                   }
               }
-      }
+        }
+
+      std::sort(dofs_on_level.begin(), dofs_on_level.end());
+      boundary_indices[level].add_indices(dofs_on_level.begin(),
+                                          std::unique(dofs_on_level.begin(),
+                                                      dofs_on_level.end()));
+      boundary_indices[level].compress();
+    };
+
+    Threads::TaskGroup<> tasks;
     for (unsigned int level = 0; level < dof.get_triangulation().n_levels();
          ++level)
-      {
-        std::sort(dofs_by_level[level].begin(), dofs_by_level[level].end());
-        boundary_indices[level].add_indices(
-          dofs_by_level[level].begin(),
-          std::unique(dofs_by_level[level].begin(),
-                      dofs_by_level[level].end()));
-      }
+      tasks += Threads::new_task([&process_level, level]() {
+        process_level(level);
+      });
+    tasks.join_all();
   }
 
 
@@ -1486,88 +1464,91 @@ namespace MGTools
              interface_dofs.size(),
              mg_dof_handler.get_triangulation().n_global_levels()));
 
-    std::vector<std::vector<types::global_dof_index>> tmp_interface_dofs(
-      interface_dofs.size());
-
     const FiniteElement<dim, spacedim> &fe = mg_dof_handler.get_fe();
 
     const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
 
-    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
-
-    std::vector<bool> cell_dofs(dofs_per_cell, false);
-
-    typename DoFHandler<dim>::cell_iterator cell = mg_dof_handler.begin(),
-                                            endc = mg_dof_handler.end();
-
-    for (; cell != endc; ++cell)
-      {
-        // Do not look at artificial level cells (in a serial computation we
-        // need to ignore the level_subdomain_id() because it is never set).
-        if (mg_dof_handler.get_triangulation().locally_owned_subdomain() !=
-              numbers::invalid_subdomain_id &&
-            cell->level_subdomain_id() == numbers::artificial_subdomain_id)
-          continue;
+    // the levels are independent of each other, so we work on them in
+    // parallel. On each level, we only visit the locally relevant cells,
+    // collect the indices in a vector and sort it at the end, which is much
+    // cheaper than inserting the indices into the IndexSet one by one
+    const auto process_level = [&](const unsigned int level) {
+      std::vector<types::global_dof_index> level_interface_dofs;
+      std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+      std::vector<bool>                    cell_dofs(dofs_per_cell, false);
+
+      // cells on level 0 cannot have a coarser neighbor
+      if (level > 0 && level < mg_dof_handler.get_triangulation().n_levels())
+        for (const auto &cell : mg_dof_handler.cell_iterators_on_level(level))
+          {
+            // Do not look at artificial level cells (in a serial computation
+            // we need to ignore the level_subdomain_id() because it is never
+            // set).
+            if (mg_dof_handler.get_triangulation().locally_owned_subdomain() !=
+                  numbers::invalid_subdomain_id &&
+                cell->level_subdomain_id() == numbers::artificial_subdomain_id)
+              continue;
 
-        bool has_coarser_neighbor = false;
+            bool has_coarser_neighbor = false;
 
-        std::fill(cell_dofs.begin(), cell_dofs.end(), false);
+            std::fill(cell_dofs.begin(), cell_dofs.end(), false);
 
-        for (const unsigned int face_nr : GeometryInfo<dim>::face_indices())
-          {
-            const typename DoFHandler<dim, spacedim>::face_iterator face =
-              cell->face(face_nr);
-            if (!face->at_boundary() || cell->has_periodic_neighbor(face_nr))
+            for (const unsigned int face_nr : GeometryInfo<dim>::face_indices())
               {
-                // interior face
-                const typename DoFHandler<dim>::cell_iterator neighbor =
-                  cell->neighbor_or_periodic_neighbor(face_nr);
-
-                // only process cell pairs if one or both of them are owned by
-                // me (ignore if running in serial)
-                if (mg_dof_handler.get_triangulation()
-                        .locally_owned_subdomain() !=
-                      numbers::invalid_subdomain_id &&
-                    neighbor->level_subdomain_id() ==
-                      numbers::artificial_subdomain_id)
-                  continue;
-
-                // Do refinement face from the coarse side
-                if (neighbor->level() < cell->level())
+                const typename DoFHandler<dim, spacedim>::face_iterator face =
+                  cell->face(face_nr);
+                if (!face->at_boundary() || cell->has_periodic_neighbor(face_nr))
                   {
-                    for (unsigned int j = 0; j < fe.n_dofs_per_face(face_nr);
-                         ++j)
-                      cell_dofs[fe.face_to_cell_index(j, face_nr)] = true;
+                    // interior face
+                    const typename DoFHandler<dim>::cell_iterator neighbor =
+                      cell->neighbor_or_periodic_neighbor(face_nr);
+
+                    // only process cell pairs if one or both of them are
+                    // owned by me (ignore if running in serial)
+                    if (mg_dof_handler.get_triangulation()
+                            .locally_owned_subdomain() !=
+                          numbers::invalid_subdomain_id &&
+                        neighbor->level_subdomain_id() ==
+                          numbers::artificial_subdomain_id)
+                      continue;
+
+                    // Do refinement face from the coarse side
+                    if (neighbor->level() < cell->level())
+                      {
+                        for (unsigned int j = 0;
+                             j < fe.n_dofs_per_face(face_nr);
+                             ++j)
+                          cell_dofs[fe.face_to_cell_index(j, face_nr)] = true;
 
-                    has_coarser_neighbor = true;
+                        has_coarser_neighbor = true;
+                      }
                   }
               }
-          }
 
-        if (has_coarser_neighbor == false)
-          continue;
+            if (has_coarser_neighbor == false)
+              continue;
 
-        const unsigned int level = cell->level();
-        cell->get_mg_dof_indices(local_dof_indices);
+            cell->get_mg_dof_indices(local_dof_indices);
 
-        for (unsigned int i = 0; i < dofs_per_cell; ++i)
-          {
-            if (cell_dofs[i])
-              tmp_interface_dofs[level].push_back(local_dof_indices[i]);
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              if (cell_dofs[i])
+                level_interface_dofs.push_back(local_dof_indices[i]);
           }
-      }
 
+      interface_dofs[level].clear();
+      std::sort(level_interface_dofs.begin(), level_interface_dofs.end());
+      interface_dofs[level].add_indices(
+        level_interface_dofs.begin(),
+        std::unique(level_interface_dofs.begin(), level_interface_dofs.end()));
+      interface_dofs[level].compress();
+    };
+
+    Threads::TaskGroup<> tasks;
     for (unsigned int l = 0;
          l < mg_dof_handler.get_triangulation().n_global_levels();
          ++l)
-      {
-        interface_dofs[l].clear();
-        std::sort(tmp_interface_dofs[l].begin(), tmp_interface_dofs[l].end());
-        interface_dofs[l].add_indices(tmp_interface_dofs[l].begin(),
-                                      std::unique(tmp_interface_dofs[l].begin(),
-                                                  tmp_interface_dofs[l].end()));
-        interface_dofs[l].compress();
-      }
+      tasks += Threads::new_task([&process_level, l]() { process_level(l); });
+    tasks.join_all();
   }
 
 
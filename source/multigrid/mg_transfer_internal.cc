@@ -583,14 +583,17 @@ namespace internal
     void
     setup_element_info(ElementInfo<Number> &          elem_info,
                        const FiniteElement<1> &       fe,
-                       const dealii::DoFHandler<dim> &dof_handler)
+                       const dealii::DoFHandler<dim> &dof_handler,
+                       const unsigned int             base_element)
     {
       // currently, we have only FE_Q and FE_DGQ type elements implemented
-      elem_info.n_components = dof_handler.get_fe().element_multiplicity(0);
-      AssertDimension(Utilities::fixed_power<dim>(fe.n_dofs_per_cell()) *
-                        elem_info.n_components,
-                      dof_handler.get_fe().n_dofs_per_cell());
-      AssertDimension(fe.degree, dof_handler.get_fe().degree);
+      const FiniteElement<dim> &fe_base =
+        dof_handler.get_fe().base_element(base_element);
+      elem_info.n_components =
+        dof_handler.get_fe().element_multiplicity(base_element);
+      AssertDimension(Utilities::fixed_power<dim>(fe.n_dofs_per_cell()),
+                      fe_base.n_dofs_per_cell());
+      AssertDimension(fe.degree, fe_base.degree);
       elem_info.fe_degree             = fe.degree;
       elem_info.element_is_continuous = fe.n_dofs_per_vertex() > 0;
       Assert(fe.n_dofs_per_vertex() < 2, ExcNotImplemented());
@@ -624,7 +627,7 @@ namespace internal
       const Quadrature<1> dummy_quadrature(
         std::vector<Point<1>>(1, Point<1>()));
       internal::MatrixFreeFunctions::ShapeInfo<Number> shape_info;
-      shape_info.reinit(dummy_quadrature, dof_handler.get_fe(), 0);
+      shape_info.reinit(dummy_quadrature, dof_handler.get_fe(), base_element);
       elem_info.lexicographic_numbering = shape_info.lexicographic_numbering;
 
       // step 1.4: get the 1d prolongation matrix and combine from both children
@@ -692,7 +695,8 @@ namespace internal
       std::vector<std::vector<Number>> &                     weights_on_refined,
       std::vector<Table<2, unsigned int>> &copy_indices_global_mine,
       MGLevelObject<std::shared_ptr<const Utilities::MPI::Partitioner>>
-        &target_partitioners)
+        &                target_partitioners,
+      const unsigned int base_element)
     {
       level_dof_indices.clear();
       parent_child_connect.clear();
@@ -708,9 +712,12 @@ namespace internal
 
       // ---------------------------- 1. Extract 1D info about the finite
       // element step 1.1: create a 1D copy of the finite element from FETools
-      // where we substitute the template argument
-      AssertDimension(dof_handler.get_fe().n_base_elements(), 1);
-      std::string fe_name = dof_handler.get_fe().base_element(0).get_name();
+      // where we substitute the template argument. For systems with several
+      // base elements, only the degrees of freedom of the given base element
+      // are considered.
+      AssertIndexRange(base_element, dof_handler.get_fe().n_base_elements());
+      std::string fe_name =
+        dof_handler.get_fe().base_element(base_element).get_name();
       {
         const std::size_t template_starts = fe_name.find_first_of('<');
         Assert(fe_name[template_starts + 1] ==
@@ -721,7 +728,7 @@ namespace internal
       const std::unique_ptr<FiniteElement<1>> fe(
         FETools::get_fe_by_name<1, 1>(fe_name));
 
-      setup_element_info(elem_info, *fe, dof_handler);
+      setup_element_info(elem_info, *fe, dof_handler, base_element);
 
 
       // -------------- 2. Extract and match dof indices between child and
@@ -856,7 +863,7 @@ namespace internal
                       // constrained DoFs) for the child
                       if (mg_constrained_dofs != nullptr)
                         for (unsigned int i = 0;
-                             i < dof_handler.get_fe().n_dofs_per_cell();
+                             i < elem_info.lexicographic_numbering.size();
                              ++i)
                           if (mg_constrained_dofs->is_boundary_index(
                                 level,
@@ -904,7 +911,7 @@ namespace internal
                   dirichlet_indices[0].emplace_back();
                   if (mg_constrained_dofs != nullptr)
                     for (unsigned int i = 0;
-                         i < dof_handler.get_fe().n_dofs_per_cell();
+                         i < elem_info.lexicographic_numbering.size();
                          ++i)
                       if (mg_constrained_dofs->is_boundary_index(
                             0,
@@ -41,10 +41,6 @@ DEAL_II_NAMESPACE_OPEN
 
 template <int dim, typename Number>
 MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree()
-  : fe_degree(0)
-  , element_is_continuous(false)
-  , n_components(0)
-  , n_child_cell_dofs(0)
 {}
 
 
@@ -52,10 +48,6 @@ MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree()
 template <int dim, typename Number>
 MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree(
   const MGConstrainedDoFs &mg_c)
-  : fe_degree(0)
-  , element_is_continuous(false)
-  , n_components(0)
-  , n_child_cell_dofs(0)
 {
   this->mg_constrained_dofs = &mg_c;
 }
@@ -78,17 +70,10 @@ MGTransferMatrixFree<dim, Number>::clear()
 {
   this->MGLevelGlobalTransfer<
     LinearAlgebra::distributed::Vector<Number>>::clear();
-  fe_degree             = 0;
-  element_is_continuous = false;
-  n_components          = 0;
-  n_child_cell_dofs     = 0;
-  level_dof_indices.clear();
+  base_element_data.clear();
   parent_child_connect.clear();
-  dirichlet_indices.clear();
   n_owned_level_cells.clear();
-  prolongation_matrix_1d.clear();
   evaluation_data.clear();
-  weights_on_refined.clear();
 }
 
 
@@ -109,22 +94,84 @@ MGTransferMatrixFree<dim, Number>::build(
     vector_partitioners[level] =
       this->ghosted_level_vector[level].get_partitioner();
 
-  std::vector<std::vector<Number>> weights_unvectorized;
-
-  internal::MGTransfer::ElementInfo<Number> elem_info;
+  // set up the transfer separately for the degrees of freedom of each base
+  // element. All base elements share the same ghost indices, as all indices
+  // on the cells are considered as ghosts in setup_transfer(), so the later
+  // base elements can simply use the partitioners set up for the first one.
+  const unsigned int n_base_elements = dof_handler.get_fe().n_base_elements();
+  base_element_data.resize(n_base_elements);
+  unsigned int max_n_child_cell_dofs = 0;
+  for (unsigned int base = 0; base < n_base_elements; ++base)
+    {
+      BaseElementData &data = base_element_data[base];
+
+      std::vector<std::vector<Number>> weights_unvectorized;
+
+      internal::MGTransfer::ElementInfo<Number> elem_info;
+
+      std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>
+        base_partitioners;
+      if (base > 0)
+        for (unsigned int level = 0; level <= vector_partitioners.max_level();
+             ++level)
+          base_partitioners.push_back(vector_partitioners[level]);
+
+      internal::MGTransfer::setup_transfer<dim, Number>(
+        dof_handler,
+        this->mg_constrained_dofs,
+        base == 0 ? external_partitioners : base_partitioners,
+        elem_info,
+        data.level_dof_indices,
+        parent_child_connect,
+        n_owned_level_cells,
+        data.dirichlet_indices,
+        weights_unvectorized,
+        this->copy_indices_global_mine,
+        vector_partitioners,
+        base);
+
+      // unpack element info data
+      data.fe_degree             = elem_info.fe_degree;
+      data.element_is_continuous = elem_info.element_is_continuous;
+      data.n_components          = elem_info.n_components;
+      data.n_child_cell_dofs     = elem_info.n_child_cell_dofs;
+      max_n_child_cell_dofs =
+        std::max(max_n_child_cell_dofs, data.n_child_cell_dofs);
+
+      // duplicate and put into vectorized array
+      data.prolongation_matrix_1d.resize(
+        elem_info.prolongation_matrix_1d.size());
+      for (unsigned int i = 0; i < elem_info.prolongation_matrix_1d.size();
+           i++)
+        data.prolongation_matrix_1d[i] = elem_info.prolongation_matrix_1d[i];
+
+      // reshuffle into aligned vector of vectorized arrays
+      const unsigned int vec_size = VectorizedArray<Number>::size();
+      const unsigned int n_levels =
+        dof_handler.get_triangulation().n_global_levels();
+
+      const unsigned int n_weights_per_cell = Utilities::fixed_power<dim>(3);
+      data.weights_on_refined.resize(n_levels - 1);
+      for (unsigned int level = 1; level < n_levels; ++level)
+        {
+          data.weights_on_refined[level - 1].resize(
+            ((n_owned_level_cells[level - 1] + vec_size - 1) / vec_size) *
+            n_weights_per_cell);
 
-  internal::MGTransfer::setup_transfer<dim, Number>(
-    dof_handler,
-    this->mg_constrained_dofs,
-    external_partitioners,
-    elem_info,
-    level_dof_indices,
-    parent_child_connect,
-    n_owned_level_cells,
-    dirichlet_indices,
-    weights_unvectorized,
-    this->copy_indices_global_mine,
-    vector_partitioners);
+          for (unsigned int c = 0; c < n_owned_level_cells[level - 1]; ++c)
+            {
+              const unsigned int comp = c / vec_size;
+              const unsigned int v    = c % vec_size;
+              for (unsigned int i = 0; i < n_weights_per_cell; ++i)
+                {
+                  data.weights_on_refined[level - 1]
+                                         [comp * n_weights_per_cell + i][v] =
+                    weights_unvectorized[level - 1]
+                                        [c * n_weights_per_cell + i];
+                }
+            }
+        }
+    }
 
   // reinit the ghosted level vector in case its partitioner differs from the
   // one the user intends to use externally
@@ -137,43 +184,7 @@ MGTransferMatrixFree<dim, Number>::build(
     else
       this->ghosted_level_vector[level].reinit(vector_partitioners[level]);
 
-  // unpack element info data
-  fe_degree             = elem_info.fe_degree;
-  element_is_continuous = elem_info.element_is_continuous;
-  n_components          = elem_info.n_components;
-  n_child_cell_dofs     = elem_info.n_child_cell_dofs;
-
-  // duplicate and put into vectorized array
-  prolongation_matrix_1d.resize(elem_info.prolongation_matrix_1d.size());
-  for (unsigned int i = 0; i < elem_info.prolongation_matrix_1d.size(); i++)
-    prolongation_matrix_1d[i] = elem_info.prolongation_matrix_1d[i];
-
-  // reshuffle into aligned vector of vectorized arrays
-  const unsigned int vec_size = VectorizedArray<Number>::size();
-  const unsigned int n_levels =
-    dof_handler.get_triangulation().n_global_levels();
-
-  const unsigned int n_weights_per_cell = Utilities::fixed_power<dim>(3);
-  weights_on_refined.resize(n_levels - 1);
-  for (unsigned int level = 1; level < n_levels; ++level)
-    {
-      weights_on_refined[level - 1].resize(
-        ((n_owned_level_cells[level - 1] + vec_size - 1) / vec_size) *
-        n_weights_per_cell);
-
-      for (unsigned int c = 0; c < n_owned_level_cells[level - 1]; ++c)
-        {
-          const unsigned int comp = c / vec_size;
-          const unsigned int v    = c % vec_size;
-          for (unsigned int i = 0; i < n_weights_per_cell; ++i)
-            {
-              weights_on_refined[level - 1][comp * n_weights_per_cell + i][v] =
-                weights_unvectorized[level - 1][c * n_weights_per_cell + i];
-            }
-        }
-    }
-
-  evaluation_data.resize(n_child_cell_dofs);
+  evaluation_data.resize(max_n_child_cell_dofs);
 }
 
 
@@ -198,8 +209,8 @@ MGTransferMatrixFree<dim, Number>::prolongate_and_add(
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
 {
-  Assert((to_level >= 1) && (to_level <= level_dof_indices.size()),
-         ExcIndexRange(to_level, 1, level_dof_indices.size() + 1));
+  Assert((to_level >= 1) && (to_level <= n_owned_level_cells.size()),
+         ExcIndexRange(to_level, 1, n_owned_level_cells.size() + 1));
 
   const bool src_inplace = src.get_partitioner().get() ==
                            this->vector_partitioners[to_level - 1].get();
@@ -235,30 +246,33 @@ MGTransferMatrixFree<dim, Number>::prolongate_and_add(
   // the implementation in do_prolongate_add is templated in the degree of the
   // element (for efficiency reasons), so we need to find the appropriate
   // kernel here...
-  if (fe_degree == 0)
-    do_prolongate_add<0>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 1)
-    do_prolongate_add<1>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 2)
-    do_prolongate_add<2>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 3)
-    do_prolongate_add<3>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 4)
-    do_prolongate_add<4>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 5)
-    do_prolongate_add<5>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 6)
-    do_prolongate_add<6>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 7)
-    do_prolongate_add<7>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 8)
-    do_prolongate_add<8>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 9)
-    do_prolongate_add<9>(to_level, dst_vec, src_vec);
-  else if (fe_degree == 10)
-    do_prolongate_add<10>(to_level, dst_vec, src_vec);
-  else
-    do_prolongate_add<-1>(to_level, dst_vec, src_vec);
+  for (const BaseElementData &data : base_element_data)
+    {
+      if (data.fe_degree == 0)
+        do_prolongate_add<0>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 1)
+        do_prolongate_add<1>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 2)
+        do_prolongate_add<2>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 3)
+        do_prolongate_add<3>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 4)
+        do_prolongate_add<4>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 5)
+        do_prolongate_add<5>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 6)
+        do_prolongate_add<6>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 7)
+        do_prolongate_add<7>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 8)
+        do_prolongate_add<8>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 9)
+        do_prolongate_add<9>(to_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 10)
+        do_prolongate_add<10>(to_level, data, dst_vec, src_vec);
+      else
+        do_prolongate_add<-1>(to_level, data, dst_vec, src_vec);
+    }
 
   dst_vec.compress(VectorOperation::add);
   if (dst_inplace == false)
@@ -277,8 +291,8 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
 {
-  Assert((from_level >= 1) && (from_level <= level_dof_indices.size()),
-         ExcIndexRange(from_level, 1, level_dof_indices.size() + 1));
+  Assert((from_level >= 1) && (from_level <= n_owned_level_cells.size()),
+         ExcIndexRange(from_level, 1, n_owned_level_cells.size() + 1));
 
   const bool src_inplace =
     src.get_partitioner().get() == this->vector_partitioners[from_level].get();
@@ -312,31 +326,34 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
 
   src_vec.update_ghost_values();
 
-  if (fe_degree == 0)
-    do_restrict_add<0>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 1)
-    do_restrict_add<1>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 2)
-    do_restrict_add<2>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 3)
-    do_restrict_add<3>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 4)
-    do_restrict_add<4>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 5)
-    do_restrict_add<5>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 6)
-    do_restrict_add<6>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 7)
-    do_restrict_add<7>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 8)
-    do_restrict_add<8>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 9)
-    do_restrict_add<9>(from_level, dst_vec, src_vec);
-  else if (fe_degree == 10)
-    do_restrict_add<10>(from_level, dst_vec, src_vec);
-  else
-    // go to the non-templated version of the evaluator
-    do_restrict_add<-1>(from_level, dst_vec, src_vec);
+  for (const BaseElementData &data : base_element_data)
+    {
+      if (data.fe_degree == 0)
+        do_restrict_add<0>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 1)
+        do_restrict_add<1>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 2)
+        do_restrict_add<2>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 3)
+        do_restrict_add<3>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 4)
+        do_restrict_add<4>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 5)
+        do_restrict_add<5>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 6)
+        do_restrict_add<6>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 7)
+        do_restrict_add<7>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 8)
+        do_restrict_add<8>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 9)
+        do_restrict_add<9>(from_level, data, dst_vec, src_vec);
+      else if (data.fe_degree == 10)
+        do_restrict_add<10>(from_level, data, dst_vec, src_vec);
+      else
+        // go to the non-templated version of the evaluator
+        do_restrict_add<-1>(from_level, data, dst_vec, src_vec);
+    }
 
   dst_vec.compress(VectorOperation::add);
   if (dst_inplace == false)
@@ -388,12 +405,14 @@ template <int degree>
 void
 MGTransferMatrixFree<dim, Number>::do_prolongate_add(
   const unsigned int                                to_level,
+  const BaseElementData &                           data,
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
 {
-  const unsigned int vec_size        = VectorizedArray<Number>::size();
-  const unsigned int degree_size     = (degree > -1 ? degree : fe_degree) + 1;
-  const unsigned int n_child_dofs_1d = 2 * degree_size - element_is_continuous;
+  const unsigned int vec_size    = VectorizedArray<Number>::size();
+  const unsigned int degree_size = (degree > -1 ? degree : data.fe_degree) + 1;
+  const unsigned int n_child_dofs_1d =
+    2 * degree_size - data.element_is_continuous;
   const unsigned int n_scalar_cell_dofs =
     Utilities::fixed_power<dim>(n_child_dofs_1d);
   constexpr unsigned int three_to_dim = Utilities::pow(3, dim);
@@ -436,15 +455,15 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
           const unsigned int shift =
             internal::MGTransfer::compute_shift_within_children<dim>(
               parent_child_connect[to_level - 1][cell + v].second,
-              fe_degree + 1 - element_is_continuous,
-              fe_degree);
+              data.fe_degree + 1 - data.element_is_continuous,
+              data.fe_degree);
           const unsigned int *indices =
-            &level_dof_indices[to_level - 1]
-                              [parent_child_connect[to_level - 1][cell + v]
-                                   .first *
-                                 n_child_cell_dofs +
-                               shift];
-          for (unsigned int c = 0, m = 0; c < n_components; ++c)
+            &data.level_dof_indices[to_level - 1]
+                                   [parent_child_connect[to_level - 1][cell + v]
+                                        .first *
+                                      data.n_child_cell_dofs +
+                                    shift];
+          for (unsigned int c = 0, m = 0; c < data.n_components; ++c)
             {
               for (unsigned int k = 0; k < (dim > 2 ? degree_size : 1); ++k)
                 for (unsigned int j = 0; j < (dim > 1 ? degree_size : 1); ++j)
@@ -456,21 +475,21 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
 
               // apply Dirichlet boundary conditions on parent cell
               for (std::vector<unsigned short>::const_iterator i =
-                     dirichlet_indices[to_level - 1][cell + v].begin();
-                   i != dirichlet_indices[to_level - 1][cell + v].end();
+                     data.dirichlet_indices[to_level - 1][cell + v].begin();
+                   i != data.dirichlet_indices[to_level - 1][cell + v].end();
                    ++i)
                 evaluation_data[*i][v] = 0.;
             }
         }
 
-      AssertDimension(prolongation_matrix_1d.size(),
+      AssertDimension(data.prolongation_matrix_1d.size(),
                       degree_size * n_child_dofs_1d);
       // perform tensorized operation
-      if (element_is_continuous)
+      if (data.element_is_continuous)
         {
           // must go through the components backwards because we want to write
           // the output to the same array as the input
-          for (int c = n_components - 1; c >= 0; --c)
+          for (int c = data.n_components - 1; c >= 0; --c)
             internal::FEEvaluationImplBasisChange<
               internal::evaluate_general,
               internal::EvaluatorQuantity::value,
@@ -479,23 +498,24 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
               2 * degree + 1,
               VectorizedArray<Number>,
               VectorizedArray<Number>>::do_forward(1,
-                                                   prolongation_matrix_1d,
+                                                   data.prolongation_matrix_1d,
                                                    evaluation_data.begin() +
                                                      c * Utilities::fixed_power<
                                                            dim>(degree_size),
                                                    evaluation_data.begin() +
                                                      c * n_scalar_cell_dofs,
-                                                   fe_degree + 1,
-                                                   2 * fe_degree + 1);
+                                                   data.fe_degree + 1,
+                                                   2 * data.fe_degree + 1);
           weight_dofs_on_child<dim, degree, Number>(
-            &weights_on_refined[to_level - 1][(cell / vec_size) * three_to_dim],
-            n_components,
-            fe_degree,
+            &data.weights_on_refined[to_level - 1]
+                                    [(cell / vec_size) * three_to_dim],
+            data.n_components,
+            data.fe_degree,
             evaluation_data.begin());
         }
       else
         {
-          for (int c = n_components - 1; c >= 0; --c)
+          for (int c = data.n_components - 1; c >= 0; --c)
             internal::FEEvaluationImplBasisChange<
               internal::evaluate_general,
               internal::EvaluatorQuantity::value,
@@ -504,24 +524,24 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
               2 * degree + 2,
               VectorizedArray<Number>,
               VectorizedArray<Number>>::do_forward(1,
-                                                   prolongation_matrix_1d,
+                                                   data.prolongation_matrix_1d,
                                                    evaluation_data.begin() +
                                                      c * Utilities::fixed_power<
                                                            dim>(degree_size),
                                                    evaluation_data.begin() +
                                                      c * n_scalar_cell_dofs,
-                                                   fe_degree + 1,
-                                                   2 * fe_degree + 2);
+                                                   data.fe_degree + 1,
+                                                   2 * data.fe_degree + 2);
         }
 
       // write into dst vector
       const unsigned int *indices =
-        &level_dof_indices[to_level][cell * n_child_cell_dofs];
+        &data.level_dof_indices[to_level][cell * data.n_child_cell_dofs];
       for (unsigned int v = 0; v < n_lanes; ++v)
         {
-          for (unsigned int i = 0; i < n_child_cell_dofs; ++i)
+          for (unsigned int i = 0; i < data.n_child_cell_dofs; ++i)
             dst.local_element(indices[i]) += evaluation_data[i][v];
-          indices += n_child_cell_dofs;
+          indices += data.n_child_cell_dofs;
         }
     }
 }
@@ -533,12 +553,14 @@ template <int degree>
 void
 MGTransferMatrixFree<dim, Number>::do_restrict_add(
   const unsigned int                                from_level,
+  const BaseElementData &                           data,
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
 {
-  const unsigned int vec_size        = VectorizedArray<Number>::size();
-  const unsigned int degree_size     = (degree > -1 ? degree : fe_degree) + 1;
-  const unsigned int n_child_dofs_1d = 2 * degree_size - element_is_continuous;
+  const unsigned int vec_size    = VectorizedArray<Number>::size();
+  const unsigned int degree_size = (degree > -1 ? degree : data.fe_degree) + 1;
+  const unsigned int n_child_dofs_1d =
+    2 * degree_size - data.element_is_continuous;
   const unsigned int n_scalar_cell_dofs =
     Utilities::fixed_power<dim>(n_child_dofs_1d);
   constexpr unsigned int three_to_dim = Utilities::pow(3, dim);
@@ -554,27 +576,27 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
       // read from source vector
       {
         const unsigned int *indices =
-          &level_dof_indices[from_level][cell * n_child_cell_dofs];
+          &data.level_dof_indices[from_level][cell * data.n_child_cell_dofs];
         for (unsigned int v = 0; v < n_lanes; ++v)
           {
-            for (unsigned int i = 0; i < n_child_cell_dofs; ++i)
+            for (unsigned int i = 0; i < data.n_child_cell_dofs; ++i)
               evaluation_data[i][v] = src.local_element(indices[i]);
-            indices += n_child_cell_dofs;
+            indices += data.n_child_cell_dofs;
           }
       }
 
-      AssertDimension(prolongation_matrix_1d.size(),
+      AssertDimension(data.prolongation_matrix_1d.size(),
                       degree_size * n_child_dofs_1d);
       // perform tensorized operation
-      if (element_is_continuous)
+      if (data.element_is_continuous)
         {
           weight_dofs_on_child<dim, degree, Number>(
-            &weights_on_refined[from_level - 1]
-                               [(cell / vec_size) * three_to_dim],
-            n_components,
-            fe_degree,
+            &data.weights_on_refined[from_level - 1]
+                                    [(cell / vec_size) * three_to_dim],
+            data.n_components,
+            data.fe_degree,
             evaluation_data.data());
-          for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int c = 0; c < data.n_components; ++c)
             internal::FEEvaluationImplBasisChange<
               internal::evaluate_general,
               internal::EvaluatorQuantity::value,
@@ -583,7 +605,7 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
               2 * degree + 1,
               VectorizedArray<Number>,
               VectorizedArray<Number>>::do_backward(1,
-                                                    prolongation_matrix_1d,
+                                                    data.prolongation_matrix_1d,
                                                     false,
                                                     evaluation_data.begin() +
                                                       c * n_scalar_cell_dofs,
@@ -591,12 +613,12 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
                                                       c *
                                                         Utilities::fixed_power<
                                                           dim>(degree_size),
-                                                    fe_degree + 1,
-                                                    2 * fe_degree + 1);
+                                                    data.fe_degree + 1,
+                                                    2 * data.fe_degree + 1);
         }
       else
         {
-          for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int c = 0; c < data.n_components; ++c)
             internal::FEEvaluationImplBasisChange<
               internal::evaluate_general,
               internal::EvaluatorQuantity::value,
@@ -605,7 +627,7 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
               2 * degree + 2,
               VectorizedArray<Number>,
               VectorizedArray<Number>>::do_backward(1,
-                                                    prolongation_matrix_1d,
+                                                    data.prolongation_matrix_1d,
                                                     false,
                                                     evaluation_data.begin() +
                                                       c * n_scalar_cell_dofs,
@@ -613,8 +635,8 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
                                                       c *
                                                         Utilities::fixed_power<
                                                           dim>(degree_size),
-                                                    fe_degree + 1,
-                                                    2 * fe_degree + 2);
+                                                    data.fe_degree + 1,
+                                                    2 * data.fe_degree + 2);
         }
 
       // write into dst vector
@@ -623,25 +645,25 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
           const unsigned int shift =
             internal::MGTransfer::compute_shift_within_children<dim>(
               parent_child_connect[from_level - 1][cell + v].second,
-              fe_degree + 1 - element_is_continuous,
-              fe_degree);
+              data.fe_degree + 1 - data.element_is_continuous,
+              data.fe_degree);
           AssertIndexRange(
             parent_child_connect[from_level - 1][cell + v].first *
-                n_child_cell_dofs +
-              n_child_cell_dofs - 1,
-            level_dof_indices[from_level - 1].size());
+                data.n_child_cell_dofs +
+              data.n_child_cell_dofs - 1,
+            data.level_dof_indices[from_level - 1].size());
           const unsigned int *indices =
-            &level_dof_indices[from_level - 1]
-                              [parent_child_connect[from_level - 1][cell + v]
-                                   .first *
-                                 n_child_cell_dofs +
-                               shift];
-          for (unsigned int c = 0, m = 0; c < n_components; ++c)
+            &data.level_dof_indices
+               [from_level - 1]
+               [parent_child_connect[from_level - 1][cell + v].first *
+                  data.n_child_cell_dofs +
+                shift];
+          for (unsigned int c = 0, m = 0; c < data.n_components; ++c)
             {
               // apply Dirichlet boundary conditions on parent cell
               for (std::vector<unsigned short>::const_iterator i =
-                     dirichlet_indices[from_level - 1][cell + v].begin();
-                   i != dirichlet_indices[from_level - 1][cell + v].end();
+                     data.dirichlet_indices[from_level - 1][cell + v].begin();
+                   i != data.dirichlet_indices[from_level - 1][cell + v].end();
                    ++i)
                 evaluation_data[*i][v] = 0.;
 
@@ -666,11 +688,23 @@ MGTransferMatrixFree<dim, Number>::memory_consumption() const
 {
   std::size_t memory = MGLevelGlobalTransfer<
     LinearAlgebra::distributed::Vector<Number>>::memory_consumption();
-  memory += MemoryConsumption::memory_consumption(level_dof_indices);
+  for (const BaseElementData &data : base_element_data)
+    memory += data.memory_consumption();
   memory += MemoryConsumption::memory_consumption(parent_child_connect);
   memory += MemoryConsumption::memory_consumption(n_owned_level_cells);
-  memory += MemoryConsumption::memory_consumption(prolongation_matrix_1d);
   memory += MemoryConsumption::memory_consumption(evaluation_data);
+  return memory;
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+MGTransferMatrixFree<dim, Number>::BaseElementData::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this);
+  memory += MemoryConsumption::memory_consumption(level_dof_indices);
+  memory += MemoryConsumption::memory_consumption(prolongation_matrix_1d);
   memory += MemoryConsumption::memory_consumption(weights_on_refined);
   memory += MemoryConsumption::memory_consumption(dirichlet_indices);
   return memory;
@@ -15,7 +15,9 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -164,6 +166,47 @@ namespace NonMatching
           gtl1[i] = j++;
       return {gtl0, gtl1};
     }
+
+
+
+    /**
+     * Scratch object for the parallel assembly of the coupling mass matrix:
+     * the FEValues object on the cells of the immersed triangulation.
+     */
+    template <int dim1, int spacedim>
+    struct CouplingMassMatrixScratch
+    {
+      CouplingMassMatrixScratch(const Mapping<dim1, spacedim> &      mapping,
+                                const FiniteElement<dim1, spacedim> &fe,
+                                const Quadrature<dim1> &             quad,
+                                const UpdateFlags update_flags)
+        : fe_values(mapping, fe, quad, update_flags)
+      {}
+
+      CouplingMassMatrixScratch(const CouplingMassMatrixScratch &scratch)
+        : fe_values(scratch.fe_values.get_mapping(),
+                    scratch.fe_values.get_fe(),
+                    scratch.fe_values.get_quadrature(),
+                    scratch.fe_values.get_update_flags())
+      {}
+
+      FEValues<dim1, spacedim> fe_values;
+    };
+
+
+
+    /**
+     * Copy object for the parallel assembly of the coupling mass matrix: the
+     * local matrices of one cell of the immersed triangulation with all the
+     * locally owned cells of the embedding triangulation it overlaps.
+     */
+    template <typename Number>
+    struct CouplingMassMatrixCopy
+    {
+      std::vector<types::global_dof_index>              dofs;
+      std::vector<std::vector<types::global_dof_index>> space_dofs;
+      std::vector<FullMatrix<Number>>                   cell_matrices;
+    };
   } // namespace internal
 
   template <int dim0,
@@ -415,10 +458,6 @@ namespace NonMatching
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.n_dofs_per_cell());
-    std::vector<types::global_dof_index> odofs(space_fe.n_dofs_per_cell());
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -445,15 +484,22 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    FullMatrix<typename Matrix::value_type> cell_matrix(
-      space_dh.get_fe().n_dofs_per_cell(),
-      immersed_dh.get_fe().n_dofs_per_cell());
-
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_dh.get_fe(),
-                                  quad,
-                                  update_JxW_values | update_quadrature_points |
-                                    update_values);
+    // The coupling between shape functions only depends on their
+    // components, so compute it once instead of for every pair of cells
+    const unsigned int n_space_dofs    = space_fe.n_dofs_per_cell();
+    const unsigned int n_immersed_dofs = immersed_fe.n_dofs_per_cell();
+    Table<2, bool>     couples(n_space_dofs, n_immersed_dofs);
+    for (unsigned int i = 0; i < n_space_dofs; ++i)
+      {
+        const auto comp_i = space_fe.system_to_component_index(i).first;
+        for (unsigned int j = 0; j < n_immersed_dofs; ++j)
+          {
+            const auto comp_j = immersed_fe.system_to_component_index(j).first;
+            couples(i, j) =
+              (space_gtl[comp_i] != numbers::invalid_unsigned_int &&
+               space_gtl[comp_i] == immersed_gtl[comp_j]);
+          }
+      }
 
     const unsigned int n_q_points = quad.size();
     const unsigned int n_active_c =
@@ -541,20 +587,32 @@ namespace NonMatching
           }
       }
 
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
+    using number = typename Matrix::value_type;
 
-    for (unsigned int j = 0; cell != endc; ++cell, ++j)
-      {
-        // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
-        cell->get_dof_indices(dofs);
+    // Compute the local matrices of the cells of the immersed triangulation
+    // in parallel. The cells are numbered as in the loops above, i.e., by
+    // their active cell index.
+    const auto worker =
+      [&](const typename DoFHandler<dim1, spacedim>::active_cell_iterator &cell,
+          internal::CouplingMassMatrixScratch<dim1, spacedim> &scratch,
+          internal::CouplingMassMatrixCopy<number> &           copy) {
+        copy.space_dofs.clear();
+        copy.cell_matrices.clear();
 
         // Get a list of outer cells, qpoints and maps.
-        const auto &cells   = cell_container[j];
-        const auto &qpoints = qpoints_container[j];
-        const auto &maps    = maps_container[j];
+        const unsigned int cell_index = cell->active_cell_index();
+        const auto &       cells      = cell_container[cell_index];
+        const auto &       qpoints    = qpoints_container[cell_index];
+        const auto &       maps       = maps_container[cell_index];
+
+        if (cells.empty())
+          return;
+
+        // Reinitialize the cell and the fe_values
+        const FEValues<dim1, spacedim> &fe_v = scratch.fe_values;
+        scratch.fe_values.reinit(cell);
+        copy.dofs.resize(n_immersed_dofs);
+        cell->get_dof_indices(copy.dofs);
 
         for (unsigned int c = 0; c < cells.size(); ++c)
           {
@@ -568,52 +626,56 @@ namespace NonMatching
                 const std::vector<unsigned int> &ids = maps[c];
 
                 FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
-                                                space_dh.get_fe(),
+                                                space_fe,
                                                 qps,
                                                 update_values);
                 o_fe_v.reinit(ocell);
-                ocell->get_dof_indices(odofs);
 
-                // Reset the matrices.
-                cell_matrix = typename Matrix::value_type();
+                copy.space_dofs.emplace_back(n_space_dofs);
+                ocell->get_dof_indices(copy.space_dofs.back());
 
-                for (unsigned int i = 0;
-                     i < space_dh.get_fe().n_dofs_per_cell();
-                     ++i)
-                  {
-                    const auto comp_i =
-                      space_dh.get_fe().system_to_component_index(i).first;
-                    if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
-                      for (unsigned int j = 0;
-                           j < immersed_dh.get_fe().n_dofs_per_cell();
-                           ++j)
+                copy.cell_matrices.emplace_back(n_space_dofs, n_immersed_dofs);
+                FullMatrix<number> &cell_matrix = copy.cell_matrices.back();
+
+                for (unsigned int i = 0; i < n_space_dofs; ++i)
+                  for (unsigned int j = 0; j < n_immersed_dofs; ++j)
+                    if (couples(i, j))
+                      for (unsigned int oq = 0;
+                           oq < o_fe_v.n_quadrature_points;
+                           ++oq)
                         {
-                          const auto comp_j = immersed_dh.get_fe()
-                                                .system_to_component_index(j)
-                                                .first;
-                          if (space_gtl[comp_i] == immersed_gtl[comp_j])
-                            for (unsigned int oq = 0;
-                                 oq < o_fe_v.n_quadrature_points;
-                                 ++oq)
-                              {
-                                // Get the corresponding q point
-                                const unsigned int q = ids[oq];
-
-                                cell_matrix(i, j) +=
-                                  (fe_v.shape_value(j, q) *
-                                   o_fe_v.shape_value(i, oq) * fe_v.JxW(q));
-                              }
-                        }
-                  }
+                          // Get the corresponding q point
+                          const unsigned int q = ids[oq];
 
-                // Now assemble the matrices
-                constraints.distribute_local_to_global(cell_matrix,
-                                                       odofs,
-                                                       dofs,
-                                                       matrix);
+                          cell_matrix(i, j) +=
+                            (fe_v.shape_value(j, q) *
+                             o_fe_v.shape_value(i, oq) * fe_v.JxW(q));
+                        }
               }
           }
-      }
+      };
+
+    // Now assemble the matrices
+    const auto copier =
+      [&](const internal::CouplingMassMatrixCopy<number> &copy) {
+        for (unsigned int c = 0; c < copy.cell_matrices.size(); ++c)
+          constraints.distribute_local_to_global(copy.cell_matrices[c],
+                                                 copy.space_dofs[c],
+                                                 copy.dofs,
+                                                 matrix);
+      };
+
+    WorkStream::run(immersed_dh.begin_active(),
+                    immersed_dh.end(),
+                    worker,
+                    copier,
+                    internal::CouplingMassMatrixScratch<dim1, spacedim>(
+                      immersed_mapping,
+                      immersed_fe,
+                      quad,
+                      update_JxW_values | update_quadrature_points |
+                        update_values),
+                    internal::CouplingMassMatrixCopy<number>());
   }
 
   template <int dim0,
@@ -0,0 +1,585 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/non_matching/quadrature_generator.h>
+
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+namespace NonMatching
+{
+  namespace
+  {
+    /**
+     * The level set function of a cell on the reference cell, i.e., the
+     * expansion of the local values of the level set function in the shape
+     * functions of the finite element.
+     */
+    template <int dim>
+    class RefSpaceFEFieldFunction : public Function<dim>
+    {
+    public:
+      RefSpaceFEFieldFunction(const FiniteElement<dim> & fe,
+                              const std::vector<double> &local_values)
+        : fe(fe)
+        , local_values(local_values)
+      {
+        AssertDimension(local_values.size(), fe.n_dofs_per_cell());
+      }
+
+      double
+      value(const Point<dim> & point,
+            const unsigned int component = 0) const override
+      {
+        AssertIndexRange(component, 1);
+        (void)component;
+
+        double value = 0.;
+        for (unsigned int i = 0; i < local_values.size(); ++i)
+          value += local_values[i] * fe.shape_value(i, point);
+        return value;
+      }
+
+      Tensor<1, dim>
+      gradient(const Point<dim> & point,
+               const unsigned int component = 0) const override
+      {
+        AssertIndexRange(component, 1);
+        (void)component;
+
+        Tensor<1, dim> gradient;
+        for (unsigned int i = 0; i < local_values.size(); ++i)
+          gradient += local_values[i] * fe.shape_grad(i, point);
+        return gradient;
+      }
+
+    private:
+      const FiniteElement<dim> & fe;
+      const std::vector<double> &local_values;
+    };
+  } // namespace
+
+
+
+  template <int dim>
+  QuadratureGenerator<dim>::AdditionalData::AdditionalData(
+    const unsigned int max_box_splits,
+    const double       root_tolerance,
+    const unsigned int max_root_iterations)
+    : max_box_splits(max_box_splits)
+    , root_tolerance(root_tolerance)
+    , max_root_iterations(max_root_iterations)
+  {}
+
+
+
+  template <int dim>
+  QuadratureGenerator<dim>::QuadratureGenerator(
+    const Quadrature<1> & quadrature_1D,
+    const AdditionalData &additional_data)
+    : quadrature_1D(quadrature_1D)
+    , additional_data(additional_data)
+  {
+    Assert(quadrature_1D.size() > 0,
+           ExcMessage("The one-dimensional quadrature formula must not be "
+                      "empty."));
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureGenerator<dim>::generate(const Function<dim> &   level_set,
+                                     const BoundingBox<dim> &box)
+  {
+    AssertDimension(level_set.n_components, 1);
+
+    inside_points.clear();
+    inside_weights.clear();
+    outside_points.clear();
+    outside_weights.clear();
+    surface_points.clear();
+    surface_weights.clear();
+    surface_normals.clear();
+
+    generate_on_box(level_set, box, 0);
+
+    inside_quadrature  = Quadrature<dim>(inside_points, inside_weights);
+    outside_quadrature = Quadrature<dim>(outside_points, outside_weights);
+    surface_quadrature = ImmersedSurfaceQuadrature<dim>(surface_points,
+                                                        surface_weights,
+                                                        surface_normals);
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  QuadratureGenerator<dim>::get_inside_quadrature() const
+  {
+    return inside_quadrature;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  QuadratureGenerator<dim>::get_outside_quadrature() const
+  {
+    return outside_quadrature;
+  }
+
+
+
+  template <int dim>
+  const ImmersedSurfaceQuadrature<dim> &
+  QuadratureGenerator<dim>::get_surface_quadrature() const
+  {
+    return surface_quadrature;
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureGenerator<dim>::generate_on_box(const Function<dim> &   level_set,
+                                            const BoundingBox<dim> &box,
+                                            const unsigned int      n_splits)
+  {
+    // Sample the level set function on a grid that is somewhat finer than
+    // the one-dimensional quadrature formula, including the boundary of the
+    // box
+    const unsigned int n_samples_1D = quadrature_1D.size() + 1;
+    const unsigned int n_samples = Utilities::fixed_power<dim>(n_samples_1D);
+
+    std::vector<Point<dim>> sample_points(n_samples);
+    bool                    has_negative_values = false;
+    bool                    has_positive_values = false;
+    for (unsigned int i = 0; i < n_samples; ++i)
+      {
+        unsigned int index = i;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            sample_points[i][d] = box.lower_bound(d) +
+                                  box.side_length(d) * (index % n_samples_1D) /
+                                    (n_samples_1D - 1);
+            index /= n_samples_1D;
+          }
+
+        const double value = level_set.value(sample_points[i]);
+        if (value <= 0.)
+          has_negative_values = true;
+        if (value >= 0.)
+          has_positive_values = true;
+      }
+
+    if (!has_negative_values)
+      {
+        add_tensor_product_points(box, outside_points, outside_weights);
+        return;
+      }
+    if (!has_positive_values)
+      {
+        add_tensor_product_points(box, inside_points, inside_weights);
+        return;
+      }
+
+    // Choose the direction of the largest derivative as height direction and
+    // check whether the zero contour is a graph over the other directions,
+    // i.e., whether the derivative in the height direction does not change
+    // its sign
+    const Tensor<1, dim> center_gradient = level_set.gradient(box.center());
+
+    unsigned int height_direction = 0;
+    for (unsigned int d = 1; d < dim; ++d)
+      if (std::abs(center_gradient[d]) >
+          std::abs(center_gradient[height_direction]))
+        height_direction = d;
+
+    bool is_graph = (center_gradient[height_direction] != 0.);
+    for (unsigned int i = 0; i < n_samples && is_graph; ++i)
+      if (level_set.gradient(sample_points[i])[height_direction] *
+            center_gradient[height_direction] <=
+          0.)
+        is_graph = false;
+
+    if (is_graph || n_splits >= additional_data.max_box_splits)
+      {
+        generate_on_graph_box(level_set, box, height_direction);
+        return;
+      }
+
+    // Otherwise, split the box and treat its parts recursively
+    for (unsigned int child = 0; child < (1U << dim); ++child)
+      {
+        Point<dim> lower;
+        Point<dim> upper;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const double midpoint =
+              0.5 * (box.lower_bound(d) + box.upper_bound(d));
+            lower[d] = (child & (1U << d)) ? midpoint : box.lower_bound(d);
+            upper[d] = (child & (1U << d)) ? box.upper_bound(d) : midpoint;
+          }
+        generate_on_box(level_set,
+                        BoundingBox<dim>(std::make_pair(lower, upper)),
+                        n_splits + 1);
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureGenerator<dim>::generate_on_graph_box(
+    const Function<dim> &   level_set,
+    const BoundingBox<dim> &box,
+    const unsigned int      height_direction)
+  {
+    const unsigned int n_q_points_1D = quadrature_1D.size();
+    const unsigned int n_lines =
+      Utilities::fixed_power<dim - 1>(n_q_points_1D);
+
+    const double lower = box.lower_bound(height_direction);
+    const double upper = box.upper_bound(height_direction);
+
+    std::vector<double> roots;
+    for (unsigned int i = 0; i < n_lines; ++i)
+      {
+        // The point and weight of the tensor product formula in the
+        // directions other than the height direction
+        Point<dim>   point;
+        double       weight = 1.;
+        unsigned int index  = i;
+        for (unsigned int d = 0; d < dim; ++d)
+          if (d != height_direction)
+            {
+              const unsigned int q = index % n_q_points_1D;
+              index /= n_q_points_1D;
+
+              point[d] = box.lower_bound(d) +
+                         box.side_length(d) * quadrature_1D.point(q)[0];
+              weight *= box.side_length(d) * quadrature_1D.weight(q);
+            }
+
+        find_roots(level_set, point, height_direction, lower, upper, roots);
+
+        // Use the one-dimensional formula on each of the intervals between
+        // the roots, which are either entirely inside or outside
+        double start = lower;
+        for (unsigned int r = 0; r <= roots.size(); ++r)
+          {
+            const double end = (r < roots.size() ? roots[r] : upper);
+            if (end > start)
+              {
+                point[height_direction] = 0.5 * (start + end);
+                const bool is_inside    = (level_set.value(point) < 0.);
+
+                std::vector<Point<dim>> &points =
+                  (is_inside ? inside_points : outside_points);
+                std::vector<double> &weights =
+                  (is_inside ? inside_weights : outside_weights);
+                for (unsigned int q = 0; q < n_q_points_1D; ++q)
+                  {
+                    point[height_direction] =
+                      start + (end - start) * quadrature_1D.point(q)[0];
+                    points.push_back(point);
+                    weights.push_back(weight * (end - start) *
+                                      quadrature_1D.weight(q));
+                  }
+              }
+            start = end;
+          }
+
+        // The roots are the points of the surface formula, where the surface
+        // element is the one of the graph over the other directions
+        for (const double root : roots)
+          {
+            point[height_direction]       = root;
+            const Tensor<1, dim> gradient = level_set.gradient(point);
+            const double         norm     = gradient.norm();
+            if (norm > 0. && gradient[height_direction] != 0.)
+              {
+                surface_points.push_back(point);
+                surface_weights.push_back(
+                  weight * norm / std::abs(gradient[height_direction]));
+                surface_normals.push_back(gradient / norm);
+              }
+          }
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureGenerator<dim>::add_tensor_product_points(
+    const BoundingBox<dim> & box,
+    std::vector<Point<dim>> &points,
+    std::vector<double> &    weights) const
+  {
+    const unsigned int n_q_points_1D = quadrature_1D.size();
+    const unsigned int n_q_points = Utilities::fixed_power<dim>(n_q_points_1D);
+
+    for (unsigned int i = 0; i < n_q_points; ++i)
+      {
+        Point<dim>   point;
+        double       weight = 1.;
+        unsigned int index  = i;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const unsigned int q = index % n_q_points_1D;
+            index /= n_q_points_1D;
+
+            point[d] = box.lower_bound(d) +
+                       box.side_length(d) * quadrature_1D.point(q)[0];
+            weight *= box.side_length(d) * quadrature_1D.weight(q);
+          }
+        points.push_back(point);
+        weights.push_back(weight);
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  QuadratureGenerator<dim>::find_roots(const Function<dim> &level_set,
+                                       const Point<dim> &   point,
+                                       const unsigned int   height_direction,
+                                       const double         lower,
+                                       const double         upper,
+                                       std::vector<double> &roots) const
+  {
+    roots.clear();
+
+    const double tolerance = additional_data.root_tolerance * (upper - lower);
+    Point<dim>   x         = point;
+
+    // Bracket the roots by sampling the line with the same number of points
+    // as used for the sign test of the box
+    const unsigned int n_samples = quadrature_1D.size() + 1;
+
+    x[height_direction] = lower;
+    double t0           = lower;
+    double value0       = level_set.value(x);
+    for (unsigned int k = 1; k < n_samples; ++k)
+      {
+        const double t1 = lower + (upper - lower) * k / (n_samples - 1);
+        x[height_direction] = t1;
+        const double value1 = level_set.value(x);
+
+        if (value1 == 0. && k < n_samples - 1)
+          roots.push_back(t1);
+        else if (value0 * value1 < 0.)
+          {
+            // Refine the bracket with the Illinois variant of the regula
+            // falsi method
+            double       a = t0, value_a = value0;
+            double       b = t1, value_b = value1;
+            double       t    = a;
+            int          side = 0;
+            unsigned int iteration = 0;
+            for (; iteration < additional_data.max_root_iterations; ++iteration)
+              {
+                t = (a * value_b - b * value_a) / (value_b - value_a);
+                if (b - a < tolerance)
+                  break;
+
+                x[height_direction] = t;
+                const double value  = level_set.value(x);
+                if (value * value_b > 0.)
+                  {
+                    b       = t;
+                    value_b = value;
+                    if (side == -1)
+                      value_a *= 0.5;
+                    side = -1;
+                  }
+                else if (value * value_a > 0.)
+                  {
+                    a       = t;
+                    value_a = value;
+                    if (side == 1)
+                      value_b *= 0.5;
+                    side = 1;
+                  }
+                else
+                  break;
+              }
+            roots.push_back(t);
+          }
+
+        t0     = t1;
+        value0 = value1;
+      }
+  }
+
+
+
+  template <int dim>
+  DiscreteQuadratureGenerator<dim>::DiscreteQuadratureGenerator(
+    const Quadrature<1> & quadrature_1D,
+    const AdditionalData &additional_data)
+    : quadrature_1D(quadrature_1D)
+    , additional_data(additional_data)
+  {}
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::generate(
+    const typename Triangulation<dim>::active_cell_iterator &cell)
+  {
+    AssertIndexRange(cell->active_cell_index(), is_generated.size());
+    if (is_generated[cell->active_cell_index()] != 0)
+      return;
+
+    QuadratureGenerator<dim> generator(quadrature_1D, additional_data);
+    generate_cell(cell->active_cell_index(), generator);
+  }
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::update_quadratures()
+  {
+    // Every cell writes its own entries only, so the cells can be treated
+    // concurrently, with one generator per subrange
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(is_generated.size()),
+      [this](const unsigned int begin, const unsigned int end) {
+        QuadratureGenerator<dim> generator(quadrature_1D, additional_data);
+        for (unsigned int c = begin; c < end; ++c)
+          if (is_generated[c] == 0 && !local_level_set_values[c].empty())
+            generate_cell(c, generator);
+      },
+      16);
+  }
+
+
+
+  template <int dim>
+  void
+  DiscreteQuadratureGenerator<dim>::generate_cell(
+    const unsigned int        active_cell_index,
+    QuadratureGenerator<dim> &generator)
+  {
+    Assert(!local_level_set_values[active_cell_index].empty(),
+           ExcMessage("The level set function is not available on this "
+                      "cell. Is it artificial?"));
+
+    const RefSpaceFEFieldFunction<dim> level_set(
+      *fe, local_level_set_values[active_cell_index]);
+
+    Point<dim> unit_point;
+    for (unsigned int d = 0; d < dim; ++d)
+      unit_point[d] = 1.;
+    const BoundingBox<dim> unit_box(std::make_pair(Point<dim>(), unit_point));
+    generator.generate(level_set, unit_box);
+
+    CellQuadratures &quadratures = cell_quadratures[active_cell_index];
+    quadratures.inside           = generator.get_inside_quadrature();
+    quadratures.outside          = generator.get_outside_quadrature();
+    quadratures.surface          = generator.get_surface_quadrature();
+
+    is_generated[active_cell_index] = 1;
+  }
+
+
+
+  template <int dim>
+  const typename DiscreteQuadratureGenerator<dim>::CellQuadratures &
+  DiscreteQuadratureGenerator<dim>::get_cell_quadratures(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    AssertIndexRange(cell->active_cell_index(), is_generated.size());
+    Assert(is_generated[cell->active_cell_index()] != 0,
+           ExcMessage("The quadrature formulas of this cell have not been "
+                      "computed yet. Call generate() or update_quadratures() "
+                      "first."));
+
+    return cell_quadratures[cell->active_cell_index()];
+  }
+
+
+
+  template <int dim>
+  LocationToLevelSet
+  DiscreteQuadratureGenerator<dim>::location_to_level_set(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    const CellQuadratures &quadratures = get_cell_quadratures(cell);
+
+    if (quadratures.surface.size() > 0 ||
+        (quadratures.inside.size() > 0 && quadratures.outside.size() > 0))
+      return LocationToLevelSet::intersected;
+    else if (quadratures.inside.size() > 0)
+      return LocationToLevelSet::inside;
+    else
+      return LocationToLevelSet::outside;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_inside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    return get_cell_quadratures(cell).inside;
+  }
+
+
+
+  template <int dim>
+  const Quadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_outside_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    return get_cell_quadratures(cell).outside;
+  }
+
+
+
+  template <int dim>
+  const ImmersedSurfaceQuadrature<dim> &
+  DiscreteQuadratureGenerator<dim>::get_surface_quadrature(
+    const typename Triangulation<dim>::active_cell_iterator &cell) const
+  {
+    return get_cell_quadratures(cell).surface;
+  }
+
+
+
+  template class QuadratureGenerator<1>;
+  template class QuadratureGenerator<2>;
+  template class QuadratureGenerator<3>;
+
+  template class DiscreteQuadratureGenerator<1>;
+  template class DiscreteQuadratureGenerator<2>;
+  template class DiscreteQuadratureGenerator<3>;
+
+} // namespace NonMatching
+DEAL_II_NAMESPACE_CLOSE
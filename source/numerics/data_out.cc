@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/memory_tracker.h>
 #include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
@@ -31,6 +32,7 @@
 
 #include <deal.II/numerics/data_out.h>
 
+#include <algorithm>
 #include <sstream>
 
 DEAL_II_NAMESPACE_OPEN
@@ -91,8 +93,13 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                                                 DoFHandlerType::space_dimension>
     &                    scratch_data,
   const unsigned int     n_subdivisions,
-  const CurvedCellRegion curved_cell_region)
+  const CurvedCellRegion curved_cell_region,
+  const unsigned int     first_patch_index)
 {
+  // attribute the memory of the patch to DataOut, also when running on a
+  // worker thread
+  MemoryTracker::Scope memory_scope(MemoryTracker::data_out);
+
   // first create the output object that we will write into
   ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
                                DoFHandlerType::space_dimension>
@@ -203,6 +210,8 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
               // have to be updated
               const UpdateFlags update_flags =
                 postprocessor->get_needed_update_flags();
+              const bool use_batched_evaluation =
+                postprocessor->supports_batched_evaluation();
 
               if ((n_components == 1) &&
                   (dataset->is_complex_valued() == false))
@@ -249,10 +258,15 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                     dh_cell);
 
                   // Finally call the postprocessor's function that
-                  // deals with scalar inputs.
-                  postprocessor->evaluate_scalar_field(
-                    scratch_data.patch_values_scalar,
-                    scratch_data.postprocessed_values[dataset_number]);
+                  // deals with scalar inputs, or collect the inputs for the
+                  // batched evaluation below
+                  if (use_batched_evaluation)
+                    scratch_data.patch_values_batch.copy_from(
+                      scratch_data.patch_values_scalar, update_flags);
+                  else
+                    postprocessor->evaluate_scalar_field(
+                      scratch_data.patch_values_scalar,
+                      scratch_data.postprocessed_values[dataset_number]);
                 }
               else
                 {
@@ -676,21 +690,43 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                   // complex-vector-valued doesn't matter -- we took it apart
                   // into several fields and so we have to call the
                   // evaluate_vector_field() function.
-                  postprocessor->evaluate_vector_field(
-                    scratch_data.patch_values_system,
-                    scratch_data.postprocessed_values[dataset_number]);
+                  if (use_batched_evaluation)
+                    scratch_data.patch_values_batch.copy_from(
+                      scratch_data.patch_values_system, update_flags);
+                  else
+                    postprocessor->evaluate_vector_field(
+                      scratch_data.patch_values_system,
+                      scratch_data.postprocessed_values[dataset_number]);
                 }
 
               // Now we need to copy the result of the postprocessor to
               // the Patch object where it can then be further processed
-              // by the functions in DataOutBase
-              for (unsigned int q = 0; q < n_q_points; ++q)
-                for (unsigned int component = 0;
-                     component < dataset->n_output_variables;
-                     ++component)
-                  patch.data(offset + component, q) =
-                    scratch_data.postprocessed_values[dataset_number][q](
-                      component);
+              // by the functions in DataOutBase. The batched interface
+              // returns the results in the same layout as the Patch object
+              // stores them, one row of points per output variable
+              if (use_batched_evaluation)
+                {
+                  scratch_data.postprocessed_values_batch.reinit(
+                    dataset->n_output_variables, n_q_points);
+                  postprocessor->evaluate_vector_field_batch(
+                    scratch_data.patch_values_batch,
+                    scratch_data.postprocessed_values_batch);
+
+                  for (unsigned int component = 0;
+                       component < dataset->n_output_variables;
+                       ++component)
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      patch.data(offset + component, q) =
+                        scratch_data.postprocessed_values_batch(component, q);
+                }
+              else
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  for (unsigned int component = 0;
+                       component < dataset->n_output_variables;
+                       ++component)
+                    patch.data(offset + component, q) =
+                      scratch_data.postprocessed_values[dataset_number][q](
+                        component);
 
               // Move the counter for the output location forward as
               // appropriate
@@ -1059,15 +1095,27 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
         }
 
       // now, there is a neighbor, so get its patch number and set it for the
-      // neighbor index
-      patch.neighbors[f] =
+      // neighbor index. patches are numbered within the chunk we are
+      // currently building, so neighbors in other chunks do not exist
+      const unsigned int neighbor_patch_idx =
         (*scratch_data
             .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
+      if ((neighbor_patch_idx < first_patch_index) ||
+          (neighbor_patch_idx - first_patch_index >= this->patches.size()))
+        patch.neighbors[f] = numbers::invalid_unsigned_int;
+      else
+        patch.neighbors[f] = neighbor_patch_idx - first_patch_index;
     }
 
+  Assert(
+    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
+                                           [cell_and_index->first->index()] >=
+      first_patch_index,
+    ExcInternalError());
   const unsigned int patch_idx =
     (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
+                                           [cell_and_index->first->index()] -
+    first_patch_index;
   // did we mess up the indices?
   Assert(patch_idx < this->patches.size(), ExcInternalError());
   patch.patch_index = patch_idx;
@@ -1121,6 +1169,53 @@ DataOut<dim, DoFHandlerType>::build_patches(
   const unsigned int                                            n_subdivisions_,
   const CurvedCellRegion                                        curved_region)
 {
+  // build all patches as one single chunk. without a sink, the patches of
+  // this chunk stay in place for the write functions of the base class
+  build_patches_in_chunks(mapping,
+                          n_subdivisions_,
+                          numbers::invalid_unsigned_int,
+                          std::function<void(const unsigned int)>(),
+                          curved_region);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patches_in_chunks(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &                                            mapping,
+  const unsigned int                             n_subdivisions_,
+  const unsigned int                             max_patches_per_chunk,
+  const std::function<void(const unsigned int)> &patch_sink,
+  const CurvedCellRegion                         curved_region)
+{
+  hp::MappingCollection<DoFHandlerType::dimension,
+                        DoFHandlerType::space_dimension>
+    mapping_collection(mapping);
+
+  build_patches_in_chunks(mapping_collection,
+                          n_subdivisions_,
+                          max_patches_per_chunk,
+                          patch_sink,
+                          curved_region);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patches_in_chunks(
+  const hp::MappingCollection<DoFHandlerType::dimension,
+                              DoFHandlerType::space_dimension> &mapping,
+  const unsigned int                                            n_subdivisions_,
+  const unsigned int                             max_patches_per_chunk,
+  const std::function<void(const unsigned int)> &patch_sink,
+  const CurvedCellRegion                         curved_region)
+{
+  Assert(max_patches_per_chunk > 0,
+         ExcMessage("Each chunk needs to contain at least one patch."));
+
   // Check consistency of redundant template parameter
   Assert(dim == DoFHandlerType::dimension,
          ExcDimensionMismatch(dim, DoFHandlerType::dimension));
@@ -1211,7 +1306,6 @@ DataOut<dim, DoFHandlerType>::build_patches(
   }
 
   this->patches.clear();
-  this->patches.resize(all_cells.size());
 
   // Now create a default object for the WorkStream object to work with. The
   // first step is to count how many output data sets there will be. This is,
@@ -1269,7 +1363,10 @@ DataOut<dim, DoFHandlerType>::build_patches(
                 update_flags,
                 cell_to_patch_index_map);
 
-  auto worker = [this, n_subdivisions, curved_cell_region](
+  // the patch index of the first cell of the chunk we are currently working on
+  unsigned int first_patch_index = 0;
+
+  auto worker = [this, n_subdivisions, curved_cell_region, &first_patch_index](
                   const std::pair<cell_iterator, unsigned int> *cell_and_index,
                   internal::DataOutImplementation::ParallelData<
                     DoFHandlerType::dimension,
@@ -1280,26 +1377,46 @@ DataOut<dim, DoFHandlerType>::build_patches(
     this->build_one_patch(cell_and_index,
                           scratch_data,
                           n_subdivisions,
-                          curved_cell_region);
+                          curved_cell_region,
+                          first_patch_index);
   };
 
-  // now build the patches in parallel
-  if (all_cells.size() > 0)
-    WorkStream::run(all_cells.data(),
-                    all_cells.data() + all_cells.size(),
-                    worker,
-                    // no copy-local-to-global function needed here
-                    std::function<void(const int)>(),
-                    thread_data,
-                    /* dummy CopyData object = */ 0,
-                    // experimenting shows that we can make things run a bit
-                    // faster if we increase the number of cells we work on
-                    // per item (i.e., WorkStream's chunk_size argument,
-                    // about 10% improvement) and the items in flight at any
-                    // given time (another 5% on the testcase discussed in
-                    // @ref workstream_paper, on 32 cores) and if
-                    8 * MultithreadInfo::n_threads(),
-                    64);
+  // now build the patches in parallel, one chunk after the other. after each
+  // chunk, hand it to the sink (if any) and release its memory again
+  for (unsigned int chunk = 0; first_patch_index < all_cells.size(); ++chunk)
+    {
+      const unsigned int n_patches_in_chunk =
+        std::min<std::size_t>(max_patches_per_chunk,
+                              all_cells.size() - first_patch_index);
+
+      this->patches.resize(n_patches_in_chunk);
+
+      WorkStream::run(all_cells.data() + first_patch_index,
+                      all_cells.data() + first_patch_index + n_patches_in_chunk,
+                      worker,
+                      // no copy-local-to-global function needed here
+                      std::function<void(const int)>(),
+                      thread_data,
+                      /* dummy CopyData object = */ 0,
+                      // experimenting shows that we can make things run a bit
+                      // faster if we increase the number of cells we work on
+                      // per item (i.e., WorkStream's chunk_size argument,
+                      // about 10% improvement) and the items in flight at any
+                      // given time (another 5% on the testcase discussed in
+                      // @ref workstream_paper, on 32 cores) and if
+                      8 * MultithreadInfo::n_threads(),
+                      64);
+
+      first_patch_index += n_patches_in_chunk;
+
+      if (patch_sink)
+        {
+          patch_sink(chunk);
+
+          // use swap() to really release the memory of this chunk
+          decltype(this->patches)().swap(this->patches);
+        }
+    }
 }
 
 
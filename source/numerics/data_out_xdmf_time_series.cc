@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/numerics/data_out_xdmf_time_series.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+DataOutXDMFTimeSeries<dim, spacedim>::DataOutXDMFTimeSeries(
+  const Triangulation<dim, spacedim> &   triangulation,
+  const std::string &                    directory,
+  const std::string &                    filename_without_extension,
+  const MPI_Comm &                       comm,
+  const DataOutBase::DataOutFilterFlags &flags)
+  : triangulation(&triangulation, typeid(*this).name())
+  , directory(directory)
+  , filename_without_extension(filename_without_extension)
+  , comm(comm)
+  , flags(flags)
+  , mesh_changed(true)
+  , n_mesh_files(0)
+  , n_time_steps(0)
+  , n_mesh_nodes(0)
+  , n_mesh_cells(0)
+{
+  Assert(flags.xdmf_hdf5_output,
+         ExcMessage("The output of this class is meant to be used in an "
+                    "XDMF/HDF5 combination, so the flags need to have "
+                    "xdmf_hdf5_output set."));
+
+  tria_listeners.push_back(
+    triangulation.signals.any_change.connect([this]() { mark_mesh_changed(); }));
+  tria_listeners.push_back(triangulation.signals.mesh_movement.connect(
+    [this]() { mark_mesh_changed(); }));
+}
+
+
+
+template <int dim, int spacedim>
+DataOutXDMFTimeSeries<dim, spacedim>::~DataOutXDMFTimeSeries()
+{
+  for (auto &connection : tria_listeners)
+    connection.disconnect();
+  tria_listeners.clear();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutXDMFTimeSeries<dim, spacedim>::write_time_step(
+  const DataOutInterface<dim, spacedim> &data_out,
+  const double                           time)
+{
+  DataOutBase::DataOutFilter data_filter(flags);
+  data_out.write_filtered_data(data_filter);
+
+  // the geometry of the output can also change without the triangulation
+  // noticing, e.g. through a different number of subdivisions. at least
+  // catch the cases in which the size of the mesh changes
+  const types::global_dof_index n_nodes =
+    Utilities::MPI::sum<types::global_dof_index>(data_filter.n_nodes(), comm);
+  const types::global_dof_index n_cells =
+    Utilities::MPI::sum<types::global_dof_index>(data_filter.n_cells(), comm);
+  if ((n_nodes != n_mesh_nodes) || (n_cells != n_mesh_cells))
+    mesh_changed = true;
+
+  const bool write_mesh_file = mesh_changed;
+  if (write_mesh_file)
+    {
+      mesh_filename = filename_without_extension + "_mesh_" +
+                      Utilities::int_to_string(n_mesh_files, 4) + ".h5";
+      n_mesh_nodes = n_nodes;
+      n_mesh_cells = n_cells;
+      ++n_mesh_files;
+      mesh_changed = false;
+    }
+
+  const std::string solution_filename =
+    filename_without_extension + "_" +
+    Utilities::int_to_string(n_time_steps, 4) + ".h5";
+  ++n_time_steps;
+
+  data_out.write_hdf5_parallel(data_filter,
+                               write_mesh_file,
+                               directory + mesh_filename,
+                               directory + solution_filename,
+                               comm);
+
+  // the entries refer to the files relative to the location of the XDMF
+  // file, i.e., without the directory
+  xdmf_entries.push_back(data_out.create_xdmf_entry(
+    data_filter, mesh_filename, solution_filename, time, comm));
+  data_out.write_xdmf_file(xdmf_entries,
+                           directory + filename_without_extension + ".xdmf",
+                           comm);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutXDMFTimeSeries<dim, spacedim>::mark_mesh_changed()
+{
+  mesh_changed = true;
+}
+
+
+
+template <int dim, int spacedim>
+const std::vector<XDMFEntry> &
+DataOutXDMFTimeSeries<dim, spacedim>::get_xdmf_entries() const
+{
+  return xdmf_entries;
+}
+
+
+// explicit instantiations
+#include "data_out_xdmf_time_series.inst"
+
+DEAL_II_NAMESPACE_CLOSE
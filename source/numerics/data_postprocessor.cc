@@ -19,15 +19,139 @@ DEAL_II_NAMESPACE_OPEN
 
 
 
+// -------------------------- DataPostprocessorInputs -------------------------
+
+namespace DataPostprocessorInputs
+{
+  template <int spacedim>
+  void
+  VectorBatch<spacedim>::reinit(const unsigned int n_components,
+                                const unsigned int n_points,
+                                const UpdateFlags  update_flags)
+  {
+    this->n_components = n_components;
+    this->n_points     = n_points;
+
+    solution_values.resize((update_flags & update_values) ?
+                             n_components * n_points :
+                             0);
+    solution_gradients.resize((update_flags & update_gradients) ?
+                                n_components * spacedim * n_points :
+                                0);
+    solution_hessians.resize((update_flags & update_hessians) ?
+                               n_components * spacedim * spacedim *
+                                 n_points :
+                               0);
+  }
+
+
+
+  template <int spacedim>
+  void
+  VectorBatch<spacedim>::copy_from(const Scalar<spacedim> &input,
+                                   const UpdateFlags       update_flags)
+  {
+    static_cast<CommonInputs<spacedim> &>(*this) = input;
+
+    const unsigned int n_points = input.solution_values.size();
+    reinit(1, n_points, update_flags);
+
+    if (update_flags & update_values)
+      std::copy(input.solution_values.begin(),
+                input.solution_values.end(),
+                solution_values.begin());
+    if (update_flags & update_gradients)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        for (unsigned int q = 0; q < n_points; ++q)
+          solution_gradients[d * n_points + q] =
+            input.solution_gradients[q][d];
+    if (update_flags & update_hessians)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        for (unsigned int e = 0; e < spacedim; ++e)
+          for (unsigned int q = 0; q < n_points; ++q)
+            solution_hessians[(d * spacedim + e) * n_points + q] =
+              input.solution_hessians[q][d][e];
+  }
+
+
+
+  template <int spacedim>
+  void
+  VectorBatch<spacedim>::copy_from(const Vector<spacedim> &input,
+                                   const UpdateFlags       update_flags)
+  {
+    static_cast<CommonInputs<spacedim> &>(*this) = input;
+
+    const unsigned int n_points = input.solution_values.size();
+    const unsigned int n_components =
+      (n_points > 0 ? input.solution_values[0].size() : 0);
+    reinit(n_components, n_points, update_flags);
+
+    if (update_flags & update_values)
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int q = 0; q < n_points; ++q)
+          solution_values[c * n_points + q] = input.solution_values[q][c];
+    if (update_flags & update_gradients)
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          for (unsigned int q = 0; q < n_points; ++q)
+            solution_gradients[(c * spacedim + d) * n_points + q] =
+              input.solution_gradients[q][c][d];
+    if (update_flags & update_hessians)
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          for (unsigned int e = 0; e < spacedim; ++e)
+            for (unsigned int q = 0; q < n_points; ++q)
+              solution_hessians[((c * spacedim + d) * spacedim + e) *
+                                  n_points +
+                                q] = input.solution_hessians[q][c][d][e];
+  }
+} // namespace DataPostprocessorInputs
+
+
+
 // -------------------------- DataPostprocessor ---------------------------
 
+namespace
+{
+  /**
+   * Copy @p input_data into a DataPostprocessorInputs::VectorBatch object,
+   * call DataPostprocessor::evaluate_vector_field_batch(), and copy the
+   * result back into @p computed_quantities.
+   */
+  template <int dim, typename InputType>
+  void
+  evaluate_through_batch(const DataPostprocessor<dim> &postprocessor,
+                         const InputType &             input_data,
+                         std::vector<Vector<double>> & computed_quantities)
+  {
+    DataPostprocessorInputs::VectorBatch<dim> batch;
+    batch.copy_from(input_data, postprocessor.get_needed_update_flags());
+
+    const unsigned int n_quantities =
+      (computed_quantities.size() > 0 ? computed_quantities[0].size() : 0);
+    Table<2, double> batch_quantities(n_quantities,
+                                      computed_quantities.size());
+    postprocessor.evaluate_vector_field_batch(batch, batch_quantities);
+
+    for (unsigned int q = 0; q < computed_quantities.size(); ++q)
+      for (unsigned int i = 0; i < n_quantities; ++i)
+        computed_quantities[q][i] = batch_quantities(i, q);
+  }
+} // namespace
+
+
+
+
 template <int dim>
 void
 DataPostprocessor<dim>::evaluate_scalar_field(
-  const DataPostprocessorInputs::Scalar<dim> &,
-  std::vector<Vector<double>> &) const
+  const DataPostprocessorInputs::Scalar<dim> &input_data,
+  std::vector<Vector<double>> &               computed_quantities) const
 {
-  AssertThrow(false, ExcPureFunctionCalled());
+  AssertThrow(supports_batched_evaluation(), ExcPureFunctionCalled());
+
+  evaluate_through_batch(*this, input_data, computed_quantities);
 }
 
 
@@ -35,10 +159,80 @@ DataPostprocessor<dim>::evaluate_scalar_field(
 template <int dim>
 void
 DataPostprocessor<dim>::evaluate_vector_field(
-  const DataPostprocessorInputs::Vector<dim> &,
-  std::vector<Vector<double>> &) const
+  const DataPostprocessorInputs::Vector<dim> &input_data,
+  std::vector<Vector<double>> &               computed_quantities) const
+{
+  AssertThrow(supports_batched_evaluation(), ExcPureFunctionCalled());
+
+  evaluate_through_batch(*this, input_data, computed_quantities);
+}
+
+
+
+template <int dim>
+void
+DataPostprocessor<dim>::evaluate_vector_field_batch(
+  const DataPostprocessorInputs::VectorBatch<dim> &input_data,
+  Table<2, double> &                               computed_quantities) const
+{
+  Assert(supports_batched_evaluation() == false,
+         ExcMessage("A class that returns true from "
+                    "supports_batched_evaluation() needs to implement "
+                    "evaluate_vector_field_batch()."));
+
+  const unsigned int n_points     = input_data.n_points;
+  const unsigned int n_components = input_data.n_components;
+  AssertDimension(computed_quantities.size(1), n_points);
+
+  DataPostprocessorInputs::Vector<dim> input;
+  static_cast<DataPostprocessorInputs::CommonInputs<dim> &>(input) =
+    input_data;
+
+  if (input_data.solution_values.size() > 0)
+    {
+      input.solution_values.resize(n_points, Vector<double>(n_components));
+      for (unsigned int q = 0; q < n_points; ++q)
+        for (unsigned int c = 0; c < n_components; ++c)
+          input.solution_values[q][c] = input_data.get_values(c)[q];
+    }
+  if (input_data.solution_gradients.size() > 0)
+    {
+      input.solution_gradients.resize(
+        n_points, std::vector<Tensor<1, dim>>(n_components));
+      for (unsigned int q = 0; q < n_points; ++q)
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int d = 0; d < dim; ++d)
+            input.solution_gradients[q][c][d] =
+              input_data.get_gradients(c, d)[q];
+    }
+  if (input_data.solution_hessians.size() > 0)
+    {
+      input.solution_hessians.resize(
+        n_points, std::vector<Tensor<2, dim>>(n_components));
+      for (unsigned int q = 0; q < n_points; ++q)
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int e = 0; e < dim; ++e)
+              input.solution_hessians[q][c][d][e] =
+                input_data.get_hessians(c, d, e)[q];
+    }
+
+  std::vector<Vector<double>> quantities(
+    n_points, Vector<double>(computed_quantities.size(0)));
+  evaluate_vector_field(input, quantities);
+
+  for (unsigned int i = 0; i < computed_quantities.size(0); ++i)
+    for (unsigned int q = 0; q < n_points; ++q)
+      computed_quantities(i, q) = quantities[q][i];
+}
+
+
+
+template <int dim>
+bool
+DataPostprocessor<dim>::supports_batched_evaluation() const
 {
-  AssertThrow(false, ExcPureFunctionCalled());
+  return false;
 }
 
 
@@ -705,7 +705,7 @@ namespace DerivativeApproximation
   } // namespace internal
 } // namespace DerivativeApproximation
 
-// Dummy structures and dummy function used for WorkStream
+// Structures used for WorkStream
 namespace DerivativeApproximation
 {
   namespace internal
@@ -721,6 +721,26 @@ namespace DerivativeApproximation
       {
         CopyData() = default;
       };
+
+      /**
+       * Scratch object used to evaluate the finite element field at the
+       * centers of the cells.
+       */
+      template <int dim>
+      struct MidpointScratch
+      {
+        MidpointScratch(const hp::MappingCollection<dim> &mapping_collection,
+                        const hp::FECollection<dim> &     fe_collection,
+                        const hp::QCollection<dim> &      q_collection,
+                        const UpdateFlags                 update_flags)
+          : fe_midpoint_values(mapping_collection,
+                               fe_collection,
+                               q_collection,
+                               update_flags)
+        {}
+
+        hp::FEValues<dim> fe_midpoint_values;
+      };
     } // namespace Assembler
   }   // namespace internal
 } // namespace DerivativeApproximation
@@ -733,41 +753,20 @@ namespace DerivativeApproximation
   {
     /**
      * Compute the derivative approximation on one cell. This computes the full
-     * derivative tensor.
+     * derivative tensor from the centers of the cell and its active neighbors
+     * and the projected derivatives of the finite element field there, which
+     * @p get_midpoint_data returns as a pair for a given cell.
      */
     template <class DerivativeDescription,
               int dim,
-              class InputVector,
-              int spacedim>
+              int spacedim,
+              typename MidpointDataFunction>
     void
-    approximate_cell(
-      const Mapping<dim, spacedim> &   mapping,
-      const DoFHandler<dim, spacedim> &dof_handler,
-      const InputVector &              solution,
-      const unsigned int               component,
+    approximate_cell_from_midpoint_data(
       const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+      const MidpointDataFunction &                get_midpoint_data,
       typename DerivativeDescription::Derivative &derivative)
     {
-      QMidpoint<dim> midpoint_rule;
-
-      // create collection objects from
-      // single quadratures, mappings,
-      // and finite elements. if we have
-      // an hp-DoFHandler,
-      // dof_handler.get_fe() returns a
-      // collection of which we do a
-      // shallow copy instead
-      const hp::QCollection<dim>   q_collection(midpoint_rule);
-      const hp::FECollection<dim> &fe_collection =
-        dof_handler.get_fe_collection();
-      const hp::MappingCollection<dim> mapping_collection(mapping);
-
-      hp::FEValues<dim> x_fe_midpoint_value(
-        mapping_collection,
-        fe_collection,
-        q_collection,
-        DerivativeDescription::update_flags | update_quadrature_points);
-
       // matrix Y=sum_i y_i y_i^T
       Tensor<2, dim> Y;
 
@@ -788,20 +787,13 @@ namespace DerivativeApproximation
       // derivatives
       typename DerivativeDescription::Derivative projected_derivative;
 
-      // reinit FE values object...
-      x_fe_midpoint_value.reinit(cell);
-      const FEValues<dim> &fe_midpoint_value =
-        x_fe_midpoint_value.get_present_fe_values();
-
-      // ...and get the value of the
-      // projected derivative...
+      // get the value of the projected
+      // derivative and the place where
+      // it lives
+      const auto this_midpoint_data = get_midpoint_data(cell);
       const typename DerivativeDescription::ProjectedDerivative
-        this_midpoint_value =
-          DerivativeDescription::get_projected_derivative(fe_midpoint_value,
-                                                          solution,
-                                                          component);
-      // ...and the place where it lives
-      const Point<dim> this_center = fe_midpoint_value.quadrature_point(0);
+                       this_midpoint_value = this_midpoint_data.second;
+      const Point<dim> this_center         = this_midpoint_data.first;
 
       // loop over all neighbors and
       // accumulate the difference
@@ -824,23 +816,13 @@ namespace DerivativeApproximation
       auto neighbor_ptr = active_neighbors.begin();
       for (; neighbor_ptr != active_neighbors.end(); ++neighbor_ptr)
         {
-          const auto neighbor = *neighbor_ptr;
-
-          // reinit FE values object...
-          x_fe_midpoint_value.reinit(neighbor);
-          const FEValues<dim> &neighbor_fe_midpoint_value =
-            x_fe_midpoint_value.get_present_fe_values();
-
-          // ...and get the value of the
-          // solution...
+          // get the value of the
+          // solution and the place where
+          // it lives
+          const auto neighbor_midpoint_data = get_midpoint_data(*neighbor_ptr);
           const typename DerivativeDescription::ProjectedDerivative
-            neighbor_midpoint_value =
-              DerivativeDescription::get_projected_derivative(
-                neighbor_fe_midpoint_value, solution, component);
-
-          // ...and the place where it lives
-          const Point<dim> neighbor_center =
-            neighbor_fe_midpoint_value.quadrature_point(0);
+            neighbor_midpoint_value = neighbor_midpoint_data.second;
+          const Point<dim> neighbor_center = neighbor_midpoint_data.first;
 
 
           // vector for the
@@ -901,23 +883,75 @@ namespace DerivativeApproximation
 
 
     /**
-     * Compute the derivative approximation on a given cell.  Fill the @p
-     * derivative_norm vector with the norm of the computed derivative tensors
-     * on the cell.
+     * Compute the derivative approximation on one cell. This computes the full
+     * derivative tensor, evaluating the finite element field at the centers
+     * of the cell and its neighbors on the fly.
      */
     template <class DerivativeDescription,
               int dim,
               class InputVector,
               int spacedim>
     void
+    approximate_cell(
+      const Mapping<dim, spacedim> &   mapping,
+      const DoFHandler<dim, spacedim> &dof_handler,
+      const InputVector &              solution,
+      const unsigned int               component,
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+      typename DerivativeDescription::Derivative &derivative)
+    {
+      QMidpoint<dim> midpoint_rule;
+
+      // create collection objects from
+      // single quadratures, mappings,
+      // and finite elements. if we have
+      // an hp-DoFHandler,
+      // dof_handler.get_fe() returns a
+      // collection of which we do a
+      // shallow copy instead
+      const hp::QCollection<dim>   q_collection(midpoint_rule);
+      const hp::FECollection<dim> &fe_collection =
+        dof_handler.get_fe_collection();
+      const hp::MappingCollection<dim> mapping_collection(mapping);
+
+      hp::FEValues<dim> x_fe_midpoint_value(
+        mapping_collection,
+        fe_collection,
+        q_collection,
+        DerivativeDescription::update_flags | update_quadrature_points);
+
+      approximate_cell_from_midpoint_data<DerivativeDescription, dim, spacedim>(
+        cell,
+        [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+              &midpoint_cell) {
+          x_fe_midpoint_value.reinit(midpoint_cell);
+          const FEValues<dim> &fe_midpoint_value =
+            x_fe_midpoint_value.get_present_fe_values();
+          return std::make_pair(fe_midpoint_value.quadrature_point(0),
+                                DerivativeDescription::get_projected_derivative(
+                                  fe_midpoint_value, solution, component));
+        },
+        derivative);
+    }
+
+
+
+    /**
+     * Compute the derivative approximation on a given cell from the centers
+     * @p centers and the projected derivatives @p midpoint_values of all
+     * cells, indexed by their active cell index, as computed in
+     * approximate_derivative().  Fill the @p derivative_norm vector with the
+     * norm of the computed derivative tensors on the cell.
+     */
+    template <class DerivativeDescription, int dim, int spacedim>
+    void
     approximate(
       SynchronousIterators<
         std::tuple<typename DoFHandler<dim, spacedim>::active_cell_iterator,
                    Vector<float>::iterator>> const &cell,
-      const Mapping<dim, spacedim> &                mapping,
-      const DoFHandler<dim, spacedim> &             dof_handler,
-      const InputVector &                           solution,
-      const unsigned int                            component)
+      const std::vector<Point<dim>> &               centers,
+      const std::vector<typename DerivativeDescription::ProjectedDerivative>
+        &midpoint_values)
     {
       // if the cell is not locally owned, then there is nothing to do
       if (std::get<0>(*cell)->is_locally_owned() == false)
@@ -927,12 +961,15 @@ namespace DerivativeApproximation
           typename DerivativeDescription::Derivative derivative;
           // call the function doing the actual
           // work on this cell
-          approximate_cell<DerivativeDescription, dim, InputVector, spacedim>(
-            mapping,
-            dof_handler,
-            solution,
-            component,
+          approximate_cell_from_midpoint_data<DerivativeDescription,
+                                              dim,
+                                              spacedim>(
             std::get<0>(*cell),
+            [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                  &midpoint_cell) {
+              const unsigned int index = midpoint_cell->active_cell_index();
+              return std::make_pair(centers[index], midpoint_values[index]);
+            },
             derivative);
 
           // evaluate the norm and fill the vector
@@ -971,6 +1008,51 @@ namespace DerivativeApproximation
                dof_handler.get_triangulation().n_active_cells()));
       AssertIndexRange(component, dof_handler.get_fe(0).n_components());
 
+      // first evaluate the finite element field at the centers of all
+      // locally owned and ghost cells. this way, the field is evaluated only
+      // once per cell rather than once for the cell itself and once for each
+      // of its neighbors. the ghost values of the solution vector are read
+      // directly, so it needs to have them imported
+      const unsigned int n_active_cells =
+        dof_handler.get_triangulation().n_active_cells();
+      std::vector<Point<dim>> centers(n_active_cells);
+      std::vector<typename DerivativeDescription::ProjectedDerivative>
+        midpoint_values(n_active_cells);
+
+      const hp::QCollection<dim>       q_collection((QMidpoint<dim>()));
+      const hp::MappingCollection<dim> mapping_collection(mapping);
+
+      // every cell writes into its own entries of the two arrays, so there
+      // is no need for a copier
+      WorkStream::run(
+        dof_handler.active_cell_iterators(),
+        [&solution, component, &centers, &midpoint_values](
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator
+            &                              cell,
+          Assembler::MidpointScratch<dim> &scratch,
+          Assembler::CopyData &) {
+          if (cell->is_artificial())
+            return;
+
+          scratch.fe_midpoint_values.reinit(cell);
+          const FEValues<dim> &fe_midpoint_value =
+            scratch.fe_midpoint_values.get_present_fe_values();
+
+          const unsigned int index = cell->active_cell_index();
+          centers[index]           = fe_midpoint_value.quadrature_point(0);
+          midpoint_values[index] =
+            DerivativeDescription::get_projected_derivative(fe_midpoint_value,
+                                                            solution,
+                                                            component);
+        },
+        std::function<void(internal::Assembler::CopyData const &)>(),
+        internal::Assembler::MidpointScratch<dim>(
+          mapping_collection,
+          dof_handler.get_fe_collection(),
+          q_collection,
+          DerivativeDescription::update_flags | update_quadrature_points),
+        internal::Assembler::CopyData());
+
       using Iterators =
         std::tuple<typename DoFHandler<dim, spacedim>::active_cell_iterator,
                    Vector<float>::iterator>;
@@ -984,12 +1066,13 @@ namespace DerivativeApproximation
       WorkStream::run(
         begin,
         end,
-        [&mapping, &dof_handler, &solution, component](
-          SynchronousIterators<Iterators> const &cell,
-          Assembler::Scratch const &,
-          Assembler::CopyData &) {
-          approximate<DerivativeDescription, dim, InputVector, spacedim>(
-            cell, mapping, dof_handler, solution, component);
+        [&centers,
+         &midpoint_values](SynchronousIterators<Iterators> const &cell,
+                           Assembler::Scratch const &,
+                           Assembler::CopyData &) {
+          approximate<DerivativeDescription, dim, spacedim>(cell,
+                                                            centers,
+                                                            midpoint_values);
         },
         std::function<void(internal::Assembler::CopyData const &)>(),
         internal::Assembler::Scratch(),
@@ -14,6 +14,13 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/hdf5.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/fe/fe_point_evaluation.h>
+#include <deal.II/fe/mapping.h>
+
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/la_parallel_vector.h>
@@ -49,6 +56,128 @@ namespace internal
       support_point_locations = new_locations;
       solution_indices        = new_sol_indices;
     }
+
+
+
+    /**
+     * Return whether @p dof_handler is based on a distributed
+     * triangulation, for which the support points closest to a point can
+     * not be determined from the locally available cells.
+     */
+    template <int dim>
+    bool
+    is_distributed(const DoFHandler<dim> &dof_handler)
+    {
+      return dynamic_cast<const parallel::TriangulationBase<dim> *>(
+               &dof_handler.get_triangulation()) != nullptr;
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+    /**
+     * Evaluate the components of @p solution selected by @p mask at the
+     * points @p cache has been set up with, and return the values of the
+     * selected components for each point. The values are averaged if a
+     * point is found in several cells, and an exception is thrown if a
+     * point is not found at all. All points are evaluated with one scalar
+     * FEPointEvaluation object per selected component and finite element,
+     * and with a single exchange among the processes.
+     */
+    template <int dim, typename VectorType>
+    std::vector<std::vector<double>>
+    evaluate_at_requested_locations(
+      const Utilities::MPI::RemotePointEvaluation<dim> &cache,
+      const DoFHandler<dim> &                           dof_handler,
+      const VectorType &                                solution,
+      const ComponentMask &                             mask)
+    {
+      const unsigned int n_components =
+        dof_handler.get_fe_collection().n_components();
+      std::vector<unsigned int> selected_components;
+      for (unsigned int c = 0; c < n_components; ++c)
+        if (mask[c])
+          selected_components.push_back(c);
+      const unsigned int n_selected = selected_components.size();
+
+      const auto evaluation_function =
+        [&](const ArrayView<std::vector<double>> &values,
+            const typename Utilities::MPI::RemotePointEvaluation<dim>::CellData
+              &cell_data) {
+          std::vector<typename VectorType::value_type> solution_values;
+          std::vector<double>                          solution_values_double;
+
+          std::vector<std::vector<std::unique_ptr<FEPointEvaluation<1, dim>>>>
+            evaluators(dof_handler.get_fe_collection().size());
+
+          for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
+            {
+              typename DoFHandler<dim>::active_cell_iterator cell = {
+                &cache.get_triangulation(),
+                cell_data.cells[i].first,
+                cell_data.cells[i].second,
+                &dof_handler};
+
+              const ArrayView<const Point<dim>> unit_points(
+                cell_data.reference_point_values.data() +
+                  cell_data.reference_point_ptrs[i],
+                cell_data.reference_point_ptrs[i + 1] -
+                  cell_data.reference_point_ptrs[i]);
+
+              const unsigned int        fe_index = cell->active_fe_index();
+              const FiniteElement<dim> &fe       = dof_handler.get_fe(fe_index);
+
+              solution_values.resize(fe.n_dofs_per_cell());
+              cell->get_dof_values(solution,
+                                   solution_values.begin(),
+                                   solution_values.end());
+              solution_values_double.assign(solution_values.begin(),
+                                            solution_values.end());
+
+              if (evaluators[fe_index].empty())
+                for (const unsigned int c : selected_components)
+                  evaluators[fe_index].push_back(
+                    std::make_unique<FEPointEvaluation<1, dim>>(
+                      cache.get_mapping(), fe, c));
+
+              for (unsigned int q = 0; q < unit_points.size(); ++q)
+                values[cell_data.reference_point_ptrs[i] + q].resize(
+                  n_selected);
+
+              for (unsigned int s = 0; s < n_selected; ++s)
+                {
+                  FEPointEvaluation<1, dim> &evaluator =
+                    *evaluators[fe_index][s];
+                  evaluator.evaluate(cell,
+                                     unit_points,
+                                     make_array_view(solution_values_double),
+                                     dealii::EvaluationFlags::values);
+                  for (unsigned int q = 0; q < unit_points.size(); ++q)
+                    values[cell_data.reference_point_ptrs[i] + q][s] =
+                      evaluator.get_value(q);
+                }
+            }
+        };
+
+      std::vector<std::vector<double>> evaluation_results, buffer;
+      cache.template evaluate_and_process<std::vector<double>>(
+        evaluation_results, buffer, evaluation_function);
+
+      const std::vector<unsigned int> &point_ptrs = cache.get_point_ptrs();
+      std::vector<std::vector<double>> point_values(
+        point_ptrs.size() - 1, std::vector<double>(n_selected, 0.));
+      for (unsigned int p = 0; p + 1 < point_ptrs.size(); ++p)
+        {
+          const unsigned int n_entries = point_ptrs[p + 1] - point_ptrs[p];
+          AssertThrow(n_entries > 0, VectorTools::ExcPointNotAvailableHere());
+          for (unsigned int e = point_ptrs[p]; e < point_ptrs[p + 1]; ++e)
+            for (unsigned int s = 0; s < n_selected; ++s)
+              point_values[p][s] += evaluation_results[e][s] / n_entries;
+        }
+
+      return point_values;
+    }
+#endif
   } // namespace PointValueHistoryImplementation
 } // namespace internal
 
@@ -122,6 +251,10 @@ PointValueHistory<dim>::PointValueHistory(
   have_dof_handler      = point_value_history.have_dof_handler;
   n_indep               = point_value_history.n_indep;
 
+  // the points are located again when needed, so that moving the points of
+  // one object does not affect the other one
+  remote_point_evaluation.reset();
+
   // What to do with tria_listener?
   // Presume subscribe new instance?
   if (have_dof_handler)
@@ -155,6 +288,10 @@ PointValueHistory<dim>::operator=(const PointValueHistory &point_value_history)
   have_dof_handler      = point_value_history.have_dof_handler;
   n_indep               = point_value_history.n_indep;
 
+  // the points are located again when needed, so that moving the points of
+  // one object does not affect the other one
+  remote_point_evaluation.reset();
+
   // What to do with tria_listener?
   // Presume subscribe new instance?
   if (have_dof_handler)
@@ -191,6 +328,13 @@ PointValueHistory<dim>::add_point(const Point<dim> &location)
   AssertThrow(have_dof_handler, ExcDoFHandlerRequired());
   AssertThrow(!triangulation_changed, ExcDoFHandlerChanged());
 
+  if (internal::PointValueHistoryImplementation::is_distributed(*dof_handler))
+    {
+      add_points(std::vector<Point<dim>>(1, location));
+      return;
+    }
+  remote_point_evaluation.reset();
+
   // Implementation assumes that support
   // points locations are dofs locations
   AssertThrow(dof_handler->get_fe().has_support_points(), ExcNotImplemented());
@@ -331,6 +475,32 @@ PointValueHistory<dim>::add_points(const std::vector<Point<dim>> &locations)
   AssertThrow(have_dof_handler, ExcDoFHandlerRequired());
   AssertThrow(!triangulation_changed, ExcDoFHandlerChanged());
 
+  remote_point_evaluation.reset();
+
+  // on distributed triangulations, the support points closest to the
+  // requested points can not be determined from the locally available
+  // cells, so only the requested locations are stored. they can be
+  // evaluated with evaluate_field_at_requested_location()
+  if (internal::PointValueHistoryImplementation::is_distributed(*dof_handler))
+    {
+      for (const Point<dim> &location : locations)
+        {
+          point_geometry_data.emplace_back(
+            location,
+            std::vector<Point<dim>>(),
+            std::vector<types::global_dof_index>());
+
+          for (auto &data_entry : data_store)
+            {
+              // add an extra row to each vector entry
+              const ComponentMask &current_mask =
+                (component_mask.find(data_entry.first))->second;
+              unsigned int n_stored = current_mask.n_selected_components();
+              data_entry.second.resize(data_entry.second.size() + n_stored);
+            }
+        }
+      return;
+    }
 
   // Implementation assumes that support
   // points locations are dofs locations
@@ -453,6 +623,28 @@ PointValueHistory<dim>::add_points(const std::vector<Point<dim>> &locations)
 
 
 
+template <int dim>
+void
+PointValueHistory<dim>::update_requested_locations(
+  const std::vector<Point<dim>> &locations)
+{
+  AssertThrow(!cleared, ExcInvalidState());
+  AssertThrow(have_dof_handler, ExcDoFHandlerRequired());
+  AssertDimension(locations.size(), point_geometry_data.size());
+
+  for (unsigned int point = 0; point < locations.size(); ++point)
+    point_geometry_data[point].requested_location = locations[point];
+
+  // if the points have already been located on the current mesh, start the
+  // search from the cells found before. otherwise, they are located from
+  // scratch in the next call to evaluate_field_at_requested_location()
+  if (remote_point_evaluation != nullptr &&
+      remote_point_evaluation->is_ready())
+    remote_point_evaluation->update(locations);
+}
+
+
+
 template <int dim>
 void
 PointValueHistory<dim>::add_field_name(const std::string &  vector_name,
@@ -560,6 +752,7 @@ PointValueHistory<dim>::clear()
   cleared          = true;
   dof_handler      = nullptr;
   have_dof_handler = false;
+  remote_point_evaluation.reset();
 }
 
 // Need to test that the internal data has a full and complete dataset for
@@ -611,6 +804,12 @@ PointValueHistory<dim>::evaluate_field(const std::string &vector_name,
   unsigned int n_stored =
     mask->second.n_selected_components(dof_handler->get_fe(0).n_components());
 
+  AssertThrow(
+    !internal::PointValueHistoryImplementation::is_distributed(*dof_handler),
+    ExcMessage("The support points closest to the requested points are not "
+               "available on distributed triangulations. Use "
+               "evaluate_field_at_requested_location() instead."));
+
   typename std::vector<
     internal::PointValueHistoryImplementation::PointGeometryData<dim>>::iterator
     point = point_geometry_data.begin();
@@ -892,7 +1091,6 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
   const std::string &vector_name,
   const VectorType & solution)
 {
-  using number = typename VectorType::value_type;
   // must be closed to add data to internal
   // members.
   Assert(closed, ExcInvalidState());
@@ -923,6 +1121,41 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
   unsigned int n_stored =
     mask->second.n_selected_components(dof_handler->get_fe(0).n_components());
 
+#ifdef DEAL_II_WITH_MPI
+  // locate all points once, and again after the mesh has changed. the
+  // values at all points are then computed with a single exchange
+  if (remote_point_evaluation == nullptr ||
+      remote_point_evaluation->is_ready() == false)
+    {
+      std::vector<Point<dim>> locations;
+      locations.reserve(point_geometry_data.size());
+      for (const auto &point : point_geometry_data)
+        locations.push_back(point.requested_location);
+
+      if (remote_point_evaluation == nullptr)
+        remote_point_evaluation =
+          std::make_shared<Utilities::MPI::RemotePointEvaluation<dim>>();
+      remote_point_evaluation->reinit(
+        locations,
+        dof_handler->get_triangulation(),
+        get_default_linear_mapping(dof_handler->get_triangulation()));
+    }
+
+  const std::vector<std::vector<double>> point_values =
+    internal::PointValueHistoryImplementation::evaluate_at_requested_locations(
+      *remote_point_evaluation, *dof_handler, solution, mask->second);
+
+  for (unsigned int data_store_index = 0;
+       data_store_index < point_values.size();
+       ++data_store_index)
+    for (unsigned int store_index = 0;
+         store_index < point_values[data_store_index].size();
+         ++store_index)
+      data_store_field->second[data_store_index * n_stored + store_index]
+        .push_back(point_values[data_store_index][store_index]);
+#else
+  using number = typename VectorType::value_type;
+
   typename std::vector<
     internal::PointValueHistoryImplementation::PointGeometryData<dim>>::iterator
                  point = point_geometry_data.begin();
@@ -952,6 +1185,7 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
             }
         }
     }
+#endif
 }
 
 
@@ -1196,6 +1430,89 @@ PointValueHistory<dim>::write_gnuplot(
 
 
 
+template <int dim>
+void
+PointValueHistory<dim>::flush_to_hdf5(const std::string &filename)
+{
+#ifdef DEAL_II_WITH_HDF5
+  // must be closed to have a consistent set of data
+  AssertThrow(closed, ExcInvalidState());
+  AssertThrow(!cleared, ExcInvalidState());
+  AssertThrow(deep_check(true), ExcDataLostSync());
+
+  // all processes store the same data, so only one of them needs to write
+  // it
+  bool write_file = true;
+  if (have_dof_handler)
+    if (const auto tria =
+          dynamic_cast<const parallel::TriangulationBase<dim> *>(
+            &dof_handler->get_triangulation()))
+      write_file =
+        (Utilities::MPI::this_mpi_process(tria->get_communicator()) == 0);
+
+  const unsigned int n_datasets = dataset_key.size();
+  if (write_file)
+    {
+      HDF5::File file(filename, HDF5::File::FileAccessMode::create);
+      file.set_attribute("n_datasets", n_datasets);
+
+      // zero-sized datasets are not written
+      if (n_datasets > 0)
+        {
+          file.write_dataset("keys", dataset_key);
+
+          if (n_indep != 0)
+            {
+              FullMatrix<double> values(n_indep, n_datasets);
+              for (unsigned int i = 0; i < n_indep; ++i)
+                for (unsigned int j = 0; j < n_datasets; ++j)
+                  values(i, j) = independent_values[i][j];
+              file.write_dataset("independent_values", values);
+            }
+        }
+
+      for (const auto &data_entry : data_store)
+        {
+          HDF5::Group group = file.create_group(data_entry.first);
+
+          if (point_geometry_data.size() > 0)
+            {
+              FullMatrix<double> locations(point_geometry_data.size(), dim);
+              for (unsigned int point = 0; point < point_geometry_data.size();
+                   ++point)
+                for (unsigned int d = 0; d < dim; ++d)
+                  locations(point, d) =
+                    point_geometry_data[point].requested_location[d];
+              group.write_dataset("requested_locations", locations);
+            }
+
+          if (n_datasets > 0 && data_entry.second.size() > 0)
+            {
+              FullMatrix<double> values(data_entry.second.size(), n_datasets);
+              for (unsigned int i = 0; i < data_entry.second.size(); ++i)
+                for (unsigned int j = 0; j < n_datasets; ++j)
+                  values(i, j) = data_entry.second[i][j];
+              group.write_dataset("values", values);
+            }
+        }
+    }
+
+  // remove the datasets written from memory, but keep the structure of
+  // the stored data
+  dataset_key.clear();
+  for (auto &values : independent_values)
+    values.clear();
+  for (auto &data_entry : data_store)
+    for (auto &values : data_entry.second)
+      values.clear();
+#else
+  (void)filename;
+  AssertThrow(false, ExcMessage("HDF5 support is disabled."));
+#endif
+}
+
+
+
 template <int dim>
 Vector<double>
 PointValueHistory<dim>::mark_support_locations()
@@ -14,6 +14,8 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -48,6 +50,7 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::SolutionTransfer(
   : dof_handler(&dof, typeid(*this).name())
   , n_dofs_old(0)
   , prepared_for(none)
+  , n_stored_vectors(0)
 {
   Assert((dynamic_cast<const parallel::distributed::Triangulation<
             DoFHandlerType::dimension,
@@ -76,13 +79,48 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::clear()
 {
   indices_on_cell.clear();
   dof_values_on_cell.clear();
-  cell_map.clear();
+  cell_data.clear();
+  n_stored_vectors = 0;
 
   prepared_for = none;
 }
 
 
 
+template <int dim, typename VectorType, typename DoFHandlerType>
+const typename SolutionTransfer<dim, VectorType, DoFHandlerType>::CellData *
+SolutionTransfer<dim, VectorType, DoFHandlerType>::get_cell_data(
+  const unsigned int level,
+  const unsigned int index) const
+{
+  if (level < cell_data.size() && index < cell_data[level].size() &&
+      cell_data[level][index].offset !=
+        std::numeric_limits<std::size_t>::max())
+    return &cell_data[level][index];
+  else
+    return nullptr;
+}
+
+
+
+template <int dim, typename VectorType, typename DoFHandlerType>
+void
+SolutionTransfer<dim, VectorType, DoFHandlerType>::set_cell_data(
+  const typename DoFHandlerType::cell_iterator &cell,
+  const CellData &                              data)
+{
+  const auto &tria = dof_handler->get_triangulation();
+  if (cell_data.size() < tria.n_levels())
+    cell_data.resize(tria.n_levels());
+  if (cell_data[cell->level()].empty())
+    cell_data[cell->level()].resize(tria.n_raw_cells(cell->level()));
+
+  AssertIndexRange(cell->index(), cell_data[cell->level()].size());
+  cell_data[cell->level()][cell->index()] = data;
+}
+
+
+
 template <int dim, typename VectorType, typename DoFHandlerType>
 void
 SolutionTransfer<dim, VectorType, DoFHandlerType>::prepare_for_pure_refinement()
@@ -105,27 +143,28 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::prepare_for_pure_refinement()
     TemporarilyRestoreSubdomainIds<dim, DoFHandlerType::space_dimension>
       subdomain_modifier(dof_handler->get_triangulation());
 
-  const unsigned int n_active_cells =
-    dof_handler->get_triangulation().n_active_cells();
   n_dofs_old = dof_handler->n_dofs();
 
-  // efficient reallocation of indices_on_cell
-  std::vector<std::vector<types::global_dof_index>>(n_active_cells)
-    .swap(indices_on_cell);
+  // on each cell store the indices of the dofs. after refining we get the
+  // values on the children by taking these indices, getting the respective
+  // values out of the data vectors and prolonging them to the children. the
+  // indices of all cells are stored contiguously in one array
+  std::size_t n_indices = 0;
+  for (const auto &cell : dof_handler->active_cell_iterators())
+    n_indices += cell->get_fe().n_dofs_per_cell();
+  indices_on_cell.resize(n_indices);
 
+  std::vector<types::global_dof_index> local_dof_indices;
+  std::size_t                          offset = 0;
   for (const auto &cell : dof_handler->active_cell_iterators())
     {
-      const unsigned int i = cell->active_cell_index();
-      indices_on_cell[i].resize(cell->get_fe().n_dofs_per_cell());
-      // on each cell store the indices of the
-      // dofs. after refining we get the values
-      // on the children by taking these
-      // indices, getting the respective values
-      // out of the data vectors and prolonging
-      // them to the children
-      cell->get_dof_indices(indices_on_cell[i]);
-      cell_map[std::make_pair(cell->level(), cell->index())] =
-        Pointerstruct(&indices_on_cell[i], cell->active_fe_index());
+      local_dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+      cell->get_dof_indices(local_dof_indices);
+      std::copy(local_dof_indices.begin(),
+                local_dof_indices.end(),
+                indices_on_cell.begin() + offset);
+      set_cell_data(cell, CellData(offset, cell->active_fe_index(), false));
+      offset += local_dof_indices.size();
     }
   prepared_for = pure_refinement;
 }
@@ -158,44 +197,8 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::refine_interpolate(
     TemporarilyRestoreSubdomainIds<dim, DoFHandlerType::space_dimension>
       subdomain_modifier(dof_handler->get_triangulation());
 
-  Vector<typename VectorType::value_type> local_values(0);
-
-  typename std::map<std::pair<unsigned int, unsigned int>,
-                    Pointerstruct>::const_iterator pointerstruct,
-    cell_map_end = cell_map.end();
-
-  for (const auto &cell : dof_handler->cell_iterators())
-    {
-      pointerstruct =
-        cell_map.find(std::make_pair(cell->level(), cell->index()));
-
-      if (pointerstruct != cell_map_end)
-        // this cell was refined or not
-        // touched at all, so we can get
-        // the new values by just setting
-        // or interpolating to the children,
-        // which is both done by one
-        // function
-        {
-          const unsigned int this_fe_index =
-            pointerstruct->second.active_fe_index;
-          const unsigned int dofs_per_cell =
-            cell->get_dof_handler().get_fe(this_fe_index).n_dofs_per_cell();
-          local_values.reinit(dofs_per_cell, true);
-
-          // make sure that the size of the stored indices is the same as
-          // dofs_per_cell. since we store the desired fe_index, we know
-          // what this size should be
-          Assert(dofs_per_cell == (*pointerstruct->second.indices_ptr).size(),
-                 ExcInternalError());
-          for (unsigned int i = 0; i < dofs_per_cell; ++i)
-            local_values(i) = internal::ElementAccess<VectorType>::get(
-              in, (*pointerstruct->second.indices_ptr)[i]);
-          cell->set_dof_values_by_interpolation(local_values,
-                                                out,
-                                                this_fe_index);
-        }
-    }
+  interpolate_on_cells(std::vector<const VectorType *>(1, &in),
+                       std::vector<VectorType *>(1, &out));
 }
 
 
@@ -271,6 +274,97 @@ namespace internal
           restriction_is_additive[f][i] = fe[f].restriction_is_additive(i);
       }
   }
+
+
+
+  /**
+   * The data written into the output vectors of SolutionTransfer for one
+   * of the cells of the old mesh: the dof indices of all of its active
+   * descendants on the new mesh, and the values of each vector on them.
+   */
+  template <typename Number>
+  struct SolutionTransferCopyData
+  {
+    std::vector<types::global_dof_index> dof_indices;
+    std::vector<std::vector<Number>>     values;
+  };
+
+
+
+  /**
+   * Distribute the values @p local_values of several vectors in the space
+   * of the element with index @p fe_index on @p cell to the active cells
+   * below @p cell, in the same way as
+   * DoFCellAccessor::set_dof_values_by_interpolation() does for a single
+   * vector, and append the dof indices and values of these cells to
+   * @p copy.
+   */
+  template <typename CellIterator, typename Number>
+  void
+  prolongate_to_active_cells(
+    const CellIterator &                cell,
+    const unsigned int                  fe_index,
+    const std::vector<Vector<Number>> & local_values,
+    const Table<2, FullMatrix<double>> &interpolation_hp,
+    SolutionTransferCopyData<Number> &  copy)
+  {
+    const unsigned int n_vectors = local_values.size();
+
+    if (cell->is_active())
+      {
+        if (cell->is_artificial())
+          return;
+
+        const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
+        std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+        cell->get_dof_indices(dof_indices);
+        copy.dof_indices.insert(copy.dof_indices.end(),
+                                dof_indices.begin(),
+                                dof_indices.end());
+
+        if (fe_index == cell->active_fe_index())
+          for (unsigned int j = 0; j < n_vectors; ++j)
+            copy.values[j].insert(copy.values[j].end(),
+                                  local_values[j].begin(),
+                                  local_values[j].end());
+        else
+          {
+            const FullMatrix<double> &interpolation_matrix =
+              interpolation_hp(cell->active_fe_index(), fe_index);
+            Vector<Number> tmp(dofs_per_cell);
+            for (unsigned int j = 0; j < n_vectors; ++j)
+              {
+                // The interpolation matrix might be empty when using
+                // FE_Nothing.
+                if (interpolation_matrix.empty() == false &&
+                    local_values[j].size() > 0)
+                  interpolation_matrix.vmult(tmp, local_values[j]);
+                copy.values[j].insert(copy.values[j].end(),
+                                      tmp.begin(),
+                                      tmp.end());
+              }
+          }
+      }
+    else
+      {
+        const auto &fe = cell->get_dof_handler().get_fe(fe_index);
+        std::vector<Vector<Number>> child_values(
+          n_vectors, Vector<Number>(fe.n_dofs_per_cell()));
+        for (unsigned int child = 0; child < cell->n_children(); ++child)
+          {
+            const FullMatrix<double> &prolongation =
+              fe.get_prolongation_matrix(child, cell->refinement_case());
+            if (fe.n_dofs_per_cell() > 0)
+              for (unsigned int j = 0; j < n_vectors; ++j)
+                prolongation.vmult(child_values[j], local_values[j]);
+            prolongate_to_active_cells(cell->child(child),
+                                       fe_index,
+                                       child_values,
+                                       interpolation_hp,
+                                       copy);
+          }
+      }
+  }
 } // namespace internal
 
 
@@ -311,65 +405,31 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::
     TemporarilyRestoreSubdomainIds<dim, DoFHandlerType::space_dimension>
       subdomain_modifier(dof_handler->get_triangulation());
 
-  // first count the number
-  // of cells that will be coarsened
-  // and that'll stay or be refined
-  unsigned int n_cells_to_coarsen        = 0;
-  unsigned int n_cells_to_stay_or_refine = 0;
-  for (const auto &act_cell : dof_handler->active_cell_iterators())
-    {
-      if (act_cell->coarsen_flag_set())
-        ++n_cells_to_coarsen;
-      else
-        ++n_cells_to_stay_or_refine;
-    }
-  Assert((n_cells_to_coarsen + n_cells_to_stay_or_refine) ==
-           dof_handler->get_triangulation().n_active_cells(),
-         ExcInternalError());
-
-  unsigned int n_coarsen_fathers = 0;
-  for (const auto &cell : dof_handler->cell_iterators())
-    if (!cell->is_active() && cell->child(0)->coarsen_flag_set())
-      ++n_coarsen_fathers;
-  Assert(n_cells_to_coarsen >= 2 * n_coarsen_fathers, ExcInternalError());
-
-  // allocate the needed memory. initialize
-  // the following arrays in an efficient
-  // way, without copying much
-  std::vector<std::vector<types::global_dof_index>>(n_cells_to_stay_or_refine)
-    .swap(indices_on_cell);
-
-  std::vector<std::vector<Vector<typename VectorType::value_type>>>(
-    n_coarsen_fathers,
-    std::vector<Vector<typename VectorType::value_type>>(in_size))
-    .swap(dof_values_on_cell);
-
-  Table<2, FullMatrix<double>>   interpolation_hp;
-  std::vector<std::vector<bool>> restriction_is_additive;
+  n_stored_vectors = in_size;
 
-  internal::extract_interpolation_matrices(*dof_handler, interpolation_hp);
-  internal::restriction_additive(dof_handler->get_fe_collection(),
-                                 restriction_is_additive);
-
-  // we need counters for
-  // the 'to_stay_or_refine' cells 'n_sr' and
-  // the 'coarsen_fathers' cells 'n_cf',
-  unsigned int n_sr = 0, n_cf = 0;
+  // first go through all cells and record where their data will be stored.
+  // for cells that remain active or will be refined, the dof indices are
+  // stored right away, whereas the interpolation of the values onto the
+  // cells whose children will be deleted is done in parallel below
+  std::vector<typename DoFHandlerType::cell_iterator> coarsen_fathers;
+  std::size_t                                         n_values = 0;
+  std::vector<types::global_dof_index>                local_dof_indices;
   for (const auto &cell : dof_handler->cell_iterators())
     {
       // CASE 1: active cell that remains as it is
       if (cell->is_active() && !cell->coarsen_flag_set())
         {
-          const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
-          indices_on_cell[n_sr].resize(dofs_per_cell);
-          // cell will not be coarsened,
-          // so we get away by storing the
-          // dof indices and later
-          // interpolating to the children
-          cell->get_dof_indices(indices_on_cell[n_sr]);
-          cell_map[std::make_pair(cell->level(), cell->index())] =
-            Pointerstruct(&indices_on_cell[n_sr], cell->active_fe_index());
-          ++n_sr;
+          // cell will not be coarsened, so we get away by storing the dof
+          // indices and later interpolating to the children
+          local_dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+          cell->get_dof_indices(local_dof_indices);
+          set_cell_data(cell,
+                        CellData(indices_on_cell.size(),
+                                 cell->active_fe_index(),
+                                 false));
+          indices_on_cell.insert(indices_on_cell.end(),
+                                 local_dof_indices.begin(),
+                                 local_dof_indices.end());
         }
 
       // CASE 2: cell is inactive but will become active
@@ -400,30 +460,47 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::
                  internal::hp::DoFHandlerImplementation::
                    ExcNoDominatedFiniteElementOnChildren());
 
-          const unsigned int dofs_per_cell =
-            dof_handler->get_fe(target_fe_index).n_dofs_per_cell();
-
-          std::vector<Vector<typename VectorType::value_type>>(
-            in_size, Vector<typename VectorType::value_type>(dofs_per_cell))
-            .swap(dof_values_on_cell[n_cf]);
-
+          set_cell_data(cell, CellData(n_values, target_fe_index, true));
+          n_values +=
+            in_size * dof_handler->get_fe(target_fe_index).n_dofs_per_cell();
+          coarsen_fathers.push_back(cell);
+        }
+    }
+  dof_values_on_cell.resize(n_values);
+
+  // store the data of each of the input vectors. get this data as
+  // interpolated onto a finite element space that encompasses that of all
+  // the children. note that cell->get_interpolated_dof_values already does
+  // all of the interpolations between spaces. every cell writes into its
+  // own part of dof_values_on_cell, so the cells can be processed in
+  // parallel
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(coarsen_fathers.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      Vector<typename VectorType::value_type> local_values;
+      for (unsigned int c = begin; c < end; ++c)
+        {
+          const auto &    cell = coarsen_fathers[c];
+          const CellData *data = get_cell_data(cell->level(), cell->index());
+          Assert(data != nullptr, ExcInternalError());
 
-          // store the data of each of the input vectors. get this data
-          // as interpolated onto a finite element space that encompasses
-          // that of all the children. note that
-          // cell->get_interpolated_dof_values already does all of the
-          // interpolations between spaces
+          const unsigned int dofs_per_cell =
+            dof_handler->get_fe(data->active_fe_index).n_dofs_per_cell();
+          local_values.reinit(dofs_per_cell);
           for (unsigned int j = 0; j < in_size; ++j)
-            cell->get_interpolated_dof_values(all_in[j],
-                                              dof_values_on_cell[n_cf][j],
-                                              target_fe_index);
-          cell_map[std::make_pair(cell->level(), cell->index())] =
-            Pointerstruct(&dof_values_on_cell[n_cf], target_fe_index);
-          ++n_cf;
+            {
+              cell->get_interpolated_dof_values(all_in[j],
+                                                local_values,
+                                                data->active_fe_index);
+              std::copy(local_values.begin(),
+                        local_values.end(),
+                        dof_values_on_cell.begin() + data->offset +
+                          j * dofs_per_cell);
+            }
         }
-    }
-  Assert(n_sr == n_cells_to_stay_or_refine, ExcInternalError());
-  Assert(n_cf == n_coarsen_fathers, ExcInternalError());
+    },
+    32);
 
   prepared_for = coarsening_and_refinement;
 }
@@ -476,111 +553,17 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate(
     TemporarilyRestoreSubdomainIds<dim, DoFHandlerType::space_dimension>
       subdomain_modifier(dof_handler->get_triangulation());
 
-  Vector<typename VectorType::value_type> local_values;
-  std::vector<types::global_dof_index>    dofs;
-
-  typename std::map<std::pair<unsigned int, unsigned int>,
-                    Pointerstruct>::const_iterator pointerstruct,
-    cell_map_end = cell_map.end();
+  Assert(size == n_stored_vectors,
+         ExcDimensionMismatch(size, n_stored_vectors));
 
-  Table<2, FullMatrix<double>> interpolation_hp;
-  internal::extract_interpolation_matrices(*dof_handler, interpolation_hp);
-  Vector<typename VectorType::value_type> tmp, tmp2;
-
-  for (const auto &cell : dof_handler->cell_iterators())
+  std::vector<const VectorType *> in_ptrs(size);
+  std::vector<VectorType *>       out_ptrs(size);
+  for (unsigned int j = 0; j < size; ++j)
     {
-      pointerstruct =
-        cell_map.find(std::make_pair(cell->level(), cell->index()));
-
-      if (pointerstruct != cell_map_end)
-        {
-          const std::vector<types::global_dof_index> *const indexptr =
-            pointerstruct->second.indices_ptr;
-
-          const std::vector<Vector<typename VectorType::value_type>>
-            *const valuesptr = pointerstruct->second.dof_values_ptr;
-
-          // cell stayed as it was or was refined
-          if (indexptr)
-            {
-              Assert(valuesptr == nullptr, ExcInternalError());
-
-              const unsigned int old_fe_index =
-                pointerstruct->second.active_fe_index;
-
-              // get the values of each of the input data vectors on this cell
-              // and prolong it to its children
-              unsigned int in_size = indexptr->size();
-              for (unsigned int j = 0; j < size; ++j)
-                {
-                  tmp.reinit(in_size, true);
-                  for (unsigned int i = 0; i < in_size; ++i)
-                    tmp(i) =
-                      internal::ElementAccess<VectorType>::get(all_in[j],
-                                                               (*indexptr)[i]);
-
-                  cell->set_dof_values_by_interpolation(tmp,
-                                                        all_out[j],
-                                                        old_fe_index);
-                }
-            }
-          else if (valuesptr)
-            // the children of this cell were deleted
-            {
-              Assert(!cell->has_children(), ExcInternalError());
-              Assert(indexptr == nullptr, ExcInternalError());
-
-              const unsigned int dofs_per_cell =
-                cell->get_fe().n_dofs_per_cell();
-              dofs.resize(dofs_per_cell);
-              // get the local
-              // indices
-              cell->get_dof_indices(dofs);
-
-              // distribute the stored data to the new vectors
-              for (unsigned int j = 0; j < size; ++j)
-                {
-                  // make sure that the size of the stored indices is the same
-                  // as dofs_per_cell. this is kind of a test if we use the same
-                  // FE in the hp-case. to really do that test we would have to
-                  // store the fe_index of all cells
-                  const Vector<typename VectorType::value_type> *data = nullptr;
-                  const unsigned int active_fe_index = cell->active_fe_index();
-                  if (active_fe_index != pointerstruct->second.active_fe_index)
-                    {
-                      const unsigned int old_index =
-                        pointerstruct->second.active_fe_index;
-                      const FullMatrix<double> &interpolation_matrix =
-                        interpolation_hp(active_fe_index, old_index);
-                      // The interpolation matrix might be empty when using
-                      // FE_Nothing.
-                      if (interpolation_matrix.empty())
-                        tmp.reinit(dofs_per_cell, false);
-                      else
-                        {
-                          tmp.reinit(dofs_per_cell, true);
-                          AssertDimension((*valuesptr)[j].size(),
-                                          interpolation_matrix.n());
-                          AssertDimension(tmp.size(), interpolation_matrix.m());
-                          interpolation_matrix.vmult(tmp, (*valuesptr)[j]);
-                        }
-                      data = &tmp;
-                    }
-                  else
-                    data = &(*valuesptr)[j];
-
-
-                  for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                    internal::ElementAccess<VectorType>::set((*data)(i),
-                                                             dofs[i],
-                                                             all_out[j]);
-                }
-            }
-          // undefined status
-          else
-            Assert(false, ExcInternalError());
-        }
+      in_ptrs[j]  = &all_in[j];
+      out_ptrs[j] = &all_out[j];
     }
+  interpolate_on_cells(in_ptrs, out_ptrs);
 }
 
 
@@ -595,12 +578,100 @@ SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate(
   Assert(out.size() == dof_handler->n_dofs(),
          ExcDimensionMismatch(out.size(), dof_handler->n_dofs()));
 
-  std::vector<VectorType> all_in(1);
-  all_in[0] = in;
-  std::vector<VectorType> all_out(1);
-  all_out[0] = out;
-  interpolate(all_in, all_out);
-  out = all_out[0];
+  Assert(prepared_for == coarsening_and_refinement, ExcNotPrepared());
+  Assert(n_stored_vectors == 1, ExcDimensionMismatch(n_stored_vectors, 1));
+  Assert(&in != &out,
+         ExcMessage("Vectors cannot be used as input and output"
+                    " at the same time!"));
+
+  // We need to access dof indices on the entire domain, see the function
+  // above.
+  const internal::parallel::shared::
+    TemporarilyRestoreSubdomainIds<dim, DoFHandlerType::space_dimension>
+      subdomain_modifier(dof_handler->get_triangulation());
+
+  interpolate_on_cells(std::vector<const VectorType *>(1, &in),
+                       std::vector<VectorType *>(1, &out));
+}
+
+
+
+template <int dim, typename VectorType, typename DoFHandlerType>
+void
+SolutionTransfer<dim, VectorType, DoFHandlerType>::interpolate_on_cells(
+  const std::vector<const VectorType *> &all_in,
+  const std::vector<VectorType *> &      all_out) const
+{
+  using Number = typename VectorType::value_type;
+
+  const unsigned int n_vectors = all_in.size();
+  AssertDimension(all_out.size(), n_vectors);
+
+  // the interpolation matrices between the elements of an hp::FECollection
+  // are computed once here, whereas the prolongation matrices are cached
+  // by the finite elements
+  Table<2, FullMatrix<double>> interpolation_hp;
+  internal::extract_interpolation_matrices(*dof_handler, interpolation_hp);
+
+  using CellIterator = typename DoFHandlerType::cell_iterator;
+  using ScratchData  = std::vector<Vector<Number>>;
+  using CopyData     = internal::SolutionTransferCopyData<Number>;
+
+  // read the local values of all vectors on each cell with stored data and
+  // prolongate them to the active descendants of the cell in parallel; the
+  // results are written into the output vectors sequentially
+  auto worker =
+    [&](const CellIterator &cell, ScratchData &local_values, CopyData &copy) {
+      copy.dof_indices.clear();
+      copy.values.resize(n_vectors);
+      for (auto &values : copy.values)
+        values.clear();
+
+      const CellData *data = get_cell_data(cell->level(), cell->index());
+      if (data == nullptr)
+        return;
+
+      const unsigned int dofs_per_cell =
+        dof_handler->get_fe(data->active_fe_index).n_dofs_per_cell();
+      local_values.resize(n_vectors);
+      for (unsigned int j = 0; j < n_vectors; ++j)
+        {
+          local_values[j].reinit(dofs_per_cell, true);
+          // the cell stayed as it was or was refined, so read the values
+          // from the input vectors
+          if (data->has_dof_values == false)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              local_values[j](i) = internal::ElementAccess<VectorType>::get(
+                *all_in[j], indices_on_cell[data->offset + i]);
+          // the children of this cell were deleted, so take the stored
+          // values
+          else
+            {
+              Assert(cell->is_active(), ExcInternalError());
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                local_values[j](i) =
+                  dof_values_on_cell[data->offset + j * dofs_per_cell + i];
+            }
+        }
+
+      internal::prolongate_to_active_cells(
+        cell, data->active_fe_index, local_values, interpolation_hp, copy);
+    };
+
+  auto copier = [&](const CopyData &copy) {
+    for (unsigned int j = 0; j < n_vectors; ++j)
+      for (unsigned int i = 0; i < copy.dof_indices.size(); ++i)
+        internal::ElementAccess<VectorType>::set(copy.values[j][i],
+                                                 copy.dof_indices[i],
+                                                 *all_out[j]);
+  };
+
+  WorkStream::run(dof_handler->begin(),
+                  dof_handler->end(),
+                  worker,
+                  copier,
+                  ScratchData(),
+                  CopyData());
 }
 
 
@@ -609,22 +680,20 @@ template <int dim, typename VectorType, typename DoFHandlerType>
 std::size_t
 SolutionTransfer<dim, VectorType, DoFHandlerType>::memory_consumption() const
 {
-  // at the moment we do not include the memory
-  // consumption of the cell_map as we have no
-  // real idea about memory consumption of a
-  // std::map
   return (MemoryConsumption::memory_consumption(dof_handler) +
           MemoryConsumption::memory_consumption(n_dofs_old) +
           sizeof(prepared_for) +
           MemoryConsumption::memory_consumption(indices_on_cell) +
-          MemoryConsumption::memory_consumption(dof_values_on_cell));
+          MemoryConsumption::memory_consumption(dof_values_on_cell) +
+          MemoryConsumption::memory_consumption(n_stored_vectors) +
+          MemoryConsumption::memory_consumption(cell_data));
 }
 
 
 
 template <int dim, typename VectorType, typename DoFHandlerType>
 std::size_t
-SolutionTransfer<dim, VectorType, DoFHandlerType>::Pointerstruct::
+SolutionTransfer<dim, VectorType, DoFHandlerType>::CellData::
   memory_consumption() const
 {
   return sizeof(*this);
@@ -0,0 +1,275 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/particles/cell_weights.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  namespace
+  {
+    // Repartition the given triangulation. The one-dimensional
+    // parallel::distributed::Triangulation is only a placeholder that does
+    // not provide this function.
+    template <int dim, int spacedim>
+    void
+    repartition_triangulation(
+      parallel::distributed::Triangulation<dim, spacedim> &triangulation)
+    {
+#ifdef DEAL_II_WITH_P4EST
+      triangulation.repartition();
+#else
+      (void)triangulation;
+      Assert(false, ExcNotImplemented());
+#endif
+    }
+
+
+
+    template <int spacedim>
+    void
+    repartition_triangulation(
+      parallel::distributed::Triangulation<1, spacedim> &)
+    {
+      Assert(false, ExcNotImplemented());
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  CellWeights<dim, spacedim>::CellWeights(
+    parallel::distributed::Triangulation<dim, spacedim> &triangulation,
+    ParticleHandler<dim, spacedim> &                     particle_handler,
+    const double                                         imbalance_threshold,
+    const unsigned int                                   n_measurement_steps)
+    : triangulation(&triangulation)
+    , particle_handler(&particle_handler)
+    , imbalance_threshold(imbalance_threshold)
+    , n_measurement_steps(n_measurement_steps)
+    , n_recorded_steps(0)
+    , accumulated_n_cells(0.)
+    , accumulated_n_particles(0.)
+    , particle_cost_ratio(0.)
+    , imbalance(0.)
+  {
+    Assert(imbalance_threshold >= 1.,
+           ExcMessage("The imbalance threshold must be at least one."));
+    Assert(n_measurement_steps > 0,
+           ExcMessage("At least one time step has to be measured."));
+
+    // the timers start running upon construction
+    mesh_timer.reset();
+    particle_timer.reset();
+
+    connection = triangulation.signals.cell_weight.connect(
+      [this](
+        const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+        const typename Triangulation<dim, spacedim>::CellStatus     status) {
+        return this->cell_weight(cell, status);
+      });
+  }
+
+
+
+  template <int dim, int spacedim>
+  CellWeights<dim, spacedim>::~CellWeights()
+  {
+    connection.disconnect();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::start_mesh_work()
+  {
+    mesh_timer.start();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::stop_mesh_work()
+  {
+    mesh_timer.stop();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::start_particle_work()
+  {
+    particle_timer.start();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::stop_particle_work()
+  {
+    particle_timer.stop();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::finish_step()
+  {
+    ++n_recorded_steps;
+    accumulated_n_cells += triangulation->n_locally_owned_active_cells();
+    accumulated_n_particles += particle_handler->n_locally_owned_particles();
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  CellWeights<dim, spacedim>::repartition_if_imbalanced()
+  {
+    if (n_recorded_steps < n_measurement_steps)
+      return false;
+
+    if (evaluate_measurements() <= imbalance_threshold)
+      return false;
+
+    particle_handler->register_store_callback_function();
+    repartition_triangulation(*triangulation);
+    particle_handler->register_load_callback_function(false);
+
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  CellWeights<dim, spacedim>::evaluate_measurements()
+  {
+    const MPI_Comm &mpi_communicator = triangulation->get_communicator();
+
+    // all processes have to take the same decision, so check the global
+    // number of recorded steps
+    if (Utilities::MPI::max(n_recorded_steps, mpi_communicator) == 0)
+      return 0.;
+
+    const double mesh_time     = mesh_timer.wall_time();
+    const double particle_time = particle_timer.wall_time();
+
+    const std::vector<double> local_values = {mesh_time,
+                                              particle_time,
+                                              accumulated_n_cells,
+                                              accumulated_n_particles};
+    std::vector<double>       global_values(local_values.size());
+    Utilities::MPI::sum(local_values, mpi_communicator, global_values);
+
+    // The average cost per cell and per particle over all processes. The
+    // ratio is only updated if both costs could be measured.
+    if (global_values[0] > 0. && global_values[2] > 0. &&
+        global_values[1] > 0. && global_values[3] > 0.)
+      {
+        const double cost_per_cell     = global_values[0] / global_values[2];
+        const double cost_per_particle = global_values[1] / global_values[3];
+        particle_cost_ratio            = cost_per_particle / cost_per_cell;
+      }
+
+    const Utilities::MPI::MinMaxAvg time_data =
+      Utilities::MPI::min_max_avg(mesh_time + particle_time, mpi_communicator);
+    imbalance = (time_data.avg > 0. ? time_data.max / time_data.avg : 1.);
+
+    mesh_timer.reset();
+    particle_timer.reset();
+    n_recorded_steps        = 0;
+    accumulated_n_cells     = 0.;
+    accumulated_n_particles = 0.;
+
+    return imbalance;
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  CellWeights<dim, spacedim>::get_particle_cost_ratio() const
+  {
+    return particle_cost_ratio;
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  CellWeights<dim, spacedim>::get_imbalance() const
+  {
+    return imbalance;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  CellWeights<dim, spacedim>::cell_weight(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const typename Triangulation<dim, spacedim>::CellStatus     status) const
+  {
+    types::particle_index n_particles = 0;
+
+    switch (status)
+      {
+        case parallel::TriangulationBase<dim, spacedim>::CELL_PERSIST:
+        case parallel::TriangulationBase<dim, spacedim>::CELL_REFINE:
+          n_particles = particle_handler->n_particles_in_cell(cell);
+          break;
+
+        case parallel::TriangulationBase<dim, spacedim>::CELL_INVALID:
+          break;
+
+        case parallel::TriangulationBase<dim, spacedim>::CELL_COARSEN:
+          for (const auto &child : cell->child_iterators())
+            n_particles += particle_handler->n_particles_in_cell(child);
+          break;
+
+        default:
+          Assert(false, ExcInternalError());
+          break;
+      }
+
+    // the triangulation adds a weight of 1000 for every cell, which
+    // corresponds to the cost of the cell itself
+    const double weight = std::round(1000. * particle_cost_ratio * n_particles);
+
+    return static_cast<unsigned int>(
+      std::min(weight,
+               static_cast<double>(std::numeric_limits<unsigned int>::max())));
+  }
+} // namespace Particles
+
+#include "cell_weights.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -19,10 +19,149 @@
 // We use some exceptions declared in this header
 #include <deal.II/numerics/data_out_dof_data.h>
 
+#ifdef DEAL_II_WITH_HDF5
+#  include <hdf5.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
 {
+  namespace
+  {
+#ifdef DEAL_II_WITH_HDF5
+    /**
+     * Create the dataset @p name of type @p type_id with @p n_global_values
+     * entries in the group @p group_id, and write the @p local_values of
+     * this process into the entries starting at @p local_offset.
+     */
+    template <typename T>
+    void
+    write_h5part_dataset(
+      const hid_t                            group_id,
+      const std::string &                    name,
+      const hid_t                            type_id,
+      const std::vector<T> &                 local_values,
+      const hsize_t                          local_offset,
+      const hsize_t                          n_global_values,
+      const hid_t                            transfer_plist_id,
+      const DataOutBase::DataOutFilterFlags &flags)
+    {
+      herr_t status;
+
+      const hid_t file_dataspace =
+        H5Screate_simple(1, &n_global_values, nullptr);
+      AssertThrow(file_dataspace >= 0, ExcIO());
+
+      // chunks can not be empty, so empty datasets are stored contiguously
+      const hid_t create_plist_id = H5Pcreate(H5P_DATASET_CREATE);
+      AssertThrow(create_plist_id >= 0, ExcIO());
+      if (((flags.hdf5_chunk_size > 0) || (flags.hdf5_compression_level > 0)) &&
+          (n_global_values > 0))
+        {
+          const hsize_t chunk_size = std::min<hsize_t>(
+            (flags.hdf5_chunk_size > 0) ? flags.hdf5_chunk_size : 65536,
+            n_global_values);
+          status = H5Pset_chunk(create_plist_id, 1, &chunk_size);
+          AssertThrow(status >= 0, ExcIO());
+
+          if (flags.hdf5_compression_level > 0)
+            {
+              status =
+                H5Pset_deflate(create_plist_id, flags.hdf5_compression_level);
+              AssertThrow(status >= 0, ExcIO());
+            }
+        }
+
+#  if H5Gcreate_vers == 1
+      const hid_t dataset_id = H5Dcreate(
+        group_id, name.c_str(), type_id, file_dataspace, create_plist_id);
+#  else
+      const hid_t dataset_id = H5Dcreate(group_id,
+                                         name.c_str(),
+                                         type_id,
+                                         file_dataspace,
+                                         H5P_DEFAULT,
+                                         create_plist_id,
+                                         H5P_DEFAULT);
+#  endif
+      AssertThrow(dataset_id >= 0, ExcIO());
+      status = H5Pclose(create_plist_id);
+      AssertThrow(status >= 0, ExcIO());
+
+      // select the section of this process in the file; processes without
+      // particles still have to take part in the collective write
+      const hsize_t n_local_values = local_values.size();
+      const hid_t   memory_dataspace =
+        H5Screate_simple(1, &n_local_values, nullptr);
+      AssertThrow(memory_dataspace >= 0, ExcIO());
+      if (n_local_values > 0)
+        {
+          status = H5Sselect_hyperslab(file_dataspace,
+                                       H5S_SELECT_SET,
+                                       &local_offset,
+                                       nullptr,
+                                       &n_local_values,
+                                       nullptr);
+          AssertThrow(status >= 0, ExcIO());
+        }
+      else
+        {
+          status = H5Sselect_none(file_dataspace);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Sselect_none(memory_dataspace);
+          AssertThrow(status >= 0, ExcIO());
+        }
+
+      status = H5Dwrite(dataset_id,
+                        type_id,
+                        memory_dataspace,
+                        file_dataspace,
+                        transfer_plist_id,
+                        local_values.data());
+      AssertThrow(status >= 0, ExcIO());
+
+      status = H5Sclose(memory_dataspace);
+      AssertThrow(status >= 0, ExcIO());
+      status = H5Sclose(file_dataspace);
+      AssertThrow(status >= 0, ExcIO());
+      status = H5Dclose(dataset_id);
+      AssertThrow(status >= 0, ExcIO());
+    }
+
+
+
+    /**
+     * Write a DataItem element of an XDMF file that refers to the
+     * one-dimensional dataset @p dataset_name of the H5Part file
+     * @p h5_filename.
+     */
+    void
+    write_xdmf_data_item(std::ostream &              out,
+                         const std::string &         indent,
+                         const std::string &         h5_filename,
+                         const std::string &         dataset_name,
+                         const std::string &         number_type,
+                         const unsigned int          precision,
+                         const types::particle_index n_values)
+    {
+      out << indent << "<DataItem Dimensions=\"" << n_values
+          << "\" NumberType=\"" << number_type << "\" Precision=\""
+          << precision << "\" Format=\"HDF\">\n"
+          << indent << "  " << h5_filename << ":/Step#0/" << dataset_name
+          << "\n"
+          << indent << "</DataItem>\n";
+    }
+#endif
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   void
   DataOut<dim, spacedim>::build_patches(
@@ -50,8 +189,7 @@ namespace Particles
             "any properties."));
 
         Assert(
-          data_component_names.size() ==
-            particles.begin()->get_properties().size(),
+          data_component_names.size() == particles.n_properties_per_particle(),
           ExcMessage(
             "When calling Particles::DataOut::build_patches with data component "
             "names and interpretations you need to provide as many data component "
@@ -91,12 +229,13 @@ namespace Particles
 
         if (n_data_components > 1)
           {
-            const ArrayView<double> properties = particle->get_properties();
+            const StridedArrayView<const double, 1> properties =
+              particle->get_property_view();
             for (unsigned int property_index = 0;
                  property_index < n_property_components;
                  ++property_index)
               patches[i].data(property_index + 1, 0) =
-                properties[property_index];
+                properties(property_index);
           }
       }
   }
@@ -253,6 +392,332 @@ namespace Particles
     return ranges;
   }
 
+
+
+  template <int dim, int spacedim>
+  void
+  write_h5part(
+    const ParticleHandler<dim, spacedim> &particle_handler,
+    const std::string &                   h5_filename,
+    const std::string &                   xdmf_filename,
+    const MPI_Comm &                      mpi_communicator,
+    const std::vector<std::string> &      data_component_names,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &                                    data_component_interpretations,
+    const DataOutBase::DataOutFilterFlags &flags,
+    const double                           time)
+  {
+    Assert(
+      data_component_names.size() == data_component_interpretations.size(),
+      ExcMessage(
+        "When calling Particles::write_h5part with data component "
+        "names and interpretations you need to provide as many data component "
+        "names as interpretations. Provide the same name for components that "
+        "belong to a single vector or tensor."));
+    Assert(data_component_names.size() == 0 ||
+             data_component_names.size() ==
+               particle_handler.n_properties_per_particle(),
+           ExcMessage(
+             "When calling Particles::write_h5part with data component "
+             "names and interpretations you need to provide as many data "
+             "component names as the particles have properties."));
+
+    const unsigned int n_property_components = data_component_names.size();
+
+    // Determine the names of the datasets of the properties, and the vectors
+    // that are described as such in the XDMF file. Components of vectors and
+    // tensors get their index within the vector or tensor appended.
+    std::vector<std::string>                          property_dataset_names;
+    std::vector<std::pair<unsigned int, std::string>> vector_ranges;
+    for (unsigned int i = 0; i < n_property_components;
+         /* i is updated below */)
+      switch (data_component_interpretations[i])
+        {
+          case DataComponentInterpretation::component_is_scalar:
+            {
+              property_dataset_names.push_back(data_component_names[i]);
+              ++i;
+              break;
+            }
+
+          case DataComponentInterpretation::component_is_part_of_vector:
+          case DataComponentInterpretation::component_is_part_of_tensor:
+            {
+              const bool is_vector =
+                (data_component_interpretations[i] ==
+                 DataComponentInterpretation::component_is_part_of_vector);
+              const unsigned int size =
+                (is_vector ? spacedim : spacedim * spacedim);
+
+              // ensure that there is a continuous number of next components
+              // that all belong to the vector or tensor
+              Assert(i + size <= n_property_components,
+                     ExcMessage("The components of the vector or tensor '" +
+                                data_component_names[i] +
+                                "' extend beyond the last property."));
+              for (unsigned int dd = 1; dd < size; ++dd)
+                Assert(data_component_interpretations[i + dd] ==
+                         data_component_interpretations[i],
+                       ExcMessage("The components of the vector or tensor '" +
+                                  data_component_names[i] +
+                                  "' have different interpretations."));
+
+              if (is_vector)
+                vector_ranges.emplace_back(property_dataset_names.size(),
+                                           data_component_names[i]);
+              for (unsigned int dd = 0; dd < size; ++dd)
+                property_dataset_names.push_back(data_component_names[i + dd] +
+                                                 "_" + std::to_string(dd));
+              i += size;
+              break;
+            }
+
+          default:
+            Assert(false, ExcNotImplemented());
+            ++i;
+        }
+
+#ifndef DEAL_II_WITH_HDF5
+    (void)h5_filename;
+    (void)xdmf_filename;
+    (void)mpi_communicator;
+    (void)flags;
+    (void)time;
+    AssertThrow(false, ExcMessage("HDF5 support is disabled."));
+#else
+    // If HDF5 is not parallel and we're using multiple processes, abort
+#  ifndef H5_HAVE_PARALLEL
+    AssertThrow(
+      Utilities::MPI::n_mpi_processes(mpi_communicator) <= 1,
+      ExcMessage(
+        "Serial HDF5 output on multiple processes is not yet supported."));
+#  endif
+
+    // Parallel writes into compressed datasets are only supported by newer
+    // versions of HDF5
+#  if defined(DEAL_II_WITH_MPI) && defined(H5_HAVE_PARALLEL)
+#    if !H5_VERSION_GE(1, 10, 2)
+    AssertThrow(flags.hdf5_compression_level == 0 ||
+                  Utilities::MPI::n_mpi_processes(mpi_communicator) == 1,
+                ExcMessage("Parallel HDF5 output with compression requires "
+                           "HDF5 version 1.10.2 or newer."));
+#    endif
+#  endif
+
+    // Determine the number of particles on all processes and the offset of
+    // the particles of this process in the datasets
+    const types::particle_index n_local_particles =
+      particle_handler.n_locally_owned_particles();
+    types::particle_index local_offset       = 0;
+    types::particle_index n_global_particles = n_local_particles;
+#  ifdef DEAL_II_WITH_MPI
+    int ierr = MPI_Exscan(&n_local_particles,
+                          &local_offset,
+                          1,
+                          DEAL_II_PARTICLE_INDEX_MPI_TYPE,
+                          MPI_SUM,
+                          mpi_communicator);
+    AssertThrowMPI(ierr);
+    // the result of MPI_Exscan is undefined on the first process
+    if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+      local_offset = 0;
+    ierr = MPI_Allreduce(&n_local_particles,
+                         &n_global_particles,
+                         1,
+                         DEAL_II_PARTICLE_INDEX_MPI_TYPE,
+                         MPI_SUM,
+                         mpi_communicator);
+    AssertThrowMPI(ierr);
+#  endif
+
+    herr_t status;
+
+    // Create the file, using the MPI communicator if HDF5 is parallel
+    const hid_t file_plist_id = H5Pcreate(H5P_FILE_ACCESS);
+    AssertThrow(file_plist_id >= 0, ExcIO());
+#  if defined(DEAL_II_WITH_MPI) && defined(H5_HAVE_PARALLEL)
+    status = H5Pset_fapl_mpio(file_plist_id, mpi_communicator, MPI_INFO_NULL);
+    AssertThrow(status >= 0, ExcIO());
+#  endif
+
+    const hid_t file_id =
+      H5Fcreate(h5_filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, file_plist_id);
+    AssertThrow(file_id >= 0, ExcIO());
+
+#  if H5Gcreate_vers == 1
+    const hid_t group_id = H5Gcreate(file_id, "Step#0", 0);
+#  else
+    const hid_t group_id =
+      H5Gcreate(file_id, "Step#0", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+#  endif
+    AssertThrow(group_id >= 0, ExcIO());
+
+    // Create the property list for a collective write
+    const hid_t transfer_plist_id = H5Pcreate(H5P_DATASET_XFER);
+    AssertThrow(transfer_plist_id >= 0, ExcIO());
+#  if defined(DEAL_II_WITH_MPI) && defined(H5_HAVE_PARALLEL)
+    status = H5Pset_dxpl_mpio(transfer_plist_id, H5FD_MPIO_COLLECTIVE);
+    AssertThrow(status >= 0, ExcIO());
+#  endif
+
+    // Write the coordinates. The visualization programs expect at least two
+    // coordinates, so the second one is set to zero in 1d.
+    const unsigned int               n_coordinates = std::max(spacedim, 2);
+    const std::array<std::string, 3> coordinate_names = {{"x", "y", "z"}};
+    std::vector<double>              values(n_local_particles);
+    for (unsigned int d = 0; d < n_coordinates; ++d)
+      {
+        std::size_t i = 0;
+        for (const auto &particle : particle_handler)
+          values[i++] = (d < spacedim ? particle.get_location()[d] : 0.);
+
+        write_h5part_dataset(group_id,
+                             coordinate_names[d],
+                             H5T_NATIVE_DOUBLE,
+                             values,
+                             local_offset,
+                             n_global_particles,
+                             transfer_plist_id,
+                             flags);
+      }
+
+    // Write the ids
+    {
+      std::vector<types::particle_index> ids(n_local_particles);
+      std::size_t                        i = 0;
+      for (const auto &particle : particle_handler)
+        ids[i++] = particle.get_id();
+
+      write_h5part_dataset(group_id,
+                           "id",
+                           (sizeof(types::particle_index) == 8 ?
+                              H5T_NATIVE_UINT64 :
+                              H5T_NATIVE_UINT32),
+                           ids,
+                           local_offset,
+                           n_global_particles,
+                           transfer_plist_id,
+                           flags);
+    }
+
+    // Write one dataset per property component
+    for (unsigned int c = 0; c < n_property_components; ++c)
+      {
+        std::size_t i = 0;
+        for (const auto &particle : particle_handler)
+          values[i++] = particle.get_property_view()(c);
+
+        write_h5part_dataset(group_id,
+                             property_dataset_names[c],
+                             H5T_NATIVE_DOUBLE,
+                             values,
+                             local_offset,
+                             n_global_particles,
+                             transfer_plist_id,
+                             flags);
+      }
+
+    status = H5Pclose(transfer_plist_id);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Gclose(group_id);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Fclose(file_id);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Pclose(file_plist_id);
+    AssertThrow(status >= 0, ExcIO());
+
+    // Describe the file in an XDMF file, which is written by the first
+    // process only
+    if (xdmf_filename.empty() ||
+        Utilities::MPI::this_mpi_process(mpi_communicator) != 0)
+      return;
+
+    std::ofstream xdmf_file(xdmf_filename);
+    AssertThrow(xdmf_file, ExcIO());
+
+    xdmf_file << "<?xml version=\"1.0\" ?>\n"
+              << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n"
+              << "<Xdmf Version=\"2.0\">\n"
+              << "  <Domain>\n"
+              << "    <Grid Name=\"Particles\" GridType=\"Uniform\">\n"
+              << "      <Time Value=\"" << time << "\"/>\n"
+              << "      <Topology TopologyType=\"Polyvertex\" "
+              << "NumberOfElements=\"" << n_global_particles << "\"/>\n"
+              << "      <Geometry GeometryType=\""
+              << (spacedim == 3 ? "X_Y_Z" : "X_Y") << "\">\n";
+    for (unsigned int d = 0; d < n_coordinates; ++d)
+      write_xdmf_data_item(xdmf_file,
+                           "        ",
+                           h5_filename,
+                           coordinate_names[d],
+                           "Float",
+                           8,
+                           n_global_particles);
+    xdmf_file << "      </Geometry>\n";
+
+    xdmf_file << "      <Attribute Name=\"id\" AttributeType=\"Scalar\" "
+              << "Center=\"Node\">\n";
+    write_xdmf_data_item(xdmf_file,
+                         "        ",
+                         h5_filename,
+                         "id",
+                         "UInt",
+                         sizeof(types::particle_index),
+                         n_global_particles);
+    xdmf_file << "      </Attribute>\n";
+
+    // Vectors are joined from their components, and padded with zeros to
+    // the three components XDMF expects
+    for (const auto &vector_range : vector_ranges)
+      {
+        std::string function = "JOIN(";
+        for (unsigned int d = 0; d < 3; ++d)
+          function += (d > 0 ? ", " : "") +
+                      (d < spacedim ? "$" + std::to_string(d) : "0 * $0");
+        function += ")";
+
+        xdmf_file << "      <Attribute Name=\"" << vector_range.second
+                  << "\" AttributeType=\"Vector\" Center=\"Node\">\n"
+                  << "        <DataItem ItemType=\"Function\" Function=\""
+                  << function << "\" Dimensions=\"" << n_global_particles
+                  << " 3\">\n";
+        for (unsigned int d = 0; d < spacedim; ++d)
+          write_xdmf_data_item(xdmf_file,
+                               "          ",
+                               h5_filename,
+                               property_dataset_names[vector_range.first + d],
+                               "Float",
+                               8,
+                               n_global_particles);
+        xdmf_file << "        </DataItem>\n"
+                  << "      </Attribute>\n";
+      }
+
+    // All other components, including those of tensors, are written as
+    // scalars
+    for (unsigned int c = 0; c < n_property_components; ++c)
+      if (data_component_interpretations[c] !=
+          DataComponentInterpretation::component_is_part_of_vector)
+        {
+          xdmf_file << "      <Attribute Name=\"" << property_dataset_names[c]
+                    << "\" AttributeType=\"Scalar\" Center=\"Node\">\n";
+          write_xdmf_data_item(xdmf_file,
+                               "        ",
+                               h5_filename,
+                               property_dataset_names[c],
+                               "Float",
+                               8,
+                               n_global_particles);
+          xdmf_file << "      </Attribute>\n";
+        }
+
+    xdmf_file << "    </Grid>\n"
+              << "  </Domain>\n"
+              << "</Xdmf>\n";
+
+    AssertThrow(xdmf_file, ExcIO());
+#endif
+  }
 } // namespace Particles
 
 #include "data_out.inst"
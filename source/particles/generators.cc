@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2019 - 2020 by the deal.II authors
+// Copyright (C) 2019 - 2021 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -17,6 +17,7 @@
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_tools.h>
 
@@ -29,6 +30,8 @@
 
 #include <deal.II/particles/generators.h>
 
+#include <limits>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
@@ -106,6 +109,135 @@ namespace Particles
 
         return cumulative_cell_weights;
       }
+
+
+
+      // The scratch data of the parallel loops that evaluate the real
+      // locations of a fixed set of reference locations on each cell. The
+      // reference locations are the quadrature points of the FEValues object,
+      // which computes their real locations for all points of a cell at once.
+      template <int dim, int spacedim>
+      struct ReferenceLocationScratchData
+      {
+        ReferenceLocationScratchData(
+          const Mapping<dim, spacedim> & mapping,
+          const std::vector<Point<dim>> &reference_locations)
+          : fe_values(mapping,
+                      fe_nothing,
+                      Quadrature<dim>(reference_locations),
+                      update_quadrature_points)
+        {}
+
+        ReferenceLocationScratchData(
+          const ReferenceLocationScratchData &scratch_data)
+          : fe_values(scratch_data.fe_values.get_mapping(),
+                      fe_nothing,
+                      scratch_data.fe_values.get_quadrature(),
+                      update_quadrature_points)
+        {}
+
+        FE_Nothing<dim, spacedim> fe_nothing;
+        FEValues<dim, spacedim>   fe_values;
+      };
+
+
+
+      // The scratch data of the parallel loop that generates random particle
+      // locations in each cell.
+      template <int dim, int spacedim>
+      struct RandomLocationScratchData
+      {
+        std::vector<Point<spacedim>> real_candidates;
+        std::vector<Point<dim>>      unit_candidates;
+      };
+
+
+
+      // The particle locations generated in one cell, which are inserted into
+      // the particle handler in the order of the cells.
+      template <int dim, int spacedim>
+      struct CellParticlesCopyData
+      {
+        typename Triangulation<dim, spacedim>::active_cell_iterator cell;
+        std::vector<Point<spacedim>>                                positions;
+        std::vector<Point<dim>> reference_locations;
+      };
+
+
+
+      // Generate @p n_particles random locations that are uniformly
+      // distributed in @p cell. Candidates are drawn in the bounding box of
+      // the cell and mapped to the unit cell in batches, keeping those that
+      // lie inside the cell. Like random_particle_in_cell(), every particle
+      // gets at most 100 tries.
+      template <int dim, int spacedim>
+      void
+      random_locations_in_cell(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator
+          &                                        cell,
+        const types::particle_index                n_particles,
+        std::mt19937 &                             random_number_generator,
+        const Mapping<dim, spacedim> &             mapping,
+        RandomLocationScratchData<dim, spacedim> &scratch_data,
+        CellParticlesCopyData<dim, spacedim> &     copy_data)
+      {
+        std::uniform_real_distribution<double> uniform_distribution_01(0, 1);
+
+        const BoundingBox<spacedim> cell_bounding_box(cell->bounding_box());
+        const std::pair<Point<spacedim>, Point<spacedim>> cell_bounds(
+          cell_bounding_box.get_boundary_points());
+
+        copy_data.positions.reserve(n_particles);
+        copy_data.reference_locations.reserve(n_particles);
+
+        unsigned int       iteration          = 0;
+        const unsigned int maximum_iterations = 100;
+        while (copy_data.positions.size() < n_particles &&
+               iteration < maximum_iterations)
+          {
+            const std::size_t n_candidates =
+              n_particles - copy_data.positions.size();
+            scratch_data.real_candidates.resize(n_candidates);
+            scratch_data.unit_candidates.resize(n_candidates);
+
+            for (auto &candidate : scratch_data.real_candidates)
+              for (unsigned int d = 0; d < spacedim; ++d)
+                candidate[d] =
+                  uniform_distribution_01(random_number_generator) *
+                    (cell_bounds.second[d] - cell_bounds.first[d]) +
+                  cell_bounds.first[d];
+
+            // points for which the transformation fails are returned with
+            // their first coordinate set to infinity
+            mapping.transform_points_real_to_unit_cell(
+              cell,
+              make_array_view(scratch_data.real_candidates),
+              make_array_view(scratch_data.unit_candidates));
+
+            for (std::size_t i = 0; i < n_candidates; ++i)
+              if (scratch_data.unit_candidates[i][0] !=
+                    std::numeric_limits<double>::infinity() &&
+                  GeometryInfo<dim>::is_inside_unit_cell(
+                    scratch_data.unit_candidates[i]))
+                {
+                  copy_data.positions.push_back(
+                    scratch_data.real_candidates[i]);
+                  copy_data.reference_locations.push_back(
+                    scratch_data.unit_candidates[i]);
+                }
+            ++iteration;
+          }
+
+        AssertThrow(
+          copy_data.positions.size() == n_particles,
+          ExcMessage(
+            "Couldn't generate a particle position within the maximum number of tries. "
+            "The ratio between the bounding box volume in which the particle is "
+            "generated and the actual cell volume is approximately: " +
+            std::to_string(
+              cell->measure() /
+              (cell_bounds.second - cell_bounds.first).norm_square())));
+      }
     } // namespace
 
     template <int dim, int spacedim>
@@ -139,24 +271,43 @@ namespace Particles
         }
 #endif
 
-      for (const auto &cell : triangulation.active_cell_iterators())
+      if (particle_reference_locations.size() > 0)
         {
-          if (cell->is_locally_owned())
-            {
-              for (const auto &reference_location :
-                   particle_reference_locations)
-                {
-                  const Point<spacedim> position_real =
-                    mapping.transform_unit_to_real_cell(cell,
-                                                        reference_location);
-
-                  const Particle<dim, spacedim> particle(position_real,
-                                                         reference_location,
-                                                         particle_index);
-                  particle_handler.insert_particle(particle, cell);
-                  ++particle_index;
-                }
-            }
+          using CellIterator =
+            typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+          // Compute the particle locations of the cells in parallel, but
+          // insert the particles in the order of the cells, so that the
+          // particle ids do not depend on the number of threads.
+          WorkStream::run(
+            triangulation.begin_active(),
+            triangulation.end(),
+            [](const CellIterator &                         cell,
+               ReferenceLocationScratchData<dim, spacedim> &scratch_data,
+               CellParticlesCopyData<dim, spacedim> &       copy_data) {
+              copy_data.cell = cell;
+              copy_data.positions.clear();
+              if (!cell->is_locally_owned())
+                return;
+
+              scratch_data.fe_values.reinit(cell);
+              copy_data.positions =
+                scratch_data.fe_values.get_quadrature_points();
+            },
+            [&](const CellParticlesCopyData<dim, spacedim> &copy_data) {
+              if (copy_data.positions.empty())
+                return;
+
+              particle_handler.insert_particles(
+                copy_data.cell,
+                make_array_view(copy_data.positions),
+                make_array_view(particle_reference_locations),
+                particle_index);
+              particle_index += copy_data.positions.size();
+            },
+            ReferenceLocationScratchData<dim, spacedim>(
+              mapping, particle_reference_locations),
+            CellParticlesCopyData<dim, spacedim>());
         }
 
       particle_handler.update_cached_numbers();
@@ -372,35 +523,57 @@ namespace Particles
           }
       }
 
-      // Now generate as many particles per cell as determined above
+      // Now generate as many particles per cell as determined above. Every
+      // cell uses its own random number generator, seeded by the combined
+      // seed and the index of the cell, so that the cells can be processed in
+      // parallel and the generated locations do not depend on the number of
+      // threads.
       {
-        unsigned int current_particle_index = start_particle_id;
-
-        std::multimap<
-          typename Triangulation<dim, spacedim>::active_cell_iterator,
-          Particle<dim, spacedim>>
-          particles;
-
-        for (const auto &cell : triangulation.active_cell_iterators())
-          if (cell->is_locally_owned())
-            {
-              for (unsigned int i = 0;
-                   i < particles_per_cell[cell->active_cell_index()];
-                   ++i)
-                {
-                  Particle<dim, spacedim> particle =
-                    random_particle_in_cell(cell,
-                                            current_particle_index,
-                                            random_number_generator,
-                                            mapping);
-                  particles.emplace_hint(particles.end(),
-                                         cell,
-                                         std::move(particle));
-                  ++current_particle_index;
-                }
-            }
-
-        particle_handler.insert_particles(particles);
+        using CellIterator =
+          typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+        types::particle_index current_particle_index = start_particle_id;
+
+        WorkStream::run(
+          triangulation.begin_active(),
+          triangulation.end(),
+          [&](const CellIterator &                      cell,
+              RandomLocationScratchData<dim, spacedim> &scratch_data,
+              CellParticlesCopyData<dim, spacedim> &    copy_data) {
+            copy_data.cell = cell;
+            copy_data.positions.clear();
+            copy_data.reference_locations.clear();
+            if (!cell->is_locally_owned() ||
+                particles_per_cell[cell->active_cell_index()] == 0)
+              return;
+
+            std::seed_seq cell_seed{combined_seed,
+                                    cell->active_cell_index()};
+            std::mt19937  cell_random_number_generator(cell_seed);
+
+            random_locations_in_cell(
+              cell,
+              particles_per_cell[cell->active_cell_index()],
+              cell_random_number_generator,
+              mapping,
+              scratch_data,
+              copy_data);
+          },
+          [&](const CellParticlesCopyData<dim, spacedim> &copy_data) {
+            if (copy_data.positions.empty())
+              return;
+
+            particle_handler.insert_particles(
+              copy_data.cell,
+              make_array_view(copy_data.positions),
+              make_array_view(copy_data.reference_locations),
+              current_particle_index);
+            current_particle_index += copy_data.positions.size();
+          },
+          RandomLocationScratchData<dim, spacedim>(),
+          CellParticlesCopyData<dim, spacedim>());
+
+        particle_handler.update_cached_numbers();
       }
     }
 
@@ -459,21 +632,37 @@ namespace Particles
         quadrature.get_points();
       std::vector<Point<spacedim>> points_to_generate;
 
-      //       Loop through cells and gather gauss points
-      for (const auto &cell : triangulation.active_cell_iterators())
+      // Loop through cells and gather the quadrature points. The points are
+      // computed in parallel and appended in the order of the cells.
+      if (particle_reference_locations.size() > 0)
         {
-          if (cell->is_locally_owned())
-            {
-              for (const auto &reference_location :
-                   particle_reference_locations)
-                {
-                  const Point<spacedim> position_real =
-                    mapping.transform_unit_to_real_cell(cell,
-                                                        reference_location);
-                  points_to_generate.push_back(position_real);
-                }
-            }
+          using CellIterator =
+            typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+          WorkStream::run(
+            triangulation.begin_active(),
+            triangulation.end(),
+            [](const CellIterator &                         cell,
+               ReferenceLocationScratchData<dim, spacedim> &scratch_data,
+               CellParticlesCopyData<dim, spacedim> &       copy_data) {
+              copy_data.positions.clear();
+              if (!cell->is_locally_owned())
+                return;
+
+              scratch_data.fe_values.reinit(cell);
+              copy_data.positions =
+                scratch_data.fe_values.get_quadrature_points();
+            },
+            [&](const CellParticlesCopyData<dim, spacedim> &copy_data) {
+              points_to_generate.insert(points_to_generate.end(),
+                                        copy_data.positions.begin(),
+                                        copy_data.positions.end());
+            },
+            ReferenceLocationScratchData<dim, spacedim>(
+              mapping, particle_reference_locations),
+            CellParticlesCopyData<dim, spacedim>());
         }
+
       particle_handler.insert_global_particles(points_to_generate,
                                                global_bounding_boxes,
                                                properties);
@@ -0,0 +1,303 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/particles/neighbor_search.h>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <iterator>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  template <int dim, int spacedim>
+  NeighborSearch<dim, spacedim>::NeighborSearch(
+    const Triangulation<dim, spacedim> &  triangulation,
+    const Mapping<dim, spacedim> &        mapping,
+    const ParticleHandler<dim, spacedim> &particle_handler,
+    const double                          radius)
+    : triangulation(&triangulation)
+    , mapping(&mapping)
+    , particle_handler(&particle_handler)
+    , cache(triangulation, mapping)
+    , radius(radius)
+    , candidate_cells_outdated(true)
+  {
+    Assert(radius >= 0., ExcMessage("The search radius must not be negative."));
+
+    // the candidate cells depend on the cells and their locations
+    const auto invalidate = [this]() {
+      candidate_cells_outdated = true;
+      candidate_cells.clear();
+      neighbor_lists.clear();
+    };
+    tria_listeners.push_back(
+      triangulation.signals.any_change.connect(invalidate));
+    tria_listeners.push_back(
+      triangulation.signals.mesh_movement.connect(invalidate));
+  }
+
+
+
+  template <int dim, int spacedim>
+  NeighborSearch<dim, spacedim>::~NeighborSearch()
+  {
+    for (auto &connection : tria_listeners)
+      connection.disconnect();
+    tria_listeners.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::set_radius(const double new_radius)
+  {
+    Assert(new_radius >= 0.,
+           ExcMessage("The search radius must not be negative."));
+
+    if (new_radius != radius)
+      {
+        radius                   = new_radius;
+        candidate_cells_outdated = true;
+        neighbor_lists.clear();
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  NeighborSearch<dim, spacedim>::get_radius() const
+  {
+    return radius;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::update_candidate_cells()
+  {
+    if (!candidate_cells_outdated)
+      return;
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      owned_cells;
+    for (const auto &cell : triangulation->active_cell_iterators())
+      if (cell->is_locally_owned())
+        owned_cells.push_back(cell);
+
+    candidate_cells.clear();
+    candidate_cells.resize(triangulation->n_active_cells());
+
+    // The tree of bounding boxes is built upon first access, which is not
+    // thread safe. Queries of the tree from several threads are.
+    const auto &rtree = cache.get_cell_bounding_boxes_rtree();
+
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(owned_cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<std::pair<
+          BoundingBox<spacedim>,
+          typename Triangulation<dim, spacedim>::active_cell_iterator>>
+          boxes;
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            const auto &cell = owned_cells[c];
+
+            BoundingBox<spacedim> search_box =
+              mapping->get_bounding_box(cell);
+            search_box.extend(radius);
+
+            boxes.clear();
+            rtree.query(boost::geometry::index::intersects(search_box),
+                        std::back_inserter(boxes));
+
+            // artificial cells do not store particles
+            std::vector<
+              typename Triangulation<dim, spacedim>::active_cell_iterator>
+              &candidates = candidate_cells[cell->active_cell_index()];
+            for (const auto &box : boxes)
+              if (!box.second->is_artificial())
+                candidates.push_back(box.second);
+          }
+      },
+      16);
+
+    candidate_cells_outdated = false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+    &NeighborSearch<dim, spacedim>::get_candidate_cells(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const
+  {
+    Assert(!candidate_cells_outdated,
+           ExcMessage("The candidate cells are not up to date. Call "
+                      "update_candidate_cells() first."));
+    Assert(cell->is_locally_owned(),
+           ExcMessage("Candidate cells are only available for locally owned "
+                      "cells."));
+    AssertIndexRange(cell->active_cell_index(), candidate_cells.size());
+
+    return candidate_cells[cell->active_cell_index()];
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::add_neighbors(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const Point<spacedim> &                                            location,
+    const particle_iterator &                                          particle,
+    std::vector<particle_iterator> &neighbors) const
+  {
+    const double radius_square = radius * radius;
+
+    for (const auto &candidate_cell : get_candidate_cells(cell))
+      {
+        const auto candidates =
+          particle_handler->particles_in_cell(candidate_cell);
+        for (auto candidate = candidates.begin(); candidate != candidates.end();
+             ++candidate)
+          if (candidate != particle &&
+              location.distance_square(candidate->get_location()) <=
+                radius_square)
+            neighbors.push_back(candidate);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<typename NeighborSearch<dim, spacedim>::particle_iterator>
+  NeighborSearch<dim, spacedim>::find_neighbors(
+    const particle_iterator &particle) const
+  {
+    const typename Triangulation<dim, spacedim>::active_cell_iterator cell =
+      particle->get_surrounding_cell(*triangulation);
+
+    std::vector<particle_iterator> neighbors;
+    add_neighbors(cell, particle->get_location(), particle, neighbors);
+
+    return neighbors;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NeighborSearch<dim, spacedim>::update_neighbor_lists()
+  {
+    update_candidate_cells();
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      owned_cells;
+    for (const auto &cell : triangulation->active_cell_iterators())
+      if (cell->is_locally_owned())
+        owned_cells.push_back(cell);
+
+    neighbor_lists.resize(triangulation->n_active_cells());
+
+    const double radius_square = radius * radius;
+
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(owned_cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        // the particles of the candidate cells of the current cell and their
+        // locations, which are tested against every particle of the cell
+        std::vector<particle_iterator> candidates;
+        std::vector<Point<spacedim>>   candidate_locations;
+
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            const auto &cell = owned_cells[c];
+            std::vector<std::vector<particle_iterator>> &cell_neighbors =
+              neighbor_lists[cell->active_cell_index()];
+
+            const auto particles = particle_handler->particles_in_cell(cell);
+            cell_neighbors.resize(particles.size());
+            if (particles.empty())
+              continue;
+
+            candidates.clear();
+            candidate_locations.clear();
+            for (const auto &candidate_cell :
+                 candidate_cells[cell->active_cell_index()])
+              {
+                const auto candidate_particles =
+                  particle_handler->particles_in_cell(candidate_cell);
+                for (auto candidate = candidate_particles.begin();
+                     candidate != candidate_particles.end();
+                     ++candidate)
+                  {
+                    candidates.push_back(candidate);
+                    candidate_locations.push_back(candidate->get_location());
+                  }
+              }
+
+            unsigned int i = 0;
+            for (auto particle = particles.begin(); particle != particles.end();
+                 ++particle, ++i)
+              {
+                const Point<spacedim> location = particle->get_location();
+
+                cell_neighbors[i].clear();
+                for (unsigned int j = 0; j < candidates.size(); ++j)
+                  if (location.distance_square(candidate_locations[j]) <=
+                        radius_square &&
+                      candidates[j] != particle)
+                    cell_neighbors[i].push_back(candidates[j]);
+              }
+          }
+      },
+      16);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<typename NeighborSearch<dim, spacedim>::particle_iterator> &
+  NeighborSearch<dim, spacedim>::get_neighbors(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int particle_index) const
+  {
+    Assert(cell->is_locally_owned(),
+           ExcMessage("Neighbor lists are only available for the particles of "
+                      "locally owned cells."));
+    AssertIndexRange(cell->active_cell_index(), neighbor_lists.size());
+    AssertIndexRange(particle_index,
+                     neighbor_lists[cell->active_cell_index()].size());
+
+    return neighbor_lists[cell->active_cell_index()][particle_index];
+  }
+} // namespace Particles
+
+#include "neighbor_search.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -59,14 +59,13 @@ namespace Particles
 
     if (particle.has_properties())
       {
-        const ArrayView<const double> their_properties =
-          particle.get_properties();
-        const ArrayView<double> my_properties =
-          property_pool->get_properties(property_pool_handle);
-
-        std::copy(their_properties.begin(),
-                  their_properties.end(),
-                  my_properties.begin());
+        const StridedArrayView<const double, 1> their_properties =
+          particle.get_property_view();
+        const StridedArrayView<double, 1> my_properties =
+          get_property_view();
+
+        for (unsigned int i = 0; i < their_properties.n_elements(); ++i)
+          my_properties(i) = their_properties(i);
       }
   }
 
@@ -98,10 +97,11 @@ namespace Particles
     // See if there are properties to load
     if (has_properties())
       {
-        const ArrayView<double> particle_properties = this->get_properties();
-        const unsigned int      size = particle_properties.size();
+        const StridedArrayView<double, 1> particle_properties =
+          this->get_property_view();
+        const unsigned int size = particle_properties.n_elements();
         for (unsigned int i = 0; i < size; ++i)
-          particle_properties[i] = *pdata++;
+          particle_properties(i) = *pdata++;
       }
 
     data = static_cast<const void *>(pdata);
@@ -141,14 +141,13 @@ namespace Particles
 
         if (particle.has_properties())
           {
-            const ArrayView<const double> their_properties =
-              particle.get_properties();
-            const ArrayView<double> my_properties =
-              property_pool->get_properties(property_pool_handle);
-
-            std::copy(their_properties.begin(),
-                      their_properties.end(),
-                      my_properties.begin());
+            const StridedArrayView<const double, 1> their_properties =
+              particle.get_property_view();
+            const StridedArrayView<double, 1> my_properties =
+              get_property_view();
+
+            for (unsigned int i = 0; i < their_properties.n_elements(); ++i)
+              my_properties(i) = their_properties(i);
           }
       }
 
@@ -236,10 +235,11 @@ namespace Particles
     // Write properties
     if (has_properties())
       {
-        const ArrayView<double> particle_properties =
-          property_pool->get_properties(property_pool_handle);
-        for (unsigned int i = 0; i < particle_properties.size(); ++i, ++pdata)
-          *pdata = particle_properties[i];
+        const StridedArrayView<const double, 1> particle_properties =
+          get_property_view();
+        for (unsigned int i = 0; i < particle_properties.n_elements();
+             ++i, ++pdata)
+          *pdata = particle_properties(i);
       }
 
     return static_cast<void *>(pdata);
@@ -270,11 +270,11 @@ namespace Particles
     // See if there are properties to load
     if (has_properties())
       {
-        const ArrayView<double> particle_properties =
-          property_pool->get_properties(property_pool_handle);
-        const unsigned int size = particle_properties.size();
+        const StridedArrayView<double, 1> particle_properties =
+          get_property_view();
+        const unsigned int size = particle_properties.n_elements();
         for (unsigned int i = 0; i < size; ++i)
-          particle_properties[i] = *pdata++;
+          particle_properties(i) = *pdata++;
       }
 
     return static_cast<const void *>(pdata);
@@ -290,11 +290,7 @@ namespace Particles
                        sizeof(get_reference_location());
 
     if (has_properties())
-      {
-        const ArrayView<double> particle_properties =
-          property_pool->get_properties(property_pool_handle);
-        size += sizeof(double) * particle_properties.size();
-      }
+      size += sizeof(double) * property_pool->n_properties_per_slot();
     return size;
   }
 
@@ -305,22 +301,19 @@ namespace Particles
   Particle<dim, spacedim>::set_properties(
     const ArrayView<const double> &new_properties)
   {
-    const ArrayView<double> property_values =
-      property_pool->get_properties(property_pool_handle);
+    const StridedArrayView<double, 1> property_values = get_property_view();
 
-    Assert(new_properties.size() == property_values.size(),
+    Assert(new_properties.size() == property_values.n_elements(),
            ExcMessage(
              "You are trying to assign properties with an incompatible length. "
              "The particle has space to store " +
-             std::to_string(property_values.size()) +
+             std::to_string(property_values.n_elements()) +
              " properties, but you are trying to assign " +
              std::to_string(new_properties.size()) +
              " properties. This is not allowed."));
 
-    if (property_values.size() > 0)
-      std::copy(new_properties.begin(),
-                new_properties.end(),
-                property_values.begin());
+    for (unsigned int i = 0; i < new_properties.size(); ++i)
+      property_values(i) = new_properties[i];
   }
 
 
@@ -13,6 +13,9 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/fe/mapping_cartesian.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
@@ -25,66 +28,6 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
 {
-  namespace
-  {
-    template <int dim, int spacedim>
-    std::vector<char>
-    pack_particles(std::vector<Particle<dim, spacedim>> &particles)
-    {
-      std::vector<char> buffer;
-
-      if (particles.size() == 0)
-        return buffer;
-
-      buffer.resize(particles.size() *
-                    particles.front().serialized_size_in_bytes());
-      void *current_data = buffer.data();
-
-      for (const auto &particle : particles)
-        {
-          current_data = particle.write_particle_data_to_memory(current_data);
-        }
-
-      return buffer;
-    }
-
-
-
-    template <int dim, int spacedim>
-    std::vector<Particle<dim, spacedim>>
-    unpack_particles(
-      const boost::iterator_range<std::vector<char>::const_iterator>
-        &                          data_range,
-      PropertyPool<dim, spacedim> &property_pool)
-    {
-      std::vector<Particle<dim, spacedim>> particles;
-
-      if (data_range.empty())
-        return particles;
-
-      Particle<dim, spacedim> particle;
-      particle.set_property_pool(property_pool);
-      const unsigned int particle_size = particle.serialized_size_in_bytes();
-
-      particles.reserve(data_range.size() / particle_size);
-
-      const void *data = static_cast<const void *>(&(*data_range.begin()));
-
-      while (data < &(*data_range.end()))
-        {
-          particles.emplace_back(data, &property_pool);
-        }
-
-      Assert(
-        data == &(*data_range.end()),
-        ExcMessage(
-          "The particle data could not be deserialized successfully. "
-          "Check that when deserializing the particles you expect the same "
-          "number of properties that were serialized."));
-
-      return particles;
-    }
-  } // namespace
 
   template <int dim, int spacedim>
   ParticleHandler<dim, spacedim>::ParticleHandler()
@@ -100,18 +43,22 @@ namespace Particles
     , store_callback()
     , load_callback()
     , handle(numbers::invalid_unsigned_int)
+    , only_dynamic_ghost_properties(false)
   {}
 
 
 
   template <int dim, int spacedim>
   ParticleHandler<dim, spacedim>::ParticleHandler(
-    const Triangulation<dim, spacedim> &triangulation,
-    const Mapping<dim, spacedim> &      mapping,
-    const unsigned int                  n_properties)
+    const Triangulation<dim, spacedim> &               triangulation,
+    const Mapping<dim, spacedim> &                     mapping,
+    const unsigned int                                 n_properties,
+    const typename PropertyPool<dim, spacedim>::Layout property_layout)
     : triangulation(&triangulation, typeid(*this).name())
     , mapping(&mapping, typeid(*this).name())
-    , property_pool(std::make_unique<PropertyPool<dim, spacedim>>(n_properties))
+    , property_pool(
+        std::make_unique<PropertyPool<dim, spacedim>>(n_properties,
+                                                      property_layout))
     , particles()
     , ghost_particles()
     , global_number_of_particles(0)
@@ -121,9 +68,24 @@ namespace Particles
     , store_callback()
     , load_callback()
     , handle(numbers::invalid_unsigned_int)
+    , only_dynamic_ghost_properties(false)
   {
     triangulation_cache =
       std::make_unique<GridTools::Cache<dim, spacedim>>(triangulation, mapping);
+
+    connect_to_triangulation_signals();
+  }
+
+
+
+  template <int dim, int spacedim>
+  ParticleHandler<dim, spacedim>::~ParticleHandler()
+  {
+    for (auto &connection : tria_listeners)
+      connection.disconnect();
+    tria_listeners.clear();
+
+    free_ghost_update_requests();
   }
 
 
@@ -131,21 +93,42 @@ namespace Particles
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::initialize(
-    const Triangulation<dim, spacedim> &new_triangulation,
-    const Mapping<dim, spacedim> &      new_mapping,
-    const unsigned int                  n_properties)
+    const Triangulation<dim, spacedim> &               new_triangulation,
+    const Mapping<dim, spacedim> &                     new_mapping,
+    const unsigned int                                 n_properties,
+    const typename PropertyPool<dim, spacedim>::Layout property_layout)
   {
     triangulation = &new_triangulation;
     mapping       = &new_mapping;
 
     // Create the memory pool that will store all particle properties
-    property_pool = std::make_unique<PropertyPool<dim, spacedim>>(n_properties);
+    property_pool =
+      std::make_unique<PropertyPool<dim, spacedim>>(n_properties,
+                                                    property_layout);
 
     // Create the grid cache to cache the information about the triangulation
     // that is used to locate the particles into subdomains and cells
     triangulation_cache =
       std::make_unique<GridTools::Cache<dim, spacedim>>(new_triangulation,
                                                         new_mapping);
+
+    connect_to_triangulation_signals();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::connect_to_triangulation_signals()
+  {
+    for (auto &connection : tria_listeners)
+      connection.disconnect();
+    tria_listeners.clear();
+
+    // moving the mesh changes the reference locations of all particles, and
+    // may move them out of their cells
+    tria_listeners.push_back(triangulation->signals.mesh_movement.connect(
+      [this]() { particles.mark_all_locations_changed(); }));
   }
 
 
@@ -161,7 +144,8 @@ namespace Particles
       particle_handler.property_pool->n_properties_per_slot();
     initialize(*particle_handler.triangulation,
                *particle_handler.mapping,
-               n_properties);
+               n_properties,
+               particle_handler.property_pool->get_layout());
     property_pool->reserve(particle_handler.particles.size() +
                            particle_handler.ghost_particles.size());
 
@@ -172,6 +156,9 @@ namespace Particles
     next_free_particle_index = particle_handler.next_free_particle_index;
     particles                = particle_handler.particles;
     ghost_particles          = particle_handler.ghost_particles;
+    only_dynamic_ghost_properties =
+      particle_handler.only_dynamic_ghost_properties;
+    dynamic_ghost_properties = particle_handler.dynamic_ghost_properties;
 
     ghost_particles_cache.ghost_particles_by_domain =
       particle_handler.ghost_particles_cache.ghost_particles_by_domain;
@@ -225,27 +212,13 @@ namespace Particles
   void
   ParticleHandler<dim, spacedim>::update_cached_numbers()
   {
-    types::particle_index locally_highest_index        = 0;
-    unsigned int          local_max_particles_per_cell = 0;
-    unsigned int          current_particles_per_cell   = 0;
-    typename Triangulation<dim, spacedim>::active_cell_iterator current_cell =
-      triangulation->begin_active();
-
+    types::particle_index locally_highest_index = 0;
     for (const auto &particle : *this)
-      {
-        locally_highest_index =
-          std::max(locally_highest_index, particle.get_id());
+      locally_highest_index =
+        std::max(locally_highest_index, particle.get_id());
 
-        if (particle.get_surrounding_cell(*triangulation) != current_cell)
-          {
-            current_particles_per_cell = 0;
-            current_cell = particle.get_surrounding_cell(*triangulation);
-          }
-
-        ++current_particles_per_cell;
-        local_max_particles_per_cell =
-          std::max(local_max_particles_per_cell, current_particles_per_cell);
-      }
+    const unsigned int local_max_particles_per_cell =
+      particles.max_particles_per_cell();
 
     if (const auto parallel_triangulation =
           dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
@@ -285,9 +258,9 @@ namespace Particles
       std::make_pair(cell->level(), cell->index());
 
     if (cell->is_locally_owned())
-      return particles.count(found_cell);
+      return particles.n_particles_in_cell(found_cell);
     else if (cell->is_ghost())
-      return ghost_particles.count(found_cell);
+      return ghost_particles.n_particles_in_cell(found_cell);
     else
       AssertThrow(false,
                   ExcMessage("You can't ask for the particles on an artificial "
@@ -320,19 +293,13 @@ namespace Particles
       std::make_pair(cell->level(), cell->index());
 
     if (cell->is_ghost())
-      {
-        const auto particles_in_cell = ghost_particles.equal_range(level_index);
-        return boost::make_iterator_range(
-          particle_iterator(ghost_particles, particles_in_cell.first),
-          particle_iterator(ghost_particles, particles_in_cell.second));
-      }
+      return boost::make_iterator_range(
+        particle_iterator(ghost_particles, ghost_particles.begin(level_index)),
+        particle_iterator(ghost_particles, ghost_particles.end(level_index)));
     else if (cell->is_locally_owned())
-      {
-        const auto particles_in_cell = particles.equal_range(level_index);
-        return boost::make_iterator_range(
-          particle_iterator(particles, particles_in_cell.first),
-          particle_iterator(particles, particles_in_cell.second));
-      }
+      return boost::make_iterator_range(
+        particle_iterator(particles, particles.begin(level_index)),
+        particle_iterator(particles, particles.end(level_index)));
     else
       AssertThrow(false,
                   ExcMessage("You can't ask for the particles on an artificial "
@@ -344,12 +311,85 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  ArrayView<double>
+  ParticleHandler<dim, spacedim>::get_property_values_in_cell(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int component)
+  {
+    const internal::LevelInd level_index(cell->level(), cell->index());
+
+    internal::ParticleContainer<dim, spacedim> *container = nullptr;
+    if (cell->is_locally_owned())
+      container = &particles;
+    else if (cell->is_ghost())
+      container = &ghost_particles;
+    else
+      AssertThrow(false,
+                  ExcMessage("You can't ask for the particles on an artificial "
+                             "cell since we don't know what exists on these "
+                             "kinds of cells."));
+
+    const unsigned int n_particles =
+      container->n_particles_in_cell(level_index);
+    if (n_particles == 0)
+      return {};
+
+    const std::vector<Particle<dim, spacedim>> &particles_in_block =
+      container->particles_in_cell(level_index);
+    const typename PropertyPool<dim, spacedim>::Handle first_handle =
+      particles_in_block[0].get_handle();
+
+#ifdef DEBUG
+    for (unsigned int i = 0; i < n_particles; ++i)
+      Assert(particles_in_block[i].get_handle() == first_handle + i,
+             ExcMessage("The properties of the particles in this cell are not "
+                        "stored contiguously. Call "
+                        "sort_particles_into_subdomains_and_cells() after "
+                        "inserting or removing particles."));
+#endif
+
+    return property_pool->get_property_values(component,
+                                              first_handle,
+                                              n_particles);
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const double>
+  ParticleHandler<dim, spacedim>::get_property_values_in_cell(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int component) const
+  {
+    return (const_cast<ParticleHandler<dim, spacedim> *>(this))
+      ->get_property_values_in_cell(cell, component);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::remove_particle(
     const ParticleHandler<dim, spacedim>::particle_iterator &particle)
   {
-    particles.erase(particle->particle);
+    particles.erase(particle->position);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::remove_particles(
+    const std::vector<particle_iterator> &particles_to_remove)
+  {
+    std::vector<typename internal::ParticleContainer<dim, spacedim>::Position>
+      positions;
+    positions.reserve(particles_to_remove.size());
+    for (const auto &particle : particles_to_remove)
+      positions.push_back(particle->position);
+
+    particles.erase(std::move(positions));
   }
 
 
@@ -360,24 +400,52 @@ namespace Particles
     const Particle<dim, spacedim> &                                    particle,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
   {
-    typename std::multimap<internal::LevelInd,
-                           Particle<dim, spacedim>>::iterator it =
-      particles.insert(
-        std::make_pair(internal::LevelInd(cell->level(), cell->index()),
-                       particle));
+    const auto position =
+      particles.insert(internal::LevelInd(cell->level(), cell->index()),
+                       particle);
 
-    particle_iterator particle_it(particles, it);
+    particle_iterator particle_it(particles, position);
     particle_it->set_property_pool(*property_pool);
 
     if (particle.has_properties())
-      for (unsigned int n = 0; n < particle.get_properties().size(); ++n)
-        particle_it->get_properties()[n] = particle.get_properties()[n];
+      {
+        const StridedArrayView<const double, 1> their_properties =
+          particle.get_property_view();
+        const StridedArrayView<double, 1> my_properties =
+          particle_it->get_property_view();
+        for (unsigned int n = 0; n < their_properties.n_elements(); ++n)
+          my_properties(n) = their_properties(n);
+      }
 
     return particle_it;
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::insert_particles(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &positions,
+    const ArrayView<const Point<dim>> &     reference_locations,
+    const types::particle_index             first_id)
+  {
+    AssertDimension(positions.size(), reference_locations.size());
+
+    const internal::LevelInd level_index(cell->level(), cell->index());
+    for (unsigned int i = 0; i < positions.size(); ++i)
+      {
+        const auto position =
+          particles.insert(level_index,
+                           Particle<dim, spacedim>(positions[i],
+                                                   reference_locations[i],
+                                                   first_id + i));
+        particles[position].set_property_pool(*property_pool);
+      }
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::insert_particles(
@@ -387,14 +455,13 @@ namespace Particles
   {
     for (const auto &particle : new_particles)
       {
-        // Insert the particle. Store an iterator to the newly
+        // Insert the particle. Store the position of the newly
         // inserted particle, and then set its property_pool.
-        auto it = particles.insert(
-          particles.end(),
-          std::make_pair(internal::LevelInd(particle.first->level(),
-                                            particle.first->index()),
-                         particle.second));
-        it->second.set_property_pool(*property_pool);
+        const auto position =
+          particles.insert(internal::LevelInd(particle.first->level(),
+                                              particle.first->index()),
+                           particle.second);
+        particles[position].set_property_pool(*property_pool);
       }
 
     update_cached_numbers();
@@ -446,22 +513,18 @@ namespace Particles
     if (cells.size() == 0)
       return;
 
-    auto hint =
-      particles.find(std::make_pair(cells[0]->level(), cells[0]->index()));
     for (unsigned int i = 0; i < cells.size(); ++i)
       {
         internal::LevelInd current_cell(cells[i]->level(), cells[i]->index());
         for (unsigned int p = 0; p < local_positions[i].size(); ++p)
           {
-            hint = particles.insert(
-              hint,
-              std::make_pair(current_cell,
-                             Particle<dim, spacedim>(positions[index_map[i][p]],
-                                                     local_positions[i][p],
-                                                     local_start_index +
-                                                       index_map[i][p])));
-
-            hint->second.set_property_pool(*property_pool);
+            const auto position = particles.insert(
+              current_cell,
+              Particle<dim, spacedim>(positions[index_map[i][p]],
+                                      local_positions[i][p],
+                                      local_start_index + index_map[i][p]));
+
+            particles[position].set_property_pool(*property_pool);
           }
       }
 
@@ -734,8 +797,12 @@ namespace Particles
         positions[i] = p.get_location();
         ids[i]       = p.get_id();
         if (p.has_properties())
-          properties[i] = {p.get_properties().begin(),
-                           p.get_properties().end()};
+          {
+            const StridedArrayView<const double, 1> particle_properties =
+              p.get_property_view();
+            for (unsigned int c = 0; c < particle_properties.n_elements(); ++c)
+              properties[i][c] = particle_properties(c);
+          }
         ++i;
       }
 
@@ -912,6 +979,41 @@ namespace Particles
       // therefore return if the scalar product of a is larger.
       return (scalar_product_a > scalar_product_b);
     }
+
+
+
+    /**
+     * Compute the inverse of the affine map from the unit cell to the cell
+     * with the given @p vertices, such that the reference location of a point
+     * $x$ is given by <tt>inverse_jacobian (x - shift)</tt>. Return false if
+     * the cell is not the image of the unit cell under an affine map, i.e.,
+     * if it is not a parallelogram or parallelepiped.
+     */
+    template <int dim, int spacedim>
+    bool
+    compute_inverse_affine_map(
+      const ArrayView<const Point<spacedim>> &vertices,
+      DerivativeForm<1, spacedim, dim> &      inverse_jacobian,
+      Tensor<1, spacedim> &                   shift)
+    {
+      AssertDimension(vertices.size(), GeometryInfo<dim>::vertices_per_cell);
+
+      const auto affine = GridTools::affine_cell_approximation<dim>(vertices);
+
+      // the approximation is exact if and only if it reproduces all vertices
+      const double tolerance =
+        1e-12 * vertices[0].distance(vertices[vertices.size() - 1]);
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        if ((apply_transformation(affine.first,
+                                  GeometryInfo<dim>::unit_cell_vertex(v)) +
+             affine.second - vertices[v])
+              .norm() > tolerance)
+          return false;
+
+      inverse_jacobian = affine.first.covariant_form().transpose();
+      shift            = affine.second;
+      return true;
+    }
   } // namespace
 
 
@@ -931,23 +1033,81 @@ namespace Particles
     std::vector<particle_iterator> particles_out_of_cell;
     particles_out_of_cell.reserve(n_locally_owned_particles());
 
+    // On parallelogram and parallelepiped cells, mappings of degree one
+    // are affine, so whether a particle is still in its cell can be
+    // decided without asking the mapping
+    const auto mapping_q =
+      dynamic_cast<const MappingQGeneric<dim, spacedim> *>(&*mapping);
+    const bool mapping_is_affine_on_parallelepipeds =
+      (dim == spacedim) &&
+      ((mapping_q != nullptr && mapping_q->get_degree() == 1) ||
+       (dynamic_cast<const MappingCartesian<dim, spacedim> *>(&*mapping) !=
+        nullptr));
+
     // Now update the reference locations of the moved particles
-    std::vector<Point<spacedim>> real_locations;
-    std::vector<Point<dim>>      reference_locations;
+    std::vector<particle_iterator> particles_to_transform;
+    std::vector<Point<spacedim>>   real_locations;
+    std::vector<Point<dim>>        reference_locations;
     for (auto particle = begin(); particle != end();)
       {
         const auto cell = particle->get_surrounding_cell(*triangulation);
-        real_locations.clear();
+        const internal::LevelInd level_index(cell->level(), cell->index());
+        const particle_iterator  end_of_cell(particles,
+                                            particles.end(level_index));
+
+        // Particles that were neither inserted nor moved since the last
+        // call of this function are still in their cells
+        if (!particles.locations_changed(level_index))
+          {
+            particle = end_of_cell;
+            continue;
+          }
+
+        const auto vertices = mapping->get_vertices(cell);
 
-        // Since we might also work on artificial cells when we initialize the
-        // particles on a remote processor, we cannot use the
-        // particles_in_cell method. Thus, We instead simply go through the
-        // particles and check if the next one belongs to the same cell as the
-        // current one.
-        for (auto it = particle;
-             it != end() && it->get_surrounding_cell(*triangulation) == cell;
-             ++it)
-          real_locations.push_back(it->get_location());
+        DerivativeForm<1, spacedim, dim> inverse_jacobian;
+        Tensor<1, spacedim>              shift;
+
+        const bool cell_is_affine =
+          mapping_is_affine_on_parallelepipeds &&
+          (cell->reference_cell() == ReferenceCells::get_hypercube<dim>()) &&
+          compute_inverse_affine_map<dim, spacedim>(
+            ArrayView<const Point<spacedim>>(vertices.data(), vertices.size()),
+            inverse_jacobian,
+            shift);
+
+        if (cell_is_affine)
+          {
+            // A particle outside the bounding box of the cell's vertices is
+            // certainly outside the cell. All others are located exactly by
+            // the inverse affine map.
+            const BoundingBox<spacedim> bounding_box(vertices);
+            for (; particle != end_of_cell; ++particle)
+              {
+                const Point<spacedim> &location = particle->get_location();
+                if (!bounding_box.point_inside(location))
+                  {
+                    particles_out_of_cell.push_back(particle);
+                    continue;
+                  }
+
+                const Point<dim> p_unit(
+                  apply_transformation(inverse_jacobian, location - shift));
+                if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                  particle->set_reference_location(p_unit);
+                else
+                  particles_out_of_cell.push_back(particle);
+              }
+            continue;
+          }
+
+        particles_to_transform.clear();
+        real_locations.clear();
+        for (; particle != end_of_cell; ++particle)
+          {
+            particles_to_transform.push_back(particle);
+            real_locations.push_back(particle->get_location());
+          }
 
         reference_locations.resize(real_locations.size());
         ArrayView<Point<dim>> reference(reference_locations.data(),
@@ -956,24 +1116,24 @@ namespace Particles
                                                     real_locations,
                                                     reference);
 
-        for (const auto &p_unit : reference_locations)
+        for (unsigned int i = 0; i < particles_to_transform.size(); ++i)
           {
+            const Point<dim> &p_unit = reference_locations[i];
             if (p_unit[0] == std::numeric_limits<double>::infinity() ||
                 !GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-              particles_out_of_cell.push_back(particle);
+              particles_out_of_cell.push_back(particles_to_transform[i]);
             else
-              particle->set_reference_location(p_unit);
-            ++particle;
+              particles_to_transform[i]->set_reference_location(p_unit);
           }
       }
 
     // There are three reasons why a particle is not in its old cell:
     // It moved to another cell, to another subdomain or it left the mesh.
-    // Particles that moved to another cell are updated and stored inside the
-    // sorted_particles vector, particles that moved to another domain are
-    // collected in the moved_particles_domain vector. Particles that left
-    // the mesh completely are ignored and removed.
-    std::vector<std::pair<internal::LevelInd, Particle<dim, spacedim>>>
+    // Particles that moved to another cell are collected together with
+    // their new cell in the sorted_particles vector, particles that moved to
+    // another domain are collected in the moved_particles_domain vector.
+    // Particles that left the mesh completely are ignored and removed.
+    std::vector<std::pair<internal::LevelInd, particle_iterator>>
       sorted_particles;
     std::map<types::subdomain_id, std::vector<particle_iterator>>
       moved_particles;
@@ -1120,7 +1280,7 @@ namespace Particles
               sorted_particles.push_back(
                 std::make_pair(internal::LevelInd(current_cell->level(),
                                                   current_cell->index()),
-                               out_particle->particle->second));
+                               out_particle));
             }
           else
             {
@@ -1131,12 +1291,10 @@ namespace Particles
         }
     }
 
-    // Sort the updated particles. This pre-sort speeds up inserting
-    // them into particles to O(N) complexity.
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      sorted_particles_map;
-
-    // Exchange particles between processors if we have more than one process
+    // Exchange particles between processors if we have more than one
+    // process. The received particles are added at the end of the
+    // particles of their cells, so the iterators collected above remain
+    // valid.
 #ifdef DEAL_II_WITH_MPI
     if (const auto parallel_triangulation =
           dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
@@ -1144,24 +1302,78 @@ namespace Particles
       {
         if (dealii::Utilities::MPI::n_mpi_processes(
               parallel_triangulation->get_communicator()) > 1)
-          send_recv_particles(moved_particles,
-                              sorted_particles_map,
-                              moved_cells);
+          send_recv_particles(moved_particles, particles, moved_cells);
       }
 #endif
 
-    sorted_particles_map.insert(sorted_particles.begin(),
-                                sorted_particles.end());
+    // Move the particles that stay on this process into their new cells.
+    // The particles remain in their old cells in a moved-from state until
+    // they are removed below.
+    for (auto &sorted_particle : sorted_particles)
+      {
+        Particle<dim, spacedim> particle(
+          std::move(particles[sorted_particle.second->position]));
+        particles.insert(sorted_particle.first, std::move(particle));
+      }
+
+    remove_particles(particles_out_of_cell);
+
+    // Particles leaving their cells leave unused memory behind in the blocks
+    // of particles of these cells. Release it if it becomes significant.
+    particles.compress();
+
+    // All particles are now known to be in their cells
+    particles.reset_locations_changed();
 
-    for (unsigned int i = 0; i < particles_out_of_cell.size(); ++i)
-      remove_particle(particles_out_of_cell[i]);
+    sort_property_pool_memory();
 
-    particles.insert(sorted_particles_map.begin(), sorted_particles_map.end());
     update_cached_numbers();
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::mark_all_particle_locations_changed()
+  {
+    particles.mark_all_locations_changed();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::sort_property_pool_memory()
+  {
+    if (property_pool->get_layout() !=
+        PropertyPool<dim, spacedim>::structure_of_arrays)
+      return;
+
+    // Collect the handles of the locally owned particles followed by those of
+    // the ghost particles, in the order in which they are stored. After
+    // sorting the memory, the handle of each particle is its index in this
+    // order.
+    std::vector<typename PropertyPool<dim, spacedim>::Handle> sorted_handles;
+    sorted_handles.reserve(particles.size() + ghost_particles.size());
+
+    for (internal::ParticleContainer<dim, spacedim> *container :
+         {&particles, &ghost_particles})
+      for (auto position = container->begin(); position != container->end();
+           container->advance(position))
+        sorted_handles.push_back((*container)[position].get_handle());
+
+    property_pool->sort_memory_slots(sorted_handles);
+
+    typename PropertyPool<dim, spacedim>::Handle new_handle = 0;
+    for (internal::ParticleContainer<dim, spacedim> *container :
+         {&particles, &ghost_particles})
+      for (auto position = container->begin(); position != container->end();
+           container->advance(position))
+        (*container)[position].set_handle(new_handle++);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::exchange_ghost_particles(
@@ -1267,6 +1479,12 @@ namespace Particles
         "Ghost particles cannot be updated if they first have not been exchanged at least once with the cache enabled"));
 
 
+    Assert(ghost_particles_cache.particle_data_size ==
+             ghost_update_data_size(),
+           ExcMessage("The properties to be updated were changed after the "
+                      "ghost particles were exchanged. Call "
+                      "exchange_ghost_particles() again."));
+
     send_recv_particles_properties_and_location(
       ghost_particles_cache.ghost_particles_by_domain, ghost_particles);
 #endif
@@ -1274,14 +1492,66 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::set_dynamic_ghost_properties(
+    const std::vector<unsigned int> &property_indices)
+  {
+    for (const unsigned int property_index : property_indices)
+      AssertIndexRange(property_index, n_properties_per_particle());
+
+    only_dynamic_ghost_properties = true;
+    dynamic_ghost_properties      = property_indices;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ParticleHandler<dim, spacedim>::ghost_update_data_size() const
+  {
+    if (only_dynamic_ghost_properties)
+      return (spacedim + dynamic_ghost_properties.size()) * sizeof(double) +
+             (size_callback ? size_callback() : 0);
+    else
+      return ghost_particles_cache.particle_data_size;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::free_ghost_update_requests()
+  {
+#ifdef DEAL_II_WITH_MPI
+    if (ghost_particles_cache.requests.empty())
+      return;
+
+    // The handler may outlive MPI if it is a global object, in which case
+    // the requests are gone anyway
+    int mpi_finalized;
+    int ierr = MPI_Finalized(&mpi_finalized);
+    AssertThrowMPI(ierr);
+
+    if (mpi_finalized == 0)
+      for (MPI_Request &request : ghost_particles_cache.requests)
+        {
+          ierr = MPI_Request_free(&request);
+          AssertThrowMPI(ierr);
+        }
+    ghost_particles_cache.requests.clear();
+#endif
+  }
+
+
+
 #ifdef DEAL_II_WITH_MPI
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::send_recv_particles(
     const std::map<types::subdomain_id, std::vector<particle_iterator>>
       &particles_to_send,
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      &received_particles,
+    internal::ParticleContainer<dim, spacedim> &received_particles,
     const std::map<
       types::subdomain_id,
       std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
@@ -1503,21 +1773,26 @@ namespace Particles
       {
         ghost_particles_iterators.clear();
 
+        // Updates of the ghost particles may only send some of the data
+        // sent here
+        const unsigned int update_data_size =
+          (only_dynamic_ghost_properties ? ghost_update_data_size() :
+                                           individual_particle_data_size);
+        ghost_particles_cache.particle_data_size = update_data_size;
+
         auto &send_pointers_particles = ghost_particles_cache.send_pointers;
         send_pointers_particles.assign(n_neighbors + 1, 0);
 
         for (unsigned int i = 0; i < n_neighbors; ++i)
           send_pointers_particles[i + 1] =
-            send_pointers_particles[i] +
-            n_send_data[i] * individual_particle_data_size;
+            send_pointers_particles[i] + n_send_data[i] * update_data_size;
 
         auto &recv_pointers_particles = ghost_particles_cache.recv_pointers;
         recv_pointers_particles.assign(n_neighbors + 1, 0);
 
         for (unsigned int i = 0; i < n_neighbors; ++i)
           recv_pointers_particles[i + 1] =
-            recv_pointers_particles[i] +
-            n_recv_data[i] * individual_particle_data_size;
+            recv_pointers_particles[i] + n_recv_data[i] * update_data_size;
 
         ghost_particles_cache.neighbors = neighbors;
 
@@ -1525,6 +1800,8 @@ namespace Particles
           ghost_particles_cache.send_pointers.back());
         ghost_particles_cache.recv_data.resize(
           ghost_particles_cache.recv_pointers.back());
+
+        setup_ghost_update_requests();
       }
 
     while (reinterpret_cast<std::size_t>(recv_data_it) -
@@ -1539,11 +1816,9 @@ namespace Particles
         const typename Triangulation<dim, spacedim>::active_cell_iterator cell =
           triangulation->create_cell_iterator(id);
 
-        typename std::multimap<internal::LevelInd,
-                               Particle<dim, spacedim>>::iterator
-          recv_particle = received_particles.insert(std::make_pair(
-            internal::LevelInd(cell->level(), cell->index()),
-            Particle<dim, spacedim>(recv_data_it, property_pool.get())));
+        const auto recv_particle = received_particles.insert(
+          internal::LevelInd(cell->level(), cell->index()),
+          Particle<dim, spacedim>(recv_data_it, property_pool.get()));
 
         if (load_callback)
           recv_data_it =
@@ -1569,8 +1844,7 @@ namespace Particles
   ParticleHandler<dim, spacedim>::send_recv_particles_properties_and_location(
     const std::map<types::subdomain_id, std::vector<particle_iterator>>
       &particles_to_send,
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      &updated_particles)
+    internal::ParticleContainer<dim, spacedim> &updated_particles)
   {
     const auto &neighbors     = ghost_particles_cache.neighbors;
     const auto &send_pointers = ghost_particles_cache.send_pointers;
@@ -1595,7 +1869,22 @@ namespace Particles
         for (const auto i : neighbors)
           for (const auto &p : particles_to_send.at(i))
             {
-              data = p->write_particle_data_to_memory(data);
+              if (only_dynamic_ghost_properties)
+                {
+                  double *pdata = static_cast<double *>(data);
+                  for (unsigned int d = 0; d < spacedim; ++d, ++pdata)
+                    *pdata = p->get_location()[d];
+
+                  const StridedArrayView<const double, 1> properties =
+                    p->get_property_view();
+                  for (const unsigned int c : dynamic_ghost_properties)
+                    *pdata++ = properties(c);
+
+                  data = static_cast<void *>(pdata);
+                }
+              else
+                data = p->write_particle_data_to_memory(data);
+
               if (store_callback)
                 data = store_callback(p, data);
             }
@@ -1603,48 +1892,19 @@ namespace Particles
 
     std::vector<char> &recv_data = ghost_particles_cache.recv_data;
 
-    // Exchange the particle data between domains
-    {
-      std::vector<MPI_Request> requests(2 * neighbors.size());
-      unsigned int             send_ops = 0;
-      unsigned int             recv_ops = 0;
-
-      const int mpi_tag = Utilities::MPI::internal::Tags::
-        particle_handler_send_recv_particles_send;
-
-      for (unsigned int i = 0; i < neighbors.size(); ++i)
-        if ((recv_pointers[i + 1] - recv_pointers[i]) > 0)
-          {
-            const int ierr =
-              MPI_Irecv(recv_data.data() + recv_pointers[i],
-                        recv_pointers[i + 1] - recv_pointers[i],
-                        MPI_CHAR,
-                        neighbors[i],
-                        mpi_tag,
-                        parallel_triangulation->get_communicator(),
-                        &(requests[send_ops]));
-            AssertThrowMPI(ierr);
-            send_ops++;
-          }
+    // Exchange the particle data between domains, using the persistent
+    // requests set up together with the cache
+    if (!ghost_particles_cache.requests.empty())
+      {
+        int ierr = MPI_Startall(ghost_particles_cache.requests.size(),
+                                ghost_particles_cache.requests.data());
+        AssertThrowMPI(ierr);
 
-      for (unsigned int i = 0; i < neighbors.size(); ++i)
-        if ((send_pointers[i + 1] - send_pointers[i]) > 0)
-          {
-            const int ierr =
-              MPI_Isend(send_data.data() + send_pointers[i],
-                        send_pointers[i + 1] - send_pointers[i],
-                        MPI_CHAR,
-                        neighbors[i],
-                        mpi_tag,
-                        parallel_triangulation->get_communicator(),
-                        &(requests[send_ops + recv_ops]));
-            AssertThrowMPI(ierr);
-            recv_ops++;
-          }
-      const int ierr =
-        MPI_Waitall(send_ops + recv_ops, requests.data(), MPI_STATUSES_IGNORE);
-      AssertThrowMPI(ierr);
-    }
+        ierr = MPI_Waitall(ghost_particles_cache.requests.size(),
+                           ghost_particles_cache.requests.data(),
+                           MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
 
     // Put the received particles into the domain if they are in the
     // triangulation
@@ -1654,12 +1914,32 @@ namespace Particles
     auto &ghost_particles_iterators =
       ghost_particles_cache.ghost_particles_iterators;
 
-    for (auto &recv_particle : ghost_particles_iterators)
+    for (const auto &recv_particle : ghost_particles_iterators)
       {
         // Update particle data using previously allocated memory space
         // for efficiency reasons
-        recv_data_it =
-          recv_particle->second.read_particle_data_from_memory(recv_data_it);
+        if (only_dynamic_ghost_properties)
+          {
+            Particle<dim, spacedim> &particle =
+              updated_particles[recv_particle];
+
+            const double *pdata = static_cast<const double *>(recv_data_it);
+            Point<spacedim> location;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              location[d] = *pdata++;
+            particle.set_location(location);
+
+            const StridedArrayView<double, 1> properties =
+              particle.get_property_view();
+            for (const unsigned int c : dynamic_ghost_properties)
+              properties(c) = *pdata++;
+
+            recv_data_it = static_cast<const void *>(pdata);
+          }
+        else
+          recv_data_it =
+            updated_particles[recv_particle].read_particle_data_from_memory(
+              recv_data_it);
 
         if (load_callback)
           recv_data_it =
@@ -1672,6 +1952,63 @@ namespace Particles
                   "The amount of data that was read into new particles "
                   "does not match the amount of data sent around."));
   }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::setup_ghost_update_requests()
+  {
+    free_ghost_update_requests();
+
+    const auto parallel_triangulation =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+        &*triangulation);
+    Assert(
+      parallel_triangulation,
+      ExcMessage(
+        "This function is only implemented for parallel::TriangulationBase objects."));
+
+    const auto &neighbors     = ghost_particles_cache.neighbors;
+    const auto &send_pointers = ghost_particles_cache.send_pointers;
+    const auto &recv_pointers = ghost_particles_cache.recv_pointers;
+    auto &      requests      = ghost_particles_cache.requests;
+
+    const int mpi_tag = Utilities::MPI::internal::Tags::
+      particle_handler_send_recv_particles_send;
+
+    for (unsigned int i = 0; i < neighbors.size(); ++i)
+      if ((recv_pointers[i + 1] - recv_pointers[i]) > 0)
+        {
+          requests.emplace_back();
+          const int ierr =
+            MPI_Recv_init(ghost_particles_cache.recv_data.data() +
+                            recv_pointers[i],
+                          recv_pointers[i + 1] - recv_pointers[i],
+                          MPI_CHAR,
+                          neighbors[i],
+                          mpi_tag,
+                          parallel_triangulation->get_communicator(),
+                          &requests.back());
+          AssertThrowMPI(ierr);
+        }
+
+    for (unsigned int i = 0; i < neighbors.size(); ++i)
+      if ((send_pointers[i + 1] - send_pointers[i]) > 0)
+        {
+          requests.emplace_back();
+          const int ierr =
+            MPI_Send_init(ghost_particles_cache.send_data.data() +
+                            send_pointers[i],
+                          send_pointers[i + 1] - send_pointers[i],
+                          MPI_CHAR,
+                          neighbors[i],
+                          mpi_tag,
+                          parallel_triangulation->get_communicator(),
+                          &requests.back());
+          AssertThrowMPI(ierr);
+        }
+  }
 #endif
 
   template <int dim, int spacedim>
@@ -1782,6 +2119,7 @@ namespace Particles
         // Reset handle and update global number of particles. The number
         // can change because of discarded or newly generated particles
         handle = numbers::invalid_unsigned_int;
+        sort_property_pool_memory();
         update_cached_numbers();
       }
 #else
@@ -1791,13 +2129,27 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  std::size_t
+  ParticleHandler<dim, spacedim>::particle_record_size() const
+  {
+    // the layout written by Particle::write_particle_data_to_memory()
+    return sizeof(types::particle_index) + (spacedim + dim) * sizeof(double) +
+           property_pool->n_properties_per_slot() * sizeof(double);
+  }
+
+
+
   template <int dim, int spacedim>
   std::vector<char>
   ParticleHandler<dim, spacedim>::store_particles(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const typename Triangulation<dim, spacedim>::CellStatus     status) const
   {
-    std::vector<Particle<dim, spacedim>> stored_particles_on_cell;
+    // The containers and cells whose particles are stored with this cell
+    std::vector<std::pair<const internal::ParticleContainer<dim, spacedim> *,
+                          internal::LevelInd>>
+      stored_cells;
 
     switch (status)
       {
@@ -1805,65 +2157,20 @@ namespace Particles
         case parallel::TriangulationBase<dim, spacedim>::CELL_REFINE:
           // If the cell persist or is refined store all particles of the
           // current cell.
-          {
-            unsigned int n_particles = 0;
-
-            const internal::LevelInd level_index = {cell->level(),
-                                                    cell->index()};
-            const auto               particles_in_cell =
-              (cell->is_ghost() ? ghost_particles.equal_range(level_index) :
-                                  particles.equal_range(level_index));
-
-            n_particles = n_particles_in_cell(cell);
-            stored_particles_on_cell.reserve(n_particles);
-
-            std::for_each(
-              particles_in_cell.first,
-              particles_in_cell.second,
-              [&stored_particles_on_cell](
-                const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                  &particle) {
-                stored_particles_on_cell.push_back(particle.second);
-              });
-
-            AssertDimension(n_particles, stored_particles_on_cell.size());
-          }
+          stored_cells.emplace_back(cell->is_ghost() ? &ghost_particles :
+                                                       &particles,
+                                    internal::LevelInd(cell->level(),
+                                                       cell->index()));
           break;
 
         case parallel::TriangulationBase<dim, spacedim>::CELL_COARSEN:
           // If this cell is the parent of children that will be coarsened,
           // collect the particles of all children.
-          {
-            unsigned int n_particles = 0;
-
-            for (const auto &child : cell->child_iterators())
-              {
-                n_particles += n_particles_in_cell(child);
-              }
-
-            stored_particles_on_cell.reserve(n_particles);
-
-            for (const auto &child : cell->child_iterators())
-              {
-                const internal::LevelInd level_index = {child->level(),
-                                                        child->index()};
-                const auto               particles_in_cell =
-                  (child->is_ghost() ?
-                     ghost_particles.equal_range(level_index) :
-                     particles.equal_range(level_index));
-
-                std::for_each(
-                  particles_in_cell.first,
-                  particles_in_cell.second,
-                  [&stored_particles_on_cell](
-                    const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                      &particle) {
-                    stored_particles_on_cell.push_back(particle.second);
-                  });
-              }
-
-            AssertDimension(n_particles, stored_particles_on_cell.size());
-          }
+          for (const auto &child : cell->child_iterators())
+            stored_cells.emplace_back(child->is_ghost() ? &ghost_particles :
+                                                          &particles,
+                                      internal::LevelInd(child->level(),
+                                                         child->index()));
           break;
 
         default:
@@ -1871,7 +2178,24 @@ namespace Particles
           break;
       }
 
-    return pack_particles(stored_particles_on_cell);
+    std::size_t n_particles = 0;
+    for (const auto &stored_cell : stored_cells)
+      n_particles += stored_cell.first->n_particles_in_cell(stored_cell.second);
+
+    // Write the particles directly from their containers into one record of
+    // fixed size per particle
+    std::vector<char> buffer(n_particles * particle_record_size());
+    void *            data = buffer.data();
+    for (const auto &stored_cell : stored_cells)
+      if (stored_cell.first->n_particles_in_cell(stored_cell.second) > 0)
+        for (const auto &particle :
+             stored_cell.first->particles_in_cell(stored_cell.second))
+          data = particle.write_particle_data_to_memory(data);
+
+    Assert(static_cast<char *>(data) == buffer.data() + buffer.size(),
+           ExcInternalError());
+
+    return buffer;
   }
 
 
@@ -1883,83 +2207,54 @@ namespace Particles
     const typename Triangulation<dim, spacedim>::CellStatus         status,
     const boost::iterator_range<std::vector<char>::const_iterator> &data_range)
   {
-    // We leave this container non-const to be able to `std::move`
-    // its contents directly into the particles multimap later.
-    std::vector<Particle<dim, spacedim>> loaded_particles_on_cell =
-      unpack_particles<dim, spacedim>(data_range, *property_pool);
+    if (data_range.empty())
+      return;
+
+    const std::size_t record_size = particle_record_size();
+    Assert(
+      data_range.size() % record_size == 0,
+      ExcMessage(
+        "The particle data could not be deserialized successfully. "
+        "Check that when deserializing the particles you expect the same "
+        "number of properties that were serialized."));
+    const std::size_t n_particles = data_range.size() / record_size;
 
-    // Update the reference to the current property pool for all particles.
-    // This was not stored, because they might be transported across process
-    // domains.
-    for (auto &particle : loaded_particles_on_cell)
-      particle.set_property_pool(*property_pool);
+    // The particles are read directly from the fixed-size records into the
+    // property pool of this object
+    const void *data = static_cast<const void *>(&(*data_range.begin()));
 
     switch (status)
       {
         case parallel::TriangulationBase<dim, spacedim>::CELL_PERSIST:
           {
-            auto position_hint = particles.end();
-            for (const auto &particle : loaded_particles_on_cell)
-              {
-                // Use std::multimap::emplace_hint to speed up insertion of
-                // particles.
-                position_hint =
-                  particles.emplace_hint(position_hint,
-                                         std::make_pair(cell->level(),
-                                                        cell->index()),
-                                         std::move(particle));
-                // Move the hint position forward by one, i.e., for the next
-                // particle. The 'hint' position will thus be right after the
-                // one just inserted.
-                ++position_hint;
-              }
+            const internal::LevelInd level_index(cell->level(), cell->index());
+            for (std::size_t i = 0; i < n_particles; ++i)
+              particles.insert(level_index,
+                               Particle<dim, spacedim>(data,
+                                                       property_pool.get()));
           }
           break;
 
         case parallel::TriangulationBase<dim, spacedim>::CELL_COARSEN:
           {
-            typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-              position_hint = particles.end();
-            for (auto &particle : loaded_particles_on_cell)
+            const internal::LevelInd level_index(cell->level(), cell->index());
+            for (std::size_t i = 0; i < n_particles; ++i)
               {
-                const Point<dim> p_unit =
+                Particle<dim, spacedim> particle(data, property_pool.get());
+                const Point<dim>        p_unit =
                   mapping->transform_real_to_unit_cell(cell,
                                                        particle.get_location());
                 particle.set_reference_location(p_unit);
-                // Use std::multimap::emplace_hint to speed up insertion of
-                // particles.
-                position_hint =
-                  particles.emplace_hint(position_hint,
-                                         std::make_pair(cell->level(),
-                                                        cell->index()),
-                                         std::move(particle));
-                // Move the hint position forward by one, i.e., for the next
-                // particle. The 'hint' position will thus be right after the
-                // one just inserted.
-                ++position_hint;
+                particles.insert(level_index, std::move(particle));
               }
           }
           break;
 
         case parallel::TriangulationBase<dim, spacedim>::CELL_REFINE:
           {
-            std::vector<
-              typename std::multimap<internal::LevelInd,
-                                     Particle<dim, spacedim>>::iterator>
-              position_hints(GeometryInfo<dim>::max_children_per_cell);
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
-              {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                  child                     = cell->child(child_index);
-                position_hints[child_index] = particles.upper_bound(
-                  std::make_pair(child->level(), child->index()));
-              }
-
-            for (auto &particle : loaded_particles_on_cell)
+            for (std::size_t i = 0; i < n_particles; ++i)
               {
+                Particle<dim, spacedim> particle(data, property_pool.get());
                 for (unsigned int child_index = 0;
                      child_index < GeometryInfo<dim>::max_children_per_cell;
                      ++child_index)
@@ -1975,17 +2270,9 @@ namespace Particles
                         if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
                           {
                             particle.set_reference_location(p_unit);
-                            // Use std::multimap::emplace_hint to speed up
-                            // insertion of particles.
-                            position_hints[child_index] =
-                              particles.emplace_hint(
-                                position_hints[child_index],
-                                std::make_pair(child->level(), child->index()),
-                                std::move(particle));
-                            // Move the hint position forward by one, i.e.,
-                            // for the next particle. The 'hint' position will
-                            // thus be right after the one just inserted.
-                            ++position_hints[child_index];
+                            particles.insert(internal::LevelInd(child->level(),
+                                                                child->index()),
+                                             std::move(particle));
                             break;
                           }
                       }
@@ -2000,6 +2287,10 @@ namespace Particles
           Assert(false, ExcInternalError());
           break;
       }
+
+    Assert(static_cast<const char *>(data) ==
+             &(*data_range.begin()) + data_range.size(),
+           ExcInternalError());
   }
 } // namespace Particles
 
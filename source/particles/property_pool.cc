@@ -18,6 +18,8 @@
 
 #include <deal.II/particles/property_pool.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
@@ -30,8 +32,11 @@ namespace Particles
 
   template <int dim, int spacedim>
   PropertyPool<dim, spacedim>::PropertyPool(
-    const unsigned int n_properties_per_slot)
+    const unsigned int n_properties_per_slot,
+    const Layout       layout)
     : n_properties(n_properties_per_slot)
+    , layout(layout)
+    , slot_capacity(0)
   {}
 
 
@@ -51,7 +56,7 @@ namespace Particles
     if (n_properties > 0)
       {
         const unsigned int n_open_handles =
-          properties.size() / n_properties - currently_available_handles.size();
+          locations.size() - currently_available_handles.size();
         (void)n_open_handles;
         AssertThrow(n_open_handles == 0,
                     ExcMessage("This property pool currently still holds " +
@@ -74,6 +79,7 @@ namespace Particles
 
     properties.clear();
     properties.shrink_to_fit();
+    slot_capacity = 0;
 
     currently_available_handles.clear();
     currently_available_handles.shrink_to_fit();
@@ -98,7 +104,10 @@ namespace Particles
         locations.resize(locations.size() + 1);
         reference_locations.resize(reference_locations.size() + 1);
         ids.resize(ids.size() + 1);
-        properties.resize(properties.size() + n_properties);
+        if (layout == array_of_structures)
+          properties.resize(properties.size() + n_properties);
+        else if (locations.size() > slot_capacity)
+          set_slot_capacity(std::max<std::size_t>(2 * slot_capacity, 1));
       }
 
     // Then initialize whatever slot we have taken with invalid locations,
@@ -106,8 +115,10 @@ namespace Particles
     set_location(handle, numbers::signaling_nan<Point<spacedim>>());
     set_reference_location(handle, numbers::signaling_nan<Point<dim>>());
     set_id(handle, numbers::invalid_unsigned_int);
-    for (double &x : get_properties(handle))
-      x = 0;
+    const StridedArrayView<double, 1> handle_properties =
+      get_property_view(handle);
+    for (unsigned int i = 0; i < n_properties; ++i)
+      handle_properties(i) = 0;
 
     return handle;
   }
@@ -133,6 +144,7 @@ namespace Particles
       {
         currently_available_handles.clear();
         properties.clear();
+        slot_capacity = 0;
         locations.clear();
         reference_locations.clear();
         ids.clear();
@@ -147,12 +159,86 @@ namespace Particles
   {
     locations.reserve(size);
     reference_locations.reserve(size);
-    properties.reserve(size * n_properties);
+    if (layout == array_of_structures)
+      properties.reserve(size * n_properties);
+    else if (size > slot_capacity)
+      set_slot_capacity(size);
     ids.reserve(size);
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  PropertyPool<dim, spacedim>::set_slot_capacity(
+    const std::size_t new_slot_capacity)
+  {
+    Assert(layout == structure_of_arrays, ExcInternalError());
+    Assert(new_slot_capacity >= locations.size(), ExcInternalError());
+
+    // Only the slots that existed before can hold values worth keeping
+    const std::size_t n_slots_to_copy =
+      std::min(slot_capacity, new_slot_capacity);
+
+    std::vector<double> new_properties(n_properties * new_slot_capacity);
+    for (unsigned int c = 0; c < n_properties; ++c)
+      std::copy(properties.begin() + c * slot_capacity,
+                properties.begin() + c * slot_capacity + n_slots_to_copy,
+                new_properties.begin() + c * new_slot_capacity);
+
+    properties.swap(new_properties);
+    slot_capacity = new_slot_capacity;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PropertyPool<dim, spacedim>::sort_memory_slots(
+    const std::vector<Handle> &sorted_handles)
+  {
+    Assert(sorted_handles.size() ==
+             locations.size() - currently_available_handles.size(),
+           ExcMessage("The handles to be sorted have to contain all handles "
+                      "that are currently registered with this pool."));
+
+    const std::size_t n_slots = sorted_handles.size();
+
+    std::vector<Point<spacedim>>       sorted_locations(n_slots);
+    std::vector<Point<dim>>            sorted_reference_locations(n_slots);
+    std::vector<types::particle_index> sorted_ids(n_slots);
+    std::vector<double> sorted_properties(n_slots * n_properties);
+
+    for (std::size_t i = 0; i < n_slots; ++i)
+      {
+        const Handle handle = sorted_handles[i];
+        AssertIndexRange(handle, locations.size());
+
+        sorted_locations[i]           = locations[handle];
+        sorted_reference_locations[i] = reference_locations[handle];
+        sorted_ids[i]                 = ids[handle];
+
+        const StridedArrayView<const double, 1> old_properties =
+          get_property_view(handle);
+        for (unsigned int c = 0; c < n_properties; ++c)
+          if (layout == array_of_structures)
+            sorted_properties[i * n_properties + c] = old_properties(c);
+          else
+            sorted_properties[c * n_slots + i] = old_properties(c);
+      }
+
+    locations.swap(sorted_locations);
+    reference_locations.swap(sorted_reference_locations);
+    ids.swap(sorted_ids);
+    properties.swap(sorted_properties);
+    if (layout == structure_of_arrays)
+      slot_capacity = n_slots;
+
+    currently_available_handles.clear();
+  }
+
+
+
   template <int dim, int spacedim>
   unsigned int
   PropertyPool<dim, spacedim>::n_properties_per_slot() const
@@ -161,6 +247,15 @@ namespace Particles
   }
 
 
+
+  template <int dim, int spacedim>
+  typename PropertyPool<dim, spacedim>::Layout
+  PropertyPool<dim, spacedim>::get_layout() const
+  {
+    return layout;
+  }
+
+
   // Instantiate the class for all reasonable template arguments
   template class PropertyPool<1, 1>;
   template class PropertyPool<1, 2>;
@@ -0,0 +1,185 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_performance_test_driver_h
+#define dealii_performance_test_driver_h
+
+// A small driver for the performance tests: it takes care of timing code
+// sections and of writing the results in a machine-readable JSON format,
+// so that the results can be tracked from one revision to the next.
+//
+// Each performance test calls
+//
+//   Benchmark benchmark("name", argc, argv);
+//   ...
+//   benchmark.add_result("vmult", {{"degree", "2"}}, value, "DoFs/s");
+//
+// and the results are written to the file given by the --output argument
+// (or to the screen) when the Benchmark object goes out of scope.
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/revision.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace dealii;
+
+
+class Benchmark
+{
+public:
+  /**
+   * Constructor. Parse the command line arguments, which may contain
+   *  --size N     a problem size parameter interpreted by each test,
+   *  --repeat N   the number of repetitions of each measurement,
+   *  --output F   the name of the JSON file to write.
+   */
+  Benchmark(const std::string &name, int argc, char **argv)
+    : name(name)
+    , size(-1)
+    , n_repetitions(5)
+  {
+    for (int i = 1; i + 1 < argc; i += 2)
+      {
+        const std::string option = argv[i];
+        if (option == "--size")
+          size = Utilities::string_to_int(argv[i + 1]);
+        else if (option == "--repeat")
+          n_repetitions = Utilities::string_to_int(argv[i + 1]);
+        else if (option == "--output")
+          output_file = argv[i + 1];
+        else
+          AssertThrow(false, ExcMessage("Unknown option " + option));
+      }
+  }
+
+  /**
+   * Write the results.
+   */
+  ~Benchmark()
+  {
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) != 0)
+      return;
+
+    if (output_file.empty())
+      write(std::cout);
+    else
+      {
+        std::ofstream out(output_file);
+        write(out);
+      }
+  }
+
+  /**
+   * Return the size parameter given on the command line, or @p default_size
+   * if none was given.
+   */
+  int
+  get_size(const int default_size) const
+  {
+    return size >= 0 ? size : default_size;
+  }
+
+  /**
+   * Run @p function the given number of times and return the smallest wall
+   * time in seconds, maximized over all MPI processes.
+   */
+  template <typename FunctionType>
+  double
+  time(const FunctionType &function) const
+  {
+    double best = std::numeric_limits<double>::max();
+    for (unsigned int r = 0; r < n_repetitions; ++r)
+      {
+#ifdef DEAL_II_WITH_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif
+        Timer timer;
+        function();
+        timer.stop();
+        best = std::min(best,
+                        Utilities::MPI::max(timer.wall_time(), MPI_COMM_WORLD));
+      }
+    return best;
+  }
+
+  /**
+   * Record a result.
+   */
+  void
+  add_result(const std::string &                       measurement,
+             const std::map<std::string, std::string> &parameters,
+             const double                              value,
+             const std::string &                       unit)
+  {
+    results.push_back({measurement, parameters, value, unit});
+  }
+
+private:
+  struct Result
+  {
+    std::string                        measurement;
+    std::map<std::string, std::string> parameters;
+    double                             value;
+    std::string                        unit;
+  };
+
+  void
+  write(std::ostream &out) const
+  {
+    out << "{\n"
+        << "  \"benchmark\": \"" << name << "\",\n"
+        << "  \"version\": \"" << DEAL_II_PACKAGE_VERSION << "\",\n"
+        << "  \"revision\": \"" << DEAL_II_GIT_SHORTREV << "\",\n"
+        << "  \"n_mpi_processes\": "
+        << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD) << ",\n"
+        << "  \"n_threads\": " << MultithreadInfo::n_threads() << ",\n"
+        << "  \"results\": [";
+    for (unsigned int i = 0; i < results.size(); ++i)
+      {
+        out << (i == 0 ? "\n" : ",\n") << "    {\"measurement\": \""
+            << results[i].measurement << "\", \"parameters\": {";
+        bool first = true;
+        for (const auto &parameter : results[i].parameters)
+          {
+            out << (first ? "" : ", ") << '"' << parameter.first << "\": \""
+                << parameter.second << '"';
+            first = false;
+          }
+        out << "}, \"value\": " << results[i].value << ", \"unit\": \""
+            << results[i].unit << "\"}";
+      }
+    out << "\n  ]\n}\n";
+  }
+
+  const std::string   name;
+  int                 size;
+  unsigned int        n_repetitions;
+  std::string         output_file;
+  std::vector<Result> results;
+};
+
+#endif
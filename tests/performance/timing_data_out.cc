@@ -0,0 +1,92 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Speed of graphical output: the time of DataOut::build_patches() and the
+// throughput of DataOut::write_vtu() in MB/s, with and without
+// compression.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <sstream>
+
+#include "performance_test_driver.h"
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  Benchmark benchmark("data_out", argc, argv);
+
+  const int          dim    = 3;
+  const unsigned int degree = 2;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(benchmark.get_size(5));
+
+  const FE_Q<dim> fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution[i] = std::sin(0.01 * i);
+
+  const std::map<std::string, std::string> parameters = {
+    {"dim", std::to_string(dim)},
+    {"degree", std::to_string(degree)},
+    {"n_cells", std::to_string(tria.n_active_cells())}};
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  double time = benchmark.time([&]() { data_out.build_patches(degree); });
+  benchmark.add_result("build_patches", parameters, time, "s");
+
+  for (const auto compression :
+       {DataOutBase::VtkFlags::no_compression,
+        DataOutBase::VtkFlags::best_speed})
+    {
+      DataOutBase::VtkFlags flags;
+      flags.compression_level = compression;
+      data_out.set_flags(flags);
+
+      std::size_t n_bytes = 0;
+      time                = benchmark.time([&]() {
+        std::ostringstream out;
+        data_out.write_vtu(out);
+        n_bytes = out.str().size();
+      });
+
+      auto write_parameters           = parameters;
+      write_parameters["compression"] =
+        compression == DataOutBase::VtkFlags::no_compression ? "none" :
+                                                               "best_speed";
+      benchmark.add_result("write_vtu",
+                           write_parameters,
+                           n_bytes / time * 1e-6,
+                           "MB/s");
+    }
+}
@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Throughput of the matrix-free Laplace operator in DoFs per second for
+// polynomial degrees one to six on a uniformly refined cube.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include "performance_test_driver.h"
+
+
+template <int dim, int degree>
+void
+measure(Benchmark &benchmark, const unsigned int n_dofs_target)
+{
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  while (tria.n_global_active_cells() * Utilities::pow(degree, dim) <
+         n_dofs_target)
+    tria.refine_global(1);
+
+  const FE_Q<dim> fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim, double>::AdditionalData::none;
+  const auto matrix_free = std::make_shared<MatrixFree<dim, double>>();
+  matrix_free->reinit(MappingQGeneric<dim>(1),
+                      dof_handler,
+                      constraints,
+                      QGauss<1>(degree + 1),
+                      data);
+
+  MatrixFreeOperators::LaplaceOperator<dim, degree> laplace;
+  laplace.initialize(matrix_free);
+
+  LinearAlgebra::distributed::Vector<double> src, dst;
+  laplace.initialize_dof_vector(src);
+  laplace.initialize_dof_vector(dst);
+  src = 1.;
+
+  const unsigned int n_applications = 20;
+  const double       time           = benchmark.time([&]() {
+    for (unsigned int i = 0; i < n_applications; ++i)
+      laplace.vmult(dst, src);
+  });
+
+  benchmark.add_result("vmult",
+                       {{"dim", std::to_string(dim)},
+                        {"degree", std::to_string(degree)},
+                        {"n_dofs", std::to_string(dof_handler.n_dofs())}},
+                       n_applications * dof_handler.n_dofs() / time,
+                       "DoFs/s");
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  Benchmark benchmark("matrix_free_laplace", argc, argv);
+
+  // the size parameter is the approximate number of DoFs in millions
+  const unsigned int n_dofs = benchmark.get_size(2) * 1000000;
+
+  measure<3, 1>(benchmark, n_dofs);
+  measure<3, 2>(benchmark, n_dofs);
+  measure<3, 3>(benchmark, n_dofs);
+  measure<3, 4>(benchmark, n_dofs);
+  measure<3, 5>(benchmark, n_dofs);
+  measure<3, 6>(benchmark, n_dofs);
+}
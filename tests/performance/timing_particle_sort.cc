@@ -0,0 +1,89 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Throughput in particles per second of inserting particles into a
+// ParticleHandler, and of sorting them into cells after they have moved.
+
+#include <deal.II/base/point.h>
+
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include <random>
+
+#include "performance_test_driver.h"
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  Benchmark benchmark("particle_sort", argc, argv);
+
+  const int          dim         = 3;
+  const unsigned int n_particles = benchmark.get_size(1000000);
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(5);
+  const MappingQGeneric<dim> mapping(1);
+
+  std::mt19937                           generator(0);
+  std::uniform_real_distribution<double> distribution(0.01, 0.99);
+  std::vector<Point<dim>>                positions(n_particles);
+  for (auto &position : positions)
+    for (unsigned int d = 0; d < dim; ++d)
+      position[d] = distribution(generator);
+
+  const std::map<std::string, std::string> parameters = {
+    {"dim", std::to_string(dim)},
+    {"n_cells", std::to_string(tria.n_active_cells())},
+    {"n_particles", std::to_string(n_particles)}};
+
+  Particles::ParticleHandler<dim> particle_handler(tria, mapping);
+  double time = benchmark.time([&]() {
+    particle_handler.clear();
+    particle_handler.insert_particles(positions);
+  });
+  benchmark.add_result("insert_particles",
+                       parameters,
+                       n_particles / time,
+                       "particles/s");
+
+  // move all particles by a fraction of the cell size, so that some of
+  // them leave their cell, and sort them again
+  const double h    = 1. / 32;
+  double       sign = 1.;
+  time              = benchmark.time([&]() {
+    for (auto particle = particle_handler.begin();
+         particle != particle_handler.end();
+         ++particle)
+      {
+        Point<dim> location = particle->get_location();
+        location[0] += sign * 0.3 * h;
+        particle->set_location(location);
+      }
+    sign = -sign;
+    particle_handler.sort_particles_into_subdomains_and_cells();
+  });
+  benchmark.add_result("sort_particles_into_subdomains_and_cells",
+                       parameters,
+                       n_particles / time,
+                       "particles/s");
+}
@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Wall times of the setup phases of a typical finite element program on an
+// adaptively refined mesh with hanging nodes: DoFHandler::distribute_dofs(),
+// the computation and closing of the constraints, and the creation of the
+// sparsity pattern.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "performance_test_driver.h"
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  Benchmark benchmark("setup", argc, argv);
+
+  const int          dim           = 3;
+  const unsigned int degree        = 2;
+  const unsigned int n_refinements = benchmark.get_size(4);
+
+  // refine the cells in one corner once more to create hanging nodes
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim>           fe(degree);
+  DoFHandler<dim>           dof_handler(tria);
+  AffineConstraints<double> constraints;
+  SparsityPattern           sparsity;
+
+  const std::map<std::string, std::string> parameters = {
+    {"dim", std::to_string(dim)},
+    {"degree", std::to_string(degree)},
+    {"n_cells", std::to_string(tria.n_active_cells())}};
+
+  double time = benchmark.time([&]() { dof_handler.distribute_dofs(fe); });
+  benchmark.add_result("distribute_dofs", parameters, time, "s");
+
+  time = benchmark.time([&]() { DoFRenumbering::Cuthill_McKee(dof_handler); });
+  benchmark.add_result("Cuthill_McKee", parameters, time, "s");
+
+  time = benchmark.time([&]() {
+    constraints.clear();
+    DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+    VectorTools::interpolate_boundary_values(dof_handler,
+                                             0,
+                                             Functions::ZeroFunction<dim>(),
+                                             constraints);
+    constraints.close();
+  });
+  benchmark.add_result("constraints", parameters, time, "s");
+
+  time = benchmark.time([&]() {
+    DynamicSparsityPattern dsp(dof_handler.n_dofs());
+    DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+    sparsity.copy_from(dsp);
+  });
+  benchmark.add_result("sparsity_pattern", parameters, time, "s");
+}
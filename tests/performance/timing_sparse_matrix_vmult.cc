@@ -0,0 +1,95 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Memory throughput of SparseMatrix::vmult() in GB/s for the sparsity
+// patterns of continuous finite elements of degrees one to three.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "performance_test_driver.h"
+
+
+void
+measure(Benchmark &benchmark, const unsigned int degree)
+{
+  const int dim = 3;
+
+  // aim at about the same number of DoFs for all degrees
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria,
+                                       benchmark.get_size(48) / degree);
+
+  const FE_Q<dim> fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> matrix(sparsity);
+  for (unsigned int row = 0; row < matrix.m(); ++row)
+    for (auto entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+      entry->value() = (entry->column() == row) ? 6. : -1. / (row + 1);
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs());
+  src = 1.;
+
+  const unsigned int n_applications = 20;
+  const double       time           = benchmark.time([&]() {
+    for (unsigned int i = 0; i < n_applications; ++i)
+      matrix.vmult(dst, src);
+  });
+
+  // each product reads the values and column indices of the matrix, the
+  // row starts, and the source vector, and writes the destination vector
+  const double bytes =
+    sparsity.n_nonzero_elements() * (sizeof(double) + sizeof(unsigned int)) +
+    matrix.m() * (sizeof(std::size_t) + 2 * sizeof(double));
+
+  benchmark.add_result("vmult",
+                       {{"degree", std::to_string(degree)},
+                        {"n_rows", std::to_string(matrix.m())},
+                        {"n_nonzero_elements",
+                         std::to_string(sparsity.n_nonzero_elements())}},
+                       n_applications * bytes / time * 1e-9,
+                       "GB/s");
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  Benchmark benchmark("sparse_matrix_vmult", argc, argv);
+
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    measure(benchmark, degree);
+}